@@ -19,6 +19,20 @@ endif()
 
 message(STATUS "Setting sizeof(integer_t) to ${INTEGER_T_SIZE}")
 
+# Option to encode difference bounds as integers with overflow checks
+# (see include/tchecker/dbm/db.hh)
+option(TCHECKER_DBM_PACKED "Use packed integer encoding of difference bounds in DBMs" OFF)
+if (TCHECKER_DBM_PACKED)
+    message(STATUS "Using packed encoding of difference bounds")
+endif()
+
+# Option to share zones between the zone graphs of concurrent threads
+# (see include/tchecker/zg/zone_registry.hh)
+option(TCHECKER_THREAD_SAFE_ZONES "Use atomic reference counters, sharded pools and concurrent caches for zones" OFF)
+if (TCHECKER_THREAD_SAFE_ZONES)
+    message(STATUS "Using thread-safe stores of zones")
+endif()
+
 #
 # Check if "flag" is accepted by the current CXX compiler. If the flag is
 # supported its value is assigned to the variable "var"; else "var" is asigned
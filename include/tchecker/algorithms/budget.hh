@@ -0,0 +1,172 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ALGORITHMS_BUDGET_HH
+#define TCHECKER_ALGORITHMS_BUDGET_HH
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+
+/*!
+ \file budget.hh
+ \brief Resource budgets of algorithms
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+class progress_t;
+
+/*!
+ \brief Status of a budget
+ */
+enum budget_status_t {
+  BUDGET_AVAILABLE = 0,   /*!< No limit has been reached */
+  BUDGET_STATES_EXCEEDED, /*!< Maximal number of visited states reached */
+  BUDGET_TIME_EXCEEDED,   /*!< Timeout reached */
+  BUDGET_MEMORY_EXCEEDED, /*!< Memory limit reached */
+  BUDGET_CANCELLED,       /*!< Cancellation requested */
+};
+
+/*!
+ \brief Output operator
+ \param os : output stream
+ \param status : budget status
+ \post status has been output to os ("available", "states", "time", "memory" or "cancelled")
+ \return os after output
+ */
+std::ostream & operator<<(std::ostream & os, enum tchecker::algorithms::budget_status_t status);
+
+/*!
+ \class cancellation_token_t
+ \brief Cancellation of algorithms, requested from any thread
+ \note algorithms check the token with their budget (see tchecker::algorithms::budget_t::check)
+ */
+class cancellation_token_t {
+public:
+  /*!
+   \brief Constructor
+   \post cancellation has not been requested
+   */
+  cancellation_token_t() : _cancelled(false) {}
+
+  /*!
+   \brief Request cancellation
+   \post the algorithms that check this token stop at their next check of the budget
+   */
+  inline void cancel() { _cancelled.store(true, std::memory_order_relaxed); }
+
+  /*!
+   \brief Accessor
+   \return true if cancellation has been requested, false otherwise
+   */
+  inline bool cancelled() const { return _cancelled.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<bool> _cancelled; /*!< Cancellation flag */
+};
+
+/*!
+ \class budget_t
+ \brief Budget of visited states, running time and memory of an algorithm
+ \note algorithms check the budget in their main loop, and stop with a partial verdict when it is exceeded (see
+ tchecker::algorithms::stats_t::budget_status)
+ */
+class budget_t {
+public:
+  /*!
+   \brief Constructor
+   \param max_states : maximal number of visited states (0 means no limit)
+   \param timeout : running time allowed from the construction of the budget (0 means no limit)
+   \param max_memory : maximal resident set size of the process in bytes (0 means no limit)
+   \param progress : progress heartbeat sampled by the checks of the budget (nullptr means no heartbeat)
+   \param cancellation : cancellation token checked by the checks of the budget (nullptr means no cancellation)
+   \note the deadline is computed at construction, hence a budget shared by successive algorithms bounds
+   their total running time
+   */
+  budget_t(std::uint64_t max_states = 0, std::chrono::milliseconds timeout = std::chrono::milliseconds{0},
+           std::size_t max_memory = 0, std::shared_ptr<tchecker::algorithms::progress_t> const & progress = nullptr,
+           std::shared_ptr<tchecker::algorithms::cancellation_token_t const> const & cancellation = nullptr);
+
+  /*!
+   \brief Accessor
+   \return maximal number of visited states (0 means no limit)
+   */
+  inline std::uint64_t max_states() const { return _max_states; }
+
+  /*!
+   \brief Accessor
+   \return allowed running time (0 means no limit)
+   */
+  inline std::chrono::milliseconds timeout() const { return _timeout; }
+
+  /*!
+   \brief Accessor
+   \return maximal resident set size in bytes (0 means no limit)
+   */
+  inline std::size_t max_memory() const { return _max_memory; }
+
+  /*!
+   \brief Accessor
+   \return progress heartbeat (nullptr if none)
+   */
+  inline std::shared_ptr<tchecker::algorithms::progress_t> const & progress() const { return _progress; }
+
+  /*!
+   \brief Accessor
+   \return cancellation token (nullptr if none)
+   */
+  inline std::shared_ptr<tchecker::algorithms::cancellation_token_t const> const & cancellation() const
+  {
+    return _cancellation;
+  }
+
+  /*!
+   \brief Accessor
+   \return true if this budget sets no limit, false otherwise
+   \note a progress heartbeat and a cancellation token are not limits
+   */
+  bool unlimited() const;
+
+  /*!
+   \brief Check the budget
+   \param visited_states : number of states visited so far
+   \param frontier : number of states waiting to be explored
+   \return tchecker::algorithms::BUDGET_CANCELLED if cancellation has been requested,
+   tchecker::algorithms::BUDGET_STATES_EXCEEDED if visited_states has reached the maximal number of
+   states, tchecker::algorithms::BUDGET_TIME_EXCEEDED if the deadline has passed,
+   tchecker::algorithms::BUDGET_MEMORY_EXCEEDED if the resident set size of the process exceeds the memory limit,
+   and tchecker::algorithms::BUDGET_AVAILABLE otherwise
+   \note the clock is sampled every TIME_CHECK_PERIOD checks, and the resident set size every MEMORY_CHECK_PERIOD
+   checks, to keep checks cheap in the main loops of the algorithms. The first check samples both. The progress
+   heartbeat, if any, is sampled with the clock (see tchecker::algorithms::progress_t::sample)
+   \note the cancellation token is checked at each check, as it only costs an atomic load
+   \note checks update a counter, hence a budget should not be checked by several threads concurrently (copies
+   of a budget can)
+   */
+  enum tchecker::algorithms::budget_status_t check(std::uint64_t visited_states, std::size_t frontier = 0) const;
+
+  static constexpr unsigned long const TIME_CHECK_PERIOD = 64;     /*!< Period of time checks (number of checks) */
+  static constexpr unsigned long const MEMORY_CHECK_PERIOD = 1024; /*!< Period of memory checks (number of checks) */
+
+private:
+  std::uint64_t _max_states;                                     /*!< Maximal number of visited states (0: no limit) */
+  std::chrono::milliseconds _timeout;                           /*!< Allowed running time (0: no limit) */
+  std::size_t _max_memory;                                      /*!< Maximal resident set size (0: no limit) */
+  std::chrono::time_point<std::chrono::steady_clock> _deadline; /*!< End of the allowed running time */
+  std::shared_ptr<tchecker::algorithms::progress_t> _progress;  /*!< Progress heartbeat (nullptr: none) */
+  std::shared_ptr<tchecker::algorithms::cancellation_token_t const> _cancellation; /*!< Cancellation (nullptr: none) */
+  mutable unsigned long _checks;                                /*!< Number of checks */
+};
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_BUDGET_HH
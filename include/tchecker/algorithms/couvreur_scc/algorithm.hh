@@ -12,7 +12,9 @@
 #include <boost/dynamic_bitset.hpp>
 
 #include "tchecker/algorithms/couvreur_scc/graph.hh"
+#include "tchecker/algorithms/budget.hh"
 #include "tchecker/algorithms/couvreur_scc/stats.hh"
+#include "tchecker/ts/static.hh"
 
 /*!
  \file algorithm.hh
@@ -92,9 +94,20 @@ namespace couvscc {
    push(Roots, <u, L>)
  */
 template <class TS, class GRAPH> class generalized_algorithm_t {
+  static_assert(tchecker::ts::is_static_v<TS>, "TS should be a final transition system, see tchecker::ts::is_static_t");
+
 public:
   using node_sptr_t = typename GRAPH::node_sptr_t;
 
+  /*!
+   \brief Constructor
+   \param budget : budget of visited states, running time and memory
+   \note when the budget is exceeded, the run is stopped, and the exceeded limit and the depth of the DFS stack are
+   recorded in its statistics (see tchecker::algorithms::stats_t::budget_status). The cycle flag is then only
+   meaningful when true
+   */
+  generalized_algorithm_t(tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{}) : _budget(budget) {}
+
   /*!
    \brief Check if a transition has an infinite run that satisfies a given set
    of labels and build the corresponding graph
@@ -123,7 +136,7 @@ public:
       auto && [is_new_node, initial_node] = graph.add_node(s);
       initial_node->initial(true);
       couv_dfs(initial_node, ts, graph, labels, stats);
-      if (stats.cycle())
+      if (stats.cycle() || stats.budget_exceeded())
         break;
     }
 
@@ -146,7 +159,7 @@ private:
    \param n : a node
    \post the DFS search in Couvreur's algorithm has been performed from n.
    stats.cycle() is true if an accepting cycle w.r.t labels has been found in
-   ts, and false otherwise
+   ts, and false otherwise, unless the budget has been exceeded
    graph contains the part of ts that has been explored
   */
   void couv_dfs(node_sptr_t & n, TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
@@ -154,6 +167,9 @@ private:
   {
     push(n, ts, graph, stats);
     while (!_todo.empty()) {
+      if (tchecker::algorithms::budget_exceeded(_budget, stats.visited_states(), _todo.size(), stats))
+        break;
+
       auto && [n, succ] = _todo.top();
       if (succ.empty()) {
         if (_roots.top().n == n)
@@ -311,6 +327,7 @@ private:
   std::stack<todo_stack_entry_t> _todo;   /*!< todo stack */
   std::stack<roots_stack_entry_t> _roots; /*!< roots stack */
   std::stack<node_sptr_t> _active;        /*!< active stack */
+  tchecker::algorithms::budget_t _budget; /*!< Budget of the runs */
 };
 
 /*!
@@ -380,9 +397,20 @@ private:
    push(Roots, <u, L>)
  */
 template <class TS, class GRAPH> class single_algorithm_t {
+  static_assert(tchecker::ts::is_static_v<TS>, "TS should be a final transition system, see tchecker::ts::is_static_t");
+
 public:
   using node_sptr_t = typename GRAPH::node_sptr_t;
 
+  /*!
+   \brief Constructor
+   \param budget : budget of visited states, running time and memory
+   \note when the budget is exceeded, the run is stopped, and the exceeded limit and the depth of the DFS stack are
+   recorded in its statistics (see tchecker::algorithms::stats_t::budget_status). The cycle flag is then only
+   meaningful when true
+   */
+  single_algorithm_t(tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{}) : _budget(budget) {}
+
   /*!
    \brief Check if a transition has an infinite run that satisfies a given set
    of labels and build the corresponding graph
@@ -417,7 +445,7 @@ public:
       initial_node->initial(true);
       initial_node->final(accepting(initial_node, ts, labels));
       couv_dfs(initial_node, ts, graph, labels, stats);
-      if (stats.cycle())
+      if (stats.cycle() || stats.budget_exceeded())
         break;
     }
 
@@ -440,7 +468,7 @@ private:
    \param n : a node
    \post the DFS search in Couvreur's algorithm has been performed from n.
    stats.cycle() is true if an accepting cycle w.r.t labels has been found in
-   ts, and false otherwise
+   ts, and false otherwise, unless the budget has been exceeded
    graph contains the part of ts that has been explored
   */
   void couv_dfs(node_sptr_t & n, TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
@@ -448,6 +476,9 @@ private:
   {
     push(n, ts, graph, labels, stats);
     while (!_todo.empty()) {
+      if (tchecker::algorithms::budget_exceeded(_budget, stats.visited_states(), _todo.size(), stats))
+        break;
+
       auto && [n, succ] = _todo.top();
       if (succ.empty()) {
         if (_roots.top().n == n)
@@ -620,6 +651,7 @@ private:
   std::stack<todo_stack_entry_t> _todo;   /*!< todo stack */
   std::stack<roots_stack_entry_t> _roots; /*!< roots stack */
   std::stack<node_sptr_t> _active;        /*!< active stack */
+  tchecker::algorithms::budget_t _budget; /*!< Budget of the runs */
 };
 
 } // namespace couvscc
@@ -0,0 +1,312 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ALGORITHMS_COUVREUR_SCC_OWCTY_HH
+#define TCHECKER_ALGORITHMS_COUVREUR_SCC_OWCTY_HH
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/budget.hh"
+#include "tchecker/algorithms/couvreur_scc/graph.hh"
+#include "tchecker/algorithms/couvreur_scc/stats.hh"
+#include "tchecker/algorithms/reach/algorithm.hh"
+#include "tchecker/graph/compact_adjacency.hh"
+#include "tchecker/ts/static.hh"
+#include "tchecker/utils/parallel.hh"
+
+/*!
+ \file owcty.hh
+ \brief Multi-core breadth-first liveness algorithm (One-Way-Catch-Them-Young)
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace couvscc {
+
+/*!
+ \class owcty_algorithm_t
+ \brief Multi-core breadth-first liveness algorithm for generalized Büchi conditions
+ \tparam TS : type of transition system, should implement tchecker::ts::fwd_t and tchecker::ts::inspector_t, and
+ have methods clone(state) and clone(transition) that copy a state and a transition allocated by another transition
+ system over the same system
+ \tparam GRAPH : type of graph, should derive from tchecker::graph::reachability::graph_t, and nodes of type
+ GRAPH::shared_node_t should derive from tchecker::algorithms::couvscc::node_t and have methods state_ptr() and
+ state() that yield the corresponding state in TS
+ \note Our implementation is based on the OWCTY algorithm in:
+ "Designing Fast LTL Model Checking Algorithms for Many-Core GPUs",
+ Jiri Barnat, Petr Bauch, Lubos Brim and Milan Ceska
+ Journal of Parallel and Distributed Computing, 2012
+
+ The state-space of the transition system is fully explored first, by the level-synchronous parallel breadth-first
+ search of tchecker::algorithms::reach::algorithm_t::run_bfs. The graph is then frozen into compressed sparse rows
+ (see tchecker::graph::reachability::graph_t::freeze_outgoing), and the set S of the states that may lie on an
+ accepting cycle is computed as follows, where F_j is the set of states with the j-th accepting label:
+
+ S := all states
+ repeat
+   for each accepting label j
+     S := states reachable from S & F_j within S
+   while some state in S has no predecessor in S
+     remove the states without predecessor from S
+ until S does not change
+
+ There is an accepting cycle if and only if S is not empty. Each reachability and each elimination is a breadth-first
+ traversal of S, where the nodes of a level are processed in parallel. A node is added to the next level by the
+ thread that claims it (reachability) or that removes its last predecessor from S (elimination) with an atomic
+ operation, hence the successors of the nodes are scanned once in each traversal
+ */
+template <class TS, class GRAPH> class owcty_algorithm_t {
+  static_assert(tchecker::ts::is_static_v<TS>, "TS should be a final transition system, see tchecker::ts::is_static_t");
+
+public:
+  using node_sptr_t = typename GRAPH::node_sptr_t;
+
+  /*!
+   \brief Number of nodes in the chunks of a level processed by one thread
+   */
+  static constexpr std::size_t CHUNK_SIZE = 1024;
+
+  /*!
+   \brief Constructor
+   \param budget : budget of visited states, running time and memory
+   \note when the budget is exceeded, the run is stopped, and the exceeded limit is recorded in the statistics (see
+   tchecker::algorithms::stats_t::budget_status). The cycle flag is then always false
+   */
+  owcty_algorithm_t(tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{}) : _budget(budget) {}
+
+  /*!
+   \brief Check if a transition system has an infinite run that satisfies a given set of labels and build the
+   corresponding graph
+   \param ts : a transition system
+   \param graph : a graph
+   \param workers : transition systems of the workers
+   \param labels : accepting labels
+   \pre graph is built from ts, and workers are transition systems over the same system as ts, configured as ts,
+   which share no component with ts and with each other (see tchecker::ts::NO_SHARING)
+   \post graph is the full state-space of ts. Initial nodes have been marked in graph, as well as final nodes, whose
+   labels include the accepting labels. The state-space has been explored and analysed by max(1, workers.size())
+   threads
+   \return statistics on the run
+   \note the successors are computed sequentially on ts if workers is empty
+   \note if labels is empty, no cycle is reported
+   */
+  tchecker::algorithms::couvscc::stats_t run(TS & ts, GRAPH & graph, std::vector<std::shared_ptr<TS>> const & workers,
+                                             boost::dynamic_bitset<> const & labels)
+  {
+    std::size_t const P = std::max<std::size_t>(1, workers.size());
+
+    tchecker::algorithms::couvscc::stats_t stats;
+
+    stats.set_start_time();
+
+    tchecker::algorithms::reach::algorithm_t<TS, GRAPH> exploration{_budget};
+    tchecker::algorithms::reach::stats_t exploration_stats =
+        exploration.run_bfs(ts, graph, boost::dynamic_bitset<>{}, workers);
+
+    stats.visited_states() = exploration_stats.visited_states();
+    stats.visited_transitions() = exploration_stats.visited_transitions();
+    stats.stored_states() = graph.nodes_count();
+
+    if (exploration_stats.budget_exceeded()) {
+      stats.budget_status() = exploration_stats.budget_status();
+      stats.frontier_size() = exploration_stats.frontier_size();
+      stats.set_end_time();
+      return stats;
+    }
+
+    tchecker::graph::compact_adjacency_t adjacency;
+    std::vector<node_sptr_t> nodes;
+    graph.freeze_outgoing(adjacency, nodes);
+
+    // accepting nodes of each label
+    std::vector<index_t> label_ids;
+    for (std::size_t j = labels.find_first(); j != boost::dynamic_bitset<>::npos; j = labels.find_next(j))
+      label_ids.push_back(static_cast<index_t>(j));
+    std::vector<std::vector<index_t>> accepting(label_ids.size());
+
+    std::vector<std::uint8_t> in_set(nodes.size(), 0);
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+      if (nodes[i].ptr() == nullptr)
+        continue;
+      in_set[i] = 1;
+      ++count;
+      boost::dynamic_bitset<> node_labels = ts.labels(nodes[i]->state_ptr());
+      nodes[i]->final(!labels.none() && labels.is_subset_of(node_labels));
+      for (std::size_t j = 0; j < label_ids.size(); ++j)
+        if (node_labels[label_ids[j]])
+          accepting[j].push_back(static_cast<index_t>(i));
+    }
+
+    if (labels.none()) {
+      stats.set_end_time();
+      return stats;
+    }
+
+    std::vector<std::atomic<std::uint32_t>> counters(nodes.size());
+    std::size_t previous_count = 0;
+    do {
+      previous_count = count;
+      for (std::size_t j = 0; j < accepting.size() && count > 0; ++j)
+        count = reachability(adjacency, accepting[j], in_set, counters, P);
+      if (count > 0)
+        count = elimination(adjacency, in_set, counters, count, P);
+
+      if (tchecker::algorithms::budget_exceeded(_budget, stats.visited_states(), count, stats)) {
+        stats.set_end_time();
+        return stats;
+      }
+    } while (count > 0 && count != previous_count);
+
+    stats.cycle() = (count > 0);
+
+    stats.set_end_time();
+
+    return stats;
+  }
+
+private:
+  using index_t = tchecker::graph::compact_adjacency_t::index_t;
+
+  /*!
+   \brief Parallel loop over a level of a traversal
+   \param size : number of nodes in the level
+   \param threads : number of threads
+   \param f : function called as f(t, begin, end)
+   \post f(t, begin, end) has been called by thread t for chunks [begin, end) of at most CHUNK_SIZE nodes that
+   partition [0, size)
+   */
+  template <class F> static void for_chunks(std::size_t size, std::size_t threads, F && f)
+  {
+    std::size_t const chunks = (size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    tchecker::parallel_for(chunks, threads,
+                           [&](std::size_t t, std::size_t c) { f(t, c * CHUNK_SIZE, std::min(size, (c + 1) * CHUNK_SIZE)); });
+  }
+
+  /*!
+   \brief Concatenate the next levels of the threads
+   \param next : next levels of the threads
+   \param level : a level
+   \post level is the concatenation of the vectors in next, which have been cleared
+   */
+  static void join(std::vector<std::vector<index_t>> & next, std::vector<index_t> & level)
+  {
+    level.clear();
+    for (std::vector<index_t> & v : next) {
+      level.insert(level.end(), v.begin(), v.end());
+      v.clear();
+    }
+  }
+
+  /*!
+   \brief Reachability within a set of nodes
+   \param adjacency : outgoing adjacency of the graph
+   \param accepting : accepting nodes
+   \param in_set : membership to the set S
+   \param counters : counters of the nodes
+   \param threads : number of threads
+   \return size of S after the reachability
+   \post S has been restricted to the nodes reachable from the nodes of accepting in S, with paths within S
+   */
+  static std::size_t reachability(tchecker::graph::compact_adjacency_t const & adjacency,
+                                  std::vector<index_t> const & accepting, std::vector<std::uint8_t> & in_set,
+                                  std::vector<std::atomic<std::uint32_t>> & counters, std::size_t threads)
+  {
+    for (std::atomic<std::uint32_t> & c : counters)
+      c.store(0, std::memory_order_relaxed);
+
+    std::vector<index_t> level;
+    for (index_t n : accepting)
+      if (in_set[n] && counters[n].exchange(1, std::memory_order_relaxed) == 0)
+        level.push_back(n);
+
+    std::size_t count = 0;
+    std::vector<std::vector<index_t>> next(threads);
+    while (!level.empty()) {
+      count += level.size();
+      for_chunks(level.size(), threads, [&](std::size_t t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+          for (index_t m : adjacency.neighbours(level[i]))
+            if (in_set[m] && counters[m].load(std::memory_order_relaxed) == 0 &&
+                counters[m].exchange(1, std::memory_order_relaxed) == 0)
+              next[t].push_back(m);
+      });
+      join(next, level);
+    }
+
+    for (std::size_t n = 0; n < in_set.size(); ++n)
+      in_set[n] = (in_set[n] && counters[n].load(std::memory_order_relaxed) != 0);
+
+    return count;
+  }
+
+  /*!
+   \brief Elimination of the nodes without predecessor in a set of nodes
+   \param adjacency : outgoing adjacency of the graph
+   \param in_set : membership to the set S
+   \param counters : counters of the nodes
+   \param count : size of S
+   \param threads : number of threads
+   \return size of S after the elimination
+   \post the nodes without predecessor in S have been removed from S, until every node in S has a predecessor in S
+   */
+  static std::size_t elimination(tchecker::graph::compact_adjacency_t const & adjacency, std::vector<std::uint8_t> & in_set,
+                                 std::vector<std::atomic<std::uint32_t>> & counters, std::size_t count, std::size_t threads)
+  {
+    // number of incoming edges from S of each node in S
+    for (std::atomic<std::uint32_t> & c : counters)
+      c.store(0, std::memory_order_relaxed);
+    for_chunks(in_set.size(), threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+      for (std::size_t n = begin; n < end; ++n)
+        if (in_set[n])
+          for (index_t m : adjacency.neighbours(static_cast<index_t>(n)))
+            if (in_set[m])
+              counters[m].fetch_add(1, std::memory_order_relaxed);
+    });
+
+    std::vector<std::vector<index_t>> next(threads);
+    std::vector<index_t> level;
+    for_chunks(in_set.size(), threads, [&](std::size_t t, std::size_t begin, std::size_t end) {
+      for (std::size_t n = begin; n < end; ++n)
+        if (in_set[n] && counters[n].load(std::memory_order_relaxed) == 0)
+          next[t].push_back(static_cast<index_t>(n));
+    });
+    join(next, level);
+
+    // the nodes of a level are removed from S before the level is processed, so that S is only read by the threads
+    while (!level.empty()) {
+      count -= level.size();
+      for (index_t n : level)
+        in_set[n] = 0;
+      for_chunks(level.size(), threads, [&](std::size_t t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+          for (index_t m : adjacency.neighbours(level[i]))
+            if (in_set[m] && counters[m].fetch_sub(1, std::memory_order_relaxed) == 1)
+              next[t].push_back(m);
+      });
+      join(next, level);
+    }
+
+    return count;
+  }
+
+  tchecker::algorithms::budget_t _budget; /*!< Budget of the runs */
+};
+
+} // end of namespace couvscc
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_COUVREUR_SCC_OWCTY_HH
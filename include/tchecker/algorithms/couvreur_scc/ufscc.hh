@@ -0,0 +1,511 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ALGORITHMS_COUVREUR_SCC_UFSCC_HH
+#define TCHECKER_ALGORITHMS_COUVREUR_SCC_UFSCC_HH
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/budget.hh"
+#include "tchecker/algorithms/couvreur_scc/graph.hh"
+#include "tchecker/algorithms/couvreur_scc/stats.hh"
+#include "tchecker/algorithms/search_order.hh"
+#include "tchecker/ts/static.hh"
+#include "tchecker/utils/parallel.hh"
+
+/*!
+ \file ufscc.hh
+ \brief Multi-core SCC-decomposition-based liveness algorithm
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace couvscc {
+
+/*!
+ \class ufscc_algorithm_t
+ \brief Multi-core SCC-decomposition-based liveness algorithm for generalized Büchi conditions
+ \tparam TS : type of transition system, should implement tchecker::ts::fwd_t and tchecker::ts::inspector_t, and
+ have methods clone(state) and clone(transition) that copy a state and a transition allocated by another transition
+ system over the same system
+ \tparam GRAPH : type of graph, should derive from tchecker::graph::reachability_graph_t, and nodes of type
+ GRAPH::shared_node_t should derive from tchecker::algorithms::couvscc::node_t and have methods state_ptr() and
+ state() that yield the corresponding state in TS
+ \note Our implementation is based on the UFSCC algorithm in:
+ "Multi-Core On-The-Fly SCC Decomposition",
+ Vincent Bloemen, Alfons Laarman and Jaco van de Pol
+ PPoPP 2016
+
+ Workers share a union-find structure over the visited states. Each set is a partial SCC, with the set of
+ workers that have claimed it, the union of the labels of its states, and the list of its states that have not
+ been fully explored yet. Each worker p runs the following DFS, with its own order of successors:
+
+ procedure ufscc_p(v)
+   push(R_p, v)
+   while (v' := pick_from_list(v)) != none do
+     for each w in post_p(v')
+       if dead(w) then
+         continue
+       else if not claimed(w, p) then
+         claim(w, p)
+         ufscc_p(w)
+       else
+         while not same_set(v, w) do
+           r := pop(R_p)
+           union(r, top(R_p))
+         if labels are included in the labels of the set of v then
+           report cycle
+     remove_from_list(v')
+   if top(R_p) = v then
+     mark_dead(v)
+     pop(R_p)
+
+ Claimed sets that are not dead lie on the stack R_p of the claiming worker, hence an edge to such a set closes
+ a cycle in the partial SCC of v: the labels of the set are then checked.
+
+ We have implemented an iterative translation of the recursive procedure above. The union-find structure and
+ the graph are protected by a single lock, while the successors of the states are computed in parallel: each
+ worker copies the states that it expands into its own transition system, and only touches objects allocated by
+ that transition system outside the lock. Each state is expanded once: its successors are added to the graph,
+ with the corresponding edges, by the first worker that expands it, and they are reused by the other workers
+ */
+template <class TS, class GRAPH> class ufscc_algorithm_t {
+  static_assert(tchecker::ts::is_static_v<TS>, "TS should be a final transition system, see tchecker::ts::is_static_t");
+
+public:
+  using node_sptr_t = typename GRAPH::node_sptr_t;
+
+  /*!
+   \brief Constructor
+   \param budget : budget of visited states, running time and memory (shared by all workers)
+   \param seed : seed of the orders of successors
+   \note when the budget is exceeded, the run is stopped, and the exceeded limit and the depth of the DFS stack of
+   the worker that has exceeded it are recorded in the statistics (see tchecker::algorithms::stats_t::budget_status).
+   The cycle flag is then only meaningful when true
+   */
+  ufscc_algorithm_t(tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{},
+                    std::mt19937_64::result_type seed = tchecker::algorithms::RANDOM_SEARCH_SEED)
+      : _budget(budget), _seed(seed)
+  {
+  }
+
+  /*!
+   \brief Check if a transition system has an infinite run that satisfies a given set of labels and build the
+   corresponding graph
+   \param ts : a transition system
+   \param graph : a graph
+   \param workers : transition systems of the workers
+   \param labels : accepting labels
+   \pre graph is built from ts, workers is not empty, and workers are transition systems over the same system as
+   ts, which share no component with ts and with each other
+   \post P = workers.size() workers have run the UFSCC algorithm in parallel on ts, until a cycle that satisfies
+   labels is reached (if any). graph is built from the states visited by the workers: a node is created for each
+   reached state in ts, and an edge is created for each transition from an expanded state in ts. Initial and final
+   nodes have been marked in graph. Worker 0 visits successors in the order computed by ts, and the other workers
+   visit them in a random order seeded by the seed of the algorithm and the index of the worker
+   \return statistics on the run
+   \throw std::invalid_argument : if workers is empty
+   \note if labels is empty, graph is the full state-space of ts
+   */
+  tchecker::algorithms::couvscc::stats_t run(TS & ts, GRAPH & graph, std::vector<std::shared_ptr<TS>> const & workers,
+                                             boost::dynamic_bitset<> const & labels)
+  {
+    std::size_t const P = workers.size();
+    if (P == 0)
+      throw std::invalid_argument("UFSCC requires at least one worker");
+
+    tchecker::algorithms::couvscc::stats_t stats;
+
+    stats.set_start_time();
+
+    shared_t shared{ts, graph, labels, P, stats};
+
+    std::vector<typename TS::sst_t> sst;
+    ts.initial(sst);
+    std::vector<std::size_t> initial;
+    for (auto && [status, s, t] : sst) {
+      std::size_t const id = shared.add_node(s);
+      shared.entries[id].node->initial(true);
+      initial.push_back(id);
+    }
+    sst.clear();
+
+    tchecker::parallel_for(P, P, [&](std::size_t, std::size_t p) {
+      worker_t worker{*workers[p], shared, _budget, _seed + p, p != 0, p};
+      worker.run(initial);
+    });
+
+    stats.stored_states() = graph.nodes_count();
+
+    shared.entries.clear();
+
+    stats.set_end_time();
+
+    return stats;
+  }
+
+private:
+  using const_state_sptr_t = typename TS::fwd_t::const_state_t;
+  using shared_state_t = std::remove_reference_t<decltype(*std::declval<const_state_sptr_t const &>())>;
+
+  static constexpr std::size_t const NO_STATE = std::numeric_limits<std::size_t>::max(); /*!< No state */
+
+  /*!
+   \brief Entry of the union-find structure
+   \note workers, labels and pending are only meaningful for the root of a set
+   */
+  struct entry_t {
+    node_sptr_t node;                 /*!< Node of the state */
+    std::size_t parent;               /*!< Parent in the union-find structure */
+    std::size_t size;                 /*!< Size of the set (root only) */
+    bool dead;                        /*!< Dead flag: the SCC of the state is complete (root only) */
+    bool done;                        /*!< Done flag: all successors of the state have been explored */
+    bool expanded;                    /*!< Expanded flag: successors of the state are in the graph */
+    boost::dynamic_bitset<> workers;  /*!< Workers that have claimed the set (root only) */
+    boost::dynamic_bitset<> labels;   /*!< Labels of the states in the set (root only) */
+    std::vector<std::size_t> pending; /*!< States of the set that may not be done (root only) */
+    std::vector<std::size_t> succ;    /*!< Successors of the state (if expanded) */
+  };
+
+  /*!
+   \brief Data shared by the workers
+   \note all members are protected by mutex, except stop
+   */
+  struct shared_t {
+    TS & ts;                                       /*!< Transition system of the graph */
+    GRAPH & graph;                                 /*!< Graph */
+    boost::dynamic_bitset<> const & labels;        /*!< Accepting labels */
+    std::size_t workers_count;                     /*!< Number of workers */
+    tchecker::algorithms::couvscc::stats_t & stats; /*!< Statistics */
+    std::vector<entry_t> entries;                  /*!< Union-find structure: id -> entry */
+    std::mutex mutex;                              /*!< Lock */
+    std::atomic<bool> stop{false};                 /*!< Stop flag */
+
+    /*!
+     \brief Constructor
+     \param ts : transition system
+     \param graph : graph
+     \param labels : accepting labels
+     \param workers_count : number of workers
+     \param stats : statistics
+     */
+    shared_t(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels, std::size_t workers_count,
+             tchecker::algorithms::couvscc::stats_t & stats)
+        : ts(ts), graph(graph), labels(labels), workers_count(workers_count), stats(stats)
+    {
+    }
+
+    /*!
+     \brief Add a node
+     \param s : a state of ts
+     \return identifier of the node of s in the union-find structure
+     \post if s has no node in graph, a new node has been added to graph, with final flag if its labels include
+     the accepting labels, and a singleton set has been added to the union-find structure for that node
+     \note the DFS number of a node is its identifier plus 1
+     */
+    template <class STATE_SPTR> std::size_t add_node(STATE_SPTR const & s)
+    {
+      auto && [is_new_node, n] = graph.add_node(s);
+      if (!is_new_node)
+        return n->dfsnum() - 1;
+
+      std::size_t const id = entries.size();
+      n->dfsnum() = static_cast<unsigned int>(id + 1);
+      boost::dynamic_bitset<> node_labels = ts.labels(n->state_ptr());
+      n->final(!labels.none() && labels.is_subset_of(node_labels));
+
+      entries.emplace_back();
+      entry_t & e = entries.back();
+      e.node = n;
+      e.parent = id;
+      e.size = 1;
+      e.dead = false;
+      e.done = false;
+      e.expanded = false;
+      e.workers.resize(workers_count);
+      e.labels = std::move(node_labels);
+      e.pending.push_back(id);
+      return id;
+    }
+
+    /*!
+     \brief Find with path halving
+     \param id : a state
+     \return root of the set of id
+     */
+    std::size_t find(std::size_t id)
+    {
+      while (entries[id].parent != id) {
+        entries[id].parent = entries[entries[id].parent].parent;
+        id = entries[id].parent;
+      }
+      return id;
+    }
+
+    /*!
+     \brief Union by size
+     \param id1 : a state
+     \param id2 : a state
+     \post the sets of id1 and id2 have been merged, with the union of their workers, labels and pending lists
+     */
+    void unite(std::size_t id1, std::size_t id2)
+    {
+      std::size_t r1 = find(id1), r2 = find(id2);
+      if (r1 == r2)
+        return;
+      if (entries[r1].size < entries[r2].size)
+        std::swap(r1, r2);
+      entry_t & root = entries[r1];
+      entry_t & other = entries[r2];
+      other.parent = r1;
+      root.size += other.size;
+      root.workers |= other.workers;
+      root.labels |= other.labels;
+      root.pending.insert(root.pending.end(), other.pending.begin(), other.pending.end());
+      other.workers.clear();
+      other.labels.clear();
+      other.pending.clear();
+      other.pending.shrink_to_fit();
+    }
+  };
+
+  /*!
+   \brief Frame of the DFS of a worker
+   */
+  struct frame_t {
+    std::size_t v;                 /*!< Root state of the call ufscc_p(v) */
+    std::size_t current;           /*!< State picked from the list of v (NO_STATE if none) */
+    std::vector<std::size_t> succ; /*!< Successors of current in the order of the worker */
+    std::size_t next;              /*!< Index of the next successor in succ */
+  };
+
+  /*!
+   \class worker_t
+   \brief Worker of the UFSCC algorithm
+   */
+  class worker_t {
+  public:
+    /*!
+     \brief Constructor
+     \param ts : transition system of the worker
+     \param shared : shared data
+     \param budget : budget of the run
+     \param seed : seed of the order of successors
+     \param shuffle : true if successors are visited in a random order, false otherwise
+     \param p : index of the worker
+     */
+    worker_t(TS & ts, shared_t & shared, tchecker::algorithms::budget_t const & budget,
+             std::mt19937_64::result_type seed, bool shuffle, std::size_t p)
+        : _ts(ts), _shared(shared), _budget(budget), _generator(seed), _shuffle(shuffle), _p(p)
+    {
+    }
+
+    /*!
+     \brief Run the worker
+     \param initial : initial states
+     \post a DFS has been run from each initial state that is not dead, until the stop flag is set. The stop flag
+     has been set if a cycle has been found or the budget has been exceeded
+     */
+    void run(std::vector<std::size_t> const & initial)
+    {
+      for (std::size_t s : initial) {
+        if (_shared.stop.load())
+          break;
+        {
+          std::lock_guard<std::mutex> lock{_shared.mutex};
+          entry_t & root = _shared.entries[_shared.find(s)];
+          if (root.dead || root.workers[_p])
+            continue;
+          root.workers[_p] = true;
+          ++_shared.stats.visited_states();
+          _roots.push_back(s);
+        }
+        _frames.push_back(frame_t{s, NO_STATE, {}, 0});
+        dfs();
+      }
+      _frames.clear();
+      _roots.clear();
+    }
+
+  private:
+    /*!
+     \brief DFS loop
+     \post the frames of the worker have been processed, until the stop flag is set
+     */
+    void dfs()
+    {
+      while (!_frames.empty()) {
+        if (_shared.stop.load(std::memory_order_relaxed))
+          return;
+
+        frame_t & top = _frames.back();
+        if (top.current == NO_STATE) {
+          if (!pick(top))
+            _frames.pop_back();
+        }
+        else if (top.next < top.succ.size())
+          visit(top, top.succ[top.next++]);
+        else {
+          std::lock_guard<std::mutex> lock{_shared.mutex};
+          _shared.entries[top.current].done = true;
+          top.current = NO_STATE;
+        }
+      }
+    }
+
+    /*!
+     \brief Pick a state from the list of the set of the root state of a frame
+     \param f : a frame with no current state
+     \return true if a state has been picked, false if all the states in the set of f.v are done
+     \post if a state has been picked, it is the current state of f, and its successors, in the order of this
+     worker, are the successors of f. Otherwise, f.v has been marked dead if it is on top of R_p
+     */
+    bool pick(frame_t & f)
+    {
+      typename GRAPH::shared_node_t const * node = nullptr;
+      {
+        std::lock_guard<std::mutex> lock{_shared.mutex};
+        std::size_t const r = _shared.find(f.v);
+        std::vector<std::size_t> & pending = _shared.entries[r].pending;
+        while (!pending.empty()) {
+          std::size_t const i = (_shuffle ? std::uniform_int_distribution<std::size_t>{0, pending.size() - 1}(_generator)
+                                          : pending.size() - 1);
+          if (!_shared.entries[pending[i]].done) {
+            f.current = pending[i];
+            break;
+          }
+          // done states are removed lazily
+          pending[i] = pending.back();
+          pending.pop_back();
+        }
+
+        if (f.current == NO_STATE) {
+          if (_roots.back() == f.v) {
+            _shared.entries[r].dead = true;
+            _roots.pop_back();
+          }
+          return false;
+        }
+
+        if (!_shared.entries[f.current].expanded)
+          node = _shared.entries[f.current].node.ptr();
+      }
+
+      if (node != nullptr)
+        expand(f.current, *node);
+
+      std::lock_guard<std::mutex> lock{_shared.mutex};
+      f.succ = _shared.entries[f.current].succ;
+      f.next = 0;
+      if (_shuffle)
+        std::shuffle(f.succ.begin(), f.succ.end(), _generator);
+      return true;
+    }
+
+    /*!
+     \brief Expand a state
+     \param id : a state
+     \param node : node of id
+     \post the successors of id have been added to the graph with the corresponding edges, unless id has been
+     expanded by another worker in the meantime
+     \note successors are computed outside the lock in the transition system of this worker: node is only read,
+     its reference counter is not modified
+     */
+    void expand(std::size_t id, typename GRAPH::shared_node_t const & node)
+    {
+      const_state_sptr_t src{_ts.clone(static_cast<shared_state_t const &>(node.state()))};
+      _ts.next(src, _sst);
+
+      std::lock_guard<std::mutex> lock{_shared.mutex};
+      entry_t & e = _shared.entries[id];
+      if (!e.expanded) {
+        for (auto && [status, s, t] : _sst) {
+          std::size_t const next_id = _shared.add_node(_shared.ts.clone(*s));
+          // add_node may reallocate entries
+          _shared.graph.add_edge(_shared.entries[id].node, _shared.entries[next_id].node, *_shared.ts.clone(*t));
+          _shared.entries[id].succ.push_back(next_id);
+        }
+        _shared.entries[id].expanded = true;
+      }
+      _sst.clear();
+    }
+
+    /*!
+     \brief Visit a successor
+     \param f : a frame
+     \param w : a successor of the current state of f
+     \post w has been skipped if dead, pushed on the DFS if not claimed by this worker, and its set has been merged
+     with the set of f.v otherwise. The stop flag has been set if an accepting cycle has been found or the budget
+     has been exceeded
+     */
+    void visit(frame_t & f, std::size_t w)
+    {
+      std::lock_guard<std::mutex> lock{_shared.mutex};
+      ++_shared.stats.visited_transitions();
+
+      entry_t & root = _shared.entries[_shared.find(w)];
+      if (root.dead)
+        return;
+
+      if (!root.workers[_p]) {
+        root.workers[_p] = true;
+        ++_shared.stats.visited_states();
+        if (tchecker::algorithms::budget_exceeded(_budget, _shared.stats.visited_states(), _frames.size(),
+                                                  _shared.stats)) {
+          _shared.stop.store(true);
+          return;
+        }
+        _roots.push_back(w);
+        _frames.push_back(frame_t{w, NO_STATE, {}, 0}); // invalidates f
+        return;
+      }
+
+      while (_shared.find(f.v) != _shared.find(w)) {
+        std::size_t const r = _roots.back();
+        _roots.pop_back();
+        _shared.unite(r, _roots.back());
+      }
+
+      if (!_shared.labels.none() && _shared.labels.is_subset_of(_shared.entries[_shared.find(f.v)].labels)) {
+        _shared.stats.cycle() = true;
+        _shared.stop.store(true);
+      }
+    }
+
+    TS & _ts;                                /*!< Transition system */
+    shared_t & _shared;                      /*!< Shared data */
+    tchecker::algorithms::budget_t _budget;  /*!< Budget (copy: budgets are not shared by threads) */
+    std::mt19937_64 _generator;              /*!< Generator of the order of successors */
+    bool _shuffle;                           /*!< Random order of successors */
+    std::size_t _p;                          /*!< Index of the worker */
+    std::vector<frame_t> _frames;            /*!< DFS stack */
+    std::vector<std::size_t> _roots;         /*!< Stack R_p */
+    std::vector<typename TS::sst_t> _sst;    /*!< Successors buffer */
+  };
+
+  tchecker::algorithms::budget_t _budget; /*!< Budget of the run */
+  std::mt19937_64::result_type _seed;     /*!< Seed of the orders of successors */
+};
+
+} // namespace couvscc
+
+} // namespace algorithms
+
+} // namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_COUVREUR_SCC_UFSCC_HH
@@ -15,8 +15,10 @@
 
 #include <boost/dynamic_bitset.hpp>
 
+#include "tchecker/algorithms/budget.hh"
 #include "tchecker/algorithms/covreach/stats.hh"
 #include "tchecker/graph/subsumption_graph.hh"
+#include "tchecker/ts/static.hh"
 #include "tchecker/waiting/factory.hh"
 
 namespace tchecker {
@@ -47,9 +49,26 @@ enum covering_t {
  cover itself
 */
 template <class TS, class GRAPH> class algorithm_t {
+  static_assert(tchecker::ts::is_static_v<TS>, "TS should be a final transition system, see tchecker::ts::is_static_t");
+
 public:
   using node_sptr_t = typename GRAPH::node_sptr_t;
 
+  /*!
+   \brief Constructor
+   \param budget : budget of visited states, running time and memory
+   \note when the budget is exceeded, exploration is stopped and the exceeded limit and the number of waiting
+   nodes are recorded in the statistics of the run (see tchecker::algorithms::stats_t::budget_status). The graph
+   built so far is kept
+   */
+  algorithm_t(tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{}) : _budget(budget) {}
+
+  /*!
+   \brief Accessor
+   \return budget of the runs
+   */
+  inline tchecker::algorithms::budget_t const & budget() const { return _budget; }
+
   /*!
    \brief Build a covering reachability graph of a transition system from its
    initial states
@@ -59,9 +78,10 @@ public:
    \param graph : a graph
    \param labels : accepting labels
    \param policy : waiting list policy
+   \param priority : priority of nodes (only used by priority queue policies)
    \post graph is a covering reachability graph of ts built from its initial
    states, until a state that satisfies labels is reached if any, or until the
-   entire state-space has been exhausted.
+   entire state-space has been exhausted, or until the budget is exceeded.
    A node is created for each maximal state in ts, and an edge is created for
    each transition in ts. Actual edges correspond to transitions in ts. A
    subsumption edge from node n1 to node n2 means that the actual successor of
@@ -69,12 +89,15 @@ public:
    The order in which the nodes of ts are visited depends on policy.
    \return Statistics on the run
    \note if labels is empty, the algorithm explores the entire state-space
+   \throw std::invalid_argument : if policy is a priority queue policy and priority is empty
   */
   template <enum tchecker::algorithms::covreach::covering_t COVERING = tchecker::algorithms::covreach::COVERING_FULL>
   tchecker::algorithms::covreach::stats_t run(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
-                                              enum tchecker::waiting::policy_t policy)
+                                              enum tchecker::waiting::policy_t policy,
+                                              tchecker::waiting::priority_function_t<node_sptr_t> const & priority = nullptr)
   {
-    std::unique_ptr<tchecker::waiting::waiting_t<node_sptr_t>> waiting{tchecker::waiting::factory<node_sptr_t>(policy)};
+    std::unique_ptr<tchecker::waiting::waiting_t<node_sptr_t>> waiting{
+        tchecker::waiting::factory<node_sptr_t>(policy, priority)};
     tchecker::algorithms::covreach::stats_t stats;
     std::vector<node_sptr_t> nodes, covered_nodes;
 
@@ -86,6 +109,9 @@ public:
     nodes.clear();
 
     while (!waiting->empty()) {
+      if (tchecker::algorithms::budget_exceeded(_budget, stats.visited_states(), waiting->size(), stats))
+        break;
+
       node_sptr_t node = waiting->first();
       waiting->remove_first();
 
@@ -114,6 +140,8 @@ public:
     waiting->clear();
 
     stats.stored_states() = graph.nodes_count();
+    stats.cover_checks() = graph.cover_checks();
+    stats.summary_checks() = graph.summary_checks();
 
     stats.set_end_time();
 
@@ -226,6 +254,9 @@ public:
   {
     return !labels.none() && labels.is_subset_of(ts.labels(n->state_ptr())) && ts.is_valid_final(n->state_ptr());
   }
+
+private:
+  tchecker::algorithms::budget_t _budget; /*!< Budget of the runs */
 };
 
 } // end of namespace covreach
@@ -0,0 +1,225 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ALGORITHMS_COVREACH_BACKWARD_HH
+#define TCHECKER_ALGORITHMS_COVREACH_BACKWARD_HH
+
+/*!
+ \file backward.hh
+ \brief Backward reachability algorithm with covering
+ */
+
+#include <iterator>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/covreach/algorithm.hh"
+#include "tchecker/algorithms/covreach/stats.hh"
+#include "tchecker/graph/subsumption_graph.hh"
+#include "tchecker/ts/static.hh"
+#include "tchecker/waiting/factory.hh"
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace covreach {
+
+/*!
+ \class backward_algorithm_t
+ \brief Backward covering reachability algorithm
+ \tparam TS : type of transition system, should implement tchecker::ts::bwd_t and tchecker::ts::inspector_t
+ \tparam GRAPH : type of graph, should derive from tchecker::graph::subsumption::graph_t, and nodes of type
+ GRAPH::shared_node_t should have a method state_ptr() that yields a pointer to the corresponding state in TS.
+ \note the graph is built from the final states of TS through predecessors, and its edges are oriented forward: an
+ edge from n1 to n2 means that n1 is included in the predecessors of n2 along the tuple of edges of the edge. Hence
+ paths of the graph are forward paths of TS.
+ \note For correctness of the algorithm, the covering relation over nodes in GRAPH should be a trace inclusion
+ w.r.t. predecessors (e.g. zone inclusion), and it should be irreflexive: a node should not cover itself
+*/
+template <class TS, class GRAPH> class backward_algorithm_t {
+  static_assert(tchecker::ts::is_static_v<TS>, "TS should be a final transition system, see tchecker::ts::is_static_t");
+
+public:
+  using node_sptr_t = typename GRAPH::node_sptr_t;
+
+  /*!
+   \brief Build a backward covering reachability graph of a transition system from its final states
+   \tparam COVERING : type of covering. Set to COVERING_LEAF_NODES to cover only non-maximal leaf nodes. Set to
+   COVERING_FULL to cover all non-maximal nodes.
+   \param ts : a transition system
+   \param graph : a graph
+   \param labels : accepting labels
+   \param policy : waiting list policy
+   \param priority : priority of nodes (only used by priority queue policies)
+   \post graph is a covering reachability graph of ts built backward from its final states w.r.t. labels (which have
+   the final flag), until a state that contains an initial state of ts is reached (which has the initial flag) if
+   any, or until all the states that reach a final state have been visited.
+   A node is created for each maximal state, and an actual edge is created from each maximal predecessor to the
+   node it has been computed from. Predecessors that are covered by a node in graph have no node and no edge. When
+   a node covers nodes that are already in graph, their incoming edges are moved to it as subsumption edges.
+   The order in which the nodes of ts are visited depends on policy.
+   \return Statistics on the run
+   \note if labels is empty, no state is final and nothing is explored
+   \throw std::invalid_argument : if policy is a priority queue policy and priority is empty
+  */
+  template <enum tchecker::algorithms::covreach::covering_t COVERING = tchecker::algorithms::covreach::COVERING_FULL>
+  tchecker::algorithms::covreach::stats_t run(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
+                                              enum tchecker::waiting::policy_t policy,
+                                              tchecker::waiting::priority_function_t<node_sptr_t> const & priority = nullptr)
+  {
+    std::unique_ptr<tchecker::waiting::waiting_t<node_sptr_t>> waiting{
+        tchecker::waiting::factory<node_sptr_t>(policy, priority)};
+    tchecker::algorithms::covreach::stats_t stats;
+    std::vector<node_sptr_t> nodes, covered_nodes;
+
+    stats.set_start_time();
+
+    if (!labels.none())
+      expand_final_nodes(ts, graph, labels, nodes, stats);
+    for (node_sptr_t const & n : nodes)
+      waiting->insert(n);
+    nodes.clear();
+
+    while (!waiting->empty()) {
+      node_sptr_t node = waiting->first();
+      waiting->remove_first();
+
+      ++stats.visited_states();
+
+      if (ts.is_initial(node->state_ptr())) {
+        node->initial(true);
+        stats.reachable() = true;
+        break;
+      }
+
+      expand_prev_nodes(node, ts, graph, nodes, stats);
+
+      for (node_sptr_t const & prev_node : nodes) {
+        waiting->insert(prev_node);
+        if constexpr (COVERING == tchecker::algorithms::covreach::COVERING_FULL) {
+          remove_covered_nodes(graph, prev_node, covered_nodes, stats);
+          for (node_sptr_t const & covered_node : covered_nodes)
+            waiting->remove(covered_node);
+          covered_nodes.clear();
+        }
+      }
+      nodes.clear();
+    }
+
+    waiting->clear();
+
+    stats.stored_states() = graph.nodes_count();
+    stats.cover_checks() = graph.cover_checks();
+    stats.summary_checks() = graph.summary_checks();
+
+    stats.set_end_time();
+
+    return stats;
+  }
+
+  /*!
+   \brief Create nodes for final states
+   \param ts : transition system
+   \param graph : a subsumption graph
+   \param labels : accepting labels
+   \param final_nodes : nodes container
+   \param stats : statistics
+   \post A node with the final flag has been created in graph for each final state of ts w.r.t. labels which is
+   maximal w.r.t. the node covering in graph. All these maximal nodes have been added to final_nodes.
+   All covered final nodes have been counted in stats
+   */
+  void expand_final_nodes(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
+                          std::vector<typename GRAPH::node_sptr_t> & final_nodes,
+                          tchecker::algorithms::covreach::stats_t & stats)
+  {
+    std::vector<typename TS::sst_t> sst;
+    typename GRAPH::node_sptr_t covering_node;
+
+    ts.final(labels, sst);
+    for (auto && [status, s, t] : sst) {
+      typename GRAPH::node_sptr_t n = graph.add_node(s);
+      n->final(true);
+      if (graph.is_covered(n, covering_node)) {
+        graph.remove_node(n);
+        ++stats.covered_states();
+      }
+      else
+        final_nodes.push_back(n);
+    }
+  }
+
+  /*!
+   \brief Create predecessor nodes of a node
+   \param node : a node
+   \param ts : a transition system
+   \param graph : a subsumption graph
+   \param prev_nodes : nodes container
+   \param stats : statistics
+   \post A node has been created in the graph for each predecessor of node that is maximal in graph. An actual edge
+   has been created from each maximal predecessor to node. All maximal predecessors have been added to prev_nodes.
+   All covered predecessor nodes have been counted in stats.
+   \note no edge is created for covered predecessors: the covering node is not included in the predecessors of node
+   in general
+   */
+  void expand_prev_nodes(typename GRAPH::node_sptr_t const & node, TS & ts, GRAPH & graph,
+                         std::vector<typename GRAPH::node_sptr_t> & prev_nodes, tchecker::algorithms::covreach::stats_t & stats)
+  {
+    std::vector<typename TS::sst_t> sst;
+    typename GRAPH::node_sptr_t covering_node;
+
+    ts.prev(node->state_ptr(), sst);
+    for (auto && [status, s, t] : sst) {
+      ++stats.visited_transitions();
+      typename GRAPH::node_sptr_t prev_node = graph.add_node(s);
+      if (graph.is_covered(prev_node, covering_node)) {
+        graph.remove_node(prev_node);
+        ++stats.covered_states();
+      }
+      else {
+        graph.add_edge(prev_node, node, tchecker::graph::subsumption::EDGE_ACTUAL, *t);
+        prev_nodes.push_back(prev_node);
+      }
+    }
+  }
+
+  /*!
+   \brief Remove non-maximal nodes
+   \param graph : a subsumption graph
+   \param node : a node
+   \param covered_nodes : a container of nodes
+   \param stats : statistics
+   \post All the nodes in graph that are covered by node have been removed from graph and added to covered_nodes.
+   All incoming edges to covered nodes have been transformed into incoming subsumption edges of node (the source of
+   each such edge is included in the predecessors of the covered node, hence in the predecessors of node).
+   Removed nodes have been counted in stats
+  */
+  void remove_covered_nodes(GRAPH & graph, typename GRAPH::node_sptr_t const & node,
+                            std::vector<typename GRAPH::node_sptr_t> & covered_nodes,
+                            tchecker::algorithms::covreach::stats_t & stats)
+  {
+    auto covered_nodes_inserter = std::back_inserter(covered_nodes);
+
+    covered_nodes.clear();
+    graph.covered_nodes(node, covered_nodes_inserter);
+    for (typename GRAPH::node_sptr_t const & covered_node : covered_nodes) {
+      // the covered node may be final, then node reaches a final state as well
+      if (covered_node->final())
+        node->final(true);
+      graph.move_incoming_edges(covered_node, node, tchecker::graph::subsumption::EDGE_SUBSUMPTION);
+      graph.remove_edges(covered_node);
+      graph.remove_node(covered_node);
+      ++stats.covered_states();
+    }
+  }
+};
+
+} // end of namespace covreach
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_COVREACH_BACKWARD_HH
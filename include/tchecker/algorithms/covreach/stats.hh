@@ -80,6 +80,30 @@ public:
   */
   unsigned long stored_states() const;
 
+  /*!
+   \brief Accessor
+   \return A reference to the number of calls to the cover predicate
+   */
+  unsigned long & cover_checks();
+
+  /*!
+   \brief Accessor
+   \return The number of calls to the cover predicate
+   */
+  unsigned long cover_checks() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of comparisons of node summaries in the subsumption index
+   */
+  unsigned long & summary_checks();
+
+  /*!
+   \brief Accessor
+   \return The number of comparisons of node summaries in the subsumption index
+   */
+  unsigned long summary_checks() const;
+
   /*!
    \brief Accessor
    \return A reference to the reachable state flag
@@ -99,11 +123,21 @@ public:
   */
   void attributes(std::map<std::string, std::string> & m) const;
 
+  /*!
+   \brief Extract statistics on cover checks as attributes (key, value)
+   \param m : attributes map
+   \post the numbers of calls to the cover predicate and of comparisons of summaries have been added to m
+   \note these statistics are not part of attributes(m) since they depend on the subsumption index
+  */
+  void cover_attributes(std::map<std::string, std::string> & m) const;
+
 private:
   unsigned long _visited_states;      /*!< Number of visited states */
   unsigned long _visited_transitions; /*!< Number of visited transitions */
   unsigned long _covered_states;      /*!< Number of covered states */
   unsigned long _stored_states;       /*!< Number of stored states */
+  unsigned long _cover_checks;        /*!< Number of calls to the cover predicate */
+  unsigned long _summary_checks;      /*!< Number of comparisons of summaries */
   bool _reachable;                    /*!< Reachability of satisfying state */
 };
 
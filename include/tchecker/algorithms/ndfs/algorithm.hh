@@ -13,8 +13,10 @@
 
 #include <boost/dynamic_bitset.hpp>
 
+#include "tchecker/algorithms/budget.hh"
 #include "tchecker/algorithms/ndfs/graph.hh"
 #include "tchecker/algorithms/ndfs/stats.hh"
+#include "tchecker/ts/static.hh"
 
 /*!
  \file algorithm.hh
@@ -88,9 +90,20 @@ namespace ndfs {
          push <t, post(t)> on red_stack
  */
 template <class TS, class GRAPH> class algorithm_t {
+  static_assert(tchecker::ts::is_static_v<TS>, "TS should be a final transition system, see tchecker::ts::is_static_t");
+
 public:
   using node_sptr_t = typename GRAPH::node_sptr_t;
 
+  /*!
+   \brief Constructor
+   \param budget : budget of visited states, running time and memory
+   \note when the budget is exceeded, the run is stopped, and the exceeded limit and the depth of the DFS stack are
+   recorded in its statistics (see tchecker::algorithms::stats_t::budget_status). The cycle flag is then only
+   meaningful when true
+   */
+  algorithm_t(tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{}) : _budget(budget) {}
+
   /*!
    \brief Check if a transition has an infinite run that satisfies a given set
    of labels and build the corresponding graph
@@ -118,7 +131,7 @@ public:
       initial_node->final(accepting(initial_node, ts, labels));
       if (initial_node->color() == tchecker::algorithms::ndfs::WHITE)
         dfs_blue(ts, graph, labels, stats, initial_node);
-      if (stats.cycle())
+      if (stats.cycle() || stats.budget_exceeded())
         break;
     }
 
@@ -195,6 +208,11 @@ private:
     ++stats.visited_states_blue();
 
     while (!stack.empty()) {
+      // the red DFS may have exceeded the budget
+      if (stats.budget_exceeded() ||
+          tchecker::algorithms::budget_exceeded(_budget, stats.visited_states(), stack.size(), stats))
+        break;
+
       auto && [s, succ, allred] = stack.top();
       if (succ.empty()) {
         if (allred)
@@ -299,6 +317,9 @@ private:
     ++stats.visited_states_red();
 
     while (!stack.empty()) {
+      if (tchecker::algorithms::budget_exceeded(_budget, stats.visited_states(), stack.size(), stats))
+        break;
+
       red_stack_entry_t & top = stack.top();
       if (!top.has_successor())
         stack.pop();
@@ -317,6 +338,8 @@ private:
       }
     }
   }
+
+  tchecker::algorithms::budget_t _budget; /*!< Budget of the runs */
 };
 
 } // namespace ndfs
@@ -0,0 +1,500 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ALGORITHMS_NDFS_CNDFS_HH
+#define TCHECKER_ALGORITHMS_NDFS_CNDFS_HH
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <stack>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/budget.hh"
+#include "tchecker/algorithms/ndfs/graph.hh"
+#include "tchecker/algorithms/ndfs/stats.hh"
+#include "tchecker/algorithms/search_order.hh"
+#include "tchecker/ts/static.hh"
+#include "tchecker/utils/hashtable.hh"
+#include "tchecker/utils/iterator.hh"
+#include "tchecker/utils/parallel.hh"
+
+/*!
+ \file cndfs.hh
+ \brief Multi-core nested DFS algorithm
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace ndfs {
+
+/*!
+ \class cndfs_algorithm_t
+ \brief Multi-core nested DFS algorithm
+ \tparam TS : type of transition system, should implement tchecker::ts::fwd_t and tchecker::ts::inspector_t, and
+ states should have a function hash_value found by argument-dependent lookup that hashes their content, and an
+ operator== that compares their content
+ \tparam GRAPH : type of graph, should derive from tchecker::graph::reachability_graph_t, and nodes of type
+ GRAPH::shared_node_t should derive from tchecker::algorithms::ndfs::node_t and have a method state_ptr() that
+ yields a pointer to the corresponding state in TS
+ \note Our implementation is based on the CNDFS algorithm in:
+ "Improved Multi-Core Nested Depth-First Search",
+ Sami Evangelista, Alfons Laarman, Laure Petrucci and Jaco van de Pol
+ ATVA 2012
+
+ Each worker p runs the following nested DFS, with its own order of successors:
+
+ procedure dfs_blue_p(s)
+   s.color[p] := cyan
+   for each t in post_p(s)
+     if t.color[p] = cyan and (s or t is accepting) then
+       report cycle
+     else if t.color[p] = white and not t.red then
+       dfs_blue_p(t)
+   if s is accepting then
+     R_p := {}
+     dfs_red_p(s)
+     await all accepting states in R_p \ {s} are red
+     for each r in R_p
+       r.red := true
+   s.color[p] := blue
+
+ procedure dfs_red_p(s)
+   R_p := R_p + {s}
+   for each t in post_p(s)
+     if t.color[p] = cyan then
+       report cycle
+     else if t not in R_p and not t.red then
+       dfs_red_p(t)
+
+ The red flags are shared by all workers, in a table of states with one lock per shard (see
+ tchecker::concurrent_hashtable_t). The colors of worker p are stored in its own graph, built from its own
+ transition system: workers share no graph and no transition system, hence no reference counter. All the
+ workers start from the initial states of the first transition system (copied into their own ones), and the first
+ worker that finds a cycle stops the others
+
+ We have implemented an iterative translation of the recursive procedures above. The red DFS of worker p
+ colors the nodes in R_p red in its graph (R_p membership), as they are marked red in the shared table afterwards
+ */
+template <class TS, class GRAPH> class cndfs_algorithm_t {
+  static_assert(tchecker::ts::is_static_v<TS>, "TS should be a final transition system, see tchecker::ts::is_static_t");
+
+public:
+  using node_sptr_t = typename GRAPH::node_sptr_t;
+  using const_state_sptr_t = typename TS::fwd_t::const_state_t;
+
+  /*!
+   \brief Constructor
+   \param budget : budget of visited states, running time and memory of each worker
+   \param seed : seed of the orders of successors
+   \note when a worker exceeds its budget, the run is stopped, and the exceeded limit and the depth of its DFS stack
+   are recorded in the statistics (see tchecker::algorithms::stats_t::budget_status). The cycle flag is then only
+   meaningful when true
+   */
+  cndfs_algorithm_t(tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{},
+                    std::mt19937_64::result_type seed = tchecker::algorithms::RANDOM_SEARCH_SEED)
+      : _budget(budget), _seed(seed), _witness(0)
+  {
+  }
+
+  /*!
+   \brief Check if a transition system has an infinite run that satisfies a given set of labels
+   \param ts : transition systems of the workers
+   \param graphs : graphs of the workers
+   \param labels : accepting labels
+   \pre ts and graphs have the same positive size P. ts are transition systems over the same system, and
+   graphs[i] is built from ts[i]. The transition systems and graphs of distinct workers share no component (in
+   particular, each worker can use its own transition system and graph in its own thread)
+   \post P workers have run the CNDFS algorithm in parallel, worker i on ts[i] and graphs[i], until a cycle that
+   satisfies labels is reached (if any). Worker 0 visits successors in the order computed by ts[0], and the other
+   workers visit them in a random order seeded by the seed of the algorithm and the index of the worker
+   \return statistics on the run: numbers of visited and stored states and transitions are summed over the workers
+   \throw std::invalid_argument : if the precondition on the numbers of transition systems and graphs is not satisfied
+   \note if labels is empty, each graph is the full state-space of ts
+   \note the worker that has found a cycle is given by witness()
+   */
+  tchecker::algorithms::ndfs::stats_t run(std::vector<std::shared_ptr<TS>> const & ts,
+                                          std::vector<std::shared_ptr<GRAPH>> const & graphs,
+                                          boost::dynamic_bitset<> const & labels)
+  {
+    std::size_t const P = ts.size();
+    if (P == 0 || graphs.size() != P)
+      throw std::invalid_argument("CNDFS requires as many graphs as transition systems");
+
+    tchecker::algorithms::ndfs::stats_t stats;
+
+    stats.set_start_time();
+
+    // initial states are computed once, and copied by each worker (see worker_t::run)
+    std::vector<typename TS::sst_t> sst;
+    ts[0]->initial(sst);
+    std::vector<const_state_sptr_t> initial;
+    for (auto && [status, s, t] : sst)
+      initial.push_back(const_state_sptr_t{s});
+    sst.clear();
+
+    red_states_t red;
+    std::atomic<bool> stop{false};
+    std::vector<tchecker::algorithms::ndfs::stats_t> workers_stats(P);
+
+    tchecker::parallel_for(P, P, [&](std::size_t, std::size_t p) {
+      worker_t worker{*ts[p], *graphs[p], labels, _budget, _seed + p, p != 0, red, stop, workers_stats[p]};
+      worker.run(initial, *ts[0]);
+    });
+
+    _witness = 0;
+    for (std::size_t p = 0; p < P; ++p) {
+      tchecker::algorithms::ndfs::stats_t const & w = workers_stats[p];
+      stats.visited_states_blue() += w.visited_states_blue();
+      stats.visited_transitions_blue() += w.visited_transitions_blue();
+      stats.visited_states_red() += w.visited_states_red();
+      stats.visited_transitions_red() += w.visited_transitions_red();
+      stats.stored_states() += graphs[p]->nodes_count();
+      if (w.cycle() && !stats.cycle()) {
+        stats.cycle() = true;
+        _witness = p;
+      }
+    }
+    for (tchecker::algorithms::ndfs::stats_t const & w : workers_stats)
+      if (!stats.cycle() && w.budget_exceeded() && !stats.budget_exceeded()) {
+        stats.budget_status() = w.budget_status();
+        stats.frontier_size() = w.frontier_size();
+      }
+
+    stats.set_end_time();
+
+    return stats;
+  }
+
+  /*!
+   \brief Accessor
+   \return index of the worker that has found a cycle in the last run (0 if no cycle has been found), hence the
+   index of the graph that contains an accepting cycle
+   */
+  inline std::size_t witness() const { return _witness; }
+
+private:
+  using state_ptr_t = decltype(std::declval<const_state_sptr_t const &>().ptr());
+
+  /*!
+   \class red_states_t
+   \brief Thread-safe set of red states
+   \note the set stores pointers to states, which are kept alive by the graphs of the workers until the end of
+   the run. States are only read by the other workers, hence their reference counters are not modified
+   */
+  class red_states_t {
+  public:
+    /*!
+     \brief Constructor
+     \post this set is empty
+     */
+    red_states_t() : _states(TABLE_SIZE, hash_t{}, equal_t{}, SHARDS) {}
+
+    /*!
+     \brief Membership
+     \param s : a state
+     \return true if a state equal to s is in this set, false otherwise
+     */
+    bool contains(state_ptr_t s) { return std::get<0>(_states.find(s)); }
+
+    /*!
+     \brief Insertion
+     \param s : a state
+     \post a state equal to s is in this set
+     */
+    void insert(state_ptr_t s) { _states.add(s); }
+
+  private:
+    static constexpr std::size_t const SHARDS = 64;       /*!< Number of shards */
+    static constexpr std::size_t const TABLE_SIZE = 4096; /*!< Initial number of slots */
+
+    /*!
+     \brief Hash function on pointers to states
+     */
+    struct hash_t {
+      std::size_t operator()(state_ptr_t s) const { return hash_value(*s); }
+    };
+
+    /*!
+     \brief Equality predicate on pointers to states
+     */
+    struct equal_t {
+      bool operator()(state_ptr_t s1, state_ptr_t s2) const { return *s1 == *s2; }
+    };
+
+    tchecker::concurrent_hashtable_t<state_ptr_t, hash_t, equal_t> _states; /*!< Red states */
+  };
+
+  /*!
+   \brief Type of entries of DFS stacks
+   */
+  struct stack_entry_t {
+    node_sptr_t n;                                     /*!< Node */
+    typename GRAPH::outgoing_edges_iterator_t current; /*!< Iterator on current successor node */
+    typename GRAPH::outgoing_edges_iterator_t end;     /*!< Past-the-end iterator on successor nodes */
+
+    /*!
+     \brief Constructor
+     \param n : a node
+     \param r : range of outgoing edges of node n
+    */
+    stack_entry_t(node_sptr_t const & n, tchecker::range_t<typename GRAPH::outgoing_edges_iterator_t> const & r)
+        : n(n), current(r.begin()), end(r.end())
+    {
+    }
+
+    /*!
+     \brief Check emptiness of successor range
+     \return true if the range [current; end) of successor nodes is not empty, false otherwise
+     */
+    bool has_successor() const { return (current != end); }
+
+    /*!
+     \brief Remove and return the first successor node
+     \param graph : a graph
+     \pre the range [current,end) is not empty
+     \return the first successor node of node n
+     \post the first successor of node n has been removed from the range of successors
+    */
+    node_sptr_t pick_successor(GRAPH & graph)
+    {
+      node_sptr_t next = graph.edge_tgt(*current);
+      ++current;
+      return next;
+    }
+  };
+
+  /*!
+   \class worker_t
+   \brief Worker of the CNDFS algorithm
+   */
+  class worker_t {
+  public:
+    /*!
+     \brief Constructor
+     \param ts : transition system of the worker
+     \param graph : graph of the worker
+     \param labels : accepting labels
+     \param budget : budget of the worker
+     \param seed : seed of the order of successors
+     \param shuffle : true if successors are visited in a random order, false otherwise
+     \param red : shared set of red states
+     \param stop : shared stop flag
+     \param stats : statistics of the worker
+     */
+    worker_t(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
+             tchecker::algorithms::budget_t const & budget, std::mt19937_64::result_type seed, bool shuffle,
+             red_states_t & red, std::atomic<bool> & stop, tchecker::algorithms::ndfs::stats_t & stats)
+        : _ts(ts), _graph(graph), _labels(labels), _budget(budget), _generator(seed), _shuffle(shuffle), _red(red),
+          _stop(stop), _stats(stats)
+    {
+    }
+
+    /*!
+     \brief Run the worker
+     \param initial : initial states
+     \param initial_ts : transition system of the initial states
+     \post a blue DFS has been run from each initial state, until the stop flag is set. The stop flag has been set
+     if a cycle has been found or the budget has been exceeded
+     */
+    void run(std::vector<const_state_sptr_t> const & initial, TS & initial_ts)
+    {
+      for (const_state_sptr_t const & s : initial) {
+        // the initial states are only read by the other workers
+        node_sptr_t n = (&initial_ts == &_ts ? std::get<1>(_graph.add_node(s))
+                                             : std::get<1>(_graph.add_node(_ts.clone(*s))));
+        n->initial(true);
+        n->final(accepting(n));
+        if (n->color() == tchecker::algorithms::ndfs::WHITE && !_red.contains(n->state_ptr().ptr()))
+          dfs_blue(n);
+        if (_stop.load())
+          break;
+      }
+    }
+
+  private:
+    /*!
+     \brief Blue DFS from a node
+     \param n : a node
+     */
+    void dfs_blue(node_sptr_t const & n)
+    {
+      std::stack<stack_entry_t> stack;
+
+      n->color() = tchecker::algorithms::ndfs::CYAN;
+      stack.push(stack_entry_t{n, expand_node(n)});
+      ++_stats.visited_states_blue();
+
+      while (!stack.empty()) {
+        if (_stop.load(std::memory_order_relaxed) || budget_exceeded(stack.size()))
+          return;
+
+        stack_entry_t & top = stack.top();
+        if (top.has_successor()) {
+          node_sptr_t t = top.pick_successor(_graph);
+          ++_stats.visited_transitions_blue();
+          if (t->color() == tchecker::algorithms::ndfs::CYAN && (top.n->final() || t->final())) {
+            report_cycle();
+            return;
+          }
+          else if (t->color() == tchecker::algorithms::ndfs::WHITE && !_red.contains(t->state_ptr().ptr())) {
+            t->color() = tchecker::algorithms::ndfs::CYAN;
+            stack.push(stack_entry_t{t, expand_node(t)});
+            ++_stats.visited_states_blue();
+          }
+        }
+        else {
+          node_sptr_t s = top.n;
+          if (s->final() && !dfs_red(s))
+            return;
+          s->color() = tchecker::algorithms::ndfs::BLUE;
+          stack.pop();
+        }
+      }
+    }
+
+    /*!
+     \brief Red DFS from an accepting node
+     \param s : an accepting node
+     \return true if the red DFS has completed, and the nodes that it has visited have been marked red, false if
+     the worker has been stopped
+     */
+    bool dfs_red(node_sptr_t const & s)
+    {
+      std::vector<node_sptr_t> visited{s}; // R_p
+      std::stack<stack_entry_t> stack;
+
+      stack.push(stack_entry_t{s, _graph.outgoing_edges(s)});
+      ++_stats.visited_states_red();
+
+      while (!stack.empty()) {
+        if (_stop.load(std::memory_order_relaxed) || budget_exceeded(stack.size()))
+          return false;
+
+        stack_entry_t & top = stack.top();
+        if (top.has_successor()) {
+          node_sptr_t t = top.pick_successor(_graph);
+          ++_stats.visited_transitions_red();
+          if (t->color() == tchecker::algorithms::ndfs::CYAN) {
+            report_cycle();
+            return false;
+          }
+          else if (t->color() != tchecker::algorithms::ndfs::RED && !_red.contains(t->state_ptr().ptr())) {
+            t->color() = tchecker::algorithms::ndfs::RED;
+            visited.push_back(t);
+            stack.push(stack_entry_t{t, expand_node(t)});
+            ++_stats.visited_states_red();
+          }
+        }
+        else
+          stack.pop();
+      }
+
+      // the accepting nodes visited by the red DFS are being processed by other workers
+      for (node_sptr_t const & r : visited)
+        if (r != s && r->final())
+          while (!_red.contains(r->state_ptr().ptr())) {
+            if (_stop.load())
+              return false;
+            std::this_thread::yield();
+          }
+
+      for (node_sptr_t const & r : visited)
+        _red.insert(r->state_ptr().ptr());
+
+      return true;
+    }
+
+    /*!
+     \brief Compute successor nodes
+     \param n : a node
+     \post if n has no outgoing edges, all successor nodes of n in the transition system have been added to the
+     graph (if not yet in) with corresponding edges, in a random order if the worker shuffles successors, and flag
+     final set to true if accepting
+     \return range of outgoing edges of n
+     */
+    tchecker::range_t<typename GRAPH::outgoing_edges_iterator_t> expand_node(node_sptr_t const & n)
+    {
+      auto edges = _graph.outgoing_edges(n);
+      if (edges.begin() != edges.end())
+        return edges;
+
+      std::vector<typename TS::sst_t> v;
+      _ts.next(n->state_ptr(), v);
+      if (_shuffle)
+        std::shuffle(v.begin(), v.end(), _generator);
+      for (auto && [status, s, t] : v) {
+        auto && [new_node, nextn] = _graph.add_node(s);
+        _graph.add_edge(n, nextn, *t);
+        nextn->final(accepting(nextn));
+      }
+      return _graph.outgoing_edges(n);
+    }
+
+    /*!
+     \brief Check if a node is accepting
+     \param n : a node
+     \return true if labels is not empty, and labels is a subset of the labels of node n, false otherwise
+     */
+    bool accepting(node_sptr_t const & n) const
+    {
+      return !_labels.none() && _labels.is_subset_of(_ts.labels(n->state_ptr()));
+    }
+
+    /*!
+     \brief Check budget
+     \param depth : depth of the current DFS stack
+     \return true if the budget of the worker is exceeded (then the stop flag has been set), false otherwise
+     */
+    bool budget_exceeded(std::size_t depth)
+    {
+      if (!tchecker::algorithms::budget_exceeded(_budget, _stats.visited_states(), depth, _stats))
+        return false;
+      _stop.store(true);
+      return true;
+    }
+
+    /*!
+     \brief Report a cycle
+     \post the cycle flag of the worker and the stop flag have been set
+     */
+    void report_cycle()
+    {
+      _stats.cycle() = true;
+      _stop.store(true);
+    }
+
+    TS & _ts;                                     /*!< Transition system */
+    GRAPH & _graph;                               /*!< Graph */
+    boost::dynamic_bitset<> const & _labels;      /*!< Accepting labels */
+    tchecker::algorithms::budget_t _budget;       /*!< Budget (copy: budgets are not shared by threads) */
+    std::mt19937_64 _generator;                   /*!< Generator of the order of successors */
+    bool _shuffle;                                /*!< Random order of successors */
+    red_states_t & _red;                          /*!< Shared set of red states */
+    std::atomic<bool> & _stop;                    /*!< Shared stop flag */
+    tchecker::algorithms::ndfs::stats_t & _stats; /*!< Statistics */
+  };
+
+  tchecker::algorithms::budget_t _budget; /*!< Budget of each worker */
+  std::mt19937_64::result_type _seed;     /*!< Seed of the orders of successors */
+  std::size_t _witness;                   /*!< Worker that has found a cycle in the last run */
+};
+
+} // namespace ndfs
+
+} // namespace algorithms
+
+} // namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_NDFS_CNDFS_HH
@@ -120,6 +120,7 @@ public:
    \brief Extract statistics as attributes (key, value)
    \param m : attributes map
    \post every statistics has been added to m
+   \note CYCLE is reported as "unknown" when the budget has been exceeded, unless a cycle has been found
   */
   void attributes(std::map<std::string, std::string> & m) const;
 
@@ -0,0 +1,371 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ALGORITHMS_NDFS_SUBSUMPTION_HH
+#define TCHECKER_ALGORITHMS_NDFS_SUBSUMPTION_HH
+
+#include <cstddef>
+#include <deque>
+#include <stack>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/budget.hh"
+#include "tchecker/algorithms/ndfs/graph.hh"
+#include "tchecker/algorithms/ndfs/stats.hh"
+#include "tchecker/ts/static.hh"
+
+/*!
+ \file subsumption.hh
+ \brief Nested DFS algorithm with subsumption
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace ndfs {
+
+/*!
+ \class subsumption_algorithm_t
+ \brief Nested DFS algorithm with subsumption
+ \tparam TS : type of transition system, should implement tchecker::ts::fwd_t and tchecker::ts::inspector_t
+ \tparam GRAPH : type of graph, should derive from tchecker::graph::reachability_graph_t, and nodes of type
+ GRAPH::shared_node_t should derive from tchecker::algorithms::ndfs::node_t and have a method state_ptr() that
+ yields a pointer to the corresponding state in TS
+ \tparam NODE_HASH : type of hash functor on nodes, nodes that are comparable w.r.t. NODE_LE should have the same hash
+ value (e.g. a hash of the discrete part of nodes)
+ \tparam NODE_LE : type of subsumption functor on nodes, should be a simulation: if n1 <= n2 then every run from n1
+ is simulated by a run from n2 that visits the same labels
+ \note Our implementation extends the nested DFS algorithm in tchecker::algorithms::ndfs::algorithm_t with the
+ subsumption rules in:
+ "Multi-Core Emptiness Checking of Timed Büchi Automata using Inclusion Abstraction",
+ Alfons Laarman, Mads Chr. Olesen, Andreas Engelbredt Dalsgaard, Kim Guldstrand Larsen and Jaco van de Pol
+ CAV 2013
+
+ - a successor t that is subsumed by a red node (t <= r) is pruned, in the blue DFS and in the red DFS, as no
+   accepting cycle is reachable from r
+ - a cycle is reported when a successor t subsumes a cyan node (c <= t), in the red DFS, and in the blue DFS if the
+   source of t or t is accepting, as c reaches t on the DFS stack, hence c has an infinite accepting run
+
+ Subsumption is not used to prune blue successors by blue nodes, as it is not sound for liveness. The graph
+ stores all the nodes that are not pruned
+ */
+template <class TS, class GRAPH, class NODE_HASH, class NODE_LE> class subsumption_algorithm_t {
+  static_assert(tchecker::ts::is_static_v<TS>, "TS should be a final transition system, see tchecker::ts::is_static_t");
+
+public:
+  using node_sptr_t = typename GRAPH::node_sptr_t;
+
+  /*!
+   \brief Constructor
+   \param node_hash : hash functor on nodes
+   \param node_le : subsumption functor on nodes
+   \param budget : budget of visited states, running time and memory
+   \note when the budget is exceeded, the run is stopped, and the exceeded limit and the depth of the DFS stack are
+   recorded in its statistics (see tchecker::algorithms::stats_t::budget_status). The cycle flag is then only
+   meaningful when true
+   */
+  subsumption_algorithm_t(NODE_HASH const & node_hash, NODE_LE const & node_le,
+                          tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{})
+      : _node_hash(node_hash), _node_le(node_le), _budget(budget)
+  {
+  }
+
+  /*!
+   \brief Check if a transition has an infinite run that satisfies a given set of labels and build the
+   corresponding graph
+   \param ts : a transition system
+   \param graph : a graph
+   \param labels : accepting labels
+   \post graph is built from a traversal of ts starting from its initial states, until a cycle that satisfies
+   labels is reached (if any). A node is created for each reached state in ts that is not pruned by subsumption,
+   and an edge is created for each transition in ts from an expanded node
+   \return statistics on the run
+   \note if labels is empty, graph is the full state-space of ts up to subsumption by red nodes
+   */
+  tchecker::algorithms::ndfs::stats_t run(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels)
+  {
+    tchecker::algorithms::ndfs::stats_t stats;
+
+    stats.set_start_time();
+
+    std::vector<typename TS::sst_t> sst;
+    ts.initial(sst);
+    for (auto && [status, s, t] : sst) {
+      auto && [is_new_node, initial_node] = graph.add_node(s);
+      initial_node->initial(true);
+      initial_node->final(accepting(initial_node, ts, labels));
+      if (initial_node->color() == tchecker::algorithms::ndfs::WHITE && !covered(_red, initial_node))
+        dfs_blue(ts, graph, labels, stats, initial_node);
+      if (stats.cycle() || stats.budget_exceeded())
+        break;
+    }
+
+    _cyan.clear();
+    _red.clear();
+
+    stats.stored_states() = graph.nodes_count();
+
+    stats.set_end_time();
+
+    return stats;
+  }
+
+private:
+  /*!
+   \brief Type of sets of nodes indexed by hash value
+   */
+  using node_index_t = std::unordered_map<std::size_t, std::vector<node_sptr_t>>;
+
+  /*!
+   \brief Insert a node in an index
+   \param index : an index
+   \param n : a node
+   \post n has been added to index
+   */
+  void insert(node_index_t & index, node_sptr_t const & n) { index[_node_hash(*n)].push_back(n); }
+
+  /*!
+   \brief Remove a node from an index
+   \param index : an index
+   \param n : a node
+   \post n has been removed from index (if in)
+   */
+  void erase(node_index_t & index, node_sptr_t const & n)
+  {
+    auto it = index.find(_node_hash(*n));
+    if (it == index.end())
+      return;
+    std::vector<node_sptr_t> & nodes = it->second;
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+      if (nodes[i] == n) {
+        nodes[i] = nodes.back();
+        nodes.pop_back();
+        break;
+      }
+  }
+
+  /*!
+   \brief Subsumption by a node in an index
+   \param index : an index
+   \param n : a node
+   \return true if n <= m for some node m in index, false otherwise
+   */
+  bool covered(node_index_t const & index, node_sptr_t const & n) const
+  {
+    auto it = index.find(_node_hash(*n));
+    if (it == index.end())
+      return false;
+    for (node_sptr_t const & m : it->second)
+      if (_node_le(*n, *m))
+        return true;
+    return false;
+  }
+
+  /*!
+   \brief Subsumption of a node in an index
+   \param index : an index
+   \param n : a node
+   \return true if m <= n for some node m in index, false otherwise
+   */
+  bool covers(node_index_t const & index, node_sptr_t const & n) const
+  {
+    auto it = index.find(_node_hash(*n));
+    if (it == index.end())
+      return false;
+    for (node_sptr_t const & m : it->second)
+      if (_node_le(*m, *n))
+        return true;
+    return false;
+  }
+
+  /*!
+   \brief Set node color
+   \param n : a node
+   \param color : a color
+   \post n has color c, and the indices of cyan and red nodes have been updated
+   */
+  void set_color(node_sptr_t const & n, enum tchecker::algorithms::ndfs::color_t color)
+  {
+    if (n->color() == tchecker::algorithms::ndfs::CYAN)
+      erase(_cyan, n);
+    n->color() = color;
+    if (color == tchecker::algorithms::ndfs::CYAN)
+      insert(_cyan, n);
+    else if (color == tchecker::algorithms::ndfs::RED)
+      insert(_red, n);
+  }
+
+  /*!
+   \brief Adds successor nodes to the graph
+   \param ts : a transition system
+   \param graph : a graph
+   \param n : a node
+   \param labels : accepting labels
+   \post all successor nodes of n in ts have been added to graph (if not yet in) with corresponding edges, and flag
+   final set to true if accepting w.r.t labels
+   \return all successor nodes of n
+  */
+  std::deque<node_sptr_t> expand_node(TS & ts, GRAPH & graph, node_sptr_t & n, boost::dynamic_bitset<> const & labels)
+  {
+    std::deque<node_sptr_t> next_nodes;
+    std::vector<typename TS::sst_t> v;
+    ts.next(n->state_ptr(), v);
+    for (auto && [status, s, t] : v) {
+      auto && [new_node, nextn] = graph.add_node(s);
+      graph.add_edge(n, nextn, *t);
+      nextn->final(accepting(nextn, ts, labels));
+      next_nodes.push_back(nextn);
+    }
+    return next_nodes;
+  }
+
+  /*!
+   \brief Type of entries of the blue DFS stack
+   */
+  struct blue_stack_entry_t {
+    node_sptr_t n;                /*!< Node */
+    std::deque<node_sptr_t> succ; /*!< Successors of node n that have not been visited yet */
+    bool allred;                  /*!< True if all explored successors of n are red */
+  };
+
+  /*!
+   \brief Blue DFS from a node
+   \param ts : a transition system
+   \param graph : a graph
+   \param labels : accepting labels
+   \param stats : statistics
+   \param n : node
+  */
+  void dfs_blue(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels, tchecker::algorithms::ndfs::stats_t & stats,
+                node_sptr_t & n)
+  {
+    std::stack<blue_stack_entry_t> stack;
+
+    set_color(n, tchecker::algorithms::ndfs::CYAN);
+    stack.push(blue_stack_entry_t{n, expand_node(ts, graph, n, labels), true});
+    ++stats.visited_states_blue();
+
+    while (!stack.empty()) {
+      // the red DFS may have exceeded the budget
+      if (stats.budget_exceeded() ||
+          tchecker::algorithms::budget_exceeded(_budget, stats.visited_states(), stack.size(), stats))
+        break;
+
+      blue_stack_entry_t & top = stack.top();
+      node_sptr_t s = top.n;
+      if (top.succ.empty()) {
+        if (top.allred)
+          set_color(s, tchecker::algorithms::ndfs::RED);
+        else if (s->final()) {
+          if (dfs_red(graph, stats, s))
+            break;
+          set_color(s, tchecker::algorithms::ndfs::RED);
+        }
+        else
+          set_color(s, tchecker::algorithms::ndfs::BLUE);
+        bool s_is_red = (s->color() == tchecker::algorithms::ndfs::RED);
+        stack.pop();
+        if (!s_is_red && !stack.empty())
+          stack.top().allred = false;
+      }
+      else {
+        node_sptr_t t = top.succ.front();
+        top.succ.pop_front();
+        ++stats.visited_transitions_blue();
+        if ((s->final() || t->final()) && (t->color() == tchecker::algorithms::ndfs::CYAN || covers(_cyan, t))) {
+          stats.cycle() = true;
+          break;
+        }
+        else if (t->color() == tchecker::algorithms::ndfs::WHITE && !covered(_red, t)) {
+          set_color(t, tchecker::algorithms::ndfs::CYAN);
+          stack.push(blue_stack_entry_t{t, expand_node(ts, graph, t, labels), true});
+          ++stats.visited_states_blue();
+        }
+        else if (t->color() != tchecker::algorithms::ndfs::RED)
+          top.allred = false;
+      }
+    }
+  }
+
+  /*!
+   \brief Check if a node is accepting
+   \param n : a node
+   \param ts : a transition system
+   \param labels : a set of labels
+   \return true if labels is not empty, and labels is a subset of the labels of node n in ts, false otherwise
+   */
+  bool accepting(node_sptr_t const & n, TS & ts, boost::dynamic_bitset<> const & labels) const
+  {
+    return !labels.none() && labels.is_subset_of(ts.labels(n->state_ptr()));
+  }
+
+  /*!
+   \brief Type of entries in the red DFS stack
+  */
+  struct red_stack_entry_t {
+    node_sptr_t n;                                     /*!< Node */
+    typename GRAPH::outgoing_edges_iterator_t current; /*!< Iterator on current successor node */
+    typename GRAPH::outgoing_edges_iterator_t end;     /*!< Path-the-end iterator on successor nodes */
+  };
+
+  /*!
+   \brief Red DFS from a node
+   \param graph : a graph
+   \param stats : statistics
+   \param n : node
+   \return true if a cycle has been found or the budget has been exceeded, false otherwise
+  */
+  bool dfs_red(GRAPH & graph, tchecker::algorithms::ndfs::stats_t & stats, node_sptr_t & n)
+  {
+    std::stack<red_stack_entry_t> stack;
+
+    auto edges = graph.outgoing_edges(n);
+    stack.push(red_stack_entry_t{n, edges.begin(), edges.end()});
+    ++stats.visited_states_red();
+
+    while (!stack.empty()) {
+      if (tchecker::algorithms::budget_exceeded(_budget, stats.visited_states(), stack.size(), stats))
+        return true;
+
+      red_stack_entry_t & top = stack.top();
+      if (top.current == top.end)
+        stack.pop();
+      else {
+        node_sptr_t t = graph.edge_tgt(*top.current);
+        ++top.current;
+        ++stats.visited_transitions_red();
+        if (t->color() == tchecker::algorithms::ndfs::CYAN || covers(_cyan, t)) {
+          stats.cycle() = true;
+          return true;
+        }
+        else if (t->color() == tchecker::algorithms::ndfs::BLUE && !covered(_red, t)) {
+          set_color(t, tchecker::algorithms::ndfs::RED);
+          auto t_edges = graph.outgoing_edges(t);
+          stack.push(red_stack_entry_t{t, t_edges.begin(), t_edges.end()});
+          ++stats.visited_states_red();
+        }
+      }
+    }
+
+    return false;
+  }
+
+  NODE_HASH _node_hash;                   /*!< Hash functor on nodes */
+  NODE_LE _node_le;                       /*!< Subsumption functor on nodes */
+  tchecker::algorithms::budget_t _budget; /*!< Budget of the runs */
+  node_index_t _cyan;                     /*!< Cyan nodes */
+  node_index_t _red;                      /*!< Red nodes */
+};
+
+} // namespace ndfs
+
+} // namespace algorithms
+
+} // namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_NDFS_SUBSUMPTION_HH
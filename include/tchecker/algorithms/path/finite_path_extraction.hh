@@ -5,6 +5,7 @@
 #ifndef TCHECKER_ALGORITHMS_FINITE_PATH_EXTRACTION_HH
 #define TCHECKER_ALGORITHMS_FINITE_PATH_EXTRACTION_HH
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <stack>
@@ -188,6 +189,76 @@ private:
   }
 };
 
+/*!
+ \class parent_path_extraction_algorithm_t
+ \brief Finite path extraction along parent edges
+ \tparam GRAPH : type of graph. Should provide:
+ - a type of shared nodes GRAPH::node_sptr_t
+ - a type of shared edges GRAPH::edge_sptr_t
+ - a method nodes() that returns the range of nodes in the graph
+ - a method incoming_edges(n) that returns the range of incoming edges of node n
+ - a method edge_src(e) that returns the source node of edge e
+ See tchecker::graph::reachability::graph_t as an example of such graph
+ \note this algorithm is meant for graphs where every node has (at most) one incoming edge from the node it has been
+ discovered from, like the graphs built with tchecker::algorithms::reach::EDGES_PARENT. The incoming edge of a node is
+ then its parent pointer, and a path is extracted in time linear in its length instead of searching the whole graph. The
+ extracted path is a shortest path when the graph has been built by a breadth-first search
+ */
+template <class GRAPH> class parent_path_extraction_algorithm_t {
+public:
+  /*!
+   \brief Type of pointer to node
+  */
+  using node_sptr_t = typename GRAPH::node_sptr_t;
+
+  /*!
+   \brief Type of pointer to edge
+  */
+  using edge_sptr_t = typename GRAPH::edge_sptr_t;
+
+  /*!
+   \brief Extract a finite sequence of edges from a graph following parent edges
+   \param g : a graph
+   \param filter_first : predicate on nodes
+   \param filter_last : predicate on nodes
+   \param filter_edge : predicate on edges
+   \return a triple (true, n, seq) if a (possibly empty) sequence of edges seq has been found from n, that satisfies
+   filter_first, to the first node of g that satisfies filter_last, where all edges on seq satisfy filter_edge and every
+   node on seq after n has exactly one incoming edge, (false, nullptr, seq) where seq is empty otherwise
+   \note (false, nullptr, seq) is also returned when the nodes of g do not all have a single parent edge, even if a path
+   exists in g (see tchecker::algorithms::finite_path_extraction_algorithm_t for a search of the whole graph)
+   */
+  std::tuple<bool, node_sptr_t, std::vector<edge_sptr_t>> run(GRAPH const & g, std::function<bool(node_sptr_t)> && filter_first,
+                                                              std::function<bool(node_sptr_t)> && filter_last,
+                                                              std::function<bool(edge_sptr_t)> && filter_edge)
+  {
+    std::vector<edge_sptr_t> seq;
+    auto r = g.nodes();
+    for (node_sptr_t n : r) {
+      if (!filter_last(n))
+        continue;
+
+      std::unordered_set<node_sptr_t> visited{n};
+      while (!filter_first(n)) {
+        auto in_edges = g.incoming_edges(n);
+        auto it = in_edges.begin(), next = in_edges.begin();
+        if (it == in_edges.end() || ++next != in_edges.end())
+          return std::make_tuple(false, nullptr, std::vector<edge_sptr_t>{});
+        edge_sptr_t e = *it;
+        n = g.edge_src(e);
+        if (!filter_edge(e) || !visited.insert(n).second)
+          return std::make_tuple(false, nullptr, std::vector<edge_sptr_t>{});
+        seq.push_back(e);
+      }
+
+      std::reverse(seq.begin(), seq.end());
+      assert(seq.empty() || g.edge_src(seq[0]) == n);
+      return std::make_tuple(true, n, seq);
+    }
+    return std::make_tuple(false, nullptr, std::vector<edge_sptr_t>{});
+  }
+};
+
 } // namespace algorithms
 
 } // namespace tchecker
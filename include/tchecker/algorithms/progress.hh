@@ -0,0 +1,93 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ALGORITHMS_PROGRESS_HH
+#define TCHECKER_ALGORITHMS_PROGRESS_HH
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+#include "tchecker/algorithms/stats.hh"
+
+/*!
+ \file progress.hh
+ \brief Progress heartbeat of algorithms
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+/*!
+ \class progress_t
+ \brief Periodic report of the progress of an algorithm: elapsed time, visited states, states per second, frontier
+ size and resident set size
+ \note algorithms sample the heartbeat through their budget (see tchecker::algorithms::budget_t::check), hence
+ every algorithm that checks a budget reports its progress. Sampling is cheap when no report is due, and it is
+ thread-safe: copies of a budget used by several threads share the heartbeat, and each report is made by the first
+ thread that samples it when due (with its own numbers of visited states and waiting states)
+ */
+class progress_t {
+public:
+  /*!
+   \brief Constructor
+   \param filename : output file (empty means standard error)
+   \param period : period of reports
+   \param format : format of reports (one line per report)
+   \throw std::invalid_argument : if period is not positive
+   \throw std::runtime_error : if filename cannot be written
+   */
+  progress_t(std::string const & filename, std::chrono::milliseconds period,
+             enum tchecker::algorithms::stats_format_t format = tchecker::algorithms::STATS_FORMAT_TEXT);
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  progress_t(tchecker::algorithms::progress_t const &) = delete;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::algorithms::progress_t & operator=(tchecker::algorithms::progress_t const &) = delete;
+
+  /*!
+   \brief Sample the progress
+   \param visited_states : number of visited states
+   \param frontier : number of states waiting to be explored
+   \post a report has been output if one period has elapsed since the previous report (or since construction for
+   the first report)
+   */
+  void sample(std::uint64_t visited_states, std::size_t frontier);
+
+private:
+  /*!
+   \brief Output a report
+   \param elapsed : time since construction
+   \param visited_states : number of visited states
+   \param frontier : number of states waiting to be explored
+   \pre _mutex is owned by the calling thread
+   \post the report has been output
+   */
+  void report(std::chrono::duration<double> elapsed, std::uint64_t visited_states, std::size_t frontier);
+
+  std::ofstream _ofs;                                             /*!< Output file (if any) */
+  std::ostream & _os;                                             /*!< Output stream */
+  std::chrono::milliseconds _period;                              /*!< Period of reports */
+  enum tchecker::algorithms::stats_format_t _format;              /*!< Format of reports */
+  std::chrono::time_point<std::chrono::steady_clock> _start_time; /*!< Construction time */
+  std::atomic<std::chrono::steady_clock::rep> _next;              /*!< Time of the next report since construction */
+  std::mutex _mutex;                                              /*!< Lock of reports */
+};
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_PROGRESS_HH
@@ -5,12 +5,23 @@
 #ifndef TCHECKER_ALGORITHMS_REACH_ALGORITHM_HH
 #define TCHECKER_ALGORITHMS_REACH_ALGORITHM_HH
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 
+#include "tchecker/algorithms/budget.hh"
 #include "tchecker/algorithms/reach/stats.hh"
 #include "tchecker/basictypes.hh"
+#include "tchecker/ts/static.hh"
+#include "tchecker/utils/parallel.hh"
 #include "tchecker/waiting/factory.hh"
 
 /*!
@@ -24,6 +35,56 @@ namespace algorithms {
 
 namespace reach {
 
+/*!
+ \brief Detection of transition systems with a sharing hash of states (see tchecker::zg::zg_t::sharing_hash)
+ \tparam TS : type of transition system
+ \note value is true if TS has a static method sharing_hash(s), a method clone(s, hash) and a method prefetch(hash)
+ for its states s
+ */
+template <class TS, class = void> struct has_sharing_hash_t : std::false_type {
+};
+
+template <class TS>
+struct has_sharing_hash_t<TS, std::void_t<decltype(TS::sharing_hash(*std::get<1>(std::declval<typename TS::sst_t &>()))),
+                                          decltype(std::declval<TS &>().clone(
+                                              *std::get<1>(std::declval<typename TS::sst_t &>()), std::size_t{0})),
+                                          decltype(std::declval<TS &>().prefetch(std::size_t{0}))>>
+    : std::true_type {
+};
+
+/*!
+ \brief Shortcut for has_sharing_hash_t
+ */
+template <class TS> inline constexpr bool has_sharing_hash_v = tchecker::algorithms::reach::has_sharing_hash_t<TS>::value;
+
+/*!
+ \brief Detection of transition systems with lazy successors (see tchecker::zg::successors_t)
+ \tparam TS : type of transition system
+ \note value is true if TS has a type successors_t of generators of the successors of its states, constructed from
+ the transition system, a state and a mask on next states, with a method next(sst) that pulls the next successor
+ */
+template <class TS, class = void> struct has_successors_t : std::false_type {
+};
+
+template <class TS>
+struct has_successors_t<TS, std::void_t<decltype(std::declval<typename TS::successors_t &>().next(
+                                std::declval<typename TS::sst_t &>()))>> : std::true_type {
+};
+
+/*!
+ \brief Shortcut for has_successors_t
+ */
+template <class TS> inline constexpr bool has_successors_v = tchecker::algorithms::reach::has_successors_t<TS>::value;
+
+/*!
+ \brief Edges stored in reachability graphs
+ */
+enum edges_t {
+  EDGES_ALL,    /*!< An edge for each transition */
+  EDGES_PARENT, /*!< An edge to each node from the node it has been discovered from (tree of first discoveries) */
+  EDGES_NONE,   /*!< No edge */
+};
+
 /*!
  \class algorithm_t
  \brief Reachability algorithm
@@ -35,9 +96,91 @@ namespace reach {
  state in TS
  */
 template <class TS, class GRAPH> class algorithm_t {
+  static_assert(tchecker::ts::is_static_v<TS>, "TS should be a final transition system, see tchecker::ts::is_static_t");
+
 public:
   using node_sptr_t = typename GRAPH::node_sptr_t;
 
+  /*!
+   \brief Type of pointers to the nodes of the frontiers
+   \note the graph keeps ownership of the nodes, hence storing frontiers as plain pointers avoids updating the
+   reference counters of the nodes when they are inserted in and removed from a frontier
+   */
+  using node_ptr_t = typename node_sptr_t::shared_object_t *;
+
+  /*!
+   \brief Constructor
+   \param budget : budget of visited states, running time and memory
+   \note when the budget is exceeded, exploration is stopped and the exceeded limit and the number of waiting
+   nodes are recorded in the statistics of the run (see tchecker::algorithms::stats_t::budget_status). The graph
+   built so far is kept
+   */
+  algorithm_t(tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{}) : _budget(budget) {}
+
+  /*!
+   \brief Accessor
+   \return budget of the runs
+   */
+  inline tchecker::algorithms::budget_t const & budget() const { return _budget; }
+
+  /*!
+   \brief Type of checkpoint functions, called with the graph built so far, the waiting nodes in the order in which
+   they would be explored, and the statistics of the run so far
+   */
+  using checkpoint_function_t = std::function<void(GRAPH const &, std::vector<node_sptr_t> const &,
+                                                   tchecker::algorithms::reach::stats_t const &)>;
+
+  /*!
+   \brief Set periodic checkpoints
+   \param checkpoint : checkpoint function (nullptr means no checkpoint)
+   \param period : time between two checkpoints
+   \post the runs from the initial states and the resumed runs call checkpoint every period of exploration time
+   (see tchecker::algorithms::reach::algorithm_t::resume). The clock is sampled every CHECKPOINT_CHECK_PERIOD visited
+   nodes
+   \note the parallel breadth-first search does not take checkpoints
+   */
+  void checkpoint(checkpoint_function_t const & checkpoint, std::chrono::milliseconds period)
+  {
+    _checkpoint = checkpoint;
+    _checkpoint_period = period;
+  }
+
+  static constexpr unsigned long const CHECKPOINT_CHECK_PERIOD = 1024; /*!< Period of checkpoint clock checks */
+
+  /*!
+   \brief Set the edges stored in the graphs
+   \param edges : edges stored in the graphs
+   \post the runs only add the edges in edges to the graphs (all edges by default). Every node of a graph is reachable
+   from an initial node along EDGES_PARENT edges, hence counter examples can be computed from the graph, but not the
+   full reachability graph. Transitions are still computed (the zones of successors depend on them) and counted in the
+   statistics, but the transitions that are not stored are neither copied nor kept
+   */
+  void edges(enum tchecker::algorithms::reach::edges_t edges) { _edges = edges; }
+
+  /*!
+   \brief Accessor
+   \return edges stored in the graphs
+   */
+  inline enum tchecker::algorithms::reach::edges_t edges() const { return _edges; }
+
+  /*!
+   \brief Set the detection of accepting nodes on the fly
+   \param on_the_fly : whether accepting nodes are detected on the fly
+   \post if on_the_fly is true and TS has lazy successors (see tchecker::algorithms::reach::has_successors_t), the
+   runs check if a node is accepting when it is discovered instead of when it is expanded, and the successors of
+   a node are computed one outgoing edge at a time: the exploration stops at the first accepting successor, without
+   computing the successors along the remaining edges. Otherwise (default), accepting nodes are detected when they
+   are expanded
+   \note the parallel breadth-first search detects accepting nodes when they are expanded
+   */
+  void on_the_fly(bool on_the_fly) { _on_the_fly = on_the_fly; }
+
+  /*!
+   \brief Accessor
+   \return true if accepting nodes are detected on the fly, false otherwise
+   */
+  inline bool on_the_fly() const { return _on_the_fly; }
+
   /*!
    \brief Build a reachability graph of a transition system from its initial
    states
@@ -45,6 +188,7 @@ public:
    \param graph : a graph
    \param labels : accepting labels
    \param policy : waiting list policy
+   \param priority : priority of nodes (only used by priority queue policies)
    \post graph is built from a traversal of ts starting from its initial states,
    until a state that satisfies labels is reached (if any).
    A node is created for each reachable state in ts, and an edge is created for
@@ -52,11 +196,14 @@ public:
    on policy.
    \return statistics on the run
    \note if labels is empty, graph is the full reachability graph of ts
+   \throw std::invalid_argument : if policy is a priority queue policy and priority is empty
    */
   tchecker::algorithms::reach::stats_t run(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
-                                           enum tchecker::waiting::policy_t policy)
+                                           enum tchecker::waiting::policy_t policy,
+                                           tchecker::waiting::priority_function_t<node_sptr_t> const & priority = nullptr)
   {
-    std::unique_ptr<tchecker::waiting::waiting_t<node_sptr_t>> waiting{tchecker::waiting::factory<node_sptr_t>(policy)};
+    std::unique_ptr<tchecker::waiting::waiting_t<node_sptr_t>> waiting{
+        tchecker::waiting::factory<node_sptr_t>(policy, priority)};
 
     tchecker::algorithms::reach::stats_t stats;
 
@@ -71,7 +218,48 @@ public:
         waiting->insert(initial_node);
     }
 
-    run_from_waiting(ts, graph, labels, *waiting, stats);
+    run_from_waiting(ts, graph, labels, *waiting, stats, _checkpoint, lifo(policy));
+
+    stats.set_end_time();
+
+    return stats;
+  }
+
+  /*!
+   \brief Resume the build of a reachability graph of a transition system from a checkpoint
+   \param ts : a transition system
+   \param graph : a graph
+   \param labels : accepting labels
+   \param policy : waiting list policy
+   \param frontier : waiting nodes, in the order in which they should be explored
+   \param previous : statistics of the run that took the checkpoint
+   \param priority : priority of nodes (only used by priority queue policies)
+   \pre graph has been restored from a checkpoint of a run with policy and priority (see
+   tchecker::algorithms::reach::algorithm_t::checkpoint), and frontier contains the waiting nodes of this checkpoint.
+   The nodes in graph that are not in frontier have been expanded
+   \post graph is built as by run() from the initial states: the traversal continues from the nodes in frontier,
+   without expanding the nodes in graph again
+   \return statistics on the run, where the numbers of visited states and transitions include the ones in previous
+   \note the running time of the returned statistics is the running time of the resumed run
+   \throw std::invalid_argument : if policy is a priority queue policy and priority is empty
+   */
+  tchecker::algorithms::reach::stats_t resume(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
+                                              enum tchecker::waiting::policy_t policy,
+                                              std::vector<node_sptr_t> const & frontier,
+                                              tchecker::algorithms::reach::stats_t const & previous,
+                                              tchecker::waiting::priority_function_t<node_sptr_t> const & priority = nullptr)
+  {
+    std::unique_ptr<tchecker::waiting::waiting_t<node_sptr_t>> waiting{
+        tchecker::waiting::factory<node_sptr_t>(policy, priority)};
+
+    tchecker::algorithms::reach::stats_t stats;
+    stats.visited_states() = previous.visited_states();
+    stats.visited_transitions() = previous.visited_transitions();
+
+    stats.set_start_time();
+
+    restore(*waiting, frontier, lifo(policy));
+    run_from_waiting(ts, graph, labels, *waiting, stats, _checkpoint, lifo(policy));
 
     stats.set_end_time();
 
@@ -100,7 +288,156 @@ public:
     tchecker::algorithms::reach::stats_t stats;
 
     stats.set_start_time();
-    run_from_waiting(ts, graph, labels, waiting, stats);
+    run_from_waiting(ts, graph, labels, waiting, stats, nullptr, false);
+    stats.set_end_time();
+
+    return stats;
+  }
+
+  /*!
+   \brief Default number of nodes in the chunks of a level of the parallel breadth-first search
+   */
+  static constexpr std::size_t DEFAULT_CHUNK_SIZE = 64;
+
+  /*!
+   \brief Build a reachability graph of a transition system from its initial
+   states, by a level-synchronous parallel breadth-first search
+   \param ts : a transition system
+   \param graph : a graph
+   \param labels : accepting labels
+   \param workers : transition systems of the exploration threads
+   \param chunk_size : number of nodes expanded at once by a thread
+   \pre TS has methods clone(s) and clone(t) that copy the states and transitions of another transition system over the
+   same system into TS. workers are transition systems over the same system as ts, configured as ts, and they should
+   not share state components with ts (see tchecker::ts::NO_SHARING). chunk_size > 0
+   \post graph is built as by run() with the tchecker::waiting::QUEUE policy: each level of the breadth-first search
+   is split into chunks of at most chunk_size nodes (smaller chunks for levels of less than chunk_size nodes per
+   thread), the successors of the nodes in a chunk are computed by one of the threads
+   on its own transition system, then they are copied into ts and inserted into graph in the order of the level.
+   Hence graph and the statistics of the run are the same as with a sequential breadth-first search, and any path
+   from an initial node to an accepting node in graph is a shortest one
+   \return statistics on the run
+   \note the successors are computed sequentially on ts if workers is empty
+   \throw std::invalid_argument : if chunk_size is 0
+   */
+  tchecker::algorithms::reach::stats_t run_bfs(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
+                                               std::vector<std::shared_ptr<TS>> const & workers,
+                                               std::size_t chunk_size = DEFAULT_CHUNK_SIZE)
+  {
+    if (chunk_size == 0)
+      throw std::invalid_argument("Chunk size should be positive");
+
+    tchecker::algorithms::reach::stats_t stats;
+
+    stats.set_start_time();
+
+    std::vector<node_ptr_t> level, next_level; // nodes are owned by graph, that does not remove nodes during the run
+
+    std::vector<typename TS::sst_t> sst;
+    ts.initial(sst);
+    for (auto && [status, s, t] : sst) {
+      auto && [is_new_node, initial_node] = graph.add_node(s);
+      initial_node->initial(true);
+      if (is_new_node)
+        level.push_back(initial_node.ptr());
+    }
+    sst.clear();
+
+    std::vector<std::vector<typename TS::sst_t>> successors; // successors of the nodes in the level
+    std::vector<std::vector<std::size_t>> hashes;            // sharing hashes of the successors, computed by the threads
+    bool stop = false;
+    while (!stop && !level.empty()) {
+      // the exploration stops at the first accepting node, in level order, as in a sequential search
+      std::size_t expanded = level.size();
+      for (std::size_t i = 0; i < level.size(); ++i) {
+        if (tchecker::algorithms::budget_exceeded(_budget, stats.visited_states(), level.size() - i, stats)) {
+          expanded = i;
+          stop = true;
+          break;
+        }
+
+        ++stats.visited_states();
+
+        if (accepting(level[i], ts, labels)) {
+          level[i]->final(true);
+          stats.reachable() = true;
+          expanded = i;
+          stop = true;
+          break;
+        }
+      }
+
+      // each thread copies its source states into its own transition system, and only touches objects allocated by it.
+      // Small levels (such as the first levels from the initial states) are split in smaller chunks, so that they are
+      // expanded by all the threads
+      if (successors.size() < expanded) {
+        successors.resize(expanded);
+        hashes.resize(expanded);
+      }
+      std::size_t const level_chunk_size =
+          (workers.empty() ? chunk_size
+                           : std::max<std::size_t>(1, std::min(chunk_size, (expanded + workers.size() - 1) / workers.size())));
+      std::size_t const chunks = (expanded + level_chunk_size - 1) / level_chunk_size;
+      if (workers.empty())
+        for (std::size_t i = 0; i < expanded; ++i)
+          ts.next(level[i]->state_ptr(), successors[i]);
+      else
+        tchecker::parallel_for(chunks, workers.size(), [&](std::size_t t, std::size_t c) {
+          TS & worker = *workers[t];
+          for (std::size_t i = c * level_chunk_size; i < std::min(expanded, (c + 1) * level_chunk_size); ++i) {
+            typename TS::const_state_t src{worker.clone(*level[i]->state_ptr())};
+            worker.next(src, successors[i]);
+            // zones of large dimension are hashed by the threads rather than when they are shared sequentially
+            if constexpr (tchecker::algorithms::reach::has_sharing_hash_v<TS>) {
+              hashes[i].clear();
+              for (auto && [status, s, t] : successors[i])
+                hashes[i].push_back(TS::sharing_hash(*s));
+            }
+          }
+        });
+
+      next_level.clear();
+      for (std::size_t i = 0; i < expanded; ++i) {
+        // the sharing of the successors one node ahead is prefetched, to overlap its cache misses with this node
+        if constexpr (tchecker::algorithms::reach::has_sharing_hash_v<TS>) {
+          if (!workers.empty() && i == 0)
+            for (std::size_t h : hashes[0])
+              ts.prefetch(h);
+          if (!workers.empty() && i + 1 < expanded)
+            for (std::size_t h : hashes[i + 1])
+              ts.prefetch(h);
+        }
+        std::size_t k = 0;
+        for (auto && [status, s, t] : successors[i]) {
+          if (workers.empty()) {
+            auto && [is_new_node, next_node] = graph.add_node(s);
+            if (is_new_node)
+              next_level.push_back(next_node.ptr());
+            if (store_edge(is_new_node))
+              graph.add_edge(level[i], next_node, *t);
+          }
+          else {
+            typename TS::state_t clone;
+            if constexpr (tchecker::algorithms::reach::has_sharing_hash_v<TS>)
+              clone = ts.clone(*s, hashes[i][k]);
+            else
+              clone = ts.clone(*s);
+            auto && [is_new_node, next_node] = graph.add_node(clone);
+            if (is_new_node)
+              next_level.push_back(next_node.ptr());
+            if (store_edge(is_new_node))
+              graph.add_edge(level[i], next_node, *ts.clone(*t));
+          }
+
+          ++k;
+          ++stats.visited_transitions();
+        }
+        successors[i].clear();
+      }
+
+      level.swap(next_level);
+    }
+
     stats.set_end_time();
 
     return stats;
@@ -115,6 +452,8 @@ private:
   \param labels : accepting labels
   \param waiting : a waiting container
   \param stats : statistics
+  \param checkpoint : checkpoint function (nullptr means no checkpoint)
+  \param lifo : true if waiting is a stack, false otherwise
   \post graph is built from a traversal of ts starting from the nodes in
   waiting, until a state that satisfies labels is reached (if any).
   A node is created for each reachable state in ts, and an edge is
@@ -122,14 +461,34 @@ private:
   visited depends on the policy implemented by waiting.
   The number of visited nodes and reachability of a satisfying node have been
   set in stats.
+  Exploration stops early if the budget is exceeded, and this is recorded in stats.
+  checkpoint has been called every _checkpoint_period of exploration
   */
   void run_from_waiting(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
                         tchecker::waiting::waiting_t<typename GRAPH::node_sptr_t> & waiting,
-                        tchecker::algorithms::reach::stats_t & stats)
+                        tchecker::algorithms::reach::stats_t & stats, checkpoint_function_t const & checkpoint, bool lifo)
   {
     std::vector<typename TS::sst_t> sst;
+    std::vector<node_sptr_t> frontier;
+    auto next_checkpoint = std::chrono::steady_clock::now() + _checkpoint_period;
 
     while (!waiting.empty()) {
+      if (tchecker::algorithms::budget_exceeded(_budget, stats.visited_states(), waiting.size(), stats))
+        break;
+
+      if (checkpoint && stats.visited_states() % CHECKPOINT_CHECK_PERIOD == 0 &&
+          std::chrono::steady_clock::now() >= next_checkpoint) {
+        // waiting containers cannot be iterated: the frontier is removed in exploration order, then inserted back
+        while (!waiting.empty()) {
+          frontier.push_back(waiting.first());
+          waiting.remove_first();
+        }
+        restore(waiting, frontier, lifo);
+        checkpoint(graph, frontier, stats);
+        frontier.clear();
+        next_checkpoint = std::chrono::steady_clock::now() + _checkpoint_period;
+      }
+
       node_sptr_t node = waiting.first();
       waiting.remove_first();
 
@@ -141,12 +500,21 @@ private:
         break;
       }
 
+      if constexpr (tchecker::algorithms::reach::has_successors_v<TS>) {
+        if (_on_the_fly) {
+          if (expand_lazily(ts, graph, labels, waiting, stats, node))
+            break;
+          continue;
+        }
+      }
+
       ts.next(node->state_ptr(), sst);
       for (auto && [status, s, t] : sst) {
         auto && [is_new_node, next_node] = graph.add_node(s);
         if (is_new_node)
           waiting.insert(next_node);
-        graph.add_edge(node, next_node, *t);
+        if (store_edge(is_new_node))
+          graph.add_edge(node, next_node, *t);
 
         ++stats.visited_transitions();
       }
@@ -156,18 +524,107 @@ private:
     waiting.clear();
   }
 
+  /*!
+   \brief Expand a node, pulling its successors one at a time
+   \param ts : a transition system
+   \param graph : a graph
+   \param labels : accepting labels
+   \param waiting : a waiting container
+   \param stats : statistics
+   \param node : a node
+   \pre TS has lazy successors (see tchecker::algorithms::reach::has_successors_t)
+   \post the successors of node have been added to graph as by run_from_waiting, until an accepting successor is
+   discovered (if any). The successors that are discovered and not accepting have been inserted in waiting. An
+   accepting successor has been counted as a visited state and marked final, and reachability has been set in stats
+   \return true if an accepting successor has been discovered, false otherwise
+   */
+  bool expand_lazily(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
+                     tchecker::waiting::waiting_t<node_sptr_t> & waiting, tchecker::algorithms::reach::stats_t & stats,
+                     node_sptr_t const & node)
+  {
+    typename TS::successors_t successors{ts, node->state_ptr(), tchecker::STATE_OK};
+    typename TS::sst_t sst;
+    while (successors.next(sst)) {
+      auto && [status, s, t] = sst;
+      auto && [is_new_node, next_node] = graph.add_node(s);
+      if (store_edge(is_new_node))
+        graph.add_edge(node, next_node, *t);
+
+      ++stats.visited_transitions();
+
+      if (!is_new_node)
+        continue;
+      if (accepting(next_node, ts, labels)) {
+        ++stats.visited_states();
+        next_node->final(true);
+        stats.reachable() = true;
+        return true;
+      }
+      waiting.insert(next_node);
+    }
+    return false;
+  }
+
+  /*!
+   \brief Check if a waiting policy is last-in first-out
+   \param policy : waiting policy
+   \return true if policy is a stack policy, false otherwise
+   */
+  static bool lifo(enum tchecker::waiting::policy_t policy)
+  {
+    return policy == tchecker::waiting::STACK || policy == tchecker::waiting::FAST_REMOVE_STACK;
+  }
+
+  /*!
+   \brief Insert nodes in a waiting container
+   \param waiting : a waiting container
+   \param frontier : nodes in the order in which they should be explored
+   \param lifo : true if waiting is a stack, false otherwise
+   \pre waiting is empty
+   \post the nodes in frontier have been inserted in waiting, which yields them in the order of frontier
+   \note priority queues are first-in first-out among equal priorities
+   */
+  static void restore(tchecker::waiting::waiting_t<node_sptr_t> & waiting, std::vector<node_sptr_t> const & frontier,
+                      bool lifo)
+  {
+    if (lifo)
+      for (auto it = frontier.rbegin(); it != frontier.rend(); ++it)
+        waiting.insert(*it);
+    else
+      for (node_sptr_t const & node : frontier)
+        waiting.insert(node);
+  }
+
+  /*!
+   \brief Check if an edge is stored in the graph
+   \param is_new_node : whether the target node of the edge has been discovered along the edge
+   \return true if the edge is stored w.r.t. _edges, false otherwise
+   */
+  inline bool store_edge(bool is_new_node) const
+  {
+    return (_edges == tchecker::algorithms::reach::EDGES_ALL) ||
+           (_edges == tchecker::algorithms::reach::EDGES_PARENT && is_new_node);
+  }
+
   /*!
    \brief Check if a node is accepting
+   \tparam NODE_PTR : type of pointer to node (node_sptr_t or node_ptr_t)
    \param n : a node
    \param ts : a transition system
    \param labels : a set of labels
    \return true if labels is not empty, and the set of labels in n contain
    labels, and n is a valid final state in ts, false otherwise
    */
-  bool accepting(node_sptr_t const & n, TS & ts, boost::dynamic_bitset<> const & labels)
+  template <class NODE_PTR> bool accepting(NODE_PTR const & n, TS & ts, boost::dynamic_bitset<> const & labels)
   {
     return !labels.none() && labels.is_subset_of(ts.labels(n->state_ptr())) && ts.is_valid_final(n->state_ptr());
   }
+
+  tchecker::algorithms::budget_t _budget;          /*!< Budget of the runs */
+  checkpoint_function_t _checkpoint{nullptr};      /*!< Checkpoint function (nullptr: no checkpoint) */
+  std::chrono::milliseconds _checkpoint_period{0}; /*!< Time between checkpoints */
+  enum tchecker::algorithms::reach::edges_t _edges{tchecker::algorithms::reach::EDGES_ALL}; /*!< Edges in graphs */
+  bool _on_the_fly{false};                         /*!< Detection of accepting nodes on the fly */
 };
 
 } // end of namespace reach
@@ -0,0 +1,227 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ALGORITHMS_REACH_BITSTATE_HH
+#define TCHECKER_ALGORITHMS_REACH_BITSTATE_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/budget.hh"
+#include "tchecker/algorithms/reach/stats.hh"
+#include "tchecker/syncprod/vedge.hh"
+#include "tchecker/ts/static.hh"
+#include "tchecker/utils/bitstate.hh"
+#include "tchecker/waiting/factory.hh"
+#include "tchecker/waiting/queue.hh"
+#include "tchecker/waiting/stack.hh"
+
+/*!
+ \file bitstate.hh
+ \brief Probabilistic reachability algorithm (bitstate hashing)
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace reach {
+
+/*!
+ \class bitstate_algorithm_t
+ \brief Reachability algorithm that stores visited states as bits in a bitstate table rather than as nodes
+ in a graph. The memory used for visited states is fixed, at the price of completeness: a state whose bits
+ are all set by other states is not explored (hash collision). Hence a satisfying state that is found is
+ reachable, but the absence of satisfying states is only probable
+ \tparam TS : type of transition system, should implement tchecker::ts::fwd_t and tchecker::ts::inspector_t,
+ and states should have a function hash_value found by argument-dependent lookup, that hashes their content.
+ In trace mode, transitions should have a method vedge_ptr() that returns their tuple of edges
+ \note in trace mode, each explored state is recorded as the index of its parent and the tuple of edges from its
+ parent, which is enough to replay the run to a satisfying state (see trace()). Neither states nor zones are
+ stored, except the initial states
+ */
+template <class TS> class bitstate_algorithm_t {
+  static_assert(tchecker::ts::is_static_v<TS>, "TS should be a final transition system, see tchecker::ts::is_static_t");
+
+public:
+  using state_sptr_t = typename TS::fwd_t::state_t;
+  using const_state_sptr_t = typename TS::fwd_t::const_state_t;
+
+  /*!
+   \brief Constructor
+   \param table_size : size of the bitstate table in bytes
+   \param hashes : number of bits set by each state
+   \param trace : trace mode flag
+   \throw std::invalid_argument : see tchecker::bitstate_table_t
+   */
+  bitstate_algorithm_t(std::size_t table_size, unsigned int hashes = 3, bool trace = false)
+      : _visited(table_size, hashes), _trace(trace), _final(NO_NODE)
+  {
+  }
+
+  /*!
+   \brief Traversal of a transition system from its initial states
+   \param ts : a transition system
+   \param labels : accepting labels
+   \param policy : waiting list policy, either tchecker::waiting::QUEUE or tchecker::waiting::STACK
+   \param budget : budget of visited states, running time and memory
+   \post ts is traversed from its initial states until a state that satisfies labels is reached (if any), or
+   the budget is exceeded. A state is explored unless its hash value is found in the bitstate table. The order
+   in which states are visited depends on policy
+   \return statistics on the run, flagged as probabilistic
+   \note only the waiting states are kept in memory (and the trace of explored states in trace mode)
+   \throw std::invalid_argument : if policy is neither tchecker::waiting::QUEUE nor tchecker::waiting::STACK
+   */
+  tchecker::algorithms::reach::stats_t run(TS & ts, boost::dynamic_bitset<> const & labels,
+                                           enum tchecker::waiting::policy_t policy,
+                                           tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{})
+  {
+    // visited states are not nodes, hence they cannot be removed from fast remove waiting containers
+    // waiting states come with their node in the trace (NO_NODE if not in trace mode)
+    using waiting_element_t = std::pair<state_sptr_t, std::size_t>;
+    std::unique_ptr<tchecker::waiting::waiting_t<waiting_element_t>> waiting;
+    if (policy == tchecker::waiting::QUEUE)
+      waiting.reset(new tchecker::waiting::queue_t<waiting_element_t>{});
+    else if (policy == tchecker::waiting::STACK)
+      waiting.reset(new tchecker::waiting::stack_t<waiting_element_t>{});
+    else
+      throw std::invalid_argument("Unsupported waiting policy for bitstate exploration");
+
+    _nodes.clear();
+    _initial_states.clear();
+    _final = NO_NODE;
+
+    tchecker::algorithms::reach::stats_t stats;
+
+    stats.set_start_time();
+
+    std::vector<typename TS::sst_t> sst;
+    ts.initial(sst);
+    for (auto && [status, s, t] : sst)
+      if (_visited.insert(hash_value(*s))) {
+        if (_trace)
+          _initial_states.push_back(const_state_sptr_t{s});
+        waiting->insert(waiting_element_t{s, add_node(NO_NODE, t)});
+      }
+    sst.clear();
+
+    while (!waiting->empty()) {
+      if (tchecker::algorithms::budget_exceeded(budget, stats.visited_states(), waiting->size(), stats))
+        break;
+
+      const_state_sptr_t s{waiting->first().first};
+      std::size_t const node = waiting->first().second;
+      waiting->remove_first();
+
+      ++stats.visited_states();
+
+      if (!labels.none() && labels.is_subset_of(ts.labels(s)) && ts.is_valid_final(s)) {
+        stats.reachable() = true;
+        _final = node;
+        break;
+      }
+
+      ts.next(s, sst);
+      for (auto && [status, next_s, t] : sst) {
+        if (_visited.insert(hash_value(*next_s)))
+          waiting->insert(waiting_element_t{next_s, add_node(node, t)});
+        ++stats.visited_transitions();
+      }
+      sst.clear();
+    }
+
+    waiting->clear();
+
+    stats.probabilistic() = true;
+    stats.collision_probability() = _visited.collision_probability();
+    if (_trace)
+      stats.memory_usage()["TRACE"] =
+          _nodes.capacity() * sizeof(node_t) + _initial_states.capacity() * sizeof(const_state_sptr_t);
+
+    stats.set_end_time();
+
+    return stats;
+  }
+
+  /*!
+   \brief Accessor
+   \return bitstate table of visited states
+   */
+  inline tchecker::bitstate_table_t const & visited() const { return _visited; }
+
+  /*!
+   \brief Accessor
+   \return a triple (true, s, seq) if the last run has found a satisfying state in trace mode, where s is the
+   initial state of the run to this state and seq is its sequence of tuples of edges, (false, nullptr, seq)
+   otherwise, with seq empty
+   \note the zones along the run are not stored: they are recomputed by replaying seq from s, e.g. with
+   tchecker::zg::path::symbolic::compute_finite_path
+   */
+  std::tuple<bool, const_state_sptr_t, std::vector<tchecker::const_vedge_sptr_t>> trace() const
+  {
+    std::vector<tchecker::const_vedge_sptr_t> seq;
+    if (_final == NO_NODE)
+      return std::make_tuple(false, const_state_sptr_t{nullptr}, seq);
+
+    // initial states are the first nodes, in the order of _initial_states
+    std::size_t node = _final;
+    for (; _nodes[node].parent != NO_NODE; node = _nodes[node].parent)
+      seq.push_back(_nodes[node].vedge);
+    std::reverse(seq.begin(), seq.end());
+    return std::make_tuple(true, _initial_states[node], seq);
+  }
+
+private:
+  /*!
+   \brief No node in the trace
+   */
+  static constexpr std::size_t const NO_NODE = static_cast<std::size_t>(-1);
+
+  /*!
+   \class node_t
+   \brief Node of the trace
+   */
+  struct node_t {
+    std::size_t parent;                 /*!< Parent node (NO_NODE for initial states) */
+    tchecker::const_vedge_sptr_t vedge; /*!< Tuple of edges from parent */
+  };
+
+  /*!
+   \brief Add a node to the trace
+   \param parent : parent node
+   \param t : transition from parent
+   \return index of the new node in trace mode, NO_NODE otherwise
+   */
+  template <class TRANSITION> std::size_t add_node(std::size_t parent, TRANSITION const & t)
+  {
+    if (!_trace)
+      return NO_NODE;
+    tchecker::const_vedge_sptr_t vedge{nullptr};
+    if (parent != NO_NODE)
+      vedge = tchecker::const_vedge_sptr_t{t->vedge_ptr()};
+    _nodes.push_back(node_t{parent, vedge});
+    return _nodes.size() - 1;
+  }
+
+  tchecker::bitstate_table_t _visited;             /*!< Visited states */
+  bool _trace;                                     /*!< Trace mode flag */
+  std::vector<node_t> _nodes;                      /*!< Trace of explored states */
+  std::vector<const_state_sptr_t> _initial_states; /*!< Initial states (first nodes of the trace) */
+  std::size_t _final;                              /*!< Node of the satisfying state (NO_NODE if none) */
+};
+
+} // end of namespace reach
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_REACH_BITSTATE_HH
@@ -0,0 +1,319 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ALGORITHMS_REACH_BMC_HH
+#define TCHECKER_ALGORITHMS_REACH_BMC_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/budget.hh"
+#include "tchecker/algorithms/reach/stats.hh"
+#include "tchecker/syncprod/vedge.hh"
+#include "tchecker/ts/static.hh"
+
+/*!
+ \file bmc.hh
+ \brief Bounded reachability algorithm (iterative-deepening depth-first search)
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace reach {
+
+/*!
+ \class bmc_stats_t
+ \brief Statistics for bounded reachability algorithm
+ */
+class bmc_stats_t : public tchecker::algorithms::reach::stats_t {
+public:
+  /*!
+   \brief Constructor
+   */
+  bmc_stats_t();
+
+  /*!
+   \brief Accessor
+   \return A reference to the largest depth that has been completely searched
+   */
+  std::size_t & bound();
+
+  /*!
+   \brief Accessor
+   \return Largest depth that has been completely searched
+   */
+  std::size_t bound() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of transitions of the run to a satisfying state
+   */
+  std::size_t & depth();
+
+  /*!
+   \brief Accessor
+   \return Number of transitions of the run to a satisfying state (meaningful when reachable)
+   */
+  std::size_t depth() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the completeness flag
+   */
+  bool & complete();
+
+  /*!
+   \brief Accessor
+   \return true if every reachable state is within the bound, false otherwise
+   */
+  bool complete() const;
+
+  /*!
+   \brief Extract statistics as attributes (key, value)
+   \param m : attributes map
+   \post the attributes of tchecker::algorithms::reach::stats_t, BMC_BOUND and BMC_COMPLETE have been added to m,
+   as well as COUNTER_EXAMPLE_DEPTH if a satisfying state has been reached. REACHABLE is "unknown" if no satisfying
+   state has been reached within an incomplete bound
+   */
+  void attributes(std::map<std::string, std::string> & m) const;
+
+private:
+  std::size_t _bound; /*!< Largest depth completely searched */
+  std::size_t _depth; /*!< Length of the run to a satisfying state */
+  bool _complete;     /*!< Every reachable state is within the bound */
+};
+
+/*!
+ \class bmc_algorithm_t
+ \brief Bounded reachability algorithm: depth-first searches with increasing depth bounds (iterative deepening),
+ that only keep the current run in memory
+ \tparam TS : type of transition system, should implement tchecker::ts::fwd_t and tchecker::ts::inspector_t,
+ states should have a function hash_value found by argument-dependent lookup that hashes their content, and an
+ operator == that compares their content. Transitions should have a method vedge_ptr() that returns their tuple
+ of edges
+ \note the depth-first search with depth bound k finds a satisfying state at depth at most k if there is one.
+ Since bounds are increased one by one, the run that is found is a shortest one
+ \note the algorithm can use an optional cache of visited states, with a fixed number of entries. A state is not
+ explored again if it is found in the cache with a remaining depth larger than or equal to the current one. The
+ cache is direct-mapped on the hash values of states: an entry is overwritten by a state with the same hash
+ value, which only costs a re-exploration, hence the search stays exact
+ */
+template <class TS> class bmc_algorithm_t {
+  static_assert(tchecker::ts::is_static_v<TS>, "TS should be a final transition system, see tchecker::ts::is_static_t");
+
+public:
+  using state_sptr_t = typename TS::fwd_t::state_t;
+  using const_state_sptr_t = typename TS::fwd_t::const_state_t;
+
+  /*!
+   \brief Constructor
+   \param cache_size : number of entries of the cache of visited states (0: no cache)
+   */
+  bmc_algorithm_t(std::size_t cache_size = 0) : _cache(cache_size) {}
+
+  /*!
+   \brief Bounded traversal of a transition system from its initial states
+   \param ts : a transition system
+   \param labels : accepting labels
+   \param depth : maximal number of transitions of the runs
+   \param budget : budget of visited states, running time and memory
+   \post ts has been traversed by depth-first searches with bounds 0, 1, ..., depth until a state that satisfies
+   labels is reached, or every state reachable from the initial states has been visited, or the budget is exceeded
+   \return statistics on the run, with visited states and transitions summed over the searches
+   */
+  tchecker::algorithms::reach::bmc_stats_t run(TS & ts, boost::dynamic_bitset<> const & labels, std::size_t depth,
+                                               tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{})
+  {
+    tchecker::algorithms::reach::bmc_stats_t stats;
+
+    stats.set_start_time();
+
+    _path.clear();
+    _initial_state = const_state_sptr_t{nullptr};
+
+    std::vector<typename TS::sst_t> initials;
+    ts.initial(initials);
+
+    bool cut = true; // some state has not been expanded due to the bound
+    for (std::size_t bound = 0; bound <= depth && cut && !stats.reachable() && !stats.budget_exceeded(); ++bound) {
+      clear_cache();
+      cut = false;
+      for (std::size_t i = 0; i < initials.size() && !stats.reachable() && !stats.budget_exceeded(); ++i)
+        cut = search(ts, const_state_sptr_t{std::get<1>(initials[i])}, labels, bound, budget, stats) || cut;
+      if (!stats.reachable() && !stats.budget_exceeded()) {
+        stats.bound() = bound;
+        stats.complete() = !cut;
+      }
+    }
+
+    clear_cache();
+
+    if (stats.reachable())
+      stats.depth() = _path.size();
+
+    stats.memory_usage()["BMC_CACHE"] = _cache.capacity() * sizeof(cache_entry_t);
+
+    stats.set_end_time();
+
+    return stats;
+  }
+
+  /*!
+   \brief Accessor
+   \return a triple (true, s, seq) if the last run has found a satisfying state, where s is the initial state of
+   the run to this state and seq is its sequence of tuples of edges, (false, nullptr, seq) otherwise, with seq
+   empty
+   \note the zones along the run are not stored: they are recomputed by replaying seq from s, e.g. with
+   tchecker::zg::path::symbolic::compute_finite_path
+   */
+  std::tuple<bool, const_state_sptr_t, std::vector<tchecker::const_vedge_sptr_t>> trace() const
+  {
+    if (_initial_state.ptr() == nullptr)
+      return std::make_tuple(false, const_state_sptr_t{nullptr}, std::vector<tchecker::const_vedge_sptr_t>{});
+    return std::make_tuple(true, _initial_state, _path);
+  }
+
+private:
+  /*!
+   \class frame_t
+   \brief Frame of the depth-first search: a state on the current run and its successors
+   */
+  struct frame_t {
+    const_state_sptr_t state;              /*!< State */
+    std::vector<typename TS::sst_t> next;  /*!< Successors of state */
+    std::size_t index;                     /*!< Index of the next successor to visit */
+  };
+
+  /*!
+   \class cache_entry_t
+   \brief Entry of the cache of visited states
+   */
+  struct cache_entry_t {
+    const_state_sptr_t state{nullptr}; /*!< State (nullptr if the entry is empty) */
+    std::size_t remaining{0};          /*!< Depth that remained when the state was visited */
+  };
+
+  /*!
+   \brief Depth-first search with a depth bound
+   \param ts : a transition system
+   \param initial : initial state
+   \param labels : accepting labels
+   \param bound : maximal number of transitions of the runs
+   \param budget : budget of visited states, running time and memory
+   \param stats : statistics
+   \post the states reachable from initial with at most bound transitions have been visited until a state that
+   satisfies labels is reached (then stats is reachable, and the run to this state is recorded), or the budget is
+   exceeded
+   \return true if a state at depth bound has successors (that have not been visited), false otherwise
+   */
+  bool search(TS & ts, const_state_sptr_t const & initial, boost::dynamic_bitset<> const & labels, std::size_t bound,
+              tchecker::algorithms::budget_t const & budget, tchecker::algorithms::reach::bmc_stats_t & stats)
+  {
+    bool cut = false;
+    std::vector<frame_t> stack;
+
+    if (visit(ts, initial, labels, bound, stack, cut, stats)) {
+      _initial_state = initial;
+      return cut;
+    }
+
+    while (!stack.empty()) {
+      if (tchecker::algorithms::budget_exceeded(budget, stats.visited_states(), stack.size(), stats))
+        break;
+
+      frame_t & top = stack.back();
+      if (top.index == top.next.size()) {
+        stack.pop_back();
+        continue;
+      }
+
+      const_state_sptr_t s{std::get<1>(top.next[top.index])};
+      ++top.index;
+      ++stats.visited_transitions();
+
+      if (visit(ts, s, labels, bound - stack.size(), stack, cut, stats)) {
+        _initial_state = initial;
+        for (frame_t const & f : stack)
+          if (f.index > 0)
+            _path.push_back(tchecker::const_vedge_sptr_t{std::get<2>(f.next[f.index - 1])->vedge_ptr()});
+        break;
+      }
+    }
+
+    return cut;
+  }
+
+  /*!
+   \brief Visit a state
+   \param ts : a transition system
+   \param s : a state
+   \param labels : accepting labels
+   \param remaining : number of transitions that can still be fired from s
+   \param stack : stack of the depth-first search
+   \param cut : flag of states not expanded due to the bound
+   \param stats : statistics
+   \return true if s satisfies labels, false otherwise
+   \post if s does not satisfy labels and it is not found in the cache with a larger or equal remaining depth, it
+   has been stored in the cache and, if remaining is positive, pushed on stack with its successors. If remaining
+   is 0 and s has successors, cut has been set to true
+   */
+  bool visit(TS & ts, const_state_sptr_t const & s, boost::dynamic_bitset<> const & labels, std::size_t remaining,
+             std::vector<frame_t> & stack, bool & cut, tchecker::algorithms::reach::bmc_stats_t & stats)
+  {
+    if (!_cache.empty()) {
+      cache_entry_t & entry = _cache[hash_value(*s) % _cache.size()];
+      if (entry.state.ptr() != nullptr && entry.remaining >= remaining && *entry.state == *s)
+        return false;
+      entry.state = s;
+      entry.remaining = remaining;
+    }
+
+    ++stats.visited_states();
+
+    if (!labels.none() && labels.is_subset_of(ts.labels(s)) && ts.is_valid_final(s)) {
+      stats.reachable() = true;
+      return true;
+    }
+
+    std::vector<typename TS::sst_t> next;
+    ts.next(s, next);
+    if (next.empty())
+      return false;
+    if (remaining == 0)
+      cut = true;
+    else
+      stack.push_back(frame_t{s, std::move(next), 0});
+    return false;
+  }
+
+  /*!
+   \brief Empty the cache of visited states
+   \post all the entries of the cache are empty, and the states they referred to have been released
+   */
+  void clear_cache()
+  {
+    for (cache_entry_t & entry : _cache)
+      entry = cache_entry_t{};
+  }
+
+  std::vector<cache_entry_t> _cache;             /*!< Cache of visited states */
+  const_state_sptr_t _initial_state{nullptr};    /*!< Initial state of the run to a satisfying state */
+  std::vector<tchecker::const_vedge_sptr_t> _path; /*!< Tuples of edges of the run to a satisfying state */
+};
+
+} // end of namespace reach
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_REACH_BMC_HH
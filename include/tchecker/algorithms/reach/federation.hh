@@ -0,0 +1,216 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ALGORITHMS_REACH_FEDERATION_HH
+#define TCHECKER_ALGORITHMS_REACH_FEDERATION_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/budget.hh"
+#include "tchecker/algorithms/reach/stats.hh"
+#include "tchecker/dbm/federation.hh"
+#include "tchecker/ta/state.hh"
+#include "tchecker/ts/static.hh"
+#include "tchecker/waiting/factory.hh"
+#include "tchecker/waiting/queue.hh"
+#include "tchecker/waiting/stack.hh"
+
+/*!
+ \file federation.hh
+ \brief Reachability algorithm with visited zones stored as federations
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace reach {
+
+/*!
+ \class federation_algorithm_t
+ \brief Reachability algorithm that stores the visited zones of each tuple of locations and valuation of bounded
+ integer variables as a federation (see tchecker::dbm::federation_t). A state is covered when its zone is included in
+ the union of the visited zones, even if no visited zone includes it
+ \tparam TS : type of transition system, should implement tchecker::ts::fwd_t and tchecker::ts::inspector_t, and have
+ a method clone(s) that returns a copy of state s. States should derive from tchecker::ta::state_t, and have a
+ method zone_ptr() to the zone of the state, with methods dim() and dbm()
+ \note when a state is not covered and its zone minus the federation is a single DBM, only the new part of its zone
+ is explored: the successors of the rest of the zone are already visited or waiting. Otherwise the whole zone is
+ explored, which avoids exploring many small pieces of zones
+ */
+template <class TS> class federation_algorithm_t {
+  static_assert(tchecker::ts::is_static_v<TS>, "TS should be a final transition system, see tchecker::ts::is_static_t");
+
+public:
+  using state_sptr_t = typename TS::fwd_t::state_t;
+  using const_state_sptr_t = typename TS::fwd_t::const_state_t;
+
+  /*!
+   \brief Traversal of a transition system from its initial states
+   \param ts : a transition system
+   \param labels : accepting labels
+   \param policy : waiting list policy, either tchecker::waiting::QUEUE or tchecker::waiting::STACK
+   \param budget : budget of visited states, running time and memory
+   \post ts is traversed from its initial states until a state that satisfies labels is reached (if any), or
+   the budget is exceeded. A state is explored unless its zone is covered by the federation of its tuple of locations
+   and valuation of bounded integer variables. The order in which states are visited depends on policy
+   \return statistics on the run
+   \throw std::invalid_argument : if policy is neither tchecker::waiting::QUEUE nor tchecker::waiting::STACK
+   */
+  tchecker::algorithms::reach::stats_t run(TS & ts, boost::dynamic_bitset<> const & labels,
+                                           enum tchecker::waiting::policy_t policy,
+                                           tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{})
+  {
+    std::unique_ptr<tchecker::waiting::waiting_t<state_sptr_t>> waiting;
+    if (policy == tchecker::waiting::QUEUE)
+      waiting.reset(new tchecker::waiting::queue_t<state_sptr_t>{});
+    else if (policy == tchecker::waiting::STACK)
+      waiting.reset(new tchecker::waiting::stack_t<state_sptr_t>{});
+    else
+      throw std::invalid_argument("Unsupported waiting policy for exploration with federations");
+
+    _visited.clear();
+    _federations_count = 0;
+
+    tchecker::algorithms::reach::stats_t stats;
+
+    stats.set_start_time();
+
+    std::vector<typename TS::sst_t> sst;
+    ts.initial(sst);
+    for (auto && [status, s, t] : sst)
+      waiting->insert(s);
+    sst.clear();
+
+    while (!waiting->empty()) {
+      if (tchecker::algorithms::budget_exceeded(budget, stats.visited_states(), waiting->size(), stats))
+        break;
+
+      state_sptr_t s{waiting->first()};
+      waiting->remove_first();
+
+      if (!labels.none() && labels.is_subset_of(ts.labels(const_state_sptr_t{s})) &&
+          ts.is_valid_final(const_state_sptr_t{s})) {
+        ++stats.visited_states();
+        stats.reachable() = true;
+        break;
+      }
+
+      state_sptr_t explored = insert(ts, s);
+      if (explored.ptr() == nullptr)
+        continue;
+
+      ++stats.visited_states();
+
+      ts.next(const_state_sptr_t{explored}, sst);
+      for (auto && [status, next_s, t] : sst) {
+        waiting->insert(next_s);
+        ++stats.visited_transitions();
+      }
+      sst.clear();
+    }
+
+    waiting->clear();
+
+    std::size_t memsize = 0;
+    for (auto const & [h, bucket] : _visited)
+      for (entry_t const & e : bucket)
+        memsize += sizeof(entry_t) + e.federation.memsize();
+    stats.memory_usage()["FEDERATIONS"] = memsize;
+
+    stats.set_end_time();
+
+    return stats;
+  }
+
+  /*!
+   \brief Accessor
+   \return number of federations of visited zones (tuples of locations and valuations of bounded integer variables)
+   */
+  inline std::size_t federations() const { return _federations_count; }
+
+  /*!
+   \brief Accessor
+   \return number of DBMs in the federations of visited zones
+   */
+  inline std::size_t dbms() const
+  {
+    std::size_t count = 0;
+    for (auto const & [h, bucket] : _visited)
+      for (entry_t const & e : bucket)
+        count += e.federation.size();
+    return count;
+  }
+
+private:
+  /*!
+   \class entry_t
+   \brief Visited zones of a tuple of locations and valuation of bounded integer variables
+   */
+  struct entry_t {
+    const_state_sptr_t state;               /*!< A state with the tuple of locations and the valuation */
+    tchecker::dbm::federation_t federation; /*!< Visited zones */
+  };
+
+  /*!
+   \brief Insertion of a state in the visited zones
+   \param ts : transition system
+   \param s : a state
+   \return nullptr if the zone of s is covered by the visited zones, and otherwise the state to explore: either s, or
+   a clone of s restricted to the part of its zone that has not been visited yet when this part is a single DBM
+   \post the zone of s has been added to the visited zones of its tuple of locations and valuation
+   */
+  state_sptr_t insert(TS & ts, state_sptr_t const & s)
+  {
+    tchecker::ta::state_t const & ta_s = *s;
+    std::vector<entry_t> & bucket = _visited[tchecker::ta::hash_value(ta_s)];
+    entry_t * entry = nullptr;
+    for (entry_t & e : bucket)
+      if (static_cast<tchecker::ta::state_t const &>(*e.state) == ta_s) {
+        entry = &e;
+        break;
+      }
+
+    auto const & zone = s->zone_ptr();
+    if (entry == nullptr) {
+      tchecker::clock_id_t const dim = static_cast<tchecker::clock_id_t>(zone->dim());
+      bucket.push_back(entry_t{const_state_sptr_t{s}, tchecker::dbm::federation_t{dim}});
+      bucket.back().federation.add(zone->dbm());
+      ++_federations_count;
+      return s;
+    }
+
+    _pieces.clear();
+    std::size_t const pieces = entry->federation.subtract(zone->dbm(), _pieces);
+    if (pieces == 0)
+      return state_sptr_t{nullptr};
+
+    entry->federation.add(zone->dbm());
+    if (pieces > 1)
+      return s;
+
+    state_sptr_t part = ts.clone(*s);
+    std::copy(_pieces.begin(), _pieces.end(), part->zone_ptr()->dbm());
+    return part;
+  }
+
+  std::unordered_map<std::size_t, std::vector<entry_t>> _visited; /*!< Map : hash value -> visited zones */
+  std::size_t _federations_count{0};                              /*!< Number of federations */
+  std::vector<tchecker::dbm::db_t> _pieces;                       /*!< Pieces of zone differences */
+};
+
+} // end of namespace reach
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_REACH_FEDERATION_HH
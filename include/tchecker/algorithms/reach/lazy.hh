@@ -0,0 +1,476 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ALGORITHMS_REACH_LAZY_HH
+#define TCHECKER_ALGORITHMS_REACH_LAZY_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/budget.hh"
+#include "tchecker/algorithms/reach/stats.hh"
+#include "tchecker/basictypes.hh"
+#include "tchecker/clockbounds/clockbounds.hh"
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/ta/state.hh"
+#include "tchecker/ts/static.hh"
+#include "tchecker/variables/clocks.hh"
+#include "tchecker/waiting/factory.hh"
+#include "tchecker/waiting/queue.hh"
+#include "tchecker/waiting/stack.hh"
+
+/*!
+ \file lazy.hh
+ \brief Reachability algorithm with lazy abstraction: clock bounds are discovered on demand
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace reach {
+
+/*!
+ \class lazy_stats_t
+ \brief Statistics for reachability algorithm with lazy abstraction
+ */
+class lazy_stats_t : public tchecker::algorithms::reach::stats_t {
+public:
+  /*!
+   \brief Constructor
+   */
+  lazy_stats_t();
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of covered states
+   */
+  std::size_t & covered_states();
+
+  /*!
+   \brief Accessor
+   \return Number of covered states
+   */
+  std::size_t covered_states() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of coverings that have been broken by a refinement of clock bounds
+   */
+  std::size_t & uncovered_states();
+
+  /*!
+   \brief Accessor
+   \return Number of coverings that have been broken by a refinement of clock bounds
+   */
+  std::size_t uncovered_states() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of refinements of clock bounds of states
+   */
+  std::size_t & refinements();
+
+  /*!
+   \brief Accessor
+   \return Number of refinements of clock bounds of states
+   */
+  std::size_t refinements() const;
+
+  /*!
+   \brief Extract statistics as attributes (key, value)
+   \param m : attributes map
+   \post the attributes of tchecker::algorithms::reach::stats_t, COVERED_STATES, UNCOVERED_STATES and
+   BOUND_REFINEMENTS have been added to m
+   */
+  void attributes(std::map<std::string, std::string> & m) const;
+
+private:
+  std::size_t _covered_states;   /*!< Number of covered states */
+  std::size_t _uncovered_states; /*!< Number of broken coverings */
+  std::size_t _refinements;      /*!< Number of refinements of clock bounds */
+};
+
+/*!
+ \class lazy_algorithm_t
+ \brief Reachability algorithm with lazy abstraction (see "Lazy abstractions for timed automata", Herbreteau,
+ Srivathsan and Walukiewicz. CAV, 2013): zones are exact, and each node of the exploration tree has its own LU clock
+ bounds, which start empty. A node is covered by a visited node with the same locations and valuation of bounded
+ integer variables when its zone is included in the aLU abstraction of the zone of that node w.r.t. its bounds
+ \tparam TS : type of transition system, should implement tchecker::ts::fwd_t and tchecker::ts::inspector_t, with
+ exact zones (no extrapolation) and transitions that keep their constraints. States should derive from
+ tchecker::ta::state_t and have a method zone(), transitions should have methods guard_container(),
+ reset_container() and tgt_invariant_container()
+ \note The bounds of a node come from its invariant, from the guards of its outgoing edges that are not implied by
+ its zone (either enabled edges, or edges that are disabled by clock constraints), and from the bounds of its
+ successors through the resets of the edges. Hence a guard is only accounted for in the nodes where it restricts the zone.
+ When the bounds of a node grow, they are propagated to its parent and to the nodes it covers, and the coverings
+ that do not hold anymore are broken: the uncovered nodes are explored again
+ */
+template <class TS> class lazy_algorithm_t {
+  static_assert(tchecker::ts::is_static_v<TS>, "TS should be a final transition system, see tchecker::ts::is_static_t");
+
+public:
+  using state_sptr_t = typename TS::fwd_t::state_t;
+  using const_state_sptr_t = typename TS::fwd_t::const_state_t;
+  using transition_sptr_t = typename TS::fwd_t::transition_t;
+
+  /*!
+   \brief Traversal of a transition system from its initial states
+   \param ts : a transition system
+   \param labels : accepting labels
+   \param policy : waiting list policy, either tchecker::waiting::QUEUE or tchecker::waiting::STACK
+   \param budget : budget of visited states, running time and memory
+   \post ts is traversed from its initial states until a state that satisfies labels is reached (if any), or
+   the budget is exceeded
+   \return statistics on the run
+   \throw std::invalid_argument : if policy is neither tchecker::waiting::QUEUE nor tchecker::waiting::STACK
+   \throw std::invalid_argument : if a diagonal clock constraint is met (the aLU abstraction is not sound for
+   diagonal constraints)
+   */
+  tchecker::algorithms::reach::lazy_stats_t
+  run(TS & ts, boost::dynamic_bitset<> const & labels, enum tchecker::waiting::policy_t policy,
+      tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{})
+  {
+    std::unique_ptr<tchecker::waiting::waiting_t<std::size_t>> waiting;
+    if (policy == tchecker::waiting::QUEUE)
+      waiting.reset(new tchecker::waiting::queue_t<std::size_t>{});
+    else if (policy == tchecker::waiting::STACK)
+      waiting.reset(new tchecker::waiting::stack_t<std::size_t>{});
+    else
+      throw std::invalid_argument("Unsupported waiting policy for lazy abstraction");
+
+    _nodes.clear();
+    _visited.clear();
+
+    tchecker::algorithms::reach::lazy_stats_t stats;
+
+    stats.set_start_time();
+
+    std::vector<typename TS::sst_t> sst;
+    ts.initial(sst);
+    for (auto && [status, s, t] : sst)
+      waiting->insert(add_node(s, NO_NODE, transition_sptr_t{nullptr}));
+    sst.clear();
+
+    tchecker::state_status_t const mask = tchecker::STATE_OK | tchecker::STATE_CLOCKS_GUARD_VIOLATED |
+                                          tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED |
+                                          tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED;
+
+    while (!waiting->empty()) {
+      if (tchecker::algorithms::budget_exceeded(budget, stats.visited_states(), waiting->size(), stats))
+        break;
+
+      std::size_t const n = waiting->first();
+      waiting->remove_first();
+
+      const_state_sptr_t s{_nodes[n].state};
+      if (!labels.none() && labels.is_subset_of(ts.labels(s)) && ts.is_valid_final(s)) {
+        ++stats.visited_states();
+        stats.reachable() = true;
+        break;
+      }
+
+      if (cover(n)) {
+        ++stats.covered_states();
+        propagate(n, *waiting, stats);
+        continue;
+      }
+
+      ++stats.visited_states();
+      _visited[tchecker::ta::hash_value(*s)].push_back(n);
+
+      bool refined = false;
+      ts.next(s, sst, mask);
+      for (auto && [status, next_s, next_t] : sst) {
+        // the bounds that make the edge enabled or disabled from the zone of n, and the bounds of the invariant
+        // of n, which constrain delays
+        refined |= constrain_bounds(n, next_t->guard_container(), false);
+        refined |= constrain_bounds(n, next_t->src_invariant_container(), true);
+        if (status != tchecker::STATE_OK) {
+          refined |= pre_bounds(n, next_t->tgt_invariant_container(), next_t->reset_container());
+          continue;
+        }
+        waiting->insert(add_node(next_s, n, next_t));
+        ++stats.visited_transitions();
+      }
+      sst.clear();
+
+      if (refined)
+        propagate(n, *waiting, stats);
+    }
+
+    waiting->clear();
+
+    stats.set_end_time();
+
+    return stats;
+  }
+
+private:
+  /*!
+   \brief Identifier of no node
+   */
+  static constexpr std::size_t const NO_NODE = std::numeric_limits<std::size_t>::max();
+
+  /*!
+   \class node_t
+   \brief Node of the exploration tree
+   */
+  struct node_t {
+    state_sptr_t state;                            /*!< State */
+    std::size_t parent;                            /*!< Parent node (NO_NODE for initial nodes) */
+    transition_sptr_t transition;                  /*!< Transition from parent node */
+    std::vector<tchecker::clockbounds::bound_t> l; /*!< Lower bounds of clocks */
+    std::vector<tchecker::clockbounds::bound_t> u; /*!< Upper bounds of clocks */
+    std::size_t covering;                          /*!< Covering node (NO_NODE if not covered) */
+    std::vector<std::size_t> covered;              /*!< Covered nodes */
+  };
+
+  /*!
+   \brief Add a node to the exploration tree
+   \param s : a state
+   \param parent : parent node
+   \param t : transition from parent to s
+   \return identifier of the new node, which has empty bounds
+   */
+  std::size_t add_node(state_sptr_t const & s, std::size_t parent, transition_sptr_t const & t)
+  {
+    std::size_t const clocks = s->zone().dim() - 1;
+    _nodes.push_back(node_t{s, parent, t, std::vector<tchecker::clockbounds::bound_t>(clocks, tchecker::clockbounds::NO_BOUND),
+                            std::vector<tchecker::clockbounds::bound_t>(clocks, tchecker::clockbounds::NO_BOUND), NO_NODE,
+                            {}});
+    return _nodes.size() - 1;
+  }
+
+  /*!
+   \brief Covering check
+   \param n : a node
+   \param m : a visited node
+   \return true if n and m have the same tuple of locations and valuation of bounded integer variables, and the zone
+   of n is included in the aLU abstraction of the zone of m w.r.t. the bounds of m
+   */
+  bool is_covered(std::size_t n, std::size_t m) const
+  {
+    node_t const & node = _nodes[n];
+    node_t const & other = _nodes[m];
+    return tchecker::ta::operator==(*node.state, *other.state) &&
+           tchecker::dbm::is_alu_le(node.state->zone().dbm(), other.state->zone().dbm(), node.state->zone().dim(),
+                                    other.l.data(), other.u.data());
+  }
+
+  /*!
+   \brief Covering of a node
+   \param n : a node
+   \return true if n is covered by a visited node, false otherwise
+   \post if n is covered by a visited node m, m is the covering node of n, and n has the bounds of m
+   */
+  bool cover(std::size_t n)
+  {
+    auto it = _visited.find(tchecker::ta::hash_value(*_nodes[n].state));
+    if (it == _visited.end())
+      return false;
+    for (std::size_t m : it->second)
+      if (is_covered(n, m)) {
+        _nodes[n].covering = m;
+        _nodes[m].covered.push_back(n);
+        update(_nodes[n].l, _nodes[m].l);
+        update(_nodes[n].u, _nodes[m].u);
+        return true;
+      }
+    return false;
+  }
+
+  /*!
+   \brief Refine bounds of a node w.r.t. clock constraints
+   \param n : a node
+   \param constraints : clock constraints
+   \param all : whether the constraints implied by the zone of n should be accounted for
+   \post the bounds of n have been updated with the constants of the constraints in constraints (only those that
+   are not implied by the zone of n, unless all is true)
+   \return true if the bounds of n have been modified, false otherwise
+   \throw std::invalid_argument : if constraints contains a diagonal constraint
+   */
+  bool constrain_bounds(std::size_t n, tchecker::clock_constraint_container_t const & constraints, bool all)
+  {
+    node_t & node = _nodes[n];
+    tchecker::dbm::db_t const * dbm = node.state->zone().dbm();
+    tchecker::clock_id_t const dim = static_cast<tchecker::clock_id_t>(node.state->zone().dim());
+    bool modified = false;
+    for (tchecker::clock_constraint_t const & c : constraints) {
+      if (c.id1() != tchecker::REFCLOCK_ID && c.id2() != tchecker::REFCLOCK_ID)
+        throw std::invalid_argument("Lazy abstraction does not support diagonal clock constraints");
+      tchecker::clock_id_t const x = (c.id1() == tchecker::REFCLOCK_ID ? 0 : c.id1() + 1);
+      tchecker::clock_id_t const y = (c.id2() == tchecker::REFCLOCK_ID ? 0 : c.id2() + 1);
+      if (!all && dbm[x * dim + y] <= tchecker::dbm::db(c.comparator(), c.value()))
+        continue; // the constraint is implied by the zone
+      if (y == 0)
+        modified |= update(node.u, c.id1(), c.value());
+      else
+        modified |= update(node.l, c.id2(), -c.value());
+    }
+    return modified;
+  }
+
+  /*!
+   \brief Refine bounds of a node w.r.t. clock constraints after resets
+   \param n : a node
+   \param constraints : clock constraints that are checked after resets
+   \param resets : clock resets
+   \post the bounds of n have been updated with the constants of the constraints in constraints on the clocks that
+   are not reset to a constant, through resets (see tchecker::algorithms::reach::lazy_algorithm_t::pre_clock)
+   \return true if the bounds of n have been modified, false otherwise
+   \throw std::invalid_argument : if constraints contains a diagonal constraint
+   */
+  bool pre_bounds(std::size_t n, tchecker::clock_constraint_container_t const & constraints,
+                  tchecker::clock_reset_container_t const & resets)
+  {
+    node_t & node = _nodes[n];
+    bool modified = false;
+    for (tchecker::clock_constraint_t const & c : constraints) {
+      if (c.id1() != tchecker::REFCLOCK_ID && c.id2() != tchecker::REFCLOCK_ID)
+        throw std::invalid_argument("Lazy abstraction does not support diagonal clock constraints");
+      bool const upper = (c.id2() == tchecker::REFCLOCK_ID);
+      tchecker::clock_id_t x = (upper ? c.id1() : c.id2());
+      tchecker::integer_t bound = (upper ? c.value() : -c.value());
+      if (!pre_clock(resets, x, bound))
+        continue;
+      modified |= update(upper ? node.u : node.l, x, bound);
+    }
+    return modified;
+  }
+
+  /*!
+   \brief Bound of a clock before resets
+   \param resets : clock resets
+   \param x : a clock, set to the clock it is reset to, if any
+   \param bound : a bound on x after resets, updated to a bound on x before resets
+   \return false if x is reset to a constant (no bound before resets), true otherwise
+   */
+  static bool pre_clock(tchecker::clock_reset_container_t const & resets, tchecker::clock_id_t & x,
+                        tchecker::integer_t & bound)
+  {
+    for (auto it = resets.rbegin(); it != resets.rend(); ++it)
+      if (it->left_id() == x) {
+        if (it->reset_to_constant())
+          return false;
+        x = it->right_id();
+        bound -= it->value();
+        return true;
+      }
+    return true;
+  }
+
+  /*!
+   \brief Propagation of refined bounds
+   \param n : a node whose bounds have been refined
+   \param waiting : waiting nodes
+   \param stats : statistics
+   \post the bounds of n have been propagated to its ancestors through the resets of the transitions, and to the
+   nodes covered by n (and so on). The coverings that do not hold anymore have been broken, and the uncovered nodes
+   have been inserted in waiting
+   */
+  void propagate(std::size_t n, tchecker::waiting::waiting_t<std::size_t> & waiting,
+                 tchecker::algorithms::reach::lazy_stats_t & stats)
+  {
+    std::vector<std::size_t> refined{n};
+    while (!refined.empty()) {
+      std::size_t const m = refined.back();
+      refined.pop_back();
+      ++stats.refinements();
+
+      // the nodes covered by m get the bounds of m, unless the covering does not hold with these bounds
+      std::vector<std::size_t> & covered = _nodes[m].covered;
+      for (std::size_t k = 0; k < covered.size();) {
+        std::size_t const c = covered[k];
+        if (!is_covered(c, m)) {
+          _nodes[c].covering = NO_NODE;
+          covered[k] = covered.back();
+          covered.pop_back();
+          waiting.insert(c);
+          ++stats.uncovered_states();
+          continue;
+        }
+        bool modified = update(_nodes[c].l, _nodes[m].l);
+        modified |= update(_nodes[c].u, _nodes[m].u);
+        if (modified)
+          refined.push_back(c);
+        ++k;
+      }
+
+      // the parent of m gets the bounds of m before the resets of the transition from the parent
+      std::size_t const p = _nodes[m].parent;
+      if (p == NO_NODE)
+        continue;
+      tchecker::clock_reset_container_t const & resets = _nodes[m].transition->reset_container();
+      bool modified = false;
+      for (tchecker::clock_id_t x = 0; x < _nodes[m].l.size(); ++x) {
+        for (int upper = 0; upper < 2; ++upper) {
+          tchecker::clockbounds::bound_t const b = (upper ? _nodes[m].u[x] : _nodes[m].l[x]);
+          if (b == tchecker::clockbounds::NO_BOUND)
+            continue;
+          tchecker::clock_id_t y = x;
+          tchecker::integer_t bound = b;
+          if (pre_clock(resets, y, bound))
+            modified |= update(upper ? _nodes[p].u : _nodes[p].l, y, bound);
+        }
+      }
+      if (modified)
+        refined.push_back(p);
+    }
+  }
+
+  /*!
+   \brief Update of a bound
+   \param bounds : clock bounds
+   \param x : a clock
+   \param bound : a bound
+   \post bounds[x] has been set to the max of bounds[x] and bound
+   \return true if bounds[x] has been modified, false otherwise
+   */
+  static bool update(std::vector<tchecker::clockbounds::bound_t> & bounds, tchecker::clock_id_t x,
+                     tchecker::clockbounds::bound_t bound)
+  {
+    if (bound <= bounds[x])
+      return false;
+    bounds[x] = bound;
+    return true;
+  }
+
+  /*!
+   \brief Update of bounds
+   \param bounds : clock bounds
+   \param upd : clock bounds
+   \post bounds has been set to the max of bounds and upd
+   \return true if bounds has been modified, false otherwise
+   */
+  static bool update(std::vector<tchecker::clockbounds::bound_t> & bounds,
+                     std::vector<tchecker::clockbounds::bound_t> const & upd)
+  {
+    bool modified = false;
+    for (tchecker::clock_id_t x = 0; x < bounds.size(); ++x)
+      modified |= update(bounds, x, upd[x]);
+    return modified;
+  }
+
+  std::vector<node_t> _nodes;                                         /*!< Exploration tree */
+  std::unordered_map<std::size_t, std::vector<std::size_t>> _visited; /*!< Map : hash value -> visited nodes */
+};
+
+} // end of namespace reach
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_REACH_LAZY_HH
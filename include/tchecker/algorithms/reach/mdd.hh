@@ -0,0 +1,223 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ALGORITHMS_REACH_MDD_HH
+#define TCHECKER_ALGORITHMS_REACH_MDD_HH
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#if BOOST_VERSION <= 106600
+#include <boost/functional/hash.hpp>
+#else
+#include <boost/container_hash/hash.hpp>
+#endif
+
+#include "tchecker/algorithms/budget.hh"
+#include "tchecker/algorithms/reach/stats.hh"
+#include "tchecker/syncprod/state.hh"
+#include "tchecker/ts/static.hh"
+#include "tchecker/variables/intval_mdd.hh"
+#include "tchecker/waiting/factory.hh"
+#include "tchecker/waiting/queue.hh"
+#include "tchecker/waiting/stack.hh"
+
+/*!
+ \file mdd.hh
+ \brief Reachability algorithm with visited valuations of bounded integer variables stored as decision diagrams
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace reach {
+
+/*!
+ \class mdd_algorithm_t
+ \brief Reachability algorithm that groups the visited states with the same tuple of locations and the same zone,
+ and stores the valuations of bounded integer variables of each group as a decision diagram (see
+ tchecker::intval_mdd_t). The groups share the nodes of their diagrams, and each group keeps a single state for
+ its tuple of locations and its zone
+ \tparam TS : type of transition system, should implement tchecker::ts::fwd_t and tchecker::ts::inspector_t.
+ States should derive from tchecker::syncprod::state_t, and have methods intval() and zone() that return their
+ valuation of bounded integer variables and their zone, with a function hash_value and an operator == on zones
+ \note the exploration is exact, and successors are computed state by state. The memory of visited states is
+ smaller than in a graph when many states only differ by their valuations of bounded integer variables
+ */
+template <class TS> class mdd_algorithm_t {
+  static_assert(tchecker::ts::is_static_v<TS>, "TS should be a final transition system, see tchecker::ts::is_static_t");
+
+public:
+  using state_sptr_t = typename TS::fwd_t::state_t;
+  using const_state_sptr_t = typename TS::fwd_t::const_state_t;
+
+  /*!
+   \brief Constructor
+   \param intvars : flat bounded integer variables of states
+   */
+  mdd_algorithm_t(tchecker::flat_integer_variables_t const & intvars) : _mdd(intvars), _collected(0) {}
+
+  /*!
+   \brief Traversal of a transition system from its initial states
+   \param ts : a transition system
+   \param labels : accepting labels
+   \param policy : waiting list policy, either tchecker::waiting::QUEUE or tchecker::waiting::STACK
+   \param budget : budget of visited states, running time and memory
+   \post ts is traversed from its initial states until a state that satisfies labels is reached (if any), or
+   the budget is exceeded. A state is explored unless its valuation is in the set of its group. The order in
+   which states are visited depends on policy
+   \return statistics on the run
+   \throw std::invalid_argument : if policy is neither tchecker::waiting::QUEUE nor tchecker::waiting::STACK
+   \throw std::out_of_range : if a state has a variable out of its range
+   */
+  tchecker::algorithms::reach::stats_t run(TS & ts, boost::dynamic_bitset<> const & labels,
+                                           enum tchecker::waiting::policy_t policy,
+                                           tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{})
+  {
+    std::unique_ptr<tchecker::waiting::waiting_t<state_sptr_t>> waiting;
+    if (policy == tchecker::waiting::QUEUE)
+      waiting.reset(new tchecker::waiting::queue_t<state_sptr_t>{});
+    else if (policy == tchecker::waiting::STACK)
+      waiting.reset(new tchecker::waiting::stack_t<state_sptr_t>{});
+    else
+      throw std::invalid_argument("Unsupported waiting policy for exploration with decision diagrams");
+
+    _groups.clear();
+    _groups_count = 0;
+
+    tchecker::algorithms::reach::stats_t stats;
+
+    stats.set_start_time();
+
+    std::vector<typename TS::sst_t> sst;
+    ts.initial(sst);
+    for (auto && [status, s, t] : sst)
+      if (insert(const_state_sptr_t{s}))
+        waiting->insert(s);
+    sst.clear();
+
+    while (!waiting->empty()) {
+      if (tchecker::algorithms::budget_exceeded(budget, stats.visited_states(), waiting->size(), stats))
+        break;
+
+      const_state_sptr_t s{waiting->first()};
+      waiting->remove_first();
+
+      ++stats.visited_states();
+
+      if (!labels.none() && labels.is_subset_of(ts.labels(s)) && ts.is_valid_final(s)) {
+        stats.reachable() = true;
+        break;
+      }
+
+      ts.next(s, sst);
+      for (auto && [status, next_s, t] : sst) {
+        if (insert(const_state_sptr_t{next_s}))
+          waiting->insert(next_s);
+        ++stats.visited_transitions();
+      }
+      sst.clear();
+    }
+
+    waiting->clear();
+
+    stats.memory_usage()["INTVAL_MDD"] = _mdd.memsize();
+    stats.memory_usage()["INTVAL_MDD_GROUPS"] = _groups_count * sizeof(group_t);
+
+    stats.set_end_time();
+
+    return stats;
+  }
+
+  /*!
+   \brief Accessor
+   \return number of groups of visited states (tuples of locations and zones)
+   */
+  inline std::size_t groups() const { return _groups_count; }
+
+  /*!
+   \brief Accessor
+   \return number of nodes of the decision diagrams of the groups
+   */
+  inline std::size_t nodes() const { return _mdd.nodes(); }
+
+private:
+  /*!
+   \class group_t
+   \brief Group of visited states with the same tuple of locations and zone
+   */
+  struct group_t {
+    const_state_sptr_t state;                /*!< A state of the group */
+    tchecker::intval_mdd_t::node_id_t root; /*!< Valuations of the group */
+  };
+
+  /*!
+   \brief Insertion of a state in the visited states
+   \param s : a state
+   \return true if s was not visited, false otherwise
+   \post s has been inserted in its group. Unreachable nodes of the decision diagrams have been collected if they
+   are as many as the nodes that remained after the last collection
+   */
+  bool insert(const_state_sptr_t const & s)
+  {
+    std::size_t h = tchecker::syncprod::hash_value(*s);
+    boost::hash_combine(h, s->zone());
+
+    std::vector<group_t> & bucket = _groups[h];
+    group_t * group = nullptr;
+    tchecker::syncprod::state_t const & vloc_s = *s;
+    for (group_t & g : bucket)
+      if (static_cast<tchecker::syncprod::state_t const &>(*g.state) == vloc_s && g.state->zone() == s->zone()) {
+        group = &g;
+        break;
+      }
+    if (group == nullptr) {
+      bucket.push_back(group_t{s, tchecker::intval_mdd_t::EMPTY});
+      group = &bucket.back();
+      ++_groups_count;
+    }
+
+    tchecker::intval_mdd_t::node_id_t const root = _mdd.insert(group->root, s->intval());
+    if (root == group->root)
+      return false;
+    group->root = root;
+
+    if (_mdd.nodes() > 2 * _collected + 1024)
+      collect();
+    return true;
+  }
+
+  /*!
+   \brief Garbage collection of the decision diagrams
+   \post the nodes that are not reachable from the roots of the groups have been reclaimed
+   */
+  void collect()
+  {
+    std::vector<tchecker::intval_mdd_t::node_id_t> roots;
+    roots.reserve(_groups_count);
+    for (auto const & [h, bucket] : _groups)
+      for (group_t const & g : bucket)
+        roots.push_back(g.root);
+    _mdd.collect(roots);
+    _collected = _mdd.nodes();
+  }
+
+  tchecker::intval_mdd_t _mdd;                                 /*!< Decision diagrams of valuations */
+  std::unordered_map<std::size_t, std::vector<group_t>> _groups; /*!< Map : hash value -> groups */
+  std::size_t _groups_count{0};                                /*!< Number of groups */
+  std::size_t _collected;                                      /*!< Nodes after the last collection */
+};
+
+} // end of namespace reach
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_REACH_MDD_HH
@@ -0,0 +1,195 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ALGORITHMS_REACH_PARTITIONED_HH
+#define TCHECKER_ALGORITHMS_REACH_PARTITIONED_HH
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/reach/stats.hh"
+#include "tchecker/ts/static.hh"
+#include "tchecker/utils/parallel.hh"
+
+/*!
+ \file partitioned.hh
+ \brief Reachability algorithm over hash-partitioned state ownership
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace reach {
+
+/*!
+ \class partitioned_algorithm_t
+ \brief Reachability algorithm where the state-space is partitioned among P partitions that do not share memory:
+ each state is owned by partition hash_value(state) mod P, which stores it in its own graph shard
+ \tparam TS : type of transition system, should implement tchecker::ts::fwd_t and tchecker::ts::inspector_t, have
+ methods clone(s) that copy the states of another transition system over the same system, and its states should have
+ a function hash_value found by argument-dependent lookup, that hashes their content
+ \tparam GRAPH : type of graph, should have a method add_node(s) that returns a pair (is_new_node, node), and nodes
+ of type GRAPH::node_sptr_t should have a method state_ptr() that yields a pointer to the corresponding state in TS
+ \note the exploration proceeds in bulk-synchronous supersteps. In each superstep, every partition (a thread)
+ expands its frontier on its own transition system and buffers the successors per owning partition. Then
+ every partition copies the successors that it owns from the send buffers into its own transition system, and
+ inserts them in its graph shard (the new nodes are its next frontier). A partition only reads the states of the
+ other partitions, and only while they are not expanding, hence partitions could be processes exchanging their send
+ buffers. The exploration terminates at the end of the first superstep that sends no state, or that reaches an
+ accepting state: the superstep barrier replaces distributed termination detection
+ \note the graph shards only store the nodes: edges are not stored as their source and target may be owned by
+ distinct partitions
+ */
+template <class TS, class GRAPH> class partitioned_algorithm_t {
+  static_assert(tchecker::ts::is_static_v<TS>, "TS should be a final transition system, see tchecker::ts::is_static_t");
+
+public:
+  using node_sptr_t = typename GRAPH::node_sptr_t;
+
+  /*!
+   \brief Type of pointers to the nodes in frontiers
+   \note frontiers do not hold references on their nodes, which are owned by the graph shards
+   */
+  using node_ptr_t = typename node_sptr_t::shared_object_t *;
+
+  /*!
+   \brief Traversal of a transition system from its initial states
+   \param ts : transition systems of the partitions
+   \param graphs : graph shards of the partitions
+   \param labels : accepting labels
+   \pre ts and graphs have the same positive size P. ts are transition systems over the same system, and the
+   transition system ts[i] only shares state components with graph shard graphs[i] (in particular, the
+   transition systems do not share state components with each other)
+   \post the states reachable from the initial states of ts[0] have been stored, until a state that satisfies labels
+   is reached (if any): graphs[i] has a node for each visited state owned by partition i. The visited states are
+   the same, and are visited in the same supersteps, as in a breadth-first search (up to the superstep that reaches
+   an accepting state, which may be explored further)
+   \return statistics on the run (summed over all partitions)
+   \throw std::invalid_argument : if the precondition on the numbers of transition systems and graphs is not satisfied
+   */
+  tchecker::algorithms::reach::stats_t run(std::vector<std::shared_ptr<TS>> const & ts,
+                                           std::vector<std::shared_ptr<GRAPH>> const & graphs,
+                                           boost::dynamic_bitset<> const & labels)
+  {
+    std::size_t const P = ts.size();
+    if (P == 0 || graphs.size() != P)
+      throw std::invalid_argument("Partitioned reachability requires as many graph shards as transition systems");
+
+    tchecker::algorithms::reach::stats_t stats;
+
+    stats.set_start_time();
+
+    std::vector<std::vector<node_ptr_t>> frontier(P); // nodes are owned by the graph shards
+    std::vector<std::vector<state_sptr_t>> outbox(P * P); // outbox[q * P + o]: states sent by q to their owner o
+    std::vector<counters_t> counters(P);
+    std::atomic<bool> reachable{false};
+
+    // initial states are sent by partition 0, and marked initial by their owner in the first superstep
+    std::vector<typename TS::sst_t> sst;
+    ts[0]->initial(sst);
+    for (auto && [status, s, t] : sst)
+      outbox[hash_value(*s) % P].push_back(s);
+    sst.clear();
+
+    for (bool initial = true; !reachable.load(); initial = false) {
+      // delivery: each partition copies the states that it owns into its transition system and its graph shard
+      tchecker::parallel_for(P, P, [&](std::size_t, std::size_t o) {
+        for (std::size_t q = 0; q < P; ++q)
+          for (state_sptr_t const & s : outbox[q * P + o]) {
+            auto && [is_new_node, node] = graphs[o]->add_node(q == o ? s : ts[o]->clone(*s));
+            if (initial)
+              node->initial(true);
+            if (is_new_node)
+              frontier[o].push_back(node.ptr());
+          }
+      });
+
+      // sent states are released while the partitions are idle
+      bool sent = false;
+      for (std::size_t i = 0; i < P * P; ++i) {
+        sent = sent || !outbox[i].empty();
+        outbox[i].clear();
+      }
+      if (!sent)
+        break;
+
+      // expansion: each partition computes the successors of its frontier, and buffers them per owner
+      tchecker::parallel_for(P, P, [&](std::size_t, std::size_t r) {
+        std::vector<typename TS::sst_t> successors;
+        for (node_ptr_t node : frontier[r]) {
+          if (reachable.load(std::memory_order_relaxed))
+            break;
+
+          ++counters[r].visited_states;
+
+          if (accepting(node, *ts[r], labels)) {
+            node->final(true);
+            reachable.store(true);
+            break;
+          }
+
+          ts[r]->next(node->state_ptr(), successors);
+          for (auto && [status, s, t] : successors) {
+            outbox[r * P + hash_value(*s) % P].push_back(s);
+            ++counters[r].visited_transitions;
+          }
+          successors.clear();
+        }
+        frontier[r].clear();
+      });
+    }
+
+    for (std::vector<state_sptr_t> & box : outbox)
+      box.clear();
+
+    for (counters_t const & c : counters) {
+      stats.visited_states() += c.visited_states;
+      stats.visited_transitions() += c.visited_transitions;
+    }
+    stats.reachable() = reachable.load();
+
+    stats.set_end_time();
+
+    return stats;
+  }
+
+private:
+  using state_sptr_t = typename TS::fwd_t::state_t;
+
+  /*!
+   \brief Counters of a partition
+   */
+  struct counters_t {
+    std::uint64_t visited_states = 0;      /*!< Number of visited states */
+    std::uint64_t visited_transitions = 0; /*!< Number of visited transitions */
+  };
+
+  /*!
+   \brief Check if a node is accepting
+   \param n : a node
+   \param ts : a transition system
+   \param labels : a set of labels
+   \return true if labels is not empty, and the set of labels in n contain labels, and n is a valid final state in
+   ts, false otherwise
+   */
+  bool accepting(node_ptr_t n, TS & ts, boost::dynamic_bitset<> const & labels)
+  {
+    return !labels.none() && labels.is_subset_of(ts.labels(n->state_ptr())) && ts.is_valid_final(n->state_ptr());
+  }
+};
+
+} // end of namespace reach
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_REACH_PARTITIONED_HH
@@ -5,6 +5,7 @@
 #ifndef TCHECKER_ALGORITHMS_REACH_STATS_HH
 #define TCHECKER_ALGORITHMS_REACH_STATS_HH
 
+#include <cstdint>
 #include <map>
 #include <string>
 
@@ -36,25 +37,25 @@ public:
    \brief Accessor
    \return A reference to the number of visited states
   */
-  unsigned long & visited_states();
+  std::uint64_t & visited_states();
 
   /*!
   \brief Accessor
   \return Number of visited states
   */
-  unsigned long visited_states() const;
+  std::uint64_t visited_states() const;
 
   /*!
    \brief Accessor
    \return A reference to the number of visited transitions
   */
-  unsigned long & visited_transitions();
+  std::uint64_t & visited_transitions();
 
   /*!
   \brief Accessor
   \return Number of visited transitions
   */
-  unsigned long visited_transitions() const;
+  std::uint64_t visited_transitions() const;
 
   /*!
   \brief Accessor
@@ -68,17 +69,57 @@ public:
    */
   bool reachable() const;
 
+  /*!
+   \brief Accessor
+   \return true if exploration has been stopped because the memory limit has been reached, false otherwise
+   \note if true, reachable() == false does not mean that no satisfying state is reachable (see
+   tchecker::algorithms::stats_t::budget_status)
+   */
+  bool memory_limit_reached() const;
+
+  /*!
+   \brief Accessor
+   \return Reference to the probabilistic completeness flag
+   */
+  bool & probabilistic();
+
+  /*!
+   \brief Accessor
+   \return true if visited states have been stored as hash values (bitstate exploration), false otherwise
+   \note if true, reachable() == false means that no satisfying state has been found, but some states may
+   have been missed due to hash collisions
+   */
+  bool probabilistic() const;
+
+  /*!
+   \brief Accessor
+   \return Reference to the collision probability
+   */
+  double & collision_probability();
+
+  /*!
+   \brief Accessor
+   \return probability that a new state was mistaken for a visited state at the end of a probabilistic run
+   */
+  double collision_probability() const;
+
   /*!
    \brief Extract statistics as attributes (key, value)
    \param m : attributes map
    \post every statistics has been added to m
+   \note MEMORY_LIMIT_REACHED is only added when the memory limit has been reached. REACHABLE is reported as
+   "unknown" when the budget has been exceeded, unless a satisfying state has been found. Similarly, COMPLETENESS and
+   COLLISION_PROBABILITY are only added for probabilistic runs, and ALLOCATIONS_PER_VISITED_STATE is only added when
+   allocations are counted (see tchecker::allocation_stats::enabled)
   */
   void attributes(std::map<std::string, std::string> & m) const;
 
 private:
-  unsigned long _visited_states;      /*!< Number of visited states */
-  unsigned long _visited_transitions; /*!< Number of visited transitions */
+  std::uint64_t _visited_states;      /*!< Number of visited states */
+  std::uint64_t _visited_transitions; /*!< Number of visited transitions */
   bool _reachable;                    /*!< Reachability of satisfying state */
+  bool _probabilistic;                /*!< Visited states stored as hash values */
+  double _collision_probability;      /*!< Probability of hash collision */
 };
 
 } // end of namespace reach
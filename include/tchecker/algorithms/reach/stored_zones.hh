@@ -0,0 +1,511 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ALGORITHMS_REACH_STORED_ZONES_HH
+#define TCHECKER_ALGORITHMS_REACH_STORED_ZONES_HH
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if BOOST_VERSION <= 106600
+#include <boost/functional/hash.hpp>
+#else
+#include <boost/container_hash/hash.hpp>
+#endif
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/budget.hh"
+#include "tchecker/algorithms/reach/stats.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/state.hh"
+#include "tchecker/ts/static.hh"
+#include "tchecker/utils/pool.hh"
+#include "tchecker/utils/shared_objects.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/variables/packed_intval.hh"
+#include "tchecker/waiting/factory.hh"
+#include "tchecker/waiting/queue.hh"
+#include "tchecker/waiting/stack.hh"
+#include "tchecker/zg/state.hh"
+#include "tchecker/zg/zone.hh"
+
+/*!
+ \file stored_zones.hh
+ \brief Reachability algorithm with the zones of nodes stored in a compressed format
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace reach {
+
+/*!
+ \class stores_intval_t
+ \brief Detection of storage formats that also store the valuations of bounded integer variables
+ \tparam STORAGE : storage format of the zones
+ \note value is true if STORAGE has a method restore_intval(stored, intval) that sets intval to the valuation of
+ bounded integer variables of stored
+ */
+template <class STORAGE, class = void> struct stores_intval_t : std::false_type {
+};
+
+template <class STORAGE>
+struct stores_intval_t<STORAGE, std::void_t<decltype(std::declval<STORAGE const &>().restore_intval(
+                                    std::declval<typename STORAGE::stored_zone_t const &>(),
+                                    std::declval<tchecker::intval_t &>()))>> : std::true_type {
+};
+
+/*!
+ \brief Shortcut for stores_intval_t
+ */
+template <class STORAGE>
+inline constexpr bool stores_intval_v = tchecker::algorithms::reach::stores_intval_t<STORAGE>::value;
+
+/*!
+ \class has_memsize_t
+ \brief Detection of storage formats that use memory aside from the stored zones
+ \tparam STORAGE : storage format of the zones
+ \note value is true if STORAGE has a method memsize() that returns the memory used by STORAGE itself, e.g. for
+ zones shared by the stored zones
+ */
+template <class STORAGE, class = void> struct has_memsize_t : std::false_type {
+};
+
+template <class STORAGE>
+struct has_memsize_t<STORAGE, std::void_t<decltype(std::declval<STORAGE const &>().memsize())>> : std::true_type {
+};
+
+/*!
+ \brief Shortcut for has_memsize_t
+ */
+template <class STORAGE> inline constexpr bool has_memsize_v = tchecker::algorithms::reach::has_memsize_t<STORAGE>::value;
+
+/*!
+ \class stores_expanded_only_t
+ \brief Detection of storage formats that only store the nodes that have been expanded
+ \tparam STORAGE : storage format of the zones
+ \note value is true if STORAGE::EXPANDED_ONLY is true. Then waiting nodes keep their full state, and they are stored
+ once their successors have been computed
+ */
+template <class STORAGE, class = void> struct stores_expanded_only_t : std::false_type {
+};
+
+template <class STORAGE>
+struct stores_expanded_only_t<STORAGE, std::enable_if_t<STORAGE::EXPANDED_ONLY>> : std::true_type {
+};
+
+/*!
+ \brief Shortcut for stores_expanded_only_t
+ */
+template <class STORAGE>
+inline constexpr bool stores_expanded_only_v = tchecker::algorithms::reach::stores_expanded_only_t<STORAGE>::value;
+
+namespace details {
+
+/*!
+ \class hot_state_t
+ \brief Full state of a node that has not been stored yet
+ \tparam STATE_SPTR : type of pointer to state
+ \tparam EXPANDED_ONLY : true if nodes are only stored once they have been expanded
+ \note empty if EXPANDED_ONLY is false
+ */
+template <class STATE_SPTR, bool EXPANDED_ONLY> struct hot_state_t {
+};
+
+template <class STATE_SPTR> struct hot_state_t<STATE_SPTR, true> {
+  STATE_SPTR state{nullptr}; /*!< Full state, nullptr once the node has been stored */
+};
+
+} // end of namespace details
+
+/*!
+ \class packed_intval_storage_t
+ \brief Storage format that stores the zones in the format of STORAGE, and the valuations of bounded integer variables
+ bit-packed (see tchecker::intval_packing_t)
+ \tparam STORAGE : storage format of the zones, that does not store valuations (see
+ tchecker::algorithms::reach::stores_intval_t)
+ \note valuations are unpacked to tchecker::intval_t when the nodes are restored, hence states and the VM are not
+ affected by the layout of stored valuations
+ */
+template <class STORAGE> class packed_intval_storage_t {
+  static_assert(!tchecker::algorithms::reach::stores_intval_v<STORAGE>, "STORAGE should not store valuations");
+
+public:
+  /*!
+   \brief Type of stored zones: zone in the format of STORAGE, and packed valuation
+   */
+  struct stored_zone_t {
+    typename STORAGE::stored_zone_t zone;        /*!< Stored zone */
+    std::vector<tchecker::packed_word_t> intval; /*!< Packed valuation of bounded integer variables */
+
+    /*!
+     \brief Accessor
+     \return number of bytes used by this stored zone
+     */
+    inline std::size_t memory_footprint() const
+    {
+      return zone.memory_footprint() + sizeof(intval) + intval.capacity() * sizeof(tchecker::packed_word_t);
+    }
+  };
+
+  /*!
+   \brief Constructor
+   \param storage : storage format of the zones
+   \param packing : layout of packed valuations
+   \throw std::invalid_argument : if packing is nullptr
+   */
+  packed_intval_storage_t(STORAGE const & storage, std::shared_ptr<tchecker::intval_packing_t const> const & packing)
+      : _storage(storage), _packing(packing)
+  {
+    if (_packing.get() == nullptr)
+      throw std::invalid_argument("Packed valuations need a packing layout");
+  }
+
+  /*!
+   \brief Compression
+   \param s : a state
+   \param zone : zone of s
+   \return the zone stored by STORAGE and the packed valuation of bounded integer variables of s
+   \throw std::out_of_range : if a variable of s is out of its range
+   */
+  stored_zone_t store(tchecker::ta::state_t const & s, tchecker::zg::zone_sptr_t const & zone)
+  {
+    stored_zone_t stored{_storage.store(s, zone), std::vector<tchecker::packed_word_t>(_packing->words(), 0)};
+    _packing->pack(s.intval(), stored.intval.data());
+    return stored;
+  }
+
+  /*!
+   \brief Decompression of the zone
+   \param stored : a stored zone
+   \param zone : a zone
+   \post zone is the zone represented by stored
+   */
+  inline void restore(stored_zone_t const & stored, tchecker::zg::zone_t & zone) const
+  {
+    _storage.restore(stored.zone, zone);
+  }
+
+  /*!
+   \brief Decompression of the valuation of bounded integer variables
+   \param stored : a stored zone
+   \param intval : a valuation of bounded integer variables
+   \pre intval has the variables of the packing layout
+   \post intval is the valuation represented by stored
+   */
+  inline void restore_intval(stored_zone_t const & stored, tchecker::intval_t & intval) const
+  {
+    _packing->unpack(stored.intval.data(), intval);
+  }
+
+  /*!
+   \brief Accessor
+   \return memory used by the storage format of the zones (see tchecker::algorithms::reach::has_memsize_t)
+   */
+  inline std::size_t memsize() const
+  {
+    if constexpr (tchecker::algorithms::reach::has_memsize_v<STORAGE>)
+      return _storage.memsize();
+    else
+      return 0;
+  }
+
+private:
+  STORAGE _storage;                                           /*!< Storage format of the zones */
+  std::shared_ptr<tchecker::intval_packing_t const> _packing; /*!< Layout of packed valuations */
+};
+
+/*!
+ \class stored_zones_algorithm_t
+ \brief Reachability algorithm that keeps the nodes at rest (visited or waiting) with their zones in the format
+ of STORAGE instead of full DBMs
+ \tparam TS : type of transition system, should implement tchecker::ts::fwd_t and tchecker::ts::inspector_t, and have
+ a method clone(s) that returns a copy of state s. States should derive from tchecker::ta::state_t, and have methods
+ zone() and zone_ptr() to the zone of the state
+ \tparam STORAGE : storage format of the zones, with a type stored_zone_t that has a method memory_footprint(), a
+ method store(s, zone) that returns the stored_zone_t of the zone (a tchecker::zg::zone_sptr_t) of a state with
+ tchecker::ta::state_t s, and a method restore(stored, zone) that sets zone to the zone of stored. STORAGE may also
+store the valuation of bounded integer variables of s (see tchecker::algorithms::reach::stores_intval_t), then nodes
+do not keep their valuation aside
+ \note a node only keeps a copy of its tuple of locations, a copy of its valuation of bounded integer variables and its
+ stored zone. If STORAGE only stores expanded nodes (see tchecker::algorithms::reach::stores_expanded_only_t),
+ waiting nodes keep their full state instead, and they are stored once their successors have been computed. The zone
+ of a stored node is restored on demand: when the node is explored, and when a new state with the same tuple of
+ locations and valuation is compared to it. Nodes are hashed from the full zones, before they are stored, and they
+ are chained in a hash table through the nodes themselves. The transition system should not share the components of
+ its states (see tchecker::ts::NO_SHARING) since states are compared by value
+ \note the memory used by the nodes is reported as STORED_ZONES: nodes, stored zones, copies of tuples of locations
+ and of valuations, hash table, and the memory of STORAGE itself (see tchecker::algorithms::reach::has_memsize_t)
+ */
+template <class TS, class STORAGE> class stored_zones_algorithm_t {
+  static_assert(tchecker::ts::is_static_v<TS>, "TS should be a final transition system, see tchecker::ts::is_static_t");
+
+public:
+  using state_sptr_t = typename TS::fwd_t::state_t;
+  using const_state_sptr_t = typename TS::fwd_t::const_state_t;
+  using stored_zone_t = typename STORAGE::stored_zone_t;
+
+  /*!
+   \brief Constructor
+   \param storage : storage format of the zones
+   */
+  explicit stored_zones_algorithm_t(STORAGE const & storage = STORAGE{}) : _storage(storage) {}
+
+  /*!
+   \brief Traversal of a transition system from its initial states
+   \param ts : a transition system
+   \param labels : accepting labels
+   \param policy : waiting list policy, either tchecker::waiting::QUEUE or tchecker::waiting::STACK
+   \param budget : budget of visited states, running time and memory
+   \post ts is traversed from its initial states until a state that satisfies labels is reached (if any), or
+   the budget is exceeded. A state is explored unless it is equal to a stored node. The order in which states are
+   visited depends on policy
+   \return statistics on the run
+   \throw std::invalid_argument : if policy is neither tchecker::waiting::QUEUE nor tchecker::waiting::STACK
+   */
+  tchecker::algorithms::reach::stats_t run(TS & ts, boost::dynamic_bitset<> const & labels,
+                                           enum tchecker::waiting::policy_t policy,
+                                           tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{})
+  {
+    std::unique_ptr<tchecker::waiting::waiting_t<node_t *>> waiting;
+    if (policy == tchecker::waiting::QUEUE)
+      waiting.reset(new tchecker::waiting::queue_t<node_t *>{});
+    else if (policy == tchecker::waiting::STACK)
+      waiting.reset(new tchecker::waiting::stack_t<node_t *>{});
+    else
+      throw std::invalid_argument("Unsupported waiting policy for exploration with stored zones");
+
+    _buckets.clear();
+    _nodes.clear();
+    _vloc_pool.reset();
+    _intval_pool.reset();
+    _scratch = state_sptr_t{nullptr};
+
+    tchecker::algorithms::reach::stats_t stats;
+
+    stats.set_start_time();
+
+    std::vector<typename TS::sst_t> sst;
+    ts.initial(sst);
+    for (auto && [status, s, t] : sst) {
+      node_t * n = insert(ts, s);
+      if (n != nullptr)
+        waiting->insert(n);
+    }
+    sst.clear();
+
+    while (!waiting->empty()) {
+      if (tchecker::algorithms::budget_exceeded(budget, stats.visited_states(), waiting->size(), stats))
+        break;
+
+      node_t * n = waiting->first();
+      waiting->remove_first();
+
+      const_state_sptr_t s{restore(ts, *n)};
+
+      ++stats.visited_states();
+
+      if (!labels.none() && labels.is_subset_of(ts.labels(s)) && ts.is_valid_final(s)) {
+        stats.reachable() = true;
+        break;
+      }
+
+      ts.next(s, sst);
+      for (auto && [status, next_s, t] : sst) {
+        ++stats.visited_transitions();
+        node_t * next_n = insert(ts, next_s);
+        if (next_n != nullptr)
+          waiting->insert(next_n);
+      }
+      sst.clear();
+
+      // expanded nodes do not need their full state anymore
+      if constexpr (tchecker::algorithms::reach::stores_expanded_only_v<STORAGE>) {
+        n->zone = _storage.store(*n->state, n->state->zone_ptr());
+        n->state = state_sptr_t{nullptr};
+      }
+    }
+
+    waiting->clear();
+
+    stats.memory_usage()["STORED_ZONES"] = memsize();
+
+    stats.set_end_time();
+
+    return stats;
+  }
+
+  /*!
+   \brief Accessor
+   \return number of stored nodes
+   */
+  inline std::size_t nodes() const { return _nodes.size(); }
+
+  /*!
+   \brief Accessor
+   \return memory used by the stored nodes
+   */
+  std::size_t memsize() const
+  {
+    std::size_t memsize = _buckets.capacity() * sizeof(node_t *);
+    // the stored zone is counted by its memory footprint
+    for (node_t const & n : _nodes)
+      memsize += sizeof(node_t) - sizeof(stored_zone_t) + n.zone.memory_footprint();
+    if (_vloc_pool != nullptr)
+      memsize += _vloc_pool->memsize();
+    if (_intval_pool != nullptr)
+      memsize += _intval_pool->memsize();
+    if constexpr (tchecker::algorithms::reach::has_memsize_v<STORAGE>)
+      memsize += _storage.memsize();
+    return memsize;
+  }
+
+private:
+  /*!
+   \brief Number of components allocated in one block
+   */
+  static constexpr std::size_t ALLOC_NB = 1024;
+
+  /*!
+   \brief Initial number of buckets of the hash table of nodes
+   */
+  static constexpr std::size_t INITIAL_BUCKETS = 1024;
+
+  /*!
+   \class node_t
+   \brief Node at rest: tuple of locations, valuation of bounded integer variables and stored zone, and its full
+   state while it has not been stored (see tchecker::algorithms::reach::stores_expanded_only_t)
+   */
+  struct node_t
+      : tchecker::algorithms::reach::details::hot_state_t<state_sptr_t,
+                                                          tchecker::algorithms::reach::stores_expanded_only_v<STORAGE>> {
+    tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t> vloc;     /*!< Tuple of locations */
+    tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t> intval; /*!< Integer valuation, nullptr if stored */
+    stored_zone_t zone;                                                 /*!< Stored zone */
+    std::size_t hash;                                                   /*!< Hash value of the node */
+    node_t * next;                                                      /*!< Next node in the same bucket */
+  };
+
+  /*!
+   \brief Insertion of a state in the stored nodes
+   \param ts : transition system
+   \param s : a state
+   \return nullptr if s is equal to a stored node, and otherwise the new node of s
+   \post the zone of each stored node with the same hash value, tuple of locations and valuation as s has been
+   restored and compared to the zone of s. If none is equal, a node of s has been stored
+   */
+  node_t * insert(TS & ts, state_sptr_t const & s)
+  {
+    if (_scratch.ptr() == nullptr) {
+      _scratch = ts.clone(*s);
+      _vloc_pool = std::make_unique<tchecker::pool_t<tchecker::shared_vloc_t>>(
+          ALLOC_NB, tchecker::allocation_size_t<tchecker::shared_vloc_t>::alloc_size(s->vloc().capacity()));
+      _intval_pool = std::make_unique<tchecker::pool_t<tchecker::shared_intval_t>>(
+          ALLOC_NB, tchecker::allocation_size_t<tchecker::shared_intval_t>::alloc_size(s->intval().capacity()));
+    }
+
+    if (_nodes.size() >= _buckets.size())
+      rehash();
+
+    std::size_t h = tchecker::ta::hash_value(static_cast<tchecker::ta::state_t const &>(*s));
+    boost::hash_combine(h, s->zone().hash());
+    node_t *& head = _buckets[h & (_buckets.size() - 1)];
+    for (node_t * n = head; n != nullptr; n = n->next) {
+      if (n->hash != h || !(*n->vloc == s->vloc()))
+        continue;
+      if constexpr (tchecker::algorithms::reach::stores_expanded_only_v<STORAGE>) {
+        if (n->state.ptr() != nullptr) {
+          if (n->state->intval() == s->intval() && n->state->zone() == s->zone())
+            return nullptr;
+          continue;
+        }
+      }
+      if constexpr (tchecker::algorithms::reach::stores_intval_v<STORAGE>) {
+        _storage.restore_intval(n->zone, *_scratch->intval_ptr());
+        if (!(_scratch->intval() == s->intval()))
+          continue;
+      }
+      else if (!(*n->intval == s->intval()))
+        continue;
+      _storage.restore(n->zone, *_scratch->zone_ptr());
+      if (_scratch->zone() == s->zone())
+        return nullptr;
+    }
+
+    // nodes keep their own copies of the components of s, which do not keep the state of ts alive
+    tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t> intval{nullptr};
+    if constexpr (!tchecker::algorithms::reach::stores_intval_v<STORAGE>)
+      intval = _intval_pool->construct(s->intval());
+    if constexpr (tchecker::algorithms::reach::stores_expanded_only_v<STORAGE>) {
+      // the zone of s is stored once the node has been expanded
+      _nodes.push_back(node_t{{}, _vloc_pool->construct(s->vloc()), intval, stored_zone_t{}, h, head});
+      _nodes.back().state = s;
+    }
+    else
+      _nodes.push_back(node_t{{}, _vloc_pool->construct(s->vloc()), intval, _storage.store(*s, s->zone_ptr()), h, head});
+    head = &_nodes.back();
+    return &_nodes.back();
+  }
+
+  /*!
+   \brief Growth of the hash table of nodes
+   \post the number of buckets has doubled (or is INITIAL_BUCKETS if there was none), and the nodes have been
+   chained again in the buckets of their hash values
+   */
+  void rehash()
+  {
+    std::size_t const size = (_buckets.empty() ? INITIAL_BUCKETS : 2 * _buckets.size());
+    _buckets.assign(size, nullptr);
+    for (node_t & n : _nodes) {
+      node_t *& head = _buckets[n.hash & (size - 1)];
+      n.next = head;
+      head = &n;
+    }
+  }
+
+  /*!
+   \brief Restoration of a node
+   \param ts : transition system
+   \param n : a stored node
+   \return the full state of n if it has not been stored, and otherwise a state with the tuple of locations, the
+   valuation of bounded integer variables and the zone of n
+   */
+  state_sptr_t restore(TS & ts, node_t const & n)
+  {
+    if constexpr (tchecker::algorithms::reach::stores_expanded_only_v<STORAGE>)
+      if (n.state.ptr() != nullptr)
+        return n.state;
+
+    // the clone has its own components, which are overwritten by the stored ones
+    state_sptr_t s = ts.clone(*_scratch);
+    *s->vloc_ptr() = *n.vloc;
+    if constexpr (tchecker::algorithms::reach::stores_intval_v<STORAGE>)
+      _storage.restore_intval(n.zone, *s->intval_ptr());
+    else
+      *s->intval_ptr() = *n.intval;
+    _storage.restore(n.zone, *s->zone_ptr());
+    return s;
+  }
+
+  STORAGE _storage;                                                          /*!< Storage format of the zones */
+  std::unique_ptr<tchecker::pool_t<tchecker::shared_vloc_t>> _vloc_pool;     /*!< Pool of tuples of locations of nodes */
+  std::unique_ptr<tchecker::pool_t<tchecker::shared_intval_t>> _intval_pool; /*!< Pool of valuations of nodes */
+  std::deque<node_t> _nodes;                                                 /*!< Stored nodes */
+  std::vector<node_t *> _buckets;                                            /*!< Hash table: chains of nodes */
+  state_sptr_t _scratch{nullptr};                                            /*!< State where zones are restored to compare */
+};
+
+} // end of namespace reach
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_REACH_STORED_ZONES_HH
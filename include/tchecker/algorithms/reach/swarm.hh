@@ -0,0 +1,197 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ALGORITHMS_REACH_SWARM_HH
+#define TCHECKER_ALGORITHMS_REACH_SWARM_HH
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/budget.hh"
+#include "tchecker/algorithms/reach/stats.hh"
+#include "tchecker/algorithms/search_order.hh"
+#include "tchecker/ts/static.hh"
+#include "tchecker/utils/bitstate.hh"
+#include "tchecker/utils/parallel.hh"
+#include "tchecker/waiting/stack.hh"
+
+/*!
+ \file swarm.hh
+ \brief Swarm verification: diversified probabilistic depth-first searches in parallel
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace reach {
+
+/*!
+ \class swarm_algorithm_t
+ \brief Reachability algorithm that runs several depth-first searches in parallel, each with its own order of
+ successors and its own bitstate table of visited states (see tchecker::algorithms::reach::bitstate_algorithm_t).
+ The searches share nothing, and the first search that reaches a satisfying state stops the others
+ \tparam TS : type of transition system, should implement tchecker::ts::fwd_t and tchecker::ts::inspector_t,
+ and states should have a function hash_value found by argument-dependent lookup, that hashes their content
+ \note the searches explore distinct parts of the state-space first, hence the swarm is meant to find satisfying
+ states in state-spaces that are too large to be explored. Like bitstate exploration, a satisfying state that is
+ found is reachable, but the absence of satisfying states is only probable
+ */
+template <class TS> class swarm_algorithm_t {
+  static_assert(tchecker::ts::is_static_v<TS>, "TS should be a final transition system, see tchecker::ts::is_static_t");
+
+public:
+  using state_sptr_t = typename TS::fwd_t::state_t;
+  using const_state_sptr_t = typename TS::fwd_t::const_state_t;
+
+  /*!
+   \brief Constructor
+   \param table_size : size of the bitstate table of each search in bytes
+   \param hashes : number of bits set by each state
+   \param seed : seed of the orders of successors
+   \throw std::invalid_argument : see tchecker::bitstate_table_t
+   */
+  swarm_algorithm_t(std::size_t table_size, unsigned int hashes = 3,
+                    std::mt19937_64::result_type seed = tchecker::algorithms::RANDOM_SEARCH_SEED)
+      : _table_size(table_size), _hashes(hashes), _seed(seed)
+  {
+    tchecker::bitstate_table_t{table_size, hashes}; // checks the parameters before threads are started
+  }
+
+  /*!
+   \brief Traversal of a transition system from its initial states
+   \param ts : transition systems of the searches
+   \param labels : accepting labels
+   \param budget : budget of visited states, running time and memory of each search
+   \pre ts is not empty, and its elements are transition systems over the same system that share no state
+   component (in particular, each one can be used by its own thread)
+   \post ts.size() depth-first searches have been run in parallel, search i on ts[i], until a search reaches a
+   state that satisfies labels, or every search has completed or exceeded its budget. Search 0 visits successors
+   in the order computed by ts[0], and the other searches visit them in a random order seeded by the seed of the
+   swarm and the index of the search (runs are reproducible up to the search that first reaches labels)
+   \return statistics on the run: numbers of visited states and transitions are summed over the searches, and the
+   collision probability is the smallest one over the searches. The budget status and frontier size of the first
+   search that exceeded its budget are recorded if no search reached labels
+   \throw std::invalid_argument : if ts is empty
+   */
+  tchecker::algorithms::reach::stats_t run(std::vector<std::shared_ptr<TS>> const & ts, boost::dynamic_bitset<> const & labels,
+                                           tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{})
+  {
+    std::size_t const n = ts.size();
+    if (n == 0)
+      throw std::invalid_argument("Swarm verification requires at least one transition system");
+
+    tchecker::algorithms::reach::stats_t stats;
+
+    stats.set_start_time();
+
+    std::atomic<bool> reachable{false};
+    std::vector<tchecker::algorithms::reach::stats_t> members(n);
+
+    tchecker::parallel_for(n, n, [&](std::size_t, std::size_t i) {
+      tchecker::algorithms::budget_t const member_budget{budget}; // budgets are not shared by threads
+      members[i] = search(*ts[i], labels, i, member_budget, reachable);
+    });
+
+    stats.reachable() = reachable.load();
+    stats.probabilistic() = true;
+    stats.collision_probability() = 1.0;
+    for (tchecker::algorithms::reach::stats_t const & m : members) {
+      stats.visited_states() += m.visited_states();
+      stats.visited_transitions() += m.visited_transitions();
+      stats.collision_probability() = std::min(stats.collision_probability(), m.collision_probability());
+      if (!stats.reachable() && m.budget_exceeded() && !stats.budget_exceeded()) {
+        stats.budget_status() = m.budget_status();
+        stats.frontier_size() = m.frontier_size();
+      }
+    }
+
+    stats.set_end_time();
+
+    return stats;
+  }
+
+private:
+  /*!
+   \brief Depth-first search of a member of the swarm
+   \param ts : a transition system
+   \param labels : accepting labels
+   \param member : index of the search in the swarm
+   \param budget : budget of the search
+   \param reachable : flag of the swarm
+   \post ts has been traversed from its initial states until a state that satisfies labels is reached (then
+   reachable has been set to true), or reachable is true, or the budget is exceeded. Successors are pushed in a
+   random order generated from member, unless member is 0
+   \return statistics on the search
+   */
+  tchecker::algorithms::reach::stats_t search(TS & ts, boost::dynamic_bitset<> const & labels, std::size_t member,
+                                              tchecker::algorithms::budget_t const & budget,
+                                              std::atomic<bool> & reachable) const
+  {
+    tchecker::bitstate_table_t visited{_table_size, _hashes};
+    tchecker::waiting::stack_t<state_sptr_t> waiting;
+    std::mt19937_64 generator{_seed + member};
+
+    tchecker::algorithms::reach::stats_t stats;
+
+    std::vector<typename TS::sst_t> sst;
+    ts.initial(sst);
+    for (auto && [status, s, t] : sst)
+      if (visited.insert(hash_value(*s)))
+        waiting.insert(s);
+    sst.clear();
+
+    while (!waiting.empty() && !reachable.load(std::memory_order_relaxed)) {
+      if (tchecker::algorithms::budget_exceeded(budget, stats.visited_states(), waiting.size(), stats))
+        break;
+
+      const_state_sptr_t s{waiting.first()};
+      waiting.remove_first();
+
+      ++stats.visited_states();
+
+      if (!labels.none() && labels.is_subset_of(ts.labels(s)) && ts.is_valid_final(s)) {
+        stats.reachable() = true;
+        reachable.store(true);
+        break;
+      }
+
+      ts.next(s, sst);
+      if (member != 0)
+        std::shuffle(sst.begin(), sst.end(), generator);
+      for (auto && [status, next_s, t] : sst) {
+        if (visited.insert(hash_value(*next_s)))
+          waiting.insert(next_s);
+        ++stats.visited_transitions();
+      }
+      sst.clear();
+    }
+
+    waiting.clear();
+
+    stats.probabilistic() = true;
+    stats.collision_probability() = visited.collision_probability();
+
+    return stats;
+  }
+
+  std::size_t _table_size;             /*!< Size of the bitstate table of each search in bytes */
+  unsigned int _hashes;                /*!< Number of bits set by each state */
+  std::mt19937_64::result_type _seed; /*!< Seed of the orders of successors */
+};
+
+} // end of namespace reach
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_REACH_SWARM_HH
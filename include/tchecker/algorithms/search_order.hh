@@ -5,8 +5,17 @@
 #ifndef TCHECKER_ALGORITHMS_SEARCH_ORDER_HH
 #define TCHECKER_ALGORITHMS_SEARCH_ORDER_HH
 
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
 #include <string>
 
+#include <boost/dynamic_bitset/dynamic_bitset.hpp>
+
+#include "tchecker/syncprod/label_distance.hh"
+#include "tchecker/syncprod/system.hh"
 #include "tchecker/waiting/factory.hh"
 
 /*!
@@ -21,9 +30,10 @@ namespace algorithms {
 /*!
  \brief Conversion from search order to waiting policy
  \param search_order : search order
- \pre search_order is either "dfs" or "bfs"
+ \pre search_order is either "dfs", "bfs", "dist", "random" or "reset"
  \return tchecker::waiting::STACK if search_order is "dfs",
- tchecker::waiting::QUEUE if search_order is "bfs"
+ tchecker::waiting::QUEUE if search_order is "bfs",
+ tchecker::waiting::PRIORITY_QUEUE otherwise (guided search, see tchecker::algorithms::priority)
  \throw std::invalid_argument if the precondition is not satisfied
 */
 enum tchecker::waiting::policy_t waiting_policy(std::string const & search_order);
@@ -31,15 +41,61 @@ enum tchecker::waiting::policy_t waiting_policy(std::string const & search_order
 /*!
  \brief Conversion from search order to waiting policy for fast remove waiting containers
  \param search_order : search order
- \pre search_order is either "dfs" or "bfs"
+ \pre search_order is either "dfs", "bfs", "dist", "random" or "reset"
  \return tchecker::waiting::FAST_REMOVE_STACK if search_order is "dfs",
- tchecker::waiting::FAST_REMOVE_QUEUE if search_order is "bfs"
+ tchecker::waiting::FAST_REMOVE_QUEUE if search_order is "bfs",
+ tchecker::waiting::FAST_REMOVE_PRIORITY_QUEUE otherwise
  \throw std::invalid_argument if the precondition is not satisfied
 */
 enum tchecker::waiting::policy_t fast_remove_waiting_policy(std::string const & search_order);
 
+/*!
+ \brief Seed of the random search order (runs are reproducible)
+ */
+static constexpr std::mt19937_64::result_type RANDOM_SEARCH_SEED = 0;
+
+/*!
+ \brief Priority function of a guided search order
+ \tparam NODE_SPTR : type of pointer to nodes, nodes should have a method state() that returns a state with a method
+ vloc()
+ \param search_order : search order
+ \param system : a system of processes
+ \param labels : searched labels
+ \return the priority of nodes for search_order:
+ - "dist": distance from the tuple of locations of nodes to labels (see tchecker::syncprod::label_distance_t)
+ - "random": random priority (nodes are visited in a random order)
+ - "bfs" and "dfs": an empty function (no priority)
+ \throw std::invalid_argument : if search_order is not one of the orders above (in particular, "reset" needs reset
+ histories, hence it is only available in the compositional exploration)
+ */
+template <class NODE_SPTR>
+tchecker::waiting::priority_function_t<NODE_SPTR> priority(std::string const & search_order,
+                                                           tchecker::syncprod::system_t const & system,
+                                                           boost::dynamic_bitset<> const & labels)
+{
+  if (search_order == "bfs" || search_order == "dfs")
+    return nullptr;
+
+  if (search_order == "dist") {
+    std::shared_ptr<tchecker::syncprod::label_distance_t const> distance{
+        std::make_shared<tchecker::syncprod::label_distance_t const>(system, labels)};
+    return [distance](NODE_SPTR const & n) {
+      std::size_t const d = distance->distance(n->state().vloc());
+      return static_cast<tchecker::waiting::priority_t>(
+          std::min<std::size_t>(d, std::numeric_limits<tchecker::waiting::priority_t>::max()));
+    };
+  }
+
+  if (search_order == "random") {
+    std::shared_ptr<std::mt19937_64> generator{std::make_shared<std::mt19937_64>(RANDOM_SEARCH_SEED)};
+    return [generator](NODE_SPTR const &) { return static_cast<tchecker::waiting::priority_t>((*generator)() >> 1); };
+  }
+
+  throw std::invalid_argument("Unsupported search order: " + search_order);
+}
+
 } // end of namespace algorithms
 
 } // end of namespace tchecker
 
-#endif // TCHECKER_ALGORITHMS_SEARCH_ORDER_HH
\ No newline at end of file
+#endif // TCHECKER_ALGORITHMS_SEARCH_ORDER_HH
@@ -6,9 +6,16 @@
 #define TCHECKER_ALGORITHMS_STATS_HH
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
 #include <map>
+#include <ostream>
 #include <string>
 
+#include "tchecker/algorithms/budget.hh"
+#include "tchecker/utils/allocation_stats.hh"
+
 /*!
  \file stats.hh
  \brief Statistics for algorithms
@@ -18,14 +25,33 @@ namespace tchecker {
 
 namespace algorithms {
 
+/*!
+ \brief Current resident set size
+ \return current resident set size of the process in bytes, 0 if it cannot be determined
+ \note reads /proc/self/statm when available, falls back to the maximum resident set size otherwise
+ */
+std::size_t resident_memory();
+
+/*!
+ \brief Peak resident set size
+ \return maximum resident set size of the process in bytes, 0 if it cannot be determined
+ */
+std::size_t peak_resident_memory();
+
 /*!
  \class stats_t
  \brief Statistics for algorithms
  */
 class stats_t {
 public:
+  /*!
+   \brief Constructor
+   */
+  stats_t();
+
   /*!
    \brief Set starting time
+   \post the allocation counters have been read (see tchecker::allocation_stats::counters)
   */
   void set_start_time();
 
@@ -37,6 +63,7 @@ public:
 
   /*!
    \brief Set ending time
+   \post the allocations since the starting time have been recorded
   */
   void set_end_time();
 
@@ -59,16 +86,310 @@ public:
   */
   long max_rss() const;
 
+  /*!
+   \brief Accessor
+   \return number of allocations between starting time and ending time, 0 if allocations are not counted (see
+   tchecker::allocation_stats::enabled)
+   \note allocations of all threads are counted
+   */
+  std::uint64_t allocations() const;
+
+  /*!
+   \brief Accessor
+   \return number of bytes allocated between starting time and ending time, 0 if allocations are not counted
+   */
+  std::uint64_t allocated_bytes() const;
+
+  /*!
+   \brief Accessor
+   \return memory usage in bytes, by subsystem (states, zones, graph nodes, etc)
+   \note subsystems are filled by algorithms and transition systems, see for instance
+   tchecker::zg::zg_t::memory_usage
+   */
+  std::map<std::string, std::size_t> & memory_usage();
+
+  /*!
+   \brief Accessor
+   \return memory usage in bytes, by subsystem
+   */
+  std::map<std::string, std::size_t> const & memory_usage() const;
+
+  /*!
+   \brief Accessor
+   \return occupancy of tables and pools (load factors, longest probe sequences, numbers of blocks, etc)
+   \note filled by algorithms, see for instance tchecker::graph::reachability::graph_t::occupancy
+   */
+  std::map<std::string, std::string> & occupancy();
+
+  /*!
+   \brief Accessor
+   \return occupancy of tables and pools
+   */
+  std::map<std::string, std::string> const & occupancy() const;
+
+  /*!
+   \brief Accessor
+   \return Reference to the budget status
+   */
+  enum tchecker::algorithms::budget_status_t & budget_status();
+
+  /*!
+   \brief Accessor
+   \return status of the budget when the algorithm stopped: tchecker::algorithms::BUDGET_AVAILABLE if the algorithm
+   ran to completion, otherwise the limit that stopped the algorithm, in which case its verdict is unknown unless a
+   witness has been found (see tchecker::algorithms::budget_t)
+   */
+  enum tchecker::algorithms::budget_status_t budget_status() const;
+
+  /*!
+   \brief Accessor
+   \return true if the algorithm has been stopped by its budget, false otherwise
+   */
+  bool budget_exceeded() const;
+
+  /*!
+   \brief Accessor
+   \return Reference to the frontier size
+   */
+  std::size_t & frontier_size();
+
+  /*!
+   \brief Accessor
+   \return number of nodes that were waiting to be explored when the algorithm was stopped by its budget
+   */
+  std::size_t frontier_size() const;
+
   /*!
    \brief Extract statistics as attributes (key, value)
    \param m : attributes map
-   \post Starting time, ending time and running time have been added to m
+   \post Starting time, ending time and running time have been added to m, as well as the peak resident set
+   size, the memory usage of each subsystem (as MEMORY_<subsystem>) and the occupancy of tables and pools (as
+   OCCUPANCY_<key>). BUDGET_EXCEEDED (the exceeded limit) and
+   FRONTIER_SIZE have been added if the algorithm has been stopped by its budget. ALLOCATIONS, DEALLOCATIONS and
+   ALLOCATED_BYTES have been added if allocations are counted
   */
   void attributes(std::map<std::string, std::string> & m) const;
 
 private:
   std::chrono::time_point<std::chrono::steady_clock> _start_time; /*!< Start time */
   std::chrono::time_point<std::chrono::steady_clock> _end_time;   /*!< End time */
+  tchecker::allocation_stats::counters_t _start_allocations;      /*!< Allocation counters at start time */
+  tchecker::allocation_stats::counters_t _allocations;            /*!< Allocations from start time to end time */
+  std::map<std::string, std::size_t> _memory_usage;               /*!< Memory usage by subsystem */
+  std::map<std::string, std::string> _occupancy;                  /*!< Occupancy of tables and pools */
+  enum tchecker::algorithms::budget_status_t _budget_status;      /*!< Status of the budget */
+  std::size_t _frontier_size;                                     /*!< Waiting nodes when stopped by the budget */
+};
+
+/*!
+ \brief Check a budget
+ \param budget : a budget
+ \param visited_states : number of visited states
+ \param frontier : number of nodes waiting to be explored
+ \param stats : statistics
+ \return true if budget is exceeded (see tchecker::algorithms::budget_t::check), false otherwise
+ \post if budget is exceeded, the exceeded limit and frontier have been recorded in stats
+ */
+bool budget_exceeded(tchecker::algorithms::budget_t const & budget, std::uint64_t visited_states, std::size_t frontier,
+                     tchecker::algorithms::stats_t & stats);
+
+/*!
+ \brief Output formats of statistics
+ */
+enum stats_format_t {
+  STATS_FORMAT_TEXT = 0, /*!< One line per attribute: key, separator and value */
+  STATS_FORMAT_JSON,     /*!< One JSON object */
+};
+
+/*!
+ \brief Output statistics
+ \param os : output stream
+ \param m : attributes map (see tchecker::algorithms::stats_t::attributes)
+ \param format : output format
+ \param separator : separator of keys and values in text format
+ \post the attributes in m have been output to os in format. In JSON format, m is output as an object on a single
+ line, with values that are numbers or booleans output as such, and other values output as strings
+ */
+void output_attributes(std::ostream & os, std::map<std::string, std::string> const & m,
+                       enum tchecker::algorithms::stats_format_t format, std::string const & separator = " ");
+
+/*!
+ \brief Allocations per visited state
+ \param allocations : number of allocations
+ \param visited_states : number of visited states
+ \return allocations / visited_states, 0 if visited_states is 0
+ */
+double allocations_per_state(std::uint64_t allocations, std::uint64_t visited_states);
+
+/*!
+ \class phase_stats_t
+ \brief Statistics of a phase of an algorithm that runs several phases (possibly several times each)
+ \note running times are cumulated over the runs of the phase. CPU time is the processor time of the whole process
+ (std::clock), hence it includes the worker threads of the phase, and the phases that run concurrently with it
+ */
+class phase_stats_t {
+public:
+  /*!
+   \brief Constructor
+   */
+  phase_stats_t();
+
+  /*!
+   \brief Accessor
+   \return Reference to the number of runs of the phase
+   */
+  std::uint64_t & runs();
+
+  /*!
+   \brief Accessor
+   \return Number of runs of the phase
+   */
+  std::uint64_t runs() const;
+
+  /*!
+   \brief Accessor
+   \return Reference to the wall-clock running time of the phase in seconds
+   */
+  double & running_time();
+
+  /*!
+   \brief Accessor
+   \return Wall-clock running time of the phase in seconds
+   */
+  double running_time() const;
+
+  /*!
+   \brief Accessor
+   \return Reference to the CPU time of the phase in seconds
+   */
+  double & cpu_time();
+
+  /*!
+   \brief Accessor
+   \return CPU time of the phase in seconds
+   */
+  double cpu_time() const;
+
+  /*!
+   \brief Accessor
+   \return Reference to the number of states visited by the phase
+   */
+  std::uint64_t & visited_states();
+
+  /*!
+   \brief Accessor
+   \return Number of states visited by the phase
+   */
+  std::uint64_t visited_states() const;
+
+  /*!
+   \brief Accessor
+   \return Reference to the number of transitions visited by the phase
+   */
+  std::uint64_t & visited_transitions();
+
+  /*!
+   \brief Accessor
+   \return Number of transitions visited by the phase
+   */
+  std::uint64_t visited_transitions() const;
+
+  /*!
+   \brief Accessor
+   \return Reference to the number of allocations of the phase
+   */
+  std::uint64_t & allocations();
+
+  /*!
+   \brief Accessor
+   \return Number of allocations of the phase, 0 if allocations are not counted
+   */
+  std::uint64_t allocations() const;
+
+  /*!
+   \brief Accessor
+   \return Reference to the number of bytes allocated by the phase
+   */
+  std::uint64_t & allocated_bytes();
+
+  /*!
+   \brief Accessor
+   \return Number of bytes allocated by the phase, 0 if allocations are not counted
+   */
+  std::uint64_t allocated_bytes() const;
+
+  /*!
+   \brief Cumulate statistics
+   \param stats : statistics of a phase
+   \post the runs, running times, numbers of visited states and transitions, and allocations of stats have been
+   added to this
+   \return this after update
+   */
+  tchecker::algorithms::phase_stats_t & operator+=(tchecker::algorithms::phase_stats_t const & stats);
+
+  /*!
+   \brief Extract statistics as attributes (key, value)
+   \param prefix : prefix of the keys
+   \param m : attributes map
+   \post prefix followed by _RUNS, _RUNNING_TIME_SECONDS, _CPU_TIME_SECONDS, _VISITED_STATES and
+   _VISITED_TRANSITIONS have been added to m. If allocations are counted, _ALLOCATIONS, _ALLOCATED_BYTES and
+   _ALLOCATIONS_PER_VISITED_STATE have been added as well
+   */
+  void attributes(std::string const & prefix, std::map<std::string, std::string> & m) const;
+
+private:
+  std::uint64_t _runs;                /*!< Number of runs */
+  double _running_time;               /*!< Wall-clock running time (seconds) */
+  double _cpu_time;                   /*!< CPU time (seconds) */
+  std::uint64_t _visited_states;      /*!< Number of visited states */
+  std::uint64_t _visited_transitions; /*!< Number of visited transitions */
+  std::uint64_t _allocations;         /*!< Number of allocations */
+  std::uint64_t _allocated_bytes;     /*!< Number of allocated bytes */
+};
+
+/*!
+ \class phase_timer_t
+ \brief Timer of a run of a phase: the run starts at construction and ends at destruction (or at stop)
+ */
+class phase_timer_t {
+public:
+  /*!
+   \brief Constructor
+   \param stats : statistics of a phase
+   \post a run of the phase has started
+   \note stats should not be destroyed before this timer is stopped
+   */
+  explicit phase_timer_t(tchecker::algorithms::phase_stats_t & stats);
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  phase_timer_t(tchecker::algorithms::phase_timer_t const &) = delete;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::algorithms::phase_timer_t & operator=(tchecker::algorithms::phase_timer_t const &) = delete;
+
+  /*!
+   \brief Destructor
+   \post see stop
+   */
+  ~phase_timer_t();
+
+  /*!
+   \brief Stop the timer
+   \post if the timer was running, the run has been added to the runs of the phase, with its wall-clock and CPU
+   times and its allocations. Does nothing otherwise
+   \note allocations are counted over all threads, like CPU time
+   */
+  void stop();
+
+private:
+  tchecker::algorithms::phase_stats_t * _stats;                   /*!< Statistics of the phase (nullptr if stopped) */
+  std::chrono::time_point<std::chrono::steady_clock> _start_time; /*!< Start of the run */
+  std::clock_t _start_cpu;                                        /*!< Processor time at the start of the run */
+  tchecker::allocation_stats::counters_t _start_allocations;      /*!< Allocation counters at the start of the run */
 };
 
 } // end of namespace algorithms
@@ -0,0 +1,175 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_API_API_HH
+#define TCHECKER_API_API_HH
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "tchecker/algorithms/budget.hh"
+#include "tchecker/parsing/declaration.hh"
+
+/*!
+ \file api.hh
+ \brief In-process verification of systems (library libtchecker_api)
+ \note a system is loaded once, then queries run on it in the calling thread. Concurrent queries are supported on
+ distinct systems, as well as on the same system (systems are only read by queries). A query is stopped by its
+ budget or by its cancellation token, which the exploration loops check (see tchecker::algorithms::budget_t)
+ */
+
+namespace tchecker {
+
+namespace api {
+
+/*!
+ \class system_t
+ \brief System loaded for verification
+ */
+class system_t {
+public:
+  /*!
+   \brief Load a system from a file
+   \param filename : file name (in any format supported by tchecker::parsing::parse_system_declaration)
+   \return the system declared in filename
+   \throw std::runtime_error : if filename cannot be parsed (errors have been reported to std::cerr)
+   */
+  static std::shared_ptr<tchecker::api::system_t const> load(std::string const & filename);
+
+  /*!
+   \brief Load a system from a string
+   \param text : declaration of a system in TChecker syntax
+   \param name : name of the declaration in error messages
+   \return the system declared in text
+   \throw std::runtime_error : if text cannot be parsed (errors have been reported to std::cerr)
+   */
+  static std::shared_ptr<tchecker::api::system_t const> from_string(std::string const & text,
+                                                                   std::string const & name = "<string>");
+
+  /*!
+   \brief Accessor
+   \return name of the system
+   */
+  std::string const & name() const;
+
+  /*!
+   \brief Accessor
+   \return declaration of the system
+   */
+  inline std::shared_ptr<tchecker::parsing::system_declaration_t> const & declaration() const { return _sysdecl; }
+
+private:
+  /*!
+   \brief Constructor
+   \param sysdecl : system declaration
+   \pre sysdecl is not nullptr
+   */
+  explicit system_t(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl);
+
+  std::shared_ptr<tchecker::parsing::system_declaration_t> _sysdecl; /*!< System declaration */
+};
+
+/*!
+ \brief Verdict of a query
+ */
+enum verdict_t {
+  VERDICT_UNKNOWN = 0, /*!< Stopped by its budget or cancelled before a witness has been found, or incomplete */
+  VERDICT_FOUND,       /*!< A witness has been found (reachable labels, or accepting cycle) */
+  VERDICT_NOT_FOUND,   /*!< Complete exploration, no witness */
+};
+
+/*!
+ \brief Output operator
+ \param os : output stream
+ \param verdict : a verdict
+ \post verdict has been output to os ("unknown", "found" or "not found")
+ \return os after output
+ */
+std::ostream & operator<<(std::ostream & os, enum tchecker::api::verdict_t verdict);
+
+/*!
+ \brief Result of a query
+ */
+struct result_t {
+  enum tchecker::api::verdict_t verdict;                   /*!< Verdict */
+  enum tchecker::algorithms::budget_status_t budget_status; /*!< Limit that stopped the query, if any */
+  std::map<std::string, std::string> stats;                /*!< Statistics, with the keys output by the tools */
+};
+
+/*!
+ \brief Options shared by all queries
+ */
+struct options_t {
+  std::string labels = "";                                          /*!< Comma-separated accepting labels */
+  std::size_t block_size = 10000;                                   /*!< Number of elements allocated in one block */
+  std::size_t table_size = 65536;                                   /*!< Size of hash tables */
+  std::size_t threads = 1;                                          /*!< Number of threads */
+  bool por = false;                                                 /*!< Partial-order reduction */
+  std::uint64_t max_states = 0;                                     /*!< Budget of visited states (0: no limit) */
+  std::chrono::milliseconds timeout = std::chrono::milliseconds{0}; /*!< Time budget (0: no limit) */
+  std::size_t max_memory = 0;                                       /*!< Memory budget in bytes (0: no limit) */
+};
+
+/*!
+ \brief Options of reachability queries (see tck-reach -a reach)
+ */
+struct reach_options_t : public tchecker::api::options_t {
+  std::string search_order = "bfs"; /*!< Search order: "bfs", "dfs", "dist" or "random" */
+  std::size_t bitstate_size = 0;    /*!< Bytes of the bitstate table (0: exact exploration) */
+  bool symmetry = false;            /*!< Symmetry reduction */
+  bool active_clocks = false;       /*!< Active-clock reduction */
+  bool on_the_fly = false;          /*!< Detection of accepting nodes on the fly (see tck-reach --on-the-fly) */
+};
+
+/*!
+ \brief Liveness algorithms
+ */
+enum liveness_algorithm_t {
+  LIVENESS_NDFS = 0, /*!< Nested DFS (multi-core with several threads, see tck-liveness -a ndfs and -a cndfs) */
+  LIVENESS_COUVSCC,  /*!< SCC decomposition (UFSCC with several threads, see tck-liveness -a couvscc) */
+};
+
+/*!
+ \brief Options of liveness queries (see tck-liveness)
+ */
+struct liveness_options_t : public tchecker::api::options_t {
+  enum tchecker::api::liveness_algorithm_t algorithm = tchecker::api::LIVENESS_NDFS; /*!< Algorithm */
+  bool subsumption = false; /*!< aLU subsumption of zones (sequential nested DFS only) */
+};
+
+/*!
+ \brief Reachability query on the zone graph of a system
+ \param system : a system
+ \param options : options
+ \param cancellation : cancellation token (nullptr means no cancellation)
+ \return verdict and statistics of the reachability of options.labels in system
+ \throw std::invalid_argument : if options are not supported (see tchecker::tck_reach::zg_reach::run)
+ \note the verdict is unknown if options.labels have not been reached by a bitstate exploration, which may miss
+ states
+ */
+tchecker::api::result_t
+reach(tchecker::api::system_t const & system, tchecker::api::reach_options_t const & options,
+      std::shared_ptr<tchecker::algorithms::cancellation_token_t const> const & cancellation = nullptr);
+
+/*!
+ \brief Liveness query on the zone graph of a system
+ \param system : a system
+ \param options : options
+ \param cancellation : cancellation token (nullptr means no cancellation)
+ \return verdict and statistics of the existence of an accepting run of system w.r.t. options.labels
+ \throw std::invalid_argument : if options.subsumption is set with an algorithm other than the sequential nested DFS
+ */
+tchecker::api::result_t
+liveness(tchecker::api::system_t const & system, tchecker::api::liveness_options_t const & options,
+         std::shared_ptr<tchecker::algorithms::cancellation_token_t const> const & cancellation = nullptr);
+
+} // namespace api
+
+} // namespace tchecker
+
+#endif // TCHECKER_API_API_HH
@@ -0,0 +1,117 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_CLOCKBOUNDS_ACTIVE_CLOCKS_HH
+#define TCHECKER_CLOCKBOUNDS_ACTIVE_CLOCKS_HH
+
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/system.hh"
+
+/*!
+ \file active_clocks.hh
+ \brief Active clocks in a system
+ */
+
+namespace tchecker {
+
+namespace clockbounds {
+
+/*!
+ \class active_clocks_t
+ \brief Map from locations to active clocks
+ \note A clock x is active in a location l if its value may be read (in an invariant, a guard or the right-hand side
+ of an assignment) along some path from l before x is reset. The value of an inactive clock is never read, hence
+ the zones that only differ on inactive clocks are bisimilar and inactive clocks can be freed.
+ Clocks that are accessed by several processes are always active, and clocks that are not accessed by any process
+ are never active. A clock that is only accessed by process p is active in a tuple of locations if it is active in
+ the location of p
+ */
+class active_clocks_t {
+public:
+  /*!
+   \brief Constructor
+   \param system : a system of timed processes
+   \post this is the map of active clocks in system
+   \note a clock is considered reset by an edge if it is surely assigned by its statement (i.e. it is the left-hand
+   side of an assignment that is not within a conditional statement or a loop, and its identifier can be determined
+   statically)
+   */
+  active_clocks_t(tchecker::ta::system_t const & system);
+
+  /*!
+   \brief Accessor
+   \return number of clocks
+   */
+  inline tchecker::clock_id_t clock_number() const { return _clock_number; }
+
+  /*!
+   \brief Accessor
+   \return number of locations
+   */
+  inline tchecker::loc_id_t loc_number() const { return _loc_number; }
+
+  /*!
+   \brief Active clock predicate
+   \param vloc : tuple of locations
+   \param x : clock identifier
+   \pre vloc is a tuple of locations of the system this has been built from, and x < clock_number() (checked by
+   assertion)
+   \return true if clock x is active in vloc, false otherwise
+   */
+  bool active(tchecker::vloc_t const & vloc, tchecker::clock_id_t x) const;
+
+  /*!
+   \brief Accessor
+   \param vloc : tuple of locations
+   \param clocks : a vector of clock identifiers
+   \pre vloc is a tuple of locations of the system this has been built from
+   \post clocks contains the active clocks in vloc, in increasing order
+   */
+  void active_clocks(tchecker::vloc_t const & vloc, std::vector<tchecker::clock_id_t> & clocks) const;
+
+  /*!
+   \brief Accessor
+   \return true if some clock is inactive in some location, false otherwise
+   */
+  inline bool has_inactive_clocks() const { return _has_inactive_clocks; }
+
+  /*!
+   \brief Free inactive clocks
+   \param dbm : a DBM
+   \param dim : dimension of dbm
+   \param vloc : tuple of locations
+   \pre dbm is not nullptr (checked by assertion), dbm is a dim*dim tight and consistent DBM (checked by assertion),
+   dim is clock_number() + 1 (checked by assertion), vloc is a tuple of locations of the system this has been built
+   from
+   \post all the clocks that are inactive in vloc have been freed in dbm (system clock x is clock x+1 in dbm)
+   */
+  void free_inactive_clocks(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc) const;
+
+private:
+  /*!
+   \brief Marker of clocks accessed by several processes
+   */
+  static tchecker::process_id_t const SHARED;
+
+  /*!
+   \brief Marker of clocks not accessed by any process
+   */
+  static tchecker::process_id_t const UNUSED;
+
+  tchecker::clock_id_t _clock_number;          /*!< Number of (flattened) clocks */
+  tchecker::loc_id_t _loc_number;              /*!< Number of locations */
+  std::vector<tchecker::process_id_t> _owner;  /*!< Map : clock -> accessing process (or SHARED or UNUSED) */
+  std::vector<bool> _active;                   /*!< Map : (location, clock) -> active */
+  bool _has_inactive_clocks;                   /*!< Some clock is inactive in some location */
+};
+
+} // end of namespace clockbounds
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_CLOCKBOUNDS_ACTIVE_CLOCKS_HH
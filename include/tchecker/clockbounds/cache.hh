@@ -0,0 +1,98 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_CLOCKBOUNDS_CACHE_HH
+#define TCHECKER_CLOCKBOUNDS_CACHE_HH
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+#include "tchecker/clockbounds/clockbounds.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/system.hh"
+
+/*!
+ \file cache.hh
+ \brief Cache of clock bounds of system declarations
+ */
+
+namespace tchecker {
+
+namespace clockbounds {
+
+/*!
+ \class cache_t
+ \brief Clock bounds of systems, computed once for each system declaration
+ \note the declarations are identified by their address, and they are kept alive by the cache, hence an address
+ cannot be reused for another declaration while the cache exists. The cache is thread-safe
+ */
+class cache_t {
+public:
+  /*!
+   \brief Constructor
+   \post this is an empty cache
+   */
+  cache_t() = default;
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  cache_t(tchecker::clockbounds::cache_t const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  cache_t(tchecker::clockbounds::cache_t &&) = delete;
+
+  /*!
+   \brief Destructor
+   */
+  ~cache_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::clockbounds::cache_t & operator=(tchecker::clockbounds::cache_t const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::clockbounds::cache_t & operator=(tchecker::clockbounds::cache_t &&) = delete;
+
+  /*!
+   \brief Accessor
+   \param sysdecl : system declaration
+   \param system : system of timed processes
+   \pre system has been built from sysdecl
+   \return the clock bounds of system (see tchecker::clockbounds::compute_clockbounds), nullptr if they cannot be
+   computed. They are only computed the first time clock bounds are requested for sysdecl
+   */
+  std::shared_ptr<tchecker::clockbounds::clockbounds_t const>
+  clockbounds(std::shared_ptr<tchecker::parsing::system_declaration_t const> const & sysdecl,
+              tchecker::ta::system_t const & system);
+
+  /*!
+   \brief Accessor
+   \return number of system declarations with cached clock bounds
+   */
+  std::size_t size() const;
+
+private:
+  /*!
+   \brief Type of cache entries
+   */
+  using entry_t = std::tuple<std::shared_ptr<tchecker::parsing::system_declaration_t const>,
+                             std::shared_ptr<tchecker::clockbounds::clockbounds_t const>>;
+
+  mutable std::mutex _mutex;                                                   /*!< Lock on _entries */
+  std::map<tchecker::parsing::system_declaration_t const *, entry_t> _entries; /*!< Map : declaration -> clock bounds */
+};
+
+} // end of namespace clockbounds
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_CLOCKBOUNDS_CACHE_HH
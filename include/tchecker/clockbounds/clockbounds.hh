@@ -5,9 +5,11 @@
 #ifndef TCHECKER_CLOCKBOUNDS_HH
 #define TCHECKER_CLOCKBOUNDS_HH
 
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <memory>
+#include <tuple>
 #include <vector>
 
 #include "tchecker/basictypes.hh"
@@ -104,6 +106,13 @@ bool update(tchecker::clockbounds::map_t & map, tchecker::clockbounds::map_t con
  */
 std::ostream & operator<<(std::ostream & os, tchecker::clockbounds::map_t const & map);
 
+/*!
+ \brief Deleter of clock bound maps (see tchecker::clockbounds::deallocate_map)
+ */
+struct map_deleter_t {
+  void operator()(tchecker::clockbounds::map_t * m) const;
+};
+
 /*!
  \class local_lu_map_t
  \brief Map from system locations to LU clock bound maps
@@ -254,6 +263,97 @@ private:
  */
 std::ostream & operator<<(std::ostream & os, tchecker::clockbounds::local_lu_map_t const & map);
 
+/*!
+ \class local_lu_cache_t
+ \brief Bounded cache of the LU clock bound maps of tuples of locations
+ \note the LU maps of a tuple of locations are the maximum of the LU maps of its locations (see
+ tchecker::clockbounds::local_lu_map_t::bounds). The cache is direct-mapped: the maps of a tuple of locations are
+ stored in the slot of its hash value, and replace the maps of the tuple previously stored in this slot. The cache
+ is not thread-safe
+ */
+class local_lu_cache_t {
+public:
+  /*!
+   \brief Default number of slots
+   */
+  static constexpr std::size_t DEFAULT_SIZE = 4096;
+
+  /*!
+   \brief Constructor
+   \param map : local LU map
+   \param size : number of slots
+   \pre map is not nullptr
+   \throw std::invalid_argument : if size is 0
+   */
+  local_lu_cache_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & map,
+                   std::size_t size = DEFAULT_SIZE);
+
+  /*!
+   \brief Copy constructor
+   \param c : cache
+   \post this is an empty cache of the map of c, with as many slots as c
+   */
+  local_lu_cache_t(tchecker::clockbounds::local_lu_cache_t const & c);
+
+  /*!
+   \brief Move constructor
+   */
+  local_lu_cache_t(tchecker::clockbounds::local_lu_cache_t && c) = default;
+
+  /*!
+   \brief Destructor
+   */
+  ~local_lu_cache_t() = default;
+
+  /*!
+   \brief Assignment operator
+   \param c : cache
+   \post this is an empty cache of the map of c, with as many slots as c
+   \return this after assignment
+   */
+  tchecker::clockbounds::local_lu_cache_t & operator=(tchecker::clockbounds::local_lu_cache_t const & c);
+
+  /*!
+   \brief Move-assignment operator
+   */
+  tchecker::clockbounds::local_lu_cache_t & operator=(tchecker::clockbounds::local_lu_cache_t && c) = default;
+
+  /*!
+   \brief Accessor
+   \param vloc : tuple of location identifiers
+   \pre all locations identifiers in vloc are in [0..map().loc_number()) (checked by assertion)
+   \return the lower-bound and upper-bound maps for vloc (see tchecker::clockbounds::local_lu_map_t::bounds)
+   \note the returned maps are invalidated by the next call to bounds()
+   */
+  std::tuple<tchecker::clockbounds::map_t const &, tchecker::clockbounds::map_t const &>
+  bounds(tchecker::vloc_t const & vloc);
+
+  /*!
+   \brief Accessor
+   \return local LU map
+   */
+  inline std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & map() const { return _map; }
+
+  /*!
+   \brief Accessor
+   \return number of slots
+   */
+  inline std::size_t size() const { return _slots.size(); }
+
+private:
+  /*!
+   \brief Slot of the cache
+   */
+  struct slot_t {
+    std::vector<tchecker::loc_id_t> vloc;                           /*!< Tuple of locations */
+    std::unique_ptr<tchecker::clockbounds::map_t, map_deleter_t> L; /*!< Clock lower-bound map of vloc */
+    std::unique_ptr<tchecker::clockbounds::map_t, map_deleter_t> U; /*!< Clock upper-bound map of vloc */
+  };
+
+  std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> _map; /*!< Local LU map */
+  std::vector<slot_t> _slots;                                        /*!< Slots */
+};
+
 /*!
  \class global_lu_map_t
  \brief Map from system to LU clock bound maps
@@ -520,6 +620,94 @@ private:
  */
 std::ostream & operator<<(std::ostream & os, tchecker::clockbounds::local_m_map_t const & map);
 
+/*!
+ \class local_m_cache_t
+ \brief Bounded cache of the M clock bound maps of tuples of locations
+ \note the M map of a tuple of locations is the maximum of the M maps of its locations (see
+ tchecker::clockbounds::local_m_map_t::bounds). The cache is direct-mapped as tchecker::clockbounds::local_lu_cache_t,
+ and it is not thread-safe
+ */
+class local_m_cache_t {
+public:
+  /*!
+   \brief Default number of slots
+   */
+  static constexpr std::size_t DEFAULT_SIZE = 4096;
+
+  /*!
+   \brief Constructor
+   \param map : local M map
+   \param size : number of slots
+   \pre map is not nullptr
+   \throw std::invalid_argument : if size is 0
+   */
+  local_m_cache_t(std::shared_ptr<tchecker::clockbounds::local_m_map_t const> const & map,
+                  std::size_t size = DEFAULT_SIZE);
+
+  /*!
+   \brief Copy constructor
+   \param c : cache
+   \post this is an empty cache of the map of c, with as many slots as c
+   */
+  local_m_cache_t(tchecker::clockbounds::local_m_cache_t const & c);
+
+  /*!
+   \brief Move constructor
+   */
+  local_m_cache_t(tchecker::clockbounds::local_m_cache_t && c) = default;
+
+  /*!
+   \brief Destructor
+   */
+  ~local_m_cache_t() = default;
+
+  /*!
+   \brief Assignment operator
+   \param c : cache
+   \post this is an empty cache of the map of c, with as many slots as c
+   \return this after assignment
+   */
+  tchecker::clockbounds::local_m_cache_t & operator=(tchecker::clockbounds::local_m_cache_t const & c);
+
+  /*!
+   \brief Move-assignment operator
+   */
+  tchecker::clockbounds::local_m_cache_t & operator=(tchecker::clockbounds::local_m_cache_t && c) = default;
+
+  /*!
+   \brief Accessor
+   \param vloc : tuple of location identifiers
+   \pre all locations identifiers in vloc are in [0..map().loc_number()) (checked by assertion)
+   \return the clock bound map for vloc (see tchecker::clockbounds::local_m_map_t::bounds)
+   \note the returned map is invalidated by the next call to bounds()
+   */
+  tchecker::clockbounds::map_t const & bounds(tchecker::vloc_t const & vloc);
+
+  /*!
+   \brief Accessor
+   \return local M map
+   */
+  inline std::shared_ptr<tchecker::clockbounds::local_m_map_t const> const & map() const { return _map; }
+
+  /*!
+   \brief Accessor
+   \return number of slots
+   */
+  inline std::size_t size() const { return _slots.size(); }
+
+private:
+  /*!
+   \brief Slot of the cache
+   */
+  struct slot_t {
+    std::vector<tchecker::loc_id_t> vloc;                           /*!< Tuple of locations */
+    std::unique_ptr<tchecker::clockbounds::map_t, map_deleter_t> M; /*!< Clock bound map of vloc */
+  };
+
+  std::shared_ptr<tchecker::clockbounds::local_m_map_t const> _map; /*!< Local M map */
+  std::vector<slot_t> _slots;                                       /*!< Slots */
+};
+
 /*!
  \class global_m_map_t
  \brief Map from system to M clock bound maps
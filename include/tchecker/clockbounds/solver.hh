@@ -6,7 +6,9 @@
 #define TCHECKER_CLOCKBOUNDS_SOLVER_HH
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <vector>
 
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/dbm/dbm.hh"
@@ -49,6 +51,14 @@ and every location l, in the graph of the system of inequations.
 
 This class provides methods to specify the constraints from the transitions of an automaton, and a method to
 solve the system of inequations, and compute the resulting bounds.
+
+The graph of inequations is stored sparsely (one edge per inequation), and the system is solved lazily, when the
+bounds are first queried after a constraint has been added: the graph is decomposed into strongly connected
+components, each component is checked for negative cycles, and the minimal paths are computed by a worklist
+Bellman-Ford algorithm over the components in topological order. The constraints on the L and U variables share
+the same edges, only their bounds from guards differ. Assignments to a clock in another process (which propagate to
+every location of that process) go through one auxiliary variable per process and clock, instead of one edge per
+location
 */
 
 class df_solver_t {
@@ -195,13 +205,45 @@ protected:
   */
   std::size_t index(tchecker::loc_id_t l, tchecker::clock_id_t x) const;
 
-  tchecker::loc_id_t _loc_number;               /*!< Number of locations */
-  tchecker::clock_id_t _clock_number;           /*!< Number of clocks */
-  std::vector<tchecker::process_id_t> _loc_pid; /*!< Map: location ID -> process ID */
-  std::size_t _dim;                             /*!< Dimension of the equations */
-  tchecker::dbm::db_t * _L;                     /*!< Inequations on lower bounds L_{x,l} */
-  tchecker::dbm::db_t * _U;                     /*!< Inequations on upper bounds U_{x,l} */
-  bool _has_solution;                           /*!< Flags existence of a solution */
+  /*!
+  \brief Accessor
+  \param pid : process ID
+  \param x : clock ID
+  \pre 0 <= pid < _process_number (checked by assertion) and 0 <= x < _clock_number (checked by assertion)
+  \return The index of the auxiliary variable for the maximal bound of clock x over the locations of process pid
+  */
+  std::size_t process_index(tchecker::process_id_t pid, tchecker::clock_id_t x) const;
+
+  /*!
+  \brief Solve the system of inequations
+  \post _has_solution tells if the system has a solution, and _L_solution and _U_solution are the minimal paths from
+  0 to the variables if it has one
+  \throw std::overflow_error : if some bound cannot be represented as a difference bound
+  */
+  void solve() const;
+
+  /*!
+  \struct edge_t
+  \brief Inequation v_src - v_tgt <= weight
+  */
+  struct edge_t {
+    std::size_t src;            /*!< Source variable */
+    std::size_t tgt;            /*!< Target variable */
+    tchecker::integer_t weight; /*!< Weight */
+  };
+
+  tchecker::loc_id_t _loc_number;                      /*!< Number of locations */
+  tchecker::clock_id_t _clock_number;                  /*!< Number of clocks */
+  tchecker::process_id_t _process_number;              /*!< Number of processes */
+  std::vector<tchecker::process_id_t> _loc_pid;        /*!< Map: location ID -> process ID */
+  std::vector<edge_t> _edges;                          /*!< Inequations between variables (shared by L and U) */
+  std::vector<std::int64_t> _L_guards;                 /*!< Minimal weight of 0 - L_{x,l} (guards), INT64_MAX if none */
+  std::vector<std::int64_t> _U_guards;                 /*!< Minimal weight of 0 - U_{x,l} (guards), INT64_MAX if none */
+  std::vector<bool> _process_used;                     /*!< Flags auxiliary variables used by some inequation */
+  mutable bool _solved;                                /*!< Flags that solutions are up-to-date */
+  mutable bool _has_solution;                          /*!< Flags existence of a solution */
+  mutable std::vector<std::int64_t> _L_solution;       /*!< Minimal paths from 0 to L_{x,l}, INT64_MAX if none */
+  mutable std::vector<std::int64_t> _U_solution;       /*!< Minimal paths from 0 to U_{x,l}, INT64_MAX if none */
 };
 
 /*!
@@ -5,18 +5,28 @@
 /*!
  \file db.hh
  \brief Difference bounds <=c and <c for DBMs
- \note We provide two implementations: safe DBMs which are portable and check for
- integer overflow/underflow, and unsafe DBMs which are slightly faster but are not
- portable and rely on unspecified compiler implementation. Default implementation
- is the safe one (highly recommended), set TCHECKER_DBM_UNSAFE to use the
- (historical) unsafe implementation instead
+ \note We provide three implementations: safe DBMs which are portable and check for
+ integer overflow/underflow, packed DBMs which are portable, check for integer
+ overflow/underflow and encode bounds as integers, and unsafe DBMs which are slightly
+ faster but are not portable and rely on unspecified compiler implementation. Default
+ implementation is the safe one (highly recommended), set TCHECKER_DBM_PACKED (in
+ tchecker/config.hh) to use the packed implementation, or TCHECKER_DBM_UNSAFE to use
+ the (historical) unsafe implementation instead
  */
 
-#ifdef TCHECKER_DBM_UNSAFE
+#include "tchecker/config.hh"
+
+#if defined(TCHECKER_DBM_UNSAFE) && defined(TCHECKER_DBM_PACKED)
+#error "TCHECKER_DBM_UNSAFE and TCHECKER_DBM_PACKED are mutually exclusive"
+#endif
+
+#if defined(TCHECKER_DBM_UNSAFE)
 #include "tchecker/dbm/details/db_unsafe.hh"
+#elif defined(TCHECKER_DBM_PACKED)
+#include "tchecker/dbm/details/db_packed.hh"
 #else
 #include "tchecker/dbm/details/db_safe.hh"
-#endif // TCHECKER_DBM_UNSAFE
+#endif
 
 #ifndef TCHECKER_DBM_DB_HH
 #define TCHECKER_DBM_DB_HH
@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <iostream>
+#include <vector>
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/dbm/db.hh"
@@ -58,6 +59,57 @@ enum status_t {
 */
 void copy(tchecker::dbm::db_t * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim);
 
+/*!
+ \brief Copy a DBM into another DBM, permuting clocks
+ \param dbm1 : target dbm
+ \param dbm2 : source dbm
+ \param dim : dimension of dbm1 and dbm2
+ \param perm : permutation of clocks
+ \pre dbm1 and dbm2 are not nullptr (checked by assertion), and they are distinct dim*dim arrays of difference bounds
+ dim >= 1 (checked by assertion)
+ perm is a permutation of 0..dim-1 such that perm[0] = 0 (checked by assertion)
+ \post dbm1[i,j] = dbm2[perm[i],perm[j]] for all 0 <= i,j < dim
+ \note dbm1 is tight if dbm2 is tight
+*/
+void permute(tchecker::dbm::db_t * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
+             tchecker::clock_id_t const * perm);
+
+/*!
+ \brief Projection of a DBM on a subset of clocks
+ \param cdbm : target dbm
+ \param dbm : source dbm
+ \param dim : dimension of dbm
+ \param clocks : clocks kept in cdbm
+ \param cdim : number of clocks kept in cdbm
+ \pre cdbm is not nullptr (checked by assertion), cdbm is a cdim*cdim array of difference bounds
+ dbm is not nullptr (checked by assertion), dbm is a dim*dim array of difference bounds
+ 1 <= cdim <= dim (checked by assertion)
+ clocks is an increasing sequence of cdim clocks in 0..dim-1 such that clocks[0] = 0 (checked by assertion)
+ \post cdbm[i,j] = dbm[clocks[i],clocks[j]] for all 0 <= i,j < cdim
+ \note cdbm is tight if dbm is tight
+*/
+void compact(tchecker::dbm::db_t * cdbm, tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim,
+             tchecker::clock_id_t const * clocks, tchecker::clock_id_t cdim);
+
+/*!
+ \brief Extension of a projected DBM to all clocks
+ \param dbm : target dbm
+ \param dim : dimension of dbm
+ \param cdbm : source dbm
+ \param clocks : clocks kept in cdbm
+ \param cdim : number of clocks kept in cdbm
+ \pre dbm is not nullptr (checked by assertion), dbm is a dim*dim array of difference bounds
+ cdbm is not nullptr (checked by assertion), cdbm is a cdim*cdim array of difference bounds
+ 1 <= cdim <= dim (checked by assertion)
+ clocks is an increasing sequence of cdim clocks in 0..dim-1 such that clocks[0] = 0 (checked by assertion)
+ \post dbm[clocks[i],clocks[j]] = cdbm[i,j] for all 0 <= i,j < cdim, and all the clocks that are not in clocks are
+ free in dbm (see tchecker::dbm::free_clock)
+ \note if cdbm is tight and consistent, then dbm is tight and consistent. Hence, for every tight DBM dbm where the
+ clocks that are not in clocks are free, compact followed by uncompact gives back dbm
+*/
+void uncompact(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::dbm::db_t const * cdbm,
+               tchecker::clock_id_t const * clocks, tchecker::clock_id_t cdim);
+
 /*!
  \brief Universal zone
  \param dbm : a DBM
@@ -207,6 +259,24 @@ bool is_tight(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim);
  */
 enum tchecker::dbm::status_t tighten(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim);
 
+/*!
+ \brief Tighten a DBM w.r.t. paths through a clock
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param k : a clock
+ \pre dbm is not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ dim >= 1 (checked by assertion)
+ 0 <= k < dim (checked by assertion)
+ dbm is consistent
+ \post every bound dbm[i,j] has been replaced by the minimum of dbm[i,j] and dbm[i,k]+dbm[k,j].
+ if dbm is empty, then the difference bound in (0,0) is less-than <=0 (tchecker::dbm::is_empty_0() returns true)
+ \return EMPTY if a negative cycle has been found, MAY_BE_EMPTY otherwise
+ \note this is one iteration of the Floyd-Warshall algorithm. Applying it for every clock k tightens dbm, applying it
+ for a subset of clocks K tightens dbm w.r.t. paths through K
+ */
+enum tchecker::dbm::status_t tighten_pivot(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t k);
+
 /*!
  \brief Tighten a DBM w.r.t. a constraint
  \param dbm : a DBM
@@ -296,6 +366,30 @@ enum tchecker::dbm::status_t constrain(tchecker::dbm::db_t * dbm, tchecker::cloc
 enum tchecker::dbm::status_t constrain(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
                                        tchecker::clock_constraint_container_t const & constraints);
 
+/*!
+ \brief Constrain a DBM w.r.t. two clock constraints containers
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \param constraints1 : clock constraints
+ \param constraints2 : clock constraints
+ \pre dbm is not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ dbm is consistent (checked by assertion)
+ dbm is tight (checked by assertion)
+ dim >= 1 (checked by assertion)
+ all clock constraints in constraints1 and constraints2 are expressed over system clocks
+ \post dbm has been intersected with constraints1 and constraints2
+ if dbm is empty, then its difference bound in (0,0) is less-than <=0
+ (tchecker::dbm::is_empty_0() returns true)
+ the resulting DBM is tight and consistent if not empty
+ \return EMPTY is the resulting DBM is empty, NON_EMPTY otherwise
+ \note all constraints are applied before dbm is closed, and only the clocks that appear in tightened bounds are
+ used for closure. This is cheaper than constraining dbm by each container in turn
+*/
+enum tchecker::dbm::status_t constrain(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                       tchecker::clock_constraint_container_t const & constraints1,
+                                       tchecker::clock_constraint_container_t const & constraints2);
+
 /*!
  \brief Equality predicate
  \param dbm1 : a first dbm
@@ -568,6 +662,63 @@ void open_down(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim);
 enum tchecker::dbm::status_t intersection(tchecker::dbm::db_t * dbm, tchecker::dbm::db_t const * dbm1,
                                           tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim);
 
+/*!
+ \brief Convex hull
+ \param dbm : a dbm
+ \param dbm1 : a dbm
+ \param dbm2 : a dbm
+ \param dim : dimension of dbm, dbm1 and dbm2
+ \pre dbm, dbm1 and dbm2 are not nullptr (checked by assertion)
+ dbm, dbm1 and dbm2 are dim*dim arrays of difference bounds
+ dbm1 and dbm2 are consistent (checked by assertion)
+ dbm1 and dbm2 are tight (checked by assertion)
+ dim >= 1 (checked by assertion).
+ \post dbm is the smallest zone that contains dbm1 and dbm2 (the pointwise maximum of dbm1 and dbm2)
+ dbm is consistent
+ dbm is tight
+ \note dbm can be one of dbm1 or dbm2
+ */
+void convex_hull(tchecker::dbm::db_t * dbm, tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2,
+                 tchecker::clock_id_t dim);
+
+/*!
+ \brief Convexity of the union of two zones
+ \param dbm1 : a dbm
+ \param dbm2 : a dbm
+ \param dim : dimension of dbm1 and dbm2
+ \pre dbm1 and dbm2 are not nullptr (checked by assertion)
+ dbm1 and dbm2 are dim*dim arrays of difference bounds
+ dbm1 and dbm2 are consistent (checked by assertion)
+ dbm1 and dbm2 are tight (checked by assertion)
+ dim >= 1 (checked by assertion).
+ \return true if the union of the zones dbm1 and dbm2 is a zone (i.e. it is equal to their convex hull), false
+ otherwise
+ \note the test is exact: the union is convex iff the hull minus dbm1 is included in dbm2. The hull minus dbm1 is
+ the union, over the bounds of dbm1 that are stronger than the hull, of the hull intersected with the negation of the
+ bound, so the test costs O(dim^2) tightenings in the worst case
+ */
+bool is_union_convex(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim);
+
+/*!
+ \brief Difference of two zones
+ \param dbm1 : a dbm
+ \param dbm2 : a dbm
+ \param dim : dimension of dbm1 and dbm2
+ \param pieces : DBMs of the difference
+ \pre dbm1 and dbm2 are not nullptr (checked by assertion)
+ dbm1 and dbm2 are dim*dim arrays of difference bounds
+ dbm1 and dbm2 are consistent (checked by assertion)
+ dbm1 and dbm2 are tight (checked by assertion)
+ dim >= 1 (checked by assertion).
+ \post the DBMs of pairwise disjoint zones, whose union is dbm1 minus dbm2, have been appended to pieces, each one as
+ dim*dim consecutive difference bounds. The appended DBMs are consistent and tight
+ \return number of DBMs appended to pieces (0 if dbm1 is included in dbm2)
+ \note the k-th piece is dbm1 intersected with the k-1 first bounds of dbm2 that are stronger than dbm1, and with the
+ negation of the k-th one. Hence there are at most dim*(dim-1) pieces
+ */
+std::size_t subtract(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
+                     std::vector<tchecker::dbm::db_t> & pieces);
+
 /*!
  \brief ExtraM extrapolation
  \param dbm : a dbm
@@ -695,6 +846,108 @@ bool is_alu_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm
 bool is_am_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
               tchecker::integer_t const * m);
 
+/*!
+ \brief Lower-bound row for aLU inclusion checks
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \param u : clock upper bounds for clocks 1 to dim-1 (u[0] is the bound for clock 1 and so on)
+ \param row : an array of dim difference bounds
+ \pre dbm is not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ dbm is consistent (checked by assertion)
+ dbm is positive (checked by assertion)
+ dbm is tight (checked by assertion)
+ dim >= 1 (checked by assertion)
+ u is an array of size dim-1
+ u[i] < tchecker::dbm::INF_VALUE for all i>=0 (checked by assertion)
+ row is an array of size dim
+ \post row[x] = dbm[0,x] if dbm[0,x] >= (<=,-u(x)) and row[x] = (<,MIN_VALUE) otherwise, for every clock x
+ \note if dbm <= aLU(dbm2) then row[x] <= dbm2[0,x] for all x, by the aLU inclusion criterion with y = 0 (see
+ tchecker::dbm::is_alu_le). Hence tchecker::dbm::is_lower_row_le(row, dbm2, dim) is a necessary condition for
+ dbm <= aLU(dbm2) which can be checked in linear time
+ */
+void alu_lower_row(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * u,
+                   tchecker::dbm::db_t * row);
+
+/*!
+ \brief Pointwise comparison of rows
+ \param row1 : an array of difference bounds
+ \param row2 : an array of difference bounds
+ \param dim : size of row1 and row2
+ \pre row1 and row2 are not nullptr (checked by assertion)
+ \return true if row1[x] <= row2[x] for all 0 <= x < dim, false otherwise
+ \note see tchecker::dbm::alu_lower_row
+ */
+bool is_lower_row_le(tchecker::dbm::db_t const * row1, tchecker::dbm::db_t const * row2, tchecker::clock_id_t dim);
+
+/*!
+ \struct reduced_bound_t
+ \brief Difference bound in a minimal constraint set: x_i - x_j # c
+ */
+struct reduced_bound_t {
+  tchecker::clock_id_t i; /*!< First clock */
+  tchecker::clock_id_t j; /*!< Second clock */
+  tchecker::dbm::db_t db; /*!< Difference bound #c */
+};
+
+/*!
+ \brief Equality predicate
+ \param b1 : a reduced bound
+ \param b2 : a reduced bound
+ \return true if b1 and b2 are equal, false otherwise
+ */
+inline bool operator==(tchecker::dbm::reduced_bound_t const & b1, tchecker::dbm::reduced_bound_t const & b2)
+{
+  return (b1.i == b2.i) && (b1.j == b2.j) && (b1.db == b2.db);
+}
+
+/*!
+ \brief Disequality predicate
+ \param b1 : a reduced bound
+ \param b2 : a reduced bound
+ \return true if b1 and b2 are not equal, false otherwise
+ */
+inline bool operator!=(tchecker::dbm::reduced_bound_t const & b1, tchecker::dbm::reduced_bound_t const & b2)
+{
+  return !(b1 == b2);
+}
+
+/*!
+ \brief Minimal constraint set of a DBM
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param bounds : container of bounds
+ \pre dbm is not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ dbm is tight or empty (checked by assertion)
+ dim >= 1 (checked by assertion)
+ \post bounds contains a minimal set of bounds with the same tight closure as dbm: bounds that are implied by
+ other bounds have been removed. bounds contains the single bound (0,0,<0) if dbm is empty
+ \note the set of bounds is canonical: two tight DBMs are equal if and only if their minimal constraint sets are
+ equal. It is computed as in "Efficient timed reachability analysis using clock difference diagrams", Larsen,
+ Pearson, Weise and Yi, CAV 1999: clocks are grouped in zero-cycle classes, each class is represented by a
+ cycle through its clocks, and bounds between the smallest clocks in classes are kept if they are not implied
+ by a path through another class
+ \note complexity is O(dim^3)
+ */
+void reduce(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim, std::vector<tchecker::dbm::reduced_bound_t> & bounds);
+
+/*!
+ \brief DBM from a minimal constraint set
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param bounds : array of bounds
+ \param count : size of bounds
+ \pre dbm is not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ dim >= 1 (checked by assertion)
+ bounds has been computed by tchecker::dbm::reduce on a DBM of dimension dim
+ \post dbm is the tight DBM defined by bounds, or it is empty (tchecker::dbm::is_empty_0() returns true)
+ \note complexity is O(dim^3)
+ */
+void expand(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::dbm::reduced_bound_t const * bounds,
+            std::size_t count);
+
 /*!
  \brief Hash function
  \param dbm : a dbm
@@ -0,0 +1,191 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_DBM_DB_PACKED_HH
+#define TCHECKER_DBM_DB_PACKED_HH
+
+#include <stdexcept>
+
+#include "tchecker/basictypes.hh"
+
+/*!
+ \file db_packed.hh
+ \brief Difference bounds <=c and <c for DBMs
+ \note This implementation packs difference bounds in integers like db_unsafe.hh, hence comparison and minimum
+ are plain integer operations. Unlike db_unsafe.hh, it is portable (no shift of negative integers) and it checks
+ for overflow/underflow like db_safe.hh
+ */
+
+namespace tchecker {
+
+namespace dbm {
+
+/* IMPLEMENTATION NOTES:
+ Difference bound #c is encoded as the integer 2*c + # where # is 1 for LE (<=) and 0 for LT (<). Bounds are
+ then ordered as integers: (<c) < (<=c) < (<c+1).
+ */
+
+/*!
+ \brief Type of difference bounds
+ */
+using db_t = tchecker::integer_t;
+
+static_assert(std::is_same<tchecker::integer_t, tchecker::dbm::db_t>::value, "");
+
+static_assert(tchecker::LT == 0, "tchecker::LT must be 0");
+static_assert(tchecker::LE == 1, "tchecker::LE must be 1");
+
+tchecker::dbm::db_t const INF_VALUE = tchecker::int_maxval / 2; /*!< Infinity value */
+tchecker::dbm::db_t const MAX_VALUE = INF_VALUE - 1;            /*!< Maximum value */
+tchecker::dbm::db_t const MIN_VALUE = tchecker::int_minval / 2; /*!< Minimum value */
+
+static_assert(tchecker::dbm::INF_VALUE != tchecker::dbm::MAX_VALUE, "");
+static_assert(tchecker::dbm::INF_VALUE != tchecker::dbm::MIN_VALUE, "");
+static_assert(tchecker::dbm::MAX_VALUE != tchecker::dbm::MIN_VALUE, "");
+
+tchecker::dbm::db_t const LE_ZERO = 2 * 0 + tchecker::LE;              /*!< <=0 */
+tchecker::dbm::db_t const LT_ZERO = 2 * 0 + tchecker::LT;              /*!< <0 */
+tchecker::dbm::db_t const LT_INFINITY = 2 * INF_VALUE + tchecker::LT;  /*!< <inf */
+tchecker::dbm::db_t const LE_MAX_VALUE = 2 * MAX_VALUE + tchecker::LE; /*!< <=MAX_VALUE (largest finite bound) */
+tchecker::dbm::db_t const LT_MIN_VALUE = 2 * MIN_VALUE + tchecker::LT; /*!< <MIN_VALUE (smallest bound) */
+
+static_assert(tchecker::dbm::LE_ZERO != tchecker::dbm::LT_ZERO, "");
+static_assert(tchecker::dbm::LT_ZERO != tchecker::dbm::LT_INFINITY, "");
+static_assert(tchecker::dbm::LE_ZERO != tchecker::dbm::LT_INFINITY, "");
+static_assert(tchecker::dbm::LE_MAX_VALUE < tchecker::dbm::LT_INFINITY, "");
+
+/*!
+ \brief Build a difference bound
+ \param cmp : a comparator
+ \param value : a value
+ \pre tchecker::dbm::MIN_VALUE <= value <= tchecker::dbm::MAX_VALUE
+ \return <value if cmp is LT and <=value if cmp is LE
+ \throw std::invalid_argument : if value is not between tchecker::dbm::MIN_VALUE and tchecker::dbm::MAX_VALUE
+ */
+inline tchecker::dbm::db_t db(enum tchecker::ineq_cmp_t cmp, tchecker::integer_t value)
+{
+  if ((value < tchecker::dbm::MIN_VALUE) || (value > tchecker::dbm::MAX_VALUE))
+    throw std::invalid_argument("value out of bounds");
+  return 2 * value + cmp;
+}
+
+namespace details {
+
+/*!
+ \brief Sum of integers with overflow check
+ \param a : an integer
+ \param b : an integer
+ \param r : result
+ \post r is a + b if the sum does not overflow/underflow, r is unspecified otherwise
+ \return true if a + b overflows/underflows, false otherwise
+ */
+inline bool add_overflow(tchecker::integer_t a, tchecker::integer_t b, tchecker::integer_t & r)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_add_overflow(a, b, &r);
+#else
+  if (((b > 0) && (a > tchecker::int_maxval - b)) || ((b < 0) && (a < tchecker::int_minval - b)))
+    return true;
+  r = a + b;
+  return false;
+#endif
+}
+
+} // end of namespace details
+
+/*!
+ \brief Sum of difference bounds
+ \param db1 : a difference bound
+ \param db2 : a difference bound
+ \pre db1 + db2 can be represented
+ \return db1 + db2, i.e. the difference bound #c where c is the sum of values in db1 and db2, and # is LT is at least one of
+ db1 and db2 is LT, and # is LE otherwise
+ \throw std::invalid_argument : if the sum cannot be represented as a tchecker::dbm::db_t
+ \note (2*c1 + #1) + (2*c2 + #2) - (#1 | #2) = 2*(c1 + c2) + (#1 & #2)
+ */
+inline tchecker::dbm::db_t sum(tchecker::dbm::db_t db1, tchecker::dbm::db_t db2)
+{
+  if ((db1 == tchecker::dbm::LT_INFINITY) || (db2 == tchecker::dbm::LT_INFINITY))
+    return tchecker::dbm::LT_INFINITY;
+  // the sum of values always fits in tchecker::integer_t, hence an overflow of the encoded sum means that the sum
+  // of values is out of bounds
+  tchecker::dbm::db_t sum;
+  if (tchecker::dbm::details::add_overflow(db1, db2, sum) ||
+      tchecker::dbm::details::add_overflow(sum, -((db1 | db2) & 1), sum) || (sum < tchecker::dbm::LT_MIN_VALUE) ||
+      (sum > tchecker::dbm::LE_MAX_VALUE))
+    throw std::invalid_argument("value out of bounds");
+  return sum;
+}
+
+/*!
+ \brief Add an integer to a difference bound
+ \param db : a difference bound
+ \param value : a value
+ \pre `db + value` can be represented
+ \return #c where # is the comparator in db, and c is value plus the value in db
+ \throw std::invalid_argument : see tchecker::dbm::sum
+ */
+inline tchecker::dbm::db_t add(tchecker::dbm::db_t db, tchecker::integer_t value)
+{
+  return tchecker::dbm::sum(db, tchecker::dbm::db(tchecker::LE, value));
+}
+
+/*!
+ \note Standard comparison operators <, <=, ==, !=, >= and > on integers carry on difference bounds
+ */
+
+/*!
+ \brief Minimum of difference bounds
+ \param db1 : a difference bound
+ \param db2 : a difference bound
+ \return db1 if db1 < db2, db2 otherwise
+ */
+inline tchecker::dbm::db_t min(tchecker::dbm::db_t db1, tchecker::dbm::db_t db2) { return (db1 < db2 ? db1 : db2); }
+
+/*!
+ \brief Maximum of difference bounds
+ \param db1 : a difference bound
+ \param db2 : a difference bound
+ \return db1 if db1 > db2, db2 otherwise
+ */
+inline tchecker::dbm::db_t max(tchecker::dbm::db_t db1, tchecker::dbm::db_t db2) { return (db1 > db2 ? db1 : db2); }
+
+/*!
+ \brief Comparison of difference bounds
+ \param db1 : a difference bound
+ \param db2 : a difference bound
+ \return 0 if db1 and db2 are equal, a negative value if db1 is smaller than db2, a positive value otherwise
+ */
+inline int db_cmp(tchecker::dbm::db_t db1, tchecker::dbm::db_t db2) { return (db1 < db2 ? -1 : (db1 == db2 ? 0 : 1)); }
+
+/*!
+ \brief Accessor
+ \param db : a difference bound
+ \return the comparator in db
+ */
+inline enum tchecker::ineq_cmp_t comparator(tchecker::dbm::db_t db)
+{
+  return ((db & tchecker::LE) ? tchecker::LE : tchecker::LT);
+}
+
+/*!
+ \brief Accessor
+ \param db : a difference bound
+ \return value of db
+ \note exact division, no right shift on negative integers
+ */
+inline tchecker::integer_t value(tchecker::dbm::db_t db) { return (db - (db & 1)) / 2; }
+
+/*!
+ \brief Accessor
+ \param db : a difference bound
+ \return hash value for db
+ */
+inline std::size_t hash(tchecker::dbm::db_t db) { return static_cast<std::size_t>(db); }
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_DBM_DB_PACKED_HH
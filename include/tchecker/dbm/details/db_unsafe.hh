@@ -46,7 +46,7 @@ static_assert(tchecker::dbm::MAX_VALUE != tchecker::dbm::MIN_VALUE, "");
 
 tchecker::dbm::db_t const LE_ZERO = (0 << 1) | tchecker::LE;                  /*!< <=0 */
 tchecker::dbm::db_t const LT_ZERO = (0 << 1) | tchecker::LT;                  /*!< <0 */
-tchecker::dbm::db_t const LT_INFINITY = (INF_VALUE << 1) | tchecker::dbm::LT; /*!< <inf */
+tchecker::dbm::db_t const LT_INFINITY = (INF_VALUE << 1) | tchecker::LT;       /*!< <inf */
 
 static_assert(tchecker::dbm::LE_ZERO != tchecker::dbm::LT_ZERO, "");
 static_assert(tchecker::dbm::LT_ZERO != tchecker::dbm::LT_INFINITY, "");
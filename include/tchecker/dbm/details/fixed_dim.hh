@@ -0,0 +1,197 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_DBM_DETAILS_FIXED_DIM_HH
+#define TCHECKER_DBM_DETAILS_FIXED_DIM_HH
+
+#include <type_traits>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+#include "tchecker/dbm/dbm.hh"
+
+/*!
+ \file fixed_dim.hh
+ \brief DBM routines specialized for small dimensions known at compile time
+ \note loops have constant trip counts, hence they are fully unrolled by the compiler. Routines in
+ tchecker/dbm/dbm.hh dispatch to these specializations when dim <= tchecker::dbm::details::FIXED_DIM_MAX
+ */
+
+namespace tchecker {
+
+namespace dbm {
+
+namespace details {
+
+/*!
+ \brief Maximal dimension with specialized routines
+ */
+constexpr tchecker::clock_id_t const FIXED_DIM_MAX = 8;
+
+/*!
+ \brief Dispatch on dimension
+ \param dim : dimension
+ \param fixed : callable on std::integral_constant<tchecker::clock_id_t, N>
+ \param generic : callable with no argument
+ \return fixed(std::integral_constant<tchecker::clock_id_t, dim>{}) if 1 <= dim <= FIXED_DIM_MAX, generic()
+ otherwise
+ */
+template <class FIXED, class GENERIC> inline decltype(auto) dispatch(tchecker::clock_id_t dim, FIXED && fixed, GENERIC && generic)
+{
+  static_assert(tchecker::dbm::details::FIXED_DIM_MAX == 8, "dispatch should cover all fixed dimensions");
+  switch (dim) {
+  case 1:
+    return fixed(std::integral_constant<tchecker::clock_id_t, 1>{});
+  case 2:
+    return fixed(std::integral_constant<tchecker::clock_id_t, 2>{});
+  case 3:
+    return fixed(std::integral_constant<tchecker::clock_id_t, 3>{});
+  case 4:
+    return fixed(std::integral_constant<tchecker::clock_id_t, 4>{});
+  case 5:
+    return fixed(std::integral_constant<tchecker::clock_id_t, 5>{});
+  case 6:
+    return fixed(std::integral_constant<tchecker::clock_id_t, 6>{});
+  case 7:
+    return fixed(std::integral_constant<tchecker::clock_id_t, 7>{});
+  case 8:
+    return fixed(std::integral_constant<tchecker::clock_id_t, 8>{});
+  default:
+    return generic();
+  }
+}
+
+/*!
+ \brief Tighten a DBM w.r.t. paths through a clock
+ \tparam N : dimension
+ \param dbm : a DBM of dimension N
+ \param k : a clock
+ \pre 0 <= k < N
+ \post every bound dbm[i][j] has been replaced by the minimum of dbm[i][j] and dbm[i][k]+dbm[k][j], and the
+ difference bound in (0,0) has been set to <0 if a negative cycle has been found
+ \return false if dbm has been found empty, true otherwise
+ */
+template <tchecker::clock_id_t N> inline bool tighten_pivot(tchecker::dbm::db_t * dbm, tchecker::clock_id_t k)
+{
+  tchecker::dbm::db_t const * row_k = dbm + k * N;
+  for (tchecker::clock_id_t i = 0; i < N; ++i) {
+    tchecker::dbm::db_t * row_i = dbm + i * N;
+    tchecker::dbm::db_t const db_ik = row_i[k];
+    if ((i == k) || (db_ik == tchecker::dbm::LT_INFINITY))
+      continue;
+    for (tchecker::clock_id_t j = 0; j < N; ++j)
+      row_i[j] = tchecker::dbm::min(tchecker::dbm::sum(db_ik, row_k[j]), row_i[j]);
+    if (row_i[i] < tchecker::dbm::LE_ZERO) {
+      dbm[0] = tchecker::dbm::LT_ZERO;
+      return false;
+    }
+  }
+  return true;
+}
+
+/*!
+ \brief Tighten a DBM
+ \tparam N : dimension
+ \param dbm : a DBM of dimension N
+ \post see tchecker::dbm::tighten
+ \return EMPTY if dbm is empty, NON_EMPTY otherwise
+ */
+template <tchecker::clock_id_t N> inline enum tchecker::dbm::status_t tighten(tchecker::dbm::db_t * dbm)
+{
+  for (tchecker::clock_id_t k = 0; k < N; ++k)
+    if (!tchecker::dbm::details::tighten_pivot<N>(dbm, k))
+      return tchecker::dbm::EMPTY;
+  return tchecker::dbm::NON_EMPTY;
+}
+
+/*!
+ \brief Tighten a DBM of dimension 1 (no clock)
+ \param dbm : a DBM of dimension 1
+ \post see tchecker::dbm::tighten
+ \return NON_EMPTY since dbm is consistent
+ */
+template <> inline enum tchecker::dbm::status_t tighten<1>(tchecker::dbm::db_t *) { return tchecker::dbm::NON_EMPTY; }
+
+/*!
+ \brief Tighten a DBM of dimension 2 (one clock)
+ \param dbm : a DBM of dimension 2
+ \post see tchecker::dbm::tighten
+ \return EMPTY if dbm is empty, NON_EMPTY otherwise
+ \note the only path that is not an edge is the cycle through the clock and the reference clock, hence a consistent
+ DBM of dimension 2 is tight if that cycle is not negative
+ */
+template <> inline enum tchecker::dbm::status_t tighten<2>(tchecker::dbm::db_t * dbm)
+{
+  if (tchecker::dbm::sum(dbm[1], dbm[2]) < tchecker::dbm::LE_ZERO) {
+    dbm[0] = tchecker::dbm::LT_ZERO;
+    return tchecker::dbm::EMPTY;
+  }
+  return tchecker::dbm::NON_EMPTY;
+}
+
+/*!
+ \brief Tighten a DBM of dimension 3 (two clocks)
+ \param dbm : a DBM of dimension 3
+ \post see tchecker::dbm::tighten
+ \return EMPTY if dbm is empty, NON_EMPTY otherwise
+ \note in a graph with 3 vertices and no negative cycle, the shortest path from i to j is either the edge (i,j) or
+ the path through the third vertex. Hence, once the 3 cycles of length 2 and the 2 cycles of length 3 have been checked,
+ every bound is tightened from the original bounds, without the sequence of pivots of Floyd-Warshall algorithm
+ */
+template <> inline enum tchecker::dbm::status_t tighten<3>(tchecker::dbm::db_t * dbm)
+{
+  using tchecker::dbm::sum;
+  tchecker::dbm::db_t const d01 = dbm[1], d02 = dbm[2], d10 = dbm[3], d12 = dbm[5], d20 = dbm[6], d21 = dbm[7];
+  if ((sum(d01, d10) < tchecker::dbm::LE_ZERO) || (sum(d02, d20) < tchecker::dbm::LE_ZERO) ||
+      (sum(d12, d21) < tchecker::dbm::LE_ZERO) || (sum(sum(d01, d12), d20) < tchecker::dbm::LE_ZERO) ||
+      (sum(sum(d02, d21), d10) < tchecker::dbm::LE_ZERO)) {
+    dbm[0] = tchecker::dbm::LT_ZERO;
+    return tchecker::dbm::EMPTY;
+  }
+  dbm[1] = tchecker::dbm::min(d01, sum(d02, d21));
+  dbm[2] = tchecker::dbm::min(d02, sum(d01, d12));
+  dbm[3] = tchecker::dbm::min(d10, sum(d12, d20));
+  dbm[5] = tchecker::dbm::min(d12, sum(d10, d02));
+  dbm[6] = tchecker::dbm::min(d20, sum(d21, d10));
+  dbm[7] = tchecker::dbm::min(d21, sum(d20, d01));
+  return tchecker::dbm::NON_EMPTY;
+}
+
+/*!
+ \brief Inclusion check
+ \tparam N : dimension
+ \param dbm1 : a DBM of dimension N
+ \param dbm2 : a DBM of dimension N
+ \return true if every bound in dbm1 is less than or equal to the corresponding bound in dbm2, false otherwise
+ */
+template <tchecker::clock_id_t N> inline bool is_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2)
+{
+  bool le = true;
+  for (tchecker::clock_id_t k = 0; k < N * N; ++k)
+    le &= (dbm1[k] <= dbm2[k]);
+  return le;
+}
+
+/*!
+ \brief Equality check
+ \tparam N : dimension
+ \param dbm1 : a DBM of dimension N
+ \param dbm2 : a DBM of dimension N
+ \return true if dbm1 and dbm2 have the same bounds, false otherwise
+ */
+template <tchecker::clock_id_t N> inline bool is_equal(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2)
+{
+  bool eq = true;
+  for (tchecker::clock_id_t k = 0; k < N * N; ++k)
+    eq &= (dbm1[k] == dbm2[k]);
+  return eq;
+}
+
+} // end of namespace details
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_DBM_DETAILS_FIXED_DIM_HH
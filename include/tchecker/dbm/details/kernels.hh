@@ -0,0 +1,82 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_DBM_DETAILS_KERNELS_HH
+#define TCHECKER_DBM_DETAILS_KERNELS_HH
+
+#include <cstddef>
+
+#include "tchecker/basictypes.hh"
+
+/*!
+ \file kernels.hh
+ \brief Vectorized kernels on rows of integer-encoded difference bounds
+ \note These kernels work on difference bounds encoded as integers (value << 1) | cmp with
+ LT=0 and LE=1, the encoding used by packed and unsafe DBMs. Bounds are then ordered as integers, and
+ the sum of two bounds b1, b2 is b1 + b2 - ((b1 | b2) & 1) unless one of them is infinity.
+ The best available instruction set (AVX-512, AVX2 or plain C++) is selected at runtime,
+ on first call
+ */
+
+namespace tchecker {
+
+namespace dbm {
+
+namespace kernels {
+
+/*!
+ \brief Instruction sets used by the kernels
+ */
+enum isa_t {
+  ISA_GENERIC, /*!< Portable C++ loops */
+  ISA_AVX2,    /*!< x86 AVX2 */
+  ISA_AVX512,  /*!< x86 AVX-512F */
+};
+
+/*!
+ \brief Accessor
+ \return the instruction set used by the kernels on this machine
+ */
+enum tchecker::dbm::kernels::isa_t isa();
+
+/*!
+ \brief Pointwise comparison
+ \param a : an array of bounds
+ \param b : an array of bounds
+ \param n : size of a and b
+ \return true if a[k] <= b[k] for all k in [0,n), false otherwise
+ */
+bool is_le(tchecker::integer_t const * a, tchecker::integer_t const * b, std::size_t n);
+
+/*!
+ \brief Pointwise minimum
+ \param r : an array of bounds
+ \param a : an array of bounds
+ \param b : an array of bounds
+ \param n : size of r, a and b
+ \pre r may be equal to a or b, but must not partially overlap them
+ \post r[k] = min(a[k], b[k]) for all k in [0,n)
+ */
+void min(tchecker::integer_t * r, tchecker::integer_t const * a, tchecker::integer_t const * b, std::size_t n);
+
+/*!
+ \brief Row update of the Floyd-Warshall algorithm
+ \param row_i : an array of bounds (row i of a DBM)
+ \param row_k : an array of bounds (row k of a DBM)
+ \param db_ik : a bound (entry (i,k) of a DBM)
+ \param n : size of row_i and row_k
+ \param inf : the encoding of infinity
+ \pre db_ik != inf, row_i and row_k are either equal or do not overlap
+ \post row_i[j] = min(row_i[j], db_ik + row_k[j]) for all j in [0,n), where + is the sum of bounds
+ */
+void tighten_row(tchecker::integer_t * row_i, tchecker::integer_t const * row_k, tchecker::integer_t db_ik, std::size_t n,
+                 tchecker::integer_t inf);
+
+} // end of namespace kernels
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_DBM_DETAILS_KERNELS_HH
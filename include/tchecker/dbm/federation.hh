@@ -0,0 +1,117 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_DBM_FEDERATION_HH
+#define TCHECKER_DBM_FEDERATION_HH
+
+#include <cstddef>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+
+/*!
+ \file federation.hh
+ \brief Federations: unions of zones represented as sets of DBMs
+ */
+
+namespace tchecker {
+
+namespace dbm {
+
+/*!
+ \class federation_t
+ \brief Union of zones represented as a set of DBMs of the same dimension
+ \note The set is kept reduced: no DBM is included in another one, and no two DBMs have a convex union (they are
+ merged into their convex hull). Inclusion in the union is exact, it does not only check inclusion in one of the DBMs
+*/
+class federation_t {
+public:
+  /*!
+   \brief Constructor
+   \param dim : dimension of DBMs
+   \pre dim >= 1
+   \post this federation is empty
+   */
+  federation_t(tchecker::clock_id_t dim);
+
+  /*!
+   \brief Accessor
+   \return dimension of DBMs
+   */
+  inline tchecker::clock_id_t dim() const { return _dim; }
+
+  /*!
+   \brief Accessor
+   \return number of DBMs in the federation
+   */
+  inline std::size_t size() const { return _dbms.size() / (static_cast<std::size_t>(_dim) * _dim); }
+
+  /*!
+   \brief Accessor
+   \return true if the federation is empty, false otherwise
+   */
+  inline bool empty() const { return _dbms.empty(); }
+
+  /*!
+   \brief Accessor
+   \param k : index of DBM
+   \pre k < size()
+   \return k-th DBM in the federation
+   */
+  inline tchecker::dbm::db_t const * dbm(std::size_t k) const { return _dbms.data() + k * _dim * _dim; }
+
+  /*!
+   \brief Inclusion
+   \param dbm : a DBM
+   \pre dbm is a dim()*dim() DBM, consistent and tight
+   \return true if the zone dbm is included in the union of the zones in this federation, false otherwise
+   */
+  bool contains(tchecker::dbm::db_t const * dbm) const;
+
+  /*!
+   \brief Difference
+   \param dbm : a DBM
+   \param pieces : DBMs of the difference
+   \pre dbm is a dim()*dim() DBM, consistent and tight
+   \post the DBMs of pairwise disjoint zones, whose union is dbm minus the union of the zones in this federation,
+   have been appended to pieces, each one as dim()*dim() consecutive difference bounds
+   \return number of DBMs appended to pieces (0 if dbm is included in this federation)
+   */
+  std::size_t subtract(tchecker::dbm::db_t const * dbm, std::vector<tchecker::dbm::db_t> & pieces) const;
+
+  /*!
+   \brief Union
+   \param dbm : a DBM
+   \pre dbm is a dim()*dim() DBM, consistent and tight
+   \post the zone dbm has been added to this federation, unless it is included in one of its DBMs. The DBMs included
+   in dbm have been removed, and the DBMs whose union with dbm is convex have been merged with dbm
+   \return true if this federation has been modified, false otherwise
+   */
+  bool add(tchecker::dbm::db_t const * dbm);
+
+  /*!
+   \brief Accessor
+   \return memory used by this federation, in bytes
+   */
+  inline std::size_t memsize() const { return sizeof(*this) + _dbms.capacity() * sizeof(tchecker::dbm::db_t); }
+
+private:
+  /*!
+   \brief Remove a DBM
+   \param k : index of DBM
+   \pre k < size()
+   \post the k-th DBM has been replaced by the last one, and the last one has been removed
+   */
+  void remove(std::size_t k);
+
+  tchecker::clock_id_t _dim;              /*!< Dimension of DBMs */
+  std::vector<tchecker::dbm::db_t> _dbms; /*!< DBMs, as consecutive dim*dim difference bounds */
+};
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_DBM_FEDERATION_HH
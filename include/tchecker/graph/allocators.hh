@@ -108,6 +108,12 @@ public:
    */
   std::size_t memsize() const { return _node_pool.memsize(); }
 
+  /*!
+   \brief Accessor
+   \return Pool of nodes (for diagnostics)
+   */
+  tchecker::pool_t<NODE> const & pool() const { return _node_pool; }
+
 protected:
   tchecker::pool_t<NODE> _node_pool; /*!< Pool of nodes */
 };
@@ -200,6 +206,12 @@ public:
    */
   std::size_t memsize() const { return _edge_pool.memsize(); }
 
+  /*!
+   \brief Accessor
+   \return Pool of edges (for diagnostics)
+   */
+  tchecker::pool_t<EDGE> const & pool() const { return _edge_pool; }
+
 protected:
   tchecker::pool_t<EDGE> _edge_pool; /*!< Pool of edges */
 };
@@ -0,0 +1,306 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_GRAPH_BINARY_HH
+#define TCHECKER_GRAPH_BINARY_HH
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "tchecker/utils/mapped_file.hh"
+
+/*!
+ \file binary.hh
+ \brief Binary format of graphs
+ \note a binary graph file starts with a header of 64 bytes: BINARY_GRAPH_MAGIC, the version of the format, a
+ byte-order mark, 4 reserved bytes, and the numbers of strings S, bytes of strings B, nodes N, node attributes NA,
+ edges E and edge attributes EA as 64-bit integers. It is followed by the tables:
+ - string offsets: S+1 64-bit integers, string i is made of the bytes [offset i, offset i+1) of the strings
+ - node attribute offsets: N+1 64-bit integers, the attributes of node i are [offset i, offset i+1)
+ - edge offsets: N+1 64-bit integers, the outgoing edges of node i are [offset i, offset i+1) (CSR)
+ - edge targets: E 64-bit integers
+ - edge attribute offsets: E+1 64-bit integers, the attributes of edge i are [offset i, offset i+1)
+ - node attributes: NA pairs of 32-bit string indices (key, value)
+ - edge attributes: EA pairs of 32-bit string indices (key, value)
+ - strings: B bytes
+ String 0 is the name of the graph. Identical strings are stored once (e.g. tuples of locations shared by many
+ nodes). Each table is aligned on the size of its elements, hence the file can be mapped in memory and read in
+ place
+ */
+
+namespace tchecker {
+
+namespace graph {
+
+/*!
+ \brief Magic number of binary graph files
+ */
+constexpr char const BINARY_GRAPH_MAGIC[4] = {'T', 'C', 'K', 'G'};
+
+/*!
+ \brief Version of the binary graph format
+ */
+constexpr std::uint32_t const BINARY_GRAPH_VERSION = 1;
+
+/*!
+ \class binary_graph_writer_t
+ \brief Builder of graphs in binary format
+ */
+class binary_graph_writer_t {
+public:
+  /*!
+   \brief Constructor
+   \param name : graph name
+   */
+  binary_graph_writer_t(std::string const & name);
+
+  /*!
+   \brief Add a node
+   \param attr : node attributes
+   \post a node with attributes attr has been added
+   \return identifier of the node (nodes are numbered from 0 in their order of addition)
+   */
+  std::uint64_t add_node(std::map<std::string, std::string> const & attr);
+
+  /*!
+   \brief Add an edge
+   \param src : source node
+   \param tgt : target node
+   \param attr : edge attributes
+   \pre src and tgt have been added, and src is not smaller than the source of the last added edge
+   \post an edge from src to tgt with attributes attr has been added
+   \throw std::invalid_argument : if the precondition is not satisfied
+   */
+  void add_edge(std::uint64_t src, std::uint64_t tgt, std::map<std::string, std::string> const & attr);
+
+  /*!
+   \brief Write the graph
+   \param os : output stream (binary mode)
+   \post the graph has been written to os in binary format
+   \throw std::runtime_error : if writing to os fails
+   */
+  void write(std::ostream & os) const;
+
+private:
+  /*!
+   \brief Index of a string
+   \param s : a string
+   \post s has been added to the strings if it was not in the strings
+   \return index of s in the strings
+   \throw std::overflow_error : if there are too many strings
+   */
+  std::uint32_t string_index(std::string const & s);
+
+  /*!
+   \brief Add attributes
+   \param attr : attributes
+   \param pairs : table of attributes
+   \post the indices of keys and values in attr have been appended to pairs
+   */
+  void add_attributes(std::map<std::string, std::string> const & attr, std::vector<std::uint32_t> & pairs);
+
+  std::unordered_map<std::string, std::uint32_t> _strings_index; /*!< Map : string -> index */
+  std::vector<std::string const *> _strings;                      /*!< Map : index -> string (keys of _strings_index) */
+  std::vector<std::uint64_t> _node_attributes_offsets;            /*!< Offsets of attributes of nodes */
+  std::vector<std::uint32_t> _node_attributes;                    /*!< Attributes of nodes */
+  std::vector<std::uint64_t> _edge_offsets;                       /*!< Offsets of outgoing edges of nodes */
+  std::vector<std::uint64_t> _edge_targets;                       /*!< Targets of edges */
+  std::vector<std::uint64_t> _edge_attributes_offsets;            /*!< Offsets of attributes of edges */
+  std::vector<std::uint32_t> _edge_attributes;                    /*!< Attributes of edges */
+};
+
+/*!
+ \brief Output a graph in binary format
+ \tparam GRAPH : type of graph, should provide types GRAPH::node_sptr_t,
+ GRAPH::edge_sptr_t, and method GRAPH::nodes() that returns the range of nodes,
+ and a method GRAPH::outgoing_edges(n) that returns the range of outgoing edges
+ of node n
+ \param os : output stream (binary mode)
+ \param g : a graph
+ \param name : graph name
+ \post the graph g has been output to os in binary format. Nodes are numbered in the order of g.nodes(), and the
+ outgoing edges of each node are in the order of g.outgoing_edges(n)
+ \return os after output
+ \throw std::runtime_error : if the source or the target of an edge is not a node of g, or if writing to os fails
+ */
+template <class GRAPH> std::ostream & binary_output(std::ostream & os, GRAPH const & g, std::string const & name)
+{
+  std::unordered_map<void const *, std::uint64_t> nodes_id;
+  std::map<std::string, std::string> attr;
+  tchecker::graph::binary_graph_writer_t writer{name};
+
+  for (typename GRAPH::node_sptr_t const & n : g.nodes()) {
+    attr.clear();
+    g.attributes(n, attr);
+    nodes_id.emplace(static_cast<void const *>(&*n), writer.add_node(attr));
+  }
+
+  auto node_id = [&](typename GRAPH::node_sptr_t const & n) {
+    auto it = nodes_id.find(static_cast<void const *>(&*n));
+    if (it == nodes_id.end())
+      throw std::runtime_error("tchecker::graph::binary_output: node not found");
+    return it->second;
+  };
+
+  for (typename GRAPH::node_sptr_t const & n : g.nodes()) {
+    std::uint64_t const src = node_id(n);
+    for (typename GRAPH::edge_sptr_t const & e : g.outgoing_edges(n)) {
+      attr.clear();
+      g.attributes(e, attr);
+      writer.add_edge(src, node_id(g.edge_tgt(e)), attr);
+    }
+  }
+
+  writer.write(os);
+  return os;
+}
+
+/*!
+ \class binary_graph_t
+ \brief Graph in binary format, read in place from a file mapped in memory
+ */
+class binary_graph_t {
+public:
+  /*!
+   \brief Constructor
+   \param filename : file name
+   \post filename has been mapped in memory and checked
+   \throw std::runtime_error : if filename cannot be mapped in memory, if it has another version of the format or
+   another byte order, or if its content is not a valid graph
+   */
+  binary_graph_t(std::string const & filename);
+
+  /*!
+   \brief Accessor
+   \return name of the graph
+   */
+  std::string_view name() const;
+
+  /*!
+   \brief Accessor
+   \return number of nodes
+   */
+  inline std::uint64_t nodes_count() const { return _nodes_count; }
+
+  /*!
+   \brief Accessor
+   \return number of edges
+   */
+  inline std::uint64_t edges_count() const { return _edges_count; }
+
+  /*!
+   \brief Accessor
+   \param n : node identifier
+   \param m : map of attributes
+   \pre n < nodes_count() (checked by assertion)
+   \post the attributes of node n have been added to m
+   */
+  void attributes(std::uint64_t n, std::map<std::string, std::string> & m) const;
+
+  /*!
+   \brief Accessor
+   \param n : node identifier
+   \pre n < nodes_count() (checked by assertion)
+   \return identifier of the first outgoing edge of n (the outgoing edges of n are numbered from
+   outgoing_edges_begin(n) to outgoing_edges_end(n))
+   */
+  std::uint64_t outgoing_edges_begin(std::uint64_t n) const;
+
+  /*!
+   \brief Accessor
+   \param n : node identifier
+   \pre n < nodes_count() (checked by assertion)
+   \return past-the-end identifier of the outgoing edges of n
+   */
+  std::uint64_t outgoing_edges_end(std::uint64_t n) const;
+
+  /*!
+   \brief Accessor
+   \param e : edge identifier
+   \pre e < edges_count() (checked by assertion)
+   \return target node of edge e
+   */
+  std::uint64_t edge_tgt(std::uint64_t e) const;
+
+  /*!
+   \brief Accessor
+   \param e : edge identifier
+   \param m : map of attributes
+   \pre e < edges_count() (checked by assertion)
+   \post the attributes of edge e have been added to m
+   */
+  void edge_attributes(std::uint64_t e, std::map<std::string, std::string> & m) const;
+
+private:
+  /*!
+   \brief Accessor
+   \param i : string index
+   \pre i is a valid string index
+   \return string i
+   */
+  std::string_view string(std::uint32_t i) const;
+
+  /*!
+   \brief Accessor
+   \param table : table of 64-bit integers
+   \param i : index
+   \return entry i of table
+   */
+  static std::uint64_t u64(char const * table, std::uint64_t i);
+
+  /*!
+   \brief Add attributes to a map
+   \param pairs : table of attributes
+   \param begin : first attribute
+   \param end : past-the-end attribute
+   \param m : map of attributes
+   \post attributes [begin, end) in pairs have been added to m
+   */
+  void attributes(char const * pairs, std::uint64_t begin, std::uint64_t end, std::map<std::string, std::string> & m) const;
+
+  std::unique_ptr<tchecker::mapped_file_t> _file; /*!< Mapped file */
+  std::uint64_t _strings_count;                   /*!< Number of strings */
+  std::uint64_t _nodes_count;                     /*!< Number of nodes */
+  std::uint64_t _edges_count;                     /*!< Number of edges */
+  char const * _string_offsets;                   /*!< Table of string offsets */
+  char const * _node_attributes_offsets;          /*!< Table of offsets of node attributes */
+  char const * _edge_offsets;                     /*!< Table of offsets of outgoing edges */
+  char const * _edge_targets;                     /*!< Table of edge targets */
+  char const * _edge_attributes_offsets;          /*!< Table of offsets of edge attributes */
+  char const * _node_attributes;                  /*!< Table of node attributes */
+  char const * _edge_attributes;                  /*!< Table of edge attributes */
+  char const * _strings;                          /*!< Strings */
+};
+
+/*!
+ \brief Output a binary graph in graphviz DOT language
+ \param os : output stream
+ \param g : a binary graph
+ \post g has been output to os in the graphviz DOT language, with nodes and edges in the order of g
+ \return os after output
+ */
+std::ostream & dot_output(std::ostream & os, tchecker::graph::binary_graph_t const & g);
+
+/*!
+ \brief Output a binary graph in JSON
+ \param os : output stream
+ \param g : a binary graph
+ \post g has been output to os as a JSON object with fields "name", "nodes" (array of objects with fields "id" and
+ "attributes") and "edges" (array of objects with fields "src", "tgt" and "attributes")
+ \return os after output
+ */
+std::ostream & json_output(std::ostream & os, tchecker::graph::binary_graph_t const & g);
+
+} // end of namespace graph
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_GRAPH_BINARY_HH
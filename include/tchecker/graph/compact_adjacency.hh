@@ -0,0 +1,104 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_GRAPH_COMPACT_ADJACENCY_HH
+#define TCHECKER_GRAPH_COMPACT_ADJACENCY_HH
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "tchecker/utils/iterator.hh"
+
+/*!
+ \file compact_adjacency.hh
+ \brief Compact (CSR) adjacency of graphs with dense node indices
+ */
+
+namespace tchecker {
+
+namespace graph {
+
+/*!
+ \class compact_adjacency_t
+ \brief Frozen adjacency of a graph stored as compressed sparse rows: the neighbours of all nodes are stored
+ in one contiguous array, where the neighbours of node i range from offset i to offset i+1. Hence a traversal
+ scans memory sequentially instead of following pointers to edges
+ \note nodes are identified by dense indices in [0, nodes_count())
+ */
+class compact_adjacency_t {
+public:
+  /*!
+   \brief Type of node indices
+   */
+  using index_t = std::uint32_t;
+
+  /*!
+   \brief Type of arcs (node, neighbour)
+   */
+  using arc_t = std::pair<index_t, index_t>;
+
+  /*!
+   \brief Constructor
+   \post this adjacency has no node
+   */
+  compact_adjacency_t();
+
+  /*!
+   \brief Build
+   \param nodes_count : number of nodes
+   \param arcs : arcs (node, neighbour)
+   \pre every node and neighbour in arcs is in [0, nodes_count)
+   \post this adjacency has nodes_count nodes, and the neighbours of each node are the neighbours in arcs, in the
+   order of arcs
+   \throw std::invalid_argument : if an arc is out of bounds (this adjacency is then left unchanged)
+   */
+  void build(std::size_t nodes_count, std::vector<arc_t> const & arcs);
+
+  /*!
+   \brief Clear
+   \post this adjacency has no node
+   */
+  void clear();
+
+  /*!
+   \brief Accessor
+   \return number of nodes
+   */
+  inline std::size_t nodes_count() const { return _offsets.size() - 1; }
+
+  /*!
+   \brief Accessor
+   \return number of arcs
+   */
+  inline std::size_t arcs_count() const { return _neighbours.size(); }
+
+  /*!
+   \brief Accessor
+   \param n : a node index
+   \pre n < nodes_count()
+   \return range of neighbours of n
+   */
+  inline tchecker::range_t<index_t const *> neighbours(index_t n) const
+  {
+    index_t const * base = _neighbours.data();
+    return tchecker::make_range(base + _offsets[n], base + _offsets[n + 1]);
+  }
+
+  /*!
+   \brief Accessor
+   \return memory used by this adjacency in bytes
+   */
+  std::size_t memsize() const;
+
+private:
+  std::vector<std::size_t> _offsets; /*!< Offsets of neighbours of each node in _neighbours (nodes_count()+1) */
+  std::vector<index_t> _neighbours;  /*!< Neighbours of all nodes */
+};
+
+} // end of namespace graph
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_GRAPH_COMPACT_ADJACENCY_HH
@@ -163,6 +163,24 @@ public:
    */
   inline std::size_t size() const { return _nodes.size(); }
 
+  /*!
+   \brief Accessor
+   \return Number of collision lists in the table of nodes
+   */
+  inline std::size_t table_size() const { return _nodes.table_size(); }
+
+  /*!
+   \brief Accessor
+   \return load factor of the table of nodes (see tchecker::collision_table_t::load_factor)
+   */
+  inline double load_factor() const { return _nodes.load_factor(); }
+
+  /*!
+   \brief Accessor
+   \return longest collision list in the table of nodes
+   */
+  inline std::size_t longest_collision_list() const { return _nodes.longest_collision_list(); }
+
   /*!
    \brief Type of iterator over the nodes in the graph
    */
@@ -8,6 +8,7 @@
 #include <map>
 #include <string>
 
+#include "tchecker/graph/guard_variables.hh"
 #include "tchecker/syncprod/vedge.hh"
 #include "tchecker/zg/zg_ha.hh"
 
@@ -51,14 +52,32 @@ private:
   tchecker::const_vedge_sptr_t const _vedge; /*!< Tuple of edges */
 };
 
-struct edge_rel_transition {
-
-  edge_rel_transition(zg_ha::transition_t const & transition);
+/*!
+\class edge_guard_variables_t
+\brief Edge with the variables constrained by the guard of its transition
+\note the edge keeps an index in a table of interned guard variables rather than the transition, which may be
+recycled once its target state has been expanded
+*/
+class edge_guard_variables_t {
+public:
+  /*!
+   \brief Constructor
+   \param transition : a transition
+   \param table : table of guard variables
+   \post the variables constrained by the guard of transition have been interned in table, and this keeps their
+   index
+   \throw std::overflow_error : see tchecker::graph::guard_variables_table_t::intern
+  */
+  edge_guard_variables_t(tchecker::zg_ha::transition_t const & transition, tchecker::graph::guard_variables_table_t & table);
 
-  inline tchecker::zg_ha::transition_t const & get_transition() const { return _transition; }
+  /*!
+   \brief Accessor
+   \return index of guard variables in the table given at construction
+  */
+  inline tchecker::graph::guard_variables_table_t::index_t guard_variables() const { return _guard_variables; }
 
 private:
-  zg_ha::transition_t const & _transition;
+  tchecker::graph::guard_variables_table_t::index_t _guard_variables; /*!< Index of guard variables */
 };
 
 } // namespace graph
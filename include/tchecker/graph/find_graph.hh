@@ -5,6 +5,15 @@
 #ifndef TCHECKER_FIND_GRAPH_HH
 #define TCHECKER_FIND_GRAPH_HH
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
 #include "tchecker/utils/hashtable.hh"
 
 /*!
@@ -151,10 +160,331 @@ public:
    */
   inline std::size_t size() const { return _nodes.size(); }
 
+  /*!
+   \brief Accessor
+   \return memory used by the table of nodes in this graph (excluding nodes)
+   */
+  inline std::size_t memsize() const { return _nodes.memsize(); }
+
+  /*!
+   \brief Accessor
+   \return load factor of the table of nodes (see tchecker::hashtable_t::load_factor)
+   */
+  inline double load_factor() const { return _nodes.load_factor(); }
+
+  /*!
+   \brief Accessor
+   \return longest probe sequence in the table of nodes (see tchecker::hashtable_t::longest_probe)
+   */
+  inline std::size_t longest_probe() const { return _nodes.longest_probe(); }
+
 protected:
   tchecker::hashtable_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_EQUAL> _nodes; /*!< Set of nodes */
 };
 
+/*!
+ \class two_level_graph_t
+ \brief Graph with node finding, where nodes are stored by discrete parts
+ \tparam NODE_SPTR : type of shared pointer to node, the pointed node should
+ inherit from tchecker::hashtable_object_t
+ \tparam NODE_SPTR_HASH : hash function on nodes pointed by NODE_SPTR, should
+ return the same hash code for nodes which are equal w.r.t. EQUAL. Should also have
+ a method discrete(n) that returns a hash code of the discrete part of node n (i.e.
+ its part that does not depend on zones)
+ \tparam NODE_SPTR_EQUAL : equality function on nodes pointed by NODE_SPTR
+ \note this graph implementation stores nodes and answers find queries, with the
+ same interface as tchecker::graph::find::graph_t. It does not store edges
+ \note nodes are stored in buckets, one for each hash code of discrete parts. A node
+ with a new discrete part is found to be new without computing NODE_SPTR_HASH (hence,
+ without hashing its zone). Small buckets are searched linearly w.r.t. NODE_SPTR_EQUAL,
+ larger buckets are indexed by a hashtable w.r.t. NODE_SPTR_HASH
+ \note each node has a unique instance in this graph w.r.t. NODE_SPTR_EQUAL
+ */
+template <class NODE_SPTR, class NODE_SPTR_HASH, class NODE_SPTR_EQUAL> class two_level_graph_t {
+  /*!
+   \brief Type of hashtable indexing large buckets
+   */
+  using index_t = tchecker::hashtable_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_EQUAL>;
+
+  /*!
+   \brief Nodes with the same hash code of their discrete parts
+   */
+  struct bucket_t {
+    std::vector<NODE_SPTR> nodes;  /*!< Nodes, in insertion order */
+    std::unique_ptr<index_t> index; /*!< Index of nodes (nullptr for small buckets) */
+  };
+
+  /*!
+   \brief Type of map : hash code of discrete part -> bucket
+   */
+  using buckets_t = std::unordered_map<std::size_t, bucket_t>;
+
+public:
+  /*!
+   \brief Type of shared pointers to node
+   */
+  using node_sptr_t = NODE_SPTR;
+
+  /*!
+   \brief Type of hash function
+   */
+  using hash_t = NODE_SPTR_HASH;
+
+  /*!
+   \brief Type of equality predicate
+   */
+  using equal_t = NODE_SPTR_EQUAL;
+
+  /*!
+   \brief Size from which buckets are indexed by a hashtable
+   */
+  static constexpr std::size_t INDEXED_BUCKET_SIZE = 8;
+
+  /*!
+   \brief Constructor
+   \param table_size : initial number of buckets
+   \param hash : hash function
+   \param equal : equality predicate
+  */
+  two_level_graph_t(std::size_t table_size, NODE_SPTR_HASH const & hash, NODE_SPTR_EQUAL const & equal)
+      : _buckets(table_size), _hash(hash), _equal(equal), _size(0)
+  {
+  }
+
+  /*!
+   \brief Copy constructor (deleted)
+  */
+  two_level_graph_t(tchecker::graph::find::two_level_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_EQUAL> const &) = delete;
+
+  /*!
+   \brief Move constructor
+  */
+  two_level_graph_t(tchecker::graph::find::two_level_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_EQUAL> &&) = default;
+
+  /*!
+   \brief Destructor
+  */
+  ~two_level_graph_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::graph::find::two_level_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_EQUAL> &
+  operator=(tchecker::graph::find::two_level_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_EQUAL> const &) = delete;
+
+  /*!
+   \brief Move-assignment operator
+   */
+  tchecker::graph::find::two_level_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_EQUAL> &
+  operator=(tchecker::graph::find::two_level_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_EQUAL> &&) = default;
+
+  /*!
+   \brief Clear
+   \post The graph is empty
+   \note No destructor call on nodes
+   */
+  inline void clear()
+  {
+    _buckets.clear();
+    _size = 0;
+  }
+
+  /*!
+   \brief Accessor
+   \param n : a node
+   \return a pair (found, p) where p is true if a node p equal to n has been
+   found in this graph, otherwise found is false and p == n
+  */
+  std::tuple<bool, NODE_SPTR const> find(NODE_SPTR const & n)
+  {
+    auto it = _buckets.find(_hash.discrete(n));
+    if (it == _buckets.end())
+      return std::make_tuple(false, n);
+    bucket_t const & bucket = it->second;
+    if (bucket.index != nullptr)
+      return bucket.index->find(n);
+    for (NODE_SPTR const & m : bucket.nodes)
+      if (_equal(m, n))
+        return std::make_tuple(true, m);
+    return std::make_tuple(false, n);
+  }
+
+  /*!
+   \brief Add node
+   \param n : a node
+   \pre n is not stored in a graph
+   \post n has been added to the graph unless it already contains an equivalent
+   node w.r.t. NODE_SPTR_EQUAL
+   \return true if n has been added to the graph, false otherwise
+   \note Invalidates iterators
+   */
+  bool add_node(NODE_SPTR const & n)
+  {
+    bucket_t & bucket = _buckets[_hash.discrete(n)];
+    if (bucket.index != nullptr) {
+      if (!bucket.index->add(n))
+        return false;
+    }
+    else if (std::any_of(bucket.nodes.begin(), bucket.nodes.end(), [&](NODE_SPTR const & m) { return _equal(m, n); }))
+      return false;
+    bucket.nodes.push_back(n);
+    if (bucket.index == nullptr && bucket.nodes.size() > INDEXED_BUCKET_SIZE) {
+      bucket.index = std::make_unique<index_t>(2 * INDEXED_BUCKET_SIZE, _hash, _equal);
+      for (NODE_SPTR const & m : bucket.nodes)
+        bucket.index->add(m);
+    }
+    ++_size;
+    return true;
+  }
+
+  /*!
+   \brief Remove node from the graph
+   \param n : a node
+   \pre n is stored in this graph
+   \post n has been removed from this graph
+   \throw std::invalid_argument : if n is not stored in this graph
+   \note Linear complexity in the number of nodes with the same hash code of
+   their discrete parts as n
+   \note Invalidates iterators
+   */
+  void remove_node(NODE_SPTR const & n)
+  {
+    auto it = _buckets.find(_hash.discrete(n));
+    if (it == _buckets.end())
+      throw std::invalid_argument("tchecker::graph::find::two_level_graph_t::remove_node: node not found");
+    bucket_t & bucket = it->second;
+    auto node_it = std::find(bucket.nodes.begin(), bucket.nodes.end(), n);
+    if (node_it == bucket.nodes.end())
+      throw std::invalid_argument("tchecker::graph::find::two_level_graph_t::remove_node: node not found");
+    bucket.nodes.erase(node_it);
+    if (bucket.index != nullptr)
+      bucket.index->remove(n);
+    if (bucket.nodes.empty())
+      _buckets.erase(it);
+    --_size;
+  }
+
+  /*!
+   \class const_iterator_t
+   \brief Iterator on nodes
+   */
+  class const_iterator_t {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = NODE_SPTR;
+    using difference_type = std::ptrdiff_t;
+    using pointer = NODE_SPTR const *;
+    using reference = NODE_SPTR const &;
+
+    /*!
+     \brief Constructor
+     \param it : iterator on buckets
+     \pre buckets are not empty
+     \post this points to the first node in the bucket pointed by it if any, past-the-end otherwise
+     */
+    const_iterator_t(typename buckets_t::const_iterator const & it) : _it(it), _pos(0) {}
+
+    /*!
+     \brief Equality predicate
+     \param it : iterator
+     \return true if this and it point to the same node, false otherwise
+     */
+    inline bool operator==(const_iterator_t const & it) const { return _it == it._it && _pos == it._pos; }
+
+    /*!
+     \brief Disequality predicate
+     \param it : iterator
+     \return false if this and it point to the same node, true otherwise
+     */
+    inline bool operator!=(const_iterator_t const & it) const { return !(*this == it); }
+
+    /*!
+     \brief Accessor
+     \pre this is not past-the-end
+     \return pointed node
+     */
+    inline NODE_SPTR const & operator*() const { return _it->second.nodes[_pos]; }
+
+    /*!
+     \brief Move to next node
+     \pre this is not past-the-end
+     \post this points to the next node if any, past-the-end otherwise
+     \return this after increment
+     */
+    const_iterator_t & operator++()
+    {
+      if (++_pos == _it->second.nodes.size()) {
+        ++_it;
+        _pos = 0;
+      }
+      return *this;
+    }
+
+  private:
+    typename buckets_t::const_iterator _it; /*!< Current bucket */
+    std::size_t _pos;                       /*!< Position in current bucket */
+  };
+
+  /*!
+   \brief Accessor
+   \return iterator on first node if any, past-the-end iterator otherwise
+   */
+  inline const_iterator_t begin() const { return const_iterator_t(_buckets.begin()); }
+
+  /*!
+   \brief Accessor
+   \return past-the-end iterator
+   */
+  inline const_iterator_t end() const { return const_iterator_t(_buckets.end()); }
+
+  /*!
+   \brief Accessor
+   \return Number of nodes in this graph
+   */
+  inline std::size_t size() const { return _size; }
+
+  /*!
+   \brief Accessor
+   \return memory used by the buckets of nodes in this graph (excluding nodes)
+   \note linear complexity in the number of buckets
+   */
+  std::size_t memsize() const
+  {
+    std::size_t m = _buckets.bucket_count() * sizeof(void *);
+    for (auto && [h, bucket] : _buckets) {
+      m += sizeof(typename buckets_t::value_type) + sizeof(void *) + bucket.nodes.capacity() * sizeof(NODE_SPTR);
+      if (bucket.index != nullptr)
+        m += sizeof(index_t) + bucket.index->memsize();
+    }
+    return m;
+  }
+
+  /*!
+   \brief Accessor
+   \return load factor of the map of buckets
+   */
+  inline double load_factor() const { return _buckets.load_factor(); }
+
+  /*!
+   \brief Accessor
+   \return number of nodes in the largest bucket (nodes with the same hash code of their discrete parts)
+   \note linear complexity in the number of buckets
+   */
+  std::size_t longest_probe() const
+  {
+    std::size_t longest = 0;
+    for (auto && [h, bucket] : _buckets)
+      longest = std::max(longest, bucket.nodes.size());
+    return longest;
+  }
+
+private:
+  buckets_t _buckets;     /*!< Map : hash code of discrete part -> bucket */
+  NODE_SPTR_HASH _hash;   /*!< Hash function */
+  NODE_SPTR_EQUAL _equal; /*!< Equality predicate */
+  std::size_t _size;      /*!< Number of nodes */
+};
+
 } // end of namespace find
 
 } // end of namespace graph
@@ -0,0 +1,135 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_GRAPH_GUARD_VARIABLES_HH
+#define TCHECKER_GRAPH_GUARD_VARIABLES_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/variables/clocks.hh"
+#include "tchecker/variables/intvars.hh"
+
+/*!
+ \file guard_variables.hh
+ \brief Interned sets of variables constrained by guards
+ */
+
+namespace tchecker {
+
+namespace graph {
+
+/*!
+ \class guard_variables_t
+ \brief Clocks and bounded integer variables constrained by a guard, as sorted sets of identifiers
+ */
+class guard_variables_t {
+public:
+  /*!
+   \brief Constructor
+   \param guard : clock constraints in a guard
+   \param intvar_guard : identifiers of bounded integer variables constrained by a guard
+   \post this keeps the clock of each constraint in guard (the clock that is not the reference clock), and the
+   variables in intvar_guard, without duplicates
+   */
+  guard_variables_t(tchecker::clock_constraint_container_t const & guard, tchecker::intvar_guard_container_t const & intvar_guard);
+
+  /*!
+   \brief Accessor
+   \return sorted identifiers of constrained clocks
+   */
+  inline std::vector<tchecker::clock_id_t> const & clocks() const { return _clocks; }
+
+  /*!
+   \brief Accessor
+   \return sorted identifiers of constrained bounded integer variables
+   */
+  inline std::vector<tchecker::intvar_id_t> const & intvars() const { return _intvars; }
+
+  /*!
+   \brief Equality predicate
+   \param g : guard variables
+   \return true if this and g have the same clocks and the same bounded integer variables, false otherwise
+   */
+  bool operator==(tchecker::graph::guard_variables_t const & g) const;
+
+  /*!
+   \brief Hash
+   \return hash value of this
+   */
+  std::size_t hash() const;
+
+private:
+  std::vector<tchecker::clock_id_t> _clocks;   /*!< Constrained clocks */
+  std::vector<tchecker::intvar_id_t> _intvars; /*!< Constrained bounded integer variables */
+};
+
+/*!
+ \class guard_variables_table_t
+ \brief Table of interned guard variables
+ \note many transitions have the same guard variables, hence an edge only keeps an index in this table rather
+ than the transition it has been built from. Entries are never removed, hence indices remain valid as long as
+ the table
+ */
+class guard_variables_table_t {
+public:
+  /*!
+   \brief Type of index in the table
+   */
+  using index_t = std::uint32_t;
+
+  guard_variables_table_t() = default;
+
+  guard_variables_table_t(tchecker::graph::guard_variables_table_t const &) = delete;
+
+  guard_variables_table_t(tchecker::graph::guard_variables_table_t &&) = delete;
+
+  tchecker::graph::guard_variables_table_t & operator=(tchecker::graph::guard_variables_table_t const &) = delete;
+
+  tchecker::graph::guard_variables_table_t & operator=(tchecker::graph::guard_variables_table_t &&) = delete;
+
+  /*!
+   \brief Intern guard variables
+   \param guard : clock constraints in a guard
+   \param intvar_guard : identifiers of bounded integer variables constrained by a guard
+   \return index of the entry equal to guard_variables_t(guard, intvar_guard) in this table. It is added to
+   this table if there is none
+   \throw std::overflow_error : if the number of entries exceeds the range of index_t
+   */
+  index_t intern(tchecker::clock_constraint_container_t const & guard, tchecker::intvar_guard_container_t const & intvar_guard);
+
+  /*!
+   \brief Accessor
+   \param i : an index
+   \pre i has been returned by intern() on this table
+   \return guard variables with index i
+   */
+  inline tchecker::graph::guard_variables_t const & operator[](index_t i) const { return *_entries[i]; }
+
+  /*!
+   \brief Accessor
+   \return number of entries in this table
+   */
+  inline std::size_t size() const { return _entries.size(); }
+
+private:
+  /*!
+   \brief Hash functor on guard variables
+   */
+  struct hash_t {
+    inline std::size_t operator()(tchecker::graph::guard_variables_t const & g) const { return g.hash(); }
+  };
+
+  std::unordered_map<tchecker::graph::guard_variables_t, index_t, hash_t> _index; /*!< Map: entry -> index */
+  std::vector<tchecker::graph::guard_variables_t const *> _entries;               /*!< Map: index -> entry (in _index) */
+};
+
+} // end of namespace graph
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_GRAPH_GUARD_VARIABLES_HH
@@ -8,6 +8,7 @@
 #include <map>
 #include <string>
 
+#include "tchecker/graph/reset_history.hh"
 #include "tchecker/refzg/state.hh"
 #include "tchecker/zg/state.hh"
 
@@ -155,41 +156,41 @@ private:
   tchecker::refzg::const_state_sptr_t _state; /*!< State of the zone graph with reference clocks */
 };
 
+/*!
+ \class node_reset_history
+ \brief Node with a shared reset history
+ */
 struct node_reset_history {
   /*!
    \brief Constructor
-   \param number_of_clocks : number of the clocks in the system
-   \post this node keeps the number of the clocks
+   \param rhv : shared reset history
+   \pre rhv is not nullptr
+   \post this node keeps a pointer to rhv
+  */
+  node_reset_history(tchecker::graph::reset_history_sptr_t const & rhv);
+
+  /*!
+  \brief Accessor
+  \return the clock reset history
   */
-  node_reset_history(const boost::dynamic_bitset<> rhv);
+  inline tchecker::graph::reset_history_t const & reset_history_vector() const { return *_reset_history_vector; }
 
   /*!
   \brief Accessor
-  \return returns the clock reset history
+  \return pointer to the shared clock reset history
   */
-  boost::dynamic_bitset<> reset_history_vector() const { return _reset_history_vector; }
+  inline tchecker::graph::reset_history_sptr_t const & reset_history_ptr() const { return _reset_history_vector; }
 
   /*!
   \brief Accessor
+  \param rhv : shared reset history
+  \pre rhv is not nullptr
   \post updates the clock reset history
   */
-  void update_reset_history_vector(boost::dynamic_bitset<> vector) { _reset_history_vector = vector; }
-
-  // /*!
-  // \brief Accessor
-  // \return the consistency status of the node regarding clock reset history
-  // */
-  // bool get_consistency_status(std::vector<bool> vector) { return _is_consistent; }
-  //
-  // /*!
-  //   \brief Accessor
-  //   \post sets the consistency status of the node regarding clock reset history
-  //   */
-  // void set_consistency_status(bool status) { _is_consistent = status; }
+  void update_reset_history_vector(tchecker::graph::reset_history_sptr_t const & rhv) { _reset_history_vector = rhv; }
 
 private:
-  boost::dynamic_bitset<> _reset_history_vector; /*!< vector of clock reset history */
-  // bool _is_consistent; /*!< consistency status */
+  tchecker::graph::reset_history_sptr_t _reset_history_vector; /*!< Shared vector of clock reset history */
 };
 
 struct node_reachability {
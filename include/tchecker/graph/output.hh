@@ -9,9 +9,11 @@
 #include <map>
 #include <ostream>
 #include <set>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/utils/allocation_size.hh"
@@ -153,6 +155,62 @@ std::ostream & dot_output(std::ostream & os, GRAPH const & g, std::string const
   return os;
 }
 
+/*!
+ \brief Output a graph in graphviz DOT language, without sorting nodes and edges
+ \tparam GRAPH : type of graph, should provide types GRAPH::node_sptr_t,
+ GRAPH::edge_sptr_t, and method GRAPH::nodes() that returns the range of nodes,
+ and a method GRAPH::outgoing_edges(n) that returns the range of outgoing edges
+ of node n
+ \param os : output stream
+ \param g : a graph
+ \param name : graph name
+ \post the graph g has been output to os in the graphviz DOT language. The nodes
+ are output in the order of g.nodes(), and named by their rank in this order. Then
+ the outgoing edges of each node are output in the order of g.outgoing_edges(n)
+ \return os after output
+ \throw std::runtime_error : if the source or the target of an edge is not a node of g
+ \note nodes and edges are written to os as they are visited, and only the names of
+ nodes are stored. This is much faster than tchecker::graph::dot_output on large
+ graphs, but the output depends on the order of nodes in g
+ */
+template <class GRAPH> std::ostream & dot_output_stream(std::ostream & os, GRAPH const & g, std::string const & name)
+{
+  using node_id_t = std::size_t;
+
+  std::unordered_map<void const *, node_id_t> nodes_id;
+  std::map<std::string, std::string> attr;
+
+  tchecker::graph::dot_output_header(os, name);
+
+  for (typename GRAPH::node_sptr_t const & n : g.nodes()) {
+    node_id_t const id = nodes_id.size();
+    nodes_id.emplace(static_cast<void const *>(&*n), id);
+    attr.clear();
+    g.attributes(n, attr);
+    tchecker::graph::dot_output_node(os, std::to_string(id), attr);
+  }
+
+  auto node_name = [&](typename GRAPH::node_sptr_t const & n) {
+    auto it = nodes_id.find(static_cast<void const *>(&*n));
+    if (it == nodes_id.end())
+      throw std::runtime_error("tchecker::graph::dot_output_stream: node not found");
+    return std::to_string(it->second);
+  };
+
+  for (typename GRAPH::node_sptr_t const & n : g.nodes()) {
+    std::string const src = node_name(n);
+    for (typename GRAPH::edge_sptr_t const & e : g.outgoing_edges(n)) {
+      attr.clear();
+      g.attributes(e, attr);
+      tchecker::graph::dot_output_edge(os, src, node_name(g.edge_tgt(e)), attr);
+    }
+  }
+
+  tchecker::graph::dot_output_footer(os);
+
+  return os;
+}
+
 } // end of namespace graph
 
 } // end of namespace tchecker
@@ -11,15 +11,26 @@
  */
 
 #include <map>
+#include <limits>
 #include <set>
+#include <stdexcept>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <boost/container_hash/hash.hpp>
 
 #include "tchecker/graph/allocators.hh"
+#include "tchecker/graph/compact_adjacency.hh"
 #include "tchecker/graph/directed_graph.hh"
 #include "tchecker/graph/find_graph.hh"
 #include "tchecker/graph/output.hh"
 #include "tchecker/graph/store_graph.hh"
 #include "tchecker/utils/allocation_size.hh"
+#include "tchecker/utils/probes.hh"
 #include "tchecker/utils/shared_objects.hh"
 
 namespace tchecker {
@@ -91,6 +102,39 @@ class node_t : public NODE,
                public tchecker::graph::directed::node_t<tchecker::graph::reachability::edge_sptr_t<NODE, EDGE>> {
 public:
   using NODE::NODE;
+
+  /*!
+   \brief Accessor
+   \return index of this node in its graph
+   \note indices are dense: they range in [0, nodes_index_bound()) of the graph that stores this node
+   */
+  inline std::size_t index() const { return _index; }
+
+  /*!
+   \brief Set index
+   \param index : node index
+   \post this node has index index
+   \note should only be called by the graph that stores this node
+   */
+  inline void index(std::size_t index) { _index = index; }
+
+  /*!
+   \brief Accessor
+   \return true if this node has been pruned since the last compaction of its graph, false otherwise
+   */
+  inline bool pruned() const { return _pruned; }
+
+  /*!
+   \brief Set pruned flag
+   \param pruned : pruned flag
+   \post this node has pruned flag pruned
+   \note should only be called by the graph that stores this node
+   */
+  inline void pruned(bool pruned) { _pruned = pruned; }
+
+private:
+  std::size_t _index{0}; /*!< Index of this node in its graph */
+  bool _pruned{false};   /*!< Pruned flag */
 };
 
 /*!
@@ -146,6 +190,45 @@ namespace graph {
 
 namespace reachability {
 
+/*!
+ \brief Detection of hash functions on nodes with a hash of discrete parts
+ \tparam NODE_HASH : type of hash function on nodes
+ \tparam NODE : type of nodes
+ \note value is true if NODE_HASH has a method discrete(n) that returns the hash code of the discrete part of node n
+ */
+template <class NODE_HASH, class NODE, class = void> struct has_discrete_hash_t : std::false_type {
+};
+
+template <class NODE_HASH, class NODE>
+struct has_discrete_hash_t<NODE_HASH, NODE,
+                           std::void_t<decltype(std::declval<NODE_HASH const &>().discrete(std::declval<NODE const &>()))>>
+    : std::true_type {
+};
+
+/*!
+ \brief Shortcut for has_discrete_hash_t
+ */
+template <class NODE_HASH, class NODE>
+inline constexpr bool has_discrete_hash_v = tchecker::graph::reachability::has_discrete_hash_t<NODE_HASH, NODE>::value;
+
+/*!
+ \brief Detection of edges with a tuple of edges
+ \tparam EDGE : type of edges
+ \note value is true if EDGE has a method vedge() that returns a tuple of edges, with an equality operator ==
+ and a hash function tchecker::hash_value
+ */
+template <class EDGE, class = void> struct has_vedge_t : std::false_type {
+};
+
+template <class EDGE>
+struct has_vedge_t<EDGE, std::void_t<decltype(std::declval<EDGE const &>().vedge())>> : std::true_type {
+};
+
+/*!
+ \brief Shortcut for has_vedge_t
+ */
+template <class EDGE> inline constexpr bool has_vedge_v = tchecker::graph::reachability::has_vedge_t<EDGE>::value;
+
 /*!
  \class graph_t
  \brief Graph that allocates and stores nodes and edges in a reachability graph
@@ -156,6 +239,10 @@ namespace reachability {
  \note this graph allocates nodes of type
  tchecker::graph::reachability::node_t<NODE, EDGE> and edges of type
  tchecker::graph::reachability::edge_t<NODE, EDGE>
+ \note nodes are stored in a tchecker::graph::find::two_level_graph_t if NODE_HASH has a hash of discrete parts (see
+ tchecker::graph::reachability::has_discrete_hash_t), and in a tchecker::graph::find::graph_t otherwise
+ \note edges with a tuple of edges can be unique (see unique_edges): then the graph has at most one edge with a given
+ tuple of edges from a node to another node
 */
 template <class NODE, class EDGE, class NODE_HASH, class NODE_EQUAL> class graph_t {
 private:
@@ -163,6 +250,16 @@ private:
   class node_sptr_hash_t;
   class node_sptr_equal_to_t;
 
+  /*!
+   \brief Type of node store
+   */
+  using find_graph_t = std::conditional_t<
+      tchecker::graph::reachability::has_discrete_hash_v<NODE_HASH, NODE>,
+      tchecker::graph::find::two_level_graph_t<tchecker::graph::reachability::node_sptr_t<NODE, EDGE>, node_sptr_hash_t,
+                                               node_sptr_equal_to_t>,
+      tchecker::graph::find::graph_t<tchecker::graph::reachability::node_sptr_t<NODE, EDGE>, node_sptr_hash_t,
+                                     node_sptr_equal_to_t>>;
+
 public:
   /*!
    \brief Type of nodes
@@ -252,10 +349,39 @@ public:
   {
     _directed_graph.clear(_find_graph.begin(), _find_graph.end());
     _find_graph.clear();
+    _edge_keys.clear();
     _node_pool.destruct_all();
     _edge_pool.destruct_all();
+    _nodes_index_bound = 0;
   }
 
+  /*!
+   \brief Set uniqueness of edges
+   \param unique : uniqueness flag
+   \pre the graph has no edge
+   \post if unique is true, add_edge does not add an edge from a node to another node when the graph already has an
+   edge with the same tuple of edges between them. Otherwise, parallel edges are kept (default)
+   \throw std::invalid_argument : if unique is true and EDGE has no tuple of edges (see
+   tchecker::graph::reachability::has_vedge_t)
+   \note unique edges are indexed by source node, target node and tuple of edges, hence adding an edge takes constant
+   time on average, and the index is kept up to date by the removal of edges
+   */
+  void unique_edges(bool unique)
+  {
+    if constexpr (!tchecker::graph::reachability::has_vedge_v<EDGE>) {
+      if (unique)
+        throw std::invalid_argument("Edges without a tuple of edges cannot be unique");
+    }
+    _unique_edges = unique;
+    _edge_keys.clear();
+  }
+
+  /*!
+   \brief Accessor
+   \return true if edges are unique, false otherwise (see unique_edges(bool))
+   */
+  inline bool unique_edges() const { return _unique_edges; }
+
   /*!
   \brief Add a node
   \param args : arguments to a constructor of type NODE
@@ -264,17 +390,33 @@ public:
   \return a pair (status, n) where status is true if n is a new node that has
   been created and added to the graph, and status is false if the graph already
   contains node n that is equivalent w.r.t NODE_HASH and NODE_EQUAL
+  \note a new node gets the next node index
    */
   template <class... ARGS> std::tuple<bool, node_sptr_t> add_node(ARGS &&... args)
   {
     node_sptr_t node = _node_pool.construct(args...);
     auto && [found, n] = _find_graph.find(node);
-    if (found)
+    if (found) {
+      TCHECKER_PROBE2(graph_add_node, 0, n->index());
       return std::make_tuple(false, n);
+    }
+    node->index(_nodes_index_bound++);
     _find_graph.add_node(node);
+    TCHECKER_PROBE2(graph_add_node, 1, node->index());
     return std::make_tuple(true, node);
   }
 
+  /*!
+   \brief Membership
+   \param n : a node
+   \return true if n is a node of this graph, false otherwise (e.g. if n has been removed by compact())
+   */
+  bool contains(node_sptr_t const & n)
+  {
+    auto && [found, m] = _find_graph.find(n);
+    return found && (m.ptr() == n.ptr());
+  }
+
   /*!
    \brief Add an edge
    \param n1 : source node
@@ -282,20 +424,45 @@ public:
    \param args : arguments to a constructor of EDGE
    \pre n1 and n2 should be nodes of the graph
    \post an instance of EDGE(args) from node n1 to node n2 has been added to the
-   graph
+   graph, unless edges are unique and the graph already has an edge from n1 to n2 with the same tuple of edges
+   (see unique_edges(bool))
+   \return true if the edge has been added, false otherwise
    */
-  template <class... ARGS> void add_edge(node_sptr_t const & n1, node_sptr_t const & n2, ARGS &&... args)
+  template <class... ARGS> bool add_edge(node_sptr_t const & n1, node_sptr_t const & n2, ARGS &&... args)
   {
     edge_sptr_t edge = _edge_pool.construct(args...);
+    if constexpr (tchecker::graph::reachability::has_vedge_v<EDGE>) {
+      if (_unique_edges && !_edge_keys.insert(edge_key_t{n1.ptr(), n2.ptr(), &*edge}).second) {
+        _edge_pool.destruct(edge);
+        return false;
+      }
+    }
     _directed_graph.add_edge(n1, n2, edge);
+    return true;
   }
 
   void change_edge_src (edge_sptr_t const & edge, node_sptr_t const & new_src) {
+    forget_edge(edge);
     _directed_graph.change_edge_src(edge, new_src);
+    remember_edge(edge);
   }
 
   void change_edge_tgt (edge_sptr_t const & edge, node_sptr_t const & new_tgt) {
+    forget_edge(edge);
     _directed_graph.change_edge_tgt(edge, new_tgt);
+    remember_edge(edge);
+  }
+
+  /*!
+  \brief Garbage collection
+  \post unused edges, then unused nodes, have been collected (i.e. destructed, and their memory is reused by
+  later allocations). Hence, the states and transitions only referenced by removed nodes and edges are no
+  longer used
+  */
+  void collect()
+  {
+    _edge_pool.collect();
+    _node_pool.collect();
   }
 
   void remove_node(node_sptr_t const & n)
@@ -305,26 +472,73 @@ public:
   }
 
   void remove_edge(edge_sptr_t const & e) {
+    forget_edge(e);
     _directed_graph.remove_edge(e);
   }
 
   void remove_outgoing_edges(node_sptr_t const & n)
   {
+    if (_unique_edges)
+      for (edge_sptr_t const & e : _directed_graph.outgoing_edges(n))
+        forget_edge(e);
     _directed_graph.remove_outgoing_edges(n);
     // assert(!is_connected(n));
   }
 
   void remove_incoming_edges(node_sptr_t const & n)
   {
+    if (_unique_edges)
+      for (edge_sptr_t const & e : _directed_graph.incoming_edges(n))
+        forget_edge(e);
     _directed_graph.remove_incoming_edges(n);
     // assert(!is_connected(n));
   }
 
+  /*!
+   \brief Prune a node
+   \param n : a node
+   \pre n is a node of this graph
+   \post n has been marked as pruned: its outgoing edges are removed by the next call to compact()
+   \note the edges of n are left unchanged until compact() is called. Hence a pass that prunes nodes should
+   ignore the edges from pruned nodes (see tchecker::graph::reachability::node_t::pruned)
+   */
+  inline void prune(node_sptr_t const & n) { n->pruned(true); }
+
+  /*!
+   \brief Compaction
+   \param keep : predicate on nodes that must stay in this graph
+   \post the outgoing edges of the pruned nodes have been removed. The pruned nodes that had incoming edges
+   before and have none after have been removed, unless keep holds on them. No node is pruned anymore, and the
+   nodes of this graph have dense indices in [0, nodes_count()) (hence nodes_index_bound() == nodes_count())
+   \note removed nodes and edges are collected by the next call to collect()
+   \note a single pass over the nodes, to be called after a pass that has pruned nodes (instead of removing
+   edges and nodes one at a time), and before containers indexed by node indices are built
+   */
+  template <class KEEP> void compact(KEEP && keep)
+  {
+    std::vector<std::tuple<node_sptr_t, bool>> pruned_nodes;
+    for (node_sptr_t const & n : _find_graph)
+      if (n->pruned())
+        pruned_nodes.emplace_back(n, !_directed_graph.incoming_edges(n).empty());
+
+    for (auto && [n, had_incoming_edges] : pruned_nodes)
+      remove_outgoing_edges(n);
+
+    for (auto && [n, had_incoming_edges] : pruned_nodes) {
+      n->pruned(false);
+      if (had_incoming_edges && _directed_graph.incoming_edges(n).empty() && !keep(n))
+        _find_graph.remove_node(n);
+    }
+
+    _nodes_index_bound = 0;
+    for (node_sptr_t const & n : _find_graph)
+      n->index(_nodes_index_bound++);
+  }
+
   /*!
   \brief Type of node iterator
   */
-  using const_node_iterator_t =
-      typename tchecker::graph::find::graph_t<node_sptr_t, node_sptr_hash_t, node_sptr_equal_to_t>::const_iterator_t;
+  using const_node_iterator_t = typename find_graph_t::const_iterator_t;
 
   /*!
   \brief Accessor
@@ -342,6 +556,46 @@ public:
    */
   inline std::size_t nodes_count() const { return _find_graph.size(); }
 
+  /*!
+  \brief Accessor
+  \param m : map (subsystem, bytes)
+  \post the memory used by this graph has been added to m, by subsystem: GRAPH_NODES and GRAPH_EDGES (pool
+  allocators), and GRAPH_TABLE (table of nodes)
+  */
+  void memory_usage(std::map<std::string, std::size_t> & m) const
+  {
+    m["GRAPH_NODES"] = _node_pool.memsize();
+    m["GRAPH_EDGES"] = _edge_pool.memsize();
+    m["GRAPH_TABLE"] = _find_graph.memsize();
+  }
+
+  /*!
+  \brief Accessor
+  \param m : map (key, value)
+  \post the occupancy of the table and of the pool allocators of this graph has been added to m: load factor and
+  longest probe sequence of the table (GRAPH_TABLE_LOAD_FACTOR, GRAPH_TABLE_LONGEST_PROBE), number of blocks and of
+  chunks of the pools (GRAPH_NODES_BLOCKS, GRAPH_NODES_CHUNKS, GRAPH_EDGES_BLOCKS, GRAPH_EDGES_CHUNKS)
+  \note linear complexity in the size of the table
+  */
+  void occupancy(std::map<std::string, std::string> & m) const
+  {
+    m["GRAPH_TABLE_LOAD_FACTOR"] = std::to_string(_find_graph.load_factor());
+    m["GRAPH_TABLE_LONGEST_PROBE"] = std::to_string(_find_graph.longest_probe());
+    m["GRAPH_NODES_BLOCKS"] = std::to_string(_node_pool.pool().blocks_count());
+    m["GRAPH_NODES_CHUNKS"] = std::to_string(_node_pool.pool().chunks_count());
+    m["GRAPH_EDGES_BLOCKS"] = std::to_string(_edge_pool.pool().blocks_count());
+    m["GRAPH_EDGES_CHUNKS"] = std::to_string(_edge_pool.pool().chunks_count());
+  }
+
+  /*!
+   \brief Accessor
+   \return a bound on node indices: every node in this graph has an index in [0, nodes_index_bound())
+   \note indices of removed nodes are not reused until compact() renumbers the nodes, hence nodes_index_bound()
+   may be bigger than nodes_count().
+   Containers indexed by node indices (e.g. bitsets) should have size nodes_index_bound()
+   */
+  inline std::size_t nodes_index_bound() const { return _nodes_index_bound; }
+
   /*!
   \brief Type of incoming edges iterator
   */
@@ -390,6 +644,66 @@ public:
    */
   inline node_sptr_t const & edge_tgt(edge_sptr_t const & edge) const { return _directed_graph.edge_tgt(edge); }
 
+  /*!
+   \brief Compact index of incoming edges
+   \param adjacency : a compact adjacency
+   \param indexed_nodes : a vector of nodes
+   \post adjacency has nodes_index_bound() nodes, and the neighbours of the node with index i are the indices of
+   the sources of its incoming edges (one per edge, in the order of incoming edges). indexed_nodes[i] is the node with
+   index i if it is a node of this graph or the source of an incoming edge, nullptr otherwise
+   \throw std::overflow_error : if node indices do not fit in tchecker::graph::compact_adjacency_t::index_t
+   \note adjacency is a snapshot of this graph: later changes are not reflected. Scanning it avoids chasing
+   pointers through edges, which is faster on large graphs that are traversed without being modified
+   (e.g. backward analysis)
+   */
+  void freeze_incoming(tchecker::graph::compact_adjacency_t & adjacency, std::vector<node_sptr_t> & indexed_nodes) const
+  {
+    using index_t = tchecker::graph::compact_adjacency_t::index_t;
+    if (_nodes_index_bound > std::numeric_limits<index_t>::max())
+      throw std::overflow_error("freeze_incoming: too many nodes");
+
+    std::vector<tchecker::graph::compact_adjacency_t::arc_t> arcs;
+    indexed_nodes.assign(_nodes_index_bound, nullptr);
+    for (node_sptr_t const & n : nodes()) {
+      indexed_nodes[n->index()] = n;
+      for (edge_sptr_t const & e : incoming_edges(n)) {
+        node_sptr_t const & src = edge_src(e);
+        indexed_nodes[src->index()] = src;
+        arcs.emplace_back(static_cast<index_t>(n->index()), static_cast<index_t>(src->index()));
+      }
+    }
+    adjacency.build(_nodes_index_bound, arcs);
+  }
+
+  /*!
+   \brief Compact index of outgoing edges
+   \param adjacency : a compact adjacency
+   \param indexed_nodes : a vector of nodes
+   \post adjacency has nodes_index_bound() nodes, and the neighbours of the node with index i are the indices of
+   the targets of its outgoing edges (one per edge, in the order of outgoing edges). indexed_nodes[i] is the node with
+   index i if it is a node of this graph or the target of an outgoing edge, nullptr otherwise
+   \throw std::overflow_error : if node indices do not fit in tchecker::graph::compact_adjacency_t::index_t
+   \note adjacency is a snapshot of this graph (see freeze_incoming)
+   */
+  void freeze_outgoing(tchecker::graph::compact_adjacency_t & adjacency, std::vector<node_sptr_t> & indexed_nodes) const
+  {
+    using index_t = tchecker::graph::compact_adjacency_t::index_t;
+    if (_nodes_index_bound > std::numeric_limits<index_t>::max())
+      throw std::overflow_error("freeze_outgoing: too many nodes");
+
+    std::vector<tchecker::graph::compact_adjacency_t::arc_t> arcs;
+    indexed_nodes.assign(_nodes_index_bound, nullptr);
+    for (node_sptr_t const & n : nodes()) {
+      indexed_nodes[n->index()] = n;
+      for (edge_sptr_t const & e : outgoing_edges(n)) {
+        node_sptr_t const & tgt = edge_tgt(e);
+        indexed_nodes[tgt->index()] = tgt;
+        arcs.emplace_back(static_cast<index_t>(n->index()), static_cast<index_t>(tgt->index()));
+      }
+    }
+    adjacency.build(_nodes_index_bound, arcs);
+  }
+
   /*!
    \brief Accessor to node attributes
    \param n : a node
@@ -442,6 +756,14 @@ private:
      */
     inline std::size_t operator()(node_sptr_t const & n) const { return _node_hash(*n); }
 
+    /*!
+     \brief Hash function on the discrete parts of shared pointers to nodes
+     \param n : a shared pointer to node
+     \return hash value for the discrete part of *n w.r.t. NODE_HASH
+     \note only available if NODE_HASH has a method discrete (see tchecker::graph::reachability::has_discrete_hash_t)
+     */
+    inline std::size_t discrete(node_sptr_t const & n) const { return _node_hash.discrete(*n); }
+
   private:
     NODE_HASH _node_hash; /*!< Hash function on nodes */
   };
@@ -471,12 +793,76 @@ private:
     NODE_EQUAL _node_eq; /*!< Equality predicate on nodes */
   };
 
+  /*!
+   \brief Key of unique edges
+   */
+  struct edge_key_t {
+    void const * src;  /*!< Source node */
+    void const * tgt;  /*!< Target node */
+    EDGE const * edge; /*!< Edge */
+  };
+
+  /*!
+   \brief Hash functor on keys of unique edges
+   */
+  struct edge_key_hash_t {
+    std::size_t operator()(edge_key_t const & k) const
+    {
+      std::size_t h = tchecker::hash_value(k.edge->vedge());
+      boost::hash_combine(h, k.src);
+      boost::hash_combine(h, k.tgt);
+      return h;
+    }
+  };
+
+  /*!
+   \brief Equality functor on keys of unique edges
+   */
+  struct edge_key_equal_to_t {
+    bool operator()(edge_key_t const & k1, edge_key_t const & k2) const
+    {
+      return k1.src == k2.src && k1.tgt == k2.tgt && k1.edge->vedge() == k2.edge->vedge();
+    }
+  };
+
+  /*!
+   \brief Index a unique edge
+   \param e : an edge of this graph
+   \post e has been added to the index of unique edges if edges are unique
+   */
+  void remember_edge(edge_sptr_t const & e)
+  {
+    if constexpr (tchecker::graph::reachability::has_vedge_v<EDGE>) {
+      if (_unique_edges)
+        _edge_keys.insert(edge_key_t{edge_src(e).ptr(), edge_tgt(e).ptr(), &*e});
+    }
+  }
+
+  /*!
+   \brief Remove a unique edge from the index
+   \param e : an edge of this graph
+   \post e has been removed from the index of unique edges if edges are unique
+   */
+  void forget_edge(edge_sptr_t const & e)
+  {
+    if constexpr (tchecker::graph::reachability::has_vedge_v<EDGE>) {
+      if (!_unique_edges)
+        return;
+      auto it = _edge_keys.find(edge_key_t{edge_src(e).ptr(), edge_tgt(e).ptr(), &*e});
+      if (it != _edge_keys.end() && it->edge == &*e)
+        _edge_keys.erase(it);
+    }
+  }
+
   node_sptr_hash_t _node_sptr_hash;         /*!< Hash functor on shared pointers to nodes */
   node_sptr_equal_to_t _node_sptr_equal_to; /*!< Equality functor on shared pointers to nodes */
-  tchecker::graph::find::graph_t<node_sptr_t, node_sptr_hash_t, node_sptr_equal_to_t> _find_graph; /*!< Node store */
-  tchecker::graph::directed::graph_t<node_sptr_t, edge_sptr_t> _directed_graph;                    /*!< Edge store */
-  tchecker::graph::node_pool_allocator_t<shared_node_t> _node_pool;                                /*!< Node pool allocator */
-  tchecker::graph::edge_pool_allocator_t<shared_edge_t> _edge_pool;                                /*!< Edge pool allocator */
+  find_graph_t _find_graph;                                                     /*!< Node store */
+  tchecker::graph::directed::graph_t<node_sptr_t, edge_sptr_t> _directed_graph; /*!< Edge store */
+  tchecker::graph::node_pool_allocator_t<shared_node_t> _node_pool;             /*!< Node pool allocator */
+  tchecker::graph::edge_pool_allocator_t<shared_edge_t> _edge_pool;             /*!< Edge pool allocator */
+  std::size_t _nodes_index_bound{0};                                            /*!< Next node index */
+  bool _unique_edges{false};                                                    /*!< Uniqueness of edges */
+  std::unordered_set<edge_key_t, edge_key_hash_t, edge_key_equal_to_t> _edge_keys; /*!< Index of unique edges */
 };
 
 /*!
@@ -0,0 +1,92 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_GRAPH_RESET_HISTORY_HH
+#define TCHECKER_GRAPH_RESET_HISTORY_HH
+
+#include <cstddef>
+#include <memory>
+#include <unordered_set>
+
+#include <boost/dynamic_bitset/dynamic_bitset.hpp>
+
+/*!
+ \file reset_history.hh
+ \brief Shared reset histories of clocks and bounded integer variables
+ */
+
+namespace tchecker {
+
+namespace graph {
+
+/*!
+ \brief Type of reset history: one flag per clock followed by one flag per bounded integer variable
+ */
+using reset_history_t = boost::dynamic_bitset<>;
+
+/*!
+ \brief Type of pointer to shared reset history
+ */
+using reset_history_sptr_t = std::shared_ptr<tchecker::graph::reset_history_t const>;
+
+/*!
+ \class reset_history_table_t
+ \brief Table of shared reset histories
+ \note equal reset histories obtained from the same table are shared, hence they can be compared and hashed
+ by pointer, like shared components of states
+ */
+class reset_history_table_t {
+public:
+  /*!
+   \brief Share a reset history
+   \param h : reset history
+   \return pointer to the reset history in this table that is equal to h. It is added to this table if there
+   is none
+   \note shared reset histories are kept in this table until it is cleared or destructed
+   */
+  tchecker::graph::reset_history_sptr_t share(tchecker::graph::reset_history_t && h);
+
+  /*!
+   \brief Share a reset history
+   \param h : reset history
+   \return see share(tchecker::graph::reset_history_t &&)
+   */
+  tchecker::graph::reset_history_sptr_t share(tchecker::graph::reset_history_t const & h);
+
+  /*!
+   \brief Accessor
+   \return number of reset histories in this table
+   */
+  inline std::size_t size() const { return _table.size(); }
+
+  /*!
+   \brief Clear
+   \post this table is empty
+   \note reset histories are still available through the pointers that have been returned by share
+   */
+  inline void clear() { _table.clear(); }
+
+private:
+  /*!
+   \brief Hash functor on pointers to reset histories, which hashes the reset histories (blocks of bits)
+   */
+  struct hash_t {
+    std::size_t operator()(tchecker::graph::reset_history_sptr_t const & h) const;
+  };
+
+  /*!
+   \brief Equality functor on pointers to reset histories, which compares the reset histories
+   */
+  struct equal_to_t {
+    bool operator()(tchecker::graph::reset_history_sptr_t const & h1, tchecker::graph::reset_history_sptr_t const & h2) const;
+  };
+
+  std::unordered_set<tchecker::graph::reset_history_sptr_t, hash_t, equal_to_t> _table; /*!< Shared reset histories */
+};
+
+} // end of namespace graph
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_GRAPH_RESET_HISTORY_HH
@@ -10,9 +10,14 @@
  \brief Subsumption graph with node covering, and actual/subsumption edges
 */
 
+#include <cstdint>
+#include <functional>
 #include <map>
 #include <set>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 #include "tchecker/graph/allocators.hh"
 #include "tchecker/graph/cover_graph.hh"
@@ -31,7 +36,10 @@ namespace subsumption {
 // Forward declarations
 template <class NODE, class EDGE> class node_t;
 template <class NODE, class EDGE> class edge_t;
-template <class NODE, class EDGE, class NODE_HASH, class NODE_LE> class graph_t;
+class no_summary_t;
+template <class NODE, class EDGE, class NODE_HASH, class NODE_LE,
+          class NODE_SUMMARY = tchecker::graph::subsumption::no_summary_t>
+class graph_t;
 
 /*!
  \brief Type of shared node
@@ -92,6 +100,12 @@ class node_t : public NODE,
                public tchecker::graph::directed::node_t<tchecker::graph::subsumption::edge_sptr_t<NODE, EDGE>> {
 public:
   using NODE::NODE;
+
+private:
+  template <class N, class E, class NODE_HASH, class NODE_LE, class NODE_SUMMARY>
+  friend class tchecker::graph::subsumption::graph_t;
+
+  std::int64_t _index_rank{0}; /*!< Upper rank of the summary of this node in the subsumption index */
 };
 
 /*!
@@ -123,7 +137,8 @@ public:
   }
 
 private:
-  template <class N, class E, class NODE_HASH, class NODE_LE> friend class tchecker::graph::subsumption::graph_t;
+  template <class N, class E, class NODE_HASH, class NODE_LE, class NODE_SUMMARY>
+  friend class tchecker::graph::subsumption::graph_t;
 
   /*!
    \brief Accessor
@@ -183,6 +198,48 @@ namespace graph {
 
 namespace subsumption {
 
+/*!
+ \class no_summary_t
+ \brief Node summary for graphs without subsumption index
+ \note A node summary functor for tchecker::graph::subsumption::graph_t defines a type summary_t, a method
+ summary(n) that returns the summary of a node n, and a method may_be_le(s1, s2) that returns false only if the
+ node with summary s1 is not covered by the node with summary s2 (i.e. a necessary condition for covering). It also
+ defines methods lower_rank(s) and upper_rank(s) such that may_be_le(s1, s2) implies lower_rank(s1) <= upper_rank(s2),
+ which are used to order the subsumption index
+ */
+class no_summary_t {
+public:
+  /*!
+   \brief Type of summaries
+   */
+  struct summary_t {
+  };
+
+  /*!
+   \brief Summary computation
+   \return an empty summary
+   */
+  template <class NODE> inline summary_t summary(NODE const &) const { return summary_t{}; }
+
+  /*!
+   \brief Necessary condition for covering
+   \return true
+   */
+  inline bool may_be_le(summary_t const &, summary_t const &) const { return true; }
+
+  /*!
+   \brief Lower rank of a summary
+   \return 0
+   */
+  inline std::int64_t lower_rank(summary_t const &) const { return 0; }
+
+  /*!
+   \brief Upper rank of a summary
+   \return 0
+   */
+  inline std::int64_t upper_rank(summary_t const &) const { return 0; }
+};
+
 /*!
  \class graph_t
  \brief Graph that allocates and stores nodes and edges in a subsumption graph.
@@ -195,16 +252,28 @@ namespace subsumption {
  \tparam NODE_LE : covering predicate on nodes, should be callable with two
  parameters of type NODE const &, and return true is the first node is covered
  by the second one, false otherwise
+ \tparam NODE_SUMMARY : node summary functor (see tchecker::graph::subsumption::no_summary_t). Unless
+ NODE_SUMMARY is tchecker::graph::subsumption::no_summary_t, the graph maintains a subsumption index: the
+ nodes with the same hash value w.r.t. NODE_HASH are stored with their summaries in a bucket ordered by decreasing
+ upper rank of summaries. A node n is only checked against the nodes with upper rank at least the lower rank of n
+ when looking for a covering node, and against the nodes with lower rank at most the upper rank of n when looking
+ for covered nodes. Remaining candidate nodes are rejected by NODE_SUMMARY::may_be_le before NODE_LE is called
+ \note the graph counts the calls to NODE_LE and to NODE_SUMMARY::may_be_le (see cover_checks and summary_checks)
  \note this graph allocates nodes of type
  tchecker::graph::subsumption::node_t<NODE, EDGE> and edges of type
  tchecker::graph::subsumption::edge_t<NODE, EDGE>
 */
-template <class NODE, class EDGE, class NODE_HASH, class NODE_LE> class graph_t {
+template <class NODE, class EDGE, class NODE_HASH, class NODE_LE, class NODE_SUMMARY> class graph_t {
 private:
   // Forward declarations
   class node_sptr_hash_t;
   class node_sptr_le_t;
 
+  /*!
+   \brief Flag: true if this graph maintains a subsumption index, false otherwise
+   */
+  static constexpr bool const has_index = !std::is_same<NODE_SUMMARY, tchecker::graph::subsumption::no_summary_t>::value;
+
 public:
   /*!
    \brief Type of nodes
@@ -254,20 +323,35 @@ public:
   \param node_le : covering predicate on nodes
   */
   graph_t(std::size_t block_size, std::size_t table_size, NODE_HASH const & node_hash, NODE_LE const & node_le)
-      : _node_sptr_hash(node_hash), _node_sptr_le(node_le), _cover_graph(table_size, _node_sptr_hash, _node_sptr_le),
-        _node_pool(block_size), _edge_pool(block_size)
+      : graph_t(block_size, table_size, node_hash, node_le, NODE_SUMMARY{})
+  {
+  }
+
+  /*!
+  \brief Constructor
+  \param block_size : number of objects allocated in a block
+  \param table_size : size of hash table
+  \param node_hash : hash function on nodes
+  \param node_le : covering predicate on nodes
+  \param node_summary : summary functor on nodes
+  */
+  graph_t(std::size_t block_size, std::size_t table_size, NODE_HASH const & node_hash, NODE_LE const & node_le,
+          NODE_SUMMARY const & node_summary)
+      : _cover_checks(0), _summary_checks(0), _node_sptr_hash(node_hash), _node_sptr_le(node_le, _cover_checks),
+        _node_summary(node_summary),
+        _cover_graph(table_size, _node_sptr_hash, _node_sptr_le), _node_pool(block_size), _edge_pool(block_size)
   {
   }
 
   /*!
   \brief Copy constructor (deleted)
   */
-  graph_t(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE> const &) = delete;
+  graph_t(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE, NODE_SUMMARY> const &) = delete;
 
   /*!
   \brief Move constructor (deleted)
   */
-  graph_t(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE> &&) = delete;
+  graph_t(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE, NODE_SUMMARY> &&) = delete;
 
   /*!
   \brief Destructor
@@ -277,14 +361,14 @@ public:
   /*!
   \brief Assignment operator (deleted)
   */
-  tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE> &
-  operator=(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE> const &) = delete;
+  tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE, NODE_SUMMARY> &
+  operator=(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE, NODE_SUMMARY> const &) = delete;
 
   /*!
   \brief Move-assignment operator (deleted)
   */
-  tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE> &
-  operator=(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE> &&) = delete;
+  tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE, NODE_SUMMARY> &
+  operator=(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE, NODE_SUMMARY> &&) = delete;
 
   /*!
   \brief Clear the graph
@@ -293,6 +377,7 @@ public:
   void clear()
   {
     _directed_graph.clear(_cover_graph.begin(), _cover_graph.end());
+    _index.clear();
     _cover_graph.clear();
     _node_pool.destruct_all();
     _edge_pool.destruct_all();
@@ -307,6 +392,12 @@ public:
   {
     node_sptr_t node = _node_pool.construct(args...);
     _cover_graph.add_node(node);
+    if constexpr (has_index) {
+      typename NODE_SUMMARY::summary_t summary = _node_summary.summary(*node);
+      std::int64_t const lower_rank = _node_summary.lower_rank(summary);
+      node->_index_rank = _node_summary.upper_rank(summary);
+      _index[_node_sptr_hash(node)].emplace(node->_index_rank, index_entry_t{node, std::move(summary), lower_rank});
+    }
     return node;
   }
 
@@ -334,13 +425,16 @@ public:
    \pre n is stored in this graph.
    n is disconnected (checked by assertion)
    \post n has been removed from this graph
-   \note constant-time complexity
+   \note constant-time complexity, logarithmic in the number of nodes with the same hash value as n with a
+   subsumption index
    \throw std::invalid_argument : if n is not stored in this graph
    */
   void remove_node(node_sptr_t const & n)
   {
     assert(!is_connected(n));
     _cover_graph.remove_node(n);
+    if constexpr (has_index)
+      remove_from_index(n);
   }
 
   /*!
@@ -388,7 +482,28 @@ public:
    */
   bool is_covered(node_sptr_t const & n, node_sptr_t & covering_node) const
   {
-    return _cover_graph.is_covered(n, covering_node);
+    if constexpr (has_index) {
+      covering_node = nullptr;
+      auto it = _index.find(_node_sptr_hash(n));
+      if (it == _index.end())
+        return false;
+      typename NODE_SUMMARY::summary_t const summary = _node_summary.summary(*n);
+      // candidates have upper rank at least the lower rank of n: they come first in the bucket
+      auto const last = it->second.upper_bound(_node_summary.lower_rank(summary));
+      for (auto candidate = it->second.begin(); candidate != last; ++candidate) {
+        index_entry_t const & entry = candidate->second;
+        if (entry.node == n)
+          continue;
+        ++_summary_checks;
+        if (_node_summary.may_be_le(summary, entry.summary) && _node_sptr_le(n, entry.node)) {
+          covering_node = entry.node;
+          return true;
+        }
+      }
+      return false;
+    }
+    else
+      return _cover_graph.is_covered(n, covering_node);
   }
 
   /*!
@@ -401,7 +516,22 @@ public:
    */
   template <class INSERTER> void covered_nodes(node_sptr_t const & n, INSERTER & ins) const
   {
-    _cover_graph.covered_nodes(n, ins);
+    if constexpr (has_index) {
+      auto it = _index.find(_node_sptr_hash(n));
+      if (it == _index.end())
+        return;
+      typename NODE_SUMMARY::summary_t const summary = _node_summary.summary(*n);
+      std::int64_t const upper_rank = _node_summary.upper_rank(summary);
+      for (auto const & [rank, entry] : it->second) {
+        if ((entry.node == n) || (entry.lower_rank > upper_rank))
+          continue;
+        ++_summary_checks;
+        if (_node_summary.may_be_le(entry.summary, summary) && _node_sptr_le(entry.node, n))
+          ins = entry.node;
+      }
+    }
+    else
+      _cover_graph.covered_nodes(n, ins);
   }
 
   /*!
@@ -463,6 +593,18 @@ public:
    */
   inline std::size_t nodes_count() const { return _cover_graph.size(); }
 
+  /*!
+   \brief Accessor
+   \return Number of calls to the covering predicate NODE_LE since this graph has been built
+   */
+  inline unsigned long cover_checks() const { return _cover_checks; }
+
+  /*!
+   \brief Accessor
+   \return Number of calls to NODE_SUMMARY::may_be_le since this graph has been built (0 without subsumption index)
+   */
+  inline unsigned long summary_checks() const { return _summary_checks; }
+
   /*!
    \brief Type of iterator on nodes
   */
@@ -552,20 +694,27 @@ private:
     /*!
      \brief Constructor
      \param node_le : covering predicate on nodes
-     \post this keeps a copy of node_le
+     \param checks : counter of calls to node_le
+     \post this keeps a copy of node_le, and a pointer to checks
      */
-    node_sptr_le_t(NODE_LE const & node_le) : _node_le(node_le) {}
+    node_sptr_le_t(NODE_LE const & node_le, unsigned long & checks) : _node_le(node_le), _checks(&checks) {}
 
     /*!
      \brief Covering predicate on shared pointers to nodes
      \param n1 : a node
      \param n2 : a node
      \return true if *n1 is less-than-or-equal-to *n2 w.r.t. NODE_LE, false otherwise
+     \post the counter of calls has been incremented
      */
-    inline bool operator()(node_sptr_t const & n1, node_sptr_t const & n2) const { return _node_le(*n1, *n2); }
+    inline bool operator()(node_sptr_t const & n1, node_sptr_t const & n2) const
+    {
+      ++*_checks;
+      return _node_le(*n1, *n2);
+    }
 
   private:
-    NODE_LE _node_le; /*!< Covering predicate on nodes */
+    NODE_LE _node_le;        /*!< Covering predicate on nodes */
+    unsigned long * _checks; /*!< Counter of calls to _node_le */
   };
 
   /*!
@@ -580,8 +729,50 @@ private:
     return (in_edges.begin() != in_edges.end() || out_edges.begin() != out_edges.end());
   }
 
-  node_sptr_hash_t _node_sptr_hash; /*!< Hash functor on shared pointers to nodes */
-  node_sptr_le_t _node_sptr_le;     /*!< Covering functor on shared pointers to nodes */
+  /*!
+   \brief Entry of the subsumption index
+   */
+  struct index_entry_t {
+    node_sptr_t node;                          /*!< Node */
+    typename NODE_SUMMARY::summary_t summary; /*!< Summary of node */
+    std::int64_t lower_rank;                   /*!< Lower rank of summary */
+  };
+
+  /*!
+   \brief Type of buckets of the subsumption index: entries by decreasing upper rank of their summaries
+   */
+  using bucket_t = std::multimap<std::int64_t, index_entry_t, std::greater<std::int64_t>>;
+
+  /*!
+   \brief Remove a node from the subsumption index
+   \param n : a node
+   \post n has been removed from the subsumption index
+   \note logarithmic in the number of nodes with the same hash value as n, and linear in the number of those nodes
+   with the same upper rank as n
+   */
+  void remove_from_index(node_sptr_t const & n)
+  {
+    auto it = _index.find(_node_sptr_hash(n));
+    if (it == _index.end())
+      return;
+    bucket_t & bucket = it->second;
+    auto && [first, last] = bucket.equal_range(n->_index_rank);
+    for (auto entry = first; entry != last; ++entry) {
+      if (entry->second.node == n) {
+        bucket.erase(entry);
+        break;
+      }
+    }
+    if (bucket.empty())
+      _index.erase(it);
+  }
+
+  mutable unsigned long _cover_checks;              /*!< Number of calls to the covering predicate */
+  mutable unsigned long _summary_checks;            /*!< Number of calls to the necessary condition on summaries */
+  node_sptr_hash_t _node_sptr_hash;                 /*!< Hash functor on shared pointers to nodes */
+  node_sptr_le_t _node_sptr_le;                     /*!< Covering functor on shared pointers to nodes */
+  NODE_SUMMARY _node_summary;                       /*!< Summary functor on nodes */
+  std::unordered_map<std::size_t, bucket_t> _index; /*!< Subsumption index (if has_index) */
   tchecker::graph::cover::graph_t<node_sptr_t, node_sptr_hash_t, node_sptr_le_t> _cover_graph; /*!< Node store with covering */
   tchecker::graph::directed::graph_t<node_sptr_t, edge_sptr_t> _directed_graph;                /*!< Edge store */
   tchecker::graph::node_pool_allocator_t<shared_node_t> _node_pool;                            /*!< Node pool allocator */
@@ -0,0 +1,69 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_PARSING_BINARY_HH
+#define TCHECKER_PARSING_BINARY_HH
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "tchecker/parsing/declaration.hh"
+
+/*!
+ \file binary.hh
+ \brief Binary format of system declarations
+ \note a binary file starts with BINARY_MAGIC, the version of the format and a byte-order mark, followed by the
+ system declaration and its inner declarations in their order of declaration. Names, attributes and contexts are
+ stored as length-prefixed strings, and declarations refer to the process, location and event declarations they
+ depend on by their index in the file. Loading a binary file maps it in memory and builds the declarations without
+ lexing and parsing the text model
+ */
+
+namespace tchecker {
+
+namespace parsing {
+
+/*!
+ \brief Magic number of binary system files
+ */
+constexpr char const BINARY_MAGIC[4] = {'T', 'C', 'K', 'B'};
+
+/*!
+ \brief Version of the binary format
+ \note files of another version are rejected, they should be compiled again from the text model
+ */
+constexpr std::uint32_t const BINARY_VERSION = 1;
+
+/*!
+ \brief Write a system declaration in binary format
+ \param os : output stream (binary mode)
+ \param sysdecl : system declaration
+ \post sysdecl has been written to os in binary format
+ \throw std::runtime_error : if writing to os fails
+ */
+void write_binary_system_declaration(std::ostream & os, tchecker::parsing::system_declaration_t const & sysdecl);
+
+/*!
+ \brief Check the format of a file
+ \param filename : file name
+ \return true if filename can be read and starts with tchecker::parsing::BINARY_MAGIC, false otherwise
+ */
+bool is_binary_system_declaration(std::string const & filename);
+
+/*!
+ \brief Load a system declaration in binary format
+ \param filename : file name
+ \return the system declaration stored in filename
+ \throw std::runtime_error : if filename cannot be mapped in memory, if it has another version of the format or
+ another byte order, or if its content is not a valid system declaration
+ \note the caller owns the returned system declaration
+ */
+tchecker::parsing::system_declaration_t * load_binary_system_declaration(std::string const & filename);
+
+} // end of namespace parsing
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_PARSING_BINARY_HH
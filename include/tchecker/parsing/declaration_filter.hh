@@ -0,0 +1,111 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_PARSING_DECLARATION_FILTER_HH
+#define TCHECKER_PARSING_DECLARATION_FILTER_HH
+
+#include <string>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/parsing/declaration.hh"
+
+/*!
+ \file declaration_filter.hh
+ \brief Filtered copy of system declarations
+ */
+
+namespace tchecker {
+
+namespace parsing {
+
+/*!
+ \class declaration_filter_t
+ \brief Visitor that copies the declarations of a system declaration that are kept, into another system declaration
+ \note the declarations that refer to other declarations (locations, edges and synchronizations) are rebuilt on top
+ of the declarations of the copy, hence the copy does not depend on the visited system declaration. Derived classes
+ choose the kept declarations, and how events and the attributes of edges are copied, by overriding the keep
+ predicates, event_name and edge_attributes. Everything is kept by default
+ */
+class declaration_filter_t : public tchecker::parsing::declaration_visitor_t {
+public:
+  /*!
+   \brief Constructor
+   \param copy : system declaration where the kept declarations are inserted
+   */
+  explicit declaration_filter_t(tchecker::parsing::system_declaration_t & copy);
+
+  /*!
+   \brief Destructor
+   */
+  virtual ~declaration_filter_t() = default;
+
+  /*!
+   \brief Visitors
+   \post the kept declarations in d have been copied into the copy. Edges and synchronizations are identified by
+   their rank among the edge (resp. synchronization) declarations of the visited system declaration. A
+   synchronization is kept if it satisfies its keep predicate, and if its kept constraints are all its constraints,
+   or at least two constraints
+   \throw std::runtime_error : if a kept declaration clashes with a declaration of the copy, or if it refers to a
+   declaration that is not in the copy
+   */
+  virtual void visit(tchecker::parsing::system_declaration_t const & d);
+  virtual void visit(tchecker::parsing::clock_declaration_t const & d);
+  virtual void visit(tchecker::parsing::int_declaration_t const & d);
+  virtual void visit(tchecker::parsing::process_declaration_t const & d);
+  virtual void visit(tchecker::parsing::event_declaration_t const & d);
+  virtual void visit(tchecker::parsing::location_declaration_t const & d);
+  virtual void visit(tchecker::parsing::edge_declaration_t const & d);
+  virtual void visit(tchecker::parsing::sync_declaration_t const & d);
+
+protected:
+  /*!
+   \brief Keep predicates
+   \return true if the declaration has to be copied, false otherwise
+   */
+  virtual bool keep(tchecker::parsing::clock_declaration_t const & d) { return true; }
+  virtual bool keep(tchecker::parsing::int_declaration_t const & d) { return true; }
+  virtual bool keep(tchecker::parsing::process_declaration_t const & d) { return true; }
+  virtual bool keep(tchecker::parsing::event_declaration_t const & d) { return true; }
+  virtual bool keep(tchecker::parsing::location_declaration_t const & d) { return true; }
+  virtual bool keep(tchecker::parsing::edge_declaration_t const & d, tchecker::edge_id_t id) { return true; }
+  virtual bool keep(tchecker::parsing::sync_declaration_t const & d, tchecker::sync_id_t id) { return true; }
+  virtual bool keep(tchecker::parsing::sync_constraint_t const & c) { return true; }
+
+  /*!
+   \brief Renaming of events
+   \param name : name of an event of the visited system declaration
+   \return name of the event in the copy (name by default)
+   */
+  virtual std::string const & event_name(std::string const & name) const { return name; }
+
+  /*!
+   \brief Attributes of copied edges
+   \param d : edge declaration
+   \param id : identifier of d
+   \return attributes of the copy of d (the attributes of d by default)
+   */
+  virtual tchecker::parsing::attributes_t edge_attributes(tchecker::parsing::edge_declaration_t const & d,
+                                                          tchecker::edge_id_t id) const;
+
+  /*!
+   \brief Accessors
+   \return the declaration with the given name in the copy
+   \throw std::runtime_error : if the copy has no such declaration
+   */
+  tchecker::parsing::process_declaration_t const & process(std::string const & name) const;
+  tchecker::parsing::location_declaration_t const & location(std::string const & process, std::string const & name) const;
+  tchecker::parsing::event_declaration_t const & event(std::string const & name) const;
+
+  tchecker::parsing::system_declaration_t & _copy; /*!< Copy */
+
+private:
+  tchecker::edge_id_t _edge_id; /*!< Identifier of next edge declaration */
+  tchecker::sync_id_t _sync_id; /*!< Identifier of next synchronization declaration */
+};
+
+} // end of namespace parsing
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_PARSING_DECLARATION_FILTER_HH
@@ -0,0 +1,56 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_PARSING_JSON_HH
+#define TCHECKER_PARSING_JSON_HH
+
+#include <string>
+
+#include "tchecker/parsing/declaration.hh"
+
+/*!
+ \file json.hh
+ \brief JSON format of system declarations (see doc/json-spec.md)
+ \note JSON files are read by a dedicated parser that builds the declarations directly, without the lexer and the
+ parser of the TChecker file format. Attribute values are not parsed, they are stored as in the text format and
+ parsed when the system is built
+ */
+
+namespace tchecker {
+
+namespace parsing {
+
+/*!
+ \brief Check the format of a file
+ \param filename : file name
+ \return true if filename can be read and its first non-blank character is '{', false otherwise
+ */
+bool is_json_system_declaration(std::string const & filename);
+
+/*!
+ \brief Parse a system declaration in JSON format
+ \param text : JSON text
+ \param context : context of text (e.g. file name), used in positions of declarations and in error messages
+ \return the system declaration in text
+ \throw std::runtime_error : if text is not valid JSON, or if it is not a valid system declaration
+ \note the caller owns the returned system declaration
+ */
+tchecker::parsing::system_declaration_t * parse_json_system_declaration(std::string const & text,
+                                                                        std::string const & context);
+
+/*!
+ \brief Load a system declaration in JSON format
+ \param filename : file name
+ \return the system declaration stored in filename
+ \throw std::runtime_error : if filename cannot be mapped in memory, if its content is not valid JSON, or if it is
+ not a valid system declaration
+ \note the caller owns the returned system declaration
+ */
+tchecker::parsing::system_declaration_t * load_json_system_declaration(std::string const & filename);
+
+} // end of namespace parsing
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_PARSING_JSON_HH
@@ -22,6 +22,8 @@ namespace parsing {
  \param filename : file to parse
  \return The system declaration read from filename, nullptr if parsing failed
  \post All errors and warnings have been reported on std::cerr
+ \note filename is loaded without parsing if it is in binary format (see tchecker::parsing::load_binary_system_declaration)
+ \note filename is read by the JSON parser if it is in JSON format (see tchecker::parsing::load_json_system_declaration)
  */
 tchecker::parsing::system_declaration_t * parse_system_declaration(std::string const & filename);
 
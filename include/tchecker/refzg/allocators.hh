@@ -177,7 +177,7 @@ public:
   void collect()
   {
     tchecker::ta::details::state_pool_allocator_t<STATE>::collect();
-    _zone_cache->collect();
+    _zone_cache->collect_now();
     _zone_pool.collect();
   }
 
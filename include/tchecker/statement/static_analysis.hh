@@ -6,6 +6,7 @@
 #define TCHECKER_STATEMENT_STATIC_ANALYSIS_HH
 
 #include <unordered_set>
+#include <vector>
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/statement/typed_statement.hh"
@@ -52,6 +53,17 @@ void extract_written_variables(tchecker::typed_statement_t const & stmt, std::un
  sequence statements are recursively visited.
  */
 bool has_local_declarations(tchecker::typed_statement_t const & stmt);
+
+/*!
+ \brief Extract the assignments of a statement made of a sequence of assignments
+ \param stmt : statement
+ \param assignments : vector of assignments
+ \return true if stmt is a sequence of assignments (and nop), false otherwise (conditionals, loops and local
+ declarations)
+ \post the assignments in stmt have been appended to assignments in order (only partially if false is returned)
+ */
+bool flat_assignments(tchecker::typed_statement_t const & stmt,
+                      std::vector<tchecker::typed_assign_statement_t const *> & assignments);
 } // end of namespace tchecker
 
 #endif // TCHECKER_STATEMENT_STATIC_ANALYSIS_HH
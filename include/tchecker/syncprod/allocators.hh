@@ -168,7 +168,7 @@ public:
   void collect()
   {
     tchecker::ts::state_pool_allocator_t<STATE>::collect();
-    _vloc_cache->collect();
+    _vloc_cache->collect_now();
     _vloc_pool.collect();
   }
 
@@ -190,6 +190,12 @@ public:
    */
   std::size_t memsize() const { return tchecker::ts::state_pool_allocator_t<STATE>::memsize() + _vloc_pool.memsize(); }
 
+  /*!
+   \brief Accessor
+   \return Memory used by the tuples of locations in this state allocator
+   */
+  std::size_t vloc_memsize() const { return _vloc_pool.memsize(); }
+
 protected:
   /*!
    \brief Construct state
@@ -202,6 +208,54 @@ protected:
     return tchecker::ts::state_pool_allocator_t<STATE>::construct_from_state(s, _vloc_pool.construct(s.vloc()), args...);
   }
 
+  /*!
+   \brief Construct state from given components
+   \param vloc : a tuple of locations
+   \param args : arguments to a constructor of STATE beyond tuple of locations
+   \return a new instance of STATE constructed from vloc and args
+   \note vloc is not allocated from this allocator, and it is not destructed by destruct_state()
+   */
+  template <class... ARGS>
+  tchecker::intrusive_shared_ptr_t<STATE>
+  construct_from_components(tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t> const & vloc, ARGS &&... args)
+  {
+    return tchecker::ts::state_pool_allocator_t<STATE>::construct(vloc, args...);
+  }
+
+  /*!
+   \brief Construct state from a state and given components
+   \param s : a state
+   \param vloc : a tuple of locations
+   \param args : arguments to a constructor of STATE beyond tuple of locations
+   \return a new instance of STATE constructed from s, vloc and args
+   \note vloc is not allocated from this allocator, and it is not destructed by destruct_state()
+   */
+  template <class... ARGS>
+  tchecker::intrusive_shared_ptr_t<STATE>
+  construct_from_state_and_components(STATE const & s, tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t> const & vloc,
+                                      ARGS &&... args)
+  {
+    return tchecker::ts::state_pool_allocator_t<STATE>::construct_from_state(s, vloc, args...);
+  }
+
+  /*!
+   \brief Destruct state, but not its components
+   \param p : pointer to state
+   \pre p has been constructed by this allocator
+   \post same as destruct(p), except that the tuple of locations in the state pointed by p is not destructed
+   \return true if the state has been destructed, false otherwise
+   */
+  bool destruct_state(tchecker::intrusive_shared_ptr_t<STATE> & p)
+  {
+    return tchecker::ts::state_pool_allocator_t<STATE>::destruct(p);
+  }
+
+  /*!
+   \brief Accessor
+   \return Capacity of allocated tuples of locations
+   */
+  inline std::size_t vloc_capacity() const { return _vloc_capacity; }
+
   std::size_t _vloc_capacity;                           /*!< Capacity of tuples of locations */
   tchecker::pool_t<tchecker::shared_vloc_t> _vloc_pool; /*!< Pool of tuples of locations */
   std::shared_ptr<vloc_cache_t> _vloc_cache;            /*!< Cache of tuples of locations */
@@ -349,7 +403,7 @@ public:
   void collect()
   {
     tchecker::ts::transition_pool_allocator_t<TRANSITION>::collect();
-    _vedge_cache->collect();
+    _vedge_cache->collect_now();
     _vedge_pool.collect();
   }
 
@@ -374,6 +428,12 @@ public:
     return tchecker::ts::transition_pool_allocator_t<TRANSITION>::memsize() + _vedge_pool.memsize();
   }
 
+  /*!
+   \brief Accessor
+   \return Memory used by the tuples of edges in this transition allocator
+   */
+  std::size_t vedge_memsize() const { return _vedge_pool.memsize(); }
+
 protected:
   /*!
    \brief Construct a transition from a transition
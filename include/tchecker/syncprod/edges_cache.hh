@@ -0,0 +1,203 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_SYNCPROD_EDGES_CACHE_HH
+#define TCHECKER_SYNCPROD_EDGES_CACHE_HH
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/syncprod/syncprod.hh"
+#include "tchecker/syncprod/system.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/system/edge.hh"
+#include "tchecker/utils/iterator.hh"
+#include "tchecker/utils/shared_objects.hh"
+
+/*!
+ \file edges_cache.hh
+ \brief Cache of outgoing and incoming tuples of edges of tuples of locations
+ */
+
+namespace tchecker {
+
+namespace syncprod {
+
+/*!
+ \class edges_list_t
+ \brief Materialized list of tuples of edges
+ \note the tuples of edges are ranges of tchecker::syncprod::edges_iterator_t, as the values of
+ tchecker::syncprod::outgoing_edges_range_t and tchecker::syncprod::incoming_edges_range_t
+ */
+class edges_list_t {
+public:
+  /*!
+   \brief Type of iterator over tuples of edges
+   */
+  using const_iterator_t = std::vector<tchecker::range_t<tchecker::syncprod::edges_iterator_t>>::const_iterator;
+
+  /*!
+   \brief Constructor
+   \tparam RANGE : type of range of tuples of edges
+   \param range : range of tuples of edges
+   \post this is the list of tuples of edges in range, in the same order
+   */
+  template <class RANGE> explicit edges_list_t(RANGE && range)
+  {
+    std::vector<std::size_t> offsets{0};
+    for (auto && vedge : range) {
+      for (tchecker::system::edge_const_shared_ptr_t const & edge : vedge)
+        _edges.push_back(edge);
+      offsets.push_back(_edges.size());
+    }
+
+    _vedges.reserve(offsets.size() - 1);
+    for (std::size_t i = 0; i + 1 < offsets.size(); ++i)
+      _vedges.push_back(tchecker::make_range(tchecker::syncprod::edges_iterator_t(_edges.data() + offsets[i]),
+                                             tchecker::syncprod::edges_iterator_t(_edges.data() + offsets[i + 1])));
+  }
+
+  /*!
+   \brief Copy constructor (deleted: tuples of edges point to the edges of this list)
+   */
+  edges_list_t(tchecker::syncprod::edges_list_t const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted: tuples of edges point to the edges of this list)
+   */
+  edges_list_t(tchecker::syncprod::edges_list_t &&) = delete;
+
+  /*!
+   \brief Destructor
+   */
+  ~edges_list_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::syncprod::edges_list_t & operator=(tchecker::syncprod::edges_list_t const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::syncprod::edges_list_t & operator=(tchecker::syncprod::edges_list_t &&) = delete;
+
+  /*!
+   \brief Accessor
+   \return number of tuples of edges
+   */
+  inline std::size_t size() const { return _vedges.size(); }
+
+  /*!
+   \brief Accessor
+   \return iterator on first tuple of edges
+   */
+  inline tchecker::syncprod::edges_list_t::const_iterator_t begin() const { return _vedges.begin(); }
+
+  /*!
+   \brief Accessor
+   \return past-the-end iterator on tuples of edges
+   */
+  inline tchecker::syncprod::edges_list_t::const_iterator_t end() const { return _vedges.end(); }
+
+private:
+  std::vector<tchecker::system::edge_const_shared_ptr_t> _edges;                /*!< Edges of all tuples */
+  std::vector<tchecker::range_t<tchecker::syncprod::edges_iterator_t>> _vedges; /*!< Tuples of edges */
+};
+
+/*!
+ \class vloc_edges_cache_t
+ \brief Direct-mapped cache of the outgoing and incoming tuples of edges of tuples of locations
+ \note Outgoing (resp. incoming) tuples of edges only depend on the tuple of locations, hence they are computed once by
+ tchecker::syncprod::outgoing_edges (resp. tchecker::syncprod::incoming_edges) and materialized as lists of tuples of
+ edges. Entries are keyed by the contents of tuples of locations, and they do not keep references on states, so they
+ are not affected by sharing or garbage collection of states. A cache of size 0 does not store anything
+ */
+class vloc_edges_cache_t {
+public:
+  /*!
+   \brief Constructor
+   \param size : number of entries
+   \post this cache has the largest power of 2 entries that is not greater than size, and no entry if size is 0
+   */
+  vloc_edges_cache_t(std::size_t size = 1024);
+
+  /*!
+   \brief Outgoing tuples of edges
+   \param system : a system
+   \param vloc : tuple of locations
+   \return list of the tuples of edges in tchecker::syncprod::outgoing_edges(system, vloc)
+   \post the list has been cached
+   \pre all calls on this cache are made with the same system
+   */
+  std::shared_ptr<tchecker::syncprod::edges_list_t const>
+  outgoing_edges(tchecker::syncprod::system_t const & system,
+                 tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc);
+
+  /*!
+   \brief Incoming tuples of edges
+   \param system : a system
+   \param vloc : tuple of locations
+   \return list of the tuples of edges in tchecker::syncprod::incoming_edges(system, vloc)
+   \post the list has been cached
+   \pre all calls on this cache are made with the same system
+   */
+  std::shared_ptr<tchecker::syncprod::edges_list_t const>
+  incoming_edges(tchecker::syncprod::system_t const & system,
+                 tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc);
+
+  /*!
+   \brief Clear
+   \post this cache is empty
+   */
+  void clear();
+
+private:
+  /*!
+   \brief Cache entry
+   */
+  struct entry_t {
+    std::vector<tchecker::loc_id_t> _vloc;                  /*!< Tuple of locations */
+    std::shared_ptr<tchecker::syncprod::edges_list_t const> _edges; /*!< Tuples of edges (nullptr if empty entry) */
+  };
+
+  /*!
+   \brief Lookup
+   \param entries : cache entries
+   \param vloc : tuple of locations
+   \return the entry of vloc in entries
+   \pre entries is not empty
+   */
+  entry_t & entry(std::vector<entry_t> & entries, tchecker::vloc_t const & vloc) const;
+
+  /*!
+   \brief Check if an entry matches a tuple of locations
+   \param entry : cache entry
+   \param vloc : tuple of locations
+   \return true if entry is not empty and its tuple of locations is vloc, false otherwise
+   */
+  static bool matches(entry_t const & entry, tchecker::vloc_t const & vloc);
+
+  /*!
+   \brief Fill an entry
+   \param entry : cache entry
+   \param vloc : tuple of locations
+   \param edges : tuples of edges
+   \post entry maps vloc to edges
+   */
+  static void fill(entry_t & entry, tchecker::vloc_t const & vloc,
+                   std::shared_ptr<tchecker::syncprod::edges_list_t const> const & edges);
+
+  std::vector<entry_t> _outgoing; /*!< Entries of outgoing tuples of edges */
+  std::vector<entry_t> _incoming; /*!< Entries of incoming tuples of edges */
+  std::size_t _mask;              /*!< Number of entries - 1 */
+};
+
+} // end of namespace syncprod
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_SYNCPROD_EDGES_CACHE_HH
@@ -6,6 +6,7 @@
 #define TCHECKER_SYNCPROD_EDGES_ITERATORS_HH
 
 #include <functional>
+#include <memory>
 #include <vector>
 
 #include <boost/iterator/transform_iterator.hpp>
@@ -81,13 +82,16 @@ public:
    \brief Constructor
    \param vloc : tuple of locations
    \param loc_edges_maps : maps loc id -> edges/events
-   \param sync_begin : iterator on first synchronization
-   \param sync_end : past-the-end iterator on synchronizations
+   \param syncs_begin : iterator on first synchronization
+   \param sync_ids : identifiers of candidate synchronizations, in increasing order
+   \pre the synchronization with identifier id is syncs_begin + id for every id in sync_ids
+   \note only the synchronizations in sync_ids are considered, see
+   tchecker::syncprod::system_t::outgoing_synchronizations
    */
   vloc_synchronized_edges_iterator_t(tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc,
                                      std::shared_ptr<tchecker::system::loc_edges_maps_t const> const & loc_edges_maps,
-                                     tchecker::system::synchronizations_t::const_iterator_t const & sync_begin,
-                                     tchecker::system::synchronizations_t::const_iterator_t const & sync_end);
+                                     tchecker::system::synchronizations_t::const_iterator_t const & syncs_begin,
+                                     std::shared_ptr<tchecker::syncprod::system_t::sync_ids_t const> const & sync_ids);
 
   /*!
    \brief Copy constructor
@@ -177,20 +181,32 @@ protected:
   \brief Fast end-of-range check
   \return true if this is past-the-end, false otherwise
   */
-  inline bool at_end() const { return (_sync_it == _sync_end); }
+  inline bool at_end() const { return (_sync_ids_it == _sync_ids->end()); }
+
+  /*!
+   \brief Accessor
+   \pre not at_end()  (checked by assertion)
+   \return current synchronization
+   */
+  inline tchecker::system::synchronization_t const & synchronization() const
+  {
+    assert(!at_end());
+    return *(_syncs_begin + *_sync_ids_it);
+  }
 
   /*!
    \brief Fills cartesian product
    \post either this range is at_end(), or _cartesian_it has been filled with ranges of edges corresponding to
-   synchronzation pointed by _sync_it
+   synchronzation pointed by _sync_ids_it
    */
   void advance_while_empty_cartesian_product();
 
   tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> _vloc; /*!< Vector of locations */
   /*!< Maps loc id -> edges/events */
   std::shared_ptr<tchecker::system::loc_edges_maps_t const> _loc_edges_maps;
-  tchecker::system::synchronizations_t::const_iterator_t _sync_it;  /*!< Iterator on synchronizations */
-  tchecker::system::synchronizations_t::const_iterator_t _sync_end; /*!< Past-the-end iterator on synchronizations */
+  tchecker::system::synchronizations_t::const_iterator_t _syncs_begin; /*!< Iterator on first synchronization */
+  std::shared_ptr<tchecker::syncprod::system_t::sync_ids_t const> _sync_ids;    /*!< Candidate synchronizations */
+  tchecker::syncprod::system_t::sync_ids_t::const_iterator _sync_ids_it;       /*!< Iterator on candidate synchronizations */
   /*!< Cartesian iterator */
   tchecker::cartesian_iterator_t<tchecker::range_t<tchecker::system::edges_collection_const_iterator_t>> _cartesian_it;
 };
@@ -241,6 +257,15 @@ public:
    */
   edges_iterator_t(tchecker::syncprod::vloc_synchronized_edges_iterator_t::edges_iterator_t const & it);
 
+  /*!
+   \brief Constructor
+   \param edge : pointer in an array of edges
+   \pre edge != nullptr (checked by assertion)
+   \post this is an iterator on the array of edges from edge
+   \note this iterator is invalidated if the array is modified
+   */
+  explicit edges_iterator_t(tchecker::system::edge_const_shared_ptr_t const * edge);
+
   /*!
    \brief Copy constructor
    */
@@ -300,6 +325,8 @@ private:
   bool _async_at_end;
   /*!< Iterator over synchronized edges */
   tchecker::syncprod::vloc_synchronized_edges_iterator_t::edges_iterator_t _sync_it;
+  /*!< Pointer in an array of edges (nullptr if not iterating over an array) */
+  tchecker::system::edge_const_shared_ptr_t const * _array_it;
 };
 
 /*!
@@ -0,0 +1,72 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_SYNCPROD_LABEL_DISTANCE_HH
+#define TCHECKER_SYNCPROD_LABEL_DISTANCE_HH
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <boost/dynamic_bitset/dynamic_bitset.hpp>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/syncprod/system.hh"
+#include "tchecker/syncprod/vloc.hh"
+
+/*!
+ \file label_distance.hh
+ \brief Distance to searched labels in the location graphs of processes (search heuristic)
+ */
+
+namespace tchecker {
+
+namespace syncprod {
+
+/*!
+ \class label_distance_t
+ \brief Estimation of the number of edges from a tuple of locations to a tuple of locations with the searched
+ labels
+ \note for each searched label, the distance from a location l of process p is the minimal number of edges of p
+ from l to a location of p with the label. The distance from a tuple of locations is the sum, over the searched
+ labels, of the minimal distance over the processes. Synchronizations, guards and invariants are ignored, hence this
+ is a heuristic: it does not under-approximate the actual number of transitions in general
+ */
+class label_distance_t {
+public:
+  /*!
+   \brief Distance for unreachable labels
+   */
+  static constexpr std::size_t UNREACHABLE = std::numeric_limits<std::size_t>::max();
+
+  /*!
+   \brief Constructor
+   \param system : a system of processes
+   \param labels : searched labels
+   \pre labels has size system.labels_count()
+   \post this is the distance to labels in the location graphs of the processes in system
+   \throw std::invalid_argument : if labels does not have size system.labels_count()
+   */
+  label_distance_t(tchecker::syncprod::system_t const & system, boost::dynamic_bitset<> const & labels);
+
+  /*!
+   \brief Accessor
+   \param vloc : tuple of locations
+   \pre vloc is a tuple of locations of the system given to the constructor (checked by assertion)
+   \return distance from vloc to the searched labels, UNREACHABLE if some searched label cannot be reached from vloc
+   \note the distance is 0 if no label is searched
+   */
+  std::size_t distance(tchecker::vloc_t const & vloc) const;
+
+private:
+  std::size_t _loc_number;                   /*!< Number of locations */
+  std::vector<tchecker::label_id_t> _labels; /*!< Searched labels */
+  std::vector<std::size_t> _distance;        /*!< Map : label index * _loc_number + location -> distance */
+};
+
+} // end of namespace syncprod
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_SYNCPROD_LABEL_DISTANCE_HH
@@ -5,6 +5,7 @@
 #ifndef TCHECKER_SYNCPROD_SYSTEM_HH
 #define TCHECKER_SYNCPROD_SYSTEM_HH
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -12,6 +13,7 @@
 
 #include "tchecker/parsing/declaration.hh"
 #include "tchecker/syncprod/label.hh"
+#include "tchecker/syncprod/vloc.hh"
 #include "tchecker/system/edge.hh"
 #include "tchecker/system/system.hh"
 #include "tchecker/utils/iterator.hh"
@@ -221,6 +223,31 @@ public:
 
   // Cast
 
+  /*!
+   \brief Type of collections of synchronization identifiers
+   */
+  using sync_ids_t = std::vector<tchecker::sync_id_t>;
+
+  /*!
+   \brief Accessor
+   \param vloc : tuple of locations
+   \return identifiers, in increasing order, of the synchronizations that may have outgoing edges from vloc
+   \note the result contains all the synchronizations that are enabled from vloc. Synchronizations are indexed by one
+   of their strong constraints (pid, event): they are only considered from tuples of locations where process pid has an
+   outgoing edge on event. Synchronizations without strong constraints are always considered
+   */
+  std::shared_ptr<tchecker::syncprod::system_t::sync_ids_t const>
+  outgoing_synchronizations(tchecker::vloc_t const & vloc) const;
+
+  /*!
+   \brief Accessor
+   \param vloc : tuple of locations
+   \return identifiers, in increasing order, of the synchronizations that may have incoming edges to vloc
+   \note see outgoing_synchronizations
+   */
+  std::shared_ptr<tchecker::syncprod::system_t::sync_ids_t const>
+  incoming_synchronizations(tchecker::vloc_t const & vloc) const;
+
   /*!
    \brief Cast
    \return this as a tchecker::system::system_t instance
@@ -255,6 +282,12 @@ private:
    */
   void compute_labels();
 
+  /*!
+   \brief Index synchronizations
+   \post _outgoing_syncs, _incoming_syncs and _unconditional_syncs have been computed
+   */
+  void index_synchronizations();
+
   /*!
    \brief Add asynchronous edge
    \param edge : an edge
@@ -275,6 +308,9 @@ private:
   std::vector<asynchronous_edges_collection_t> _async_outgoing_edges; /*!< Map : loc id -> asynchronous outgoing edges */
   std::vector<asynchronous_edges_collection_t> _async_incoming_edges; /*!< Map : loc id -> asynchronous incoming edges */
   static asynchronous_edges_collection_t const _empty_async_edges;    /*!< Empty collection of asynchronous edges */
+  std::vector<sync_ids_t> _outgoing_syncs; /*!< Map : loc id -> synchronizations indexed by outgoing edges from loc */
+  std::vector<sync_ids_t> _incoming_syncs; /*!< Map : loc id -> synchronizations indexed by incoming edges to loc */
+  sync_ids_t _unconditional_syncs;         /*!< Synchronizations without strong constraints */
   boost::dynamic_bitset<> _committed;                                 /*!< Committed locations */
   std::vector<boost::dynamic_bitset<>> _labels;                       /*!< Map: location identifier -> labels */
 };
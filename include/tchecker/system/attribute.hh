@@ -6,10 +6,12 @@
 #define TCHECKER_SYSTEM_ATTRIBUTE_HH
 
 #include <array>
+#include <cstdint>
 #include <iostream>
 #include <set>
 #include <string>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "tchecker/parsing/declaration.hh"
 #include "tchecker/utils/iterator.hh"
@@ -59,22 +61,56 @@ public:
   using tchecker::parsing::attr_t::attr_t;
 };
 
+/*!
+ \brief Keys of attributes interpreted by TChecker
+ \note keys are interned when attributes are added, then the attributes with an interned key are accessed by an
+ array lookup (see tchecker::system::attributes_t::range)
+ */
+enum attr_key_t {
+  ATTR_KEY_COMMITTED = 0, /*!< Key "committed" */
+  ATTR_KEY_DO,            /*!< Key "do" */
+  ATTR_KEY_INITIAL,       /*!< Key "initial" */
+  ATTR_KEY_INVARIANT,     /*!< Key "invariant" */
+  ATTR_KEY_LABEL,         /*!< Key "label" */
+  ATTR_KEY_LABELS,        /*!< Key "labels" */
+  ATTR_KEY_PROVIDED,      /*!< Key "provided" */
+  ATTR_KEY_URGENT,        /*!< Key "urgent" */
+  ATTR_KEY_OTHER,         /*!< Any other key (not interned) */
+};
+
+/*!
+ \brief Interning of attribute keys
+ \param key : attribute key
+ \return the interned key of key, tchecker::system::ATTR_KEY_OTHER if key is not interned
+ */
+enum tchecker::system::attr_key_t attr_key(std::string const & key);
+
+/*!
+ \brief Accessor
+ \param key : interned key
+ \pre key is not tchecker::system::ATTR_KEY_OTHER
+ \return name of key
+ \throw std::invalid_argument : if key is tchecker::system::ATTR_KEY_OTHER
+ */
+std::string const & attr_key_name(enum tchecker::system::attr_key_t key);
+
 /*!
  \class attributes_t
- \brief Collection of attributes as a map key -> attribute to allow iteration
- on keys
+ \brief Collection of attributes to allow iteration on keys
+ \note attributes are stored contiguously and grouped by keys (groups in the order of the first attribute of each
+ key, and attributes in each group in insertion order). The group of each interned key is indexed
  */
 class attributes_t {
   /*!
-   \brief Type of map key -> attribute
+   \brief Type of container of attributes
   */
-  using map_t = std::unordered_multimap<std::string, tchecker::system::attr_t>;
+  using container_t = std::vector<tchecker::system::attr_t>;
 
 public:
   /*!
    \brief Default contructor
    */
-  attributes_t() = default;
+  attributes_t();
 
   /*!
    \brief Constructor
@@ -113,7 +149,7 @@ public:
    \param key : attribute key
    \param value : attribute value
    \param parsing_position : parsing position of the attribute
-   \post attribute (key, value, parsing_position) has been added to the map
+   \post attribute (key, value, parsing_position) has been added to the group of key
    */
   void add_attribute(std::string const & key, std::string const & value,
                      tchecker::system::attr_parsing_position_t const & parsing_position);
@@ -121,7 +157,7 @@ public:
   /*!
    \brief Merge attributes
    \param attr : attributes
-   \post all attributes from attr have been added to the map
+   \post all attributes from attr have been added
    */
   void add_attributes(tchecker::system::attributes_t const & attr);
 
@@ -129,31 +165,40 @@ public:
    \class const_iterator_t
    \brief Const iterator on attributes, that dereferences to tchecker::system::attr_t
    */
-  class const_iterator_t : public map_t::const_iterator {
+  class const_iterator_t : public container_t::const_iterator {
   public:
     /*!
      \brief Constructor
-     \param it : map iterator
+     \param it : container iterator
      \post this iterator point to it
      */
-    const_iterator_t(map_t::const_iterator const & it);
-
-    /*!
-     \brief Accessor
-     \return attribute at pointed map entry
-     */
-    inline tchecker::system::attr_t const & operator*() const { return (*this)->second; }
+    const_iterator_t(container_t::const_iterator const & it);
   };
 
   /*!
    \brief Accessor
    \param key : attribute key
-   \pre key exists in this map
    \return range (begin,end) of values associated to key
    \note the returned range is empty (i.e. begin=end) if there is no attribute key in this map
+   \note attributes with an interned key are accessed in constant time (see tchecker::system::attr_key)
    */
   tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> range(std::string const & key) const;
 
+  /*!
+   \brief Accessor
+   \param key : interned key
+   \pre key is not tchecker::system::ATTR_KEY_OTHER
+   \return range (begin,end) of values associated to key
+   \note the returned range is empty (i.e. begin=end) if there is no attribute key in this map
+   */
+  inline tchecker::range_t<tchecker::system::attributes_t::const_iterator_t>
+  range(enum tchecker::system::attr_key_t key) const
+  {
+    auto const & group = _groups[key];
+    return tchecker::make_range<tchecker::system::attributes_t::const_iterator_t>(_attributes.begin() + group.first,
+                                                                                   _attributes.begin() + group.second);
+  }
+
   /*!
    \brief Accessor
    \return range of attributes
@@ -162,7 +207,14 @@ public:
   tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> range() const;
 
 private:
-  map_t _map; /*!< Map : key -> attribute */
+  /*!
+   \brief Index the groups of interned keys
+   \post _groups has been updated w.r.t. _attributes
+   */
+  void index_groups();
+
+  container_t _attributes;                                                   /*!< Attributes grouped by keys */
+  std::array<std::pair<std::uint32_t, std::uint32_t>, ATTR_KEY_OTHER> _groups; /*!< Interned key -> group */
 };
 
 /*!
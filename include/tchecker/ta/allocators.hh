@@ -124,6 +124,19 @@ public:
     return tchecker::ta::details::state_pool_allocator_t<STATE>::construct_from_state(s);
   }
 
+  /*!
+   \brief Clone state, sharing its valuation of bounded integer variables
+   \param s : a state
+   \return a new instance of STATE that is a clone of s, except that its valuation of bounded integer variables is the
+   one in s (not a copy)
+   \pre the valuation of bounded integer variables of the new state is never modified (e.g. the state is only updated
+   along edges that satisfy tchecker::ta::static_statements)
+  */
+  tchecker::intrusive_shared_ptr_t<STATE> clone_sharing_intval(STATE const & s)
+  {
+    return tchecker::ta::details::state_pool_allocator_t<STATE>::construct_from_state_sharing_intval(s);
+  }
+
   /*!
    \brief Destruct state
    \param p : pointer to state
@@ -170,7 +183,7 @@ public:
   void collect()
   {
     tchecker::syncprod::details::state_pool_allocator_t<STATE>::collect();
-    _intval_cache->collect();
+    _intval_cache->collect_now();
     _intval_pool.collect();
   }
 
@@ -196,6 +209,14 @@ public:
     return tchecker::syncprod::details::state_pool_allocator_t<STATE>::memsize() + _intval_pool.memsize();
   }
 
+  /*!
+   \brief Accessor
+   \return Memory used by the valuations of bounded integer variables in this state allocator
+   */
+  std::size_t intval_memsize() const { return _intval_pool.memsize(); }
+
+  using tchecker::syncprod::details::state_pool_allocator_t<STATE>::vloc_memsize;
+
 protected:
   /*!
    \brief Construct state from a state
@@ -210,6 +231,78 @@ protected:
         s, _intval_pool.construct(s.intval()), args...);
   }
 
+  /*!
+   \brief Construct state from a state, sharing its valuation of bounded integer variables
+   \param s : a state
+   \param args : arguments to a constructor of STATE beyond tuple of locations and valuation of bounded integer variables
+   \return a new instance of STATE constructed from a copy of the tuple of locations in s, the valuation of bounded
+   integer variables in s, and args
+   \note the valuation is only destructed by destruct() once it is not referenced by any other state
+   */
+  template <class... ARGS>
+  tchecker::intrusive_shared_ptr_t<STATE> construct_from_state_sharing_intval(STATE const & s, ARGS &&... args)
+  {
+    tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t> intval{
+        const_cast<tchecker::shared_intval_t *>(s.intval_ptr().ptr())};
+    return tchecker::syncprod::details::state_pool_allocator_t<STATE>::construct_from_state(s, intval, args...);
+  }
+
+  /*!
+   \brief Construct state from given components
+   \param vloc : a tuple of locations
+   \param intval : a valuation of bounded integer variables
+   \param args : arguments to a constructor of STATE beyond tuple of locations and valuation of bounded integer variables
+   \return a new instance of STATE constructed from vloc, intval and args
+   \note vloc and intval are not allocated from this allocator, and they are not destructed by destruct_state()
+   */
+  template <class... ARGS>
+  tchecker::intrusive_shared_ptr_t<STATE>
+  construct_from_components(tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t> const & vloc,
+                            tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t> const & intval, ARGS &&... args)
+  {
+    return tchecker::syncprod::details::state_pool_allocator_t<STATE>::construct_from_components(vloc, intval, args...);
+  }
+
+  /*!
+   \brief Construct state from a state and given components
+   \param s : a state
+   \param vloc : a tuple of locations
+   \param intval : a valuation of bounded integer variables
+   \param args : arguments to a constructor of STATE beyond tuple of locations and valuation of bounded integer variables
+   \return a new instance of STATE constructed from s, vloc, intval and args
+   \note vloc and intval are not allocated from this allocator, and they are not destructed by destruct_state()
+   */
+  template <class... ARGS>
+  tchecker::intrusive_shared_ptr_t<STATE>
+  construct_from_state_and_components(STATE const & s, tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t> const & vloc,
+                                      tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t> const & intval,
+                                      ARGS &&... args)
+  {
+    return tchecker::syncprod::details::state_pool_allocator_t<STATE>::construct_from_state_and_components(s, vloc, intval,
+                                                                                                          args...);
+  }
+
+  /*!
+   \brief Destruct state, but not its components
+   \param p : pointer to state
+   \pre p has been constructed by this allocator
+   \post same as destruct(p), except that the tuple of locations and the valuation of bounded integer variables in the
+   state pointed by p are not destructed
+   \return true if the state has been destructed, false otherwise
+   */
+  bool destruct_state(tchecker::intrusive_shared_ptr_t<STATE> & p)
+  {
+    return tchecker::syncprod::details::state_pool_allocator_t<STATE>::destruct_state(p);
+  }
+
+  /*!
+   \brief Accessor
+   \return Capacity of allocated valuations of bounded integer variables
+   */
+  inline std::size_t intval_capacity() const { return _intval_capacity; }
+
+  using tchecker::syncprod::details::state_pool_allocator_t<STATE>::vloc_capacity;
+
   std::size_t _intval_capacity;                             /*!< Capacity of valuations of bounded integer variables */
   tchecker::pool_t<tchecker::shared_intval_t> _intval_pool; /*!< Pool of valuations of bounded integer variables */
   std::shared_ptr<intval_cache_t> _intval_cache;            /*!< Cache of valuations of bounded integer variables */
@@ -248,6 +341,7 @@ public:
   using tchecker::syncprod::details::transition_pool_allocator_t<TRANSITION>::share;
   using tchecker::syncprod::details::transition_pool_allocator_t<TRANSITION>::destruct_all;
   using tchecker::syncprod::details::transition_pool_allocator_t<TRANSITION>::memsize;
+  using tchecker::syncprod::details::transition_pool_allocator_t<TRANSITION>::vedge_memsize;
 
 protected:
   using tchecker::syncprod::details::transition_pool_allocator_t<TRANSITION>::construct_from_transition;
@@ -170,7 +170,7 @@ public:
   void collect()
   {
     tchecker::syncprod::details::state_pool_allocator_t<STATE>::collect();
-    _intval_cache->collect();
+    _intval_cache->collect_now();
     _intval_pool.collect();
   }
 
@@ -0,0 +1,90 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_TA_DECOMPOSITION_HH
+#define TCHECKER_TA_DECOMPOSITION_HH
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <tuple>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/system.hh"
+
+/*!
+ \file decomposition.hh
+ \brief Decomposition of systems into a property and an environment (compositional reachability)
+ */
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \brief Maximal number of groups of processes for which all the decompositions are enumerated. Larger systems are
+ decomposed greedily
+ */
+std::size_t const DECOMPOSITION_EXHAUSTIVE_GROUPS = 16;
+
+/*!
+ \brief Decomposition of a system into a property and an environment
+ */
+struct decomposition_t {
+  boost::dynamic_bitset<> property; /*!< Processes of the property (the other ones are in the environment) */
+  std::size_t interface_syncs;       /*!< Synchronizations with processes in the property and in the environment */
+  std::size_t interface_intvars;     /*!< Bounded integer variables accessed by the property and the environment */
+  std::size_t property_clocks;       /*!< Clocks of the property */
+  std::size_t environment_clocks;    /*!< Clocks of the environment */
+
+  /*!
+   \brief Accessor
+   \return size of the interface between the property and the environment
+   */
+  inline std::size_t interface_size() const { return interface_syncs + interface_intvars; }
+};
+
+/*!
+ \brief Search a decomposition
+ \param system : a system of timed processes
+ \param labels : comma-separated list of searched labels
+ \param strict : if true, the property has more processes than the processes with a location labelled by labels and
+ the processes that share clocks with them
+ \return the decomposition of system with the smallest interface, then the fewest clocks in the property, then the
+ fewest processes in the property, among the decompositions such that: the property contains the processes with a
+ location labelled by labels, the property and the environment do not share clocks, and the environment is not empty.
+ All the decompositions are compared when the processes form at most DECOMPOSITION_EXHAUSTIVE_GROUPS groups of
+ processes sharing clocks, otherwise groups are added to the property greedily while they reduce the interface (the
+ first group is added even if it does not reduce the interface when strict is true)
+ \throw std::invalid_argument : if labels is empty or contains an unknown label, or if no decomposition exists
+ \note strict decompositions are used to decompose the environment of a merged system again (hierarchical
+ compositional reachability), as the property then grows at each level
+ */
+tchecker::ta::decomposition_t decompose(tchecker::ta::system_t const & system, std::string const & labels,
+                                        bool strict = false);
+
+/*!
+ \brief Split a system declaration
+ \param sysdecl : system declaration
+ \param decomposition : decomposition of the system declared by sysdecl
+ \return the system, property and environment declarations of decomposition, as output by system-generator: the
+ events only used by the property are renamed as epsilon events (prefixed by '_') in the three declarations. The
+ property and the environment have their own processes, clocks and events, and all the bounded integer variables. The
+ environment has the synchronizations of sysdecl restricted to its processes (when they still synchronize at least two
+ processes), and the property has no synchronization
+ \pre decomposition has been computed by tchecker::ta::decompose from the system declared by sysdecl
+ \throw std::invalid_argument : if sysdecl is not a valid declaration of a system of timed processes, or if renamed
+ events collide with events of sysdecl
+ */
+std::tuple<std::shared_ptr<tchecker::parsing::system_declaration_t>, std::shared_ptr<tchecker::parsing::system_declaration_t>,
+           std::shared_ptr<tchecker::parsing::system_declaration_t>>
+split(tchecker::parsing::system_declaration_t const & sysdecl, tchecker::ta::decomposition_t const & decomposition);
+
+} // end of namespace ta
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TA_DECOMPOSITION_HH
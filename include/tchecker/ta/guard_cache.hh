@@ -0,0 +1,95 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_TA_GUARD_CACHE_HH
+#define TCHECKER_TA_GUARD_CACHE_HH
+
+#include <cstddef>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/syncprod/syncprod.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/shared_objects.hh"
+#include "tchecker/variables/clocks.hh"
+#include "tchecker/variables/intvars.hh"
+
+/*!
+ \file guard_cache.hh
+ \brief Cache of truth values of guards on bounded integer variables valuations
+ */
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \class guard_cache_t
+ \brief Direct-mapped cache of the truth values of edge guards w.r.t. valuations of bounded integer variables
+ \note The truth value of the integer part of a guard only depends on the valuation of bounded integer variables.
+ Valuations are shared among states (see tchecker::ts::SHARING), hence entries are keyed by the address of valuations,
+ and each entry keeps a reference on its valuation so that the address cannot be reused while the entry exists.
+ Guards that do not depend on bounded integer variables (see tchecker::ta::system_t::static_guard) are never cached
+ */
+class guard_cache_t {
+public:
+  /*!
+   \brief Constructor
+   \param size : number of entries
+   \post this cache has the largest power of 2 entries that is not greater than size (at least 1)
+   */
+  guard_cache_t(std::size_t size = 1024);
+
+  /*!
+   \brief Truth value of a guard
+   \param system : a system of timed processes
+   \param intval : valuation of bounded integer variables
+   \param id : edge identifier
+   \pre id is an edge in system, and intval is a valuation of the bounded integer variables in system
+   \return false if the guard of edge id does not hold for intval, true otherwise (including when evaluation
+   throws, so that failures are reported by tchecker::ta::next)
+   \post the truth value of the guard of edge id for intval has been cached
+   */
+  bool holds(tchecker::ta::system_t const & system,
+             tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t const> const & intval, tchecker::edge_id_t id);
+
+  /*!
+   \brief Truth value of guards
+   \param system : a system of timed processes
+   \param intval : valuation of bounded integer variables
+   \param edges : tuple of edges
+   \pre see holds(system, intval, id)
+   \return false if the guard of some edge in edges does not hold for intval, true otherwise
+   */
+  bool holds(tchecker::ta::system_t const & system,
+             tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t const> const & intval,
+             tchecker::syncprod::outgoing_edges_value_t const & edges);
+
+  /*!
+   \brief Clear
+   \post this cache is empty, and it does not keep references on valuations anymore
+   */
+  void clear();
+
+private:
+  /*!
+   \brief Cache entry
+   */
+  struct entry_t {
+    tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t const> _intval; /*!< Valuation */
+    tchecker::edge_id_t _edge;                                                   /*!< Edge identifier */
+    bool _holds;                                                                 /*!< Truth value of guard */
+  };
+
+  std::vector<entry_t> _entries;                       /*!< Entries */
+  std::size_t _mask;                                   /*!< Number of entries - 1 */
+  tchecker::clock_constraint_container_t _clkconstr;   /*!< Clock constraints of evaluated guards (discarded) */
+  tchecker::clock_reset_container_t _clkreset;         /*!< Clock resets of evaluated guards (should stay empty) */
+};
+
+} // end of namespace ta
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TA_GUARD_CACHE_HH
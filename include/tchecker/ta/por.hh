@@ -0,0 +1,97 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_TA_POR_HH
+#define TCHECKER_TA_POR_HH
+
+#include <limits>
+
+#include <boost/dynamic_bitset/dynamic_bitset.hpp>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/syncprod/syncprod.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/system.hh"
+
+/*!
+ \file por.hh
+ \brief Partial-order reduction of asynchronous edges
+ */
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \class por_t
+ \brief Persistent sets made of the outgoing edges of a single process
+ \note A location l of process p is reducible if:
+ - l has outgoing edges, all of them asynchronous,
+ - the edges from l, as well as the invariants of l and of the targets of these edges, do not involve clocks,
+ - l and the targets of the edges from l are neither committed nor urgent,
+ - the targets of the edges from l have no outgoing edge on an event that p weakly synchronizes on,
+ - the bounded integer variables in the edges from l are only accessed by process p,
+ - the edges from l do not change the searched labels (i.e. source and target have the same searched labels),
+ - l is not on a cycle of edges between reducible locations of p (this ensures that every cycle of the reduced
+ state-space has a fully expanded state).
+ If the system has no committed location, the edges from a reducible location are independent from the edges of all
+ the other processes, in particular in zone graphs, and they cannot be enabled or disabled by other processes. Hence
+ they form a persistent set of invisible edges: exploring only these edges from a tuple of locations in which some
+ process is in a reducible location (as long as one of them has a successor) preserves the reachability of the
+ searched labels
+ */
+class por_t {
+public:
+  /*!
+   \brief Identifier returned when no process is reducible
+   */
+  static constexpr tchecker::process_id_t NO_REDUCIBLE_PROCESS = std::numeric_limits<tchecker::process_id_t>::max();
+
+  /*!
+   \brief Constructor
+   \param system : a system of timed processes
+   \param labels : searched labels
+   \post this is the partial-order reduction of system w.r.t. labels. No location is reducible if system has a committed
+   location
+   \note the edges from reducible locations are sound for the standard and elapsed zone semantics
+   */
+  por_t(tchecker::ta::system_t const & system, boost::dynamic_bitset<> const & labels);
+
+  /*!
+   \brief Accessor
+   \param id : location identifier
+   \return true if location id is reducible, false otherwise
+   */
+  inline bool reducible(tchecker::loc_id_t id) const { return (id < _reducible.size()) && _reducible[id]; }
+
+  /*!
+   \brief Selection of reducible process
+   \param vloc : tuple of locations
+   \return the smallest process identifier p such that vloc[p] is reducible if any, NO_REDUCIBLE_PROCESS otherwise
+   */
+  tchecker::process_id_t reducible_process(tchecker::vloc_t const & vloc) const;
+
+  /*!
+   \brief Accessor
+   \return number of reducible locations
+   */
+  inline std::size_t reducible_count() const { return _reducible.count(); }
+
+private:
+  boost::dynamic_bitset<> _reducible; /*!< Reducible locations */
+};
+
+/*!
+ \brief Check if a tuple of edges involves a process
+ \param edges : tuple of edges
+ \param pid : process identifier
+ \return true if some edge in edges belongs to process pid, false otherwise
+ */
+bool involves(tchecker::syncprod::outgoing_edges_value_t const & edges, tchecker::process_id_t pid);
+
+} // end of namespace ta
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TA_POR_HH
@@ -0,0 +1,67 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_TA_PRUNING_HH
+#define TCHECKER_TA_PRUNING_HH
+
+#include <cstddef>
+#include <memory>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/system.hh"
+
+/*!
+ \file pruning.hh
+ \brief Removal of the edges that can never be taken (static analysis of bounded integer variables)
+ */
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \brief Number of times the range of a bounded integer variable is extended before it is widened to its domain (the
+ ranges of counters up to this value are computed exactly)
+ */
+std::size_t const PRUNING_WIDENING_DELAY = 64;
+
+/*!
+ \brief Edges and synchronizations that can be taken
+ */
+struct live_edges_t {
+  boost::dynamic_bitset<> edges; /*!< Edges that may be taken (indexed by edge identifier) */
+  boost::dynamic_bitset<> syncs; /*!< Synchronizations that may be taken (indexed by synchronization identifier) */
+};
+
+/*!
+ \brief Interval analysis of bounded integer variables
+ \param system : a system of timed processes
+ \return the edges and synchronizations of system that may be taken from the initial state. The values of the bounded
+ integer variables are over-approximated by one interval for each (flattened) variable, shared by all the locations.
+ An edge is not live if its source location is not reachable, or if its guard, its statement or the invariant of its
+ target location cannot be satisfied by the intervals (assuming the guard). A synchronization is not live if one of
+ its strong constraints has no live edge, and an edge on an event that is not asynchronous is not live if it belongs
+ to no live synchronization
+ \note clocks are ignored. Intervals grow at most tchecker::ta::PRUNING_WIDENING_DELAY times before they are widened to
+ the domain of their variable, and loops in statements are analysed with the same widening
+ */
+tchecker::ta::live_edges_t live_edges(tchecker::ta::system_t const & system);
+
+/*!
+ \brief Removal of the edges that can never be taken
+ \param sysdecl : system declaration
+ \return a system declaration obtained from sysdecl by removing the edges and the synchronizations that are not live
+ (see tchecker::ta::live_edges). The returned declaration has the same reachable states as sysdecl
+ \throw std::invalid_argument : if sysdecl is not a valid declaration of a system of timed processes
+ */
+std::shared_ptr<tchecker::parsing::system_declaration_t>
+prune_dead_edges(tchecker::parsing::system_declaration_t const & sysdecl);
+
+} // end of namespace ta
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TA_PRUNING_HH
@@ -0,0 +1,47 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_TA_SLICING_HH
+#define TCHECKER_TA_SLICING_HH
+
+#include <memory>
+#include <string>
+
+#include "tchecker/parsing/declaration.hh"
+
+/*!
+ \file slicing.hh
+ \brief Cone-of-influence reduction of system declarations
+ */
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \brief Cone-of-influence reduction
+ \param sysdecl : system declaration
+ \param labels : comma-separated list of searched labels
+ \return a system declaration obtained from sysdecl by removing:
+ - the processes that cannot influence the processes with a location labelled by labels (all processes are kept if
+ labels is empty). The processes that synchronize or share variables with a kept process are kept, as well as the
+ processes that could block the others (with a committed or urgent location, an invariant that may not hold, or no
+ initial location)
+ - the events, synchronizations and bounded integer variables that are not used by the kept processes
+ - the clocks that are not accessed by the kept processes, and the clocks that are only reset (possibly to clocks that
+ are only reset), along with their resets
+ The returned declaration has a state with labels reachable iff sysdecl has one
+ \throw std::invalid_argument : if sysdecl is not a valid declaration of a system of timed processes, or if labels
+ contains an unknown label
+ \note resets are only removed from statements made of sequences of assignments. Clocks that are reset within a
+ conditional or a loop are kept
+ */
+std::shared_ptr<tchecker::parsing::system_declaration_t> cone_of_influence(tchecker::parsing::system_declaration_t const & sysdecl,
+                                                                           std::string const & labels);
+
+} // end of namespace ta
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TA_SLICING_HH
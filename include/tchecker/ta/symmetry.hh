@@ -0,0 +1,95 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_TA_SYMMETRY_HH
+#define TCHECKER_TA_SYMMETRY_HH
+
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/variables/intvars.hh"
+
+/*!
+ \file symmetry.hh
+ \brief Symmetry reduction for groups of identical processes
+ */
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \class symmetry_t
+ \brief Groups of symmetric processes, and canonical permutation of states
+ \note Two processes p and q are symmetric if they are identical up to the renaming of their local variables (i.e.
+ the clocks and bounded integer variables that are only accessed by p, resp. by q): the k-th locations of p and q have
+ the same name, attributes, labels and invariant, and p and q have the same edges (between their k-th locations, on
+ the same events, with the same guards and statements), and the set of synchronizations is left unchanged when p and
+ q are swapped. The local variables of p and q are matched in declaration order. Shared variables and events are not
+ renamed.
+ Then, every permutation of the processes in a group (along with their locations and local variables) maps the
+ states reachable in the zone graph to states reachable in the zone graph with the same labels. Hence, a single
+ state can be explored for all the permutations of a state: the one where the processes of each group are sorted
+ w.r.t. their location and the values of their local bounded integer variables
+ */
+class symmetry_t {
+public:
+  /*!
+   \brief Constructor
+   \param system : a system of timed processes
+   \post this is the symmetry of system: groups of at least two symmetric processes
+   */
+  symmetry_t(tchecker::ta::system_t const & system);
+
+  /*!
+   \brief Accessor
+   \return number of groups of symmetric processes
+   */
+  inline std::size_t groups_count() const { return _groups.size(); }
+
+  /*!
+   \brief Accessor
+   \param i : group index
+   \pre i < groups_count() (checked by assertion)
+   \return identifiers of the processes in group i, in increasing order
+   */
+  std::vector<tchecker::process_id_t> processes(std::size_t i) const;
+
+  /*!
+   \brief Canonical permutation
+   \param vloc : tuple of locations
+   \param intval : valuation of bounded integer variables
+   \param clocks : permutation of clocks
+   \pre vloc and intval are a tuple of locations and a valuation of the system this has been built from
+   \post the processes of each group have been permuted in vloc and intval, in such a way that they are sorted w.r.t.
+   their location and the values of their local bounded integer variables (ties keep their relative order). If the
+   returned value is true, clocks has one entry for each flattened clock of the system: clocks[x] is the clock that
+   clock x has been permuted from
+   \return true if vloc and intval have been permuted, false if they are left unchanged (clocks is left unchanged then)
+   */
+  bool canonicalize(tchecker::vloc_t & vloc, tchecker::intval_t & intval, std::vector<tchecker::clock_id_t> & clocks) const;
+
+private:
+  /*!
+   \brief Member of a group of symmetric processes
+   */
+  struct member_t {
+    tchecker::process_id_t _pid;                  /*!< Process identifier */
+    std::vector<tchecker::loc_id_t> _locations;   /*!< Locations of the process, in declaration order */
+    std::vector<tchecker::intvar_id_t> _intvars;  /*!< Flattened local bounded integer variables, in declaration order */
+    std::vector<tchecker::clock_id_t> _clocks;    /*!< Flattened local clocks, in declaration order */
+  };
+
+  std::vector<std::vector<member_t>> _groups; /*!< Groups of symmetric processes */
+  std::vector<std::size_t> _location_index;   /*!< Map : location identifier -> index in its process */
+  std::size_t _clocks_count;                  /*!< Number of flattened clocks */
+};
+
+} // end of namespace ta
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TA_SYMMETRY_HH
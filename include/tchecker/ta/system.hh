@@ -19,6 +19,7 @@
 #include "tchecker/system/attribute.hh"
 #include "tchecker/system/system.hh"
 #include "tchecker/utils/iterator.hh"
+#include "tchecker/vm/native.hh"
 #include "tchecker/vm/vm.hh"
 
 /*!
@@ -59,9 +60,12 @@ public:
   system_t(tchecker::syncprod::system_t const & system);
 
   /*!
-   \brief Copy constructor
+   \brief Copy constructor (deleted)
+   \note systems are large (processes, locations, edges, attributes and bytecode), and they are shared by the
+   transition systems and the algorithms. They should be passed by reference or by shared pointer. An explicit copy
+   can be made with the constructor from tchecker::syncprod::system_t
    */
-  system_t(tchecker::ta::system_t const &);
+  system_t(tchecker::ta::system_t const &) = delete;
 
   /*!
    \brief Move constructor
@@ -74,9 +78,9 @@ public:
   ~system_t() = default;
 
   /*!
-   \brief Assignment operator
+   \brief Assignment operator (deleted)
    */
-  tchecker::ta::system_t & operator=(tchecker::ta::system_t const &);
+  tchecker::ta::system_t & operator=(tchecker::ta::system_t const &) = delete;
 
   /*!
    \brief Move-assignment operator
@@ -132,6 +136,24 @@ public:
    */
   tchecker::bytecode_t const * guard_bytecode(tchecker::edge_id_t id) const;
 
+  /*!
+   \brief Accessor
+   \param id : edge identifier
+   \pre id is an edge identifier (checked by assertion)
+   \return clock constraints of the guard of edge id if it does not depend on bounded integer variables and it
+   is satisfiable by some valuation, nullptr otherwise (in which case, guard_bytecode(id) should be interpreted)
+   */
+  tchecker::clock_constraint_container_t const * static_guard(tchecker::edge_id_t id) const;
+
+  /*!
+   \brief Accessor
+   \param id : edge identifier
+   \pre id is an edge identifier (checked by assertion)
+   \return native code registered for the guard bytecode of edge id (see tchecker::native::register_function),
+   nullptr if there is none (in which case, guard_bytecode(id) should be interpreted)
+   */
+  tchecker::native_function_t native_guard(tchecker::edge_id_t id) const;
+
   /*!
    \brief Accessor
    \param id : edge identifier
@@ -148,6 +170,24 @@ public:
    */
   tchecker::bytecode_t const * statement_bytecode(tchecker::edge_id_t id) const;
 
+  /*!
+   \brief Accessor
+   \param id : edge identifier
+   \pre id is an edge identifier (checked by assertion)
+   \return clock resets of the statement of edge id if it neither reads nor assigns bounded integer variables
+   (e.g. nop or clock resets only), nullptr otherwise (in which case, statement_bytecode(id) should be interpreted)
+   */
+  tchecker::clock_reset_container_t const * static_statement(tchecker::edge_id_t id) const;
+
+  /*!
+   \brief Accessor
+   \param id : edge identifier
+   \pre id is an edge identifier (checked by assertion)
+   \return native code registered for the statement bytecode of edge id (see tchecker::native::register_function),
+   nullptr if there is none (in which case, statement_bytecode(id) should be interpreted)
+   */
+  tchecker::native_function_t native_statement(tchecker::edge_id_t id) const;
+
   // Events
   using tchecker::syncprod::system_t::event_attributes;
   using tchecker::syncprod::system_t::event_id;
@@ -204,6 +244,25 @@ public:
    */
   tchecker::bytecode_t const * invariant_bytecode(tchecker::loc_id_t id) const;
 
+  /*!
+   \brief Accessor
+   \param id : location identifier
+   \pre id is a location identifier (checked by assertion)
+   \return clock constraints of the invariant of location id if it does not depend on bounded integer variables
+   and it is satisfiable by some valuation, nullptr otherwise (in which case, invariant_bytecode(id) should be
+   interpreted)
+   */
+  tchecker::clock_constraint_container_t const * static_invariant(tchecker::loc_id_t id) const;
+
+  /*!
+   \brief Accessor
+   \param id : location identifier
+   \pre id is a location identifier (checked by assertion)
+   \return native code registered for the invariant bytecode of location id (see tchecker::native::register_function),
+   nullptr if there is none (in which case, invariant_bytecode(id) should be interpreted)
+   */
+  tchecker::native_function_t native_invariant(tchecker::loc_id_t id) const;
+
   // Processes
   using tchecker::syncprod::system_t::is_process;
   using tchecker::syncprod::system_t::process_attributes;
@@ -217,7 +276,13 @@ public:
   using tchecker::syncprod::system_t::synchronizations_count;
 
   // Virtual machine
-  inline tchecker::vm_t & vm() const { return _vm; }
+  /*!
+   \brief Accessor
+   \return bytecode interpreter of the calling thread
+   \note the interpreter only holds the state of the current evaluation, hence there is one interpreter per
+   thread, used by all systems. Compiled bytecode is read-only, so a system can be used by several threads
+   */
+  tchecker::vm_t & vm() const;
 
   // Cast
   using tchecker::syncprod::system_t::as_system_system;
@@ -235,6 +300,9 @@ private:
   struct compiled_expression_t {
     std::shared_ptr<tchecker::typed_expression_t> _typed_expr; /*!< Typed expression */
     std::shared_ptr<tchecker::bytecode_t> _compiled_expr;      /*!< Compiled expression */
+    std::shared_ptr<tchecker::clock_constraint_container_t const>
+        _static_clkconstr; /*!< Clock constraints of intval-independent expression (nullptr otherwise) */
+    tchecker::native_function_t _native; /*!< Native code of compiled expression (nullptr if none) */
   };
 
   /*!
@@ -243,25 +311,32 @@ private:
   struct compiled_statement_t {
     std::shared_ptr<tchecker::typed_statement_t> _typed_stmt; /*!< Typed statement */
     std::shared_ptr<tchecker::bytecode_t> _compiled_stmt;     /*!< Compiled statement */
+    std::shared_ptr<tchecker::clock_reset_container_t const>
+        _static_clkreset; /*!< Clock resets of intval-independent statement (nullptr otherwise) */
+    tchecker::native_function_t _native; /*!< Native code of compiled statement (nullptr if none) */
   };
 
   /*!
    \brief Compute data from syncprod::system_t
-   \throw std::invalid_argument : if system has a transition over a weakly synchronized event
+   \post invariants, guards and statements have been compiled. Identical lists of attributes (e.g. the same
+   invariant on many locations) are compiled once and shared, and distinct lists are compiled in parallel when
+   there are many of them. Compiled lists are kept in a process-wide cache, keyed by the declarations of variables
+   and the values of the attributes, and they are reused by later systems with the same declarations
+   \throw std::invalid_argument : if system has a transition over a weakly synchronized event, or if the
+   compilation of an attribute fails
    */
   void compute_from_syncprod_system();
 
   /*!
-   \brief Set location invariant
-   \param id : location identifier
-   \param invariants : range of invariants (as strings)
-   \post all invariants have been parsed, typed, compiled and set as location id invariant
+   \brief Compile a conjunction of expressions
+   \param expressions : range of expressions (as strings), e.g. invariants of a location or guards of an edge
+   \return the conjunction of all expressions in the range, typed and compiled (true if the range is empty)
    \note all compilation errors have been reported to std::cerr
-   \note previous invariant (if any) has been replaced by the new one
-   \throw std::invalid_argument : if compilation of invariants fails
+   \note this is safe to call from several threads
+   \throw std::invalid_argument : if compilation of expressions fails
    */
-  void set_invariant(tchecker::loc_id_t id,
-                     tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> const & invariants);
+  compiled_expression_t
+  compile_conjunction(tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> const & expressions) const;
 
   /*!
    \brief Set location urgent flag
@@ -272,29 +347,16 @@ private:
   void set_urgent(tchecker::loc_id_t id, tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> const & flags);
 
   /*!
-   \brief Set edge guard (provided attribute)
-   \param id : location identifier
-   \param guards : range of guards (as strings)
-   \post all guards have been parsed, typed, compiled and set as edge id guard
-   \note all compilation errors have been reported to std::cerr
-   \note previous guard (if any) has been replaced by the new one
-   \throw std::invalid_argument : if compilation of guards fails
-   */
-  void set_guards(tchecker::edge_id_t id, tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> const & guards);
-
-  /*!
-   \brief Set edge statement (do attribute)
-   \param id : edge identifier
-   \param statements : range of statements (as strings)
-   \post all statements have been parsed, typed, compiled and set as edge id statement
+   \brief Compile a sequence of statements
+   \param statements : range of statements (as strings), e.g. do attributes of an edge
+   \return the sequence of all statements in the range, typed and compiled (nop if the range is empty)
    \note all compilation errors have been reported to std::cerr
-   \note previous statement (if any) has been replaced by the new one
+   \note this is safe to call from several threads
    \throw std::invalid_argument : if compilation of statements fails
    */
-  void set_statements(tchecker::edge_id_t id,
-                      tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> const & statements);
+  compiled_statement_t
+  compile_sequence(tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> const & statements) const;
 
-  mutable tchecker::vm_t _vm;                     /*!< Bytecode interpreter */
   std::vector<compiled_expression_t> _invariants; /*!< Map : location identifier -> invariant */
   std::vector<compiled_expression_t> _guards;     /*!< Map : edge identifier -> guard */
   std::vector<compiled_statement_t> _statements;  /*!< Map : edge identifier -> statement */
@@ -5,7 +5,9 @@
 #ifndef TCHECKER_TA_SYSTEM_HA_HH
 #define TCHECKER_TA_SYSTEM_HA_HH
 
+#include <cassert>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -30,6 +32,14 @@ namespace tchecker {
 
 namespace ta_ha {
 
+/*!
+ \brief Epsilon event predicate
+ \param name : event name
+ \return true if name is the name of an epsilon event (i.e. it starts with '_'), false otherwise
+ \note epsilon events are internal to the environment
+ */
+inline bool is_epsilon_event_name(std::string const & name) { return !name.empty() && name[0] == '_'; }
+
 /*!
  \class system_t
  \brief System of processes for timed automata
@@ -59,9 +69,12 @@ public:
   system_t(tchecker::syncprod::system_t const & system);
 
   /*!
-   \brief Copy constructor
+   \brief Copy constructor (deleted)
+   \note systems are large (processes, locations, edges, attributes and bytecode), and they are shared by the
+   transition systems and the algorithms. They should be passed by reference or by shared pointer. An explicit copy
+   can be made with the constructor from tchecker::syncprod::system_t
    */
-  system_t(tchecker::ta_ha::system_t const &);
+  system_t(tchecker::ta_ha::system_t const &) = delete;
 
   /*!
    \brief Move constructor
@@ -74,9 +87,9 @@ public:
   ~system_t() = default;
 
   /*!
-   \brief Assignment operator
+   \brief Assignment operator (deleted)
    */
-  tchecker::ta_ha::system_t & operator=(tchecker::ta_ha::system_t const &);
+  tchecker::ta_ha::system_t & operator=(tchecker::ta_ha::system_t const &) = delete;
 
   /*!
    \brief Move-assignment operator
@@ -130,7 +143,7 @@ public:
    \pre id is an edge identifier (checked by assertion)
    \return guard bytecode for edge id
    */
-  tchecker::vm_ha::bytecode_t const * guard_bytecode(tchecker::edge_id_t id) const;
+  tchecker::bytecode_t const * guard_bytecode(tchecker::edge_id_t id) const;
 
   /*!
    \brief Accessor
@@ -146,7 +159,7 @@ public:
    \pre id is an edge identifier (checked by assertion)
    \return statement bytecode for edge id
    */
-  tchecker::vm_ha::bytecode_t const * statement_bytecode(tchecker::edge_id_t id) const;
+  tchecker::bytecode_t const * statement_bytecode(tchecker::edge_id_t id) const;
 
   // Events
   using tchecker::syncprod::system_t::event_attributes;
@@ -155,6 +168,53 @@ public:
   using tchecker::syncprod::system_t::events_count;
   using tchecker::syncprod::system_t::is_event;
 
+  /*!
+   \brief Accessor
+   \param id : event identifier
+   \pre id is an event identifier (checked by assertion)
+   \return true if event id is an epsilon event, false otherwise
+   \see tchecker::ta_ha::is_epsilon_event_name
+   */
+  inline bool is_epsilon_event(tchecker::event_id_t id) const
+  {
+    assert(is_event(id));
+    return _epsilon_events[id];
+  }
+
+  /*!
+   \brief Accessor
+   \param id : edge identifier
+   \pre id is an edge identifier (checked by assertion)
+   \return true if edge id is labelled by an epsilon event, false otherwise
+   */
+  inline bool is_epsilon_edge(tchecker::edge_id_t id) const
+  {
+    assert(is_edge(id));
+    return _epsilon_edges[id];
+  }
+
+  /*!
+   \brief Accessor
+   \param id : event identifier
+   \pre id is an event identifier (checked by assertion)
+   \return sorted identifiers of the flattened bounded integer variables written by the statement of some
+   edge labelled by event id
+   \note computed from the typed statements when this system is built
+   */
+  inline std::vector<tchecker::intvar_id_t> const & written_intvars(tchecker::event_id_t id) const
+  {
+    assert(is_event(id));
+    return _written_intvars[id];
+  }
+
+  /*!
+   \brief Accessor
+   \return flattened bounded integer variables that may be read by the guard of some edge
+   \note computed from the typed guards when this system is built (array cells with a non-constant offset are all
+   considered read)
+   */
+  inline boost::dynamic_bitset<> const & guarded_intvars() const { return _guarded_intvars; }
+
   // Bounded integer variables
   using tchecker::syncprod::system_t::integer_variables;
   using tchecker::syncprod::system_t::intvar_attributes;
@@ -202,7 +262,7 @@ public:
    \pre id is a location identifier (checked by assertion)
    \return invariant bytecode for location id
    */
-  tchecker::vm_ha::bytecode_t const * invariant_bytecode(tchecker::loc_id_t id) const;
+  tchecker::bytecode_t const * invariant_bytecode(tchecker::loc_id_t id) const;
 
   // Processes
   using tchecker::syncprod::system_t::is_process;
@@ -217,7 +277,13 @@ public:
   using tchecker::syncprod::system_t::synchronizations_count;
 
   // Virtual machine
-  inline tchecker::vm_ha::vm_t & vm() const { return _vm; }
+  /*!
+   \brief Accessor
+   \return bytecode interpreter of the calling thread
+   \note the interpreter only holds the state of the current evaluation, hence there is one interpreter per
+   thread, used by all systems. Compiled bytecode is read-only, so a system can be used by several threads
+   */
+  tchecker::vm_ha::vm_t & vm() const;
 
   // Cast
   using tchecker::syncprod::system_t::as_system_system;
@@ -234,7 +300,7 @@ private:
    */
   struct compiled_expression_t {
     std::shared_ptr<tchecker::typed_expression_t> _typed_expr; /*!< Typed expression */
-    std::shared_ptr<tchecker::vm_ha::bytecode_t> _compiled_expr;      /*!< Compiled expression */
+    std::shared_ptr<tchecker::bytecode_t> _compiled_expr;      /*!< Compiled expression */
   };
 
   /*!
@@ -242,7 +308,7 @@ private:
    */
   struct compiled_statement_t {
     std::shared_ptr<tchecker::typed_statement_t> _typed_stmt; /*!< Typed statement */
-    std::shared_ptr<tchecker::vm_ha::bytecode_t> _compiled_stmt;     /*!< Compiled statement */
+    std::shared_ptr<tchecker::bytecode_t> _compiled_stmt;     /*!< Compiled statement */
   };
 
   /*!
@@ -251,6 +317,20 @@ private:
    */
   void compute_from_syncprod_system();
 
+  /*!
+   \brief Compute the bounded integer variables written on each event
+   \pre compute_from_syncprod_system() has set the statements
+   \post _written_intvars maps every event to the flattened integer variables written by its edges
+   */
+  void compute_written_intvars();
+
+  /*!
+   \brief Compute the bounded integer variables read by guards
+   \pre compute_from_syncprod_system() has set the guards
+   \post _guarded_intvars has the flattened integer variables that may be read by the guard of some edge
+   */
+  void compute_guarded_intvars();
+
   /*!
    \brief Set location invariant
    \param id : location identifier
@@ -294,11 +374,14 @@ private:
   void set_statements(tchecker::edge_id_t id,
                       tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> const & statements);
 
-  mutable tchecker::vm_ha::vm_t _vm;                     /*!< Bytecode interpreter */
   std::vector<compiled_expression_t> _invariants; /*!< Map : location identifier -> invariant */
   std::vector<compiled_expression_t> _guards;     /*!< Map : edge identifier -> guard */
   std::vector<compiled_statement_t> _statements;  /*!< Map : edge identifier -> statement */
   boost::dynamic_bitset<> _urgent;                /*!< Urgent locations */
+  boost::dynamic_bitset<> _epsilon_events;        /*!< Epsilon events */
+  boost::dynamic_bitset<> _epsilon_edges;         /*!< Edges labelled by an epsilon event */
+  std::vector<std::vector<tchecker::intvar_id_t>> _written_intvars; /*!< Map : event identifier -> written intvars */
+  boost::dynamic_bitset<> _guarded_intvars;                         /*!< Integer variables read by guards */
 };
 
 } // end of namespace ta_ha
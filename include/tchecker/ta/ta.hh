@@ -368,6 +368,17 @@ inline tchecker::state_status_t prev(tchecker::ta::system_t const & system, tche
 
 // Tools
 
+/*!
+ \brief Checks if a tuple of edges leaves bounded integer variables unchanged
+ \param system : a system of timed processes
+ \param edges : tuple of edges
+ \return true if no statement in edges reads or assigns bounded integer variables (see
+ tchecker::ta::system_t::static_statement), false otherwise
+ \note next() does not modify the valuation of bounded integer variables along such edges, hence successor states can
+ share the valuation of their source state instead of copying it
+ */
+bool static_statements(tchecker::ta::system_t const & system, tchecker::ta::outgoing_edges_value_t const & edges);
+
 /*!
  \brief Checks if time can elapse in a tuple of locations
  \param system : a system of timed processes
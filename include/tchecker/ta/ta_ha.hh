@@ -252,9 +252,9 @@ tchecker::state_status_t next(tchecker::ta_ha::system_t const & system,
                               tchecker::intrusive_shared_ptr_t<tchecker::shared_vedge_t> const & vedge,
                               tchecker::clock_constraint_container_t & src_invariant,
                               tchecker::clock_constraint_container_t & guard,
-                              std::vector<unsigned> & intvarconstr,
+                              tchecker::intvar_guard_container_t & intvarconstr,
                               tchecker::clock_reset_container_t & reset,
-                              std::vector<std::pair<tchecker::variable_id_t, tchecker::variable_id_t>> & intvar_set,
+                              tchecker::intvar_set_container_t & intvar_set,
                               tchecker::clock_constraint_container_t & tgt_invariant,
                               tchecker::ta_ha::outgoing_edges_value_t const & edges);
 
@@ -349,9 +349,9 @@ tchecker::state_status_t prev(tchecker::ta_ha::system_t const & system,
                               tchecker::intrusive_shared_ptr_t<tchecker::shared_vedge_t> const & vedge,
                               tchecker::clock_constraint_container_t & src_invariant,
                               tchecker::clock_constraint_container_t & guard,
-                              std::vector<unsigned> & intvarconstr,
+                              tchecker::intvar_guard_container_t & intvarconstr,
                               tchecker::clock_reset_container_t & reset,
-                              std::vector<std::pair<tchecker::variable_id_t, tchecker::variable_id_t>> & intvar_set,
+                              tchecker::intvar_set_container_t & intvar_set,
                               tchecker::clock_constraint_container_t & tgt_invariant,
                               tchecker::ta_ha::incoming_edges_value_t const & v);
 
@@ -82,26 +82,26 @@ public:
    \brief Accessor
    \return this transition's target invariant container
    */
-  inline std::vector<std::pair<tchecker::variable_id_t, tchecker::variable_id_t>> & intvar_set_container() { return _intvar_set; }
+  inline tchecker::intvar_set_container_t & intvar_set_container() { return _intvar_set; }
 
   /*!
   \brief Accessor
   \return this transition's target invariant container
   */
-  inline std::vector<std::pair<tchecker::variable_id_t, tchecker::variable_id_t>> const & intvar_set_container() const { return _intvar_set; }
+  inline tchecker::intvar_set_container_t const & intvar_set_container() const { return _intvar_set; }
 
   /*!
    \brief Accessor
    \return this transition's int var guard container
    */
-  inline std::vector<unsigned> & intvar_guard_container() { return _intvar_guard; }
+  inline tchecker::intvar_guard_container_t & intvar_guard_container() { return _intvar_guard; }
 
 
   /*!
   \brief Accessor
   \return this transition's int var guard container
   */
-  inline std::vector<unsigned> const & intvar_guard_container() const { return _intvar_guard; }
+  inline tchecker::intvar_guard_container_t const & intvar_guard_container() const { return _intvar_guard; }
 
 
   // Range accessors
@@ -134,21 +134,21 @@ public:
    \brief Accessor
    \return this transition's integer variables set contiainer
    */
-  tchecker::range_t<std::vector<std::pair<tchecker::variable_id_t, tchecker::variable_id_t>>::const_iterator> intvar_set() const;
+  tchecker::range_t<tchecker::intvar_set_container_t::const_iterator> intvar_set() const;
 
   /*!
    \brief Accessor
    \return this transition's integer variables guard contiainer
    */
-  tchecker::range_t<std::vector<unsigned>::const_iterator> intvar_guard() const;
+  tchecker::range_t<tchecker::intvar_guard_container_t::const_iterator> intvar_guard() const;
 
 
 protected:
   tchecker::clock_constraint_container_t _src_invariant; /*!< Source invariant */
   tchecker::clock_constraint_container_t _guard;         /*!< Guard */
   tchecker::clock_reset_container_t _reset;              /*!< Reset */
-  std::vector<std::pair<tchecker::variable_id_t, tchecker::variable_id_t>> _intvar_set;              /*!< Integer Variable Set */
-  std::vector<unsigned> _intvar_guard;                   /*!< Integer Variable Set */
+  tchecker::intvar_set_container_t _intvar_set;         /*!< Integer Variable Set */
+  tchecker::intvar_guard_container_t _intvar_guard;     /*!< Integer Variable Set */
   tchecker::clock_constraint_container_t _tgt_invariant; /*!< Target invariant */
 
 };
@@ -5,8 +5,10 @@
 #ifndef TCHECKER_TS_FWD_HH
 #define TCHECKER_TS_FWD_HH
 
+#include <cstddef>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
@@ -271,6 +273,65 @@ void next(FWD_IMPL & fwd_impl, typename FWD_IMPL::const_state_t const & s, std::
     fwd_impl.next(s, out_edge, v, mask);
 }
 
+/*!
+ \class successors_t
+ \brief Lazy computation of next states and transitions with selected status
+ \tparam FWD_IMPL : type of low-level forward transition system (should derive
+ from tchecker::ts::fwd_impl_t<...>)
+ \note successors are computed along one outgoing edge at a time, when they are pulled by next(sst). Hence a
+ search that stops at some successor does not compute the successors along the remaining edges. This is a lazy
+ alternative to tchecker::ts::next()
+ */
+template <class FWD_IMPL> class successors_t {
+public:
+  /*!
+   \brief Type of tuples (status, state, transition)
+   */
+  using sst_t = typename FWD_IMPL::sst_t;
+
+  /*!
+   \brief Constructor
+   \param fwd_impl : low-level forward transition system
+   \param s : state
+   \param mask : mask on next states
+   \note this keeps a reference on fwd_impl and a copy of s
+   */
+  successors_t(FWD_IMPL & fwd_impl, typename FWD_IMPL::const_state_t const & s, tchecker::state_status_t mask)
+      : _fwd_impl(fwd_impl), _s(s), _mask(mask), _edges(fwd_impl.outgoing_edges(s)), _it(_edges.begin())
+  {
+  }
+
+  /*!
+   \brief Next successor
+   \param sst : a tuple (status, state, transition)
+   \post sst has been set to the next tuple (status, s', t) such that s -t-> s' is a transition and the status of s'
+   matches mask (i.e. status & mask != 0), if any
+   \return true if sst has been set, false if all the successors of s have been pulled
+   */
+  bool next(sst_t & sst)
+  {
+    while (_pos == _buffer.size()) {
+      _buffer.clear();
+      _pos = 0;
+      if (_it == _edges.end())
+        return false;
+      _fwd_impl.next(_s, *_it, _buffer, _mask);
+      ++_it;
+    }
+    sst = std::move(_buffer[_pos++]);
+    return true;
+  }
+
+private:
+  FWD_IMPL & _fwd_impl;                                            /*!< Low-level forward transition system */
+  typename FWD_IMPL::const_state_t _s;                             /*!< Source state */
+  tchecker::state_status_t _mask;                                  /*!< Mask on next states */
+  typename FWD_IMPL::outgoing_edges_range_t _edges;                /*!< Outgoing edges of _s */
+  typename FWD_IMPL::outgoing_edges_range_t::begin_iterator_t _it; /*!< Next outgoing edge */
+  std::vector<sst_t> _buffer;                                      /*!< Successors along the last outgoing edge */
+  std::size_t _pos{0};                                             /*!< Next successor in _buffer */
+};
+
 } // end of namespace ts
 
 } // end of namespace tchecker
@@ -0,0 +1,75 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_TS_STATIC_HH
+#define TCHECKER_TS_STATIC_HH
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*!
+ \file static.hh
+ \brief Static interface of transition systems for exploration algorithms
+ \note transition systems implement the virtual interfaces tchecker::ts::fwd_t and tchecker::ts::inspector_t, and
+ the exploration algorithms are templates over the concrete type of transition system. When this type is final, the
+ calls of the algorithms to initial(), next(), labels() and is_valid_final() are resolved statically (no virtual
+ dispatch), and so are the calls of tchecker::ts::initial() and tchecker::ts::next() to the ranges of edges and the
+ successor computations of the transition system, which can then be inlined
+ */
+
+namespace tchecker {
+
+namespace ts {
+
+namespace details {
+
+/*!
+ \class has_static_interface_t
+ \brief Detection of the methods called by the exploration algorithms
+ \tparam TS : type of transition system
+ */
+template <class TS, class = void> struct has_static_interface_t : std::false_type {
+};
+
+/*!
+ \class has_static_interface_t
+ \brief Detection of the methods called by the exploration algorithms (specialization for transition systems that
+ have methods initial(v), next(s, v), labels(s) and is_valid_final(s))
+ \tparam TS : type of transition system
+ */
+template <class TS>
+struct has_static_interface_t<
+    TS, std::void_t<typename TS::sst_t, typename TS::const_state_t,
+                    decltype(std::declval<TS &>().initial(std::declval<std::vector<typename TS::sst_t> &>())),
+                    decltype(std::declval<TS &>().next(std::declval<typename TS::const_state_t const &>(),
+                                                       std::declval<std::vector<typename TS::sst_t> &>())),
+                    decltype(std::declval<TS &>().labels(std::declval<typename TS::const_state_t const &>())),
+                    decltype(std::declval<TS &>().is_valid_final(std::declval<typename TS::const_state_t const &>()))>>
+    : std::true_type {
+};
+
+} // end of namespace details
+
+/*!
+ \class is_static_t
+ \brief Check that a transition system can be explored without virtual dispatch
+ \tparam TS : type of transition system
+ \note value is true if TS is a final class with methods initial(v), next(s, v), labels(s) and is_valid_final(s),
+ false otherwise
+ */
+template <class TS>
+struct is_static_t : std::integral_constant<bool, std::is_final<TS>::value && details::has_static_interface_t<TS>::value> {
+};
+
+/*!
+ \brief Shortcut to tchecker::ts::is_static_t<TS>::value
+ */
+template <class TS> inline constexpr bool is_static_v = tchecker::ts::is_static_t<TS>::value;
+
+} // end of namespace ts
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TS_STATIC_HH
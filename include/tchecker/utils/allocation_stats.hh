@@ -0,0 +1,59 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ALLOCATION_STATS_HH
+#define TCHECKER_ALLOCATION_STATS_HH
+
+#include <cstdint>
+
+/*!
+ \file allocation_stats.hh
+ \brief Counters of dynamic memory allocations
+ \note Allocations are counted when TChecker is built with TCHECKER_ALLOCATION_STATS (CMake option
+ TCHECKER_ALLOCATION_STATS), which replaces the global operators new and delete by counting ones. Allocations that
+ do not go through operator new (direct calls to malloc from C code) are not counted
+ */
+
+namespace tchecker {
+
+namespace allocation_stats {
+
+/*!
+ \class counters_t
+ \brief Counters of allocations
+ */
+struct counters_t {
+  std::uint64_t allocations{0};     /*!< Number of calls to operator new */
+  std::uint64_t deallocations{0};   /*!< Number of calls to operator delete (on non-null pointers) */
+  std::uint64_t allocated_bytes{0}; /*!< Number of bytes requested from operator new */
+};
+
+/*!
+ \brief Difference of counters
+ \param c1 : counters
+ \param c2 : counters
+ \pre c2 has been read before c1
+ \return counters of the allocations between c2 and c1
+ */
+tchecker::allocation_stats::counters_t operator-(tchecker::allocation_stats::counters_t const & c1,
+                                                 tchecker::allocation_stats::counters_t const & c2);
+
+/*!
+ \brief Accessor
+ \return true if allocations are counted, false otherwise
+ */
+bool enabled();
+
+/*!
+ \brief Accessor
+ \return counters of the allocations since the start of the process (summed over all threads), all zero if
+ allocations are not counted
+ */
+tchecker::allocation_stats::counters_t counters();
+
+} // end of namespace allocation_stats
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALLOCATION_STATS_HH
@@ -5,7 +5,9 @@
 #ifndef TCHECKER_ARRAY_HH
 #define TCHECKER_ARRAY_HH
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <tuple>
@@ -451,11 +453,49 @@ protected:
   constexpr T const * end_ptr() const { return ptr() + BASE::_capacity; }
 };
 
+namespace details {
+
+/*!
+ \brief Whether arrays of T can be compared and hashed as sequences of bytes
+ \tparam T : type of array elements
+ \note true if T is trivially copyable and its objects have unique representations (no padding, no floating point),
+ which is the case of tchecker::loc_id_t and tchecker::integer_t
+ */
+template <class T>
+inline constexpr bool is_bytewise_v = std::is_trivially_copyable<T>::value && std::has_unique_object_representations<T>::value;
+
+/*!
+ \brief Length of the longest common prefix of two arrays of elements
+ \tparam T : type of elements
+ \param p1 : first array
+ \param p2 : second array
+ \param n : number of elements of p1 and p2
+ \return the smallest index i < n such that p1[i] != p2[i], n if there is no such i
+ \note the common prefix is skipped by blocks using std::memcmp, which is vectorized
+ */
+template <class T> std::size_t common_prefix_size(T const * p1, T const * p2, std::size_t n)
+{
+  static_assert(tchecker::details::is_bytewise_v<T>, "T should be comparable as a sequence of bytes");
+  constexpr std::size_t block_size = (64 / sizeof(T) > 0 ? 64 / sizeof(T) : 1);
+  std::size_t i = 0;
+  for (; i + block_size <= n; i += block_size)
+    if (std::memcmp(p1 + i, p2 + i, block_size * sizeof(T)) != 0)
+      break;
+  for (; i < n; ++i)
+    if (p1[i] != p2[i])
+      break;
+  return i;
+}
+
+} // end of namespace details
+
 /*!
  \brief Equality check
  \param a1 : array
  \param a2 : array
  \return true if a1 and a2 have equal BASE and equal elements, false otherwise
+ \note elements are compared with std::memcmp when T is comparable as a sequence of bytes (see
+ tchecker::details::is_bytewise_v)
  */
 template <class T, std::size_t T_ALLOCSIZE, class BASE>
 bool operator==(tchecker::make_array_t<T, T_ALLOCSIZE, BASE> const & a1,
@@ -463,12 +503,18 @@ bool operator==(tchecker::make_array_t<T, T_ALLOCSIZE, BASE> const & a1,
 {
   if (static_cast<BASE const &>(a1) != static_cast<BASE const &>(a2))
     return false;
-  auto it1 = a1.begin(), end1 = a1.end();
-  auto it2 = a2.begin(), end2 = a2.end();
-  for (; it1 != end1 && it2 != end2; ++it1, ++it2)
-    if (*it1 != *it2)
-      return false;
-  return true;
+  if constexpr (tchecker::details::is_bytewise_v<T>) {
+    std::size_t const size = std::min(a1.end() - a1.begin(), a2.end() - a2.begin());
+    return (size == 0) || (std::memcmp(a1.begin(), a2.begin(), size * sizeof(T)) == 0);
+  }
+  else {
+    auto it1 = a1.begin(), end1 = a1.end();
+    auto it2 = a2.begin(), end2 = a2.end();
+    for (; it1 != end1 && it2 != end2; ++it1, ++it2)
+      if (*it1 != *it2)
+        return false;
+    return true;
+  }
 }
 
 /*!
@@ -484,16 +530,60 @@ bool operator!=(tchecker::make_array_t<T, T_ALLOCSIZE, BASE> const & a1,
   return (!(a1 == a2));
 }
 
+/*!
+ \brief Lexical ordering on elements
+ \param a1 : array
+ \param a2 : array
+ \return 0 if a1 and a2 have equal elements, a negative value if the elements of a1 are smaller than the elements of a2
+ w.r.t. lexical ordering (with operator <), and a positive value otherwise
+ \note BASE is not compared. The common prefix of a1 and a2 is skipped by blocks using std::memcmp when T is comparable
+ as a sequence of bytes (see tchecker::details::is_bytewise_v)
+ */
+template <class T, std::size_t T_ALLOCSIZE, class BASE>
+int lexical_cmp(tchecker::make_array_t<T, T_ALLOCSIZE, BASE> const & a1,
+                tchecker::make_array_t<T, T_ALLOCSIZE, BASE> const & a2)
+{
+  std::size_t const size1 = a1.end() - a1.begin(), size2 = a2.end() - a2.begin();
+  std::size_t const size = std::min(size1, size2);
+  std::size_t i = 0;
+  if constexpr (tchecker::details::is_bytewise_v<T>)
+    i = tchecker::details::common_prefix_size(a1.begin(), a2.begin(), size);
+  else
+    while (i < size && !(a1.begin()[i] < a2.begin()[i]) && !(a2.begin()[i] < a1.begin()[i]))
+      ++i;
+  if (i < size)
+    return (a1.begin()[i] < a2.begin()[i] ? -1 : 1);
+  return (size1 == size2 ? 0 : (size1 < size2 ? -1 : 1));
+}
+
 /*!
  \brief Hash
  \param a : array
  \return hash value for array a
+ \note when T is comparable as a sequence of bytes (see tchecker::details::is_bytewise_v), the elements are hashed
+ by 64-bit words rather than one by one
  */
 template <class T, std::size_t T_ALLOCSIZE, class BASE>
 std::size_t hash_value(tchecker::make_array_t<T, T_ALLOCSIZE, BASE> const & a)
 {
   std::size_t h = hash_value(static_cast<BASE>(a));
-  boost::hash_range(h, a.begin(), a.end());
+  if constexpr (tchecker::details::is_bytewise_v<T> && sizeof(T) < sizeof(std::uint64_t)) {
+    char const * p = reinterpret_cast<char const *>(a.begin());
+    std::size_t const size = (a.end() - a.begin()) * sizeof(T);
+    std::size_t i = 0;
+    for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+      std::uint64_t w;
+      std::memcpy(&w, p + i, sizeof(w));
+      boost::hash_combine(h, w);
+    }
+    if (i < size) {
+      std::uint64_t w = 0;
+      std::memcpy(&w, p + i, size - i);
+      boost::hash_combine(h, w);
+    }
+  }
+  else
+    boost::hash_range(h, a.begin(), a.end());
   return h;
 }
 
@@ -0,0 +1,164 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ASYNC_OUTPUT_HH
+#define TCHECKER_ASYNC_OUTPUT_HH
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+/*!
+ \file async_output.hh
+ \brief Buffered output written by a background thread
+ */
+
+namespace tchecker {
+
+/*!
+ \class async_streambuf_t
+ \brief Stream buffer that stores output in large chunks, and hands full chunks to a background thread that
+ writes them to an output stream
+ \note flushes (e.g. std::endl) do not force a write: data is written when a chunk is full, and when the buffer is
+ closed. The number of chunks waiting to be written is bounded, hence a producer that is faster than the output
+ waits for the writer
+ */
+class async_streambuf_t : public std::streambuf {
+public:
+  /*!
+   \brief Default size of chunks in bytes
+   */
+  static constexpr std::size_t const DEFAULT_CHUNK_SIZE = 1 << 20;
+
+  /*!
+   \brief Default maximal number of chunks waiting to be written
+   */
+  static constexpr std::size_t const DEFAULT_PENDING_CHUNKS = 8;
+
+  /*!
+   \brief Constructor
+   \param os : output stream
+   \param chunk_size : size of chunks in bytes
+   \param pending_chunks : maximal number of chunks waiting to be written
+   \post the writer thread has been started
+   \throw std::invalid_argument : if chunk_size or pending_chunks is 0
+   \note os must not be used by others until this buffer is closed
+   */
+  async_streambuf_t(std::ostream & os, std::size_t chunk_size = DEFAULT_CHUNK_SIZE,
+                    std::size_t pending_chunks = DEFAULT_PENDING_CHUNKS);
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  async_streambuf_t(tchecker::async_streambuf_t const &) = delete;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::async_streambuf_t & operator=(tchecker::async_streambuf_t const &) = delete;
+
+  /*!
+   \brief Destructor
+   \post this buffer has been closed (errors are ignored, see close())
+   */
+  ~async_streambuf_t();
+
+  /*!
+   \brief Close
+   \post all data has been written to the output stream which has been flushed, and the writer thread has
+   stopped. Calling close() again has no effect
+   \throw std::runtime_error : if writing to the output stream failed
+   */
+  void close();
+
+protected:
+  /*!
+   \brief Handle a full chunk
+   \param c : character
+   \post the current chunk has been handed to the writer thread, and c has been stored in a new chunk
+   \return c (not eof) on success, eof if this buffer is closed
+   */
+  virtual int_type overflow(int_type c) override;
+
+  /*!
+   \brief Write a sequence of characters
+   \param s : characters
+   \param n : number of characters
+   \post the n characters from s have been stored, handing full chunks to the writer thread
+   \return the number of stored characters
+   */
+  virtual std::streamsize xsputn(char const * s, std::streamsize n) override;
+
+  /*!
+   \brief Synchronize
+   \return 0
+   \note data is not written before the current chunk is full (see class documentation)
+   */
+  virtual int sync() override;
+
+private:
+  /*!
+   \brief Hand the current chunk to the writer thread
+   \post the current chunk has been queued if not empty (after waiting for room in the queue), and a new
+   current chunk has been set up
+   */
+  void hand_over();
+
+  /*!
+   \brief Writer thread
+   \post the queued chunks have been written to the output stream until this buffer is closed
+   */
+  void write_chunks();
+
+  std::ostream & _os;                    /*!< Output stream */
+  std::size_t _chunk_size;               /*!< Size of chunks */
+  std::size_t _pending_chunks;           /*!< Maximal number of queued chunks */
+  std::vector<char> _chunk;              /*!< Current chunk */
+  std::deque<std::vector<char>> _queue;  /*!< Chunks waiting to be written */
+  std::mutex _mutex;                     /*!< Mutex on _queue, _closing and _failed */
+  std::condition_variable _cv_not_empty; /*!< Signaled when a chunk is queued or when closing */
+  std::condition_variable _cv_not_full;  /*!< Signaled when a chunk is dequeued */
+  bool _closing;                         /*!< Closing flag */
+  bool _closed;                          /*!< Closed flag */
+  bool _failed;                          /*!< Write error flag */
+  std::thread _writer;                   /*!< Writer thread */
+};
+
+/*!
+ \class async_ostream_t
+ \brief Output stream whose output is written to another stream by a background thread
+ (see tchecker::async_streambuf_t)
+ */
+class async_ostream_t : public std::ostream {
+public:
+  /*!
+   \brief Constructor
+   \param os : output stream
+   \param chunk_size : size of chunks in bytes
+   \param pending_chunks : maximal number of chunks waiting to be written
+   \throw std::invalid_argument : if chunk_size or pending_chunks is 0
+   \note os must not be used by others until this stream is closed
+   */
+  async_ostream_t(std::ostream & os, std::size_t chunk_size = tchecker::async_streambuf_t::DEFAULT_CHUNK_SIZE,
+                  std::size_t pending_chunks = tchecker::async_streambuf_t::DEFAULT_PENDING_CHUNKS);
+
+  /*!
+   \brief Close
+   \post all data has been written to the output stream (see tchecker::async_streambuf_t::close)
+   \throw std::runtime_error : if writing to the output stream failed
+   */
+  void close();
+
+private:
+  tchecker::async_streambuf_t _buf; /*!< Stream buffer */
+};
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ASYNC_OUTPUT_HH
@@ -0,0 +1,105 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_UTILS_BITSTATE_HH
+#define TCHECKER_UTILS_BITSTATE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*!
+ \file bitstate.hh
+ \brief Bitstate tables (probabilistic sets of hash values)
+ */
+
+namespace tchecker {
+
+/*!
+ \class bitstate_table_t
+ \brief Holzmann-style bitstate table: a set of hash values is represented by an array of bits, where each
+ hash value sets a fixed number of bits. A value is reported as a member when all its bits are set, hence
+ a new value may be mistaken for a member (hash collision), but a member is never reported as new
+ */
+class bitstate_table_t {
+public:
+  /*!
+   \brief Constructor
+   \param size : size of the table in bytes
+   \param hashes : number of bits set by each value
+   \post this table is empty, and its number of bits is the largest power of 2 that fits in size bytes
+   (at least 64)
+   \throw std::invalid_argument : if size is 0, or if hashes is 0
+   */
+  bitstate_table_t(std::size_t size, unsigned int hashes = 3);
+
+  /*!
+   \brief Insert a hash value
+   \param h : a hash value
+   \post all the bits of h are set
+   \return true if h was not in this table (at least one of its bits was unset), false otherwise
+   */
+  bool insert(std::size_t h);
+
+  /*!
+   \brief Membership
+   \param h : a hash value
+   \return true if all the bits of h are set, false otherwise
+   */
+  bool contains(std::size_t h) const;
+
+  /*!
+   \brief Clear
+   \post this table is empty
+   */
+  void clear();
+
+  /*!
+   \brief Accessor
+   \return number of bits in this table
+   */
+  inline std::size_t bits() const { return _mask + 1; }
+
+  /*!
+   \brief Accessor
+   \return number of bits set by each value
+   */
+  inline unsigned int hashes() const { return _hashes; }
+
+  /*!
+   \brief Accessor
+   \return number of bits set in this table
+   */
+  inline std::size_t set_bits() const { return _set_bits; }
+
+  /*!
+   \brief Accessor
+   \return probability that a value which is not in this table is reported as a member, i.e.
+   (set_bits() / bits())^hashes()
+   */
+  double collision_probability() const;
+
+  /*!
+   \brief Accessor
+   \return size of this table in bytes
+   */
+  std::size_t memsize() const;
+
+private:
+  /*!
+   \brief Mix hash value
+   \param h : a hash value
+   \return a 64-bit mix of h (splitmix64 finalizer), so that weak hash functions spread over the table
+   */
+  static std::uint64_t mix(std::uint64_t h);
+
+  std::vector<std::uint64_t> _table; /*!< Bits */
+  std::size_t _mask;                 /*!< Number of bits - 1 */
+  unsigned int _hashes;              /*!< Number of bits per value */
+  std::size_t _set_bits;             /*!< Number of bits set */
+};
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_UTILS_BITSTATE_HH
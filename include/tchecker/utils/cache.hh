@@ -10,7 +10,9 @@
  \brief Cache of shared objects
  */
 
+#include <chrono>
 #include <limits>
+#include <tuple>
 #include <vector>
 
 #include "tchecker/utils/hashtable.hh"
@@ -78,6 +80,38 @@ public:
    */
   inline SPTR find_else_add(SPTR const & o) { return _hashtable.find_else_add(o); }
 
+  /*!
+   \brief Object caching with a precomputed hash code
+   \param o : object
+   \param h : hash code of o
+   \pre h is the hash code of o w.r.t. HASH
+   \return same as find_else_add(o)
+   \post same as find_else_add(o)
+   */
+  inline SPTR find_else_add(SPTR const & o, std::size_t h) { return _hashtable.find_else_add(o, h); }
+
+  /*!
+   \brief Batched object caching with precomputed hash codes
+   \param objects : objects
+   \param hashes : hash codes of objects
+   \pre hashes[i] is the hash code of objects[i] w.r.t. HASH for every i
+   \post objects[i] has been replaced by find_else_add(objects[i], hashes[i]) for every i in increasing order
+   \throw std::invalid_argument : if objects and hashes do not have the same size
+   \note lookups are software pipelined (see tchecker::hashtable_t::find_else_add)
+   */
+  inline void find_else_add(std::vector<SPTR> & objects, std::vector<std::size_t> const & hashes)
+  {
+    _hashtable.find_else_add(objects, hashes);
+  }
+
+  /*!
+   \brief Prefetch
+   \param h : hash code
+   \post the slot where objects with hash code h are cached is being loaded in the cache of the processor (see
+   tchecker::hashtable_t::prefetch)
+   */
+  inline void prefetch(std::size_t h) const { _hashtable.prefetch(h); }
+
   /*!
    \brief Membership predicate
    \param o : object
@@ -206,11 +240,203 @@ public:
     return 0;
   }
 
+  /*!
+   \brief Garbage collection regardless of period
+   \post all objects with reference counter 1 have been removed from this cache, and the period between two
+   collections has been reset
+   \return number of collected objects
+   */
+  std::size_t collect_now()
+  {
+    _period = 1;
+    _count = 1;
+    return tchecker::cache_t<SPTR, HASH, EQUAL>::collect();
+  }
+
 private:
   std::size_t _period; /*!< Period between two collections */
   std::size_t _count;  /*!< Time from last collection */
 };
 
+/*!
+ \class concurrent_cache_t
+ \brief Cache of shared objects with collection of unused objects, that can be shared between threads
+ \tparam SPTR : type of pointer to stored objects. Must be a shared pointer tchecker::intrusive_shared_ptr_t<...>
+ to an object that derives from tchecker::cached_object_t, with an atomic reference counter
+ \tparam HASH : hash function over shared pointers of type SPTR, must be default constructible
+ \tparam EQUAL : equality predicate over shared pointers of type SPTR, must be default constructible
+ \note objects are stored in a tchecker::concurrent_hashtable_t. Unlike tchecker::periodic_collectable_cache_t,
+ every collection visits the cache, as several threads may release objects between collections
+ */
+template <class SPTR, class HASH, class EQUAL> class concurrent_cache_t : public tchecker::collectable_t {
+public:
+  /*!
+   \brief Constructor
+   \param table_size : size of the hash table
+   */
+  concurrent_cache_t(std::size_t table_size = 65536) : _hashtable(table_size, HASH{}, EQUAL{}) {}
+
+  /*!
+   \brief Copy-construction (deleted)
+   */
+  concurrent_cache_t(tchecker::concurrent_cache_t<SPTR, HASH, EQUAL> const &) = delete;
+
+  /*!
+   \brief Move-construction (deleted)
+   */
+  concurrent_cache_t(tchecker::concurrent_cache_t<SPTR, HASH, EQUAL> &&) = delete;
+
+  /*!
+   \brief Destructor
+   */
+  virtual ~concurrent_cache_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::concurrent_cache_t<SPTR, HASH, EQUAL> &
+  operator=(tchecker::concurrent_cache_t<SPTR, HASH, EQUAL> const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::concurrent_cache_t<SPTR, HASH, EQUAL> &
+  operator=(tchecker::concurrent_cache_t<SPTR, HASH, EQUAL> &&) = delete;
+
+  /*!
+   \brief Object caching
+   \param o : object
+   \return see tchecker::cache_t::find_else_add
+   \post see tchecker::cache_t::find_else_add
+   */
+  inline SPTR find_else_add(SPTR const & o) { return _hashtable.find_else_add(o); }
+
+  /*!
+   \brief Object caching with a precomputed hash code
+   \param o : object
+   \param h : hash code of o
+   \pre h is the hash code of o w.r.t. HASH
+   \return same as find_else_add(o)
+   \post same as find_else_add(o)
+   */
+  inline SPTR find_else_add(SPTR const & o, std::size_t h) { return _hashtable.find_else_add(o, h); }
+
+  /*!
+   \brief Prefetch
+   \param h : hash code
+   \post see tchecker::concurrent_hashtable_t::prefetch
+   */
+  inline void prefetch(std::size_t h) const { _hashtable.prefetch(h); }
+
+  /*!
+   \brief Membership predicate
+   \param o : object
+   \return true if this cache constains an object equivalent to o (w.r.t. HASH and EQUAL), false otherwise
+   */
+  inline bool find(SPTR const & o) { return std::get<0>(_hashtable.find(o)); }
+
+  /*!
+   \brief Clear the cache
+   \post This cache is empty
+   */
+  inline void clear() { _hashtable.clear(); }
+
+  /*!
+   \brief Garbage collection
+   \post All objects with reference counter 1 (i.e. objects with no reference outside of this cache) have been
+   removed from this cache
+   \return number of collected objects
+   \note an object with reference counter 1 is only referenced by this cache, and lookups lock the same shards as
+   collection, hence a collected object cannot be returned by a concurrent lookup
+   */
+  virtual std::size_t collect()
+  {
+    return _hashtable.remove_if([](SPTR const & o) { return o->refcount() == 1; });
+  }
+
+  /*!
+   \brief Garbage collection
+   \post same as collect()
+   \return same as collect()
+   */
+  inline std::size_t collect_now() { return collect(); }
+
+  /*!
+   \brief Accessor
+   \return Number of objects in the cache
+   \note the result may be outdated if other threads update the cache concurrently
+   */
+  inline std::size_t size() { return _hashtable.size(); }
+
+private:
+  tchecker::concurrent_hashtable_t<SPTR, HASH, EQUAL> _hashtable; /*!< Table of stored objects */
+};
+
+/*!
+ \class collection_trigger_t
+ \brief Trigger of incremental garbage collection, driven by a number of allocations and/or by elapsed time
+ */
+class collection_trigger_t {
+public:
+  /*!
+   \brief Constructor
+   \param allocations : number of allocations between two collections (0: not driven by allocations)
+   \param interval : time between two collections (0: not driven by time)
+   \note the trigger is disabled if both allocations and interval are 0
+   */
+  collection_trigger_t(std::size_t allocations = 0, std::chrono::milliseconds interval = std::chrono::milliseconds{0})
+      : _allocations(allocations), _interval(interval), _count(0), _last(std::chrono::steady_clock::now())
+  {
+  }
+
+  /*!
+   \brief Accessor
+   \return true if the trigger is enabled, false otherwise
+   */
+  inline bool enabled() const { return (_allocations != 0) || (_interval.count() != 0); }
+
+  /*!
+   \brief Count an allocation
+   \post the allocation has been counted, and the trigger has been reset if a collection is due
+   \return true if a collection is due, false otherwise
+   \note elapsed time is only checked every TIME_CHECK_PERIOD allocations
+   */
+  inline bool tick()
+  {
+    if (!enabled())
+      return false;
+    ++_count;
+    if ((_allocations != 0) && (_count >= _allocations)) {
+      reset();
+      return true;
+    }
+    if ((_interval.count() != 0) && (_count % TIME_CHECK_PERIOD == 0) &&
+        (std::chrono::steady_clock::now() - _last >= _interval)) {
+      reset();
+      return true;
+    }
+    return false;
+  }
+
+  /*!
+   \brief Reset
+   \post no allocation has been counted since now
+   */
+  inline void reset()
+  {
+    _count = 0;
+    _last = std::chrono::steady_clock::now();
+  }
+
+private:
+  static constexpr std::size_t const TIME_CHECK_PERIOD = 256; /*!< Period of time checks (allocations) */
+
+  std::size_t _allocations;                                /*!< Allocations between two collections */
+  std::chrono::milliseconds _interval;                     /*!< Time between two collections */
+  std::size_t _count;                                      /*!< Allocations since last collection */
+  std::chrono::time_point<std::chrono::steady_clock> _last; /*!< Time of last collection */
+};
+
 } // end of namespace tchecker
 
 #endif // TCHECKER_CACHE_HH
@@ -10,17 +10,28 @@
  \brief Hashtable of shared objects
  */
 
-#include <unordered_set>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
 #include <vector>
 
 #include "tchecker/utils/iterator.hh"
+#include "tchecker/utils/probes.hh"
 #include "tchecker/utils/shared_objects.hh"
+#include "tchecker/utils/sizing.hh"
+#include "tchecker/utils/spinlock.hh"
 
 namespace tchecker {
 
 // Forward declaration
 template <class SPTR, class HASH> class collision_table_t;
 template <class SPTR, class HASH, class EQUAL> class hashtable_t;
+template <class SPTR, class HASH, class EQUAL> class concurrent_hashtable_t;
 
 /*!
  \brief Type of position in a collision table
@@ -144,6 +155,9 @@ private:
   \note stored objects should derive from tchecker::collision_table_object_t
   \note collision tables do not check for object equality: objects with same
   hash value are simply stored in the same collision list.
+  \note When adaptive sizes are enabled when the table is constructed (see
+  tchecker::adaptive_sizes), the number of collision lists doubles whenever
+  the load factor exceeds MAX_ADAPTIVE_LOAD_FACTOR. Otherwise, it is fixed
 */
 template <class SPTR, class HASH> class collision_table_t {
 protected:
@@ -155,6 +169,11 @@ public:
   */
   using object_sptr_t = SPTR;
 
+  /*!
+   \brief Maximal load factor with adaptive sizes
+   */
+  static constexpr std::size_t MAX_ADAPTIVE_LOAD_FACTOR = 2;
+
   /*!
    \brief Constructor
    \param table_size : size of the table (number of collision lists)
@@ -162,7 +181,8 @@ public:
    \pre table_size != tchecker::COLLISION_TABLE_NOT_STORED
    \throw std::invalid_argument : if the precondition is violated
    */
-  collision_table_t(std::size_t table_size, HASH const & hash) : _table{table_size}, _hash(hash), _size(0)
+  collision_table_t(std::size_t table_size, HASH const & hash)
+      : _table{table_size}, _hash(hash), _size(0), _adaptive(tchecker::adaptive_sizes())
   {
     if (table_size == tchecker::COLLISION_TABLE_NOT_STORED)
       throw std::invalid_argument("Collision table size is too big");
@@ -220,6 +240,8 @@ public:
   {
     if (o->is_stored())
       throw std::invalid_argument("Adding an object that is already stored in a collision table is not allowed");
+    if (_adaptive && _size >= MAX_ADAPTIVE_LOAD_FACTOR * _table.size())
+      grow();
     tchecker::collision_table_position_t position_in_table = compute_position_in_table(o);
     add(o, position_in_table);
   }
@@ -246,6 +268,31 @@ public:
    */
   inline std::size_t size() const { return _size; }
 
+  /*!
+   \brief Accessor
+   \return Number of collision lists in this collision table
+   */
+  inline std::size_t table_size() const { return _table.size(); }
+
+  /*!
+   \brief Accessor
+   \return Average number of objects per collision list
+   */
+  inline double load_factor() const { return _table.empty() ? 0.0 : static_cast<double>(_size) / _table.size(); }
+
+  /*!
+   \brief Accessor
+   \return Size of the longest collision list
+   \note Linear complexity in the size of the table
+   */
+  std::size_t longest_collision_list() const
+  {
+    std::size_t longest = 0;
+    for (collision_list_t const & c : _table)
+      longest = std::max(longest, c.size());
+    return longest;
+  }
+
   /*!
    \class iterator_t
    \brief Type of iterator over the objects in the table
@@ -562,6 +609,27 @@ protected:
     --_size;
   }
 
+  /*!
+   \brief Double the size of the table
+   \post the number of collision lists has doubled (unless it would reach
+   tchecker::COLLISION_TABLE_NOT_STORED), and all objects have been moved to
+   their new collision list
+   \note invalidates iterators
+   */
+  void grow()
+  {
+    if (2 * _table.size() >= tchecker::COLLISION_TABLE_NOT_STORED)
+      return;
+    std::vector<collision_list_t> old_table(2 * _table.size());
+    old_table.swap(_table);
+    for (collision_list_t & c : old_table)
+      for (SPTR const & o : c) {
+        o->clear_position();
+        tchecker::collision_table_position_t h = compute_position_in_table(o);
+        o->set_position(h, add(o, _table[h]));
+      }
+  }
+
   /*!
    \brief Accessor to range of objects in a collision list from a const iterator to a
    collision list
@@ -578,6 +646,7 @@ protected:
   std::vector<collision_list_t> _table; /*!< Table with collision lists */
   HASH _hash;                           /*!< Hash function */
   std::size_t _size;                    /*!< Number of stored objects */
+  bool _adaptive;                       /*!< Geometric growth of the table */
 };
 
 /*!
@@ -594,19 +663,40 @@ class hashtable_object_t {};
  \tparam HASH : hash function over shared pointers of type SPTR
  \tparam EQUAL : equality predicate over shared pointers of type SPTR
  \note stored objects should derive from tchecker::hashtable_object_t
+ \note open addressing with Robin Hood linear probing: objects are stored in a flat array of slots, there is no
+ collision list. The hash code of each stored object is kept in its slot and acts as a fingerprint: EQUAL is only
+ called on objects with the same hash code, hence most unequal objects are rejected without comparing them
+ \note the table grows (doubles its capacity) when its load factor exceeds 7/8, or when some object is too far from
+ its home slot
 */
 template <class SPTR, class HASH, class EQUAL> class hashtable_t {
+  /*!
+   \brief Slot in the table
+   */
+  struct slot_t {
+    std::size_t hash{0};       /*!< Hash code of object */
+    std::uint32_t distance{0}; /*!< 0 if this slot is empty, 1 + distance to home slot of object otherwise */
+    SPTR object{nullptr};      /*!< Stored object */
+  };
+
+  using slots_t = std::vector<slot_t>;
+
 public:
   /*!
    \brief Constructor
-   \param table_size : capacity of the table
+   \param table_size : initial number of slots in the table
    \param hash : hash function
    \param equal : equality predicate
    \pre table_size != tchecker::COLLISION_TABLE_NOT_STORED
    \throw std::invalid_argument : if the precondition is violated
-   \note the capacity of the table may grow when too many collisions occur
+   \note the table grows as objects are added, hence table_size is only a hint
    */
-  hashtable_t(std::size_t table_size, HASH const & hash, EQUAL const & equal) : _table(table_size, hash, equal) {}
+  hashtable_t(std::size_t table_size, HASH const & hash, EQUAL const & equal) : _hash(hash), _equal(equal), _size(0)
+  {
+    if (table_size == tchecker::COLLISION_TABLE_NOT_STORED)
+      throw std::invalid_argument("Hashtable size is too big");
+    allocate(table_size);
+  }
 
   /*!
    \brief Copy constructor
@@ -638,8 +728,14 @@ public:
    \post The hash table is empty
    \note Destructor called on shared pointers
    \note Invalidates iterators
+   \note The capacity of the table is kept
    */
-  void clear() { _table.clear(); }
+  void clear()
+  {
+    for (slot_t & slot : _slots)
+      slot = slot_t{};
+    _size = 0;
+  }
 
   /*!
    \brief Add object to the hashtable
@@ -651,17 +747,26 @@ public:
    */
   bool add(SPTR const & o)
   {
-    auto && [it, inserted] = _table.insert(o);
-    return inserted;
+    std::size_t const h = _hash(o);
+    if (lookup(o, h) != NOT_FOUND)
+      return false;
+    insert(o, h);
+    return true;
   }
 
+  /*!
+   \brief Remove an object from the hashtable
+   \param o : an object
+   \post the object equal to o w.r.t. EQUAL has been removed from this hashtable
+   \throw std::invalid_argument : if this hashtable contains no object equal to o
+   \note Invalidates iterators
+   */
   void remove(SPTR const & o)
   {
-    auto it = _table.find(o);
-    if (it == _table.end()) {
+    std::size_t const i = lookup(o, _hash(o));
+    if (i == NOT_FOUND)
       throw std::invalid_argument("Removing an object that is not stored");
-    }
-    remove(it);
+    erase(i);
   }
 
   /*!
@@ -672,10 +777,10 @@ public:
   */
   std::tuple<bool, SPTR const> find(SPTR const & o) const
   {
-    auto it = _table.find(o);
-    if (it == _table.end())
+    std::size_t const i = lookup(o, _hash(o));
+    if (i == NOT_FOUND)
       return std::make_tuple(false, o);
-    return std::make_tuple(true, *it);
+    return std::make_tuple(true, _slots[i].object);
   }
 
   /*!
@@ -686,49 +791,207 @@ public:
    \return an object in this hashtable that is EQUAL to o, in particular o
    itself if it has been added
   */
-  SPTR find_else_add(SPTR const & o)
+  SPTR find_else_add(SPTR const & o) { return find_else_add(o, _hash(o)); }
+
+  /*!
+   \brief Add an object if it is not already in, with a precomputed hash code
+   \param o : an object
+   \param h : hash code of o
+   \pre h is the hash code of o w.r.t. HASH
+   \post same as find_else_add(o)
+   \return same as find_else_add(o)
+   \note the hash code can be computed beforehand, e.g. by the threads that have computed the objects
+  */
+  SPTR find_else_add(SPTR const & o, std::size_t h)
+  {
+    std::size_t const i = lookup(o, h);
+    if (i != NOT_FOUND)
+      return _slots[i].object;
+    insert(o, h);
+    return o;
+  }
+
+  /*!
+   \brief Add objects if they are not already in, with precomputed hash codes
+   \param objects : objects
+   \param hashes : hash codes of objects
+   \pre hashes[i] is the hash code of objects[i] w.r.t. HASH for every i, and hashes has the size of objects
+   \post objects[i] has been added to this hashtable if it does not contain any object EQUAL to objects[i], and
+   objects[i] has been replaced by the object in this hashtable that is EQUAL to it, for every i in increasing order
+   \throw std::invalid_argument : if objects and hashes do not have the same size
+   \note the lookups are software pipelined: the home slots of the objects PREFETCH_DISTANCE positions ahead are
+   prefetched, as well as the objects in the home slots with the same hash codes PREFETCH_DISTANCE/2 positions
+   ahead, hence the cache misses of distinct lookups overlap
+  */
+  void find_else_add(std::vector<SPTR> & objects, std::vector<std::size_t> const & hashes)
+  {
+    if (objects.size() != hashes.size())
+      throw std::invalid_argument("Objects and hash codes should have the same size");
+    std::size_t const n = objects.size();
+    for (std::size_t i = 0; i < std::min(n, PREFETCH_DISTANCE); ++i)
+      prefetch(hashes[i]);
+    for (std::size_t i = 0; i < n; ++i) {
+      if (i + PREFETCH_DISTANCE < n)
+        prefetch(hashes[i + PREFETCH_DISTANCE]);
+      if (i + PREFETCH_DISTANCE / 2 < n)
+        prefetch_candidate(hashes[i + PREFETCH_DISTANCE / 2]);
+      objects[i] = find_else_add(objects[i], hashes[i]);
+    }
+  }
+
+  /*!
+   \brief Prefetch the home slot of a hash code
+   \param h : hash code
+   \post the first slot where an object with hash code h may be stored is being loaded in the cache of the
+   processor, if prefetching is supported
+   \note lookups are not affected, this is only a hint to hide the cache miss of a later lookup of h
+  */
+  inline void prefetch(std::size_t h) const
   {
-    auto && [it, inserted] = _table.insert(o);
-    if (inserted)
-      return o;
-    return *it;
+#if defined(__GNUC__)
+    __builtin_prefetch(&_slots[home(h)]);
+#else
+    (void)h;
+#endif
   }
 
   /*!
    \brief Accessor
    \return Number of objects in this hash table
    */
-  inline std::size_t size() const { return _table.size(); }
+  inline std::size_t size() const { return _size; }
+
+  /*!
+   \brief Accessor
+   \return Memory used by the slots of this hash table (excluding stored objects)
+   */
+  inline std::size_t memsize() const { return _slots.capacity() * sizeof(slot_t); }
+
+  /*!
+   \brief Accessor
+   \return Number of objects that can be stored in this hash table before it grows
+   */
+  inline std::size_t capacity() const { return max_load(_capacity); }
+
+  /*!
+   \brief Accessor
+   \return Ratio of the number of objects to the number of home slots
+   \note the table grows when the load factor exceeds 7/8
+   */
+  inline double load_factor() const { return static_cast<double>(_size) / _capacity; }
+
+  /*!
+   \brief Accessor
+   \return Longest distance of an object to its home slot, i.e. number of collisions on the longest probe sequence
+   \note Linear complexity in the capacity of the table
+   */
+  std::size_t longest_probe() const
+  {
+    std::uint32_t longest = 0;
+    for (slot_t const & slot : _slots)
+      longest = std::max(longest, slot.distance);
+    return (longest == 0 ? 0 : longest - 1);
+  }
+
+  /*!
+   \class iterator_base_t
+   \brief Iterator over the objects in the table
+   \tparam SLOTS : type of slots (const or non-const)
+   */
+  template <class SLOTS> class iterator_base_t {
+  public:
+    /*!
+     \brief Constructor
+     \param slots : iterated slots
+     \param i : index in slots
+     \post this iterator points to the first object at index >= i in slots, or past-the-end
+     */
+    iterator_base_t(SLOTS * slots, std::size_t i) : _slots(slots), _i(i) { skip_empty(); }
+
+    /*!
+     \brief Equality predicate
+     \param it : an iterator
+     \return true if this iterator is equal to it, false otherwise
+     */
+    bool operator==(iterator_base_t<SLOTS> const & it) const { return (_slots == it._slots) && (_i == it._i); }
+
+    /*!
+     \brief Disequality predicate
+     \param it : an iterator
+     \return true if this iterator is different of it, false otherwise
+     */
+    bool operator!=(iterator_base_t<SLOTS> const & it) const { return !(*this == it); }
+
+    /*!
+     \brief Dereference operator
+     \pre this iterator is not past-the-end (checked by assertion)
+     \return object pointed by this iterator
+     */
+    SPTR const & operator*() const
+    {
+      assert(_i < _slots->size());
+      return (*_slots)[_i].object;
+    }
+
+    /*!
+     \brief Move to next object
+     \pre this iterator is not past-the-end (checked by assertion)
+     \return this iterator after it has been moved
+     */
+    iterator_base_t<SLOTS> & operator++()
+    {
+      assert(_i < _slots->size());
+      ++_i;
+      skip_empty();
+      return *this;
+    }
+
+  private:
+    friend class tchecker::hashtable_t<SPTR, HASH, EQUAL>;
+
+    /*!
+     \brief Skip empty slots
+     \post this iterator points to the first object at index >= _i, or past-the-end
+     */
+    void skip_empty()
+    {
+      while ((_i < _slots->size()) && ((*_slots)[_i].distance == 0))
+        ++_i;
+    }
+
+    SLOTS * _slots; /*!< Iterated slots */
+    std::size_t _i; /*!< Index in _slots */
+  };
 
   /*!
    \brief Type of iterator
   */
-  using iterator_t = typename std::unordered_set<SPTR, HASH, EQUAL>::iterator;
+  using iterator_t = iterator_base_t<slots_t>;
 
   /*!
    \brief Iterator on first element (if any)
   */
-  iterator_t begin() { return _table.begin(); }
+  iterator_t begin() { return iterator_t(&_slots, 0); }
 
   /*!
     \brief Past-the-end iterator
   */
-  iterator_t end() { return _table.end(); }
+  iterator_t end() { return iterator_t(&_slots, _slots.size()); }
 
   /*!
     \brief Type of const iterator
   */
-  using const_iterator_t = typename std::unordered_set<SPTR, HASH, EQUAL>::const_iterator;
+  using const_iterator_t = iterator_base_t<slots_t const>;
 
   /*!
     \brief Const iterator on first element (if any)
   */
-  const_iterator_t begin() const { return _table.cbegin(); }
+  const_iterator_t begin() const { return const_iterator_t(&_slots, 0); }
 
   /*!
     \brief Const past-the-end iterator
   */
-  const_iterator_t end() const { return _table.cend(); }
+  const_iterator_t end() const { return const_iterator_t(&_slots, _slots.size()); }
 
   /*!
     \brief Remove an element
@@ -736,11 +999,430 @@ public:
     \pre it can be dereferenced
     \post the element pointed by it has been removed from this hash table
     \return iterator to the next object in the table
+    \note iterators to objects before it remain valid; objects after it are each visited once by the returned iterator
   */
-  iterator_t remove(iterator_t const & it) { return _table.erase(it); }
+  iterator_t remove(iterator_t const & it)
+  {
+    assert(it._slots == &_slots);
+    erase(it._i);
+    return iterator_t(&_slots, it._i);
+  }
 
 protected:
-  std::unordered_set<SPTR, HASH, EQUAL> _table; /*!< Container */
+  template <class SP, class H, class E> friend class tchecker::concurrent_hashtable_t;
+
+  static constexpr std::size_t const NOT_FOUND = std::numeric_limits<std::size_t>::max(); /*!< Index of missing objects */
+  static constexpr std::size_t const MIN_CAPACITY = 16;                                   /*!< Minimal capacity */
+  static constexpr std::size_t const PREFETCH_DISTANCE = 8;                               /*!< Lookahead of batches */
+
+  /*!
+   \brief Maximal number of stored objects before growing
+   \param capacity : a capacity
+   \return 7/8 of capacity
+   */
+  static constexpr std::size_t max_load(std::size_t capacity) { return capacity - capacity / 8; }
+
+  /*!
+   \brief Allocate slots
+   \param capacity : requested number of home slots
+   \post all slots are empty, and the number of home slots is the smallest power of 2 >= capacity (and
+   >= MIN_CAPACITY)
+   */
+  void allocate(std::size_t capacity)
+  {
+    _capacity = MIN_CAPACITY;
+    _shift = std::numeric_limits<std::size_t>::digits - 4;
+    while (_capacity < capacity) {
+      _capacity *= 2;
+      --_shift;
+    }
+    // objects are at most _max_distance slots away from their home, hence probes never wrap around
+    _max_distance = static_cast<std::uint32_t>(std::numeric_limits<std::size_t>::digits - _shift) + 8;
+    _slots.assign(_capacity + _max_distance, slot_t{});
+  }
+
+  /*!
+   \brief Computes home slot
+   \param h : hash code
+   \return the index of the first slot where an object with hash code h may be stored
+   \note Fibonacci hashing: the top bits of h times 2^N/phi are a good index even if the low bits of h are poor
+   */
+  inline std::size_t home(std::size_t h) const
+  {
+    constexpr std::size_t const mult =
+        (std::numeric_limits<std::size_t>::digits == 64 ? static_cast<std::size_t>(11400714819323198485ull) : 2654435769u);
+    return (h * mult) >> _shift;
+  }
+
+  /*!
+   \brief Prefetch the object in the home slot of a hash code
+   \param h : hash code
+   \pre the home slot of h has been prefetched (see prefetch)
+   \post the object in the home slot of h is being loaded in the cache of the processor if it has hash code h,
+   and if prefetching is supported
+   */
+  inline void prefetch_candidate(std::size_t h) const
+  {
+#if defined(__GNUC__)
+    slot_t const & slot = _slots[home(h)];
+    if (slot.distance != 0 && slot.hash == h)
+      __builtin_prefetch(&*slot.object);
+#else
+    (void)h;
+#endif
+  }
+
+  /*!
+   \brief Look for an object
+   \param o : an object
+   \param h : hash code of o
+   \return index of the slot with an object EQUAL to o, NOT_FOUND if there is no such object
+   */
+  std::size_t lookup(SPTR const & o, std::size_t h) const
+  {
+    std::size_t i = home(h);
+    for (std::uint32_t distance = 1; _slots[i].distance >= distance; ++i, ++distance)
+      if ((_slots[i].hash == h) && _equal(_slots[i].object, o))
+        return i;
+    return NOT_FOUND;
+  }
+
+  /*!
+   \brief Insert an object
+   \param o : an object
+   \param h : hash code of o
+   \pre this table does not contain an object EQUAL to o
+   \post o has been inserted in this table, which may have grown
+   */
+  void insert(SPTR const & o, std::size_t h)
+  {
+    if (_size + 1 > max_load(_capacity))
+      grow();
+    slot_t carried{h, 1, o};
+    while (!place(carried))
+      grow();
+    ++_size;
+  }
+
+  /*!
+   \brief Place a slot in the table (Robin Hood insertion)
+   \param carried : a slot
+   \post carried has been placed in the table and true is returned, or the probe went too far and false is
+   returned. In the later case, carried has been updated to the slot that remains to be placed
+   \return see post
+   */
+  bool place(slot_t & carried)
+  {
+    carried.distance = 1;
+    for (std::size_t i = home(carried.hash); carried.distance <= _max_distance; ++i, ++carried.distance) {
+      slot_t & slot = _slots[i];
+      if (slot.distance == 0) {
+        // distance > 1 means that the object collided with the objects in the slots before
+        TCHECKER_PROBE1(hashtable_place, carried.distance);
+        slot = std::move(carried);
+        return true;
+      }
+      // steal the slot from richer objects (i.e. closer to their home) to keep probe sequences short
+      if (slot.distance < carried.distance)
+        std::swap(slot, carried);
+    }
+    return false;
+  }
+
+  /*!
+   \brief Double the capacity
+   \post the capacity of this table has doubled, and all objects have been moved to the new slots
+   */
+  void grow()
+  {
+    slots_t old_slots;
+    old_slots.swap(_slots);
+    std::size_t capacity = 2 * _capacity;
+    for (;;) {
+      allocate(capacity);
+      bool placed = true;
+      for (slot_t & slot : old_slots) {
+        if (slot.distance == 0)
+          continue;
+        if (!(placed = place(slot)))
+          break;
+        slot.distance = 0;
+      }
+      if (placed)
+        return;
+      // should not happen with a reasonable hash function: gather objects placed so far and retry
+      for (slot_t & slot : _slots)
+        if (slot.distance != 0)
+          old_slots.push_back(std::move(slot));
+      capacity = 2 * _capacity;
+    }
+  }
+
+  /*!
+   \brief Erase object at given index
+   \param i : index of a slot
+   \pre slot at index i contains an object (checked by assertion)
+   \post the object at index i has been removed, and the following objects have been shifted backward
+   \note objects at index < i are not moved
+   */
+  void erase(std::size_t i)
+  {
+    assert(i < _slots.size() && _slots[i].distance != 0);
+    std::size_t j = i + 1;
+    for (; (j < _slots.size()) && (_slots[j].distance > 1); ++j) {
+      _slots[j - 1] = std::move(_slots[j]);
+      --_slots[j - 1].distance;
+    }
+    _slots[j - 1] = slot_t{};
+    --_size;
+  }
+
+  HASH _hash;                  /*!< Hash function */
+  EQUAL _equal;                /*!< Equality predicate */
+  slots_t _slots;              /*!< Slots */
+  std::size_t _size;           /*!< Number of stored objects */
+  std::size_t _capacity;       /*!< Number of home slots (a power of 2) */
+  std::size_t _shift;          /*!< Shift for Fibonacci hashing */
+  std::uint32_t _max_distance; /*!< Maximal distance to home slot */
+};
+
+/*!
+ \class concurrent_hashtable_t
+ \brief Hashtable that can be shared between threads
+ \tparam SPTR : type of pointer to stored objects (see tchecker::hashtable_t)
+ \tparam HASH : hash function over shared pointers of type SPTR
+ \tparam EQUAL : equality predicate over shared pointers of type SPTR
+ \note lock striping: objects are distributed over shards w.r.t. their hash code, each shard is a
+ tchecker::hashtable_t protected by a spin lock. Operations on objects in distinct shards do not contend
+ \note SPTR must be safe to copy from several threads if objects are shared across threads
+*/
+template <class SPTR, class HASH, class EQUAL> class concurrent_hashtable_t {
+public:
+  /*!
+   \brief Constructor
+   \param table_size : initial number of slots in the table (over all shards)
+   \param hash : hash function
+   \param equal : equality predicate
+   \param shards : number of shards
+   \pre shards is a power of 2
+   \throw std::invalid_argument : if shards is not a power of 2, or if table_size is too big
+   */
+  concurrent_hashtable_t(std::size_t table_size, HASH const & hash, EQUAL const & equal, std::size_t shards = 64)
+      : _hash(hash)
+  {
+    if ((shards == 0) || ((shards & (shards - 1)) != 0))
+      throw std::invalid_argument("Number of shards should be a power of 2");
+    _shards.reserve(shards);
+    for (std::size_t i = 0; i < shards; ++i)
+      _shards.emplace_back(new shard_t(table_size / shards, hash, equal));
+  }
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  concurrent_hashtable_t(tchecker::concurrent_hashtable_t<SPTR, HASH, EQUAL> const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  concurrent_hashtable_t(tchecker::concurrent_hashtable_t<SPTR, HASH, EQUAL> &&) = delete;
+
+  /*!
+   \brief Destructor
+   */
+  ~concurrent_hashtable_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::concurrent_hashtable_t<SPTR, HASH, EQUAL> &
+  operator=(tchecker::concurrent_hashtable_t<SPTR, HASH, EQUAL> const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::concurrent_hashtable_t<SPTR, HASH, EQUAL> &
+  operator=(tchecker::concurrent_hashtable_t<SPTR, HASH, EQUAL> &&) = delete;
+
+  /*!
+   \brief Clear
+   \post The hash table is empty
+   */
+  void clear()
+  {
+    for (auto & shard : _shards) {
+      std::lock_guard<tchecker::spinlock_t> lock(shard->lock);
+      shard->table.clear();
+    }
+  }
+
+  /*!
+   \brief Add object to the hashtable
+   \param o : an object
+   \post o has been added to this hashtable if it does not contain any element equal to o w.r.t. EQUAL
+   \return true if o has been added to this hashtable, false otherwise
+   */
+  bool add(SPTR const & o)
+  {
+    std::size_t const h = _hash(o);
+    shard_t & shard = shard_of(h);
+    std::lock_guard<tchecker::spinlock_t> lock(shard.lock);
+    if (shard.table.lookup(o, h) != shard_table_t::NOT_FOUND)
+      return false;
+    shard.table.insert(o, h);
+    return true;
+  }
+
+  /*!
+   \brief Remove an object from the hashtable
+   \param o : an object
+   \post the object equal to o w.r.t. EQUAL has been removed from this hashtable
+   \throw std::invalid_argument : if this hashtable contains no object equal to o
+   */
+  void remove(SPTR const & o)
+  {
+    std::size_t const h = _hash(o);
+    shard_t & shard = shard_of(h);
+    std::lock_guard<tchecker::spinlock_t> lock(shard.lock);
+    std::size_t const i = shard.table.lookup(o, h);
+    if (i == shard_table_t::NOT_FOUND)
+      throw std::invalid_argument("Removing an object that is not stored");
+    shard.table.erase(i);
+  }
+
+  /*!
+   \brief Find an object in the hashtable
+   \param o : an object
+   \return a pair (found, p) where p is true if an object p equal to o has been
+   found in this hashtable, otherwise found is false and p == o
+  */
+  std::tuple<bool, SPTR const> find(SPTR const & o)
+  {
+    std::size_t const h = _hash(o);
+    shard_t & shard = shard_of(h);
+    std::lock_guard<tchecker::spinlock_t> lock(shard.lock);
+    std::size_t const i = shard.table.lookup(o, h);
+    if (i == shard_table_t::NOT_FOUND)
+      return std::make_tuple(false, o);
+    return std::make_tuple(true, shard.table._slots[i].object);
+  }
+
+  /*!
+   \brief Add an object if it is not already in
+   \param o : an object
+   \post o has been added to this hashtable if it does not contain any object EQUAL to o
+   \return an object in this hashtable that is EQUAL to o, in particular o itself if it has been added
+  */
+  SPTR find_else_add(SPTR const & o)
+  {
+    std::size_t const h = _hash(o);
+    shard_t & shard = shard_of(h);
+    std::lock_guard<tchecker::spinlock_t> lock(shard.lock);
+    std::size_t const i = shard.table.lookup(o, h);
+    if (i != shard_table_t::NOT_FOUND)
+      return shard.table._slots[i].object;
+    shard.table.insert(o, h);
+    return o;
+  }
+
+  /*!
+   \brief Add an object if it is not already in, with a precomputed hash code
+   \param o : an object
+   \param h : hash code of o
+   \pre h is the hash code of o w.r.t. HASH
+   \return same as find_else_add(o)
+   \post same as find_else_add(o)
+  */
+  SPTR find_else_add(SPTR const & o, std::size_t h)
+  {
+    shard_t & shard = shard_of(h);
+    std::lock_guard<tchecker::spinlock_t> lock(shard.lock);
+    std::size_t const i = shard.table.lookup(o, h);
+    if (i != shard_table_t::NOT_FOUND)
+      return shard.table._slots[i].object;
+    shard.table.insert(o, h);
+    return o;
+  }
+
+  /*!
+   \brief Prefetch
+   \param h : hash code
+   \post the shard of objects with hash code h is being loaded in the cache of the processor
+   \note the slots of the shard are not prefetched, as they may be reallocated by other threads
+   */
+  inline void prefetch(std::size_t h) const
+  {
+#if defined(__GNUC__)
+    __builtin_prefetch(_shards[h & (_shards.size() - 1)].get());
+#else
+    (void)h;
+#endif
+  }
+
+  /*!
+   \brief Remove objects
+   \param pred : predicate over stored objects
+   \post the objects o such that pred(o) is true have been removed from this hashtable. pred is called on
+   the objects of a shard while the shard is locked
+   \return number of removed objects
+   */
+  template <class PRED> std::size_t remove_if(PRED && pred)
+  {
+    std::size_t removed = 0;
+    for (auto & shard : _shards) {
+      std::lock_guard<tchecker::spinlock_t> lock(shard->lock);
+      auto it = shard->table.begin();
+      while (it != shard->table.end()) {
+        if (pred(*it)) {
+          it = shard->table.remove(it);
+          ++removed;
+        }
+        else
+          ++it;
+      }
+    }
+    return removed;
+  }
+
+  /*!
+   \brief Accessor
+   \return Number of objects in this hash table
+   \note the result may be outdated if other threads update the table concurrently
+   */
+  std::size_t size()
+  {
+    std::size_t size = 0;
+    for (auto & shard : _shards) {
+      std::lock_guard<tchecker::spinlock_t> lock(shard->lock);
+      size += shard->table.size();
+    }
+    return size;
+  }
+
+private:
+  using shard_table_t = tchecker::hashtable_t<SPTR, HASH, EQUAL>;
+
+  /*!
+   \brief Shard: hashtable and its lock, on their own cache line
+   */
+  struct alignas(64) shard_t {
+    shard_t(std::size_t table_size, HASH const & hash, EQUAL const & equal) : table(table_size, hash, equal) {}
+
+    tchecker::spinlock_t lock; /*!< Lock on table */
+    shard_table_t table;       /*!< Hashtable */
+  };
+
+  /*!
+   \brief Accessor
+   \param h : hash code
+   \return the shard of objects with hash code h
+   \note shards are selected from the low bits of h, while tchecker::hashtable_t selects slots from the high
+   bits of a multiple of h
+   */
+  inline shard_t & shard_of(std::size_t h) { return *_shards[h & (_shards.size() - 1)]; }
+
+  HASH _hash;                                   /*!< Hash function */
+  std::vector<std::unique_ptr<shard_t>> _shards; /*!< Shards */
 };
 
 } // end of namespace tchecker
@@ -48,6 +48,12 @@ unsigned int log_error_count();
 */
 unsigned int log_warning_count();
 
+/*!
+ \brief Reset error and warning counters
+ \post The numbers of errors and warnings are 0
+*/
+void log_reset_count();
+
 /*!
  \brief Output error and warning counters
  \param os : output stream
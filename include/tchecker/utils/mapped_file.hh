@@ -0,0 +1,73 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_MAPPED_FILE_HH
+#define TCHECKER_MAPPED_FILE_HH
+
+#include <cstddef>
+#include <string>
+
+/*!
+ \file mapped_file.hh
+ \brief Read-only memory mapping of files
+ */
+
+namespace tchecker {
+
+/*!
+ \class mapped_file_t
+ \brief Read-only memory mapping of a file
+ */
+class mapped_file_t {
+public:
+  /*!
+   \brief Constructor
+   \param filename : file name
+   \post filename has been mapped in memory
+   \throw std::runtime_error : if filename cannot be mapped (in particular, if filename is empty)
+   */
+  mapped_file_t(std::string const & filename);
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  mapped_file_t(tchecker::mapped_file_t const &) = delete;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::mapped_file_t & operator=(tchecker::mapped_file_t const &) = delete;
+
+  /*!
+   \brief Destructor
+   \post the file has been unmapped
+   */
+  ~mapped_file_t();
+
+  /*!
+   \brief Accessor
+   \return first byte of the file
+   */
+  inline char const * begin() const { return _data; }
+
+  /*!
+   \brief Accessor
+   \return past-the-end byte of the file
+   */
+  inline char const * end() const { return _data + _size; }
+
+  /*!
+   \brief Accessor
+   \return size of the file in bytes
+   */
+  inline std::size_t size() const { return _size; }
+
+private:
+  char const * _data; /*!< Mapped file */
+  std::size_t _size;  /*!< Size of the file */
+};
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_MAPPED_FILE_HH
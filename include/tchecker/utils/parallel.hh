@@ -0,0 +1,99 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_PARALLEL_HH
+#define TCHECKER_PARALLEL_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+/*!
+ \file parallel.hh
+ \brief Parallel loops
+ */
+
+namespace tchecker {
+
+/*!
+ \brief Set the pinning policy of threads
+ \param pinning : true to pin threads to processors, false otherwise (default)
+ \post the worker threads of parallel loops (see tchecker::parallel_for) started from now on are pinned to processors
+ if pinning is true, and are scheduled freely otherwise
+ \note with pinning, worker t is pinned to the t-th processor (modulo the number of processors) in the affinity mask
+ of the process, and it stays on it. Pools of objects allocate their blocks from the thread that first uses them
+ (see tchecker::sharded_pool_t, and the zone graphs of each worker), hence on multi-socket machines, the memory of
+ each worker is allocated on its socket (first-touch policy) and it remains local
+ */
+void set_thread_pinning(bool pinning);
+
+/*!
+ \brief Accessor
+ \return true if the worker threads of parallel loops are pinned to processors, false otherwise
+ */
+bool thread_pinning();
+
+/*!
+ \brief Pin the calling thread to a processor
+ \param t : index of thread
+ \post the calling thread runs on the t-th processor (modulo the number of processors) in the affinity mask of the
+ process, if thread affinity is supported
+ \return true if the calling thread has been pinned, false otherwise (in particular, if thread affinity is not
+ supported)
+ */
+bool pin_this_thread(std::size_t t);
+
+/*!
+ \brief Parallel loop over a range of indices
+ \param size : number of indices
+ \param threads : maximum number of threads
+ \param f : function called as f(thread_id, i)
+ \post f(t, i) has been called for every i in [0, size), where thread t=i%n handles index i and n is the
+ number of threads actually used (at most threads and size)
+ \note indices are dealt in a round-robin fashion, hence the index-to-thread mapping only depends on size
+ and threads
+ \note f is run in the calling thread when a single thread is used
+ \note worker threads are pinned to processors if thread pinning is enabled (see tchecker::set_thread_pinning)
+ \throw any exception thrown by f (the first one, by thread identifier, is rethrown after all threads have joined)
+ */
+template <class F> void parallel_for(std::size_t size, std::size_t threads, F && f)
+{
+  std::size_t const n = std::min(std::max<std::size_t>(threads, 1), std::max<std::size_t>(size, 1));
+
+  if (n == 1) {
+    for (std::size_t i = 0; i < size; ++i)
+      f(0, i);
+    return;
+  }
+
+  bool const pinning = tchecker::thread_pinning();
+  std::vector<std::exception_ptr> errors(n);
+  std::vector<std::thread> workers;
+  workers.reserve(n);
+  for (std::size_t t = 0; t < n; ++t)
+    workers.emplace_back([&, t]() {
+      if (pinning)
+        tchecker::pin_this_thread(t);
+      try {
+        for (std::size_t i = t; i < size; i += n)
+          f(t, i);
+      }
+      catch (...) {
+        errors[t] = std::current_exception();
+      }
+    });
+
+  for (std::thread & w : workers)
+    w.join();
+
+  for (std::exception_ptr const & e : errors)
+    if (e)
+      std::rethrow_exception(e);
+}
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_PARALLEL_HH
@@ -5,10 +5,16 @@
 #ifndef TCHECKER_POOL_HH
 #define TCHECKER_POOL_HH
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "tchecker/utils/shared_objects.hh"
+#include "tchecker/utils/sizing.hh"
+#include "tchecker/utils/spinlock.hh"
 
 /*!
  \file pool.hh
@@ -42,26 +48,35 @@ public:
  tchecker::make_shared_t<Y> for some Y
  \note Pools allocate blocks of memory. Each block contains a fix number of
  chunks. A chunk stores an object of type T. All chunks have the same fixed
- size alloc_size. A block contains a fixed alloc_nb chunks. The size of a
- block is alloc_nb * alloc_size + sizeof(void *). The extra size for a pointer
- is used to maintain a simple linked list of blocks.
- \note The pool is *NOT* thread-safe
+ size alloc_size. A block contains alloc_nb chunks. The size of a block is
+ alloc_nb * alloc_size + 2 * sizeof(void *). The extra size for two pointers
+ is used to maintain a simple linked list of blocks, and the end of each block.
+ \note When adaptive sizes are enabled when the pool is constructed (see
+ tchecker::adaptive_sizes), the number of chunks doubles with every new block,
+ until blocks have MAX_ADAPTIVE_BLOCK_SIZE bytes
+ \note The pool is *NOT* thread-safe (see tchecker::sharded_pool_t)
  */
 template <class T> class pool_t {
 public:
-  static_assert(std::is_same<T, tchecker::make_shared_t<typename T::object_t>>::value,
+  static_assert(std::is_same<T, tchecker::make_shared_t<typename T::object_t, typename T::refcount_storage_t,
+                                                       T::REFCOUNT_RESERVED>>::value,
                 "T should have type tchecker::make_shared_t<...>");
 
   /*!
    \brief Size of the reference counter
    */
-  static constexpr std::size_t SIZEOF_REFCOUNT = sizeof(typename T::refcount_t);
+  static constexpr std::size_t SIZEOF_REFCOUNT = sizeof(typename T::refcount_storage_t);
 
   /*!
    \brief Minimal allocation size
    */
   static constexpr std::size_t MIN_ALLOC_SIZE = SIZEOF_REFCOUNT + sizeof(void *);
 
+  /*!
+   \brief Maximal size of blocks with adaptive sizes (bytes)
+   */
+  static constexpr std::size_t MAX_ADAPTIVE_BLOCK_SIZE = std::size_t{1} << 26;
+
   /*!
    \brief States of the reference counter used by the allocator
    */
@@ -94,14 +109,16 @@ public:
    actual allocation size is max(alloc_size, MIN_ALLOC_SIZE). The MIN_ALLOC_SIZE
    bytes are needed to maintain a list of free chunk, while keeping the value of
    the reference counter of each chunk untouched.
-   \note extra sizeof(void *) bytes are allocated for each block to maintain
+   \note extra 2 * sizeof(void *) bytes are allocated for each block to maintain
    a list of allocated blocks
+   \note with adaptive sizes (see tchecker::adaptive_sizes), alloc_nb is the
+   number of chunks of the first block, and the following blocks are bigger
    \throw std::invalid argument when the precondition is not satisfied
    */
   pool_t(std::size_t alloc_nb, std::size_t alloc_size)
-      : _alloc_nb(alloc_nb), _alloc_size(std::max(alloc_size, MIN_ALLOC_SIZE)),
-        _block_size(_alloc_nb * _alloc_size + sizeof(void *)), _blocks_count(0), _free_head(nullptr), _block_head(nullptr),
-        _raw_head(nullptr), _raw_end(nullptr)
+      : _initial_alloc_nb(alloc_nb), _alloc_nb(alloc_nb), _alloc_size(std::max(alloc_size, MIN_ALLOC_SIZE)),
+        _adaptive(tchecker::adaptive_sizes()), _blocks_count(0), _chunks_count(0), _memsize(0), _free_head(nullptr),
+        _block_head(nullptr), _raw_head(nullptr), _raw_end(nullptr)
   {
     if (_alloc_nb < 1)
       throw std::invalid_argument("allocation number should be >= 1");
@@ -149,7 +166,7 @@ public:
     if (t == nullptr)
       return tchecker::intrusive_shared_ptr_t<T>(nullptr);
     // p points after the reference counter
-    void * p = static_cast<typename T::refcount_t *>(t) + 1;
+    void * p = static_cast<typename T::refcount_storage_t *>(t) + 1;
     try {
       T::construct(p, std::forward<ARGS>(args)...); // construct T in p with args
     }
@@ -179,14 +196,15 @@ public:
     if (p->refcount() > 1)
       return false;
 
+    // release the reference first: release() below marks the chunk FREE_CHUNK, which must not be decremented
     T * t = p.ptr();
+    p = nullptr;
+
     T::destruct(t);
 
-    typename T::refcount_t * chunk = reinterpret_cast<typename T::refcount_t *>(t) - 1;
+    typename T::refcount_storage_t * chunk = reinterpret_cast<typename T::refcount_storage_t *>(t) - 1;
     release(chunk);
 
-    p = nullptr;
-
     return true;
   }
 
@@ -205,7 +223,7 @@ public:
     // Move to the free list all chunks in blocks list that are not in the
     // free list and that are unused
     for (void * block = _block_head; block != nullptr; block = nextblock(block)) {
-      void * block_end = static_cast<char *>(block) + _block_size;
+      void * block_end = endblock(block);
 
       for (char * chunk = first_chunk_ptr(block); chunk != block_end; chunk += _alloc_size) {
         // Ignore chunks inside unused raw block (refcount not set yet)
@@ -213,7 +231,7 @@ public:
           break; // ignore the entire raw block
 
         // Collect all unused chunks in the free list
-        typename T::refcount_t * refcount = reinterpret_cast<typename T::refcount_t *>(chunk);
+        typename T::refcount_storage_t * refcount = reinterpret_cast<typename T::refcount_storage_t *>(chunk);
         if (*refcount == COLLECTABLE_CHUNK) {
           // make the chunk free using its refcount
           *refcount = FREE_CHUNK;
@@ -248,7 +266,7 @@ public:
     // - are not in free list
     // - are not in raw block
     for (void * block = _block_head; block != nullptr; block = nextblock(block)) {
-      void * block_end = static_cast<char *>(block) + _block_size;
+      void * block_end = endblock(block);
 
       for (char * chunk = first_chunk_ptr(block); chunk != block_end; chunk += _alloc_size) {
         // Ignore chunks inside unused raw block
@@ -256,7 +274,7 @@ public:
           break;
 
         // Destruct all chunks that are not free
-        typename T::refcount_t * refcount = reinterpret_cast<typename T::refcount_t *>(chunk);
+        typename T::refcount_storage_t * refcount = reinterpret_cast<typename T::refcount_storage_t *>(chunk);
 
         if (*refcount > T::REFCOUNT_MAX)
           continue;
@@ -290,7 +308,10 @@ public:
       p = nextblock(p);
       delete[] static_cast<char *>(tmp);
     }
+    _alloc_nb = _initial_alloc_nb;
     _blocks_count = 0;
+    _chunks_count = 0;
+    _memsize = 0;
     _free_head = nullptr; // _free_head_lock access protection useless
     _block_head = nullptr;
     _raw_head = nullptr;
@@ -302,7 +323,7 @@ public:
    \return Memory footprint of the pool
    \note Constant time
    */
-  inline constexpr std::size_t memsize() const { return (_blocks_count * _block_size); }
+  inline constexpr std::size_t memsize() const { return _memsize; }
 
   /*!
    \brief Register a collectable
@@ -316,7 +337,7 @@ public:
 
   /*!
    \brief Accessor
-   \return number of allocated objects per block
+   \return number of allocated objects in the next block
   */
   inline std::size_t alloc_nb() const { return _alloc_nb; }
 
@@ -328,9 +349,9 @@ public:
 
   /*!
    \brief Accessor
-   \return size of allocated blocks
+   \return size of the next allocated block
   */
-  inline std::size_t block_size() const { return _block_size; }
+  inline std::size_t block_size() const { return _alloc_nb * _alloc_size + BLOCK_HEADER_SIZE; }
 
   /*!
    \brief Accessor
@@ -338,7 +359,24 @@ public:
   */
   inline std::size_t blocks_count() const { return _blocks_count; }
 
+  /*!
+   \brief Accessor
+   \return number of chunks in the allocated blocks
+  */
+  inline std::size_t chunks_count() const { return _chunks_count; }
+
+  /*!
+   \brief Accessor
+   \return true if the blocks of this pool grow geometrically, false if they all have the same size
+  */
+  inline bool adaptive() const { return _adaptive; }
+
 protected:
+  /*!
+   \brief Size of the header of blocks: pointer to next block, and pointer to the end of the block
+   */
+  static constexpr std::size_t BLOCK_HEADER_SIZE = 2 * sizeof(void *);
+
   /*!
    \brief Accessor to next chunk
    \param ptr : pointer to a chunk
@@ -349,7 +387,7 @@ protected:
    */
   static constexpr void *& nextchunk(void * const ptr)
   {
-    return *(reinterpret_cast<void **>(static_cast<typename T::refcount_t *>(ptr) + 1));
+    return *(reinterpret_cast<void **>(static_cast<typename T::refcount_storage_t *>(ptr) + 1));
   }
 
   /*!
@@ -362,13 +400,22 @@ protected:
    */
   static constexpr void *& nextblock(void * const ptr) { return *(reinterpret_cast<void **>(ptr)); }
 
+  /*!
+   \brief Accessor to end of block
+   \param ptr : pointer to a block
+   \return mutable past-the-end address of the block at ptr
+   \pre the past-the-end address is stored in the second sizeof(void*) bytes
+   of the block
+   */
+  static constexpr void *& endblock(void * const ptr) { return *(reinterpret_cast<void **>(ptr) + 1); }
+
   /*!
    \brief Accessor
    \param block : address of a block
    \return address of first chunk in block
-   \pre the first chunk is located sizeof(void *) bytes after block
+   \pre the first chunk is located BLOCK_HEADER_SIZE bytes after block
    */
-  static constexpr char * first_chunk_ptr(void * const block) { return (static_cast<char *>(block) + sizeof(void *)); }
+  static constexpr char * first_chunk_ptr(void * const block) { return (static_cast<char *>(block) + BLOCK_HEADER_SIZE); }
 
   /*!
    \brief Memory allocation
@@ -380,7 +427,7 @@ protected:
   {
     // Allocate from the raw block if possible
     if (_raw_head != _raw_end) {
-      typename T::refcount_t * chunk = reinterpret_cast<typename T::refcount_t *>(allocate_chunk_from_raw_block());
+      typename T::refcount_storage_t * chunk = reinterpret_cast<typename T::refcount_storage_t *>(allocate_chunk_from_raw_block());
       *chunk = 0; // set reference counter
       return chunk;
     }
@@ -395,14 +442,14 @@ protected:
     }
 
     if (_free_head != nullptr) {
-      typename T::refcount_t * chunk = reinterpret_cast<typename T::refcount_t *>(allocate_chunk_from_free_list());
+      typename T::refcount_storage_t * chunk = reinterpret_cast<typename T::refcount_storage_t *>(allocate_chunk_from_free_list());
       *chunk = 0; // set reference counter
       return chunk;
     }
 
     // Allocate a new raw block, and allocate from the block
     allocate_raw_block();
-    typename T::refcount_t * chunk = reinterpret_cast<typename T::refcount_t *>(allocate_chunk_from_raw_block());
+    typename T::refcount_storage_t * chunk = reinterpret_cast<typename T::refcount_storage_t *>(allocate_chunk_from_raw_block());
     *chunk = 0; // set reference counter
     return chunk;
   }
@@ -417,15 +464,22 @@ protected:
   {
     assert(_raw_head == _raw_end);
     // allocate
-    _raw_head = new char[_block_size];
-    _raw_end = _raw_head + _block_size;
+    std::size_t const block_size = this->block_size();
+    _raw_head = new char[block_size];
+    _raw_end = _raw_head + block_size;
     // link to allocated blocks
     nextblock(_raw_head) = _block_head;
+    endblock(_raw_head) = _raw_end;
     _block_head = _raw_head;
-    // jump over 1st word used for linking chunks
+    // jump over the header used for linking blocks
     _raw_head = first_chunk_ptr(_raw_head);
     // count one more block
     ++_blocks_count;
+    _chunks_count += _alloc_nb;
+    _memsize += block_size;
+    // the next block is twice bigger, as long as it does not exceed MAX_ADAPTIVE_BLOCK_SIZE
+    if (_adaptive && 2 * _alloc_nb * _alloc_size + BLOCK_HEADER_SIZE <= MAX_ADAPTIVE_BLOCK_SIZE)
+      _alloc_nb *= 2;
   }
 
   /*!
@@ -463,7 +517,7 @@ protected:
    */
   void release(void const * chunk)
   {
-    typename T::refcount_t * refcount = static_cast<typename T::refcount_t *>(const_cast<void *>(chunk));
+    typename T::refcount_storage_t * refcount = static_cast<typename T::refcount_storage_t *>(const_cast<void *>(chunk));
     *refcount = FREE_CHUNK;
     this->release(chunk, chunk);
   }
@@ -486,10 +540,13 @@ protected:
     _free_head = static_cast<char *>(pbegin);
   }
 
-  std::size_t const _alloc_nb;                                         /*!< number of chunks per block */
+  std::size_t const _initial_alloc_nb;                                 /*!< number of chunks of the first block */
+  std::size_t _alloc_nb;                                               /*!< number of chunks of the next block */
   std::size_t const _alloc_size;                                       /*!< size of a chunk (bytes) */
-  std::size_t const _block_size;                                       /*!< size of a block (bytes) */
+  bool const _adaptive;                                                /*!< geometric growth of blocks */
   std::size_t _blocks_count;                                           /*!< number of allocated blocks */
+  std::size_t _chunks_count;                                           /*!< number of chunks in allocated blocks */
+  std::size_t _memsize;                                                /*!< size of allocated blocks (bytes) */
   char * _free_head;                                                   /*!< head pointer to list of free chunks */
   char * _block_head;                                                  /*!< head pointer to list of blocks */
   char * _raw_head;                                                    /*!< pointer to raw block */
@@ -497,6 +554,279 @@ protected:
   std::vector<std::shared_ptr<tchecker::collectable_t>> _collectables; /*!< collectable data structures for memory collection */
 };
 
+namespace details {
+
+/*!
+ \brief Accessor
+ \return index of the calling thread
+ \note threads are numbered 0, 1, 2, ... in the order of their first call to this function
+ */
+inline std::size_t this_thread_index()
+{
+  static std::atomic<std::size_t> threads_count{0};
+  thread_local std::size_t const index = threads_count.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+} // end of namespace details
+
+/*!
+ \class sharded_pool_t
+ \brief Thread-safe pool allocator
+ \tparam T : type of allocated objects. Should be tchecker::make_shared_t<Y, std::atomic<U>> for some Y and U
+ \note Chunks are allocated from shards. Each shard is a tchecker::pool_t protected by a spin lock. Threads
+ are mapped to shards in the order of their first allocation, hence the lock of a shard is only contended when
+ there are more threads than shards
+ \note The shard that owns a chunk is stored in an extra word after the object. Chunks destructed from a thread
+ that does not own them are pushed to a lock-free list of their shard, then the shard reuses them on its next
+ allocation. Chunks that are no longer referenced are collected by their shard, as in tchecker::pool_t
+ */
+template <class T> class sharded_pool_t {
+  static_assert(T::REFCOUNT_IS_ATOMIC, "objects shared between threads need atomic reference counters");
+
+public:
+  /*!
+   \brief Type of allocated objects
+   */
+  using t = T;
+
+  /*!
+   \brief Type of pointer to allocated objects
+   */
+  using ptr_t = tchecker::intrusive_shared_ptr_t<T>;
+
+  /*!
+   \brief Constructor
+   \param alloc_nb : number of chunks in a block (allocation unit) of each shard
+   \param alloc_size : fixed size of objects
+   \param shards : number of shards, 0 for the number of hardware threads
+   \pre alloc_nb >= 1
+   \throw std::invalid argument when the precondition is not satisfied
+   */
+  sharded_pool_t(std::size_t alloc_nb, std::size_t alloc_size, std::size_t shards = 0) : _owner_offset(owner_offset(alloc_size))
+  {
+    if (shards == 0)
+      shards = std::max(1u, std::thread::hardware_concurrency());
+    _shards.reserve(shards);
+    for (std::size_t i = 0; i < shards; ++i)
+      _shards.emplace_back(new shard_t(alloc_nb, _owner_offset + sizeof(shard_t *)));
+  }
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  sharded_pool_t(tchecker::sharded_pool_t<T> const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  sharded_pool_t(tchecker::sharded_pool_t<T> &&) = delete;
+
+  /*!
+   \brief Destructor
+   \post All the objects allocated by the pool have been destructed
+   */
+  ~sharded_pool_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::sharded_pool_t<T> & operator=(tchecker::sharded_pool_t<T> const &) = delete;
+
+  /*!
+   \brief Move assignment operator (deleted)
+   */
+  tchecker::sharded_pool_t<T> & operator=(tchecker::sharded_pool_t<T> &&) = delete;
+
+  /*!
+   \brief Construct an object
+   \param args : parameters to a constructor of type T
+   \return A new instance of T built with args and allocated from the shard of the calling thread
+   */
+  template <class... ARGS> tchecker::intrusive_shared_ptr_t<T> construct(ARGS &&... args)
+  {
+    shard_t & shard = local_shard();
+    std::lock_guard<tchecker::spinlock_t> lock(shard.lock);
+    reclaim(shard);
+    tchecker::intrusive_shared_ptr_t<T> p = shard.pool.construct(std::forward<ARGS>(args)...);
+    if (p.ptr() != nullptr)
+      owner(p.ptr()) = &shard;
+    return p;
+  }
+
+  /*!
+   \brief Destruct an object
+   \param p : pointer to object
+   \pre p has been allocated by this pool
+   \post if the reference counter of p is 1, then the object pointed by p has been destructed, p has been
+   set to nullptr, and the memory has been released to the shard that owns it. Otherwise, if p points to
+   nullptr, or if the reference counter of p is greater than 1, nothing happens
+   \return true if the object pointed by p has been destructed, false otherwise
+   */
+  bool destruct(tchecker::intrusive_shared_ptr_t<T> & p)
+  {
+    if (p.ptr() == nullptr)
+      return false;
+    if (p->refcount() > 1)
+      return false;
+
+    shard_t * shard = owner(p.ptr());
+    if (shard == &local_shard()) {
+      std::lock_guard<tchecker::spinlock_t> lock(shard->lock);
+      return shard->pool.destruct(p);
+    }
+
+    T * t = p.ptr();
+    p = nullptr;
+    T::destruct(t);
+
+    typename T::refcount_storage_t * chunk = reinterpret_cast<typename T::refcount_storage_t *>(t) - 1;
+    *chunk = tchecker::pool_t<T>::FREE_CHUNK;
+    void * head = shard->remote.load(std::memory_order_relaxed);
+    do {
+      shard_pool_t::next(chunk) = head;
+    } while (!shard->remote.compare_exchange_weak(head, chunk, std::memory_order_release, std::memory_order_relaxed));
+    return true;
+  }
+
+  /*!
+   \brief Collects unused chunks
+   \post all shards have collected the chunks released by other threads, and their unused chunks
+   (see tchecker::pool_t::collect)
+   \return Number of collected chunks
+   */
+  std::size_t collect()
+  {
+    std::size_t collected = 0;
+    for (auto & shard : _shards) {
+      std::lock_guard<tchecker::spinlock_t> lock(shard->lock);
+      reclaim(*shard);
+      collected += shard->pool.collect();
+    }
+    return collected;
+  }
+
+  /*!
+   \brief Destruct all the objects allocated by the pool
+   \pre no other thread uses this pool
+   \post All the objects allocated by the pool have been destructed. All the memory allocated by the pool has
+   been freed. The pool is empty.
+   */
+  void destruct_all()
+  {
+    for (auto & shard : _shards) {
+      shard->remote.store(nullptr, std::memory_order_relaxed);
+      shard->pool.destruct_all();
+    }
+  }
+
+  /*!
+   \brief Accessor
+   \return Memory footprint of the pool
+   \note the result may be outdated if other threads allocate from the pool concurrently
+   */
+  std::size_t memsize() const
+  {
+    std::size_t memsize = 0;
+    for (auto & shard : _shards) {
+      std::lock_guard<tchecker::spinlock_t> lock(shard->lock);
+      memsize += shard->pool.memsize();
+    }
+    return memsize;
+  }
+
+  /*!
+   \brief Accessor
+   \return number of shards
+   */
+  inline std::size_t shards_count() const { return _shards.size(); }
+
+private:
+  /*!
+   \class shard_pool_t
+   \brief Pool of a shard, with access to its free list
+   */
+  class shard_pool_t : public tchecker::pool_t<T> {
+  public:
+    using tchecker::pool_t<T>::pool_t;
+
+    /*!
+     \brief Release a list of chunks
+     \param begin : first chunk in the list
+     \param end : last chunk in the list
+     \pre see tchecker::pool_t::release
+     \post All the chunks in the list begin..end have been released
+     */
+    inline void release_list(void * begin, void * end) { this->release(begin, end); }
+
+    /*!
+     \brief Accessor to next chunk
+     \param ptr : pointer to a chunk
+     \return mutable address of the next chunk in the list of chunks starting at ptr
+     */
+    static inline void *& next(void * ptr) { return tchecker::pool_t<T>::nextchunk(ptr); }
+  };
+
+  /*!
+   \brief Shard: pool, lock and list of chunks released by other threads, on their own cache lines
+   */
+  struct alignas(64) shard_t {
+    shard_t(std::size_t alloc_nb, std::size_t alloc_size) : pool(alloc_nb, alloc_size), remote(nullptr) {}
+
+    tchecker::spinlock_t lock;  /*!< Lock on pool */
+    shard_pool_t pool;          /*!< Pool */
+    std::atomic<void *> remote; /*!< Chunks released by other threads */
+  };
+
+  /*!
+   \brief Offset of the owner shard in chunks
+   \param alloc_size : size of objects
+   \return offset of the first word after alloc_size bytes that does not overlap the free list link
+   */
+  static constexpr std::size_t owner_offset(std::size_t alloc_size)
+  {
+    std::size_t const size = std::max(alloc_size, tchecker::pool_t<T>::MIN_ALLOC_SIZE);
+    return (size + alignof(shard_t *) - 1) / alignof(shard_t *) * alignof(shard_t *);
+  }
+
+  /*!
+   \brief Accessor
+   \param t : an object allocated by this pool
+   \return the owner shard of t
+   */
+  inline shard_t *& owner(T * t) const
+  {
+    char * chunk = reinterpret_cast<char *>(reinterpret_cast<typename T::refcount_storage_t *>(t) - 1);
+    return *reinterpret_cast<shard_t **>(chunk + _owner_offset);
+  }
+
+  /*!
+   \brief Accessor
+   \return the shard of the calling thread
+   */
+  inline shard_t & local_shard() { return *_shards[tchecker::details::this_thread_index() % _shards.size()]; }
+
+  /*!
+   \brief Reuse chunks released by other threads
+   \param shard : a shard
+   \pre the lock of shard is held
+   \post the chunks released to shard by other threads have been added to the free list of its pool
+   */
+  static void reclaim(shard_t & shard)
+  {
+    void * begin = shard.remote.exchange(nullptr, std::memory_order_acquire);
+    if (begin == nullptr)
+      return;
+    void * end = begin;
+    while (shard_pool_t::next(end) != nullptr)
+      end = shard_pool_t::next(end);
+    shard.pool.release_list(begin, end);
+  }
+
+  std::size_t const _owner_offset;               /*!< Offset of owner shard in chunks */
+  std::vector<std::unique_ptr<shard_t>> _shards; /*!< Shards */
+};
+
 } // end of namespace tchecker
 
 #endif // TCHECKER_POOL_HH
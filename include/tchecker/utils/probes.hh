@@ -0,0 +1,57 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_PROBES_HH
+#define TCHECKER_PROBES_HH
+
+#include <cstdint>
+
+/*!
+ \file probes.hh
+ \brief Trace points on hot paths (USDT probes)
+ \note Trace points are compiled in when TCHECKER_PROBES is defined (CMake option TCHECKER_PROBES), and expand to
+ nothing otherwise. They are defined as USDT probes of provider tchecker when <sys/sdt.h> is available, which can be
+ listed with perf list sdt_tchecker:* or bpftrace -l 'usdt:tck-reach:tchecker:*', and enabled on running processes.
+ Otherwise, every trace point calls tchecker_probe(name, a1, a2), which can be traced as a uprobe
+ */
+
+#if defined(TCHECKER_PROBES) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#define TCHECKER_PROBES_SDT
+#endif
+#endif
+
+#if defined(TCHECKER_PROBES) && defined(TCHECKER_PROBES_SDT)
+
+#include <sys/sdt.h>
+
+#define TCHECKER_PROBE0(name) DTRACE_PROBE(tchecker, name)
+#define TCHECKER_PROBE1(name, a1) DTRACE_PROBE1(tchecker, name, a1)
+#define TCHECKER_PROBE2(name, a1, a2) DTRACE_PROBE2(tchecker, name, a1, a2)
+
+#elif defined(TCHECKER_PROBES)
+
+/*!
+ \brief Trace point
+ \param name : name of the trace point
+ \param a1 : first argument
+ \param a2 : second argument
+ \post does nothing, this function is never inlined so that it can be traced as a uprobe, e.g.
+ bpftrace -e 'uprobe:tck-reach:tchecker_probe { @[str(arg0)] = count(); }' -p PID
+ */
+extern "C" void tchecker_probe(char const * name, std::uintptr_t a1, std::uintptr_t a2);
+
+#define TCHECKER_PROBE0(name) tchecker_probe(#name, 0, 0)
+#define TCHECKER_PROBE1(name, a1) tchecker_probe(#name, (std::uintptr_t)(a1), 0)
+#define TCHECKER_PROBE2(name, a1, a2) tchecker_probe(#name, (std::uintptr_t)(a1), (std::uintptr_t)(a2))
+
+#else
+
+#define TCHECKER_PROBE0(name) ((void)0)
+#define TCHECKER_PROBE1(name, a1) ((void)0)
+#define TCHECKER_PROBE2(name, a1, a2) ((void)0)
+
+#endif
+
+#endif // TCHECKER_PROBES_HH
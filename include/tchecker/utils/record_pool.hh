@@ -0,0 +1,408 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_RECORD_POOL_HH
+#define TCHECKER_RECORD_POOL_HH
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "tchecker/utils/shared_objects.hh"
+
+/*!
+ \file record_pool.hh
+ \brief Pool allocator of records of three shared objects
+ */
+
+namespace tchecker {
+
+/*!
+ \class record_pool_t
+ \brief Pool allocator of records that store three shared objects contiguously
+ \tparam T1 : type of first objects, should derive from tchecker::make_shared_t<Y> for some Y
+ \tparam T2 : type of second objects, should derive from tchecker::make_shared_t<Y> for some Y
+ \tparam T3 : type of third objects, should derive from tchecker::make_shared_t<Y> for some Y
+ \note A record stores an object of type T1, an object of type T2 and an object of type T3, each one preceded by its
+ reference counter (as in tchecker::pool_t). Objects are constructed together, in the same record, but they are
+ referenced and destructed separately: a record is released once its three objects have been destructed
+ \note Records are allocated by blocks of alloc_nb records. The pool is *NOT* thread-safe
+ */
+template <class T1, class T2, class T3> class record_pool_t {
+  static_assert(!std::is_same<T1, T2>::value && !std::is_same<T1, T3>::value && !std::is_same<T2, T3>::value,
+                "T1, T2 and T3 should be distinct types");
+
+public:
+  /*!
+   \brief Constructor
+   \param alloc_nb : number of records in a block (allocation unit)
+   \param alloc_size1 : allocation size of objects of type T1
+   \param alloc_size2 : allocation size of objects of type T2
+   \param alloc_size3 : allocation size of objects of type T3
+   \pre alloc_nb >= 1
+   \note allocation sizes should be determined by tchecker::allocation_size_t, as for tchecker::pool_t
+   \throw std::invalid_argument : if alloc_nb is 0
+   */
+  record_pool_t(std::size_t alloc_nb, std::size_t alloc_size1, std::size_t alloc_size2, std::size_t alloc_size3)
+      : _alloc_nb(alloc_nb), _offset2(align(std::max(alloc_size1, MIN_ALLOC_SIZE))), _offset3(_offset2 + align(alloc_size2)),
+        _record_size(_offset3 + align(alloc_size3)), _memsize(0), _free_head(nullptr)
+  {
+    if (_alloc_nb < 1)
+      throw std::invalid_argument("allocation number should be >= 1");
+  }
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  record_pool_t(tchecker::record_pool_t<T1, T2, T3> const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  record_pool_t(tchecker::record_pool_t<T1, T2, T3> &&) = delete;
+
+  /*!
+   \brief Destructor
+   \post All the objects allocated by the pool have been destructed
+   */
+  ~record_pool_t() { destruct_all(); }
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::record_pool_t<T1, T2, T3> & operator=(tchecker::record_pool_t<T1, T2, T3> const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::record_pool_t<T1, T2, T3> & operator=(tchecker::record_pool_t<T1, T2, T3> &&) = delete;
+
+  /*!
+   \brief Construct the objects of a record
+   \param arg1 : parameter to a constructor of type T1
+   \param arg2 : parameter to a constructor of type T2
+   \param arg3 : parameter to a constructor of type T3
+   \return new instances of T1, T2 and T3 built from arg1, arg2 and arg3, and allocated in the same record
+   \note collects unused records before allocating a new block
+   */
+  template <class A1, class A2, class A3>
+  std::tuple<tchecker::intrusive_shared_ptr_t<T1>, tchecker::intrusive_shared_ptr_t<T2>, tchecker::intrusive_shared_ptr_t<T3>>
+  construct(A1 && arg1, A2 && arg2, A3 && arg3)
+  {
+    char * record = allocate();
+    T1 * t1 = object<T1>(record, 0);
+    T2 * t2 = object<T2>(record, _offset2);
+    T3 * t3 = object<T3>(record, _offset3);
+    try {
+      T1::construct(t1, std::forward<A1>(arg1));
+    }
+    catch (...) {
+      release(record);
+      throw;
+    }
+    try {
+      T2::construct(t2, std::forward<A2>(arg2));
+    }
+    catch (...) {
+      T1::destruct(t1);
+      release(record);
+      throw;
+    }
+    try {
+      T3::construct(t3, std::forward<A3>(arg3));
+    }
+    catch (...) {
+      T2::destruct(t2);
+      T1::destruct(t1);
+      release(record);
+      throw;
+    }
+    return std::make_tuple(tchecker::intrusive_shared_ptr_t<T1>(t1), tchecker::intrusive_shared_ptr_t<T2>(t2),
+                           tchecker::intrusive_shared_ptr_t<T3>(t3));
+  }
+
+  /*!
+   \brief Destruct an object
+   \param p : pointer to object
+   \pre p has been allocated by this pool
+   \post if the reference counter of p is 1, then the object pointed by p has been destructed, and p has been set to
+   nullptr. The record of the object has been released if it has no other object left. Otherwise, if p points to nullptr,
+   or if the reference counter of p is greater than 1, nothing happens
+   \return true if the object pointed by p has been destructed, false otherwise
+   */
+  bool destruct(tchecker::intrusive_shared_ptr_t<T1> & p) { return destruct_object(p, 0); }
+
+  /*!
+   \brief Destruct an object
+   \param p : pointer to object
+   \pre p has been allocated by this pool
+   \post see destruct(tchecker::intrusive_shared_ptr_t<T1> &)
+   \return true if the object pointed by p has been destructed, false otherwise
+   */
+  bool destruct(tchecker::intrusive_shared_ptr_t<T2> & p) { return destruct_object(p, _offset2); }
+
+  /*!
+   \brief Destruct an object
+   \param p : pointer to object
+   \pre p has been allocated by this pool
+   \post see destruct(tchecker::intrusive_shared_ptr_t<T1> &)
+   \return true if the object pointed by p has been destructed, false otherwise
+   */
+  bool destruct(tchecker::intrusive_shared_ptr_t<T3> & p) { return destruct_object(p, _offset3); }
+
+  /*!
+   \brief Collect unused records
+   \post All objects with reference counter 0 have been destructed, and all the records without objects left have been
+   released
+   \return Number of collected records
+   */
+  std::size_t collect()
+  {
+    std::size_t collected = 0;
+    for (char * block : _blocks)
+      for (char * record = block; record != block + _alloc_nb * _record_size; record += _record_size) {
+        if (is_free(record))
+          continue;
+        collect_object<T1>(record, 0);
+        collect_object<T2>(record, _offset2);
+        collect_object<T3>(record, _offset3);
+        if (is_free(record)) {
+          push_free(record);
+          ++collected;
+        }
+      }
+    return collected;
+  }
+
+  /*!
+   \brief Destruct all the objects allocated by the pool
+   \post All the objects allocated by the pool have been destructed. All the memory allocated by the pool has been
+   freed. The pool is empty
+   */
+  void destruct_all()
+  {
+    for (char * block : _blocks) {
+      for (char * record = block; record != block + _alloc_nb * _record_size; record += _record_size) {
+        destruct_unused_object<T1>(record, 0);
+        destruct_unused_object<T2>(record, _offset2);
+        destruct_unused_object<T3>(record, _offset3);
+      }
+      delete[] block;
+    }
+    _blocks.clear();
+    _memsize = 0;
+    _free_head = nullptr;
+  }
+
+  /*!
+   \brief Accessor
+   \return Memory footprint of the pool
+   */
+  inline std::size_t memsize() const { return _memsize; }
+
+  /*!
+   \brief Accessor
+   \return size of records (bytes)
+   */
+  inline std::size_t record_size() const { return _record_size; }
+
+private:
+  /*!
+   \brief Minimal allocation size of objects of type T1, which store the link to the next free record
+   */
+  static constexpr std::size_t MIN_ALLOC_SIZE = sizeof(typename T1::refcount_storage_t) + sizeof(void *);
+
+  /*!
+   \brief Value of the reference counter of destructed objects
+   */
+  template <class T> static constexpr typename T::refcount_t FREE_OBJECT = T::REFCOUNT_MAX + 1;
+
+  /*!
+   \brief Alignment of objects in a record
+   \param size : a size
+   \return the smallest multiple of the alignment of pointers that is not smaller than size
+   */
+  static constexpr std::size_t align(std::size_t size)
+  {
+    return (size + alignof(void *) - 1) / alignof(void *) * alignof(void *);
+  }
+
+  /*!
+   \brief Accessor
+   \param record : a record
+   \param offset : offset of an object of type T in record
+   \return address of the reference counter of the object of type T in record
+   */
+  template <class T> static typename T::refcount_storage_t * refcount(char * record, std::size_t offset)
+  {
+    return reinterpret_cast<typename T::refcount_storage_t *>(record + offset);
+  }
+
+  /*!
+   \brief Accessor
+   \param record : a record
+   \param offset : offset of an object of type T in record
+   \return address of the object of type T in record
+   */
+  template <class T> static T * object(char * record, std::size_t offset)
+  {
+    return reinterpret_cast<T *>(refcount<T>(record, offset) + 1);
+  }
+
+  /*!
+   \brief Accessor
+   \param record : a free record
+   \return mutable address of the next free record, stored after the first reference counter of record
+   */
+  static void *& nextrecord(char * record) { return *reinterpret_cast<void **>(refcount<T1>(record, 0) + 1); }
+
+  /*!
+   \brief Check if a record is free
+   \param record : a record
+   \return true if the three objects in record have been destructed, false otherwise
+   */
+  bool is_free(char * record) const
+  {
+    return *refcount<T1>(record, 0) == FREE_OBJECT<T1> && *refcount<T2>(record, _offset2) == FREE_OBJECT<T2> &&
+           *refcount<T3>(record, _offset3) == FREE_OBJECT<T3>;
+  }
+
+  /*!
+   \brief Destruct an object
+   \param p : pointer to an object of type T
+   \param offset : offset of objects of type T in records
+   \post see destruct(tchecker::intrusive_shared_ptr_t<T1> &)
+   \return true if the object pointed by p has been destructed, false otherwise
+   */
+  template <class T> bool destruct_object(tchecker::intrusive_shared_ptr_t<T> & p, std::size_t offset)
+  {
+    if (p.ptr() == nullptr)
+      return false;
+    if (p->refcount() > 1)
+      return false;
+
+    // release the reference first: the reference counter is set to FREE_OBJECT below, which must not be decremented
+    T * t = p.ptr();
+    p = nullptr;
+
+    T::destruct(t);
+
+    typename T::refcount_storage_t * rc = reinterpret_cast<typename T::refcount_storage_t *>(t) - 1;
+    *rc = FREE_OBJECT<T>;
+    char * record = reinterpret_cast<char *>(rc) - offset;
+    if (is_free(record))
+      push_free(record);
+
+    return true;
+  }
+
+  /*!
+   \brief Collect an object
+   \param record : a record
+   \param offset : offset of objects of type T in records
+   \post the object of type T in record has been destructed if its reference counter is 0
+   */
+  template <class T> static void collect_object(char * record, std::size_t offset)
+  {
+    typename T::refcount_storage_t * rc = refcount<T>(record, offset);
+    if (*rc != 0)
+      return;
+    *rc = FREE_OBJECT<T>;
+    T::destruct(object<T>(record, offset));
+  }
+
+  /*!
+   \brief Destruct an object that is not referenced anymore
+   \param record : a record
+   \param offset : offset of objects of type T in records
+   \pre the object of type T in record is free or has reference counter 0 (checked by assertion)
+   \post the object of type T in record has been destructed if it was not free
+   */
+  template <class T> static void destruct_unused_object(char * record, std::size_t offset)
+  {
+    typename T::refcount_storage_t * rc = refcount<T>(record, offset);
+    if (*rc > T::REFCOUNT_MAX)
+      return;
+    assert(*rc == 0);
+    *rc = FREE_OBJECT<T>;
+    T::destruct(object<T>(record, offset));
+  }
+
+  /*!
+   \brief Memory allocation
+   \return a record with its three objects free
+   \throw std::bad_alloc : if no memory left (i.e. when operator new throws)
+   \note collects unused records if needed
+   */
+  char * allocate()
+  {
+    if (_free_head == nullptr)
+      collect();
+    if (_free_head == nullptr)
+      allocate_block();
+    char * record = _free_head;
+    _free_head = static_cast<char *>(nextrecord(record));
+    return record;
+  }
+
+  /*!
+   \brief Allocate a new block
+   \post A new block has been allocated, and all its records have been added to the list of free records
+   */
+  void allocate_block()
+  {
+    std::size_t const block_size = _alloc_nb * _record_size;
+    char * block = new char[block_size];
+    _blocks.push_back(block);
+    _memsize += block_size;
+    for (char * record = block + block_size; record != block;) {
+      record -= _record_size;
+      new (refcount<T1>(record, 0)) typename T1::refcount_storage_t(FREE_OBJECT<T1>);
+      new (refcount<T2>(record, _offset2)) typename T2::refcount_storage_t(FREE_OBJECT<T2>);
+      new (refcount<T3>(record, _offset3)) typename T3::refcount_storage_t(FREE_OBJECT<T3>);
+      push_free(record);
+    }
+  }
+
+  /*!
+   \brief Release a record
+   \param record : a record returned by allocate()
+   \pre the objects in record have not been constructed, or they have been destructed
+   \post the three objects in record are free, and record has been added to the list of free records
+   */
+  void release(char * record)
+  {
+    *refcount<T1>(record, 0) = FREE_OBJECT<T1>;
+    *refcount<T2>(record, _offset2) = FREE_OBJECT<T2>;
+    *refcount<T3>(record, _offset3) = FREE_OBJECT<T3>;
+    push_free(record);
+  }
+
+  /*!
+   \brief Add a record to the list of free records
+   \param record : a free record
+   \post record is the head of the list of free records
+   */
+  void push_free(char * record)
+  {
+    nextrecord(record) = _free_head;
+    _free_head = record;
+  }
+
+  std::size_t const _alloc_nb;    /*!< number of records in a block */
+  std::size_t const _offset2;     /*!< offset of objects of type T2 in records */
+  std::size_t const _offset3;     /*!< offset of objects of type T3 in records */
+  std::size_t const _record_size; /*!< size of a record (bytes) */
+  std::size_t _memsize;           /*!< size of allocated blocks (bytes) */
+  char * _free_head;              /*!< head pointer to list of free records */
+  std::vector<char *> _blocks;    /*!< allocated blocks */
+};
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_RECORD_POOL_HH
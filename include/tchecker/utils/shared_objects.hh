@@ -5,8 +5,11 @@
 #ifndef TCHECKER_SHARED_OBJECTS_HH
 #define TCHECKER_SHARED_OBJECTS_HH
 
+#include <atomic>
 #include <exception>
 #include <limits>
+#include <new>
+#include <type_traits>
 
 #if BOOST_VERSION <= 106600
 #include <boost/functional/hash.hpp>
@@ -23,6 +26,95 @@
 
 namespace tchecker {
 
+// reference counters
+
+/*!
+ \class refcount_traits_t
+ \brief Operations on reference counters
+ \tparam REFCOUNT : type of reference counter, an unsigned integer type
+ \note plain integer operations: reference counters are not thread-safe
+ */
+template <class REFCOUNT> class refcount_traits_t {
+public:
+  /*!
+   \brief Type of values of reference counters
+   */
+  using value_t = REFCOUNT;
+
+  /*!
+   \brief Thread-safety of reference counters
+   */
+  static constexpr bool const is_atomic = false;
+
+  /*!
+   \brief Increment
+   \param r : a reference counter
+   \post r has been incremented
+   \return the value of r after increment
+   */
+  static inline value_t increment(REFCOUNT & r) { return ++r; }
+
+  /*!
+   \brief Decrement
+   \param r : a reference counter
+   \post r has been decremented
+   \return the value of r after decrement
+   */
+  static inline value_t decrement(REFCOUNT & r) { return --r; }
+
+  /*!
+   \brief Accessor
+   \param r : a reference counter
+   \return the value of r
+   */
+  static inline value_t load(REFCOUNT const & r) { return r; }
+};
+
+/*!
+ \class refcount_traits_t<std::atomic<U>>
+ \brief Operations on atomic reference counters
+ \tparam U : type of values of reference counters, an unsigned integer type
+ \note reference counters can be updated from several threads. Increment is relaxed (a new reference
+ is always obtained from an existing one), decrement synchronizes with the release of the last reference
+ */
+template <class U> class refcount_traits_t<std::atomic<U>> {
+public:
+  /*!
+   \brief Type of values of reference counters
+   */
+  using value_t = U;
+
+  /*!
+   \brief Thread-safety of reference counters
+   */
+  static constexpr bool const is_atomic = true;
+
+  static_assert(std::atomic<U>::is_always_lock_free, "atomic reference counters should be lock-free");
+
+  /*!
+   \brief Increment
+   \param r : a reference counter
+   \post r has been incremented
+   \return the value of r after increment
+   */
+  static inline value_t increment(std::atomic<U> & r) { return r.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+  /*!
+   \brief Decrement
+   \param r : a reference counter
+   \post r has been decremented
+   \return the value of r after decrement
+   */
+  static inline value_t decrement(std::atomic<U> & r) { return r.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+
+  /*!
+   \brief Accessor
+   \param r : a reference counter
+   \return the value of r
+   */
+  static inline value_t load(std::atomic<U> const & r) { return r.load(std::memory_order_acquire); }
+};
+
 // shared objects
 
 /*!
@@ -30,7 +122,9 @@ namespace tchecker {
  \brief Functor to create a shared class from a given class. Adds a reference
  counter to the given class.
  \tparam T : type to share
- \tparam REFCOUNT : type of the reference counter. Must be an unsigned type.
+ \tparam REFCOUNT : type of the reference counter. Must be an unsigned type, or
+ std::atomic<U> for an unsigned type U when shared objects are referenced from several threads
+ (see tchecker::refcount_traits_t)
  \tparam RESERVED : number of reserved values of the reference counter
  \note The reference counter is stored by allocating sizeof(REFCOUNT) extra
  bytes of memory. These bytes are stored at the beginning of the allocated
@@ -44,7 +138,10 @@ namespace tchecker {
  */
 template <class T, class REFCOUNT = std::size_t, std::size_t RESERVED = 1> class make_shared_t final : public T {
 
-  static_assert(std::is_unsigned<REFCOUNT>::value, "REFCOUNT must be an unsigned type");
+  using refcount_traits_t = tchecker::refcount_traits_t<REFCOUNT>;
+
+  static_assert(std::is_unsigned<typename refcount_traits_t::value_t>::value, "REFCOUNT must be an unsigned type");
+  static_assert(sizeof(REFCOUNT) == sizeof(typename refcount_traits_t::value_t), "REFCOUNT should have the size of its values");
   static_assert(sizeof(REFCOUNT) % alignof(T *) == 0, "REFCOUNT size must be a multiple of pointer alignment");
 
 public:
@@ -54,9 +151,24 @@ public:
   using object_t = T;
 
   /*!
-   \brief Type of reference counter
+   \brief Type of values of the reference counter
    */
-  using refcount_t = REFCOUNT;
+  using refcount_t = typename refcount_traits_t::value_t;
+
+  /*!
+   \brief Type of the reference counter as stored in memory (REFCOUNT)
+   */
+  using refcount_storage_t = REFCOUNT;
+
+  /*!
+   \brief Number of reserved values of the reference counter
+   */
+  constexpr static std::size_t REFCOUNT_RESERVED = RESERVED;
+
+  /*!
+   \brief Thread-safety of the reference counter
+   */
+  constexpr static bool REFCOUNT_IS_ATOMIC = refcount_traits_t::is_atomic;
 
   /*!
    \brief Maximal value of the reference counter
@@ -160,9 +272,7 @@ public:
    */
   inline void take_reference(void) const
   {
-    refcount_t * refcount = refcount_addr();
-    *refcount += 1;
-    if (*refcount == REFCOUNT_MAX) // overflow
+    if (refcount_traits_t::increment(*refcount_addr()) == REFCOUNT_MAX) // overflow
       throw std::overflow_error("reference counter overflow");
   }
 
@@ -174,17 +284,17 @@ public:
    */
   inline void release_reference(void) const
   {
-    refcount_t * refcount = refcount_addr();
-    if (*refcount == 0)
+    refcount_storage_t * refcount = refcount_addr();
+    if (refcount_traits_t::load(*refcount) == 0)
       throw std::underflow_error("reference counter underflow");
-    *refcount -= 1;
+    refcount_traits_t::decrement(*refcount);
   }
 
   /*!
    \brief Accessor
    \return The value of the reference counter
    */
-  inline constexpr std::size_t refcount(void) const { return *(refcount_addr()); }
+  inline constexpr std::size_t refcount(void) const { return refcount_traits_t::load(*refcount_addr()); }
 
 private:
   /*!
@@ -195,8 +305,7 @@ private:
    */
   template <class... ARGS> make_shared_t(ARGS &&... args) : T(std::forward<ARGS>(args)...)
   {
-    refcount_t * const refcount = refcount_addr();
-    *refcount = 0;
+    new (refcount_addr()) refcount_storage_t(0);
   }
 
   /*!
@@ -207,8 +316,7 @@ private:
    */
   make_shared_t(make_shared_t<T, REFCOUNT, RESERVED> const & shared) : T(shared)
   {
-    refcount_t * const refcount = refcount_addr();
-    *refcount = 0;
+    new (refcount_addr()) refcount_storage_t(0);
   }
 
   /*!
@@ -220,22 +328,23 @@ private:
    \brief Accessor
    \return The address of the reference counter
    */
-  constexpr refcount_t * refcount_addr() const
+  constexpr refcount_storage_t * refcount_addr() const
   {
-    return (reinterpret_cast<refcount_t *>(const_cast<tchecker::make_shared_t<T> *>(this)) - 1);
+    return (reinterpret_cast<refcount_storage_t *>(const_cast<tchecker::make_shared_t<T, REFCOUNT, RESERVED> *>(this)) - 1);
   }
 };
 
 // allocation size for shared objects
 
 /*!
- \class allocation_size_t<make_shared_t<T>>
+ \class allocation_size_t<make_shared_t<T, REFCOUNT, RESERVED>>
  \brief Specialization of class tchecker::allocation_size_t for type
  tchecker::make_shared_t
  \note A specialization of tchecker::allocation_size_t should be defined for
  type T in namespace tchecker
  */
-template <class T> class allocation_size_t<tchecker::make_shared_t<T>> {
+template <class T, class REFCOUNT, std::size_t RESERVED>
+class allocation_size_t<tchecker::make_shared_t<T, REFCOUNT, RESERVED>> {
 public:
   /*!
    \brief Accessor
@@ -247,7 +356,8 @@ public:
   template <class... ARGS> static constexpr std::size_t alloc_size(ARGS &&... args)
   {
     // allocation size for T + size of reference counter
-    return (tchecker::allocation_size_t<T>().alloc_size(args...) + sizeof(typename tchecker::make_shared_t<T>::refcount_t));
+    return (tchecker::allocation_size_t<T>().alloc_size(args...) +
+            sizeof(typename tchecker::make_shared_t<T, REFCOUNT, RESERVED>::refcount_storage_t));
   }
 };
 
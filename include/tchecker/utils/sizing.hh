@@ -0,0 +1,32 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_SIZING_HH
+#define TCHECKER_SIZING_HH
+
+/*!
+ \file sizing.hh
+ \brief Sizing policy of pools and collision tables
+ */
+
+namespace tchecker {
+
+/*!
+ \brief Set the sizing policy
+ \param adaptive : true for adaptive sizes, false for fixed sizes
+ \post pools (see tchecker::pool_t) and collision tables (see tchecker::collision_table_t) constructed from now on
+ grow geometrically if adaptive is true, and have fixed block sizes and table sizes otherwise (default)
+ \note the policy of a pool or a table is set at construction: it is not changed by later calls
+ */
+void set_adaptive_sizes(bool adaptive);
+
+/*!
+ \brief Accessor
+ \return true if pools and collision tables constructed from now on grow geometrically, false otherwise
+ */
+bool adaptive_sizes();
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_SIZING_HH
@@ -6,6 +6,7 @@
 #define TCHECKER_STRING_HH
 
 #include <functional>
+#include <ostream>
 #include <string>
 #include <vector>
 
@@ -26,6 +27,23 @@ namespace tchecker {
 */
 std::vector<std::string> split(std::string const & s, char d);
 
+/*!
+ \brief Output a JSON string
+ \param os : output stream
+ \param s : a string
+ \post s has been output to os as a JSON string (with quotes, and escaped special characters)
+ */
+void output_json_string(std::ostream & os, std::string const & s);
+
+/*!
+ \brief Stable hash of a string
+ \param s : a string
+ \return the FNV-1a hash of s, as 16 hexadecimal digits
+ \note the hash does not depend on the standard library nor on the platform, hence it can identify data that is
+ kept between runs (caches, stored state spaces)
+ */
+std::string stable_hash(std::string const & s);
+
 } // namespace tchecker
 
 #endif // TCHECKER_STRING_HH
\ No newline at end of file
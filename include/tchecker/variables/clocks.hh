@@ -5,10 +5,14 @@
 #ifndef TCHECKER_CLOCKS_HH
 #define TCHECKER_CLOCKS_HH
 
+#include <cstddef>
 #include <iostream>
 #include <string>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+#include <boost/container_hash/hash.hpp>
+
 #include "tchecker/basictypes.hh"
 #include "tchecker/dbm/db.hh"
 #include "tchecker/utils/allocation_size.hh"
@@ -271,16 +275,34 @@ std::ostream & output_clock_constraints(std::ostream & os, tchecker::range_t<CLK
  */
 int lexical_cmp(tchecker::clock_constraint_t const & c1, tchecker::clock_constraint_t const & c2);
 
+/*!
+ \brief Number of elements stored inline by clock constraint and clock reset containers
+ \note transitions have four containers (source invariant, guard, reset and target invariant), and almost all of them
+ fit inline, hence computing a successor does not allocate them on the heap
+ */
+constexpr std::size_t const CLOCK_CONTAINER_INLINE_CAPACITY = 8;
+
 /*!
  \brief Clock constraint container
  */
-using clock_constraint_container_t = std::vector<tchecker::clock_constraint_t>;
+using clock_constraint_container_t =
+    boost::container::small_vector<tchecker::clock_constraint_t, tchecker::CLOCK_CONTAINER_INLINE_CAPACITY>;
 
 /*!
  \brief Const iterator over clock constraint container
  */
 using clock_constraint_container_const_iterator_t = tchecker::clock_constraint_container_t::const_iterator;
 
+/*!
+ \brief Hash function
+ \param c : clock constraint container
+ \return hash value for c (same as for a std::vector of the clock constraints in c)
+ */
+inline std::size_t hash_value(tchecker::clock_constraint_container_t const & c)
+{
+  return boost::hash_range(c.begin(), c.end());
+}
+
 /*!
  \brief Lexical ordering on clock constraint containers
  \param c1 : first clock constraint container
@@ -513,13 +535,21 @@ int lexical_cmp(tchecker::clock_reset_t const & r1, tchecker::clock_reset_t cons
 /*!
  \brief Clock reset container
  */
-using clock_reset_container_t = std::vector<tchecker::clock_reset_t>;
+using clock_reset_container_t =
+    boost::container::small_vector<tchecker::clock_reset_t, tchecker::CLOCK_CONTAINER_INLINE_CAPACITY>;
 
 /*!
  \brief Const iterator over clock reset container
  */
 using clock_reset_container_const_iterator_t = tchecker::clock_reset_container_t::const_iterator;
 
+/*!
+ \brief Hash function
+ \param c : clock reset container
+ \return hash value for c (same as for a std::vector of the clock resets in c)
+ */
+inline std::size_t hash_value(tchecker::clock_reset_container_t const & c) { return boost::hash_range(c.begin(), c.end()); }
+
 /*!
  \brief Lexical ordering on clock reset containers
  \param c1 : first clock reset container
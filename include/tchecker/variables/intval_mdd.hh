@@ -0,0 +1,153 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_INTVAL_MDD_HH
+#define TCHECKER_INTVAL_MDD_HH
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/variables/intvars.hh"
+
+/*!
+ \file intval_mdd.hh
+ \brief Sets of valuations of bounded integer variables as multi-valued decision diagrams
+ */
+
+namespace tchecker {
+
+/*!
+ \class intval_mdd_t
+ \brief Store of sets of valuations of bounded integer variables, represented as multi-valued decision diagrams (MDD)
+ \note A set is identified by its root node. Node i tests variable i, and its edges are labelled by the values of
+ variable i in its range that lead to a non-empty set. Every path from a root goes through all the variables
+ (quasi-reduced MDD), and nodes are unique: two sets of the store share their common suffixes, and equal sets have
+ the same root. Hence node identifiers can be compared to check set equality
+ \note Sets are persistent: insertion returns a new root and leaves the former set unchanged. The nodes that are
+ only reachable from former roots are reclaimed by collect()
+ */
+class intval_mdd_t {
+public:
+  /*!
+   \brief Type of node identifiers
+   */
+  using node_id_t = std::uint32_t;
+
+  /*!
+   \brief Root of the empty set
+   */
+  static constexpr node_id_t const EMPTY = 0;
+
+  /*!
+   \brief Root of the set of the empty valuation (terminal node of non-empty sets)
+   */
+  static constexpr node_id_t const TERMINAL = 1;
+
+  /*!
+   \brief Constructor
+   \param intvars : flat bounded integer variables
+   \post this is an empty store of sets of valuations of intvars
+   */
+  intval_mdd_t(tchecker::flat_integer_variables_t const & intvars);
+
+  /*!
+   \brief Accessor
+   \return number of variables
+   */
+  inline tchecker::intvar_id_t size() const { return static_cast<tchecker::intvar_id_t>(_ranges.size()); }
+
+  /*!
+   \brief Insertion
+   \param root : root of a set
+   \param intval : valuation of bounded integer variables
+   \pre root is EMPTY, or it has been returned by insert(), and it has not been reclaimed by collect(). intval has
+   size() variables
+   \return root of the union of set root and {intval} (root itself if intval is in set root)
+   \throw std::out_of_range : if some variable in intval is out of its range
+   */
+  node_id_t insert(node_id_t root, tchecker::intval_t const & intval);
+
+  /*!
+   \brief Membership
+   \param root : root of a set
+   \param intval : valuation of bounded integer variables
+   \pre same as insert()
+   \return true if intval is in set root, false otherwise
+   */
+  bool contains(node_id_t root, tchecker::intval_t const & intval) const;
+
+  /*!
+   \brief Cardinal
+   \param root : root of a set
+   \pre same as insert()
+   \return number of valuations in set root
+   */
+  std::uint64_t count(node_id_t root) const;
+
+  /*!
+   \brief Garbage collection
+   \param roots : roots of the sets to keep
+   \pre each root in roots is EMPTY, or it has been returned by insert() and it has not been reclaimed
+   \post the nodes that are not reachable from roots have been reclaimed, and their identifiers can be reused by
+   later insertions. The sets in roots are unchanged
+   */
+  void collect(std::vector<node_id_t> const & roots);
+
+  /*!
+   \brief Accessor
+   \return number of allocated nodes (including the nodes that have not been collected yet)
+   */
+  inline std::size_t nodes() const { return _nodes.size() - _free.size(); }
+
+  /*!
+   \brief Accessor
+   \return memory used by the store, in bytes
+   */
+  std::size_t memsize() const;
+
+private:
+  /*!
+   \brief Type of edges: value of the variable of a node, and target node
+   */
+  using edge_t = std::pair<tchecker::integer_t, node_id_t>;
+
+  /*!
+   \class node_t
+   \brief Node of the decision diagram
+   */
+  struct node_t {
+    tchecker::intvar_id_t _level;   /*!< Tested variable (size() for terminal nodes) */
+    std::vector<edge_t> _edges;     /*!< Edges, sorted by value (empty for terminal and reclaimed nodes) */
+    std::size_t _hash;              /*!< Hash value of level and edges */
+  };
+
+  /*!
+   \brief Insertion in a sub-diagram
+   \param node : a node of level level, or EMPTY
+   \param level : a level
+   \param intval : valuation of bounded integer variables
+   \return the node of the union of sub-diagram node and the suffix of intval from variable level
+   */
+  node_id_t insert(node_id_t node, tchecker::intvar_id_t level, tchecker::intval_t const & intval);
+
+  /*!
+   \brief Unique node
+   \param level : level
+   \param edges : sorted edges to nodes of level level + 1
+   \return the identifier of the node with level and edges, which has been created if needed
+   */
+  node_id_t make_node(tchecker::intvar_id_t level, std::vector<edge_t> && edges);
+
+  std::vector<std::pair<tchecker::integer_t, tchecker::integer_t>> _ranges; /*!< Ranges of variables */
+  std::vector<node_t> _nodes;                                            /*!< Nodes (EMPTY and TERMINAL first) */
+  std::vector<node_id_t> _free;                                          /*!< Reclaimed nodes */
+  std::unordered_multimap<std::size_t, node_id_t> _unique;               /*!< Map : hash value -> nodes */
+};
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_INTVAL_MDD_HH
@@ -5,8 +5,13 @@
 #ifndef TCHECKER_INTVARS_HH
 #define TCHECKER_INTVARS_HH
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <utility>
+
+#include <boost/container/small_vector.hpp>
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/utils/allocation_size.hh"
@@ -180,6 +185,10 @@ flat_integer_variables_valuations_range(tchecker::flat_integer_variables_t const
 class intval_base_t : public tchecker::array_capacity_t<unsigned short>, public tchecker::cached_object_t {
 public:
   using tchecker::array_capacity_t<unsigned short>::array_capacity_t;
+
+protected:
+  mutable bool _hash_valid = false; /*!< Whether _hash is the hash value of the valuation */
+  mutable std::size_t _hash = 0;    /*!< Hash value of the valuation (cached) */
 };
 
 /*!
@@ -218,6 +227,96 @@ public:
    */
   inline constexpr typename tchecker::intval_t::capacity_t size() const { return capacity(); }
 
+  // Accessors. Mutable accessors invalidate the cached hash value, see assign for O(1) updates of the hash value
+
+  /*!
+   \brief Accessor
+   \param i : index
+   \pre i < size() (checked by assertion)
+   \return reference to the value of variable i
+   \post the cached hash value of this valuation has been invalidated
+   */
+  inline tchecker::integer_t & operator[](tchecker::intval_base_t::capacity_t i)
+  {
+    _hash_valid = false;
+    return tchecker::integer_array_t::operator[](i);
+  }
+
+  /*!
+   \brief Accessor
+   \param i : index
+   \pre i < size() (checked by assertion)
+   \return const reference to the value of variable i
+   */
+  inline tchecker::integer_t const & operator[](tchecker::intval_base_t::capacity_t i) const
+  {
+    return tchecker::integer_array_t::operator[](i);
+  }
+
+  /*!
+   \brief Accessor
+   \return iterator to first value
+   \post the cached hash value of this valuation has been invalidated
+   */
+  inline tchecker::integer_array_t::iterator_t begin()
+  {
+    _hash_valid = false;
+    return tchecker::integer_array_t::begin();
+  }
+
+  /*!
+   \brief Accessor
+   \return past-the-end iterator
+   \post the cached hash value of this valuation has been invalidated
+   */
+  inline tchecker::integer_array_t::iterator_t end()
+  {
+    _hash_valid = false;
+    return tchecker::integer_array_t::end();
+  }
+
+  /*!
+   \brief Accessor
+   \return const iterator to first value
+   */
+  inline tchecker::integer_array_t::const_iterator_t begin() const { return tchecker::integer_array_t::begin(); }
+
+  /*!
+   \brief Accessor
+   \return past-the-end const iterator
+   */
+  inline tchecker::integer_array_t::const_iterator_t end() const { return tchecker::integer_array_t::end(); }
+
+  /*!
+   \brief Assignment of a variable
+   \param i : index
+   \param value : a value
+   \pre i < size() (checked by assertion)
+   \post variable i has value value. The cached hash value (if any) has been updated in constant time
+   */
+  inline void assign(tchecker::intval_base_t::capacity_t i, tchecker::integer_t value)
+  {
+    tchecker::integer_t & v = tchecker::integer_array_t::operator[](i);
+    if (_hash_valid)
+      _hash ^= tchecker::intval_t::variable_hash(i, v) ^ tchecker::intval_t::variable_hash(i, value);
+    v = value;
+  }
+
+  /*!
+   \brief Hash
+   \return hash value of this valuation
+   \note The hash value is the XOR of the hash values of pairs (variable, value) (Zobrist hashing), hence it can
+   be updated in constant time by assign. It is computed once, and cached until a mutable accessor is called
+   */
+  inline std::size_t hash() const
+  {
+    if (!_hash_valid) {
+      _hash = compute_hash();
+      _hash_valid = true;
+    }
+    return _hash;
+  }
+
   /*!
    \brief Construction
    \param args : arguments to a constructor of intval_t
@@ -238,6 +337,29 @@ public:
     v->~intval_t();
   }
 
+private:
+  /*!
+   \brief Hash of a variable value
+   \param i : index
+   \param value : value
+   \return hash value of variable i having value value
+   */
+  static inline std::size_t variable_hash(tchecker::intval_base_t::capacity_t i, tchecker::integer_t value)
+  {
+    // splitmix64 finalizer on (i, value)
+    std::uint64_t h = (static_cast<std::uint64_t>(i) << 32) ^ static_cast<std::uint64_t>(static_cast<std::int64_t>(value));
+    h += 0x9e3779b97f4a7c15ULL;
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    return static_cast<std::size_t>(h ^ (h >> 31));
+  }
+
+  /*!
+   \brief Hash
+   \return hash value of this valuation, computed from all its variables
+   */
+  std::size_t compute_hash() const;
+
 protected:
   /*!
    \brief Constructor
@@ -355,6 +477,13 @@ void from_string(tchecker::intval_t & intval, tchecker::flat_integer_variables_t
  */
 int lexical_cmp(tchecker::intval_t const & intval1, tchecker::intval_t const & intval2);
 
+/*!
+ \brief Hash
+ \param intval : bounded integer variables valuation
+ \return hash value of intval (see tchecker::intval_t::hash)
+ */
+inline std::size_t hash_value(tchecker::intval_t const & intval) { return intval.hash(); }
+
 /*!
  \brief Type of shared integer variables valuation
  */
@@ -365,6 +494,24 @@ using shared_intval_t = tchecker::make_shared_t<tchecker::intval_t>;
 */
 using intval_sptr_t = tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t>;
 
+/*!
+ \brief Number of elements stored inline by the containers of integer variables read and assigned by transitions
+ */
+constexpr std::size_t const INTVAR_CONTAINER_INLINE_CAPACITY = 8;
+
+/*!
+ \brief Container of the bounded integer variables read by a guard (used by history-aware transitions)
+ */
+using intvar_guard_container_t = boost::container::small_vector<unsigned, tchecker::INTVAR_CONTAINER_INLINE_CAPACITY>;
+
+/*!
+ \brief Container of the assignments (assigned variable, read variable) of bounded integer variables by a statement
+ (used by history-aware transitions)
+ */
+using intvar_set_container_t =
+    boost::container::small_vector<std::pair<tchecker::variable_id_t, tchecker::variable_id_t>,
+                                   tchecker::INTVAR_CONTAINER_INLINE_CAPACITY>;
+
 } // end of namespace tchecker
 
 #endif // TCHECKER_INTVARS_HH
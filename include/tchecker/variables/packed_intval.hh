@@ -0,0 +1,289 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_PACKED_INTVAL_HH
+#define TCHECKER_PACKED_INTVAL_HH
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/utils/allocation_size.hh"
+#include "tchecker/utils/array.hh"
+#include "tchecker/utils/cache.hh"
+#include "tchecker/utils/shared_objects.hh"
+#include "tchecker/variables/intvars.hh"
+
+/*!
+ \file packed_intval.hh
+ \brief Bit-packed valuations of bounded integer variables
+ */
+
+namespace tchecker {
+
+/*!
+ \brief Type of words of packed valuations
+ */
+using packed_word_t = std::uint64_t;
+
+/*!
+ \class intval_packing_t
+ \brief Layout of bit-packed valuations of bounded integer variables: each variable with range [min,max] is stored as
+ value - min on ceil(log2(max - min + 1)) bits
+ \note Fields never straddle two words, and they are laid out from the most significant bits of the first word. Hence
+ comparing packed valuations word by word coincides with tchecker::lexical_cmp on unpacked valuations
+ */
+class intval_packing_t {
+public:
+  /*!
+   \brief Constructor
+   \param intvars : flat bounded integer variables
+   \post this is the packing layout of valuations of intvars
+   */
+  intval_packing_t(tchecker::flat_integer_variables_t const & intvars);
+
+  /*!
+   \brief Accessor
+   \return number of variables
+   */
+  inline tchecker::intvar_id_t size() const { return static_cast<tchecker::intvar_id_t>(_fields.size()); }
+
+  /*!
+   \brief Accessor
+   \return number of words of packed valuations
+   */
+  inline unsigned short words() const { return _words; }
+
+  /*!
+   \brief Accessor
+   \param id : variable identifier
+   \pre id < size() (checked by assertion)
+   \return number of bits of variable id (0 for variables with a single value)
+   */
+  inline unsigned width(tchecker::intvar_id_t id) const
+  {
+    assert(id < size());
+    return _fields[id]._width;
+  }
+
+  /*!
+   \brief Read a variable
+   \param words : packed valuation
+   \param id : variable identifier
+   \pre words has words() words, and id < size() (checked by assertion)
+   \return value of variable id in words
+   */
+  inline tchecker::integer_t get(tchecker::packed_word_t const * words, tchecker::intvar_id_t id) const
+  {
+    assert(id < size());
+    field_t const & f = _fields[id];
+    return static_cast<tchecker::integer_t>(f._min + static_cast<tchecker::integer_t>((words[f._word] >> f._shift) & f._mask));
+  }
+
+  /*!
+   \brief Write a variable
+   \param words : packed valuation
+   \param id : variable identifier
+   \param value : value
+   \pre words has words() words, and id < size() (checked by assertion)
+   \post variable id has value value in words
+   \throw std::out_of_range : if value is not in the range of variable id
+   */
+  void set(tchecker::packed_word_t * words, tchecker::intvar_id_t id, tchecker::integer_t value) const;
+
+  /*!
+   \brief Packing
+   \param intval : valuation of bounded integer variables
+   \param words : packed valuation
+   \pre intval has size() variables and words has words() words
+   \post words is the packed version of intval
+   \throw std::out_of_range : if some variable in intval is out of its range
+   */
+  void pack(tchecker::intval_t const & intval, tchecker::packed_word_t * words) const;
+
+  /*!
+   \brief Unpacking
+   \param words : packed valuation
+   \param intval : valuation of bounded integer variables
+   \pre intval has size() variables and words has words() words
+   \post intval is the unpacked version of words
+   */
+  void unpack(tchecker::packed_word_t const * words, tchecker::intval_t & intval) const;
+
+private:
+  /*!
+   \brief Field of a variable in packed valuations
+   */
+  struct field_t {
+    tchecker::integer_t _min;    /*!< Minimal value */
+    tchecker::integer_t _max;    /*!< Maximal value */
+    tchecker::packed_word_t _mask; /*!< Mask of width bits */
+    unsigned short _word;        /*!< Index of word */
+    unsigned char _shift;        /*!< Position of least significant bit in word */
+    unsigned char _width;        /*!< Number of bits */
+  };
+
+  std::vector<field_t> _fields; /*!< Map : variable identifier -> field */
+  unsigned short _words;        /*!< Number of words */
+};
+
+/*!
+ \class packed_intval_base_t
+ \brief Base class for packed valuations which can be stored in cache
+ */
+class packed_intval_base_t : public tchecker::array_capacity_t<unsigned short>, public tchecker::cached_object_t {
+public:
+  using tchecker::array_capacity_t<unsigned short>::array_capacity_t;
+};
+
+/*!
+ \brief Type of arrays of packed words
+ */
+using packed_word_array_t =
+    tchecker::make_array_t<tchecker::packed_word_t, sizeof(tchecker::packed_word_t), tchecker::packed_intval_base_t>;
+
+/*!
+ \class packed_intval_t
+ \brief Bit-packed valuation of bounded integer variables, see tchecker::intval_packing_t
+ \note Equality, hash and lexical comparison operate on words. NO FIELD SHOULD BE ADDED TO THIS CLASS (either by
+ definition or inheritance). See tchecker::make_array_t for details
+ */
+class packed_intval_t : public tchecker::packed_word_array_t {
+public:
+  /*!
+   \brief Accessor
+   \return number of words
+   */
+  inline constexpr unsigned short words() const { return capacity(); }
+
+  /*!
+   \brief Accessor
+   \return pointer to first word
+   */
+  inline tchecker::packed_word_t * data() { return begin(); }
+
+  /*!
+   \brief Accessor
+   \return pointer to first word
+   */
+  inline tchecker::packed_word_t const * data() const { return begin(); }
+
+  /*!
+   \brief Construction
+   \param ptr : pointer to an allocated zone
+   \param args : arguments to a constructor of packed_intval_t
+   \pre ptr points to an allocated zone of capacity at least allocation_size_t<packed_intval_t>::alloc_size(args)
+   \post packed_intval_t(args) has been called on ptr
+   */
+  template <class... ARGS> static inline void construct(void * ptr, ARGS &&... args) { new (ptr) packed_intval_t(args...); }
+
+  /*!
+   \brief Destruction
+   \param v : packed valuation
+   \post ~packed_intval_t() has been called on v
+   */
+  static inline void destruct(tchecker::packed_intval_t * v)
+  {
+    assert(v != nullptr);
+    v->~packed_intval_t();
+  }
+
+protected:
+  /*!
+   \brief Constructor
+   \param words : number of words
+   \post all words are 0
+   */
+  packed_intval_t(unsigned short words) : tchecker::packed_word_array_t(std::make_tuple(words), std::make_tuple(0)) {}
+
+  /*!
+   \brief Copy constructor
+   */
+  packed_intval_t(tchecker::packed_intval_t const &) = default;
+
+  /*!
+   \brief Move constructor
+   */
+  packed_intval_t(tchecker::packed_intval_t &&) = default;
+
+  /*!
+   \brief Destructor
+   */
+  ~packed_intval_t() = default;
+};
+
+/*!
+ \class allocation_size_t
+ \brief Specialization of tchecker::allocation_size_t for class tchecker::packed_intval_t
+ */
+template <> class allocation_size_t<tchecker::packed_intval_t> {
+public:
+  /*!
+   \brief Allocation size
+   \param args : arguments for a constructor of class tchecker::packed_intval_t
+   \return allocation size for objects of class tchecker::packed_intval_t
+   */
+  template <class... ARGS> static constexpr std::size_t alloc_size(ARGS &&... args)
+  {
+    return tchecker::allocation_size_t<tchecker::packed_word_array_t>::alloc_size(args...);
+  }
+};
+
+/*!
+ \brief Allocate and construct a packed valuation
+ \param words : number of words
+ \return an instance of packed_intval_t with words words set to 0
+ */
+tchecker::packed_intval_t * packed_intval_allocate_and_construct(unsigned short words);
+
+/*!
+ \brief Destruct and deallocate a packed valuation
+ \param v : packed valuation
+ \pre v has been allocated by tchecker::packed_intval_allocate_and_construct
+ \post v has been destructed and deallocated
+ */
+void packed_intval_destruct_and_deallocate(tchecker::packed_intval_t * v);
+
+/*!
+ \brief Equality check
+ \param v1 : packed valuation
+ \param v2 : packed valuation
+ \return true if v1 and v2 have the same words, false otherwise
+ */
+bool operator==(tchecker::packed_intval_t const & v1, tchecker::packed_intval_t const & v2);
+
+/*!
+ \brief Disequality check
+ \param v1 : packed valuation
+ \param v2 : packed valuation
+ \return see operator==
+ */
+inline bool operator!=(tchecker::packed_intval_t const & v1, tchecker::packed_intval_t const & v2) { return !(v1 == v2); }
+
+/*!
+ \brief Hash
+ \param v : packed valuation
+ \return hash value of the words of v
+ */
+std::size_t hash_value(tchecker::packed_intval_t const & v);
+
+/*!
+ \brief Lexical ordering
+ \param v1 : packed valuation
+ \param v2 : packed valuation
+ \pre v1 and v2 have been packed with the same tchecker::intval_packing_t
+ \return 0 if v1 and v2 are equal, a negative value if v1 is smaller than v2 w.r.t. lexical ordering on the variable
+ values, and a positive value otherwise
+ */
+int lexical_cmp(tchecker::packed_intval_t const & v1, tchecker::packed_intval_t const & v2);
+
+/*!
+ \brief Type of shared packed valuations
+ */
+using shared_packed_intval_t = tchecker::make_shared_t<tchecker::packed_intval_t>;
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_PACKED_INTVAL_HH
@@ -37,6 +37,17 @@ tchecker::bytecode_t * compile(tchecker::typed_expression_t const & expr);
  */
 tchecker::bytecode_t * compile(tchecker::typed_statement_t const & stmt);
 
+/*!
+ \brief Check independence from bounded integer variables
+ \param bytecode : bytecode
+ \pre bytecode has been returned by tchecker::compile
+ \return true if interpreting bytecode neither reads nor writes bounded integer variables or local variables,
+ false otherwise
+ \note interpreting an intval-independent bytecode yields the same value and the same clock constraints for
+ all valuations of bounded integer variables
+ */
+bool intval_independent(tchecker::bytecode_t const * bytecode);
+
 } // end of namespace tchecker
 
 #endif // TCHECKER_VM_COMPILERS_HH
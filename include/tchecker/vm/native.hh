@@ -0,0 +1,142 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_VM_NATIVE_HH
+#define TCHECKER_VM_NATIVE_HH
+
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/variables/clocks.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/vm/vm.hh"
+
+/*!
+ \file native.hh
+ \brief Native code for tchecker bytecode: C++ code generation, and registry of natively compiled bytecode
+ \note tchecker::native::emit_cpp translates bytecode to a C++ translation unit. Once built as a shared library and
+ loaded (e.g. with tck-reach --native), the translation unit registers its functions, and systems built afterwards
+ call them instead of interpreting the same bytecode (see tchecker::ta::system_t)
+ */
+
+namespace tchecker {
+
+/*!
+ \brief Type of natively compiled bytecode
+ \note same arguments and return value as tchecker::vm_t::run
+ */
+using native_function_t = tchecker::integer_t (*)(tchecker::intval_t & intval,
+                                                    tchecker::clock_constraint_container_t & clkconstr,
+                                                    tchecker::clock_reset_container_t & clkreset);
+
+namespace native {
+
+/*!
+ \brief Register natively compiled bytecode
+ \param bytecode : bytecode
+ \param size : size of bytecode (see tchecker::native::bytecode_size)
+ \param function : native function equivalent to bytecode
+ \post function is returned by find_function for any bytecode with the same size words as bytecode
+ \note thread-safe
+ */
+void register_function(tchecker::bytecode_t const * bytecode, std::size_t size, tchecker::native_function_t function);
+
+/*!
+ \brief Lookup natively compiled bytecode
+ \param bytecode : bytecode
+ \return the native function registered for bytecode if any, nullptr otherwise
+ \note thread-safe
+ */
+tchecker::native_function_t find_function(tchecker::bytecode_t const * bytecode);
+
+/*!
+ \brief Size of bytecode
+ \param bytecode : bytecode
+ \pre bytecode is null-terminated (i.e. VM_RET)
+ \return number of words from bytecode up to, and including, the last instruction reachable from the first one
+ \throw std::invalid_argument : if bytecode contains an unknown instruction, or jumps before its first instruction
+ */
+std::size_t bytecode_size(tchecker::bytecode_t const * bytecode);
+
+/*!
+ \brief C++ code generation
+ \param os : output stream
+ \param bytecodes : bytecodes
+ \param name : name of the compiled model (output in a comment)
+ \post a C++ translation unit with one function for each bytecode in bytecodes, and that registers these functions
+ when it is loaded, has been output to os. Every value on the interpreter stack is a local variable, and jumps are
+ translated to gotos
+ \throw std::invalid_argument : if some bytecode in bytecodes is not well-formed (e.g. the stack depth at some
+ instruction depends on the path to the instruction)
+ */
+void emit_cpp(std::ostream & os, std::vector<tchecker::bytecode_t const *> const & bytecodes, std::string const & name);
+
+// Runtime support of generated code: same checks as tchecker::basic_vm_t
+
+/*!
+ \brief Conversion of a stack value
+ \tparam T : integer type
+ \param v : stack value
+ \return v cast to T
+ \throw std::runtime_error : if v cannot be represented by type T
+ */
+template <class T> inline T value(tchecker::bytecode_t v)
+{
+  static_assert(std::is_integral<T>::value, "T should be an integral type");
+  if ((v < std::numeric_limits<T>::min()) || (v > std::numeric_limits<T>::max()))
+    throw std::runtime_error("vm_t::top, value out-of-bounds");
+  return static_cast<T>(v);
+}
+
+/*!
+ \brief Range check (instruction VM_FAILNOTIN)
+ \param v : value
+ \param l : lower bound
+ \param h : upper bound
+ \throw std::out_of_range : if not (l <= v <= h)
+ */
+inline void fail_not_in(tchecker::bytecode_t v, tchecker::bytecode_t l, tchecker::bytecode_t h)
+{
+  if ((v < l) || (v > h)) {
+    std::stringstream ss;
+    ss << v << " out of [" << l << ", " << h << "]";
+    throw std::out_of_range("out-of-bounds value: " + ss.str());
+  }
+}
+
+/*!
+ \brief Type of stack of frames of local variables
+ */
+using frames_t = std::vector<std::map<tchecker::bytecode_t, tchecker::integer_t>>;
+
+/*!
+ \brief Look for a local variable in a stack of frames
+ \param frames : stack of frames
+ \param id : identifier of local variable
+ \return the lvalue of local variable id in the top-most frame that declares it
+ \throw std::out_of_range : if id is not declared in frames
+ */
+inline tchecker::integer_t & slot_of(tchecker::native::frames_t & frames, tchecker::bytecode_t id)
+{
+  for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+    auto kv = it->find(id);
+    if (kv != it->end())
+      return kv->second;
+  }
+  throw std::out_of_range("unknown local variable ID");
+}
+
+} // end of namespace native
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_VM_NATIVE_HH
@@ -11,6 +11,7 @@
 #include <iostream>
 #include <limits>
 #include <map>
+#include <utility>
 #include <vector>
 
 #include "tchecker/basictypes.hh"
@@ -39,8 +40,9 @@ enum instruction_t {
   //                  offset is a parameter of the instruction
   VM_PUSH, // stack = v1 ... vK v                   where v is a parameter of VM_PUSH
   //
-  VM_VALUEAT, // stack = v1 ... vK-1 [vK]              vK replaced by value at addr vK
-  VM_ASSIGN,  // stack = v1 ... vK-2                   [vK-1] = vK, i.e. value at address vK-1 is replaced by vK
+  VM_VALUEAT,    // stack = v1 ... vK-1 [vK]           vK replaced by value at addr vK
+  VM_VALUEAT_ID, // stack = v1 ... vK [x]              where x is a parameter of VM_VALUEAT_ID (VM_PUSH x; VM_VALUEAT)
+  VM_ASSIGN,     // stack = v1 ... vK-2                [vK-1] = vK, i.e. value at address vK-1 is replaced by vK
   //
   VM_LAND,  // stack = v1 ... vK-2 (vK-1 && vK)
   VM_MINUS, // stack = v1 ... vK-2 (vK-1 - vK)
@@ -123,44 +125,58 @@ std::size_t output_instruction(std::ostream & os, tchecker::bytecode_t const * b
 // Virtual machine (VM)
 
 /*!
- \class vm_t
+ \brief Dispatch of instructions in the interpreter
+ \note the interpreter is direct-threaded (computed goto) on compilers that support labels as values, unless
+ TCHECKER_VM_SWITCH_DISPATCH is defined. Otherwise, it dispatches instructions with a switch loop
+ */
+#if defined(__GNUC__) && !defined(TCHECKER_VM_SWITCH_DISPATCH) && !defined(TCHECKER_VM_COMPUTED_GOTO)
+#define TCHECKER_VM_COMPUTED_GOTO
+#endif
+
+/*!
+ \class basic_vm_t
  \brief Virtual machine for bytecode interpretation
+ \tparam TRACKING : tracking policy of accesses to bounded integer variables, should have methods
+ read(tchecker::intvar_id_t id), called when the value of variable id is read, and
+ write(tchecker::intvar_id_t id, tchecker::integer_t value), called when value is assigned to variable id
+ \note the tracking policy is chosen at compile time: a policy with empty methods has no cost, see
+ tchecker::vm_t and tchecker::vm_ha::vm_t
  */
-class vm_t {
+template <class TRACKING> class basic_vm_t {
 public:
   /*!
    \brief Constructor
    */
-  vm_t() = default;
+  basic_vm_t() = default;
 
   /*!
    \brief Copy constructor
    \param vm : virtual machine
    \post this is a copy of vm
    */
-  vm_t(tchecker::vm_t const & vm) = default;
+  basic_vm_t(tchecker::basic_vm_t<TRACKING> const & vm) = default;
 
   /*!
    \brief Move constructor
    \patam vm : virtual machine
    \post vm has been moved to this
    */
-  vm_t(tchecker::vm_t && vm) = default;
+  basic_vm_t(tchecker::basic_vm_t<TRACKING> && vm) = default;
 
   /*!
    \brief Destructor
    */
-  ~vm_t() = default;
+  ~basic_vm_t() = default;
 
   /*!
    \brief Assignment operator
    */
-  tchecker::vm_t & operator=(tchecker::vm_t const &) = default;
+  tchecker::basic_vm_t<TRACKING> & operator=(tchecker::basic_vm_t<TRACKING> const &) = default;
 
   /*!
    \brief Move assignment operator
    */
-  tchecker::vm_t & operator=(tchecker::vm_t &&) = default;
+  tchecker::basic_vm_t<TRACKING> & operator=(tchecker::basic_vm_t<TRACKING> &&) = default;
 
   /*!
    \brief Bytecode interpreter
@@ -168,13 +184,15 @@ public:
    \param intval : valuation of bounded integer variables
    \param clkconstr : container of clock constraints
    \param clkreset : container of clock resets
+   \param tracking : tracking of accesses to bounded integer variables
    \pre bytecode is null-terminated (i.e. VM_RET).
    Variables identifiers in bytecode are less than intval.size() (checked by assertion)
    \return value computed by the last instruction in bytecode
    \post bytecode has been executed:
    intval has been updated,
    clock constraints have been pushed into clkconstr,
-   and clock resets have been pushed into clkreset
+   and clock resets have been pushed into clkreset,
+   and accesses to bounded integer variables have been reported to tracking
    \throw std::runtime_error : if bytecode interpretation fails
    \throw std::out_of_range : if out-of-bound array access
    \note Evaluating a bytecode from an expression returns 0 for false and any
@@ -183,316 +201,355 @@ public:
    exception if evaluation failed.
    */
   tchecker::integer_t run(tchecker::bytecode_t const * bytecode, tchecker::intval_t & intval,
-                          tchecker::clock_constraint_container_t & clkconstr, tchecker::clock_reset_container_t & clkreset)
+                          tchecker::clock_constraint_container_t & clkconstr, tchecker::clock_reset_container_t & clkreset,
+                          TRACKING & tracking)
   {
     assert(size() == 0); // stack should be empty
 
-    tchecker::integer_t eval = 0;
-    _return = false;
+    // Assume stack=v1 ... vK where vK is the top symbol. Each instruction ends with a jump to the next one
+    // (TCHECKER_VM_NEXT) or returns from run
+    try {
+#if defined(TCHECKER_VM_COMPUTED_GOTO)
+      // direct-threaded dispatch: one indirect jump per instruction, in the order of enum instruction_t
+      static void * const dispatch[] = {
+          &&L_VM_RET,        &&L_VM_RETZ,       &&L_VM_FAILNOTIN,    &&L_VM_JMP,          &&L_VM_JMPZ,
+          &&L_VM_PUSH,       &&L_VM_VALUEAT,    &&L_VM_VALUEAT_ID,   &&L_VM_ASSIGN,       &&L_VM_LAND,
+          &&L_VM_MINUS,      &&L_VM_DIV,        &&L_VM_EQ,           &&L_VM_GE,           &&L_VM_GT,
+          &&L_VM_LT,         &&L_VM_LE,         &&L_VM_MUL,          &&L_VM_MOD,          &&L_VM_NE,
+          &&L_VM_SUM,        &&L_VM_NEG,        &&L_VM_LNOT,         &&L_VM_CLKCONSTR,    &&L_VM_CLKRESET,
+          &&L_VM_PUSH_FRAME, &&L_VM_POP_FRAME,  &&L_VM_VALUEAT_FRAME, &&L_VM_ASSIGN_FRAME, &&L_VM_INIT_FRAME,
+          &&L_VM_NOP};
+      static_assert(sizeof(dispatch) / sizeof(dispatch[0]) == VM_NOP + 1, "dispatch table should cover instruction_t");
+#define TCHECKER_VM_INSTRUCTION(i) L_##i:
+#define TCHECKER_VM_DISPATCH()                                                                                                 \
+  assert((*bytecode >= 0) && (*bytecode <= VM_NOP));                                                                           \
+  goto * dispatch[*bytecode]
+      TCHECKER_VM_DISPATCH();
+#else
+#define TCHECKER_VM_INSTRUCTION(i) case i:
+#define TCHECKER_VM_DISPATCH() continue
+      for (;;) {
+        switch (*bytecode) {
+#endif
+#define TCHECKER_VM_NEXT()                                                                                                     \
+  ++bytecode;                                                                                                                  \
+  TCHECKER_VM_DISPATCH()
 
-    do {
-      try {
-        eval = interpret_instruction(bytecode, intval, clkconstr, clkreset);
-      }
-      catch (...) {
+      // end of operation, return vK
+      TCHECKER_VM_INSTRUCTION(VM_RET)
+      {
+        auto val = top_and_pop<tchecker::integer_t>();
+        assert(size() == 0);
         clear();
-        throw;
+        return val;
       }
 
-      ++bytecode;
-    } while (_return == false);
-
-    return eval;
-  }
-
-protected:
-  // bytecode instructions interpretation
-
-  /*!
-   \brief Single instruction interpreter
-   \param bytecode : tchecker bytecode
-   \param intval : valuation of bounded integer variables
-   \param clkconstr : container of clock constraints
-   \param clkreset : container of clock resets
-   \return computed value
-   \pre all integer variable indentifiers in bytecode are less than intval.size() (checked by assertion)
-   \post the instruction pointed by bytecode has been interpreted:
-   intval and the stack have been updated,
-   and all clock constraints have been pushed into clkconstr and all clock resets have been pushed into clkreset
-   \throw std::runtime_error : if bytecode interpretation fails
-   \throw std::out_of_range : if out-of-bound array access
-   */
-  inline tchecker::integer_t interpret_instruction(tchecker::bytecode_t const *& bytecode, tchecker::intval_t & intval,
-                                                   tchecker::clock_constraint_container_t & clkconstr,
-                                                   tchecker::clock_reset_container_t & clkreset)
-  {
-    // Assume stack=v1 ... vK where vK is the top symbol
-    switch (*bytecode) {
-      // end of operation, return vK
-    case VM_RET: {
-      auto val = top_and_pop<tchecker::integer_t>();
-      assert(size() == 0);
-      clear();
-      _return = true;
-      return val;
-    }
-
       // end of operation when vK==0, return 0
-    case VM_RETZ: {
-      if (top<tchecker::integer_t>() == 0) {
-        clear();
-        _return = true;
-        return 0;
+      TCHECKER_VM_INSTRUCTION(VM_RETZ)
+      {
+        if (top<tchecker::integer_t>() == 0) {
+          clear();
+          return 0;
+        }
+        TCHECKER_VM_NEXT();
       }
-      return top<tchecker::integer_t>();
-    }
 
       // raise exception when not (l <= vK <= h) for parameters l and h
       // of instruction VM_FAILNOTIN
-    case VM_FAILNOTIN: {
-      tchecker::bytecode_t const l = *++bytecode;
-      tchecker::bytecode_t const h = *++bytecode;
-      auto const offset = top<tchecker::bytecode_t>();
-      assert(contains_value<tchecker::integer_t>(l));
-      assert(contains_value<tchecker::integer_t>(h));
-      assert(contains_value<tchecker::integer_t>(offset));
-      if ((offset < l) || (offset > h)) {
-        std::stringstream ss;
-        ss << offset << " out of [" << l << ", " << h << "]";
-        throw std::out_of_range("out-of-bounds value: " + ss.str());
+      TCHECKER_VM_INSTRUCTION(VM_FAILNOTIN)
+      {
+        tchecker::bytecode_t const l = *++bytecode;
+        tchecker::bytecode_t const h = *++bytecode;
+        auto const offset = top<tchecker::bytecode_t>();
+        assert(contains_value<tchecker::integer_t>(l));
+        assert(contains_value<tchecker::integer_t>(h));
+        assert(contains_value<tchecker::integer_t>(offset));
+        if ((offset < l) || (offset > h)) {
+          std::stringstream ss;
+          ss << offset << " out of [" << l << ", " << h << "]";
+          throw std::out_of_range("out-of-bounds value: " + ss.str());
+        }
+        TCHECKER_VM_NEXT();
       }
 
-      return top<tchecker::integer_t>();
-    }
-
       // unconditional jump relatively to next instruction;
       // offset is a parameter of the instruction
-    case VM_JMP: {
-      tchecker::bytecode_t const shift = *++bytecode;
-      // jump is relative to the address of the next instruction:
-      // - bytecode++;
-      // but we have to handle the increment of the IP in the main loop:
-      // - bytecode += shift - 1;
-      // so:
-      bytecode += shift;
-
-      return 1;
-    }
+      TCHECKER_VM_INSTRUCTION(VM_JMP)
+      {
+        tchecker::bytecode_t const shift = *++bytecode;
+        // jump is relative to the address of the next instruction:
+        // - bytecode++;
+        // but the increment of the IP is done by TCHECKER_VM_NEXT:
+        // - bytecode += shift - 1;
+        // so:
+        bytecode += shift;
+        TCHECKER_VM_NEXT();
+      }
+
       // stack = v1 ... vK   jump if vK == 0
       // offset is a parameter of the instruction
-    case VM_JMPZ: {
-      tchecker::bytecode_t const shift = *++bytecode;
-
-      if (top_and_pop<tchecker::integer_t>() == 0) {
-        bytecode += shift;
-        return 0;
+      TCHECKER_VM_INSTRUCTION(VM_JMPZ)
+      {
+        tchecker::bytecode_t const shift = *++bytecode;
+        if (top_and_pop<tchecker::integer_t>() == 0)
+          bytecode += shift;
+        TCHECKER_VM_NEXT();
       }
-      return 1;
-    }
 
       // stack = v1 ... vK v   where v is a parameter of instruction VM_PUSH
-    case VM_PUSH: {
-      tchecker::bytecode_t const v = *++bytecode;
-      push<tchecker::bytecode_t>(v);
-      return top<tchecker::integer_t>();
-    }
+      TCHECKER_VM_INSTRUCTION(VM_PUSH)
+      {
+        tchecker::bytecode_t const v = *++bytecode;
+        push<tchecker::bytecode_t>(v);
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... [vK]   vK replaced by value at ID vK in intvars
       // valuation
-    case VM_VALUEAT: {
-      auto const id = top_and_pop<tchecker::intval_base_t::capacity_t>();
-      assert(id < intval.size());
-      push<tchecker::integer_t>(intval[id]);
-      return top<tchecker::integer_t>();
-    }
+      TCHECKER_VM_INSTRUCTION(VM_VALUEAT)
+      {
+        auto const id = top_and_pop<tchecker::intval_base_t::capacity_t>();
+        assert(id < intval.size());
+        push<tchecker::integer_t>(std::as_const(intval)[id]);
+        tracking.read(id);
+        TCHECKER_VM_NEXT();
+      }
+
+      // stack = v1 ... vK [x]   where x is a parameter of instruction VM_VALUEAT_ID
+      // (same as VM_PUSH x followed by VM_VALUEAT)
+      TCHECKER_VM_INSTRUCTION(VM_VALUEAT_ID)
+      {
+        tchecker::bytecode_t const v = *++bytecode;
+        assert(contains_value<tchecker::intval_base_t::capacity_t>(v));
+        auto const id = static_cast<tchecker::intval_base_t::capacity_t>(v);
+        assert(id < intval.size());
+        push<tchecker::integer_t>(std::as_const(intval)[id]);
+        tracking.read(id);
+        TCHECKER_VM_NEXT();
+      }
 
       // [vK-1] = vK, stack = v1 ... vK-2
-    case VM_ASSIGN: {
-      auto const value = top_and_pop<tchecker::integer_t>();
-      auto const id = top_and_pop<tchecker::intval_base_t::capacity_t>();
-      assert(id < intval.size());
-      intval[id] = value;
-      return value;
-    }
+      TCHECKER_VM_INSTRUCTION(VM_ASSIGN)
+      {
+        auto const value = top_and_pop<tchecker::integer_t>();
+        auto const id = top_and_pop<tchecker::intval_base_t::capacity_t>();
+        assert(id < intval.size());
+        intval.assign(id, value);
+        tracking.write(id, value);
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... vK-2 (vK-1 && vK)
-    case VM_LAND: {
-      auto const right = top_and_pop<tchecker::integer_t>();
-      auto const left = top_and_pop<tchecker::integer_t>();
-      push<tchecker::integer_t>(left && right);
-      return top<tchecker::integer_t>();
-    }
+      TCHECKER_VM_INSTRUCTION(VM_LAND)
+      {
+        auto const right = top_and_pop<tchecker::integer_t>();
+        auto const left = top_and_pop<tchecker::integer_t>();
+        push<tchecker::integer_t>(left && right);
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... vK-2 (vK-1 - vK)
-    case VM_MINUS: {
-      auto const right = top_and_pop<tchecker::integer_t>();
-      auto const left = top_and_pop<tchecker::integer_t>();
-      push<tchecker::integer_t>(left - right);
-      return top<tchecker::integer_t>();
-    }
+      TCHECKER_VM_INSTRUCTION(VM_MINUS)
+      {
+        auto const right = top_and_pop<tchecker::integer_t>();
+        auto const left = top_and_pop<tchecker::integer_t>();
+        push<tchecker::integer_t>(left - right);
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... vK-2 (vK-1 / vK)
-    case VM_DIV: {
-      auto const right = top_and_pop<tchecker::integer_t>();
-      auto const left = top_and_pop<tchecker::integer_t>();
-      push<tchecker::integer_t>(left / right);
-      return top<tchecker::integer_t>();
-    }
+      TCHECKER_VM_INSTRUCTION(VM_DIV)
+      {
+        auto const right = top_and_pop<tchecker::integer_t>();
+        auto const left = top_and_pop<tchecker::integer_t>();
+        push<tchecker::integer_t>(left / right);
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... vK-2 (vK-1 == vK)
-    case VM_EQ: {
-      auto const right = top_and_pop<tchecker::integer_t>();
-      auto const left = top_and_pop<tchecker::integer_t>();
-      push<tchecker::integer_t>(left == right);
-      return top<tchecker::integer_t>();
-    }
+      TCHECKER_VM_INSTRUCTION(VM_EQ)
+      {
+        auto const right = top_and_pop<tchecker::integer_t>();
+        auto const left = top_and_pop<tchecker::integer_t>();
+        push<tchecker::integer_t>(left == right);
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... vK-2 (vK-1 >= vK)
-    case VM_GE: {
-      auto const right = top_and_pop<tchecker::integer_t>();
-      auto const left = top_and_pop<tchecker::integer_t>();
-      push<tchecker::integer_t>(left >= right);
-      return top<tchecker::integer_t>();
-    }
+      TCHECKER_VM_INSTRUCTION(VM_GE)
+      {
+        auto const right = top_and_pop<tchecker::integer_t>();
+        auto const left = top_and_pop<tchecker::integer_t>();
+        push<tchecker::integer_t>(left >= right);
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... vK-2 (vK-1 > vK)
-    case VM_GT: {
-      auto const right = top_and_pop<tchecker::integer_t>();
-      auto const left = top_and_pop<tchecker::integer_t>();
-      push<tchecker::integer_t>(left > right);
-      return top<tchecker::integer_t>();
-    }
+      TCHECKER_VM_INSTRUCTION(VM_GT)
+      {
+        auto const right = top_and_pop<tchecker::integer_t>();
+        auto const left = top_and_pop<tchecker::integer_t>();
+        push<tchecker::integer_t>(left > right);
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... vK-2 (vK-1 < vK)
-    case VM_LT: {
-      auto const right = top_and_pop<tchecker::integer_t>();
-      auto const left = top_and_pop<tchecker::integer_t>();
-      push<tchecker::integer_t>(left < right);
-      return top<tchecker::integer_t>();
-    }
+      TCHECKER_VM_INSTRUCTION(VM_LT)
+      {
+        auto const right = top_and_pop<tchecker::integer_t>();
+        auto const left = top_and_pop<tchecker::integer_t>();
+        push<tchecker::integer_t>(left < right);
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... vK-2 (vK-1 <= vK)
-    case VM_LE: {
-      auto const right = top_and_pop<tchecker::integer_t>();
-      auto const left = top_and_pop<tchecker::integer_t>();
-      push<tchecker::integer_t>(left <= right);
-      return top<tchecker::integer_t>();
-    }
+      TCHECKER_VM_INSTRUCTION(VM_LE)
+      {
+        auto const right = top_and_pop<tchecker::integer_t>();
+        auto const left = top_and_pop<tchecker::integer_t>();
+        push<tchecker::integer_t>(left <= right);
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... vK-2 (vK-1 * vK)
-    case VM_MUL: {
-      auto const right = top_and_pop<tchecker::integer_t>();
-      auto const left = top_and_pop<tchecker::integer_t>();
-      push<tchecker::integer_t>(left * right);
-      return top<tchecker::integer_t>();
-    }
+      TCHECKER_VM_INSTRUCTION(VM_MUL)
+      {
+        auto const right = top_and_pop<tchecker::integer_t>();
+        auto const left = top_and_pop<tchecker::integer_t>();
+        push<tchecker::integer_t>(left * right);
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... vK-2 (vK-1 % vK)
-    case VM_MOD: {
-      auto const right = top_and_pop<tchecker::integer_t>();
-      auto const left = top_and_pop<tchecker::integer_t>();
-      push<tchecker::integer_t>(left % right);
-      return top<tchecker::integer_t>();
-    }
+      TCHECKER_VM_INSTRUCTION(VM_MOD)
+      {
+        auto const right = top_and_pop<tchecker::integer_t>();
+        auto const left = top_and_pop<tchecker::integer_t>();
+        push<tchecker::integer_t>(left % right);
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... vK-2 (vK-1 != vK)
-    case VM_NE: {
-      auto const right = top_and_pop<tchecker::integer_t>();
-      auto const left = top_and_pop<tchecker::integer_t>();
-      push<tchecker::integer_t>(left != right);
-      return top<tchecker::integer_t>();
-    }
+      TCHECKER_VM_INSTRUCTION(VM_NE)
+      {
+        auto const right = top_and_pop<tchecker::integer_t>();
+        auto const left = top_and_pop<tchecker::integer_t>();
+        push<tchecker::integer_t>(left != right);
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... vK-2 (vK-1 + vK)
-    case VM_SUM: {
-      auto const right = top_and_pop<tchecker::integer_t>();
-      auto const left = top_and_pop<tchecker::integer_t>();
-      push<tchecker::integer_t>(left + right);
-      return top<tchecker::integer_t>();
-    }
+      TCHECKER_VM_INSTRUCTION(VM_SUM)
+      {
+        auto const right = top_and_pop<tchecker::integer_t>();
+        auto const left = top_and_pop<tchecker::integer_t>();
+        push<tchecker::integer_t>(left + right);
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... vK-1 (- vK)
-    case VM_NEG: {
-      auto const v = top_and_pop<tchecker::integer_t>();
-      push<tchecker::integer_t>(-v);
-      return top<tchecker::integer_t>();
-    }
+      TCHECKER_VM_INSTRUCTION(VM_NEG)
+      {
+        auto const v = top_and_pop<tchecker::integer_t>();
+        push<tchecker::integer_t>(-v);
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... vK-1 (! vK)
-    case VM_LNOT: {
-      auto const v = top_and_pop<tchecker::integer_t>();
-      push<tchecker::integer_t>(!v);
-      return top<tchecker::integer_t>();
-    }
+      TCHECKER_VM_INSTRUCTION(VM_LNOT)
+      {
+        auto const v = top_and_pop<tchecker::integer_t>();
+        push<tchecker::integer_t>(!v);
+        TCHECKER_VM_NEXT();
+      }
 
       // no-operation
-    case VM_NOP:
-      return 1;
+      TCHECKER_VM_INSTRUCTION(VM_NOP) { TCHECKER_VM_NEXT(); }
 
       // stack = v1 ... vK-4 1  output (vK-2 vK-1 s vK)   where s is a
       // parameter of VM_CLKCONSTR (strictness)
-    case VM_CLKCONSTR: {
-      tchecker::bytecode_t cmp = *++bytecode;
-      auto const bound = top_and_pop<tchecker::integer_t>();
-      auto const id2 = top_and_pop<tchecker::clock_id_t>();
-      auto const id1 = top_and_pop<tchecker::clock_id_t>();
-      static_assert(tchecker::LT == 0, "");
-      clkconstr.emplace_back(id1, id2, (cmp == 0 ? tchecker::LT : tchecker::LE), bound);
-      return 1;
-    }
+      TCHECKER_VM_INSTRUCTION(VM_CLKCONSTR)
+      {
+        tchecker::bytecode_t cmp = *++bytecode;
+        auto const bound = top_and_pop<tchecker::integer_t>();
+        auto const id2 = top_and_pop<tchecker::clock_id_t>();
+        auto const id1 = top_and_pop<tchecker::clock_id_t>();
+        static_assert(tchecker::LT == 0, "");
+        clkconstr.emplace_back(id1, id2, (cmp == 0 ? tchecker::LT : tchecker::LE), bound);
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... vK-3    output (vK-2 vK-1 vK)
-    case VM_CLKRESET: {
-      auto const value = top_and_pop<tchecker::integer_t>();
-      auto const right_id = top_and_pop<tchecker::clock_id_t>();
-      auto const left_id = top_and_pop<tchecker::clock_id_t>();
-      clkreset.emplace_back(left_id, right_id, value);
-      return 1;
-    }
+      TCHECKER_VM_INSTRUCTION(VM_CLKRESET)
+      {
+        auto const value = top_and_pop<tchecker::integer_t>();
+        auto const right_id = top_and_pop<tchecker::clock_id_t>();
+        auto const left_id = top_and_pop<tchecker::clock_id_t>();
+        clkreset.emplace_back(left_id, right_id, value);
+        TCHECKER_VM_NEXT();
+      }
 
       // push a new frame for local variables
-    case VM_PUSH_FRAME: {
-      _frames.emplace_back();
-      return 1;
-    }
+      TCHECKER_VM_INSTRUCTION(VM_PUSH_FRAME)
+      {
+        _frames.emplace_back();
+        TCHECKER_VM_NEXT();
+      }
+
       // pop the top-level frame
-    case VM_POP_FRAME: {
-      _frames.pop_back();
-      return 1;
-    }
+      TCHECKER_VM_INSTRUCTION(VM_POP_FRAME)
+      {
+        _frames.pop_back();
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... vK-1 [vK]
       // vK is replaced by the value of the local variable identified by vK.
-    case VM_VALUEAT_FRAME: {
-      auto const id = top_and_pop<tchecker::bytecode_t>();
-      push<tchecker::integer_t>(slot_of(id));
-      return top<tchecker::integer_t>();
-    }
+      TCHECKER_VM_INSTRUCTION(VM_VALUEAT_FRAME)
+      {
+        auto const id = top_and_pop<tchecker::bytecode_t>();
+        push<tchecker::integer_t>(slot_of(id));
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... vK-2
       // [vK-1] is assigned vK where vK-1 identifies a local variables.
-    case VM_ASSIGN_FRAME: {
-      auto const value = top_and_pop<tchecker::integer_t>();
-      auto const id = top_and_pop<tchecker::intvar_id_t>();
-      slot_of(id) = value;
-      return value;
-    }
+      TCHECKER_VM_INSTRUCTION(VM_ASSIGN_FRAME)
+      {
+        auto const value = top_and_pop<tchecker::integer_t>();
+        auto const id = top_and_pop<tchecker::intvar_id_t>();
+        slot_of(id) = value;
+        TCHECKER_VM_NEXT();
+      }
 
       // stack = v1 ... vK-2
       // [vK-1] is initialized with vK where vK-1 identifies a local variables.
-    case VM_INIT_FRAME: {
-      auto const value = top_and_pop<tchecker::intvar_id_t>();
-      auto const id = top_and_pop<tchecker::intval_base_t::capacity_t>();
-      _frames.back()[id] = static_cast<tchecker::integer_t>(value);
+      TCHECKER_VM_INSTRUCTION(VM_INIT_FRAME)
+      {
+        auto const value = top_and_pop<tchecker::intvar_id_t>();
+        auto const id = top_and_pop<tchecker::intval_base_t::capacity_t>();
+        _frames.back()[id] = static_cast<tchecker::integer_t>(value);
+        TCHECKER_VM_NEXT();
+      }
 
-      return 0;
+#if !defined(TCHECKER_VM_COMPUTED_GOTO)
+        default:
+          throw std::runtime_error("incomplete switch statement");
+        }
+      }
+#endif
+#undef TCHECKER_VM_NEXT
+#undef TCHECKER_VM_DISPATCH
+#undef TCHECKER_VM_INSTRUCTION
     }
+    catch (...) {
+      clear();
+      throw;
     }
-
-    // should never be reached
-    throw std::runtime_error("incomplete switch statement");
   }
 
+protected:
+
   using frame_t = std::map<tchecker::bytecode_t, tchecker::integer_t>;
 
   /*!
@@ -588,13 +645,55 @@ protected:
    */
   inline std::size_t size() const { return _stack.size(); }
 
-  bool _return;                             /*!< Return flag */
   std::vector<tchecker::bytecode_t> _stack; /*!< Interpretation stack */
   // NB: implemented as an std::vector for methods clear() and size()
 
   std::vector<frame_t> _frames;
 };
 
+/*!
+ \class no_tracking_t
+ \brief Tracking policy of tchecker::basic_vm_t that records nothing
+ */
+class no_tracking_t {
+public:
+  /*!
+   \brief Read access (no-op)
+   */
+  inline void read(tchecker::intvar_id_t) {}
+
+  /*!
+   \brief Write access (no-op)
+   */
+  inline void write(tchecker::intvar_id_t, tchecker::integer_t) {}
+};
+
+/*!
+ \class vm_t
+ \brief Virtual machine for bytecode interpretation, without tracking of accesses to bounded integer variables
+ */
+class vm_t : public tchecker::basic_vm_t<tchecker::no_tracking_t> {
+public:
+  /*!
+   \brief Bytecode interpreter
+   \param bytecode : tchecker bytecode
+   \param intval : valuation of bounded integer variables
+   \param clkconstr : container of clock constraints
+   \param clkreset : container of clock resets
+   \return see tchecker::basic_vm_t::run
+   \post see tchecker::basic_vm_t::run
+   \throw std::runtime_error : if bytecode interpretation fails
+   \throw std::out_of_range : if out-of-bound array access
+   */
+  inline tchecker::integer_t run(tchecker::bytecode_t const * bytecode, tchecker::intval_t & intval,
+                                 tchecker::clock_constraint_container_t & clkconstr,
+                                 tchecker::clock_reset_container_t & clkreset)
+  {
+    tchecker::no_tracking_t tracking;
+    return tchecker::basic_vm_t<tchecker::no_tracking_t>::run(bytecode, intval, clkconstr, clkreset, tracking);
+  }
+};
+
 } // end of namespace tchecker
 
 #endif // TCHECKER_VM_HH
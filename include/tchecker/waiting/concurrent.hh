@@ -0,0 +1,569 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_WAITING_CONCURRENT_HH
+#define TCHECKER_WAITING_CONCURRENT_HH
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "tchecker/waiting/waiting.hh"
+
+/*!
+ \file concurrent.hh
+ \brief Lock-free waiting containers for parallel explorations
+ \note Contrary to tchecker::waiting::waiting_t, these containers store raw pointers to elements that are kept
+ alive elsewhere (e.g. by a graph), and their accessors are approximate when other threads update the container
+ */
+
+namespace tchecker {
+
+namespace waiting {
+
+/*!
+ \class concurrent_status_t
+ \brief Atomic access to the waiting status of elements
+ \note Several threads may insert, remove and claim the same element: each insertion of an element allows at
+ most one successful claim, and a removed element cannot be claimed until it is inserted again. Hence, removing
+ an element from a concurrent waiting container takes constant time, whatever the container
+ */
+class concurrent_status_t {
+public:
+  /*!
+   \brief Mark an element waiting
+   \param e : element
+   \post e is waiting
+   */
+  static inline void set_waiting(tchecker::waiting::element_t const & e)
+  {
+    e._status.store(tchecker::waiting::WAITING, std::memory_order_release);
+  }
+
+  /*!
+   \brief Mark an element not waiting
+   \param e : element
+   \post e is not waiting
+   */
+  static inline void remove(tchecker::waiting::element_t const & e)
+  {
+    e._status.store(tchecker::waiting::NOT_WAITING, std::memory_order_release);
+  }
+
+  /*!
+   \brief Claim an element
+   \param e : element
+   \return true if e was waiting, false otherwise
+   \post e is not waiting
+   \note when several threads claim a waiting element, exactly one of them succeeds
+   */
+  static inline bool claim(tchecker::waiting::element_t const & e)
+  {
+    enum tchecker::waiting::status_t expected = tchecker::waiting::WAITING;
+    return e._status.compare_exchange_strong(expected, tchecker::waiting::NOT_WAITING, std::memory_order_acq_rel,
+                                             std::memory_order_acquire);
+  }
+
+  /*!
+   \brief Accessor
+   \param e : element
+   \return true if e is waiting, false otherwise
+   */
+  static inline bool waiting(tchecker::waiting::element_t const & e)
+  {
+    return e._status.load(std::memory_order_acquire) == tchecker::waiting::WAITING;
+  }
+};
+
+/*!
+ \class chase_lev_deque_t
+ \brief Work-stealing deque (Chase and Lev, in the formulation of Le, Pop, Cohen and Zappa Nardelli)
+ \tparam T : type of elements, should be trivially copyable (e.g. raw pointers)
+ \note The owner thread pushes and pops at the bottom (lifo), other threads steal at the top (fifo). The
+ deque grows when full. The previous arrays are kept until destruction, since thieves may still read them
+ */
+template <class T> class chase_lev_deque_t {
+  static_assert(std::is_trivially_copyable<T>::value, "chase_lev_deque_t requires trivially copyable elements");
+
+public:
+  /*!
+   \brief Constructor
+   \param capacity : initial capacity, rounded up to a power of 2
+   \throw std::invalid_argument : if capacity is 0
+   */
+  explicit chase_lev_deque_t(std::size_t capacity = 1024) : _top(0), _bottom(0)
+  {
+    if (capacity == 0)
+      throw std::invalid_argument("Work-stealing deque capacity should be positive");
+    std::size_t c = 1;
+    while (c < capacity)
+      c <<= 1;
+    _arrays.push_back(std::make_unique<array_t>(c));
+    _array.store(_arrays.back().get(), std::memory_order_relaxed);
+  }
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  chase_lev_deque_t(tchecker::waiting::chase_lev_deque_t<T> const &) = delete;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::waiting::chase_lev_deque_t<T> & operator=(tchecker::waiting::chase_lev_deque_t<T> const &) = delete;
+
+  /*!
+   \brief Push
+   \param t : element
+   \post t has been pushed at the bottom of this deque
+   \note should only be called by the owner thread
+   */
+  void push(T t)
+  {
+    std::int64_t b = _bottom.load(std::memory_order_relaxed);
+    std::int64_t top = _top.load(std::memory_order_acquire);
+    array_t * a = _array.load(std::memory_order_relaxed);
+    if (b - top > static_cast<std::int64_t>(a->mask))
+      a = grow(a, top, b);
+    a->put(b, t);
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(b + 1, std::memory_order_relaxed);
+  }
+
+  /*!
+   \brief Pop
+   \param t : an element
+   \return true if an element has been popped, false if this deque is empty
+   \post if true is returned, the bottom element has been removed from this deque and stored in t
+   \note should only be called by the owner thread
+   */
+  bool pop(T & t)
+  {
+    std::int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+    array_t * a = _array.load(std::memory_order_relaxed);
+    _bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = _top.load(std::memory_order_relaxed);
+
+    if (top > b) { // empty
+      _bottom.store(b + 1, std::memory_order_relaxed);
+      return false;
+    }
+    t = a->get(b);
+    if (top == b) { // last element: race with thieves
+      bool const won = _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      _bottom.store(b + 1, std::memory_order_relaxed);
+      return won;
+    }
+    return true;
+  }
+
+  /*!
+   \brief Steal
+   \param t : an element
+   \return true if an element has been stolen, false if this deque is empty or if another thread took the top
+   element concurrently
+   \post if true is returned, the top element has been removed from this deque and stored in t
+   \note can be called by any thread
+   */
+  bool steal(T & t)
+  {
+    std::int64_t top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t b = _bottom.load(std::memory_order_acquire);
+    if (top >= b)
+      return false;
+    array_t * a = _array.load(std::memory_order_acquire);
+    T x = a->get(top);
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+      return false;
+    t = x;
+    return true;
+  }
+
+  /*!
+   \brief Accessor
+   \return number of elements in this deque
+   \note the result is approximate if other threads update this deque
+   */
+  std::size_t size() const
+  {
+    std::int64_t b = _bottom.load(std::memory_order_relaxed);
+    std::int64_t top = _top.load(std::memory_order_relaxed);
+    return (b > top ? static_cast<std::size_t>(b - top) : 0);
+  }
+
+  /*!
+   \brief Accessor
+   \return true if this deque is empty, false otherwise
+   \note the result is approximate if other threads update this deque
+   */
+  inline bool empty() const { return size() == 0; }
+
+private:
+  /*!
+   \brief Circular array of elements
+   */
+  struct array_t {
+    explicit array_t(std::size_t capacity) : mask(capacity - 1), elements(new std::atomic<T>[capacity]) {}
+
+    inline T get(std::int64_t i) const { return elements[i & mask].load(std::memory_order_relaxed); }
+
+    inline void put(std::int64_t i, T t) { elements[i & mask].store(t, std::memory_order_relaxed); }
+
+    std::size_t const mask;                       /*!< Capacity - 1 (capacity is a power of 2) */
+    std::unique_ptr<std::atomic<T>[]> elements; /*!< Elements */
+  };
+
+  /*!
+   \brief Grow the array
+   \param a : current array
+   \param top : top index
+   \param b : bottom index
+   \return new array, twice as large as a, that contains the elements of a between top and b
+   \post the new array is the array of this deque, and a is kept until destruction
+   */
+  array_t * grow(array_t * a, std::int64_t top, std::int64_t b)
+  {
+    _arrays.push_back(std::make_unique<array_t>(2 * (a->mask + 1)));
+    array_t * bigger = _arrays.back().get();
+    for (std::int64_t i = top; i < b; ++i)
+      bigger->put(i, a->get(i));
+    _array.store(bigger, std::memory_order_release);
+    return bigger;
+  }
+
+  alignas(64) std::atomic<std::int64_t> _top;    /*!< Top index (thieves) */
+  alignas(64) std::atomic<std::int64_t> _bottom; /*!< Bottom index (owner) */
+  std::atomic<array_t *> _array;                 /*!< Current array */
+  std::vector<std::unique_ptr<array_t>> _arrays; /*!< All allocated arrays (owner) */
+};
+
+/*!
+ \class mpmc_queue_t
+ \brief Bounded lock-free multiple-producer multiple-consumer queue (fifo, after D. Vyukov)
+ \tparam T : type of elements
+ */
+template <class T> class mpmc_queue_t {
+public:
+  /*!
+   \brief Constructor
+   \param capacity : capacity, rounded up to a power of 2
+   \throw std::invalid_argument : if capacity is 0
+   */
+  explicit mpmc_queue_t(std::size_t capacity) : _enqueue(0), _dequeue(0)
+  {
+    if (capacity == 0)
+      throw std::invalid_argument("MPMC queue capacity should be positive");
+    std::size_t c = 1;
+    while (c < capacity)
+      c <<= 1;
+    _mask = c - 1;
+    _cells.reset(new cell_t[c]);
+    for (std::size_t i = 0; i < c; ++i)
+      _cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  mpmc_queue_t(tchecker::waiting::mpmc_queue_t<T> const &) = delete;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::waiting::mpmc_queue_t<T> & operator=(tchecker::waiting::mpmc_queue_t<T> const &) = delete;
+
+  /*!
+   \brief Push
+   \param t : element
+   \return true if t has been inserted at the end of this queue, false if this queue is full
+   */
+  bool try_push(T const & t)
+  {
+    cell_t * cell = nullptr;
+    std::size_t pos = _enqueue.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &_cells[pos & _mask];
+      std::size_t const seq = cell->sequence.load(std::memory_order_acquire);
+      std::intptr_t const diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+      if (diff == 0) {
+        if (_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0)
+        return false;
+      else
+        pos = _enqueue.load(std::memory_order_relaxed);
+    }
+    cell->element = t;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /*!
+   \brief Pop
+   \param t : an element
+   \return true if an element has been popped, false if this queue is empty
+   \post if true is returned, the first element has been removed from this queue and stored in t
+   */
+  bool try_pop(T & t)
+  {
+    cell_t * cell = nullptr;
+    std::size_t pos = _dequeue.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &_cells[pos & _mask];
+      std::size_t const seq = cell->sequence.load(std::memory_order_acquire);
+      std::intptr_t const diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (_dequeue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0)
+        return false;
+      else
+        pos = _dequeue.load(std::memory_order_relaxed);
+    }
+    t = std::move(cell->element);
+    cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+    return true;
+  }
+
+  /*!
+   \brief Accessor
+   \return capacity of this queue
+   */
+  inline std::size_t capacity() const { return _mask + 1; }
+
+  /*!
+   \brief Accessor
+   \return number of elements in this queue
+   \note the result is approximate if other threads update this queue
+   */
+  std::size_t size() const
+  {
+    std::size_t const e = _enqueue.load(std::memory_order_relaxed);
+    std::size_t const d = _dequeue.load(std::memory_order_relaxed);
+    return (e > d ? e - d : 0);
+  }
+
+  /*!
+   \brief Accessor
+   \return true if this queue is empty, false otherwise
+   \note the result is approximate if other threads update this queue
+   */
+  inline bool empty() const { return size() == 0; }
+
+private:
+  /*!
+   \brief Cell of the queue
+   */
+  struct cell_t {
+    std::atomic<std::size_t> sequence; /*!< Sequence number */
+    T element;                         /*!< Element */
+  };
+
+  std::unique_ptr<cell_t[]> _cells;           /*!< Cells */
+  std::size_t _mask;                          /*!< Capacity - 1 (capacity is a power of 2) */
+  alignas(64) std::atomic<std::size_t> _enqueue; /*!< Enqueue position */
+  alignas(64) std::atomic<std::size_t> _dequeue; /*!< Dequeue position */
+};
+
+/*!
+ \class work_stealing_waiting_t
+ \brief Concurrent waiting container with one work-stealing deque per worker, and fast remove
+ \tparam T : type of elements, should be a raw pointer to a type deriving from tchecker::waiting::element_t
+ \note Each worker takes its own elements in lifo order, and steals the oldest elements of the other workers
+ when its deque is empty. Removed elements are skipped when they are taken
+ */
+template <class T> class work_stealing_waiting_t {
+public:
+  /*!
+   \brief Constructor
+   \param workers : number of workers
+   \param capacity : initial capacity of each deque
+   \throw std::invalid_argument : if workers or capacity is 0
+   */
+  explicit work_stealing_waiting_t(std::size_t workers, std::size_t capacity = 1024)
+  {
+    if (workers == 0)
+      throw std::invalid_argument("Work-stealing waiting container needs at least one worker");
+    for (std::size_t i = 0; i < workers; ++i)
+      _deques.push_back(std::make_unique<tchecker::waiting::chase_lev_deque_t<T>>(capacity));
+  }
+
+  /*!
+   \brief Accessor
+   \return number of workers
+   */
+  inline std::size_t workers() const { return _deques.size(); }
+
+  /*!
+   \brief Insert
+   \param worker : worker
+   \param t : element
+   \pre worker < workers(), and worker is the calling thread
+   \post t is waiting and it has been pushed on the deque of worker
+   */
+  void insert(std::size_t worker, T t)
+  {
+    tchecker::waiting::concurrent_status_t::set_waiting(*t);
+    _deques[worker]->push(t);
+  }
+
+  /*!
+   \brief Insert initial elements
+   \param elements : elements
+   \pre no thread accesses this container
+   \post the elements in elements are waiting, and they have been pushed evenly on the deques of the workers (the
+   i-th element on the deque of worker i modulo workers())
+   \note seeding the deques evenly lets all the workers start without stealing
+   */
+  void seed(std::vector<T> const & elements)
+  {
+    std::size_t const n = _deques.size();
+    for (std::size_t i = 0; i < elements.size(); ++i) {
+      tchecker::waiting::concurrent_status_t::set_waiting(*elements[i]);
+      _deques[i % n]->push(elements[i]);
+    }
+  }
+
+  /*!
+   \brief Take a waiting element
+   \param worker : worker
+   \param t : an element
+   \pre worker < workers(), and worker is the calling thread
+   \return true if a waiting element has been found, false otherwise
+   \post if true is returned, t is an element that has been claimed by worker (it is not waiting anymore). The
+   deque of worker is searched first, then the others are stolen from in turn
+   \note false may be returned while other threads insert elements: termination should be detected by the caller
+   */
+  bool take(std::size_t worker, T & t)
+  {
+    while (_deques[worker]->pop(t))
+      if (tchecker::waiting::concurrent_status_t::claim(*t))
+        return true;
+    std::size_t const n = _deques.size();
+    for (std::size_t i = 1; i < n; ++i) {
+      tchecker::waiting::chase_lev_deque_t<T> & victim = *_deques[(worker + i) % n];
+      while (!victim.empty())
+        if (victim.steal(t) && tchecker::waiting::concurrent_status_t::claim(*t))
+          return true;
+    }
+    return false;
+  }
+
+  /*!
+   \brief Remove an element
+   \param t : element
+   \post t is not waiting anymore. It will be skipped when taken from a deque
+   \note constant time
+   */
+  inline void remove(T t) { tchecker::waiting::concurrent_status_t::remove(*t); }
+
+  /*!
+   \brief Accessor
+   \return number of elements in the deques
+   \note removed elements that are still stored are counted, and the result is approximate if other threads
+   update this container
+   */
+  std::size_t size() const
+  {
+    std::size_t s = 0;
+    for (auto const & d : _deques)
+      s += d->size();
+    return s;
+  }
+
+  /*!
+   \brief Accessor
+   \return true if all deques are empty, false otherwise
+   \note see size()
+   */
+  inline bool empty() const { return size() == 0; }
+
+private:
+  std::vector<std::unique_ptr<tchecker::waiting::chase_lev_deque_t<T>>> _deques; /*!< Deques of workers */
+};
+
+/*!
+ \class concurrent_queue_waiting_t
+ \brief Concurrent waiting queue (fifo) with fast remove, for breadth-first explorations
+ \tparam T : type of elements, should be a raw pointer to a type deriving from tchecker::waiting::element_t
+ */
+template <class T> class concurrent_queue_waiting_t {
+public:
+  /*!
+   \brief Constructor
+   \param capacity : capacity of the queue
+   \throw std::invalid_argument : if capacity is 0
+   */
+  explicit concurrent_queue_waiting_t(std::size_t capacity) : _queue(capacity) {}
+
+  /*!
+   \brief Insert
+   \param t : element
+   \return true if t has been inserted, false if the queue is full
+   \post if true is returned, t is waiting and it has been inserted at the end of the queue
+   */
+  bool insert(T t)
+  {
+    tchecker::waiting::concurrent_status_t::set_waiting(*t);
+    if (_queue.try_push(t))
+      return true;
+    tchecker::waiting::concurrent_status_t::remove(*t);
+    return false;
+  }
+
+  /*!
+   \brief Take a waiting element
+   \param t : an element
+   \return true if a waiting element has been found, false if the queue is empty
+   \post if true is returned, t is the first waiting element of the queue, which has been claimed by the caller
+   (it is not waiting anymore). Removed elements before t have been dropped
+   */
+  bool take(T & t)
+  {
+    while (_queue.try_pop(t))
+      if (tchecker::waiting::concurrent_status_t::claim(*t))
+        return true;
+    return false;
+  }
+
+  /*!
+   \brief Remove an element
+   \param t : element
+   \post t is not waiting anymore. It will be skipped when taken from the queue
+   \note constant time
+   */
+  inline void remove(T t) { tchecker::waiting::concurrent_status_t::remove(*t); }
+
+  /*!
+   \brief Accessor
+   \return number of elements in the queue
+   \note removed elements that are still stored are counted, and the result is approximate if other threads
+   update this container
+   */
+  inline std::size_t size() const { return _queue.size(); }
+
+  /*!
+   \brief Accessor
+   \return true if the queue is empty, false otherwise
+   \note see size()
+   */
+  inline bool empty() const { return _queue.empty(); }
+
+private:
+  tchecker::waiting::mpmc_queue_t<T> _queue; /*!< Queue */
+};
+
+} // end of namespace waiting
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_WAITING_CONCURRENT_HH
@@ -7,6 +7,7 @@
 
 #include <stdexcept>
 
+#include "tchecker/waiting/priority_queue.hh"
 #include "tchecker/waiting/queue.hh"
 #include "tchecker/waiting/stack.hh"
 #include "tchecker/waiting/waiting.hh"
@@ -19,20 +20,26 @@ namespace waiting {
  \brief Type of waiting policies
 */
 enum policy_t {
-  QUEUE = 0,         /*!< Queue: fifo polocy */
-  FAST_REMOVE_QUEUE, /*!< Queue: fifo policy, with fast removal of elements */
-  STACK,             /*!< Stack: lifo policy */
-  FAST_REMOVE_STACK, /*!< Stack: lifo policy, with fast removal of elements */
+  QUEUE = 0,                  /*!< Queue: fifo polocy */
+  FAST_REMOVE_QUEUE,          /*!< Queue: fifo policy, with fast removal of elements */
+  STACK,                      /*!< Stack: lifo policy */
+  FAST_REMOVE_STACK,          /*!< Stack: lifo policy, with fast removal of elements */
+  PRIORITY_QUEUE,             /*!< Priority queue: smallest priority first, fifo among equal priorities */
+  FAST_REMOVE_PRIORITY_QUEUE, /*!< Priority queue, with fast removal of elements */
 };
 
 /*!
  \brief Factory of waiting containers
  \tparam T : type of waiting elements
  \param policy : waiting policy
+ \param priority : priority function (only used by priority queues)
  \return a newly allocated empty waiting container of elements of type T
  that implements policy
+ \throw std::invalid_argument : if policy is a priority queue and priority is empty
  */
-template <class T> tchecker::waiting::waiting_t<T> * factory(enum policy_t policy)
+template <class T>
+tchecker::waiting::waiting_t<T> * factory(enum policy_t policy,
+                                          tchecker::waiting::priority_function_t<T> const & priority = nullptr)
 {
   switch (policy) {
   case tchecker::waiting::QUEUE:
@@ -43,6 +50,10 @@ template <class T> tchecker::waiting::waiting_t<T> * factory(enum policy_t polic
     return new tchecker::waiting::stack_t<T>{};
   case tchecker::waiting::FAST_REMOVE_STACK:
     return new tchecker::waiting::fast_remove_stack_t<T>{};
+  case tchecker::waiting::PRIORITY_QUEUE:
+    return new tchecker::waiting::priority_queue_t<T>{priority};
+  case tchecker::waiting::FAST_REMOVE_PRIORITY_QUEUE:
+    return new tchecker::waiting::fast_remove_priority_queue_t<T>{priority};
   default:
     throw std::invalid_argument("Unknow waiting policy");
   }
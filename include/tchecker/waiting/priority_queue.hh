@@ -0,0 +1,156 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_WAITING_PRIORITY_QUEUE_HH
+#define TCHECKER_WAITING_PRIORITY_QUEUE_HH
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "tchecker/waiting/waiting.hh"
+
+/*!
+ \file priority_queue.hh
+ \brief Waiting priority queue (guided search)
+ */
+
+namespace tchecker {
+
+namespace waiting {
+
+/*!
+ \brief Type of priorities (elements with smaller priorities come first)
+ */
+using priority_t = std::int64_t;
+
+/*!
+ \brief Type of priority functions
+ \tparam T : type of waiting elements
+ */
+template <class T> using priority_function_t = std::function<tchecker::waiting::priority_t(T const &)>;
+
+/*!
+ \class priority_queue_t
+ \brief Waiting container implementing a priority queue: elements with smallest priority first, and in insertion
+ order (fifo) among elements with the same priority
+ \tparam T : type of waiting elements
+ \note the priority of an element is computed once, when the element is inserted
+ */
+template <class T> class priority_queue_t final : public tchecker::waiting::waiting_t<T> {
+public:
+  /*!
+   \brief Constructor
+   \param priority : priority function
+   \throw std::invalid_argument : if priority is empty
+   */
+  explicit priority_queue_t(tchecker::waiting::priority_function_t<T> const & priority) : _priority(priority), _count(0)
+  {
+    if (!_priority)
+      throw std::invalid_argument("Priority queue requires a priority function");
+  }
+
+  /*!
+   \brief Destructor
+  */
+  virtual ~priority_queue_t() = default;
+
+  /*!
+   \brief Accessor
+   \return true if the container is empty, false otherwise
+   */
+  virtual inline bool empty() { return _pq.empty(); }
+
+  /*!
+   \brief Accessor
+   \return number of elements in the container
+   */
+  virtual inline std::size_t size() { return _pq.size(); }
+
+  /*!
+   \brief Clear the container
+   \post this container is empty
+   */
+  virtual inline void clear() { _pq = queue_t{}; }
+
+  /*!
+   \brief Insert
+   \param t : element
+   \post t has been inserted with priority given by the priority function
+   */
+  virtual inline void insert(T const & t) { _pq.emplace(_priority(t), _count++, t); }
+
+  /*!
+   \brief Remove first element
+   \pre not empty()
+   \post first element has been removed from the queue
+   */
+  virtual inline void remove_first() { _pq.pop(); }
+
+  /*!
+   \brief Accessor
+   \pre not empty()
+   \return element with smallest priority in the queue
+   */
+  virtual inline T const & first() { return std::get<2>(_pq.top()); }
+
+  /*!
+    \brief Remove an element
+    \param t : element
+    \post all occurrences of t have been removed from the queue
+    \note complexity is linear in the size of the container
+  */
+  virtual void remove(T const & t)
+  {
+    std::vector<entry_t> entries;
+    entries.reserve(_pq.size());
+    for (; !_pq.empty(); _pq.pop())
+      if (std::get<2>(_pq.top()) != t)
+        entries.push_back(_pq.top());
+    _pq = queue_t{later_t{}, std::move(entries)};
+  }
+
+private:
+  /*!
+   \brief Type of entries: priority, insertion rank, element
+   */
+  using entry_t = std::tuple<tchecker::waiting::priority_t, std::uint64_t, T>;
+
+  /*!
+   \class later_t
+   \brief Order on entries: e1 is after e2 if it has a bigger priority, or the same priority and a bigger rank
+   */
+  class later_t {
+  public:
+    bool operator()(entry_t const & e1, entry_t const & e2) const
+    {
+      return std::tie(std::get<0>(e1), std::get<1>(e1)) > std::tie(std::get<0>(e2), std::get<1>(e2));
+    }
+  };
+
+  /*!
+   \brief Type of priority queue: min-heap of entries
+   */
+  using queue_t = std::priority_queue<entry_t, std::vector<entry_t>, later_t>;
+
+  tchecker::waiting::priority_function_t<T> _priority; /*!< Priority function */
+  std::uint64_t _count;                                 /*!< Number of inserted elements */
+  queue_t _pq;                                          /*!< Container */
+};
+
+/*!
+ \brief Waiting priority queue with fast remove
+ \tparam T : type of elements, should be a pointer to a type deriving from tchecker::waiting::element_t
+*/
+template <class T>
+using fast_remove_priority_queue_t = tchecker::waiting::fast_remove_waiting_t<tchecker::waiting::priority_queue_t<T>>;
+
+} // end of namespace waiting
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_WAITING_PRIORITY_QUEUE_HH
@@ -7,6 +7,7 @@
 
 #include <deque>
 
+#include "tchecker/utils/probes.hh"
 #include "tchecker/waiting/waiting.hh"
 
 /*!
@@ -36,6 +37,12 @@ public:
    */
   virtual inline bool empty() { return _dq.empty(); }
 
+  /*!
+   \brief Accessor
+   \return number of elements in the container
+   */
+  virtual inline std::size_t size() { return _dq.size(); }
+
   /*!
    \brief Clear the container
    \post this container is empty
@@ -47,14 +54,22 @@ public:
    \param t : element
    \post t has been inserted at the end of the queue
    */
-  virtual inline void insert(T const & t) { _dq.push_back(t); }
+  virtual inline void insert(T const & t)
+  {
+    _dq.push_back(t);
+    TCHECKER_PROBE1(waiting_insert, _dq.size());
+  }
 
   /*!
    \brief Remove first element
    \pre not empty()
    \post first element has been removed from the queue
    */
-  virtual inline void remove_first() { _dq.pop_front(); }
+  virtual inline void remove_first()
+  {
+    _dq.pop_front();
+    TCHECKER_PROBE1(waiting_remove, _dq.size());
+  }
 
   /*!
    \brief Accessor
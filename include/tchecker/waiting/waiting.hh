@@ -5,7 +5,9 @@
 #ifndef TCHECKER_WAITING_HH
 #define TCHECKER_WAITING_HH
 
+#include <atomic>
 #include <cassert>
+#include <cstddef>
 
 /*!
  \file waiting.hh
@@ -42,6 +44,14 @@ public:
    */
   virtual bool empty() = 0;
 
+  /*!
+   \brief Accessor
+   \return number of elements in the container
+   \note this method is not marked const to allow implementations that update
+   the container (see tchecker::waiting::fast_remove_waiting_t)
+   */
+  virtual std::size_t size() = 0;
+
   /*!
    \brief Clear the container
    \post this container is empty
@@ -84,8 +94,9 @@ public:
   virtual void remove(T const & t) = 0;
 };
 
-// forward declaration
+// forward declarations
 template <class W> class fast_remove_waiting_t;
+class concurrent_status_t;
 
 /*!
 \brief Status of elements in a fast-remove waiting container
@@ -106,10 +117,23 @@ public:
   */
   element_t();
 
+  /*!
+   \brief Copy constructor
+   \post this element has the same waiting status as e
+   */
+  element_t(tchecker::waiting::element_t const & e);
+
+  /*!
+   \brief Assignment operator
+   \post this element has the same waiting status as e
+   */
+  tchecker::waiting::element_t & operator=(tchecker::waiting::element_t const & e);
+
 protected:
   template <class W> friend class fast_remove_waiting_t;
+  friend class concurrent_status_t;
 
-  mutable enum tchecker::waiting::status_t _status; /*!< Waiting status */
+  mutable std::atomic<enum tchecker::waiting::status_t> _status; /*!< Waiting status (see concurrent_status_t) */
 };
 
 /*!
@@ -163,6 +187,17 @@ public:
     return _w.empty();
   }
 
+  /*!
+   \brief Accessor
+   \return number of elements in the container
+   \note removed elements that are still stored by the container are counted
+   */
+  virtual std::size_t size()
+  {
+    remove_non_waiting_first();
+    return _w.size();
+  }
+
   /*!
    \brief Clear the container
    \post this container is empty
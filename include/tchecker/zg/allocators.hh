@@ -6,12 +6,15 @@
 #define TCHECKER_ZG_ALLOCATORS_HH
 
 #include <memory>
+#include <stdexcept>
 #include <type_traits>
 
 #include "tchecker/ta/allocators.hh"
 #include "tchecker/utils/cache.hh"
+#include "tchecker/utils/record_pool.hh"
 #include "tchecker/zg/state.hh"
 #include "tchecker/zg/transition.hh"
+#include "tchecker/zg/zone_registry.hh"
 
 /*!
  \file allocators.hh
@@ -33,11 +36,10 @@ template <class STATE> class state_pool_allocator_t : private tchecker::ta::deta
   static_assert(std::is_base_of<tchecker::zg::state_t, STATE>::value, "");
 
   /*!
-   \brief Type of cache of zones
-  */
-  using zone_cache_t =
-      tchecker::periodic_collectable_cache_t<tchecker::zg::zone_sptr_t, tchecker::intrusive_shared_ptr_delegate_hash_t,
-                                             tchecker::intrusive_shared_ptr_delegate_equal_to_t>;
+   \brief Type of pool of records of state components
+   */
+  using record_pool_t =
+      tchecker::record_pool_t<tchecker::shared_vloc_t, tchecker::shared_intval_t, tchecker::zg::shared_zone_t>;
 
 public:
   /*!
@@ -74,10 +76,8 @@ public:
       : tchecker::ta::details::state_pool_allocator_t<STATE>(state_alloc_nb, vloc_alloc_nb, vloc_capacity, intval_alloc_nb,
                                                              intval_capacity, table_size),
         _zone_dimension(zone_dimension),
-        _zone_pool(zone_alloc_nb, tchecker::allocation_size_t<tchecker::zg::shared_zone_t>::alloc_size(_zone_dimension)),
-        _zone_cache(new zone_cache_t(table_size))
+        _zones(std::make_shared<tchecker::zg::zone_store_t>(zone_alloc_nb, zone_dimension, table_size)), _shared_zones(false)
   {
-    _zone_pool.enroll(_zone_cache);
   }
 
   /*!
@@ -111,22 +111,52 @@ public:
    \brief Construct state
    \param args : arguments to a constructor of STATE beyond the zone
    \return a new instance of STATE constructed from a newly allocated zone, and args
+   \note unused states and components are collected first if the collection trigger fires
    */
   template <class... ARGS> tchecker::intrusive_shared_ptr_t<STATE> construct(ARGS &&... args)
   {
-    return tchecker::ta::details::state_pool_allocator_t<STATE>::construct(_zone_pool.construct(_zone_dimension), args...);
+    if (_collection_trigger.tick())
+      collect();
+    if (_records != nullptr) {
+      auto && [vloc, intval, zone] = _records->construct(vloc_capacity(), intval_capacity(), _zone_dimension);
+      return tchecker::ta::details::state_pool_allocator_t<STATE>::construct_from_components(vloc, intval, zone, args...);
+    }
+    return tchecker::ta::details::state_pool_allocator_t<STATE>::construct(_zones->pool().construct(_zone_dimension), args...);
   }
 
   /*!
    \brief Clone state
    \param s : a state
    \return a new instance of STATE that is a clone of s
+   \note unused states and components are collected first if the collection trigger fires
   */
   template <class... ARGS> tchecker::intrusive_shared_ptr_t<STATE> clone(STATE const & s)
   {
+    if (_collection_trigger.tick())
+      collect();
     return tchecker::zg::details::state_pool_allocator_t<STATE>::construct_from_state(s);
   }
 
+  /*!
+   \brief Clone state, sharing its valuation of bounded integer variables
+   \param s : a state
+   \return a new instance of STATE that is a clone of s, except that its valuation of bounded integer variables is the
+   one in s (not a copy)
+   \pre see tchecker::ta::details::state_pool_allocator_t::clone_sharing_intval
+   \note unused states and components are collected first if the collection trigger fires
+   \note same as clone(s) when state components are allocated in records (see allocate_records): the valuation of
+   bounded integer variables is copied into the record of the new state
+  */
+  tchecker::intrusive_shared_ptr_t<STATE> clone_sharing_intval(STATE const & s)
+  {
+    if (_records != nullptr)
+      return clone(s);
+    if (_collection_trigger.tick())
+      collect();
+    return tchecker::ta::details::state_pool_allocator_t<STATE>::construct_from_state_sharing_intval(
+        s, _zones->pool().construct(s.zone()));
+  }
+
   /*!
    \brief Destruct state
    \param p : pointer to state
@@ -144,10 +174,24 @@ public:
 
     auto zone_ptr = p->zone_ptr();
 
+    if (_records != nullptr) {
+      auto vloc_ptr = p->vloc_ptr();
+      auto intval_ptr = p->intval_ptr();
+
+      if (!tchecker::ta::details::state_pool_allocator_t<STATE>::destruct_state(p))
+        return false;
+
+      _records->destruct(zone_ptr);
+      _records->destruct(intval_ptr);
+      _records->destruct(vloc_ptr);
+
+      return true;
+    }
+
     if (!tchecker::ta::details::state_pool_allocator_t<STATE>::destruct(p))
       return false;
 
-    _zone_pool.destruct(zone_ptr);
+    _zones->pool().destruct(zone_ptr);
 
     return true;
   }
@@ -163,9 +207,42 @@ public:
   void share(tchecker::intrusive_shared_ptr_t<STATE> const & p)
   {
     tchecker::ta::details::state_pool_allocator_t<STATE>::share(p);
-    p->zone_ptr() = _zone_cache->find_else_add(p->zone_ptr());
+    tchecker::zg::zone_sptr_t zone = p->zone_ptr();
+    p->zone_ptr() = _zones->cache().find_else_add(zone);
+    // a zone that has been replaced by a shared one is released at once, so that its chunk is reused by the next
+    // allocation instead of waiting for collection
+    if (p->zone_ptr() != zone)
+      destruct_zone(zone);
   }
 
+  /*!
+   \brief Share state components with other states, with a precomputed hash code of the zone
+   \param p : pointer to state
+   \param zone_hash : hash code of the zone in the state pointed by p
+   \pre p has been constructed by this allocator
+   \pre p is not nullptr
+   \pre zone_hash == p->zone().hash()
+   \post same as share(p)
+   \note saves the hash of the zone, the most expensive part of sharing on zones of large dimension, when it has been
+   computed beforehand (e.g. by the threads that have computed the state)
+  */
+  void share(tchecker::intrusive_shared_ptr_t<STATE> const & p, std::size_t zone_hash)
+  {
+    tchecker::ta::details::state_pool_allocator_t<STATE>::share(p);
+    tchecker::zg::zone_sptr_t zone = p->zone_ptr();
+    p->zone_ptr() = _zones->cache().find_else_add(zone, zone_hash);
+    if (p->zone_ptr() != zone)
+      destruct_zone(zone);
+  }
+
+  /*!
+   \brief Prefetch the sharing of a zone
+   \param zone_hash : hash code of a zone
+   \post the slot where zones with hash code zone_hash are shared is being loaded in the cache of the processor
+   \note hides the cache miss of a later call to share(p, zone_hash)
+  */
+  inline void prefetch(std::size_t zone_hash) { _zones->cache().prefetch(zone_hash); }
+
   /*!
    \brief Collect unused states
    \post Unused states, unused tuples of locations, and unused valuations of bounded integer variables have been collected
@@ -173,29 +250,108 @@ public:
   void collect()
   {
     tchecker::ta::details::state_pool_allocator_t<STATE>::collect();
-    _zone_cache->collect();
-    _zone_pool.collect();
+    _zones->collect();
+    if (_records != nullptr)
+      _records->collect();
   }
 
+  /*!
+   \brief Set collection trigger
+   \param trigger : a collection trigger
+   \post collect() is called before constructing a state when trigger fires
+   \note the trigger should only be enabled when no state with a null reference counter is still in use
+   */
+  void collection_trigger(tchecker::collection_trigger_t const & trigger) { _collection_trigger = trigger; }
+
   /*!
    \brief Destruct all allocated states
    \post All allocated states, zones, tuples of locations and valuations of
    bounded integer variables have been destructed
    \note invalidates all pointers to states, zones, tuple of locations and
    valuations of bounded integer variables allocated by this allocator
+   \note if zones are shared with other allocators (see share_zones), only the zones that are not used
+   anymore are destructed
    */
   void destruct_all()
   {
     tchecker::ta::details::state_pool_allocator_t<STATE>::destruct_all();
-    _zone_cache->clear();
-    _zone_pool.destruct_all();
+    if (_shared_zones)
+      _zones->collect();
+    else
+      _zones->destruct_all();
+    if (_records != nullptr)
+      _records->destruct_all();
+  }
+
+  /*!
+   \brief Share zones
+   \param zones : a store of zones
+   \pre no zone has been allocated by this allocator
+   \post zones are allocated and shared from zones, along with the other allocators that use it
+   \throw std::invalid_argument : if the dimension of zones in zones differs from the dimension of zones
+   allocated by this allocator
+   \throw std::runtime_error : if zones have already been allocated by this allocator, or if state components are
+   allocated in records (see allocate_records)
+   */
+  void share_zones(std::shared_ptr<tchecker::zg::zone_store_t> const & zones)
+  {
+    if (zones->zone_dimension() != _zone_dimension)
+      throw std::invalid_argument("Sharing zones of another dimension");
+    if (!_shared_zones && _zones->memsize() != 0)
+      throw std::runtime_error("Sharing zones after allocation");
+    if (_records != nullptr)
+      throw std::runtime_error("Sharing zones allocated in records");
+    _zones = zones;
+    _shared_zones = true;
+  }
+
+  /*!
+   \brief Allocate state components in records
+   \param record_alloc_nb : number of records allocated in one block
+   \pre no state has been allocated by this allocator, and zones are not shared with other allocators (see share_zones)
+   \post the tuple of locations, the valuation of bounded integer variables and the zone of each state constructed by
+   this allocator are allocated contiguously in one record
+   \throw std::runtime_error : if zones are shared with other allocators, or if states have already been allocated by
+   this allocator
+   \note records save the indirections from a state to its components when states do not share their components (see
+   tchecker::ts::NO_SHARING). Components can still be shared using share(), the records of the components that have been
+   replaced by shared ones are then kept until they are collected
+   */
+  void allocate_records(std::size_t record_alloc_nb)
+  {
+    if (_shared_zones)
+      throw std::runtime_error("Allocating records of shared zones");
+    if (memsize() != 0)
+      throw std::runtime_error("Allocating records after allocation");
+    _records = std::make_unique<record_pool_t>(
+        record_alloc_nb, tchecker::allocation_size_t<tchecker::shared_vloc_t>::alloc_size(vloc_capacity()),
+        tchecker::allocation_size_t<tchecker::shared_intval_t>::alloc_size(intval_capacity()),
+        tchecker::allocation_size_t<tchecker::zg::shared_zone_t>::alloc_size(_zone_dimension));
   }
 
   /*!
    \brief Accessor
    \return Memory used by this state allocator
    */
-  std::size_t memsize() const { return tchecker::ta::details::state_pool_allocator_t<STATE>::memsize() + _zone_pool.memsize(); }
+  std::size_t memsize() const
+  {
+    return tchecker::ta::details::state_pool_allocator_t<STATE>::memsize() + _zones->memsize() + record_memsize();
+  }
+
+  /*!
+   \brief Accessor
+   \return Memory used by the zones in this state allocator
+   */
+  std::size_t zone_memsize() const { return _zones->memsize(); }
+
+  /*!
+   \brief Accessor
+   \return Memory used by the records of state components in this state allocator (see allocate_records)
+   */
+  std::size_t record_memsize() const { return (_records == nullptr ? 0 : _records->memsize()); }
+
+  using tchecker::ta::details::state_pool_allocator_t<STATE>::intval_memsize;
+  using tchecker::ta::details::state_pool_allocator_t<STATE>::vloc_memsize;
 
 protected:
   /*!
@@ -206,13 +362,37 @@ protected:
    */
   template <class... ARGS> tchecker::intrusive_shared_ptr_t<STATE> construct_from_state(STATE const & s, ARGS &&... args)
   {
-    return tchecker::ta::details::state_pool_allocator_t<STATE>::construct_from_state(s, _zone_pool.construct(s.zone()),
+    if (_records != nullptr) {
+      auto && [vloc, intval, zone] = _records->construct(s.vloc(), s.intval(), s.zone());
+      return tchecker::ta::details::state_pool_allocator_t<STATE>::construct_from_state_and_components(s, vloc, intval, zone,
+                                                                                                       args...);
+    }
+    return tchecker::ta::details::state_pool_allocator_t<STATE>::construct_from_state(s, _zones->pool().construct(s.zone()),
                                                                                       args...);
   }
 
+  /*!
+   \brief Destruct a zone
+   \param zone : a zone allocated by this allocator
+   \post zone has been destructed if its reference counter is 1, from the records if state components are allocated
+   in records, or from the pool of zones otherwise
+   */
+  void destruct_zone(tchecker::zg::zone_sptr_t & zone)
+  {
+    if (_records != nullptr)
+      _records->destruct(zone);
+    else
+      _zones->pool().destruct(zone);
+  }
+
+  using tchecker::ta::details::state_pool_allocator_t<STATE>::intval_capacity;
+  using tchecker::ta::details::state_pool_allocator_t<STATE>::vloc_capacity;
+
   std::size_t _zone_dimension;                              /*!< Dimension of allocated zones */
-  tchecker::pool_t<tchecker::zg::shared_zone_t> _zone_pool; /*!< Pool of zones */
-  std::shared_ptr<zone_cache_t> _zone_cache;                /*!< Cache of zones */
+  std::shared_ptr<tchecker::zg::zone_store_t> _zones;       /*!< Pool and cache of zones */
+  bool _shared_zones;                                       /*!< Whether _zones is shared with other allocators */
+  tchecker::collection_trigger_t _collection_trigger;       /*!< Trigger of incremental collection */
+  std::unique_ptr<record_pool_t> _records;                  /*!< Records of state components, nullptr if not used */
 };
 
 /*!
@@ -250,6 +430,7 @@ public:
   using tchecker::ta::details::transition_pool_allocator_t<TRANSITION>::share;
   using tchecker::ta::details::transition_pool_allocator_t<TRANSITION>::destruct_all;
   using tchecker::ta::details::transition_pool_allocator_t<TRANSITION>::memsize;
+  using tchecker::ta::details::transition_pool_allocator_t<TRANSITION>::vedge_memsize;
 
 protected:
   using tchecker::ta::details::transition_pool_allocator_t<TRANSITION>::construct_from_transition;
@@ -6,12 +6,14 @@
 #define TCHECKER_ZG_ALLOCATORS_HA_HH
 
 #include <memory>
+#include <stdexcept>
 #include <type_traits>
 
 #include "tchecker/ta/allocators_ha.hh"
 #include "tchecker/utils/cache.hh"
 #include "tchecker/zg/state.hh"
 #include "tchecker/zg/transition_ha.hh"
+#include "tchecker/zg/zone_registry.hh"
 
 /*!
  \file allocators.hh
@@ -32,13 +34,6 @@ namespace details {
 template <class STATE> class state_pool_allocator_t : private tchecker::ta_ha::details::state_pool_allocator_t<STATE> {
   static_assert(std::is_base_of<tchecker::zg::state_t, STATE>::value, "");
 
-  /*!
-   \brief Type of cache of zones
-  */
-  using zone_cache_t =
-      tchecker::periodic_collectable_cache_t<tchecker::zg::zone_sptr_t, tchecker::intrusive_shared_ptr_delegate_hash_t,
-                                             tchecker::intrusive_shared_ptr_delegate_equal_to_t>;
-
 public:
   /*!
    \brief Type of allocated states
@@ -74,10 +69,8 @@ public:
       : tchecker::ta_ha::details::state_pool_allocator_t<STATE>(state_alloc_nb, vloc_alloc_nb, vloc_capacity, intval_alloc_nb,
                                                              intval_capacity, table_size),
         _zone_dimension(zone_dimension),
-        _zone_pool(zone_alloc_nb, tchecker::allocation_size_t<tchecker::zg::shared_zone_t>::alloc_size(_zone_dimension)),
-        _zone_cache(new zone_cache_t(table_size))
+        _zones(std::make_shared<tchecker::zg::zone_store_t>(zone_alloc_nb, zone_dimension, table_size)), _shared_zones(false)
   {
-    _zone_pool.enroll(_zone_cache);
   }
 
   /*!
@@ -111,19 +104,25 @@ public:
    \brief Construct state
    \param args : arguments to a constructor of STATE beyond the zone
    \return a new instance of STATE constructed from a newly allocated zone, and args
+   \note unused states and components are collected first if the collection trigger fires
    */
   template <class... ARGS> tchecker::intrusive_shared_ptr_t<STATE> construct(ARGS &&... args)
   {
-    return tchecker::ta_ha::details::state_pool_allocator_t<STATE>::construct(_zone_pool.construct(_zone_dimension), args...);
+    if (_collection_trigger.tick())
+      collect();
+    return tchecker::ta_ha::details::state_pool_allocator_t<STATE>::construct(_zones->pool().construct(_zone_dimension), args...);
   }
 
   /*!
    \brief Clone state
    \param s : a state
    \return a new instance of STATE that is a clone of s
+   \note unused states and components are collected first if the collection trigger fires
   */
   template <class... ARGS> tchecker::intrusive_shared_ptr_t<STATE> clone(STATE const & s)
   {
+    if (_collection_trigger.tick())
+      collect();
     return tchecker::zg_ha::details::state_pool_allocator_t<STATE>::construct_from_state(s);
   }
 
@@ -147,7 +146,7 @@ public:
     if (!tchecker::ta_ha::details::state_pool_allocator_t<STATE>::destruct(p))
       return false;
 
-    _zone_pool.destruct(zone_ptr);
+    _zones->pool().destruct(zone_ptr);
 
     return true;
   }
@@ -163,7 +162,12 @@ public:
   void share(tchecker::intrusive_shared_ptr_t<STATE> const & p)
   {
     tchecker::ta_ha::details::state_pool_allocator_t<STATE>::share(p);
-    p->zone_ptr() = _zone_cache->find_else_add(p->zone_ptr());
+    tchecker::zg::zone_sptr_t zone = p->zone_ptr();
+    p->zone_ptr() = _zones->cache().find_else_add(zone);
+    // a zone that has been replaced by a shared one is released at once, so that its chunk is reused by the next
+    // allocation instead of waiting for collection
+    if (p->zone_ptr() != zone)
+      _zones->pool().destruct(zone);
   }
 
   /*!
@@ -173,29 +177,59 @@ public:
   void collect()
   {
     tchecker::ta_ha::details::state_pool_allocator_t<STATE>::collect();
-    _zone_cache->collect();
-    _zone_pool.collect();
+    _zones->collect();
   }
 
+  /*!
+   \brief Set collection trigger
+   \param trigger : a collection trigger
+   \post collect() is called before constructing a state when trigger fires
+   \note the trigger should only be enabled when no state with a null reference counter is still in use
+   */
+  void collection_trigger(tchecker::collection_trigger_t const & trigger) { _collection_trigger = trigger; }
+
   /*!
    \brief Destruct all allocated states
    \post All allocated states, zones, tuples of locations and valuations of
    bounded integer variables have been destructed
    \note invalidates all pointers to states, zones, tuple of locations and
    valuations of bounded integer variables allocated by this allocator
+   \note if zones are shared with other allocators (see share_zones), only the zones that are not used
+   anymore are destructed
    */
   void destruct_all()
   {
     tchecker::ta_ha::details::state_pool_allocator_t<STATE>::destruct_all();
-    _zone_cache->clear();
-    _zone_pool.destruct_all();
+    if (_shared_zones)
+      _zones->collect();
+    else
+      _zones->destruct_all();
+  }
+
+  /*!
+   \brief Share zones
+   \param zones : a store of zones
+   \pre no zone has been allocated by this allocator
+   \post zones are allocated and shared from zones, along with the other allocators that use it
+   \throw std::invalid_argument : if the dimension of zones in zones differs from the dimension of zones
+   allocated by this allocator
+   \throw std::runtime_error : if zones have already been allocated by this allocator
+   */
+  void share_zones(std::shared_ptr<tchecker::zg::zone_store_t> const & zones)
+  {
+    if (zones->zone_dimension() != _zone_dimension)
+      throw std::invalid_argument("Sharing zones of another dimension");
+    if (!_shared_zones && _zones->memsize() != 0)
+      throw std::runtime_error("Sharing zones after allocation");
+    _zones = zones;
+    _shared_zones = true;
   }
 
   /*!
    \brief Accessor
    \return Memory used by this state allocator
    */
-  std::size_t memsize() const { return tchecker::ta_ha::details::state_pool_allocator_t<STATE>::memsize() + _zone_pool.memsize(); }
+  std::size_t memsize() const { return tchecker::ta_ha::details::state_pool_allocator_t<STATE>::memsize() + _zones->memsize(); }
 
 protected:
   /*!
@@ -206,13 +240,14 @@ protected:
    */
   template <class... ARGS> tchecker::intrusive_shared_ptr_t<STATE> construct_from_state(STATE const & s, ARGS &&... args)
   {
-    return tchecker::ta_ha::details::state_pool_allocator_t<STATE>::construct_from_state(s, _zone_pool.construct(s.zone()),
+    return tchecker::ta_ha::details::state_pool_allocator_t<STATE>::construct_from_state(s, _zones->pool().construct(s.zone()),
                                                                                       args...);
   }
 
   std::size_t _zone_dimension;                              /*!< Dimension of allocated zones */
-  tchecker::pool_t<tchecker::zg::shared_zone_t> _zone_pool; /*!< Pool of zones */
-  std::shared_ptr<zone_cache_t> _zone_cache;                /*!< Cache of zones */
+  std::shared_ptr<tchecker::zg::zone_store_t> _zones;       /*!< Pool and cache of zones */
+  bool _shared_zones;                                       /*!< Whether _zones is shared with other allocators */
+  tchecker::collection_trigger_t _collection_trigger;       /*!< Trigger of incremental collection */
 };
 
 /*!
@@ -0,0 +1,209 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ZG_COLD_STATE_HH
+#define TCHECKER_ZG_COLD_STATE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/ta/state.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/zg/state.hh"
+#include "tchecker/zg/zone.hh"
+
+/*!
+ \file cold_state.hh
+ \brief Compressed zones and integer valuations of explored states
+ */
+
+namespace tchecker {
+
+namespace zg {
+
+/*!
+ \class cold_state_t
+ \brief Storage format for the zone and the valuation of bounded integer variables of a state that is not used anymore
+ by the exploration (fully expanded, and not waiting)
+ \note the zone is stored as its minimal set of bounds (see tchecker::dbm::reduce), and the bounds and the values of
+ the integer variables are stored as variable-length integers in a single byte buffer. Indices of bounds are encoded
+ as i*dim+j, and bounds as 2*value+comparator (zig-zag encoded), so most bounds of a model with small constants take 2
+ or 3 bytes instead of a pair of clocks and a tchecker::dbm::db_t. The state is decompressed when it has to be used
+ (e.g. comparison with a new state, certificate output or counter-example extraction). Equality and hashing work on
+ the buffer since the encoding is canonical
+ */
+class cold_state_t {
+public:
+  /*!
+   \brief Constructor
+   \post this is the compressed form of an empty valuation and of a zone of dimension 0, which stands for a state
+   that has not been compressed yet
+   */
+  cold_state_t() : _dim(0), _intvars(0), _intval_offset(0) {}
+
+  /*!
+   \brief Constructor
+   \param zone : a zone
+   \param intval : a valuation of bounded integer variables
+   \post this is the compressed form of zone and intval
+   */
+  cold_state_t(tchecker::zg::zone_t const & zone, tchecker::intval_t const & intval);
+
+  /*!
+   \brief Copy constructor
+   */
+  cold_state_t(tchecker::zg::cold_state_t const &) = default;
+
+  /*!
+   \brief Move constructor
+   */
+  cold_state_t(tchecker::zg::cold_state_t &&) = default;
+
+  /*!
+   \brief Destructor
+   */
+  ~cold_state_t() = default;
+
+  /*!
+   \brief Assignment operator
+   */
+  tchecker::zg::cold_state_t & operator=(tchecker::zg::cold_state_t const &) = default;
+
+  /*!
+   \brief Move-assignment operator
+   */
+  tchecker::zg::cold_state_t & operator=(tchecker::zg::cold_state_t &&) = default;
+
+  /*!
+   \brief Decompression of the zone
+   \param zone : a zone
+   \pre zone has dimension dim()
+   \post zone is the zone represented by this
+   \throw std::invalid_argument : if zone does not have dimension dim()
+   */
+  void to_zone(tchecker::zg::zone_t & zone) const;
+
+  /*!
+   \brief Decompression of the valuation of bounded integer variables
+   \param intval : a valuation of bounded integer variables
+   \pre intval has size intvars()
+   \post intval is the valuation represented by this
+   \throw std::invalid_argument : if intval does not have size intvars()
+   */
+  void to_intval(tchecker::intval_t & intval) const;
+
+  /*!
+   \brief Accessor
+   \return dimension of the zone
+   */
+  inline std::size_t dim() const { return _dim; }
+
+  /*!
+   \brief Accessor
+   \return number of bounded integer variables
+   */
+  inline std::size_t intvars() const { return _intvars; }
+
+  /*!
+   \brief Accessor
+   \return number of bytes used by this cold state
+   */
+  std::size_t memory_footprint() const;
+
+  /*!
+   \brief Equality predicate
+   \param s : a cold state
+   \return true if this and s represent the same zone and the same valuation, false otherwise
+   */
+  bool operator==(tchecker::zg::cold_state_t const & s) const;
+
+  /*!
+   \brief Disequality predicate
+   \param s : a cold state
+   \return negation of operator==
+   */
+  bool operator!=(tchecker::zg::cold_state_t const & s) const;
+
+  /*!
+   \brief Accessor
+   \return hash code for this cold state
+   */
+  std::size_t hash() const;
+
+private:
+  tchecker::clock_id_t _dim;        /*!< Dimension of the zone */
+  unsigned short _intvars;          /*!< Number of bounded integer variables */
+  std::uint32_t _intval_offset;     /*!< Offset of the valuation in _bytes */
+  std::vector<std::uint8_t> _bytes; /*!< Encoded bounds of the zone, followed by the encoded valuation */
+};
+
+/*!
+ \brief Boost compatible hash function on cold states
+ \param s : a cold state
+ \return hash value for s
+ */
+inline std::size_t hash_value(tchecker::zg::cold_state_t const & s) { return s.hash(); }
+
+/*!
+ \class cold_state_storage_t
+ \brief Storage of the zones and the valuations of bounded integer variables of states as cold states (see
+ tchecker::algorithms::reach::stored_zones_algorithm_t)
+ \note only the nodes that have been expanded are cold: waiting nodes keep their full state (see
+ tchecker::algorithms::reach::stores_expanded_only_t)
+ */
+class cold_state_storage_t {
+public:
+  /*!
+   \brief Type of stored zones
+   */
+  using stored_zone_t = tchecker::zg::cold_state_t;
+
+  /*!
+   \brief Nodes are only stored once they have been expanded
+   */
+  static constexpr bool EXPANDED_ONLY = true;
+
+  /*!
+   \brief Compression
+   \param s : a state
+   \param zone : zone of s
+   \return the cold state of zone and the valuation of bounded integer variables of s
+   */
+  inline tchecker::zg::cold_state_t store(tchecker::ta::state_t const & s, tchecker::zg::zone_sptr_t const & zone) const
+  {
+    return tchecker::zg::cold_state_t{*zone, s.intval()};
+  }
+
+  /*!
+   \brief Decompression of the zone
+   \param stored : a cold state
+   \param zone : a zone
+   \post zone is the zone represented by stored
+   \throw std::invalid_argument : if zone does not have dimension stored.dim()
+   */
+  inline void restore(tchecker::zg::cold_state_t const & stored, tchecker::zg::zone_t & zone) const
+  {
+    stored.to_zone(zone);
+  }
+
+  /*!
+   \brief Decompression of the valuation of bounded integer variables
+   \param stored : a cold state
+   \param intval : a valuation of bounded integer variables
+   \post intval is the valuation represented by stored
+   \throw std::invalid_argument : if intval does not have size stored.intvars()
+   */
+  inline void restore_intval(tchecker::zg::cold_state_t const & stored, tchecker::intval_t & intval) const
+  {
+    stored.to_intval(intval);
+  }
+};
+
+} // end of namespace zg
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ZG_COLD_STATE_HH
@@ -0,0 +1,184 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ZG_COMPACT_ZONE_HH
+#define TCHECKER_ZG_COMPACT_ZONE_HH
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/clockbounds/active_clocks.hh"
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/ta/state.hh"
+#include "tchecker/zg/state.hh"
+#include "tchecker/zg/zone.hh"
+
+/*!
+ \file compact_zone.hh
+ \brief Zones stored as DBMs over their active clocks
+ */
+
+namespace tchecker {
+
+namespace zg {
+
+/*!
+ \class compact_zone_t
+ \brief Storage format for zones at rest where inactive clocks are free: the DBM is restricted to active clocks
+ \note a compact zone takes (k+1)*(k+1) bounds for k active clocks instead of dim*dim bounds. It is decompressed to
+ a tchecker::zg::zone_t when it has to be used, by freeing inactive clocks (see tchecker::dbm::uncompact). The active
+ clocks are usually obtained from tchecker::clockbounds::active_clocks_t for the tuple of locations of the zone, and
+ the zone is obtained by freeing its inactive clocks
+ */
+class compact_zone_t {
+public:
+  /*!
+   \brief Constructor
+   \param zone : a zone
+   \param clocks : active clocks (system clock identifiers)
+   \pre clocks is increasing, every clock x in clocks satisfies x+1 < zone.dim(), and all the clocks that are not in
+   clocks are free in zone (see tchecker::dbm::free_clock)
+   \post this is the compact form of zone
+   */
+  compact_zone_t(tchecker::zg::zone_t const & zone, std::vector<tchecker::clock_id_t> const & clocks);
+
+  /*!
+   \brief Copy constructor
+   */
+  compact_zone_t(tchecker::zg::compact_zone_t const &) = default;
+
+  /*!
+   \brief Move constructor
+   */
+  compact_zone_t(tchecker::zg::compact_zone_t &&) = default;
+
+  /*!
+   \brief Destructor
+   */
+  ~compact_zone_t() = default;
+
+  /*!
+   \brief Assignment operator
+   */
+  tchecker::zg::compact_zone_t & operator=(tchecker::zg::compact_zone_t const &) = default;
+
+  /*!
+   \brief Move-assignment operator
+   */
+  tchecker::zg::compact_zone_t & operator=(tchecker::zg::compact_zone_t &&) = default;
+
+  /*!
+   \brief Decompression
+   \param zone : a zone
+   \pre zone has dimension dim()
+   \post zone is the zone represented by this
+   \throw std::invalid_argument : if zone does not have dimension dim()
+   */
+  void to_zone(tchecker::zg::zone_t & zone) const;
+
+  /*!
+   \brief Accessor
+   \return dimension of the zone
+   */
+  inline std::size_t dim() const { return _dim; }
+
+  /*!
+   \brief Accessor
+   \return dimension of the stored DBM (number of active clocks plus 1)
+   */
+  inline std::size_t compact_dim() const { return _clocks.size(); }
+
+  /*!
+   \brief Accessor
+   \return number of bytes used by this compact zone
+   */
+  std::size_t memory_footprint() const;
+
+  /*!
+   \brief Equality predicate
+   \param zone : a compact zone
+   \return true if this and zone have the same active clocks and represent the same zone, false otherwise
+   */
+  bool operator==(tchecker::zg::compact_zone_t const & zone) const;
+
+  /*!
+   \brief Disequality predicate
+   \param zone : a compact zone
+   \return negation of operator==
+   */
+  bool operator!=(tchecker::zg::compact_zone_t const & zone) const;
+
+  /*!
+   \brief Accessor
+   \return hash code for this compact zone
+   */
+  std::size_t hash() const;
+
+private:
+  tchecker::clock_id_t _dim;                  /*!< Dimension of the zone */
+  std::vector<tchecker::clock_id_t> _clocks;  /*!< Active clocks in the zone (DBM indices, starting with 0) */
+  std::vector<tchecker::dbm::db_t> _dbm;      /*!< DBM restricted to active clocks */
+};
+
+/*!
+ \brief Boost compatible hash function on compact zones
+ \param zone : a compact zone
+ \return hash value for zone
+ */
+inline std::size_t hash_value(tchecker::zg::compact_zone_t const & zone) { return zone.hash(); }
+
+/*!
+ \class compact_zone_storage_t
+ \brief Storage of zones as compact zones over the active clocks of their tuple of locations (see
+ tchecker::algorithms::reach::stored_zones_algorithm_t)
+ \note the zones should be computed with the active-clock reduction w.r.t. the same active clocks (see
+ tchecker::zg::zg_t::active_clocks_reduction), so that their inactive clocks are free
+ */
+class compact_zone_storage_t {
+public:
+  /*!
+   \brief Type of stored zones
+   */
+  using stored_zone_t = tchecker::zg::compact_zone_t;
+
+  /*!
+   \brief Constructor
+   \param active : active clocks of the system
+   \throw std::invalid_argument : if active is nullptr
+   */
+  explicit compact_zone_storage_t(std::shared_ptr<tchecker::clockbounds::active_clocks_t const> const & active);
+
+  /*!
+   \brief Compression
+   \param s : a state
+   \param zone : zone of s
+   \pre the clocks that are not active in the tuple of locations of s are free in zone
+   \return the compact form of zone over the active clocks of the tuple of locations of s
+   */
+  tchecker::zg::compact_zone_t store(tchecker::ta::state_t const & s, tchecker::zg::zone_sptr_t const & zone);
+
+  /*!
+   \brief Decompression
+   \param stored : a compact zone
+   \param zone : a zone
+   \post zone is the zone represented by stored
+   \throw std::invalid_argument : if zone does not have dimension stored.dim()
+   */
+  inline void restore(tchecker::zg::compact_zone_t const & stored, tchecker::zg::zone_t & zone) const
+  {
+    stored.to_zone(zone);
+  }
+
+private:
+  std::shared_ptr<tchecker::clockbounds::active_clocks_t const> _active; /*!< Active clocks */
+  std::vector<tchecker::clock_id_t> _clocks;                             /*!< Active clocks of the stored zone */
+};
+
+} // end of namespace zg
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ZG_COMPACT_ZONE_HH
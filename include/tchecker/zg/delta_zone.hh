@@ -0,0 +1,218 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ZG_DELTA_ZONE_HH
+#define TCHECKER_ZG_DELTA_ZONE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/state.hh"
+#include "tchecker/utils/pool.hh"
+#include "tchecker/utils/shared_objects.hh"
+#include "tchecker/zg/state.hh"
+#include "tchecker/zg/zone.hh"
+
+/*!
+ \file delta_zone.hh
+ \brief Zones stored as differences with a reference zone
+ */
+
+namespace tchecker {
+
+namespace zg {
+
+/*!
+ \class delta_zone_t
+ \brief Storage format for zones at rest: the bounds of the DBM that differ from the DBM of a reference zone
+ \note successor zones usually only differ from their parent zone on the rows and columns of the reset clocks and of
+ the constrained clocks. A delta zone w.r.t. the zone of the parent node (or of a representative of a group of
+ zones) takes one index and one bound per differing bound instead of dim*dim bounds, and keeps the reference zone
+ alive. It is decoded to a tchecker::zg::zone_t when it has to be used: nodes that are waiting to be explored should
+ keep their decoded zone, and the zones of the explored nodes can be encoded, as they are only read by inclusion and
+ equality checks
+ */
+class delta_zone_t {
+public:
+  /*!
+   \brief Constructor
+   \param zone : a zone
+   \param reference : reference zone
+   \pre reference is not nullptr (checked by assertion)
+   \post this is the difference of zone with reference
+   \throw std::invalid_argument : if zone and reference have distinct dimensions
+   */
+  delta_zone_t(tchecker::zg::zone_t const & zone, tchecker::zg::zone_sptr_t const & reference);
+
+  /*!
+   \brief Copy constructor
+   */
+  delta_zone_t(tchecker::zg::delta_zone_t const &) = default;
+
+  /*!
+   \brief Move constructor
+   */
+  delta_zone_t(tchecker::zg::delta_zone_t &&) = default;
+
+  /*!
+   \brief Destructor
+   */
+  ~delta_zone_t() = default;
+
+  /*!
+   \brief Assignment operator
+   */
+  tchecker::zg::delta_zone_t & operator=(tchecker::zg::delta_zone_t const &) = default;
+
+  /*!
+   \brief Move-assignment operator
+   */
+  tchecker::zg::delta_zone_t & operator=(tchecker::zg::delta_zone_t &&) = default;
+
+  /*!
+   \brief Decoding
+   \param zone : a zone
+   \post zone is the zone stored in this
+   \throw std::invalid_argument : if zone does not have the dimension of this
+   */
+  void to_zone(tchecker::zg::zone_t & zone) const;
+
+  /*!
+   \brief Accessor
+   \return reference zone
+   */
+  inline tchecker::zg::zone_sptr_t const & reference() const { return _reference; }
+
+  /*!
+   \brief Accessor
+   \return number of bounds that differ from the reference zone
+   */
+  inline std::size_t delta_size() const { return _indices.size(); }
+
+  /*!
+   \brief Accessor
+   \return number of bytes used by this delta zone, not including the reference zone
+   */
+  std::size_t memory_footprint() const;
+
+  /*!
+   \brief Equality check
+   \param zone : a delta zone
+   \return true if this and zone have the same reference zone (same pointer) and the same differences, false otherwise
+   \note the stored zones are equal if this and zone are equal, but they may also be equal when this and zone are
+   distinct w.r.t. distinct reference zones
+   */
+  bool operator==(tchecker::zg::delta_zone_t const & zone) const;
+
+  /*!
+   \brief Disequality check
+   \param zone : a delta zone
+   \return false if this and zone are equal (see operator==), true otherwise
+   */
+  bool operator!=(tchecker::zg::delta_zone_t const & zone) const;
+
+  /*!
+   \brief Accessor
+   \return hash code for this delta zone, consistent with operator==
+   */
+  std::size_t hash() const;
+
+private:
+  tchecker::clock_id_t _dim;                /*!< Dimension of the zone */
+  tchecker::zg::zone_sptr_t _reference;     /*!< Reference zone */
+  std::vector<std::uint32_t> _indices;      /*!< Increasing indices (i*dim+j) of the bounds that differ */
+  std::vector<tchecker::dbm::db_t> _bounds; /*!< Bounds at the indices in _indices */
+};
+
+/*!
+ \brief Boost compatible hash function on delta zones
+ \param zone : a delta zone
+ \return hash value for zone
+ */
+inline std::size_t hash_value(tchecker::zg::delta_zone_t const & zone) { return zone.hash(); }
+
+/*!
+ \class delta_zone_storage_t
+ \brief Storage of zones as delta zones w.r.t. reference zones of their tuple of locations (see
+ tchecker::algorithms::reach::stored_zones_algorithm_t)
+ \note each tuple of locations has at most MAX_REFERENCES reference zones. A zone is stored as its difference with
+ the reference zone that has the least differing bounds. When this difference would take more memory than the DBM
+ of the zone, the zone is stored in full instead: it is its own reference, with no differing bound, and it becomes
+ a reference zone of its tuple of locations if there are less than MAX_REFERENCES of them. Reference zones are kept
+ alive by the delta zones and by this storage
+ \note reference zones and the tuples of locations of the groups of references are copied to pools of this storage,
+ hence they do not keep the states they come from alive. Copies of a storage share their pools
+ */
+class delta_zone_storage_t {
+public:
+  /*!
+   \brief Type of stored zones
+   */
+  using stored_zone_t = tchecker::zg::delta_zone_t;
+
+  static constexpr std::size_t const MAX_REFERENCES = 4; /*!< Maximal number of references of a tuple of locations */
+
+  /*!
+   \brief Encoding
+   \param s : a state
+   \param zone : zone of s
+   \return the difference of zone with the closest reference zone of the tuple of locations of s if it takes less
+   memory than the DBM of zone, and zone w.r.t. itself otherwise
+   \post zone has been added to the reference zones of the tuple of locations of s if it is stored w.r.t. itself and
+   there are less than MAX_REFERENCES of them
+   */
+  tchecker::zg::delta_zone_t store(tchecker::ta::state_t const & s, tchecker::zg::zone_sptr_t const & zone);
+
+  /*!
+   \brief Decoding
+   \param stored : a delta zone
+   \param zone : a zone
+   \post zone is the zone stored in stored
+   \throw std::invalid_argument : if zone does not have the dimension of stored
+   */
+  inline void restore(tchecker::zg::delta_zone_t const & stored, tchecker::zg::zone_t & zone) const
+  {
+    stored.to_zone(zone);
+  }
+
+  /*!
+   \brief Accessor
+   \return number of reference zones
+   */
+  std::size_t references() const;
+
+  /*!
+   \brief Accessor
+   \return memory used by this storage: reference zones (including the zones stored in full), and groups of references
+   */
+  std::size_t memsize() const;
+
+private:
+  static constexpr std::size_t const ALLOC_NB = 1024; /*!< Number of zones/tuples of locations allocated in one block */
+
+  /*!
+   \class group_t
+   \brief Reference zones of a tuple of locations
+   */
+  struct group_t {
+    tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t> vloc; /*!< Tuple of locations */
+    std::vector<tchecker::zg::zone_sptr_t> references;              /*!< Reference zones */
+  };
+
+  std::shared_ptr<tchecker::pool_t<tchecker::shared_vloc_t>> _vloc_pool;     /*!< Pool of tuples of locations */
+  std::shared_ptr<tchecker::pool_t<tchecker::zg::shared_zone_t>> _zone_pool; /*!< Pool of reference zones */
+  std::unordered_map<std::size_t, std::vector<group_t>> _groups;             /*!< Map : hash value -> groups of references */
+};
+
+} // end of namespace zg
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ZG_DELTA_ZONE_HH
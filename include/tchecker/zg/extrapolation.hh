@@ -176,32 +176,32 @@ public:
   /*!
   \brief Copy constructor
   */
-  local_lu_extrapolation_t(tchecker::zg::details::local_lu_extrapolation_t const & e);
+  local_lu_extrapolation_t(tchecker::zg::details::local_lu_extrapolation_t const & e) = default;
 
   /*!
   \brief Move constructor
   */
-  local_lu_extrapolation_t(tchecker::zg::details::local_lu_extrapolation_t && e);
+  local_lu_extrapolation_t(tchecker::zg::details::local_lu_extrapolation_t && e) = default;
 
   /*!
    \brief Destructor
   */
-  virtual ~local_lu_extrapolation_t();
+  virtual ~local_lu_extrapolation_t() = default;
 
   /*!
   \brief Assignment operator
   */
-  tchecker::zg::details::local_lu_extrapolation_t & operator=(tchecker::zg::details::local_lu_extrapolation_t const & e);
+  tchecker::zg::details::local_lu_extrapolation_t &
+  operator=(tchecker::zg::details::local_lu_extrapolation_t const & e) = default;
 
   /*!
   \brief Move-assignment operator
   */
-  tchecker::zg::details::local_lu_extrapolation_t & operator=(tchecker::zg::details::local_lu_extrapolation_t && e);
+  tchecker::zg::details::local_lu_extrapolation_t & operator=(tchecker::zg::details::local_lu_extrapolation_t && e) = default;
 
 protected:
-  tchecker::clockbounds::map_t * _l;                                          /*!< clock bounds L map */
-  tchecker::clockbounds::map_t * _u;                                          /*!< clock bounds U map */
   std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> _clock_bounds; /*!< local LU clock bounds map */
+  tchecker::clockbounds::local_lu_cache_t _cache;                             /*!< LU maps of tuples of locations */
 };
 
 } // end of namespace details
@@ -365,31 +365,32 @@ public:
   /*!
   \brief Copy constructor
   */
-  local_m_extrapolation_t(tchecker::zg::details::local_m_extrapolation_t const & e);
+  local_m_extrapolation_t(tchecker::zg::details::local_m_extrapolation_t const & e) = default;
 
   /*!
   \brief Move constructor
   */
-  local_m_extrapolation_t(tchecker::zg::details::local_m_extrapolation_t && e);
+  local_m_extrapolation_t(tchecker::zg::details::local_m_extrapolation_t && e) = default;
 
   /*!
    \brief Destructor
   */
-  virtual ~local_m_extrapolation_t();
+  virtual ~local_m_extrapolation_t() = default;
 
   /*!
   \brief Assignment operator
   */
-  tchecker::zg::details::local_m_extrapolation_t & operator=(tchecker::zg::details::local_m_extrapolation_t const & e);
+  tchecker::zg::details::local_m_extrapolation_t &
+  operator=(tchecker::zg::details::local_m_extrapolation_t const & e) = default;
 
   /*!
   \brief Move-assignment operator
   */
-  tchecker::zg::details::local_m_extrapolation_t & operator=(tchecker::zg::details::local_m_extrapolation_t && e);
+  tchecker::zg::details::local_m_extrapolation_t & operator=(tchecker::zg::details::local_m_extrapolation_t && e) = default;
 
 protected:
-  tchecker::clockbounds::map_t * _m;                                         /*!< clock bounds M map */
   std::shared_ptr<tchecker::clockbounds::local_m_map_t const> _clock_bounds; /*!< local M clock bounds map */
+  tchecker::clockbounds::local_m_cache_t _cache;                             /*!< M maps of tuples of locations */
 };
 
 } // end of namespace details
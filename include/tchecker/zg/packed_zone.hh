@@ -0,0 +1,217 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ZG_PACKED_ZONE_HH
+#define TCHECKER_ZG_PACKED_ZONE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/clockbounds/clockbounds.hh"
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/ta/state.hh"
+#include "tchecker/zg/state.hh"
+#include "tchecker/zg/zone.hh"
+
+/*!
+ \file packed_zone.hh
+ \brief Zones stored with narrow bounds
+ */
+
+namespace tchecker {
+
+namespace zg {
+
+/*!
+ \brief Width of the stored bounds of packed zones
+ */
+enum bound_width_t {
+  BOUND_WIDTH_16 = 16, /*!< 16-bit bounds */
+  BOUND_WIDTH_32 = 32, /*!< 32-bit bounds */
+  BOUND_WIDTH_64 = 64, /*!< Bounds of type tchecker::dbm::db_t */
+};
+
+/*!
+ \brief Width of the bounds of a model
+ \param max_bound : largest clock bound of the model (see tchecker::clockbounds), or a negative value if the model
+ has no clock bound
+ \param dim : dimension of the zones of the model
+ \return the narrowest width that stores every finite bound of the zones of dim clocks (extrapolated w.r.t.
+ max_bound), which is the width of the values in [-dim*(max_bound+1), dim*(max_bound+1)] encoded with their
+ strictness
+ \note the finite bounds of a closed DBM are sums of at most dim constraints, each bounded by max_bound+1 in
+ absolute value after extrapolation
+ */
+enum tchecker::zg::bound_width_t bound_width(tchecker::integer_t max_bound, std::size_t dim);
+
+/*!
+ \brief Width of the bounds of a model
+ \param m : global M map of the model
+ \return the width of the bounds of zones over the clocks of m, extrapolated w.r.t. the largest bound in m (see
+ tchecker::zg::bound_width(tchecker::integer_t, std::size_t))
+ */
+enum tchecker::zg::bound_width_t bound_width(tchecker::clockbounds::global_m_map_t const & m);
+
+/*!
+ \class packed_zone_t
+ \brief Storage format for zones at rest: the DBM with bounds of a narrow type
+ \note a packed zone takes dim*dim bounds of 2 or 4 bytes instead of sizeof(tchecker::dbm::db_t) bytes when the
+ bounds fit. It is decompressed to a tchecker::zg::zone_t, where bounds are widened, when it has to be used. The
+ width is usually chosen once for a model by tchecker::zg::bound_width
+ */
+class packed_zone_t {
+public:
+  /*!
+   \brief Constructor
+   \param zone : a zone
+   \param width : width of the stored bounds
+   \post this is the packed form of zone
+   \throw std::invalid_argument : if a finite bound of zone does not fit in width bits
+   */
+  packed_zone_t(tchecker::zg::zone_t const & zone, enum tchecker::zg::bound_width_t width);
+
+  /*!
+   \brief Copy constructor
+   */
+  packed_zone_t(tchecker::zg::packed_zone_t const &) = default;
+
+  /*!
+   \brief Move constructor
+   */
+  packed_zone_t(tchecker::zg::packed_zone_t &&) = default;
+
+  /*!
+   \brief Destructor
+   */
+  ~packed_zone_t() = default;
+
+  /*!
+   \brief Assignment operator
+   */
+  tchecker::zg::packed_zone_t & operator=(tchecker::zg::packed_zone_t const &) = default;
+
+  /*!
+   \brief Move-assignment operator
+   */
+  tchecker::zg::packed_zone_t & operator=(tchecker::zg::packed_zone_t &&) = default;
+
+  /*!
+   \brief Decompression
+   \param zone : a zone
+   \pre zone has dimension dim()
+   \post zone is the zone represented by this
+   \throw std::invalid_argument : if zone does not have dimension dim()
+   */
+  void to_zone(tchecker::zg::zone_t & zone) const;
+
+  /*!
+   \brief Accessor
+   \return dimension of the zone
+   */
+  inline std::size_t dim() const { return _dim; }
+
+  /*!
+   \brief Accessor
+   \return width of the stored bounds
+   */
+  inline enum tchecker::zg::bound_width_t width() const { return _width; }
+
+  /*!
+   \brief Accessor
+   \return number of bytes used by this packed zone
+   */
+  std::size_t memory_footprint() const;
+
+  /*!
+   \brief Equality predicate
+   \param zone : a packed zone
+   \return true if this and zone have the same width and represent the same zone, false otherwise
+   */
+  bool operator==(tchecker::zg::packed_zone_t const & zone) const;
+
+  /*!
+   \brief Disequality predicate
+   \param zone : a packed zone
+   \return negation of operator==
+   */
+  bool operator!=(tchecker::zg::packed_zone_t const & zone) const;
+
+  /*!
+   \brief Accessor
+   \return hash code for this packed zone
+   */
+  std::size_t hash() const;
+
+private:
+  tchecker::clock_id_t _dim;                 /*!< Dimension of the zone */
+  enum tchecker::zg::bound_width_t _width;   /*!< Width of the stored bounds */
+  std::vector<std::int16_t> _dbm16;          /*!< DBM with 16-bit bounds (width 16) */
+  std::vector<std::int32_t> _dbm32;          /*!< DBM with 32-bit bounds (width 32) */
+  std::vector<tchecker::dbm::db_t> _dbm64;   /*!< DBM (width 64) */
+};
+
+/*!
+ \brief Boost compatible hash function on packed zones
+ \param zone : a packed zone
+ \return hash value for zone
+ */
+inline std::size_t hash_value(tchecker::zg::packed_zone_t const & zone) { return zone.hash(); }
+
+/*!
+ \class packed_zone_storage_t
+ \brief Storage of zones as packed zones of a fixed width (see tchecker::algorithms::reach::stored_zones_algorithm_t)
+ \note the width is chosen once, usually from the clock bounds of the model (see tchecker::zg::bound_width). Zones
+ with a finite bound that does not fit in the width are stored with bounds of type tchecker::dbm::db_t
+ */
+class packed_zone_storage_t {
+public:
+  /*!
+   \brief Type of stored zones
+   */
+  using stored_zone_t = tchecker::zg::packed_zone_t;
+
+  /*!
+   \brief Constructor
+   \param width : width of the stored bounds
+   */
+  explicit packed_zone_storage_t(enum tchecker::zg::bound_width_t width) : _width(width) {}
+
+  /*!
+   \brief Compression
+   \param s : a state
+   \param zone : zone of s
+   \return the packed form of zone with bounds of width(), or with bounds of type tchecker::dbm::db_t if a finite
+   bound of zone does not fit in width() bits
+   */
+  tchecker::zg::packed_zone_t store(tchecker::ta::state_t const & s, tchecker::zg::zone_sptr_t const & zone) const;
+
+  /*!
+   \brief Decompression
+   \param stored : a packed zone
+   \param zone : a zone
+   \post zone is the zone represented by stored
+   \throw std::invalid_argument : if zone does not have dimension stored.dim()
+   */
+  inline void restore(tchecker::zg::packed_zone_t const & stored, tchecker::zg::zone_t & zone) const
+  {
+    stored.to_zone(zone);
+  }
+
+  /*!
+   \brief Accessor
+   \return width of the stored bounds
+   */
+  inline enum tchecker::zg::bound_width_t width() const { return _width; }
+
+private:
+  enum tchecker::zg::bound_width_t _width; /*!< Width of the stored bounds */
+};
+
+} // end of namespace zg
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ZG_PACKED_ZONE_HH
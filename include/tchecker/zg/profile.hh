@@ -0,0 +1,142 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ZG_PROFILE_HH
+#define TCHECKER_ZG_PROFILE_HH
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/syncprod/syncprod.hh"
+#include "tchecker/syncprod/vedge.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/system.hh"
+
+/*!
+ \file profile.hh
+ \brief Profile of the edges and locations of a model during an exploration of its zone graph
+ */
+
+namespace tchecker {
+
+namespace zg {
+
+/*!
+ \class profile_t
+ \brief Counters of the successors computed along each edge and from each location of a system
+ \note counters are updated with relaxed atomic operations, hence a profile can be shared by the zone graphs of
+ several exploration threads. Each process edge of a tuple of edges is counted, as well as each location of a tuple
+ of locations
+ */
+class profile_t {
+public:
+  /*!
+   \class edge_counters_t
+   \brief Counters of an edge
+   */
+  struct edge_counters_t {
+    std::atomic<std::uint64_t> computed{0};      /*!< Successors computed along the edge */
+    std::atomic<std::uint64_t> successors{0};    /*!< Successors with status tchecker::STATE_OK */
+    std::atomic<std::uint64_t> intvars{0};       /*!< Successors rejected by bounded integer variables */
+    std::atomic<std::uint64_t> clocks_guard{0};  /*!< Successors with status tchecker::STATE_CLOCKS_GUARD_VIOLATED */
+    std::atomic<std::uint64_t> empty_zone{0};    /*!< Successors rejected by clocks for another reason */
+    std::atomic<std::uint64_t> duplicates{0};    /*!< Successors that were already visited */
+  };
+
+  /*!
+   \class location_counters_t
+   \brief Counters of a location
+   */
+  struct location_counters_t {
+    std::atomic<std::uint64_t> expanded{0};      /*!< States expanded in the location */
+    std::atomic<std::uint64_t> successors{0};    /*!< Successors with status tchecker::STATE_OK from the location */
+    std::atomic<std::uint64_t> empty_zone{0};    /*!< Successors from the location rejected by clocks */
+    std::atomic<std::uint64_t> duplicates{0};    /*!< Already visited successors in the location */
+  };
+
+  /*!
+   \brief Constructor
+   \param system : a system of timed processes
+   \post all counters of the edges and locations of system are 0
+   \note this keeps a pointer on system
+   */
+  explicit profile_t(std::shared_ptr<tchecker::ta::system_t const> const & system);
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  profile_t(tchecker::zg::profile_t const &) = delete;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::zg::profile_t & operator=(tchecker::zg::profile_t const &) = delete;
+
+  /*!
+   \brief Record the expansion of a state
+   \param vloc : tuple of locations of the state
+   \post the expansions of the locations in vloc have been incremented
+   */
+  void expanded(tchecker::vloc_t const & vloc);
+
+  /*!
+   \brief Record a successor
+   \param vloc : tuple of locations of the source state
+   \param edges : tuple of edges
+   \param status : status of the successor along edges
+   \post the counters of the edges in edges and of the locations in vloc have been updated w.r.t. status
+   */
+  void next(tchecker::vloc_t const & vloc, tchecker::syncprod::outgoing_edges_value_t const & edges,
+            tchecker::state_status_t status);
+
+  /*!
+   \brief Record a successor that was already visited
+   \param vloc : tuple of locations of the successor
+   \param vedge : tuple of edges of the transition
+   \post the duplicates of the locations in vloc and of the edges in vedge have been incremented
+   */
+  void duplicate(tchecker::vloc_t const & vloc, tchecker::vedge_t const & vedge);
+
+  /*!
+   \brief Accessor
+   \param id : identifier of an edge
+   \pre id is an edge identifier of the system (checked by assertion)
+   \return counters of edge id
+   */
+  tchecker::zg::profile_t::edge_counters_t const & edge(tchecker::edge_id_t id) const;
+
+  /*!
+   \brief Accessor
+   \param id : identifier of a location
+   \pre id is a location identifier of the system (checked by assertion)
+   \return counters of location id
+   */
+  tchecker::zg::profile_t::location_counters_t const & location(tchecker::loc_id_t id) const;
+
+  /*!
+   \brief Output a ranked report
+   \param os : output stream
+   \param top : maximal number of edges and of locations in the report (0: no limit)
+   \post the edges with at least one computed successor have been output to os, by decreasing number of computed
+   successors, followed by the locations with at least one expanded state, by decreasing number of expansions. Ties are
+   broken by identifier
+   \return os after output
+   */
+  std::ostream & report(std::ostream & os, std::size_t top = 0) const;
+
+private:
+  std::shared_ptr<tchecker::ta::system_t const> _system;   /*!< System of timed processes */
+  std::vector<edge_counters_t> _edges;                     /*!< Map : edge identifier -> counters */
+  std::vector<location_counters_t> _locations;             /*!< Map : location identifier -> counters */
+};
+
+} // end of namespace zg
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ZG_PROFILE_HH
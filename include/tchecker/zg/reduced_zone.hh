@@ -0,0 +1,170 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ZG_REDUCED_ZONE_HH
+#define TCHECKER_ZG_REDUCED_ZONE_HH
+
+#include <cstddef>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/ta/state.hh"
+#include "tchecker/zg/state.hh"
+#include "tchecker/zg/zone.hh"
+
+/*!
+ \file reduced_zone.hh
+ \brief Zones stored as minimal constraint sets
+ */
+
+namespace tchecker {
+
+namespace zg {
+
+/*!
+ \class reduced_zone_t
+ \brief Storage format for zones at rest: the minimal set of bounds with the same closure as the zone
+ \note a reduced zone takes a few bounds per clock instead of dim*dim bounds. It is decompressed to a
+ tchecker::zg::zone_t when it has to be used. Equality and hashing work on the reduced form since it is canonical
+ */
+class reduced_zone_t {
+public:
+  /*!
+   \brief Constructor
+   \param zone : a zone
+   \post this is the reduced form of zone
+   */
+  explicit reduced_zone_t(tchecker::zg::zone_t const & zone);
+
+  /*!
+   \brief Copy constructor
+   */
+  reduced_zone_t(tchecker::zg::reduced_zone_t const &) = default;
+
+  /*!
+   \brief Move constructor
+   */
+  reduced_zone_t(tchecker::zg::reduced_zone_t &&) = default;
+
+  /*!
+   \brief Destructor
+   */
+  ~reduced_zone_t() = default;
+
+  /*!
+   \brief Assignment operator
+   */
+  tchecker::zg::reduced_zone_t & operator=(tchecker::zg::reduced_zone_t const &) = default;
+
+  /*!
+   \brief Move-assignment operator
+   */
+  tchecker::zg::reduced_zone_t & operator=(tchecker::zg::reduced_zone_t &&) = default;
+
+  /*!
+   \brief Decompression
+   \param zone : a zone
+   \pre zone has dimension dim()
+   \post zone is the zone represented by this
+   \throw std::invalid_argument : if zone does not have dimension dim()
+   */
+  void to_zone(tchecker::zg::zone_t & zone) const;
+
+  /*!
+   \brief Accessor
+   \return dimension of the zone
+   */
+  inline std::size_t dim() const { return _dim; }
+
+  /*!
+   \brief Accessor
+   \return number of stored bounds
+   */
+  inline std::size_t size() const { return _bounds.size(); }
+
+  /*!
+   \brief Accessor
+   \return number of bytes used by this reduced zone
+   */
+  std::size_t memory_footprint() const;
+
+  /*!
+   \brief Emptiness check
+   \return true if this zone is empty, false otherwise
+   */
+  bool is_empty() const;
+
+  /*!
+   \brief Equality predicate
+   \param zone : a reduced zone
+   \return true if this and zone represent the same zone, false otherwise
+   */
+  bool operator==(tchecker::zg::reduced_zone_t const & zone) const;
+
+  /*!
+   \brief Disequality predicate
+   \param zone : a reduced zone
+   \return true if this and zone represent distinct zones, false otherwise
+   */
+  bool operator!=(tchecker::zg::reduced_zone_t const & zone) const;
+
+  /*!
+   \brief Accessor
+   \return hash code for this reduced zone
+   */
+  std::size_t hash() const;
+
+private:
+  tchecker::clock_id_t _dim;                           /*!< Dimension of the zone */
+  std::vector<tchecker::dbm::reduced_bound_t> _bounds; /*!< Minimal set of bounds */
+};
+
+/*!
+ \brief Boost compatible hash function on reduced zones
+ \param zone : a reduced zone
+ \return hash value for zone
+ */
+inline std::size_t hash_value(tchecker::zg::reduced_zone_t const & zone) { return zone.hash(); }
+
+/*!
+ \class reduced_zone_storage_t
+ \brief Storage of zones as reduced zones (see tchecker::algorithms::reach::stored_zones_algorithm_t)
+ */
+class reduced_zone_storage_t {
+public:
+  /*!
+   \brief Type of stored zones
+   */
+  using stored_zone_t = tchecker::zg::reduced_zone_t;
+
+  /*!
+   \brief Compression
+   \param s : a state
+   \param zone : zone of s
+   \return the reduced form of zone
+   */
+  inline tchecker::zg::reduced_zone_t store(tchecker::ta::state_t const & s, tchecker::zg::zone_sptr_t const & zone) const
+  {
+    return tchecker::zg::reduced_zone_t{*zone};
+  }
+
+  /*!
+   \brief Decompression
+   \param stored : a reduced zone
+   \param zone : a zone
+   \post zone is the zone represented by stored
+   \throw std::invalid_argument : if zone does not have dimension stored.dim()
+   */
+  inline void restore(tchecker::zg::reduced_zone_t const & stored, tchecker::zg::zone_t & zone) const
+  {
+    stored.to_zone(zone);
+  }
+};
+
+} // end of namespace zg
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ZG_REDUCED_ZONE_HH
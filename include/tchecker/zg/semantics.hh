@@ -76,6 +76,41 @@ public:
                                         tchecker::clock_reset_container_t const & clkreset, bool tgt_delay_allowed,
                                         tchecker::clock_constraint_container_t const & tgt_invariant) = 0;
 
+  /*!
+  \brief Compute the source part of next zone
+  \param dbm : a DBM
+  \param dim : dimension of dbm
+  \param src_delay_allowed : true if delay allowed in source state
+  \param src_invariant : invariant in source state
+  \post dbm has been updated w.r.t. src_delay_allowed and src_invariant, as in next
+  \return STATE_OK if the resulting dbm is not empty, other values if the resulting
+  dbm is empty (see details in implementations)
+  \note next(dbm, ...) is equivalent to prepare_next(dbm, ...) followed by next_prepared(dbm, ...).
+  The source part only depends on the source state, hence it can be computed once for all
+  outgoing edges
+   */
+  virtual tchecker::state_status_t prepare_next(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, bool src_delay_allowed,
+                                                tchecker::clock_constraint_container_t const & src_invariant) = 0;
+
+  /*!
+  \brief Compute the edge part of next zone
+  \param dbm : a DBM
+  \param dim : dimension of dbm
+  \param guard : transition guard
+  \param clkreset : transition reset
+  \param tgt_delay_allowed : true if delay allowed in target state
+  \param tgt_invariant : invariant in target state
+  \pre dbm has been computed by prepare_next
+  \post dbm has been updated w.r.t. guard, clkreset, tgt_delay_allowed and tgt_invariant,
+  as in next
+  \return STATE_OK if the resulting dbm is not empty, other values if the resulting
+  dbm is empty (see details in implementations)
+   */
+  virtual tchecker::state_status_t next_prepared(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                                 tchecker::clock_constraint_container_t const & guard,
+                                                 tchecker::clock_reset_container_t const & clkreset, bool tgt_delay_allowed,
+                                                 tchecker::clock_constraint_container_t const & tgt_invariant) = 0;
+
   /*!
   \brief Compute previous zone
   \param dbm : a DBM
@@ -164,6 +199,41 @@ public:
                                         tchecker::clock_reset_container_t const & clkreset, bool tgt_delay_allowed,
                                         tchecker::clock_constraint_container_t const & tgt_invariant);
 
+  /*!
+  \brief Compute the source part of next zone
+  \param dbm : a DBM
+  \param dim : dimension of dbm
+  \param src_delay_allowed : true if delay allowed in source state
+  \param src_invariant : invariant in source state
+  \post dbm has been intersected with src_invariant, then delayed (if allowed) and
+  intersected with src_invariant again (if delayed)
+  \return tchecker::STATE_OK if the resulting DBM is not empty,
+  tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED otherwise
+  */
+  virtual tchecker::state_status_t prepare_next(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, bool src_delay_allowed,
+                                                tchecker::clock_constraint_container_t const & src_invariant);
+
+  /*!
+  \brief Compute the edge part of next zone
+  \param dbm : a DBM
+  \param dim : dimension of dbm
+  \param guard : transition guard
+  \param clkreset : transition reset
+  \param tgt_delay_allowed : true if delay allowed in target state
+  \param tgt_invariant : invariant in target state
+  \pre dbm has been computed by prepare_next
+  \post dbm has been intersected with guard, then reset w.r.t clkreset, then
+  intersected with tgt_invariant
+  \return tchecker::STATE_OK if the resulting DBM is not empty. Otherwise,
+  tchecker::STATE_CLOCKS_GUARD_VIOLATED if intersection with guard result in an empty
+  zone, tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED if intersection with
+  tgt_invariant result in an empty zone
+  */
+  virtual tchecker::state_status_t next_prepared(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                                 tchecker::clock_constraint_container_t const & guard,
+                                                 tchecker::clock_reset_container_t const & clkreset, bool tgt_delay_allowed,
+                                                 tchecker::clock_constraint_container_t const & tgt_invariant);
+
   /*!
   \brief Compute previous zone
   \param dbm : a DBM
@@ -263,6 +333,41 @@ public:
                                         tchecker::clock_reset_container_t const & clkreset, bool tgt_delay_allowed,
                                         tchecker::clock_constraint_container_t const & tgt_invariant);
 
+  /*!
+  \brief Compute the source part of next zone
+  \param dbm : a DBM
+  \param dim : dimension of dbm
+  \param src_delay_allowed : true if delay allowed in source state
+  \param src_invariant : invariant in source state
+  \post dbm has been intersected with src_invariant
+  \return tchecker::STATE_OK if the resulting DBM is not empty,
+  tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED otherwise
+  */
+  virtual tchecker::state_status_t prepare_next(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, bool src_delay_allowed,
+                                                tchecker::clock_constraint_container_t const & src_invariant);
+
+  /*!
+  \brief Compute the edge part of next zone
+  \param dbm : a DBM
+  \param dim : dimension of dbm
+  \param guard : transition guard
+  \param clkreset : transition reset
+  \param tgt_delay_allowed : true if delay allowed in target state
+  \param tgt_invariant : invariant in target state
+  \pre dbm has been computed by prepare_next
+  \post dbm has been intersected with guard, then reset w.r.t clkreset, then
+  intersected with tgt_invariant, then delayed (if allowed) and intersected with
+  tgt_invariant again (if delayed)
+  \return tchecker::STATE_OK if the resulting DBM is not empty. Otherwise,
+  tchecker::STATE_CLOCKS_GUARD_VIOLATED if intersection with guard result in an empty
+  zone, tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED if intersection with
+  tgt_invariant result in an empty zone
+  */
+  virtual tchecker::state_status_t next_prepared(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                                 tchecker::clock_constraint_container_t const & guard,
+                                                 tchecker::clock_reset_container_t const & clkreset, bool tgt_delay_allowed,
+                                                 tchecker::clock_constraint_container_t const & tgt_invariant);
+
   /*!
   \brief Compute previous zone
   \param dbm : a DBM
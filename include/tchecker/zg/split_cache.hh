@@ -0,0 +1,136 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ZG_SPLIT_CACHE_HH
+#define TCHECKER_ZG_SPLIT_CACHE_HH
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "tchecker/utils/shared_objects.hh"
+#include "tchecker/variables/clocks.hh"
+#include "tchecker/zg/state.hh"
+
+/*!
+ \file split_cache.hh
+ \brief Cache of the splits of zones w.r.t. clock constraints
+ */
+
+namespace tchecker {
+
+namespace zg {
+
+/*!
+ \class split_cache_t
+ \brief Bounded cache of the pieces of zones split w.r.t. lists of clock constraints, with least-recently-used
+ eviction
+ \note Entries are keyed by the pointer to a shared zone and the list of clock constraints. Since shared zones are
+ never modified, the pointer identifies the zone. Entries keep a reference on their zone and on the pieces of the
+ split, which are shared zones too, hence these zones are not collected while they are in the cache. A cache of
+ capacity 0 does not store anything
+ */
+class split_cache_t {
+public:
+  /*!
+   \brief Type of pointers to shared zones
+   */
+  using zone_sptr_t = tchecker::intrusive_shared_ptr_t<tchecker::zg::shared_zone_t>;
+
+  /*!
+   \brief Type of pointers to const shared zones
+   */
+  using const_zone_sptr_t = tchecker::intrusive_shared_ptr_t<tchecker::zg::shared_zone_t const>;
+
+  /*!
+   \brief Constructor
+   \param capacity : maximal number of entries
+   */
+  split_cache_t(std::size_t capacity = 4096);
+
+  /*!
+   \brief Lookup
+   \param zone : a shared zone
+   \param constraints : clock constraints
+   \return pointer to the pieces of the split of zone w.r.t. constraints if they are in the cache, nullptr otherwise
+   \post the entry of zone and constraints (if any) is the most recently used one
+   \note the returned pointer is invalidated by the next call to insert() or clear()
+   */
+  std::vector<zone_sptr_t> const * find(const_zone_sptr_t const & zone,
+                                        tchecker::clock_constraint_container_t const & constraints);
+
+  /*!
+   \brief Insertion
+   \param zone : a shared zone
+   \param constraints : clock constraints
+   \param pieces : shared zones, pieces of the split of zone w.r.t. constraints
+   \pre zone and constraints are not in the cache
+   \post pieces have been cached as the most recently used entry of zone and constraints. The least recently used
+   entry has been evicted if the cache was full
+   */
+  void insert(const_zone_sptr_t const & zone, tchecker::clock_constraint_container_t const & constraints,
+              std::vector<zone_sptr_t> && pieces);
+
+  /*!
+   \brief Clear
+   \post this cache is empty, and its zones are not referenced anymore
+   */
+  void clear();
+
+  /*!
+   \brief Accessor
+   \return maximal number of entries
+   */
+  inline std::size_t capacity() const { return _capacity; }
+
+  /*!
+   \brief Accessor
+   \return number of entries
+   */
+  inline std::size_t size() const { return _entries.size(); }
+
+  /*!
+   \brief Accessor
+   \return number of lookups that found their entry
+   */
+  inline std::size_t hits() const { return _hits; }
+
+  /*!
+   \brief Accessor
+   \return number of lookups that did not find their entry
+   */
+  inline std::size_t misses() const { return _misses; }
+
+private:
+  /*!
+   \brief Cache entry
+   */
+  struct entry_t {
+    std::size_t _hash;                                    /*!< Hash value of zone pointer and constraints */
+    const_zone_sptr_t _zone;                              /*!< Split zone */
+    tchecker::clock_constraint_container_t _constraints; /*!< Clock constraints */
+    std::vector<zone_sptr_t> _pieces;                     /*!< Pieces of the split */
+  };
+
+  /*!
+   \brief Hash function
+   \param zone : a shared zone
+   \param constraints : clock constraints
+   \return hash value of the pointer zone and constraints
+   */
+  static std::size_t hash(const_zone_sptr_t const & zone, tchecker::clock_constraint_container_t const & constraints);
+
+  std::size_t _capacity;                                                   /*!< Maximal number of entries */
+  std::list<entry_t> _entries;                                             /*!< Entries, most recently used first */
+  std::unordered_multimap<std::size_t, std::list<entry_t>::iterator> _index; /*!< Map : hash value -> entries */
+  std::size_t _hits;                                                       /*!< Number of successful lookups */
+  std::size_t _misses;                                                     /*!< Number of failed lookups */
+};
+
+} // end of namespace zg
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ZG_SPLIT_CACHE_HH
@@ -11,6 +11,9 @@
 #include <boost/container_hash/hash.hpp>
 #endif
 
+#include <atomic>
+
+#include "tchecker/config.hh"
 #include "tchecker/ta/state.hh"
 #include "tchecker/utils/allocation_size.hh"
 #include "tchecker/utils/shared_objects.hh"
@@ -27,8 +30,14 @@ namespace zg {
 
 /*!
 \brief Type of shared zone, DBM implementation
+\note zones have an atomic reference counter when TCHECKER_THREAD_SAFE_ZONES is defined, so that zone graphs of
+concurrent threads can share them (see tchecker::zg::zone_store_t)
 */
+#if defined(TCHECKER_THREAD_SAFE_ZONES)
+using shared_zone_t = tchecker::make_shared_t<tchecker::zg::zone_t, std::atomic<std::size_t>>;
+#else
 using shared_zone_t = tchecker::make_shared_t<tchecker::zg::zone_t>;
+#endif
 
 /*!
 \brief Type of shared pointer to zone, DBM implementation
@@ -146,7 +155,17 @@ bool operator!=(tchecker::zg::state_t const & s1, tchecker::zg::state_t const &
  */
 bool shared_equal_to(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2);
 
-bool shared_equal_to_incl_vector(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2, const boost::dynamic_bitset<>& v1, const boost::dynamic_bitset<>& v2);
+/*!
+ \brief Equality check for shared states with a vector of flags
+ \param s1 : state
+ \param s2 : state
+ \param v1 : vector of flags attached to s1
+ \param v2 : vector of flags attached to s2
+ \return true if s1 and s2 are equal w.r.t. shared_equal_to, and v1 and v2 are equal, false otherwise
+ \note vectors are compared block by block
+ */
+bool shared_equal_to_incl_vector(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2,
+                                 boost::dynamic_bitset<> const & v1, boost::dynamic_bitset<> const & v2);
 
 /*!
  \brief Covering check
@@ -200,6 +219,31 @@ bool is_alu_le(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s
 bool shared_is_alu_le(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2,
                       tchecker::clockbounds::map_t const & l, tchecker::clockbounds::map_t const & u);
 
+/*!
+ \brief aM subsumption check
+ \param s1 : state
+ \param s2 : state
+ \param m : clock bounds
+ \return true if s1 and s2 have the same tuple of locations and integer
+ variables valuation, and the zone in s1 is included in aM-abstraction of the
+ zone in s2, false otherwise
+*/
+bool is_am_le(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2, tchecker::clockbounds::map_t const & m);
+
+/*!
+ \brief aM subsumption check for shared states
+ \param s1 : state
+ \param s2 : state
+ \param m : clock bounds
+ \return true if s1 and s2 have the same tuple of locations and integer
+ variables valuation, and the zone in s1 is included in aM-abstraction of the
+ zone in s2, false otherwise
+ \note this should only be used on states that have shared internal components: this
+ function checks pointers instead of values when relevant
+*/
+bool shared_is_am_le(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2,
+                     tchecker::clockbounds::map_t const & m);
+
 /*!
  \brief Hash
  \param s : state
@@ -216,7 +260,15 @@ std::size_t hash_value(tchecker::zg::state_t const & s);
  */
 std::size_t shared_hash_value(tchecker::zg::state_t const & s);
 
-std::size_t shared_hash_value_incl_vector(tchecker::zg::state_t const & s, boost::dynamic_bitset<> v);
+/*!
+ \brief Hash for shared states with a vector of flags
+ \param s : state
+ \param v : vector of flags attached to s
+ \return Hash value for state s and vector v
+ \note this should only be used on states that have shared internal components: this function
+ hashes the pointers (not the values). Vector v is hashed block by block
+ */
+std::size_t shared_hash_value_incl_vector(tchecker::zg::state_t const & s, boost::dynamic_bitset<> const & v);
 
 /*!
  \brief Lexical ordering on states of the zone graph
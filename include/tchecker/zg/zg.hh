@@ -5,12 +5,20 @@
 #ifndef TCHECKER_ZG_HH
 #define TCHECKER_ZG_HH
 
+#include <cstddef>
 #include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
 
 #include "tchecker/basictypes.hh"
+#include "tchecker/clockbounds/active_clocks.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/syncprod/vedge.hh"
 #include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/guard_cache.hh"
+#include "tchecker/ta/por.hh"
+#include "tchecker/ta/symmetry.hh"
 #include "tchecker/ta/system.hh"
 #include "tchecker/ta/ta.hh"
 #include "tchecker/ts/builder.hh"
@@ -23,6 +31,7 @@
 #include "tchecker/variables/intvars.hh"
 #include "tchecker/zg/allocators.hh"
 #include "tchecker/zg/extrapolation.hh"
+#include "tchecker/zg/profile.hh"
 #include "tchecker/zg/semantics.hh"
 #include "tchecker/zg/state.hh"
 #include "tchecker/zg/transition.hh"
@@ -577,6 +586,8 @@ inline tchecker::state_status_t initialize(tchecker::ta::system_t const & system
 
 // zg_t
 
+class successors_t;
+
 /*!
  \class zg_t
  \brief Transition system of the zone graph over system of timed processes with
@@ -626,6 +637,7 @@ public:
   using initial_value_t = fwd_impl_t::initial_value_t;
   using outgoing_edges_range_t = fwd_impl_t::outgoing_edges_range_t;
   using outgoing_edges_value_t = fwd_impl_t::outgoing_edges_value_t;
+  using successors_t = tchecker::zg::successors_t; /*!< Lazy successors (see tchecker::zg::successors_t) */
   using final_range_t = bwd_impl_t::final_range_t;
   using final_value_t = bwd_impl_t::final_value_t;
   using incoming_edges_range_t = bwd_impl_t::incoming_edges_range_t;
@@ -640,6 +652,8 @@ public:
    \param block_size : number of objects allocated in a block
    \param table_size : size of hash tables
    \note all states and transitions are pool allocated and deallocated automatically
+   \note with tchecker::ts::NO_SHARING, the tuple of locations, the valuation of bounded integer variables and the zone
+   of each state are allocated together in one record (see tchecker::zg::details::state_pool_allocator_t::allocate_records)
    */
   zg_t(std::shared_ptr<tchecker::ta::system_t const> const & system, enum tchecker::ts::sharing_type_t sharing_type,
        std::shared_ptr<tchecker::zg::semantics_t> const & semantics,
@@ -704,6 +718,7 @@ public:
    and initial transition t from init_edge, such that status matches mask (i.e. status & mask != 0)
    \note states and transitions that are added to v are deallocated automatically
    \note states and transitions share their internal components if sharing_type is tchecker::ts::SHARING
+   \note the initial states are built in a batch: v is grown once for all the initial edges
    */
   virtual void initial(std::vector<sst_t> & v, tchecker::state_status_t mask = tchecker::STATE_OK);
 
@@ -741,6 +756,18 @@ public:
   virtual void next(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v,
                     tchecker::state_status_t mask = tchecker::STATE_OK);
 
+  /*!
+  \brief Next states and transitions with selected status, computed in one batch
+  \param s : state
+  \param v : container
+  \param mask : mask on next states
+  \post same as next(s, v, mask)
+  \note the source part of the successor zones (source invariant and delay) is computed once, then
+  it is copied and updated along each outgoing edge of s (see tchecker::zg::semantics_t::prepare_next)
+  */
+  void next_all(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v,
+                tchecker::state_status_t mask = tchecker::STATE_OK);
+
   // Backward
 
   /*!
@@ -924,6 +951,51 @@ public:
   */
   virtual void share(tchecker::zg::transition_sptr_t & t);
 
+  /*!
+   \brief Clone a state
+   \param s : a state
+   \return a copy of s allocated by this zone graph, with shared components if sharing_type is tchecker::ts::SHARING
+   \pre s is a state of a zone graph over the same system (it may have been allocated by another zone graph)
+   \note s is only read, its reference counters are not modified
+   */
+  tchecker::zg::state_sptr_t clone(tchecker::zg::shared_state_t const & s);
+
+  /*!
+   \brief Clone a state with a precomputed sharing hash
+   \param s : a state
+   \param hash : sharing hash of s
+   \pre hash == sharing_hash(s)
+   \return same as clone(s)
+   \note the zone of the clone is not hashed again: the sharing hash can be computed in parallel by the threads that
+   compute successors, then states are shared sequentially
+   */
+  tchecker::zg::state_sptr_t clone(tchecker::zg::shared_state_t const & s, std::size_t hash);
+
+  /*!
+   \brief Sharing hash of a state
+   \param s : a state
+   \return hash code of the zone of s, as used to share zones (see clone(s, hash))
+   \note reads s only, hence it can be called on states of other zone graphs, concurrently
+   */
+  static inline std::size_t sharing_hash(tchecker::zg::shared_state_t const & s) { return s.zone().hash(); }
+
+  /*!
+   \brief Prefetch the sharing of a state
+   \param hash : sharing hash of a state
+   \post the memory accessed by a later call to clone(s, hash) to share the zone of s is being loaded in the cache of
+   the processor, if this zone graph shares states
+   */
+  void prefetch(std::size_t hash);
+
+  /*!
+   \brief Clone a transition
+   \param t : a transition
+   \return a copy of t allocated by this zone graph, with shared components if sharing_type is tchecker::ts::SHARING
+   \pre t is a transition of a zone graph over the same system (it may have been allocated by another zone graph)
+   \note t is only read, its reference counters are not modified
+   */
+  tchecker::zg::transition_sptr_t clone(tchecker::zg::shared_transition_t const & t);
+
   /*!
    \brief Accessor
    \return Pointer to underlying system of timed processes
@@ -942,7 +1014,103 @@ public:
   */
   inline enum tchecker::ts::sharing_type_t sharing_type() const { return _sharing_type; }
 
+  /*!
+   \brief Accessor
+   \param m : map (subsystem, bytes)
+   \post the memory used by the allocators of this zone graph has been added to m, by subsystem: STATES, VLOCS,
+   INTVALS, ZONES, RECORDS (state allocator), TRANSITIONS and VEDGES (transition allocator)
+   */
+  void memory_usage(std::map<std::string, std::size_t> & m) const;
+
+  /*!
+   \brief Accessor
+   \return true if transitions keep their constraints (source invariant, guard, reset and target invariant),
+   false if transitions only keep their tuple of edges
+  */
+  inline bool transition_constraints() const { return _transition_constraints; }
+
+  /*!
+   \brief Setter
+   \param keep : whether transitions should keep their constraints
+   \post transitions computed from now on keep their constraints if keep is true. Otherwise, constraints are
+   computed in buffers of this zone graph that are reused from one transition to the next, and transitions only
+   keep their tuple of edges
+   \note dropping constraints saves one allocation per container and per transition, for algorithms that only
+   need the tuple of edges of transitions. Constraints are on by default
+  */
+  inline void transition_constraints(bool keep) { _transition_constraints = keep; }
+
+  /*!
+   \brief Setter
+   \param por : partial-order reduction (nullptr disables the reduction)
+   \post next_all (hence next) only computes the successors along the edges of the reducible process of a state
+   (see tchecker::ta::por_t::reducible_process), if there is one and it yields a successor with status
+   tchecker::STATE_OK. Otherwise, all the successors are computed
+   \note the reduction is disabled by default. It preserves the reachability of the labels por has been computed for
+  */
+  inline void partial_order_reduction(std::shared_ptr<tchecker::ta::por_t const> const & por) { _por = por; }
+
+  /*!
+   \brief Accessor
+   \return partial-order reduction of this zone graph, nullptr if the reduction is disabled
+  */
+  inline std::shared_ptr<tchecker::ta::por_t const> const & partial_order_reduction() const { return _por; }
+
+  /*!
+   \brief Setter
+   \param symmetry : symmetry reduction (nullptr disables the reduction)
+   \post the initial states and successors computed from now on with status tchecker::STATE_OK are replaced by their
+   canonical permutation (see tchecker::ta::symmetry_t::canonicalize)
+   \note the reduction is disabled by default. It preserves the reachability of labels, but the transitions of the
+   zone graph do not lead to the states they return anymore (the tuples of edges are those of the permuted state)
+  */
+  inline void symmetry_reduction(std::shared_ptr<tchecker::ta::symmetry_t const> const & symmetry) { _symmetry = symmetry; }
+
+  /*!
+   \brief Setter
+   \param active_clocks : active clocks (nullptr disables the reduction)
+   \post the clocks that are inactive in the tuple of locations of the initial states and successors computed from now
+   on with status tchecker::STATE_OK are freed in their zone (see
+   tchecker::clockbounds::active_clocks_t::free_inactive_clocks)
+   \note the reduction is disabled by default. It preserves the reachability of labels since the values of inactive
+   clocks are never read. The zones of the successors are larger than the exact ones, hence symbolic runs of the zone
+   graph may not be feasible w.r.t. exact zones
+  */
+  inline void active_clocks_reduction(std::shared_ptr<tchecker::clockbounds::active_clocks_t const> const & active_clocks)
+  {
+    _active_clocks = active_clocks;
+  }
+
+  /*!
+   \brief Setter
+   \param profile : profile of the edges and locations of the system (nullptr disables profiling)
+   \post the expansions of states and the successors computed from now on by next are recorded in profile (see
+   tchecker::zg::profile_t)
+   \note profiling is disabled by default. A profile may be shared by several zone graphs over the same system
+  */
+  inline void profile(std::shared_ptr<tchecker::zg::profile_t> const & profile) { _profile = profile; }
+
+  /*!
+   \brief Accessor
+   \return profile of this zone graph, nullptr if profiling is disabled
+  */
+  inline std::shared_ptr<tchecker::zg::profile_t> const & profile() const { return _profile; }
+
 private:
+  /*!
+   \brief Select container for transition constraints
+   \param container : container of a transition
+   \param buffer : buffer of this zone graph
+   \return container if transitions keep their constraints, buffer (cleared) otherwise
+   */
+  template <class CONTAINER> inline CONTAINER & constraints_container(CONTAINER & container, CONTAINER & buffer)
+  {
+    if (_transition_constraints)
+      return container;
+    buffer.clear();
+    return buffer;
+  }
+
   /*!
    \brief Clone and constrain a state
    \param s : a state
@@ -952,12 +1120,75 @@ private:
   tchecker::zg::state_sptr_t clone_and_constrain(tchecker::zg::const_state_sptr_t const & s,
                                                  tchecker::clock_constraint_t const & c);
 
+  /*!
+   \brief Canonical permutation of a state w.r.t. symmetry reduction
+   \param s : a state
+   \pre symmetry reduction is enabled, and the valuation of bounded integer variables of s is not shared
+   \post s has been replaced by its canonical permutation
+   */
+  void canonicalize(tchecker::zg::state_t & s);
+
   std::shared_ptr<tchecker::ta::system_t const> _system;           /*!< System of timed processes */
   enum tchecker::ts::sharing_type_t _sharing_type;                 /*!< Sharing of state/transition components */
   std::shared_ptr<tchecker::zg::semantics_t> _semantics;           /*!< Zone semantics */
   std::shared_ptr<tchecker::zg::extrapolation_t> _extrapolation;   /*!< Zone extrapolation */
   tchecker::zg::state_pool_allocator_t _state_allocator;           /*!< Pool allocator of states */
   tchecker::zg::transition_pool_allocator_t _transition_allocator; /*! Pool allocator of transitions */
+  std::vector<tchecker::dbm::db_t> _prepared_zone;                /*!< Source zone prepared by next_all */
+  bool _transition_constraints;                                    /*!< Whether transitions keep their constraints */
+  tchecker::clock_constraint_container_t _src_invariant_buffer;    /*!< Source invariant of transitions without constraints */
+  tchecker::clock_constraint_container_t _guard_buffer;            /*!< Guard of transitions without constraints */
+  tchecker::clock_reset_container_t _reset_buffer;                 /*!< Reset of transitions without constraints */
+  tchecker::clock_constraint_container_t _tgt_invariant_buffer;    /*!< Target invariant of transitions without constraints */
+  tchecker::ta::guard_cache_t _guard_cache;                        /*!< Truth values of guards on valuations */
+  std::shared_ptr<tchecker::ta::por_t const> _por;                 /*!< Partial-order reduction (nullptr: none) */
+  std::shared_ptr<tchecker::ta::symmetry_t const> _symmetry;       /*!< Symmetry reduction (nullptr: none) */
+  std::vector<tchecker::clock_id_t> _symmetry_clocks;              /*!< Permutation of clocks by canonicalize */
+  std::vector<tchecker::dbm::db_t> _symmetry_zone;                 /*!< Zone permuted by canonicalize */
+  std::shared_ptr<tchecker::clockbounds::active_clocks_t const> _active_clocks; /*!< Active clocks (nullptr: none) */
+  std::shared_ptr<tchecker::zg::profile_t> _profile;               /*!< Profile of edges and locations (nullptr: none) */
+};
+
+/*!
+ \class successors_t
+ \brief Lazy computation of the successors of a state in a zone graph
+ \note successors are computed along one outgoing edge at a time, when they are pulled by next(sst), as by
+ tchecker::ts::successors_t. They are the successors computed by tchecker::zg::zg_t::next(s, v, mask), in the same
+ order, including partial-order reduction. But the source zone is not prepared once for all the outgoing edges (see
+ tchecker::zg::zg_t::next_all): the successors that are not pulled are not computed
+ */
+class successors_t {
+public:
+  /*!
+   \brief Constructor
+   \param zg : zone graph
+   \param s : state
+   \param mask : mask on next states
+   \note this keeps a reference on zg and a copy of s
+   */
+  successors_t(tchecker::zg::zg_t & zg, tchecker::zg::const_state_sptr_t const & s,
+               tchecker::state_status_t mask = tchecker::STATE_OK);
+
+  /*!
+   \brief Next successor
+   \param sst : a tuple (status, state, transition)
+   \post sst has been set to the next successor of s computed by tchecker::zg::zg_t::next(s, v, mask), if any
+   \return true if sst has been set, false if all the successors of s have been pulled
+   \note states and transitions share their internal components if the sharing type of zg is tchecker::ts::SHARING
+   */
+  bool next(tchecker::zg::zg_t::sst_t & sst);
+
+private:
+  tchecker::zg::zg_t & _zg;                       /*!< Zone graph */
+  tchecker::zg::const_state_sptr_t _s;            /*!< Source state */
+  tchecker::state_status_t _mask;                 /*!< Mask on next states */
+  tchecker::process_id_t _reduced;                /*!< Reducible process of _s */
+  int _pass;                                      /*!< 0: edges of _reduced, 1: other edges (see next_all) */
+  bool _ok;                                       /*!< A successor with status STATE_OK has been computed */
+  tchecker::zg::outgoing_edges_range_t _edges;    /*!< Outgoing edges of _s */
+  tchecker::zg::outgoing_edges_iterator_t _it;    /*!< Next outgoing edge */
+  std::vector<tchecker::zg::zg_t::sst_t> _buffer; /*!< Successors along the last outgoing edge */
+  std::size_t _pos;                               /*!< Next successor in _buffer */
 };
 
 /*!
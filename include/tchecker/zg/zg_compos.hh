@@ -6,11 +6,14 @@
 #define TCHECKER_ZG_COMPOS_HH
 
 #include <cstdlib>
+#include <vector>
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
+#include "tchecker/syncprod/edges_cache.hh"
 #include "tchecker/syncprod/vedge.hh"
 #include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/por.hh"
 #include "tchecker/ta/system.hh"
 #include "tchecker/ta/ta.hh"
 #include "tchecker/ts/builder.hh"
@@ -24,9 +27,11 @@
 #include "tchecker/zg/allocators.hh"
 #include "tchecker/zg/extrapolation_compos.hh"
 #include "tchecker/zg/semantics.hh"
+#include "tchecker/zg/split_cache.hh"
 #include "tchecker/zg/state.hh"
 #include "tchecker/zg/transition.hh"
 #include "tchecker/zg/zone.hh"
+#include "tchecker/zg/zone_registry.hh"
 
 /*!
  \file zg.hh
@@ -639,11 +644,14 @@ public:
    \param extrapolation : a zone extrapolation
    \param block_size : number of objects allocated in a block
    \param table_size : size of hash tables
+   \param edges_cache_size : number of entries of the cache of outgoing/incoming tuples of edges (0 disables the cache)
+   \param split_cache_size : number of entries of the cache of splits of zones (0 disables the cache)
    \note all states and transitions are pool allocated and deallocated automatically
    */
   zg_t(std::shared_ptr<tchecker::ta::system_t const> const & system, enum tchecker::ts::sharing_type_t sharing_type,
        std::shared_ptr<tchecker::zg::semantics_t> const & semantics,
-       std::shared_ptr<tchecker::zg_compos::extrapolation_t> const & extrapolation, std::size_t block_size, std::size_t table_size);
+       std::shared_ptr<tchecker::zg_compos::extrapolation_t> const & extrapolation, std::size_t block_size, std::size_t table_size,
+       std::size_t edges_cache_size = 1024, std::size_t split_cache_size = 4096);
 
   /*!
    \brief Copy constructor (deleted)
@@ -741,6 +749,18 @@ public:
   virtual void next(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v,
                     tchecker::state_status_t mask = tchecker::STATE_OK);
 
+  /*!
+  \brief Next states and transitions with selected status, computed in one batch
+  \param s : state
+  \param v : container
+  \param mask : mask on next states
+  \post same as next(s, v, mask)
+  \note the source part of the successor zones (source invariant and delay) is computed once, then
+  it is copied and updated along each outgoing edge of s (see tchecker::zg::semantics_t::prepare_next)
+  */
+  void next_all(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v,
+                tchecker::state_status_t mask = tchecker::STATE_OK);
+
   // Backward
 
   /*!
@@ -863,6 +883,9 @@ public:
    \param v : vector of states
    \post s has been successively split w.r.t. every constraint in constraints. All resulting states
    have been added to v
+   \note with sharing, the zones of the resulting states are cached for the zone of s and constraints (see
+   tchecker::zg::split_cache_t), and a later split of a state with the same shared zone w.r.t. the same constraints
+   shares these zones instead of computing them again. The resulting states are shared
    */
   void split(tchecker::zg::const_state_sptr_t const & s, tchecker::clock_constraint_container_t const & constraints,
              std::vector<tchecker::zg::state_sptr_t> & v);
@@ -924,6 +947,62 @@ public:
   */
   virtual void share(tchecker::zg::transition_sptr_t & t);
 
+  /*!
+   \brief Clone a state
+   \param s : a state
+   \return a copy of s allocated by this zone graph, with shared components if sharing_type is tchecker::ts::SHARING
+   \pre s is a state of a zone graph over the same system (it may have been allocated by another zone graph)
+   \note s is only read, its reference counters are not modified
+   */
+  tchecker::zg::state_sptr_t clone(tchecker::zg::shared_state_t const & s);
+
+  /*!
+   \brief Clone a transition
+   \param t : a transition
+   \return a copy of t allocated by this zone graph, with shared components if sharing_type is tchecker::ts::SHARING
+   \pre t is a transition of a zone graph over the same system (it may have been allocated by another zone graph)
+   \note t is only read, its reference counters are not modified
+   */
+  tchecker::zg::transition_sptr_t clone(tchecker::zg::shared_transition_t const & t);
+
+  /*!
+   \brief Garbage collection
+   \post the cache of splits of zones has been cleared. Unused states and transitions allocated by this zone graph,
+   and their unused shared components, have been collected. Their memory is reused by later allocations
+   \note states that are only referenced by collectable objects (e.g. removed nodes) are only collected once these
+   objects have been collected
+   */
+  void collect();
+
+  /*!
+   \brief Set incremental garbage collection
+   \param trigger : a collection trigger
+   \post unused states and components are collected before a state is allocated, each time trigger fires
+   \note collection is disabled by default (collection then only occurs when allocation pools are full)
+   */
+  void collection_trigger(tchecker::collection_trigger_t const & trigger);
+
+  /*!
+   \brief Share zones with other zone graphs
+   \param registry : a registry of zones
+   \pre no state has been allocated by this zone graph
+   \post zones of states of this zone graph are allocated and shared from the store of their dimension in
+   registry, hence equal shared zones are stored once for all the zone graphs that use registry
+   \throw std::runtime_error : if states have already been allocated by this zone graph
+   \note registry keeps its stores alive, and should not be used by zone graphs of other threads
+   */
+  void share_zones(tchecker::zg::zone_registry_t & registry);
+
+  /*!
+   \brief Setter
+   \param por : partial-order reduction (nullptr disables the reduction)
+   \post next_all (hence next) only computes the successors along the edges of the reducible process of a state
+   (see tchecker::ta::por_t::reducible_process), if there is one and it yields a successor with status
+   tchecker::STATE_OK. Otherwise, all the successors are computed
+   \note the reduction is disabled by default. It preserves the reachability of the labels por has been computed for
+  */
+  inline void partial_order_reduction(std::shared_ptr<tchecker::ta::por_t const> const & por) { _por = por; }
+
   /*!
    \brief Accessor
    \return Pointer to underlying system of timed processes
@@ -942,6 +1021,12 @@ public:
   */
   inline enum tchecker::ts::sharing_type_t sharing_type() const { return _sharing_type; }
 
+  /*!
+   \brief Accessor
+   \return cache of splits of zones
+  */
+  inline tchecker::zg::split_cache_t const & split_cache() const { return _split_cache; }
+
 private:
   /*!
    \brief Clone and constrain a state
@@ -958,6 +1043,10 @@ private:
   std::shared_ptr<tchecker::zg_compos::extrapolation_t> _extrapolation;   /*!< Zone extrapolation */
   tchecker::zg::state_pool_allocator_t _state_allocator;           /*!< Pool allocator of states */
   tchecker::zg::transition_pool_allocator_t _transition_allocator; /*! Pool allocator of transitions */
+  std::vector<tchecker::dbm::db_t> _prepared_zone;                /*!< Source zone prepared by next_all */
+  tchecker::syncprod::vloc_edges_cache_t _edges_cache;             /*!< Outgoing/incoming tuples of edges of vlocs */
+  std::shared_ptr<tchecker::ta::por_t const> _por;                 /*!< Partial-order reduction (nullptr: none) */
+  tchecker::zg::split_cache_t _split_cache;                        /*!< Cache of splits (destructed before states) */
 };
 
 /*!
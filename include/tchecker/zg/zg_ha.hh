@@ -6,6 +6,7 @@
 #define TCHECKER_ZG_HA_HH
 
 #include <cstdlib>
+#include <vector>
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
@@ -27,6 +28,7 @@
 #include "tchecker/zg/state.hh"
 #include "tchecker/zg/transition_ha.hh"
 #include "tchecker/zg/zone.hh"
+#include "tchecker/zg/zone_registry.hh"
 
 /*!
  \file zg.hh
@@ -305,9 +307,9 @@ tchecker::state_status_t next(tchecker::ta_ha::system_t const & system,
                               tchecker::intrusive_shared_ptr_t<tchecker::zg::shared_zone_t> const & zone,
                               tchecker::intrusive_shared_ptr_t<tchecker::shared_vedge_t> const & vedge,
                               tchecker::clock_constraint_container_t & src_invariant,
-                              tchecker::clock_constraint_container_t & guard, std::vector<unsigned> & intvar_guard,
+                              tchecker::clock_constraint_container_t & guard, tchecker::intvar_guard_container_t & intvar_guard,
                               tchecker::clock_reset_container_t & reset,
-                              std::vector<std::pair<tchecker::variable_id_t, tchecker::variable_id_t>> & intvar_set,
+                              tchecker::intvar_set_container_t & intvar_set,
                               tchecker::clock_constraint_container_t & tgt_invariant, tchecker::zg::semantics_t & semantics,
                               tchecker::zg_ha::extrapolation_t & extrapolation,
                               tchecker::zg_ha::outgoing_edges_value_t const & edges);
@@ -429,9 +431,9 @@ tchecker::state_status_t prev(tchecker::ta_ha::system_t const & system,
                               tchecker::intrusive_shared_ptr_t<tchecker::zg::shared_zone_t> const & zone,
                               tchecker::intrusive_shared_ptr_t<tchecker::shared_vedge_t> const & vedge,
                               tchecker::clock_constraint_container_t & src_invariant,
-                              tchecker::clock_constraint_container_t & guard, std::vector<unsigned> & intvar_guard,
+                              tchecker::clock_constraint_container_t & guard, tchecker::intvar_guard_container_t & intvar_guard,
                               tchecker::clock_reset_container_t & reset,
-                              std::vector<std::pair<tchecker::variable_id_t, tchecker::variable_id_t>> & intvar_set,
+                              tchecker::intvar_set_container_t & intvar_set,
                               tchecker::clock_constraint_container_t & tgt_invariant, tchecker::zg::semantics_t & semantics,
                               tchecker::zg_ha::extrapolation_t & extrapolation,
                               tchecker::zg_ha::incoming_edges_value_t const & edges);
@@ -745,6 +747,18 @@ public:
   virtual void next(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v,
                     tchecker::state_status_t mask = tchecker::STATE_OK);
 
+  /*!
+  \brief Next states and transitions with selected status, computed in one batch
+  \param s : state
+  \param v : container
+  \param mask : mask on next states
+  \post same as next(s, v, mask)
+  \note the source part of the successor zones (source invariant and delay) is computed once, then
+  it is copied and updated along each outgoing edge of s (see tchecker::zg::semantics_t::prepare_next)
+  */
+  void next_all(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v,
+                tchecker::state_status_t mask = tchecker::STATE_OK);
+
   // Backward
 
   /*!
@@ -928,6 +942,52 @@ public:
   */
   virtual void share(tchecker::zg_ha::transition_sptr_t & t);
 
+  /*!
+   \brief Clone a state
+   \param s : a state
+   \return a copy of s allocated by this zone graph, with shared components if sharing_type is tchecker::ts::SHARING
+   \pre s is a state of a zone graph over the same system (it may have been allocated by another zone graph)
+   \note s is only read, its reference counters are not modified
+   */
+  tchecker::zg::state_sptr_t clone(tchecker::zg::shared_state_t const & s);
+
+  /*!
+   \brief Clone a transition
+   \param t : a transition
+   \return a copy of t allocated by this zone graph, with shared components if sharing_type is tchecker::ts::SHARING
+   \pre t is a transition of a zone graph over the same system (it may have been allocated by another zone graph)
+   \note t is only read, its reference counters are not modified
+   */
+  tchecker::zg_ha::transition_sptr_t clone(tchecker::zg_ha::shared_transition_t const & t);
+
+  /*!
+   \brief Garbage collection
+   \post unused states and transitions allocated by this zone graph, and their unused shared components, have
+   been collected. Their memory is reused by later allocations
+   \note states that are only referenced by collectable objects (e.g. removed nodes) are only collected once these
+   objects have been collected
+   */
+  void collect();
+
+  /*!
+   \brief Set incremental garbage collection
+   \param trigger : a collection trigger
+   \post unused states and components are collected before a state is allocated, each time trigger fires
+   \note collection is disabled by default (collection then only occurs when allocation pools are full)
+   */
+  void collection_trigger(tchecker::collection_trigger_t const & trigger);
+
+  /*!
+   \brief Share zones with other zone graphs
+   \param registry : a registry of zones
+   \pre no state has been allocated by this zone graph
+   \post zones of states of this zone graph are allocated and shared from the store of their dimension in
+   registry, hence equal shared zones are stored once for all the zone graphs that use registry
+   \throw std::runtime_error : if states have already been allocated by this zone graph
+   \note registry keeps its stores alive, and should not be used by zone graphs of other threads
+   */
+  void share_zones(tchecker::zg::zone_registry_t & registry);
+
   /*!
    \brief Accessor
    \return Pointer to underlying system of timed processes
@@ -962,6 +1022,7 @@ private:
   std::shared_ptr<tchecker::zg_ha::extrapolation_t> _extrapolation;   /*!< Zone extrapolation */
   tchecker::zg_ha::state_pool_allocator_t _state_allocator;           /*!< Pool allocator of states */
   tchecker::zg_ha::transition_pool_allocator_t _transition_allocator; /*! Pool allocator of transitions */
+  std::vector<tchecker::dbm::db_t> _prepared_zone;                /*!< Source zone prepared by next_all */
 };
 
 /*!
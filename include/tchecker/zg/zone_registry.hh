@@ -0,0 +1,241 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ZG_ZONE_REGISTRY_HH
+#define TCHECKER_ZG_ZONE_REGISTRY_HH
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/config.hh"
+#include "tchecker/utils/cache.hh"
+#include "tchecker/utils/pool.hh"
+#include "tchecker/zg/zone.hh"
+
+/*!
+ \file zone_registry.hh
+ \brief Stores of shared zones, that can be used by several zone graphs
+ */
+
+namespace tchecker {
+
+namespace zg {
+
+/*!
+ \class zone_store_t
+ \brief Pool and cache of zones of a given dimension
+ \note a store is either owned by one state allocator, or shared by the state allocators of several zone graphs
+ through a tchecker::zg::zone_registry_t. In the latter case, equal shared zones are stored once for all zone
+ graphs. A store is thread-safe if TCHECKER_THREAD_SAFE_ZONES is defined: zones are then allocated from a
+ tchecker::sharded_pool_t and shared through a tchecker::concurrent_cache_t. Otherwise, it is not thread-safe
+ */
+class zone_store_t {
+public:
+#if defined(TCHECKER_THREAD_SAFE_ZONES)
+  /*!
+   \brief Type of pool of zones
+   */
+  using zone_pool_t = tchecker::sharded_pool_t<tchecker::zg::shared_zone_t>;
+
+  /*!
+   \brief Type of cache of zones
+   */
+  using zone_cache_t =
+      tchecker::concurrent_cache_t<tchecker::zg::zone_sptr_t, tchecker::intrusive_shared_ptr_delegate_hash_t,
+                                   tchecker::intrusive_shared_ptr_delegate_equal_to_t>;
+
+  /*!
+   \brief Whether stores can be shared between threads
+   */
+  static constexpr bool const THREAD_SAFE = true;
+#else
+  /*!
+   \brief Type of pool of zones
+   */
+  using zone_pool_t = tchecker::pool_t<tchecker::zg::shared_zone_t>;
+
+  /*!
+   \brief Type of cache of zones
+   */
+  using zone_cache_t =
+      tchecker::periodic_collectable_cache_t<tchecker::zg::zone_sptr_t, tchecker::intrusive_shared_ptr_delegate_hash_t,
+                                             tchecker::intrusive_shared_ptr_delegate_equal_to_t>;
+
+  /*!
+   \brief Whether stores can be shared between threads
+   */
+  static constexpr bool const THREAD_SAFE = false;
+#endif
+
+  /*!
+   \brief Constructor
+   \param zone_alloc_nb : number of zones allocated in one block
+   \param zone_dimension : dimension of zones
+   \param table_size : size of the cache of zones
+   \throw std::invalid_argument : if zone_alloc_nb is 0
+   */
+  zone_store_t(std::size_t zone_alloc_nb, std::size_t zone_dimension, std::size_t table_size)
+      : _zone_dimension(zone_dimension),
+        _zone_pool(zone_alloc_nb, tchecker::allocation_size_t<tchecker::zg::shared_zone_t>::alloc_size(zone_dimension)),
+        _zone_cache(new zone_cache_t(table_size))
+  {
+    // the cache of a thread-safe store is collected by collect() only
+#if !defined(TCHECKER_THREAD_SAFE_ZONES)
+    _zone_pool.enroll(_zone_cache);
+#endif
+  }
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  zone_store_t(tchecker::zg::zone_store_t const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  zone_store_t(tchecker::zg::zone_store_t &&) = delete;
+
+  /*!
+   \brief Destructor
+   \post all zones in this store have been destructed
+   */
+  ~zone_store_t() { destruct_all(); }
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::zg::zone_store_t & operator=(tchecker::zg::zone_store_t const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::zg::zone_store_t & operator=(tchecker::zg::zone_store_t &&) = delete;
+
+  /*!
+   \brief Accessor
+   \return dimension of zones in this store
+   */
+  inline std::size_t zone_dimension() const { return _zone_dimension; }
+
+  /*!
+   \brief Accessor
+   \return pool of zones
+   */
+  inline zone_pool_t & pool() { return _zone_pool; }
+
+  /*!
+   \brief Accessor
+   \return cache of shared zones
+   */
+  inline zone_cache_t & cache() { return *_zone_cache; }
+
+  /*!
+   \brief Collect unused zones
+   \post unused zones in the cache and in the pool have been collected
+   */
+  void collect()
+  {
+    _zone_cache->collect_now();
+    _zone_pool.collect();
+  }
+
+  /*!
+   \brief Destruct all zones
+   \post the cache is empty and all zones have been destructed
+   \note invalidates all pointers to zones in this store
+   */
+  void destruct_all()
+  {
+    _zone_cache->clear();
+    _zone_pool.destruct_all();
+  }
+
+  /*!
+   \brief Accessor
+   \return memory used by the zones in this store
+   */
+  inline std::size_t memsize() const { return _zone_pool.memsize(); }
+
+private:
+  std::size_t _zone_dimension;                              /*!< Dimension of zones */
+  zone_pool_t _zone_pool;                    /*!< Pool of zones */
+  std::shared_ptr<zone_cache_t> _zone_cache; /*!< Cache of zones */
+};
+
+/*!
+ \class zone_registry_t
+ \brief Registry of zone stores, one for each dimension
+ \note zone graphs that are given the same registry share equal zones, see for instance
+ tchecker::zg_ha::zg_t::share_zones. Stores are created under a lock, hence zone graphs of concurrent threads
+ can share a registry when its stores are thread-safe (see tchecker::zg::zone_store_t::THREAD_SAFE)
+ */
+class zone_registry_t {
+public:
+  /*!
+   \brief Constructor
+   \param zone_alloc_nb : number of zones allocated in one block by stores
+   \param table_size : size of the caches of zones in stores
+   \throw std::invalid_argument : if zone_alloc_nb is 0
+   */
+  zone_registry_t(std::size_t zone_alloc_nb, std::size_t table_size) : _zone_alloc_nb(zone_alloc_nb), _table_size(table_size)
+  {
+    if (_zone_alloc_nb == 0)
+      throw std::invalid_argument("allocation number should be >= 1");
+  }
+
+  /*!
+   \brief Accessor
+   \param zone_dimension : dimension of zones
+   \return the store of zones of dimension zone_dimension in this registry. It is created if there is none
+   */
+  std::shared_ptr<tchecker::zg::zone_store_t> store(std::size_t zone_dimension)
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto it = _stores.find(zone_dimension);
+    if (it != _stores.end())
+      return it->second;
+    auto store = std::make_shared<tchecker::zg::zone_store_t>(_zone_alloc_nb, zone_dimension, _table_size);
+    _stores.emplace(zone_dimension, store);
+    return store;
+  }
+
+  /*!
+   \brief Accessor
+   \return number of stores in this registry
+   */
+  std::size_t size() const
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _stores.size();
+  }
+
+  /*!
+   \brief Accessor
+   \return memory used by the zones in this registry
+   */
+  std::size_t memsize() const
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    std::size_t memsize = 0;
+    for (auto && [dim, store] : _stores)
+      memsize += store->memsize();
+    return memsize;
+  }
+
+private:
+  std::size_t _zone_alloc_nb;                                                 /*!< Number of zones allocated in one block */
+  std::size_t _table_size;                                                    /*!< Size of caches of zones */
+  std::map<std::size_t, std::shared_ptr<tchecker::zg::zone_store_t>> _stores; /*!< Map : dimension -> store */
+  mutable std::mutex _mutex;                                                  /*!< Lock on _stores */
+};
+
+} // end of namespace zg
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ZG_ZONE_REGISTRY_HH
@@ -0,0 +1,90 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ZG_ZONE_STATS_HH
+#define TCHECKER_ZG_ZONE_STATS_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/zg/state.hh"
+
+/*!
+ \file zone_stats.hh
+ \brief Statistics on the zones of stored states
+ */
+
+namespace tchecker {
+
+namespace zg {
+
+/*!
+ \class zone_stats_t
+ \brief Histograms of the shapes of the zones of a set of states, to choose a storage format or an algorithm for a
+ model: number of bounds in the minimal constraint sets of the zones (see tchecker::zg::reduced_zone_t), fraction of
+ unbounded entries of the DBMs, largest absolute constant in the DBMs (see tchecker::zg::packed_zone_t), and number
+ of zones per discrete part (see tchecker::dbm::federation_t and covering reachability)
+ \note the zones are sampled: one state every period is inspected for the shape of its zone, whereas every state is
+ counted in the zones per discrete part. Discrete parts are identified by the hash value of their tuple of locations
+ and their valuation of bounded integer variables, hence discrete parts with the same hash value are counted together
+ */
+class zone_stats_t {
+public:
+  /*!
+   \brief Constructor
+   \param period : sampling period of the zones
+   \throw std::invalid_argument : if period is 0
+   */
+  explicit zone_stats_t(std::size_t period = 1);
+
+  /*!
+   \brief Record a state
+   \param s : a zone graph state
+   \post s has been counted in the zones per discrete part. If s is the first state or a multiple of the period of
+   added states, the shape of its zone has been recorded in the histograms
+   */
+  void add(tchecker::zg::state_t const & s);
+
+  /*!
+   \brief Accessor
+   \return number of added states
+   */
+  inline std::uint64_t states() const { return _states; }
+
+  /*!
+   \brief Accessor
+   \return number of sampled zones
+   */
+  inline std::uint64_t sampled() const { return _sampled; }
+
+  /*!
+   \brief Output a report
+   \param os : output stream
+   \post the histograms have been output to os, one per section starting with a comment line. Each line of a
+   histogram has a value (or a range of values) and the number of zones (or of discrete parts) with this value
+   \return os after output
+   */
+  std::ostream & report(std::ostream & os) const;
+
+private:
+  std::size_t _period;                                   /*!< Sampling period */
+  std::uint64_t _states;                                 /*!< Number of added states */
+  std::uint64_t _sampled;                                /*!< Number of sampled zones */
+  std::map<std::size_t, std::uint64_t> _constraints;     /*!< Number of bounds in minimal constraint set -> zones */
+  std::map<std::size_t, std::uint64_t> _unbounded;       /*!< Decile of unbounded non-diagonal entries -> zones */
+  std::map<std::size_t, std::uint64_t> _constant_bits;   /*!< Bits of the largest absolute constant -> zones */
+  std::unordered_map<std::size_t, std::uint64_t> _zones; /*!< Hash value of discrete part -> zones */
+  std::vector<tchecker::dbm::reduced_bound_t> _bounds;   /*!< Minimal constraint set of the last sampled zone */
+};
+
+} // end of namespace zg
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ZG_ZONE_STATS_HH
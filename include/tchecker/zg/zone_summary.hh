@@ -0,0 +1,154 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ZG_ZONE_SUMMARY_HH
+#define TCHECKER_ZG_ZONE_SUMMARY_HH
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/clockbounds/clockbounds.hh"
+#include "tchecker/dbm/db.hh"
+#include "tchecker/zg/zone.hh"
+
+/*!
+ \file zone_summary.hh
+ \brief Summaries of zones for cheap rejection of aLU inclusion checks
+ */
+
+namespace tchecker {
+
+namespace zg {
+
+/*!
+ \class alu_summary_t
+ \brief Lower-bound rows of a zone used to reject aLU inclusion checks in linear time
+ \note the summary stores the lower-bound row of the zone masked w.r.t. clock upper bounds (see
+ tchecker::dbm::alu_lower_row) and the lower-bound row itself, contiguously. Summaries are compared
+ without accessing the zones. The sums of the two rows (w.r.t. an integer rank of bounds) are ranks of the summary:
+ pointwise comparison of the rows implies comparison of the ranks, hence summaries can be ordered by rank in subsumption indices
+ */
+class alu_summary_t {
+public:
+  /*!
+   \brief Constructor
+   \post this is an empty summary, that may be aLU-included in any summary
+   */
+  alu_summary_t() = default;
+
+  /*!
+   \brief Constructor
+   \param zone : a zone
+   \param u : clock upper bounds
+   \pre u is a clock bound map over the clocks in zone
+   \post this is the summary of zone w.r.t. u. The summary of an empty zone is an empty summary
+   */
+  alu_summary_t(tchecker::zg::zone_t const & zone, tchecker::clockbounds::map_t const & u);
+
+  /*!
+   \brief Necessary condition for aLU inclusion
+   \param summary : a summary
+   \return false if the zone of this summary is not included in aLU(zone of summary), true otherwise (in
+   particular, true if this or summary is an empty summary)
+   \note the aLU inclusion check must still be performed when true is returned. The bounds U used for this
+   summary must be the bounds in tchecker::zg::zone_t::is_alu_le
+   */
+  bool may_be_alu_le(tchecker::zg::alu_summary_t const & summary) const;
+
+  /*!
+   \brief Accessor
+   \return sum of the masked lower-bound row, or the smallest rank for empty summaries
+   \note if this->may_be_alu_le(summary) then lower_rank() <= summary.upper_rank()
+   */
+  inline std::int64_t lower_rank() const { return _lower_rank; }
+
+  /*!
+   \brief Accessor
+   \return sum of the lower-bound row, or the largest rank for empty summaries
+   \note if summary.may_be_alu_le(*this) then summary.lower_rank() <= upper_rank()
+   */
+  inline std::int64_t upper_rank() const { return _upper_rank; }
+
+private:
+  tchecker::clock_id_t _dim{0};                                       /*!< Dimension of the zone (0 for empty summaries) */
+  std::vector<tchecker::dbm::db_t> _rows;                             /*!< Masked lower-bound row, then lower-bound row */
+  std::int64_t _lower_rank{std::numeric_limits<std::int64_t>::min()}; /*!< Sum of the masked lower-bound row */
+  std::int64_t _upper_rank{std::numeric_limits<std::int64_t>::max()}; /*!< Sum of the lower-bound row */
+};
+
+/*!
+ \class node_alu_summary_t
+ \brief Summary functor for tchecker::graph::subsumption::graph_t on nodes that contain a zone graph state
+ \tparam NODE : type of node, should provide a method state() that returns a tchecker::zg::state_t
+ \note summaries are computed w.r.t. local LU clock bounds in the tuple of locations of the state, hence they are
+ consistent with covering predicates that check aLU inclusion w.r.t. local LU clock bounds
+ */
+template <class NODE> class node_alu_summary_t {
+public:
+  /*!
+   \brief Type of summaries
+   */
+  using summary_t = tchecker::zg::alu_summary_t;
+
+  /*!
+   \brief Constructor
+   \param clock_bounds : local LU clock bounds map
+   */
+  node_alu_summary_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & clock_bounds)
+      : _clock_bounds(clock_bounds),
+        _l(tchecker::clockbounds::allocate_map(clock_bounds->clock_number()), &tchecker::clockbounds::deallocate_map),
+        _u(tchecker::clockbounds::allocate_map(clock_bounds->clock_number()), &tchecker::clockbounds::deallocate_map)
+  {
+  }
+
+  /*!
+   \brief Summary computation
+   \param n : a node
+   \return summary of the zone in n w.r.t. local U bounds in the locations of n
+   */
+  tchecker::zg::alu_summary_t summary(NODE const & n) const
+  {
+    _clock_bounds->bounds(n.state().vloc(), *_l, *_u);
+    return tchecker::zg::alu_summary_t{n.state().zone(), *_u};
+  }
+
+  /*!
+   \brief Necessary condition for covering
+   \param s1 : a summary
+   \param s2 : a summary
+   \return false if the node of s1 cannot be covered by the node of s2, true otherwise
+   */
+  inline bool may_be_le(tchecker::zg::alu_summary_t const & s1, tchecker::zg::alu_summary_t const & s2) const
+  {
+    return s1.may_be_alu_le(s2);
+  }
+
+  /*!
+   \brief Lower rank of a summary
+   \param s : a summary
+   \return lower rank of s (see tchecker::zg::alu_summary_t::lower_rank)
+   */
+  inline std::int64_t lower_rank(tchecker::zg::alu_summary_t const & s) const { return s.lower_rank(); }
+
+  /*!
+   \brief Upper rank of a summary
+   \param s : a summary
+   \return upper rank of s (see tchecker::zg::alu_summary_t::upper_rank)
+   */
+  inline std::int64_t upper_rank(tchecker::zg::alu_summary_t const & s) const { return s.upper_rank(); }
+
+private:
+  std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> _clock_bounds; /*!< local LU clock bounds map */
+  std::shared_ptr<tchecker::clockbounds::map_t> _l;                           /*!< L map (scratch) */
+  std::shared_ptr<tchecker::clockbounds::map_t> _u;                           /*!< U map (scratch) */
+};
+
+} // end of namespace zg
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ZG_ZONE_SUMMARY_HH
@@ -0,0 +1,57 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include "tchecker/algorithms/budget.hh"
+#include "tchecker/algorithms/progress.hh"
+#include "tchecker/algorithms/stats.hh"
+
+namespace tchecker {
+
+namespace algorithms {
+
+std::ostream & operator<<(std::ostream & os, enum tchecker::algorithms::budget_status_t status)
+{
+  switch (status) {
+  case tchecker::algorithms::BUDGET_STATES_EXCEEDED:
+    return os << "states";
+  case tchecker::algorithms::BUDGET_TIME_EXCEEDED:
+    return os << "time";
+  case tchecker::algorithms::BUDGET_MEMORY_EXCEEDED:
+    return os << "memory";
+  case tchecker::algorithms::BUDGET_CANCELLED:
+    return os << "cancelled";
+  default:
+    return os << "available";
+  }
+}
+
+budget_t::budget_t(std::uint64_t max_states, std::chrono::milliseconds timeout, std::size_t max_memory,
+                   std::shared_ptr<tchecker::algorithms::progress_t> const & progress,
+                   std::shared_ptr<tchecker::algorithms::cancellation_token_t const> const & cancellation)
+    : _max_states(max_states), _timeout(timeout), _max_memory(max_memory),
+      _deadline(std::chrono::steady_clock::now() + timeout), _progress(progress), _cancellation(cancellation), _checks(0)
+{
+}
+
+bool budget_t::unlimited() const { return _max_states == 0 && _timeout.count() == 0 && _max_memory == 0; }
+
+enum tchecker::algorithms::budget_status_t budget_t::check(std::uint64_t visited_states, std::size_t frontier) const
+{
+  if (_cancellation != nullptr && _cancellation->cancelled())
+    return tchecker::algorithms::BUDGET_CANCELLED;
+  if (_max_states != 0 && visited_states >= _max_states)
+    return tchecker::algorithms::BUDGET_STATES_EXCEEDED;
+  unsigned long const checks = _checks++;
+  if (_progress != nullptr && checks % TIME_CHECK_PERIOD == 0)
+    _progress->sample(visited_states, frontier);
+  if (_timeout.count() != 0 && checks % TIME_CHECK_PERIOD == 0 && std::chrono::steady_clock::now() >= _deadline)
+    return tchecker::algorithms::BUDGET_TIME_EXCEEDED;
+  if (_max_memory != 0 && checks % MEMORY_CHECK_PERIOD == 0 && tchecker::algorithms::resident_memory() > _max_memory)
+    return tchecker::algorithms::BUDGET_MEMORY_EXCEEDED;
+  return tchecker::algorithms::BUDGET_AVAILABLE;
+}
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
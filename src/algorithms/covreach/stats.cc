@@ -11,7 +11,11 @@ namespace tchecker {
 namespace algorithms {
 namespace covreach {
 
-stats_t::stats_t() : _visited_states(0), _visited_transitions(0), _covered_states(0), _reachable(false) {}
+stats_t::stats_t()
+    : _visited_states(0), _visited_transitions(0), _covered_states(0), _stored_states(0), _cover_checks(0),
+      _summary_checks(0), _reachable(false)
+{
+}
 
 unsigned long & stats_t::visited_states() { return _visited_states; }
 
@@ -29,6 +33,14 @@ unsigned long & stats_t::stored_states() { return _stored_states; }
 
 unsigned long stats_t::stored_states() const { return _stored_states; }
 
+unsigned long & stats_t::cover_checks() { return _cover_checks; }
+
+unsigned long stats_t::cover_checks() const { return _cover_checks; }
+
+unsigned long & stats_t::summary_checks() { return _summary_checks; }
+
+unsigned long stats_t::summary_checks() const { return _summary_checks; }
+
 bool & stats_t::reachable() { return _reachable; }
 
 bool stats_t::reachable() const { return _reachable; }
@@ -59,6 +71,18 @@ void stats_t::attributes(std::map<std::string, std::string> & m) const
   m["REACHABLE"] = sstream.str();
 }
 
+void stats_t::cover_attributes(std::map<std::string, std::string> & m) const
+{
+  std::stringstream sstream;
+
+  sstream << _cover_checks;
+  m["COVER_CHECKS"] = sstream.str();
+
+  sstream.str("");
+  sstream << _summary_checks;
+  m["SUMMARY_CHECKS"] = sstream.str();
+}
+
 } // end of namespace covreach
 
 } // namespace algorithms
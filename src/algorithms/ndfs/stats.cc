@@ -80,7 +80,10 @@ void stats_t::attributes(std::map<std::string, std::string> & m) const
   m["STORED_STATES"] = sstream.str();
 
   sstream.str("");
-  sstream << std::boolalpha << _cycle;
+  if (budget_exceeded() && !_cycle)
+    sstream << "unknown";
+  else
+    sstream << std::boolalpha << _cycle;
   m["CYCLE"] = sstream.str();
 }
 
@@ -0,0 +1,82 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#include "tchecker/algorithms/progress.hh"
+
+namespace tchecker {
+
+namespace algorithms {
+
+progress_t::progress_t(std::string const & filename, std::chrono::milliseconds period,
+                       enum tchecker::algorithms::stats_format_t format)
+    : _os(filename.empty() ? std::cerr : _ofs), _period(period), _format(format),
+      _start_time(std::chrono::steady_clock::now()),
+      _next(std::chrono::duration_cast<std::chrono::steady_clock::duration>(period).count())
+{
+  if (period.count() <= 0)
+    throw std::invalid_argument("Period of progress reports should be positive");
+  if (!filename.empty()) {
+    _ofs.open(filename);
+    if (!_ofs)
+      throw std::runtime_error("Cannot write file " + filename);
+  }
+}
+
+void progress_t::sample(std::uint64_t visited_states, std::size_t frontier)
+{
+  std::chrono::steady_clock::duration const elapsed = std::chrono::steady_clock::now() - _start_time;
+  if (elapsed.count() < _next.load(std::memory_order_relaxed))
+    return;
+
+  // the thread that gets the lock reports, the others go on with their exploration
+  std::unique_lock<std::mutex> lock{_mutex, std::try_to_lock};
+  if (!lock.owns_lock() || elapsed.count() < _next.load(std::memory_order_relaxed))
+    return;
+  _next.store((elapsed + _period).count(), std::memory_order_relaxed);
+  report(elapsed, visited_states, frontier);
+}
+
+void progress_t::report(std::chrono::duration<double> elapsed, std::uint64_t visited_states, std::size_t frontier)
+{
+  std::map<std::string, std::string> m;
+  std::stringstream sstream;
+
+  sstream << elapsed.count();
+  m["ELAPSED_SECONDS"] = sstream.str();
+
+  sstream.str("");
+  sstream << visited_states;
+  m["VISITED_STATES"] = sstream.str();
+
+  sstream.str("");
+  sstream << (elapsed.count() > 0.0 ? visited_states / elapsed.count() : 0.0);
+  m["STATES_PER_SECOND"] = sstream.str();
+
+  sstream.str("");
+  sstream << frontier;
+  m["FRONTIER_SIZE"] = sstream.str();
+
+  sstream.str("");
+  sstream << tchecker::algorithms::resident_memory();
+  m["MEMORY_RSS_BYTES"] = sstream.str();
+
+  if (_format == tchecker::algorithms::STATS_FORMAT_JSON) {
+    tchecker::algorithms::output_attributes(_os, m, _format);
+    return;
+  }
+
+  _os << "PROGRESS";
+  for (auto && [key, value] : m)
+    _os << " " << key << "=" << value;
+  _os << std::endl;
+}
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
@@ -0,0 +1,56 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <sstream>
+
+#include "tchecker/algorithms/reach/bmc.hh"
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace reach {
+
+bmc_stats_t::bmc_stats_t() : _bound(0), _depth(0), _complete(false) {}
+
+std::size_t & bmc_stats_t::bound() { return _bound; }
+
+std::size_t bmc_stats_t::bound() const { return _bound; }
+
+std::size_t & bmc_stats_t::depth() { return _depth; }
+
+std::size_t bmc_stats_t::depth() const { return _depth; }
+
+bool & bmc_stats_t::complete() { return _complete; }
+
+bool bmc_stats_t::complete() const { return _complete; }
+
+void bmc_stats_t::attributes(std::map<std::string, std::string> & m) const
+{
+  tchecker::algorithms::reach::stats_t::attributes(m);
+
+  std::stringstream sstream;
+
+  if (!reachable() && !_complete)
+    m["REACHABLE"] = "unknown";
+
+  sstream << _bound;
+  m["BMC_BOUND"] = sstream.str();
+
+  sstream.str("");
+  sstream << std::boolalpha << _complete;
+  m["BMC_COMPLETE"] = sstream.str();
+
+  if (reachable()) {
+    sstream.str("");
+    sstream << _depth;
+    m["COUNTER_EXAMPLE_DEPTH"] = sstream.str();
+  }
+}
+
+} // end of namespace reach
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
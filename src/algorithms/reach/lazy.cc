@@ -0,0 +1,51 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <sstream>
+
+#include "tchecker/algorithms/reach/lazy.hh"
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace reach {
+
+lazy_stats_t::lazy_stats_t() : _covered_states(0), _uncovered_states(0), _refinements(0) {}
+
+std::size_t & lazy_stats_t::covered_states() { return _covered_states; }
+
+std::size_t lazy_stats_t::covered_states() const { return _covered_states; }
+
+std::size_t & lazy_stats_t::uncovered_states() { return _uncovered_states; }
+
+std::size_t lazy_stats_t::uncovered_states() const { return _uncovered_states; }
+
+std::size_t & lazy_stats_t::refinements() { return _refinements; }
+
+std::size_t lazy_stats_t::refinements() const { return _refinements; }
+
+void lazy_stats_t::attributes(std::map<std::string, std::string> & m) const
+{
+  tchecker::algorithms::reach::stats_t::attributes(m);
+
+  std::stringstream sstream;
+
+  sstream << _covered_states;
+  m["COVERED_STATES"] = sstream.str();
+
+  sstream.str("");
+  sstream << _uncovered_states;
+  m["UNCOVERED_STATES"] = sstream.str();
+
+  sstream.str("");
+  sstream << _refinements;
+  m["BOUND_REFINEMENTS"] = sstream.str();
+}
+
+} // end of namespace reach
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
@@ -12,20 +12,33 @@ namespace algorithms {
 
 namespace reach {
 
-stats_t::stats_t() : _visited_states(0), _visited_transitions(0), _reachable(false) {}
+stats_t::stats_t()
+    : _visited_states(0), _visited_transitions(0), _reachable(false), _probabilistic(false), _collision_probability(0.0)
+{
+}
 
-unsigned long & stats_t::visited_states() { return _visited_states; }
+std::uint64_t & stats_t::visited_states() { return _visited_states; }
 
-unsigned long stats_t::visited_states() const { return _visited_states; }
+std::uint64_t stats_t::visited_states() const { return _visited_states; }
 
-unsigned long & stats_t::visited_transitions() { return _visited_transitions; }
+std::uint64_t & stats_t::visited_transitions() { return _visited_transitions; }
 
-unsigned long stats_t::visited_transitions() const { return _visited_transitions; }
+std::uint64_t stats_t::visited_transitions() const { return _visited_transitions; }
 
 bool & stats_t::reachable() { return _reachable; }
 
 bool stats_t::reachable() const { return _reachable; }
 
+bool stats_t::memory_limit_reached() const { return budget_status() == tchecker::algorithms::BUDGET_MEMORY_EXCEEDED; }
+
+bool & stats_t::probabilistic() { return _probabilistic; }
+
+bool stats_t::probabilistic() const { return _probabilistic; }
+
+double & stats_t::collision_probability() { return _collision_probability; }
+
+double stats_t::collision_probability() const { return _collision_probability; }
+
 void stats_t::attributes(std::map<std::string, std::string> & m) const
 {
   tchecker::algorithms::stats_t::attributes(m);
@@ -39,9 +52,29 @@ void stats_t::attributes(std::map<std::string, std::string> & m) const
   sstream << _visited_transitions;
   m["VISITED_TRANSITIONS"] = sstream.str();
 
+  if (tchecker::allocation_stats::enabled()) {
+    sstream.str("");
+    sstream << tchecker::algorithms::allocations_per_state(allocations(), _visited_states);
+    m["ALLOCATIONS_PER_VISITED_STATE"] = sstream.str();
+  }
+
   sstream.str("");
-  sstream << std::boolalpha << _reachable;
+  if (budget_exceeded() && !_reachable)
+    sstream << "unknown";
+  else
+    sstream << std::boolalpha << _reachable;
   m["REACHABLE"] = sstream.str();
+
+  if (memory_limit_reached())
+    m["MEMORY_LIMIT_REACHED"] = "true";
+
+  if (_probabilistic) {
+    m["COMPLETENESS"] = "probabilistic";
+
+    sstream.str("");
+    sstream << _collision_probability;
+    m["COLLISION_PROBABILITY"] = sstream.str();
+  }
 }
 
 } // end of namespace reach
@@ -8,12 +8,24 @@ namespace tchecker {
 
 namespace algorithms {
 
+/*!
+ \brief Guided search orders
+ \param search_order : search order
+ \return true if search_order is a search order guided by priorities, false otherwise
+ */
+static bool guided_search_order(std::string const & search_order)
+{
+  return (search_order == "dist") || (search_order == "random") || (search_order == "reset");
+}
+
 enum tchecker::waiting::policy_t waiting_policy(std::string const & search_order)
 {
   if (search_order == "dfs")
     return tchecker::waiting::STACK;
   else if (search_order == "bfs")
     return tchecker::waiting::QUEUE;
+  else if (guided_search_order(search_order))
+    return tchecker::waiting::PRIORITY_QUEUE;
   throw std::invalid_argument("Unknown search order: " + search_order);
 }
 
@@ -23,6 +35,8 @@ enum tchecker::waiting::policy_t fast_remove_waiting_policy(std::string const &
     return tchecker::waiting::FAST_REMOVE_STACK;
   else if (search_order == "bfs")
     return tchecker::waiting::FAST_REMOVE_QUEUE;
+  else if (guided_search_order(search_order))
+    return tchecker::waiting::FAST_REMOVE_PRIORITY_QUEUE;
   throw std::invalid_argument("Unknown search order: " + search_order);
 }
 
@@ -2,20 +2,60 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <cctype>
+#include <fstream>
 #include <sstream>
 #include <sys/resource.h>
+#include <unistd.h>
 
 #include "tchecker/algorithms/stats.hh"
+#include "tchecker/utils/probes.hh"
+#include "tchecker/utils/string.hh"
 
 namespace tchecker {
 
 namespace algorithms {
 
-void stats_t::set_start_time() { _start_time = std::chrono::steady_clock::now(); }
+std::size_t resident_memory()
+{
+  std::ifstream statm("/proc/self/statm");
+  std::size_t size = 0, resident = 0;
+  if (statm >> size >> resident) {
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size > 0)
+      return resident * static_cast<std::size_t>(page_size);
+  }
+
+  return tchecker::algorithms::peak_resident_memory();
+}
+
+std::size_t peak_resident_memory()
+{
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == -1 || usage.ru_maxrss < 0)
+    return 0;
+#if defined(__APPLE__)
+  return static_cast<std::size_t>(usage.ru_maxrss); // bytes
+#else
+  return static_cast<std::size_t>(usage.ru_maxrss) * 1024; // kilobytes
+#endif
+}
+
+stats_t::stats_t() : _budget_status(tchecker::algorithms::BUDGET_AVAILABLE), _frontier_size(0) {}
+
+void stats_t::set_start_time()
+{
+  _start_allocations = tchecker::allocation_stats::counters();
+  _start_time = std::chrono::steady_clock::now();
+}
 
 std::chrono::time_point<std::chrono::steady_clock> stats_t::start_time() const { return _start_time; }
 
-void stats_t::set_end_time() { _end_time = std::chrono::steady_clock::now(); }
+void stats_t::set_end_time()
+{
+  _end_time = std::chrono::steady_clock::now();
+  _allocations = tchecker::allocation_stats::counters() - _start_allocations;
+}
 
 std::chrono::time_point<std::chrono::steady_clock> stats_t::end_time() const { return _end_time; }
 
@@ -34,6 +74,28 @@ long stats_t::max_rss() const
   return usage.ru_maxrss;
 }
 
+std::uint64_t stats_t::allocations() const { return _allocations.allocations; }
+
+std::uint64_t stats_t::allocated_bytes() const { return _allocations.allocated_bytes; }
+
+std::map<std::string, std::size_t> & stats_t::memory_usage() { return _memory_usage; }
+
+std::map<std::string, std::size_t> const & stats_t::memory_usage() const { return _memory_usage; }
+
+std::map<std::string, std::string> & stats_t::occupancy() { return _occupancy; }
+
+std::map<std::string, std::string> const & stats_t::occupancy() const { return _occupancy; }
+
+enum tchecker::algorithms::budget_status_t & stats_t::budget_status() { return _budget_status; }
+
+enum tchecker::algorithms::budget_status_t stats_t::budget_status() const { return _budget_status; }
+
+bool stats_t::budget_exceeded() const { return _budget_status != tchecker::algorithms::BUDGET_AVAILABLE; }
+
+std::size_t & stats_t::frontier_size() { return _frontier_size; }
+
+std::size_t stats_t::frontier_size() const { return _frontier_size; }
+
 void stats_t::attributes(std::map<std::string, std::string> & m) const
 {
   std::stringstream sstream;
@@ -44,6 +106,230 @@ void stats_t::attributes(std::map<std::string, std::string> & m) const
   sstream.str("");
   sstream << max_rss();
   m["MEMORY_MAX_RSS"] = sstream.str();
+
+  sstream.str("");
+  sstream << tchecker::algorithms::peak_resident_memory();
+  m["MEMORY_PEAK_RSS_BYTES"] = sstream.str();
+
+  for (auto && [subsystem, bytes] : _memory_usage) {
+    sstream.str("");
+    sstream << bytes;
+    m["MEMORY_" + subsystem] = sstream.str();
+  }
+
+  for (auto && [key, value] : _occupancy)
+    m["OCCUPANCY_" + key] = value;
+
+  if (tchecker::allocation_stats::enabled()) {
+    sstream.str("");
+    sstream << _allocations.allocations;
+    m["ALLOCATIONS"] = sstream.str();
+
+    sstream.str("");
+    sstream << _allocations.deallocations;
+    m["DEALLOCATIONS"] = sstream.str();
+
+    sstream.str("");
+    sstream << _allocations.allocated_bytes;
+    m["ALLOCATED_BYTES"] = sstream.str();
+  }
+
+  if (budget_exceeded()) {
+    sstream.str("");
+    sstream << _budget_status;
+    m["BUDGET_EXCEEDED"] = sstream.str();
+
+    sstream.str("");
+    sstream << _frontier_size;
+    m["FRONTIER_SIZE"] = sstream.str();
+  }
+}
+
+bool budget_exceeded(tchecker::algorithms::budget_t const & budget, std::uint64_t visited_states, std::size_t frontier,
+                     tchecker::algorithms::stats_t & stats)
+{
+  enum tchecker::algorithms::budget_status_t status = budget.check(visited_states, frontier);
+  if (status == tchecker::algorithms::BUDGET_AVAILABLE)
+    return false;
+  stats.budget_status() = status;
+  stats.frontier_size() = frontier;
+  return true;
+}
+
+/*!
+ \brief Check a JSON number
+ \param s : a string
+ \return true if s is a JSON number, false otherwise
+ */
+static bool is_json_number(std::string const & s)
+{
+  std::size_t i = 0;
+  auto digits = [&]() {
+    std::size_t const from = i;
+    while (i < s.size() && std::isdigit(static_cast<unsigned char>(s[i])))
+      ++i;
+    return i > from;
+  };
+
+  if (i < s.size() && s[i] == '-')
+    ++i;
+  if (i < s.size() && s[i] == '0')
+    ++i;
+  else if (!digits())
+    return false;
+  if (i < s.size() && s[i] == '.') {
+    ++i;
+    if (!digits())
+      return false;
+  }
+  if (i < s.size() && (s[i] == 'e' || s[i] == 'E')) {
+    ++i;
+    if (i < s.size() && (s[i] == '+' || s[i] == '-'))
+      ++i;
+    if (!digits())
+      return false;
+  }
+  return i == s.size();
+}
+
+void output_attributes(std::ostream & os, std::map<std::string, std::string> const & m,
+                       enum tchecker::algorithms::stats_format_t format, std::string const & separator)
+{
+  if (format == tchecker::algorithms::STATS_FORMAT_TEXT) {
+    for (auto && [key, value] : m)
+      os << key << separator << value << std::endl;
+    return;
+  }
+
+  os << "{";
+  bool first = true;
+  for (auto && [key, value] : m) {
+    if (!first)
+      os << ",";
+    first = false;
+    tchecker::output_json_string(os, key);
+    os << ":";
+    if (value == "true" || value == "false" || is_json_number(value))
+      os << value;
+    else
+      tchecker::output_json_string(os, value);
+  }
+  os << "}" << std::endl;
+}
+
+double allocations_per_state(std::uint64_t allocations, std::uint64_t visited_states)
+{
+  if (visited_states == 0)
+    return 0.0;
+  return static_cast<double>(allocations) / static_cast<double>(visited_states);
+}
+
+phase_stats_t::phase_stats_t()
+    : _runs(0), _running_time(0.0), _cpu_time(0.0), _visited_states(0), _visited_transitions(0), _allocations(0),
+      _allocated_bytes(0)
+{
+}
+
+std::uint64_t & phase_stats_t::runs() { return _runs; }
+
+std::uint64_t phase_stats_t::runs() const { return _runs; }
+
+double & phase_stats_t::running_time() { return _running_time; }
+
+double phase_stats_t::running_time() const { return _running_time; }
+
+double & phase_stats_t::cpu_time() { return _cpu_time; }
+
+double phase_stats_t::cpu_time() const { return _cpu_time; }
+
+std::uint64_t & phase_stats_t::visited_states() { return _visited_states; }
+
+std::uint64_t phase_stats_t::visited_states() const { return _visited_states; }
+
+std::uint64_t & phase_stats_t::visited_transitions() { return _visited_transitions; }
+
+std::uint64_t phase_stats_t::visited_transitions() const { return _visited_transitions; }
+
+std::uint64_t & phase_stats_t::allocations() { return _allocations; }
+
+std::uint64_t phase_stats_t::allocations() const { return _allocations; }
+
+std::uint64_t & phase_stats_t::allocated_bytes() { return _allocated_bytes; }
+
+std::uint64_t phase_stats_t::allocated_bytes() const { return _allocated_bytes; }
+
+tchecker::algorithms::phase_stats_t & phase_stats_t::operator+=(tchecker::algorithms::phase_stats_t const & stats)
+{
+  _runs += stats._runs;
+  _running_time += stats._running_time;
+  _cpu_time += stats._cpu_time;
+  _visited_states += stats._visited_states;
+  _visited_transitions += stats._visited_transitions;
+  _allocations += stats._allocations;
+  _allocated_bytes += stats._allocated_bytes;
+  return *this;
+}
+
+void phase_stats_t::attributes(std::string const & prefix, std::map<std::string, std::string> & m) const
+{
+  std::stringstream sstream;
+
+  sstream << _runs;
+  m[prefix + "_RUNS"] = sstream.str();
+
+  sstream.str("");
+  sstream << _running_time;
+  m[prefix + "_RUNNING_TIME_SECONDS"] = sstream.str();
+
+  sstream.str("");
+  sstream << _cpu_time;
+  m[prefix + "_CPU_TIME_SECONDS"] = sstream.str();
+
+  sstream.str("");
+  sstream << _visited_states;
+  m[prefix + "_VISITED_STATES"] = sstream.str();
+
+  sstream.str("");
+  sstream << _visited_transitions;
+  m[prefix + "_VISITED_TRANSITIONS"] = sstream.str();
+
+  if (tchecker::allocation_stats::enabled()) {
+    sstream.str("");
+    sstream << _allocations;
+    m[prefix + "_ALLOCATIONS"] = sstream.str();
+
+    sstream.str("");
+    sstream << _allocated_bytes;
+    m[prefix + "_ALLOCATED_BYTES"] = sstream.str();
+
+    sstream.str("");
+    sstream << tchecker::algorithms::allocations_per_state(_allocations, _visited_states);
+    m[prefix + "_ALLOCATIONS_PER_VISITED_STATE"] = sstream.str();
+  }
+}
+
+phase_timer_t::phase_timer_t(tchecker::algorithms::phase_stats_t & stats)
+    : _stats(&stats), _start_time(std::chrono::steady_clock::now()), _start_cpu(std::clock()),
+      _start_allocations(tchecker::allocation_stats::counters())
+{
+  TCHECKER_PROBE1(phase_start, _stats);
+}
+
+phase_timer_t::~phase_timer_t() { stop(); }
+
+void phase_timer_t::stop()
+{
+  if (_stats == nullptr)
+    return;
+  std::chrono::duration<double> duration = std::chrono::steady_clock::now() - _start_time;
+  ++_stats->runs();
+  _stats->running_time() += duration.count();
+  _stats->cpu_time() += static_cast<double>(std::clock() - _start_cpu) / CLOCKS_PER_SEC;
+  tchecker::allocation_stats::counters_t const allocations = tchecker::allocation_stats::counters() - _start_allocations;
+  _stats->allocations() += allocations.allocations;
+  _stats->allocated_bytes() += allocations.allocated_bytes;
+  TCHECKER_PROBE2(phase_stop, _stats, _stats->runs());
+  _stats = nullptr;
 }
 
 } // end of namespace algorithms
@@ -0,0 +1,155 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <cstdio>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+
+#include "tchecker/api/api.hh"
+#include "tchecker/parsing/parsing.hh"
+#include "tck-liveness/zg-couvscc.hh"
+#include "tck-liveness/zg-ndfs.hh"
+#include "tck-reach/zg-reach.hh"
+
+namespace tchecker {
+
+namespace api {
+
+/*!
+ \brief Lock on the parser of systems, which is not reentrant
+ */
+static std::mutex parser_mutex;
+
+/* system_t */
+
+system_t::system_t(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl) : _sysdecl(sysdecl) {}
+
+std::shared_ptr<tchecker::api::system_t const> system_t::load(std::string const & filename)
+{
+  std::shared_ptr<tchecker::parsing::system_declaration_t> sysdecl;
+  {
+    std::lock_guard<std::mutex> lock{parser_mutex};
+    sysdecl.reset(tchecker::parsing::parse_system_declaration(filename));
+  }
+  if (sysdecl.get() == nullptr)
+    throw std::runtime_error("Unable to parse system from " + filename);
+  return std::shared_ptr<tchecker::api::system_t const>{new tchecker::api::system_t{sysdecl}};
+}
+
+std::shared_ptr<tchecker::api::system_t const> system_t::from_string(std::string const & text, std::string const & name)
+{
+  std::FILE * f = fmemopen(const_cast<char *>(text.data()), text.size(), "r");
+  if (f == nullptr)
+    throw std::runtime_error("Unable to read system from " + name);
+
+  std::shared_ptr<tchecker::parsing::system_declaration_t> sysdecl;
+  {
+    std::lock_guard<std::mutex> lock{parser_mutex};
+    sysdecl.reset(tchecker::parsing::parse_system_declaration(f, name));
+  }
+  std::fclose(f);
+  if (sysdecl.get() == nullptr)
+    throw std::runtime_error("Unable to parse system from " + name);
+  return std::shared_ptr<tchecker::api::system_t const>{new tchecker::api::system_t{sysdecl}};
+}
+
+std::string const & system_t::name() const { return _sysdecl->name(); }
+
+/* verdict_t */
+
+std::ostream & operator<<(std::ostream & os, enum tchecker::api::verdict_t verdict)
+{
+  switch (verdict) {
+  case tchecker::api::VERDICT_FOUND:
+    return os << "found";
+  case tchecker::api::VERDICT_NOT_FOUND:
+    return os << "not found";
+  default:
+    return os << "unknown";
+  }
+}
+
+/*!
+ \brief Budget of a query
+ \param options : options of the query
+ \param cancellation : cancellation token
+ \return budget with the limits of options and cancellation token
+ */
+static tchecker::algorithms::budget_t
+budget(tchecker::api::options_t const & options,
+       std::shared_ptr<tchecker::algorithms::cancellation_token_t const> const & cancellation)
+{
+  return tchecker::algorithms::budget_t{options.max_states, options.timeout, options.max_memory, nullptr, cancellation};
+}
+
+/*!
+ \brief Result of a query
+ \param stats : statistics of the query
+ \param found : true if a witness has been found, false otherwise
+ \param complete : true if the exploration is complete when not stopped by its budget, false otherwise
+ \return result of the query with statistics stats
+ */
+template <class STATS> static tchecker::api::result_t result(STATS const & stats, bool found, bool complete)
+{
+  tchecker::api::result_t r;
+  if (found)
+    r.verdict = tchecker::api::VERDICT_FOUND;
+  else if (stats.budget_exceeded() || !complete)
+    r.verdict = tchecker::api::VERDICT_UNKNOWN;
+  else
+    r.verdict = tchecker::api::VERDICT_NOT_FOUND;
+  r.budget_status = stats.budget_status();
+  stats.attributes(r.stats);
+  return r;
+}
+
+/* reach */
+
+tchecker::api::result_t reach(tchecker::api::system_t const & system, tchecker::api::reach_options_t const & options,
+                              std::shared_ptr<tchecker::algorithms::cancellation_token_t const> const & cancellation)
+{
+  // no certificate is computed from the graph, hence it stores no edge
+  auto && [stats, graph] = tchecker::tck_reach::zg_reach::run(
+      system.declaration(), options.labels, options.search_order, options.block_size, options.table_size,
+      tchecker::api::budget(options, cancellation), options.bitstate_size, options.por, options.symmetry,
+      options.active_clocks, options.threads, false, "", std::chrono::milliseconds{0}, "",
+      tchecker::algorithms::reach::EDGES_NONE, options.on_the_fly);
+  return tchecker::api::result(stats, stats.reachable(), !stats.probabilistic());
+}
+
+/* liveness */
+
+tchecker::api::result_t liveness(tchecker::api::system_t const & system,
+                                 tchecker::api::liveness_options_t const & options,
+                                 std::shared_ptr<tchecker::algorithms::cancellation_token_t const> const & cancellation)
+{
+  if (options.subsumption && (options.algorithm != tchecker::api::LIVENESS_NDFS || options.threads > 1))
+    throw std::invalid_argument("Subsumption is only available with the sequential nested DFS");
+
+  tchecker::algorithms::budget_t const budget = tchecker::api::budget(options, cancellation);
+
+  if (options.algorithm == tchecker::api::LIVENESS_COUVSCC) {
+    auto && [stats, graph] = tchecker::tck_liveness::zg_couvscc::run(system.declaration(), options.labels, options.block_size,
+                                                                     options.table_size, budget, options.por,
+                                                                     options.threads);
+    return tchecker::api::result(stats, stats.cycle(), true);
+  }
+
+  if (options.threads > 1) {
+    auto && [stats, graph] =
+        tchecker::tck_liveness::zg_ndfs::run_cndfs(system.declaration(), options.labels, options.threads,
+                                                   options.block_size, options.table_size, budget, options.por);
+    return tchecker::api::result(stats, stats.cycle(), true);
+  }
+
+  auto && [stats, graph] = tchecker::tck_liveness::zg_ndfs::run(system.declaration(), options.labels,
+                                                                options.block_size, options.table_size, budget,
+                                                                options.subsumption, options.por);
+  return tchecker::api::result(stats, stats.cycle(), true);
+}
+
+} // namespace api
+
+} // namespace tchecker
@@ -0,0 +1,181 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <cassert>
+#include <limits>
+#include <unordered_set>
+
+#include "tchecker/clockbounds/active_clocks.hh"
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/expression/static_analysis.hh"
+#include "tchecker/statement/static_analysis.hh"
+#include "tchecker/variables/static_analysis.hh"
+
+namespace tchecker {
+
+namespace clockbounds {
+
+/*!
+ \class reset_clocks_extractor_t
+ \brief Computes the set of clock IDs that are surely assigned in a statement: the clocks in the left-hand side of
+ assignments that are not within a conditional statement or a loop, and that can be identified statically
+ */
+class reset_clocks_extractor_t : public tchecker::typed_statement_visitor_t {
+public:
+  /*!
+   \brief Constructor
+   \param clocks : set of reset clocks
+   \post surely assigned clocks are added to clocks
+   */
+  reset_clocks_extractor_t(std::unordered_set<tchecker::clock_id_t> & clocks) : _clocks(clocks) {}
+
+  /*!
+   \brief Destructor
+   */
+  virtual ~reset_clocks_extractor_t() = default;
+
+  /*!
+   \brief Visitor
+   \post first and second statements have been visited
+   */
+  virtual void visit(tchecker::typed_sequence_statement_t const & stmt)
+  {
+    stmt.first().visit(*this);
+    stmt.second().visit(*this);
+  }
+
+  /*!
+   \brief Visitor
+   \post the clock in the lvalue of stmt has been inserted if its ID can be determined
+   */
+  virtual void visit(tchecker::typed_int_to_clock_assign_statement_t const & stmt) { insert(stmt.clock()); }
+
+  /*!
+   \brief Visitor
+   \post the clock in the lvalue of stmt has been inserted if its ID can be determined
+   */
+  virtual void visit(tchecker::typed_clock_to_clock_assign_statement_t const & stmt) { insert(stmt.lclock()); }
+
+  /*!
+   \brief Visitor
+   \post the clock in the lvalue of stmt has been inserted if its ID can be determined
+   */
+  virtual void visit(tchecker::typed_sum_to_clock_assign_statement_t const & stmt) { insert(stmt.lclock()); }
+
+  // Other visitors: no clock is surely assigned in conditional statements and loops
+  virtual void visit(tchecker::typed_if_statement_t const &) {}
+  virtual void visit(tchecker::typed_while_statement_t const &) {}
+  virtual void visit(tchecker::typed_nop_statement_t const &) {}
+  virtual void visit(tchecker::typed_assign_statement_t const &) {}
+  virtual void visit(tchecker::typed_local_var_statement_t const &) {}
+  virtual void visit(tchecker::typed_local_array_statement_t const &) {}
+
+private:
+  /*!
+   \brief Insert clock
+   \param lvalue : left-value clock expression
+   \post the clock in lvalue has been inserted in _clocks if it can be determined statically
+   */
+  void insert(tchecker::typed_lvalue_expression_t const & lvalue)
+  {
+    tchecker::range_t<tchecker::variable_id_t> range = tchecker::extract_lvalue_variable_ids(lvalue);
+    if (range.begin() + 1 == range.end())
+      _clocks.insert(range.begin());
+  }
+
+  std::unordered_set<tchecker::clock_id_t> & _clocks; /*!< Set of reset clocks */
+};
+
+/* active_clocks_t */
+
+tchecker::process_id_t const active_clocks_t::SHARED = std::numeric_limits<tchecker::process_id_t>::max();
+
+tchecker::process_id_t const active_clocks_t::UNUSED = std::numeric_limits<tchecker::process_id_t>::max() - 1;
+
+active_clocks_t::active_clocks_t(tchecker::ta::system_t const & system)
+    : _clock_number(system.clock_variables().size(tchecker::VK_FLATTENED)), _loc_number(system.locations_count()),
+      _owner(_clock_number, UNUSED), _active(static_cast<std::size_t>(_loc_number) * _clock_number, false),
+      _has_inactive_clocks(false)
+{
+  tchecker::variable_access_map_t const access = tchecker::variable_access(system);
+  for (tchecker::clock_id_t x = 0; x < _clock_number; ++x)
+    for (tchecker::process_id_t pid : access.accessing_processes(x, tchecker::VTYPE_CLOCK, tchecker::VACCESS_ANY))
+      _owner[x] = (_owner[x] == UNUSED || _owner[x] == pid ? pid : SHARED);
+
+  std::unordered_set<tchecker::clock_id_t> clocks;
+  std::unordered_set<tchecker::intvar_id_t> intvars;
+
+  // clocks read in the invariant of a location are active in the location
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations()) {
+    clocks.clear();
+    tchecker::extract_variables(system.invariant(loc->id()), clocks, intvars);
+    for (tchecker::clock_id_t x : clocks)
+      _active[loc->id() * _clock_number + x] = true;
+  }
+
+  // clocks read by an edge are active in its source location, and clocks that are active in its target location are
+  // active in its source location unless they are reset by the edge
+  std::vector<std::unordered_set<tchecker::clock_id_t>> resets(system.edges_count());
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+    clocks.clear();
+    tchecker::extract_variables(system.guard(edge->id()), clocks, intvars);
+    tchecker::extract_read_variables(system.statement(edge->id()), clocks, intvars);
+    for (tchecker::clock_id_t x : clocks)
+      _active[edge->src() * _clock_number + x] = true;
+
+    tchecker::clockbounds::reset_clocks_extractor_t extractor(resets[edge->id()]);
+    system.statement(edge->id()).visit(extractor);
+  }
+
+  for (bool stable = false; !stable;) {
+    stable = true;
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges())
+      for (tchecker::clock_id_t x = 0; x < _clock_number; ++x) {
+        std::size_t const src = edge->src() * _clock_number + x, tgt = edge->tgt() * _clock_number + x;
+        if (_active[tgt] && !_active[src] && resets[edge->id()].find(x) == resets[edge->id()].end()) {
+          _active[src] = true;
+          stable = false;
+        }
+      }
+  }
+
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
+    for (tchecker::clock_id_t x = 0; x < _clock_number; ++x)
+      if (_owner[x] == UNUSED || (_owner[x] == loc->pid() && !_active[loc->id() * _clock_number + x]))
+        _has_inactive_clocks = true;
+}
+
+bool active_clocks_t::active(tchecker::vloc_t const & vloc, tchecker::clock_id_t x) const
+{
+  assert(x < _clock_number);
+  tchecker::process_id_t const pid = _owner[x];
+  if (pid == SHARED)
+    return true;
+  if (pid == UNUSED)
+    return false;
+  assert(pid < vloc.size());
+  return _active[vloc[pid] * _clock_number + x];
+}
+
+void active_clocks_t::active_clocks(tchecker::vloc_t const & vloc, std::vector<tchecker::clock_id_t> & clocks) const
+{
+  clocks.clear();
+  for (tchecker::clock_id_t x = 0; x < _clock_number; ++x)
+    if (active(vloc, x))
+      clocks.push_back(x);
+}
+
+void active_clocks_t::free_inactive_clocks(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                           tchecker::vloc_t const & vloc) const
+{
+  assert(dbm != nullptr);
+  assert(dim == _clock_number + 1);
+  for (tchecker::clock_id_t x = 0; x < _clock_number; ++x)
+    if (!active(vloc, x))
+      tchecker::dbm::free_clock(dbm, dim, x + 1); // translation of clock id from system to dbm
+}
+
+} // end of namespace clockbounds
+
+} // end of namespace tchecker
@@ -0,0 +1,34 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include "tchecker/clockbounds/cache.hh"
+#include "tchecker/clockbounds/solver.hh"
+
+namespace tchecker {
+
+namespace clockbounds {
+
+std::shared_ptr<tchecker::clockbounds::clockbounds_t const>
+cache_t::clockbounds(std::shared_ptr<tchecker::parsing::system_declaration_t const> const & sysdecl,
+                     tchecker::ta::system_t const & system)
+{
+  std::lock_guard<std::mutex> lock{_mutex};
+  auto it = _entries.find(sysdecl.get());
+  if (it == _entries.end()) {
+    std::shared_ptr<tchecker::clockbounds::clockbounds_t const> clock_bounds{
+        tchecker::clockbounds::compute_clockbounds(system)};
+    it = _entries.emplace(sysdecl.get(), entry_t{sysdecl, clock_bounds}).first;
+  }
+  return std::get<1>(it->second);
+}
+
+std::size_t cache_t::size() const
+{
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _entries.size();
+}
+
+} // end of namespace clockbounds
+
+} // end of namespace tchecker
@@ -2,9 +2,13 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <algorithm>
 #include <cassert>
+#include <stdexcept>
 #include <tuple>
 
+#include <boost/functional/hash.hpp>
+
 #include "tchecker/basictypes.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/utils/iterator.hh"
@@ -35,6 +39,8 @@ tchecker::clockbounds::map_t * clone_map(tchecker::clockbounds::map_t const & m)
 
 void deallocate_map(tchecker::clockbounds::map_t * m) { tchecker::make_array_destruct_and_deallocate(m); }
 
+void map_deleter_t::operator()(tchecker::clockbounds::map_t * m) const { tchecker::clockbounds::deallocate_map(m); }
+
 void clear(tchecker::clockbounds::map_t & map)
 {
   for (tchecker::clock_id_t id = 0; id < map.capacity(); ++id)
@@ -228,6 +234,45 @@ std::ostream & operator<<(std::ostream & os, tchecker::clockbounds::local_lu_map
   return os;
 }
 
+/* local_lu_cache_t */
+
+local_lu_cache_t::local_lu_cache_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & map,
+                                   std::size_t size)
+    : _map(map)
+{
+  if (size == 0)
+    throw std::invalid_argument("Cache of clock bounds should have a positive size");
+  _slots.resize(size);
+}
+
+local_lu_cache_t::local_lu_cache_t(tchecker::clockbounds::local_lu_cache_t const & c) : local_lu_cache_t(c._map, c.size())
+{
+}
+
+tchecker::clockbounds::local_lu_cache_t &
+local_lu_cache_t::operator=(tchecker::clockbounds::local_lu_cache_t const & c)
+{
+  if (this != &c)
+    *this = tchecker::clockbounds::local_lu_cache_t{c._map, c.size()};
+  return *this;
+}
+
+std::tuple<tchecker::clockbounds::map_t const &, tchecker::clockbounds::map_t const &>
+local_lu_cache_t::bounds(tchecker::vloc_t const & vloc)
+{
+  slot_t & slot = _slots[boost::hash_range(vloc.begin(), vloc.end()) % _slots.size()];
+  if (slot.L == nullptr) {
+    slot.L.reset(tchecker::clockbounds::allocate_map(_map->clock_number()));
+    slot.U.reset(tchecker::clockbounds::allocate_map(_map->clock_number()));
+  }
+  else if (std::equal(vloc.begin(), vloc.end(), slot.vloc.begin(), slot.vloc.end()))
+    return std::tie(*slot.L, *slot.U);
+
+  _map->bounds(vloc, *slot.L, *slot.U);
+  slot.vloc.assign(vloc.begin(), vloc.end());
+  return std::tie(*slot.L, *slot.U);
+}
+
 /* global_lu_map_t */
 
 global_lu_map_t::global_lu_map_t(tchecker::clock_id_t clock_nb) : _clock_nb(0), _L(nullptr), _U(nullptr) { resize(clock_nb); }
@@ -450,6 +495,39 @@ std::ostream & operator<<(std::ostream & os, tchecker::clockbounds::local_m_map_
   return os;
 }
 
+/* local_m_cache_t */
+
+local_m_cache_t::local_m_cache_t(std::shared_ptr<tchecker::clockbounds::local_m_map_t const> const & map,
+                                 std::size_t size)
+    : _map(map)
+{
+  if (size == 0)
+    throw std::invalid_argument("Cache of clock bounds should have a positive size");
+  _slots.resize(size);
+}
+
+local_m_cache_t::local_m_cache_t(tchecker::clockbounds::local_m_cache_t const & c) : local_m_cache_t(c._map, c.size()) {}
+
+tchecker::clockbounds::local_m_cache_t & local_m_cache_t::operator=(tchecker::clockbounds::local_m_cache_t const & c)
+{
+  if (this != &c)
+    *this = tchecker::clockbounds::local_m_cache_t{c._map, c.size()};
+  return *this;
+}
+
+tchecker::clockbounds::map_t const & local_m_cache_t::bounds(tchecker::vloc_t const & vloc)
+{
+  slot_t & slot = _slots[boost::hash_range(vloc.begin(), vloc.end()) % _slots.size()];
+  if (slot.M == nullptr)
+    slot.M.reset(tchecker::clockbounds::allocate_map(_map->clock_number()));
+  else if (std::equal(vloc.begin(), vloc.end(), slot.vloc.begin(), slot.vloc.end()))
+    return *slot.M;
+
+  _map->bounds(vloc, *slot.M);
+  slot.vloc.assign(vloc.begin(), vloc.end());
+  return *slot.M;
+}
+
 /* global_m_map_t */
 
 global_m_map_t::global_m_map_t(tchecker::clock_id_t clock_nb) : _clock_nb(0), _M(nullptr) { resize(clock_nb); }
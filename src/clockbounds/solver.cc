@@ -4,6 +4,9 @@
 
 #include <cassert>
 #include <cstring>
+#include <deque>
+#include <limits>
+#include <stdexcept>
 #include <unordered_set>
 
 #include "tchecker/clockbounds/solver.hh"
@@ -15,128 +18,73 @@ namespace clockbounds {
 
 df_solver_t::df_solver_t(tchecker::ta::system_t const & system)
     : _loc_number(system.locations_count()), _clock_number(system.clock_variables().size(tchecker::VK_FLATTENED)),
-      _loc_pid(_loc_number, 0),
-      _dim(1 + _loc_number * _clock_number), // 1 variable for each clock in each location, plus 1 for dummy clock 0
-      _L(nullptr), _U(nullptr), _has_solution(true)
+      _process_number(system.processes_count()), _loc_pid(_loc_number, 0)
 {
-  if ((_loc_number > 0) && (_clock_number > 0) && ((_dim < _loc_number) || (_dim < _clock_number)))
+  std::size_t const variables = static_cast<std::size_t>(_loc_number + _process_number) * _clock_number;
+  if ((_clock_number > 0) && (variables / _clock_number != static_cast<std::size_t>(_loc_number + _process_number)))
     throw std::invalid_argument("invalid number of clocks or locations (overflow)");
 
   for (tchecker::loc_id_t id = 0; id < _loc_number; ++id)
     _loc_pid[id] = system.location(id)->pid();
 
-  _L = new tchecker::dbm::db_t[_dim * _dim];
-  _U = new tchecker::dbm::db_t[_dim * _dim];
   clear();
 }
 
-df_solver_t::df_solver_t(tchecker::clockbounds::df_solver_t const & solver)
-    : _loc_number(solver._loc_number), _clock_number(solver._clock_number), _loc_pid(solver._loc_pid), _dim(solver._dim),
-      _L(nullptr), _U(nullptr), _has_solution(true)
-{
-  _L = new tchecker::dbm::db_t[_dim * _dim];
-  _U = new tchecker::dbm::db_t[_dim * _dim];
-  memcpy(_L, solver._L, _dim * _dim * sizeof(*_L));
-  memcpy(_U, solver._U, _dim * _dim * sizeof(*_U));
-}
+df_solver_t::df_solver_t(tchecker::clockbounds::df_solver_t const & solver) = default;
 
-df_solver_t::df_solver_t(tchecker::clockbounds::df_solver_t && solver)
-    : _loc_number(std::move(solver._loc_number)), _clock_number(std::move(solver._clock_number)),
-      _loc_pid(std::move(solver._loc_pid)), _dim(std::move(solver._dim)), _L(std::move(solver._L)), _U(std::move(solver._U)),
-      _has_solution(std::move(solver._has_solution))
-{
-  solver._loc_number = 0;
-  solver._clock_number = 0;
-  solver._dim = 1;
-  solver._L = nullptr;
-  solver._U = nullptr;
-  solver._has_solution = false;
-}
-
-df_solver_t::~df_solver_t()
-{
-  delete[] _L;
-  delete[] _U;
-}
+df_solver_t::df_solver_t(tchecker::clockbounds::df_solver_t && solver) = default;
 
-tchecker::clockbounds::df_solver_t & df_solver_t::operator=(tchecker::clockbounds::df_solver_t const & solver)
-{
-  if (this != &solver) {
-    _loc_number = solver._loc_number;
-    _clock_number = solver._clock_number;
-    _loc_pid = solver._loc_pid;
-    _dim = solver._dim;
+df_solver_t::~df_solver_t() = default;
 
-    delete[] _L;
-    _L = new tchecker::dbm::db_t[_dim * _dim];
-    memcpy(_L, solver._L, _dim * _dim * sizeof(*_L));
+tchecker::clockbounds::df_solver_t & df_solver_t::operator=(tchecker::clockbounds::df_solver_t const & solver) = default;
 
-    delete[] _U;
-    _U = new tchecker::dbm::db_t[_dim * _dim];
-    memcpy(_U, solver._U, _dim * _dim * sizeof(*_U));
+tchecker::clockbounds::df_solver_t & df_solver_t::operator=(tchecker::clockbounds::df_solver_t && solver) = default;
 
-    _has_solution = solver._has_solution;
-  }
+tchecker::clock_id_t df_solver_t::clock_number() const { return _clock_number; }
 
-  return *this;
-}
+tchecker::clock_id_t df_solver_t::loc_number() const { return _loc_number; }
 
-tchecker::clockbounds::df_solver_t & df_solver_t::operator=(tchecker::clockbounds::df_solver_t && solver)
+/*!
+ \brief Bound from a minimal path
+ \param d : minimal path from 0 to a variable, INT64_MAX if there is none
+ \return the clock bound for d
+ */
+static tchecker::clockbounds::bound_t bound(std::int64_t d)
 {
-  if (this != &solver) {
-    _loc_number = std::move(solver._loc_number);
-    _clock_number = std::move(solver._clock_number);
-    _loc_pid = std::move(solver._loc_pid);
-    _dim = std::move(solver._dim);
-    _L = std::move(solver._L);
-    _U = std::move(solver._U);
-    _has_solution = std::move(solver._has_solution);
-
-    solver._loc_number = 0;
-    solver._clock_number = 0;
-    solver._dim = 1;
-    solver._L = nullptr;
-    solver._U = nullptr;
-    solver._has_solution = false;
-  }
-
-  return *this;
+  return (d == std::numeric_limits<std::int64_t>::max() ? tchecker::clockbounds::NO_BOUND
+                                                         : static_cast<tchecker::clockbounds::bound_t>(-d));
 }
 
-tchecker::clock_id_t df_solver_t::clock_number() const { return _clock_number; }
-
-tchecker::clock_id_t df_solver_t::loc_number() const { return _loc_number; }
-
 tchecker::clockbounds::bound_t df_solver_t::L(tchecker::loc_id_t l, tchecker::clock_id_t x) const
 {
   assert(l < _loc_number);
   assert(x < _clock_number);
-  tchecker::dbm::db_t db = _L[0 * _dim + index(l, x)];
-  return (db == tchecker::dbm::LT_INFINITY ? tchecker::clockbounds::NO_BOUND : -tchecker::dbm::value(db));
+  solve();
+  return bound(_L_solution[index(l, x)]);
 }
 
 tchecker::clockbounds::bound_t df_solver_t::U(tchecker::loc_id_t l, tchecker::clock_id_t x) const
 {
   assert(l < _loc_number);
   assert(x < _clock_number);
-  tchecker::dbm::db_t db = _U[0 * _dim + index(l, x)];
-  return (db == tchecker::dbm::LT_INFINITY ? tchecker::clockbounds::NO_BOUND : -tchecker::dbm::value(db));
+  solve();
+  return bound(_U_solution[index(l, x)]);
 }
 
-bool df_solver_t::has_solution() const { return _has_solution; }
+bool df_solver_t::has_solution() const
+{
+  solve();
+  return _has_solution;
+}
 
 void df_solver_t::clear()
 {
-  // <inf everywhere except <=0 on diagonal
-  for (tchecker::clock_id_t x = 0; x < _dim; ++x) {
-    for (tchecker::clock_id_t y = 0; y < _dim; ++y) {
-      _L[x * _dim + y] = tchecker::dbm::LT_INFINITY;
-      _U[x * _dim + y] = tchecker::dbm::LT_INFINITY;
-    }
-    _L[x * _dim + x] = tchecker::dbm::LE_ZERO;
-    _U[x * _dim + x] = tchecker::dbm::LE_ZERO;
-  }
-
+  std::size_t const variables = static_cast<std::size_t>(_loc_number + _process_number) * _clock_number;
+  _edges.clear();
+  _L_guards.assign(variables, std::numeric_limits<std::int64_t>::max());
+  _U_guards.assign(variables, std::numeric_limits<std::int64_t>::max());
+  _process_used.assign(static_cast<std::size_t>(_process_number) * _clock_number, false);
+  _solved = false;
   _has_solution = true;
 }
 
@@ -145,7 +93,9 @@ void df_solver_t::add_lower_bound_guard(tchecker::loc_id_t l, tchecker::clock_id
   assert(l < _loc_number);
   assert(x < _clock_number);
   // L_{l, x} >= c  (i.e. 0 - L_{l, x} <= -c)
-  _has_solution &= (tchecker::dbm::constrain(_L, _dim, 0, index(l, x), tchecker::LE, -c) != tchecker::dbm::EMPTY);
+  std::int64_t & guard = _L_guards[index(l, x)];
+  guard = std::min<std::int64_t>(guard, -static_cast<std::int64_t>(c));
+  _solved = false;
 }
 
 void df_solver_t::add_upper_bound_guard(tchecker::loc_id_t l, tchecker::clock_id_t x, tchecker::integer_t c)
@@ -153,7 +103,9 @@ void df_solver_t::add_upper_bound_guard(tchecker::loc_id_t l, tchecker::clock_id
   assert(l < _loc_number);
   assert(x < _clock_number);
   // U_{l, x} >= c  (i.e. 0 - U_{l ,x} <= -c)
-  _has_solution &= (tchecker::dbm::constrain(_U, _dim, 0, index(l, x), tchecker::LE, -c) != tchecker::dbm::EMPTY);
+  std::int64_t & guard = _U_guards[index(l, x)];
+  guard = std::min<std::int64_t>(guard, -static_cast<std::int64_t>(c));
+  _solved = false;
 }
 
 void df_solver_t::add_assignment(tchecker::loc_id_t l1, tchecker::loc_id_t l2, tchecker::clock_id_t x, tchecker::clock_id_t y,
@@ -164,16 +116,16 @@ void df_solver_t::add_assignment(tchecker::loc_id_t l1, tchecker::loc_id_t l2, t
   assert(x < _clock_number);
   assert(y < _clock_number);
   // Propagation over the edge: L_{l2,x} - L_{l1,y} <= c / U_{l2,x} - U_{l1,xy} <= c
-  _has_solution &= (tchecker::dbm::constrain(_L, _dim, index(l2, x), index(l1, y), tchecker::LE, c) != tchecker::dbm::EMPTY);
-  _has_solution &= (tchecker::dbm::constrain(_U, _dim, index(l2, x), index(l1, y), tchecker::LE, c) != tchecker::dbm::EMPTY);
+  _edges.push_back({index(l2, x), index(l1, y), c});
 
   // Propagation across processes: L_{m,x} - L_{l1,y} <= c / U_{m,x} - U_{l1,y} <= c
-  // for every location m in another process
-  for (tchecker::loc_id_t m = 0; m < _loc_number; ++m)
-    if (_loc_pid[m] != _loc_pid[l1]) {
-      _has_solution &= (tchecker::dbm::constrain(_L, _dim, index(m, x), index(l1, y), tchecker::LE, c) != tchecker::dbm::EMPTY);
-      _has_solution &= (tchecker::dbm::constrain(_U, _dim, index(m, x), index(l1, y), tchecker::LE, c) != tchecker::dbm::EMPTY);
+  // for every location m in another process, through the maximal bound of x in the locations of that process
+  for (tchecker::process_id_t pid = 0; pid < _process_number; ++pid)
+    if (pid != _loc_pid[l1]) {
+      _edges.push_back({process_index(pid, x), index(l1, y), c});
+      _process_used[process_index(pid, x) - static_cast<std::size_t>(_loc_number) * _clock_number] = true;
     }
+  _solved = false;
 }
 
 void df_solver_t::add_no_assignement(tchecker::loc_id_t l1, tchecker::loc_id_t l2, tchecker::clock_id_t x)
@@ -181,17 +133,205 @@ void df_solver_t::add_no_assignement(tchecker::loc_id_t l1, tchecker::loc_id_t l
   assert(l1 < _loc_number);
   assert(l2 < _loc_number);
   assert(x < _clock_number);
-  // L_{l2,x} - L_{l1,x} <= 0
-  _has_solution &= (tchecker::dbm::constrain(_L, _dim, index(l2, x), index(l1, x), tchecker::LE, 0) != tchecker::dbm::EMPTY);
-  // U_{l2,x} - U_{l1,x} <= 0
-  _has_solution &= (tchecker::dbm::constrain(_U, _dim, index(l2, x), index(l1, x), tchecker::LE, 0) != tchecker::dbm::EMPTY);
+  // L_{l2,x} - L_{l1,x} <= 0 / U_{l2,x} - U_{l1,x} <= 0
+  _edges.push_back({index(l2, x), index(l1, x), 0});
+  _solved = false;
 }
 
 std::size_t df_solver_t::index(tchecker::loc_id_t l, tchecker::clock_id_t x) const
 {
   assert(l < _loc_number);
   assert(x < _clock_number);
-  return 1 + l * _clock_number + x;
+  return static_cast<std::size_t>(l) * _clock_number + x;
+}
+
+std::size_t df_solver_t::process_index(tchecker::process_id_t pid, tchecker::clock_id_t x) const
+{
+  assert(pid < _process_number);
+  assert(x < _clock_number);
+  return static_cast<std::size_t>(_loc_number + pid) * _clock_number + x;
+}
+
+/*!
+ \brief Strongly connected components
+ \param n : number of vertices
+ \param first : first[v]..first[v+1]-1 are the indices in targets of the successors of vertex v
+ \param targets : successors of the vertices
+ \param component : map from vertices to their component
+ \return number of components
+ \post component[v] is the component of vertex v, components are numbered in topological order (every edge goes
+ from a component to the same component or a bigger one)
+ \note iterative version of Tarjan's algorithm
+ */
+static std::size_t strongly_connected_components(std::size_t n, std::vector<std::size_t> const & first,
+                                                 std::vector<std::size_t> const & targets,
+                                                 std::vector<std::size_t> & component)
+{
+  std::size_t const UNVISITED = std::numeric_limits<std::size_t>::max();
+  std::vector<std::size_t> order(n, UNVISITED), low(n, 0), next(n, 0);
+  std::vector<bool> on_stack(n, false);
+  std::vector<std::size_t> stack, calls;
+  std::size_t counter = 0, count = 0;
+
+  component.assign(n, UNVISITED);
+  for (std::size_t root = 0; root < n; ++root) {
+    if (order[root] != UNVISITED)
+      continue;
+    calls.push_back(root);
+    while (!calls.empty()) {
+      std::size_t const v = calls.back();
+      if (order[v] == UNVISITED) {
+        order[v] = low[v] = counter++;
+        next[v] = first[v];
+        stack.push_back(v);
+        on_stack[v] = true;
+      }
+      if (next[v] < first[v + 1]) {
+        std::size_t const w = targets[next[v]++];
+        if (order[w] == UNVISITED)
+          calls.push_back(w);
+        else if (on_stack[w])
+          low[v] = std::min(low[v], order[w]);
+        continue;
+      }
+      calls.pop_back();
+      if (!calls.empty())
+        low[calls.back()] = std::min(low[calls.back()], low[v]);
+      if (low[v] == order[v]) {
+        std::size_t w;
+        do {
+          w = stack.back();
+          stack.pop_back();
+          on_stack[w] = false;
+          component[w] = count;
+        } while (w != v);
+        ++count;
+      }
+    }
+  }
+
+  // Tarjan's algorithm finds the components in reverse topological order
+  for (std::size_t v = 0; v < n; ++v)
+    component[v] = count - 1 - component[v];
+  return count;
+}
+
+/*!
+ \brief Minimal paths in a component
+ \param members : vertices of the component
+ \param first : first[v]..first[v+1]-1 are the indices in targets and weights of the successors of vertex v
+ \param targets : successors of the vertices
+ \param weights : weights of the edges to successors
+ \param component : map from vertices to their component
+ \param c : a component
+ \param dist : distances
+ \param queued : flags of vertices in the worklist (all false)
+ \param relaxations : number of insertions of each vertex in the worklist, or nullptr
+ \return false if a negative cycle has been found (only if relaxations is not nullptr), true otherwise
+ \post dist has been minimized along the edges of component c (worklist Bellman-Ford algorithm), starting from the
+ members of c with a finite distance
+ */
+static bool component_paths(std::vector<std::size_t> const & members, std::vector<std::size_t> const & first,
+                            std::vector<std::size_t> const & targets, std::vector<std::int64_t> const & weights,
+                            std::vector<std::size_t> const & component, std::size_t c, std::vector<std::int64_t> & dist,
+                            std::vector<bool> & queued, std::vector<std::size_t> * relaxations)
+{
+  std::int64_t const INF = std::numeric_limits<std::int64_t>::max();
+  std::deque<std::size_t> worklist;
+  for (std::size_t v : members)
+    if (dist[v] != INF) {
+      worklist.push_back(v);
+      queued[v] = true;
+    }
+
+  bool no_negative_cycle = true;
+  while (!worklist.empty()) {
+    std::size_t const v = worklist.front();
+    worklist.pop_front();
+    queued[v] = false;
+    if (no_negative_cycle)
+      for (std::size_t k = first[v]; k < first[v + 1]; ++k) {
+        std::size_t const w = targets[k];
+        if (component[w] != c || dist[v] + weights[k] >= dist[w])
+          continue;
+        dist[w] = dist[v] + weights[k];
+        if (queued[w])
+          continue;
+        if (relaxations != nullptr && ++(*relaxations)[w] > members.size()) {
+          no_negative_cycle = false;
+          break;
+        }
+        worklist.push_back(w);
+        queued[w] = true;
+      }
+  }
+  return no_negative_cycle;
+}
+
+void df_solver_t::solve() const
+{
+  if (_solved)
+    return;
+
+  std::int64_t const INF = std::numeric_limits<std::int64_t>::max();
+  std::size_t const n = _L_guards.size();
+
+  // edges (the variable for clock x in process p is bigger than the variables for x in the locations of p)
+  std::vector<edge_t> edges{_edges};
+  for (tchecker::loc_id_t l = 0; l < _loc_number; ++l)
+    for (tchecker::clock_id_t x = 0; x < _clock_number; ++x)
+      if (_process_used[process_index(_loc_pid[l], x) - static_cast<std::size_t>(_loc_number) * _clock_number])
+        edges.push_back({index(l, x), process_index(_loc_pid[l], x), 0});
+
+  // compressed adjacency lists
+  std::vector<std::size_t> first(n + 1, 0), targets(edges.size());
+  std::vector<std::int64_t> weights(edges.size());
+  for (edge_t const & e : edges)
+    ++first[e.src + 1];
+  for (std::size_t v = 0; v < n; ++v)
+    first[v + 1] += first[v];
+  std::vector<std::size_t> position{first.begin(), first.end() - 1};
+  for (edge_t const & e : edges) {
+    targets[position[e.src]] = e.tgt;
+    weights[position[e.src]] = e.weight;
+    ++position[e.src];
+  }
+
+  std::vector<std::size_t> component;
+  std::size_t const count = strongly_connected_components(n, first, targets, component);
+  std::vector<std::vector<std::size_t>> members(count);
+  for (std::size_t v = 0; v < n; ++v)
+    members[component[v]].push_back(v);
+
+  // negative cycles, from null potentials in each component
+  std::vector<bool> queued(n, false);
+  std::vector<std::int64_t> potential(n, 0);
+  std::vector<std::size_t> relaxations(n, 0);
+  _has_solution = true;
+  for (std::size_t c = 0; c < count && _has_solution; ++c)
+    _has_solution = component_paths(members[c], first, targets, weights, component, c, potential, queued, &relaxations);
+
+  _L_solution = _L_guards;
+  _U_solution = _U_guards;
+  if (_has_solution) {
+    // minimal paths from 0, component by component in topological order
+    for (std::vector<std::int64_t> * dist : {&_L_solution, &_U_solution})
+      for (std::size_t c = 0; c < count; ++c) {
+        component_paths(members[c], first, targets, weights, component, c, *dist, queued, nullptr);
+        for (std::size_t v : members[c]) {
+          if ((*dist)[v] == INF)
+            continue;
+          if ((*dist)[v] < -static_cast<std::int64_t>(tchecker::dbm::MAX_VALUE) ||
+              (*dist)[v] > static_cast<std::int64_t>(tchecker::dbm::MAX_VALUE))
+            throw std::overflow_error("Overflow in clock bounds");
+          for (std::size_t k = first[v]; k < first[v + 1]; ++k)
+            if (component[targets[k]] != c)
+              (*dist)[targets[k]] = std::min((*dist)[targets[k]], (*dist)[v] + weights[k]);
+        }
+      }
+  }
+
+  _solved = true;
 }
 
 /*!
@@ -2,18 +2,20 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <numeric>
 
-#if BOOST_VERSION <= 106600
-#include <boost/functional/hash.hpp>
-#else
-#include <boost/container_hash/hash.hpp>
-#endif
-
 #include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/details/fixed_dim.hh"
 #include "tchecker/utils/ordering.hh"
 
+#if defined(TCHECKER_DBM_UNSAFE) || defined(TCHECKER_DBM_PACKED)
+#include "tchecker/dbm/details/kernels.hh"
+#endif
+
 namespace tchecker {
 
 namespace dbm {
@@ -30,6 +32,58 @@ void copy(tchecker::dbm::db_t * dbm1, tchecker::dbm::db_t const * dbm2, tchecker
   std::memcpy(dbm1, dbm2, dim * dim * sizeof(*dbm2));
 }
 
+void permute(tchecker::dbm::db_t * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
+             tchecker::clock_id_t const * perm)
+{
+  assert(dbm1 != nullptr);
+  assert(dbm2 != nullptr);
+  assert(dbm1 != dbm2);
+  assert(dim >= 1);
+  assert(perm[0] == 0);
+  for (tchecker::clock_id_t i = 0; i < dim; ++i)
+    for (tchecker::clock_id_t j = 0; j < dim; ++j)
+      DBM1(i, j) = DBM2(perm[i], perm[j]);
+}
+
+void compact(tchecker::dbm::db_t * cdbm, tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim,
+             tchecker::clock_id_t const * clocks, tchecker::clock_id_t cdim)
+{
+  assert(cdbm != nullptr);
+  assert(dbm != nullptr);
+  assert(1 <= cdim && cdim <= dim);
+  assert(clocks[0] == 0);
+  assert(std::is_sorted(clocks, clocks + cdim) && clocks[cdim - 1] < dim);
+  for (tchecker::clock_id_t i = 0; i < cdim; ++i)
+    for (tchecker::clock_id_t j = 0; j < cdim; ++j)
+      cdbm[i * cdim + j] = DBM(clocks[i], clocks[j]);
+}
+
+void uncompact(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::dbm::db_t const * cdbm,
+               tchecker::clock_id_t const * clocks, tchecker::clock_id_t cdim)
+{
+  assert(dbm != nullptr);
+  assert(cdbm != nullptr);
+  assert(1 <= cdim && cdim <= dim);
+  assert(clocks[0] == 0);
+  assert(std::is_sorted(clocks, clocks + cdim) && clocks[cdim - 1] < dim);
+
+  // free clocks x: x-y <inf, and y-x has the same bound as y-0 (see tchecker::dbm::free_clock)
+  tchecker::dbm::universal(dbm, dim);
+  for (tchecker::clock_id_t i = 0; i < cdim; ++i)
+    for (tchecker::clock_id_t j = 0; j < cdim; ++j)
+      DBM(clocks[i], clocks[j]) = cdbm[i * cdim + j];
+
+  for (tchecker::clock_id_t x = 1, k = 1; x < dim; ++x) {
+    if (k < cdim && clocks[k] == x) {
+      ++k;
+      continue;
+    }
+    for (tchecker::clock_id_t y = 0; y < dim; ++y)
+      DBM(y, x) = DBM(y, 0);
+    DBM(x, x) = tchecker::dbm::LE_ZERO;
+  }
+}
+
 void universal(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim)
 {
   assert(dbm != nullptr);
@@ -161,22 +215,51 @@ bool is_tight(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim)
   return true;
 }
 
+enum tchecker::dbm::status_t tighten_pivot(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t k)
+{
+  assert(dbm != nullptr);
+  assert(dim >= 1);
+  assert(k < dim);
+
+  if (dim <= tchecker::dbm::details::FIXED_DIM_MAX) {
+    bool const non_empty = tchecker::dbm::details::dispatch(
+        dim, [&](auto n) { return tchecker::dbm::details::tighten_pivot<decltype(n)::value>(dbm, k); }, [] { return true; });
+    return (non_empty ? tchecker::dbm::MAY_BE_EMPTY : tchecker::dbm::EMPTY);
+  }
+
+  for (tchecker::clock_id_t i = 0; i < dim; ++i) {
+    if ((i == k) || (DBM(i, k) == tchecker::dbm::LT_INFINITY)) // optimization
+      continue;
+#ifdef TCHECKER_DBM_UNSAFE
+    tchecker::dbm::kernels::tighten_row(&DBM(i, 0), &DBM(k, 0), DBM(i, k), dim, tchecker::dbm::LT_INFINITY);
+#else
+    for (tchecker::clock_id_t j = 0; j < dim; ++j)
+      DBM(i, j) = tchecker::dbm::min(tchecker::dbm::sum(DBM(i, k), DBM(k, j)), DBM(i, j));
+#endif // TCHECKER_DBM_UNSAFE
+    if (DBM(i, i) < tchecker::dbm::LE_ZERO) {
+      DBM(0, 0) = tchecker::dbm::LT_ZERO;
+      return tchecker::dbm::EMPTY;
+    }
+  }
+  return tchecker::dbm::MAY_BE_EMPTY;
+}
+
 enum tchecker::dbm::status_t tighten(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim)
 {
   assert(dbm != nullptr);
   assert(dim >= 1);
 
-  for (tchecker::clock_id_t k = 0; k < dim; ++k) {
-    for (tchecker::clock_id_t i = 0; i < dim; ++i) {
-      if ((i == k) || (DBM(i, k) == tchecker::dbm::LT_INFINITY)) // optimization
-        continue;
-      for (tchecker::clock_id_t j = 0; j < dim; ++j)
-        DBM(i, j) = tchecker::dbm::min(tchecker::dbm::sum(DBM(i, k), DBM(k, j)), DBM(i, j));
-      if (DBM(i, i) < tchecker::dbm::LE_ZERO) {
-        DBM(0, 0) = tchecker::dbm::LT_ZERO;
+  if (dim <= tchecker::dbm::details::FIXED_DIM_MAX) {
+    auto status = tchecker::dbm::details::dispatch(
+        dim, [&](auto n) { return tchecker::dbm::details::tighten<decltype(n)::value>(dbm); },
+        [] { return tchecker::dbm::NON_EMPTY; });
+    if (status == tchecker::dbm::EMPTY)
+      return tchecker::dbm::EMPTY;
+  }
+  else {
+    for (tchecker::clock_id_t k = 0; k < dim; ++k)
+      if (tchecker::dbm::tighten_pivot(dbm, dim, k) == tchecker::dbm::EMPTY)
         return tchecker::dbm::EMPTY;
-      }
-    }
   }
   assert(tchecker::dbm::is_consistent(dbm, dim));
   assert(tchecker::dbm::is_tight(dbm, dim));
@@ -201,8 +284,13 @@ enum tchecker::dbm::status_t tighten(tchecker::dbm::db_t * dbm, tchecker::clock_
     }
 
     // tighten i->j w.r.t. i->y->j
+#ifdef TCHECKER_DBM_UNSAFE
+    if (DBM(i, y) != tchecker::dbm::LT_INFINITY)
+      tchecker::dbm::kernels::tighten_row(&DBM(i, 0), &DBM(y, 0), DBM(i, y), dim, tchecker::dbm::LT_INFINITY);
+#else
     for (tchecker::clock_id_t j = 0; j < dim; ++j)
       DBM(i, j) = tchecker::dbm::min(DBM(i, j), tchecker::dbm::sum(DBM(i, y), DBM(y, j)));
+#endif // TCHECKER_DBM_UNSAFE
 
     if (DBM(i, i) < tchecker::dbm::LE_ZERO) {
       DBM(0, 0) = tchecker::dbm::LT_ZERO;
@@ -254,6 +342,74 @@ enum tchecker::dbm::status_t constrain(tchecker::dbm::db_t * dbm, tchecker::cloc
   return tchecker::dbm::NON_EMPTY;
 }
 
+/*!
+ \brief Maximal number of distinct clocks that are closed incrementally by batched constrain
+ \note above this number, the full Floyd-Warshall closure is applied
+ */
+static constexpr std::size_t const CONSTRAIN_MAX_PIVOTS = 16;
+
+/*!
+ \brief Batched constrain
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param containers : pointers to containers of clock constraints
+ \param count : number of containers
+ \pre dbm is tight and consistent, all constraints are expressed over system clocks
+ \post dbm has been intersected with all constraints, and it is tight if not empty. If dbm is empty,
+ then its difference bound in (0,0) is <0
+ \return EMPTY if dbm is empty, NON_EMPTY otherwise
+ \note all bounds are first updated, and dbm is then closed using the clocks of the updated bounds as pivots only.
+ Since the other bounds were tight, every shortest path only goes through those clocks. A constraint that
+ closes a negative cycle with the opposite bound is detected before any closure
+ */
+static enum tchecker::dbm::status_t constrain_batch(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                                    tchecker::clock_constraint_container_t const * const * containers,
+                                                    std::size_t count)
+{
+  tchecker::clock_id_t pivots[CONSTRAIN_MAX_PIVOTS];
+  std::size_t pivots_count = 0;
+  bool overflow = false;
+
+  auto add_pivot = [&](tchecker::clock_id_t k) {
+    for (std::size_t p = 0; p < pivots_count; ++p)
+      if (pivots[p] == k)
+        return;
+    if (pivots_count == CONSTRAIN_MAX_PIVOTS)
+      overflow = true;
+    else
+      pivots[pivots_count++] = k;
+  };
+
+  for (std::size_t n = 0; n < count; ++n)
+    for (tchecker::clock_constraint_t const & c : *containers[n]) {
+      tchecker::clock_id_t x = (c.id1() == tchecker::REFCLOCK_ID ? 0 : c.id1() + 1);
+      tchecker::clock_id_t y = (c.id2() == tchecker::REFCLOCK_ID ? 0 : c.id2() + 1);
+      assert(x < dim);
+      assert(y < dim);
+      tchecker::dbm::db_t db = tchecker::dbm::db(c.comparator(), c.value());
+      if (db >= DBM(x, y))
+        continue;
+      if (tchecker::dbm::sum(db, DBM(y, x)) < tchecker::dbm::LE_ZERO) { // negative cycle x->y->x
+        DBM(0, 0) = tchecker::dbm::LT_ZERO;
+        return tchecker::dbm::EMPTY;
+      }
+      DBM(x, y) = db;
+      add_pivot(x);
+      add_pivot(y);
+    }
+
+  if (overflow)
+    return tchecker::dbm::tighten(dbm, dim);
+
+  for (std::size_t p = 0; p < pivots_count; ++p)
+    if (tchecker::dbm::tighten_pivot(dbm, dim, pivots[p]) == tchecker::dbm::EMPTY)
+      return tchecker::dbm::EMPTY;
+
+  assert(tchecker::dbm::is_consistent(dbm, dim));
+  assert(tchecker::dbm::is_tight(dbm, dim));
+  return tchecker::dbm::NON_EMPTY;
+}
+
 enum tchecker::dbm::status_t constrain(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
                                        tchecker::clock_constraint_container_t const & constraints)
 {
@@ -262,11 +418,21 @@ enum tchecker::dbm::status_t constrain(tchecker::dbm::db_t * dbm, tchecker::cloc
   assert(tchecker::dbm::is_consistent(dbm, dim));
   assert(tchecker::dbm::is_tight(dbm, dim));
 
-  for (tchecker::clock_constraint_t const & c : constraints) {
-    if (tchecker::dbm::constrain(dbm, dim, c) == tchecker::dbm::EMPTY)
-      return tchecker::dbm::EMPTY;
-  }
-  return tchecker::dbm::NON_EMPTY;
+  tchecker::clock_constraint_container_t const * containers[] = {&constraints};
+  return tchecker::dbm::constrain_batch(dbm, dim, containers, 1);
+}
+
+enum tchecker::dbm::status_t constrain(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                       tchecker::clock_constraint_container_t const & constraints1,
+                                       tchecker::clock_constraint_container_t const & constraints2)
+{
+  assert(dbm != nullptr);
+  assert(dim >= 1);
+  assert(tchecker::dbm::is_consistent(dbm, dim));
+  assert(tchecker::dbm::is_tight(dbm, dim));
+
+  tchecker::clock_constraint_container_t const * containers[] = {&constraints1, &constraints2};
+  return tchecker::dbm::constrain_batch(dbm, dim, containers, 2);
 }
 
 bool is_equal(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim)
@@ -277,11 +443,19 @@ bool is_equal(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2
   assert(tchecker::dbm::is_tight(dbm1, dim));
   assert(tchecker::dbm::is_tight(dbm2, dim));
 
+  if (dim <= tchecker::dbm::details::FIXED_DIM_MAX)
+    return tchecker::dbm::details::dispatch(
+        dim, [&](auto n) { return tchecker::dbm::details::is_equal<decltype(n)::value>(dbm1, dbm2); }, [] { return true; });
+
+#if defined(TCHECKER_DBM_UNSAFE) || defined(TCHECKER_DBM_PACKED)
+  return (std::memcmp(dbm1, dbm2, static_cast<std::size_t>(dim) * dim * sizeof(*dbm1)) == 0);
+#else
   for (tchecker::clock_id_t i = 0; i < dim; ++i)
     for (tchecker::clock_id_t j = 0; j < dim; ++j)
       if (DBM1(i, j) != DBM2(i, j))
         return false;
   return true;
+#endif
 }
 
 bool satisfies(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t x, tchecker::clock_id_t y,
@@ -317,11 +491,19 @@ bool is_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, t
   assert(tchecker::dbm::is_tight(dbm1, dim));
   assert(tchecker::dbm::is_tight(dbm2, dim));
 
+  if (dim <= tchecker::dbm::details::FIXED_DIM_MAX)
+    return tchecker::dbm::details::dispatch(
+        dim, [&](auto n) { return tchecker::dbm::details::is_le<decltype(n)::value>(dbm1, dbm2); }, [] { return true; });
+
+#if defined(TCHECKER_DBM_UNSAFE) || defined(TCHECKER_DBM_PACKED)
+  return tchecker::dbm::kernels::is_le(dbm1, dbm2, static_cast<std::size_t>(dim) * dim);
+#else
   for (tchecker::clock_id_t i = 0; i < dim; ++i)
     for (tchecker::clock_id_t j = 0; j < dim; ++j)
       if (DBM1(i, j) > DBM2(i, j))
         return false;
   return true;
+#endif
 }
 
 void reset(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t x, tchecker::clock_id_t y,
@@ -502,13 +684,108 @@ enum tchecker::dbm::status_t intersection(tchecker::dbm::db_t * dbm, tchecker::d
   assert(tchecker::dbm::is_tight(dbm1, dim));
   assert(tchecker::dbm::is_tight(dbm2, dim));
 
+#if defined(TCHECKER_DBM_UNSAFE) || defined(TCHECKER_DBM_PACKED)
+  tchecker::dbm::kernels::min(dbm, dbm1, dbm2, static_cast<std::size_t>(dim) * dim);
+#else
   for (tchecker::clock_id_t i = 0; i < dim; ++i)
     for (tchecker::clock_id_t j = 0; j < dim; ++j)
       DBM(i, j) = tchecker::dbm::min(DBM1(i, j), DBM2(i, j));
+#endif
 
   return tchecker::dbm::tighten(dbm, dim);
 }
 
+void convex_hull(tchecker::dbm::db_t * dbm, tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2,
+                 tchecker::clock_id_t dim)
+{
+  assert(dim >= 1);
+  assert(dbm != nullptr);
+  assert(dbm1 != nullptr);
+  assert(dbm2 != nullptr);
+  assert(tchecker::dbm::is_consistent(dbm1, dim));
+  assert(tchecker::dbm::is_consistent(dbm2, dim));
+  assert(tchecker::dbm::is_tight(dbm1, dim));
+  assert(tchecker::dbm::is_tight(dbm2, dim));
+
+  // the pointwise maximum of two tight DBMs is tight
+  for (tchecker::clock_id_t i = 0; i < dim; ++i)
+    for (tchecker::clock_id_t j = 0; j < dim; ++j)
+      DBM(i, j) = tchecker::dbm::max(DBM1(i, j), DBM2(i, j));
+
+  assert(tchecker::dbm::is_tight(dbm, dim));
+}
+
+bool is_union_convex(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim)
+{
+  assert(dim >= 1);
+  assert(dbm1 != nullptr);
+  assert(dbm2 != nullptr);
+  assert(tchecker::dbm::is_consistent(dbm1, dim));
+  assert(tchecker::dbm::is_consistent(dbm2, dim));
+  assert(tchecker::dbm::is_tight(dbm1, dim));
+  assert(tchecker::dbm::is_tight(dbm2, dim));
+
+  if (tchecker::dbm::is_le(dbm1, dbm2, dim) || tchecker::dbm::is_le(dbm2, dbm1, dim))
+    return true;
+
+  std::size_t const size = static_cast<std::size_t>(dim) * dim;
+  std::vector<tchecker::dbm::db_t> hull(size), piece(size);
+  tchecker::dbm::convex_hull(hull.data(), dbm1, dbm2, dim);
+
+  // hull \ dbm1 is the union of hull & !(xi - xj # c) over the bounds (i,j) of dbm1 stronger than the hull. Each
+  // piece must be included in dbm2. The negation of xi - xj # c is xj - xi #' -c (#' is < if # is <=, and <= if #
+  // is <)
+  for (tchecker::clock_id_t i = 0; i < dim; ++i)
+    for (tchecker::clock_id_t j = 0; j < dim; ++j) {
+      tchecker::dbm::db_t const bound = DBM1(i, j);
+      if (bound >= hull[i * dim + j])
+        continue;
+      enum tchecker::ineq_cmp_t const cmp = (tchecker::dbm::comparator(bound) == tchecker::LE ? tchecker::LT : tchecker::LE);
+      piece = hull;
+      if (tchecker::dbm::constrain(piece.data(), dim, j, i, cmp, -tchecker::dbm::value(bound)) == tchecker::dbm::EMPTY)
+        continue;
+      if (!tchecker::dbm::is_le(piece.data(), dbm2, dim))
+        return false;
+    }
+  return true;
+}
+
+std::size_t subtract(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
+                     std::vector<tchecker::dbm::db_t> & pieces)
+{
+  assert(dim >= 1);
+  assert(dbm1 != nullptr);
+  assert(dbm2 != nullptr);
+  assert(tchecker::dbm::is_consistent(dbm1, dim));
+  assert(tchecker::dbm::is_consistent(dbm2, dim));
+  assert(tchecker::dbm::is_tight(dbm1, dim));
+  assert(tchecker::dbm::is_tight(dbm2, dim));
+
+  std::size_t const size = static_cast<std::size_t>(dim) * dim;
+  std::vector<tchecker::dbm::db_t> remainder{dbm1, dbm1 + size};
+  std::vector<tchecker::dbm::db_t> piece(size);
+  std::size_t count = 0;
+
+  // remainder is dbm1 intersected with the bounds of dbm2 considered so far, the next piece is remainder intersected
+  // with the negation of the next bound xi - xj # c, i.e. xj - xi #' -c (#' is < if # is <=, and <= if # is <)
+  for (tchecker::clock_id_t i = 0; i < dim; ++i)
+    for (tchecker::clock_id_t j = 0; j < dim; ++j) {
+      tchecker::dbm::db_t const bound = DBM2(i, j);
+      if (bound >= remainder[i * dim + j])
+        continue;
+      enum tchecker::ineq_cmp_t const cmp = (tchecker::dbm::comparator(bound) == tchecker::LE ? tchecker::LT : tchecker::LE);
+      piece = remainder;
+      if (tchecker::dbm::constrain(piece.data(), dim, j, i, cmp, -tchecker::dbm::value(bound)) == tchecker::dbm::NON_EMPTY) {
+        pieces.insert(pieces.end(), piece.begin(), piece.end());
+        ++count;
+      }
+      if (tchecker::dbm::constrain(remainder.data(), dim, i, j, tchecker::dbm::comparator(bound),
+                                   tchecker::dbm::value(bound)) == tchecker::dbm::EMPTY)
+        return count;
+    }
+  return count;
+}
+
 void extra_m(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * m)
 {
   assert(dbm != nullptr);
@@ -857,12 +1134,155 @@ bool is_am_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2
   return tchecker::dbm::is_alu_le(dbm1, dbm2, dim, m, m);
 }
 
+void alu_lower_row(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * u,
+                   tchecker::dbm::db_t * row)
+{
+  assert(dbm != nullptr);
+  assert(row != nullptr);
+  assert(dim >= 1);
+  assert(tchecker::dbm::is_consistent(dbm, dim));
+  assert(tchecker::dbm::is_positive(dbm, dim));
+  assert(tchecker::dbm::is_tight(dbm, dim));
+
+  tchecker::dbm::db_t const lt_min = tchecker::dbm::db(tchecker::LT, tchecker::dbm::MIN_VALUE);
+
+  for (tchecker::clock_id_t x = 0; x < dim; ++x) {
+    tchecker::integer_t Ux = U(x);
+    assert(Ux < tchecker::dbm::INF_VALUE);
+
+    if ((Ux == -tchecker::dbm::INF_VALUE) || (DBM(0, x) < tchecker::dbm::db(tchecker::LE, -Ux)))
+      row[x] = lt_min;
+    else
+      row[x] = DBM(0, x);
+  }
+}
+
+bool is_lower_row_le(tchecker::dbm::db_t const * row1, tchecker::dbm::db_t const * row2, tchecker::clock_id_t dim)
+{
+  assert(row1 != nullptr);
+  assert(row2 != nullptr);
+#if defined(TCHECKER_DBM_UNSAFE) || defined(TCHECKER_DBM_PACKED)
+  return tchecker::dbm::kernels::is_le(row1, row2, dim);
+#else
+  for (tchecker::clock_id_t x = 0; x < dim; ++x)
+    if (row1[x] > row2[x])
+      return false;
+  return true;
+#endif
+}
+
+void reduce(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim, std::vector<tchecker::dbm::reduced_bound_t> & bounds)
+{
+  assert(dbm != nullptr);
+  assert(dim >= 1);
+
+  bounds.clear();
+
+  if (tchecker::dbm::is_empty_0(dbm, dim)) {
+    bounds.push_back({0, 0, tchecker::dbm::LT_ZERO});
+    return;
+  }
+
+  assert(tchecker::dbm::is_tight(dbm, dim));
+
+  // zero-cycle classes: rep[i] is the smallest clock in the class of i, and next[i] is the next clock in the
+  // class of i (or dim if i is the largest one)
+  std::vector<tchecker::clock_id_t> rep(dim), next(dim, dim);
+  for (tchecker::clock_id_t i = 0; i < dim; ++i)
+    rep[i] = i;
+
+  for (tchecker::clock_id_t i = 0; i < dim; ++i) {
+    if (rep[i] != i)
+      continue;
+    tchecker::clock_id_t last = i;
+    for (tchecker::clock_id_t j = i + 1; j < dim; ++j)
+      if ((rep[j] == j) && (tchecker::dbm::sum(DBM(i, j), DBM(j, i)) == tchecker::dbm::LE_ZERO)) {
+        rep[j] = i;
+        next[last] = j;
+        last = j;
+      }
+    // cycle i -> ... -> last -> i through the class of i
+    if (last != i) {
+      for (tchecker::clock_id_t k = i; k != last; k = next[k])
+        bounds.push_back({k, next[k], DBM(k, next[k])});
+      bounds.push_back({last, i, DBM(last, i)});
+    }
+  }
+
+  // bounds between representatives that are not implied by a path through another representative
+  for (tchecker::clock_id_t i = 0; i < dim; ++i) {
+    if (rep[i] != i)
+      continue;
+    for (tchecker::clock_id_t j = 0; j < dim; ++j) {
+      if ((rep[j] != j) || (i == j) || (DBM(i, j) == tchecker::dbm::LT_INFINITY))
+        continue;
+      bool implied = false;
+      for (tchecker::clock_id_t k = 0; k < dim && !implied; ++k) {
+        if ((rep[k] != k) || (k == i) || (k == j))
+          continue;
+        if ((DBM(i, k) == tchecker::dbm::LT_INFINITY) || (DBM(k, j) == tchecker::dbm::LT_INFINITY))
+          continue;
+        implied = (tchecker::dbm::sum(DBM(i, k), DBM(k, j)) <= DBM(i, j));
+      }
+      if (!implied)
+        bounds.push_back({i, j, DBM(i, j)});
+    }
+  }
+}
+
+void expand(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::dbm::reduced_bound_t const * bounds,
+            std::size_t count)
+{
+  assert(dbm != nullptr);
+  assert(dim >= 1);
+
+  tchecker::dbm::universal(dbm, dim);
+  for (std::size_t k = 0; k < count; ++k) {
+    assert(bounds[k].i < dim);
+    assert(bounds[k].j < dim);
+    DBM(bounds[k].i, bounds[k].j) = bounds[k].db;
+  }
+
+  if (DBM(0, 0) < tchecker::dbm::LE_ZERO)
+    return;
+
+  tchecker::dbm::tighten(dbm, dim);
+}
+
 std::size_t hash(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim)
 {
-  std::size_t seed = 0;
-  for (tchecker::clock_id_t k = 0; k < dim * dim; ++k)
-    boost::hash_combine(seed, tchecker::dbm::hash(dbm[k]));
-  return seed;
+  assert(dbm != nullptr);
+  assert(dim >= 1);
+
+  // Bounds are mixed into 4 independent lanes (multiply-xor), which removes the serial dependency of
+  // hash_combine and lets the compiler interleave or vectorize the loop. Lanes are then merged and the result
+  // is finalized with the 64-bit MurmurHash3 mixer
+  std::uint64_t const K = 0x9e3779b97f4a7c15ULL;
+  std::size_t const n = static_cast<std::size_t>(dim) * dim;
+  std::uint64_t h;
+  if (dim <= 3) {
+    // at most 9 bounds: a single lane is cheaper than the setup and the merge of 4 lanes
+    h = K ^ n;
+    for (std::size_t k = 0; k < n; ++k)
+      h = (h ^ static_cast<std::uint64_t>(tchecker::dbm::hash(dbm[k]))) * K;
+  }
+  else {
+    std::uint64_t lanes[4] = {K, K ^ 1, K ^ 2, K ^ 3};
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4)
+      for (std::size_t l = 0; l < 4; ++l)
+        lanes[l] = (lanes[l] ^ static_cast<std::uint64_t>(tchecker::dbm::hash(dbm[k + l]))) * K;
+    for (std::size_t l = 0; k < n; ++k, ++l)
+      lanes[l] = (lanes[l] ^ static_cast<std::uint64_t>(tchecker::dbm::hash(dbm[k]))) * K;
+    h = lanes[0] ^ (lanes[1] << 17 | lanes[1] >> 47) ^ (lanes[2] << 31 | lanes[2] >> 33) ^
+        (lanes[3] << 47 | lanes[3] >> 17) ^ n;
+  }
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return static_cast<std::size_t>(h);
 }
 
 std::ostream & output_matrix(std::ostream & os, tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim)
@@ -0,0 +1,89 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <algorithm>
+#include <cassert>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/federation.hh"
+
+namespace tchecker {
+
+namespace dbm {
+
+federation_t::federation_t(tchecker::clock_id_t dim) : _dim(dim) { assert(dim >= 1); }
+
+bool federation_t::contains(tchecker::dbm::db_t const * dbm) const
+{
+  std::size_t const n = size();
+  for (std::size_t k = 0; k < n; ++k)
+    if (tchecker::dbm::is_le(dbm, federation_t::dbm(k), _dim))
+      return true;
+  if (n < 2)
+    return false;
+  std::vector<tchecker::dbm::db_t> pieces;
+  return subtract(dbm, pieces) == 0;
+}
+
+std::size_t federation_t::subtract(tchecker::dbm::db_t const * dbm, std::vector<tchecker::dbm::db_t> & pieces) const
+{
+  std::size_t const dbm_size = static_cast<std::size_t>(_dim) * _dim;
+
+  // the pieces of dbm that are not covered by the first k DBMs of the federation
+  std::vector<tchecker::dbm::db_t> remainder{dbm, dbm + dbm_size}, next;
+  std::size_t const n = size();
+  for (std::size_t k = 0; k < n && !remainder.empty(); ++k) {
+    next.clear();
+    for (std::size_t p = 0; p < remainder.size(); p += dbm_size)
+      tchecker::dbm::subtract(remainder.data() + p, federation_t::dbm(k), _dim, next);
+    remainder.swap(next);
+  }
+
+  pieces.insert(pieces.end(), remainder.begin(), remainder.end());
+  return remainder.size() / dbm_size;
+}
+
+bool federation_t::add(tchecker::dbm::db_t const * dbm)
+{
+  std::size_t const dbm_size = static_cast<std::size_t>(_dim) * _dim;
+
+  for (std::size_t k = 0; k < size(); ++k)
+    if (tchecker::dbm::is_le(dbm, federation_t::dbm(k), _dim))
+      return false;
+
+  std::vector<tchecker::dbm::db_t> merged{dbm, dbm + dbm_size};
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (std::size_t k = 0; k < size();) {
+      tchecker::dbm::db_t const * other = federation_t::dbm(k);
+      if (tchecker::dbm::is_le(other, merged.data(), _dim))
+        remove(k);
+      else if (tchecker::dbm::is_union_convex(merged.data(), other, _dim)) {
+        // the hull may now merge with DBMs that have already been checked
+        tchecker::dbm::convex_hull(merged.data(), merged.data(), other, _dim);
+        remove(k);
+        changed = true;
+      }
+      else
+        ++k;
+    }
+  }
+
+  _dbms.insert(_dbms.end(), merged.begin(), merged.end());
+  return true;
+}
+
+void federation_t::remove(std::size_t k)
+{
+  std::size_t const dbm_size = static_cast<std::size_t>(_dim) * _dim;
+  assert(k < size());
+  if (k + 1 < size())
+    std::copy(_dbms.end() - dbm_size, _dbms.end(), _dbms.begin() + k * dbm_size);
+  _dbms.resize(_dbms.size() - dbm_size);
+}
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
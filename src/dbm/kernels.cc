@@ -0,0 +1,215 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <cassert>
+
+#include "tchecker/dbm/details/kernels.hh"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && (INTEGER_T_SIZE == 32)
+#define TCHECKER_DBM_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+namespace tchecker {
+
+namespace dbm {
+
+namespace kernels {
+
+/* Generic kernels (also used for the tails of vectorized loops) */
+
+static inline bool generic_is_le(tchecker::integer_t const * a, tchecker::integer_t const * b, std::size_t n)
+{
+  for (std::size_t k = 0; k < n; ++k)
+    if (a[k] > b[k])
+      return false;
+  return true;
+}
+
+static inline void generic_min(tchecker::integer_t * r, tchecker::integer_t const * a, tchecker::integer_t const * b,
+                               std::size_t n)
+{
+  for (std::size_t k = 0; k < n; ++k)
+    r[k] = (a[k] < b[k] ? a[k] : b[k]);
+}
+
+static inline void generic_tighten_row(tchecker::integer_t * row_i, tchecker::integer_t const * row_k,
+                                       tchecker::integer_t db_ik, std::size_t n, tchecker::integer_t inf)
+{
+  for (std::size_t j = 0; j < n; ++j) {
+    tchecker::integer_t const db_kj = row_k[j];
+    tchecker::integer_t const s = (db_kj == inf ? inf : (db_ik + db_kj) - ((db_ik | db_kj) & 1));
+    if (s < row_i[j])
+      row_i[j] = s;
+  }
+}
+
+#if defined(TCHECKER_DBM_KERNELS_X86)
+
+/* AVX2 kernels: 8 bounds per vector */
+
+__attribute__((target("avx2"))) static bool avx2_is_le(tchecker::integer_t const * a, tchecker::integer_t const * b,
+                                                       std::size_t n)
+{
+  std::size_t k = 0;
+  for (; k + 8 <= n; k += 8) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(a + k));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(b + k));
+    if (!_mm256_testz_si256(_mm256_cmpgt_epi32(va, vb), _mm256_cmpgt_epi32(va, vb)))
+      return false;
+  }
+  return generic_is_le(a + k, b + k, n - k);
+}
+
+__attribute__((target("avx2"))) static void avx2_min(tchecker::integer_t * r, tchecker::integer_t const * a,
+                                                     tchecker::integer_t const * b, std::size_t n)
+{
+  std::size_t k = 0;
+  for (; k + 8 <= n; k += 8) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(a + k));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(b + k));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(r + k), _mm256_min_epi32(va, vb));
+  }
+  generic_min(r + k, a + k, b + k, n - k);
+}
+
+__attribute__((target("avx2"))) static void avx2_tighten_row(tchecker::integer_t * row_i, tchecker::integer_t const * row_k,
+                                                             tchecker::integer_t db_ik, std::size_t n,
+                                                             tchecker::integer_t inf)
+{
+  __m256i const vik = _mm256_set1_epi32(db_ik);
+  __m256i const vinf = _mm256_set1_epi32(inf);
+  __m256i const vone = _mm256_set1_epi32(1);
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    __m256i vkj = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(row_k + j));
+    __m256i vlt = _mm256_and_si256(_mm256_or_si256(vik, vkj), vone);
+    __m256i vs = _mm256_sub_epi32(_mm256_add_epi32(vik, vkj), vlt);
+    vs = _mm256_blendv_epi8(vs, vinf, _mm256_cmpeq_epi32(vkj, vinf));
+    __m256i vij = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(row_i + j));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(row_i + j), _mm256_min_epi32(vij, vs));
+  }
+  generic_tighten_row(row_i + j, row_k + j, db_ik, n - j, inf);
+}
+
+/* AVX-512 kernels: 16 bounds per vector */
+
+__attribute__((target("avx512f"))) static bool avx512_is_le(tchecker::integer_t const * a, tchecker::integer_t const * b,
+                                                            std::size_t n)
+{
+  std::size_t k = 0;
+  for (; k + 16 <= n; k += 16) {
+    __m512i va = _mm512_loadu_si512(a + k);
+    __m512i vb = _mm512_loadu_si512(b + k);
+    if (_mm512_cmpgt_epi32_mask(va, vb) != 0)
+      return false;
+  }
+  return generic_is_le(a + k, b + k, n - k);
+}
+
+__attribute__((target("avx512f"))) static void avx512_min(tchecker::integer_t * r, tchecker::integer_t const * a,
+                                                          tchecker::integer_t const * b, std::size_t n)
+{
+  std::size_t k = 0;
+  for (; k + 16 <= n; k += 16)
+    _mm512_storeu_si512(r + k, _mm512_min_epi32(_mm512_loadu_si512(a + k), _mm512_loadu_si512(b + k)));
+  generic_min(r + k, a + k, b + k, n - k);
+}
+
+__attribute__((target("avx512f"))) static void avx512_tighten_row(tchecker::integer_t * row_i,
+                                                                  tchecker::integer_t const * row_k,
+                                                                  tchecker::integer_t db_ik, std::size_t n,
+                                                                  tchecker::integer_t inf)
+{
+  __m512i const vik = _mm512_set1_epi32(db_ik);
+  __m512i const vinf = _mm512_set1_epi32(inf);
+  __m512i const vone = _mm512_set1_epi32(1);
+  std::size_t j = 0;
+  for (; j + 16 <= n; j += 16) {
+    __m512i vkj = _mm512_loadu_si512(row_k + j);
+    __m512i vlt = _mm512_and_si512(_mm512_or_si512(vik, vkj), vone);
+    __m512i vs = _mm512_sub_epi32(_mm512_add_epi32(vik, vkj), vlt);
+    vs = _mm512_mask_blend_epi32(_mm512_cmpeq_epi32_mask(vkj, vinf), vs, vinf);
+    _mm512_storeu_si512(row_i + j, _mm512_min_epi32(_mm512_loadu_si512(row_i + j), vs));
+  }
+  generic_tighten_row(row_i + j, row_k + j, db_ik, n - j, inf);
+}
+
+#endif // TCHECKER_DBM_KERNELS_X86
+
+/* Runtime selection */
+
+namespace {
+
+/*!
+ \brief Table of kernels for an instruction set
+ */
+struct table_t {
+  enum tchecker::dbm::kernels::isa_t isa;
+  bool (*is_le)(tchecker::integer_t const *, tchecker::integer_t const *, std::size_t);
+  void (*min)(tchecker::integer_t *, tchecker::integer_t const *, tchecker::integer_t const *, std::size_t);
+  void (*tighten_row)(tchecker::integer_t *, tchecker::integer_t const *, tchecker::integer_t, std::size_t,
+                      tchecker::integer_t);
+};
+
+bool generic_is_le_fn(tchecker::integer_t const * a, tchecker::integer_t const * b, std::size_t n)
+{
+  return generic_is_le(a, b, n);
+}
+
+void generic_min_fn(tchecker::integer_t * r, tchecker::integer_t const * a, tchecker::integer_t const * b, std::size_t n)
+{
+  generic_min(r, a, b, n);
+}
+
+void generic_tighten_row_fn(tchecker::integer_t * row_i, tchecker::integer_t const * row_k, tchecker::integer_t db_ik,
+                            std::size_t n, tchecker::integer_t inf)
+{
+  generic_tighten_row(row_i, row_k, db_ik, n, inf);
+}
+
+table_t select_table()
+{
+#if defined(TCHECKER_DBM_KERNELS_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    return {tchecker::dbm::kernels::ISA_AVX512, &avx512_is_le, &avx512_min, &avx512_tighten_row};
+  if (__builtin_cpu_supports("avx2"))
+    return {tchecker::dbm::kernels::ISA_AVX2, &avx2_is_le, &avx2_min, &avx2_tighten_row};
+#endif // TCHECKER_DBM_KERNELS_X86
+  return {tchecker::dbm::kernels::ISA_GENERIC, &generic_is_le_fn, &generic_min_fn, &generic_tighten_row_fn};
+}
+
+table_t const & table()
+{
+  static table_t const t = select_table();
+  return t;
+}
+
+} // end of anonymous namespace
+
+enum tchecker::dbm::kernels::isa_t isa() { return table().isa; }
+
+bool is_le(tchecker::integer_t const * a, tchecker::integer_t const * b, std::size_t n)
+{
+  return table().is_le(a, b, n);
+}
+
+void min(tchecker::integer_t * r, tchecker::integer_t const * a, tchecker::integer_t const * b, std::size_t n)
+{
+  table().min(r, a, b, n);
+}
+
+void tighten_row(tchecker::integer_t * row_i, tchecker::integer_t const * row_k, tchecker::integer_t db_ik, std::size_t n,
+                 tchecker::integer_t inf)
+{
+  assert(db_ik != inf);
+  table().tighten_row(row_i, row_k, db_ik, n, inf);
+}
+
+} // end of namespace kernels
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
@@ -2,6 +2,7 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <cstring>
 #include <limits>
 #include <vector>
 
@@ -10,6 +11,10 @@
 #include "tchecker/dbm/refdbm.hh"
 #include "tchecker/utils/ordering.hh"
 
+#if defined(TCHECKER_DBM_UNSAFE) || defined(TCHECKER_DBM_PACKED)
+#include "tchecker/dbm/details/kernels.hh"
+#endif
+
 #define DBM(i, j)       dbm[(i)*dim + (j)]
 #define RDBM(i, j)      rdbm[(i)*rdim + (j)]
 #define RDBM1(i, j)     rdbm1[(i)*rdim + (j)]
@@ -398,6 +403,44 @@ bool is_time_elapse_am_star_le(tchecker::dbm::db_t const * rdbm1, tchecker::dbm:
   return tchecker::refdbm::is_time_elapse_alu_star_le(rdbm1, rdbm2, r, m, m);
 }
 
+/*!
+ \brief Minimum of reference clock rows
+ \param rdbm : a DBM with reference clocks
+ \param rdim : dimension of rdbm
+ \param refcount : number of reference clocks in rdbm
+ \param slot : index of the scratch buffer to use (0 or 1)
+ \return a vector v of size rdim - refcount such that v[x - refcount] = min {rdbm[t,x] | t reference clock} for
+ every offset clock x
+ \note the returned vector is a per-thread scratch buffer that is overwritten by the next call with the same slot.
+ Rows are contiguous, hence the minimum is computed row-wise (vectorized for integer-encoded bounds) rather than
+ column by column
+ */
+static std::vector<tchecker::dbm::db_t> & min_ref_rows(tchecker::dbm::db_t const * rdbm, std::size_t rdim,
+                                                       std::size_t refcount, std::size_t slot)
+{
+  static thread_local std::vector<tchecker::dbm::db_t> scratch[2];
+  assert(slot < 2);
+  assert(refcount >= 1);
+
+  std::size_t const n = rdim - refcount;
+  std::vector<tchecker::dbm::db_t> & v = scratch[slot];
+  v.resize(n);
+  if (n == 0)
+    return v;
+
+  std::memcpy(v.data(), &RDBM(0, refcount), n * sizeof(tchecker::dbm::db_t));
+  for (tchecker::clock_id_t t = 1; t < refcount; ++t) {
+#if defined(TCHECKER_DBM_UNSAFE) || defined(TCHECKER_DBM_PACKED)
+    tchecker::dbm::kernels::min(v.data(), v.data(), &RDBM(t, refcount), n);
+#else
+    tchecker::dbm::db_t const * row_t = &RDBM(t, refcount);
+    for (std::size_t k = 0; k < n; ++k)
+      v[k] = tchecker::dbm::min(v[k], row_t[k]);
+#endif
+  }
+  return v;
+}
+
 bool is_sync_alu_le(tchecker::dbm::db_t const * rdbm1, tchecker::dbm::db_t const * rdbm2,
                     tchecker::reference_clock_variables_t const & r, tchecker::integer_t const * l,
                     tchecker::integer_t const * u)
@@ -431,6 +474,10 @@ bool is_sync_alu_le(tchecker::dbm::db_t const * rdbm1, tchecker::dbm::db_t const
   std::size_t const rdim = r.size();
   std::size_t const refcount = r.refcount();
 
+  // Compute min_tx1 and min_tx2 for all offset clocks x at once, row by row
+  std::vector<tchecker::dbm::db_t> & min_t1 = min_ref_rows(rdbm1, rdim, refcount, 0);
+  std::vector<tchecker::dbm::db_t> & min_t2 = min_ref_rows(rdbm2, rdim, refcount, 1);
+
   for (tchecker::clock_id_t x = refcount; x < rdim; ++x) {
     tchecker::integer_t Ux = U(x);
     assert(Ux < tchecker::dbm::INF_VALUE);
@@ -439,22 +486,14 @@ bool is_sync_alu_le(tchecker::dbm::db_t const * rdbm1, tchecker::dbm::db_t const
     if (Ux == -tchecker::dbm::INF_VALUE)
       continue;
 
-    // Compute min_tx1 = min {dbm1[t,x] | t ref clock}
-    tchecker::dbm::db_t min_tx1 = LTE_RDBM1(0, x);
-    for (tchecker::clock_id_t t = 1; t < refcount; ++t)
-      min_tx1 = tchecker::dbm::min(min_tx1, LTE_RDBM1(t, x));
+    tchecker::dbm::db_t const min_tx1 = min_t1[x - refcount];
 
     // Check 1st condition
     if (min_tx1 < tchecker::dbm::db(tchecker::LE, -Ux))
       continue;
 
-    // Compute min_tx2 = min {dbm2[t,x] | t ref clock}
-    tchecker::dbm::db_t min_tx2 = LTE_RDBM2(0, x);
-    for (tchecker::clock_id_t t = 1; t < refcount; ++t)
-      min_tx2 = tchecker::dbm::min(min_tx2, LTE_RDBM2(t, x));
-
     // Check 2nd condition (of first case above)
-    if (min_tx2 < min_tx1)
+    if (min_t2[x - refcount] < min_tx1)
       return false;
 
     for (tchecker::clock_id_t y = refcount; y < rdim; ++y) {
@@ -469,8 +508,7 @@ bool is_sync_alu_le(tchecker::dbm::db_t const * rdbm1, tchecker::dbm::db_t const
         continue;
 
       // Check 2nd and 3rd conditions (of second case above)
-      if (LTE_RDBM2(y, x) < LTE_RDBM1(y, x) &&
-          tchecker::dbm::sum(LTE_RDBM2(y, x), tchecker::dbm::db(tchecker::LT, -Ly)) < min_tx1)
+      if (RDBM2(y, x) < RDBM1(y, x) && tchecker::dbm::sum(RDBM2(y, x), tchecker::dbm::db(tchecker::LT, -Ly)) < min_tx1)
         return false;
     }
   }
@@ -580,23 +618,8 @@ enum tchecker::dbm::status_t bound_spread(tchecker::dbm::db_t * rdbm, tchecker::
   // Optimized tightening: Floyd-Warshall algorithm w.r.t. reference clocks in ref_clocks
   for (auto t = ref_clocks.find_first(); t != ref_clocks.npos; t = ref_clocks.find_next(t)) {
     assert(t < r.refcount());
-
-    for (tchecker::clock_id_t x = 0; x < rdim; ++x) {
-      if (x == t || RDBM(x, t) == tchecker::dbm::LT_INFINITY)
-        continue; // optimization
-
-      for (tchecker::clock_id_t y = 0; y < rdim; ++y) {
-        if (y == t || RDBM(t, y) == tchecker::dbm::LT_INFINITY)
-          continue; // optimization
-
-        RDBM(x, y) = tchecker::dbm::min(tchecker::dbm::sum(RDBM(x, t), RDBM(t, y)), RDBM(x, y));
-      }
-
-      if (RDBM(x, x) < tchecker::dbm::LE_ZERO) {
-        RDBM(0, 0) = tchecker::dbm::LT_ZERO;
-        return tchecker::dbm::EMPTY;
-      }
-    }
+    if (tchecker::dbm::tighten_pivot(rdbm, rdim, t) == tchecker::dbm::EMPTY)
+      return tchecker::dbm::EMPTY;
   }
 
   assert(tchecker::refdbm::is_consistent(rdbm, r));
@@ -621,10 +644,9 @@ void reset_to_reference_clock(tchecker::dbm::db_t * rdbm, tchecker::reference_cl
     return;
 
   // x is identified to r(x) w.r.t. all clocks z
-  for (tchecker::clock_id_t z = 0; z < rdim; ++z) {
-    RDBM(x, z) = RDBM(tx, z);
+  std::memcpy(&RDBM(x, 0), &RDBM(tx, 0), rdim * sizeof(tchecker::dbm::db_t));
+  for (tchecker::clock_id_t z = 0; z < rdim; ++z)
     RDBM(z, x) = RDBM(z, tx);
-  }
   RDBM(x, x) = tchecker::dbm::LE_ZERO; // cheaper than testing in loop
 
   assert(tchecker::refdbm::is_consistent(rdbm, r));
@@ -0,0 +1,356 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+#include "tchecker/graph/binary.hh"
+#include "tchecker/graph/output.hh"
+#include "tchecker/utils/string.hh"
+
+namespace tchecker {
+
+namespace graph {
+
+/*!
+ \brief Byte-order mark of binary graph files
+ */
+static std::uint32_t const BYTE_ORDER_MARK = 0x01020304;
+
+/*!
+ \brief Size of the header of binary graph files in bytes
+ */
+static std::size_t const HEADER_SIZE = 64;
+
+/*!
+ \brief Write a table
+ \param os : output stream
+ \param table : a table
+ \post the entries of table have been written to os
+ */
+template <class T> static void write_table(std::ostream & os, std::vector<T> const & table)
+{
+  os.write(reinterpret_cast<char const *>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(T)));
+}
+
+/* binary_graph_writer_t */
+
+binary_graph_writer_t::binary_graph_writer_t(std::string const & name)
+    : _node_attributes_offsets{0}, _edge_attributes_offsets{0}
+{
+  string_index(name); // string 0
+}
+
+std::uint64_t binary_graph_writer_t::add_node(std::map<std::string, std::string> const & attr)
+{
+  add_attributes(attr, _node_attributes);
+  _node_attributes_offsets.push_back(_node_attributes.size() / 2);
+  return _node_attributes_offsets.size() - 2;
+}
+
+void binary_graph_writer_t::add_edge(std::uint64_t src, std::uint64_t tgt, std::map<std::string, std::string> const & attr)
+{
+  std::uint64_t const nodes_count = _node_attributes_offsets.size() - 1;
+  if (src >= nodes_count || tgt >= nodes_count)
+    throw std::invalid_argument("tchecker::graph::binary_graph_writer_t: unknown node");
+  if (src + 1 < _edge_offsets.size())
+    throw std::invalid_argument("tchecker::graph::binary_graph_writer_t: edges should be added by increasing source");
+
+  while (_edge_offsets.size() <= src)
+    _edge_offsets.push_back(_edge_targets.size());
+  _edge_targets.push_back(tgt);
+  add_attributes(attr, _edge_attributes);
+  _edge_attributes_offsets.push_back(_edge_attributes.size() / 2);
+}
+
+void binary_graph_writer_t::write(std::ostream & os) const
+{
+  std::uint64_t const nodes_count = _node_attributes_offsets.size() - 1;
+
+  std::vector<std::uint64_t> string_offsets;
+  string_offsets.reserve(_strings.size() + 1);
+  std::uint64_t offset = 0;
+  for (std::string const * s : _strings) {
+    string_offsets.push_back(offset);
+    offset += s->size();
+  }
+  string_offsets.push_back(offset);
+
+  std::vector<std::uint64_t> edge_offsets{_edge_offsets};
+  edge_offsets.resize(nodes_count + 1, _edge_targets.size());
+
+  std::uint32_t const prefix[4] = {0, tchecker::graph::BINARY_GRAPH_VERSION, tchecker::graph::BYTE_ORDER_MARK, 0};
+  std::uint64_t const counts[6] = {_strings.size(),         offset,
+                                   nodes_count,             _node_attributes.size() / 2,
+                                   _edge_targets.size(),    _edge_attributes.size() / 2};
+  static_assert(sizeof(prefix) + sizeof(counts) == tchecker::graph::HEADER_SIZE, "unexpected header size");
+
+  os.write(tchecker::graph::BINARY_GRAPH_MAGIC, sizeof(tchecker::graph::BINARY_GRAPH_MAGIC));
+  os.write(reinterpret_cast<char const *>(prefix + 1), sizeof(prefix) - sizeof(prefix[0]));
+  os.write(reinterpret_cast<char const *>(counts), sizeof(counts));
+  tchecker::graph::write_table(os, string_offsets);
+  tchecker::graph::write_table(os, _node_attributes_offsets);
+  tchecker::graph::write_table(os, edge_offsets);
+  tchecker::graph::write_table(os, _edge_targets);
+  tchecker::graph::write_table(os, _edge_attributes_offsets);
+  tchecker::graph::write_table(os, _node_attributes);
+  tchecker::graph::write_table(os, _edge_attributes);
+  for (std::string const * s : _strings)
+    os.write(s->data(), static_cast<std::streamsize>(s->size()));
+
+  if (!os)
+    throw std::runtime_error("tchecker::graph::binary_graph_writer_t: write error");
+}
+
+std::uint32_t binary_graph_writer_t::string_index(std::string const & s)
+{
+  auto it = _strings_index.find(s);
+  if (it != _strings_index.end())
+    return it->second;
+  if (_strings.size() == std::numeric_limits<std::uint32_t>::max())
+    throw std::overflow_error("tchecker::graph::binary_graph_writer_t: too many strings");
+  auto && [inserted_it, inserted] = _strings_index.emplace(s, static_cast<std::uint32_t>(_strings.size()));
+  assert(inserted);
+  _strings.push_back(&inserted_it->first);
+  return inserted_it->second;
+}
+
+void binary_graph_writer_t::add_attributes(std::map<std::string, std::string> const & attr,
+                                           std::vector<std::uint32_t> & pairs)
+{
+  for (auto && [key, value] : attr) {
+    pairs.push_back(string_index(key));
+    pairs.push_back(string_index(value));
+  }
+}
+
+/* binary_graph_t */
+
+/*!
+ \brief Check a table of offsets
+ \param table : table of 64-bit offsets
+ \param size : number of offsets
+ \param last : expected last offset
+ \return true if the offsets in table are non-decreasing from 0 to last, false otherwise
+ */
+static bool valid_offsets(char const * table, std::uint64_t size, std::uint64_t last)
+{
+  std::uint64_t previous = 0;
+  for (std::uint64_t i = 0; i < size; ++i) {
+    std::uint64_t offset;
+    std::memcpy(&offset, table + i * sizeof(offset), sizeof(offset));
+    if ((i == 0 && offset != 0) || offset < previous)
+      return false;
+    previous = offset;
+  }
+  return previous == last;
+}
+
+binary_graph_t::binary_graph_t(std::string const & filename) : _file(std::make_unique<tchecker::mapped_file_t>(filename))
+{
+  auto invalid = [&](std::string const & reason) {
+    return std::runtime_error(filename + " is not a valid binary graph: " + reason);
+  };
+
+  char const * p = _file->begin();
+  std::size_t const size = _file->size();
+
+  if (size < tchecker::graph::HEADER_SIZE ||
+      std::memcmp(p, tchecker::graph::BINARY_GRAPH_MAGIC, sizeof(tchecker::graph::BINARY_GRAPH_MAGIC)) != 0)
+    throw invalid("missing header");
+
+  std::uint32_t prefix[3];
+  std::memcpy(prefix, p + sizeof(tchecker::graph::BINARY_GRAPH_MAGIC), sizeof(prefix));
+  if (prefix[0] != tchecker::graph::BINARY_GRAPH_VERSION)
+    throw invalid("unsupported version " + std::to_string(prefix[0]));
+  if (prefix[1] != tchecker::graph::BYTE_ORDER_MARK)
+    throw invalid("other byte order");
+
+  std::uint64_t counts[6];
+  std::memcpy(counts, p + 16, sizeof(counts));
+  _strings_count = counts[0];
+  std::uint64_t const strings_size = counts[1];
+  _nodes_count = counts[2];
+  std::uint64_t const node_attributes_count = counts[3];
+  _edges_count = counts[4];
+  std::uint64_t const edge_attributes_count = counts[5];
+
+  for (std::uint64_t count : counts)
+    if (count > size)
+      throw invalid("truncated file");
+  if (_strings_count == 0)
+    throw invalid("missing graph name");
+
+  std::uint64_t const expected_size = tchecker::graph::HEADER_SIZE +
+                                      8 * ((_strings_count + 1) + 2 * (_nodes_count + 1) + _edges_count + (_edges_count + 1)) +
+                                      8 * (node_attributes_count + edge_attributes_count) + strings_size;
+  if (expected_size != size)
+    throw invalid("unexpected size");
+
+  _string_offsets = p + tchecker::graph::HEADER_SIZE;
+  _node_attributes_offsets = _string_offsets + 8 * (_strings_count + 1);
+  _edge_offsets = _node_attributes_offsets + 8 * (_nodes_count + 1);
+  _edge_targets = _edge_offsets + 8 * (_nodes_count + 1);
+  _edge_attributes_offsets = _edge_targets + 8 * _edges_count;
+  _node_attributes = _edge_attributes_offsets + 8 * (_edges_count + 1);
+  _edge_attributes = _node_attributes + 8 * node_attributes_count;
+  _strings = _edge_attributes + 8 * edge_attributes_count;
+
+  if (!tchecker::graph::valid_offsets(_string_offsets, _strings_count + 1, strings_size) ||
+      !tchecker::graph::valid_offsets(_node_attributes_offsets, _nodes_count + 1, node_attributes_count) ||
+      !tchecker::graph::valid_offsets(_edge_offsets, _nodes_count + 1, _edges_count) ||
+      !tchecker::graph::valid_offsets(_edge_attributes_offsets, _edges_count + 1, edge_attributes_count))
+    throw invalid("invalid table of offsets");
+
+  for (std::uint64_t e = 0; e < _edges_count; ++e)
+    if (u64(_edge_targets, e) >= _nodes_count)
+      throw invalid("invalid edge target");
+
+  for (char const * pairs : {_node_attributes, _edge_attributes}) {
+    std::uint64_t const n = 2 * (pairs == _node_attributes ? node_attributes_count : edge_attributes_count);
+    for (std::uint64_t i = 0; i < n; ++i) {
+      std::uint32_t index;
+      std::memcpy(&index, pairs + 4 * i, sizeof(index));
+      if (index >= _strings_count)
+        throw invalid("invalid string index");
+    }
+  }
+}
+
+std::string_view binary_graph_t::name() const { return string(0); }
+
+void binary_graph_t::attributes(std::uint64_t n, std::map<std::string, std::string> & m) const
+{
+  assert(n < _nodes_count);
+  attributes(_node_attributes, u64(_node_attributes_offsets, n), u64(_node_attributes_offsets, n + 1), m);
+}
+
+std::uint64_t binary_graph_t::outgoing_edges_begin(std::uint64_t n) const
+{
+  assert(n < _nodes_count);
+  return u64(_edge_offsets, n);
+}
+
+std::uint64_t binary_graph_t::outgoing_edges_end(std::uint64_t n) const
+{
+  assert(n < _nodes_count);
+  return u64(_edge_offsets, n + 1);
+}
+
+std::uint64_t binary_graph_t::edge_tgt(std::uint64_t e) const
+{
+  assert(e < _edges_count);
+  return u64(_edge_targets, e);
+}
+
+void binary_graph_t::edge_attributes(std::uint64_t e, std::map<std::string, std::string> & m) const
+{
+  assert(e < _edges_count);
+  attributes(_edge_attributes, u64(_edge_attributes_offsets, e), u64(_edge_attributes_offsets, e + 1), m);
+}
+
+std::string_view binary_graph_t::string(std::uint32_t i) const
+{
+  assert(i < _strings_count);
+  std::uint64_t const begin = u64(_string_offsets, i);
+  return std::string_view{_strings + begin, static_cast<std::size_t>(u64(_string_offsets, i + 1) - begin)};
+}
+
+std::uint64_t binary_graph_t::u64(char const * table, std::uint64_t i)
+{
+  std::uint64_t value;
+  std::memcpy(&value, table + i * sizeof(value), sizeof(value));
+  return value;
+}
+
+void binary_graph_t::attributes(char const * pairs, std::uint64_t begin, std::uint64_t end,
+                                std::map<std::string, std::string> & m) const
+{
+  for (std::uint64_t i = begin; i < end; ++i) {
+    std::uint32_t pair[2];
+    std::memcpy(pair, pairs + 8 * i, sizeof(pair));
+    m.insert_or_assign(std::string{string(pair[0])}, std::string{string(pair[1])});
+  }
+}
+
+/* output */
+
+std::ostream & dot_output(std::ostream & os, tchecker::graph::binary_graph_t const & g)
+{
+  std::map<std::string, std::string> attr;
+
+  tchecker::graph::dot_output_header(os, std::string{g.name()});
+
+  for (std::uint64_t n = 0; n < g.nodes_count(); ++n) {
+    attr.clear();
+    g.attributes(n, attr);
+    tchecker::graph::dot_output_node(os, std::to_string(n), attr);
+  }
+
+  for (std::uint64_t n = 0; n < g.nodes_count(); ++n)
+    for (std::uint64_t e = g.outgoing_edges_begin(n); e < g.outgoing_edges_end(n); ++e) {
+      attr.clear();
+      g.edge_attributes(e, attr);
+      tchecker::graph::dot_output_edge(os, std::to_string(n), std::to_string(g.edge_tgt(e)), attr);
+    }
+
+  return tchecker::graph::dot_output_footer(os);
+}
+
+/*!
+ \brief Output attributes as a JSON object
+ \param os : output stream
+ \param attr : attributes
+ \post attr has been output to os as a JSON object
+ */
+static void json_output_attributes(std::ostream & os, std::map<std::string, std::string> const & attr)
+{
+  os << "{";
+  bool first = true;
+  for (auto && [key, value] : attr) {
+    if (!first)
+      os << ",";
+    first = false;
+    tchecker::output_json_string(os, key);
+    os << ":";
+    tchecker::output_json_string(os, value);
+  }
+  os << "}";
+}
+
+std::ostream & json_output(std::ostream & os, tchecker::graph::binary_graph_t const & g)
+{
+  std::map<std::string, std::string> attr;
+
+  os << "{\"name\":";
+  tchecker::output_json_string(os, std::string{g.name()});
+
+  os << ",\"nodes\":[";
+  for (std::uint64_t n = 0; n < g.nodes_count(); ++n) {
+    attr.clear();
+    g.attributes(n, attr);
+    os << (n == 0 ? "" : ",") << std::endl << "{\"id\":" << n << ",\"attributes\":";
+    tchecker::graph::json_output_attributes(os, attr);
+    os << "}";
+  }
+
+  os << "]," << std::endl << "\"edges\":[";
+  bool first = true;
+  for (std::uint64_t n = 0; n < g.nodes_count(); ++n)
+    for (std::uint64_t e = g.outgoing_edges_begin(n); e < g.outgoing_edges_end(n); ++e) {
+      attr.clear();
+      g.edge_attributes(e, attr);
+      os << (first ? "" : ",") << std::endl << "{\"src\":" << n << ",\"tgt\":" << g.edge_tgt(e) << ",\"attributes\":";
+      tchecker::graph::json_output_attributes(os, attr);
+      os << "}";
+      first = false;
+    }
+
+  return os << "]}" << std::endl;
+}
+
+} // end of namespace graph
+
+} // end of namespace tchecker
@@ -0,0 +1,47 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <stdexcept>
+
+#include "tchecker/graph/compact_adjacency.hh"
+
+namespace tchecker {
+
+namespace graph {
+
+compact_adjacency_t::compact_adjacency_t() : _offsets{0} {}
+
+void compact_adjacency_t::build(std::size_t nodes_count, std::vector<arc_t> const & arcs)
+{
+  for (auto && [n, m] : arcs)
+    if ((n >= nodes_count) || (m >= nodes_count))
+      throw std::invalid_argument("compact_adjacency_t::build: arc out of bounds");
+
+  // counting sort of arcs by node, stable w.r.t. the order of arcs
+  _offsets.assign(nodes_count + 1, 0);
+  for (auto && [n, m] : arcs)
+    ++_offsets[n + 1];
+  for (std::size_t i = 0; i < nodes_count; ++i)
+    _offsets[i + 1] += _offsets[i];
+
+  _neighbours.resize(arcs.size());
+  std::vector<std::size_t> next(_offsets.begin(), _offsets.end() - 1);
+  for (auto && [n, m] : arcs)
+    _neighbours[next[n]++] = m;
+}
+
+void compact_adjacency_t::clear()
+{
+  _offsets.assign(1, 0);
+  _neighbours.clear();
+}
+
+std::size_t compact_adjacency_t::memsize() const
+{
+  return sizeof(*this) + _offsets.capacity() * sizeof(std::size_t) + _neighbours.capacity() * sizeof(index_t);
+}
+
+} // end of namespace graph
+
+} // end of namespace tchecker
@@ -12,7 +12,11 @@ edge_vedge_t::edge_vedge_t(tchecker::vedge_sptr_t const & vedge) : _vedge(vedge)
 
 edge_vedge_t::edge_vedge_t(tchecker::const_vedge_sptr_t const & vedge) : _vedge(vedge) {}
 
-edge_rel_transition::edge_rel_transition (zg_ha::transition_t const & transition) : _transition(transition) {}
+edge_guard_variables_t::edge_guard_variables_t(tchecker::zg_ha::transition_t const & transition,
+                                               tchecker::graph::guard_variables_table_t & table)
+    : _guard_variables(table.intern(transition.guard_container(), transition.intvar_guard_container()))
+{
+}
 
 } // namespace graph
 
@@ -0,0 +1,81 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#if BOOST_VERSION <= 106600
+#include <boost/functional/hash.hpp>
+#else
+#include <boost/container_hash/hash.hpp>
+#endif
+
+#include "tchecker/graph/guard_variables.hh"
+
+namespace tchecker {
+
+namespace graph {
+
+/*!
+ \brief Sort and remove duplicates
+ \param v : a vector
+ \post v is sorted and has no duplicates
+ */
+template <class T> static void sort_unique(std::vector<T> & v)
+{
+  std::sort(v.begin(), v.end());
+  v.erase(std::unique(v.begin(), v.end()), v.end());
+}
+
+/* guard_variables_t */
+
+guard_variables_t::guard_variables_t(tchecker::clock_constraint_container_t const & guard,
+                                     tchecker::intvar_guard_container_t const & intvar_guard)
+{
+  _clocks.reserve(guard.size());
+  for (tchecker::clock_constraint_t const & c : guard)
+    _clocks.push_back(c.id1() != tchecker::REFCLOCK_ID ? c.id1() : c.id2());
+  tchecker::graph::sort_unique(_clocks);
+
+  _intvars.assign(intvar_guard.begin(), intvar_guard.end());
+  tchecker::graph::sort_unique(_intvars);
+}
+
+bool guard_variables_t::operator==(tchecker::graph::guard_variables_t const & g) const
+{
+  return (_clocks == g._clocks) && (_intvars == g._intvars);
+}
+
+std::size_t guard_variables_t::hash() const
+{
+  std::size_t h = boost::hash_range(_clocks.begin(), _clocks.end());
+  boost::hash_combine(h, _clocks.size());
+  boost::hash_range(h, _intvars.begin(), _intvars.end());
+  return h;
+}
+
+/* guard_variables_table_t */
+
+tchecker::graph::guard_variables_table_t::index_t
+guard_variables_table_t::intern(tchecker::clock_constraint_container_t const & guard,
+                                tchecker::intvar_guard_container_t const & intvar_guard)
+{
+  tchecker::graph::guard_variables_t key{guard, intvar_guard};
+  auto it = _index.find(key);
+  if (it != _index.end())
+    return it->second;
+
+  if (_entries.size() > std::numeric_limits<index_t>::max())
+    throw std::overflow_error("Too many guard variables for index type");
+
+  index_t const i = static_cast<index_t>(_entries.size());
+  auto inserted = _index.emplace(std::move(key), i).first;
+  _entries.push_back(&inserted->first);
+  return i;
+}
+
+} // end of namespace graph
+
+} // end of namespace tchecker
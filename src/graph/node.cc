@@ -8,6 +8,8 @@
 #include <boost/container_hash/hash.hpp>
 #endif
 
+#include <cassert>
+
 #include "tchecker/graph/node.hh"
 
 namespace tchecker {
@@ -81,7 +83,15 @@ node_refzg_state_t::node_refzg_state_t(tchecker::refzg::state_sptr_t const & s)
 
 node_refzg_state_t::node_refzg_state_t(tchecker::refzg::const_state_sptr_t const & s) : _state(s) {}
 
-node_reset_history::node_reset_history(const boost::dynamic_bitset<> rhv) : _reset_history_vector(rhv) {}
+/* node_reset_history */
+
+node_reset_history::node_reset_history(tchecker::graph::reset_history_sptr_t const & rhv) : _reset_history_vector(rhv)
+{
+  assert(_reset_history_vector != nullptr);
+}
+
+/* node_reachability */
+
 node_reachability::node_reachability(bool status) : _is_reachable(status) {}
 } // namespace graph
 
@@ -0,0 +1,51 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#if BOOST_VERSION <= 106600
+#include <boost/functional/hash.hpp>
+#else
+#include <boost/container_hash/hash.hpp>
+#endif
+
+#include "tchecker/graph/reset_history.hh"
+
+namespace tchecker {
+
+namespace graph {
+
+/* reset_history_table_t */
+
+tchecker::graph::reset_history_sptr_t reset_history_table_t::share(tchecker::graph::reset_history_t && h)
+{
+  // the key does not own h: no allocation unless h is added to the table
+  tchecker::graph::reset_history_sptr_t key{tchecker::graph::reset_history_sptr_t{}, &h};
+  auto it = _table.find(key);
+  if (it != _table.end())
+    return *it;
+  return *_table.insert(std::make_shared<tchecker::graph::reset_history_t const>(std::move(h))).first;
+}
+
+tchecker::graph::reset_history_sptr_t reset_history_table_t::share(tchecker::graph::reset_history_t const & h)
+{
+  tchecker::graph::reset_history_sptr_t key{tchecker::graph::reset_history_sptr_t{}, &h};
+  auto it = _table.find(key);
+  if (it != _table.end())
+    return *it;
+  return *_table.insert(std::make_shared<tchecker::graph::reset_history_t const>(h)).first;
+}
+
+std::size_t reset_history_table_t::hash_t::operator()(tchecker::graph::reset_history_sptr_t const & h) const
+{
+  return boost::hash_value(*h);
+}
+
+bool reset_history_table_t::equal_to_t::operator()(tchecker::graph::reset_history_sptr_t const & h1,
+                                                   tchecker::graph::reset_history_sptr_t const & h2) const
+{
+  return *h1 == *h2;
+}
+
+} // end of namespace graph
+
+} // end of namespace tchecker
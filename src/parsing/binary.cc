@@ -0,0 +1,504 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "tchecker/parsing/binary.hh"
+#include "tchecker/utils/mapped_file.hh"
+
+namespace tchecker {
+
+namespace parsing {
+
+namespace details {
+
+/*!
+ \brief Kinds of records of inner declarations
+ */
+enum record_t : std::uint8_t {
+  RECORD_CLOCK = 1, /*!< Clock declaration */
+  RECORD_INT,       /*!< Bounded integer declaration */
+  RECORD_PROCESS,   /*!< Process declaration */
+  RECORD_EVENT,     /*!< Event declaration */
+  RECORD_LOCATION,  /*!< Location declaration */
+  RECORD_EDGE,      /*!< Edge declaration */
+  RECORD_SYNC,      /*!< Synchronization declaration */
+};
+
+/*!
+ \brief Byte-order mark, read back as another value on a machine with another byte order
+ */
+constexpr std::uint32_t const BYTE_ORDER_MARK = 0x01020304;
+
+/*!
+ \class binary_writer_t
+ \brief Visitor that writes a system declaration in binary format
+ */
+class binary_writer_t : public tchecker::parsing::declaration_visitor_t {
+public:
+  /*!
+   \brief Constructor
+   \param os : output stream
+   */
+  binary_writer_t(std::ostream & os) : _os(os) {}
+
+  /*!
+   \brief Write a system declaration
+   \param d : system declaration
+   \post the header of the binary format, d and its inner declarations have been written to the output stream
+   */
+  virtual void visit(tchecker::parsing::system_declaration_t const & d)
+  {
+    _os.write(tchecker::parsing::BINARY_MAGIC, sizeof(tchecker::parsing::BINARY_MAGIC));
+    write<std::uint32_t>(tchecker::parsing::BINARY_VERSION);
+    write<std::uint32_t>(BYTE_ORDER_MARK);
+
+    write_string(d.name());
+    write_attributes(d.attributes());
+    write_string(d.context());
+
+    auto declarations = d.declarations();
+    write_size(std::distance(declarations.begin(), declarations.end()));
+    for (tchecker::parsing::inner_declaration_t const * decl : declarations) {
+      decl->visit(*this);
+      _indices.insert({decl, static_cast<std::uint32_t>(_indices.size())});
+    }
+  }
+
+  virtual void visit(tchecker::parsing::clock_declaration_t const & d)
+  {
+    write<std::uint8_t>(RECORD_CLOCK);
+    write_string(d.name());
+    write<std::uint32_t>(d.size());
+    write_attributes(d.attributes());
+    write_string(d.context());
+  }
+
+  virtual void visit(tchecker::parsing::int_declaration_t const & d)
+  {
+    write<std::uint8_t>(RECORD_INT);
+    write_string(d.name());
+    write<std::uint32_t>(d.size());
+    write<std::int64_t>(d.min());
+    write<std::int64_t>(d.max());
+    write<std::int64_t>(d.init());
+    write_attributes(d.attributes());
+    write_string(d.context());
+  }
+
+  virtual void visit(tchecker::parsing::process_declaration_t const & d)
+  {
+    write<std::uint8_t>(RECORD_PROCESS);
+    write_string(d.name());
+    write_attributes(d.attributes());
+    write_string(d.context());
+  }
+
+  virtual void visit(tchecker::parsing::event_declaration_t const & d)
+  {
+    write<std::uint8_t>(RECORD_EVENT);
+    write_string(d.name());
+    write_attributes(d.attributes());
+    write_string(d.context());
+  }
+
+  virtual void visit(tchecker::parsing::location_declaration_t const & d)
+  {
+    write<std::uint8_t>(RECORD_LOCATION);
+    write_index(d.process());
+    write_string(d.name());
+    write_attributes(d.attributes());
+    write_string(d.context());
+  }
+
+  virtual void visit(tchecker::parsing::edge_declaration_t const & d)
+  {
+    write<std::uint8_t>(RECORD_EDGE);
+    write_index(d.process());
+    write_index(d.src());
+    write_index(d.tgt());
+    write_index(d.event());
+    write_attributes(d.attributes());
+    write_string(d.context());
+  }
+
+  virtual void visit(tchecker::parsing::sync_declaration_t const & d)
+  {
+    write<std::uint8_t>(RECORD_SYNC);
+    auto constraints = d.sync_constraints();
+    write_size(std::distance(constraints.begin(), constraints.end()));
+    for (tchecker::parsing::sync_constraint_t const * c : constraints) {
+      write_index(c->process());
+      write_index(c->event());
+      write<std::uint8_t>(c->strength());
+    }
+    write_attributes(d.attributes());
+    write_string(d.context());
+  }
+
+private:
+  /*!
+   \brief Write a value
+   \param value : a value
+   \post the bytes of value have been written to the output stream
+   */
+  template <class T> void write(T value) { _os.write(reinterpret_cast<char const *>(&value), sizeof(T)); }
+
+  /*!
+   \brief Write a size
+   \param size : a size
+   \post size has been written to the output stream
+   \throw std::runtime_error : if size does not fit in 32 bits
+   */
+  void write_size(std::size_t size)
+  {
+    if (size > std::numeric_limits<std::uint32_t>::max())
+      throw std::runtime_error("System declaration is too large for binary format");
+    write<std::uint32_t>(static_cast<std::uint32_t>(size));
+  }
+
+  /*!
+   \brief Write a string
+   \param s : a string
+   \post the length of s and its characters have been written to the output stream
+   */
+  void write_string(std::string const & s)
+  {
+    write_size(s.size());
+    _os.write(s.data(), s.size());
+  }
+
+  /*!
+   \brief Write attributes
+   \param attributes : attributes
+   \post the number of attributes, and the key, value and parsing positions of each attribute have been written to
+   the output stream
+   */
+  void write_attributes(tchecker::parsing::attributes_t const & attributes)
+  {
+    write_size(attributes.size());
+    for (tchecker::parsing::attr_t const & attr : attributes.attributes()) {
+      write_string(attr.key());
+      write_string(attr.value());
+      write_string(attr.parsing_position().key_position());
+      write_string(attr.parsing_position().value_position());
+    }
+  }
+
+  /*!
+   \brief Write a reference to a declaration
+   \param d : a declaration
+   \pre d has been written before
+   \post the index of d has been written to the output stream
+   \throw std::runtime_error : if d has not been written before
+   */
+  void write_index(tchecker::parsing::inner_declaration_t const & d)
+  {
+    auto it = _indices.find(&d);
+    if (it == _indices.end())
+      throw std::runtime_error("Declaration refers to a declaration that comes after it");
+    write<std::uint32_t>(it->second);
+  }
+
+  std::ostream & _os;                                                                          /*!< Output stream */
+  std::unordered_map<tchecker::parsing::inner_declaration_t const *, std::uint32_t> _indices; /*!< Written declarations */
+};
+
+/*!
+ \class binary_reader_t
+ \brief Reader of values in a memory area
+ */
+class binary_reader_t {
+public:
+  /*!
+   \brief Constructor
+   \param begin : first byte
+   \param end : past-the-end byte
+   */
+  binary_reader_t(char const * begin, char const * end) : _p(begin), _end(end) {}
+
+  /*!
+   \brief Read a value
+   \return the value at the current position
+   \post the current position has moved past the value
+   \throw std::runtime_error : if the memory area is too short
+   */
+  template <class T> T read()
+  {
+    check(sizeof(T));
+    T value;
+    std::memcpy(&value, _p, sizeof(T));
+    _p += sizeof(T);
+    return value;
+  }
+
+  /*!
+   \brief Read a string
+   \return the string at the current position
+   \post the current position has moved past the string
+   \throw std::runtime_error : if the memory area is too short
+   */
+  std::string read_string()
+  {
+    std::uint32_t const size = read<std::uint32_t>();
+    check(size);
+    std::string s{_p, size};
+    _p += size;
+    return s;
+  }
+
+  /*!
+   \brief Read attributes
+   \return the attributes at the current position
+   \post the current position has moved past the attributes
+   \throw std::runtime_error : if the memory area is too short
+   */
+  tchecker::parsing::attributes_t read_attributes()
+  {
+    tchecker::parsing::attributes_t attributes;
+    std::uint32_t const size = read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < size; ++i) {
+      std::string key = read_string();
+      std::string value = read_string();
+      std::string key_position = read_string();
+      std::string value_position = read_string();
+      attributes.insert(new tchecker::parsing::attr_t{
+          key, value, tchecker::parsing::attr_parsing_position_t{key_position, value_position}});
+    }
+    return attributes;
+  }
+
+  /*!
+   \brief Accessor
+   \return true if the whole memory area has been read, false otherwise
+   */
+  inline bool at_end() const { return _p == _end; }
+
+private:
+  /*!
+   \brief Check the remaining size
+   \param size : a size
+   \throw std::runtime_error : if less than size bytes remain
+   */
+  void check(std::size_t size) const
+  {
+    if (static_cast<std::size_t>(_end - _p) < size)
+      throw std::runtime_error("unexpected end of file");
+  }
+
+  char const * _p;         /*!< Current position */
+  char const * const _end; /*!< End of memory area */
+};
+
+/*!
+ \brief Access a declaration by index
+ \param declarations : declarations
+ \param index : index of a declaration
+ \return the declaration of type D at index in declarations
+ \throw std::runtime_error : if index is out of range or if the declaration at index is not of type D
+ */
+template <class D>
+D const & declaration(std::vector<tchecker::parsing::inner_declaration_t const *> const & declarations, std::uint32_t index)
+{
+  D const * d = (index < declarations.size() ? dynamic_cast<D const *>(declarations[index]) : nullptr);
+  if (d == nullptr)
+    throw std::runtime_error("invalid reference to a declaration");
+  return *d;
+}
+
+/*!
+ \brief Convert a bounded integer
+ \param value : value of a bounded integer
+ \return value as a tchecker::integer_t
+ \throw std::runtime_error : if value does not fit in tchecker::integer_t
+ */
+static tchecker::integer_t to_integer(std::int64_t value)
+{
+  if (value < std::numeric_limits<tchecker::integer_t>::min() || value > std::numeric_limits<tchecker::integer_t>::max())
+    throw std::runtime_error("integer value out of range");
+  return static_cast<tchecker::integer_t>(value);
+}
+
+/*!
+ \brief Add a declaration inserted in a system declaration
+ \param inserted : result of the insertion
+ \param d : a declaration
+ \param declarations : declarations read so far
+ \post d has been added to declarations if inserted is true
+ \throw std::runtime_error : if inserted is false (d redeclares a name)
+ \note d is owned by the system declaration if inserted is true, it is deleted otherwise
+ */
+template <class D>
+void add_declaration(bool inserted, std::unique_ptr<D> & d, std::vector<tchecker::parsing::inner_declaration_t const *> & declarations)
+{
+  if (!inserted)
+    throw std::runtime_error("multiple declarations of the same name");
+  declarations.push_back(d.release());
+}
+
+/*!
+ \brief Read a system declaration
+ \param reader : binary reader
+ \return the system declaration read from reader
+ \throw std::runtime_error : if reader does not contain a valid system declaration in binary format
+ */
+static tchecker::parsing::system_declaration_t * read_system_declaration(binary_reader_t & reader)
+{
+  for (char c : tchecker::parsing::BINARY_MAGIC)
+    if (reader.read<char>() != c)
+      throw std::runtime_error("not a binary system file");
+  if (reader.read<std::uint32_t>() != tchecker::parsing::BINARY_VERSION)
+    throw std::runtime_error("unsupported version of the binary format, the model should be compiled again");
+  if (reader.read<std::uint32_t>() != BYTE_ORDER_MARK)
+    throw std::runtime_error("file compiled on a machine with another byte order");
+
+  std::string system_name = reader.read_string();
+  tchecker::parsing::attributes_t system_attributes = reader.read_attributes();
+  std::string system_context = reader.read_string();
+  std::unique_ptr<tchecker::parsing::system_declaration_t> sysdecl{
+      new tchecker::parsing::system_declaration_t{system_name, std::move(system_attributes), system_context}};
+
+  std::vector<tchecker::parsing::inner_declaration_t const *> declarations;
+  std::uint32_t const count = reader.read<std::uint32_t>();
+  declarations.reserve(count);
+
+  for (std::uint32_t i = 0; i < count; ++i) {
+    switch (reader.read<std::uint8_t>()) {
+    case RECORD_CLOCK: {
+      std::string name = reader.read_string();
+      std::uint32_t const size = reader.read<std::uint32_t>();
+      tchecker::parsing::attributes_t attributes = reader.read_attributes();
+      std::unique_ptr<tchecker::parsing::clock_declaration_t> d{
+          new tchecker::parsing::clock_declaration_t{name, size, std::move(attributes), reader.read_string()}};
+      add_declaration(sysdecl->insert_clock_declaration(d.get()), d, declarations);
+      break;
+    }
+    case RECORD_INT: {
+      std::string name = reader.read_string();
+      std::uint32_t const size = reader.read<std::uint32_t>();
+      tchecker::integer_t const min = to_integer(reader.read<std::int64_t>());
+      tchecker::integer_t const max = to_integer(reader.read<std::int64_t>());
+      tchecker::integer_t const init = to_integer(reader.read<std::int64_t>());
+      tchecker::parsing::attributes_t attributes = reader.read_attributes();
+      std::unique_ptr<tchecker::parsing::int_declaration_t> d{new tchecker::parsing::int_declaration_t{
+          name, size, min, max, init, std::move(attributes), reader.read_string()}};
+      add_declaration(sysdecl->insert_int_declaration(d.get()), d, declarations);
+      break;
+    }
+    case RECORD_PROCESS: {
+      std::string name = reader.read_string();
+      tchecker::parsing::attributes_t attributes = reader.read_attributes();
+      std::unique_ptr<tchecker::parsing::process_declaration_t> d{
+          new tchecker::parsing::process_declaration_t{name, std::move(attributes), reader.read_string()}};
+      add_declaration(sysdecl->insert_process_declaration(d.get()), d, declarations);
+      break;
+    }
+    case RECORD_EVENT: {
+      std::string name = reader.read_string();
+      tchecker::parsing::attributes_t attributes = reader.read_attributes();
+      std::unique_ptr<tchecker::parsing::event_declaration_t> d{
+          new tchecker::parsing::event_declaration_t{name, std::move(attributes), reader.read_string()}};
+      add_declaration(sysdecl->insert_event_declaration(d.get()), d, declarations);
+      break;
+    }
+    case RECORD_LOCATION: {
+      auto const & process =
+          declaration<tchecker::parsing::process_declaration_t>(declarations, reader.read<std::uint32_t>());
+      std::string name = reader.read_string();
+      tchecker::parsing::attributes_t attributes = reader.read_attributes();
+      std::unique_ptr<tchecker::parsing::location_declaration_t> d{
+          new tchecker::parsing::location_declaration_t{name, process, std::move(attributes), reader.read_string()}};
+      add_declaration(sysdecl->insert_location_declaration(d.get()), d, declarations);
+      break;
+    }
+    case RECORD_EDGE: {
+      auto const & process =
+          declaration<tchecker::parsing::process_declaration_t>(declarations, reader.read<std::uint32_t>());
+      auto const & src = declaration<tchecker::parsing::location_declaration_t>(declarations, reader.read<std::uint32_t>());
+      auto const & tgt = declaration<tchecker::parsing::location_declaration_t>(declarations, reader.read<std::uint32_t>());
+      auto const & event = declaration<tchecker::parsing::event_declaration_t>(declarations, reader.read<std::uint32_t>());
+      tchecker::parsing::attributes_t attributes = reader.read_attributes();
+      std::unique_ptr<tchecker::parsing::edge_declaration_t> d{new tchecker::parsing::edge_declaration_t{
+          process, src, tgt, event, std::move(attributes), reader.read_string()}};
+      add_declaration(sysdecl->insert_edge_declaration(d.get()), d, declarations);
+      break;
+    }
+    case RECORD_SYNC: {
+      std::vector<std::unique_ptr<tchecker::parsing::sync_constraint_t>> constraints;
+      std::uint32_t const size = reader.read<std::uint32_t>();
+      for (std::uint32_t j = 0; j < size; ++j) {
+        auto const & process =
+            declaration<tchecker::parsing::process_declaration_t>(declarations, reader.read<std::uint32_t>());
+        auto const & event = declaration<tchecker::parsing::event_declaration_t>(declarations, reader.read<std::uint32_t>());
+        std::uint8_t const strength = reader.read<std::uint8_t>();
+        if (strength != tchecker::SYNC_WEAK && strength != tchecker::SYNC_STRONG)
+          throw std::runtime_error("invalid strength of synchronization");
+        constraints.emplace_back(new tchecker::parsing::sync_constraint_t{
+            process, event, static_cast<enum tchecker::sync_strength_t>(strength)});
+      }
+      tchecker::parsing::attributes_t attributes = reader.read_attributes();
+      std::string context = reader.read_string();
+      // ownership of the constraints is transferred once the synchronization is built
+      std::vector<tchecker::parsing::sync_constraint_t const *> syncs;
+      for (auto const & c : constraints)
+        syncs.push_back(c.get());
+      std::unique_ptr<tchecker::parsing::sync_declaration_t> d{
+          new tchecker::parsing::sync_declaration_t{std::move(syncs), std::move(attributes), context}};
+      for (auto & c : constraints)
+        c.release();
+      add_declaration(sysdecl->insert_sync_declaration(d.get()), d, declarations);
+      break;
+    }
+    default:
+      throw std::runtime_error("unknown kind of declaration");
+    }
+  }
+
+  if (!reader.at_end())
+    throw std::runtime_error("unexpected data at end of file");
+
+  return sysdecl.release();
+}
+
+} // end of namespace details
+
+void write_binary_system_declaration(std::ostream & os, tchecker::parsing::system_declaration_t const & sysdecl)
+{
+  tchecker::parsing::details::binary_writer_t writer{os};
+  sysdecl.visit(writer);
+  if (!os)
+    throw std::runtime_error("Cannot write binary system declaration");
+}
+
+bool is_binary_system_declaration(std::string const & filename)
+{
+  std::ifstream ifs{filename, std::ios::binary};
+  char magic[sizeof(tchecker::parsing::BINARY_MAGIC)];
+  if (!ifs.read(magic, sizeof(magic)))
+    return false;
+  return std::memcmp(magic, tchecker::parsing::BINARY_MAGIC, sizeof(magic)) == 0;
+}
+
+tchecker::parsing::system_declaration_t * load_binary_system_declaration(std::string const & filename)
+{
+  tchecker::mapped_file_t file{filename};
+  tchecker::parsing::details::binary_reader_t reader{file.begin(), file.end()};
+  try {
+    return tchecker::parsing::details::read_system_declaration(reader);
+  }
+  catch (std::exception const & e) {
+    throw std::runtime_error("invalid binary system file " + filename + ": " + e.what());
+  }
+}
+
+} // end of namespace parsing
+
+} // end of namespace tchecker
@@ -0,0 +1,160 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "tchecker/parsing/declaration_filter.hh"
+
+namespace tchecker {
+
+namespace parsing {
+
+declaration_filter_t::declaration_filter_t(tchecker::parsing::system_declaration_t & copy)
+    : _copy(copy), _edge_id(0), _sync_id(0)
+{
+}
+
+void declaration_filter_t::visit(tchecker::parsing::system_declaration_t const & d)
+{
+  for (auto const * decl : d.declarations())
+    decl->visit(*this);
+}
+
+void declaration_filter_t::visit(tchecker::parsing::clock_declaration_t const & d)
+{
+  if (!keep(d))
+    return;
+  auto const * c = dynamic_cast<tchecker::parsing::clock_declaration_t const *>(d.clone());
+  if (!_copy.insert_clock_declaration(c)) {
+    delete c;
+    throw std::runtime_error("Clock " + d.name() + " is already declared in " + _copy.name());
+  }
+}
+
+void declaration_filter_t::visit(tchecker::parsing::int_declaration_t const & d)
+{
+  if (!keep(d))
+    return;
+  auto const * c = dynamic_cast<tchecker::parsing::int_declaration_t const *>(d.clone());
+  if (!_copy.insert_int_declaration(c)) {
+    delete c;
+    throw std::runtime_error("Integer variable " + d.name() + " is already declared in " + _copy.name());
+  }
+}
+
+void declaration_filter_t::visit(tchecker::parsing::process_declaration_t const & d)
+{
+  if (!keep(d))
+    return;
+  auto const * c = dynamic_cast<tchecker::parsing::process_declaration_t const *>(d.clone());
+  if (!_copy.insert_process_declaration(c)) {
+    delete c;
+    throw std::runtime_error("Process " + d.name() + " is already declared in " + _copy.name());
+  }
+}
+
+void declaration_filter_t::visit(tchecker::parsing::event_declaration_t const & d)
+{
+  if (!keep(d))
+    return;
+  tchecker::parsing::attributes_t attr(d.attributes());
+  auto const * c = new tchecker::parsing::event_declaration_t(event_name(d.name()), std::move(attr), d.context());
+  if (!_copy.insert_event_declaration(c)) {
+    delete c;
+    throw std::runtime_error("Event " + event_name(d.name()) + " is already declared in " + _copy.name());
+  }
+}
+
+void declaration_filter_t::visit(tchecker::parsing::location_declaration_t const & d)
+{
+  if (!keep(d))
+    return;
+  tchecker::parsing::attributes_t attr(d.attributes());
+  auto const * c =
+      new tchecker::parsing::location_declaration_t(d.name(), process(d.process().name()), std::move(attr), d.context());
+  if (!_copy.insert_location_declaration(c)) {
+    delete c;
+    throw std::runtime_error("Location " + d.process().name() + ":" + d.name() + " is already declared in " +
+                             _copy.name());
+  }
+}
+
+void declaration_filter_t::visit(tchecker::parsing::edge_declaration_t const & d)
+{
+  tchecker::edge_id_t const id = _edge_id++;
+  if (!keep(d, id))
+    return;
+  std::string const & ps = d.process().name();
+  _copy.insert_edge_declaration(new tchecker::parsing::edge_declaration_t(
+      process(ps), location(ps, d.src().name()), location(ps, d.tgt().name()), event(d.event().name()),
+      edge_attributes(d, id), d.context()));
+}
+
+void declaration_filter_t::visit(tchecker::parsing::sync_declaration_t const & d)
+{
+  tchecker::sync_id_t const id = _sync_id++;
+  if (!keep(d, id))
+    return;
+
+  std::vector<tchecker::parsing::sync_constraint_t const *> syncs;
+  try {
+    for (tchecker::parsing::sync_constraint_t const * c : d.sync_constraints())
+      if (keep(*c))
+        syncs.push_back(
+            new tchecker::parsing::sync_constraint_t(process(c->process().name()), event(c->event().name()), c->strength()));
+  }
+  catch (...) {
+    for (tchecker::parsing::sync_constraint_t const * c : syncs)
+      delete c;
+    throw;
+  }
+
+  // a synchronization restricted to a single process does not synchronize anything, unless it was on a single process
+  std::size_t const constraints_count = std::distance(d.sync_constraints().begin(), d.sync_constraints().end());
+  if (syncs.size() < 2 && syncs.size() != constraints_count) {
+    for (tchecker::parsing::sync_constraint_t const * c : syncs)
+      delete c;
+    return;
+  }
+
+  tchecker::parsing::attributes_t attr(d.attributes());
+  _copy.insert_sync_declaration(new tchecker::parsing::sync_declaration_t(std::move(syncs), std::move(attr), d.context()));
+}
+
+tchecker::parsing::attributes_t declaration_filter_t::edge_attributes(tchecker::parsing::edge_declaration_t const & d,
+                                                                      tchecker::edge_id_t id) const
+{
+  return tchecker::parsing::attributes_t(d.attributes());
+}
+
+tchecker::parsing::process_declaration_t const & declaration_filter_t::process(std::string const & name) const
+{
+  auto const * d = _copy.get_process_declaration(name);
+  if (d == nullptr)
+    throw std::runtime_error("Process " + name + " is not declared in " + _copy.name());
+  return *d;
+}
+
+tchecker::parsing::location_declaration_t const & declaration_filter_t::location(std::string const & process,
+                                                                                 std::string const & name) const
+{
+  auto const * d = _copy.get_location_declaration(process, name);
+  if (d == nullptr)
+    throw std::runtime_error("Location " + process + ":" + name + " is not declared in " + _copy.name());
+  return *d;
+}
+
+tchecker::parsing::event_declaration_t const & declaration_filter_t::event(std::string const & name) const
+{
+  auto const * d = _copy.get_event_declaration(event_name(name));
+  if (d == nullptr)
+    throw std::runtime_error("Event " + event_name(name) + " is not declared in " + _copy.name());
+  return *d;
+}
+
+} // end of namespace parsing
+
+} // end of namespace tchecker
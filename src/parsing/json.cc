@@ -0,0 +1,745 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "tchecker/parsing/json.hh"
+#include "tchecker/utils/mapped_file.hh"
+
+namespace tchecker {
+
+namespace parsing {
+
+namespace details {
+
+/*!
+ \class json_value_t
+ \brief JSON value
+ */
+struct json_value_t {
+  /*!
+   \brief Kinds of values
+   */
+  enum kind_t {
+    JSON_NULL,   /*!< null */
+    JSON_BOOL,   /*!< true or false */
+    JSON_NUMBER, /*!< Number */
+    JSON_STRING, /*!< String */
+    JSON_ARRAY,  /*!< Array */
+    JSON_OBJECT, /*!< Object */
+  };
+
+  enum kind_t kind = JSON_NULL;        /*!< Kind of value */
+  std::string text;                    /*!< Content of strings, text of numbers and booleans */
+  std::vector<std::string> keys;       /*!< Keys of members (objects) */
+  std::vector<json_value_t> elements;  /*!< Elements (arrays) or values of members (objects) */
+  std::string position;                /*!< Position of the value in the input */
+};
+
+/*!
+ \class json_parser_t
+ \brief Parser of JSON values
+ */
+class json_parser_t {
+public:
+  /*!
+   \brief Constructor
+   \param begin : first character
+   \param end : past-the-end character
+   \param context : context of the input (e.g. file name)
+   */
+  json_parser_t(char const * begin, char const * end, std::string const & context)
+      : _p(begin), _end(end), _line_begin(begin), _line(1), _context(context)
+  {
+  }
+
+  /*!
+   \brief Parse a document
+   \return the JSON value in the input
+   \throw std::runtime_error : if the input is not a single valid JSON value
+   */
+  tchecker::parsing::details::json_value_t parse()
+  {
+    tchecker::parsing::details::json_value_t v;
+    parse_value(v, 0);
+    skip_blanks();
+    if (_p != _end)
+      error("unexpected data after JSON value");
+    return v;
+  }
+
+private:
+  /*!
+   \brief Maximal depth of nested arrays and objects
+   */
+  static constexpr unsigned int const MAX_DEPTH = 256;
+
+  /*!
+   \brief Parse a value
+   \param v : value
+   \param depth : depth of v
+   \post the value at the current position has been parsed into v
+   \throw std::runtime_error : if the input is not a valid JSON value
+   */
+  void parse_value(tchecker::parsing::details::json_value_t & v, unsigned int depth)
+  {
+    skip_blanks();
+    if (_p == _end)
+      error("unexpected end of input");
+    if (depth > MAX_DEPTH)
+      error("too many nested arrays and objects");
+
+    v.position = position();
+    switch (*_p) {
+    case '{':
+      v.kind = tchecker::parsing::details::json_value_t::JSON_OBJECT;
+      ++_p;
+      skip_blanks();
+      if (_p != _end && *_p == '}') {
+        ++_p;
+        return;
+      }
+      while (true) {
+        skip_blanks();
+        if (_p == _end || *_p != '"')
+          error("expected member name");
+        v.keys.emplace_back();
+        parse_string(v.keys.back());
+        skip_blanks();
+        expect(':');
+        v.elements.emplace_back();
+        parse_value(v.elements.back(), depth + 1);
+        skip_blanks();
+        if (_p != _end && *_p == ',') {
+          ++_p;
+          continue;
+        }
+        expect('}');
+        return;
+      }
+    case '[':
+      v.kind = tchecker::parsing::details::json_value_t::JSON_ARRAY;
+      ++_p;
+      skip_blanks();
+      if (_p != _end && *_p == ']') {
+        ++_p;
+        return;
+      }
+      while (true) {
+        v.elements.emplace_back();
+        parse_value(v.elements.back(), depth + 1);
+        skip_blanks();
+        if (_p != _end && *_p == ',') {
+          ++_p;
+          continue;
+        }
+        expect(']');
+        return;
+      }
+    case '"':
+      v.kind = tchecker::parsing::details::json_value_t::JSON_STRING;
+      parse_string(v.text);
+      return;
+    case 't':
+      v.kind = tchecker::parsing::details::json_value_t::JSON_BOOL;
+      parse_literal("true", v.text);
+      return;
+    case 'f':
+      v.kind = tchecker::parsing::details::json_value_t::JSON_BOOL;
+      parse_literal("false", v.text);
+      return;
+    case 'n':
+      v.kind = tchecker::parsing::details::json_value_t::JSON_NULL;
+      parse_literal("null", v.text);
+      return;
+    default:
+      v.kind = tchecker::parsing::details::json_value_t::JSON_NUMBER;
+      parse_number(v.text);
+      return;
+    }
+  }
+
+  /*!
+   \brief Parse a string
+   \param s : string
+   \pre the current character is '"'
+   \post the string at the current position has been parsed, and its content (unescaped, UTF-8 encoded) has been
+   stored in s
+   \throw std::runtime_error : if the string is not valid
+   */
+  void parse_string(std::string & s)
+  {
+    ++_p; // opening quote
+    while (true) {
+      char const * q = _p;
+      while (q != _end && *q != '"' && *q != '\\' && static_cast<unsigned char>(*q) >= 0x20)
+        ++q;
+      s.append(_p, q);
+      _p = q;
+      if (_p == _end)
+        error("unterminated string");
+      if (*_p == '"') {
+        ++_p;
+        return;
+      }
+      if (*_p != '\\')
+        error("control character in string");
+      ++_p;
+      if (_p == _end)
+        error("unterminated string");
+      switch (*_p++) {
+      case '"':
+        s += '"';
+        break;
+      case '\\':
+        s += '\\';
+        break;
+      case '/':
+        s += '/';
+        break;
+      case 'b':
+        s += '\b';
+        break;
+      case 'f':
+        s += '\f';
+        break;
+      case 'n':
+        s += '\n';
+        break;
+      case 'r':
+        s += '\r';
+        break;
+      case 't':
+        s += '\t';
+        break;
+      case 'u': {
+        unsigned long code = parse_hex4();
+        if (code >= 0xd800 && code < 0xdc00) { // surrogate pair
+          if (_end - _p < 2 || _p[0] != '\\' || _p[1] != 'u')
+            error("invalid surrogate pair in string");
+          _p += 2;
+          unsigned long const low = parse_hex4();
+          if (low < 0xdc00 || low >= 0xe000)
+            error("invalid surrogate pair in string");
+          code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+        }
+        else if (code >= 0xdc00 && code < 0xe000)
+          error("invalid surrogate pair in string");
+        append_utf8(s, code);
+        break;
+      }
+      default:
+        error("invalid escape sequence in string");
+      }
+    }
+  }
+
+  /*!
+   \brief Parse 4 hexadecimal digits
+   \return value of the 4 hexadecimal digits at the current position
+   \throw std::runtime_error : if there are not 4 hexadecimal digits at the current position
+   */
+  unsigned long parse_hex4()
+  {
+    if (_end - _p < 4)
+      error("invalid escape sequence in string");
+    unsigned long code = 0;
+    for (int i = 0; i < 4; ++i, ++_p) {
+      char const c = *_p;
+      code <<= 4;
+      if (c >= '0' && c <= '9')
+        code += static_cast<unsigned long>(c - '0');
+      else if (c >= 'a' && c <= 'f')
+        code += static_cast<unsigned long>(c - 'a' + 10);
+      else if (c >= 'A' && c <= 'F')
+        code += static_cast<unsigned long>(c - 'A' + 10);
+      else
+        error("invalid escape sequence in string");
+    }
+    return code;
+  }
+
+  /*!
+   \brief Append a code point to a string
+   \param s : string
+   \param code : code point
+   \post code has been appended to s in UTF-8
+   */
+  static void append_utf8(std::string & s, unsigned long code)
+  {
+    if (code < 0x80)
+      s += static_cast<char>(code);
+    else if (code < 0x800) {
+      s += static_cast<char>(0xc0 | (code >> 6));
+      s += static_cast<char>(0x80 | (code & 0x3f));
+    }
+    else if (code < 0x10000) {
+      s += static_cast<char>(0xe0 | (code >> 12));
+      s += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+      s += static_cast<char>(0x80 | (code & 0x3f));
+    }
+    else {
+      s += static_cast<char>(0xf0 | (code >> 18));
+      s += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+      s += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+      s += static_cast<char>(0x80 | (code & 0x3f));
+    }
+  }
+
+  /*!
+   \brief Parse a number
+   \param s : string
+   \post the number at the current position has been parsed, and its text has been stored in s
+   \throw std::runtime_error : if there is no valid number at the current position
+   */
+  void parse_number(std::string & s)
+  {
+    char const * const begin = _p;
+    if (_p != _end && *_p == '-')
+      ++_p;
+    if (_p == _end || !std::isdigit(static_cast<unsigned char>(*_p)))
+      error("invalid value");
+    if (*_p == '0')
+      ++_p;
+    else
+      skip_digits();
+    if (_p != _end && *_p == '.') {
+      ++_p;
+      if (_p == _end || !std::isdigit(static_cast<unsigned char>(*_p)))
+        error("invalid number");
+      skip_digits();
+    }
+    if (_p != _end && (*_p == 'e' || *_p == 'E')) {
+      ++_p;
+      if (_p != _end && (*_p == '+' || *_p == '-'))
+        ++_p;
+      if (_p == _end || !std::isdigit(static_cast<unsigned char>(*_p)))
+        error("invalid number");
+      skip_digits();
+    }
+    s.assign(begin, _p);
+  }
+
+  /*!
+   \brief Parse a literal
+   \param literal : literal
+   \param s : string
+   \post literal has been parsed at the current position, and stored in s
+   \throw std::runtime_error : if literal is not at the current position
+   */
+  void parse_literal(std::string const & literal, std::string & s)
+  {
+    if (static_cast<std::size_t>(_end - _p) < literal.size() || literal.compare(0, literal.size(), _p, literal.size()) != 0)
+      error("invalid value");
+    _p += literal.size();
+    s = literal;
+  }
+
+  /*!
+   \brief Skip digits
+   \post the current position has moved past all digits
+   */
+  void skip_digits()
+  {
+    while (_p != _end && std::isdigit(static_cast<unsigned char>(*_p)))
+      ++_p;
+  }
+
+  /*!
+   \brief Skip blank characters
+   \post the current position has moved past all blank characters
+   */
+  void skip_blanks()
+  {
+    while (_p != _end && (*_p == ' ' || *_p == '\t' || *_p == '\n' || *_p == '\r')) {
+      if (*_p == '\n') {
+        ++_line;
+        _line_begin = _p + 1;
+      }
+      ++_p;
+    }
+  }
+
+  /*!
+   \brief Parse a character
+   \param c : character
+   \post the current position has moved past c
+   \throw std::runtime_error : if the current character is not c
+   */
+  void expect(char c)
+  {
+    if (_p == _end || *_p != c)
+      error(std::string{"expected '"} + c + "'");
+    ++_p;
+  }
+
+  /*!
+   \brief Accessor
+   \return the current position as context:line.column
+   */
+  std::string position() const
+  {
+    return _context + ":" + std::to_string(_line) + "." + std::to_string(_p - _line_begin + 1);
+  }
+
+  /*!
+   \brief Report an error
+   \param msg : error message
+   \throw std::runtime_error : with msg at the current position
+   */
+  [[noreturn]] void error(std::string const & msg) const { throw std::runtime_error(position() + ": " + msg); }
+
+  char const * _p;            /*!< Current position */
+  char const * const _end;    /*!< End of input */
+  char const * _line_begin;   /*!< Beginning of the current line */
+  std::size_t _line;          /*!< Current line */
+  std::string const _context; /*!< Context of the input */
+};
+
+/*!
+ \brief Report an invalid system declaration
+ \param v : JSON value
+ \param msg : error message
+ \throw std::runtime_error : with msg at the position of v
+ */
+[[noreturn]] static void invalid(tchecker::parsing::details::json_value_t const & v, std::string const & msg)
+{
+  throw std::runtime_error(v.position + ": " + msg);
+}
+
+/*!
+ \brief Access a member of an object
+ \param v : JSON object
+ \param key : member name
+ \return the value of member key of v, nullptr if v has no such member
+ \throw std::runtime_error : if v is not an object
+ */
+static tchecker::parsing::details::json_value_t const * member(tchecker::parsing::details::json_value_t const & v,
+                                                               std::string const & key)
+{
+  if (v.kind != tchecker::parsing::details::json_value_t::JSON_OBJECT)
+    invalid(v, "object expected");
+  for (std::size_t i = 0; i < v.keys.size(); ++i)
+    if (v.keys[i] == key)
+      return &v.elements[i];
+  return nullptr;
+}
+
+/*!
+ \brief Access a string member of an object
+ \param v : JSON object
+ \param key : member name
+ \return the value of member key of v
+ \throw std::runtime_error : if v is not an object, or if it has no member key that is a string
+ */
+static std::string const & string_member(tchecker::parsing::details::json_value_t const & v, std::string const & key)
+{
+  tchecker::parsing::details::json_value_t const * m = member(v, key);
+  if (m == nullptr)
+    invalid(v, "missing member \"" + key + "\"");
+  if (m->kind != tchecker::parsing::details::json_value_t::JSON_STRING)
+    invalid(*m, "string expected");
+  return m->text;
+}
+
+/*!
+ \brief Access an integer member of an object
+ \param v : JSON object
+ \param key : member name
+ \param default_value : value of a missing member, nullptr if the member is required
+ \return the value of member key of v, *default_value if v has no member key
+ \throw std::runtime_error : if v is not an object, if it has no member key and default_value is nullptr, or if
+ member key is not an integer in tchecker::integer_t
+ */
+static tchecker::integer_t integer_member(tchecker::parsing::details::json_value_t const & v, std::string const & key,
+                                          tchecker::integer_t const * default_value = nullptr)
+{
+  tchecker::parsing::details::json_value_t const * m = member(v, key);
+  if (m == nullptr) {
+    if (default_value == nullptr)
+      invalid(v, "missing member \"" + key + "\"");
+    return *default_value;
+  }
+  if (m->kind != tchecker::parsing::details::json_value_t::JSON_NUMBER)
+    invalid(*m, "integer expected");
+  errno = 0;
+  char * end = nullptr;
+  long long const value = std::strtoll(m->text.c_str(), &end, 10);
+  if (*end != '\0')
+    invalid(*m, "integer expected");
+  if (errno == ERANGE || value < std::numeric_limits<tchecker::integer_t>::min() ||
+      value > std::numeric_limits<tchecker::integer_t>::max())
+    invalid(*m, "integer out of range");
+  return static_cast<tchecker::integer_t>(value);
+}
+
+/*!
+ \brief Access a size member of an object
+ \param v : JSON object
+ \param key : member name
+ \return the value of member key of v, 1 if v has no member key
+ \throw std::runtime_error : if v is not an object, or if member key is not a positive integer
+ */
+static unsigned int size_member(tchecker::parsing::details::json_value_t const & v, std::string const & key)
+{
+  tchecker::integer_t const one = 1;
+  tchecker::integer_t const size = integer_member(v, key, &one);
+  if (size < 1)
+    invalid(*member(v, key), "positive size expected");
+  return static_cast<unsigned int>(size);
+}
+
+/*!
+ \brief Access an array member of an object
+ \param v : JSON object
+ \param key : member name
+ \return the elements of member key of v, no element if v has no member key
+ \throw std::runtime_error : if v is not an object, or if member key is not an array
+ */
+static std::vector<tchecker::parsing::details::json_value_t> const &
+array_member(tchecker::parsing::details::json_value_t const & v, std::string const & key)
+{
+  static std::vector<tchecker::parsing::details::json_value_t> const empty;
+  tchecker::parsing::details::json_value_t const * m = member(v, key);
+  if (m == nullptr)
+    return empty;
+  if (m->kind != tchecker::parsing::details::json_value_t::JSON_ARRAY)
+    invalid(*m, "array expected");
+  return m->elements;
+}
+
+/*!
+ \brief Build attributes
+ \param v : JSON object
+ \param skipped : name of an attribute to skip (empty if none)
+ \param skipped_value : value of attribute skipped
+ \return the attributes in member "attributes" of v (none if v has no such member), except attribute skipped
+ which value is stored in skipped_value
+ \throw std::runtime_error : if member "attributes" of v is not an object of strings, numbers and booleans
+ */
+static tchecker::parsing::attributes_t attributes(tchecker::parsing::details::json_value_t const & v,
+                                                  std::string const & skipped, std::string const ** skipped_value)
+{
+  tchecker::parsing::attributes_t attr;
+  tchecker::parsing::details::json_value_t const * m = member(v, "attributes");
+  if (m == nullptr)
+    return attr;
+  if (m->kind != tchecker::parsing::details::json_value_t::JSON_OBJECT)
+    invalid(*m, "object expected");
+  for (std::size_t i = 0; i < m->keys.size(); ++i) {
+    tchecker::parsing::details::json_value_t const & value = m->elements[i];
+    if (value.kind != tchecker::parsing::details::json_value_t::JSON_STRING &&
+        value.kind != tchecker::parsing::details::json_value_t::JSON_NUMBER &&
+        value.kind != tchecker::parsing::details::json_value_t::JSON_BOOL)
+      invalid(value, "attribute values should be strings, numbers or booleans");
+    if (!skipped.empty() && m->keys[i] == skipped) {
+      *skipped_value = &value.text;
+      continue;
+    }
+    attr.insert(new tchecker::parsing::attr_t{m->keys[i], value.text,
+                                              tchecker::parsing::attr_parsing_position_t{value.position, value.position}});
+  }
+  return attr;
+}
+
+/*!
+ \brief Build attributes
+ \param v : JSON object
+ \return the attributes in member "attributes" of v (none if v has no such member)
+ \throw std::runtime_error : if member "attributes" of v is not an object of strings, numbers and booleans
+ */
+static tchecker::parsing::attributes_t attributes(tchecker::parsing::details::json_value_t const & v)
+{
+  return attributes(v, "", nullptr);
+}
+
+/*!
+ \brief Insert a declaration
+ \param inserted : result of the insertion of d
+ \param d : a declaration
+ \param v : JSON value of d
+ \return d
+ \post d is owned by the system declaration
+ \throw std::runtime_error : if inserted is false (d redeclares a name)
+ \note d is deleted if inserted is false
+ */
+template <class D>
+static D const * insert(bool inserted, std::unique_ptr<D> & d, tchecker::parsing::details::json_value_t const & v)
+{
+  if (!inserted)
+    invalid(v, "multiple declarations of the same name");
+  return d.release();
+}
+
+/*!
+ \brief Access an event declaration
+ \param sysdecl : system declaration
+ \param name : event name
+ \param v : JSON value that refers to name
+ \return the declaration of event name in sysdecl, declared with no attribute if it was not declared yet
+ */
+static tchecker::parsing::event_declaration_t const * event(tchecker::parsing::system_declaration_t & sysdecl,
+                                                            std::string const & name,
+                                                            tchecker::parsing::details::json_value_t const & v)
+{
+  tchecker::parsing::event_declaration_t const * e = sysdecl.get_event_declaration(name);
+  if (e != nullptr)
+    return e;
+  std::unique_ptr<tchecker::parsing::event_declaration_t> d{
+      new tchecker::parsing::event_declaration_t{name, tchecker::parsing::attributes_t{}, v.position}};
+  return insert(sysdecl.insert_event_declaration(d.get()), d, v);
+}
+
+/*!
+ \brief Build a system declaration
+ \param root : JSON value
+ \return the system declaration in root
+ \throw std::runtime_error : if root is not a valid system declaration
+ */
+static tchecker::parsing::system_declaration_t * system_declaration(tchecker::parsing::details::json_value_t const & root)
+{
+  std::unique_ptr<tchecker::parsing::system_declaration_t> sysdecl{
+      new tchecker::parsing::system_declaration_t{string_member(root, "name"), attributes(root), root.position}};
+
+  for (tchecker::parsing::details::json_value_t const & v : array_member(root, "events")) {
+    std::unique_ptr<tchecker::parsing::event_declaration_t> d{
+        new tchecker::parsing::event_declaration_t{string_member(v, "name"), attributes(v), v.position}};
+    insert(sysdecl->insert_event_declaration(d.get()), d, v);
+  }
+
+  for (tchecker::parsing::details::json_value_t const & v : array_member(root, "clocks")) {
+    std::unique_ptr<tchecker::parsing::clock_declaration_t> d{new tchecker::parsing::clock_declaration_t{
+        string_member(v, "name"), size_member(v, "size"), attributes(v), v.position}};
+    insert(sysdecl->insert_clock_declaration(d.get()), d, v);
+  }
+
+  for (tchecker::parsing::details::json_value_t const & v : array_member(root, "ints")) {
+    std::unique_ptr<tchecker::parsing::int_declaration_t> d{new tchecker::parsing::int_declaration_t{
+        string_member(v, "name"), size_member(v, "size"), integer_member(v, "min"), integer_member(v, "max"),
+        integer_member(v, "init"), attributes(v), v.position}};
+    insert(sysdecl->insert_int_declaration(d.get()), d, v);
+  }
+
+  for (tchecker::parsing::details::json_value_t const & p : array_member(root, "processes")) {
+    std::unique_ptr<tchecker::parsing::process_declaration_t> pd{
+        new tchecker::parsing::process_declaration_t{string_member(p, "pid"), attributes(p), p.position}};
+    tchecker::parsing::process_declaration_t const * process = insert(sysdecl->insert_process_declaration(pd.get()), pd, p);
+
+    // locations are referred to by their identifier, their name is their label if any, their identifier otherwise
+    std::unordered_map<std::string, tchecker::parsing::location_declaration_t const *> locations;
+    for (tchecker::parsing::details::json_value_t const & v : array_member(p, "locations")) {
+      std::string const & id = string_member(v, "id");
+      std::string const * label = &id;
+      tchecker::parsing::attributes_t attr = attributes(v, "label", &label);
+      std::unique_ptr<tchecker::parsing::location_declaration_t> d{
+          new tchecker::parsing::location_declaration_t{*label, *process, std::move(attr), v.position}};
+      tchecker::parsing::location_declaration_t const * loc = insert(sysdecl->insert_location_declaration(d.get()), d, v);
+      if (!locations.emplace(id, loc).second)
+        invalid(v, "multiple locations with identifier " + id);
+    }
+
+    auto location = [&](tchecker::parsing::details::json_value_t const & v, std::string const & key) {
+      auto it = locations.find(string_member(v, key));
+      if (it == locations.end())
+        invalid(v, "unknown location " + string_member(v, key) + " in process " + process->name());
+      return it->second;
+    };
+
+    // the event of an edge is its member "event" if any, its label otherwise
+    for (tchecker::parsing::details::json_value_t const & v : array_member(p, "edges")) {
+      std::string const * label = nullptr;
+      tchecker::parsing::attributes_t attr = attributes(v, "label", &label);
+      if (member(v, "event") != nullptr)
+        label = &string_member(v, "event");
+      if (label == nullptr)
+        invalid(v, "missing event of edge");
+      std::unique_ptr<tchecker::parsing::edge_declaration_t> d{new tchecker::parsing::edge_declaration_t{
+          *process, *location(v, "src"), *location(v, "tgt"), *event(*sysdecl, *label, v), std::move(attr), v.position}};
+      insert(sysdecl->insert_edge_declaration(d.get()), d, v);
+    }
+  }
+
+  for (tchecker::parsing::details::json_value_t const & v : array_member(root, "sync")) {
+    if (v.kind != tchecker::parsing::details::json_value_t::JSON_ARRAY)
+      invalid(v, "array expected");
+    std::vector<std::unique_ptr<tchecker::parsing::sync_constraint_t>> constraints;
+    for (tchecker::parsing::details::json_value_t const & c : v.elements) {
+      if (c.kind != tchecker::parsing::details::json_value_t::JSON_STRING)
+        invalid(c, "string expected");
+      std::string::size_type const at = c.text.find('@');
+      if (at == std::string::npos)
+        invalid(c, "synchronization constraint process@event expected");
+      bool const weak = (c.text.back() == '?');
+      std::string const process_name = c.text.substr(0, at);
+      std::string const event_name = c.text.substr(at + 1, c.text.size() - at - 1 - (weak ? 1 : 0));
+      tchecker::parsing::process_declaration_t const * process = sysdecl->get_process_declaration(process_name);
+      if (process == nullptr)
+        invalid(c, "unknown process " + process_name);
+      constraints.emplace_back(new tchecker::parsing::sync_constraint_t{
+          *process, *event(*sysdecl, event_name, c), (weak ? tchecker::SYNC_WEAK : tchecker::SYNC_STRONG)});
+    }
+    // ownership of the constraints is transferred once the synchronization is built
+    std::vector<tchecker::parsing::sync_constraint_t const *> syncs;
+    for (auto const & c : constraints)
+      syncs.push_back(c.get());
+    std::unique_ptr<tchecker::parsing::sync_declaration_t> d{
+        new tchecker::parsing::sync_declaration_t{std::move(syncs), tchecker::parsing::attributes_t{}, v.position}};
+    for (auto & c : constraints)
+      c.release();
+    insert(sysdecl->insert_sync_declaration(d.get()), d, v);
+  }
+
+  return sysdecl.release();
+}
+
+/*!
+ \brief Parse a system declaration
+ \param begin : first character
+ \param end : past-the-end character
+ \param context : context of the input
+ \return the system declaration in [begin, end)
+ \throw std::runtime_error : if [begin, end) is not valid JSON, or if it is not a valid system declaration
+ */
+static tchecker::parsing::system_declaration_t * parse(char const * begin, char const * end, std::string const & context)
+{
+  tchecker::parsing::details::json_parser_t parser{begin, end, context};
+  tchecker::parsing::details::json_value_t const root = parser.parse();
+  return tchecker::parsing::details::system_declaration(root);
+}
+
+} // end of namespace details
+
+bool is_json_system_declaration(std::string const & filename)
+{
+  std::ifstream ifs{filename, std::ios::in | std::ios::binary};
+  char c;
+  while (ifs.get(c))
+    if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+      return c == '{';
+  return false;
+}
+
+tchecker::parsing::system_declaration_t * parse_json_system_declaration(std::string const & text,
+                                                                        std::string const & context)
+{
+  return tchecker::parsing::details::parse(text.data(), text.data() + text.size(), context);
+}
+
+tchecker::parsing::system_declaration_t * load_json_system_declaration(std::string const & filename)
+{
+  tchecker::mapped_file_t file{filename};
+  return tchecker::parsing::details::parse(file.begin(), file.end(), filename);
+}
+
+} // end of namespace parsing
+
+} // end of namespace tchecker
@@ -4,6 +4,7 @@
 
 %{
 #include <cstdlib>
+#include <mutex>
 #include <sstream>
 
 #include "tchecker/expression/expression.hh"
@@ -110,6 +111,10 @@ namespace tchecker {
                        tchecker::expression_t * & expr,
                        tchecker::statement_t * & stmt)
 		{
+			// The lexer and the parser are not reentrant, programs are parsed one at a time
+			static std::mutex parsing_mutex;
+			std::lock_guard<std::mutex> lock{parsing_mutex};
+
 			std::size_t old_error_count = tchecker::log_error_count();
       
 			expr = nullptr;
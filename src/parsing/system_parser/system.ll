@@ -3,11 +3,21 @@
  */
 
 %{
+#include <algorithm>
+#include <cerrno>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <exception>
 #include <sstream>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tchecker/parsing/binary.hh"
+#include "tchecker/parsing/json.hh"
 #include "tchecker/parsing/declaration.hh"
 #include "tchecker/parsing/parsing.hh"
 #include "tchecker/utils/log.hh"
@@ -119,8 +129,7 @@ newline    [\n]
                  return system::parser_t::make_TOK_RBRACE(loc); }
 {newline}+       { loc.lines(static_cast<int>(spyyleng)); loc.step(); }
 [^:{}#]*       {
-                 std::string s(spyytext);
-                 size_t nb_nl = std::count(s.begin(), s.end(), '\n');
+                 size_t nb_nl = std::count(spyytext, spyytext + spyyleng, '\n');
                  auto res = system::parser_t::make_TOK_TEXT(spyytext, loc);
                  loc.lines(static_cast<int>(nb_nl));
                  return res;
@@ -141,16 +150,123 @@ namespace tchecker {
 
   namespace parsing {
 
+    /*!
+     \brief Parse the current buffer of the lexer
+     \param filename : name of the scanned file
+     \return The system declaration read from the current buffer, nullptr if parsing failed
+     \post All errors and warnings have been reported on std::cerr
+     */
+    static tchecker::parsing::system_declaration_t * parse_current_buffer(std::string const & filename)
+    {
+      std::size_t old_error_count = tchecker::log_error_count();
+
+      // Initialise
+      sp_reset_locations();
+      BEGIN INITIAL;
+
+      // Parse
+      tchecker::parsing::system_declaration_t * sysdecl = nullptr;
+
+      try {
+        tchecker::parsing::system::parser_t parser(filename, sysdecl);
+        parser.parse();
+        spyy_flush_buffer(YY_CURRENT_BUFFER);
+      }
+      catch (...) {
+        delete sysdecl;
+        spyy_flush_buffer(YY_CURRENT_BUFFER);
+        throw;
+      }
+
+      if (tchecker::log_error_count() > old_error_count) {
+        delete sysdecl;
+        sysdecl = nullptr;
+      }
+
+      return sysdecl;
+    }
+
+
+    /*!
+     \brief Parse a regular file scanned in place from a memory mapping
+     \param filename : file to parse
+     \param sysdecl : system declaration
+     \return true if filename has been mapped and parsed, false if filename cannot be mapped (the caller should read
+     it through stdio then)
+     \post sysdecl is the system declaration read from filename (nullptr if parsing failed) if filename has been
+     mapped, sysdecl is left unchanged otherwise. All errors and warnings have been reported on std::cerr
+     \note flex scans a buffer in place if it ends with two YY_END_OF_BUFFER_CHAR. The file is mapped privately
+     (the lexer writes to its buffer) over an anonymous mapping that is two bytes larger, hence the buffer ends with
+     zeros: either the end of the last page of the file, or the next anonymous page. This saves copying the file to
+     the stdio and lexer buffers
+     */
+    static bool parse_mapped_system_declaration(std::string const & filename,
+                                                tchecker::parsing::system_declaration_t * & sysdecl)
+    {
+      int fd = ::open(filename.c_str(), O_RDONLY);
+      if (fd == -1)
+        return false;
+
+      struct stat st;
+      if (::fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+        ::close(fd);
+        return false;
+      }
+
+      std::size_t const size = static_cast<std::size_t>(st.st_size);
+      void * buffer = ::mmap(nullptr, size + 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (buffer == MAP_FAILED) {
+        ::close(fd);
+        return false;
+      }
+      void * file = ::mmap(buffer, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0);
+      ::close(fd);
+      if (file == MAP_FAILED) {
+        ::munmap(buffer, size + 2);
+        return false;
+      }
+
+      YY_BUFFER_STATE state = spyy_scan_buffer(static_cast<char *>(buffer), size + 2);
+      if (state == nullptr) {
+        ::munmap(buffer, size + 2);
+        return false;
+      }
+
+      try {
+        sysdecl = parse_current_buffer(filename);
+      }
+      catch (...) {
+        spyy_delete_buffer(state);
+        ::munmap(buffer, size + 2);
+        throw;
+      }
+      spyy_delete_buffer(state);
+      ::munmap(buffer, size + 2);
+      return true;
+    }
+
     tchecker::parsing::system_declaration_t * parse_system_declaration(std::string const & filename)
     {
       if (filename.empty() || (filename == "-"))
         return tchecker::parsing::parse_system_declaration(stdin, "");
+
+      // models compiled by tck-compile are loaded without lexing and parsing
+      if (tchecker::parsing::is_binary_system_declaration(filename))
+        return tchecker::parsing::load_binary_system_declaration(filename);
+
+      // models in JSON format are read by a dedicated parser
+      if (tchecker::parsing::is_json_system_declaration(filename))
+        return tchecker::parsing::load_json_system_declaration(filename);
       
+      // regular files are scanned in place from a memory mapping, other files are read through stdio
+      tchecker::parsing::system_declaration_t * sysdecl = nullptr;
+      if (parse_mapped_system_declaration(filename, sysdecl))
+        return sysdecl;
+
       std::FILE * f = std::fopen(filename.c_str(), "r");
       if (f == nullptr)
         throw std::runtime_error("cannot open " + filename + ": " + strerror(errno));
-        
-      tchecker::parsing::system_declaration_t * sysdecl = nullptr;
+
       try {
         sysdecl = tchecker::parsing::parse_system_declaration(f, filename);
         std::fclose(f);
@@ -166,34 +282,8 @@ namespace tchecker {
     tchecker::parsing::system_declaration_t *
     parse_system_declaration(std::FILE * f, std::string const & filename)
 		{
-      std::size_t old_error_count = tchecker::log_error_count();
-      
       spyyrestart(f);
-
-      // Initialise
-      sp_reset_locations();
-      BEGIN INITIAL;
-      
-      // Parse
-      tchecker::parsing::system_declaration_t * sysdecl = nullptr;
-      
-      try {
-        tchecker::parsing::system::parser_t parser(filename, sysdecl);
-				parser.parse();
-        spyy_flush_buffer(YY_CURRENT_BUFFER);
-      }
-      catch (...) {
-        delete sysdecl;
-        spyy_flush_buffer(YY_CURRENT_BUFFER);
-        throw;
-      }
-      
-      if (tchecker::log_error_count() > old_error_count) {
-        delete sysdecl;
-        sysdecl = nullptr;
-      }
-      
-      return sysdecl;
+      return parse_current_buffer(filename);
     }
     
   }
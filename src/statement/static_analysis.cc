@@ -335,4 +335,59 @@ bool has_local_declarations(tchecker::typed_statement_t const & stmt)
   stmt.visit(v);
   return v.value();
 }
+
+namespace details {
+
+/* flat_assignments */
+
+/*!
+ \class flat_assignments_visitor_t
+ \brief Visitor that collects the assignments of statements made of sequences of assignments
+ */
+class flat_assignments_visitor_t : public tchecker::typed_statement_visitor_t {
+public:
+  /*!
+   \brief Constructor
+   \param assignments : vector of assignments
+   */
+  flat_assignments_visitor_t(std::vector<tchecker::typed_assign_statement_t const *> & assignments)
+      : _flat(true), _assignments(assignments)
+  {
+  }
+
+  /*!
+   \brief Accessor
+   \return true if the visited statements are sequences of assignments (and nop), false otherwise
+   */
+  inline bool flat() const { return _flat; }
+
+  virtual void visit(tchecker::typed_nop_statement_t const &) {}
+  virtual void visit(tchecker::typed_assign_statement_t const & stmt) { _assignments.push_back(&stmt); }
+  virtual void visit(tchecker::typed_int_to_clock_assign_statement_t const & stmt) { _assignments.push_back(&stmt); }
+  virtual void visit(tchecker::typed_clock_to_clock_assign_statement_t const & stmt) { _assignments.push_back(&stmt); }
+  virtual void visit(tchecker::typed_sum_to_clock_assign_statement_t const & stmt) { _assignments.push_back(&stmt); }
+  virtual void visit(tchecker::typed_sequence_statement_t const & stmt)
+  {
+    stmt.first().visit(*this);
+    stmt.second().visit(*this);
+  }
+  virtual void visit(tchecker::typed_if_statement_t const &) { _flat = false; }
+  virtual void visit(tchecker::typed_while_statement_t const &) { _flat = false; }
+  virtual void visit(tchecker::typed_local_var_statement_t const &) { _flat = false; }
+  virtual void visit(tchecker::typed_local_array_statement_t const &) { _flat = false; }
+
+private:
+  bool _flat;                                                           /*!< Flat statements */
+  std::vector<tchecker::typed_assign_statement_t const *> & _assignments; /*!< Assignments */
+};
+
+} // end of namespace details
+
+bool flat_assignments(tchecker::typed_statement_t const & stmt,
+                      std::vector<tchecker::typed_assign_statement_t const *> & assignments)
+{
+  tchecker::details::flat_assignments_visitor_t v{assignments};
+  stmt.visit(v);
+  return v.flat();
+}
 } // end of namespace tchecker
@@ -0,0 +1,90 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include "tchecker/syncprod/edges_cache.hh"
+
+namespace tchecker {
+
+namespace syncprod {
+
+/*!
+ \brief Largest power of 2 not greater than n
+ \param n : a size
+ \return largest power of 2 not greater than n, 0 if n is 0
+ */
+static std::size_t floor_power_of_2(std::size_t n)
+{
+  if (n == 0)
+    return 0;
+  std::size_t p = 1;
+  while (p <= n / 2)
+    p *= 2;
+  return p;
+}
+
+vloc_edges_cache_t::vloc_edges_cache_t(std::size_t size)
+    : _outgoing(floor_power_of_2(size)), _incoming(_outgoing.size()), _mask(_outgoing.empty() ? 0 : _outgoing.size() - 1)
+{
+}
+
+std::shared_ptr<tchecker::syncprod::edges_list_t const>
+vloc_edges_cache_t::outgoing_edges(tchecker::syncprod::system_t const & system,
+                                   tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc)
+{
+  if (_outgoing.empty())
+    return std::make_shared<tchecker::syncprod::edges_list_t const>(tchecker::syncprod::outgoing_edges(system, vloc));
+
+  entry_t & e = entry(_outgoing, *vloc);
+  if (!matches(e, *vloc))
+    fill(e, *vloc, std::make_shared<tchecker::syncprod::edges_list_t const>(tchecker::syncprod::outgoing_edges(system, vloc)));
+  return e._edges;
+}
+
+std::shared_ptr<tchecker::syncprod::edges_list_t const>
+vloc_edges_cache_t::incoming_edges(tchecker::syncprod::system_t const & system,
+                                   tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc)
+{
+  if (_incoming.empty())
+    return std::make_shared<tchecker::syncprod::edges_list_t const>(tchecker::syncprod::incoming_edges(system, vloc));
+
+  entry_t & e = entry(_incoming, *vloc);
+  if (!matches(e, *vloc))
+    fill(e, *vloc, std::make_shared<tchecker::syncprod::edges_list_t const>(tchecker::syncprod::incoming_edges(system, vloc)));
+  return e._edges;
+}
+
+void vloc_edges_cache_t::clear()
+{
+  for (entry_t & e : _outgoing)
+    e._edges.reset();
+  for (entry_t & e : _incoming)
+    e._edges.reset();
+}
+
+vloc_edges_cache_t::entry_t & vloc_edges_cache_t::entry(std::vector<entry_t> & entries, tchecker::vloc_t const & vloc) const
+{
+  assert(!entries.empty());
+  return entries[tchecker::hash_value(vloc) & _mask];
+}
+
+bool vloc_edges_cache_t::matches(entry_t const & entry, tchecker::vloc_t const & vloc)
+{
+  if (entry._edges == nullptr || entry._vloc.size() != vloc.size())
+    return false;
+  for (std::size_t i = 0; i < entry._vloc.size(); ++i)
+    if (entry._vloc[i] != vloc[i])
+      return false;
+  return true;
+}
+
+void vloc_edges_cache_t::fill(entry_t & entry, tchecker::vloc_t const & vloc,
+                              std::shared_ptr<tchecker::syncprod::edges_list_t const> const & edges)
+{
+  entry._vloc.assign(vloc.begin(), vloc.end());
+  entry._edges = edges;
+}
+
+} // end of namespace syncprod
+
+} // end of namespace tchecker
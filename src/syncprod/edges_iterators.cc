@@ -73,17 +73,18 @@ static inline bool enabled(tchecker::system::synchronization_t const & sync, tch
 vloc_synchronized_edges_iterator_t::vloc_synchronized_edges_iterator_t(
     tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc,
     std::shared_ptr<tchecker::system::loc_edges_maps_t const> const & loc_edges_maps,
-    tchecker::system::synchronizations_t::const_iterator_t const & sync_begin,
-    tchecker::system::synchronizations_t::const_iterator_t const & sync_end)
-    : _vloc(vloc), _loc_edges_maps(loc_edges_maps), _sync_it(sync_begin), _sync_end(sync_end)
+    tchecker::system::synchronizations_t::const_iterator_t const & syncs_begin,
+    std::shared_ptr<tchecker::syncprod::system_t::sync_ids_t const> const & sync_ids)
+    : _vloc(vloc), _loc_edges_maps(loc_edges_maps), _syncs_begin(syncs_begin), _sync_ids(sync_ids),
+      _sync_ids_it(_sync_ids->begin())
 {
   advance_while_empty_cartesian_product();
 }
 
 bool vloc_synchronized_edges_iterator_t::operator==(tchecker::syncprod::vloc_synchronized_edges_iterator_t const & it) const
 {
-  return ((*_vloc == *it._vloc) && (_loc_edges_maps.get() == it._loc_edges_maps.get()) && (_sync_it == it._sync_it) &&
-          (_sync_end == it._sync_end) && (_cartesian_it == it._cartesian_it));
+  return ((*_vloc == *it._vloc) && (_loc_edges_maps.get() == it._loc_edges_maps.get()) && (_syncs_begin == it._syncs_begin) &&
+          (_sync_ids.get() == it._sync_ids.get()) && (_sync_ids_it == it._sync_ids_it) && (_cartesian_it == it._cartesian_it));
 }
 
 bool vloc_synchronized_edges_iterator_t::operator!=(tchecker::syncprod::vloc_synchronized_edges_iterator_t const & it) const
@@ -100,7 +101,7 @@ tchecker::syncprod::vloc_synchronized_edges_iterator_t & tchecker::syncprod::vlo
   assert(!at_end());
   ++_cartesian_it;
   if (_cartesian_it == tchecker::past_the_end_iterator) {
-    ++_sync_it;
+    ++_sync_ids_it;
     advance_while_empty_cartesian_product();
   }
   return *this;
@@ -111,15 +112,15 @@ void tchecker::syncprod::vloc_synchronized_edges_iterator_t::advance_while_empty
   _cartesian_it.clear();
 
   while (!at_end()) {
-    if (tchecker::syncprod::enabled(*_sync_it, *_vloc, *_loc_edges_maps))
+    if (tchecker::syncprod::enabled(synchronization(), *_vloc, *_loc_edges_maps))
       break;
-    ++_sync_it;
+    ++_sync_ids_it;
   }
 
   if (at_end())
     return;
 
-  auto constraints = _sync_it->synchronization_constraints();
+  auto constraints = synchronization().synchronization_constraints();
   for (auto const & constr : constraints) {
     auto edges = _loc_edges_maps->edges((*_vloc)[constr.pid()], constr.event_id());
     if ((constr.strength() == tchecker::SYNC_WEAK) && (edges.begin() == edges.end()))
@@ -134,8 +135,9 @@ tchecker::range_t<tchecker::syncprod::vloc_synchronized_edges_iterator_t, tcheck
 outgoing_synchronized_edges(tchecker::syncprod::system_t const & system,
                             tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc)
 {
-  auto syncs = system.synchronizations();
-  tchecker::syncprod::vloc_synchronized_edges_iterator_t begin(vloc, system.outgoing_edges_maps(), syncs.begin(), syncs.end());
+  tchecker::syncprod::vloc_synchronized_edges_iterator_t begin(vloc, system.outgoing_edges_maps(),
+                                                               system.synchronizations().begin(),
+                                                               system.outgoing_synchronizations(*vloc));
 
   return tchecker::make_range(begin, tchecker::past_the_end_iterator);
 }
@@ -146,8 +148,9 @@ tchecker::range_t<tchecker::syncprod::vloc_synchronized_edges_iterator_t, tcheck
 incoming_synchronized_edges(tchecker::syncprod::system_t const & system,
                             tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc)
 {
-  auto syncs = system.synchronizations();
-  tchecker::syncprod::vloc_synchronized_edges_iterator_t begin(vloc, system.incoming_edges_maps(), syncs.begin(), syncs.end());
+  tchecker::syncprod::vloc_synchronized_edges_iterator_t begin(vloc, system.incoming_edges_maps(),
+                                                               system.synchronizations().begin(),
+                                                               system.incoming_synchronizations(*vloc));
 
   return tchecker::make_range(begin, tchecker::past_the_end_iterator);
 }
@@ -155,18 +158,26 @@ incoming_synchronized_edges(tchecker::syncprod::system_t const & system,
 /* edges_iterator_t */
 
 edges_iterator_t::edges_iterator_t(tchecker::system::edge_const_shared_ptr_t const & edge, bool at_end)
-    : _async_edge(edge), _async_at_end(at_end)
+    : _async_edge(edge), _async_at_end(at_end), _array_it(nullptr)
 {
   assert(edge.get() != nullptr);
 }
 
 edges_iterator_t::edges_iterator_t(tchecker::syncprod::vloc_synchronized_edges_iterator_t::edges_iterator_t const & it)
-    : _async_edge(nullptr), _async_at_end(false), _sync_it(it)
+    : _async_edge(nullptr), _async_at_end(false), _sync_it(it), _array_it(nullptr)
+{
+}
+
+edges_iterator_t::edges_iterator_t(tchecker::system::edge_const_shared_ptr_t const * edge)
+    : _async_edge(nullptr), _async_at_end(false), _array_it(edge)
 {
+  assert(edge != nullptr);
 }
 
 bool edges_iterator_t::operator==(tchecker::syncprod::edges_iterator_t const & it) const
 {
+  if ((_array_it != nullptr) || (it._array_it != nullptr))
+    return (_array_it == it._array_it);
   return ((_async_edge == it._async_edge) && (_async_at_end == it._async_at_end) && (_sync_it == it._sync_it));
 }
 
@@ -174,6 +185,8 @@ bool edges_iterator_t::operator!=(tchecker::syncprod::edges_iterator_t const & i
 
 tchecker::system::edge_const_shared_ptr_t edges_iterator_t::operator*()
 {
+  if (_array_it != nullptr)
+    return *_array_it;
   if (_async_edge.get() == nullptr)
     return *_sync_it;
   return _async_edge;
@@ -181,7 +194,9 @@ tchecker::system::edge_const_shared_ptr_t edges_iterator_t::operator*()
 
 tchecker::syncprod::edges_iterator_t & edges_iterator_t::operator++()
 {
-  if (_async_edge.get() == nullptr)
+  if (_array_it != nullptr)
+    ++_array_it;
+  else if (_async_edge.get() == nullptr)
     ++_sync_it;
   else
     _async_at_end = true;
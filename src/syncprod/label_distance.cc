@@ -0,0 +1,70 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <stdexcept>
+
+#include "tchecker/syncprod/label_distance.hh"
+
+namespace tchecker {
+
+namespace syncprod {
+
+label_distance_t::label_distance_t(tchecker::syncprod::system_t const & system, boost::dynamic_bitset<> const & labels)
+    : _loc_number(system.locations_count())
+{
+  if (labels.size() != system.labels_count())
+    throw std::invalid_argument("Labels do not match the system");
+
+  for (std::size_t label = labels.find_first(); label != boost::dynamic_bitset<>::npos; label = labels.find_next(label))
+    _labels.push_back(static_cast<tchecker::label_id_t>(label));
+
+  // predecessors of locations in the location graphs of the processes
+  std::vector<std::vector<tchecker::loc_id_t>> predecessors(_loc_number);
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges())
+    predecessors[edge->tgt()].push_back(edge->src());
+
+  // backward breadth-first search from the locations with each label
+  _distance.assign(_labels.size() * _loc_number, UNREACHABLE);
+  std::deque<tchecker::loc_id_t> waiting;
+  for (std::size_t i = 0; i < _labels.size(); ++i) {
+    std::size_t * distance = _distance.data() + i * _loc_number;
+    for (tchecker::loc_id_t l = 0; l < _loc_number; ++l)
+      if (system.labels(l)[_labels[i]]) {
+        distance[l] = 0;
+        waiting.push_back(l);
+      }
+    for (; !waiting.empty(); waiting.pop_front()) {
+      tchecker::loc_id_t const l = waiting.front();
+      for (tchecker::loc_id_t pred : predecessors[l])
+        if (distance[pred] == UNREACHABLE) {
+          distance[pred] = distance[l] + 1;
+          waiting.push_back(pred);
+        }
+    }
+  }
+}
+
+std::size_t label_distance_t::distance(tchecker::vloc_t const & vloc) const
+{
+  std::size_t sum = 0;
+  for (std::size_t i = 0; i < _labels.size(); ++i) {
+    std::size_t const * distance = _distance.data() + i * _loc_number;
+    std::size_t d = UNREACHABLE;
+    for (tchecker::loc_id_t l : vloc) {
+      assert(l < _loc_number);
+      d = std::min(d, distance[l]);
+    }
+    if (d == UNREACHABLE)
+      return UNREACHABLE;
+    sum += d;
+  }
+  return sum;
+}
+
+} // end of namespace syncprod
+
+} // end of namespace tchecker
@@ -2,6 +2,7 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <stack>
 #include <tuple>
@@ -24,6 +25,7 @@ tchecker::syncprod::system_t::asynchronous_edges_collection_t const tchecker::sy
 system_t::system_t(tchecker::parsing::system_declaration_t const & sysdecl) : tchecker::system::system_t(sysdecl)
 {
   extract_asynchronous_edges();
+  index_synchronizations();
   compute_committed_locations();
   compute_labels();
 }
@@ -31,6 +33,7 @@ system_t::system_t(tchecker::parsing::system_declaration_t const & sysdecl) : tc
 system_t::system_t(tchecker::system::system_t const & system) : tchecker::system::system_t(system)
 {
   extract_asynchronous_edges();
+  index_synchronizations();
   compute_committed_locations();
   compute_labels();
 }
@@ -88,6 +91,38 @@ system_t::asynchronous_incoming_edges(tchecker::loc_id_t loc) const
                               asynchronous_edges_const_iterator_t(_async_incoming_edges[loc].end()));
 }
 
+/*!
+ \brief Merge synchronizations indexed by a tuple of locations
+ \param vloc : tuple of locations
+ \param syncs : map loc id -> synchronizations
+ \param unconditional_syncs : synchronizations without strong constraints
+ \return sorted union of unconditional_syncs and syncs[l] for all l in vloc
+ */
+static std::shared_ptr<tchecker::syncprod::system_t::sync_ids_t const>
+merge_synchronizations(tchecker::vloc_t const & vloc, std::vector<tchecker::syncprod::system_t::sync_ids_t> const & syncs,
+                       tchecker::syncprod::system_t::sync_ids_t const & unconditional_syncs)
+{
+  auto ids = std::make_shared<tchecker::syncprod::system_t::sync_ids_t>(unconditional_syncs);
+  for (tchecker::loc_id_t loc : vloc)
+    if (loc < syncs.size())
+      ids->insert(ids->end(), syncs[loc].begin(), syncs[loc].end());
+  // each synchronization is indexed by a single location, hence there are no duplicates
+  std::sort(ids->begin(), ids->end());
+  return ids;
+}
+
+std::shared_ptr<tchecker::syncprod::system_t::sync_ids_t const>
+system_t::outgoing_synchronizations(tchecker::vloc_t const & vloc) const
+{
+  return tchecker::syncprod::merge_synchronizations(vloc, _outgoing_syncs, _unconditional_syncs);
+}
+
+std::shared_ptr<tchecker::syncprod::system_t::sync_ids_t const>
+system_t::incoming_synchronizations(tchecker::vloc_t const & vloc) const
+{
+  return tchecker::syncprod::merge_synchronizations(vloc, _incoming_syncs, _unconditional_syncs);
+}
+
 boost::dynamic_bitset<> const & system_t::labels(tchecker::loc_id_t id) const
 {
   assert(is_location(id));
@@ -131,6 +166,54 @@ void system_t::extract_asynchronous_edges()
       add_asynchronous_edge(edge);
 }
 
+/*!
+ \brief Index synchronizations w.r.t. edges of locations
+ \param system : a system
+ \param loc_edges_maps : maps loc id -> edges/events
+ \param syncs : map loc id -> synchronizations
+ \param unconditional_syncs : synchronizations without strong constraints
+ \post every synchronization with strong constraints has been added to syncs[l] for each location l of process pid
+ with an edge on event in loc_edges_maps, where (pid, event) is the strong constraint satisfied by the fewest locations.
+ Every other synchronization has been added to unconditional_syncs. Identifiers are added in increasing order
+ */
+static void index_synchronizations(tchecker::system::system_t const & system,
+                                   tchecker::system::loc_edges_maps_t const & loc_edges_maps,
+                                   std::vector<tchecker::syncprod::system_t::sync_ids_t> & syncs,
+                                   tchecker::syncprod::system_t::sync_ids_t & unconditional_syncs)
+{
+  syncs.clear();
+  syncs.resize(system.locations_count());
+  unconditional_syncs.clear();
+
+  std::vector<tchecker::loc_id_t> locs, pivot_locs;
+  for (tchecker::system::synchronization_t const & sync : system.synchronizations()) {
+    bool strong = false;
+    for (tchecker::system::sync_constraint_t const & constr : sync.synchronization_constraints()) {
+      if (constr.strength() != tchecker::SYNC_STRONG)
+        continue;
+      locs.clear();
+      for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations(constr.pid()))
+        if (loc_edges_maps.event(loc->id(), constr.event_id()))
+          locs.push_back(loc->id());
+      if (!strong || locs.size() < pivot_locs.size())
+        pivot_locs.swap(locs);
+      strong = true;
+    }
+
+    if (!strong)
+      unconditional_syncs.push_back(sync.id());
+    else
+      for (tchecker::loc_id_t loc : pivot_locs)
+        syncs[loc].push_back(sync.id());
+  }
+}
+
+void system_t::index_synchronizations()
+{
+  tchecker::syncprod::index_synchronizations(*this, *outgoing_edges_maps(), _outgoing_syncs, _unconditional_syncs);
+  tchecker::syncprod::index_synchronizations(*this, *incoming_edges_maps(), _incoming_syncs, _unconditional_syncs);
+}
+
 void system_t::compute_committed_locations()
 {
   tchecker::loc_id_t locations_count = this->locations_count();
@@ -138,7 +221,7 @@ void system_t::compute_committed_locations()
 
   for (tchecker::loc_id_t id = 0; id < locations_count; ++id) {
     auto const & attr = tchecker::syncprod::system_t::location(id)->attributes();
-    set_committed(id, attr.range("committed"));
+    set_committed(id, attr.range(tchecker::system::ATTR_KEY_COMMITTED));
   }
 }
 
@@ -160,7 +243,7 @@ void system_t::compute_labels()
   std::vector<std::string> labels;
   for (tchecker::loc_id_t loc_id = 0; loc_id < locations_count; ++loc_id) {
     auto const & attr = tchecker::syncprod::system_t::location(loc_id)->attributes();
-    labels_from_attrs(attr.range("labels"), labels);
+    labels_from_attrs(attr.range(tchecker::system::ATTR_KEY_LABELS), labels);
   }
 
   for (std::string const & l : labels) {
@@ -179,7 +262,7 @@ void system_t::compute_labels()
     _labels[loc_id].reset();
     auto const & attr = tchecker::syncprod::system_t::location(loc_id)->attributes();
     labels.clear();
-    labels_from_attrs(attr.range("labels"), labels);
+    labels_from_attrs(attr.range(tchecker::system::ATTR_KEY_LABELS), labels);
     for (std::string const & l : labels)
       _labels[loc_id].set(this->label_id(l));
   }
@@ -69,9 +69,8 @@ void from_string(tchecker::vloc_t & vloc, tchecker::system::system_t const & sys
 
 int lexical_cmp(tchecker::vloc_t const & vloc1, tchecker::vloc_t const & vloc2)
 {
-  return tchecker::lexical_cmp(
-      vloc1.begin(), vloc1.end(), vloc2.begin(), vloc2.end(),
-      [](tchecker::loc_id_t id1, tchecker::loc_id_t id2) -> int { return (id1 < id2 ? -1 : (id1 == id2 ? 0 : 1)); });
+  return tchecker::lexical_cmp(static_cast<tchecker::loc_array_t const &>(vloc1),
+                               static_cast<tchecker::loc_array_t const &>(vloc2));
 }
 
 } // end of namespace tchecker
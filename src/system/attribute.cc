@@ -2,6 +2,10 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
 #include "tchecker/system/attribute.hh"
 
 namespace tchecker {
@@ -19,9 +23,32 @@ attr_parsing_position_t::attr_parsing_position_t(tchecker::parsing::attr_parsing
 
 attr_t::attr_t(tchecker::parsing::attr_t const & attr) : tchecker::parsing::attr_t(attr) {}
 
+/* attr_key_t */
+
+/*!
+ \brief Names of interned keys, indexed by tchecker::system::attr_key_t
+ */
+static std::array<std::string, tchecker::system::ATTR_KEY_OTHER> const attr_key_names = {
+    "committed", "do", "initial", "invariant", "label", "labels", "provided", "urgent"};
+
+enum tchecker::system::attr_key_t attr_key(std::string const & key)
+{
+  auto it = std::find(attr_key_names.begin(), attr_key_names.end(), key);
+  return static_cast<enum tchecker::system::attr_key_t>(it - attr_key_names.begin());
+}
+
+std::string const & attr_key_name(enum tchecker::system::attr_key_t key)
+{
+  if (key >= tchecker::system::ATTR_KEY_OTHER)
+    throw std::invalid_argument("Attribute key is not interned");
+  return attr_key_names[key];
+}
+
 /* attributes_t */
 
-attributes_t::attributes_t(tchecker::parsing::attributes_t const & attributes)
+attributes_t::attributes_t() { _groups.fill(std::make_pair(0, 0)); }
+
+attributes_t::attributes_t(tchecker::parsing::attributes_t const & attributes) : attributes_t()
 {
   for (tchecker::parsing::attr_t const & attr : attributes)
     add_attribute(attr.key(), attr.value(), tchecker::system::attr_parsing_position_t{attr.parsing_position()});
@@ -30,7 +57,15 @@ attributes_t::attributes_t(tchecker::parsing::attributes_t const & attributes)
 void attributes_t::add_attribute(std::string const & key, std::string const & value,
                                  tchecker::system::attr_parsing_position_t const & parsing_position)
 {
-  _map.insert(std::make_pair(key, tchecker::system::attr_t{key, value, parsing_position}));
+  if (_attributes.size() >= std::numeric_limits<std::uint32_t>::max())
+    throw std::overflow_error("Too many attributes");
+
+  // new attribute goes at the end of the group of key, or at the end of the container if there is no such group
+  auto it = std::find_if(_attributes.rbegin(), _attributes.rend(),
+                         [&key](tchecker::system::attr_t const & attr) { return attr.key() == key; });
+  _attributes.insert((it == _attributes.rend() ? _attributes.end() : it.base()),
+                     tchecker::system::attr_t{key, value, parsing_position});
+  index_groups();
 }
 
 void attributes_t::add_attributes(tchecker::system::attributes_t const & attr)
@@ -39,17 +74,39 @@ void attributes_t::add_attributes(tchecker::system::attributes_t const & attr)
     add_attribute(attr.key(), attr.value(), attr.parsing_position());
 }
 
-attributes_t::const_iterator_t::const_iterator_t(map_t::const_iterator const & it) : map_t::const_iterator(it) {}
+attributes_t::const_iterator_t::const_iterator_t(container_t::const_iterator const & it) : container_t::const_iterator(it) {}
 
 tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> attributes_t::range(std::string const & key) const
 {
-  auto range = _map.equal_range(key);
-  return tchecker::make_range<tchecker::system::attributes_t::const_iterator_t>(range.first, range.second);
+  enum tchecker::system::attr_key_t const k = tchecker::system::attr_key(key);
+  if (k != tchecker::system::ATTR_KEY_OTHER)
+    return range(k);
+
+  auto has_key = [&key](tchecker::system::attr_t const & attr) { return attr.key() == key; };
+  auto first = std::find_if(_attributes.begin(), _attributes.end(), has_key);
+  auto last = std::find_if_not(first, _attributes.end(), has_key);
+  return tchecker::make_range<tchecker::system::attributes_t::const_iterator_t>(first, last);
 }
 
 tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> attributes_t::range() const
 {
-  return tchecker::make_range<tchecker::system::attributes_t::const_iterator_t>(_map.begin(), _map.end());
+  return tchecker::make_range<tchecker::system::attributes_t::const_iterator_t>(_attributes.begin(), _attributes.end());
+}
+
+void attributes_t::index_groups()
+{
+  _groups.fill(std::make_pair(0, 0));
+  std::uint32_t const size = static_cast<std::uint32_t>(_attributes.size());
+  std::uint32_t first = 0;
+  while (first < size) {
+    std::uint32_t last = first + 1;
+    while (last < size && _attributes[last].key() == _attributes[first].key())
+      ++last;
+    enum tchecker::system::attr_key_t const k = tchecker::system::attr_key(_attributes[first].key());
+    if (k != tchecker::system::ATTR_KEY_OTHER)
+      _groups[k] = std::make_pair(first, last);
+    first = last;
+  }
 }
 
 } // end of namespace system
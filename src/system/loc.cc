@@ -79,7 +79,7 @@ void locs_t::add_location(tchecker::process_id_t pid, std::string const & name,
 
   _locs.push_back(loc);
 
-  auto range = attributes.range("initial");
+  auto range = attributes.range(tchecker::system::ATTR_KEY_INITIAL);
   if (range.begin() != range.end()) {
     if (pid >= _initial_locs.size())
       _initial_locs.resize(pid + 1);
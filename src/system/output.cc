@@ -3,6 +3,7 @@
  */
 
 #include "tchecker/system/output.hh"
+#include "tchecker/utils/string.hh"
 
 namespace tchecker {
 
@@ -109,7 +110,7 @@ static void output_dot(std::ostream & os, tchecker::system::loc_const_shared_ptr
 {
   os << dot_node_name(s.process_name(loc->pid()), loc->name(), delimiter);
   tchecker::system::attributes_t attributes{loc->attributes()};
-  if (!attributes.range("label").empty())
+  if (!attributes.range(tchecker::system::ATTR_KEY_LABEL).empty())
     throw std::runtime_error("location already has a \"label\" attribute");
   attributes.add_attribute("label", loc->name(), tchecker::system::attr_parsing_position_t());
   output_dot(os, attributes);
@@ -123,7 +124,7 @@ static void output_dot(std::ostream & os, tchecker::system::edge_const_shared_pt
   std::string tgt_name = s.location(edge->tgt())->name();
   os << dot_node_name(pname, src_name, delimiter) << " -> " << dot_node_name(pname, tgt_name, delimiter);
   tchecker::system::attributes_t attributes{edge->attributes()};
-  if (!attributes.range("label").empty())
+  if (!attributes.range(tchecker::system::ATTR_KEY_LABEL).empty())
     throw std::runtime_error("edge already has a \"label\" attribute");
   attributes.add_attribute("label", s.event_name(edge->event_id()), tchecker::system::attr_parsing_position_t());
   output_dot(os, attributes);
@@ -201,9 +202,12 @@ static void json_output_attributes(std::ostream & os, tchecker::system::attribut
     for (auto it = begin; it != end; ++it) {
       if (it != begin)
         os << "," << std::endl;
-      os << t1 << "\"" << (*it).key() << "\" : \"" << (*it).value() << "\"";
+      os << t1;
+      tchecker::output_json_string(os, (*it).key());
+      os << " : ";
+      tchecker::output_json_string(os, (*it).value());
     }
-    os << t1 << std::endl;
+    os << std::endl;
   }
   os << t0 << "}" << std::endl;
 }
@@ -217,9 +221,11 @@ static void json_output_location(std::ostream & os, tchecker::system::system_t c
 
   if (!first)
     os << "," << std::endl;
-  os << t0 << "{" << std::endl << t1 << "\"id\" : \"" << locid << "\"," << std::endl;
+  os << t0 << "{" << std::endl << t1 << "\"id\" : ";
+  tchecker::output_json_string(os, locid);
+  os << "," << std::endl;
   tchecker::system::attributes_t attributes{loc->attributes()};
-  if (!attributes.range("label").empty())
+  if (!attributes.range(tchecker::system::ATTR_KEY_LABEL).empty())
     throw std::runtime_error("location already has a \"label\" attribute");
   attributes.add_attribute("label", loc->name(), tchecker::system::attr_parsing_position_t());
   json_output_attributes(os, attributes, t1);
@@ -237,11 +243,13 @@ static void json_output_edge(std::ostream & os, tchecker::system::system_t const
   std::string tgt_name = s.location(edge->tgt())->name();
   if (!first)
     os << "," << std::endl;
-  os << t0 << "{" << std::endl
-     << t1 << "\"src\" : \"" << dot_node_name(pname, src_name, delimiter) << "\"," << std::endl
-     << t1 << "\"tgt\" : \"" << dot_node_name(pname, tgt_name, delimiter) << "\"," << std::endl;
+  os << t0 << "{" << std::endl << t1 << "\"src\" : ";
+  tchecker::output_json_string(os, dot_node_name(pname, src_name, delimiter));
+  os << "," << std::endl << t1 << "\"tgt\" : ";
+  tchecker::output_json_string(os, dot_node_name(pname, tgt_name, delimiter));
+  os << "," << std::endl;
   tchecker::system::attributes_t attributes{edge->attributes()};
-  if (!attributes.range("label").empty())
+  if (!attributes.range(tchecker::system::ATTR_KEY_LABEL).empty())
     throw std::runtime_error("edge already has a \"label\" attribute");
   attributes.add_attribute("label", s.event_name(edge->event_id()), tchecker::system::attr_parsing_position_t());
   json_output_attributes(os, attributes, t1);
@@ -252,9 +260,11 @@ static void json_output_process(std::ostream & os, tchecker::system::system_t co
                                 tchecker::process_id_t pid, std::string const t0)
 {
   std::string const t1 = t0 + json_tab;
-  os << t0 << "{" << std::endl
-     << t1 << "\"pid\" : \"" << s.process_name(pid) << "\"," << std::endl
-     << t1 << "\"locations\" : [" << std::endl;
+  os << t0 << "{" << std::endl << t1 << "\"pid\" : ";
+  tchecker::output_json_string(os, s.process_name(pid));
+  os << "," << std::endl;
+  json_output_attributes(os, s.process_attributes(pid), t1);
+  os << t1 << "\"locations\" : [" << std::endl;
   // Locations
   bool first = true;
   for (tchecker::system::loc_const_shared_ptr_t loc : s.locations()) {
@@ -294,10 +304,8 @@ static void json_output_sync(std::ostream & os, tchecker::system::synchronizatio
     if (it != r.begin())
       os << ", ";
     tchecker::system::sync_constraint_t const & constr = *it;
-    os << "\"" << s.process_name(constr.pid()) << "@" << s.event_name(constr.event_id());
-    if (constr.strength() == tchecker::SYNC_WEAK)
-      os << "?";
-    os << "\"";
+    tchecker::output_json_string(os, s.process_name(constr.pid()) + "@" + s.event_name(constr.event_id()) +
+                                         (constr.strength() == tchecker::SYNC_WEAK ? "?" : ""));
   }
   os << " ]";
 }
@@ -305,7 +313,55 @@ static void json_output_sync(std::ostream & os, tchecker::system::synchronizatio
 void output_json(std::ostream & os, tchecker::system::system_t const & s, std::string const & delimiter)
 {
   std::string const t1 = json_tab;
-  os << "{" << std::endl << t1 << "\"name\" : \"" << s.name() << "\"," << std::endl << t1 << "\"processes\" : [" << std::endl;
+  std::string const t2 = t1 + json_tab;
+  std::string const t3 = t2 + json_tab;
+  os << "{" << std::endl << t1 << "\"name\" : ";
+  tchecker::output_json_string(os, s.name());
+  os << "," << std::endl;
+  json_output_attributes(os, s.attributes(), t1);
+
+  // Events, clocks and bounded integer variables
+  os << t1 << "\"events\" : [" << std::endl;
+  tchecker::event_id_t events_count = s.events_count();
+  for (tchecker::event_id_t id = 0; id < events_count; ++id) {
+    os << t2 << "{" << std::endl << t3 << "\"name\" : ";
+    tchecker::output_json_string(os, s.event_name(id));
+    os << "," << std::endl;
+    json_output_attributes(os, s.event_attributes(id), t3);
+    os << t2 << "}" << (id + 1 < events_count ? "," : "") << std::endl;
+  }
+  os << t1 << "]," << std::endl;
+
+  os << t1 << "\"clocks\" : [" << std::endl;
+  tchecker::clock_variables_t const & clock_variables = s.clock_variables();
+  tchecker::clock_id_t clocks_count = s.clocks_count(tchecker::VK_DECLARED);
+  for (tchecker::clock_id_t id = 0; id < clocks_count; ++id) {
+    os << t2 << "{" << std::endl << t3 << "\"name\" : ";
+    tchecker::output_json_string(os, clock_variables.name(id));
+    os << "," << std::endl << t3 << "\"size\" : " << clock_variables.info(id).size() << "," << std::endl;
+    json_output_attributes(os, s.clock_attributes(id), t3);
+    os << t2 << "}" << (id + 1 < clocks_count ? "," : "") << std::endl;
+  }
+  os << t1 << "]," << std::endl;
+
+  os << t1 << "\"ints\" : [" << std::endl;
+  tchecker::integer_variables_t const & integer_variables = s.integer_variables();
+  tchecker::intvar_id_t intvars_count = s.intvars_count(tchecker::VK_DECLARED);
+  for (tchecker::intvar_id_t id = 0; id < intvars_count; ++id) {
+    tchecker::intvar_info_t const & info = integer_variables.info(id);
+    os << t2 << "{" << std::endl << t3 << "\"name\" : ";
+    tchecker::output_json_string(os, integer_variables.name(id));
+    os << "," << std::endl
+       << t3 << "\"size\" : " << info.size() << "," << std::endl
+       << t3 << "\"min\" : " << info.min() << "," << std::endl
+       << t3 << "\"max\" : " << info.max() << "," << std::endl
+       << t3 << "\"init\" : " << info.initial_value() << "," << std::endl;
+    json_output_attributes(os, s.intvar_attributes(id), t3);
+    os << t2 << "}" << (id + 1 < intvars_count ? "," : "") << std::endl;
+  }
+  os << t1 << "]," << std::endl;
+
+  os << t1 << "\"processes\" : [" << std::endl;
 
   tchecker::process_id_t processes_count = s.processes_count();
   for (tchecker::process_id_t pid = 0; pid < processes_count; ++pid) {
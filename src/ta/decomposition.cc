@@ -0,0 +1,359 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <iterator>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "tchecker/parsing/declaration_filter.hh"
+#include "tchecker/ta/decomposition.hh"
+#include "tchecker/ta/system_ha.hh"
+#include "tchecker/variables/access.hh"
+#include "tchecker/variables/static_analysis.hh"
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \class interface_t
+ \brief Processes that share each synchronization, clock and bounded integer variable of a system
+ */
+class interface_t {
+public:
+  /*!
+   \brief Constructor
+   \param system : a system of timed processes
+   */
+  explicit interface_t(tchecker::ta::system_t const & system) : _processes_count(system.processes_count())
+  {
+    for (tchecker::system::synchronization_t const & sync : system.synchronizations()) {
+      boost::dynamic_bitset<> & processes = _syncs.emplace_back(_processes_count);
+      for (tchecker::system::sync_constraint_t const & c : sync.synchronization_constraints())
+        processes.set(c.pid());
+    }
+
+    tchecker::variable_access_map_t const access = tchecker::variable_access(system);
+
+    // declared variables are accessed by a process if one of their flattened variables is
+    tchecker::integer_variables_t const & integer_variables = system.integer_variables();
+    for (auto && [id, name] : integer_variables.index()) {
+      boost::dynamic_bitset<> & processes = _intvars.emplace_back(_processes_count);
+      for (tchecker::intvar_id_t v = id; v < id + integer_variables.info(id).size(); ++v)
+        for (tchecker::process_id_t pid : access.accessing_processes(v, tchecker::VTYPE_INTVAR, tchecker::VACCESS_ANY))
+          processes.set(pid);
+    }
+
+    tchecker::clock_variables_t const & clock_variables = system.clock_variables();
+    for (auto && [id, name] : clock_variables.index()) {
+      auto & [processes, size] =
+          _clocks.emplace_back(boost::dynamic_bitset<>{_processes_count}, clock_variables.info(id).size());
+      for (tchecker::clock_id_t x = id; x < id + size; ++x)
+        for (tchecker::process_id_t pid : access.accessing_processes(x, tchecker::VTYPE_CLOCK, tchecker::VACCESS_ANY))
+          processes.set(pid);
+    }
+  }
+
+  /*!
+   \brief Accessor
+   \return number of processes
+   */
+  inline std::size_t processes_count() const { return _processes_count; }
+
+  /*!
+   \brief Accessor
+   \return processes accessing each declared clock, along with the size of the clock
+   */
+  inline std::vector<std::tuple<boost::dynamic_bitset<>, std::size_t>> const & clocks() const { return _clocks; }
+
+  /*!
+   \brief Evaluate a decomposition
+   \param property : processes of the property
+   \return the decomposition of the system with property
+   */
+  tchecker::ta::decomposition_t evaluate(boost::dynamic_bitset<> const & property) const
+  {
+    tchecker::ta::decomposition_t d{property, 0, 0, 0, 0};
+    auto shared = [&](boost::dynamic_bitset<> const & processes) {
+      return processes.intersects(property) && !processes.is_subset_of(property);
+    };
+    for (boost::dynamic_bitset<> const & processes : _syncs)
+      if (shared(processes))
+        ++d.interface_syncs;
+    for (boost::dynamic_bitset<> const & processes : _intvars)
+      if (shared(processes))
+        ++d.interface_intvars;
+    for (auto && [processes, size] : _clocks) {
+      if (processes.intersects(property))
+        d.property_clocks += size;
+      else if (processes.any())
+        d.environment_clocks += size;
+    }
+    return d;
+  }
+
+private:
+  std::size_t _processes_count;                                        /*!< Number of processes */
+  std::vector<boost::dynamic_bitset<>> _syncs;                         /*!< Processes of each synchronization */
+  std::vector<boost::dynamic_bitset<>> _intvars;                       /*!< Processes accessing each variable */
+  std::vector<std::tuple<boost::dynamic_bitset<>, std::size_t>> _clocks; /*!< Processes accessing each clock, size */
+};
+
+/*!
+ \brief Order on decompositions
+ \param d1 : decomposition
+ \param d2 : decomposition
+ \return true if d1 has a smaller interface than d2, or the same interface and fewer clocks in the property, or the
+ same interface and clocks and fewer processes in the property, false otherwise
+ */
+static bool better(tchecker::ta::decomposition_t const & d1, tchecker::ta::decomposition_t const & d2)
+{
+  return std::make_tuple(d1.interface_size(), d1.property_clocks, d1.property.count()) <
+         std::make_tuple(d2.interface_size(), d2.property_clocks, d2.property.count());
+}
+
+/*!
+ \brief Compute the groups of processes that share clocks
+ \param interface : interface of a system
+ \return the partition of the processes of interface in groups of processes that share clocks (transitively)
+ */
+static std::vector<boost::dynamic_bitset<>> clock_groups(tchecker::ta::interface_t const & interface)
+{
+  std::size_t const processes_count = interface.processes_count();
+  std::vector<tchecker::process_id_t> parent(processes_count);
+  std::iota(parent.begin(), parent.end(), 0);
+  auto find = [&](tchecker::process_id_t pid) {
+    while (parent[pid] != pid)
+      pid = parent[pid] = parent[parent[pid]];
+    return pid;
+  };
+
+  for (auto && [processes, size] : interface.clocks()) {
+    if (processes.none())
+      continue;
+    std::size_t const first = processes.find_first();
+    for (std::size_t pid = processes.find_next(first); pid != boost::dynamic_bitset<>::npos; pid = processes.find_next(pid))
+      parent[find(pid)] = find(first);
+  }
+
+  std::vector<boost::dynamic_bitset<>> groups;
+  std::unordered_map<tchecker::process_id_t, std::size_t> group_of_root;
+  for (tchecker::process_id_t pid = 0; pid < processes_count; ++pid) {
+    auto [it, inserted] = group_of_root.try_emplace(find(pid), groups.size());
+    if (inserted)
+      groups.emplace_back(processes_count);
+    groups[it->second].set(pid);
+  }
+  return groups;
+}
+
+tchecker::ta::decomposition_t decompose(tchecker::ta::system_t const & system, std::string const & labels, bool strict)
+{
+  boost::dynamic_bitset<> const accepting = system.as_syncprod_system().labels(labels);
+  if (accepting.none())
+    throw std::invalid_argument("The property of a decomposition is found from the searched labels");
+
+  tchecker::ta::interface_t const interface{system};
+  std::vector<boost::dynamic_bitset<>> const groups = tchecker::ta::clock_groups(interface);
+
+  // the property contains the groups of the processes with a searched label, the other groups are free
+  boost::dynamic_bitset<> seed{system.processes_count()};
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
+    if ((system.labels(loc->id()) & accepting).any())
+      seed.set(loc->pid());
+  std::vector<boost::dynamic_bitset<>> free;
+  for (boost::dynamic_bitset<> const & group : groups) {
+    if (group.intersects(seed))
+      seed |= group;
+    else
+      free.push_back(group);
+  }
+  if (free.size() < (strict ? 2 : 1))
+    throw std::invalid_argument("No decomposition with a non-empty environment");
+
+  tchecker::ta::decomposition_t best = interface.evaluate(seed);
+
+  if (groups.size() <= tchecker::ta::DECOMPOSITION_EXHAUSTIVE_GROUPS) {
+    // the mask with all free groups leaves an empty environment. A strict decomposition is not the seed (mask 0)
+    bool found = !strict;
+    for (std::size_t mask = 1; mask + 1 < (std::size_t{1} << free.size()); ++mask) {
+      boost::dynamic_bitset<> property = seed;
+      for (std::size_t i = 0; i < free.size(); ++i)
+        if (mask & (std::size_t{1} << i))
+          property |= free[i];
+      tchecker::ta::decomposition_t const d = interface.evaluate(property);
+      if (!found || tchecker::ta::better(d, best)) {
+        best = d;
+        found = true;
+      }
+    }
+    return best;
+  }
+
+  // greedy: add the free group that improves the decomposition most, while the environment has two groups or more
+  std::vector<bool> added(free.size(), false);
+  for (std::size_t remaining = free.size(); remaining > 1; --remaining) {
+    std::size_t best_group = free.size();
+    tchecker::ta::decomposition_t best_step = best;
+    bool const forced = (strict && remaining == free.size());
+    for (std::size_t i = 0; i < free.size(); ++i) {
+      if (added[i])
+        continue;
+      tchecker::ta::decomposition_t const d = interface.evaluate(best.property | free[i]);
+      if ((forced && best_group == free.size()) || tchecker::ta::better(d, best_step)) {
+        best_step = d;
+        best_group = i;
+      }
+    }
+    if (best_group == free.size())
+      break;
+    added[best_group] = true;
+    best = best_step;
+  }
+  return best;
+}
+
+/*!
+ \brief Kind of synchronizations of a split declaration
+ */
+enum split_syncs_t {
+  SPLIT_SYNCS_NONE,       /*!< No synchronization */
+  SPLIT_SYNCS_RESTRICTED, /*!< Synchronizations restricted to the kept processes, if they synchronize two processes */
+};
+
+/*!
+ \class splitter_t
+ \brief Visitor that copies the declarations of a part of a system declaration
+ */
+class splitter_t : public tchecker::parsing::declaration_filter_t {
+public:
+  /*!
+   \brief Constructor
+   \param split : split system declaration
+   \param processes : names of kept processes
+   \param clocks : names of kept clocks
+   \param events : names of kept events (before renaming)
+   \param renamed : map event name -> new name (events not in the map keep their name)
+   \param syncs : kind of synchronizations of split
+   \note all the bounded integer variables are kept. A synchronization of the whole system is kept, even on a single
+   process
+   */
+  splitter_t(tchecker::parsing::system_declaration_t & split, std::set<std::string> const & processes,
+             std::set<std::string> const & clocks, std::set<std::string> const & events,
+             std::unordered_map<std::string, std::string> const & renamed, enum tchecker::ta::split_syncs_t syncs)
+      : tchecker::parsing::declaration_filter_t(split), _processes(processes), _clocks(clocks), _events(events),
+        _renamed(renamed), _syncs(syncs)
+  {
+  }
+
+protected:
+  using tchecker::parsing::declaration_filter_t::keep;
+
+  virtual bool keep(tchecker::parsing::clock_declaration_t const & d) { return _clocks.count(d.name()) != 0; }
+
+  virtual bool keep(tchecker::parsing::process_declaration_t const & d) { return _processes.count(d.name()) != 0; }
+
+  virtual bool keep(tchecker::parsing::event_declaration_t const & d) { return _events.count(d.name()) != 0; }
+
+  virtual bool keep(tchecker::parsing::location_declaration_t const & d)
+  {
+    return _processes.count(d.process().name()) != 0;
+  }
+
+  virtual bool keep(tchecker::parsing::edge_declaration_t const & d, tchecker::edge_id_t id)
+  {
+    return _processes.count(d.process().name()) != 0;
+  }
+
+  virtual bool keep(tchecker::parsing::sync_declaration_t const & d, tchecker::sync_id_t id)
+  {
+    return _syncs != tchecker::ta::SPLIT_SYNCS_NONE;
+  }
+
+  virtual bool keep(tchecker::parsing::sync_constraint_t const & c)
+  {
+    return _processes.count(c.process().name()) != 0;
+  }
+
+  virtual std::string const & event_name(std::string const & name) const
+  {
+    auto it = _renamed.find(name);
+    return (it == _renamed.end() ? name : it->second);
+  }
+
+private:
+  std::set<std::string> const & _processes;                         /*!< Kept processes */
+  std::set<std::string> const & _clocks;                            /*!< Kept clocks */
+  std::set<std::string> const & _events;                            /*!< Kept events */
+  std::unordered_map<std::string, std::string> const & _renamed;    /*!< Renamed events */
+  enum tchecker::ta::split_syncs_t _syncs;                          /*!< Kind of synchronizations */
+};
+
+std::tuple<std::shared_ptr<tchecker::parsing::system_declaration_t>, std::shared_ptr<tchecker::parsing::system_declaration_t>,
+           std::shared_ptr<tchecker::parsing::system_declaration_t>>
+split(tchecker::parsing::system_declaration_t const & sysdecl, tchecker::ta::decomposition_t const & decomposition)
+{
+  tchecker::ta::system_t const system{sysdecl};
+  boost::dynamic_bitset<> const & property = decomposition.property;
+
+  std::set<std::string> all_processes, property_processes, environment_processes;
+  for (tchecker::process_id_t pid = 0; pid < system.processes_count(); ++pid) {
+    all_processes.insert(system.process_name(pid));
+    (property[pid] ? property_processes : environment_processes).insert(system.process_name(pid));
+  }
+
+  std::set<std::string> all_clocks, property_clocks, environment_clocks;
+  tchecker::ta::interface_t const interface{system};
+  tchecker::clock_variables_t const & clock_variables = system.clock_variables();
+  std::size_t i = 0;
+  for (auto && [id, name] : clock_variables.index()) {
+    boost::dynamic_bitset<> const & processes = std::get<0>(interface.clocks()[i++]);
+    all_clocks.insert(name);
+    if (processes.intersects(property))
+      property_clocks.insert(name);
+    if (!processes.is_subset_of(property))
+      environment_clocks.insert(name);
+  }
+
+  std::set<std::string> all_events, property_events, environment_events;
+  for (tchecker::event_id_t id = 0; id < system.events_count(); ++id)
+    all_events.insert(system.event_name(id));
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges())
+    (property[edge->pid()] ? property_events : environment_events).insert(system.event_name(edge->event_id()));
+  for (tchecker::system::synchronization_t const & sync : system.synchronizations())
+    for (tchecker::system::sync_constraint_t const & c : sync.synchronization_constraints())
+      (property[c.pid()] ? property_events : environment_events).insert(system.event_name(c.event_id()));
+
+  // the events of the property that the environment does not know are epsilon events
+  std::unordered_map<std::string, std::string> renamed;
+  for (std::string const & event : property_events)
+    if (environment_events.find(event) == environment_events.end() && !tchecker::ta_ha::is_epsilon_event_name(event)) {
+      if (all_events.find("_" + event) != all_events.end())
+        throw std::invalid_argument("Event _" + event + " is already declared, event " + event + " cannot be renamed");
+      renamed[event] = "_" + event;
+    }
+
+  auto declaration = [&](std::set<std::string> const & processes, std::set<std::string> const & clocks,
+                         std::set<std::string> const & events, enum tchecker::ta::split_syncs_t syncs) {
+    tchecker::parsing::attributes_t attr(sysdecl.attributes());
+    std::shared_ptr<tchecker::parsing::system_declaration_t> d{
+        new tchecker::parsing::system_declaration_t(sysdecl.name(), std::move(attr), sysdecl.context())};
+    tchecker::ta::splitter_t splitter{*d, processes, clocks, events, renamed, syncs};
+    sysdecl.visit(splitter);
+    return d;
+  };
+
+  return std::make_tuple(
+      declaration(all_processes, all_clocks, all_events, tchecker::ta::SPLIT_SYNCS_RESTRICTED),
+      declaration(property_processes, property_clocks, property_events, tchecker::ta::SPLIT_SYNCS_NONE),
+      declaration(environment_processes, environment_clocks, environment_events, tchecker::ta::SPLIT_SYNCS_RESTRICTED));
+}
+
+} // end of namespace ta
+
+} // end of namespace tchecker
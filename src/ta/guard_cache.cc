@@ -0,0 +1,79 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <cstdint>
+
+#include "tchecker/ta/guard_cache.hh"
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \brief Largest power of 2 not greater than n
+ \param n : a size
+ \return largest power of 2 not greater than n, 1 if n is 0
+ */
+static std::size_t floor_power_of_2(std::size_t n)
+{
+  std::size_t p = 1;
+  while (p <= n / 2)
+    p *= 2;
+  return p;
+}
+
+guard_cache_t::guard_cache_t(std::size_t size) : _entries(floor_power_of_2(size)), _mask(_entries.size() - 1) {}
+
+bool guard_cache_t::holds(tchecker::ta::system_t const & system,
+                          tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t const> const & intval,
+                          tchecker::edge_id_t id)
+{
+  if (system.static_guard(id) != nullptr)
+    return true;
+
+  std::uint64_t h = reinterpret_cast<std::uintptr_t>(intval.ptr()) ^ (static_cast<std::uint64_t>(id) * 0x9e3779b97f4a7c15ULL);
+  h ^= (h >> 29);
+  entry_t & entry = _entries[h & _mask];
+  if (entry._intval.ptr() == intval.ptr() && entry._edge == id)
+    return entry._holds;
+
+  // guards do not assign variables, hence intval is not modified
+  bool holds = true;
+  try {
+    tchecker::intval_t & v = const_cast<tchecker::shared_intval_t &>(*intval);
+    tchecker::native_function_t native = system.native_guard(id);
+    holds = ((native != nullptr ? native(v, _clkconstr, _clkreset)
+                                : system.vm().run(system.guard_bytecode(id), v, _clkconstr, _clkreset)) != 0);
+  }
+  catch (...) {
+    holds = true;
+  }
+  _clkconstr.clear();
+  _clkreset.clear();
+
+  entry._intval = intval;
+  entry._edge = id;
+  entry._holds = holds;
+  return holds;
+}
+
+bool guard_cache_t::holds(tchecker::ta::system_t const & system,
+                          tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t const> const & intval,
+                          tchecker::syncprod::outgoing_edges_value_t const & edges)
+{
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : edges)
+    if (!holds(system, intval, edge->id()))
+      return false;
+  return true;
+}
+
+void guard_cache_t::clear()
+{
+  for (entry_t & entry : _entries)
+    entry._intval.reset();
+}
+
+} // end of namespace ta
+
+} // end of namespace tchecker
@@ -0,0 +1,217 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <algorithm>
+#include <stack>
+#include <unordered_set>
+#include <vector>
+
+#include "tchecker/expression/static_analysis.hh"
+#include "tchecker/statement/static_analysis.hh"
+#include "tchecker/system/static_analysis.hh"
+#include "tchecker/ta/por.hh"
+#include "tchecker/variables/access.hh"
+#include "tchecker/variables/static_analysis.hh"
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \brief Check if the bounded integer variables of an expression are local to a process
+ \param intvars : bounded integer variables
+ \param pid : process identifier
+ \param access : variable access map
+ \return true if every variable in intvars is only accessed by process pid, false otherwise
+ */
+static bool local_intvars(std::unordered_set<tchecker::intvar_id_t> const & intvars, tchecker::process_id_t pid,
+                          tchecker::variable_access_map_t const & access)
+{
+  for (tchecker::intvar_id_t id : intvars)
+    for (tchecker::process_id_t accessing_pid : access.accessing_processes(id, tchecker::VTYPE_INTVAR, tchecker::VACCESS_ANY))
+      if (accessing_pid != pid)
+        return false;
+  return true;
+}
+
+/*!
+ \brief Check if a location may be left independently from the other processes
+ \param system : a system of timed processes
+ \param id : location identifier
+ \return true if location id is neither committed nor urgent, and its invariant does not involve clocks
+ */
+static bool independent_location(tchecker::ta::system_t const & system, tchecker::loc_id_t id)
+{
+  if (system.is_committed(id) || system.is_urgent(id))
+    return false;
+  std::unordered_set<tchecker::clock_id_t> clocks;
+  std::unordered_set<tchecker::intvar_id_t> intvars;
+  tchecker::extract_variables(system.invariant(id), clocks, intvars);
+  return clocks.empty();
+}
+
+/*!
+ \brief Check if an edge is independent from the other processes
+ \param system : a system of timed processes
+ \param edge : an edge
+ \param access : variable access map
+ \param weak_events : weakly synchronized events
+ \param labels : searched labels
+ \return true if edge is asynchronous, its guard and statement do not involve clocks, its bounded integer variables are
+ only accessed by its process, its target location is independent (see independent_location) and has no outgoing edge on
+ a weakly synchronized event (that the other processes would synchronize with after edge), and its source and target
+ locations have the same searched labels, false otherwise
+ */
+static bool independent_edge(tchecker::ta::system_t const & system, tchecker::system::edge_t const & edge,
+                             tchecker::variable_access_map_t const & access, tchecker::system::process_events_map_t & weak_events,
+                             boost::dynamic_bitset<> const & labels)
+{
+  if (!system.is_asynchronous(edge) || !independent_location(system, edge.tgt()))
+    return false;
+
+  for (tchecker::system::edge_const_shared_ptr_t const & tgt_edge : system.outgoing_edges(edge.tgt()))
+    if (weak_events.contains(edge.pid(), tgt_edge->event_id()))
+      return false;
+
+  if ((system.labels(edge.src()) & labels) != (system.labels(edge.tgt()) & labels))
+    return false;
+
+  std::unordered_set<tchecker::clock_id_t> clocks;
+  std::unordered_set<tchecker::intvar_id_t> intvars;
+  tchecker::extract_variables(system.guard(edge.id()), clocks, intvars);
+  tchecker::extract_read_variables(system.statement(edge.id()), clocks, intvars);
+  tchecker::extract_written_variables(system.statement(edge.id()), clocks, intvars);
+  return clocks.empty() && local_intvars(intvars, edge.pid(), access);
+}
+
+/*!
+ \brief Remove locations on cycles
+ \param system : a system of timed processes
+ \param candidates : candidate locations
+ \post all locations on a cycle of edges between candidate locations have been removed from candidates
+ \note iterative Tarjan's algorithm on the graph of edges between candidate locations
+ */
+static void remove_cycles(tchecker::ta::system_t const & system, boost::dynamic_bitset<> & candidates)
+{
+  std::size_t const count = candidates.size();
+  std::size_t const undefined = count;
+  std::vector<std::size_t> index(count, undefined), lowlink(count, undefined);
+  std::vector<bool> on_stack(count, false);
+  std::vector<tchecker::loc_id_t> scc_stack;
+  boost::dynamic_bitset<> on_cycle(count);
+  std::size_t next_index = 0;
+
+  // DFS stack of (location, successors, next successor)
+  struct frame_t {
+    tchecker::loc_id_t loc;
+    std::vector<tchecker::loc_id_t> succs;
+    std::size_t next;
+  };
+
+  auto successors = [&](tchecker::loc_id_t loc) {
+    std::vector<tchecker::loc_id_t> succs;
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : system.outgoing_edges(loc)) {
+      if (!candidates[edge->tgt()])
+        continue;
+      if (edge->tgt() == loc)
+        on_cycle[loc] = true;
+      succs.push_back(edge->tgt());
+    }
+    return succs;
+  };
+
+  for (tchecker::loc_id_t root = 0; root < count; ++root) {
+    if (!candidates[root] || index[root] != undefined)
+      continue;
+
+    std::stack<frame_t> dfs;
+    index[root] = lowlink[root] = next_index++;
+    scc_stack.push_back(root);
+    on_stack[root] = true;
+    dfs.push(frame_t{root, successors(root), 0});
+
+    while (!dfs.empty()) {
+      frame_t & f = dfs.top();
+      if (f.next < f.succs.size()) {
+        tchecker::loc_id_t succ = f.succs[f.next++];
+        if (index[succ] == undefined) {
+          index[succ] = lowlink[succ] = next_index++;
+          scc_stack.push_back(succ);
+          on_stack[succ] = true;
+          dfs.push(frame_t{succ, successors(succ), 0});
+        }
+        else if (on_stack[succ])
+          lowlink[f.loc] = std::min(lowlink[f.loc], index[succ]);
+        continue;
+      }
+
+      tchecker::loc_id_t loc = f.loc;
+      dfs.pop();
+      if (!dfs.empty())
+        lowlink[dfs.top().loc] = std::min(lowlink[dfs.top().loc], lowlink[loc]);
+
+      if (lowlink[loc] == index[loc]) {
+        bool const nontrivial = (scc_stack.back() != loc);
+        tchecker::loc_id_t l;
+        do {
+          l = scc_stack.back();
+          scc_stack.pop_back();
+          on_stack[l] = false;
+          if (nontrivial)
+            on_cycle[l] = true;
+        } while (l != loc);
+      }
+    }
+  }
+
+  candidates -= on_cycle;
+}
+
+por_t::por_t(tchecker::ta::system_t const & system, boost::dynamic_bitset<> const & labels)
+    : _reducible(system.locations_count())
+{
+  if (system.committed_locations().any())
+    return;
+
+  boost::dynamic_bitset<> searched_labels(labels);
+  searched_labels.resize(system.labels_count());
+
+  tchecker::variable_access_map_t const access = tchecker::variable_access(system);
+  tchecker::system::process_events_map_t weak_events = tchecker::system::weakly_synchronized_events(system.as_system_system());
+
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations()) {
+    tchecker::loc_id_t const id = loc->id();
+    if (!independent_location(system, id))
+      continue;
+    bool reducible = false;
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : system.outgoing_edges(id)) {
+      reducible = independent_edge(system, *edge, access, weak_events, searched_labels);
+      if (!reducible)
+        break;
+    }
+    _reducible[id] = reducible;
+  }
+
+  tchecker::ta::remove_cycles(system, _reducible);
+}
+
+tchecker::process_id_t por_t::reducible_process(tchecker::vloc_t const & vloc) const
+{
+  for (tchecker::process_id_t pid = 0; pid < vloc.size(); ++pid)
+    if (reducible(vloc[pid]))
+      return pid;
+  return NO_REDUCIBLE_PROCESS;
+}
+
+bool involves(tchecker::syncprod::outgoing_edges_value_t const & edges, tchecker::process_id_t pid)
+{
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : edges)
+    if (edge->pid() == pid)
+      return true;
+  return false;
+}
+
+} // end of namespace ta
+
+} // end of namespace tchecker
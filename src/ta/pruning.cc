@@ -0,0 +1,752 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "tchecker/expression/typed_expression.hh"
+#include "tchecker/parsing/declaration_filter.hh"
+#include "tchecker/statement/typed_statement.hh"
+#include "tchecker/ta/pruning.hh"
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \brief Interval of integers (empty if min > max)
+ */
+struct interval_t {
+  tchecker::integer_t min; /*!< Lower bound */
+  tchecker::integer_t max; /*!< Upper bound */
+
+  /*!
+   \brief Accessor
+   \return true if this interval is empty, false otherwise
+   */
+  inline bool empty() const { return min > max; }
+
+  /*!
+   \brief Accessor
+   \return true if this interval contains a non-zero value (i.e. may be true), false otherwise
+   */
+  inline bool may_be_true() const { return !empty() && (min != 0 || max != 0); }
+
+  /*!
+   \brief Accessor
+   \return true if this interval contains zero (i.e. may be false), false otherwise
+   */
+  inline bool may_be_false() const { return min <= 0 && max >= 0; }
+
+  bool operator==(tchecker::ta::interval_t const & i) const { return min == i.min && max == i.max; }
+  bool operator!=(tchecker::ta::interval_t const & i) const { return !(*this == i); }
+};
+
+/*!
+ \brief All integers
+ */
+static tchecker::ta::interval_t const INTERVAL_TOP{tchecker::int_minval, tchecker::int_maxval};
+
+/*!
+ \brief Booleans
+ */
+static tchecker::ta::interval_t const INTERVAL_TRUE{1, 1}, INTERVAL_FALSE{0, 0}, INTERVAL_UNKNOWN{0, 1};
+
+/*!
+ \brief Boolean interval
+ \param may_be_true : true if the predicate may hold
+ \param may_be_false : true if the predicate may not hold
+ \return interval of the predicate
+ */
+static tchecker::ta::interval_t boolean(bool may_be_true, bool may_be_false)
+{
+  if (may_be_true && may_be_false)
+    return tchecker::ta::INTERVAL_UNKNOWN;
+  return (may_be_true ? tchecker::ta::INTERVAL_TRUE : tchecker::ta::INTERVAL_FALSE);
+}
+
+/*!
+ \brief Join
+ \return the smallest interval that contains i1 and i2
+ */
+static tchecker::ta::interval_t join(tchecker::ta::interval_t const & i1, tchecker::ta::interval_t const & i2)
+{
+  if (i1.empty())
+    return i2;
+  if (i2.empty())
+    return i1;
+  return tchecker::ta::interval_t{std::min(i1.min, i2.min), std::max(i1.max, i2.max)};
+}
+
+/*!
+ \brief Meet
+ \return the intersection of i1 and i2
+ */
+static tchecker::ta::interval_t meet(tchecker::ta::interval_t const & i1, tchecker::ta::interval_t const & i2)
+{
+  return tchecker::ta::interval_t{std::max(i1.min, i2.min), std::min(i1.max, i2.max)};
+}
+
+/*!
+ \brief Interval of the values of an arithmetic operation on bounds
+ \param op : arithmetic operator (PLUS, MINUS or TIMES)
+ \param i1 : an interval
+ \param i2 : an interval
+ \return the smallest interval that contains i1 op i2, or INTERVAL_TOP if an operation on bounds overflows
+ */
+static tchecker::ta::interval_t arithmetic(enum tchecker::binary_operator_t op, tchecker::ta::interval_t const & i1,
+                                           tchecker::ta::interval_t const & i2)
+{
+  tchecker::integer_t const b1[2] = {i1.min, i1.max}, b2[2] = {i2.min, i2.max};
+  tchecker::ta::interval_t result{tchecker::int_maxval, tchecker::int_minval};
+  for (tchecker::integer_t x : b1)
+    for (tchecker::integer_t y : b2) {
+      tchecker::integer_t r;
+      bool overflow = false;
+      if (op == tchecker::EXPR_OP_PLUS)
+        overflow = __builtin_add_overflow(x, y, &r);
+      else if (op == tchecker::EXPR_OP_MINUS)
+        overflow = __builtin_sub_overflow(x, y, &r);
+      else
+        overflow = __builtin_mul_overflow(x, y, &r);
+      if (overflow)
+        return tchecker::ta::INTERVAL_TOP;
+      result = tchecker::ta::join(result, tchecker::ta::interval_t{r, r});
+    }
+  return result;
+}
+
+/*!
+ \class intervals_t
+ \brief Intervals of the bounded integer variables
+ */
+class intervals_t {
+public:
+  /*!
+   \brief Constructor
+   \param globals : intervals of the flattened bounded integer variables
+   */
+  explicit intervals_t(std::vector<tchecker::ta::interval_t> const & globals) : _globals(globals), _bottom(false) {}
+
+  /*!
+   \brief Accessor
+   \return true if this is bottom (no valuation), false otherwise
+   */
+  inline bool bottom() const { return _bottom; }
+
+  /*!
+   \brief Set to bottom
+   \post this represents no valuation
+   */
+  inline void set_bottom() { _bottom = true; }
+
+  /*!
+   \brief Accessor
+   \return intervals of flattened bounded integer variables
+   */
+  inline std::vector<tchecker::ta::interval_t> & globals() { return _globals; }
+
+  /*!
+   \brief Accessor
+   \return intervals of flattened bounded integer variables
+   */
+  inline std::vector<tchecker::ta::interval_t> const & globals() const { return _globals; }
+
+  /*!
+   \brief Accessor
+   \return intervals of local variables (the local variables that are not in the map are unknown)
+   */
+  inline std::unordered_map<tchecker::variable_id_t, tchecker::ta::interval_t> & locals() { return _locals; }
+
+  /*!
+   \brief Accessor
+   \return intervals of local variables (the local variables that are not in the map are unknown)
+   */
+  inline std::unordered_map<tchecker::variable_id_t, tchecker::ta::interval_t> const & locals() const { return _locals; }
+
+  /*!
+   \brief Join
+   \param intervals : intervals
+   \post this contains the valuations of this and of intervals
+   */
+  void join(tchecker::ta::intervals_t const & intervals)
+  {
+    if (intervals._bottom)
+      return;
+    if (_bottom) {
+      *this = intervals;
+      return;
+    }
+    for (std::size_t v = 0; v < _globals.size(); ++v)
+      _globals[v] = tchecker::ta::join(_globals[v], intervals._globals[v]);
+    for (auto it = _locals.begin(); it != _locals.end();) {
+      auto other = intervals._locals.find(it->first);
+      if (other == intervals._locals.end())
+        it = _locals.erase(it);
+      else {
+        it->second = tchecker::ta::join(it->second, other->second);
+        ++it;
+      }
+    }
+  }
+
+  bool operator==(tchecker::ta::intervals_t const & i) const
+  {
+    return _bottom == i._bottom && _globals == i._globals && _locals == i._locals;
+  }
+
+private:
+  std::vector<tchecker::ta::interval_t> _globals;                              /*!< Flattened bounded integer variables */
+  std::unordered_map<tchecker::variable_id_t, tchecker::ta::interval_t> _locals; /*!< Local variables */
+  bool _bottom;                                                                /*!< No valuation */
+};
+
+/*!
+ \class interval_evaluator_t
+ \brief Evaluation of expressions over intervals
+ */
+class interval_evaluator_t : public tchecker::typed_expression_visitor_t {
+public:
+  /*!
+   \brief Constructor
+   \param intervals : intervals of variables
+   */
+  explicit interval_evaluator_t(tchecker::ta::intervals_t const & intervals) : _intervals(intervals), _value(INTERVAL_TOP) {}
+
+  /*!
+   \brief Evaluation
+   \param expr : expression
+   \return interval that contains the values of expr over the valuations in the intervals
+   */
+  tchecker::ta::interval_t evaluate(tchecker::typed_expression_t const & expr)
+  {
+    expr.visit(*this);
+    return _value;
+  }
+
+  virtual void visit(tchecker::typed_int_expression_t const & expr) { _value = {expr.value(), expr.value()}; }
+
+  virtual void visit(tchecker::typed_var_expression_t const & expr) { _value = variable(expr, 0); }
+
+  virtual void visit(tchecker::typed_bounded_var_expression_t const & expr) { _value = variable(expr, 0); }
+
+  virtual void visit(tchecker::typed_array_expression_t const & expr)
+  {
+    tchecker::ta::interval_t const offset =
+        tchecker::ta::meet(evaluate(expr.offset()), {0, static_cast<tchecker::integer_t>(expr.variable().size()) - 1});
+    tchecker::ta::interval_t value{tchecker::int_maxval, tchecker::int_minval};
+    for (tchecker::integer_t k = offset.min; !offset.empty() && k <= offset.max; ++k)
+      value = tchecker::ta::join(value, variable(expr.variable(), static_cast<tchecker::variable_id_t>(k)));
+    _value = value;
+  }
+
+  virtual void visit(tchecker::typed_par_expression_t const & expr) { _value = evaluate(expr.expr()); }
+
+  virtual void visit(tchecker::typed_binary_expression_t const & expr)
+  {
+    tchecker::ta::interval_t const l = evaluate(expr.left_operand());
+    tchecker::ta::interval_t const r = evaluate(expr.right_operand());
+    if (l.empty() || r.empty()) {
+      _value = l.empty() ? l : r;
+      return;
+    }
+    switch (expr.binary_operator()) {
+    case tchecker::EXPR_OP_LAND:
+      _value = tchecker::ta::boolean(l.may_be_true() && r.may_be_true(), l.may_be_false() || r.may_be_false());
+      break;
+    case tchecker::EXPR_OP_LT:
+      _value = tchecker::ta::boolean(l.min < r.max, l.max >= r.min);
+      break;
+    case tchecker::EXPR_OP_LE:
+      _value = tchecker::ta::boolean(l.min <= r.max, l.max > r.min);
+      break;
+    case tchecker::EXPR_OP_GT:
+      _value = tchecker::ta::boolean(l.max > r.min, l.min <= r.max);
+      break;
+    case tchecker::EXPR_OP_GE:
+      _value = tchecker::ta::boolean(l.max >= r.min, l.min < r.max);
+      break;
+    case tchecker::EXPR_OP_EQ:
+    case tchecker::EXPR_OP_NEQ: {
+      bool const may_be_equal = !tchecker::ta::meet(l, r).empty();
+      bool const may_differ = !(l.min == l.max && r.min == r.max && l.min == r.min);
+      _value = (expr.binary_operator() == tchecker::EXPR_OP_EQ ? tchecker::ta::boolean(may_be_equal, may_differ)
+                                                                 : tchecker::ta::boolean(may_differ, may_be_equal));
+      break;
+    }
+    case tchecker::EXPR_OP_MINUS:
+    case tchecker::EXPR_OP_PLUS:
+    case tchecker::EXPR_OP_TIMES:
+      _value = tchecker::ta::arithmetic(expr.binary_operator(), l, r);
+      break;
+    case tchecker::EXPR_OP_DIV:
+    case tchecker::EXPR_OP_MOD:
+      if (l.min == l.max && r.min == r.max && r.min != 0 && !(l.min == tchecker::int_minval && r.min == -1)) {
+        tchecker::integer_t const v = (expr.binary_operator() == tchecker::EXPR_OP_DIV ? l.min / r.min : l.min % r.min);
+        _value = {v, v};
+      }
+      else if (expr.binary_operator() == tchecker::EXPR_OP_MOD && l.min >= 0 && r.min > 0)
+        _value = {0, std::min(l.max, r.max - 1)};
+      else
+        _value = INTERVAL_TOP;
+      break;
+    default:
+      _value = INTERVAL_TOP;
+    }
+  }
+
+  virtual void visit(tchecker::typed_unary_expression_t const & expr)
+  {
+    tchecker::ta::interval_t const i = evaluate(expr.operand());
+    if (i.empty())
+      _value = i;
+    else if (expr.unary_operator() == tchecker::EXPR_OP_LNOT)
+      _value = tchecker::ta::boolean(i.may_be_false(), i.may_be_true());
+    else if (i.min == tchecker::int_minval)
+      _value = INTERVAL_TOP;
+    else
+      _value = {-i.max, -i.min};
+  }
+
+  virtual void visit(tchecker::typed_simple_clkconstr_expression_t const &) { _value = INTERVAL_UNKNOWN; }
+
+  virtual void visit(tchecker::typed_diagonal_clkconstr_expression_t const &) { _value = INTERVAL_UNKNOWN; }
+
+  virtual void visit(tchecker::typed_ite_expression_t const & expr)
+  {
+    tchecker::ta::interval_t const cond = evaluate(expr.condition());
+    tchecker::ta::interval_t value{tchecker::int_maxval, tchecker::int_minval};
+    if (cond.may_be_true())
+      value = tchecker::ta::join(value, evaluate(expr.then_value()));
+    if (cond.may_be_false())
+      value = tchecker::ta::join(value, evaluate(expr.else_value()));
+    _value = value;
+  }
+
+private:
+  /*!
+   \brief Interval of a variable
+   \param var : variable
+   \param offset : offset in var
+   \return interval of the value of var[offset]
+   */
+  tchecker::ta::interval_t variable(tchecker::typed_var_expression_t const & var, tchecker::variable_id_t offset) const
+  {
+    if (var.type() == tchecker::EXPR_TYPE_INTVAR || var.type() == tchecker::EXPR_TYPE_INTARRAY)
+      return _intervals.globals()[var.id() + offset];
+    if (var.type() == tchecker::EXPR_TYPE_LOCALINTVAR) {
+      auto it = _intervals.locals().find(var.id());
+      if (it != _intervals.locals().end())
+        return it->second;
+    }
+    return INTERVAL_TOP;
+  }
+
+  tchecker::ta::intervals_t const & _intervals; /*!< Intervals of variables */
+  tchecker::ta::interval_t _value;             /*!< Value of the last evaluated expression */
+};
+
+/*!
+ \brief Evaluation over intervals
+ \param expr : expression
+ \param intervals : intervals of variables
+ \return interval of the values of expr over intervals
+ */
+static tchecker::ta::interval_t evaluate(tchecker::typed_expression_t const & expr, tchecker::ta::intervals_t const & intervals)
+{
+  tchecker::ta::interval_evaluator_t evaluator{intervals};
+  return evaluator.evaluate(expr);
+}
+
+/*!
+ \brief Restriction of intervals to the valuations that satisfy a condition
+ \param cond : a condition
+ \param intervals : intervals of variables
+ \post intervals have been narrowed by the conjuncts of cond that compare a flattened bounded integer variable (or a
+ local variable) to an expression, and intervals is bottom if cond cannot be satisfied
+ */
+static void assume(tchecker::typed_expression_t const & cond, tchecker::ta::intervals_t & intervals)
+{
+  if (intervals.bottom())
+    return;
+  if (!tchecker::ta::evaluate(cond, intervals).may_be_true()) {
+    intervals.set_bottom();
+    return;
+  }
+
+  if (auto const * par = dynamic_cast<tchecker::typed_par_expression_t const *>(&cond)) {
+    tchecker::ta::assume(par->expr(), intervals);
+    return;
+  }
+
+  auto const * binary = dynamic_cast<tchecker::typed_binary_expression_t const *>(&cond);
+  if (binary == nullptr)
+    return;
+  if (binary->binary_operator() == tchecker::EXPR_OP_LAND) {
+    tchecker::ta::assume(binary->left_operand(), intervals);
+    tchecker::ta::assume(binary->right_operand(), intervals);
+    return;
+  }
+
+  enum tchecker::binary_operator_t op = binary->binary_operator();
+  if (!tchecker::predicate(op) || op == tchecker::EXPR_OP_NEQ)
+    return;
+  tchecker::typed_expression_t const * var_expr = &binary->left_operand();
+  tchecker::typed_expression_t const * bound_expr = &binary->right_operand();
+  if (dynamic_cast<tchecker::typed_var_expression_t const *>(var_expr) == nullptr) {
+    std::swap(var_expr, bound_expr);
+    op = tchecker::reverse_cmp(op);
+  }
+  auto const * var = dynamic_cast<tchecker::typed_var_expression_t const *>(var_expr);
+  if (var == nullptr)
+    return;
+
+  tchecker::ta::interval_t * x = nullptr;
+  if (var->type() == tchecker::EXPR_TYPE_INTVAR)
+    x = &intervals.globals()[var->id()];
+  else if (var->type() == tchecker::EXPR_TYPE_LOCALINTVAR) {
+    auto it = intervals.locals().find(var->id());
+    if (it == intervals.locals().end())
+      return;
+    x = &it->second;
+  }
+  else
+    return;
+
+  // x op bound, where the bounds of bound are not extreme (checked by the interval evaluation of cond)
+  tchecker::ta::interval_t const bound = tchecker::ta::evaluate(*bound_expr, intervals);
+  switch (op) {
+  case tchecker::EXPR_OP_LT:
+    *x = tchecker::ta::meet(*x, {tchecker::int_minval, bound.max - 1});
+    break;
+  case tchecker::EXPR_OP_LE:
+    *x = tchecker::ta::meet(*x, {tchecker::int_minval, bound.max});
+    break;
+  case tchecker::EXPR_OP_EQ:
+    *x = tchecker::ta::meet(*x, bound);
+    break;
+  case tchecker::EXPR_OP_GE:
+    *x = tchecker::ta::meet(*x, {bound.min, tchecker::int_maxval});
+    break;
+  case tchecker::EXPR_OP_GT:
+    *x = tchecker::ta::meet(*x, {bound.min + 1, tchecker::int_maxval});
+    break;
+  default:
+    break;
+  }
+  if (x->empty())
+    intervals.set_bottom();
+}
+
+/*!
+ \class interval_executor_t
+ \brief Execution of statements over intervals
+ */
+class interval_executor_t : public tchecker::typed_statement_visitor_t {
+public:
+  /*!
+   \brief Constructor
+   \param domains : domains of the flattened bounded integer variables
+   \param intervals : intervals of variables
+   \post the statements visited by this are executed on intervals
+   */
+  interval_executor_t(std::vector<tchecker::ta::interval_t> const & domains, tchecker::ta::intervals_t & intervals)
+      : _domains(domains), _intervals(intervals)
+  {
+  }
+
+  /*!
+   \brief Execution
+   \param stmt : statement
+   \post intervals contains the valuations obtained by executing stmt from a valuation in intervals. Intervals are
+   bottom if stmt always fails from intervals
+   */
+  void execute(tchecker::typed_statement_t const & stmt)
+  {
+    if (!_intervals.bottom())
+      stmt.visit(*this);
+  }
+
+  virtual void visit(tchecker::typed_nop_statement_t const &) {}
+
+  virtual void visit(tchecker::typed_assign_statement_t const & stmt)
+  {
+    tchecker::ta::interval_t const value = tchecker::ta::evaluate(stmt.rvalue(), _intervals);
+    if (value.empty()) {
+      _intervals.set_bottom();
+      return;
+    }
+
+    tchecker::typed_lvalue_expression_t const & lvalue = stmt.lvalue();
+    if (auto const * array = dynamic_cast<tchecker::typed_array_expression_t const *>(&lvalue)) {
+      tchecker::typed_var_expression_t const & var = array->variable();
+      if (var.type() != tchecker::EXPR_TYPE_INTARRAY)
+        return;
+      tchecker::ta::interval_t const offset = tchecker::ta::meet(tchecker::ta::evaluate(array->offset(), _intervals),
+                                                                 {0, static_cast<tchecker::integer_t>(var.size()) - 1});
+      if (offset.empty()) {
+        _intervals.set_bottom();
+        return;
+      }
+      bool assigned = false;
+      for (tchecker::integer_t k = offset.min; k <= offset.max; ++k) {
+        tchecker::variable_id_t const id = var.id() + static_cast<tchecker::variable_id_t>(k);
+        tchecker::ta::interval_t const v = tchecker::ta::meet(value, _domains[id]);
+        if (v.empty())
+          continue;
+        assigned = true;
+        _intervals.globals()[id] = (offset.min == offset.max ? v : tchecker::ta::join(_intervals.globals()[id], v));
+      }
+      if (!assigned)
+        _intervals.set_bottom();
+      return;
+    }
+
+    auto const * var = dynamic_cast<tchecker::typed_var_expression_t const *>(&lvalue);
+    if (var == nullptr)
+      return;
+    if (var->type() == tchecker::EXPR_TYPE_INTVAR) {
+      tchecker::ta::interval_t const v = tchecker::ta::meet(value, _domains[var->id()]);
+      if (v.empty())
+        _intervals.set_bottom();
+      else
+        _intervals.globals()[var->id()] = v;
+    }
+    else if (var->type() == tchecker::EXPR_TYPE_LOCALINTVAR)
+      _intervals.locals()[var->id()] = value;
+  }
+
+  virtual void visit(tchecker::typed_int_to_clock_assign_statement_t const &) {}
+
+  virtual void visit(tchecker::typed_clock_to_clock_assign_statement_t const &) {}
+
+  virtual void visit(tchecker::typed_sum_to_clock_assign_statement_t const &) {}
+
+  virtual void visit(tchecker::typed_sequence_statement_t const & stmt)
+  {
+    execute(stmt.first());
+    execute(stmt.second());
+  }
+
+  virtual void visit(tchecker::typed_if_statement_t const & stmt)
+  {
+    tchecker::ta::interval_t const cond = tchecker::ta::evaluate(stmt.condition(), _intervals);
+    tchecker::ta::intervals_t else_intervals{_intervals};
+    if (!cond.may_be_true())
+      _intervals.set_bottom();
+    tchecker::ta::assume(stmt.condition(), _intervals);
+    execute(stmt.then_stmt());
+    if (cond.may_be_false()) {
+      tchecker::ta::interval_executor_t else_executor{_domains, else_intervals};
+      else_executor.execute(stmt.else_stmt());
+      _intervals.join(else_intervals);
+    }
+  }
+
+  virtual void visit(tchecker::typed_while_statement_t const & stmt)
+  {
+    // join of the intervals at loop head. Intervals that keep growing are widened to their domain
+    std::vector<std::size_t> growth(_domains.size(), 0);
+    while (true) {
+      tchecker::ta::intervals_t body{_intervals};
+      tchecker::ta::assume(stmt.condition(), body);
+      execute_in(stmt.statement(), body);
+      tchecker::ta::intervals_t head{_intervals};
+      head.join(body);
+      if (head == _intervals)
+        return;
+      for (std::size_t v = 0; v < _domains.size(); ++v)
+        if (head.globals()[v] != _intervals.globals()[v] && ++growth[v] > tchecker::ta::PRUNING_WIDENING_DELAY)
+          head.globals()[v] = _domains[v];
+      for (auto & [id, interval] : head.locals())
+        if (_intervals.locals().find(id) == _intervals.locals().end() || interval != _intervals.locals().at(id))
+          interval = INTERVAL_TOP;
+      _intervals = head;
+    }
+  }
+
+  virtual void visit(tchecker::typed_local_var_statement_t const & stmt)
+  {
+    tchecker::ta::interval_t const value = tchecker::ta::evaluate(stmt.initial_value(), _intervals);
+    if (value.empty())
+      _intervals.set_bottom();
+    else
+      _intervals.locals()[stmt.variable().id()] = value;
+  }
+
+  virtual void visit(tchecker::typed_local_array_statement_t const &) {}
+
+private:
+  /*!
+   \brief Execution on other intervals
+   \param stmt : statement
+   \param intervals : intervals
+   \post stmt has been executed on intervals
+   */
+  void execute_in(tchecker::typed_statement_t const & stmt, tchecker::ta::intervals_t & intervals) const
+  {
+    tchecker::ta::interval_executor_t executor{_domains, intervals};
+    executor.execute(stmt);
+  }
+
+  std::vector<tchecker::ta::interval_t> const & _domains; /*!< Domains of flattened bounded integer variables */
+  tchecker::ta::intervals_t & _intervals;                 /*!< Intervals of variables */
+};
+
+/*!
+ \brief Valuations after an edge
+ \param system : a system of timed processes
+ \param edge : an edge of system
+ \param domains : domains of the flattened bounded integer variables
+ \param intervals : intervals of the variables before edge
+ \return intervals of the variables after edge from intervals, bottom if edge cannot be taken from intervals
+ */
+static tchecker::ta::intervals_t post(tchecker::ta::system_t const & system, tchecker::system::edge_t const & edge,
+                                      std::vector<tchecker::ta::interval_t> const & domains,
+                                      tchecker::ta::intervals_t const & intervals)
+{
+  tchecker::ta::intervals_t next{intervals};
+  tchecker::ta::assume(system.guard(edge.id()), next);
+  tchecker::ta::interval_executor_t executor{domains, next};
+  executor.execute(system.statement(edge.id()));
+  next.locals().clear();
+  if (!next.bottom())
+    tchecker::ta::assume(system.invariant(edge.tgt()), next);
+  return next;
+}
+
+tchecker::ta::live_edges_t live_edges(tchecker::ta::system_t const & system)
+{
+  auto const & intvars = system.integer_variables().flattened();
+  std::vector<tchecker::ta::interval_t> domains, initial;
+  for (tchecker::intvar_id_t v = 0; v < intvars.size(); ++v) {
+    domains.push_back({intvars.info(v).min(), intvars.info(v).max()});
+    initial.push_back({intvars.info(v).initial_value(), intvars.info(v).initial_value()});
+  }
+  tchecker::ta::intervals_t intervals{initial};
+  std::vector<std::size_t> growth(domains.size(), 0);
+
+  std::size_t const events_count = system.events_count();
+  boost::dynamic_bitset<> locations{system.locations_count()};
+  for (tchecker::process_id_t pid = 0; pid < system.processes_count(); ++pid)
+    for (tchecker::system::loc_const_shared_ptr_t const & loc : system.initial_locations(pid))
+      locations[loc->id()] = 1;
+
+  tchecker::ta::live_edges_t live{boost::dynamic_bitset<>{system.edges_count()},
+                                  boost::dynamic_bitset<>{system.synchronizations_count()}};
+  std::vector<tchecker::ta::intervals_t> posts(system.edges_count(), intervals);
+  bool changed = true;
+  while (changed) {
+    changed = false;
+
+    // edges that can be taken locally, and (process, event) pairs which have such an edge
+    boost::dynamic_bitset<> enabled{system.edges_count()};
+    boost::dynamic_bitset<> enabled_events{system.processes_count() * events_count};
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+      if (!locations[edge->src()])
+        continue;
+      posts[edge->id()] = tchecker::ta::post(system, *edge, domains, intervals);
+      if (posts[edge->id()].bottom())
+        continue;
+      enabled[edge->id()] = 1;
+      enabled_events[edge->pid() * events_count + edge->event_id()] = 1;
+    }
+
+    for (tchecker::system::synchronization_t const & sync : system.synchronizations()) {
+      bool strong = false, all_strong = true, any = false;
+      for (tchecker::system::sync_constraint_t const & c : sync.synchronization_constraints()) {
+        bool const e = enabled_events[c.pid() * events_count + c.event_id()];
+        any |= e;
+        if (c.strength() == tchecker::SYNC_STRONG) {
+          strong = true;
+          all_strong &= e;
+        }
+      }
+      if ((strong ? all_strong : any) && !live.syncs[sync.id()]) {
+        live.syncs[sync.id()] = 1;
+        changed = true;
+      }
+    }
+
+    boost::dynamic_bitset<> synchronized{system.processes_count() * events_count};
+    for (tchecker::system::synchronization_t const & sync : system.synchronizations())
+      if (live.syncs[sync.id()])
+        for (tchecker::system::sync_constraint_t const & c : sync.synchronization_constraints())
+          synchronized[c.pid() * events_count + c.event_id()] = 1;
+
+    tchecker::ta::intervals_t next{intervals};
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+      if (!enabled[edge->id()])
+        continue;
+      if (!system.is_asynchronous(*edge) && !synchronized[edge->pid() * events_count + edge->event_id()])
+        continue;
+      if (!live.edges[edge->id()]) {
+        live.edges[edge->id()] = 1;
+        changed = true;
+      }
+      if (!locations[edge->tgt()]) {
+        locations[edge->tgt()] = 1;
+        changed = true;
+      }
+      next.join(posts[edge->id()]);
+    }
+
+    for (std::size_t v = 0; v < domains.size(); ++v)
+      if (next.globals()[v] != intervals.globals()[v]) {
+        if (++growth[v] > tchecker::ta::PRUNING_WIDENING_DELAY)
+          next.globals()[v] = domains[v];
+        changed = true;
+      }
+    intervals = next;
+  }
+
+  return live;
+}
+
+/*!
+ \class pruner_t
+ \brief Visitor that copies a system declaration without its dead edges and synchronizations
+ */
+class pruner_t : public tchecker::parsing::declaration_filter_t {
+public:
+  /*!
+   \brief Constructor
+   \param pruned : pruned system declaration
+   \param live : live edges and synchronizations
+   */
+  pruner_t(tchecker::parsing::system_declaration_t & pruned, tchecker::ta::live_edges_t const & live)
+      : tchecker::parsing::declaration_filter_t(pruned), _live(live)
+  {
+  }
+
+protected:
+  using tchecker::parsing::declaration_filter_t::keep;
+
+  virtual bool keep(tchecker::parsing::edge_declaration_t const & d, tchecker::edge_id_t id) { return _live.edges[id]; }
+
+  virtual bool keep(tchecker::parsing::sync_declaration_t const & d, tchecker::sync_id_t id) { return _live.syncs[id]; }
+
+private:
+  tchecker::ta::live_edges_t const & _live; /*!< Live edges and synchronizations */
+};
+
+std::shared_ptr<tchecker::parsing::system_declaration_t>
+prune_dead_edges(tchecker::parsing::system_declaration_t const & sysdecl)
+{
+  tchecker::ta::system_t const system{sysdecl};
+  tchecker::ta::live_edges_t const live = tchecker::ta::live_edges(system);
+
+  tchecker::parsing::attributes_t attr(sysdecl.attributes());
+  std::shared_ptr<tchecker::parsing::system_declaration_t> pruned{
+      new tchecker::parsing::system_declaration_t(sysdecl.name(), std::move(attr), sysdecl.context())};
+  tchecker::ta::pruner_t pruner{*pruned, live};
+  sysdecl.visit(pruner);
+  return pruned;
+}
+
+} // end of namespace ta
+
+} // end of namespace tchecker
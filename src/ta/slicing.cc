@@ -0,0 +1,321 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/parsing/declaration_filter.hh"
+#include "tchecker/expression/static_analysis.hh"
+#include "tchecker/statement/static_analysis.hh"
+#include "tchecker/statement/typed_statement.hh"
+#include "tchecker/ta/slicing.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/variables/access.hh"
+#include "tchecker/variables/static_analysis.hh"
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \brief Check if a process could block the other processes
+ \param system : a system of timed processes
+ \param pid : process identifier
+ \return true if pid has a committed or urgent location, a location with an invariant that is not trivially true, or
+ no initial location, false otherwise
+ */
+static bool blocking(tchecker::ta::system_t const & system, tchecker::process_id_t pid)
+{
+  if (system.initial_locations(pid).begin() == system.initial_locations(pid).end())
+    return true;
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations(pid)) {
+    if (system.is_committed(loc->id()) || system.is_urgent(loc->id()))
+      return true;
+    tchecker::clock_constraint_container_t const * invariant = system.static_invariant(loc->id());
+    if (invariant == nullptr || !invariant->empty())
+      return true;
+  }
+  return false;
+}
+
+/*!
+ \brief Compute the processes in the cone of influence of labels
+ \param system : a system of timed processes
+ \param labels : searched labels
+ \return the set of processes with a location in labels (all processes if labels is empty), closed under
+ synchronization and variable sharing, and the processes that could block the other ones
+ */
+static boost::dynamic_bitset<> relevant_processes(tchecker::ta::system_t const & system, boost::dynamic_bitset<> const & labels)
+{
+  std::size_t const processes_count = system.processes_count();
+  boost::dynamic_bitset<> relevant{processes_count};
+
+  if (labels.none())
+    relevant.set();
+  else
+    for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
+      if ((system.labels(loc->id()) & labels).any())
+        relevant.set(loc->pid());
+
+  for (tchecker::process_id_t pid = 0; pid < processes_count; ++pid)
+    if (tchecker::ta::blocking(system, pid))
+      relevant.set(pid);
+
+  // processes that interact: synchronizations and shared variables
+  std::vector<std::vector<tchecker::process_id_t>> neighbours(processes_count);
+  for (tchecker::system::synchronization_t const & sync : system.synchronizations())
+    for (tchecker::system::sync_constraint_t const & c1 : sync.synchronization_constraints())
+      for (tchecker::system::sync_constraint_t const & c2 : sync.synchronization_constraints())
+        neighbours[c1.pid()].push_back(c2.pid());
+
+  tchecker::variable_access_map_t const access = tchecker::variable_access(system);
+  for (tchecker::intvar_id_t id = 0; id < system.intvars_count(tchecker::VK_FLATTENED); ++id)
+    for (tchecker::process_id_t p1 : access.accessing_processes(id, tchecker::VTYPE_INTVAR, tchecker::VACCESS_ANY))
+      for (tchecker::process_id_t p2 : access.accessing_processes(id, tchecker::VTYPE_INTVAR, tchecker::VACCESS_ANY))
+        neighbours[p1].push_back(p2);
+  for (tchecker::clock_id_t id = 0; id < system.clocks_count(tchecker::VK_FLATTENED); ++id)
+    for (tchecker::process_id_t p1 : access.accessing_processes(id, tchecker::VTYPE_CLOCK, tchecker::VACCESS_ANY))
+      for (tchecker::process_id_t p2 : access.accessing_processes(id, tchecker::VTYPE_CLOCK, tchecker::VACCESS_ANY))
+        neighbours[p1].push_back(p2);
+
+  std::vector<tchecker::process_id_t> waiting;
+  for (tchecker::process_id_t pid = 0; pid < processes_count; ++pid)
+    if (relevant[pid])
+      waiting.push_back(pid);
+  while (!waiting.empty()) {
+    tchecker::process_id_t const pid = waiting.back();
+    waiting.pop_back();
+    for (tchecker::process_id_t q : neighbours[pid])
+      if (!relevant[q]) {
+        relevant.set(q);
+        waiting.push_back(q);
+      }
+  }
+
+  return relevant;
+}
+
+/*!
+ \brief Compute the relevant clocks
+ \param system : a system of timed processes
+ \param processes : relevant processes
+ \return the set of flattened clocks that are read by a guard or an invariant of a relevant process, or accessed in a
+ statement of a relevant process that is not a sequence of assignments, or assigned to a relevant clock
+ */
+static boost::dynamic_bitset<> relevant_clocks(tchecker::ta::system_t const & system, boost::dynamic_bitset<> const & processes)
+{
+  boost::dynamic_bitset<> relevant{system.clocks_count(tchecker::VK_FLATTENED)};
+  std::unordered_set<tchecker::clock_id_t> clocks;
+  std::unordered_set<tchecker::intvar_id_t> intvars;
+  std::vector<std::tuple<std::unordered_set<tchecker::clock_id_t>, std::unordered_set<tchecker::clock_id_t>>> resets;
+
+  auto add = [&](std::unordered_set<tchecker::clock_id_t> const & ids) {
+    for (tchecker::clock_id_t id : ids)
+      relevant.set(id);
+  };
+
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations()) {
+    if (!processes[loc->pid()])
+      continue;
+    clocks.clear();
+    tchecker::extract_variables(system.invariant(loc->id()), clocks, intvars);
+    add(clocks);
+  }
+
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+    if (!processes[edge->pid()])
+      continue;
+    clocks.clear();
+    tchecker::extract_variables(system.guard(edge->id()), clocks, intvars);
+    add(clocks);
+
+    std::vector<tchecker::typed_assign_statement_t const *> assignments;
+    if (!tchecker::flat_assignments(system.statement(edge->id()), assignments)) {
+      clocks.clear();
+      tchecker::extract_read_variables(system.statement(edge->id()), clocks, intvars);
+      tchecker::extract_written_variables(system.statement(edge->id()), clocks, intvars);
+      add(clocks);
+      continue;
+    }
+    for (tchecker::typed_assign_statement_t const * a : assignments) {
+      std::unordered_set<tchecker::clock_id_t> written, read;
+      tchecker::extract_written_variables(*a, written, intvars);
+      tchecker::extract_read_variables(*a, read, intvars);
+      // assignments to an array of clocks with a non-constant index may fail, hence they are kept
+      if (written.empty() || written.size() > 1) {
+        add(written);
+        add(read);
+      }
+      else
+        resets.emplace_back(std::move(written), std::move(read));
+    }
+  }
+
+  // clocks assigned to relevant clocks are relevant
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (auto && [written, read] : resets) {
+      if (std::none_of(written.begin(), written.end(), [&](tchecker::clock_id_t id) { return relevant[id]; }))
+        continue;
+      for (tchecker::clock_id_t id : read)
+        if (!relevant[id]) {
+          relevant.set(id);
+          changed = true;
+        }
+    }
+  }
+
+  return relevant;
+}
+
+/*!
+ \class slicer_t
+ \brief Visitor that copies the relevant declarations of a system declaration
+ */
+class slicer_t : public tchecker::parsing::declaration_filter_t {
+public:
+  /*!
+   \brief Constructor
+   \param sliced : sliced system declaration
+   \param processes : names of relevant processes
+   \param clocks : names of relevant clocks
+   \param intvars : names of relevant bounded integer variables
+   \param events : names of relevant events
+   \param statements : map edge identifier -> sliced statement (edges with unchanged statement are not in the map)
+   */
+  slicer_t(tchecker::parsing::system_declaration_t & sliced, std::set<std::string> const & processes,
+           std::set<std::string> const & clocks, std::set<std::string> const & intvars, std::set<std::string> const & events,
+           std::unordered_map<tchecker::edge_id_t, std::string> const & statements)
+      : tchecker::parsing::declaration_filter_t(sliced), _processes(processes), _clocks(clocks), _intvars(intvars),
+        _events(events), _statements(statements)
+  {
+  }
+
+protected:
+  using tchecker::parsing::declaration_filter_t::keep;
+
+  virtual bool keep(tchecker::parsing::clock_declaration_t const & d) { return _clocks.count(d.name()) != 0; }
+
+  virtual bool keep(tchecker::parsing::int_declaration_t const & d) { return _intvars.count(d.name()) != 0; }
+
+  virtual bool keep(tchecker::parsing::process_declaration_t const & d) { return _processes.count(d.name()) != 0; }
+
+  virtual bool keep(tchecker::parsing::event_declaration_t const & d) { return _events.count(d.name()) != 0; }
+
+  virtual bool keep(tchecker::parsing::location_declaration_t const & d)
+  {
+    return _processes.count(d.process().name()) != 0;
+  }
+
+  virtual bool keep(tchecker::parsing::edge_declaration_t const & d, tchecker::edge_id_t id)
+  {
+    return _processes.count(d.process().name()) != 0;
+  }
+
+  // synchronizations only involve relevant processes, or only irrelevant processes
+  virtual bool keep(tchecker::parsing::sync_constraint_t const & c)
+  {
+    return _processes.count(c.process().name()) != 0;
+  }
+
+  virtual tchecker::parsing::attributes_t edge_attributes(tchecker::parsing::edge_declaration_t const & d,
+                                                          tchecker::edge_id_t id) const
+  {
+    auto it = _statements.find(id);
+    if (it == _statements.end())
+      return tchecker::parsing::declaration_filter_t::edge_attributes(d, id);
+    tchecker::parsing::attributes_t attr;
+    for (tchecker::parsing::attr_t const & a : d.attributes().attributes())
+      if (a.key() != "do")
+        attr.insert(new tchecker::parsing::attr_t(a));
+    attr.insert(new tchecker::parsing::attr_t("do", it->second, tchecker::parsing::attr_parsing_position_t{}));
+    return attr;
+  }
+
+private:
+  std::set<std::string> const & _processes;                               /*!< Relevant processes */
+  std::set<std::string> const & _clocks;                                  /*!< Relevant clocks */
+  std::set<std::string> const & _intvars;                                 /*!< Relevant bounded integer variables */
+  std::set<std::string> const & _events;                                  /*!< Relevant events */
+  std::unordered_map<tchecker::edge_id_t, std::string> const & _statements; /*!< Sliced statements */
+};
+
+std::shared_ptr<tchecker::parsing::system_declaration_t> cone_of_influence(tchecker::parsing::system_declaration_t const & sysdecl,
+                                                                           std::string const & labels)
+{
+  tchecker::ta::system_t const system{sysdecl};
+
+  boost::dynamic_bitset<> const processes = tchecker::ta::relevant_processes(system, system.as_syncprod_system().labels(labels));
+  boost::dynamic_bitset<> const clocks = tchecker::ta::relevant_clocks(system, processes);
+  tchecker::variable_access_map_t const access = tchecker::variable_access(system);
+
+  std::set<std::string> process_names, clock_names, intvar_names, event_names;
+  for (tchecker::process_id_t pid = 0; pid < system.processes_count(); ++pid)
+    if (processes[pid])
+      process_names.insert(system.process_name(pid));
+
+  // declared variables are kept if one of their flattened variables is relevant
+  tchecker::clock_variables_t const & clock_variables = system.clock_variables();
+  for (auto && [id, name] : clock_variables.index())
+    for (tchecker::clock_id_t x = id; x < id + clock_variables.info(id).size(); ++x)
+      if (clocks[x])
+        clock_names.insert(name);
+
+  tchecker::integer_variables_t const & integer_variables = system.integer_variables();
+  for (auto && [id, name] : integer_variables.index())
+    for (tchecker::intvar_id_t v = id; v < id + integer_variables.info(id).size(); ++v)
+      for (tchecker::process_id_t pid : access.accessing_processes(v, tchecker::VTYPE_INTVAR, tchecker::VACCESS_ANY))
+        if (processes[pid])
+          intvar_names.insert(name);
+
+  for (tchecker::system::synchronization_t const & sync : system.synchronizations())
+    for (tchecker::system::sync_constraint_t const & c : sync.synchronization_constraints())
+      if (processes[c.pid()])
+        event_names.insert(system.event_name(c.event_id()));
+
+  // statements without the resets of irrelevant clocks
+  std::unordered_map<tchecker::edge_id_t, std::string> statements;
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+    if (!processes[edge->pid()])
+      continue;
+    event_names.insert(system.event_name(edge->event_id()));
+
+    std::vector<tchecker::typed_assign_statement_t const *> assignments;
+    if (!tchecker::flat_assignments(system.statement(edge->id()), assignments))
+      continue;
+
+    std::string statement;
+    bool sliced = false;
+    for (tchecker::typed_assign_statement_t const * a : assignments) {
+      std::unordered_set<tchecker::clock_id_t> written;
+      std::unordered_set<tchecker::intvar_id_t> intvars;
+      tchecker::extract_written_variables(*a, written, intvars);
+      if (!written.empty() && std::none_of(written.begin(), written.end(), [&](tchecker::clock_id_t id) { return clocks[id]; })) {
+        sliced = true;
+        continue;
+      }
+      statement += (statement.empty() ? "" : "; ") + a->to_string();
+    }
+    if (sliced)
+      statements[edge->id()] = (statement.empty() ? "nop" : statement);
+  }
+
+  tchecker::parsing::attributes_t attr(sysdecl.attributes());
+  std::shared_ptr<tchecker::parsing::system_declaration_t> sliced{
+      new tchecker::parsing::system_declaration_t(sysdecl.name(), std::move(attr), sysdecl.context())};
+  tchecker::ta::slicer_t slicer{*sliced, process_names, clock_names, intvar_names, event_names, statements};
+  sysdecl.visit(slicer);
+  return sliced;
+}
+
+} // end of namespace ta
+
+} // end of namespace tchecker
@@ -0,0 +1,321 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <map>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+#include "tchecker/ta/symmetry.hh"
+#include "tchecker/variables/access.hh"
+#include "tchecker/variables/static_analysis.hh"
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \brief Type of renaming of variables (base names)
+ */
+using renaming_t = std::unordered_map<std::string, std::string>;
+
+/*!
+ \brief Renaming of identifiers
+ \param s : output of an expression or a statement
+ \param renaming : renaming of variables
+ \return s where every identifier in the domain of renaming has been replaced by its image
+ */
+static std::string rename(std::string const & s, tchecker::ta::renaming_t const & renaming)
+{
+  std::string out;
+  std::size_t i = 0;
+  while (i < s.size()) {
+    if (!std::isalpha(static_cast<unsigned char>(s[i])) && s[i] != '_') {
+      out += s[i++];
+      continue;
+    }
+    std::size_t j = i;
+    while (j < s.size() && (std::isalnum(static_cast<unsigned char>(s[j])) || s[j] == '_' || s[j] == '.'))
+      ++j;
+    std::string const token = s.substr(i, j - i);
+    auto it = renaming.find(token);
+    out += (it == renaming.end() ? token : it->second);
+    i = j;
+  }
+  return out;
+}
+
+/*!
+ \brief Check if a variable is local to a process
+ \param id : identifier of a declared variable
+ \param size : size of the variable
+ \param vtype : type of the variable
+ \param pid : process identifier
+ \param access : variable access map
+ \return true if the flattened variables id to id + size - 1 are only accessed by process pid, and at least one of
+ them is accessed, false otherwise
+ */
+static bool local_variable(tchecker::variable_id_t id, tchecker::variable_size_t size, enum tchecker::variable_type_t vtype,
+                           tchecker::process_id_t pid, tchecker::variable_access_map_t const & access)
+{
+  bool accessed = false;
+  for (tchecker::variable_id_t flat_id = id; flat_id < id + size; ++flat_id)
+    for (tchecker::process_id_t accessing_pid : access.accessing_processes(flat_id, vtype, tchecker::VACCESS_ANY)) {
+      if (accessing_pid != pid)
+        return false;
+      accessed = true;
+    }
+  return accessed;
+}
+
+/*!
+ \brief Identifiers of declared variables in increasing order
+ \param variables : declared variables
+ \return the identifiers of the variables declared in variables, in increasing order
+ */
+template <class ID, class INFO, class INDEX>
+static std::vector<ID> declared_identifiers(tchecker::size_variables_t<ID, INFO, INDEX> const & variables)
+{
+  std::vector<ID> ids;
+  for (auto && [id, name] : variables.index())
+    ids.push_back(id);
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+/*!
+ \brief Description of a process up to the renaming of its local variables
+ */
+struct process_description_t {
+  std::string _signature;                      /*!< Locations, edges and local variables, with local variables renamed */
+  std::vector<tchecker::loc_id_t> _locations;  /*!< Locations in declaration order */
+  std::vector<tchecker::intvar_id_t> _intvars; /*!< Flattened local bounded integer variables in declaration order */
+  std::vector<tchecker::clock_id_t> _clocks;   /*!< Flattened local clocks in declaration order */
+};
+
+/*!
+ \brief Compute the description of a process
+ \param system : a system of timed processes
+ \param access : variable access map of system
+ \param pid : process identifier
+ \param location_index : map location identifier -> index in its process
+ \return the description of process pid, where the k-th local clock (resp. bounded integer variable) of pid is
+ renamed to $ck (resp. $ik)
+ */
+static tchecker::ta::process_description_t describe(tchecker::ta::system_t const & system,
+                                                     tchecker::variable_access_map_t const & access,
+                                                     tchecker::process_id_t pid,
+                                                     std::vector<std::size_t> const & location_index)
+{
+  tchecker::ta::process_description_t d;
+  tchecker::ta::renaming_t renaming;
+  std::ostringstream sig;
+
+  tchecker::clock_variables_t const & clocks = system.clock_variables();
+  for (tchecker::clock_id_t id : tchecker::ta::declared_identifiers(clocks)) {
+    tchecker::clock_id_t const size = clocks.info(id).size();
+    if (!tchecker::ta::local_variable(id, size, tchecker::VTYPE_CLOCK, pid, access))
+      continue;
+    renaming[clocks.name(id)] = "$c" + std::to_string(renaming.size());
+    for (tchecker::clock_id_t flat_id = id; flat_id < id + size; ++flat_id)
+      d._clocks.push_back(flat_id);
+    sig << "clock " << size << "\n";
+  }
+
+  tchecker::integer_variables_t const & intvars = system.integer_variables();
+  for (tchecker::intvar_id_t id : tchecker::ta::declared_identifiers(intvars)) {
+    tchecker::intvar_info_t const & info = intvars.info(id);
+    if (!tchecker::ta::local_variable(id, info.size(), tchecker::VTYPE_INTVAR, pid, access))
+      continue;
+    renaming[intvars.name(id)] = "$i" + std::to_string(renaming.size());
+    for (tchecker::intvar_id_t flat_id = id; flat_id < id + info.size(); ++flat_id)
+      d._intvars.push_back(flat_id);
+    sig << "int " << info.size() << " " << info.min() << " " << info.max() << " " << info.initial_value() << "\n";
+  }
+
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations(pid)) {
+    d._locations.push_back(loc->id());
+    sig << "location " << loc->name() << " " << system.is_initial_location(loc->id()) << system.is_committed(loc->id())
+        << system.is_urgent(loc->id()) << " " << system.labels(loc->id()) << " "
+        << tchecker::ta::rename(system.invariant(loc->id()).to_string(), renaming) << "\n";
+  }
+
+  std::vector<std::string> edges;
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges(pid))
+    edges.push_back("edge " + std::to_string(location_index[edge->src()]) + " " +
+                    std::to_string(location_index[edge->tgt()]) + " " + system.event_name(edge->event_id()) + " " +
+                    tchecker::ta::rename(system.guard(edge->id()).to_string(), renaming) + " " +
+                    tchecker::ta::rename(system.statement(edge->id()).to_string(), renaming) + "\n");
+  std::sort(edges.begin(), edges.end());
+  for (std::string const & e : edges)
+    sig << e;
+
+  d._signature = sig.str();
+  return d;
+}
+
+/*!
+ \brief Type of synchronizations as sorted tuples of constraints (process, event, strength)
+ */
+using sync_constraints_t = std::vector<std::tuple<tchecker::process_id_t, tchecker::event_id_t, int>>;
+
+/*!
+ \brief Constraints of a synchronization, with two processes swapped
+ \param sync : a synchronization
+ \param p : process identifier
+ \param q : process identifier
+ \return the sorted tuple of constraints of sync where p and q have been swapped
+ */
+static tchecker::ta::sync_constraints_t swapped_constraints(tchecker::system::synchronization_t const & sync,
+                                                            tchecker::process_id_t p, tchecker::process_id_t q)
+{
+  tchecker::ta::sync_constraints_t constraints;
+  for (tchecker::system::sync_constraint_t const & c : sync.synchronization_constraints()) {
+    tchecker::process_id_t const pid = (c.pid() == p ? q : (c.pid() == q ? p : c.pid()));
+    constraints.emplace_back(pid, c.event_id(), static_cast<int>(c.strength()));
+  }
+  std::sort(constraints.begin(), constraints.end());
+  return constraints;
+}
+
+/*!
+ \brief Check if swapping two processes leaves the synchronizations unchanged
+ \param system : a system of timed processes
+ \param syncs : synchronizations of system
+ \param p : process identifier
+ \param q : process identifier
+ \return true if swapping p and q maps each synchronization of system into syncs, false otherwise
+ */
+static bool swappable(tchecker::ta::system_t const & system, std::set<tchecker::ta::sync_constraints_t> const & syncs,
+                      tchecker::process_id_t p, tchecker::process_id_t q)
+{
+  for (tchecker::system::synchronization_t const & sync : system.synchronizations())
+    if (syncs.find(tchecker::ta::swapped_constraints(sync, p, q)) == syncs.end())
+      return false;
+  return true;
+}
+
+symmetry_t::symmetry_t(tchecker::ta::system_t const & system)
+    : _location_index(system.locations_count(), 0), _clocks_count(system.clocks_count(tchecker::VK_FLATTENED))
+{
+  for (tchecker::process_id_t pid = 0; pid < system.processes_count(); ++pid) {
+    std::size_t k = 0;
+    for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations(pid))
+      _location_index[loc->id()] = k++;
+  }
+
+  std::set<tchecker::ta::sync_constraints_t> syncs;
+  for (tchecker::system::synchronization_t const & sync : system.synchronizations())
+    syncs.insert(tchecker::ta::swapped_constraints(sync, 0, 0));
+
+  tchecker::variable_access_map_t const access = tchecker::variable_access(system);
+
+  // processes with the same description, in increasing order of identifiers
+  std::vector<tchecker::ta::process_description_t> descriptions;
+  std::map<std::string, std::vector<tchecker::process_id_t>> candidates;
+  for (tchecker::process_id_t pid = 0; pid < system.processes_count(); ++pid) {
+    descriptions.push_back(tchecker::ta::describe(system, access, pid, _location_index));
+    candidates[descriptions.back()._signature].push_back(pid);
+  }
+
+  // swapping consecutive processes of a group should preserve synchronizations, as these transpositions generate all
+  // the permutations of the group
+  for (auto && [signature, pids] : candidates) {
+    std::vector<std::vector<tchecker::process_id_t>> groups;
+    for (tchecker::process_id_t pid : pids) {
+      auto it = std::find_if(groups.begin(), groups.end(), [&](std::vector<tchecker::process_id_t> const & group) {
+        return tchecker::ta::swappable(system, syncs, group.back(), pid);
+      });
+      if (it == groups.end())
+        groups.push_back({pid});
+      else
+        it->push_back(pid);
+    }
+
+    for (std::vector<tchecker::process_id_t> const & group : groups) {
+      if (group.size() < 2)
+        continue;
+      std::vector<member_t> members;
+      for (tchecker::process_id_t pid : group) {
+        tchecker::ta::process_description_t & d = descriptions[pid];
+        members.push_back(member_t{pid, std::move(d._locations), std::move(d._intvars), std::move(d._clocks)});
+      }
+      _groups.push_back(std::move(members));
+    }
+  }
+}
+
+std::vector<tchecker::process_id_t> symmetry_t::processes(std::size_t i) const
+{
+  assert(i < _groups.size());
+  std::vector<tchecker::process_id_t> pids;
+  for (member_t const & m : _groups[i])
+    pids.push_back(m._pid);
+  return pids;
+}
+
+bool symmetry_t::canonicalize(tchecker::vloc_t & vloc, tchecker::intval_t & intval,
+                              std::vector<tchecker::clock_id_t> & clocks) const
+{
+  bool permuted = false;
+
+  for (std::vector<member_t> const & group : _groups) {
+    std::size_t const size = group.size();
+    std::size_t const intvars = group[0]._intvars.size();
+
+    auto less = [&](std::size_t a, std::size_t b) {
+      std::size_t const la = _location_index[vloc[group[a]._pid]], lb = _location_index[vloc[group[b]._pid]];
+      if (la != lb)
+        return la < lb;
+      for (std::size_t i = 0; i < intvars; ++i) {
+        tchecker::integer_t const va = intval[group[a]._intvars[i]], vb = intval[group[b]._intvars[i]];
+        if (va != vb)
+          return va < vb;
+      }
+      return false;
+    };
+
+    std::vector<std::size_t> order(size);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), less);
+    if (std::is_sorted(order.begin(), order.end()))
+      continue;
+
+    if (!permuted) {
+      clocks.resize(_clocks_count);
+      std::iota(clocks.begin(), clocks.end(), 0);
+      permuted = true;
+    }
+
+    std::vector<std::size_t> old_locations(size);
+    std::vector<tchecker::integer_t> old_values(size * intvars);
+    for (std::size_t m = 0; m < size; ++m) {
+      old_locations[m] = _location_index[vloc[group[m]._pid]];
+      for (std::size_t i = 0; i < intvars; ++i)
+        old_values[m * intvars + i] = intval[group[m]._intvars[i]];
+    }
+
+    for (std::size_t m = 0; m < size; ++m) {
+      member_t const & dst = group[m];
+      member_t const & src = group[order[m]];
+      vloc[dst._pid] = dst._locations[old_locations[order[m]]];
+      for (std::size_t i = 0; i < intvars; ++i)
+        intval[dst._intvars[i]] = old_values[order[m] * intvars + i];
+      for (std::size_t i = 0; i < dst._clocks.size(); ++i)
+        clocks[dst._clocks[i]] = src._clocks[i];
+    }
+  }
+
+  return permuted;
+}
+
+} // end of namespace ta
+
+} // end of namespace tchecker
@@ -5,7 +5,11 @@
 #include <cassert>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "tchecker/clockbounds/solver.hh"
 #include "tchecker/expression/expression.hh"
@@ -17,6 +21,7 @@
 #include "tchecker/ta/static_analysis.hh"
 #include "tchecker/ta/system.hh"
 #include "tchecker/utils/log.hh"
+#include "tchecker/utils/parallel.hh"
 #include "tchecker/vm/compilers.hh"
 
 namespace tchecker {
@@ -38,20 +43,10 @@ system_t::system_t(tchecker::syncprod::system_t const & system) : tchecker::sync
   compute_from_syncprod_system();
 }
 
-system_t::system_t(tchecker::ta::system_t const & system)
-    : tchecker::syncprod::system_t(system.as_syncprod_system()), _vm(system._vm)
+tchecker::vm_t & system_t::vm() const
 {
-  compute_from_syncprod_system();
-}
-
-tchecker::ta::system_t & system_t::operator=(tchecker::ta::system_t const & system)
-{
-  if (this != &system) {
-    tchecker::syncprod::system_t::operator=(system);
-    _vm = system._vm;
-    compute_from_syncprod_system();
-  }
-  return *this;
+  thread_local tchecker::vm_t vm;
+  return vm;
 }
 
 tchecker::system::attribute_keys_map_t const & system_t::known_attributes()
@@ -79,6 +74,18 @@ tchecker::bytecode_t const * system_t::guard_bytecode(tchecker::edge_id_t id) co
   return _guards[id]._compiled_expr.get();
 }
 
+tchecker::clock_constraint_container_t const * system_t::static_guard(tchecker::edge_id_t id) const
+{
+  assert(is_edge(id));
+  return _guards[id]._static_clkconstr.get();
+}
+
+tchecker::native_function_t system_t::native_guard(tchecker::edge_id_t id) const
+{
+  assert(is_edge(id));
+  return _guards[id]._native;
+}
+
 tchecker::typed_statement_t const & system_t::statement(tchecker::edge_id_t id) const
 {
   assert(is_edge(id));
@@ -109,6 +116,238 @@ tchecker::bytecode_t const * system_t::invariant_bytecode(tchecker::loc_id_t id)
   return _invariants[id]._compiled_expr.get();
 }
 
+tchecker::clock_reset_container_t const * system_t::static_statement(tchecker::edge_id_t id) const
+{
+  assert(is_edge(id));
+  return _statements[id]._static_clkreset.get();
+}
+
+tchecker::native_function_t system_t::native_statement(tchecker::edge_id_t id) const
+{
+  assert(is_edge(id));
+  return _statements[id]._native;
+}
+
+tchecker::clock_constraint_container_t const * system_t::static_invariant(tchecker::loc_id_t id) const
+{
+  assert(is_location(id));
+  return _invariants[id]._static_clkconstr.get();
+}
+
+tchecker::native_function_t system_t::native_invariant(tchecker::loc_id_t id) const
+{
+  assert(is_location(id));
+  return _invariants[id]._native;
+}
+
+/*!
+ \brief Compute the clock constraints of an expression that does not depend on bounded integer variables
+ \param bytecode : bytecode of an expression
+ \return the clock constraints output by interpreting bytecode if bytecode is intval-independent and evaluates to
+ true, nullptr otherwise
+ */
+static std::shared_ptr<tchecker::clock_constraint_container_t const>
+static_clock_constraints(tchecker::bytecode_t const * bytecode)
+{
+  if (!tchecker::intval_independent(bytecode))
+    return nullptr;
+
+  // bytecode does not access bounded integer variables, hence an empty valuation is enough
+  auto clkconstr = std::make_shared<tchecker::clock_constraint_container_t>();
+  tchecker::clock_reset_container_t clkreset;
+  tchecker::intval_t * intval = tchecker::intval_allocate_and_construct(0, 0);
+  tchecker::integer_t value = 0;
+  try {
+    value = tchecker::vm_t{}.run(bytecode, *intval, *clkconstr, clkreset);
+  }
+  catch (...) {
+    value = 0;
+  }
+  tchecker::intval_destruct_and_deallocate(intval);
+
+  if ((value == 0) || !clkreset.empty())
+    return nullptr;
+  clkconstr->shrink_to_fit();
+  return clkconstr;
+}
+
+/*!
+ \brief Compute the clock resets of a statement that does not depend on bounded integer variables
+ \param bytecode : bytecode of a statement
+ \return the clock resets output by interpreting bytecode if bytecode is intval-independent and succeeds, nullptr
+ otherwise
+ */
+static std::shared_ptr<tchecker::clock_reset_container_t const> static_clock_resets(tchecker::bytecode_t const * bytecode)
+{
+  if (!tchecker::intval_independent(bytecode))
+    return nullptr;
+
+  // bytecode does not access bounded integer variables, hence an empty valuation is enough
+  tchecker::clock_constraint_container_t clkconstr;
+  auto clkreset = std::make_shared<tchecker::clock_reset_container_t>();
+  tchecker::intval_t * intval = tchecker::intval_allocate_and_construct(0, 0);
+  tchecker::integer_t value = 0;
+  try {
+    value = tchecker::vm_t{}.run(bytecode, *intval, clkconstr, *clkreset);
+  }
+  catch (...) {
+    value = 0;
+  }
+  tchecker::intval_destruct_and_deallocate(intval);
+
+  if ((value == 0) || !clkconstr.empty())
+    return nullptr;
+  clkreset->shrink_to_fit();
+  return clkreset;
+}
+
+/*!
+ \brief Minimal number of distinct lists of attributes for parallel compilation (smaller systems are compiled by the
+ calling thread, as starting threads would cost more than compiling)
+ */
+static std::size_t const PARALLEL_COMPILATION_THRESHOLD = 64;
+
+/*!
+ \class attributes_cache_t
+ \brief Distinct lists of attributes, identified by the values of their attributes
+ */
+class attributes_cache_t {
+public:
+  using range_t = tchecker::range_t<tchecker::system::attributes_t::const_iterator_t>;
+
+  /*!
+   \brief Add a list of attributes
+   \param attributes : range of attributes
+   \post attributes has been added to the cache if no list with the same values (in the same order) was in the cache
+   \return index of the list in the cache with the same values as attributes
+   */
+  std::size_t add(range_t const & attributes)
+  {
+    std::string key;
+    for (auto && attr : attributes) {
+      key += attr.value();
+      key += '\0';
+    }
+    auto && [it, inserted] = _index.emplace(key, _ranges.size());
+    if (inserted) {
+      _ranges.push_back(attributes);
+      _keys.push_back(std::move(key));
+    }
+    return it->second;
+  }
+
+  /*!
+   \brief Accessor
+   \return number of distinct lists of attributes
+   */
+  inline std::size_t size() const { return _ranges.size(); }
+
+  /*!
+   \brief Accessor
+   \param i : index
+   \pre i < size() (checked by assertion)
+   \return the first added list of attributes with index i
+   */
+  inline range_t const & range(std::size_t i) const
+  {
+    assert(i < _ranges.size());
+    return _ranges[i];
+  }
+
+  /*!
+   \brief Accessor
+   \param i : index
+   \pre i < size() (checked by assertion)
+   \return the values of the attributes of the list with index i
+   */
+  inline std::string const & key(std::size_t i) const
+  {
+    assert(i < _keys.size());
+    return _keys[i];
+  }
+
+private:
+  std::unordered_map<std::string, std::size_t> _index; /*!< Map : values of attributes -> index */
+  std::vector<range_t> _ranges;                        /*!< Map : index -> list of attributes */
+  std::vector<std::string> _keys;                      /*!< Map : index -> values of attributes */
+};
+
+/*!
+ \brief Maximal number of entries of a compilation cache (the cache is emptied when it is full)
+ */
+static std::size_t const COMPILATION_CACHE_SIZE = 1 << 16;
+
+/*!
+ \class compilation_cache_t
+ \brief Process-wide cache of compiled lists of attributes, identified by the declarations of the variables of their
+ system and the values of their attributes
+ \tparam COMPILED : type of compiled lists of attributes
+ \note compiled attributes are immutable once compiled, hence they are shared by the systems built successively from
+ similar declarations, such as the merged systems of the iterations of compositional checks. The cache is safe to use
+ from several threads
+ */
+template <class COMPILED> class compilation_cache_t {
+public:
+  /*!
+   \brief Look up a compiled list of attributes
+   \param key : key of a list of attributes
+   \param compiled : a compiled list of attributes
+   \return true if key is in the cache, false otherwise
+   \post compiled is the compiled list of attributes of key if key is in the cache, it is unchanged otherwise
+   */
+  bool find(std::string const & key, COMPILED & compiled) const
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto it = _cache.find(key);
+    if (it == _cache.end())
+      return false;
+    compiled = it->second;
+    return true;
+  }
+
+  /*!
+   \brief Add a compiled list of attributes
+   \param key : key of a list of attributes
+   \param compiled : compiled list of attributes of key
+   \post compiled has been added to the cache for key. The cache has been emptied first if it was full
+   */
+  void insert(std::string const & key, COMPILED const & compiled)
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    if (_cache.size() >= COMPILATION_CACHE_SIZE)
+      _cache.clear();
+    _cache.emplace(key, compiled);
+  }
+
+private:
+  mutable std::mutex _mutex;                           /*!< Lock of the cache */
+  std::unordered_map<std::string, COMPILED> _cache;    /*!< Map : key -> compiled list of attributes */
+};
+
+/*!
+ \brief Signature of the declarations of variables
+ \param intvars : bounded integer variables
+ \param clocks : clock variables
+ \return a string that identifies the flattened variables in intvars and clocks, with their names, identifiers and
+ domains. Attributes compile to the same typed expressions and bytecode over declarations with the same signature
+ */
+static std::string variables_signature(tchecker::integer_variables_t const & intvars,
+                                       tchecker::clock_variables_t const & clocks)
+{
+  std::stringstream ss;
+  auto const & flat_intvars = intvars.flattened();
+  for (tchecker::intvar_id_t id = 0; id < flat_intvars.size(); ++id) {
+    tchecker::intvar_info_t const & info = flat_intvars.info(id);
+    ss << flat_intvars.name(id) << ':' << info.min() << ':' << info.max() << ':' << info.initial_value() << ';';
+  }
+  ss << '\0';
+  auto const & flat_clocks = clocks.flattened();
+  for (tchecker::clock_id_t id = 0; id < flat_clocks.size(); ++id)
+    ss << flat_clocks.name(id) << ';';
+  ss << '\0';
+  return ss.str();
+}
+
 void system_t::compute_from_syncprod_system()
 {
   _invariants.clear();
@@ -124,16 +363,79 @@ void system_t::compute_from_syncprod_system()
   _statements.resize(edges_count);
   _urgent.resize(locations_count);
 
+  attributes_cache_t invariants, guards, statements;
+  std::vector<std::size_t> invariant_index(locations_count), guard_index(edges_count), statement_index(edges_count);
+
   for (tchecker::loc_id_t id = 0; id < locations_count; ++id) {
     auto const & attributes = tchecker::syncprod::system_t::location(id)->attributes();
-    set_invariant(id, attributes.range("invariant"));
-    set_urgent(id, attributes.range("urgent"));
+    invariant_index[id] = invariants.add(attributes.range(tchecker::system::ATTR_KEY_INVARIANT));
+    set_urgent(id, attributes.range(tchecker::system::ATTR_KEY_URGENT));
   }
 
   for (tchecker::edge_id_t id = 0; id < edges_count; ++id) {
     auto const & attributes = tchecker::syncprod::system_t::edge(id)->attributes();
-    set_guards(id, attributes.range("provided"));
-    set_statements(id, attributes.range("do"));
+    guard_index[id] = guards.add(attributes.range(tchecker::system::ATTR_KEY_PROVIDED));
+    statement_index[id] = statements.add(attributes.range(tchecker::system::ATTR_KEY_DO));
+  }
+
+  // Compile distinct lists of attributes that are not in the caches: invariants, then guards, then statements
+  static compilation_cache_t<compiled_expression_t> expression_cache;
+  static compilation_cache_t<compiled_statement_t> statement_cache;
+  std::string const signature = variables_signature(integer_variables(), clock_variables());
+
+  std::vector<compiled_expression_t> compiled_invariants(invariants.size()), compiled_guards(guards.size());
+  std::vector<compiled_statement_t> compiled_statements(statements.size());
+
+  // a job i < invariants.size() + guards.size() compiles an invariant or a guard, statements come next
+  std::size_t const expressions_count = invariants.size() + guards.size();
+  auto const expression_key = [&](std::size_t i) -> std::string {
+    return signature + (i < invariants.size() ? invariants.key(i) : guards.key(i - invariants.size()));
+  };
+  auto const compiled_expression = [&](std::size_t i) -> compiled_expression_t & {
+    return (i < invariants.size() ? compiled_invariants[i] : compiled_guards[i - invariants.size()]);
+  };
+
+  // native code may have been loaded after a cached list was compiled
+  std::vector<std::size_t> jobs;
+  for (std::size_t i = 0; i < expressions_count; ++i) {
+    compiled_expression_t & c = compiled_expression(i);
+    if (!expression_cache.find(expression_key(i), c))
+      jobs.push_back(i);
+    else if (c._native == nullptr)
+      c._native = tchecker::native::find_function(c._compiled_expr.get());
+  }
+  for (std::size_t i = 0; i < statements.size(); ++i) {
+    compiled_statement_t & c = compiled_statements[i];
+    if (!statement_cache.find(signature + statements.key(i), c))
+      jobs.push_back(expressions_count + i);
+    else if (c._native == nullptr)
+      c._native = tchecker::native::find_function(c._compiled_stmt.get());
+  }
+
+  std::size_t const threads = (jobs.size() < PARALLEL_COMPILATION_THRESHOLD ? 1 : std::thread::hardware_concurrency());
+
+  tchecker::parallel_for(jobs.size(), threads, [&](std::size_t, std::size_t j) {
+    std::size_t const i = jobs[j];
+    if (i < invariants.size())
+      compiled_invariants[i] = compile_conjunction(invariants.range(i));
+    else if (i < expressions_count)
+      compiled_guards[i - invariants.size()] = compile_conjunction(guards.range(i - invariants.size()));
+    else
+      compiled_statements[i - expressions_count] = compile_sequence(statements.range(i - expressions_count));
+  });
+
+  for (std::size_t i : jobs)
+    if (i < expressions_count)
+      expression_cache.insert(expression_key(i), compiled_expression(i));
+    else
+      statement_cache.insert(signature + statements.key(i - expressions_count), compiled_statements[i - expressions_count]);
+
+  for (tchecker::loc_id_t id = 0; id < locations_count; ++id)
+    _invariants[id] = compiled_invariants[invariant_index[id]];
+
+  for (tchecker::edge_id_t id = 0; id < edges_count; ++id) {
+    _guards[id] = compiled_guards[guard_index[id]];
+    _statements[id] = compiled_statements[statement_index[id]];
   }
 
   if (tchecker::ta::has_guarded_weakly_synchronized_event(*this))
@@ -186,24 +488,24 @@ conjunction_from_attributes(tchecker::range_t<tchecker::system::attributes_t::co
   return expr;
 }
 
-void system_t::set_invariant(tchecker::loc_id_t id,
-                             tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> const & invariants)
+system_t::compiled_expression_t
+system_t::compile_conjunction(tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> const & expressions) const
 {
   tchecker::integer_variables_t localvars;
 
-  std::shared_ptr<tchecker::expression_t> invariant_expr{
-      conjunction_from_attributes(invariants, localvars, integer_variables(), clock_variables())};
-  if (invariant_expr.get() == nullptr)
+  std::shared_ptr<tchecker::expression_t> expr{
+      conjunction_from_attributes(expressions, localvars, integer_variables(), clock_variables())};
+  if (expr.get() == nullptr)
     throw std::invalid_argument("Syntax error");
 
-  std::shared_ptr<tchecker::typed_expression_t> invariant_typed_expr{
-      tchecker::typecheck(*invariant_expr, localvars, integer_variables(), clock_variables())};
-  assert(tchecker::bool_valued(invariant_typed_expr->type()));
+  std::shared_ptr<tchecker::typed_expression_t> typed_expr{
+      tchecker::typecheck(*expr, localvars, integer_variables(), clock_variables())};
+  assert(tchecker::bool_valued(typed_expr->type()));
 
   try {
-    std::shared_ptr<tchecker::bytecode_t> invariant_bytecode{tchecker::compile(*invariant_typed_expr),
-                                                             std::default_delete<tchecker::bytecode_t[]>()};
-    _invariants[id] = {invariant_typed_expr, invariant_bytecode};
+    std::shared_ptr<tchecker::bytecode_t> bytecode{tchecker::compile(*typed_expr),
+                                                   std::default_delete<tchecker::bytecode_t[]>()};
+    return {typed_expr, bytecode, static_clock_constraints(bytecode.get()), tchecker::native::find_function(bytecode.get())};
   }
   catch (std::exception const & e) {
     std::stringstream oss;
@@ -219,32 +521,6 @@ void system_t::set_urgent(tchecker::loc_id_t id,
     _urgent[id] = 1;
 }
 
-void system_t::set_guards(tchecker::edge_id_t id,
-                          tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> const & guards)
-{
-  tchecker::integer_variables_t localvars;
-
-  std::shared_ptr<tchecker::expression_t> guard_expr{
-      conjunction_from_attributes(guards, localvars, integer_variables(), clock_variables())};
-  if (guard_expr.get() == nullptr)
-    throw std::invalid_argument("Syntax error");
-
-  std::shared_ptr<tchecker::typed_expression_t> guard_typed_expr{
-      tchecker::typecheck(*guard_expr, localvars, integer_variables(), clock_variables())};
-  assert(tchecker::bool_valued(guard_typed_expr->type()));
-
-  try {
-    std::shared_ptr<tchecker::bytecode_t> guard_bytecode{tchecker::compile(*guard_typed_expr),
-                                                         std::default_delete<tchecker::bytecode_t[]>()};
-    _guards[id] = {guard_typed_expr, guard_bytecode};
-  }
-  catch (std::exception const & e) {
-    std::stringstream oss;
-    oss << e.what();
-    throw std::invalid_argument(oss.str());
-  }
-}
-
 static tchecker::statement_t *
 sequence_from_attributes(tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> const & attributes,
                          tchecker::integer_variables_t const & localvars, tchecker::integer_variables_t const & intvars,
@@ -284,8 +560,8 @@ sequence_from_attributes(tchecker::range_t<tchecker::system::attributes_t::const
   return stmt;
 }
 
-void system_t::set_statements(tchecker::edge_id_t id,
-                              tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> const & statements)
+system_t::compiled_statement_t
+system_t::compile_sequence(tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> const & statements) const
 {
   tchecker::integer_variables_t localvars;
 
@@ -301,7 +577,7 @@ void system_t::set_statements(tchecker::edge_id_t id,
   try {
     std::shared_ptr<tchecker::bytecode_t> bytecode{tchecker::compile(*typed_stmt),
                                                    std::default_delete<tchecker::bytecode_t[]>()};
-    _statements[id] = {typed_stmt, bytecode};
+    return {typed_stmt, bytecode, static_clock_resets(bytecode.get()), tchecker::native::find_function(bytecode.get())};
   }
   catch (std::exception const & e) {
     std::stringstream oss;
@@ -2,22 +2,26 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <unordered_set>
 
 #include "tchecker/clockbounds/solver.hh"
 #include "tchecker/expression/expression.hh"
+#include "tchecker/expression/static_analysis.hh"
 #include "tchecker/expression/type_inference.hh"
 #include "tchecker/expression/typechecking.hh"
 #include "tchecker/parsing/parsing.hh"
+#include "tchecker/statement/static_analysis.hh"
 #include "tchecker/statement/statement.hh"
 #include "tchecker/statement/typechecking.hh"
 #include "tchecker/ta/static_analysis.hh"
 #include "tchecker/ta/system_ha.hh"
 #include "tchecker/utils/log.hh"
-#include "tchecker/vm/compilers_ha.hh"
+#include "tchecker/vm/compilers.hh"
 
 namespace tchecker {
 
@@ -38,20 +42,10 @@ system_t::system_t(tchecker::syncprod::system_t const & system) : tchecker::sync
   compute_from_syncprod_system();
 }
 
-system_t::system_t(tchecker::ta_ha::system_t const & system)
-    : tchecker::syncprod::system_t(system.as_syncprod_system()), _vm(system._vm)
+tchecker::vm_ha::vm_t & system_t::vm() const
 {
-  compute_from_syncprod_system();
-}
-
-tchecker::ta_ha::system_t & system_t::operator=(tchecker::ta_ha::system_t const & system)
-{
-  if (this != &system) {
-    tchecker::syncprod::system_t::operator=(system);
-    _vm = system._vm;
-    compute_from_syncprod_system();
-  }
-  return *this;
+  thread_local tchecker::vm_ha::vm_t vm;
+  return vm;
 }
 
 tchecker::system::attribute_keys_map_t const & system_t::known_attributes()
@@ -115,31 +109,74 @@ void system_t::compute_from_syncprod_system()
   _guards.clear();
   _statements.clear();
   _urgent.reset();
+  _epsilon_events.reset();
+  _epsilon_edges.reset();
+  _written_intvars.clear();
+  _guarded_intvars.clear();
 
   tchecker::loc_id_t const locations_count = this->locations_count();
   tchecker::edge_id_t const edges_count = this->edges_count();
+  tchecker::event_id_t const events_count = this->events_count();
 
   _invariants.resize(locations_count);
   _guards.resize(edges_count);
   _statements.resize(edges_count);
   _urgent.resize(locations_count);
+  _epsilon_events.resize(events_count);
+  _epsilon_edges.resize(edges_count);
+  _written_intvars.resize(events_count);
+
+  for (tchecker::event_id_t id = 0; id < events_count; ++id)
+    _epsilon_events[id] = tchecker::ta_ha::is_epsilon_event_name(event_name(id));
 
   for (tchecker::loc_id_t id = 0; id < locations_count; ++id) {
     auto const & attributes = tchecker::syncprod::system_t::location(id)->attributes();
-    set_invariant(id, attributes.range("invariant"));
-    set_urgent(id, attributes.range("urgent"));
+    set_invariant(id, attributes.range(tchecker::system::ATTR_KEY_INVARIANT));
+    set_urgent(id, attributes.range(tchecker::system::ATTR_KEY_URGENT));
   }
 
   for (tchecker::edge_id_t id = 0; id < edges_count; ++id) {
     auto const & attributes = tchecker::syncprod::system_t::edge(id)->attributes();
-    set_guards(id, attributes.range("provided"));
-    set_statements(id, attributes.range("do"));
+    set_guards(id, attributes.range(tchecker::system::ATTR_KEY_PROVIDED));
+    set_statements(id, attributes.range(tchecker::system::ATTR_KEY_DO));
+    _epsilon_edges[id] = _epsilon_events[tchecker::syncprod::system_t::edge(id)->event_id()];
   }
 
+  compute_written_intvars();
+  compute_guarded_intvars();
+
   if (tchecker::ta::has_guarded_weakly_synchronized_event(*this))
     throw std::invalid_argument("Transitions over weakly synchronized events should not have guards");
 }
 
+void system_t::compute_written_intvars()
+{
+  std::vector<std::unordered_set<tchecker::intvar_id_t>> written(_written_intvars.size());
+  std::unordered_set<tchecker::clock_id_t> clocks;
+
+  for (tchecker::edge_id_t id = 0; id < _statements.size(); ++id)
+    tchecker::extract_written_variables(*_statements[id]._typed_stmt, clocks,
+                                        written[tchecker::syncprod::system_t::edge(id)->event_id()]);
+
+  for (tchecker::event_id_t id = 0; id < written.size(); ++id) {
+    _written_intvars[id].assign(written[id].begin(), written[id].end());
+    std::sort(_written_intvars[id].begin(), _written_intvars[id].end());
+  }
+}
+
+void system_t::compute_guarded_intvars()
+{
+  std::unordered_set<tchecker::intvar_id_t> guarded;
+  std::unordered_set<tchecker::clock_id_t> clocks;
+
+  for (tchecker::edge_id_t id = 0; id < _guards.size(); ++id)
+    tchecker::extract_variables(*_guards[id]._typed_expr, clocks, guarded);
+
+  _guarded_intvars.resize(intvars_count(tchecker::VK_FLATTENED));
+  for (tchecker::intvar_id_t id : guarded)
+    _guarded_intvars[id] = 1;
+}
+
 static tchecker::expression_t *
 conjunction_from_attributes(tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> const & attributes,
                             tchecker::integer_variables_t const & localvars, tchecker::integer_variables_t const & intvars,
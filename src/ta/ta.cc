@@ -10,11 +10,38 @@ namespace tchecker {
 
 namespace ta {
 
-/*!< Place holder constraint container, should stay empty */
-static tchecker::clock_constraint_container_t place_holder_clkconstr;
+/*!< Place holder constraint container, should stay empty (one per thread, as zone graphs may be explored in parallel) */
+static thread_local tchecker::clock_constraint_container_t place_holder_clkconstr;
 
 /*!< Place holder clock reset container, should stay empty */
-static tchecker::clock_reset_container_t place_holder_clkreset;
+static thread_local tchecker::clock_reset_container_t place_holder_clkreset;
+
+/*!
+ \brief Evaluate a guard or an invariant
+ \param vm : virtual machine
+ \param bytecode : bytecode of the expression
+ \param static_clkconstr : clock constraints of the expression if it does not depend on bounded integer variables,
+ nullptr otherwise
+ \param native : native code of the expression, nullptr if none
+ \param intval : valuation of bounded integer variables
+ \param clkconstr : container of clock constraints
+ \return false if the expression does not hold for intval, true otherwise
+ \post the clock constraints of the expression have been pushed to clkconstr. The virtual machine is only used when
+ static_clkconstr and native are nullptr
+ */
+static inline bool eval(tchecker::vm_t & vm, tchecker::bytecode_t const * bytecode,
+                        tchecker::clock_constraint_container_t const * static_clkconstr,
+                        tchecker::native_function_t native, tchecker::intval_t & intval,
+                        tchecker::clock_constraint_container_t & clkconstr)
+{
+  if (static_clkconstr != nullptr) {
+    clkconstr.insert(clkconstr.end(), static_clkconstr->begin(), static_clkconstr->end());
+    return true;
+  }
+  if (native != nullptr)
+    return (native(intval, clkconstr, place_holder_clkreset) != 0);
+  return (vm.run(bytecode, intval, clkconstr, place_holder_clkreset) != 0);
+}
 
 /* Semantics functions */
 
@@ -39,7 +66,8 @@ tchecker::state_status_t initial(tchecker::ta::system_t const & system,
   // check invariant
   tchecker::vm_t & vm = system.vm();
   for (tchecker::loc_id_t loc_id : *vloc) {
-    if (vm.run(system.invariant_bytecode(loc_id), *intval, invariant, place_holder_clkreset) == 0)
+    if (!eval(vm, system.invariant_bytecode(loc_id), system.static_invariant(loc_id),
+              system.native_invariant(loc_id), *intval, invariant))
       return tchecker::STATE_INTVARS_SRC_INVARIANT_VIOLATED;
     assert(place_holder_clkreset.empty());
   }
@@ -82,7 +110,8 @@ tchecker::state_status_t final(tchecker::ta::system_t const & system,
   // check invariant
   tchecker::vm_t & vm = system.vm();
   for (tchecker::loc_id_t loc_id : *vloc) {
-    if (vm.run(system.invariant_bytecode(loc_id), *intval, invariant, place_holder_clkreset) == 0)
+    if (!eval(vm, system.invariant_bytecode(loc_id), system.static_invariant(loc_id),
+              system.native_invariant(loc_id), *intval, invariant))
       return tchecker::STATE_INTVARS_TGT_INVARIANT_VIOLATED;
     assert(place_holder_clkreset.empty());
   }
@@ -104,7 +133,8 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
 
   // check source invariant
   for (tchecker::loc_id_t loc_id : *vloc) {
-    if (vm.run(system.invariant_bytecode(loc_id), *intval, src_invariant, place_holder_clkreset) == 0)
+    if (!eval(vm, system.invariant_bytecode(loc_id), system.static_invariant(loc_id),
+              system.native_invariant(loc_id), *intval, src_invariant))
       return tchecker::STATE_INTVARS_SRC_INVARIANT_VIOLATED;
     assert(place_holder_clkreset.empty());
   }
@@ -116,21 +146,32 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
 
   // check guards
   for (tchecker::system::edge_const_shared_ptr_t const & edge : edges) {
-    if (vm.run(system.guard_bytecode(edge->id()), *intval, guard, place_holder_clkreset) == 0)
+    if (!eval(vm, system.guard_bytecode(edge->id()), system.static_guard(edge->id()),
+              system.native_guard(edge->id()), *intval, guard))
       return tchecker::STATE_INTVARS_GUARD_VIOLATED;
     assert(place_holder_clkreset.empty());
   }
 
   // apply statements
   for (tchecker::system::edge_const_shared_ptr_t const & edge : edges) {
-    if (vm.run(system.statement_bytecode(edge->id()), *intval, place_holder_clkconstr, reset) == 0)
+    tchecker::clock_reset_container_t const * static_reset = system.static_statement(edge->id());
+    if (static_reset != nullptr) {
+      reset.insert(reset.end(), static_reset->begin(), static_reset->end());
+      continue;
+    }
+    tchecker::native_function_t native = system.native_statement(edge->id());
+    tchecker::integer_t const value = (native != nullptr ? native(*intval, place_holder_clkconstr, reset)
+                                                         : vm.run(system.statement_bytecode(edge->id()), *intval,
+                                                                  place_holder_clkconstr, reset));
+    if (value == 0)
       return tchecker::STATE_INTVARS_STATEMENT_FAILED;
     assert(place_holder_clkconstr.empty());
   }
 
   // check target invariant
   for (tchecker::loc_id_t loc_id : *vloc) {
-    if (vm.run(system.invariant_bytecode(loc_id), *intval, tgt_invariant, place_holder_clkreset) == 0)
+    if (!eval(vm, system.invariant_bytecode(loc_id), system.static_invariant(loc_id),
+              system.native_invariant(loc_id), *intval, tgt_invariant))
       return tchecker::STATE_INTVARS_TGT_INVARIANT_VIOLATED;
     assert(place_holder_clkreset.empty());
   }
@@ -244,6 +285,14 @@ tchecker::state_status_t prev(tchecker::ta::system_t const & system,
 
 /* delay_allowed */
 
+bool static_statements(tchecker::ta::system_t const & system, tchecker::ta::outgoing_edges_value_t const & edges)
+{
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : edges)
+    if (system.static_statement(edge->id()) == nullptr)
+      return false;
+  return true;
+}
+
 bool delay_allowed(tchecker::ta::system_t const & system, tchecker::vloc_t const & vloc)
 {
   for (tchecker::loc_id_t loc_id : vloc)
@@ -352,7 +401,8 @@ tchecker::state_status_t initialize(tchecker::ta::system_t const & system,
   // check invariant
   tchecker::vm_t & vm = system.vm();
   for (tchecker::loc_id_t loc_id : *vloc) {
-    if (vm.run(system.invariant_bytecode(loc_id), *intval, invariant, place_holder_clkreset) == 0)
+    if (!eval(vm, system.invariant_bytecode(loc_id), system.static_invariant(loc_id),
+              system.native_invariant(loc_id), *intval, invariant))
       return tchecker::STATE_INTVARS_SRC_INVARIANT_VIOLATED;
     assert(place_holder_clkreset.empty());
   }
@@ -10,17 +10,17 @@ namespace tchecker {
 
 namespace ta_ha {
 
-/*!< Place holder constraint container, should stay empty */
-static tchecker::clock_constraint_container_t place_holder_clkconstr;
+/*!< Place holder constraint container, should stay empty (one per thread, as zone graphs may be explored in parallel) */
+static thread_local tchecker::clock_constraint_container_t place_holder_clkconstr;
 
 /*!< Place holder clock reset container, should stay empty */
-static tchecker::clock_reset_container_t place_holder_clkreset;
+static thread_local tchecker::clock_reset_container_t place_holder_clkreset;
 
 /*!< Place holder integer variable set container, should stay empty */
-static std::vector<std::pair<tchecker::variable_id_t, tchecker::variable_id_t>> place_holder_intvar_set;
+static thread_local tchecker::intvar_set_container_t place_holder_intvar_set;
 
 /*!< Place holder integer variable guard container, should stay empty */
-static std::vector<unsigned> place_holder_intvarconstr;
+static thread_local tchecker::intvar_guard_container_t place_holder_intvarconstr;
 
 /* Semantics functions */
 
@@ -102,9 +102,9 @@ tchecker::state_status_t next(tchecker::ta_ha::system_t const & system,
                               tchecker::intrusive_shared_ptr_t<tchecker::shared_vedge_t> const & vedge,
                               tchecker::clock_constraint_container_t & src_invariant,
                               tchecker::clock_constraint_container_t & guard,
-                              std::vector<unsigned> & intvarconstr,
+                              tchecker::intvar_guard_container_t & intvarconstr,
                               tchecker::clock_reset_container_t & reset,
-                              std::vector<std::pair<tchecker::variable_id_t, tchecker::variable_id_t>> & intvar_set,
+                              tchecker::intvar_set_container_t & intvar_set,
                               tchecker::clock_constraint_container_t & tgt_invariant,
                               tchecker::ta_ha::outgoing_edges_value_t const & edges)
 {
@@ -207,9 +207,9 @@ tchecker::state_status_t prev(tchecker::ta_ha::system_t const & system,
                               tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t> const & intval,
                               tchecker::intrusive_shared_ptr_t<tchecker::shared_vedge_t> const & vedge,
                               tchecker::clock_constraint_container_t & src_invariant,
-                              tchecker::clock_constraint_container_t & guard, std::vector<unsigned> & intvarconstr,
+                              tchecker::clock_constraint_container_t & guard, tchecker::intvar_guard_container_t & intvarconstr,
                               tchecker::clock_reset_container_t & reset,
-                              std::vector<std::pair<tchecker::variable_id_t, tchecker::variable_id_t>> & intvar_set,
+                              tchecker::intvar_set_container_t & intvar_set,
                               tchecker::clock_constraint_container_t & tgt_invariant,
                               tchecker::ta_ha::incoming_edges_value_t const & v)
 {
@@ -36,12 +36,12 @@ tchecker::range_t<tchecker::clock_constraint_container_const_iterator_t> transit
   return tchecker::make_range(_tgt_invariant.begin(), _tgt_invariant.end());
 }
 
-tchecker::range_t<std::vector<std::pair<tchecker::variable_id_t, tchecker::variable_id_t>>::const_iterator> transition_t::intvar_set() const
+tchecker::range_t<tchecker::intvar_set_container_t::const_iterator> transition_t::intvar_set() const
 {
   return tchecker::make_range(_intvar_set.begin(), _intvar_set.end());
 }
 
-tchecker::range_t<std::vector<unsigned>::const_iterator> transition_t::intvar_guard() const
+tchecker::range_t<tchecker::intvar_guard_container_t::const_iterator> transition_t::intvar_guard() const
 {
   return tchecker::make_range(_intvar_guard.begin(), _intvar_guard.end());
 }
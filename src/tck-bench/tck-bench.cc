@@ -0,0 +1,566 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <getopt.h>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/utils/hashtable.hh"
+#include "tchecker/utils/log.hh"
+#include "tchecker/utils/pool.hh"
+#include "tchecker/variables/clocks.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/vm/vm.hh"
+#include "tchecker/zg/state.hh"
+#include "tchecker/zg/zone.hh"
+
+/*!
+ \file tck-bench.cc
+ \brief Micro-benchmarks of the DBM library, the virtual machine, hash tables and pool allocators
+ */
+
+static struct option long_options[] = {{"output", required_argument, 0, 'o'},
+                                       {"dimensions", required_argument, 0, 'd'},
+                                       {"filter", required_argument, 0, 'f'},
+                                       {"json", no_argument, 0, 'j'},
+                                       {"help", no_argument, 0, 'h'},
+                                       {"min-time", required_argument, 0, 0},
+                                       {0, 0, 0, 0}};
+
+static char * const options = (char *)"d:f:hjo:";
+
+/*!
+ \brief Display usage
+ \param progname : programme name
+ */
+void usage(char * progname)
+{
+  std::cerr << "Usage: " << progname << " [options]" << std::endl;
+  std::cerr << "   -d d1,d2,...  comma-separated list of dimensions (default: 2,4,8,16,32)" << std::endl;
+  std::cerr << "   -f s          only run the benchmarks whose name contains s" << std::endl;
+  std::cerr << "   -h            help" << std::endl;
+  std::cerr << "   -j, --json    output results in JSON format" << std::endl;
+  std::cerr << "   -o out_file   output file for results (default is standard output)" << std::endl;
+  std::cerr << "   --min-time t  minimal running time of each benchmark in milliseconds (default: 200)" << std::endl;
+  std::cerr << "the dimension of DBM, hash table and pool benchmarks is the number of clocks plus the reference clock,"
+            << std::endl;
+  std::cerr << "and the dimension of virtual machine benchmarks is the number of conjuncts or assignments in the bytecode"
+            << std::endl;
+}
+
+static bool help = false;                                              /*!< Help flag */
+static bool json = false;                                              /*!< JSON output */
+static std::string output_file = "";                                   /*!< Output file name (empty: standard output) */
+static std::string filter = "";                                        /*!< Filter on benchmark names */
+static std::vector<tchecker::clock_id_t> dimensions{2, 4, 8, 16, 32}; /*!< Dimensions */
+static std::size_t min_time = 200;                                     /*!< Minimal running time (ms) */
+
+/*!
+ \brief Parse command-line arguments
+ \param argc : number of arguments
+ \param argv : array of arguments
+ \pre argv[0] up to argv[argc-1] are valid accesses
+ \post global variables have been set from argv
+ \throw std::invalid_argument : if an option has an invalid parameter
+ */
+int parse_command_line(int argc, char * argv[])
+{
+  while (true) {
+    int long_option_index = -1;
+    int c = getopt_long(argc, argv, options, long_options, &long_option_index);
+
+    if (c == -1)
+      break;
+
+    if (c == ':')
+      throw std::runtime_error("Missing option parameter");
+    else if (c == '?')
+      throw std::runtime_error("Unknown command-line option");
+    else if (c != 0) {
+      switch (c) {
+      case 'd': {
+        dimensions.clear();
+        std::istringstream is{optarg};
+        for (std::string d; std::getline(is, d, ',');) {
+          unsigned long dim = std::stoul(d);
+          if (dim < 2 || dim > 64)
+            throw std::invalid_argument("Invalid dimension " + d + " (should be between 2 and 64)");
+          dimensions.push_back(static_cast<tchecker::clock_id_t>(dim));
+        }
+        if (dimensions.empty())
+          throw std::invalid_argument("Empty list of dimensions");
+        break;
+      }
+      case 'f':
+        filter = optarg;
+        break;
+      case 'h':
+        help = true;
+        break;
+      case 'j':
+        json = true;
+        break;
+      case 'o':
+        if (strcmp(optarg, "") == 0)
+          throw std::invalid_argument("Invalid empty output file name");
+        output_file = optarg;
+        break;
+      default:
+        throw std::runtime_error("This should never be executed");
+        break;
+      }
+    }
+    else {
+      if (strcmp(long_options[long_option_index].name, "min-time") == 0) {
+        min_time = std::stoul(optarg);
+        if (min_time == 0)
+          throw std::invalid_argument("Invalid minimal running time 0");
+      }
+      else
+        throw std::runtime_error("This should never be executed");
+    }
+  }
+
+  return optind;
+}
+
+/*!
+ \brief Sink for computed values: benchmarks write their results to it so that the compiler cannot optimize them out
+ */
+static volatile std::size_t sink = 0;
+
+/*!
+ \class result_t
+ \brief Result of a benchmark
+ */
+struct result_t {
+  std::string family;     /*!< Name of benchmark */
+  unsigned dim;           /*!< Dimension */
+  std::size_t iterations; /*!< Number of iterations */
+  double ns;              /*!< Time per iteration (nanoseconds) */
+};
+
+/*!
+ \brief Type of benchmarks
+ \note a benchmark runs a given number of iterations of the measured operation. The data of the benchmark is
+ built before the benchmark is returned, hence it is not measured
+ */
+using benchmark_t = std::function<void(std::size_t iterations)>;
+
+/*!
+ \brief Measure a benchmark
+ \param benchmark : a benchmark
+ \return number of iterations and time per iteration in nanoseconds
+ \post benchmark has been run with an increasing number of iterations until its running time is at least min_time
+ */
+static std::tuple<std::size_t, double> measure(benchmark_t const & benchmark)
+{
+  using clock_t = std::chrono::steady_clock;
+  std::chrono::nanoseconds const target = std::chrono::milliseconds(min_time);
+
+  benchmark(1); // warm up
+  for (std::size_t iterations = 1;; iterations *= 2) {
+    auto const start = clock_t::now();
+    benchmark(iterations);
+    std::chrono::nanoseconds const elapsed = clock_t::now() - start;
+    if (elapsed >= target || iterations >= (std::size_t{1} << 40))
+      return std::make_tuple(iterations, static_cast<double>(elapsed.count()) / static_cast<double>(iterations));
+  }
+}
+
+/*!
+ \brief Number of DBMs (and of objects of hash tables) a benchmark cycles over
+ */
+static constexpr std::size_t SAMPLES = 1024;
+
+/*!
+ \class dbms_t
+ \brief Random DBMs of a dimension
+ \note the DBMs are built from random valuations of clocks, hence they are consistent and positive. Reproducible
+ pseudo-random numbers are used so that results can be compared across runs
+ */
+class dbms_t {
+public:
+  /*!
+   \brief Constructor
+   \param dim : dimension
+   \post this contains SAMPLES tight DBMs, SAMPLES loose (non tight) DBMs with the same zones, and clock bounds
+   */
+  dbms_t(tchecker::clock_id_t dim) : _dim(dim), _tight(SAMPLES * dim * dim), _loose(SAMPLES * dim * dim), _l(dim), _u(dim)
+  {
+    std::mt19937 gen{static_cast<std::mt19937::result_type>(dim)};
+    std::uniform_int_distribution<tchecker::integer_t> value{0, 20}, slack{0, 3};
+    std::vector<tchecker::integer_t> v(dim, 0);
+    for (std::size_t k = 0; k < SAMPLES; ++k) {
+      for (tchecker::clock_id_t i = 1; i < dim; ++i)
+        v[i] = value(gen);
+      tchecker::dbm::db_t * loose = _loose.data() + k * dim * dim;
+      tchecker::dbm::universal_positive(loose, dim);
+      for (tchecker::clock_id_t i = 0; i < dim; ++i)
+        for (tchecker::clock_id_t j = 0; j < dim; ++j)
+          if (i != j && slack(gen) < 2) {
+            // bounds x0 - xj stay non-positive so that the DBM is positive
+            tchecker::integer_t const bound = v[i] - v[j] + slack(gen);
+            loose[i * dim + j] = tchecker::dbm::db(tchecker::LE, (i == 0 ? std::min(bound, 0) : bound));
+          }
+      tchecker::dbm::db_t * tight = _tight.data() + k * dim * dim;
+      std::copy(loose, loose + dim * dim, tight);
+      tchecker::dbm::tighten(tight, dim);
+    }
+    for (tchecker::clock_id_t i = 0; i + 1 < dim; ++i) {
+      _l[i] = value(gen);
+      _u[i] = value(gen);
+    }
+  }
+
+  inline tchecker::clock_id_t dim() const { return _dim; }
+  inline tchecker::dbm::db_t const * tight(std::size_t k) const { return _tight.data() + (k % SAMPLES) * _dim * _dim; }
+  inline tchecker::dbm::db_t const * loose(std::size_t k) const { return _loose.data() + (k % SAMPLES) * _dim * _dim; }
+  inline tchecker::integer_t const * l() const { return _l.data(); }
+  inline tchecker::integer_t const * u() const { return _u.data(); }
+
+private:
+  tchecker::clock_id_t _dim;               /*!< Dimension */
+  std::vector<tchecker::dbm::db_t> _tight; /*!< Tight DBMs */
+  std::vector<tchecker::dbm::db_t> _loose; /*!< Non-tight DBMs */
+  std::vector<tchecker::integer_t> _l;     /*!< Lower clock bounds */
+  std::vector<tchecker::integer_t> _u;     /*!< Upper clock bounds */
+};
+
+using zone_sptr_t = tchecker::intrusive_shared_ptr_t<tchecker::zg::shared_zone_t>;
+
+/*!
+ \class zone_sptr_hash_t
+ \brief Hash function on shared zones
+ */
+class zone_sptr_hash_t {
+public:
+  std::size_t operator()(zone_sptr_t const & z) const { return z->hash(); }
+};
+
+/*!
+ \class zone_sptr_equal_t
+ \brief Equality predicate on shared zones
+ */
+class zone_sptr_equal_t {
+public:
+  bool operator()(zone_sptr_t const & z1, zone_sptr_t const & z2) const { return *z1 == *z2; }
+};
+
+using zone_table_t = tchecker::hashtable_t<zone_sptr_t, zone_sptr_hash_t, zone_sptr_equal_t>;
+
+/*!
+ \class zones_t
+ \brief Shared zones with the DBMs of dbms_t
+ \note the pool is declared first, hence the zones are released before it is destructed
+ */
+struct zones_t {
+  /*!
+   \brief Constructor
+   \param dbms : random DBMs
+   \post this contains SAMPLES zones with the tight DBMs of dbms, and a hash table of these zones
+   */
+  zones_t(dbms_t const & dbms)
+      : alloc_size(tchecker::allocation_size_t<tchecker::zg::shared_zone_t>::alloc_size(dbms.dim())),
+        pool(SAMPLES, alloc_size), table(SAMPLES, zone_sptr_hash_t{}, zone_sptr_equal_t{})
+  {
+    tchecker::clock_id_t const dim = dbms.dim();
+    for (std::size_t k = 0; k < SAMPLES; ++k) {
+      zones.push_back(pool.construct(dim));
+      std::memcpy(zones.back()->dbm(), dbms.tight(k), dim * dim * sizeof(tchecker::dbm::db_t));
+      table.add(zones.back());
+    }
+  }
+
+  std::size_t alloc_size;                              /*!< Allocation size of zones */
+  tchecker::pool_t<tchecker::zg::shared_zone_t> pool; /*!< Pool of zones */
+  zone_table_t table;                                  /*!< Hash table of zones */
+  std::vector<zone_sptr_t> zones;                      /*!< Zones */
+};
+
+/*!
+ \brief Benchmarks of the DBM library
+ \param dbms : random DBMs
+ \return benchmarks on dbms, with their names
+ */
+static std::vector<std::tuple<std::string, benchmark_t>> dbm_benchmarks(std::shared_ptr<dbms_t> const & dbms)
+{
+  tchecker::clock_id_t const dim = dbms->dim();
+  auto work = std::make_shared<std::vector<tchecker::dbm::db_t>>(dim * dim);
+  std::vector<std::tuple<std::string, benchmark_t>> benchmarks;
+
+  // copies are part of the measured time of the benchmarks that modify DBMs
+  benchmarks.emplace_back("dbm::copy", [=](std::size_t iterations) {
+    for (std::size_t k = 0; k < iterations; ++k) {
+      std::memcpy(work->data(), dbms->tight(k), dim * dim * sizeof(tchecker::dbm::db_t));
+      sink = sink + tchecker::dbm::hash(work->back());
+    }
+  });
+
+  benchmarks.emplace_back("dbm::tighten", [=](std::size_t iterations) {
+    for (std::size_t k = 0; k < iterations; ++k) {
+      std::memcpy(work->data(), dbms->loose(k), dim * dim * sizeof(tchecker::dbm::db_t));
+      sink = sink + tchecker::dbm::tighten(work->data(), dim);
+    }
+  });
+
+  benchmarks.emplace_back("dbm::constrain", [=](std::size_t iterations) {
+    for (std::size_t k = 0; k < iterations; ++k) {
+      std::memcpy(work->data(), dbms->tight(k), dim * dim * sizeof(tchecker::dbm::db_t));
+      tchecker::clock_id_t const x = static_cast<tchecker::clock_id_t>(k % dim);
+      tchecker::clock_id_t const y = static_cast<tchecker::clock_id_t>((k + 1) % dim);
+      sink = sink + tchecker::dbm::constrain(work->data(), dim, x, y, tchecker::LE, 5);
+    }
+  });
+
+  benchmarks.emplace_back("dbm::is_le", [=](std::size_t iterations) {
+    for (std::size_t k = 0; k < iterations; ++k)
+      sink = sink + tchecker::dbm::is_le(dbms->tight(k), dbms->tight(k + 1), dim);
+  });
+
+  benchmarks.emplace_back("dbm::is_alu_le", [=](std::size_t iterations) {
+    for (std::size_t k = 0; k < iterations; ++k)
+      sink = sink + tchecker::dbm::is_alu_le(dbms->tight(k), dbms->tight(k + 1), dim, dbms->l(), dbms->u());
+  });
+
+  benchmarks.emplace_back("dbm::extra_lu_plus", [=](std::size_t iterations) {
+    for (std::size_t k = 0; k < iterations; ++k) {
+      std::memcpy(work->data(), dbms->tight(k), dim * dim * sizeof(tchecker::dbm::db_t));
+      tchecker::dbm::extra_lu_plus(work->data(), dim, dbms->l(), dbms->u());
+      sink = sink + tchecker::dbm::hash(work->back());
+    }
+  });
+
+  benchmarks.emplace_back("dbm::hash", [=](std::size_t iterations) {
+    for (std::size_t k = 0; k < iterations; ++k)
+      sink = sink + tchecker::dbm::hash(dbms->tight(k), dim);
+  });
+
+  return benchmarks;
+}
+
+/*!
+ \brief Benchmarks of hash tables and pool allocators
+ \param dbms : random DBMs
+ \return benchmarks on zones of dbms, with their names
+ */
+static std::vector<std::tuple<std::string, benchmark_t>> table_benchmarks(std::shared_ptr<dbms_t> const & dbms)
+{
+  tchecker::clock_id_t const dim = dbms->dim();
+  auto zones = std::make_shared<zones_t>(*dbms);
+  std::size_t const alloc_size = zones->alloc_size;
+
+  std::vector<std::tuple<std::string, benchmark_t>> benchmarks;
+
+  // the table is cleared every SAMPLES insertions, clearing is part of the measured time
+  benchmarks.emplace_back("hashtable::add", [=](std::size_t iterations) {
+    zone_table_t table{SAMPLES, zone_sptr_hash_t{}, zone_sptr_equal_t{}};
+    for (std::size_t k = 0; k < iterations; ++k) {
+      if (k % SAMPLES == 0)
+        table.clear();
+      sink = sink + table.add(zones->zones[k % SAMPLES]);
+    }
+  });
+
+  benchmarks.emplace_back("hashtable::find", [=](std::size_t iterations) {
+    for (std::size_t k = 0; k < iterations; ++k)
+      sink = sink + std::get<0>(zones->table.find(zones->zones[k % SAMPLES]));
+  });
+
+  benchmarks.emplace_back("pool::construct_destruct", [=](std::size_t iterations) {
+    tchecker::pool_t<tchecker::zg::shared_zone_t> local_pool{SAMPLES, alloc_size};
+    for (std::size_t k = 0; k < iterations; ++k) {
+      zone_sptr_t z = local_pool.construct(dim);
+      sink = sink + z->dim();
+      local_pool.destruct(z);
+    }
+  });
+
+  // the objects are released every SAMPLES allocations and reclaimed by collection, which is measured
+  benchmarks.emplace_back("pool::construct_collect", [=](std::size_t iterations) {
+    tchecker::pool_t<tchecker::zg::shared_zone_t> local_pool{SAMPLES, alloc_size};
+    std::vector<zone_sptr_t> allocated;
+    allocated.reserve(SAMPLES);
+    for (std::size_t k = 0; k < iterations; ++k) {
+      if (allocated.size() == SAMPLES) {
+        allocated.clear();
+        sink = sink + local_pool.collect();
+      }
+      allocated.push_back(local_pool.construct(dim));
+    }
+  });
+
+  return benchmarks;
+}
+
+/*!
+ \brief Benchmarks of the virtual machine
+ \param n : number of conjuncts of guards and of assignments of statements
+ \return benchmarks on bytecode of size n, with their names
+ \note the bytecode is written as tchecker::compile produces it for guard `i0 < 8 && x1 <= 3 && ...` and statement
+ `i0 = (i0 + 1) % 8; x1 = 0; ...` over n bounded integer variables and n clocks
+ */
+static std::vector<std::tuple<std::string, benchmark_t>> vm_benchmarks(unsigned n)
+{
+  auto guard = std::make_shared<std::vector<tchecker::bytecode_t>>();
+  auto statement = std::make_shared<std::vector<tchecker::bytecode_t>>();
+  for (unsigned i = 0; i < n; ++i) {
+    auto const id = static_cast<tchecker::bytecode_t>(i);
+    // i < 8
+    guard->insert(guard->end(), {tchecker::VM_VALUEAT_ID, id, tchecker::VM_PUSH, 8, tchecker::VM_LT});
+    if (i > 0)
+      guard->push_back(tchecker::VM_LAND);
+    // x - 0 <= 3
+    guard->insert(guard->end(), {tchecker::VM_PUSH, static_cast<tchecker::bytecode_t>(id + 1), tchecker::VM_PUSH, 0,
+                                 tchecker::VM_PUSH, 3, tchecker::VM_CLKCONSTR, tchecker::LE, tchecker::VM_PUSH, 1,
+                                 tchecker::VM_LAND});
+    // i = (i + 1) % 8
+    statement->insert(statement->end(), {tchecker::VM_PUSH, id, tchecker::VM_VALUEAT_ID, id, tchecker::VM_PUSH, 1,
+                                         tchecker::VM_SUM, tchecker::VM_PUSH, 8, tchecker::VM_MOD, tchecker::VM_ASSIGN});
+    // x = 0
+    statement->insert(statement->end(), {tchecker::VM_PUSH, static_cast<tchecker::bytecode_t>(id + 1), tchecker::VM_PUSH,
+                                         0, tchecker::VM_PUSH, 0, tchecker::VM_CLKRESET});
+  }
+  guard->push_back(tchecker::VM_RET);
+  statement->insert(statement->end(), {tchecker::VM_PUSH, 1, tchecker::VM_RET});
+
+  auto const size = static_cast<unsigned short>(n);
+  std::shared_ptr<tchecker::intval_t> intval{tchecker::intval_allocate_and_construct(size, size, 0),
+                                             tchecker::intval_destruct_and_deallocate};
+
+  std::vector<std::tuple<std::string, benchmark_t>> benchmarks;
+
+  benchmarks.emplace_back("vm::run_guard", [=](std::size_t iterations) {
+    tchecker::vm_t vm;
+    tchecker::clock_constraint_container_t clkconstr;
+    tchecker::clock_reset_container_t clkreset;
+    for (std::size_t k = 0; k < iterations; ++k) {
+      clkconstr.clear();
+      sink = sink + static_cast<std::size_t>(vm.run(guard->data(), *intval, clkconstr, clkreset));
+    }
+  });
+
+  benchmarks.emplace_back("vm::run_statement", [=](std::size_t iterations) {
+    tchecker::vm_t vm;
+    tchecker::clock_constraint_container_t clkconstr;
+    tchecker::clock_reset_container_t clkreset;
+    for (std::size_t k = 0; k < iterations; ++k) {
+      clkreset.clear();
+      sink = sink + static_cast<std::size_t>(vm.run(statement->data(), *intval, clkconstr, clkreset));
+    }
+  });
+
+  return benchmarks;
+}
+
+/*!
+ \brief Run benchmarks
+ \param benchmarks : benchmarks with their names
+ \param dim : dimension of benchmarks
+ \param results : results
+ \post the benchmarks whose name contains filter have been measured, and their results have been appended to results
+ */
+static void run(std::vector<std::tuple<std::string, benchmark_t>> const & benchmarks, unsigned dim,
+                std::vector<result_t> & results)
+{
+  for (auto const & [name, benchmark] : benchmarks) {
+    std::string const full_name = name + "/" + std::to_string(dim);
+    if (full_name.find(filter) == std::string::npos)
+      continue;
+    auto [iterations, ns] = measure(benchmark);
+    results.push_back(result_t{name, dim, iterations, ns});
+  }
+}
+
+/*!
+ \brief Output results
+ \param os : output stream
+ \param results : results
+ \post results have been output to os in JSON format if json is set, and as a table otherwise
+ */
+static void output(std::ostream & os, std::vector<result_t> const & results)
+{
+  if (!json) {
+    for (result_t const & r : results)
+      os << std::left << std::setw(36) << (r.family + "/" + std::to_string(r.dim)) << std::right << std::setw(14)
+         << std::fixed << std::setprecision(2) << r.ns << " ns" << std::setw(14) << r.iterations << std::endl;
+    return;
+  }
+
+  os << "{" << std::endl;
+  os << "  \"context\": {" << std::endl;
+  os << "    \"min_time_ms\": " << min_time << "," << std::endl;
+#ifdef NDEBUG
+  os << "    \"build\": \"release\"" << std::endl;
+#else
+  os << "    \"build\": \"debug\"" << std::endl;
+#endif
+  os << "  }," << std::endl;
+  os << "  \"benchmarks\": [" << std::endl;
+  for (std::size_t k = 0; k < results.size(); ++k) {
+    result_t const & r = results[k];
+    os << "    {\"name\": \"" << r.family << "/" << r.dim << "\", \"family\": \"" << r.family << "\", \"dim\": " << r.dim
+       << ", \"iterations\": " << r.iterations << ", \"real_time\": " << std::fixed << std::setprecision(3) << r.ns
+       << ", \"time_unit\": \"ns\"}" << (k + 1 < results.size() ? "," : "") << std::endl;
+  }
+  os << "  ]" << std::endl;
+  os << "}" << std::endl;
+}
+
+/*!
+ \brief Main function
+ */
+int main(int argc, char * argv[])
+{
+  try {
+    int optindex = parse_command_line(argc, argv);
+
+    if (argc - optindex > 0) {
+      std::cerr << "Too many arguments" << std::endl;
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    if (help) {
+      usage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+
+    std::vector<result_t> results;
+    for (tchecker::clock_id_t dim : dimensions) {
+      auto dbms = std::make_shared<dbms_t>(dim);
+      run(dbm_benchmarks(dbms), dim, results);
+      run(table_benchmarks(dbms), dim, results);
+      run(vm_benchmarks(dim), dim, results);
+    }
+
+    if (output_file == "")
+      output(std::cout, results);
+    else {
+      std::ofstream ofs{output_file, std::ios::out};
+      if (!ofs)
+        throw std::runtime_error("Cannot write file " + output_file);
+      output(ofs, results);
+    }
+  }
+  catch (std::exception & e) {
+    std::cerr << tchecker::log_error << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
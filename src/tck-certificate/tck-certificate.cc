@@ -0,0 +1,143 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <getopt.h>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "tchecker/graph/binary.hh"
+#include "tchecker/utils/log.hh"
+
+/*!
+ \file tck-certificate.cc
+ \brief Conversion of binary graph certificates
+ */
+
+static struct option long_options[] = {{"format", required_argument, 0, 'f'},
+                                       {"output", required_argument, 0, 'o'},
+                                       {"help", no_argument, 0, 'h'},
+                                       {0, 0, 0, 0}};
+
+static char * const options = (char *)"f:ho:";
+
+/*!
+ \brief Display usage
+ \param progname : programme name
+ */
+void usage(char * progname)
+{
+  std::cerr << "Usage: " << progname << " [options] file" << std::endl;
+  std::cerr << "   -f format  output format" << std::endl;
+  std::cerr << "          dot   graphviz DOT language (default)" << std::endl;
+  std::cerr << "          json  JSON object with arrays of nodes and edges" << std::endl;
+  std::cerr << "   -o file    output file (default is standard output)" << std::endl;
+  std::cerr << "   -h         help" << std::endl;
+  std::cerr << "converts a binary graph certificate output by tck-reach -C graph --format bin" << std::endl;
+}
+
+/*!
+ \brief Output formats
+ */
+enum format_t {
+  FORMAT_DOT,  /*!< Graphviz DOT language */
+  FORMAT_JSON, /*!< JSON */
+};
+
+static bool help = false;                 /*!< Help flag */
+static enum format_t format = FORMAT_DOT; /*!< Output format */
+static std::string output_file = "";      /*!< Output file name (empty means standard output) */
+
+/*!
+ \brief Parse command-line arguments
+ \param argc : number of arguments
+ \param argv : array of arguments
+ \pre argv[0] up to argv[argc-1] are valid accesses
+ \post global variables help, format and output_file have been set from argv
+ */
+int parse_command_line(int argc, char * argv[])
+{
+  while (true) {
+    int long_option_index = -1;
+    int c = getopt_long(argc, argv, options, long_options, &long_option_index);
+
+    if (c == -1)
+      break;
+
+    if (c == ':')
+      throw std::runtime_error("Missing option parameter");
+    else if (c == '?')
+      throw std::runtime_error("Unknown command-line option");
+    else {
+      switch (c) {
+      case 'f':
+        if (strcmp(optarg, "dot") == 0)
+          format = FORMAT_DOT;
+        else if (strcmp(optarg, "json") == 0)
+          format = FORMAT_JSON;
+        else
+          throw std::invalid_argument("Unknown output format: " + std::string(optarg));
+        break;
+      case 'h':
+        help = true;
+        break;
+      case 'o':
+        if (strcmp(optarg, "") == 0)
+          throw std::invalid_argument("Invalid empty output file name");
+        output_file = optarg;
+        break;
+      default:
+        throw std::runtime_error("This should never be executed");
+        break;
+      }
+    }
+  }
+
+  return optind;
+}
+
+/*!
+ \brief Main function
+ */
+int main(int argc, char * argv[])
+{
+  try {
+    int optindex = parse_command_line(argc, argv);
+
+    if (help) {
+      usage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+
+    if (argc - optindex != 1) {
+      std::cerr << (argc == optindex ? "Missing input file" : "Too many input files") << std::endl;
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    tchecker::graph::binary_graph_t g{argv[optindex]};
+
+    std::shared_ptr<std::ofstream> os_ptr{nullptr};
+    std::ostream * os = &std::cout;
+    if (output_file != "") {
+      os_ptr = std::make_shared<std::ofstream>(output_file);
+      if (!*os_ptr)
+        throw std::runtime_error("Cannot write file " + output_file);
+      os = os_ptr.get();
+    }
+
+    if (format == FORMAT_DOT)
+      tchecker::graph::dot_output(*os, g);
+    else
+      tchecker::graph::json_output(*os, g);
+  }
+  catch (std::exception & e) {
+    std::cerr << tchecker::log_error << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <getopt.h>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "tchecker/parsing/binary.hh"
+#include "tchecker/parsing/parsing.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/log.hh"
+
+/*!
+ \file tck-compile.cc
+ \brief Compilation of systems to binary format
+ */
+
+static struct option long_options[] = {{"output", required_argument, 0, 'o'}, {"help", no_argument, 0, 'h'}, {0, 0, 0, 0}};
+
+static char * const options = (char *)"ho:";
+
+/*!
+ \brief Display usage
+ \param progname : programme name
+ */
+void usage(char * progname)
+{
+  std::cerr << "Usage: " << progname << " [options] [file]" << std::endl;
+  std::cerr << "   -o file   output file (required)" << std::endl;
+  std::cerr << "   -h        help" << std::endl;
+  std::cerr << "reads from standard input if file is not provided" << std::endl;
+  std::cerr << "the output file is loaded by tck-reach, tck-liveness, tck-simulate and tck-syntax in place of the model,"
+            << std::endl;
+  std::cerr << "without parsing it" << std::endl;
+}
+
+static bool help = false;            /*!< Help flag */
+static std::string output_file = ""; /*!< Output file name */
+
+/*!
+ \brief Parse command-line arguments
+ \param argc : number of arguments
+ \param argv : array of arguments
+ \pre argv[0] up to argv[argc-1] are valid accesses
+ \post global variables help and output_file have been set from argv
+ */
+int parse_command_line(int argc, char * argv[])
+{
+  while (true) {
+    int long_option_index = -1;
+    int c = getopt_long(argc, argv, options, long_options, &long_option_index);
+
+    if (c == -1)
+      break;
+
+    if (c == ':')
+      throw std::runtime_error("Missing option parameter");
+    else if (c == '?')
+      throw std::runtime_error("Unknown command-line option");
+    else {
+      switch (c) {
+      case 'h':
+        help = true;
+        break;
+      case 'o':
+        if (strcmp(optarg, "") == 0)
+          throw std::invalid_argument("Invalid empty output file name");
+        output_file = optarg;
+        break;
+      default:
+        throw std::runtime_error("This should never be executed");
+        break;
+      }
+    }
+  }
+
+  return optind;
+}
+
+/*!
+ \brief Main function
+ */
+int main(int argc, char * argv[])
+{
+  try {
+    int optindex = parse_command_line(argc, argv);
+
+    if (argc - optindex > 1) {
+      std::cerr << "Too many input files" << std::endl;
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    if (help) {
+      usage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+
+    if (output_file == "") {
+      std::cerr << "Missing output file" << std::endl;
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    std::string input_file = (optindex == argc ? "" : argv[optindex]);
+
+    std::shared_ptr<tchecker::parsing::system_declaration_t> sysdecl{
+        tchecker::parsing::parse_system_declaration(input_file)};
+    if (sysdecl.get() == nullptr || tchecker::log_error_count() > 0) {
+      tchecker::log_output_count(std::cout);
+      return EXIT_FAILURE;
+    }
+
+    // the attributes are checked once at compile time, the binary file is only loaded by the tools
+    tchecker::ta::system_t system{*sysdecl};
+    if (tchecker::log_error_count() > 0) {
+      tchecker::log_output_count(std::cout);
+      return EXIT_FAILURE;
+    }
+
+    std::ofstream ofs{output_file, std::ios::out | std::ios::binary};
+    if (!ofs)
+      throw std::runtime_error("Cannot write file " + output_file);
+    tchecker::parsing::write_binary_system_declaration(ofs, *sysdecl);
+  }
+  catch (std::exception & e) {
+    std::cerr << tchecker::log_error << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -3,6 +3,7 @@
  */
 
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <getopt.h>
 #include <iostream>
@@ -10,8 +11,13 @@
 #include <memory>
 #include <string>
 
+#include "tchecker/algorithms/budget.hh"
+#include "tchecker/algorithms/progress.hh"
+#include "tchecker/algorithms/stats.hh"
 #include "tchecker/parsing/parsing.hh"
+#include "tchecker/utils/async_output.hh"
 #include "tchecker/utils/log.hh"
+#include "tchecker/utils/parallel.hh"
 #include "zg-couvscc.hh"
 #include "zg-ndfs.hh"
 
@@ -25,8 +31,20 @@ static struct option long_options[] = {{"algorithm", required_argument, 0, 'a'},
                                        {"help", no_argument, 0, 'h'},
                                        {"labels", required_argument, 0, 'l'},
                                        {"output", required_argument, 0, 'o'},
+                                       {"lexical-graph", no_argument, 0, 0},
                                        {"block-size", required_argument, 0, 0},
                                        {"table-size", required_argument, 0, 0},
+                                       {"max-memory", required_argument, 0, 0},
+                                       {"max-states", required_argument, 0, 0},
+                                       {"timeout", required_argument, 0, 0},
+                                       {"stats-format", required_argument, 0, 0},
+                                       {"progress", required_argument, 0, 0},
+                                       {"progress-file", required_argument, 0, 0},
+                                       {"threads", required_argument, 0, 0},
+                                       {"pin", no_argument, 0, 0},
+                                       {"deterministic", no_argument, 0, 0},
+                                       {"subsumption", no_argument, 0, 0},
+                                       {"por", no_argument, 0, 0},
                                        {0, 0, 0, 0}};
 
 static char const * const options = (char *)"a:C:hl:o:";
@@ -39,27 +57,55 @@ void usage(char * progname)
 {
   std::cerr << "Usage: " << progname << " [options] [file]" << std::endl;
   std::cerr << "   -a algorithm  liveness algorithm" << std::endl;
+  std::cerr << "          cndfs      multi-core nested depth-first search algorithm over the zone graph (see --threads)"
+            << std::endl;
+  std::cerr << "                     search an accepting cycle with a state with all labels" << std::endl;
   std::cerr << "          couvscc    Couvreur's SCC-decomposition-based algorithm" << std::endl;
   std::cerr << "                     search an accepting cycle that visits all labels" << std::endl;
   std::cerr << "          ndfs       nested depth-first search algorithm over the zone graph" << std::endl;
   std::cerr << "                     search an accepting cycle with a state with all labels" << std::endl;
+  std::cerr << "          owcty      multi-core breadth-first elimination algorithm over the full zone graph (see --threads)"
+            << std::endl;
+  std::cerr << "                     search an accepting cycle that visits all labels" << std::endl;
   std::cerr << "   -C type       type of certificate" << std::endl;
   std::cerr << "          none       no certificate (default)" << std::endl;
   std::cerr << "          graph      graph of explored state-space" << std::endl;
-  std::cerr << "          symbolic   symbolic lasso run with loop on labels (not for couvscc with multiple labels)"
+  std::cerr << "          symbolic   symbolic lasso run with loop on labels (not for couvscc and owcty"
             << std::endl;
+  std::cerr << "                     with multiple labels)" << std::endl;
   std::cerr << "   -h            help" << std::endl;
   std::cerr << "   -l l1,l2,...  comma-separated list of accepting labels" << std::endl;
   std::cerr << "   -o out_file   output file for certificate (default is standard output)" << std::endl;
+  std::cerr << "   --lexical-graph        output the nodes and edges of graph certificates in lexical order"
+            << std::endl;
+  std::cerr << "                          (deterministic but slower, default: order of exploration)" << std::endl;
   std::cerr << "   --block-size  size of allocation blocks" << std::endl;
   std::cerr << "   --table-size  size of hash tables" << std::endl;
+  std::cerr << "   --max-memory n[K|M|G]  stop when memory usage exceeds n bytes (default: no limit)" << std::endl;
+  std::cerr << "   --max-states n         stop after visiting n states (default: no limit)" << std::endl;
+  std::cerr << "   --timeout s            stop after s seconds (default: no limit)" << std::endl;
+  std::cerr << "                          the verdict is unknown when a limit stops the search" << std::endl;
+  std::cerr << "   --stats-format f       output statistics as text (default) or json" << std::endl;
+  std::cerr << "   --progress s           report progress every s seconds on standard error" << std::endl;
+  std::cerr << "   --progress-file f      report progress to file f instead of standard error" << std::endl;
+  std::cerr << "   --threads n            number of workers of cndfs, couvscc and owcty (default: 1)" << std::endl;
+  std::cerr << "   --pin                  pin the workers of cndfs, couvscc and owcty to processors, which keeps the memory"
+            << std::endl;
+  std::cerr << "                          of each worker on its socket" << std::endl;
+  std::cerr << "   --deterministic        certificates of cndfs do not depend on the scheduling of its workers: they"
+            << std::endl;
+  std::cerr << "                          are computed by ndfs, hence they are the same as with -a ndfs" << std::endl;
+  std::cerr << "   --subsumption          prune ndfs with aLU subsumption of zones" << std::endl;
+  std::cerr << "   --por                  partial-order reduction of independent asynchronous edges" << std::endl;
   std::cerr << "reads from standard input if file is not provided" << std::endl;
 }
 
 enum algorithm_t {
+  ALGO_CNDFS,   /*!< Multi-core nested DFS algorithm */
   ALGO_COUVSCC, /*!< Couvreur's SCC algorithm */
   ALGO_NDFS,    /*!< Nested DFS algorithm */
   ALGO_NONE,    /*!< No algorithm */
+  ALGO_OWCTY,   /*!< One-Way-Catch-Them-Young algorithm */
 };
 
 enum certificate_t {
@@ -73,9 +119,85 @@ static enum certificate_t certificate = CERTIFICATE_NONE; /*!< Type of certifica
 static bool help = false;                                 /*!< Help flag */
 static std::string labels = "";                           /*!< Searched labels */
 static std::string output_file = "";                      /*!< Output file name (empty means standard output) */
+static bool lexical_graph = false;                        /*!< Graph certificates in lexical order */
 static std::ostream * os = &std::cout;                    /*!< Default output stream */
 static std::size_t block_size = 10000;                    /*!< Size of allocated blocks */
 static std::size_t table_size = 65536;                    /*!< Size of hash tables */
+static std::size_t max_memory = 0;                        /*!< Memory budget in bytes (0: no limit) */
+static unsigned long max_states = 0;                      /*!< Budget of visited states (0: no limit) */
+static unsigned long timeout = 0;                         /*!< Time budget in seconds (0: no limit) */
+/*! Output format of statistics */
+static enum tchecker::algorithms::stats_format_t stats_format = tchecker::algorithms::STATS_FORMAT_TEXT;
+static unsigned long progress_period = 0;                 /*!< Seconds between progress reports (0: none) */
+static std::string progress_file = "";                    /*!< Progress report file (empty: standard error) */
+static std::size_t threads = 1;                           /*!< Number of workers of cndfs, couvscc and owcty */
+static bool deterministic = false;                        /*!< Certificates of cndfs independent of scheduling */
+static bool subsumption = false;                          /*!< Subsumption in ndfs */
+static bool por = false;                                  /*!< Partial-order reduction */
+
+/*!
+ \brief Parse a memory size
+ \param s : a string
+ \return the number of bytes in s, an integer optionally followed by K, M or G (powers of 1024)
+ \throw std::invalid_argument : if s is not a valid memory size
+ */
+static std::size_t parse_memory_size(char const * s)
+{
+  char * end = nullptr;
+  std::size_t size = std::strtoull(s, &end, 10);
+  if (end == s)
+    throw std::invalid_argument("Invalid memory size: " + std::string{s});
+  switch (*end) {
+  case '\0':
+    return size;
+  case 'K':
+  case 'k':
+    size <<= 10;
+    break;
+  case 'M':
+  case 'm':
+    size <<= 20;
+    break;
+  case 'G':
+  case 'g':
+    size <<= 30;
+    break;
+  default:
+    throw std::invalid_argument("Invalid memory size: " + std::string{s});
+  }
+  if (*(end + 1) != '\0')
+    throw std::invalid_argument("Invalid memory size: " + std::string{s});
+  return size;
+}
+
+/*!
+ \brief Parse a format of statistics
+ \param s : a string
+ \return the format of statistics named s (text or json)
+ \throw std::invalid_argument : if s is not a format of statistics
+ */
+static enum tchecker::algorithms::stats_format_t parse_stats_format(char const * s)
+{
+  if (strcmp(s, "text") == 0)
+    return tchecker::algorithms::STATS_FORMAT_TEXT;
+  if (strcmp(s, "json") == 0)
+    return tchecker::algorithms::STATS_FORMAT_JSON;
+  throw std::invalid_argument("Unknown format of statistics: " + std::string{s});
+}
+
+/*!
+ \brief Budget from the command line
+ \return the budget of visited states, running time and memory set by the command-line options, with the progress
+ heartbeat if progress is reported
+ */
+static tchecker::algorithms::budget_t budget()
+{
+  std::shared_ptr<tchecker::algorithms::progress_t> progress{
+      progress_period == 0 ? nullptr
+                           : new tchecker::algorithms::progress_t{
+                                 progress_file, std::chrono::milliseconds{progress_period * 1000}, stats_format}};
+  return tchecker::algorithms::budget_t{max_states, std::chrono::milliseconds{timeout * 1000}, max_memory, progress};
+}
 
 /*!
  \brief Parse command-line arguments
@@ -105,6 +227,10 @@ int parse_command_line(int argc, char * argv[])
           algorithm = ALGO_NDFS;
         else if (strcmp(optarg, "couvscc") == 0)
           algorithm = ALGO_COUVSCC;
+        else if (strcmp(optarg, "cndfs") == 0)
+          algorithm = ALGO_CNDFS;
+        else if (strcmp(optarg, "owcty") == 0)
+          algorithm = ALGO_OWCTY;
         else
           throw std::runtime_error("Unknown algorithm: " + std::string(optarg));
         break;
@@ -137,6 +263,36 @@ int parse_command_line(int argc, char * argv[])
         block_size = std::strtoull(optarg, nullptr, 10);
       else if (strcmp(long_options[long_option_index].name, "table-size") == 0)
         table_size = std::strtoull(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "max-memory") == 0)
+        max_memory = parse_memory_size(optarg);
+      else if (strcmp(long_options[long_option_index].name, "max-states") == 0)
+        max_states = std::strtoul(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "timeout") == 0)
+        timeout = std::strtoul(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "stats-format") == 0)
+        stats_format = parse_stats_format(optarg);
+      else if (strcmp(long_options[long_option_index].name, "progress") == 0) {
+        progress_period = std::strtoul(optarg, nullptr, 10);
+        if (progress_period == 0)
+          throw std::invalid_argument("Period of progress reports should be positive");
+      }
+      else if (strcmp(long_options[long_option_index].name, "progress-file") == 0)
+        progress_file = optarg;
+      else if (strcmp(long_options[long_option_index].name, "subsumption") == 0)
+        subsumption = true;
+      else if (strcmp(long_options[long_option_index].name, "por") == 0)
+        por = true;
+      else if (strcmp(long_options[long_option_index].name, "lexical-graph") == 0)
+        lexical_graph = true;
+      else if (strcmp(long_options[long_option_index].name, "threads") == 0) {
+        threads = std::strtoull(optarg, nullptr, 10);
+        if (threads == 0)
+          throw std::invalid_argument("Number of threads should be positive");
+      }
+      else if (strcmp(long_options[long_option_index].name, "pin") == 0)
+        tchecker::set_thread_pinning(true);
+      else if (strcmp(long_options[long_option_index].name, "deterministic") == 0)
+        deterministic = true;
       else
         throw std::runtime_error("This also should never be executed");
     }
@@ -167,7 +323,7 @@ tchecker::parsing::system_declaration_t * load_system_declaration(std::string co
 }
 
 /*!
- \brief Run nested DFS algorithm
+ \brief Run nested DFS algorithm (sequential or multi-core w.r.t. the selected algorithm)
  \param sysdecl : system declaration
  \post statistics on accepting run w.r.t. command-line specified labels in
  the system declared by sysdecl have been output to standard output.
@@ -175,17 +331,34 @@ tchecker::parsing::system_declaration_t * load_system_declaration(std::string co
 */
 void ndfs(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
 {
-  auto && [stats, graph] = tchecker::tck_liveness::zg_ndfs::run(sysdecl, labels, block_size, table_size);
+  if (subsumption && algorithm != ALGO_NDFS)
+    throw std::invalid_argument("Subsumption is only available with ndfs algorithm");
+
+  tchecker::algorithms::budget_t const budget = ::budget();
+  auto && [stats, graph] =
+      (algorithm == ALGO_CNDFS
+           ? tchecker::tck_liveness::zg_ndfs::run_cndfs(sysdecl, labels, threads, block_size, table_size, budget, por)
+           : tchecker::tck_liveness::zg_ndfs::run(sysdecl, labels, block_size, table_size, budget, subsumption, por));
 
   // stats
   std::map<std::string, std::string> m;
   stats.attributes(m);
-  for (auto && [key, value] : m)
-    std::cout << key << " " << value << std::endl;
+  tchecker::algorithms::output_attributes(std::cout, m, stats_format);
+
+  // the graph of the worker of cndfs that has found a cycle depends on the scheduling of the workers, and so does
+  // the counter example. In deterministic mode, the certificate is computed by the sequential nested DFS instead
+  if (deterministic && (algorithm == ALGO_CNDFS) &&
+      ((certificate == CERTIFICATE_GRAPH) || ((certificate == CERTIFICATE_SYMBOLIC) && stats.cycle()))) {
+    auto && [sequential_stats, sequential_graph] =
+        tchecker::tck_liveness::zg_ndfs::run(sysdecl, labels, block_size, table_size, budget, false, por);
+    if (sequential_stats.budget_exceeded() && !sequential_stats.cycle())
+      throw std::runtime_error("*** tck_liveness: budget exceeded while computing a deterministic certificate");
+    graph = sequential_graph;
+  }
 
   // certificate
   if (certificate == CERTIFICATE_GRAPH)
-    tchecker::tck_liveness::zg_ndfs::dot_output(*os, *graph, sysdecl->name());
+    tchecker::tck_liveness::zg_ndfs::dot_output(*os, *graph, sysdecl->name(), lexical_graph);
   else if ((certificate == CERTIFICATE_SYMBOLIC) && stats.cycle()) {
     std::unique_ptr<tchecker::tck_liveness::zg_ndfs::cex::symbolic_cex_t> cex{
         tchecker::tck_liveness::zg_ndfs::cex::symbolic_counter_example(*graph)};
@@ -196,7 +369,7 @@ void ndfs(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysde
 }
 
 /*!
- \brief Run Couvreur's algorithm
+ \brief Run Couvreur's algorithm (sequential or multi-core) or the OWCTY algorithm w.r.t. the selected algorithm
  \param sysdecl : system declaration
  \post statistics on accepting run w.r.t. command-line specified labels in
  the system declared by sysdecl have been output to standard output.
@@ -204,23 +377,29 @@ void ndfs(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysde
 */
 void couvscc(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
 {
+  if (subsumption)
+    throw std::invalid_argument("Subsumption is only available with ndfs algorithm");
+
   std::string::difference_type labels_count = std::count(labels.begin(), labels.end(), ',') + 1;
 
   if (certificate == CERTIFICATE_SYMBOLIC && labels_count > 1)
     throw std::runtime_error(
         "*** tck_liveness: cannot compute symbolic counter example with more than 1 label (use graph instead)");
 
-  auto && [stats, graph] = tchecker::tck_liveness::zg_couvscc::run(sysdecl, labels, block_size, table_size);
+  tchecker::algorithms::budget_t const budget = ::budget();
+  auto && [stats, graph] =
+      (algorithm == ALGO_OWCTY
+           ? tchecker::tck_liveness::zg_couvscc::run_owcty(sysdecl, labels, block_size, table_size, budget, por, threads)
+           : tchecker::tck_liveness::zg_couvscc::run(sysdecl, labels, block_size, table_size, budget, por, threads));
 
   // stats
   std::map<std::string, std::string> m;
   stats.attributes(m);
-  for (auto && [key, value] : m)
-    std::cout << key << " " << value << std::endl;
+  tchecker::algorithms::output_attributes(std::cout, m, stats_format);
 
   // certificate
   if (certificate == CERTIFICATE_GRAPH)
-    tchecker::tck_liveness::zg_couvscc::dot_output(*os, *graph, sysdecl->name());
+    tchecker::tck_liveness::zg_couvscc::dot_output(*os, *graph, sysdecl->name(), lexical_graph);
   else if ((certificate == CERTIFICATE_SYMBOLIC) && stats.cycle()) {
     std::unique_ptr<tchecker::tck_liveness::zg_couvscc::cex::symbolic_cex_t> cex{
         tchecker::tck_liveness::zg_couvscc::cex::symbolic_counter_example(*graph)};
@@ -257,11 +436,13 @@ int main(int argc, char * argv[])
       return EXIT_FAILURE;
 
     std::shared_ptr<std::ofstream> os_ptr{nullptr};
+    std::shared_ptr<tchecker::async_ostream_t> async_os_ptr{nullptr}; // certificate files are written in background
 
     if (certificate != CERTIFICATE_NONE && output_file != "") {
       try {
         os_ptr = std::make_shared<std::ofstream>(output_file);
-        os = os_ptr.get();
+        async_os_ptr = std::make_shared<tchecker::async_ostream_t>(*os_ptr);
+        os = async_os_ptr.get();
       }
       catch (std::exception & e) {
         std::cerr << tchecker::log_error << e.what() << std::endl;
@@ -271,14 +452,19 @@ int main(int argc, char * argv[])
 
     switch (algorithm) {
     case ALGO_NDFS:
+    case ALGO_CNDFS:
       ndfs(sysdecl);
       break;
     case ALGO_COUVSCC:
+    case ALGO_OWCTY:
       couvscc(sysdecl);
       break;
     default:
       throw std::runtime_error("No algorithm specified");
     }
+
+    if (async_os_ptr != nullptr)
+      async_os_ptr->close();
   }
   catch (std::exception & e) {
     std::cerr << tchecker::log_error << e.what() << std::endl;
@@ -2,6 +2,8 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <vector>
+
 #include <boost/dynamic_bitset.hpp>
 
 #include "counter_example.hh"
@@ -116,8 +118,11 @@ public:
   }
 };
 
-std::ostream & dot_output(std::ostream & os, tchecker::tck_liveness::zg_couvscc::graph_t const & g, std::string const & name)
+std::ostream & dot_output(std::ostream & os, tchecker::tck_liveness::zg_couvscc::graph_t const & g, std::string const & name,
+                          bool lexical)
 {
+  if (!lexical)
+    return tchecker::graph::dot_output_stream(os, g, name);
   return tchecker::graph::reachability::dot_output<tchecker::tck_liveness::zg_couvscc::graph_t,
                                                    tchecker::tck_liveness::zg_couvscc::node_lexical_less_t,
                                                    tchecker::tck_liveness::zg_couvscc::edge_lexical_less_t>(os, g, name);
@@ -144,8 +149,12 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_liveness::zg_couvscc:
 
 std::tuple<tchecker::algorithms::couvscc::stats_t, std::shared_ptr<tchecker::tck_liveness::zg_couvscc::graph_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
-    std::size_t block_size, std::size_t table_size)
+    std::size_t block_size, std::size_t table_size, tchecker::algorithms::budget_t const & budget, bool por,
+    std::size_t threads)
 {
+  if (threads == 0)
+    throw std::invalid_argument("Number of threads should be positive");
+
   std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
   if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
     std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
@@ -157,17 +166,79 @@ run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, st
       new tchecker::tck_liveness::zg_couvscc::graph_t{zg, block_size, table_size}};
 
   boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+  std::shared_ptr<tchecker::ta::por_t const> reduction{nullptr};
+  if (por) {
+    reduction = std::make_shared<tchecker::ta::por_t const>(*system, accepting_labels);
+    zg->partial_order_reduction(reduction);
+  }
 
   tchecker::algorithms::couvscc::stats_t stats;
 
-  if (accepting_labels.count() > 1) {
-    tchecker::tck_liveness::zg_couvscc::generalized_algorithm_t algorithm;
+  if (threads > 1) {
+    // each worker computes successors in its own zone graph (and virtual machine), the reduction is read-only
+    std::vector<std::shared_ptr<tchecker::zg::zg_t>> workers;
+    for (std::size_t p = 0; p < threads; ++p) {
+      workers.emplace_back(tchecker::zg::factory(system, tchecker::ts::NO_SHARING, tchecker::zg::ELAPSED_SEMANTICS,
+                                                 tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size, table_size));
+      if (por)
+        workers.back()->partial_order_reduction(reduction);
+    }
+    tchecker::tck_liveness::zg_couvscc::ufscc_algorithm_t algorithm{budget};
+    stats = algorithm.run(*zg, *graph, workers, accepting_labels);
+  }
+  else if (accepting_labels.count() > 1) {
+    tchecker::tck_liveness::zg_couvscc::generalized_algorithm_t algorithm{budget};
     stats = algorithm.run(*zg, *graph, accepting_labels);
   }
   else {
-    tchecker::tck_liveness::zg_couvscc::single_algorithm_t algorithm;
+    tchecker::tck_liveness::zg_couvscc::single_algorithm_t algorithm{budget};
     stats = algorithm.run(*zg, *graph, accepting_labels);
   }
+  zg->memory_usage(stats.memory_usage());
+  graph->memory_usage(stats.memory_usage());
+
+  return std::make_tuple(stats, graph);
+}
+
+std::tuple<tchecker::algorithms::couvscc::stats_t, std::shared_ptr<tchecker::tck_liveness::zg_couvscc::graph_t>>
+run_owcty(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+          std::size_t block_size, std::size_t table_size, tchecker::algorithms::budget_t const & budget, bool por,
+          std::size_t threads)
+{
+  if (threads == 0)
+    throw std::invalid_argument("Number of threads should be positive");
+
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+  if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
+    std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
+
+  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, tchecker::ts::SHARING, tchecker::zg::ELAPSED_SEMANTICS,
+                                                               tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size, table_size)};
+
+  std::shared_ptr<tchecker::tck_liveness::zg_couvscc::graph_t> graph{
+      new tchecker::tck_liveness::zg_couvscc::graph_t{zg, block_size, table_size}};
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+  std::shared_ptr<tchecker::ta::por_t const> reduction{nullptr};
+  if (por) {
+    reduction = std::make_shared<tchecker::ta::por_t const>(*system, accepting_labels);
+    zg->partial_order_reduction(reduction);
+  }
+
+  // successors are computed sequentially by the BFS when there is a single thread
+  std::vector<std::shared_ptr<tchecker::zg::zg_t>> workers;
+  for (std::size_t p = 0; threads > 1 && p < threads; ++p) {
+    workers.emplace_back(tchecker::zg::factory(system, tchecker::ts::NO_SHARING, tchecker::zg::ELAPSED_SEMANTICS,
+                                               tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size, table_size));
+    if (por)
+      workers.back()->partial_order_reduction(reduction);
+  }
+
+  tchecker::tck_liveness::zg_couvscc::owcty_algorithm_t algorithm{budget};
+  tchecker::algorithms::couvscc::stats_t stats = algorithm.run(*zg, *graph, workers, accepting_labels);
+
+  zg->memory_usage(stats.memory_usage());
+  graph->memory_usage(stats.memory_usage());
 
   return std::make_tuple(stats, graph);
 }
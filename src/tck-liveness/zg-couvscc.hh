@@ -12,7 +12,9 @@
 
 #include "tchecker/algorithms/couvreur_scc/algorithm.hh"
 #include "tchecker/algorithms/couvreur_scc/graph.hh"
+#include "tchecker/algorithms/couvreur_scc/owcty.hh"
 #include "tchecker/algorithms/couvreur_scc/stats.hh"
+#include "tchecker/algorithms/couvreur_scc/ufscc.hh"
 #include "tchecker/graph/edge.hh"
 #include "tchecker/graph/node.hh"
 #include "tchecker/graph/reachability_graph.hh"
@@ -159,9 +161,12 @@ private:
  \param os : output stream
  \param g : graph
  \param name : graph name
+ \param lexical : if true, nodes and edges are output in lexical order, otherwise they are streamed
+ in the order of the graph (see tchecker::graph::dot_output_stream)
  \post graph g with name has been output to os
 */
-std::ostream & dot_output(std::ostream & os, tchecker::tck_liveness::zg_couvscc::graph_t const & g, std::string const & name);
+std::ostream & dot_output(std::ostream & os, tchecker::tck_liveness::zg_couvscc::graph_t const & g, std::string const & name,
+                          bool lexical = false);
 
 namespace cex {
 
@@ -217,18 +222,75 @@ public:
                                                           tchecker::tck_liveness::zg_couvscc::graph_t>::single_algorithm_t;
 };
 
+/*!
+ \class ufscc_algorithm_t
+ \brief Multi-core union-find SCC liveness algorithm over the zone graph
+*/
+class ufscc_algorithm_t
+    : public tchecker::algorithms::couvscc::ufscc_algorithm_t<tchecker::zg::zg_t, tchecker::tck_liveness::zg_couvscc::graph_t> {
+public:
+  using tchecker::algorithms::couvscc::ufscc_algorithm_t<tchecker::zg::zg_t,
+                                                         tchecker::tck_liveness::zg_couvscc::graph_t>::ufscc_algorithm_t;
+};
+
+/*!
+ \class owcty_algorithm_t
+ \brief Multi-core breadth-first liveness algorithm over the zone graph
+*/
+class owcty_algorithm_t
+    : public tchecker::algorithms::couvscc::owcty_algorithm_t<tchecker::zg::zg_t, tchecker::tck_liveness::zg_couvscc::graph_t> {
+public:
+  using tchecker::algorithms::couvscc::owcty_algorithm_t<tchecker::zg::zg_t,
+                                                         tchecker::tck_liveness::zg_couvscc::graph_t>::owcty_algorithm_t;
+};
+
 /*!
  \brief Run Couvreur's algorithm on the zone graph of a system
  \param sysdecl : system declaration
  \param labels : comma-separated string of labels
  \param block_size : number of elements allocated in one block
  \param table_size : size of hash tables
+ \param budget : budget of visited states, running time and memory
+ \param por : partial-order reduction flag
+ \param threads : number of workers
  \pre labels must appear as node attributes in sysdecl
  \return statistics on the run and the liveness graph
+ \throw std::invalid_argument : if threads is 0
+ \note the run stops when budget is exceeded, which is recorded in the returned statistics
+ \note if por is true, the zone graph is reduced w.r.t. labels (see tchecker::ta::por_t and
+ tchecker::zg::zg_t::partial_order_reduction)
+ \note if threads is 1, Couvreur's algorithm is run. Otherwise, threads workers run the UFSCC algorithm (see
+ tchecker::tck_liveness::zg_couvscc::ufscc_algorithm_t), and the liveness graph contains the states expanded by
+ all the workers
  */
 std::tuple<tchecker::algorithms::couvscc::stats_t, std::shared_ptr<tchecker::tck_liveness::zg_couvscc::graph_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
-    std::size_t block_size = 10000, std::size_t table_size = 65536);
+    std::size_t block_size = 10000, std::size_t table_size = 65536,
+    tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{}, bool por = false,
+    std::size_t threads = 1);
+
+/*!
+ \brief Run the OWCTY algorithm on the zone graph of a system
+ \param sysdecl : system declaration
+ \param labels : comma-separated string of labels
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param budget : budget of visited states, running time and memory
+ \param por : partial-order reduction flag
+ \param threads : number of workers
+ \pre labels must appear as node attributes in sysdecl
+ \return statistics on the run and the liveness graph, which is the full zone graph (see
+ tchecker::tck_liveness::zg_couvscc::owcty_algorithm_t)
+ \throw std::invalid_argument : if threads is 0
+ \note the run stops when budget is exceeded, which is recorded in the returned statistics
+ \note if por is true, the zone graph is reduced w.r.t. labels (see tchecker::ta::por_t and
+ tchecker::zg::zg_t::partial_order_reduction)
+ */
+std::tuple<tchecker::algorithms::couvscc::stats_t, std::shared_ptr<tchecker::tck_liveness::zg_couvscc::graph_t>>
+run_owcty(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
+          std::size_t block_size = 10000, std::size_t table_size = 65536,
+          tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{}, bool por = false,
+          std::size_t threads = 1);
 
 } // namespace zg_couvscc
 
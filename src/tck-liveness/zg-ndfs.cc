@@ -5,6 +5,7 @@
 #include <boost/dynamic_bitset.hpp>
 
 #include "counter_example.hh"
+#include "tchecker/clockbounds/solver.hh"
 #include "tchecker/system/static_analysis.hh"
 #include "tchecker/ta/system.hh"
 #include "tchecker/utils/log.hh"
@@ -37,6 +38,34 @@ bool node_equal_to_t::operator()(tchecker::tck_liveness::zg_ndfs::node_t const &
   return tchecker::zg::shared_equal_to(n1.state(), n2.state());
 }
 
+/* node_discrete_hash_t */
+
+std::size_t node_discrete_hash_t::operator()(tchecker::tck_liveness::zg_ndfs::node_t const & n) const
+{
+  return tchecker::ta::shared_hash_value(n.state());
+}
+
+/* node_alu_le_t */
+
+node_alu_le_t::node_alu_le_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & clock_bounds)
+    : _clock_bounds(clock_bounds), _cache(clock_bounds)
+{
+  if (_clock_bounds.get() == nullptr)
+    throw std::invalid_argument("nullptr clock bounds");
+}
+
+node_alu_le_t::node_alu_le_t(tchecker::tck_liveness::zg_ndfs::node_alu_le_t const & le)
+    : node_alu_le_t(le._clock_bounds)
+{
+}
+
+bool node_alu_le_t::operator()(tchecker::tck_liveness::zg_ndfs::node_t const & n1,
+                               tchecker::tck_liveness::zg_ndfs::node_t const & n2) const
+{
+  auto && [l, u] = _cache.bounds(n2.state().vloc());
+  return tchecker::zg::shared_is_alu_le(n1.state(), n2.state(), l, u);
+}
+
 /* edge_t */
 
 edge_t::edge_t(tchecker::zg::transition_t const & t) : tchecker::graph::edge_vedge_t(t.vedge_ptr()) {}
@@ -116,8 +145,11 @@ public:
   }
 };
 
-std::ostream & dot_output(std::ostream & os, tchecker::tck_liveness::zg_ndfs::graph_t const & g, std::string const & name)
+std::ostream & dot_output(std::ostream & os, tchecker::tck_liveness::zg_ndfs::graph_t const & g, std::string const & name,
+                          bool lexical)
 {
+  if (!lexical)
+    return tchecker::graph::dot_output_stream(os, g, name);
   return tchecker::graph::reachability::dot_output<tchecker::tck_liveness::zg_ndfs::graph_t,
                                                    tchecker::tck_liveness::zg_ndfs::node_lexical_less_t,
                                                    tchecker::tck_liveness::zg_ndfs::edge_lexical_less_t>(os, g, name);
@@ -144,7 +176,8 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_liveness::zg_ndfs::ce
 
 std::tuple<tchecker::algorithms::ndfs::stats_t, std::shared_ptr<tchecker::tck_liveness::zg_ndfs::graph_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
-    std::size_t block_size, std::size_t table_size)
+    std::size_t block_size, std::size_t table_size, tchecker::algorithms::budget_t const & budget, bool subsumption,
+    bool por)
 {
   std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
   if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
@@ -157,12 +190,74 @@ run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, st
       new tchecker::tck_liveness::zg_ndfs::graph_t{zg, block_size, table_size}};
 
   boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+  if (por)
+    zg->partial_order_reduction(std::make_shared<tchecker::ta::por_t const>(*system, accepting_labels));
+
+  tchecker::algorithms::ndfs::stats_t stats;
+  if (subsumption) {
+    std::unique_ptr<tchecker::clockbounds::clockbounds_t> clock_bounds{tchecker::clockbounds::compute_clockbounds(*system)};
+    if (clock_bounds.get() == nullptr)
+      throw std::runtime_error("Unable to compute clock bounds of the system");
+    tchecker::tck_liveness::zg_ndfs::subsumption_algorithm_t algorithm{
+        tchecker::tck_liveness::zg_ndfs::node_discrete_hash_t{},
+        tchecker::tck_liveness::zg_ndfs::node_alu_le_t{clock_bounds->local_lu_map()}, budget};
+    stats = algorithm.run(*zg, *graph, accepting_labels);
+  }
+  else {
+    tchecker::tck_liveness::zg_ndfs::algorithm_t algorithm{budget};
+    stats = algorithm.run(*zg, *graph, accepting_labels);
+  }
+  zg->memory_usage(stats.memory_usage());
+  graph->memory_usage(stats.memory_usage());
 
-  tchecker::tck_liveness::zg_ndfs::algorithm_t algorithm;
+  return std::make_tuple(stats, graph);
+}
 
-  tchecker::algorithms::ndfs::stats_t stats = algorithm.run(*zg, *graph, accepting_labels);
+/* run_cndfs */
 
-  return std::make_tuple(stats, graph);
+std::tuple<tchecker::algorithms::ndfs::stats_t, std::shared_ptr<tchecker::tck_liveness::zg_ndfs::graph_t>>
+run_cndfs(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+          std::size_t threads, std::size_t block_size, std::size_t table_size,
+          tchecker::algorithms::budget_t const & budget, bool por)
+{
+  if (threads == 0)
+    throw std::invalid_argument("Number of threads should be positive");
+
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+  if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
+    std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
+
+  // each worker has its own zone graph (and virtual machine) and graph, which share nothing with the others
+  std::vector<std::shared_ptr<tchecker::zg::zg_t>> zgs;
+  std::vector<std::shared_ptr<tchecker::tck_liveness::zg_ndfs::graph_t>> graphs;
+  for (std::size_t p = 0; p < threads; ++p) {
+    zgs.emplace_back(tchecker::zg::factory(system, tchecker::ts::SHARING, tchecker::zg::ELAPSED_SEMANTICS,
+                                           tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size, table_size));
+    graphs.push_back(std::make_shared<tchecker::tck_liveness::zg_ndfs::graph_t>(zgs.back(), block_size, table_size));
+  }
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+  if (por) {
+    // the reduction is read-only, hence shared by the workers
+    std::shared_ptr<tchecker::ta::por_t const> reduction{new tchecker::ta::por_t{*system, accepting_labels}};
+    for (std::shared_ptr<tchecker::zg::zg_t> const & zg : zgs)
+      zg->partial_order_reduction(reduction);
+  }
+
+  tchecker::tck_liveness::zg_ndfs::cndfs_algorithm_t algorithm{budget};
+
+  tchecker::algorithms::ndfs::stats_t stats = algorithm.run(zgs, graphs, accepting_labels);
+  // memory usage is summed over workers
+  std::map<std::string, std::size_t> m;
+  for (std::size_t p = 0; p < threads; ++p) {
+    zgs[p]->memory_usage(m);
+    graphs[p]->memory_usage(m);
+    for (auto && [key, size] : m)
+      stats.memory_usage()[key] += size;
+    m.clear();
+  }
+
+  return std::make_tuple(stats, graphs[algorithm.witness()]);
 }
 
 } // namespace zg_ndfs
@@ -11,8 +11,11 @@
 #include <tuple>
 
 #include "tchecker/algorithms/ndfs/algorithm.hh"
+#include "tchecker/algorithms/ndfs/cndfs.hh"
 #include "tchecker/algorithms/ndfs/graph.hh"
 #include "tchecker/algorithms/ndfs/stats.hh"
+#include "tchecker/algorithms/ndfs/subsumption.hh"
+#include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/graph/edge.hh"
 #include "tchecker/graph/node.hh"
 #include "tchecker/graph/reachability_graph.hh"
@@ -80,6 +83,65 @@ public:
   bool operator()(tchecker::tck_liveness::zg_ndfs::node_t const & n1, tchecker::tck_liveness::zg_ndfs::node_t const & n2) const;
 };
 
+/*!
+\class node_discrete_hash_t
+\brief Hash functor on the discrete part of nodes
+*/
+class node_discrete_hash_t {
+public:
+  /*!
+  \brief Hash function
+  \param n : a node
+  \return hash value for the tuple of locations and the valuation of integer variables in n
+  */
+  std::size_t operator()(tchecker::tck_liveness::zg_ndfs::node_t const & n) const;
+};
+
+/*!
+\class node_alu_le_t
+\brief aLU subsumption functor on nodes, w.r.t. local LU clock bounds
+*/
+class node_alu_le_t {
+public:
+  /*!
+  \brief Constructor
+  \param clock_bounds : local LU clock bounds
+  \pre clock_bounds is not nullptr
+  \throw std::invalid_argument : if clock_bounds is nullptr
+  */
+  node_alu_le_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & clock_bounds);
+
+  /*!
+  \brief Copy constructor
+  \param le : a functor
+  \post this is a copy of le, with its own clock bound maps
+  */
+  node_alu_le_t(tchecker::tck_liveness::zg_ndfs::node_alu_le_t const & le);
+
+  /*!
+  \brief Destructor
+  */
+  ~node_alu_le_t() = default;
+
+  /*!
+  \brief Assignment operator (deleted)
+  */
+  tchecker::tck_liveness::zg_ndfs::node_alu_le_t & operator=(tchecker::tck_liveness::zg_ndfs::node_alu_le_t const &) = delete;
+
+  /*!
+  \brief Subsumption predicate
+  \param n1 : a node
+  \param n2 : a node
+  \return true if n1 and n2 have the same discrete part, and the zone in n1 is included in the aLU abstraction of
+  the zone in n2 w.r.t. the LU clock bounds of the locations in n2, false otherwise
+  */
+  bool operator()(tchecker::tck_liveness::zg_ndfs::node_t const & n1, tchecker::tck_liveness::zg_ndfs::node_t const & n2) const;
+
+private:
+  std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> _clock_bounds; /*!< Local LU clock bounds */
+  mutable tchecker::clockbounds::local_lu_cache_t _cache;                     /*!< LU bounds of tuples of locations */
+};
+
 /*!
  \class edge_t
  \brief Edge of the liveness graph of a zone graph
@@ -158,9 +220,12 @@ private:
  \param os : output stream
  \param g : graph
  \param name : graph name
+ \param lexical : if true, nodes and edges are output in lexical order, otherwise they are streamed
+ in the order of the graph (see tchecker::graph::dot_output_stream)
  \post graph g with name has been output to os
 */
-std::ostream & dot_output(std::ostream & os, tchecker::tck_liveness::zg_ndfs::graph_t const & g, std::string const & name);
+std::ostream & dot_output(std::ostream & os, tchecker::tck_liveness::zg_ndfs::graph_t const & g, std::string const & name,
+                          bool lexical = false);
 
 namespace cex {
 
@@ -208,12 +273,70 @@ public:
  \param labels : comma-separated string of labels
  \param block_size : number of elements allocated in one block
  \param table_size : size of hash tables
+ \param budget : budget of visited states, running time and memory
+ \param subsumption : subsumption flag
+ \param por : partial-order reduction flag
  \pre labels must appear as node attributes in sysdecl
  \return statistics on the run and the liveness graph
+ \throw std::runtime_error : if subsumption is true and clock bounds cannot be computed
+ \note the run stops when budget is exceeded, which is recorded in the returned statistics
+ \note if subsumption is true, the nested DFS prunes the nodes that are aLU-subsumed by red nodes, and reports
+ cycles as soon as a node aLU-subsumes a cyan node (see tchecker::algorithms::ndfs::subsumption_algorithm_t)
+ \note if por is true, the zone graph is reduced w.r.t. labels (see tchecker::ta::por_t and
+ tchecker::zg::zg_t::partial_order_reduction)
  */
 std::tuple<tchecker::algorithms::ndfs::stats_t, std::shared_ptr<tchecker::tck_liveness::zg_ndfs::graph_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
-    std::size_t block_size = 10000, std::size_t table_size = 65536);
+    std::size_t block_size = 10000, std::size_t table_size = 65536,
+    tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{}, bool subsumption = false,
+    bool por = false);
+
+/*!
+ \class subsumption_algorithm_t
+ \brief Nested DFS algorithm with aLU subsumption over the zone graph
+*/
+class subsumption_algorithm_t
+    : public tchecker::algorithms::ndfs::subsumption_algorithm_t<
+          tchecker::zg::zg_t, tchecker::tck_liveness::zg_ndfs::graph_t, tchecker::tck_liveness::zg_ndfs::node_discrete_hash_t,
+          tchecker::tck_liveness::zg_ndfs::node_alu_le_t> {
+public:
+  using tchecker::algorithms::ndfs::subsumption_algorithm_t<
+      tchecker::zg::zg_t, tchecker::tck_liveness::zg_ndfs::graph_t, tchecker::tck_liveness::zg_ndfs::node_discrete_hash_t,
+      tchecker::tck_liveness::zg_ndfs::node_alu_le_t>::subsumption_algorithm_t;
+};
+
+/*!
+ \class cndfs_algorithm_t
+ \brief Multi-core nested DFS algorithm over the zone graph
+*/
+class cndfs_algorithm_t
+    : public tchecker::algorithms::ndfs::cndfs_algorithm_t<tchecker::zg::zg_t, tchecker::tck_liveness::zg_ndfs::graph_t> {
+public:
+  using tchecker::algorithms::ndfs::cndfs_algorithm_t<tchecker::zg::zg_t,
+                                                      tchecker::tck_liveness::zg_ndfs::graph_t>::cndfs_algorithm_t;
+};
+
+/*!
+ \brief Run multi-core nested DFS algorithm on the zone graph of a system
+ \param sysdecl : system declaration
+ \param labels : comma-separated string of labels
+ \param threads : number of workers
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param budget : budget of visited states, running time and memory of each worker
+ \param por : partial-order reduction flag
+ \pre labels must appear as node attributes in sysdecl
+ \return statistics on the run and the liveness graph of the worker that has found a cycle (of the first worker if
+ no cycle has been found). Each worker explores its own zone graph (see
+ tchecker::algorithms::ndfs::cndfs_algorithm_t)
+ \throw std::invalid_argument : if threads is 0
+ \note the run stops when budget is exceeded, which is recorded in the returned statistics
+ \note if por is true, the zone graph of every worker is reduced w.r.t. labels (see tchecker::ta::por_t)
+ */
+std::tuple<tchecker::algorithms::ndfs::stats_t, std::shared_ptr<tchecker::tck_liveness::zg_ndfs::graph_t>>
+run_cndfs(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
+          std::size_t threads = 1, std::size_t block_size = 10000, std::size_t table_size = 65536,
+          tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{}, bool por = false);
 
 } // namespace zg_ndfs
 
@@ -0,0 +1,129 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <sstream>
+
+#include "compos-stats.hh"
+
+namespace tchecker {
+
+namespace tck_reach {
+
+namespace compos {
+
+char const * phase_name(enum tchecker::tck_reach::compos::phase_t phase)
+{
+  switch (phase) {
+  case tchecker::tck_reach::compos::PHASE_FORWARD:
+    return "FORWARD";
+  case tchecker::tck_reach::compos::PHASE_BACKWARD_PROPAGATION:
+    return "BACKWARD_PROPAGATION";
+  case tchecker::tck_reach::compos::PHASE_COLLECTION:
+    return "COLLECTION";
+  case tchecker::tck_reach::compos::PHASE_BACKWARD_REACHABILITY:
+    return "BACKWARD_REACHABILITY";
+  case tchecker::tck_reach::compos::PHASE_DECLARATION:
+    return "DECLARATION";
+  case tchecker::tck_reach::compos::PHASE_CHECK:
+    return "CHECK";
+  default:
+    return "UNKNOWN";
+  }
+}
+
+stats_t::stats_t() : _reachable(false), _iterations(0), _backward_des_states(0), _levels(1) {}
+
+tchecker::algorithms::phase_stats_t & stats_t::phase(enum tchecker::tck_reach::compos::phase_t phase)
+{
+  return _phases[phase];
+}
+
+tchecker::algorithms::phase_stats_t const & stats_t::phase(enum tchecker::tck_reach::compos::phase_t phase) const
+{
+  return _phases[phase];
+}
+
+bool & stats_t::reachable() { return _reachable; }
+
+bool stats_t::reachable() const { return _reachable; }
+
+std::uint64_t & stats_t::iterations() { return _iterations; }
+
+std::uint64_t stats_t::iterations() const { return _iterations; }
+
+std::uint64_t & stats_t::levels() { return _levels; }
+
+std::uint64_t stats_t::levels() const { return _levels; }
+
+std::uint64_t & stats_t::backward_des_states() { return _backward_des_states; }
+
+std::uint64_t stats_t::backward_des_states() const { return _backward_des_states; }
+
+std::uint64_t stats_t::visited_states() const
+{
+  std::uint64_t visited_states = 0;
+  for (tchecker::algorithms::phase_stats_t const & phase : _phases)
+    visited_states += phase.visited_states();
+  return visited_states;
+}
+
+std::uint64_t stats_t::visited_transitions() const
+{
+  std::uint64_t visited_transitions = 0;
+  for (tchecker::algorithms::phase_stats_t const & phase : _phases)
+    visited_transitions += phase.visited_transitions();
+  return visited_transitions;
+}
+
+void stats_t::attributes(std::map<std::string, std::string> & m) const
+{
+  tchecker::algorithms::stats_t::attributes(m);
+
+  std::stringstream sstream;
+
+  if (_reachable)
+    m["REACHABLE"] = "true";
+  else
+    m["REACHABLE"] = (budget_exceeded() ? "unknown" : "false");
+
+  sstream << running_time();
+  m["TOTAL_RUNNING_TIME"] = sstream.str();
+
+  sstream.str("");
+  sstream << visited_states();
+  m["TOTAL_VISITED_STATES"] = sstream.str();
+
+  sstream.str("");
+  sstream << visited_transitions();
+  m["TOTAL_VISITED_TRANSITIONS"] = sstream.str();
+
+  if (tchecker::allocation_stats::enabled()) {
+    sstream.str("");
+    sstream << tchecker::algorithms::allocations_per_state(allocations(), visited_states());
+    m["ALLOCATIONS_PER_VISITED_STATE"] = sstream.str();
+  }
+
+  sstream.str("");
+  sstream << _iterations;
+  m["ITERATIONS"] = sstream.str();
+
+  sstream.str("");
+  sstream << _levels;
+  m["LEVELS"] = sstream.str();
+
+  sstream.str("");
+  sstream << _backward_des_states;
+  m["BACKWARD_DES_STATES"] = sstream.str();
+
+  for (std::size_t i = 0; i < tchecker::tck_reach::compos::PHASE_COUNT; ++i)
+    if (_phases[i].runs() != 0)
+      _phases[i].attributes(tchecker::tck_reach::compos::phase_name(static_cast<enum tchecker::tck_reach::compos::phase_t>(i)),
+                            m);
+}
+
+} // end of namespace compos
+
+} // end of namespace tck_reach
+
+} // end of namespace tchecker
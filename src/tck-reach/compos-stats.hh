@@ -0,0 +1,159 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_TCK_REACH_COMPOS_STATS_HH
+#define TCHECKER_TCK_REACH_COMPOS_STATS_HH
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "tchecker/algorithms/stats.hh"
+
+/*!
+ \file compos-stats.hh
+ \brief Statistics of the compositional algorithm
+ */
+
+namespace tchecker {
+
+namespace tck_reach {
+
+namespace compos {
+
+/*!
+ \brief Phases of the compositional algorithm
+ */
+enum phase_t {
+  PHASE_FORWARD = 0,           /*!< Forward exploration of the property graph */
+  PHASE_BACKWARD_PROPAGATION,  /*!< Backward propagation from the final nodes */
+  PHASE_COLLECTION,            /*!< Reclamation of the pruned nodes */
+  PHASE_BACKWARD_REACHABILITY, /*!< Backward reachability from the propagated nodes */
+  PHASE_DECLARATION,           /*!< Construction of the declaration of the property graph */
+  PHASE_CHECK,                 /*!< Check of the product of the system with the property graph */
+  PHASE_COUNT,                 /*!< Number of phases (not a phase) */
+};
+
+/*!
+ \brief Name of a phase
+ \param phase : a phase
+ \return name of phase, as used in the keys of tchecker::tck_reach::compos::stats_t::attributes
+ \pre phase != tchecker::tck_reach::compos::PHASE_COUNT
+ */
+char const * phase_name(enum tchecker::tck_reach::compos::phase_t phase);
+
+/*!
+ \class stats_t
+ \brief Statistics of the compositional algorithm: overall verdict and counters, and statistics of each phase
+ */
+class stats_t : public tchecker::algorithms::stats_t {
+public:
+  /*!
+   \brief Constructor
+   */
+  stats_t();
+
+  /*!
+   \brief Accessor
+   \param phase : a phase
+   \return Reference to the statistics of phase
+   \pre phase != tchecker::tck_reach::compos::PHASE_COUNT
+   */
+  tchecker::algorithms::phase_stats_t & phase(enum tchecker::tck_reach::compos::phase_t phase);
+
+  /*!
+   \brief Accessor
+   \param phase : a phase
+   \return statistics of phase
+   \pre phase != tchecker::tck_reach::compos::PHASE_COUNT
+   */
+  tchecker::algorithms::phase_stats_t const & phase(enum tchecker::tck_reach::compos::phase_t phase) const;
+
+  /*!
+   \brief Accessor
+   \return Reference to the reachable state flag
+   */
+  bool & reachable();
+
+  /*!
+   \brief Accessor
+   \return true if a satisfying state is reachable, false otherwise
+   */
+  bool reachable() const;
+
+  /*!
+   \brief Accessor
+   \return Reference to the number of iterations (forward explorations)
+   */
+  std::uint64_t & iterations();
+
+  /*!
+   \brief Accessor
+   \return number of iterations (forward explorations)
+   */
+  std::uint64_t iterations() const;
+
+  /*!
+   \brief Accessor
+   \return Reference to the number of nodes made final by backward propagation
+   */
+  std::uint64_t & backward_des_states();
+
+  /*!
+   \brief Accessor
+   \return number of nodes made final by backward propagation
+   */
+  std::uint64_t backward_des_states() const;
+
+  /*!
+   \brief Accessor
+   \return Reference to the number of levels of decomposition
+   */
+  std::uint64_t & levels();
+
+  /*!
+   \brief Accessor
+   \return number of levels of decomposition (1 unless the merged systems are decomposed again)
+   */
+  std::uint64_t levels() const;
+
+  /*!
+   \brief Accessor
+   \return number of visited states, summed over the phases
+   */
+  std::uint64_t visited_states() const;
+
+  /*!
+   \brief Accessor
+   \return number of visited transitions, summed over the phases
+   */
+  std::uint64_t visited_transitions() const;
+
+  /*!
+   \brief Extract statistics as attributes (key, value)
+   \param m : attributes map
+   \post all attributes of tchecker::algorithms::stats_t have been added to m, as well as REACHABLE ("true",
+   "false", or "unknown" if no satisfying state has been found and the budget has been exceeded),
+   TOTAL_RUNNING_TIME, TOTAL_VISITED_STATES, TOTAL_VISITED_TRANSITIONS, ITERATIONS, LEVELS, BACKWARD_DES_STATES and the
+   statistics of each phase that has run (see tchecker::algorithms::phase_stats_t::attributes) with the name of
+   the phase as prefix. ALLOCATIONS_PER_VISITED_STATE (over all phases) has been added if allocations are counted
+   */
+  void attributes(std::map<std::string, std::string> & m) const;
+
+private:
+  std::array<tchecker::algorithms::phase_stats_t, tchecker::tck_reach::compos::PHASE_COUNT> _phases; /*!< Phases */
+  bool _reachable;                    /*!< Reachability of satisfying states */
+  std::uint64_t _iterations;          /*!< Number of iterations */
+  std::uint64_t _backward_des_states; /*!< Number of nodes made final by backward propagation */
+  std::uint64_t _levels;              /*!< Number of levels of decomposition */
+};
+
+} // end of namespace compos
+
+} // end of namespace tck_reach
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TCK_REACH_COMPOS_STATS_HH
@@ -0,0 +1,284 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_TCK_REACH_CONCUR19_HH
+#define TCHECKER_TCK_REACH_CONCUR19_HH
+
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <tuple>
+
+#include "tchecker/algorithms/covreach/algorithm.hh"
+#include "tchecker/algorithms/covreach/stats.hh"
+#include "tchecker/clockbounds/clockbounds.hh"
+#include "tchecker/graph/edge.hh"
+#include "tchecker/graph/node.hh"
+#include "tchecker/graph/subsumption_graph.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/refzg/path.hh"
+#include "tchecker/refzg/refzg.hh"
+#include "tchecker/refzg/state.hh"
+#include "tchecker/refzg/transition.hh"
+#include "tchecker/syncprod/vedge.hh"
+#include "tchecker/utils/shared_objects.hh"
+#include "tchecker/waiting/waiting.hh"
+
+/*!
+ \file concur19.hh
+ \brief Local-time reachability algorithm with sync-subsumption (Govind, Herbreteau, Srivathsan and Walukiewicz,
+ CONCUR 2019)
+ */
+
+namespace tchecker {
+
+namespace tck_reach {
+
+namespace concur19 {
+
+/*!
+ \class node_t
+ \brief Node of the subsumption graph of a local-time zone graph
+ */
+class node_t : public tchecker::waiting::element_t,
+               public tchecker::graph::node_flags_t,
+               public tchecker::graph::node_refzg_state_t {
+public:
+  /*!
+  \brief Constructor
+  \param s : a state of a zone graph with reference clocks
+  \param initial : initial node flag
+  \param final : final node flag
+  \post this node keeps a shared pointer to s, and has initial/final node flags as specified
+  */
+  node_t(tchecker::refzg::state_sptr_t const & s, bool initial = false, bool final = false);
+
+  /*!
+  \brief Constructor
+  \param s : a state of a zone graph with reference clocks
+  \param initial : initial node flag
+  \param final : final node flag
+  \post this node keeps a shared pointer to s, and has initial/final node flags as specified
+  */
+  node_t(tchecker::refzg::const_state_sptr_t const & s, bool initial = false, bool final = false);
+};
+
+/*!
+\class node_hash_t
+\brief Hash functor for nodes
+*/
+class node_hash_t {
+public:
+  /*!
+  \brief Hash function
+  \param n : a node
+  \return hash value for the tuple of locations and the valuation of integer variables in n
+  \note nodes that may cover each other have the same hash value
+  */
+  std::size_t operator()(tchecker::tck_reach::concur19::node_t const & n) const;
+};
+
+/*!
+\class node_le_t
+\brief Sync-subsumption on nodes, w.r.t. local LU clock bounds
+*/
+class node_le_t {
+public:
+  /*!
+  \brief Constructor
+  \param clock_bounds : local LU clock bounds
+  \pre clock_bounds is not nullptr
+  \throw std::invalid_argument : if clock_bounds is nullptr
+  */
+  node_le_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & clock_bounds);
+
+  /*!
+  \brief Copy constructor
+  \param le : a functor
+  \post this is a copy of le, with its own clock bound maps
+  */
+  node_le_t(tchecker::tck_reach::concur19::node_le_t const & le);
+
+  /*!
+  \brief Destructor
+  */
+  ~node_le_t() = default;
+
+  /*!
+  \brief Assignment operator (deleted)
+  */
+  tchecker::tck_reach::concur19::node_le_t & operator=(tchecker::tck_reach::concur19::node_le_t const &) = delete;
+
+  /*!
+  \brief Subsumption predicate
+  \param n1 : a node
+  \param n2 : a node
+  \return true if n1 and n2 have the same discrete part, and the zone in n1 is sync-subsumed by the zone in n2
+  w.r.t. the LU clock bounds of the locations in n2 (see tchecker::refzg::zone_t::is_sync_alu_le), false otherwise
+  */
+  bool operator()(tchecker::tck_reach::concur19::node_t const & n1, tchecker::tck_reach::concur19::node_t const & n2) const;
+
+private:
+  std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> _clock_bounds; /*!< Local LU clock bounds */
+  mutable tchecker::clockbounds::local_lu_cache_t _cache;                     /*!< LU bounds of tuples of locations */
+};
+
+/*!
+ \class edge_t
+ \brief Edge of the subsumption graph of a local-time zone graph
+*/
+class edge_t : public tchecker::graph::edge_vedge_t {
+public:
+  /*!
+   \brief Constructor
+   \param t : a transition of a zone graph with reference clocks
+   \post this node keeps a shared pointer on the vedge in t
+  */
+  edge_t(tchecker::refzg::transition_t const & t);
+};
+
+/*!
+ \class graph_t
+ \brief Subsumption graph over the local-time zone graph
+*/
+class graph_t
+    : public tchecker::graph::subsumption::graph_t<tchecker::tck_reach::concur19::node_t, tchecker::tck_reach::concur19::edge_t,
+                                                   tchecker::tck_reach::concur19::node_hash_t,
+                                                   tchecker::tck_reach::concur19::node_le_t> {
+public:
+  /*!
+   \brief Constructor
+   \param refzg : zone graph with reference clocks
+   \param clock_bounds : local LU clock bounds of the system of refzg
+   \param block_size : number of objects allocated in a block
+   \param table_size : size of hash table
+   \pre clock_bounds is not nullptr
+   \throw std::invalid_argument : if clock_bounds is nullptr
+   \note this keeps a pointer on refzg and on clock_bounds
+  */
+  graph_t(std::shared_ptr<tchecker::refzg::refzg_t> const & refzg,
+          std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & clock_bounds, std::size_t block_size,
+          std::size_t table_size);
+
+  /*!
+   \brief Destructor
+  */
+  virtual ~graph_t();
+
+  /*!
+   \brief Accessor
+   \return pointer to internal zone graph with reference clocks
+  */
+  inline std::shared_ptr<tchecker::refzg::refzg_t> refzg_ptr() { return _refzg; }
+
+  /*!
+   \brief Accessor
+   \return internal zone graph with reference clocks
+  */
+  inline tchecker::refzg::refzg_t const & refzg() const { return *_refzg; }
+
+  using tchecker::graph::subsumption::graph_t<tchecker::tck_reach::concur19::node_t, tchecker::tck_reach::concur19::edge_t,
+                                              tchecker::tck_reach::concur19::node_hash_t,
+                                              tchecker::tck_reach::concur19::node_le_t>::attributes;
+
+protected:
+  /*!
+   \brief Accessor to node attributes
+   \param n : a node
+   \param m : a map (key, value) of attributes
+   \post attributes of node n have been added to map m
+  */
+  virtual void attributes(tchecker::tck_reach::concur19::node_t const & n, std::map<std::string, std::string> & m) const;
+
+  /*!
+   \brief Accessor to edge attributes
+   \param e : an edge
+   \param m : a map (key, value) of attributes
+   \post attributes of edge e have been added to map m
+  */
+  virtual void attributes(tchecker::tck_reach::concur19::edge_t const & e, std::map<std::string, std::string> & m) const;
+
+private:
+  std::shared_ptr<tchecker::refzg::refzg_t> _refzg; /*!< Zone graph with reference clocks */
+};
+
+/*!
+ \brief Graph output
+ \param os : output stream
+ \param g : graph
+ \param name : graph name
+ \param lexical : if true, nodes and edges are output in lexical order, otherwise they are streamed
+ in the order of the graph (see tchecker::graph::dot_output_stream)
+ \post graph g with name has been output to os
+*/
+std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::concur19::graph_t const & g, std::string const & name,
+                          bool lexical = false);
+
+namespace cex {
+
+/*!
+ \brief Type of symbolic counter-example
+*/
+using symbolic_cex_t = tchecker::refzg::path::finite_path_t;
+
+/*!
+ \brief Compute a symbolic counter-example from a subsumption graph of a local-time zone graph
+ \param g : subsumption graph on a local-time zone graph
+ \return a finite path from an initial node to a final node in g if any, nullptr otherwise
+ \note the zones along the path are recomputed from its sequence of tuples of edges, with standard semantics
+ \note the returned pointer shall be deleted
+*/
+tchecker::tck_reach::concur19::cex::symbolic_cex_t *
+symbolic_counter_example(tchecker::tck_reach::concur19::graph_t const & g);
+
+/*!
+ \brief Symbolic counter-example output
+ \param os : output stream
+ \param cex : counter example
+ \param name : counter example name
+ \post cex has been output to os
+ \return os after output
+ */
+std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::concur19::cex::symbolic_cex_t const & cex,
+                          std::string const & name);
+
+} // namespace cex
+
+/*!
+ \class algorithm_t
+ \brief Covering reachability algorithm over the local-time zone graph
+*/
+class algorithm_t
+    : public tchecker::algorithms::covreach::algorithm_t<tchecker::refzg::refzg_t, tchecker::tck_reach::concur19::graph_t> {
+public:
+  using tchecker::algorithms::covreach::algorithm_t<tchecker::refzg::refzg_t, tchecker::tck_reach::concur19::graph_t>::algorithm_t;
+};
+
+/*!
+ \brief Run local-time reachability algorithm on a system
+ \param sysdecl : system declaration
+ \param labels : comma-separated string of labels
+ \param search_order : search order, either "dfs", "bfs", "dist" or "random"
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \pre labels must appear as node attributes in sysdecl
+ \return statistics on the run and the subsumption graph of the local-time zone graph of sysdecl: each process has
+ its own reference clock, and nodes are covered w.r.t. sync-subsumption with local LU clock bounds. A node is final
+ if it has the labels and its zone is synchronizable
+ \throw std::invalid_argument : if search_order is not supported
+ \throw std::runtime_error : if the clock bounds of the system cannot be computed
+ \note the spread of the reference clocks is unbounded
+ */
+std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::concur19::graph_t>>
+run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
+    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536);
+
+} // end of namespace concur19
+
+} // end of namespace tck_reach
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TCK_REACH_CONCUR19_HH
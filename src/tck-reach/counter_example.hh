@@ -6,6 +6,7 @@
 #define TCHECKER_TCK_REACH_COUNTER_EXAMPLE_HH
 
 #include <memory>
+#include <tuple>
 #include <vector>
 
 #include "tchecker/algorithms/path/finite_path_extraction.hh"
@@ -49,22 +50,49 @@ template <class GRAPH> bool final_node(typename GRAPH::node_sptr_t const & n) {
 */
 template <class GRAPH> bool true_edge(typename GRAPH::edge_sptr_t const & e) { return true; }
 
+/*!
+ \brief Compute a sequence of edges from an initial node to a final node
+ \tparam GRAPH : type of graph, see tchecker::algorithms::finite_path_extraction_algorithm_t and
+ tchecker::algorithms::parent_path_extraction_algorithm_t for requirements
+ \param g : a graph over the zone graph (reachability graph, subsumption graph, etc)
+ \param parents : true if the path should first be extracted along the parent edges of g
+ \return a triple (found, root, seq) as returned by tchecker::algorithms::finite_path_extraction_algorithm_t::run
+ \note if parents is true, the path is extracted along parent edges in time linear in its length, and g is searched only
+ when some node on the path has several incoming edges (see tchecker::algorithms::parent_path_extraction_algorithm_t)
+ */
+template <class GRAPH>
+std::tuple<bool, typename GRAPH::node_sptr_t, std::vector<typename GRAPH::edge_sptr_t>>
+counter_example_edges(GRAPH const & g, bool parents)
+{
+  if (parents) {
+    tchecker::algorithms::parent_path_extraction_algorithm_t<GRAPH> algorithm;
+    auto && [found, root, seq] = algorithm.run(g, &tchecker::tck_reach::initial_node<GRAPH>,
+                                               &tchecker::tck_reach::final_node<GRAPH>, &tchecker::tck_reach::true_edge<GRAPH>);
+    if (found)
+      return std::make_tuple(true, root, seq);
+  }
+
+  tchecker::algorithms::finite_path_extraction_algorithm_t<GRAPH> algorithm;
+  return algorithm.run(g, &tchecker::tck_reach::initial_node<GRAPH>, &tchecker::tck_reach::final_node<GRAPH>,
+                       &tchecker::tck_reach::true_edge<GRAPH>);
+}
+
 /*!
  \brief Compute a symbolic counter example of a zone graph
  \tparam GRAPH : type of graph, see tchecker::algorithms::path::finite::algorithm_t for requirements
  \param g : a graph over the zone graph (reachability graph, subsumption graph, etc)
+ \param parents : true if the path should first be extracted along the parent edges of g (see
+ tchecker::tck_reach::counter_example_edges)
  \return a finite path from an initial node of g to a final node of g
  */
-template <class GRAPH> tchecker::zg::path::symbolic::finite_path_t * symbolic_counter_example_zg(GRAPH const & g)
+template <class GRAPH>
+tchecker::zg::path::symbolic::finite_path_t * symbolic_counter_example_zg(GRAPH const & g, bool parents = false)
 {
   std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(
       g.zg().system_ptr(), g.zg().sharing_type(), tchecker::zg::STANDARD_SEMANTICS, tchecker::zg::NO_EXTRAPOLATION, 128, 128)};
 
   // compute sequence of edges from initial to final node in g
-  tchecker::algorithms::finite_path_extraction_algorithm_t<GRAPH> algorithm;
-
-  auto && [found, root, seq] = algorithm.run(g, &tchecker::tck_reach::initial_node<GRAPH>,
-                                             &tchecker::tck_reach::final_node<GRAPH>, &tchecker::tck_reach::true_edge<GRAPH>);
+  auto && [found, root, seq] = tchecker::tck_reach::counter_example_edges(g, parents);
 
   if (!found)
     return new tchecker::zg::path::symbolic::finite_path_t{zg};
@@ -84,12 +112,15 @@ template <class GRAPH> tchecker::zg::path::symbolic::finite_path_t * symbolic_co
  \brief Compute a concrete counter example of a zone graph
  \tparam GRAPH : type of graph, see tchecker::algorithms::path::finite::algorithm_t for requirements
  \param g : a graph over the zone graph (reachability graph, subsumption graph, etc)
+ \param parents : true if the path should first be extracted along the parent edges of g (see
+ tchecker::tck_reach::counter_example_edges)
  \return a finite path from an initial node of g to a final node of g, with concrete clock valuations
  */
-template <class GRAPH> tchecker::zg::path::concrete::finite_path_t * concrete_counter_example_zg(GRAPH const & g)
+template <class GRAPH>
+tchecker::zg::path::concrete::finite_path_t * concrete_counter_example_zg(GRAPH const & g, bool parents = false)
 {
   std::unique_ptr<tchecker::zg::path::symbolic::finite_path_t> symbolic_cex{
-      tchecker::tck_reach::symbolic_counter_example_zg<GRAPH>(g)};
+      tchecker::tck_reach::symbolic_counter_example_zg<GRAPH>(g, parents)};
 
   // Compute concrete counter-exemple from symbolic counter-example
   tchecker::zg::path::concrete::finite_path_t * cex = tchecker::zg::path::concrete::compute_finite_path(*symbolic_cex);
@@ -102,19 +133,18 @@ template <class GRAPH> tchecker::zg::path::concrete::finite_path_t * concrete_co
  \tparam GRAPH : type of graph, see tchecker::algorithms::path::finite::algorithm_t for requirements
  \tparam CEX : type of counter example, should inherit from tchecker::refzg::path::finite_path_t
  \param g : a graph over the zone graph (reachability graph, subsumption graph, etc)
+ \param parents : true if the path should first be extracted along the parent edges of g (see
+ tchecker::tck_reach::counter_example_edges)
  \return a finite path from an initial node of g to a final node of g
  */
-template <class GRAPH, class CEX> CEX * symbolic_counter_example_refzg(GRAPH const & g)
+template <class GRAPH, class CEX> CEX * symbolic_counter_example_refzg(GRAPH const & g, bool parents = false)
 {
   std::shared_ptr<tchecker::refzg::refzg_t> refzg{
       tchecker::refzg::factory(g.refzg().system_ptr(), g.refzg().sharing_type(), tchecker::refzg::PROCESS_REFERENCE_CLOCKS,
                                tchecker::refzg::STANDARD_SEMANTICS, g.refzg().spread(), 128, 128)};
 
   // compute sequence of edges from initial to final node in g
-  tchecker::algorithms::finite_path_extraction_algorithm_t<GRAPH> algorithm;
-
-  auto && [found, root, seq] = algorithm.run(g, &tchecker::tck_reach::initial_node<GRAPH>,
-                                             &tchecker::tck_reach::final_node<GRAPH>, &tchecker::tck_reach::true_edge<GRAPH>);
+  auto && [found, root, seq] = tchecker::tck_reach::counter_example_edges(g, parents);
 
   if (!found)
     return new CEX{refzg};
@@ -5,17 +5,35 @@
 #ifndef PARSE_GRAPH_HH
 #define PARSE_GRAPH_HH
 
-#include <fstream>
+#include <algorithm>
+#include <limits>
 #include <map>
+#include <sstream>
 #include <set>
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/expression/static_analysis.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/parsing/declaration_filter.hh"
+#include "tchecker/statement/static_analysis.hh"
+#include "tchecker/ta/system_ha.hh"
+#include "tchecker/utils/parallel.hh"
+#include "tchecker/utils/probes.hh"
 #include "zg-history-aware.hh"
 
+/*!
+ \file parse-graph.hh
+ \brief Construction of the merged system declaration from the backward-pruned history-aware graph
+ */
+
 namespace tchecker {
 
 namespace tck_reach {
@@ -26,6 +44,7 @@ using node_sptr_t = typename tchecker::tck_reach::zg_history_aware::graph_t::nod
 using edge_sptr_t = typename tchecker::tck_reach::zg_history_aware::graph_t::edge_sptr_t;
 using node_lexical_less_t = typename tchecker::tck_reach::zg_history_aware::node_lexical_less_t;
 using extended_edge_t = typename std::tuple<tchecker::node_id_t, tchecker::node_id_t, edge_sptr_t>; // <src, tgt, edge_sptr>
+using nodes_t = std::vector<node_sptr_t>; // reachable nodes, identifiers are stored in nodes (see node_t::merged_id)
 
 // Extend EDGE_LE on triples (src, tgt, edge)
 class extended_edge_le_t : private tchecker::tck_reach::zg_history_aware::edge_lexical_less_t {
@@ -43,430 +62,893 @@ public:
   }
 };
 
-// Function declarations
-tchecker::parsing::system_declaration_t * load_system_declaration(std::string const & filename);
-void writeInitialData(std::ofstream & file);
-void writeSystemClocks(std::ofstream & file, std::vector<std::string> & system_clocks,
-                       const std::shared_ptr<tchecker::parsing::system_declaration_t> & property_decl);
-void writeIntegerVariables(std::ofstream & file, const std::string & input_file);
-tchecker::node_id_t assignNodeIDs(std::map<node_sptr_t, tchecker::node_id_t, node_lexical_less_t> & nodes_map,
-                                  const graph_t & graph);
-void writeNodeLocations(std::ofstream & file, const graph_t & graph,
-                        const std::map<node_sptr_t, tchecker::node_id_t, node_lexical_less_t> & nodes_map);
-void writeEdges(std::ofstream & file, const graph_t & graph,
-                const std::map<node_sptr_t, tchecker::node_id_t, node_lexical_less_t> & nodes_map,
-                std::set<std::string> & declared_events);
-void writeEnvironmentData(std::ofstream & file, const std::string & env_file, std::set<std::string> & declared_events,
-                          std::map<std::string, std::set<std::string>> & events_per_ps);
-
-void writeNodeAttributes(std::ofstream & file, const std::map<std::string, std::string> & attr, const node_sptr_t & node,
-                         const tchecker::system::system_t & graph_system);
-void writeEdge(std::ofstream & file, tchecker::node_id_t src, tchecker::node_id_t tgt, const edge_sptr_t & edge,
-               const std::map<std::string, std::string> & attr, std::set<std::string> & declared_events,
-               tchecker::system::system_t graph_system);
-void writeSynchronization(std::ofstream & file, const std::set<std::string> & declared_events,
-                          const std::map<std::string, std::set<std::string>> & events_per_ps);
+// Hash and equality of triples (src, tgt, edge) on identifiers and vedges
+class extended_edge_hash_t {
+public:
+  std::size_t operator()(extended_edge_t const & e) const
+  {
+    auto && [src, tgt, edge_sptr] = e;
+    std::size_t h = tchecker::hash_value(edge_sptr->vedge());
+    boost::hash_combine(h, src);
+    boost::hash_combine(h, tgt);
+    return h;
+  }
+};
 
-tchecker::parsing::system_declaration_t *
-graph_parser(const std::string & input_file, const std::string & env_file,
-             const std::shared_ptr<tchecker::parsing::system_declaration_t> & property_decl, const graph_t & graph,
-             std::ostream * os, uint32_t & nodes_count)
-{
-  std::ofstream m_file("m_file.txt");
+class extended_edge_equal_to_t {
+public:
+  bool operator()(extended_edge_t const & e1, extended_edge_t const & e2) const
+  {
+    auto && [src1, tgt1, edge_sptr1] = e1;
+    auto && [src2, tgt2, edge_sptr2] = e2;
+    return (src1 == src2) && (tgt1 == tgt2) && (edge_sptr1->vedge() == edge_sptr2->vedge());
+  }
+};
 
-  // Step 1: Write header system data
-  writeInitialData(m_file);
+/*!
+ \brief Name of the merged system and of its single process
+ */
+static std::string const MERGED_SYSTEM_NAME = "mergedSystem";
+static std::string const MERGED_PROCESS_NAME = "sys";
 
-  // Step 2: Write system clocks
-  std::vector<std::string> system_clocks;
-  writeSystemClocks(m_file, system_clocks, property_decl);
+/*!
+ \brief Context attached to in-memory declarations (used in error messages)
+ */
+static std::string const MERGED_CONTEXT = "merged system";
+
+/*!
+ \class merge_inputs_t
+ \brief Declarations of the system, of the property and of the environment that are imported in every merged
+ system
+ \note the system, the property and the environment do not change across compositional iterations: their
+ declarations are collected once, so building a merged system neither scans nor visits them
+ */
+class merge_inputs_t {
+public:
+  /*!
+   \brief Constructor
+   \param sysdecl : declaration of the system (integer variables are taken from it)
+   \param envdecl : declaration of the environment
+   \param property_decl : declaration of the property (clocks are taken from it)
+   \note this keeps pointers to sysdecl, envdecl and property_decl
+   */
+  merge_inputs_t(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl,
+                 std::shared_ptr<tchecker::parsing::system_declaration_t> const & envdecl,
+                 std::shared_ptr<tchecker::parsing::system_declaration_t> const & property_decl)
+      : _sysdecl(sysdecl), _envdecl(envdecl), _property_decl(property_decl)
+  {
+    for (auto const & [name, _] : property_decl->get_clocks())
+      _property_clocks.push_back(name);
+    for (auto const * decl : sysdecl->declarations()) {
+      auto const * d = dynamic_cast<tchecker::parsing::int_declaration_t const *>(decl);
+      if (d != nullptr)
+        _system_ints.push_back(d);
+    }
+    for (auto const * decl : envdecl->declarations()) {
+      auto const * d = dynamic_cast<tchecker::parsing::edge_declaration_t const *>(decl);
+      if (d != nullptr)
+        _environment_events[d->process().name()].insert(d->event().name());
+    }
+  }
 
-  // Step 3: Declare bounded integer variables
-  writeIntegerVariables(m_file, input_file);
+  /*!
+   \brief Accessor
+   \return names of the clocks of the property
+   */
+  inline std::vector<std::string> const & property_clocks() const { return _property_clocks; }
+
+  /*!
+   \brief Accessor
+   \return declarations of the bounded integer variables of the system
+   */
+  inline std::vector<tchecker::parsing::int_declaration_t const *> const & system_ints() const { return _system_ints; }
+
+  /*!
+   \brief Accessor
+   \return declaration of the environment
+   */
+  inline tchecker::parsing::system_declaration_t const & environment() const { return *_envdecl; }
+
+  /*!
+   \brief Accessor
+   \return map from the processes of the environment to the events of their edges
+   */
+  inline std::map<std::string, std::set<std::string>> const & environment_events() const { return _environment_events; }
+
+private:
+  std::shared_ptr<tchecker::parsing::system_declaration_t> _sysdecl;       /*!< System declaration */
+  std::shared_ptr<tchecker::parsing::system_declaration_t> _envdecl;       /*!< Environment declaration */
+  std::shared_ptr<tchecker::parsing::system_declaration_t> _property_decl; /*!< Property declaration */
+  std::vector<std::string> _property_clocks;                               /*!< Clocks of the property */
+  std::vector<tchecker::parsing::int_declaration_t const *> _system_ints;  /*!< Integer variables of the system */
+  std::map<std::string, std::set<std::string>> _environment_events;       /*!< Events of environment processes */
+};
 
-  // Step 4: Assign each node a unique ID
-  std::map<node_sptr_t, tchecker::node_id_t, node_lexical_less_t> nodes_map;
-  nodes_count = assignNodeIDs(nodes_map, graph);
+/*!
+ \class node_invariants_t
+ \brief Invariants of the locations of the merged system, computed once per tuple of locations
+ \note the invariant of a node is the conjunction of the invariants of its locations. It is computed at the first
+ node with a given tuple of locations (vlocs are shared by the zone graph, hence identified by their address), and
+ distinct invariants are identified by their text. Nodes with the same tuple of locations thus get the same
+ identifier, and the merged system holds as many distinct invariants as distinct tuples of locations at most
+ */
+class node_invariants_t {
+public:
+  /*!
+   \brief Constructor
+   \param graph_system : system of the graph
+   \note this keeps a reference on graph_system
+   */
+  node_invariants_t(tchecker::system::system_t const & graph_system) : _graph_system(graph_system) {}
+
+  /*!
+   \brief Identifier of the invariant of a node
+   \param node : a node
+   \return identifier of the conjunction of the invariants of the locations of node
+   \note not thread-safe
+   */
+  std::size_t id(node_sptr_t const & node)
+  {
+    tchecker::shared_vloc_t const * vloc = node->state_ptr()->vloc_ptr().ptr();
+    auto it = _vloc_ids.find(vloc);
+    if (it != _vloc_ids.end())
+      return it->second;
+
+    std::string text;
+    for (auto loc_id : *vloc)
+      for (auto const & inv : _graph_system.location(loc_id)->attributes().range(tchecker::system::ATTR_KEY_INVARIANT)) {
+        if (!text.empty())
+          text += " && ";
+        text += inv.value();
+      }
+    auto && [text_it, inserted] = _text_ids.emplace(std::move(text), _invariants.size());
+    if (inserted)
+      _invariants.push_back(&text_it->first);
+    _vloc_ids.emplace(vloc, text_it->second);
+    return text_it->second;
+  }
 
-  // Step 5: Write node locations with attributes
-  writeNodeLocations(m_file, graph, nodes_map);
+  /*!
+   \brief Accessor
+   \param id : identifier of an invariant
+   \pre id has been returned by id()
+   \return the invariant with identifier id (empty if the locations have no invariant)
+   \note thread-safe as long as id() is not called concurrently
+   */
+  inline std::string const & invariant(std::size_t id) const { return *_invariants[id]; }
+
+private:
+  tchecker::system::system_t const & _graph_system;                       /*!< System of the graph */
+  std::unordered_map<tchecker::shared_vloc_t const *, std::size_t> _vloc_ids; /*!< Map : vloc -> invariant identifier */
+  std::unordered_map<std::string, std::size_t> _text_ids;                 /*!< Map : invariant -> identifier */
+  std::vector<std::string const *> _invariants;                           /*!< Invariants by identifier (keys of _text_ids) */
+};
 
-  // Step 6: Write edges based on node IDs
-  std::set<std::string> declared_events;
-  writeEdges(m_file, graph, nodes_map, declared_events);
+/*!
+ \brief Statements of the edges of the merged system without the assignments of inactive clocks, by edge identifier
+ of the graph system (edges with unchanged statements are not in the map)
+ */
+using edge_statements_t = std::unordered_map<tchecker::edge_id_t, std::string>;
 
-  // Step 7: Write environment data
-  std::map<std::string, std::set<std::string>> events_per_ps;
-  writeEnvironmentData(m_file, env_file, declared_events, events_per_ps);
+// Function declarations
+boost::dynamic_bitset<> activeClocks(const graph_t & graph, tchecker::tck_reach::edge_statements_t & statements);
+void declareSystemClocks(tchecker::parsing::system_declaration_t & merged, tchecker::tck_reach::merge_inputs_t const & inputs,
+                         const graph_t & graph, boost::dynamic_bitset<> const * active);
+void declareIntegerVariables(tchecker::parsing::system_declaration_t & merged,
+                             tchecker::tck_reach::merge_inputs_t const & inputs);
+tchecker::node_id_t assignNodeIDs(tchecker::tck_reach::nodes_t & nodes, const graph_t & graph, bool merge, bool lexical);
+void mergeNodes(tchecker::tck_reach::nodes_t const & nodes);
+tchecker::node_id_t minimizeNodes(tchecker::tck_reach::nodes_t const & nodes, const graph_t & graph,
+                                  tchecker::node_id_t nodes_count, tchecker::tck_reach::node_invariants_t & invariants);
+void declareNodeLocations(tchecker::parsing::system_declaration_t & merged,
+                          tchecker::parsing::process_declaration_t const & process, tchecker::tck_reach::nodes_t const & nodes,
+                          tchecker::tck_reach::node_invariants_t & invariants,
+                          std::vector<tchecker::parsing::location_declaration_t const *> & locations,
+                          std::size_t threads = 1);
+tchecker::parsing::attributes_t nodeAttributes(const node_sptr_t & node, bool initial, std::string const & invariant);
+void declareEdges(tchecker::parsing::system_declaration_t & merged, tchecker::parsing::process_declaration_t const & process,
+                  const graph_t & graph, std::vector<tchecker::parsing::location_declaration_t const *> const & locations,
+                  bool lexical, std::set<std::string> & synchronized_events, std::size_t threads = 1,
+                  tchecker::tck_reach::edge_statements_t const * statements = nullptr);
+tchecker::parsing::attributes_t edgeAttributes(const edge_sptr_t & edge, const tchecker::system::system_t & graph_system,
+                                               tchecker::tck_reach::edge_statements_t const * reduced = nullptr);
+void declareEnvironmentData(tchecker::parsing::system_declaration_t & merged, tchecker::tck_reach::merge_inputs_t const & inputs,
+                            std::set<std::string> const & synchronized_events,
+                            std::map<std::string, std::set<std::string>> & events_per_ps);
+void declareSynchronization(tchecker::parsing::system_declaration_t & merged, const std::set<std::string> & synchronized_events,
+                            const std::map<std::string, std::set<std::string>> & events_per_ps);
+void outputDeclaration(std::ostream & os, tchecker::parsing::system_declaration_t const & merged, std::size_t threads = 1);
+
+/*!
+ \brief Build the merged system declaration from the reachable part of a history-aware graph
+ \param inputs : declarations of the system, of the environment and of the property
+ \param graph : history-aware graph, with reachable nodes marked by backward reachability
+ \param os : output stream for the merged system (nullptr for no output)
+ \param nodes_count : number of locations in the merged system
+ \param merge : merge flag
+ \param minimize : minimization flag
+ \param lexical : lexical ordering flag
+ \param threads : number of threads formatting the attributes of locations and edges, and the output to os
+ \param reduce_clocks : clock reduction flag
+ \return the merged system declaration: one process "sys" with a location per reachable node of graph,
+ synchronized with the processes of the environment. If merge is set, reachable nodes with the same locations,
+ integer variables valuation, reset history and final flag share a location when the union of their zones is a
+ zone (see mergeNodes). If minimize is set, bisimilar locations are then merged (see minimizeNodes). Locations
+ are numbered in the order of the nodes of graph, and edges are declared in the order of the outgoing edges of the
+ nodes, unless lexical is set: then locations are numbered in the lexical order of the nodes, and edges are declared
+ in the order of their source, target and vedge (deterministic output). If reduce_clocks is set, the clocks of the
+ property that are not active in the reachable part of graph (see activeClocks) are not declared, and their
+ assignments are removed from the statements of the edges
+ \post nodes_count has been set to the number of locations in the merged system. The merged system has been
+ output to os if os is not nullptr.
+ \note the declaration is built directly in memory: neither the file system nor the parser are involved
+ \note the declaration and its output do not depend on threads: chunks are formatted in parallel, and they are
+ inserted or output in order
+ \note the caller owns the returned declaration
+ */
+tchecker::parsing::system_declaration_t *
+graph_parser(tchecker::tck_reach::merge_inputs_t const & inputs, const graph_t & graph, std::ostream * os,
+             uint32_t & nodes_count, bool merge = false, bool minimize = false, bool lexical = false,
+             std::size_t threads = 1, bool reduce_clocks = false)
+{
+  TCHECKER_PROBE0(graph_parser_start);
 
-  // Step 8: Write synchronization data
-  writeSynchronization(m_file, declared_events, events_per_ps);
+  // Step 1: Declare the merged system and its process
+  auto * merged =
+      new tchecker::parsing::system_declaration_t(MERGED_SYSTEM_NAME, tchecker::parsing::attributes_t{}, MERGED_CONTEXT);
 
-  m_file.close();
+  try {
+    auto const * process =
+        new tchecker::parsing::process_declaration_t(MERGED_PROCESS_NAME, tchecker::parsing::attributes_t{}, MERGED_CONTEXT);
+    merged->insert_process_declaration(process);
+
+    // Step 2: Declare system clocks (the active ones if reduce_clocks is set)
+    tchecker::tck_reach::edge_statements_t statements;
+    boost::dynamic_bitset<> active;
+    if (reduce_clocks)
+      active = activeClocks(graph, statements);
+    declareSystemClocks(*merged, inputs, graph, (reduce_clocks ? &active : nullptr));
+
+    // Step 3: Declare bounded integer variables
+    declareIntegerVariables(*merged, inputs);
+
+    // Step 4: Assign each node a unique ID
+    tchecker::tck_reach::nodes_t nodes;
+    tchecker::tck_reach::node_invariants_t invariants{graph->zg().system().as_system_system()};
+    nodes_count = assignNodeIDs(nodes, graph, merge, lexical);
+    if (minimize)
+      nodes_count = minimizeNodes(nodes, graph, nodes_count, invariants);
+
+    // Step 5: Declare node locations with attributes
+    std::vector<tchecker::parsing::location_declaration_t const *> locations;
+    declareNodeLocations(*merged, *process, nodes, invariants, locations, threads);
+
+    // Step 6: Declare edges based on node IDs
+    std::set<std::string> synchronized_events;
+    declareEdges(*merged, *process, graph, locations, lexical, synchronized_events, threads, &statements);
+
+    // Step 7: Declare environment data
+    std::map<std::string, std::set<std::string>> events_per_ps;
+    declareEnvironmentData(*merged, inputs, synchronized_events, events_per_ps);
+
+    // Step 8: Declare synchronization data
+    declareSynchronization(*merged, synchronized_events, events_per_ps);
+  }
+  catch (...) {
+    delete merged;
+    throw;
+  }
 
-  std::ifstream read_file("m_file.txt");
-  if (read_file.is_open()) {
-    std::string line;
-    while (std::getline(read_file, line)) {
-      *os << line << std::endl;
-    }
+  if (os != nullptr) {
+    outputDeclaration(*os, *merged, threads);
+    *os << std::endl;
   }
-  read_file.close();
 
-//  *os << "BACKWARD_REACH_STATES " << nodes_count << "\n\n";
-  return load_system_declaration("m_file.txt");
-}
+  TCHECKER_PROBE1(graph_parser_stop, nodes_count);
 
-void writeInitialData(std::ofstream & file)
-{
-  file << "system:mergedSystem\n\n";
-  file << "process:sys\n\n";
+  return merged;
 }
 
-void writeSystemClocks(std::ofstream & file, std::vector<std::string> & system_clocks,
-                       const std::shared_ptr<tchecker::parsing::system_declaration_t> & property_decl)
+/*!
+ \brief Compute the active clocks of the merged system
+ \param graph : history-aware graph, with reachable nodes marked by backward reachability
+ \param statements : statements of edges
+ \return the set of flattened clocks of the system of graph that are read by the invariant of a reachable node, by
+ the guard of an edge between reachable nodes, or by a statement of such an edge that is not a sequence of
+ assignments, or that are assigned to an active clock
+ \post the statements of the edges between reachable nodes that assign inactive clocks have been added to
+ statements, without these assignments
+ \note inactive clocks are only reset, hence they do not constrain the runs of the merged system, which can do
+ without them: the dimension of the zones of the final check is reduced accordingly
+ */
+boost::dynamic_bitset<> activeClocks(const graph_t & graph, tchecker::tck_reach::edge_statements_t & statements)
 {
-  for (const auto & [key, _] : property_decl->get_clocks()) {
-    file << "clock:1:" << key << "\n";
-    system_clocks.push_back(key);
+  tchecker::ta_ha::system_t const & system = graph->zg().system();
+  boost::dynamic_bitset<> active{system.clocks_count(tchecker::VK_FLATTENED)};
+  std::unordered_set<tchecker::clock_id_t> clocks;
+  std::unordered_set<tchecker::intvar_id_t> intvars;
+  auto add = [&](std::unordered_set<tchecker::clock_id_t> const & ids) {
+    for (tchecker::clock_id_t id : ids)
+      active.set(id);
+  };
+
+  // locations of reachable nodes, and edges between reachable nodes
+  boost::dynamic_bitset<> locations{system.locations_count()};
+  boost::dynamic_bitset<> edges{system.edges_count()};
+  for (const auto & node : graph->nodes()) {
+    if (!node->get_reach_status())
+      continue;
+    for (auto loc_id : node->state().vloc())
+      locations.set(loc_id);
+    for (const auto & edge : graph->outgoing_edges(node))
+      if (graph->edge_tgt(edge)->get_reach_status())
+        for (auto edge_id : edge->vedge())
+          edges.set(edge_id);
+  }
+
+  for (std::size_t id = locations.find_first(); id != boost::dynamic_bitset<>::npos; id = locations.find_next(id)) {
+    clocks.clear();
+    tchecker::extract_variables(system.invariant(id), clocks, intvars);
+    add(clocks);
+  }
+
+  // resets: assigned clock, clocks read by the assignment
+  std::vector<std::tuple<tchecker::clock_id_t, std::unordered_set<tchecker::clock_id_t>>> resets;
+  for (std::size_t id = edges.find_first(); id != boost::dynamic_bitset<>::npos; id = edges.find_next(id)) {
+    clocks.clear();
+    tchecker::extract_variables(system.guard(id), clocks, intvars);
+    add(clocks);
+
+    std::vector<tchecker::typed_assign_statement_t const *> assignments;
+    if (!tchecker::flat_assignments(system.statement(id), assignments)) {
+      clocks.clear();
+      tchecker::extract_read_variables(system.statement(id), clocks, intvars);
+      tchecker::extract_written_variables(system.statement(id), clocks, intvars);
+      add(clocks);
+      continue;
+    }
+    for (tchecker::typed_assign_statement_t const * a : assignments) {
+      std::unordered_set<tchecker::clock_id_t> written, read;
+      tchecker::extract_written_variables(*a, written, intvars);
+      tchecker::extract_read_variables(*a, read, intvars);
+      // assignments to an array of clocks with a non-constant index may fail, hence they are kept
+      if (written.size() == 1)
+        resets.emplace_back(*written.begin(), std::move(read));
+      else {
+        add(written);
+        add(read);
+      }
+    }
+  }
+
+  // clocks assigned to active clocks are active
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (auto && [written, read] : resets) {
+      if (!active[written])
+        continue;
+      for (tchecker::clock_id_t id : read)
+        if (!active[id]) {
+          active.set(id);
+          changed = true;
+        }
+    }
   }
-  file << "\n";
+
+  // statements without the assignments of inactive clocks
+  for (std::size_t id = edges.find_first(); id != boost::dynamic_bitset<>::npos; id = edges.find_next(id)) {
+    std::vector<tchecker::typed_assign_statement_t const *> assignments;
+    if (!tchecker::flat_assignments(system.statement(id), assignments))
+      continue;
+    std::string statement;
+    bool reduced = false;
+    for (tchecker::typed_assign_statement_t const * a : assignments) {
+      std::unordered_set<tchecker::clock_id_t> written;
+      tchecker::extract_written_variables(*a, written, intvars);
+      if (written.size() == 1 && !active[*written.begin()]) {
+        reduced = true;
+        continue;
+      }
+      statement += (statement.empty() ? "" : "; ") + a->to_string();
+    }
+    if (reduced)
+      statements[id] = statement;
+  }
+
+  return active;
 }
 
-void writeIntegerVariables(std::ofstream & file, const std::string & input_file)
+/*!
+ \brief Declare the clocks of the merged system
+ \param merged : merged system declaration
+ \param inputs : declarations of the system, of the environment and of the property
+ \param graph : history-aware graph
+ \param active : active flattened clocks of the system of graph (nullptr: all clocks are active)
+ \post the clocks of the property have been declared in merged, except those with no active flattened clock
+ */
+void declareSystemClocks(tchecker::parsing::system_declaration_t & merged, tchecker::tck_reach::merge_inputs_t const & inputs,
+                         const graph_t & graph, boost::dynamic_bitset<> const * active)
 {
-  std::ifstream input_file_stream(input_file);
-  std::string line;
-  while (std::getline(input_file_stream, line)) {
-    if (line.find("int") != std::string::npos) {
-      file << line << "\n";
+  tchecker::clock_variables_t const & clock_variables = graph->zg().system().clock_variables();
+  for (std::string const & name : inputs.property_clocks()) {
+    if (active != nullptr && clock_variables.is_variable(name)) {
+      tchecker::clock_id_t const id = clock_variables.id(name);
+      bool is_active = false;
+      for (tchecker::clock_id_t x = id; x < id + clock_variables.info(id).size(); ++x)
+        is_active = is_active || (*active)[x];
+      if (!is_active)
+        continue;
     }
+    merged.insert_clock_declaration(
+        new tchecker::parsing::clock_declaration_t(name, 1, tchecker::parsing::attributes_t{}, MERGED_CONTEXT));
   }
-  file << "\n";
 }
 
-tchecker::node_id_t assignNodeIDs(std::map<node_sptr_t, tchecker::node_id_t, node_lexical_less_t> & nodes_map,
-                                  const graph_t & graph)
+void declareIntegerVariables(tchecker::parsing::system_declaration_t & merged,
+                             tchecker::tck_reach::merge_inputs_t const & inputs)
+{
+  for (auto const * d : inputs.system_ints())
+    merged.insert_int_declaration(dynamic_cast<tchecker::parsing::int_declaration_t const *>(d->clone()));
+}
+
+tchecker::node_id_t assignNodeIDs(tchecker::tck_reach::nodes_t & nodes, const graph_t & graph, bool merge, bool lexical)
 {
   for (const auto & node : graph->nodes()) {
-    if (node->get_reach_status()) {
-      nodes_map.insert(std::make_pair(node, 0));
-    }
+    node->merged_id(tchecker::tck_reach::zg_history_aware::node_t::NO_MERGED_ID);
+    if (node->get_reach_status())
+      nodes.push_back(node);
   }
 
+  if (lexical)
+    std::sort(nodes.begin(), nodes.end(), node_lexical_less_t{});
+
   tchecker::node_id_t node_count = 0;
-  for (auto & [_, id] : nodes_map) {
-    id = node_count++;
+  for (auto & node : nodes)
+    node->merged_id(node_count++);
+
+  if (merge) {
+    mergeNodes(nodes);
+    node_count = 0;
+    std::vector<tchecker::node_id_t> renaming(nodes.size(), std::numeric_limits<tchecker::node_id_t>::max());
+    for (auto & node : nodes) {
+      if (renaming[node->merged_id()] == std::numeric_limits<tchecker::node_id_t>::max())
+        renaming[node->merged_id()] = node_count++;
+      node->merged_id(renaming[node->merged_id()]);
+    }
   }
 
   return node_count;
 }
 
-void writeNodeLocations(std::ofstream & file, const graph_t & graph,
-                        const std::map<node_sptr_t, tchecker::node_id_t, node_lexical_less_t> & nodes_map)
-{
-  auto graph_system = graph->zg().system().as_system_system();
-  for (const auto & [node, id] : nodes_map) {
-    file << "location:sys:S" << id << "{";
-
-    std::map<std::string, std::string> attr;
-    graph->attributes(node, attr);
-    writeNodeAttributes(file, attr, node, graph_system);
+/*!
+ \brief Less-than order on the discrete part of nodes
+ \note nodes with the same discrete part only differ by their zone and their initial flag
+ */
+class node_discrete_less_t {
+public:
+  bool operator()(const node_sptr_t & n1, const node_sptr_t & n2) const
+  {
+    int cmp = tchecker::lexical_cmp(n1->state().vloc(), n2->state().vloc());
+    if (cmp != 0)
+      return (cmp < 0);
+    cmp = tchecker::lexical_cmp(n1->state().intval(), n2->state().intval());
+    if (cmp != 0)
+      return (cmp < 0);
+    if (n1->reset_history_vector() != n2->reset_history_vector())
+      return (n1->reset_history_vector() < n2->reset_history_vector());
+    return (n1->final() < n2->final());
+  }
+};
 
-    file << "}\n";
+/*!
+ \brief Merge nodes with convex union of zones
+ \param nodes : reachable nodes
+ \post nodes with the same locations, integer variables valuation, reset history and final flag have been given
+ the same identifier (the smallest one) when the union of their zones is a zone. The union is checked exactly (see
+ tchecker::dbm::is_union_convex) and merged nodes are grouped greedily in the order of nodes: each node joins the
+ first group whose convex hull forms a zone with its zone
+ */
+void mergeNodes(tchecker::tck_reach::nodes_t const & nodes)
+{
+  // group of merged nodes: convex hull of the zones of the nodes, and identifier of the group
+  using group_t = std::tuple<std::vector<tchecker::dbm::db_t>, tchecker::node_id_t>;
+  std::map<node_sptr_t, std::vector<group_t>, node_discrete_less_t> groups;
+
+  for (auto const & node : nodes) {
+    tchecker::zg::zone_t const & zone = node->state().zone();
+    tchecker::clock_id_t const dim = static_cast<tchecker::clock_id_t>(zone.dim());
+    std::vector<group_t> & candidates = groups[node];
+
+    bool merged = false;
+    for (auto & [hull, group_id] : candidates) {
+      if (!tchecker::dbm::is_union_convex(hull.data(), zone.dbm(), dim))
+        continue;
+      tchecker::dbm::convex_hull(hull.data(), hull.data(), zone.dbm(), dim);
+      node->merged_id(group_id);
+      merged = true;
+      break;
+    }
 
-    // auto reset_vector = node->reset_history_vector();
-    // file << reset_vector << std::endl;
+    if (!merged)
+      candidates.emplace_back(std::vector<tchecker::dbm::db_t>(zone.dbm(), zone.dbm() + dim * dim), node->merged_id());
   }
-  file << "\n";
 }
 
-void writeNodeAttributes(std::ofstream & file, const std::map<std::string, std::string> & attr, const node_sptr_t & node,
-                         const tchecker::system::system_t & graph_system)
+void declareNodeLocations(tchecker::parsing::system_declaration_t & merged,
+                          tchecker::parsing::process_declaration_t const & process, tchecker::tck_reach::nodes_t const & nodes,
+                          tchecker::tck_reach::node_invariants_t & invariants,
+                          std::vector<tchecker::parsing::location_declaration_t const *> & locations,
+                          std::size_t threads)
 {
-  // Custom function for writing node attributes (e.g., initial, final, invariants, etc.)
-  bool pi_printed = false;
-  for (const auto & [key, value] : attr) {
-    if (key == "final") {
-      // add pi label to finals
-      file << "labels:Pi";
-      pi_printed = true;
+  // a location is initial if one of its nodes is initial, and its other attributes are shared by its nodes
+  std::vector<node_sptr_t> representatives;
+  std::vector<bool> initial;
+  for (const auto & node : nodes) {
+    tchecker::node_id_t const id = node->merged_id();
+    if (id >= representatives.size()) {
+      representatives.resize(id + 1);
+      initial.resize(id + 1, false);
     }
+    if (representatives[id].ptr() == nullptr)
+      representatives[id] = node;
+    initial[id] = initial[id] || node->initial();
   }
 
-  // invariants
-  bool inv_printed = false;
-  for (auto loc_id : node->state_ptr()->vloc()) {
-    auto single_location = graph_system.location(loc_id);
-    const auto & loc_range = single_location->attributes().range("invariant");
-    if (!loc_range.empty()) {
-      // if there exists at least one invariant
-      if (inv_printed == false) {
-        // if (pi_printed == true) {        // previous implementation
-        //    m_file << ":";                // previous implementation
-        // }                                // previous implementation
-        if (!pi_printed) {
-          // if not pi, otherwise we don't need the invariant
-          file << "invariant:";
-        }
-        else {
-          file << ":invariant:";
-        }
-      }
-      for (auto loc_it = loc_range.begin(); loc_it != loc_range.end();) {
-        auto const loc_invariant = *loc_it;
-        if (inv_printed == false) {
-          file << loc_invariant.value();
-          inv_printed = true;
-        }
-        else {
-          file << " && " << loc_invariant.value();
-        }
-        if (++loc_it != loc_range.end()) {
-          file << " && ";
-        }
-      }
-    }
+  // invariants are computed once per tuple of locations, then attributes are formatted in parallel (invariants are
+  // only read), and locations are declared in order
+  std::vector<std::size_t> invariant_ids(representatives.size());
+  for (tchecker::node_id_t id = 0; id < representatives.size(); ++id)
+    invariant_ids[id] = invariants.id(representatives[id]);
+
+  std::vector<tchecker::parsing::attributes_t> attributes(representatives.size());
+  tchecker::parallel_for(representatives.size(), threads, [&](std::size_t, std::size_t id) {
+    attributes[id] = nodeAttributes(representatives[id], initial[id], invariants.invariant(invariant_ids[id]));
+  });
+
+  locations.resize(representatives.size(), nullptr);
+  for (tchecker::node_id_t id = 0; id < representatives.size(); ++id) {
+    auto const * loc = new tchecker::parsing::location_declaration_t("S" + std::to_string(id), process,
+                                                                     std::move(attributes[id]), MERGED_CONTEXT);
+    merged.insert_location_declaration(loc);
+    locations[id] = loc;
   }
+}
 
-  for (const auto & [key, value] : attr) {
-    if (key == "initial") {
-      if (inv_printed) {
-        file << ":initial:";
-      }
-      else {
-        file << "initial:";
-      }
-    }
+/*!
+ \brief Join attribute values
+ \param values : attribute values
+ \param separator : separator between values
+ \return the values in values separated by separator
+ */
+static std::string join_values(std::vector<std::string> const & values, std::string const & separator)
+{
+  std::string s;
+  for (auto it = values.begin(); it != values.end(); ++it) {
+    if (it != values.begin())
+      s += separator;
+    s += *it;
   }
+  return s;
+}
+
+tchecker::parsing::attributes_t nodeAttributes(const node_sptr_t & node, bool initial, std::string const & invariant)
+{
+  tchecker::parsing::attributes_t attr;
+
+  // add pi label to finals
+  if (node->final())
+    attr.insert(new tchecker::parsing::attr_t("labels", "Pi", tchecker::parsing::attr_parsing_position_t{}));
+
+  // invariants
+  if (!invariant.empty())
+    attr.insert(new tchecker::parsing::attr_t("invariant", invariant, tchecker::parsing::attr_parsing_position_t{}));
+
+  if (initial)
+    attr.insert(new tchecker::parsing::attr_t("initial", "", tchecker::parsing::attr_parsing_position_t{}));
+
+  return attr;
 }
 
-void writeEdges(std::ofstream & file, const graph_t & graph,
-                const std::map<node_sptr_t, tchecker::node_id_t, node_lexical_less_t> & nodes_map,
-                std::set<std::string> & declared_events)
+void declareEdges(tchecker::parsing::system_declaration_t & merged, tchecker::parsing::process_declaration_t const & process,
+                  const graph_t & graph, std::vector<tchecker::parsing::location_declaration_t const *> const & locations,
+                  bool lexical, std::set<std::string> & synchronized_events, std::size_t threads,
+                  tchecker::tck_reach::edge_statements_t const * statements)
 {
-  std::multiset<extended_edge_t, extended_edge_le_t> edges_set;
+  // edges of merged nodes with the same vedge are declared once
+  std::unordered_set<extended_edge_t, extended_edge_hash_t, extended_edge_equal_to_t> edges_set;
+  std::vector<extended_edge_t> edges;
 
   for (const auto & node : graph->nodes()) {
     for (const auto & edge : graph->outgoing_edges(node)) {
-      if (graph->edge_src(edge)->get_reach_status() && graph->edge_tgt(edge)->get_reach_status()) {
-        auto src_it = nodes_map.find(graph->edge_src(edge));
-        auto tgt_it = nodes_map.find(graph->edge_tgt(edge));
-
-        if (src_it != nodes_map.end() && tgt_it != nodes_map.end()) {
-          edges_set.emplace(src_it->second, tgt_it->second, edge);
-        }
-        else {
+      auto const & src = graph->edge_src(edge);
+      auto const & tgt = graph->edge_tgt(edge);
+      if (src->get_reach_status() && tgt->get_reach_status()) {
+        if (src->merged_id() == tchecker::tck_reach::zg_history_aware::node_t::NO_MERGED_ID ||
+            tgt->merged_id() == tchecker::tck_reach::zg_history_aware::node_t::NO_MERGED_ID)
           throw std::runtime_error("Edge source or target not found in node map.");
-        }
+        extended_edge_t e{src->merged_id(), tgt->merged_id(), edge};
+        if (edges_set.insert(e).second)
+          edges.push_back(e);
       }
     }
   }
 
-  std::map<std::string, std::string> attr;
-  auto graph_system = graph->zg().system().as_system_system();
+  if (lexical)
+    std::sort(edges.begin(), edges.end(), extended_edge_le_t{});
+
+  tchecker::ta_ha::system_t const & system = graph->zg().system();
+  auto const & graph_system = system.as_system_system();
+
+  // event declarations of the merged system, indexed by event identifiers of the graph system: event names are only
+  // looked up when an event is declared
+  std::vector<tchecker::parsing::event_declaration_t const *> events(system.events_count(), nullptr);
+
+  // attributes are formatted in parallel (graph_system is only read), edges are declared in order
+  std::vector<tchecker::parsing::attributes_t> attributes(edges.size());
+  tchecker::parallel_for(edges.size(), threads, [&](std::size_t, std::size_t i) {
+    attributes[i] = edgeAttributes(std::get<2>(edges[i]), graph_system, statements);
+  });
+
+  for (std::size_t i = 0; i < edges.size(); ++i) {
+    auto const & [src, tgt, edge] = edges[i];
+    // the merged edge is labelled by the event of the first process involved in the vedge
+    auto const & vedge = edge->vedge();
+    if (vedge.begin() == vedge.end())
+      throw std::runtime_error("Edge with empty vedge in history-aware graph.");
+    tchecker::event_id_t const event_id = graph_system.edge(*vedge.begin())->event_id();
+
+    if (events[event_id] == nullptr) {
+      std::string const & event_name = system.event_name(event_id);
+      events[event_id] =
+          new tchecker::parsing::event_declaration_t(event_name, tchecker::parsing::attributes_t{}, MERGED_CONTEXT);
+      merged.insert_event_declaration(events[event_id]);
+      if (!system.is_epsilon_event(event_id)) // epsilon events are asynchronous
+        synchronized_events.insert(event_name);
+    }
 
-  for (const auto & [src, tgt, edge] : edges_set) {
-    attr.clear();
-    graph->attributes(edge, attr);
-    writeEdge(file, src, tgt, edge, attr, declared_events, graph_system);
+    merged.insert_edge_declaration(new tchecker::parsing::edge_declaration_t(
+        process, *locations[src], *locations[tgt], *events[event_id], std::move(attributes[i]), MERGED_CONTEXT));
   }
 }
 
-void writeEdge(std::ofstream & file, tchecker::node_id_t src, tchecker::node_id_t tgt, const edge_sptr_t & edge,
-               const std::map<std::string, std::string> & attr, std::set<std::string> & declared_events,
-               tchecker::system::system_t graph_system)
+/*!
+ \brief Statements and guards of an edge
+ \param edge : an edge
+ \param graph_system : system of the graph
+ \param statements : statements of edge
+ \param guards : guards of edge
+ \param reduced : reduced statements of edges (nullptr: none)
+ \post the statements and the guards of the edges in the vedge of edge have been appended to statements and guards.
+ The statements of the edges in reduced are taken from reduced (when not empty)
+ */
+static void edge_values(const edge_sptr_t & edge, const tchecker::system::system_t & graph_system,
+                        std::vector<std::string> & statements, std::vector<std::string> & guards,
+                        tchecker::tck_reach::edge_statements_t const * reduced = nullptr)
 {
-  // Custom function to handle edge attributes (e.g., event, do/provided statements)
-
-  for (const auto & [key, value] : attr) {
-    if (key == "vedge") {
-      std::basic_string<char>::size_type startIndex = value.find('@');
-      std::basic_string<char>::size_type endIndex = value.find(',');
-      // Determine the substring based on the presence of endIndex
-      std::string sub_string = (endIndex != std::string::npos) ? value.substr(startIndex + 1, (endIndex - 1) - startIndex)
-                                                               : value.substr(startIndex + 1, value.length() - startIndex - 2);
-
-      bool insert_line = declared_events.insert(sub_string).second;
-      // It will search and insert if the event wasn't previously declared
-      if (insert_line) {
-        file << "\nevent:" << sub_string << "\n";
-      }
-      // print edge
-      file << "edge:sys:S" << std::to_string(src) << ":S" << std::to_string(tgt) << ":" << sub_string << "{";
-      // check for do statements
-      bool do_printed = false;
-      for (auto edge_id : edge->vedge()) {
-        // do statements
-        auto single_edge = graph_system.edge(edge_id);
-        auto const & edge_range = single_edge->attributes().range("do");
-        if (!edge_range.empty()) {
-          // if there exists at least one do statement
-          if (do_printed == false) {
-            file << "do:";
-          }
-          for (auto edge_it = edge_range.begin(); edge_it != edge_range.end();) {
-            auto const clock_assignment = *edge_it;
-            if (do_printed == false) {
-              file << clock_assignment.value();
-              do_printed = true;
-            }
-            else {
-              file << ";" << clock_assignment.value();
-            }
-            if (++edge_it != edge_range.end()) {
-              file << ";";
-            }
-          }
-        }
-      }
-      // check for provided statements
-      bool provided_printed = false;
-      for (auto edge_id : edge->vedge()) {
-        // provided statements
-        auto single_edge = graph_system.edge(edge_id);
-        auto const & edge_range = single_edge->attributes().range("provided");
-        if (!edge_range.empty()) {
-          // if there exists at least one provided statement
-          if (do_printed == true) {
-            // if there exist a do statement before
-            file << ":";
-            do_printed = false; // prohibit second run
-          }
-          if (provided_printed == false) {
-            // if provided was not printed before
-            file << "provided:";
-          }
-          for (auto edge_it = edge_range.begin(); edge_it != edge_range.end();) {
-            auto const clock_condition = *edge_it;
-            if (provided_printed == false) {
-              file << clock_condition.value();
-              provided_printed = true;
-            }
-            else {
-              file << " && " << clock_condition.value();
-            }
-            if (++edge_it != edge_range.end()) {
-              file << " && ";
-            }
-          }
-        }
-      }
-      file << "}\n";
-      if (insert_line) {
-        // insert another line for convenience
-        file << "\n";
-      }
+  for (auto edge_id : edge->vedge()) {
+    auto const & attributes = graph_system.edge(edge_id)->attributes();
+    auto it = (reduced == nullptr ? tchecker::tck_reach::edge_statements_t::const_iterator{} : reduced->find(edge_id));
+    if (reduced != nullptr && it != reduced->end()) {
+      if (!it->second.empty())
+        statements.push_back(it->second);
     }
+    else
+      for (auto const & stmt : attributes.range(tchecker::system::ATTR_KEY_DO))
+        statements.push_back(stmt.value());
+    for (auto const & guard : attributes.range(tchecker::system::ATTR_KEY_PROVIDED))
+      guards.push_back(guard.value());
   }
 }
 
-void writeEnvironmentData(std::ofstream & file, const std::string & env_file, std::set<std::string> & declared_events,
-                          std::map<std::string, std::set<std::string>> & events_per_ps)
+tchecker::parsing::attributes_t edgeAttributes(const edge_sptr_t & edge, const tchecker::system::system_t & graph_system,
+                                               tchecker::tck_reach::edge_statements_t const * reduced)
 {
-  std::vector<std::string> env_clocks;
-  std::set<std::string> declared_asynch_events;
-  std::set<std::string> declared_env_ps;
-
-  std::ifstream env_file_stream(env_file);
-  std::string line;
-  while (std::getline(env_file_stream, line)) {
-    if (line[0] == '#')
-      continue; // if the line is a comment
-
-    if (line.find("process") != std::string::npos) {
-      file << "\n" << line << "\n\n";
-      std::basic_string<char>::size_type index = line.find(':');
-      std::string ps = line.substr(index + 1, line.length() - index - 1);
-      file << "# ps name: " << ps << "\n\n";
-      declared_env_ps.insert(ps);
-      // add to declared environment processes // if the ps was not previously added (just to be sure, should not happen)
-    }
-    else if (line.find("location") != std::string::npos) {
-      file << line << "\n\n";
+  std::vector<std::string> statements, guards;
+  edge_values(edge, graph_system, statements, guards, reduced);
+
+  tchecker::parsing::attributes_t attr;
+  if (!statements.empty())
+    attr.insert(
+        new tchecker::parsing::attr_t("do", join_values(statements, ";"), tchecker::parsing::attr_parsing_position_t{}));
+  if (!guards.empty())
+    attr.insert(new tchecker::parsing::attr_t("provided", join_values(guards, " && "),
+                                              tchecker::parsing::attr_parsing_position_t{}));
+  return attr;
+}
+
+/*!
+ \brief Minimization of the locations of the merged system
+ \param nodes : reachable nodes
+ \param graph : history-aware graph
+ \param nodes_count : number of identifiers of nodes
+ \param invariants : invariants of nodes
+ \pre the identifiers of nodes range from 0 to nodes_count - 1, and nodes are the reachable nodes of graph
+ \post bisimilar identifiers have been given the same identifier, and the identifiers of nodes have been renumbered
+ from 0 in the order of nodes. Identifiers are labelled by their final flag and their invariant,
+ and their outgoing edges by their event, guards and statements (as declared in the merged system). The coarsest
+ bisimulation is computed by partition refinement: a block is split according to the labels of the outgoing edges
+ of its identifiers and the blocks of their targets, until no block is split
+ \return number of identifiers of nodes
+ \note the merged process with bisimilar locations merged is bisimilar to the merged process, in any environment:
+ locations and edges that are merged have the same invariants, guards and statements, hence the same timed behaviours
+ */
+tchecker::node_id_t minimizeNodes(tchecker::tck_reach::nodes_t const & nodes, const graph_t & graph,
+                                  tchecker::node_id_t nodes_count, tchecker::tck_reach::node_invariants_t & invariants)
+{
+  tchecker::ta_ha::system_t const & system = graph->zg().system();
+  auto const & graph_system = system.as_system_system();
+
+  // initial partition: by final flag and invariant (merged nodes have the same ones)
+  std::vector<std::size_t> block(nodes_count);
+  std::size_t blocks_count = 0;
+  {
+    std::map<std::tuple<bool, std::size_t>, std::size_t> blocks;
+    for (auto const & node : nodes)
+      block[node->merged_id()] =
+          blocks.emplace(std::make_tuple(node->final(), invariants.id(node)), blocks.size()).first->second;
+    blocks_count = blocks.size();
+  }
+
+  // outgoing edges of identifiers: label (event, guards and statements) and target
+  std::map<std::tuple<tchecker::event_id_t, std::string, std::string>, std::size_t> labels;
+  std::vector<std::vector<std::tuple<std::size_t, tchecker::node_id_t>>> edges(nodes_count);
+  std::vector<std::string> statements, guards;
+  for (const auto & node : nodes) {
+    for (const auto & edge : graph->outgoing_edges(node)) {
+      auto const & tgt = graph->edge_tgt(edge);
+      auto const & vedge = edge->vedge();
+      if (tgt->merged_id() == tchecker::tck_reach::zg_history_aware::node_t::NO_MERGED_ID || vedge.begin() == vedge.end())
+        continue;
+      statements.clear();
+      guards.clear();
+      edge_values(edge, graph_system, statements, guards);
+      auto label = std::make_tuple(graph_system.edge(*vedge.begin())->event_id(), join_values(guards, " && "),
+                                   join_values(statements, ";"));
+      std::size_t const label_id = labels.emplace(std::move(label), labels.size()).first->second;
+      edges[node->merged_id()].emplace_back(label_id, tgt->merged_id());
     }
-    else if (line.find("event") != std::string::npos) {
-      std::basic_string<char>::size_type start_index = line.find(':');
-      std::string events_name = line.substr(start_index + 1, line.length() - start_index - 1);
-      if (declared_events.find(events_name) == declared_events.end()) {
-        // if not prev. declared in system events
-        if (declared_asynch_events.insert(events_name).second) {
-          // if not prev. declared in env events
-          file << "event:" << events_name << "\n\n";
-        }
+  }
+
+  // refinement: the signature of an identifier is its block and the set of labels and blocks of the targets of its
+  // outgoing edges. Signatures refine blocks, hence the partition is stable when the number of blocks is unchanged
+  std::vector<std::size_t> signature;
+  std::vector<std::size_t> next_block(nodes_count);
+  for (;;) {
+    std::map<std::vector<std::size_t>, std::size_t> blocks;
+    for (tchecker::node_id_t id = 0; id < nodes_count; ++id) {
+      std::set<std::tuple<std::size_t, std::size_t>> successors;
+      for (auto const & [label_id, tgt] : edges[id])
+        successors.emplace(label_id, block[tgt]);
+      signature.clear();
+      signature.push_back(block[id]);
+      for (auto const & [label_id, tgt_block] : successors) {
+        signature.push_back(label_id);
+        signature.push_back(tgt_block);
       }
+      next_block[id] = blocks.emplace(signature, blocks.size()).first->second;
     }
-    else if (line.find("edge") != std::string::npos) {
-      file << line << "\n\n";
-      std::string the_ps;
-      for (const std::string & cur_ps : declared_env_ps) {
-        // find the corresponding process
-        if (line.find(cur_ps) != std::string::npos) {
-          the_ps = cur_ps; // note that processes should be declared before events, otherwise ps may not be initialized
-          break;
-        }
-      }
-      std::string the_event;
-      for (const std::string & cur_event : declared_events) {
-        // we only need to check shared events between system and env, for the purpose of sync later
-        if (line.find(cur_event) != std::string::npos) {
-          the_event = cur_event;
-        }
-      }
+    block.swap(next_block);
+    if (blocks.size() == blocks_count)
+      break;
+    blocks_count = blocks.size();
+  }
 
-      events_per_ps[the_ps].insert(the_event);
-      // add the event to the corresponding list (will create the set if it's the first event to be added)
-    }
-    else if (line.find("clock") != std::string::npos) {
-      file << line << "\n\n";
-      std::basic_string<char>::size_type start_index = line.find_last_of(':');
-      std::string clock_name = line.substr(start_index + 1, line.length() - start_index - 1);
-      env_clocks.push_back(clock_name); // add the new clock to the list of env clocks
-    }
-    else if (line.find("sync") != std::string::npos) {
-      file << line << "\n\n";
-    }
+  // renumbering in the order of nodes
+  tchecker::node_id_t count = 0;
+  std::vector<tchecker::node_id_t> renaming(blocks_count, std::numeric_limits<tchecker::node_id_t>::max());
+  for (auto const & node : nodes) {
+    tchecker::node_id_t const id = node->merged_id();
+    if (renaming[block[id]] == std::numeric_limits<tchecker::node_id_t>::max())
+      renaming[block[id]] = count++;
+    node->merged_id(renaming[block[id]]);
   }
+
+  return count;
 }
 
-void writeSynchronization(std::ofstream & file, const std::set<std::string> & declared_events,
-                          const std::map<std::string, std::set<std::string>> & events_per_ps)
+/*!
+ \class environment_importer_t
+ \brief Imports the declarations of an environment into the merged system
+ \note declarations that refer to other declarations (locations, edges, synchronizations) are rebuilt on top
+ of the declarations of the merged system, so the merged system does not depend on the environment
+ declaration once built. Integer variables and events shared with the system are already declared, the other
+ declarations of the environment must not clash with the merged system (see tchecker::parsing::declaration_filter_t)
+ */
+class environment_importer_t : public tchecker::parsing::declaration_filter_t {
+public:
+  /*!
+   \brief Constructor
+   \param merged : merged system declaration
+   */
+  environment_importer_t(tchecker::parsing::system_declaration_t & merged)
+      : tchecker::parsing::declaration_filter_t(merged)
+  {
+  }
+
+protected:
+  using tchecker::parsing::declaration_filter_t::keep;
+
+  virtual bool keep(tchecker::parsing::int_declaration_t const & d)
+  {
+    return _copy.get_int_declaration(d.name()) == nullptr;
+  }
+
+  virtual bool keep(tchecker::parsing::event_declaration_t const & d)
+  {
+    return _copy.get_event_declaration(d.name()) == nullptr;
+  }
+};
+
+void declareEnvironmentData(tchecker::parsing::system_declaration_t & merged, tchecker::tck_reach::merge_inputs_t const & inputs,
+                            std::set<std::string> const & synchronized_events,
+                            std::map<std::string, std::set<std::string>> & events_per_ps)
 {
-  // Write synchronization lines based on declared events and events per process
-  for (std::string event : declared_events) {
-    if (event[0] != '_') {
-      // if not epsilon
-      file << "sync:"
-           << "sys@" << event;
-      for (const auto & pair : events_per_ps) {
-        std::string ps = pair.first;
-        for (const auto & found_event : pair.second) {
-          if (found_event == event) {
-            file << ":" << ps << "@" << event;
-          }
-        }
-      }
+  tchecker::tck_reach::environment_importer_t importer(merged);
+  inputs.environment().visit(importer);
+
+  // we only need to record events shared between system and env, for the purpose of sync later
+  for (auto const & [ps, events] : inputs.environment_events())
+    for (std::string const & event : events)
+      if (synchronized_events.find(event) != synchronized_events.end())
+        events_per_ps[ps].insert(event);
+}
+
+void declareSynchronization(tchecker::parsing::system_declaration_t & merged, const std::set<std::string> & synchronized_events,
+                            const std::map<std::string, std::set<std::string>> & events_per_ps)
+{
+  auto const & sys = *merged.get_process_declaration(MERGED_PROCESS_NAME);
+
+  // Declare synchronizations based on synchronized events and events per process
+  for (std::string const & event : synchronized_events) {
+    auto const & event_decl = *merged.get_event_declaration(event);
+    std::vector<tchecker::parsing::sync_constraint_t const *> syncs;
+    syncs.push_back(new tchecker::parsing::sync_constraint_t(sys, event_decl, tchecker::SYNC_STRONG));
+    for (const auto & [ps, events] : events_per_ps) {
+      if (events.find(event) != events.end())
+        syncs.push_back(new tchecker::parsing::sync_constraint_t(*merged.get_process_declaration(ps), event_decl,
+                                                                 tchecker::SYNC_STRONG));
     }
-    file << "\n";
+    merged.insert_sync_declaration(
+        new tchecker::parsing::sync_declaration_t(std::move(syncs), tchecker::parsing::attributes_t{}, MERGED_CONTEXT));
   }
 }
 
-tchecker::parsing::system_declaration_t * load_system_declaration(std::string const & filename)
+/*!
+ \brief Output of the merged system declaration
+ \param os : output stream
+ \param merged : merged system declaration
+ \param threads : number of threads
+ \post merged has been output to os, as by os << merged
+ \note the inner declarations are split in contiguous chunks, one per thread, which are formatted in parallel into
+ their own buffers (declarations are only read), then written to os in order
+ */
+void outputDeclaration(std::ostream & os, tchecker::parsing::system_declaration_t const & merged, std::size_t threads)
 {
-  tchecker::parsing::system_declaration_t * sysdecl = nullptr;
-  try {
-    sysdecl = tchecker::parsing::parse_system_declaration(filename);
-    if (sysdecl == nullptr)
-      throw std::runtime_error("nullptr system declaration");
+  auto const declarations = merged.declarations();
+  std::size_t const size = std::distance(declarations.begin(), declarations.end());
+  std::size_t const chunks = std::min(std::max<std::size_t>(threads, 1), size);
+  if (chunks <= 1) {
+    os << merged;
+    return;
   }
-  catch (std::exception const & e) {
-    std::cerr << tchecker::log_error << e.what() << std::endl;
-  }
-  return sysdecl;
+
+  std::vector<std::string> buffers(chunks);
+  tchecker::parallel_for(chunks, chunks, [&](std::size_t, std::size_t c) {
+    std::ostringstream chunk_os;
+    auto const first = declarations.begin() + (c * size) / chunks;
+    auto const last = declarations.begin() + ((c + 1) * size) / chunks;
+    for (auto it = first; it != last; ++it)
+      chunk_os << **it << std::endl;
+    buffers[c] = chunk_os.str();
+  });
+
+  os << "system:" << merged.name() << merged.attributes() << std::endl;
+  for (std::string const & buffer : buffers)
+    os << buffer;
 }
 
 } // namespace tck_reach
 
 } // namespace tchecker
 
-#endif // PARSE_GRAPH_HH
\ No newline at end of file
+#endif // PARSE_GRAPH_HH
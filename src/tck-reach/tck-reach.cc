@@ -2,19 +2,63 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <dlfcn.h>
+#include <filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <getopt.h>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
+#include <sstream>
 #include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <tuple>
+#include <unistd.h>
+#include <vector>
 
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/budget.hh"
+#include "tchecker/algorithms/progress.hh"
 #include "tchecker/algorithms/reach/algorithm.hh"
 #include "tchecker/algorithms/search_order.hh"
+#include "tchecker/algorithms/stats.hh"
+#include "tchecker/graph/binary.hh"
 #include "tchecker/parsing/parsing.hh"
 #include "tchecker/syncprod/system.hh"
+#include "tchecker/ta/decomposition.hh"
+#include "tchecker/ta/pruning.hh"
+#include "tchecker/ta/slicing.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/async_output.hh"
 #include "tchecker/utils/log.hh"
+#include "tchecker/utils/parallel.hh"
+#include "tchecker/utils/sizing.hh"
+#include "tchecker/utils/string.hh"
+#include "tchecker/vm/native.hh"
+#include "tchecker/zg/zone_stats.hh"
+#include "compos-stats.hh"
+#include "concur19.hh"
+#include "zg-backward.hh"
+#include "zg-covreach.hh"
 #include "zg-reach-compos.hh"
 #include "zg-reach.hh"
 
@@ -29,12 +73,64 @@
 
 static struct option long_options[] = {{"algorithm", required_argument, 0, 'a'},
                                        {"certificate", required_argument, 0, 'C'},
+                                       {"cover", required_argument, 0, 'c'},
+                                       {"cover-stats", no_argument, 0, 0},
                                        {"output", required_argument, 0, 'o'},
                                        {"help", no_argument, 0, 'h'},
                                        {"labels", required_argument, 0, 'l'},
                                        {"search-order", no_argument, 0, 's'},
+                                       {"lexical-graph", no_argument, 0, 0},
+                                       {"format", required_argument, 0, 0},
                                        {"block-size", required_argument, 0, 0},
                                        {"table-size", required_argument, 0, 0},
+                                       {"adaptive-sizes", no_argument, 0, 0},
+                                       {"profile-model", required_argument, 0, 0},
+                                       {"zone-stats", required_argument, 0, 0},
+                                       {"checkpoint-every", required_argument, 0, 0},
+                                       {"checkpoint-file", required_argument, 0, 0},
+                                       {"resume", required_argument, 0, 0},
+                                       {"state-store", required_argument, 0, 0},
+                                       {"memory-limit", required_argument, 0, 0},
+                                       {"max-memory", required_argument, 0, 0},
+                                       {"max-states", required_argument, 0, 0},
+                                       {"timeout", required_argument, 0, 0},
+                                       {"stats-format", required_argument, 0, 0},
+                                       {"progress", required_argument, 0, 0},
+                                       {"progress-file", required_argument, 0, 0},
+                                       {"bitstate", required_argument, 0, 0},
+                                       {"gc-allocations", required_argument, 0, 0},
+                                       {"gc-interval", required_argument, 0, 0},
+                                       {"threads", required_argument, 0, 0},
+                                       {"pin", no_argument, 0, 0},
+                                       {"partitions", required_argument, 0, 0},
+                                       {"swarm", required_argument, 0, 0},
+                                       {"intval-mdd", no_argument, 0, 0},
+                                       {"federation", no_argument, 0, 0},
+                                       {"zone-storage", required_argument, 0, 0},
+                                       {"packed-intvals", no_argument, 0, 0},
+                                       {"lazy", no_argument, 0, 0},
+                                       {"covering", no_argument, 0, 0},
+                                       {"minimize", no_argument, 0, 0},
+                                       {"reduce-clocks", no_argument, 0, 0},
+                                       {"pipeline", no_argument, 0, 0},
+                                       {"bidirectional", no_argument, 0, 0},
+                                       {"por", no_argument, 0, 0},
+                                       {"symmetry", no_argument, 0, 0},
+                                       {"slice", no_argument, 0, 0},
+                                       {"prune", no_argument, 0, 0},
+                                       {"active-clocks", no_argument, 0, 0},
+                                       {"on-the-fly", no_argument, 0, 0},
+                                       {"ha-extrapolation", required_argument, 0, 0},
+                                       {"check-extrapolation", required_argument, 0, 0},
+                                       {"check-engine", required_argument, 0, 0},
+                                       {"emit-cpp", required_argument, 0, 0},
+                                       {"native", required_argument, 0, 0},
+                                       {"jit", no_argument, 0, 0},
+                                       {"server", required_argument, 0, 0},
+                                       {"jobs", required_argument, 0, 0},
+                                       {"iteration-growth", required_argument, 0, 0},
+                                       {"depth", required_argument, 0, 0},
+                                       {"bmc-cache", required_argument, 0, 0},
                                        {
                                            "property-file",
                                            required_argument,
@@ -42,11 +138,14 @@ static struct option long_options[] = {{"algorithm", required_argument, 0, 'a'},
                                            'P',
                                        },
                                        {"env-file", required_argument, 0, 'E'},
+                                       {"auto-split", no_argument, 0, 0},
+                                       {"levels", required_argument, 0, 0},
+                                       {"fragment-cache", required_argument, 0, 0},
                                        {"iterative", no_argument, 0, 'i'},
                                        {"merge-flag", no_argument, 0, 'm'},
                                        {0, 0, 0, 0}};
 
-static char const * const options = (char *)"a:C:hl:o:s:P:E:m:i";
+static char const * const options = (char *)"a:c:C:hl:o:s:P:E:mi";
 
 /*!
   \brief Display usage
@@ -58,25 +157,232 @@ void usage(char * progname)
   std::cerr << "   -a algorithm  reachability algorithm" << std::endl;
   std::cerr << "          reach      standard reachability algorithm over the zone graph" << std::endl;
   std::cerr << "          compos   compositional reachability algorithm over the history aware zone graph" << std::endl;
-  std::cerr << "   -C type       type of certificate (only for reach at the moment)" << std::endl;
+  std::cerr << "          covreach   reachability algorithm with covering over the zone graph (see -c)" << std::endl;
+  std::cerr << "          concur19   local-time reachability algorithm with sync-subsumption (CONCUR'19)" << std::endl;
+  std::cerr << "          backward   backward reachability algorithm with covering from the states with searched labels"
+            << std::endl;
+  std::cerr << "                     to an initial state, over the zone graph with zone inclusion" << std::endl;
+  std::cerr << "          bmc        bounded reachability by iterative-deepening depth-first search over the zone graph"
+            << std::endl;
+  std::cerr << "                     (see --depth), only the current run is kept in memory" << std::endl;
+  std::cerr << "          portfolio  reach, covreach and compos (with -P or --auto-split) run concurrently, the first"
+            << std::endl;
+  std::cerr << "                     verdict cancels the other algorithms, and its statistics are output with the"
+            << std::endl;
+  std::cerr << "                     name of the algorithm (without certificate)" << std::endl;
+  std::cerr << "   -c cover      cover relation of covreach:" << std::endl;
+  std::cerr << "          inclusion  zone inclusion, zones are extrapolated w.r.t. local LU bounds (default)" << std::endl;
+  std::cerr << "          aLUg       inclusion in aLU abstraction w.r.t. global clock bounds, zones are exact" << std::endl;
+  std::cerr << "          aLUl       inclusion in aLU abstraction w.r.t. local clock bounds, zones are exact" << std::endl;
+  std::cerr << "          aMg        inclusion in aM abstraction w.r.t. global clock bounds, zones are exact" << std::endl;
+  std::cerr << "          aMl        inclusion in aM abstraction w.r.t. local clock bounds, zones are exact" << std::endl;
+  std::cerr << "   --cover-stats  output the numbers of cover checks and of comparisons of zone summaries (covreach,"
+            << std::endl;
+  std::cerr << "                  concur19, backward)" << std::endl;
+  std::cerr << "   -C type       type of certificate (compos: counter-examples are runs of the merged system)" << std::endl;
   std::cerr << "          none       no certificate (default)" << std::endl;
   std::cerr << "          graph      graph of explored state-space" << std::endl;
   std::cerr << "          symbolic   symbolic run to a state with searched labels if any" << std::endl;
   std::cerr << "          concrete   concrete run to a state with searched labels if any"
             << std::endl;
+  std::cerr << "   -E env_file   environment of the system (compos)" << std::endl;
+  std::cerr << "   --auto-split  compos splits the system into a property, with the processes of the labels, and an"
+            << std::endl;
+  std::cerr << "                 environment with the smallest interface, instead of -P and -E" << std::endl;
+  std::cerr << "   --levels n    compos decomposes the merged system of a level again, up to n levels: the fragment"
+            << std::endl;
+  std::cerr << "                 and a part of its environment are the property of the next level, and the other"
+            << std::endl;
+  std::cerr << "                 processes its environment (default: 1, without --pipeline)" << std::endl;
+  std::cerr << "   --fragment-cache dir  compos stores the pruned property graph in dir, by content of the property,"
+            << std::endl;
+  std::cerr << "                 the environment and the variables of the system, and only checks the system when"
+            << std::endl;
+  std::cerr << "                 they have not changed (without -i, --pipeline and graph certificate)" << std::endl;
   std::cerr << "   -h            help" << std::endl;
+  std::cerr << "   -i, --iterative  compos checks the property graph after the first final node, then after"
+            << std::endl;
+  std::cerr << "                 geometrically more final nodes (see --iteration-growth)" << std::endl;
   std::cerr << "   -l l1,l2,...  comma-separated list of searched labels" << std::endl;
+  std::cerr << "   -m, --merge-flag  compos merges the nodes of a fragment with same locations, integer variables and"
+            << std::endl;
+  std::cerr << "                 reset history when the union of their zones is a zone" << std::endl;
   std::cerr << "   -o out_file   output file for certificate (default is standard output)" << std::endl;
-  std::cerr << "   -s bfs|dfs    search order" << std::endl;
+  std::cerr << "   -P f1,f2,...  comma-separated list of property files (compos), or @m for the property files listed in"
+            << std::endl;
+  std::cerr << "                 file m (one per line). The statistics of each property are output with its name"
+            << std::endl;
+  std::cerr << "                 when there are several properties" << std::endl;
+  std::cerr << "   -s order      search order:" << std::endl;
+  std::cerr << "          bfs        breadth-first search (default)" << std::endl;
+  std::cerr << "          dfs        depth-first search" << std::endl;
+  std::cerr << "          dist       states closest to the searched labels in the location graphs first" << std::endl;
+  std::cerr << "          random     random order (reproducible)" << std::endl;
+  std::cerr << "          reset      states with most reset variables first (compositional exploration only)"
+            << std::endl;
+  std::cerr << "   --lexical-graph  output the nodes and edges of graph certificates, and the locations and edges of"
+            << std::endl;
+  std::cerr << "                    the merged systems of compos, in lexical order (deterministic but slower, default:"
+            << std::endl;
+  std::cerr << "                    order of exploration)" << std::endl;
+  std::cerr << "   --format f    format of graph certificates: dot (default) or bin (binary, reach only, see"
+            << std::endl;
+  std::cerr << "                 tck-certificate)" << std::endl;
   std::cerr << "   --block-size  size of allocation blocks" << std::endl;
   std::cerr << "   --table-size  size of hash tables" << std::endl;
+  std::cerr << "   --adaptive-sizes  allocation blocks and hash tables grow geometrically from --block-size and"
+            << std::endl;
+  std::cerr << "                 --table-size (reach reports their occupancy as OCCUPANCY_* statistics)" << std::endl;
+  std::cerr << "   --profile-model f  write to file f the edges and locations of the model ranked by computed successors"
+            << std::endl;
+  std::cerr << "                 and expanded states, with their empty zones and duplicates (reach)" << std::endl;
+  std::cerr << "   --zone-stats f  write to file f histograms of the bounds, unbounded entries and largest constants"
+            << std::endl;
+  std::cerr << "                 of the stored zones, and of the zones per discrete part (reach)" << std::endl;
+  std::cerr << "   --checkpoint-every m  write the graph, waiting states and statistics to the checkpoint file every"
+            << std::endl;
+  std::cerr << "                 m minutes, in binary graph format (reach)" << std::endl;
+  std::cerr << "   --checkpoint-file f   checkpoint file (default: tck-reach.ckpt)" << std::endl;
+  std::cerr << "   --resume f    continue the exploration of checkpoint file f (reach, same model and options)"
+            << std::endl;
+  std::cerr << "   --state-store f  answer the labels from the fully explored zone graph stored in f, which is built"
+            << std::endl;
+  std::cerr << "                 if f is not a store of the model (reach, without certificate)" << std::endl;
+  std::cerr << "   --max-memory n[K|M|G]    stop when memory usage exceeds n bytes (default: no limit)" << std::endl;
+  std::cerr << "   --memory-limit n[K|M|G]  same as --max-memory" << std::endl;
+  std::cerr << "   --max-states n           stop after visiting n states (default: no limit)" << std::endl;
+  std::cerr << "   --timeout s              stop after s seconds (default: no limit)" << std::endl;
+  std::cerr << "                            the verdict is unknown when a limit stops the exploration (not with"
+            << std::endl;
+  std::cerr << "                            --partitions)" << std::endl;
+  std::cerr << "   --stats-format f         output statistics as text (default) or json" << std::endl;
+  std::cerr << "   --progress s             report progress every s seconds on standard error (not with --partitions)"
+            << std::endl;
+  std::cerr << "   --progress-file f        report progress to file f instead of standard error" << std::endl;
+  std::cerr << "   --bitstate n[K|M|G]      store visited states as hash values in a table of n bytes (probabilistic,"
+            << std::endl;
+  std::cerr << "                            reach, and final checks of compos, without graph certificate; counter-examples"
+            << std::endl;
+  std::cerr << "                            of reach are replayed from a trace of the explored states)" << std::endl;
+  std::cerr << "   --gc-allocations n       compos collects unused states every n state allocations" << std::endl;
+  std::cerr << "   --gc-interval ms         compos collects unused states every ms milliseconds" << std::endl;
+  std::cerr << "   --threads n   number of threads computing successors with bfs (default: 1)" << std::endl;
+  std::cerr << "   --pin         pin the threads of parallel explorations to processors, which keeps the memory of"
+            << std::endl;
+  std::cerr << "                 each thread on its socket" << std::endl;
+  std::cerr << "   --partitions n  partition the states of reach among n explorers that share no memory (reach"
+            << std::endl;
+  std::cerr << "                   without certificate, default: 0, no partitioning)" << std::endl;
+  std::cerr << "   --swarm n     n depth-first searches of reach in parallel, with diversified orders of successors"
+            << std::endl;
+  std::cerr << "                 and their own bitstate tables (probabilistic, reach without certificate, table size"
+            << std::endl;
+  std::cerr << "                 set by --bitstate, default: 16M)" << std::endl;
+  std::cerr << "   --intval-mdd  store the valuations of bounded integer variables of the visited states with same"
+            << std::endl;
+  std::cerr << "                 locations and zone as a decision diagram (reach without certificate)" << std::endl;
+  std::cerr << "   --federation  store the zones of the visited states with same locations and integer valuation as"
+            << std::endl;
+  std::cerr << "                 a union of zones (reach without certificate)" << std::endl;
+  std::cerr << "   --zone-storage f  store the zones of the visited and waiting states of reach in format f, and"
+            << std::endl;
+  std::cerr << "                     restore them when the states are explored or compared (reach without"
+            << std::endl;
+  std::cerr << "                     certificate, -C is not supported: stored states are not restored along"
+            << std::endl;
+  std::cerr << "                     counterexamples). f is one of: full (default, DBMs), reduced (minimal"
+            << std::endl;
+  std::cerr << "                     constraint sets), delta (differences with reference zones of the same"
+            << std::endl;
+  std::cerr << "                     locations, or DBMs), packed (DBMs with bounds as narrow as the clock bounds"
+            << std::endl;
+  std::cerr << "                     allow), cold (zones and integer valuations of expanded states as"
+            << std::endl;
+  std::cerr << "                     variable-length integers, waiting states are kept whole), compact (DBMs over the"
+            << std::endl;
+  std::cerr << "                     active clocks, implies --active-clocks). States are compared for equality only"
+            << std::endl;
+  std::cerr << "                     (no covering). Cannot be combined with -C, --state-store, --bitstate,"
+            << std::endl;
+  std::cerr << "                     --partitions, --swarm, --intval-mdd, --federation, --lazy, --profile-model,"
+            << std::endl;
+  std::cerr << "                     --zone-stats, --checkpoint-every, --resume, --on-the-fly, nor with -s bfs"
+            << std::endl;
+  std::cerr << "                     on more than one thread (--threads)" << std::endl;
+  std::cerr << "   --packed-intvals  store the valuations of bounded integer variables of the visited and waiting"
+            << std::endl;
+  std::cerr << "                     states of reach bit-packed (with --zone-storage, except cold)" << std::endl;
+  std::cerr << "   --lazy        lazy abstraction: exact zones, covered w.r.t. clock bounds that are discovered along"
+            << std::endl;
+  std::cerr << "                 the exploration (reach without certificate, no diagonal constraints)" << std::endl;
+  std::cerr << "   --covering    zone subsumption in the forward exploration of compos" << std::endl;
+  std::cerr << "   --minimize    compos merges the bisimilar locations of the merged system (same invariants, and edges"
+            << std::endl;
+  std::cerr << "                 with same events, guards and statements to bisimilar locations)" << std::endl;
+  std::cerr << "   --reduce-clocks  compos removes the clocks of the merged system that are only reset, and their resets"
+            << std::endl;
+  std::cerr << "   --pipeline    compos checks each new fragment of the property graph while exploring the next one"
+            << std::endl;
+  std::cerr << "   --bidirectional  compos checks search forward from the initial states and backward from the labels"
+            << std::endl;
+  std::cerr << "                    in alternation (without bitstate)" << std::endl;
+  std::cerr << "   --por         partial-order reduction of independent asynchronous edges (reach, and final checks"
+            << std::endl;
+  std::cerr << "                 of compos)" << std::endl;
+  std::cerr << "   --symmetry    symmetry reduction of identical processes (reach without certificate)" << std::endl;
+  std::cerr << "   --slice       remove the processes, variables and resets that cannot influence the labels (reach)"
+            << std::endl;
+  std::cerr << "   --prune       remove the edges that are never enabled by the bounded integer variables (all" << std::endl;
+  std::cerr << "                 algorithms but compos)" << std::endl;
+  std::cerr << "   --active-clocks  free the clocks that are reset before being read in the zones (reach)" << std::endl;
+  std::cerr << "   --on-the-fly  stop at the first accepting successor, computed lazily edge by edge (reach without"
+            << std::endl;
+  std::cerr << "                 bitstate, and without several threads with bfs)" << std::endl;
+  std::cerr << "   --ha-extrapolation e     zone extrapolation of the history-aware exploration of compos (default:"
+            << std::endl;
+  std::cerr << "                            m-global)" << std::endl;
+  std::cerr << "   --check-extrapolation e  zone extrapolation of the compositional checks of compos (default: m-global)"
+            << std::endl;
+  std::cerr << "          none, lu-global, lu-local, lu+global, lu+local, m-global, m-local, m+global, m+local"
+            << std::endl;
+  std::cerr << "   --check-engine e  engine of the compositional checks of compos (default: reach)" << std::endl;
+  std::cerr << "          reach     reachability over the product of the system and the merged system (see -j, --bitstate,"
+            << std::endl;
+  std::cerr << "                    --bidirectional, --por and --check-extrapolation)" << std::endl;
+  std::cerr << "          covreach  sequential covering reachability over the merged system (see -c)" << std::endl;
+  std::cerr << "   --emit-cpp f  write the guards, invariants and statements of the model as C++ code to file f, and exit"
+            << std::endl;
+  std::cerr << "   --native l    use the native code in shared library l (built from the output of --emit-cpp)"
+            << std::endl;
+  std::cerr << "   --jit         compile the output of --emit-cpp and use it as with --native (the bytecode is"
+            << std::endl;
+  std::cerr << "                 interpreted if it cannot be compiled)" << std::endl;
+  std::cerr << "   --iteration-growth g  factor of the number of final nodes found between two checks of -i (default: 2,"
+            << std::endl;
+  std::cerr << "                 0: complete exploration after the first check)" << std::endl;
+  std::cerr << "   --jobs n      number of properties of -P checked concurrently by compos (default: 1)" << std::endl;
+  std::cerr << "   --depth k     maximal number of transitions of the runs searched by bmc (required by bmc)" << std::endl;
+  std::cerr << "   --bmc-cache n  cache of n visited states in bmc, that are not explored again at a smaller"
+            << std::endl;
+  std::cerr << "                  remaining depth (default: 0, no cache)" << std::endl;
+  std::cerr << "   --server s    serve queries on Unix socket s: each connection sends one line of options and files,"
+            << std::endl;
+  std::cerr << "                 and receives the output of tck-reach on them. Models are kept in memory until their"
+            << std::endl;
+  std::cerr << "                 content changes (other options given with --server are defaults for the queries)"
+            << std::endl;
   std::cerr << "reads from standard input if file is not provided" << std::endl;
 }
 
 enum algorithm_t {
-  ALGO_REACH,    /*!< Reachability algorithm */
-  ALGO_COMPOS,   /*!< Compositional algorithm */
-  ALGO_NONE,     /*!< No algorithm */
+  ALGO_REACH,     /*!< Reachability algorithm */
+  ALGO_COMPOS,    /*!< Compositional algorithm */
+  ALGO_BMC,       /*!< Bounded reachability algorithm */
+  ALGO_COVREACH,  /*!< Covering reachability algorithm */
+  ALGO_CONCUR19,  /*!< Local-time reachability algorithm */
+  ALGO_BACKWARD,  /*!< Backward reachability algorithm */
+  ALGO_PORTFOLIO, /*!< Concurrent reach, covreach and compos algorithms */
+  ALGO_NONE,      /*!< No algorithm */
 };
 
 enum certificate_t {
@@ -86,20 +392,226 @@ enum certificate_t {
   CERTIFICATE_NONE,     /*!< No certificate */
 };
 
+enum check_engine_t {
+  CHECK_ENGINE_REACH,    /*!< Reachability over the product of the system and the merged system */
+  CHECK_ENGINE_COVREACH, /*!< Covering reachability over the merged system */
+};
+
 static enum algorithm_t algorithm = ALGO_NONE;            /*!< Selected algorithm */
 static bool help = false;                                 /*!< Help flag */
 static enum certificate_t certificate = CERTIFICATE_NONE; /*!< Type of certificate */
 static std::string search_order = "bfs";                  /*!< Search order */
+static bool lexical_graph = false;                        /*!< Graph certificates and merged systems in lexical order */
+static bool binary_graph = false;                         /*!< Graph certificates in binary format */
 static std::string labels = "";                           /*!< Searched labels */
 static std::string output_file = "";                      /*!< Output file name (empty means standard output) */
 static std::ostream * os = &std::cout;                    /*!< Default output stream */
 static std::size_t block_size = 10000;                    /*!< Size of allocated blocks */
 static std::size_t table_size = 65536;                    /*!< Size of hash tables */
+static std::size_t memory_limit = 0;                      /*!< Memory budget in bytes (0: no limit) */
+static unsigned long max_states = 0;                      /*!< Budget of visited states (0: no limit) */
+static unsigned long timeout = 0;                         /*!< Time budget in seconds (0: no limit) */
+/*! Output format of statistics */
+static enum tchecker::algorithms::stats_format_t stats_format = tchecker::algorithms::STATS_FORMAT_TEXT;
+static unsigned long progress_period = 0;                 /*!< Seconds between progress reports (0: none) */
+static std::string progress_file = "";                    /*!< Progress report file (empty: standard error) */
+static std::size_t bitstate_size = 0;                     /*!< Size of bitstate table in bytes (0: exact) */
+static std::size_t gc_allocations = 0;                    /*!< Allocations between collections (0: none) */
+static std::size_t gc_interval = 0;                       /*!< Milliseconds between collections (0: none) */
+static std::size_t threads = 1;                           /*!< Number of exploration threads */
+static std::string profile_file = "";                     /*!< Model profile report file (empty: no profiling) */
+static std::string zone_stats_file = "";                  /*!< Zone statistics report file (empty: none) */
+static unsigned long checkpoint_period = 0;               /*!< Minutes between checkpoints (0: none) */
+static std::string checkpoint_file = "tck-reach.ckpt";    /*!< Checkpoint file */
+static std::string resume_file = "";                      /*!< Checkpoint file to resume from (empty: none) */
+static std::string state_store = "";                      /*!< State store file of reach (empty: none) */
+static std::size_t partitions = 0;                        /*!< Number of partitions of reach (0: none) */
+static std::size_t swarm = 0;                             /*!< Number of swarm searches of reach (0: none) */
+static bool intval_mdd = false;                           /*!< Visited intvals of reach as decision diagrams */
+static bool federation = false;                           /*!< Visited zones of reach as federations */
+/*! Storage format of the zones of reach */
+static enum tchecker::tck_reach::zg_reach::zone_storage_t zone_storage = tchecker::tck_reach::zg_reach::ZONE_STORAGE_FULL;
+static bool packed_intvals = false;                       /*!< Bit-packed valuations of the stored zones of reach */
+static bool lazy = false;                                 /*!< Lazy abstraction of clock bounds in reach */
+static bool covering = false;                             /*!< Covering in the history-aware exploration */
+/*! Cover relation of covreach */
+static enum tchecker::tck_reach::zg_covreach::cover_t cover = tchecker::tck_reach::zg_covreach::COVER_INCLUSION;
+static bool cover_stats = false;                          /*!< Statistics on cover checks of covreach, concur19 and backward */
+static bool minimize = false;                             /*!< Minimization of the merged systems of compos */
+static bool reduce_clocks = false;                        /*!< Removal of the inactive clocks of the merged systems */
+static bool pipeline = false;                             /*!< Pipelined compositional algorithm */
+static bool bidirectional = false;                        /*!< Bidirectional compositional checks */
+static bool por = false;                                  /*!< Partial-order reduction */
+static bool symmetry = false;                             /*!< Symmetry reduction */
+static bool slice = false;                                /*!< Cone-of-influence reduction */
+static bool prune = false;                                /*!< Removal of dead edges */
+static bool active_clocks = false;                        /*!< Active-clock reduction */
+static bool on_the_fly = false;                           /*!< Detection of accepting nodes on the fly */
+/*! Extrapolation of the history-aware exploration */
+static enum tchecker::zg_ha::extrapolation_type_t ha_extrapolation = tchecker::zg_ha::EXTRA_M_GLOBAL;
+/*! Extrapolation of the compositional checks */
+static enum tchecker::zg_compos::extrapolation_type_t check_extrapolation = tchecker::zg_compos::EXTRA_M_GLOBAL;
+static enum check_engine_t check_engine = CHECK_ENGINE_REACH; /*!< Engine of the compositional checks */
+static std::string emit_cpp_file = "";                    /*!< Output file of native code (empty: none) */
+static std::vector<std::string> native_libraries;         /*!< Shared libraries of native code */
+static bool jit = false;                                  /*!< Compilation of the model to native code at startup */
+static std::string server_socket = "";                    /*!< Socket of the verification server (empty: none) */
+static std::size_t jobs = 1;                              /*!< Number of properties checked concurrently */
 static std::string property_file = "";
 static std::string env_file = "";
+static bool auto_split = false; /*!< Decomposition of the system into a property and an environment by compos */
+static std::size_t compos_levels = 1;   /*!< Maximal number of levels of decomposition of compos */
+static std::string fragment_cache = ""; /*!< Directory of the property graphs of compos (empty: none) */
 static bool early_enabled = false;
+static unsigned long iteration_growth = 2; /*!< Growth factor of the number of final nodes between checks of -i */
+static std::size_t depth = 0;              /*!< Depth bound of bmc (0: not set) */
+static std::size_t bmc_cache = 0;          /*!< Entries of the cache of visited states of bmc (0: none) */
 static bool merge_flag = false;
 
+/*!
+ \brief Parse an unsigned integer
+ \param s : a string
+ \param what : description of the value in error messages
+ \return the unsigned decimal integer in s
+ \throw std::invalid_argument : if s is not an unsigned decimal integer, or if it is out of range
+ */
+static unsigned long parse_unsigned(char const * s, std::string const & what)
+{
+  // strtoul accepts signs and leading spaces, and wraps negative values around
+  if (!std::isdigit(static_cast<unsigned char>(*s)))
+    throw std::invalid_argument("Invalid " + what + ": " + std::string{s});
+  char * end = nullptr;
+  errno = 0;
+  unsigned long const value = std::strtoul(s, &end, 10);
+  if (*end != '\0' || errno == ERANGE)
+    throw std::invalid_argument("Invalid " + what + ": " + std::string{s});
+  return value;
+}
+
+/*!
+ \brief Parse a memory size
+ \param s : a string
+ \return the number of bytes in s, an integer optionally followed by K, M or G (powers of 1024)
+ \throw std::invalid_argument : if s is not a valid memory size
+ */
+static std::size_t parse_memory_size(char const * s)
+{
+  char * end = nullptr;
+  std::size_t size = std::strtoull(s, &end, 10);
+  if (end == s)
+    throw std::invalid_argument("Invalid memory size: " + std::string{s});
+  switch (*end) {
+  case '\0':
+    return size;
+  case 'K':
+  case 'k':
+    size <<= 10;
+    break;
+  case 'M':
+  case 'm':
+    size <<= 20;
+    break;
+  case 'G':
+  case 'g':
+    size <<= 30;
+    break;
+  default:
+    throw std::invalid_argument("Invalid memory size: " + std::string{s});
+  }
+  if (*(end + 1) != '\0')
+    throw std::invalid_argument("Invalid memory size: " + std::string{s});
+  return size;
+}
+
+/*!
+ \brief Parse a format of statistics
+ \param s : a string
+ \return the format of statistics named s (text or json)
+ \throw std::invalid_argument : if s is not a format of statistics
+ */
+static enum tchecker::algorithms::stats_format_t parse_stats_format(char const * s)
+{
+  if (strcmp(s, "text") == 0)
+    return tchecker::algorithms::STATS_FORMAT_TEXT;
+  if (strcmp(s, "json") == 0)
+    return tchecker::algorithms::STATS_FORMAT_JSON;
+  throw std::invalid_argument("Unknown format of statistics: " + std::string{s});
+}
+
+/*!
+ \brief Progress heartbeat from the command line
+ \return the progress heartbeat set by the command-line options, nullptr if progress is not reported
+ */
+static std::shared_ptr<tchecker::algorithms::progress_t> progress()
+{
+  if (progress_period == 0)
+    return nullptr;
+  static std::shared_ptr<tchecker::algorithms::progress_t> const p{new tchecker::algorithms::progress_t{
+      progress_file, std::chrono::milliseconds{progress_period * 1000}, stats_format}};
+  return p;
+}
+
+/*!
+ \brief Budget of the algorithm of the portfolio that runs on this thread (nullptr: budget from the command line)
+ */
+static thread_local tchecker::algorithms::budget_t const * runner_budget = nullptr;
+
+/*!
+ \brief Budget from the command line
+ \return the budget of visited states, running time and memory set by the command-line options, with the progress
+ heartbeat, or the budget of the algorithm of the portfolio on this thread if any (see runner_budget)
+ \note the running time is counted from the first call, at the start of the verification
+ */
+static tchecker::algorithms::budget_t const & budget()
+{
+  if (runner_budget != nullptr)
+    return *runner_budget;
+  static tchecker::algorithms::budget_t const b{max_states, std::chrono::milliseconds{timeout * 1000}, memory_limit,
+                                                progress()};
+  return b;
+}
+
+/*!
+ \brief Edges of the reachability graphs of reach
+ \return the edges needed by the certificate set on the command line: all edges for a graph, the tree of first
+ discoveries for a counter example (which is a path in this tree), and no edge otherwise
+ */
+static enum tchecker::algorithms::reach::edges_t reach_edges()
+{
+  if (certificate == CERTIFICATE_GRAPH)
+    return tchecker::algorithms::reach::EDGES_ALL;
+  if (certificate == CERTIFICATE_SYMBOLIC || certificate == CERTIFICATE_CONCRETE)
+    return tchecker::algorithms::reach::EDGES_PARENT;
+  return tchecker::algorithms::reach::EDGES_NONE;
+}
+
+/*!
+ \brief Extrapolations by name
+ \param NS : namespace of the extrapolation types
+ */
+#define EXTRAPOLATION_NAMES(NS)                                                                                                  \
+  {                                                                                                                              \
+    {"none", NS::NO_EXTRAPOLATION}, {"lu-global", NS::EXTRA_LU_GLOBAL}, {"lu-local", NS::EXTRA_LU_LOCAL},                      \
+        {"lu+global", NS::EXTRA_LU_PLUS_GLOBAL}, {"lu+local", NS::EXTRA_LU_PLUS_LOCAL}, {"m-global", NS::EXTRA_M_GLOBAL},      \
+        {"m-local", NS::EXTRA_M_LOCAL}, {"m+global", NS::EXTRA_M_PLUS_GLOBAL}, {"m+local", NS::EXTRA_M_PLUS_LOCAL}             \
+  }
+
+/*!
+ \brief Parse an extrapolation
+ \param names : map from names to extrapolation types
+ \param s : a string
+ \return the extrapolation type named s in names
+ \throw std::invalid_argument : if s is not a name in names
+ */
+template <class EXTRAPOLATION_TYPE>
+static EXTRAPOLATION_TYPE parse_extrapolation(std::map<std::string, EXTRAPOLATION_TYPE> const & names, char const * s)
+{
+  auto it = names.find(s);
+  if (it == names.end())
+    throw std::invalid_argument("Unknown extrapolation: " + std::string{s});
+  return it->second;
+}
+
 /*!
  \brief Parse command-line arguments
  \param argc : number of arguments
@@ -140,9 +652,33 @@ int parse_command_line(int argc, char * argv[])
           algorithm = ALGO_REACH;
         else if (strcmp(optarg, "compos") == 0)
           algorithm = ALGO_COMPOS;
+        else if (strcmp(optarg, "bmc") == 0)
+          algorithm = ALGO_BMC;
+        else if (strcmp(optarg, "covreach") == 0)
+          algorithm = ALGO_COVREACH;
+        else if (strcmp(optarg, "concur19") == 0)
+          algorithm = ALGO_CONCUR19;
+        else if (strcmp(optarg, "backward") == 0)
+          algorithm = ALGO_BACKWARD;
+        else if (strcmp(optarg, "portfolio") == 0)
+          algorithm = ALGO_PORTFOLIO;
         else
           throw std::runtime_error("Unknown algorithm: " + std::string(optarg));
         break;
+      case 'c':
+        if (strcmp(optarg, "inclusion") == 0)
+          cover = tchecker::tck_reach::zg_covreach::COVER_INCLUSION;
+        else if (strcmp(optarg, "aLUg") == 0)
+          cover = tchecker::tck_reach::zg_covreach::COVER_ALU_GLOBAL;
+        else if (strcmp(optarg, "aLUl") == 0)
+          cover = tchecker::tck_reach::zg_covreach::COVER_ALU_LOCAL;
+        else if (strcmp(optarg, "aMg") == 0)
+          cover = tchecker::tck_reach::zg_covreach::COVER_AM_GLOBAL;
+        else if (strcmp(optarg, "aMl") == 0)
+          cover = tchecker::tck_reach::zg_covreach::COVER_AM_LOCAL;
+        else
+          throw std::runtime_error("Unknown cover relation: " + std::string(optarg));
+        break;
       case 'C':
         if (strcmp(optarg, "none") == 0)
           certificate = CERTIFICATE_NONE;
@@ -177,6 +713,168 @@ int parse_command_line(int argc, char * argv[])
         block_size = std::strtoull(optarg, nullptr, 10);
       else if (strcmp(long_options[long_option_index].name, "table-size") == 0)
         table_size = std::strtoull(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "adaptive-sizes") == 0)
+        tchecker::set_adaptive_sizes(true);
+      else if (strcmp(long_options[long_option_index].name, "profile-model") == 0)
+        profile_file = optarg;
+      else if (strcmp(long_options[long_option_index].name, "zone-stats") == 0)
+        zone_stats_file = optarg;
+      else if (strcmp(long_options[long_option_index].name, "checkpoint-every") == 0)
+        checkpoint_period = std::strtoul(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "checkpoint-file") == 0)
+        checkpoint_file = optarg;
+      else if (strcmp(long_options[long_option_index].name, "resume") == 0)
+        resume_file = optarg;
+      else if (strcmp(long_options[long_option_index].name, "state-store") == 0)
+        state_store = optarg;
+      else if (strcmp(long_options[long_option_index].name, "memory-limit") == 0 ||
+               strcmp(long_options[long_option_index].name, "max-memory") == 0)
+        memory_limit = parse_memory_size(optarg);
+      else if (strcmp(long_options[long_option_index].name, "max-states") == 0)
+        max_states = std::strtoul(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "timeout") == 0)
+        timeout = std::strtoul(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "stats-format") == 0)
+        stats_format = parse_stats_format(optarg);
+      else if (strcmp(long_options[long_option_index].name, "progress") == 0) {
+        progress_period = std::strtoul(optarg, nullptr, 10);
+        if (progress_period == 0)
+          throw std::invalid_argument("Period of progress reports should be positive");
+      }
+      else if (strcmp(long_options[long_option_index].name, "progress-file") == 0)
+        progress_file = optarg;
+      else if (strcmp(long_options[long_option_index].name, "bitstate") == 0) {
+        bitstate_size = parse_memory_size(optarg);
+        if (bitstate_size == 0)
+          throw std::invalid_argument("Size of bitstate table should be positive");
+      }
+      else if (strcmp(long_options[long_option_index].name, "gc-allocations") == 0)
+        gc_allocations = std::strtoull(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "gc-interval") == 0)
+        gc_interval = std::strtoull(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "threads") == 0) {
+        threads = std::strtoull(optarg, nullptr, 10);
+        if (threads == 0)
+          throw std::invalid_argument("Number of threads should be positive");
+      }
+      else if (strcmp(long_options[long_option_index].name, "pin") == 0)
+        tchecker::set_thread_pinning(true);
+      else if (strcmp(long_options[long_option_index].name, "iteration-growth") == 0)
+        iteration_growth = parse_unsigned(optarg, "iteration growth");
+      else if (strcmp(long_options[long_option_index].name, "depth") == 0) {
+        depth = std::strtoull(optarg, nullptr, 10);
+        if (depth == 0)
+          throw std::invalid_argument("Depth bound should be positive");
+      }
+      else if (strcmp(long_options[long_option_index].name, "bmc-cache") == 0)
+        bmc_cache = std::strtoull(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "jobs") == 0) {
+        jobs = std::strtoull(optarg, nullptr, 10);
+        if (jobs == 0)
+          throw std::invalid_argument("Number of jobs should be positive");
+      }
+      else if (strcmp(long_options[long_option_index].name, "partitions") == 0) {
+        partitions = std::strtoull(optarg, nullptr, 10);
+        if (partitions == 0)
+          throw std::invalid_argument("Number of partitions should be positive");
+      }
+      else if (strcmp(long_options[long_option_index].name, "swarm") == 0) {
+        swarm = std::strtoull(optarg, nullptr, 10);
+        if (swarm == 0)
+          throw std::invalid_argument("Number of searches of the swarm should be positive");
+      }
+      else if (strcmp(long_options[long_option_index].name, "lexical-graph") == 0)
+        lexical_graph = true;
+      else if (strcmp(long_options[long_option_index].name, "format") == 0) {
+        if (strcmp(optarg, "dot") == 0)
+          binary_graph = false;
+        else if (strcmp(optarg, "bin") == 0)
+          binary_graph = true;
+        else
+          throw std::invalid_argument("Unknown format of graph certificates: " + std::string(optarg));
+      }
+      else if (strcmp(long_options[long_option_index].name, "covering") == 0)
+        covering = true;
+      else if (strcmp(long_options[long_option_index].name, "minimize") == 0)
+        minimize = true;
+      else if (strcmp(long_options[long_option_index].name, "reduce-clocks") == 0)
+        reduce_clocks = true;
+      else if (strcmp(long_options[long_option_index].name, "pipeline") == 0)
+        pipeline = true;
+      else if (strcmp(long_options[long_option_index].name, "bidirectional") == 0)
+        bidirectional = true;
+      else if (strcmp(long_options[long_option_index].name, "intval-mdd") == 0)
+        intval_mdd = true;
+      else if (strcmp(long_options[long_option_index].name, "federation") == 0)
+        federation = true;
+      else if (strcmp(long_options[long_option_index].name, "zone-storage") == 0) {
+        if (strcmp(optarg, "full") == 0)
+          zone_storage = tchecker::tck_reach::zg_reach::ZONE_STORAGE_FULL;
+        else if (strcmp(optarg, "reduced") == 0)
+          zone_storage = tchecker::tck_reach::zg_reach::ZONE_STORAGE_REDUCED;
+        else if (strcmp(optarg, "delta") == 0)
+          zone_storage = tchecker::tck_reach::zg_reach::ZONE_STORAGE_DELTA;
+        else if (strcmp(optarg, "packed") == 0)
+          zone_storage = tchecker::tck_reach::zg_reach::ZONE_STORAGE_PACKED;
+        else if (strcmp(optarg, "cold") == 0)
+          zone_storage = tchecker::tck_reach::zg_reach::ZONE_STORAGE_COLD;
+        else if (strcmp(optarg, "compact") == 0)
+          zone_storage = tchecker::tck_reach::zg_reach::ZONE_STORAGE_COMPACT;
+        else
+          throw std::runtime_error("Unknown storage format of zones: " + std::string(optarg));
+      }
+      else if (strcmp(long_options[long_option_index].name, "packed-intvals") == 0)
+        packed_intvals = true;
+      else if (strcmp(long_options[long_option_index].name, "lazy") == 0)
+        lazy = true;
+      else if (strcmp(long_options[long_option_index].name, "por") == 0)
+        por = true;
+      else if (strcmp(long_options[long_option_index].name, "symmetry") == 0)
+        symmetry = true;
+      else if (strcmp(long_options[long_option_index].name, "slice") == 0)
+        slice = true;
+      else if (strcmp(long_options[long_option_index].name, "prune") == 0)
+        prune = true;
+      else if (strcmp(long_options[long_option_index].name, "auto-split") == 0)
+        auto_split = true;
+      else if (strcmp(long_options[long_option_index].name, "levels") == 0) {
+        compos_levels = std::strtoull(optarg, nullptr, 10);
+        if (compos_levels == 0)
+          throw std::invalid_argument("Number of levels should be positive");
+      }
+      else if (strcmp(long_options[long_option_index].name, "fragment-cache") == 0) {
+        if (strlen(optarg) == 0)
+          throw std::invalid_argument("Invalid empty fragment cache directory name");
+        fragment_cache = optarg;
+      }
+      else if (strcmp(long_options[long_option_index].name, "cover-stats") == 0)
+        cover_stats = true;
+      else if (strcmp(long_options[long_option_index].name, "active-clocks") == 0)
+        active_clocks = true;
+      else if (strcmp(long_options[long_option_index].name, "on-the-fly") == 0)
+        on_the_fly = true;
+      else if (strcmp(long_options[long_option_index].name, "ha-extrapolation") == 0)
+        ha_extrapolation =
+            parse_extrapolation<enum tchecker::zg_ha::extrapolation_type_t>(EXTRAPOLATION_NAMES(tchecker::zg_ha), optarg);
+      else if (strcmp(long_options[long_option_index].name, "check-extrapolation") == 0)
+        check_extrapolation =
+            parse_extrapolation<enum tchecker::zg_compos::extrapolation_type_t>(EXTRAPOLATION_NAMES(tchecker::zg_compos), optarg);
+      else if (strcmp(long_options[long_option_index].name, "check-engine") == 0) {
+        if (strcmp(optarg, "reach") == 0)
+          check_engine = CHECK_ENGINE_REACH;
+        else if (strcmp(optarg, "covreach") == 0)
+          check_engine = CHECK_ENGINE_COVREACH;
+        else
+          throw std::invalid_argument("Unknown engine of compositional checks: " + std::string(optarg));
+      }
+      else if (strcmp(long_options[long_option_index].name, "emit-cpp") == 0)
+        emit_cpp_file = optarg;
+      else if (strcmp(long_options[long_option_index].name, "native") == 0)
+        native_libraries.push_back(optarg);
+      else if (strcmp(long_options[long_option_index].name, "jit") == 0)
+        jit = true;
+      else if (strcmp(long_options[long_option_index].name, "server") == 0)
+        server_socket = optarg;
       else
         throw std::runtime_error("This also should never be executed");
     }
@@ -206,6 +904,233 @@ tchecker::parsing::system_declaration_t * load_system_declaration(std::string co
   return sysdecl;
 }
 
+/*!
+ \brief Declarations kept in memory by the verification server, by file name (see serve)
+ */
+static std::map<std::string, std::shared_ptr<tchecker::parsing::system_declaration_t>> resident_declarations;
+
+/*!
+ \brief Clock bounds of systems, computed once for all the compositional checks, and kept in memory by the
+ verification server
+ */
+static std::shared_ptr<tchecker::clockbounds::cache_t> clock_bounds_cache{new tchecker::clockbounds::cache_t};
+
+/*!
+ \brief Access a system declaration
+ \param filename : file name
+ \return the declaration of filename kept in memory if any, the system declaration loaded from filename otherwise
+ (nullptr in case of errors)
+ \post all errors have been reported to std::cerr
+ */
+std::shared_ptr<tchecker::parsing::system_declaration_t> system_declaration(std::string const & filename)
+{
+  auto it = resident_declarations.find(filename);
+  if (it != resident_declarations.end())
+    return it->second;
+  return std::shared_ptr<tchecker::parsing::system_declaration_t>{load_system_declaration(filename)};
+}
+
+/*!
+ \brief Property files
+ \param spec : value of option -P
+ \return the comma-separated list of files in spec, or the files listed in file m (one per line, blank lines and
+ lines starting with '#' are ignored) if spec is @m
+ \throw std::runtime_error : if file m cannot be read
+ */
+static std::vector<std::string> property_files(std::string const & spec)
+{
+  std::vector<std::string> files;
+  if (!spec.empty() && spec[0] == '@') {
+    std::ifstream manifest{spec.substr(1)};
+    if (!manifest)
+      throw std::runtime_error("Cannot read file " + spec.substr(1));
+    std::string line;
+    while (std::getline(manifest, line)) {
+      std::size_t const begin = line.find_first_not_of(" \t\r");
+      if (begin == std::string::npos || line[begin] == '#')
+        continue;
+      std::size_t const end = line.find_last_not_of(" \t\r");
+      files.push_back(line.substr(begin, end - begin + 1));
+    }
+    return files;
+  }
+
+  std::size_t begin = 0;
+  while (true) {
+    std::size_t const end = spec.find(',', begin);
+    files.push_back(spec.substr(begin, end == std::string::npos ? std::string::npos : end - begin));
+    if (end == std::string::npos)
+      break;
+    begin = end + 1;
+  }
+  return files;
+}
+
+/*!
+ \brief Output native code
+ \param sysdecl : system declaration
+ \param filename : output file name
+ \post a C++ translation unit with the bytecode of the guards, invariants and statements of the system declared by
+ sysdecl that depend on bounded integer variables has been written to filename (see tchecker::native::emit_cpp)
+ \throw std::runtime_error : if filename cannot be written
+ */
+void emit_cpp(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & filename)
+{
+  tchecker::ta::system_t system{*sysdecl};
+
+  std::vector<tchecker::bytecode_t const *> bytecodes;
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
+    if (system.static_invariant(loc->id()) == nullptr)
+      bytecodes.push_back(system.invariant_bytecode(loc->id()));
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+    if (system.static_guard(edge->id()) == nullptr)
+      bytecodes.push_back(system.guard_bytecode(edge->id()));
+    if (system.static_statement(edge->id()) == nullptr)
+      bytecodes.push_back(system.statement_bytecode(edge->id()));
+  }
+
+  std::ofstream ofs{filename};
+  if (!ofs)
+    throw std::runtime_error("Cannot write file " + filename);
+  tchecker::native::emit_cpp(ofs, bytecodes, sysdecl->name());
+}
+
+/*!
+ \brief Load native code
+ \param filename : shared library built from the output of emit_cpp
+ \post filename has been loaded, and its functions have been registered. They are used by the systems built from
+ now on
+ \throw std::runtime_error : if filename cannot be loaded
+ \note the library is never unloaded
+ */
+void load_native(std::string const & filename)
+{
+  if (dlopen(filename.c_str(), RTLD_NOW | RTLD_GLOBAL) == nullptr)
+    throw std::runtime_error("Cannot load native code: " + std::string{dlerror()});
+}
+
+/*!
+ \brief Compile and load native code
+ \param sysdecl : system declaration
+ \return true if native code for sysdecl has been compiled and loaded, false otherwise
+ \post if true is returned, the native code of sysdecl (see emit_cpp) has been built as a shared library in a
+ temporary directory, and loaded (see load_native). Otherwise, a warning has been reported, and the bytecode of
+ sysdecl is interpreted
+ \note the native code is built by TCHECKER_JIT_COMMAND, the compiler and the include directories of the build of
+ tck-reach (see CMake option TCHECKER_JIT). The temporary directory is removed once the library is loaded
+ \note the merged systems of compos have their own bytecode, they only use native code for the bytecode that is
+ identical to the bytecode of sysdecl
+ */
+static bool jit_compile(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
+{
+#ifndef TCHECKER_JIT_COMMAND
+  std::cerr << tchecker::log_warning << "tck-reach is built without TCHECKER_JIT, bytecode is interpreted" << std::endl;
+  return false;
+#else
+  std::error_code ec;
+  std::filesystem::path const dir =
+      std::filesystem::temp_directory_path(ec) / ("tck-reach-jit-" + std::to_string(::getpid()));
+  std::string const source = (dir / "model.cc").string();
+  std::string const library = (dir / "model.so").string();
+  std::string const log = (dir / "compile.log").string();
+  bool loaded = false;
+  try {
+    std::filesystem::create_directories(dir);
+    emit_cpp(sysdecl, source);
+    std::string const command =
+        std::string{TCHECKER_JIT_COMMAND} + " -o '" + library + "' '" + source + "' > '" + log + "' 2>&1";
+    if (std::system(command.c_str()) != 0)
+      throw std::runtime_error("Cannot compile native code (see " + log + ")");
+    load_native(library);
+    loaded = true;
+  }
+  catch (std::exception & e) {
+    std::cerr << tchecker::log_warning << e.what() << ", bytecode is interpreted" << std::endl;
+  }
+  // the compilation log is kept for diagnosis, the loaded library stays mapped once its file is removed
+  if (loaded)
+    std::filesystem::remove_all(dir, ec);
+  return loaded;
+#endif
+}
+
+/*!
+ \brief Maximal number of zones sampled by the zone statistics (see --zone-stats)
+ */
+static std::size_t const ZONE_STATS_SAMPLES = 100000;
+
+/*!
+ \brief Write zone statistics
+ \param graphs : reachability graphs (or graph shards) of the same zone graph
+ \post the statistics of the zones stored in graphs have been written to the zone statistics file, sampling at most
+ about ZONE_STATS_SAMPLES zones (see tchecker::zg::zone_stats_t)
+ \throw std::runtime_error : if the zone statistics file cannot be written
+ */
+static void write_zone_stats(std::vector<std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t>> const & graphs)
+{
+  std::size_t nodes = 0;
+  for (std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t> const & graph : graphs)
+    nodes += graph->nodes_count();
+
+  tchecker::zg::zone_stats_t zone_stats{std::max<std::size_t>(1, nodes / ZONE_STATS_SAMPLES)};
+  for (std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t> const & graph : graphs)
+    for (tchecker::tck_reach::zg_reach::graph_t::node_sptr_t const & n : graph->nodes())
+      zone_stats.add(n->state());
+
+  std::ofstream ofs{zone_stats_file};
+  if (!ofs)
+    throw std::runtime_error("Cannot write file " + zone_stats_file);
+  zone_stats.report(ofs);
+}
+
+/*!
+ \brief Perform reachability analysis from a state store
+ \param sysdecl : system declaration
+ \post statistics on the reachability of command-line specified labels in the system declared by sysdecl have been
+ output to standard output. They have been computed from the state store file if it is a store of sysdecl. Otherwise,
+ the zone graph of sysdecl has been fully explored and written to the state store file first
+ \throw std::invalid_argument : if a certificate is required, or with options that make the explored zone graph depend
+ on the labels or be incomplete
+*/
+void store_reach(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
+{
+  if (certificate != CERTIFICATE_NONE)
+    throw std::invalid_argument("No certificate can be computed from a state store");
+  if (bitstate_size != 0 || partitions != 0 || swarm != 0 || intval_mdd || federation || lazy ||
+      !profile_file.empty() || checkpoint_period != 0 || !resume_file.empty())
+    throw std::invalid_argument("State stores cannot be combined with bitstate, partitioned or swarm exploration, "
+                                "decision diagrams of integer valuations, federations, lazy abstraction, model "
+                                "profiling or checkpoints");
+  if (!budget().unlimited())
+    throw std::invalid_argument("State stores do not support budgets of states, time or memory");
+  // these reductions depend on the labels, whereas the store answers any labels
+  if (por || symmetry || slice)
+    throw std::invalid_argument("State stores do not support partial-order or symmetry reductions, or slicing");
+
+  std::string const hash = tchecker::tck_reach::zg_reach::system_hash(*sysdecl);
+
+  std::map<std::string, std::string> m;
+  if (tchecker::tck_reach::zg_reach::is_store(state_store, hash))
+    m["STATE_STORE"] = "reused";
+  else {
+    auto && [stats, graph] = tchecker::tck_reach::zg_reach::run(sysdecl, "", search_order, block_size, table_size,
+                                                                budget(), 0, false, false, active_clocks, threads);
+    tchecker::tck_reach::zg_reach::write_store(state_store, *graph, hash);
+    stats.attributes(m);
+    m["STATE_STORE"] = "built";
+  }
+
+  auto && [query_stats, stored_states] = tchecker::tck_reach::zg_reach::query_store(state_store, *sysdecl, labels);
+  std::map<std::string, std::string> query_m;
+  query_stats.attributes(query_m);
+  // the exploration statistics are kept when the store has just been built
+  for (auto && [key, value] : query_m)
+    m.emplace(key, value);
+  m["REACHABLE"] = query_m["REACHABLE"];
+  m["STORED_STATES"] = std::to_string(stored_states);
+  tchecker::algorithms::output_attributes(std::cout, m, stats_format);
+}
+
 /*!
  \brief Perform reachability analysis
  \param sysdecl : system declaration
@@ -215,17 +1140,215 @@ tchecker::parsing::system_declaration_t * load_system_declaration(std::string co
 */
 void reach(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
 {
-  auto && [stats, graph] = tchecker::tck_reach::zg_reach::run(sysdecl, labels, search_order, block_size, table_size);
+  if (bitstate_size != 0 && certificate == CERTIFICATE_GRAPH)
+    throw std::invalid_argument("No graph certificate can be computed with bitstate exploration");
+  if (symmetry && certificate != CERTIFICATE_NONE)
+    throw std::invalid_argument("No certificate can be computed with symmetry reduction");
+  if (symmetry && por)
+    throw std::invalid_argument("Symmetry reduction and partial-order reduction cannot be combined");
+  if (partitions != 0 && certificate != CERTIFICATE_NONE)
+    throw std::invalid_argument("No certificate can be computed with partitioned exploration");
+  if (partitions != 0 && bitstate_size != 0)
+    throw std::invalid_argument("Partitioned exploration and bitstate exploration cannot be combined");
+  if (partitions != 0 && !budget().unlimited())
+    throw std::invalid_argument("Partitioned exploration does not support budgets of states, time or memory");
+  if (swarm != 0 && certificate != CERTIFICATE_NONE)
+    throw std::invalid_argument("No certificate can be computed with swarm verification");
+  if (swarm != 0 && partitions != 0)
+    throw std::invalid_argument("Swarm verification and partitioned exploration cannot be combined");
+  if (intval_mdd && certificate != CERTIFICATE_NONE)
+    throw std::invalid_argument("No certificate can be computed with decision diagrams of integer valuations");
+  if (intval_mdd && (bitstate_size != 0 || partitions != 0 || swarm != 0))
+    throw std::invalid_argument("Decision diagrams of integer valuations cannot be combined with bitstate, "
+                                "partitioned or swarm exploration");
+  if (federation && certificate != CERTIFICATE_NONE)
+    throw std::invalid_argument("No certificate can be computed with federations of zones");
+  if (federation && (bitstate_size != 0 || partitions != 0 || swarm != 0 || intval_mdd))
+    throw std::invalid_argument("Federations of zones cannot be combined with bitstate, partitioned or swarm "
+                                "exploration, or decision diagrams of integer valuations");
+  if (lazy && certificate != CERTIFICATE_NONE)
+    throw std::invalid_argument("No certificate can be computed with lazy abstraction");
+  if (lazy && (bitstate_size != 0 || partitions != 0 || swarm != 0 || intval_mdd || federation))
+    throw std::invalid_argument("Lazy abstraction cannot be combined with bitstate, partitioned or swarm exploration, "
+                                "decision diagrams of integer valuations or federations");
+  if (zone_storage != tchecker::tck_reach::zg_reach::ZONE_STORAGE_FULL &&
+      (certificate != CERTIFICATE_NONE || !state_store.empty() || bitstate_size != 0 || partitions != 0 ||
+       swarm != 0 || intval_mdd || federation || lazy || !profile_file.empty() || !zone_stats_file.empty() ||
+       checkpoint_period != 0 || !resume_file.empty() || on_the_fly || (threads > 1 && search_order == "bfs")))
+    throw std::invalid_argument("Stored zones cannot be combined with certificates, state stores, bitstate, "
+                                "partitioned, swarm or parallel exploration, decision diagrams of integer valuations, "
+                                "federations, lazy abstraction, model profiling, zone statistics, checkpoints or "
+                                "on-the-fly detection");
+  if (packed_intvals && (zone_storage == tchecker::tck_reach::zg_reach::ZONE_STORAGE_FULL ||
+                         zone_storage == tchecker::tck_reach::zg_reach::ZONE_STORAGE_COLD))
+    throw std::invalid_argument("Packed valuations of integer variables need a storage format of zones that does not "
+                                "store them (--zone-storage other than full and cold)");
+  if (lazy && (por || symmetry || active_clocks))
+    throw std::invalid_argument("Lazy abstraction does not support partial-order, symmetry or active-clock reductions");
+  if (!profile_file.empty() && (partitions != 0 || swarm != 0 || intval_mdd || federation || lazy ||
+                                (bitstate_size != 0 && certificate != CERTIFICATE_NONE)))
+    throw std::invalid_argument("Model profiling is not available with partitioned or swarm exploration, decision "
+                                "diagrams of integer valuations, federations, lazy abstraction or bitstate counter "
+                                "examples");
+  if (!zone_stats_file.empty() &&
+      (!state_store.empty() || swarm != 0 || intval_mdd || federation || lazy || bitstate_size != 0))
+    throw std::invalid_argument("Zone statistics are not available with state stores, swarm or bitstate exploration, "
+                                "decision diagrams of integer valuations, federations or lazy abstraction");
+  if ((checkpoint_period != 0 || !resume_file.empty()) &&
+      (partitions != 0 || swarm != 0 || intval_mdd || federation || lazy || bitstate_size != 0 ||
+       (threads > 1 && search_order == "bfs")))
+    throw std::invalid_argument("Checkpoints are not available with partitioned, swarm, bitstate or parallel "
+                                "exploration, decision diagrams of integer valuations, federations or lazy abstraction");
+  if (on_the_fly && (!state_store.empty() || partitions != 0 || swarm != 0 || intval_mdd || federation || lazy ||
+                     bitstate_size != 0 || (threads > 1 && search_order == "bfs")))
+    throw std::invalid_argument("On-the-fly detection is not available with state stores, partitioned, swarm, bitstate "
+                                "or parallel exploration, decision diagrams of integer valuations, federations or "
+                                "lazy abstraction");
+
+  if (!state_store.empty()) {
+    store_reach(sysdecl);
+    return;
+  }
+
+  // the certificate is computed on the sliced system
+  std::shared_ptr<tchecker::parsing::system_declaration_t> const decl =
+      (slice ? tchecker::ta::cone_of_influence(*sysdecl, labels) : sysdecl);
+
+  if (partitions != 0) {
+    auto && [stats, graphs] = tchecker::tck_reach::zg_reach::run_partitioned(decl, labels, partitions, block_size,
+                                                                             table_size, por, symmetry, active_clocks);
+    std::map<std::string, std::string> m;
+    stats.attributes(m);
+    m["PARTITIONS"] = std::to_string(partitions);
+    tchecker::algorithms::output_attributes(std::cout, m, stats_format);
+    if (!zone_stats_file.empty())
+      write_zone_stats(graphs);
+    return;
+  }
+
+  if (swarm != 0) {
+    tchecker::algorithms::reach::stats_t stats = tchecker::tck_reach::zg_reach::run_swarm(
+        decl, labels, swarm, (bitstate_size == 0 ? std::size_t{1} << 24 : bitstate_size), block_size, table_size,
+        budget(), por, symmetry, active_clocks);
+    std::map<std::string, std::string> m;
+    stats.attributes(m);
+    m["SWARM"] = std::to_string(swarm);
+    tchecker::algorithms::output_attributes(std::cout, m, stats_format);
+    return;
+  }
+
+  if (intval_mdd) {
+    tchecker::algorithms::reach::stats_t stats = tchecker::tck_reach::zg_reach::run_intval_mdd(
+        decl, labels, search_order, block_size, table_size, budget(), por, symmetry, active_clocks);
+    std::map<std::string, std::string> m;
+    stats.attributes(m);
+    tchecker::algorithms::output_attributes(std::cout, m, stats_format);
+
+    if (stats.budget_exceeded())
+      std::cerr << tchecker::log_warning << stats.budget_status() << " budget exceeded, exploration is incomplete"
+                << std::endl;
+    return;
+  }
+
+  if (federation) {
+    tchecker::algorithms::reach::stats_t stats = tchecker::tck_reach::zg_reach::run_federation(
+        decl, labels, search_order, block_size, table_size, budget(), por, symmetry, active_clocks);
+    std::map<std::string, std::string> m;
+    stats.attributes(m);
+    tchecker::algorithms::output_attributes(std::cout, m, stats_format);
+
+    if (stats.budget_exceeded())
+      std::cerr << tchecker::log_warning << stats.budget_status() << " budget exceeded, exploration is incomplete"
+                << std::endl;
+    return;
+  }
+
+  if (zone_storage != tchecker::tck_reach::zg_reach::ZONE_STORAGE_FULL) {
+    tchecker::algorithms::reach::stats_t stats = tchecker::tck_reach::zg_reach::run_stored_zones(
+        decl, labels, zone_storage, search_order, block_size, table_size, budget(), por, symmetry, active_clocks,
+        packed_intvals);
+    std::map<std::string, std::string> m;
+    stats.attributes(m);
+    tchecker::algorithms::output_attributes(std::cout, m, stats_format);
+
+    if (stats.budget_exceeded())
+      std::cerr << tchecker::log_warning << stats.budget_status() << " budget exceeded, exploration is incomplete"
+                << std::endl;
+    return;
+  }
+
+  if (lazy) {
+    tchecker::algorithms::reach::lazy_stats_t stats =
+        tchecker::tck_reach::zg_reach::run_lazy(decl, labels, search_order, block_size, table_size, budget());
+    std::map<std::string, std::string> m;
+    stats.attributes(m);
+    tchecker::algorithms::output_attributes(std::cout, m, stats_format);
+
+    if (stats.budget_exceeded())
+      std::cerr << tchecker::log_warning << stats.budget_status() << " budget exceeded, exploration is incomplete"
+                << std::endl;
+    return;
+  }
+
+  // bitstate exploration only stores the trace of explored states, and recomputes the zones of the counter example
+  if (bitstate_size != 0 && certificate != CERTIFICATE_NONE) {
+    auto && [stats, symbolic_cex] = tchecker::tck_reach::zg_reach::run_bitstate_cex(
+        decl, labels, search_order, block_size, table_size, budget(), bitstate_size, por, active_clocks);
+    std::map<std::string, std::string> m;
+    stats.attributes(m);
+    tchecker::algorithms::output_attributes(std::cout, m, stats_format);
+
+    if (stats.budget_exceeded())
+      std::cerr << tchecker::log_warning << stats.budget_status() << " budget exceeded, exploration is incomplete"
+                << std::endl;
+
+    if (!stats.reachable())
+      return;
+    if (symbolic_cex->empty())
+      throw std::runtime_error("Unable to compute a counter example");
+    if (certificate == CERTIFICATE_SYMBOLIC)
+      tchecker::tck_reach::zg_reach::cex::dot_output(*os, *symbolic_cex, sysdecl->name());
+    else {
+      std::unique_ptr<tchecker::tck_reach::zg_reach::cex::concrete_cex_t> cex{
+          tchecker::zg::path::concrete::compute_finite_path(*symbolic_cex)};
+      if (cex->empty())
+        throw std::runtime_error("Unable to compute a concrete counter example");
+      tchecker::tck_reach::zg_reach::cex::dot_output(*os, *cex, sysdecl->name());
+    }
+    return;
+  }
+
+  auto && [stats, graph] = tchecker::tck_reach::zg_reach::run(decl, labels, search_order, block_size, table_size,
+                                                              budget(), bitstate_size, por, symmetry, active_clocks,
+                                                              threads, !profile_file.empty(),
+                                                              (checkpoint_period != 0 ? checkpoint_file : ""),
+                                                              std::chrono::minutes{checkpoint_period}, resume_file,
+                                                              reach_edges(), on_the_fly);
+
+  if (!profile_file.empty()) {
+    std::ofstream ofs{profile_file};
+    if (!ofs)
+      throw std::runtime_error("Cannot write file " + profile_file);
+    graph->zg().profile()->report(ofs);
+  }
+
+  if (!zone_stats_file.empty())
+    write_zone_stats({graph});
 
   // stats
   std::map<std::string, std::string> m;
   stats.attributes(m);
-  for (auto && [key, value] : m)
-    std::cout << key << " " << value << std::endl;
+  tchecker::algorithms::output_attributes(std::cout, m, stats_format);
+
+  if (stats.budget_exceeded())
+    std::cerr << tchecker::log_warning << stats.budget_status() << " budget exceeded, exploration is incomplete"
+              << std::endl;
 
   // certificate
-   if (certificate == CERTIFICATE_GRAPH)
-     tchecker::tck_reach::zg_reach::dot_output(*os, *graph, sysdecl->name());
+   if ((certificate == CERTIFICATE_GRAPH) && binary_graph)
+     tchecker::graph::binary_output(*os, *graph, sysdecl->name());
+   else if (certificate == CERTIFICATE_GRAPH)
+     tchecker::tck_reach::zg_reach::dot_output(*os, *graph, sysdecl->name(), lexical_graph);
    else if ((certificate == CERTIFICATE_CONCRETE) && stats.reachable()) {
      std::unique_ptr<tchecker::tck_reach::zg_reach::cex::concrete_cex_t> cex{
          tchecker::tck_reach::zg_reach::cex::concrete_counter_example(*graph)};
@@ -242,286 +1365,1105 @@ void reach(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysd
    }
 }
 
-bool check_consistency(
-    const tchecker::intrusive_shared_ptr_t<tchecker::make_shared_t<tchecker::graph::reachability::edge_t<
-        tchecker::tck_reach::zg_history_aware::node_t, tchecker::tck_reach::zg_history_aware::edge_t>>> & incoming_edge,
-    const tchecker::graph::reachability::node_sptr_t<tchecker::tck_reach::zg_history_aware::node_t,
-                                                     tchecker::tck_reach::zg_history_aware::edge_t> & src_node,
-    const std::size_t number_of_clocks)
+/*!
+ \brief Perform covering reachability analysis
+ \param sysdecl : system declaration
+ \post statistics on covering reachability analysis of command-line specified labels in the system declared by
+ sysdecl have been output to standard output. A certification has been output if required.
+*/
+void covreach(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
 {
-  const tchecker::clock_constraint_container_t clk_guard_vector = incoming_edge->get_transition().guard_container();
-  const std::vector<unsigned> intvar_guard_vector = incoming_edge->get_transition().intvar_guard_container();
-  for (auto constraint : clk_guard_vector) {
-    tchecker::variable_id_t variable_id = (constraint.id1() != tchecker::REFCLOCK_ID) ? constraint.id1() : constraint.id2();
-    if (variable_id < src_node->reset_history_vector().size() && !src_node->reset_history_vector()[variable_id]) {
-      return false;
-    }
-  }
-  for (auto variable_id : intvar_guard_vector) {
-    if (variable_id < src_node->reset_history_vector().size() &&
-        !src_node->reset_history_vector()[variable_id + number_of_clocks]) {
-      return false;
-    }
-  }
-  return true;
+  if (por || symmetry || active_clocks)
+    throw std::invalid_argument("Algorithm covreach does not support partial-order, symmetry or active-clock reductions");
+  if (threads > 1 || bitstate_size != 0 || partitions != 0 || swarm != 0)
+    throw std::invalid_argument("Algorithm covreach does not support parallel, bitstate, partitioned or swarm "
+                                "exploration");
+
+  std::shared_ptr<tchecker::parsing::system_declaration_t> const decl =
+      (slice ? tchecker::ta::cone_of_influence(*sysdecl, labels) : sysdecl);
+
+  auto && [stats, graph] =
+      tchecker::tck_reach::zg_covreach::run(decl, labels, search_order, cover, block_size, table_size, budget());
+
+  // stats
+  std::map<std::string, std::string> m;
+  stats.attributes(m);
+  if (cover_stats)
+    stats.cover_attributes(m);
+  tchecker::algorithms::output_attributes(std::cout, m, stats_format);
+
+  if (stats.budget_exceeded())
+    std::cerr << tchecker::log_warning << stats.budget_status() << " budget exceeded, exploration is incomplete"
+              << std::endl;
+
+  // certificate (counter examples are paths in the zone graph, as the ones of reach)
+  if (certificate == CERTIFICATE_GRAPH)
+    tchecker::tck_reach::zg_covreach::dot_output(*os, *graph, sysdecl->name(), lexical_graph);
+  else if ((certificate == CERTIFICATE_CONCRETE) && stats.reachable()) {
+    std::unique_ptr<tchecker::tck_reach::zg_covreach::cex::concrete_cex_t> cex{
+        tchecker::tck_reach::zg_covreach::cex::concrete_counter_example(*graph)};
+    if (cex->empty())
+      throw std::runtime_error("Unable to compute a concrete counter example");
+    tchecker::tck_reach::zg_reach::cex::dot_output(*os, *cex, sysdecl->name());
+  }
+  else if ((certificate == CERTIFICATE_SYMBOLIC) && stats.reachable()) {
+    std::unique_ptr<tchecker::tck_reach::zg_covreach::cex::symbolic_cex_t> cex{
+        tchecker::tck_reach::zg_covreach::cex::symbolic_counter_example(*graph)};
+    if (cex->empty())
+      throw std::runtime_error("Unable to compute a symbolic counter example");
+    tchecker::tck_reach::zg_reach::cex::dot_output(*os, *cex, sysdecl->name());
+  }
 }
 
-std::tuple<bool, unsigned long long int, unsigned long long int, unsigned long long int>
-backward_propagation(const std::shared_ptr<tchecker::tck_reach::zg_history_aware::graph_t> & graph,
-                     std::queue<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t> & pi_nodes,
-                     std::unordered_set<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t> & reachable_waiting_list,
-                     std::unordered_set<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t> & reachable_visited_list)
+/*!
+ \brief Perform local-time reachability analysis
+ \param sysdecl : system declaration
+ \post statistics on local-time reachability analysis of command-line specified labels in the system declared by
+ sysdecl have been output to standard output. A certification has been output if required.
+ \throw std::invalid_argument : if a concrete counter example is required
+*/
+void concur19(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
+{
+  if (!budget().unlimited())
+    throw std::invalid_argument("Algorithm concur19 does not support budgets of states, time or memory");
+  if (por || symmetry || active_clocks)
+    throw std::invalid_argument("Algorithm concur19 does not support partial-order, symmetry or active-clock reductions");
+  if (threads > 1 || bitstate_size != 0 || partitions != 0 || swarm != 0)
+    throw std::invalid_argument("Algorithm concur19 does not support parallel, bitstate, partitioned or swarm "
+                                "exploration");
+  if (certificate == CERTIFICATE_CONCRETE)
+    throw std::invalid_argument("No concrete counter example can be computed with concur19");
+
+  std::shared_ptr<tchecker::parsing::system_declaration_t> const decl =
+      (slice ? tchecker::ta::cone_of_influence(*sysdecl, labels) : sysdecl);
+
+  auto && [stats, graph] = tchecker::tck_reach::concur19::run(decl, labels, search_order, block_size, table_size);
+
+  // stats
+  std::map<std::string, std::string> m;
+  stats.attributes(m);
+  if (cover_stats)
+    stats.cover_attributes(m);
+  tchecker::algorithms::output_attributes(std::cout, m, stats_format);
+
+  // certificate
+  if (certificate == CERTIFICATE_GRAPH)
+    tchecker::tck_reach::concur19::dot_output(*os, *graph, sysdecl->name(), lexical_graph);
+  else if ((certificate == CERTIFICATE_SYMBOLIC) && stats.reachable()) {
+    std::unique_ptr<tchecker::tck_reach::concur19::cex::symbolic_cex_t> cex{
+        tchecker::tck_reach::concur19::cex::symbolic_counter_example(*graph)};
+    if (cex->empty())
+      throw std::runtime_error("Unable to compute a symbolic counter example");
+    tchecker::tck_reach::concur19::cex::dot_output(*os, *cex, sysdecl->name());
+  }
+}
+
+/*!
+ \brief Perform backward reachability analysis
+ \param sysdecl : system declaration
+ \post statistics on backward reachability analysis of command-line specified labels in the system declared by
+ sysdecl have been output to standard output. A certification has been output if required.
+*/
+void backward(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
+{
+  if (!budget().unlimited())
+    throw std::invalid_argument("Algorithm backward does not support budgets of states, time or memory");
+  if (por || symmetry || active_clocks)
+    throw std::invalid_argument("Algorithm backward does not support partial-order, symmetry or active-clock reductions");
+  if (threads > 1 || bitstate_size != 0 || partitions != 0 || swarm != 0)
+    throw std::invalid_argument("Algorithm backward does not support parallel, bitstate, partitioned or swarm "
+                                "exploration");
+
+  std::shared_ptr<tchecker::parsing::system_declaration_t> const decl =
+      (slice ? tchecker::ta::cone_of_influence(*sysdecl, labels) : sysdecl);
+
+  auto && [stats, graph] = tchecker::tck_reach::zg_backward::run(decl, labels, search_order, block_size, table_size);
+
+  // stats
+  std::map<std::string, std::string> m;
+  stats.attributes(m);
+  if (cover_stats)
+    stats.cover_attributes(m);
+  tchecker::algorithms::output_attributes(std::cout, m, stats_format);
+
+  // certificate (edges of the graph are oriented forward, counter examples are computed as for covreach)
+  if (certificate == CERTIFICATE_GRAPH)
+    tchecker::tck_reach::zg_covreach::dot_output(*os, *graph, sysdecl->name(), lexical_graph);
+  else if ((certificate == CERTIFICATE_CONCRETE) && stats.reachable()) {
+    std::unique_ptr<tchecker::tck_reach::zg_covreach::cex::concrete_cex_t> cex{
+        tchecker::tck_reach::zg_covreach::cex::concrete_counter_example(*graph)};
+    if (cex->empty())
+      throw std::runtime_error("Unable to compute a concrete counter example");
+    tchecker::tck_reach::zg_reach::cex::dot_output(*os, *cex, sysdecl->name());
+  }
+  else if ((certificate == CERTIFICATE_SYMBOLIC) && stats.reachable()) {
+    std::unique_ptr<tchecker::tck_reach::zg_covreach::cex::symbolic_cex_t> cex{
+        tchecker::tck_reach::zg_covreach::cex::symbolic_counter_example(*graph)};
+    if (cex->empty())
+      throw std::runtime_error("Unable to compute a symbolic counter example");
+    tchecker::tck_reach::zg_reach::cex::dot_output(*os, *cex, sysdecl->name());
+  }
+}
+
+/*!
+ \brief Perform bounded reachability analysis
+ \param sysdecl : system declaration
+ \post statistics on the reachability of command-line specified labels within the depth bound in the system
+ declared by sysdecl have been output to standard output. A counter example has been output if required.
+*/
+void bmc(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
+{
+  if (depth == 0)
+    throw std::invalid_argument("Algorithm bmc requires a depth bound (see --depth)");
+  if (certificate == CERTIFICATE_GRAPH)
+    throw std::invalid_argument("No graph certificate can be computed with bmc");
+  if (symmetry)
+    throw std::invalid_argument("Symmetry reduction is not available with bmc");
+
+  std::shared_ptr<tchecker::parsing::system_declaration_t> const decl =
+      (slice ? tchecker::ta::cone_of_influence(*sysdecl, labels) : sysdecl);
+
+  auto && [stats, symbolic_cex] = tchecker::tck_reach::zg_reach::run_bmc(decl, labels, depth, bmc_cache, block_size,
+                                                                         table_size, budget(), por, active_clocks);
+  std::map<std::string, std::string> m;
+  stats.attributes(m);
+  tchecker::algorithms::output_attributes(std::cout, m, stats_format);
+
+  if (stats.budget_exceeded())
+    std::cerr << tchecker::log_warning << stats.budget_status() << " budget exceeded, exploration is incomplete"
+              << std::endl;
+
+  if (!stats.reachable() || certificate == CERTIFICATE_NONE)
+    return;
+  if (symbolic_cex->empty())
+    throw std::runtime_error("Unable to compute a counter example");
+  if (certificate == CERTIFICATE_SYMBOLIC)
+    tchecker::tck_reach::zg_reach::cex::dot_output(*os, *symbolic_cex, sysdecl->name());
+  else {
+    std::unique_ptr<tchecker::tck_reach::zg_reach::cex::concrete_cex_t> cex{
+        tchecker::zg::path::concrete::compute_finite_path(*symbolic_cex)};
+    if (cex->empty())
+      throw std::runtime_error("Unable to compute a concrete counter example");
+    tchecker::tck_reach::zg_reach::cex::dot_output(*os, *cex, sysdecl->name());
+  }
+}
+
+/*!
+ \class node_set_t
+ \brief Set of nodes of a history-aware graph, represented as a bitset over node indices
+ \note nodes are enumerated in insertion order. An erased node is skipped, and it is listed once even
+ if it is inserted again
+ */
+class node_set_t {
+public:
+  /*!
+   \brief Type of pointer to node
+   */
+  using node_sptr_t = tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t;
+
+  /*!
+   \brief Constructor
+   \param index_bound : bound on node indices
+   \post this set is empty and can store nodes with index in [0, index_bound)
+   */
+  explicit node_set_t(std::size_t index_bound) : _members(index_bound), _listed(index_bound) {}
+
+  /*!
+   \brief Insert a node
+   \param n : a node
+   \pre n->index() < index_bound (checked by assertion)
+   \post n is in this set
+   \return true if n was not in this set, false otherwise
+   */
+  bool insert(node_sptr_t const & n)
+  {
+    std::size_t const i = n->index();
+    assert(i < _members.size());
+    if (_members[i])
+      return false;
+    _members.set(i);
+    if (!_listed[i]) {
+      _listed.set(i);
+      _nodes.push_back(n);
+    }
+    return true;
+  }
+
+  /*!
+   \brief Erase a node
+   \param n : a node
+   \post n is not in this set
+   */
+  inline void erase(node_sptr_t const & n) { _members.reset(n->index()); }
+
+  /*!
+   \brief Membership predicate
+   \param n : a node
+   \return true if n is in this set, false otherwise
+   */
+  inline bool contains(node_sptr_t const & n) const { return _members[n->index()]; }
+
+  /*!
+   \brief Visitor
+   \param f : function called on nodes
+   \post f(n) has been called on every node n in this set, in insertion order
+   */
+  template <class F> void for_each(F && f) const
+  {
+    for (node_sptr_t const & n : _nodes)
+      if (_members[n->index()])
+        f(n);
+  }
+
+private:
+  boost::dynamic_bitset<> _members; /*!< Nodes in this set */
+  boost::dynamic_bitset<> _listed;  /*!< Nodes in _nodes */
+  std::vector<node_sptr_t> _nodes;  /*!< Nodes in insertion order */
+};
+
+/*!
+ \class guard_masks_t
+ \brief Masks of the history slots read by the interned guard variables of a history-aware graph
+ \note a mask is computed the first time it is requested, then consistency checks are word-wise inclusions
+ */
+class guard_masks_t {
+public:
+  /*!
+   \brief Constructor
+   \param table : table of guard variables
+   \param intvar_slots : map from integer variables to history slots (see intvar_history_slots)
+   \note this keeps references on table and intvar_slots
+   */
+  guard_masks_t(tchecker::graph::guard_variables_table_t const & table, std::vector<std::size_t> const & intvar_slots)
+      : _table(table), _intvar_slots(intvar_slots)
+  {
+  }
+
+  /*!
+   \brief Accessor
+   \param i : index of guard variables in the table
+   \param size : size of reset histories
+   \return the history of given size with the slots of the clocks and of the tracked integer variables of entry i
+   (slots out of range are ignored)
+   */
+  tchecker::graph::reset_history_t const & mask(tchecker::graph::guard_variables_table_t::index_t i, std::size_t size)
+  {
+    if (i >= _masks.size())
+      _masks.resize(_table.size());
+    tchecker::graph::reset_history_t & m = _masks[i];
+    // a mask of size 0 is empty, otherwise it has the size of the histories once it has been computed
+    if (m.size() == size)
+      return m;
+
+    m.clear();
+    m.resize(size);
+    tchecker::graph::guard_variables_t const & guard_variables = _table[i];
+    for (tchecker::clock_id_t x : guard_variables.clocks())
+      if (x < size)
+        m.set(x);
+    for (tchecker::intvar_id_t v : guard_variables.intvars()) {
+      // integer variables read by guards are tracked by histories (see intvar_history_slots)
+      std::size_t const slot =
+          (v < _intvar_slots.size() ? _intvar_slots[v] : tchecker::tck_reach::zg_history_aware::NO_HISTORY_SLOT);
+      if (slot < size)
+        m.set(slot);
+    }
+    return m;
+  }
+
+private:
+  tchecker::graph::guard_variables_table_t const & _table; /*!< Table of guard variables */
+  std::vector<std::size_t> const & _intvar_slots;          /*!< History slots of integer variables */
+  std::vector<tchecker::graph::reset_history_t> _masks;    /*!< Masks by index of guard variables */
+};
+
+/*!
+ \brief Consistency of a backward propagation
+ \param incoming_edge : an edge
+ \param src_node : source node of incoming_edge
+ \param masks : masks of the guard variables of the graph of incoming_edge
+ \return true if every clock and tracked integer variable read by the guard of incoming_edge is set in the reset
+ history of src_node, false otherwise
+ */
+bool check_consistency(
+    const tchecker::intrusive_shared_ptr_t<tchecker::make_shared_t<tchecker::graph::reachability::edge_t<
+        tchecker::tck_reach::zg_history_aware::node_t, tchecker::tck_reach::zg_history_aware::edge_t>>> & incoming_edge,
+    const tchecker::graph::reachability::node_sptr_t<tchecker::tck_reach::zg_history_aware::node_t,
+                                                     tchecker::tck_reach::zg_history_aware::edge_t> & src_node,
+    guard_masks_t & masks)
+{
+  const tchecker::graph::reset_history_t & reset_history = src_node->reset_history_vector();
+  return masks.mask(incoming_edge->guard_variables(), reset_history.size()).is_subset_of(reset_history);
+}
+
+/*!
+ \brief Backward analysis of a history-aware graph
+ \param graph : history-aware graph
+ \param pi_nodes : final nodes
+ \param propagation : statistics of the propagation of final nodes
+ \param reachability : statistics of the backward reachability of final nodes
+ \post the nodes of graph that reach a final node have their reachability status set. Final nodes have been
+ propagated backward along consistent epsilon edges (the sources have been made final, and the outgoing edges
+ of final nodes have been removed), then the other ancestors of final nodes have been marked. The runs of both
+ phases have been added to propagation and reachability. The graph has been compacted (see
+ tchecker::graph::reachability::graph_t::compact): final nodes that are only reached from final nodes have been
+ removed unless they are initial, and node indices are dense
+ \return a tuple (status, new_count) where status is true if an initial node has been made final (the analysis
+ stops right away), and new_count is the number of nodes that have been made final
+ \note the analysis is a single traversal with a two-colour worklist: final nodes first, then the other marked
+ nodes. A node is expanded at most once per colour, and a marked node is never expanded again as a final node
+ since no final node remains to be propagated when marked nodes are expanded. Only the ancestors of final nodes
+ are visited
+ */
+std::tuple<bool, unsigned long long int>
+backward_analysis(const std::shared_ptr<tchecker::tck_reach::zg_history_aware::graph_t> & graph,
+                  std::queue<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t> & pi_nodes,
+                  tchecker::algorithms::phase_stats_t & propagation, tchecker::algorithms::phase_stats_t & reachability)
 {
+  using node_sptr_t = tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t;
 
-  const std::size_t number_of_clocks = graph->zg().system().as_system_system().clocks_count(tchecker::VK_FLATTENED);
+  const std::vector<std::size_t> intvar_slots =
+      tchecker::tck_reach::zg_history_aware::intvar_history_slots(graph->zg().system());
+  guard_masks_t masks{graph->guard_variables(), intvar_slots};
   unsigned long long int new_count = 0;
-  unsigned long long int visited_states = 0;
-  unsigned long long int visited_transition = 0;
 
-  const tchecker::system::system_t graph_system = graph->zg().system().as_system_system();
+  // nodes reached by the analysis, and marked nodes that are not final (second colour of the worklist)
+  node_set_t reachable_visited_list(graph->nodes_index_bound());
+  node_set_t reachable_waiting_list(graph->nodes_index_bound());
+
+  // pruned nodes are final nodes: their outgoing edges are ignored, and they are removed by the compaction of
+  // the graph at the end of the analysis (initial nodes are kept)
+  auto compact = [&]() { graph->compact([](node_sptr_t const & n) { return n->initial(); }); };
+
+  tchecker::algorithms::phase_timer_t propagation_timer{propagation};
+  tchecker::ta_ha::system_t const & graph_system = graph->zg().system();
   while (!pi_nodes.empty()) {
-    visited_states += 1;
-    tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t pi_node = pi_nodes.front();
+    propagation.visited_states() += 1;
+    node_sptr_t pi_node = pi_nodes.front();
     pi_nodes.pop();
     pi_node->update_reach_status(true);
-    graph->remove_outgoing_edges(pi_node);
+    graph->prune(pi_node);
     reachable_visited_list.insert(pi_node);
 
-    auto incoming_edges = graph->incoming_edges(pi_node);
     for (auto incoming_edge : graph->incoming_edges(pi_node)) {
-      visited_transition += 1;
-      const auto edge = graph_system.edge(*incoming_edge->vedge().begin());
-      const auto & event_name = graph_system.event_name(edge->event_id());
       auto src_node = graph->edge_src(incoming_edge);
-      if (event_name[0] == '_') {
-        const bool is_consistent = check_consistency(incoming_edge, src_node, number_of_clocks);
-        if (is_consistent) {
-          reachable_waiting_list.erase(src_node);
-          new_count++;
-          src_node->final(true);                  
-          pi_nodes.push(src_node);                
-          graph->remove_outgoing_edges(src_node); 
-          if (graph->incoming_edges(pi_node).empty()) {
-            graph->remove_node(pi_node);
-          }
-          if (src_node->initial()) {
-            return std::make_tuple(true, new_count, visited_states, visited_transition);
-          }
-        }
-        else {
-          if (reachable_visited_list.insert(src_node).second) {
-            reachable_waiting_list.insert(src_node);
-          }
+      if (src_node->pruned())
+        continue;
+      propagation.visited_transitions() += 1;
+      if (graph_system.is_epsilon_edge(*incoming_edge->vedge().begin()) &&
+          check_consistency(incoming_edge, src_node, masks)) {
+        reachable_waiting_list.erase(src_node);
+        new_count++;
+        src_node->final(true);
+        pi_nodes.push(src_node);
+        graph->prune(src_node);
+        if (src_node->initial()) {
+          propagation_timer.stop();
+          compact();
+          return std::make_tuple(true, new_count);
         }
       }
-      else {
-        if (reachable_visited_list.insert(src_node).second) {
-          reachable_waiting_list.insert(src_node);
-        }
+      else if (reachable_visited_list.insert(src_node)) {
+        reachable_waiting_list.insert(src_node);
       }
       src_node->update_reach_status(true);
     }
   }
-
-  return std::make_tuple(false, new_count, visited_states, visited_transition);
-}
-
-std::tuple<unsigned long long int, unsigned long long int> backward_reachability(
-    const std::shared_ptr<tchecker::tck_reach::zg_history_aware::graph_t> & graph,
-    const std::unordered_set<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t> & reachable_waiting_list,
-    std::unordered_set<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t> & reachable_visited_list)
-{
-  std::queue<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t> second_reachable_waiting_list;
-
-  unsigned long long int visited_states = 0;
-  unsigned long long int visited_transition = 0;
-
-  for (const auto & node : reachable_waiting_list) {
-    visited_states += 1;
-
-    auto incoming_edges = graph->incoming_edges(node);
-    for (auto incoming_edge : incoming_edges) {
-      visited_transition += 1;
-
+  propagation_timer.stop();
+
+  // final nodes cannot appear anymore: the ancestors of marked nodes are marked
+  tchecker::algorithms::phase_timer_t reachability_timer{reachability};
+  std::queue<node_sptr_t> second_reachable_waiting_list;
+  auto visit_predecessors = [&](node_sptr_t const & node) {
+    reachability.visited_states() += 1;
+    for (auto incoming_edge : graph->incoming_edges(node)) {
       auto src_node = graph->edge_src(incoming_edge);
-      if (reachable_visited_list.insert(src_node).second) {
+      if (src_node->pruned())
+        continue;
+      reachability.visited_transitions() += 1;
+      if (reachable_visited_list.insert(src_node)) {
         second_reachable_waiting_list.push(src_node);
         src_node->update_reach_status(true);
       }
     }
-  }
+  };
 
+  reachable_waiting_list.for_each(visit_predecessors);
   while (!second_reachable_waiting_list.empty()) {
-    visited_states += 1;
-
-    auto node = second_reachable_waiting_list.front();
+    node_sptr_t node = second_reachable_waiting_list.front();
     second_reachable_waiting_list.pop();
-    auto incoming_edges = graph->incoming_edges(node);
-    for (auto incoming_edge : incoming_edges) {
-      visited_transition += 1;
+    visit_predecessors(node);
+  }
 
-      auto src_node = graph->edge_src(incoming_edge);
-      if (reachable_visited_list.insert(src_node).second) {
-        second_reachable_waiting_list.push(src_node);
-        src_node->update_reach_status(true);
-      }
+  compact();
+  return std::make_tuple(false, new_count);
+}
+
+/*!
+ \brief Lock on the parser of systems, which is not reentrant, for the fragments read from the cache by concurrent
+ compositional checks
+ */
+static std::mutex fragment_parser_mutex;
+
+/*!
+ \brief Key of a fragment in the fragment cache
+ \param inputs : declarations of the system, of the environment and of the property
+ \return a hash of the property and environment declarations, of the integer variables of the system, and of the
+ options that determine the pruned property graph and its merged system, as 16 hexadecimal digits
+ \note the hash is stable between runs (see tchecker::stable_hash) as keys are kept between runs
+ */
+static std::string fragment_key(tchecker::tck_reach::merge_inputs_t const & inputs,
+                                tchecker::parsing::system_declaration_t const & propertydecl)
+{
+  std::stringstream ss;
+  ss << "fragment 1" << '\0' << propertydecl << '\0' << inputs.environment() << '\0';
+  for (tchecker::parsing::int_declaration_t const * d : inputs.system_ints())
+    ss << *d << '\0';
+  ss << labels << '\0' << merge_flag << minimize << reduce_clocks << covering << lexical_graph
+     << static_cast<int>(ha_extrapolation);
+  return tchecker::stable_hash(ss.str());
+}
+
+/*!
+ \brief Store a result of the property graph in the fragment cache
+ \param key : key of the fragment (see fragment_key)
+ \param status : REACHABLE if the labels are reachable in the property graph, UNREACHABLE if they are not, FRAGMENT
+ if the merged system has to be checked
+ \param check_decl : merged system (FRAGMENT only)
+ \post the status, followed by check_decl if status is FRAGMENT, has been written to key in directory
+ fragment_cache. A warning has been reported if it could not be written
+ */
+static void store_fragment(std::string const & key, std::string const & status,
+                           tchecker::parsing::system_declaration_t const * check_decl = nullptr)
+{
+  std::error_code ec;
+  std::filesystem::create_directories(fragment_cache, ec);
+  std::string const path = fragment_cache + "/" + key;
+  std::string const tmp = path + "." + std::to_string(::getpid());
+  {
+    std::ofstream ofs{tmp, std::ios::out | std::ios::binary | std::ios::trunc};
+    ofs << status << "\n";
+    if (check_decl != nullptr)
+      tchecker::tck_reach::outputDeclaration(ofs, *check_decl, threads);
+    if (!ofs.good()) {
+      std::cerr << tchecker::log_warning << "cannot write fragment cache " << tmp << std::endl;
+      return;
     }
   }
+  std::filesystem::rename(tmp, path, ec);
+  if (ec)
+    std::cerr << tchecker::log_warning << "cannot write fragment cache " << path << ": " << ec.message() << std::endl;
+}
 
-  return std::make_tuple(visited_states, visited_transition);
+/*!
+ \brief Load a result of the property graph from the fragment cache
+ \param key : key of the fragment (see fragment_key)
+ \param status : status of the fragment
+ \param check_decl : merged system
+ \return true if key is in directory fragment_cache, false otherwise
+ \post if true is returned, status has been set to the stored status (see store_fragment), and check_decl to the
+ stored merged system if status is FRAGMENT
+ */
+static bool load_fragment(std::string const & key, std::string & status,
+                          std::shared_ptr<tchecker::parsing::system_declaration_t> & check_decl)
+{
+  std::string const path = fragment_cache + "/" + key;
+  std::FILE * f = std::fopen(path.c_str(), "r");
+  if (f == nullptr)
+    return false;
+  char line[16];
+  bool found = (std::fgets(line, sizeof(line), f) != nullptr);
+  status = (found ? std::string{line} : "");
+  if (!status.empty() && status.back() == '\n')
+    status.pop_back();
+  if (status == "FRAGMENT") {
+    std::lock_guard<std::mutex> lock{fragment_parser_mutex};
+    check_decl.reset(tchecker::parsing::parse_system_declaration(f, path));
+    found = (check_decl.get() != nullptr);
+  }
+  else
+    found = (status == "REACHABLE" || status == "UNREACHABLE");
+  std::fclose(f);
+  return found;
 }
 
-void compos(const std::string & input_file, const std::shared_ptr<tchecker::parsing::system_declaration_t> & sysdecl,
+/*!
+ \brief Compositional reachability
+ \param sysdecl : system declaration
+ \param propertydecl : property declaration
+ \param envdecl : environment declaration
+ \param stats_os : output stream for statistics
+ \param cert_os : output stream for certificates and merged systems
+ \param property : name of the property in the statistics (empty: not output)
+ \param level : level of decomposition of this call
+ \param result : statistics of this call (nullptr: statistics are output to stats_os)
+ \post the labels have been searched in the product of sysdecl and envdecl with the property. Statistics have been
+ output to stats_os, with attribute PROPERTY if property is not empty, or stored into result if it is not nullptr.
+ If fragment_cache is set, the pruned property graph is loaded from the cache when the property, the environment and
+ the integer variables of sysdecl are unchanged, and only its product with sysdecl is checked. Otherwise, it is stored
+ in the cache
+ \note while level is smaller than compos_levels, the merged system of the fragment and of the environment is
+ decomposed again instead of being checked: the fragment and a part of the environment are the property of the next
+ level, and the other processes of the environment are its environment (see tchecker::ta::decompose with strict
+ decompositions). The statistics of the next levels are added to the statistics of this call. The merged system is
+ checked when its environment cannot be split
+ \note merged systems are checked by the engine of --check-engine, either when they are computed, or concurrently
+ with the exploration of the next fragment with --pipeline
+ \throw std::invalid_argument : if the options cannot be combined
+ \throw std::runtime_error : if a counter example cannot be computed
+ */
+void compos(const std::shared_ptr<tchecker::parsing::system_declaration_t> & sysdecl,
             const std::shared_ptr<tchecker::parsing::system_declaration_t> & propertydecl,
-            const std::shared_ptr<tchecker::parsing::system_declaration_t> & envdecl)
+            const std::shared_ptr<tchecker::parsing::system_declaration_t> & envdecl, std::ostream & stats_os,
+            std::ostream & cert_os, std::string const & property = "", std::size_t level = 1,
+            tchecker::tck_reach::compos::stats_t * result = nullptr)
 {
-  tchecker::algorithms::reach::stats_t stats;
+  tchecker::tck_reach::compos::stats_t compos_stats;
+  tchecker::tck_reach::zg_history_aware::stats_t stats;
   std::shared_ptr<tchecker::tck_reach::zg_history_aware::graph_t> graph;
   std::queue<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t> pi_nodes;
-  unsigned long long int cumulative_visited_states = 0;
-  unsigned long long int cumulative_visited_transition = 0;
   bool early_termination = false;
   long long int iteration_num;
-  std::string reachable;
 
-  if (early_enabled) {
+  if (bidirectional && bitstate_size != 0)
+    throw std::invalid_argument("Bidirectional checks and bitstate exploration cannot be combined");
+  // counter examples are extracted from final nodes, which are not stored by these checks
+  if ((bidirectional || bitstate_size != 0) && (certificate == CERTIFICATE_SYMBOLIC || certificate == CERTIFICATE_CONCRETE))
+    throw std::invalid_argument("No counter example can be computed with bidirectional checks or bitstate exploration");
+
+  // a cached fragment is the complete pruned property graph, from which the graph certificate cannot be output
+  if (!fragment_cache.empty() && (early_enabled || pipeline || certificate == CERTIFICATE_GRAPH))
+    throw std::invalid_argument("The fragment cache cannot be combined with -i, --pipeline or a graph certificate");
+
+  // covering checks explore the merged system alone, with their own clock bounds and zones
+  if (check_engine == CHECK_ENGINE_COVREACH && (por || bitstate_size != 0 || bidirectional))
+    throw std::invalid_argument("Covering compositional checks do not support --por, --bitstate or --bidirectional");
+
+  // pipelined checks run the merged systems concurrently with the exploration, they are not decomposed
+  if (compos_levels > 1 && pipeline)
+    throw std::invalid_argument("Several levels of decomposition cannot be combined with --pipeline");
+
+  if (early_enabled || pipeline) {
     iteration_num = 1;
   } else {
     iteration_num = -1;
   }
 
-  std::chrono::time_point<std::chrono::steady_clock> pi_start_time = std::chrono::steady_clock::now();
+  // the declarations imported in merged systems are collected once for all iterations
+  tchecker::tck_reach::merge_inputs_t const merge_inputs{sysdecl, envdecl, propertydecl};
+
+  compos_stats.set_start_time();
+
+  // all exit points output the same block of statistics
+  auto output_stats = [&]() {
+    compos_stats.set_end_time();
+    if (result != nullptr) {
+      *result = compos_stats;
+      return;
+    }
+    std::map<std::string, std::string> m;
+    compos_stats.attributes(m);
+    if (!property.empty())
+      m["PROPERTY"] = property;
+    tchecker::algorithms::output_attributes(stats_os, m, stats_format, ": ");
+  };
+
+  // the exploration is resumed from its frontier after an early termination
+  tchecker::collection_trigger_t const collection{gc_allocations, std::chrono::milliseconds{gc_interval}};
+
+  // zones are stored once for the history-aware zone graph and the zone graphs of compositional checks
+  std::shared_ptr<tchecker::zg::zone_registry_t> zones{new tchecker::zg::zone_registry_t{block_size, table_size}};
+
+  // the clock bounds of the system are computed once for all the compositional checks
+  std::shared_ptr<tchecker::clockbounds::cache_t> clock_bounds = clock_bounds_cache;
+
+  // the exploration and the checks each hold a copy of the budget as checks may run concurrently with the
+  // exploration. They share the deadline
+  tchecker::algorithms::budget_t const check_budget = budget();
+
+  // checks of the product of the system with the current fragment of the property graph, one per engine of
+  // --check-engine. A check is timed by the thread that runs it, as pipelined checks run concurrently with the
+  // other phases. The counter example of a check is extracted from its graph, and output when the check is
+  // collected. Statistics of the engines are reported as statistics of reach
+  using check_result_t =
+      std::tuple<tchecker::algorithms::reach::stats_t, tchecker::algorithms::phase_stats_t, std::string>;
+  using check_decl_t = std::shared_ptr<tchecker::parsing::system_declaration_t>;
+  using check_zones_t = std::shared_ptr<tchecker::zg::zone_registry_t>;
+
+  auto reach_check = [=](check_decl_t const & check_decl, check_zones_t const & check_zones, std::ostream & cex_os) {
+    auto && [check_stats, check_graph] =
+        tchecker::tck_reach::zg_reach_compos::run(sysdecl, check_decl, labels, search_order, block_size, table_size,
+                                                  threads, bitstate_size, collection, check_zones, por,
+                                                  check_extrapolation, clock_bounds, bidirectional, check_budget);
+    if ((certificate == CERTIFICATE_CONCRETE) && check_stats.reachable()) {
+      std::unique_ptr<tchecker::tck_reach::zg_reach_compos::cex::concrete_cex_t> cex{
+          tchecker::tck_reach::zg_reach_compos::cex::concrete_counter_example(*check_graph)};
+      if (cex->empty())
+        throw std::runtime_error("Unable to compute a concrete counter example");
+      tchecker::tck_reach::zg_reach_compos::cex::dot_output(cex_os, *cex, propertydecl->name());
+    }
+    else if ((certificate == CERTIFICATE_SYMBOLIC) && check_stats.reachable()) {
+      std::unique_ptr<tchecker::tck_reach::zg_reach_compos::cex::symbolic_cex_t> cex{
+          tchecker::tck_reach::zg_reach_compos::cex::symbolic_counter_example(*check_graph)};
+      if (cex->empty())
+        throw std::runtime_error("Unable to compute a symbolic counter example");
+      tchecker::tck_reach::zg_reach_compos::cex::dot_output(cex_os, *cex, propertydecl->name());
+    }
+    return check_stats;
+  };
+
+  // the merged system declares the clocks and the integer variables of the system that it uses, hence it is checked
+  // on its own
+  auto covreach_check = [=](check_decl_t const & check_decl, check_zones_t const &, std::ostream & cex_os) {
+    auto && [covreach_stats, check_graph] = tchecker::tck_reach::zg_covreach::run(
+        check_decl, labels, search_order, cover, block_size, table_size, check_budget);
+    if ((certificate == CERTIFICATE_CONCRETE) && covreach_stats.reachable()) {
+      std::unique_ptr<tchecker::tck_reach::zg_covreach::cex::concrete_cex_t> cex{
+          tchecker::tck_reach::zg_covreach::cex::concrete_counter_example(*check_graph)};
+      if (cex->empty())
+        throw std::runtime_error("Unable to compute a concrete counter example");
+      tchecker::tck_reach::zg_reach::cex::dot_output(cex_os, *cex, propertydecl->name());
+    }
+    else if ((certificate == CERTIFICATE_SYMBOLIC) && covreach_stats.reachable()) {
+      std::unique_ptr<tchecker::tck_reach::zg_covreach::cex::symbolic_cex_t> cex{
+          tchecker::tck_reach::zg_covreach::cex::symbolic_counter_example(*check_graph)};
+      if (cex->empty())
+        throw std::runtime_error("Unable to compute a symbolic counter example");
+      tchecker::tck_reach::zg_reach::cex::dot_output(cex_os, *cex, propertydecl->name());
+    }
+    tchecker::algorithms::reach::stats_t check_stats;
+    check_stats.visited_states() = covreach_stats.visited_states();
+    check_stats.visited_transitions() = covreach_stats.visited_transitions();
+    check_stats.reachable() = covreach_stats.reachable();
+    check_stats.budget_status() = covreach_stats.budget_status();
+    check_stats.frontier_size() = covreach_stats.frontier_size();
+    return check_stats;
+  };
+
+  std::function<tchecker::algorithms::reach::stats_t(check_decl_t const &, check_zones_t const &, std::ostream &)> const
+      check_engines[] = {reach_check, covreach_check};
+
+  auto run_check = [=](check_decl_t const & check_decl, check_zones_t const & check_zones) {
+    tchecker::algorithms::phase_stats_t phase;
+    tchecker::algorithms::phase_timer_t timer{phase};
+    std::ostringstream cex_os;
+    tchecker::algorithms::reach::stats_t const check_stats = check_engines[check_engine](check_decl, check_zones, cex_os);
+    timer.stop();
+    phase.visited_states() = check_stats.visited_states();
+    phase.visited_transitions() = check_stats.visited_transitions();
+    return check_result_t{check_stats, phase, cex_os.str()};
+  };
+
+  std::future<check_result_t> pending_check;
+  auto collect_check = [&](check_result_t const & result) {
+    auto const & [check_stats, check_phase, check_cex] = result;
+    cert_os << check_cex;
+    compos_stats.phase(tchecker::tck_reach::compos::PHASE_CHECK) += check_phase;
+    compos_stats.reachable() = check_stats.reachable();
+    if (check_stats.budget_exceeded()) {
+      compos_stats.budget_status() = check_stats.budget_status();
+      compos_stats.frontier_size() = check_stats.frontier_size();
+      return true;
+    }
+    return check_stats.reachable();
+  };
+
+  // every exit after a pipelined check may have been started joins it, and keeps its verdict and statistics
+  auto finish = [&]() {
+    if (pending_check.valid()) {
+      bool const reachable = compos_stats.reachable();
+      collect_check(pending_check.get());
+      compos_stats.reachable() = compos_stats.reachable() || reachable;
+    }
+    output_stats();
+  };
+
+  // the merged system is decomposed again while levels remain, with a strict decomposition so that the property
+  // grows at each level. The merged system is checked when its environment cannot be split
+  auto check_fragment = [&](std::shared_ptr<tchecker::parsing::system_declaration_t> const & check_decl) {
+    std::shared_ptr<tchecker::parsing::system_declaration_t> next_sysdecl, next_propertydecl, next_envdecl;
+    if (level < compos_levels) {
+      try {
+        tchecker::ta::decomposition_t const decomposition =
+            tchecker::ta::decompose(tchecker::ta::system_t{*check_decl}, labels, true);
+        std::tie(next_sysdecl, next_propertydecl, next_envdecl) = tchecker::ta::split(*check_decl, decomposition);
+      }
+      catch (std::invalid_argument const &) {
+        next_sysdecl = nullptr;
+      }
+    }
+    if (next_sysdecl == nullptr)
+      return collect_check(run_check(check_decl, zones));
+
+    tchecker::tck_reach::compos::stats_t next_stats;
+    compos(next_sysdecl, next_propertydecl, next_envdecl, stats_os, cert_os, "", level + 1, &next_stats);
+    for (std::size_t i = 0; i < tchecker::tck_reach::compos::PHASE_COUNT; ++i) {
+      enum tchecker::tck_reach::compos::phase_t const phase = static_cast<enum tchecker::tck_reach::compos::phase_t>(i);
+      compos_stats.phase(phase) += next_stats.phase(phase);
+    }
+    compos_stats.iterations() += next_stats.iterations();
+    compos_stats.backward_des_states() += next_stats.backward_des_states();
+    compos_stats.levels() = std::max(compos_stats.levels(), next_stats.levels() + 1);
+    compos_stats.reachable() = next_stats.reachable();
+    if (next_stats.budget_exceeded()) {
+      compos_stats.budget_status() = next_stats.budget_status();
+      compos_stats.frontier_size() = next_stats.frontier_size();
+      return true;
+    }
+    return next_stats.reachable();
+  };
+
+  std::string const key = (fragment_cache.empty() ? "" : fragment_key(merge_inputs, *propertydecl));
+  if (!key.empty()) {
+    std::string status;
+    std::shared_ptr<tchecker::parsing::system_declaration_t> check_decl;
+    if (load_fragment(key, status, check_decl)) {
+      if (status == "FRAGMENT")
+        check_fragment(check_decl);
+      else
+        compos_stats.reachable() = (status == "REACHABLE");
+      finish();
+      return;
+    }
+  }
+
+  tchecker::tck_reach::zg_history_aware::exploration_t exploration(propertydecl, envdecl, labels, search_order, block_size,
+                                                                   table_size, threads, covering, collection, zones,
+                                                                   ha_extrapolation, budget());
+  graph = exploration.graph();
 
   do {
 
     early_termination = false;
 
-    std::tie(stats, graph) = tchecker::tck_reach::zg_history_aware::run(
-        propertydecl, envdecl, pi_nodes, early_termination, labels, search_order, block_size, table_size, iteration_num);
+    {
+      tchecker::algorithms::phase_timer_t timer{compos_stats.phase(tchecker::tck_reach::compos::PHASE_FORWARD)};
+      stats = exploration.resume(pi_nodes, early_termination, iteration_num);
 
-    // stats
-    std::map<std::string, std::string> m;
-    stats.attributes(m);
-    for (auto && [key, value] : m) {
-      if (key == "VISITED_STATES")
-        cumulative_visited_states += std::stoull(value);
-      else if (key == "VISITED_TRANSITIONS")
-        cumulative_visited_transition += std::stoull(value);
-      else if (key == "REACHABLE")
-        reachable = value;
+      // backward analysis starts from every final node found so far, on a fresh reachability status
+      std::queue<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t>().swap(pi_nodes);
+      exploration.restart_backward_analysis(pi_nodes);
     }
 
+    ++compos_stats.iterations();
+    compos_stats.phase(tchecker::tck_reach::compos::PHASE_FORWARD).visited_states() += stats.visited_states();
+    compos_stats.phase(tchecker::tck_reach::compos::PHASE_FORWARD).visited_transitions() += stats.visited_transitions();
+    compos_stats.memory_usage() = stats.memory_usage();
+
     // certificate
     if (certificate == CERTIFICATE_GRAPH)
-      tchecker::tck_reach::zg_history_aware::dot_output(*os, *graph, propertydecl->name());
+      tchecker::tck_reach::zg_history_aware::dot_output(cert_os, *graph, propertydecl->name(), lexical_graph);
     else if ((certificate == CERTIFICATE_CONCRETE) && stats.reachable()) {
       std::unique_ptr<tchecker::tck_reach::zg_history_aware::cex::concrete_cex_t> cex{
           tchecker::tck_reach::zg_history_aware::cex::concrete_counter_example(*graph)};
       if (cex->empty())
         throw std::runtime_error("Unable to compute a concrete counter example");
-      tchecker::tck_reach::zg_history_aware::cex::dot_output(*os, *cex, propertydecl->name());
+      tchecker::tck_reach::zg_history_aware::cex::dot_output(cert_os, *cex, propertydecl->name());
     }
     else if ((certificate == CERTIFICATE_SYMBOLIC) && stats.reachable()) {
       std::unique_ptr<tchecker::tck_reach::zg_history_aware::cex::symbolic_cex_t> cex{
           tchecker::tck_reach::zg_history_aware::cex::symbolic_counter_example(*graph)};
       if (cex->empty())
         throw std::runtime_error("Unable to compute a symbolic counter example");
-      tchecker::tck_reach::zg_history_aware::cex::dot_output(*os, *cex, propertydecl->name());
+      tchecker::tck_reach::zg_history_aware::cex::dot_output(cert_os, *cex, propertydecl->name());
+    }
+
+    // the property graph is incomplete, hence it cannot be checked
+    if (stats.budget_exceeded()) {
+      compos_stats.budget_status() = stats.budget_status();
+      compos_stats.frontier_size() = stats.frontier_size();
+      break;
     }
 
     if (pi_nodes.empty()) {
-      std::chrono::time_point<std::chrono::steady_clock> pi_end_time = std::chrono::steady_clock::now();
-      std::chrono::duration<double> pi_duration = pi_end_time - pi_start_time;
-
-      std::cout << "REACHABLE: " << "false" << std::endl;
-      std::cout << "TOTAL_RUNNING_TIME: " << pi_duration.count() << std::endl;
-      std::cout << "TOTAL_VISITED_STATES: " << cumulative_visited_states << std::endl;
-      std::cout << "TOTAL_VISITED_TRANSITIONS: " << cumulative_visited_transition << std::endl;
-      std::cout << "BACKWARD_DES_STATES: N/A" << std::endl;
-      std::cout << "BACKWARD_REACH_STATES N/A" << std::endl;
+      if (!key.empty())
+        store_fragment(key, "UNREACHABLE");
+      finish();
       return;
     }
 
-    std::unordered_set<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t> reachable_waiting_list;
-    std::unordered_set<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t> reachable_visited_list;
-
-    auto [status, new_count, propagation_visited_states, propagation_visited_transitions] = backward_propagation(graph, pi_nodes, reachable_waiting_list, reachable_visited_list);
-
-    cumulative_visited_states += propagation_visited_states;
-    cumulative_visited_transition += propagation_visited_transitions;
+    auto [status, new_count] =
+        backward_analysis(graph, pi_nodes, compos_stats.phase(tchecker::tck_reach::compos::PHASE_BACKWARD_PROPAGATION),
+                          compos_stats.phase(tchecker::tck_reach::compos::PHASE_BACKWARD_REACHABILITY));
+    compos_stats.backward_des_states() += new_count;
 
     if (status) {
-      std::chrono::time_point<std::chrono::steady_clock> pi_end_time = std::chrono::steady_clock::now();
-      std::chrono::duration<double> pi_duration = pi_end_time - pi_start_time;
-
-      std::cout << "REACHABLE: " << status << std::endl;
-      std::cout << "TOTAL_RUNNING_TIME: " << pi_duration.count() << std::endl;
-      std::cout << "TOTAL_VISITED_STATES: " << cumulative_visited_states << std::endl;
-      std::cout << "TOTAL_VISITED_TRANSITIONS: " << cumulative_visited_transition << std::endl;
-      std::cout << "BACKWARD_DES_STATES: " << new_count << std::endl;
-      std::cout << "BACKWARD_REACH_STATES N/A" << std::endl;
+      if (!key.empty())
+        store_fragment(key, "REACHABLE");
+      compos_stats.reachable() = true;
+      finish();
       return;
     }
-    auto [reachability_visited_states, reachability_visited_transitions] = backward_reachability(graph, reachable_waiting_list, reachable_visited_list);
 
-    cumulative_visited_states += reachability_visited_states;
-    cumulative_visited_transition += reachability_visited_transitions;
+    // the nodes pruned by backward propagation, and the states only used by them, are reclaimed
+    {
+      tchecker::algorithms::phase_timer_t timer{compos_stats.phase(tchecker::tck_reach::compos::PHASE_COLLECTION)};
+      exploration.collect();
+    }
 
     uint32_t nodes_count;
+    tchecker::algorithms::phase_timer_t declaration_timer{compos_stats.phase(tchecker::tck_reach::compos::PHASE_DECLARATION)};
     std::shared_ptr<tchecker::parsing::system_declaration_t> check_decl{
-        tchecker::tck_reach::graph_parser(input_file, env_file, propertydecl, graph, os, nodes_count)};
-    auto && [stats_final, graph_final] =
-        tchecker::tck_reach::zg_reach_compos::run(sysdecl, check_decl, labels, search_order, block_size, table_size);
-
-    // stats
-    std::map<std::string, std::string> m_final;
-    stats_final.attributes(m_final);
-    for (auto && [key, value] : m_final) {
-      if (key == "VISITED_STATES")
-        cumulative_visited_states += std::stoull(value);
-      else if (key == "VISITED_TRANSITIONS")
-        cumulative_visited_transition += std::stoull(value);
-      else if (key == "REACHABLE")
-        reachable = value;
-    }
-
-    if (reachable == "true") {
-      break;
+        tchecker::tck_reach::graph_parser(merge_inputs, graph, &cert_os, nodes_count, merge_flag, minimize,
+                                          lexical_graph, threads, reduce_clocks)};
+    declaration_timer.stop();
+
+    if (!key.empty())
+      store_fragment(key, "FRAGMENT", check_decl.get());
+
+    if (pipeline) {
+      // the check of the previous fragment has run while this fragment was computed
+      if (pending_check.valid() && collect_check(pending_check.get()))
+        break;
+    }
+
+    // check_decl does not refer to graph, hence a pipelined check can run on its own systems while the exploration
+    // resumes. The last fragment (complete exploration) is checked right away. Zones are only shared with the
+    // exploration if stores of zones are thread-safe (see TCHECKER_THREAD_SAFE_ZONES)
+    if (pipeline && early_termination) {
+      check_zones_t const check_zones = (tchecker::zg::zone_store_t::THREAD_SAFE ? zones : nullptr);
+      pending_check = std::async(std::launch::async, [=]() { return run_check(check_decl, check_zones); });
     }
+    else if (check_fragment(check_decl))
+      break;
 
     // clear Pi nodes
     std::queue<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t>().swap(pi_nodes);
 
-    // set the next iteration number
-    iteration_num = -1;         // one iteration is enough
+    // set the next iteration number: the fragment was spurious, the next check waits for geometrically more final
+    // nodes, so that proofs need a logarithmic number of checks while bugs are still found early
+    if (iteration_growth == 0 || iteration_num < 0 ||
+        iteration_num > std::numeric_limits<long long int>::max() / static_cast<long long int>(iteration_growth))
+      iteration_num = -1;
+    else
+      iteration_num *= static_cast<long long int>(iteration_growth);
 
   } while (early_termination);
 
-  std::chrono::time_point<std::chrono::steady_clock> pi_end_time = std::chrono::steady_clock::now();
-  std::chrono::duration<double> pi_duration = pi_end_time - pi_start_time;
+  finish();
+}
 
-  std::cout << "REACHABLE: " << reachable << std::endl;
-  std::cout << "TOTAL_RUNNING_TIME: " << pi_duration.count() << std::endl;
-  std::cout << "TOTAL_VISITED_STATES: " << cumulative_visited_states << std::endl;
-  std::cout << "TOTAL_VISITED_TRANSITIONS: " << cumulative_visited_transition << std::endl;
+/*!
+ \brief Compositional reachability of a batch of properties
+ \param sysdecl : system declaration
+ \param properties : property files
+ \param propertydecls : property declarations (one per file in properties)
+ \param envdecl : environment declaration
+ \post the properties have been checked by compos, jobs of them concurrently. The statistics of each property
+ (with attribute PROPERTY) have been output to standard output, and its certificates to os, in the order of
+ properties. The system and environment declarations, and the clock bounds of the system, are shared by all the
+ checks
+ \return true if all the checks have completed, false if one has failed (its error has been reported)
+ */
+static bool compos_batch(const std::shared_ptr<tchecker::parsing::system_declaration_t> & sysdecl,
+                         std::vector<std::string> const & properties,
+                         std::vector<std::shared_ptr<tchecker::parsing::system_declaration_t>> const & propertydecls,
+                         const std::shared_ptr<tchecker::parsing::system_declaration_t> & envdecl)
+{
+  assert(properties.size() == propertydecls.size());
+
+  std::size_t const count = properties.size();
+  std::vector<std::ostringstream> stats_os(count), cert_os(count);
+  std::vector<std::string> errors(count);
+
+  // each worker checks the next property that has not been taken yet
+  std::atomic<std::size_t> next{0};
+  auto worker = [&]() {
+    for (std::size_t i = next++; i < count; i = next++) {
+      try {
+        compos(sysdecl, propertydecls[i], envdecl, stats_os[i], cert_os[i], properties[i]);
+      }
+      catch (std::exception & e) {
+        errors[i] = e.what();
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (std::size_t j = 1; j < std::min(jobs, count); ++j)
+    workers.emplace_back(worker);
+  worker();
+  for (std::thread & t : workers)
+    t.join();
+
+  bool success = true;
+  for (std::size_t i = 0; i < count; ++i) {
+    *os << cert_os[i].str();
+    std::cout << stats_os[i].str();
+    if (!errors[i].empty()) {
+      std::cerr << tchecker::log_error << properties[i] << ": " << errors[i] << std::endl;
+      success = false;
+    }
+  }
+  return success;
 }
 
 /*!
- \brief Main function
-*/
-int main(int argc, char * argv[])
+ \brief Portfolio of algorithms
+ \param sysdecl : system declaration
+ \param propertydecl : property declaration of compos (nullptr: compos is not run)
+ \param envdecl : environment declaration of compos
+ \post reach, covreach and compos (if propertydecl is not nullptr) have been run concurrently on sysdecl, each one on
+ its own thread and with its own copy of the budget from the command line. The first algorithm that has completed
+ has cancelled the other ones, and its statistics have been output to standard output with attribute ENGINE. If no
+ algorithm has completed within the budget, the statistics of the first algorithm that has stopped have been output
+ with ENGINE none
+ \throw std::invalid_argument : if a certificate is required, or if the options cannot be combined
+ \throw std::runtime_error : if every algorithm has failed
+ \note the algorithms share the declarations and the clock bounds of the system. covreach runs without the reductions
+ and the parallel exploration of reach
+ \note the memory limit bounds the resident set size of the process, which the algorithms share: an algorithm that
+ exceeds it stops and releases its memory to the other algorithms
+ */
+static void portfolio(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl,
+                      std::shared_ptr<tchecker::parsing::system_declaration_t> const & propertydecl,
+                      std::shared_ptr<tchecker::parsing::system_declaration_t> const & envdecl)
 {
-  try {
-    int optindex = parse_command_line(argc, argv);
+  if (certificate != CERTIFICATE_NONE)
+    throw std::invalid_argument("No certificate can be computed by the portfolio");
+  if (symmetry && por)
+    throw std::invalid_argument("Symmetry reduction and partial-order reduction cannot be combined");
+
+  std::shared_ptr<tchecker::parsing::system_declaration_t> const decl =
+      (slice ? tchecker::ta::cone_of_influence(*sysdecl, labels) : sysdecl);
+
+  // each algorithm yields its statistics, the separator of its output, and whether it has stopped within its budget
+  using result_t = std::tuple<std::map<std::string, std::string>, std::string, bool>;
+  using engine_t = std::function<result_t(tchecker::algorithms::budget_t const &)>;
+  std::vector<std::pair<std::string, engine_t>> engines;
+
+  engines.emplace_back("reach", [&](tchecker::algorithms::budget_t const & b) {
+    auto && [stats, graph] = tchecker::tck_reach::zg_reach::run(
+        decl, labels, search_order, block_size, table_size, b, bitstate_size, por, symmetry, active_clocks, threads,
+        false, "", std::chrono::milliseconds{0}, "", tchecker::algorithms::reach::EDGES_NONE, on_the_fly);
+    std::map<std::string, std::string> m;
+    stats.attributes(m);
+    return result_t{m, " ", !stats.budget_exceeded()};
+  });
+
+  engines.emplace_back("covreach", [&](tchecker::algorithms::budget_t const & b) {
+    auto && [stats, graph] =
+        tchecker::tck_reach::zg_covreach::run(decl, labels, search_order, cover, block_size, table_size, b);
+    std::map<std::string, std::string> m;
+    stats.attributes(m);
+    if (cover_stats)
+      stats.cover_attributes(m);
+    return result_t{m, " ", !stats.budget_exceeded()};
+  });
+
+  if (propertydecl != nullptr)
+    engines.emplace_back("compos", [&](tchecker::algorithms::budget_t const & b) {
+      // compos gets its budget from budget(), also in its nested levels
+      runner_budget = &b;
+      tchecker::tck_reach::compos::stats_t stats;
+      std::ostringstream cert_os;
+      compos(sysdecl, propertydecl, envdecl, cert_os, cert_os, "", 1, &stats);
+      runner_budget = nullptr;
+      std::map<std::string, std::string> m;
+      stats.attributes(m);
+      return result_t{m, ": ", !stats.budget_exceeded()};
+    });
+
+  std::size_t const count = engines.size();
+  std::shared_ptr<tchecker::algorithms::cancellation_token_t> cancellation{new tchecker::algorithms::cancellation_token_t};
+  // the budgets are built before the algorithms start, hence they share the deadline
+  std::vector<tchecker::algorithms::budget_t> budgets;
+  for (std::size_t i = 0; i < count; ++i)
+    budgets.emplace_back(max_states, std::chrono::milliseconds{timeout * 1000}, memory_limit, progress(), cancellation);
+
+  std::vector<result_t> results(count);
+  std::vector<std::string> errors(count);
+  std::vector<std::size_t> stopped; // algorithms that have stopped, in order
+  std::mutex mutex;
+  std::size_t winner = count;
+
+  auto runner = [&](std::size_t i) {
+    try {
+      results[i] = engines[i].second(budgets[i]);
+    }
+    catch (std::exception & e) {
+      errors[i] = e.what();
+    }
+    std::lock_guard<std::mutex> lock{mutex};
+    if (!errors[i].empty())
+      return;
+    stopped.push_back(i);
+    if (winner == count && std::get<2>(results[i])) {
+      winner = i;
+      cancellation->cancel();
+    }
+  };
+
+  std::vector<std::thread> runners;
+  for (std::size_t i = 1; i < count; ++i)
+    runners.emplace_back(runner, i);
+  runner(0);
+  for (std::thread & t : runners)
+    t.join();
+
+  for (std::size_t i = 0; i < count; ++i)
+    if (!errors[i].empty())
+      std::cerr << tchecker::log_warning << engines[i].first << ": " << errors[i] << std::endl;
+
+  if (stopped.empty())
+    throw std::runtime_error("Every algorithm of the portfolio has failed");
+
+  std::size_t const output = (winner == count ? stopped.front() : winner);
+  auto & [m, separator, completed] = results[output];
+  m["ENGINE"] = (winner == count ? "none" : engines[winner].first);
+  tchecker::algorithms::output_attributes(std::cout, m, stats_format, separator);
+
+  if (winner == count)
+    std::cerr << tchecker::log_warning << "no algorithm has completed within the budget, the verdict is unknown"
+              << std::endl;
+}
 
+/*!
+ \brief Verification
+ \param argc : number of arguments
+ \param argv : array of arguments
+ \param optindex : index of the first argument that is not an option
+ \pre argv has been parsed by parse_command_line
+ \post the algorithm selected by the command line has been run
+ \return the exit status of tck-reach
+ */
+int verify(int argc, char * argv[], int optindex)
+{
+  try {
     if (argc - optindex > 1) {
       std::cerr << "Too many input files" << std::endl;
       usage(argv[0]);
       return EXIT_FAILURE;
     }
 
-    if ((certificate == CERTIFICATE_CONCRETE) && (algorithm != ALGO_REACH)) {
-      std::cerr << "Concrete counter-example is only available for algorithm reach" << std::endl;
+    if (binary_graph && (algorithm != ALGO_REACH)) {
+      std::cerr << "Binary graph certificate is only available for algorithm reach" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if ((checkpoint_period != 0 || !resume_file.empty()) && (algorithm != ALGO_REACH)) {
+      std::cerr << "Checkpoints are only available for algorithm reach" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if (!state_store.empty() && (algorithm != ALGO_REACH)) {
+      std::cerr << "State stores are only available for algorithm reach" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if (auto_split && (algorithm != ALGO_COMPOS) && (algorithm != ALGO_PORTFOLIO)) {
+      std::cerr << "Automatic split is only available for algorithms compos and portfolio" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if (auto_split && (property_file != "" || env_file != "")) {
+      std::cerr << "Automatic split cannot be combined with property and environment files" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // the property and environment declarations of compos refer to the edges of the system
+    if (prune && (algorithm == ALGO_COMPOS || algorithm == ALGO_PORTFOLIO)) {
+      std::cerr << "Removal of dead edges is not available for algorithms compos and portfolio" << std::endl;
       return EXIT_FAILURE;
     }
 
@@ -532,19 +2474,57 @@ int main(int argc, char * argv[])
 
     std::string input_file = (optindex == argc ? "" : argv[optindex]);
 
-    std::shared_ptr<tchecker::parsing::system_declaration_t> sysdecl{load_system_declaration(input_file)};
-    std::shared_ptr<tchecker::parsing::system_declaration_t> propertydecl{load_system_declaration(property_file)};
-    std::shared_ptr<tchecker::parsing::system_declaration_t> envdecl{load_system_declaration(env_file)};
+    std::shared_ptr<tchecker::parsing::system_declaration_t> sysdecl{system_declaration(input_file)};
+    std::vector<std::string> const properties = property_files(property_file);
+    if (properties.size() > 1 && algorithm != ALGO_COMPOS) {
+      std::cerr << "Several properties can only be checked by algorithm compos" << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::vector<std::shared_ptr<tchecker::parsing::system_declaration_t>> propertydecls;
+    for (std::string const & property : properties)
+      propertydecls.push_back(system_declaration(property));
+    // the environment of --auto-split is computed from the system
+    std::shared_ptr<tchecker::parsing::system_declaration_t> envdecl{auto_split ? nullptr : system_declaration(env_file)};
 
     if (tchecker::log_error_count() > 0)
       return EXIT_FAILURE;
 
+    if (auto_split) {
+      tchecker::ta::decomposition_t const decomposition =
+          tchecker::ta::decompose(tchecker::ta::system_t{*sysdecl}, labels);
+      std::shared_ptr<tchecker::parsing::system_declaration_t> propertydecl;
+      std::tie(sysdecl, propertydecl, envdecl) = tchecker::ta::split(*sysdecl, decomposition);
+      propertydecls.push_back(propertydecl);
+      std::cerr << "Property:";
+      for (auto const * d : propertydecl->declarations())
+        if (auto const * p = dynamic_cast<tchecker::parsing::process_declaration_t const *>(d))
+          std::cerr << " " << p->name();
+      std::cerr << " (interface: " << decomposition.interface_size() << ", clocks: " << decomposition.property_clocks
+                << " in the property, " << decomposition.environment_clocks << " in the environment)" << std::endl;
+    }
+
+    if (prune)
+      sysdecl = tchecker::ta::prune_dead_edges(*sysdecl);
+
+    if (emit_cpp_file != "") {
+      emit_cpp(sysdecl, emit_cpp_file);
+      return EXIT_SUCCESS;
+    }
+
+    for (std::string const & library : native_libraries)
+      load_native(library);
+
+    if (jit)
+      jit_compile(sysdecl);
+
     std::shared_ptr<std::ofstream> os_ptr{nullptr};
+    std::shared_ptr<tchecker::async_ostream_t> async_os_ptr{nullptr}; // certificate files are written in background
 
     if (certificate != CERTIFICATE_NONE && output_file != "") {
       try {
-        os_ptr = std::make_shared<std::ofstream>(output_file);
-        os = os_ptr.get();
+        os_ptr = std::make_shared<std::ofstream>(output_file, std::ios::out | std::ios::binary);
+        async_os_ptr = std::make_shared<tchecker::async_ostream_t>(*os_ptr);
+        os = async_os_ptr.get();
       }
       catch (std::exception & e) {
         std::cerr << tchecker::log_error << e.what() << std::endl;
@@ -556,12 +2536,37 @@ int main(int argc, char * argv[])
     case ALGO_REACH:
       reach(sysdecl);
       break;
+    case ALGO_BMC:
+      bmc(sysdecl);
+      break;
+    case ALGO_COVREACH:
+      covreach(sysdecl);
+      break;
+    case ALGO_CONCUR19:
+      concur19(sysdecl);
+      break;
+    case ALGO_BACKWARD:
+      backward(sysdecl);
+      break;
+    case ALGO_PORTFOLIO:
+      // the property of --auto-split follows the declaration of -P
+      portfolio(sysdecl, (auto_split || !property_file.empty() ? propertydecls.back() : nullptr), envdecl);
+      break;
     case ALGO_COMPOS:
-      compos(input_file, sysdecl, propertydecl, envdecl);
+      if (auto_split || properties.size() == 1)
+        compos(sysdecl, propertydecls.front(), envdecl, std::cout, *os);
+      else if (!compos_batch(sysdecl, properties, propertydecls, envdecl)) {
+        if (async_os_ptr != nullptr)
+          async_os_ptr->close();
+        return EXIT_FAILURE;
+      }
       break;
     default:
       throw std::runtime_error("No algorithm specified");
     }
+
+    if (async_os_ptr != nullptr)
+      async_os_ptr->close();
   }
   catch (std::exception & e) {
     std::cerr << tchecker::log_error << e.what() << std::endl;
@@ -570,3 +2575,193 @@ int main(int argc, char * argv[])
 
   return EXIT_SUCCESS;
 }
+
+/*!
+ \brief Files of a query
+ \param args : arguments of a query (args[0] is the program name)
+ \return the input file, the property files and the environment file named by the options in args
+ \note the global variables are not modified
+ */
+static std::vector<std::string> query_files(std::vector<char *> & args)
+{
+  std::vector<std::string> files;
+  int const argc = static_cast<int>(args.size()) - 1; // args ends with nullptr
+  optind = 0;
+  opterr = 0;
+  while (true) {
+    int long_option_index = -1;
+    int c = getopt_long(argc, args.data(), options, long_options, &long_option_index);
+    if (c == -1)
+      break;
+    if (c == 'P' && optarg != nullptr) {
+      // a manifest that cannot be read is reported by the query
+      try {
+        std::vector<std::string> const properties = property_files(optarg);
+        files.insert(files.end(), properties.begin(), properties.end());
+      }
+      catch (std::exception &) {
+      }
+    }
+    else if (c == 'E' && optarg != nullptr)
+      files.push_back(optarg);
+  }
+  for (int i = optind; i < argc; ++i)
+    files.push_back(args[i]);
+  opterr = 1;
+  return files;
+}
+
+/*!
+ \brief Verification server
+ \param socket_path : path of the Unix socket
+ \post queries have been served on socket_path until the process is terminated. Each connection sends one line
+ of options and files, and receives the output (standard output and standard error) of tck-reach on them. The
+ line is split at blanks, hence file names cannot contain blanks
+ \return EXIT_FAILURE if the socket cannot be set up
+ \note each query runs in a child process that starts from the state of the server: the options of its command
+ line are added to the options of the server, and the models that have not changed since the previous queries are
+ neither read nor built again. The models are identified by the hash value of their content: a model that has
+ changed is parsed again, and its clock bounds are computed again. Queries run concurrently
+ */
+static int serve(std::string const & socket_path)
+{
+  int const listening = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listening == -1) {
+    std::cerr << tchecker::log_error << "cannot create socket: " << std::strerror(errno) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  struct sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (socket_path.size() >= sizeof(address.sun_path)) {
+    std::cerr << tchecker::log_error << "socket path is too long: " << socket_path << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+  ::unlink(socket_path.c_str());
+  if (::bind(listening, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) == -1 ||
+      ::listen(listening, 64) == -1) {
+    std::cerr << tchecker::log_error << "cannot listen on " << socket_path << ": " << std::strerror(errno) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // queries are not waited for
+  std::signal(SIGCHLD, SIG_IGN);
+
+  // content hash and declaration of the models, by file name
+  std::map<std::string, std::tuple<std::size_t, std::shared_ptr<tchecker::parsing::system_declaration_t>>> models;
+
+  while (true) {
+    int const connection = ::accept(listening, nullptr, nullptr);
+    if (connection == -1) {
+      if (errno == EINTR)
+        continue;
+      std::cerr << tchecker::log_error << "cannot accept connection: " << std::strerror(errno) << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::string line;
+    char c;
+    while (::read(connection, &c, 1) == 1 && c != '\n')
+      line += c;
+
+    std::vector<std::string> words{"tck-reach"};
+    std::istringstream iss{line};
+    for (std::string word; iss >> word;)
+      words.push_back(word);
+    std::vector<char *> args;
+    for (std::string & word : words)
+      args.push_back(word.data());
+    args.push_back(nullptr);
+
+    // models are loaded by the server, hence by all the following queries (errors are reported by the query)
+    resident_declarations.clear();
+    std::vector<std::string> const files = query_files(args);
+    for (std::size_t i = 0; i < files.size(); ++i) {
+      std::ifstream ifs{files[i], std::ios::in | std::ios::binary};
+      if (!ifs)
+        continue;
+      std::string const content{std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+      std::size_t const hash = std::hash<std::string>{}(content);
+
+      auto it = models.find(files[i]);
+      if (it == models.end() || std::get<0>(it->second) != hash) {
+        std::streambuf * cerr_buf = std::cerr.rdbuf(nullptr);
+        std::shared_ptr<tchecker::parsing::system_declaration_t> decl{load_system_declaration(files[i])};
+        // the system is the last file, its clock bounds are used by the compositional checks
+        if (decl != nullptr && tchecker::log_error_count() == 0 && i + 1 == files.size()) {
+          try {
+            tchecker::ta::system_t const system{*decl};
+            clock_bounds_cache->clockbounds(decl, system);
+          }
+          catch (...) {
+          }
+        }
+        std::cerr.rdbuf(cerr_buf);
+        if (decl == nullptr || tchecker::log_error_count() > 0) {
+          tchecker::log_reset_count();
+          models.erase(files[i]);
+          continue;
+        }
+        it = models.insert_or_assign(files[i], std::make_tuple(hash, decl)).first;
+      }
+      resident_declarations[files[i]] = std::get<1>(it->second);
+    }
+
+    // clock bounds of the models that have changed are released from time to time
+    if (clock_bounds_cache->size() > 2 * models.size() + 16) {
+      clock_bounds_cache.reset(new tchecker::clockbounds::cache_t);
+      for (auto && [filename, model] : models)
+        if (std::get<1>(model) != nullptr) {
+          try {
+            tchecker::ta::system_t const system{*std::get<1>(model)};
+            clock_bounds_cache->clockbounds(std::get<1>(model), system);
+          }
+          catch (...) {
+          }
+        }
+    }
+
+    pid_t const pid = ::fork();
+    if (pid == 0) {
+      ::close(listening);
+      ::dup2(connection, STDOUT_FILENO);
+      ::dup2(connection, STDERR_FILENO);
+      ::close(connection);
+      server_socket = "";
+      int status = EXIT_FAILURE;
+      try {
+        optind = 0;
+        int const optindex = parse_command_line(static_cast<int>(args.size()) - 1, args.data());
+        status = verify(static_cast<int>(args.size()) - 1, args.data(), optindex);
+      }
+      catch (std::exception & e) {
+        std::cerr << tchecker::log_error << e.what() << std::endl;
+      }
+      std::cout.flush();
+      std::cerr.flush();
+      ::_exit(status);
+    }
+    if (pid == -1)
+      std::cerr << tchecker::log_error << "cannot run query: " << std::strerror(errno) << std::endl;
+    ::close(connection);
+  }
+}
+
+/*!
+ \brief Main function
+*/
+int main(int argc, char * argv[])
+{
+  try {
+    int optindex = parse_command_line(argc, argv);
+    if (server_socket != "" && !help)
+      return serve(server_socket);
+    return verify(argc, argv, optindex);
+  }
+  catch (std::exception & e) {
+    std::cerr << tchecker::log_error << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,59 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/search_order.hh"
+#include "tchecker/clockbounds/solver.hh"
+#include "tchecker/system/static_analysis.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/log.hh"
+#include "zg-backward.hh"
+
+namespace tchecker {
+
+namespace tck_reach {
+
+namespace zg_backward {
+
+std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_backward::graph_t>>
+run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+    std::string const & search_order, std::size_t block_size, std::size_t table_size)
+{
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+  if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
+    std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
+
+  // clock bounds are used by the summary index of the subsumption graph
+  std::shared_ptr<tchecker::clockbounds::clockbounds_t const> clock_bounds{
+      tchecker::clockbounds::compute_clockbounds(*system)};
+  if (clock_bounds.get() == nullptr)
+    throw std::runtime_error("Unable to compute clock bounds of the system");
+
+  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, tchecker::ts::SHARING, tchecker::zg::STANDARD_SEMANTICS,
+                                                               tchecker::zg::NO_EXTRAPOLATION, block_size, table_size)};
+
+  std::shared_ptr<tchecker::tck_reach::zg_backward::graph_t> graph{new tchecker::tck_reach::zg_backward::graph_t{
+      zg, tchecker::tck_reach::zg_covreach::COVER_INCLUSION, clock_bounds, block_size, table_size}};
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  // covered nodes are removed from the waiting container
+  enum tchecker::waiting::policy_t policy = tchecker::algorithms::fast_remove_waiting_policy(search_order);
+
+  tchecker::tck_reach::zg_backward::algorithm_t algorithm;
+
+  tchecker::algorithms::covreach::stats_t stats = algorithm.run<tchecker::algorithms::covreach::COVERING_FULL>(
+      *zg, *graph, accepting_labels, policy,
+      tchecker::algorithms::priority<tchecker::tck_reach::zg_backward::graph_t::node_sptr_t>(
+          search_order, system->as_syncprod_system(), accepting_labels));
+
+  return std::make_tuple(stats, graph);
+}
+
+} // end of namespace zg_backward
+
+} // end of namespace tck_reach
+
+} // end of namespace tchecker
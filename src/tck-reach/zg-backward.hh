@@ -0,0 +1,73 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_TCK_REACH_ZG_BACKWARD_HH
+#define TCHECKER_TCK_REACH_ZG_BACKWARD_HH
+
+#include <memory>
+#include <string>
+#include <tuple>
+
+#include "tchecker/algorithms/covreach/backward.hh"
+#include "tchecker/algorithms/covreach/stats.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/zg/zg.hh"
+#include "zg-covreach.hh"
+
+/*!
+ \file zg-backward.hh
+ \brief Backward reachability algorithm over the zone graph
+ */
+
+namespace tchecker {
+
+namespace tck_reach {
+
+namespace zg_backward {
+
+/*!
+ \brief Type of subsumption graph (nodes are covered w.r.t. zone inclusion)
+ */
+using graph_t = tchecker::tck_reach::zg_covreach::graph_t;
+
+/*!
+ \class algorithm_t
+ \brief Backward covering reachability algorithm over the zone graph
+*/
+class algorithm_t : public tchecker::algorithms::covreach::backward_algorithm_t<tchecker::zg::zg_t,
+                                                                                 tchecker::tck_reach::zg_backward::graph_t> {
+public:
+  using tchecker::algorithms::covreach::backward_algorithm_t<tchecker::zg::zg_t,
+                                                              tchecker::tck_reach::zg_backward::graph_t>::backward_algorithm_t;
+};
+
+/*!
+ \brief Run backward reachability algorithm on the zone graph of a system
+ \param sysdecl : system declaration
+ \param labels : comma-separated string of labels
+ \param search_order : search order, either "dfs", "bfs", "dist" or "random"
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \pre labels must appear as node attributes in sysdecl
+ \return statistics on the run and the subsumption graph built from the final states of the zone graph of sysdecl
+ through predecessors, until a node that contains an initial state is found. Nodes are covered w.r.t. zone
+ inclusion, and edges are oriented forward, so symbolic and concrete counter-examples are computed from the graph as
+ for tchecker::tck_reach::zg_covreach::run
+ \throw std::invalid_argument : if search_order is not supported
+ \throw std::runtime_error : if the clock bounds of the system cannot be computed
+ \note zones have standard semantics and are not extrapolated: backward zones only involve the constants of the
+ system, so the exploration terminates
+ \note predecessors are computed for all the valuations of the bounded integer variables that satisfy the guards
+ */
+std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_backward::graph_t>>
+run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
+    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536);
+
+} // end of namespace zg_backward
+
+} // end of namespace tck_reach
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TCK_REACH_ZG_BACKWARD_HH
@@ -0,0 +1,246 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "counter_example.hh"
+#include "tchecker/algorithms/search_order.hh"
+#include "tchecker/clockbounds/solver.hh"
+#include "tchecker/system/static_analysis.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/log.hh"
+#include "zg-covreach.hh"
+
+namespace tchecker {
+
+namespace tck_reach {
+
+namespace zg_covreach {
+
+/* node_t */
+
+node_t::node_t(tchecker::zg::state_sptr_t const & s, bool initial, bool final)
+    : tchecker::graph::node_flags_t(initial, final), tchecker::graph::node_zg_state_t(s)
+{
+}
+
+node_t::node_t(tchecker::zg::const_state_sptr_t const & s, bool initial, bool final)
+    : tchecker::graph::node_flags_t(initial, final), tchecker::graph::node_zg_state_t(s)
+{
+}
+
+/* node_hash_t */
+
+std::size_t node_hash_t::operator()(tchecker::tck_reach::zg_covreach::node_t const & n) const
+{
+  return tchecker::ta::shared_hash_value(n.state());
+}
+
+/* node_le_t */
+
+node_le_t::node_le_t(enum tchecker::tck_reach::zg_covreach::cover_t cover,
+                     std::shared_ptr<tchecker::clockbounds::clockbounds_t const> const & clock_bounds)
+    : _cover(cover), _clock_bounds(clock_bounds), _l(nullptr), _u(nullptr), _m(nullptr),
+      _lu_cache(clock_bounds == nullptr ? nullptr : clock_bounds->local_lu_map()),
+      _m_cache(clock_bounds == nullptr ? nullptr : clock_bounds->local_m_map())
+{
+  if (_clock_bounds.get() == nullptr)
+    throw std::invalid_argument("nullptr clock bounds");
+  _l = tchecker::clockbounds::allocate_map(_clock_bounds->clock_number());
+  _u = tchecker::clockbounds::allocate_map(_clock_bounds->clock_number());
+  _m = tchecker::clockbounds::allocate_map(_clock_bounds->clock_number());
+  // global bounds do not depend on the nodes
+  if (_cover == tchecker::tck_reach::zg_covreach::COVER_ALU_GLOBAL)
+    _clock_bounds->global_lu_map()->bounds(*_l, *_u);
+  else if (_cover == tchecker::tck_reach::zg_covreach::COVER_AM_GLOBAL)
+    _clock_bounds->global_m_map()->bounds(*_m);
+}
+
+node_le_t::node_le_t(tchecker::tck_reach::zg_covreach::node_le_t const & le) : node_le_t(le._cover, le._clock_bounds) {}
+
+node_le_t::~node_le_t()
+{
+  tchecker::clockbounds::deallocate_map(_l);
+  tchecker::clockbounds::deallocate_map(_u);
+  tchecker::clockbounds::deallocate_map(_m);
+}
+
+bool node_le_t::operator()(tchecker::tck_reach::zg_covreach::node_t const & n1,
+                           tchecker::tck_reach::zg_covreach::node_t const & n2) const
+{
+  switch (_cover) {
+  case tchecker::tck_reach::zg_covreach::COVER_INCLUSION:
+    return tchecker::zg::shared_is_le(n1.state(), n2.state());
+  case tchecker::tck_reach::zg_covreach::COVER_ALU_GLOBAL:
+    return tchecker::zg::shared_is_alu_le(n1.state(), n2.state(), *_l, *_u);
+  case tchecker::tck_reach::zg_covreach::COVER_ALU_LOCAL: {
+    auto && [l, u] = _lu_cache.bounds(n2.state().vloc());
+    return tchecker::zg::shared_is_alu_le(n1.state(), n2.state(), l, u);
+  }
+  case tchecker::tck_reach::zg_covreach::COVER_AM_GLOBAL:
+    return tchecker::zg::shared_is_am_le(n1.state(), n2.state(), *_m);
+  case tchecker::tck_reach::zg_covreach::COVER_AM_LOCAL:
+    return tchecker::zg::shared_is_am_le(n1.state(), n2.state(), _m_cache.bounds(n2.state().vloc()));
+  default:
+    throw std::invalid_argument("Unknown cover relation");
+  }
+}
+
+/* edge_t */
+
+edge_t::edge_t(tchecker::zg::transition_t const & t) : tchecker::graph::edge_vedge_t(t.vedge_ptr()) {}
+
+/* graph_t */
+
+graph_t::graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, enum tchecker::tck_reach::zg_covreach::cover_t cover,
+                 std::shared_ptr<tchecker::clockbounds::clockbounds_t const> const & clock_bounds, std::size_t block_size,
+                 std::size_t table_size)
+    : tchecker::graph::subsumption::graph_t<tchecker::tck_reach::zg_covreach::node_t, tchecker::tck_reach::zg_covreach::edge_t,
+                                            tchecker::tck_reach::zg_covreach::node_hash_t,
+                                            tchecker::tck_reach::zg_covreach::node_le_t,
+                                            tchecker::zg::node_alu_summary_t<tchecker::tck_reach::zg_covreach::node_t>>(
+          block_size, table_size, tchecker::tck_reach::zg_covreach::node_hash_t(),
+          tchecker::tck_reach::zg_covreach::node_le_t(cover, clock_bounds),
+          tchecker::zg::node_alu_summary_t<tchecker::tck_reach::zg_covreach::node_t>(clock_bounds->local_lu_map())),
+      _zg(zg)
+{
+}
+
+graph_t::~graph_t()
+{
+  tchecker::graph::subsumption::graph_t<tchecker::tck_reach::zg_covreach::node_t, tchecker::tck_reach::zg_covreach::edge_t,
+                                        tchecker::tck_reach::zg_covreach::node_hash_t,
+                                        tchecker::tck_reach::zg_covreach::node_le_t,
+                                        tchecker::zg::node_alu_summary_t<tchecker::tck_reach::zg_covreach::node_t>>::clear();
+}
+
+void graph_t::attributes(tchecker::tck_reach::zg_covreach::node_t const & n, std::map<std::string, std::string> & m) const
+{
+  _zg->attributes(n.state_ptr(), m);
+  tchecker::graph::attributes(static_cast<tchecker::graph::node_flags_t const &>(n), m);
+}
+
+void graph_t::attributes(tchecker::tck_reach::zg_covreach::edge_t const & e, std::map<std::string, std::string> & m) const
+{
+  m["vedge"] = tchecker::to_string(e.vedge(), _zg->system().as_system_system());
+}
+
+/* dot_output */
+
+/*!
+ \class node_lexical_less_t
+ \brief Less-than order on nodes based on lexical ordering
+*/
+class node_lexical_less_t {
+public:
+  /*!
+   \brief Less-than order on nodes based on lexical ordering
+   \param n1 : a node
+   \param n2 : a node
+   \return true if n1 is less-than n2 w.r.t. lexical ordering over the states in
+   the nodes
+  */
+  bool operator()(tchecker::tck_reach::zg_covreach::graph_t::node_sptr_t const & n1,
+                  tchecker::tck_reach::zg_covreach::graph_t::node_sptr_t const & n2) const
+  {
+    int state_cmp = tchecker::zg::lexical_cmp(n1->state(), n2->state());
+    if (state_cmp != 0)
+      return (state_cmp < 0);
+    return (tchecker::graph::lexical_cmp(static_cast<tchecker::graph::node_flags_t const &>(*n1),
+                                         static_cast<tchecker::graph::node_flags_t const &>(*n2)) < 0);
+  }
+};
+
+/*!
+ \class edge_lexical_less_t
+ \brief Less-than ordering on edges based on lexical ordering
+ */
+class edge_lexical_less_t {
+public:
+  /*!
+   \brief Less-than ordering on edges based on lexical ordering
+   \param e1 : an edge
+   \param e2 : an edge
+   \return true if e1 is less-than  e2 w.r.t. the tuple of edges in e1 and e2
+  */
+  bool operator()(tchecker::tck_reach::zg_covreach::graph_t::edge_sptr_t const & e1,
+                  tchecker::tck_reach::zg_covreach::graph_t::edge_sptr_t const & e2) const
+  {
+    return tchecker::lexical_cmp(e1->vedge(), e2->vedge()) < 0;
+  }
+};
+
+std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_covreach::graph_t const & g, std::string const & name,
+                          bool lexical)
+{
+  if (!lexical)
+    return tchecker::graph::dot_output_stream(os, g, name);
+  return tchecker::graph::subsumption::dot_output<tchecker::tck_reach::zg_covreach::graph_t,
+                                                  tchecker::tck_reach::zg_covreach::node_lexical_less_t,
+                                                  tchecker::tck_reach::zg_covreach::edge_lexical_less_t>(os, g, name);
+}
+
+/* counter example */
+namespace cex {
+
+tchecker::tck_reach::zg_covreach::cex::symbolic_cex_t *
+symbolic_counter_example(tchecker::tck_reach::zg_covreach::graph_t const & g)
+{
+  return tchecker::tck_reach::symbolic_counter_example_zg<tchecker::tck_reach::zg_covreach::graph_t>(g);
+}
+
+tchecker::tck_reach::zg_covreach::cex::concrete_cex_t *
+concrete_counter_example(tchecker::tck_reach::zg_covreach::graph_t const & g)
+{
+  return tchecker::tck_reach::concrete_counter_example_zg<tchecker::tck_reach::zg_covreach::graph_t>(g);
+}
+
+} // namespace cex
+
+/* run */
+
+std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_covreach::graph_t>>
+run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+    std::string const & search_order, enum tchecker::tck_reach::zg_covreach::cover_t cover, std::size_t block_size,
+    std::size_t table_size, tchecker::algorithms::budget_t const & budget)
+{
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+  if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
+    std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
+
+  std::shared_ptr<tchecker::clockbounds::clockbounds_t const> clock_bounds{
+      tchecker::clockbounds::compute_clockbounds(*system)};
+  if (clock_bounds.get() == nullptr)
+    throw std::runtime_error("Unable to compute clock bounds of the system");
+
+  // abstractions are checked by the cover relation on exact zones
+  enum tchecker::zg::extrapolation_type_t extrapolation =
+      (cover == tchecker::tck_reach::zg_covreach::COVER_INCLUSION ? tchecker::zg::EXTRA_LU_PLUS_LOCAL
+                                                                  : tchecker::zg::NO_EXTRAPOLATION);
+  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, tchecker::ts::SHARING, tchecker::zg::ELAPSED_SEMANTICS,
+                                                               extrapolation, block_size, table_size)};
+
+  std::shared_ptr<tchecker::tck_reach::zg_covreach::graph_t> graph{
+      new tchecker::tck_reach::zg_covreach::graph_t{zg, cover, clock_bounds, block_size, table_size}};
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  // covered nodes are removed from the waiting container
+  enum tchecker::waiting::policy_t policy = tchecker::algorithms::fast_remove_waiting_policy(search_order);
+
+  tchecker::tck_reach::zg_covreach::algorithm_t algorithm{budget};
+
+  tchecker::algorithms::covreach::stats_t stats = algorithm.run<tchecker::algorithms::covreach::COVERING_FULL>(
+      *zg, *graph, accepting_labels, policy,
+      tchecker::algorithms::priority<tchecker::tck_reach::zg_covreach::graph_t::node_sptr_t>(
+          search_order, system->as_syncprod_system(), accepting_labels));
+
+  return std::make_tuple(stats, graph);
+}
+
+} // end of namespace zg_covreach
+
+} // end of namespace tck_reach
+
+} // end of namespace tchecker
@@ -0,0 +1,315 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_ZG_COVREACH_ALGORITHM_HH
+#define TCHECKER_ZG_COVREACH_ALGORITHM_HH
+
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <tuple>
+
+#include "tchecker/algorithms/budget.hh"
+#include "tchecker/algorithms/covreach/algorithm.hh"
+#include "tchecker/algorithms/covreach/stats.hh"
+#include "tchecker/clockbounds/clockbounds.hh"
+#include "tchecker/graph/edge.hh"
+#include "tchecker/graph/node.hh"
+#include "tchecker/graph/subsumption_graph.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/syncprod/vedge.hh"
+#include "tchecker/utils/shared_objects.hh"
+#include "tchecker/waiting/waiting.hh"
+#include "tchecker/zg/path.hh"
+#include "tchecker/zg/state.hh"
+#include "tchecker/zg/transition.hh"
+#include "tchecker/zg/zg.hh"
+#include "tchecker/zg/zone_summary.hh"
+
+namespace tchecker {
+
+namespace tck_reach {
+
+namespace zg_covreach {
+
+/*!
+ \brief Type of cover relation on nodes
+ */
+enum cover_t {
+  COVER_INCLUSION,  /*!< Zone inclusion, on zones with local ExtraLU+ extrapolation */
+  COVER_ALU_GLOBAL, /*!< Inclusion in aLU abstraction w.r.t. global clock bounds, on exact zones */
+  COVER_ALU_LOCAL,  /*!< Inclusion in aLU abstraction w.r.t. local clock bounds, on exact zones */
+  COVER_AM_GLOBAL,  /*!< Inclusion in aM abstraction w.r.t. global clock bounds, on exact zones */
+  COVER_AM_LOCAL,   /*!< Inclusion in aM abstraction w.r.t. local clock bounds, on exact zones */
+};
+
+/*!
+ \class node_t
+ \brief Node of the subsumption graph of a zone graph
+ */
+class node_t : public tchecker::waiting::element_t,
+               public tchecker::graph::node_flags_t,
+               public tchecker::graph::node_zg_state_t {
+public:
+  /*!
+  \brief Constructor
+  \param s : a zone graph state
+  \param initial : initial node flag
+  \param final : final node flag
+  \post this node keeps a shared pointer to s, and has initial/final node flags as specified
+  */
+  node_t(tchecker::zg::state_sptr_t const & s, bool initial = false, bool final = false);
+
+  /*!
+   \brief Constructor
+   \param s : a zone graph state
+   \param initial : initial node flag
+   \param final : final node flag
+   \post this node keeps a shared pointer to s, and has initial/final node flags as specified
+   */
+  node_t(tchecker::zg::const_state_sptr_t const & s, bool initial = false, bool final = false);
+};
+
+/*!
+\class node_hash_t
+\brief Hash functor for nodes
+*/
+class node_hash_t {
+public:
+  /*!
+  \brief Hash function
+  \param n : a node
+  \return hash value for the tuple of locations and the valuation of integer variables in n
+  \note nodes that may cover each other have the same hash value
+  */
+  std::size_t operator()(tchecker::tck_reach::zg_covreach::node_t const & n) const;
+};
+
+/*!
+\class node_le_t
+\brief Cover relation on nodes
+*/
+class node_le_t {
+public:
+  /*!
+  \brief Constructor
+  \param cover : cover relation
+  \param clock_bounds : clock bounds
+  \pre clock_bounds is not nullptr
+  \throw std::invalid_argument : if clock_bounds is nullptr
+  */
+  node_le_t(enum tchecker::tck_reach::zg_covreach::cover_t cover,
+            std::shared_ptr<tchecker::clockbounds::clockbounds_t const> const & clock_bounds);
+
+  /*!
+  \brief Copy constructor
+  \param le : a functor
+  \post this is a copy of le, with its own clock bound maps
+  */
+  node_le_t(tchecker::tck_reach::zg_covreach::node_le_t const & le);
+
+  /*!
+  \brief Destructor
+  */
+  ~node_le_t();
+
+  /*!
+  \brief Assignment operator (deleted)
+  */
+  tchecker::tck_reach::zg_covreach::node_le_t & operator=(tchecker::tck_reach::zg_covreach::node_le_t const &) = delete;
+
+  /*!
+  \brief Cover predicate
+  \param n1 : a node
+  \param n2 : a node
+  \return true if n1 and n2 have the same discrete part, and the zone in n1 is covered by the zone in n2 w.r.t. the
+  cover relation of this functor (using the local clock bounds of the locations in n2 for local covers), false
+  otherwise
+  */
+  bool operator()(tchecker::tck_reach::zg_covreach::node_t const & n1, tchecker::tck_reach::zg_covreach::node_t const & n2) const;
+
+private:
+  enum tchecker::tck_reach::zg_covreach::cover_t _cover;                     /*!< Cover relation */
+  std::shared_ptr<tchecker::clockbounds::clockbounds_t const> _clock_bounds; /*!< Clock bounds */
+  tchecker::clockbounds::map_t * _l;                                         /*!< Lower bounds */
+  tchecker::clockbounds::map_t * _u;                                         /*!< Upper bounds */
+  tchecker::clockbounds::map_t * _m;                                         /*!< M bounds */
+  mutable tchecker::clockbounds::local_lu_cache_t _lu_cache;                 /*!< Local LU bounds of tuples of locations */
+  mutable tchecker::clockbounds::local_m_cache_t _m_cache;                   /*!< Local M bounds of tuples of locations */
+};
+
+/*!
+ \class edge_t
+ \brief Edge of the subsumption graph of a zone graph
+*/
+class edge_t : public tchecker::graph::edge_vedge_t {
+public:
+  /*!
+   \brief Constructor
+   \param t : a zone graph transition
+   \post this node keeps a shared pointer on the vedge in t
+  */
+  edge_t(tchecker::zg::transition_t const & t);
+};
+
+/*!
+ \class graph_t
+ \brief Subsumption graph over the zone graph
+ \note the candidate covering nodes are found from a subsumption index with summaries of zones w.r.t. local LU clock
+ bounds (see tchecker::zg::node_alu_summary_t). Every cover relation in tchecker::tck_reach::zg_covreach::cover_t
+ implies inclusion in the aLU abstraction w.r.t. local clock bounds, hence the summaries never reject a covering node
+*/
+class graph_t : public tchecker::graph::subsumption::graph_t<
+                    tchecker::tck_reach::zg_covreach::node_t, tchecker::tck_reach::zg_covreach::edge_t,
+                    tchecker::tck_reach::zg_covreach::node_hash_t, tchecker::tck_reach::zg_covreach::node_le_t,
+                    tchecker::zg::node_alu_summary_t<tchecker::tck_reach::zg_covreach::node_t>> {
+public:
+  /*!
+   \brief Constructor
+   \param zg : zone graph
+   \param cover : cover relation on nodes
+   \param clock_bounds : clock bounds of the system of zg
+   \param block_size : number of objects allocated in a block
+   \param table_size : size of hash table
+   \pre clock_bounds is not nullptr
+   \throw std::invalid_argument : if clock_bounds is nullptr
+   \note this keeps a pointer on zg and on clock_bounds
+  */
+  graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, enum tchecker::tck_reach::zg_covreach::cover_t cover,
+          std::shared_ptr<tchecker::clockbounds::clockbounds_t const> const & clock_bounds, std::size_t block_size,
+          std::size_t table_size);
+
+  /*!
+   \brief Destructor
+  */
+  virtual ~graph_t();
+
+  /*!
+   \brief Accessor
+   \return pointer to internal zone graph
+  */
+  inline std::shared_ptr<tchecker::zg::zg_t> zg_ptr() { return _zg; }
+
+  /*!
+   \brief Accessor
+   \return internal zone graph
+  */
+  inline tchecker::zg::zg_t const & zg() const { return *_zg; }
+
+  using tchecker::graph::subsumption::graph_t<
+      tchecker::tck_reach::zg_covreach::node_t, tchecker::tck_reach::zg_covreach::edge_t,
+      tchecker::tck_reach::zg_covreach::node_hash_t, tchecker::tck_reach::zg_covreach::node_le_t,
+      tchecker::zg::node_alu_summary_t<tchecker::tck_reach::zg_covreach::node_t>>::attributes;
+
+protected:
+  /*!
+   \brief Accessor to node attributes
+   \param n : a node
+   \param m : a map (key, value) of attributes
+   \post attributes of node n have been added to map m
+  */
+  virtual void attributes(tchecker::tck_reach::zg_covreach::node_t const & n, std::map<std::string, std::string> & m) const;
+
+  /*!
+   \brief Accessor to edge attributes
+   \param e : an edge
+   \param m : a map (key, value) of attributes
+   \post attributes of edge e have been added to map m
+  */
+  virtual void attributes(tchecker::tck_reach::zg_covreach::edge_t const & e, std::map<std::string, std::string> & m) const;
+
+private:
+  std::shared_ptr<tchecker::zg::zg_t> _zg; /*!< Zone graph */
+};
+
+/*!
+ \brief Graph output
+ \param os : output stream
+ \param g : graph
+ \param name : graph name
+ \param lexical : if true, nodes and edges are output in lexical order, otherwise they are streamed
+ in the order of the graph (see tchecker::graph::dot_output_stream)
+ \post graph g with name has been output to os
+*/
+std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_covreach::graph_t const & g, std::string const & name,
+                          bool lexical = false);
+
+namespace cex {
+
+/*!
+ \brief Type of symbolic counter-example
+*/
+using symbolic_cex_t = tchecker::zg::path::symbolic::finite_path_t;
+
+/*!
+ \brief Compute a symbolic counter-example from a subsumption graph of a zone graph
+ \param g : subsumption graph on a zone graph
+ \return a finite path from an initial node to a final node in g if any, nullptr otherwise
+ \note the zones along the path are recomputed from its sequence of tuples of edges, which also follows
+ subsumption edges
+ \note the returned pointer shall be deleted
+*/
+tchecker::tck_reach::zg_covreach::cex::symbolic_cex_t *
+symbolic_counter_example(tchecker::tck_reach::zg_covreach::graph_t const & g);
+
+/*!
+ \brief Type of concrete counter-example
+*/
+using concrete_cex_t = tchecker::zg::path::concrete::finite_path_t;
+
+/*!
+ \brief Compute a concrete counter-example from a subsumption graph of a zone graph
+ \param g : subsumption graph on a zone graph
+ \return a finite path from an initial node to a final node in g with concrete clock valuations if any,
+ nullptr otherwise
+ \note the returned pointer shall be deleted
+*/
+tchecker::tck_reach::zg_covreach::cex::concrete_cex_t *
+concrete_counter_example(tchecker::tck_reach::zg_covreach::graph_t const & g);
+
+} // namespace cex
+
+/*!
+ \class algorithm_t
+ \brief Covering reachability algorithm over the zone graph
+*/
+class algorithm_t
+    : public tchecker::algorithms::covreach::algorithm_t<tchecker::zg::zg_t, tchecker::tck_reach::zg_covreach::graph_t> {
+public:
+  using tchecker::algorithms::covreach::algorithm_t<tchecker::zg::zg_t, tchecker::tck_reach::zg_covreach::graph_t>::algorithm_t;
+};
+
+/*!
+ \brief Run covering reachability algorithm on the zone graph of a system
+ \param sysdecl : system declaration
+ \param labels : comma-separated string of labels
+ \param search_order : search order, either "dfs", "bfs", "dist" or "random"
+ \param cover : cover relation on nodes
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param budget : budget of visited states, running time and memory of the exploration
+ \pre labels must appear as node attributes in sysdecl
+ \return statistics on the run and the subsumption graph: each new node that is covered by a visited node is
+ discarded, and the visited nodes that are covered by a new node are removed (see
+ tchecker::algorithms::covreach::algorithm_t)
+ \throw std::invalid_argument : if search_order is not supported
+ \throw std::runtime_error : if the clock bounds of the system cannot be computed
+ \note zones are extrapolated w.r.t. local LU clock bounds (ExtraLU+) with cover COVER_INCLUSION. They are exact with
+ the other covers, which check inclusion in an abstraction instead (the zone graph then has no extrapolation)
+ */
+std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_covreach::graph_t>>
+run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
+    std::string const & search_order = "bfs",
+    enum tchecker::tck_reach::zg_covreach::cover_t cover = tchecker::tck_reach::zg_covreach::COVER_INCLUSION,
+    std::size_t block_size = 10000, std::size_t table_size = 65536,
+    tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{});
+
+} // end of namespace zg_covreach
+
+} // namespace tck_reach
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ZG_COVREACH_ALGORITHM_HH
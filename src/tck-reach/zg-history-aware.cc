@@ -2,15 +2,25 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <mutex>
 #include <queue>
+#include <string>
+#include <tuple>
 
 #include <boost/dynamic_bitset.hpp>
 
 #include "counter_example_ha.hh"
 #include "tchecker/algorithms/search_order.hh"
+#include "tchecker/clockbounds/solver_ha.hh"
 #include "tchecker/system/static_analysis.hh"
 #include "tchecker/ta/system_ha.hh"
 #include "tchecker/utils/log.hh"
+#include "tchecker/utils/parallel.hh"
 #include "zg-history-aware.hh"
 
 namespace tchecker {
@@ -21,15 +31,19 @@ namespace zg_history_aware {
 
 /* node_t */
 
-node_t::node_t(tchecker::zg::state_sptr_t const & s, bool initial, bool final, boost::dynamic_bitset<> rhv)
+node_t::node_t(tchecker::zg::state_sptr_t const & s, bool initial, bool final,
+               tchecker::graph::reset_history_sptr_t const & rhv)
     : tchecker::graph::node_flags_t(initial, final), tchecker::graph::node_zg_state_t(s),
-      tchecker::graph::node_reset_history(rhv), tchecker::graph::node_reachability(false)
+      tchecker::graph::node_reset_history(rhv), tchecker::graph::node_reachability(false),
+      _merged_id(NO_MERGED_ID)
 {
 }
 
-node_t::node_t(tchecker::zg::const_state_sptr_t const & s, bool initial, bool final, boost::dynamic_bitset<> rhv)
+node_t::node_t(tchecker::zg::const_state_sptr_t const & s, bool initial, bool final,
+               tchecker::graph::reset_history_sptr_t const & rhv)
     : tchecker::graph::node_flags_t(initial, final), tchecker::graph::node_zg_state_t(s),
-      tchecker::graph::node_reset_history(rhv), tchecker::graph::node_reachability(false)
+      tchecker::graph::node_reset_history(rhv), tchecker::graph::node_reachability(false),
+      _merged_id(NO_MERGED_ID)
 {
 }
 
@@ -37,7 +51,10 @@ node_t::node_t(tchecker::zg::const_state_sptr_t const & s, bool initial, bool fi
 
 std::size_t node_hash_t::operator()(tchecker::tck_reach::zg_history_aware::node_t const & n) const
 {
-  return tchecker::zg::shared_hash_value_incl_vector(n.state(), n.reset_history_vector());
+  // reset histories are shared by the exploration
+  std::size_t h = tchecker::zg::shared_hash_value(n.state());
+  boost::hash_combine(h, n.reset_history_ptr().get());
+  return h;
 }
 
 /* node_equal_to_t */
@@ -45,14 +62,13 @@ std::size_t node_hash_t::operator()(tchecker::tck_reach::zg_history_aware::node_
 bool node_equal_to_t::operator()(tchecker::tck_reach::zg_history_aware::node_t const & n1,
                                  tchecker::tck_reach::zg_history_aware::node_t const & n2) const
 {
-  return tchecker::zg::shared_equal_to_incl_vector(n1.state(), n2.state(), n1.reset_history_vector(),
-                                                   n2.reset_history_vector());
+  return tchecker::zg::shared_equal_to(n1.state(), n2.state()) && (n1.reset_history_ptr() == n2.reset_history_ptr());
 }
 
 /* edge_t */
 
-edge_t::edge_t(tchecker::zg_ha::transition_t const & t)
-    : tchecker::graph::edge_vedge_t(t.vedge_ptr()), tchecker::graph::edge_rel_transition(t)
+edge_t::edge_t(tchecker::zg_ha::transition_t const & t, tchecker::graph::guard_variables_table_t & guard_variables)
+    : tchecker::graph::edge_vedge_t(t.vedge_ptr()), tchecker::graph::edge_guard_variables_t(t, guard_variables)
 {
 }
 
@@ -88,8 +104,11 @@ void graph_t::attributes(tchecker::tck_reach::zg_history_aware::edge_t const & e
 
 /* dot_output */
 
-std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_history_aware::graph_t const & g, std::string const & name)
+std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_history_aware::graph_t const & g, std::string const & name,
+                          bool lexical)
 {
+  if (!lexical)
+    return tchecker::graph::dot_output_stream(os, g, name);
   return tchecker::graph::reachability::dot_output<tchecker::tck_reach::zg_history_aware::graph_t,
                                                    tchecker::tck_reach::zg_history_aware::node_lexical_less_t,
                                                    tchecker::tck_reach::zg_history_aware::edge_lexical_less_t>(os, g, name);
@@ -138,149 +157,638 @@ bool accepting(tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t const
   return !labels.none() && labels.is_subset_of(ts.labels(n->state_ptr())) && ts.is_valid_final(n->state_ptr());
 }
 
-tchecker::algorithms::reach::stats_t
-run(tchecker::zg_ha::zg_t & zg, std::shared_ptr<tchecker::ta_ha::system_t const> & env,
-    tchecker::tck_reach::zg_history_aware::graph_t & graph,
-    std::queue<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t> & final_nodes_container,
-    boost::dynamic_bitset<> const & labels, enum tchecker::waiting::policy_t policy, bool & early_termination, int num_clocks,
-    int num_int_vars, long long int iteration_num)
+/* stats_t */
+
+stats_t::stats_t(std::size_t threads)
+    : _covered_states(0), _thread_expanded_states(std::max<std::size_t>(threads, 1), 0),
+      _thread_computed_transitions(std::max<std::size_t>(threads, 1), 0)
 {
-  using node_sptr_t = typename tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t;
-  auto graph_system = graph.zg().system().as_system_system();
+}
 
-  auto num_clocks_vars = num_clocks + num_int_vars;
-  std::unique_ptr<tchecker::waiting::waiting_t<node_sptr_t>> waiting{tchecker::waiting::factory<node_sptr_t>(policy)};
+void stats_t::attributes(std::map<std::string, std::string> & m) const
+{
+  tchecker::algorithms::reach::stats_t::attributes(m);
 
-  std::unordered_map<std::string, std::unordered_set<intvar_id_t>> intvars_set_by_env;
-  std::vector<std::string> env_intvar_names;
-  std::vector<std::string> env_event_names;
-  env_intvar_names.reserve(env->integer_variables().index().size());
-  env_event_names.reserve(env->edges_count());
-  long long int count = 0; // TODO: Wrong results if the variable overflows (which can happen if number of final states surpasses 2^64)
+  m["COVERED_STATES"] = std::to_string(_covered_states);
 
-  // get integer variable names
-  for (const auto & intvar : env->integer_variables().index()) {
-    env_intvar_names.push_back(intvar.second);
+  if (threads() < 2)
+    return;
+
+  m["THREADS"] = std::to_string(threads());
+  for (std::size_t t = 0; t < threads(); ++t) {
+    m["THREAD_" + std::to_string(t) + "_EXPANDED_STATES"] = std::to_string(_thread_expanded_states[t]);
+    m["THREAD_" + std::to_string(t) + "_COMPUTED_TRANSITIONS"] = std::to_string(_thread_computed_transitions[t]);
   }
+}
 
-  // get event names
-  for (const auto & edge : env->edges()) {
-    const std::string & event_name = env->event_name(edge->event_id());
-    env_event_names.push_back(event_name);
+/* environment_summary_t */
+
+environment_summary_t::environment_summary_t(tchecker::parsing::system_declaration_t const & envdecl)
+{
+  tchecker::ta_ha::system_t const env{envdecl};
+  _initial = tchecker::system::every_process_has_initial_location(env.as_system_system());
+
+  auto const & env_intvars = env.integer_variables().flattened();
+  for (tchecker::event_id_t event = 0; event < env.events_count(); ++event) {
+    std::vector<std::string> & written = _written[env.event_name(event)];
+    for (tchecker::intvar_id_t intvar : env.written_intvars(event))
+      written.push_back(env_intvars.name(intvar));
   }
+}
 
-  // Process each edge's attributes and search for "do" attributes
-  for (const auto & edge : env->edges()) {
-    const std::string & event_name = env->event_name(edge->event_id());
-    for (const auto & attr : edge->attributes().range()) {
-      if (attr.key() == "do") {
-        for (const auto & name : env_intvar_names) {
-          if (attr.value().find(name) != std::string::npos) {
-            intvars_set_by_env[event_name].insert(graph_system.intvar_id(name));
-          }
-        }
-      }
-    }
+std::vector<std::string> const & environment_summary_t::written_intvars(std::string const & event) const
+{
+  static std::vector<std::string> const none;
+  auto it = _written.find(event);
+  return (it == _written.end() ? none : it->second);
+}
+
+std::shared_ptr<tchecker::tck_reach::zg_history_aware::environment_summary_t const>
+environment_summary(std::shared_ptr<tchecker::parsing::system_declaration_t> const & envdecl)
+{
+  using summary_sptr_t = std::shared_ptr<tchecker::tck_reach::zg_history_aware::environment_summary_t const>;
+  // the declarations are observed: an entry whose declaration has expired is stale, as its address can be reused
+  static std::map<tchecker::parsing::system_declaration_t const *,
+                  std::tuple<std::weak_ptr<tchecker::parsing::system_declaration_t>, summary_sptr_t>>
+      summaries;
+  static std::mutex mutex;
+
+  std::lock_guard<std::mutex> lock{mutex};
+  auto it = summaries.find(envdecl.get());
+  if (it != summaries.end() && !std::get<0>(it->second).expired())
+    return std::get<1>(it->second);
+
+  for (auto entry = summaries.begin(); entry != summaries.end();)
+    entry = (std::get<0>(entry->second).expired() ? summaries.erase(entry) : std::next(entry));
+
+  summary_sptr_t summary = std::make_shared<tchecker::tck_reach::zg_history_aware::environment_summary_t const>(*envdecl);
+  summaries[envdecl.get()] = std::make_tuple(std::weak_ptr<tchecker::parsing::system_declaration_t>{envdecl}, summary);
+  return summary;
+}
+
+/* intvar_history_slots */
+
+std::vector<std::size_t> intvar_history_slots(tchecker::ta_ha::system_t const & system)
+{
+  std::size_t const num_clocks = system.as_system_system().clocks_count(tchecker::VK_FLATTENED);
+  boost::dynamic_bitset<> const & guarded = system.guarded_intvars();
+
+  std::vector<std::size_t> slots(system.as_system_system().intvars_count(tchecker::VK_FLATTENED),
+                                 tchecker::tck_reach::zg_history_aware::NO_HISTORY_SLOT);
+  std::size_t next_slot = num_clocks;
+  for (std::size_t id = 0; id < slots.size(); ++id)
+    if (id < guarded.size() && guarded[id])
+      slots[id] = next_slot++;
+  return slots;
+}
+
+/* exploration_t */
+
+/*!
+ \brief Build the zone graph of a system for the history-aware exploration
+ \param system : a system
+ \param sharing_type : sharing type of states and transitions
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param extrapolation : zone extrapolation
+ \param clock_bounds : clock bounds of system (nullptr: computed by the zone graph factory)
+ \return the zone graph of system with elapsed semantics and extrapolation
+ */
+static std::shared_ptr<tchecker::zg_ha::zg_t>
+make_zg(std::shared_ptr<tchecker::ta_ha::system_t const> const & system, enum tchecker::ts::sharing_type_t sharing_type,
+        std::size_t block_size, std::size_t table_size, enum tchecker::zg_ha::extrapolation_type_t extrapolation,
+        std::shared_ptr<tchecker::clockbounds::clockbounds_t const> const & clock_bounds)
+{
+  if (clock_bounds == nullptr)
+    return std::shared_ptr<tchecker::zg_ha::zg_t>{tchecker::zg_ha::factory(
+        system, sharing_type, tchecker::zg::ELAPSED_SEMANTICS, extrapolation, block_size, table_size)};
+  return std::shared_ptr<tchecker::zg_ha::zg_t>{tchecker::zg_ha::factory(
+      system, sharing_type, tchecker::zg::ELAPSED_SEMANTICS, extrapolation, *clock_bounds, block_size, table_size)};
+}
+
+exploration_t::exploration_t(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl,
+                             std::shared_ptr<tchecker::parsing::system_declaration_t> const & envdecl,
+                             std::string const & labels, std::string const & search_order, std::size_t block_size,
+                             std::size_t table_size, std::size_t threads, bool covering,
+                             tchecker::collection_trigger_t const & collection,
+                             std::shared_ptr<tchecker::zg::zone_registry_t> const & zones,
+                             enum tchecker::zg_ha::extrapolation_type_t extrapolation,
+                             tchecker::algorithms::budget_t const & budget)
+    : _covering(covering), _budget(budget), _visited_states(0)
+{
+  _system = std::make_shared<tchecker::ta_ha::system_t const>(*sysdecl);
+  if (!tchecker::system::every_process_has_initial_location(_system->as_system_system()))
+    std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
+
+  _env = tchecker::tck_reach::zg_history_aware::environment_summary(envdecl);
+  if (!_env->has_initial_state())
+    std::cerr << tchecker::log_warning << "environment has no initial state" << std::endl;
+
+  // clock bounds are computed once for the zone graphs of all threads and for covering
+  std::shared_ptr<tchecker::clockbounds::clockbounds_t const> clock_bounds;
+  if (extrapolation != tchecker::zg_ha::NO_EXTRAPOLATION || _covering)
+    clock_bounds.reset(tchecker::clockbounds_ha::compute_clockbounds(*_system));
+
+  _zg = make_zg(_system, tchecker::ts::SHARING, block_size, table_size, extrapolation, clock_bounds);
+  _zg->collection_trigger(collection);
+  if (zones.get() != nullptr)
+    _zg->share_zones(*zones);
+
+  _graph = std::make_shared<tchecker::tck_reach::zg_history_aware::graph_t>(_zg, block_size, table_size);
+
+  _labels = _system->as_syncprod_system().labels(labels);
+
+  enum tchecker::waiting::policy_t policy = tchecker::algorithms::waiting_policy(search_order);
+  tchecker::waiting::priority_function_t<node_sptr_t> priority;
+  if (search_order == "reset") // nodes with most variables reset in their history first
+    priority = [](node_sptr_t const & n) {
+      return -static_cast<tchecker::waiting::priority_t>(n->reset_history_vector().count());
+    };
+  else
+    priority = tchecker::algorithms::priority<node_sptr_t>(search_order, _system->as_syncprod_system(), _labels);
+  _waiting.reset(tchecker::waiting::factory<node_sptr_t>(policy, priority));
+
+  // batches preserve the exploration order of a queue only, depth-first search is sequential
+  _threads = (policy == tchecker::waiting::QUEUE ? std::max<std::size_t>(threads, 1) : 1);
+
+  // each thread computes successors on its own zone graph over the shared system (each thread evaluates
+  // guards and statements with its own virtual machine), and without sharing as its states are copied into _zg
+  if (_threads > 1) {
+    for (std::size_t t = 0; t < _threads; ++t)
+      _workers.push_back(make_zg(_system, tchecker::ts::NO_SHARING, block_size, table_size, extrapolation, clock_bounds));
   }
 
-  tchecker::algorithms::reach::stats_t stats;
+  if (_covering) {
+    if (clock_bounds.get() != nullptr)
+      _m = clock_bounds->global_m_map();
+    else
+      std::cerr << tchecker::log_warning << "no clock bounds, covering uses zone inclusion" << std::endl;
+  }
 
-  stats.set_start_time();
+  _num_clocks = _system->as_system_system().clocks_count(tchecker::VK_FLATTENED);
+  // integer variables that are not read by guards are projected away from histories
+  _intvar_slots = tchecker::tck_reach::zg_history_aware::intvar_history_slots(*_system);
+  _num_int_vars = static_cast<int>(std::count_if(_intvar_slots.begin(), _intvar_slots.end(), [](std::size_t slot) {
+    return slot != tchecker::tck_reach::zg_history_aware::NO_HISTORY_SLOT;
+  }));
+
+  // integer variables written by the environment on each shared event, from the summary of the environment, as
+  // flattened variables of the system
+  auto const & system_intvars = _system->integer_variables().flattened();
+  _intvars_set_by_env.assign(_system->events_count(), {});
+  for (tchecker::event_id_t event = 0; event < _system->events_count(); ++event) {
+    std::vector<tchecker::intvar_id_t> & written = _intvars_set_by_env[event];
+    for (std::string const & name : _env->written_intvars(_system->event_name(event)))
+      if (system_intvars.is_variable(name))
+        written.push_back(system_intvars.id(name));
+  }
+
+  // the specialization of add_successors for the capabilities of reset histories is selected once
+  _history_capabilities = 0;
+  if (_num_int_vars == 0)
+    _history_capabilities |= HISTORY_CLOCKS_ONLY;
+  if (_num_clocks + _num_int_vars <= 64)
+    _history_capabilities |= HISTORY_SINGLE_WORD;
+  if (std::all_of(_intvars_set_by_env.begin(), _intvars_set_by_env.end(),
+                  [](std::vector<tchecker::intvar_id_t> const & written) { return written.empty(); }))
+    _history_capabilities |= HISTORY_NO_ENV_INTVARS;
+
+  static add_successors_t const add_successors_table[HISTORY_CAPABILITIES] = {
+      &exploration_t::add_successors<0>, &exploration_t::add_successors<1>, &exploration_t::add_successors<2>,
+      &exploration_t::add_successors<3>, &exploration_t::add_successors<4>, &exploration_t::add_successors<5>,
+      &exploration_t::add_successors<6>, &exploration_t::add_successors<7>};
+  _add_successors = add_successors_table[_history_capabilities];
 
   std::vector<typename tchecker::zg_ha::zg_t::sst_t> sst;
 
-  typename tchecker::zg_ha::zg_t::initial_range_t init_edges = zg.initial_edges();
+  typename tchecker::zg_ha::zg_t::initial_range_t init_edges = _zg->initial_edges();
   for (typename tchecker::zg_ha::zg_t::initial_value_t && init_edge : init_edges)
-    zg.initial(init_edge, sst);
+    _zg->initial(init_edge, sst);
 
   for (auto && [status, s, t] : sst) {
 
-    boost::dynamic_bitset<> new_reset_clock_history;
-    new_reset_clock_history = boost::dynamic_bitset<>(num_clocks_vars); // create a new bit vector
-    new_reset_clock_history.set();                                      // set every flag to true (initial vector)
-    auto && [is_new_node, initial_node] = graph.add_node(s, false, false, new_reset_clock_history);
+    tchecker::graph::reset_history_t new_reset_clock_history(_num_clocks + _num_int_vars); // create a new bit vector
+    new_reset_clock_history.set(); // set every flag to true (initial vector)
+    auto && [is_new_node, initial_node] =
+        _graph->add_node(s, false, false, _reset_histories.share(std::move(new_reset_clock_history)));
 
     initial_node->initial(true);
-    if (is_new_node)
-      waiting->insert(initial_node);
+    if (is_new_node) {
+      _waiting->insert(initial_node);
+      if (_covering)
+        _covering_index[covering_key(initial_node->state(), initial_node->reset_history_ptr())].push_back(initial_node);
+    }
   }
+}
 
-  // iterate over next nodes
-  sst.clear();
-  while (!waiting->empty()) {
-    node_sptr_t node = waiting->first();
-    waiting->remove_first();
+tchecker::tck_reach::zg_history_aware::stats_t
+exploration_t::resume(std::queue<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t> & final_nodes_container,
+                      bool & early_termination, long long int iteration_num)
+{
+  tchecker::tck_reach::zg_history_aware::stats_t stats(_threads);
+
+  stats.set_start_time();
+
+  // the node that triggered the previous early termination has been visited, but not expanded
+  if (_pending.ptr() != nullptr) {
+    node_sptr_t node = _pending;
+    _pending.reset();
+    expand(node, stats);
+  }
+
+  if (_threads > 1)
+    resume_parallel(final_nodes_container, early_termination, iteration_num, stats);
+  else
+    resume_sequential(final_nodes_container, early_termination, iteration_num, stats);
+
+  _visited_states += stats.visited_states();
+
+  stats.set_end_time();
+
+  return stats;
+}
+
+bool exploration_t::next_waiting(node_sptr_t & node)
+{
+  if (!_backlog.empty()) {
+    node = _backlog.front();
+    _backlog.pop_front();
+    return true;
+  }
+  if (!_waiting->empty()) {
+    node = _waiting->first();
+    _waiting->remove_first();
+    return true;
+  }
+  return false;
+}
+
+bool exploration_t::budget_exceeded(tchecker::tck_reach::zg_history_aware::stats_t & stats) const
+{
+  return tchecker::algorithms::budget_exceeded(_budget, _visited_states + stats.visited_states(),
+                                               _backlog.size() + _waiting->size(), stats);
+}
+
+bool exploration_t::check_accepting(node_sptr_t const & node, std::queue<node_sptr_t> & final_nodes_container,
+                                    tchecker::tck_reach::zg_history_aware::stats_t & stats)
+{
+  if (!accepting(node, *_zg, _labels))
+    return false;
+  node->final(true);
+  stats.reachable() = true;
+  node->update_reach_status(true);
+  final_nodes_container.push(node);
+  _final_nodes.push_back(node);
+
+  // antichain of accepting nodes w.r.t. covering: the dominated nodes are removed from the seeds of the backward
+  // analysis (see restart_backward_analysis)
+  std::vector<node_sptr_t> & maximal = _maximal_final_nodes[covering_key(node->state(), node->reset_history_ptr())];
+  if (!node->initial())
+    for (node_sptr_t const & n : maximal)
+      if (covers(n, node->state(), node->reset_history_ptr())) {
+        _dominated_final_nodes.push_back(node);
+        return true;
+      }
+  auto dominated = [&](node_sptr_t const & n) {
+    if (n->initial() || !covers(node, n->state(), n->reset_history_ptr()))
+      return false;
+    _dominated_final_nodes.push_back(n);
+    return true;
+  };
+  maximal.erase(std::remove_if(maximal.begin(), maximal.end(), dominated), maximal.end());
+  maximal.push_back(node);
+  return true;
+}
+
+/*!
+ \brief Bound on final nodes
+ \param iteration_num : number of final nodes after which exploration stops (-1 for no limit)
+ \return iteration_num if it is not negative, the largest 64-bit unsigned integer otherwise (which is not reached
+ by a 64-bit count of final nodes)
+ */
+static std::uint64_t final_nodes_bound(long long int iteration_num)
+{
+  return (iteration_num < 0 ? std::numeric_limits<std::uint64_t>::max() : static_cast<std::uint64_t>(iteration_num));
+}
+
+void exploration_t::resume_sequential(std::queue<node_sptr_t> & final_nodes_container, bool & early_termination,
+                                      long long int iteration_num, tchecker::tck_reach::zg_history_aware::stats_t & stats)
+{
+  std::uint64_t count = 0;
+  std::uint64_t const final_nodes_limit = final_nodes_bound(iteration_num);
 
+  // iterate over next nodes
+  node_sptr_t node;
+  while (!budget_exceeded(stats) && next_waiting(node)) {
     ++stats.visited_states();
 
-    if (accepting(node, zg, labels)) {
-      node->final(true);
-      stats.reachable() = true;
-      node->update_reach_status(true);
-      final_nodes_container.push(node);
-      count++;
-      if (count == iteration_num) {      // TODO
-      early_termination = true;
+    if (check_accepting(node, final_nodes_container, stats)) {
+      if (++count == final_nodes_limit) {
+        early_termination = true;
+        _pending = node;
+        break;
+      }
+    }
+
+    expand(node, stats);
+  }
+}
+
+void exploration_t::resume_parallel(std::queue<node_sptr_t> & final_nodes_container, bool & early_termination,
+                                    long long int iteration_num, tchecker::tck_reach::zg_history_aware::stats_t & stats)
+{
+  std::uint64_t count = 0;
+  std::uint64_t const final_nodes_limit = final_nodes_bound(iteration_num);
+
+  std::vector<node_sptr_t> batch;
+  std::vector<std::vector<typename tchecker::zg_ha::zg_t::sst_t>> successors;
+  std::vector<std::size_t> expanded_by; // worker that has computed the successors of each node of the batch
+
+  while (!budget_exceeded(stats)) {
+    // the batch is the whole waiting list: nodes inserted while processing the batch come after it, as with a queue
+    batch.clear();
+    node_sptr_t node;
+    while (next_waiting(node))
+      batch.push_back(node);
+    if (batch.empty())
       break;
+
+    // accepting nodes are checked in waiting order to stop where the sequential exploration would stop
+    std::size_t expanded = batch.size();
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      ++stats.visited_states();
+      if (check_accepting(batch[i], final_nodes_container, stats)) {
+        if (++count == final_nodes_limit) {
+          early_termination = true;
+          _pending = batch[i];
+          expanded = i;
+          break;
+        }
       }
     }
 
-    auto src_reset_history = node->reset_history_vector();
+    // successors are computed in parallel: each thread copies its source states into its own zone graph
+    // and only touches objects allocated by that zone graph
+    successors.resize(expanded);
+    expanded_by.resize(expanded);
+    tchecker::parallel_for(expanded, _threads, [&](std::size_t t, std::size_t i) {
+      expanded_by[i] = t;
+      tchecker::zg_ha::zg_t & worker = *_workers[t];
+      tchecker::zg::const_state_sptr_t src{
+          worker.clone(static_cast<tchecker::zg::shared_state_t const &>(batch[i]->state()))};
+      worker.next(src, successors[i]);
+    });
+
+    // successors are inserted into the graph in waiting order, to get the same graph as a sequential exploration
+    for (std::size_t i = 0; i < expanded; ++i) {
+      for (auto && [status, s, t] : successors[i])
+        _sst.emplace_back(status, _zg->clone(*s), _zg->clone(*t));
+      successors[i].clear();
+
+      std::size_t const t = expanded_by[i];
+      ++stats.thread_expanded_states(t);
+      stats.thread_computed_transitions(t) += _sst.size();
+
+      add_successors(batch[i], _sst, stats);
+      _sst.clear();
+    }
 
-    auto node_state = node->state_ptr();
-    typename tchecker::zg_ha::zg_t::outgoing_edges_range_t out_edges = zg.outgoing_edges(node_state);
-    for (typename tchecker::zg_ha::zg_t::outgoing_edges_value_t && out_edge : out_edges)
-      zg.next(node_state, out_edge, sst);
+    if (early_termination) {
+      // the nodes after the pending one are waiting before the nodes inserted by this batch
+      _backlog.insert(_backlog.end(), batch.begin() + expanded + 1, batch.end());
+      break;
+    }
+  }
+}
 
-    for (auto && [status, s, t] : sst) {
+void exploration_t::expand(tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t const & node,
+                           tchecker::tck_reach::zg_history_aware::stats_t & stats)
+{
+  auto node_state = node->state_ptr();
+  typename tchecker::zg_ha::zg_t::outgoing_edges_range_t out_edges = _zg->outgoing_edges(node_state);
+  for (typename tchecker::zg_ha::zg_t::outgoing_edges_value_t && out_edge : out_edges)
+    _zg->next(node_state, out_edge, _sst);
 
-      auto reset_container = t->reset_container();
-      bool is_epsilon = false;
+  ++stats.thread_expanded_states(0);
+  stats.thread_computed_transitions(0) += _sst.size();
 
-      auto current_edge = graph_system.edge(*t->vedge().begin());
-      const auto & current_event_name = graph_system.event_name(current_edge->event_id());
-      if (current_event_name[0] == '_') {
-        is_epsilon = true;
-      }
+  add_successors(node, _sst, stats);
+  // the buffer keeps its capacity, but releases successor states and transitions
+  _sst.clear();
+}
 
-      boost::dynamic_bitset<> new_reset_clock_history = src_reset_history;
-      if (!is_epsilon) { // start from the beginning (all clock flags set to false), then apply the changes
-        new_reset_clock_history = boost::dynamic_bitset<>(num_clocks_vars); // create a new bit vector
-        for (int i = 0; i < num_clocks_vars; ++i) {                         // set every clock flag to false (initial vector)
-          new_reset_clock_history[i] = false;
-        }
-        for (auto modified_intvar : intvars_set_by_env[current_event_name]) {
-          new_reset_clock_history[num_clocks_vars + modified_intvar] = false;
-        }
+/*!
+ \brief Reset history as a word
+ \param h : a reset history
+ \pre h has at most 64 flags
+ \return the word with the flags of h
+ */
+static inline std::uint64_t history_word(tchecker::graph::reset_history_t const & h)
+{
+  return (h.empty() ? 0 : static_cast<std::uint64_t>(h.to_ulong()));
+}
+
+template <unsigned CAPS>
+void exploration_t::add_successors(tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t const & node,
+                                   std::vector<typename tchecker::zg_ha::zg_t::sst_t> const & sst,
+                                   tchecker::tck_reach::zg_history_aware::stats_t & stats)
+{
+  constexpr bool single_word = ((CAPS & HISTORY_SINGLE_WORD) != 0);
+
+  tchecker::graph::reset_history_t const & src_reset_history = node->reset_history_vector();
+  std::uint64_t const src_word = (single_word ? history_word(src_reset_history) : 0);
+
+  for (auto && [status, s, t] : sst) {
+    // the history after a non-epsilon transition has exactly the variables updated by the transition. An epsilon
+    // transition adds them to the source history (word-wise union of bitsets)
+    edge_reset_history_t const & e = edge_reset_history<CAPS>(*t);
+    tchecker::graph::reset_history_sptr_t next_reset_history = e.history;
+    if (_system->is_epsilon_edge(*t->vedge().begin())) {
+      if constexpr (single_word) {
+        std::uint64_t const w = src_word | e.word;
+        next_reset_history = (w == src_word ? node->reset_history_ptr() : word_reset_history(w));
       }
+      else if (next_reset_history->is_subset_of(src_reset_history))
+        next_reset_history = node->reset_history_ptr();
+      else
+        next_reset_history = _reset_histories.share(src_reset_history | *next_reset_history);
+    }
 
-      // apply the changes to clock ids
-      for (auto clk_reset_history : t->reset_container()) {
-        // set the corresponding flag to true for each resets
-        new_reset_clock_history[clk_reset_history.left_id()] = true;
+    ++stats.visited_transitions();
+
+    if (_covering) {
+      node_sptr_t covering_node;
+      if (is_covered(*s, next_reset_history, covering_node)) {
+        _graph->add_edge(node, covering_node, *t);
+        ++stats.covered_states();
+        continue;
       }
+    }
+
+    auto && [is_new_node, next_node] = _graph->add_node(s, false, false, next_reset_history);
+
+    if (is_new_node) {
+      _waiting->insert(next_node);
+      if (_covering)
+        _covering_index[covering_key(next_node->state(), next_reset_history)].push_back(next_node);
+    }
+    _graph->add_edge(node, next_node, *t);
+  }
+}
 
-      for (auto intvar_set_history : t->intvar_set_container()) {
-        // set the corresponding flag to true for each resets
-        new_reset_clock_history[intvar_set_history.first + num_clocks] = true;
+template <unsigned CAPS>
+exploration_t::edge_reset_history_t const & exploration_t::edge_reset_history(tchecker::zg_ha::transition_t const & t)
+{
+  constexpr bool clocks_only = ((CAPS & HISTORY_CLOCKS_ONLY) != 0);
+  constexpr bool single_word = ((CAPS & HISTORY_SINGLE_WORD) != 0);
+  constexpr bool no_env_intvars = ((CAPS & HISTORY_NO_ENV_INTVARS) != 0);
+
+  auto const & resets = t.reset_container();
+  auto const & intvar_sets = t.intvar_set_container();
+
+  // without tracked integer variables, integer assignments are not recorded. Otherwise, assignments to integer
+  // variables that are not tracked are skipped
+  auto matches = [&](std::vector<std::size_t> const & updated) {
+    if (updated.size() < resets.size())
+      return false;
+    auto it = updated.begin();
+    for (auto const & r : resets)
+      if (*it++ != r.left_id())
+        return false;
+    if constexpr (!clocks_only) {
+      for (auto const & a : intvar_sets) {
+        std::size_t const slot = _intvar_slots[a.first];
+        if (slot == tchecker::tck_reach::zg_history_aware::NO_HISTORY_SLOT)
+          continue;
+        if (it == updated.end() || *it++ != slot)
+          return false;
       }
+    }
+    return (it == updated.end());
+  };
+
+  std::vector<edge_reset_history_t> & cached = _edge_reset_histories[t.vedge_ptr()];
+  for (edge_reset_history_t const & e : cached)
+    if (matches(e.updated))
+      return e;
+
+  // start from the beginning (all clock flags set to false), then apply the changes
+  edge_reset_history_t e;
+  tchecker::graph::reset_history_t h(_num_clocks + _num_int_vars, false);
+  if constexpr (!no_env_intvars) {
+    auto current_edge = _system->as_system_system().edge(*t.vedge().begin());
+    for (auto modified_intvar : _intvars_set_by_env[current_edge->event_id()])
+      if (_intvar_slots[modified_intvar] != tchecker::tck_reach::zg_history_aware::NO_HISTORY_SLOT)
+        h[_intvar_slots[modified_intvar]] = false;
+  }
+  for (auto const & r : resets) {
+    e.updated.push_back(r.left_id());
+    h[r.left_id()] = true;
+  }
+  if constexpr (!clocks_only) {
+    for (auto const & a : intvar_sets) {
+      std::size_t const slot = _intvar_slots[a.first];
+      if (slot == tchecker::tck_reach::zg_history_aware::NO_HISTORY_SLOT)
+        continue;
+      e.updated.push_back(slot);
+      h[slot] = true;
+    }
+  }
+  if constexpr (single_word)
+    e.word = history_word(h);
+  e.history = _reset_histories.share(std::move(h));
+  cached.push_back(std::move(e));
+  return cached.back();
+}
 
-      auto && [is_new_node, next_node] = graph.add_node(s, false, false, new_reset_clock_history);
+tchecker::graph::reset_history_sptr_t exploration_t::word_reset_history(std::uint64_t w)
+{
+  auto it = _word_reset_histories.find(w);
+  if (it != _word_reset_histories.end())
+    return it->second;
+  tchecker::graph::reset_history_t h(_num_clocks + _num_int_vars, static_cast<unsigned long>(w));
+  tchecker::graph::reset_history_sptr_t shared = _reset_histories.share(std::move(h));
+  _word_reset_histories.emplace(w, shared);
+  return shared;
+}
 
-      if (is_new_node)
-        waiting->insert(next_node);
-      graph.add_edge(node, next_node, *t);
+std::size_t exploration_t::covering_key(tchecker::zg::state_t const & s, tchecker::graph::reset_history_sptr_t const & h)
+{
+  std::size_t key = tchecker::ta::shared_hash_value(s);
+  boost::hash_combine(key, h.get());
+  return key;
+}
+
+bool exploration_t::covers(node_sptr_t const & n, tchecker::zg::state_t const & s,
+                           tchecker::graph::reset_history_sptr_t const & h) const
+{
+  if (n->reset_history_ptr() != h || !tchecker::ta::shared_equal_to(s, n->state()))
+    return false;
+  return (_covering && _m.get() != nullptr ? s.zone().is_am_le(n->state().zone(), _m->M())
+                                           : s.zone() <= n->state().zone());
+}
 
-      ++stats.visited_transitions();
+bool exploration_t::is_covered(tchecker::zg::state_t const & s, tchecker::graph::reset_history_sptr_t const & h,
+                               node_sptr_t & covering_node) const
+{
+  auto it = _covering_index.find(covering_key(s, h));
+  if (it == _covering_index.end())
+    return false;
+
+  for (node_sptr_t const & n : it->second) {
+    if (covers(n, s, h)) {
+      covering_node = n;
+      return true;
     }
-    sst.clear();
   }
+  return false;
+}
 
-  waiting->clear();
+void exploration_t::collect()
+{
+  _graph->collect();
+  _zg->collect();
+}
 
-  stats.set_end_time();
+void exploration_t::restart_backward_analysis(
+    std::queue<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t> & final_nodes_container)
+{
+  // the edges to a dominated accepting node go to a maximal accepting node that covers it (there is one, as
+  // covering is transitive), and the dominated node is not a seed. Edges are added to dominated nodes by the
+  // exploration, hence they are moved before each backward analysis. A dominated node is a seed if the maximal
+  // nodes that cover it have been removed from the graph by a previous backward analysis
+  std::unordered_set<node_sptr_t> seeds;
+  std::vector<tchecker::tck_reach::zg_history_aware::graph_t::edge_sptr_t> edges;
+  for (node_sptr_t const & node : _dominated_final_nodes) {
+    std::vector<node_sptr_t> const & maximal =
+        _maximal_final_nodes[covering_key(node->state(), node->reset_history_ptr())];
+    auto it = std::find_if(maximal.begin(), maximal.end(), [&](node_sptr_t const & n) {
+      return covers(n, node->state(), node->reset_history_ptr()) && _graph->contains(n);
+    });
+    if (it == maximal.end())
+      continue;
+    seeds.insert(node);
+    edges.clear();
+    for (auto const & e : _graph->incoming_edges(node))
+      edges.push_back(e);
+    for (auto const & e : edges)
+      _graph->change_edge_tgt(e, *it);
+    _graph->prune(node);
+  }
 
-  return stats;
+  // then accepting nodes, in discovery order (they may have been removed from the graph by a previous
+  // backward analysis), then nodes that have been made final by a previous backward analysis
+  for (node_sptr_t const & node : _final_nodes) {
+    node->update_reach_status(false);
+    if (seeds.insert(node).second)
+      final_nodes_container.push(node);
+  }
+
+  for (node_sptr_t const & node : _graph->nodes()) {
+    node->update_reach_status(false);
+    if (node->final() && seeds.insert(node).second)
+      final_nodes_container.push(node);
+  }
 }
 
 /* run */
@@ -290,33 +798,16 @@ run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl,
     std::shared_ptr<tchecker::parsing::system_declaration_t> const & envdecl,
     std::queue<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t> & final_nodes_container, bool & early_termination,
     std::string const & labels, std::string const & search_order, std::size_t block_size, std::size_t table_size,
-    long long int iteration_num)
+    long long int iteration_num, enum tchecker::zg_ha::extrapolation_type_t extrapolation,
+    tchecker::algorithms::budget_t const & budget)
 {
-  std::shared_ptr<tchecker::ta_ha::system_t const> system{new tchecker::ta_ha::system_t{*sysdecl}};
-  if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
-    std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
-
-  std::shared_ptr<tchecker::ta_ha::system_t const> env{new tchecker::ta_ha::system_t{*envdecl}};
-  if (!tchecker::system::every_process_has_initial_location(env->as_system_system()))
-    std::cerr << tchecker::log_warning << "environment has no initial state" << std::endl;
-
-  std::shared_ptr<tchecker::zg_ha::zg_t> zg{tchecker::zg_ha::factory(
-      system, tchecker::ts::SHARING, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg_ha::EXTRA_M_GLOBAL, block_size, table_size)};
-
-  std::shared_ptr<tchecker::tck_reach::zg_history_aware::graph_t> graph{
-      new tchecker::tck_reach::zg_history_aware::graph_t{zg, block_size, table_size}};
-
-  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
-
-  enum tchecker::waiting::policy_t policy = tchecker::algorithms::waiting_policy(search_order);
-
-  int number_of_clocks = system->as_system_system().clocks_count(tchecker::VK_FLATTENED);
-  int number_of_int_vars = system->as_system_system().intvars_count(tchecker::VK_FLATTENED);
+  tchecker::tck_reach::zg_history_aware::exploration_t exploration(sysdecl, envdecl, labels, search_order, block_size,
+                                                                   table_size, 1, false, tchecker::collection_trigger_t{},
+                                                                   nullptr, extrapolation, budget);
 
-  tchecker::algorithms::reach::stats_t stats = run(*zg, env, *graph, final_nodes_container, accepting_labels, policy,
-                                                   early_termination, number_of_clocks, number_of_int_vars, iteration_num);
+  tchecker::algorithms::reach::stats_t stats = exploration.resume(final_nodes_container, early_termination, iteration_num);
 
-  return std::make_tuple(stats, graph);
+  return std::make_tuple(stats, exploration.graph());
 }
 
 } // namespace zg_history_aware
@@ -5,24 +5,39 @@
 #ifndef TCHECKER_ZG_HISTORY_AWARE_ALGORITHM_HH
 #define TCHECKER_ZG_HISTORY_AWARE_ALGORITHM_HH
 
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <map>
 #include <memory>
 #include <ostream>
+#include <queue>
 #include <string>
 #include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
 
 #include "tchecker/algorithms/reach/algorithm.hh"
 #include "tchecker/algorithms/reach/stats.hh"
+#include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/graph/edge.hh"
 #include "tchecker/graph/node.hh"
 #include "tchecker/graph/reachability_graph.hh"
+#include "tchecker/graph/reset_history.hh"
 #include "tchecker/parsing/declaration.hh"
 #include "tchecker/syncprod/vedge.hh"
+#include "tchecker/ta/system_ha.hh"
+#include "tchecker/utils/cache.hh"
 #include "tchecker/utils/shared_objects.hh"
 #include "tchecker/waiting/waiting.hh"
 #include "tchecker/zg/path_ha.hh"
 #include "tchecker/zg/state.hh"
 #include "tchecker/zg/transition_ha.hh"
 #include "tchecker/zg/zg_ha.hh"
+#include "tchecker/zg/zone_registry.hh"
 
 namespace tchecker {
 
@@ -45,20 +60,43 @@ public:
   \param s : a zone graph state
   \param initial : initial node flag
   \param final : final node flag
-  \post this node keeps a shared pointer to s, and has initial/final node flags as specified
+  \param rhv : shared reset history
+  \post this node keeps a shared pointer to s and to rhv, and has initial/final node flags as specified
   */
-  node_t(tchecker::zg::state_sptr_t const & s, bool initial = false, bool final = false,
-         boost::dynamic_bitset<> rhv = boost::dynamic_bitset<>());
+  node_t(tchecker::zg::state_sptr_t const & s, bool initial, bool final, tchecker::graph::reset_history_sptr_t const & rhv);
 
   /*!
    \brief Constructor
    \param s : a zone graph state
    \param initial : initial node flag
    \param final : final node flag
-   \post this node keeps a shared pointer to s, and has initial/final node flags as specified
+   \param rhv : shared reset history
+   \post this node keeps a shared pointer to s and to rhv, and has initial/final node flags as specified
+   */
+  node_t(tchecker::zg::const_state_sptr_t const & s, bool initial, bool final,
+         tchecker::graph::reset_history_sptr_t const & rhv);
+
+  /*!
+   \brief Accessor
+   \return identifier of the location of this node in the last merged system (see tchecker::tck_reach::graph_parser),
+   NO_MERGED_ID if this node has no location
+   */
+  inline tchecker::node_id_t merged_id() const { return _merged_id; }
+
+  /*!
+   \brief Setter
+   \param id : identifier
+   \post the identifier of the location of this node in the merged system is id
+   */
+  inline void merged_id(tchecker::node_id_t id) { _merged_id = id; }
+
+  /*!
+   \brief Identifier of nodes without location in the merged system
    */
-  node_t(tchecker::zg::const_state_sptr_t const & s, bool initial = false, bool final = false,
-         boost::dynamic_bitset<> rhv = boost::dynamic_bitset<>());
+  static constexpr tchecker::node_id_t NO_MERGED_ID = std::numeric_limits<tchecker::node_id_t>::max();
+
+private:
+  tchecker::node_id_t _merged_id; /*!< Identifier of the location of this node in the merged system */
 };
 
 /*!
@@ -95,14 +133,16 @@ public:
  \class edge_t
  \brief Edge of the reachability graph of a zone graph
 */
-class edge_t : public tchecker::graph::edge_vedge_t, public tchecker::graph::edge_rel_transition {
+class edge_t : public tchecker::graph::edge_vedge_t, public tchecker::graph::edge_guard_variables_t {
 public:
   /*!
    \brief Constructor
    \param t : a zone graph transition
-   \post this node keeps a shared pointer on the vedge in t
+   \param guard_variables : table of guard variables
+   \post this node keeps a shared pointer on the vedge in t, and the index of the guard variables of t in
+   guard_variables
   */
-  edge_t(tchecker::zg_ha::transition_t const & t);
+  edge_t(tchecker::zg_ha::transition_t const & t, tchecker::graph::guard_variables_table_t & guard_variables);
 };
 
 /*!
@@ -140,6 +180,33 @@ public:
   */
   inline tchecker::zg_ha::zg_t const & zg() const { return *_zg; }
 
+  /*!
+   \brief Accessor
+   \return table of guard variables of edges in this graph
+  */
+  inline tchecker::graph::guard_variables_table_t & guard_variables() { return _guard_variables; }
+
+  /*!
+   \brief Accessor
+   \return table of guard variables of edges in this graph
+  */
+  inline tchecker::graph::guard_variables_table_t const & guard_variables() const { return _guard_variables; }
+
+  /*!
+   \brief Add an edge
+   \param n1 : source node
+   \param n2 : target node
+   \param t : a zone graph transition
+   \post an edge from n1 to n2 built from t has been added to this graph. It does not keep a reference to t
+  */
+  inline void add_edge(node_sptr_t const & n1, node_sptr_t const & n2, tchecker::zg_ha::transition_t const & t)
+  {
+    tchecker::graph::reachability::graph_t<
+        tchecker::tck_reach::zg_history_aware::node_t, tchecker::tck_reach::zg_history_aware::edge_t,
+        tchecker::tck_reach::zg_history_aware::node_hash_t,
+        tchecker::tck_reach::zg_history_aware::node_equal_to_t>::add_edge(n1, n2, t, _guard_variables);
+  }
+
   using tchecker::graph::reachability::graph_t<
       tchecker::tck_reach::zg_history_aware::node_t, tchecker::tck_reach::zg_history_aware::edge_t,
       tchecker::tck_reach::zg_history_aware::node_hash_t, tchecker::tck_reach::zg_history_aware::node_equal_to_t>::attributes;
@@ -164,7 +231,8 @@ protected:
                           std::map<std::string, std::string> & m) const;
 
 private:
-  std::shared_ptr<tchecker::zg_ha::zg_t> _zg; /*!< Zone graph */
+  std::shared_ptr<tchecker::zg_ha::zg_t> _zg;                /*!< Zone graph */
+  tchecker::graph::guard_variables_table_t _guard_variables; /*!< Guard variables of edges */
 };
 
 /*!
@@ -172,10 +240,12 @@ private:
  \param os : output stream
  \param g : graph
  \param name : graph name
+ \param lexical : if true, nodes and edges are output in lexical order, otherwise they are streamed
+ in the order of the graph (see tchecker::graph::dot_output_stream)
  \post graph g with name has been output to os
 */
-std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_history_aware::graph_t const & g,
-                          std::string const & name);
+std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_history_aware::graph_t const & g, std::string const & name,
+                          bool lexical = false);
 
 namespace cex {
 
@@ -243,6 +313,440 @@ public:
                                                  tchecker::tck_reach::zg_history_aware::graph_t>::algorithm_t;
 };
 
+/*!
+ \class stats_t
+ \brief Statistics of the history-aware exploration, with a breakdown per exploration thread
+ */
+class stats_t : public tchecker::algorithms::reach::stats_t {
+public:
+  /*!
+   \brief Constructor
+   \param threads : number of exploration threads
+   */
+  stats_t(std::size_t threads = 1);
+
+  /*!
+   \brief Accessor
+   \param thread : thread identifier
+   \return A reference to the number of states expanded by thread
+   \pre thread < threads()
+   */
+  inline std::uint64_t & thread_expanded_states(std::size_t thread) { return _thread_expanded_states[thread]; }
+
+  /*!
+   \brief Accessor
+   \param thread : thread identifier
+   \return A reference to the number of transitions computed by thread
+   \pre thread < threads()
+   */
+  inline std::uint64_t & thread_computed_transitions(std::size_t thread) { return _thread_computed_transitions[thread]; }
+
+  /*!
+   \brief Accessor
+   \return number of exploration threads
+   */
+  inline std::size_t threads() const { return _thread_expanded_states.size(); }
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of successor states that have been covered by a node of the graph
+   */
+  inline std::uint64_t & covered_states() { return _covered_states; }
+
+  /*!
+   \brief Extract statistics as attributes (key, value)
+   \param m : attributes map
+   \post every statistics has been added to m, including per-thread statistics if there are more than one thread
+   */
+  void attributes(std::map<std::string, std::string> & m) const;
+
+private:
+  std::uint64_t _covered_states;                           /*!< Number of covered states */
+  std::vector<std::uint64_t> _thread_expanded_states;      /*!< Number of expanded states per thread */
+  std::vector<std::uint64_t> _thread_computed_transitions; /*!< Number of computed transitions per thread */
+};
+
+/*!
+ \class environment_summary_t
+ \brief Summary of an environment for the history-aware exploration: the names of the integer variables that are
+ written by the environment on each of its events
+ \note the summary does not depend on the explored system, hence it is computed once for each environment
+ declaration and shared by the explorations of all the properties checked against that environment (see
+ tchecker::tck_reach::zg_history_aware::environment_summary)
+ */
+class environment_summary_t {
+public:
+  /*!
+   \brief Constructor
+   \param envdecl : environment declaration
+   \post this summarizes the environment declared by envdecl
+   \throw std::invalid_argument : if envdecl is not a valid environment (see tchecker::ta_ha::system_t)
+   */
+  environment_summary_t(tchecker::parsing::system_declaration_t const & envdecl);
+
+  /*!
+   \brief Accessor
+   \param event : an event name
+   \return the names of the integer variables written by the environment on event (flattened variables), an
+   empty vector if event is not an event of the environment
+   */
+  std::vector<std::string> const & written_intvars(std::string const & event) const;
+
+  /*!
+   \brief Accessor
+   \return true if every process of the environment has an initial location, false otherwise
+   */
+  inline bool has_initial_state() const { return _initial; }
+
+private:
+  std::unordered_map<std::string, std::vector<std::string>> _written; /*!< Map : event -> intvars written on event */
+  bool _initial;                                                    /*!< Initial state flag */
+};
+
+/*!
+ \brief Summary of an environment
+ \param envdecl : environment declaration
+ \return the summary of envdecl, computed at the first call for envdecl, and shared by the next calls as long as
+ envdecl is alive
+ \throw std::invalid_argument : if envdecl is not a valid environment
+ \note thread-safe. Summaries are identified by the address of their declaration, and they are not kept when the
+ declaration has been destructed
+ */
+std::shared_ptr<tchecker::tck_reach::zg_history_aware::environment_summary_t const>
+environment_summary(std::shared_ptr<tchecker::parsing::system_declaration_t> const & envdecl);
+
+/*!
+ \brief Position of an integer variable that is not tracked by reset histories
+ */
+inline constexpr std::size_t NO_HISTORY_SLOT = std::numeric_limits<std::size_t>::max();
+
+/*!
+ \brief Positions of integer variables in reset histories
+ \param system : a system
+ \return the position in reset histories of each flattened bounded integer variable of system: the integer
+ variables that may be read by a guard (see tchecker::ta_ha::system_t::guarded_intvars) follow the clocks, in
+ increasing order of their identifiers, and the other integer variables are NO_HISTORY_SLOT
+ \note reset histories are only checked on the variables read by the guards of edges, hence the other integer
+ variables are projected away from histories: states that only differ on them share their history
+ */
+std::vector<std::size_t> intvar_history_slots(tchecker::ta_ha::system_t const & system);
+
+/*!
+ \class exploration_t
+ \brief Resumable exploration of the history-aware zone graph of a system
+ \note The graph and the waiting list are kept between calls to resume(), hence an exploration that
+ stopped early can be continued from its frontier instead of being restarted from the initial nodes
+ \note With several threads and breadth-first search order, the waiting nodes are expanded in batches:
+ successors are computed in parallel, each thread on its own zone graph, then they are inserted into the
+ graph in waiting order by the calling thread. The resulting graph is the same as with a single thread
+*/
+class exploration_t {
+public:
+  /*!
+   \brief Constructor
+   \param sysdecl : system declaration
+   \param envdecl : environment declaration
+   \param labels : comma-separated string of labels
+   \param search_order : search order
+   \param block_size : number of elements allocated in one block
+   \param table_size : size of hash tables
+   \param threads : number of exploration threads
+   \param covering : covering mode
+   \param collection : trigger of incremental garbage collection in the zone graph
+   \param zones : registry of zones shared with other zone graphs (nullptr: zones are not shared)
+   \param extrapolation : zone extrapolation
+   \param budget : budget of visited states, running time and memory, over all the calls to resume()
+   \pre labels must appear as node attributes in sysdecl
+   search_order must be either "dfs", "bfs", "dist", "random" (see tchecker::algorithms::priority) or "reset"
+   (nodes with most variables reset in their history first)
+   \post the initial nodes of the zone graph of sysdecl have been added to the graph and to the waiting list
+   \note envdecl is only used through its summary (see tchecker::tck_reach::zg_history_aware::environment_summary),
+   which is shared with the other explorations against the same environment
+   \note the exploration is sequential for "dfs" search order, whatever threads
+   \note in covering mode, a successor is not added to the graph when it is covered by a node in the graph:
+   the edge goes to the covering node instead. A node covers a state that has the same locations, integer
+   variables valuation and reset history, and a zone included in the aM-abstraction of its zone (global
+   clock bounds, or zone inclusion if clock bounds cannot be computed). Nodes in the graph are never removed
+   by covering as the backward analysis goes through their incoming edges
+   */
+  exploration_t(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl,
+                std::shared_ptr<tchecker::parsing::system_declaration_t> const & envdecl, std::string const & labels,
+                std::string const & search_order, std::size_t block_size, std::size_t table_size, std::size_t threads = 1,
+                bool covering = false, tchecker::collection_trigger_t const & collection = tchecker::collection_trigger_t{},
+                std::shared_ptr<tchecker::zg::zone_registry_t> const & zones = nullptr,
+                enum tchecker::zg_ha::extrapolation_type_t extrapolation = tchecker::zg_ha::EXTRA_M_GLOBAL,
+                tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{});
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  exploration_t(tchecker::tck_reach::zg_history_aware::exploration_t const &) = delete;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::tck_reach::zg_history_aware::exploration_t &
+  operator=(tchecker::tck_reach::zg_history_aware::exploration_t const &) = delete;
+
+  /*!
+   \brief Continue the exploration
+   \param final_nodes_container : container of final nodes
+   \param early_termination : early termination flag
+   \param iteration_num : number of final nodes after which exploration stops (-1 for no limit)
+   \post the nodes that have been found final by this call have been pushed to final_nodes_container.
+   early_termination is true if the exploration stopped after iteration_num final nodes, and is left unchanged
+   otherwise
+   \return statistics on this call (states and transitions visited by previous calls are not counted)
+   \note the exploration also stops when the budget is exceeded, which is recorded in the returned statistics
+   with the number of waiting nodes. The exploration can be resumed with a larger budget afterwards
+   */
+  tchecker::tck_reach::zg_history_aware::stats_t
+  resume(std::queue<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t> & final_nodes_container,
+         bool & early_termination, long long int iteration_num = -1);
+
+  /*!
+   \brief Prepare the graph for a new backward analysis
+   \param final_nodes_container : container of final nodes
+   \post the reachability status of every node has been reset, and every final node (including final nodes found
+   by previous calls to resume() and nodes made final by a previous backward analysis) has been pushed to
+   final_nodes_container, except the accepting nodes that are dominated by a maximal accepting node: the incoming
+   edges of a dominated node have been moved to a maximal accepting node that covers it, and it has been pruned
+   \note backward propagation along an edge only depends on its source node, hence moving the incoming edges of a
+   dominated node to a covering final node preserves the nodes made final by the backward analysis, while the
+   dominated node is not propagated. Initial accepting nodes are never dominated
+   */
+  void restart_backward_analysis(std::queue<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t> & final_nodes_container);
+
+  /*!
+   \brief Garbage collection
+   \post the nodes and edges removed from the graph, and the states, transitions and shared components only
+   used by them, have been collected
+   \note to be called after nodes have been pruned from the graph (e.g. by a backward analysis)
+   */
+  void collect();
+
+  /*!
+   \brief Accessor
+   \return the graph built so far
+   */
+  inline std::shared_ptr<tchecker::tck_reach::zg_history_aware::graph_t> const & graph() const { return _graph; }
+
+private:
+  /*!
+   \brief Expand a node
+   \param node : a node
+   \param stats : statistics
+   \post the successors of node have been added to the graph (and the new ones to the waiting list)
+   */
+  void expand(tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t const & node,
+              tchecker::tck_reach::zg_history_aware::stats_t & stats);
+
+  /*!
+   \brief Insert successors of a node into the graph
+   \param node : a node
+   \param sst : successors of node in the zone graph
+   \param stats : statistics
+   \post the successors in sst have been added to the graph (and the new ones to the waiting list), with their
+   reset history computed from node
+   \note calls the specialization of add_successors<CAPS>() for the history capabilities of the system, which is
+   selected at construction
+   */
+  inline void add_successors(tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t const & node,
+                             std::vector<typename tchecker::zg_ha::zg_t::sst_t> const & sst,
+                             tchecker::tck_reach::zg_history_aware::stats_t & stats)
+  {
+    (this->*_add_successors)(node, sst, stats);
+  }
+
+  /*!
+   \brief Capabilities of reset histories, known before the exploration starts
+   */
+  enum history_capability_t : unsigned {
+    HISTORY_CLOCKS_ONLY = 1,    /*!< The system has no integer variable: histories only have clocks */
+    HISTORY_SINGLE_WORD = 2,    /*!< Histories fit in a 64-bit word */
+    HISTORY_NO_ENV_INTVARS = 4, /*!< The environment writes no integer variable of the system */
+    HISTORY_CAPABILITIES = 8,   /*!< Number of combinations of capabilities */
+  };
+
+  /*!
+   \brief Insert successors of a node into the graph, specialized for the capabilities of reset histories
+   \tparam CAPS : capabilities of reset histories (combination of history_capability_t flags)
+   \param node : a node
+   \param sst : successors of node in the zone graph
+   \param stats : statistics
+   \post see add_successors()
+   \note with HISTORY_SINGLE_WORD, the history after an epsilon transition is computed as a 64-bit word, and it is
+   shared from a table indexed by words
+   */
+  template <unsigned CAPS>
+  void add_successors(tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t const & node,
+                      std::vector<typename tchecker::zg_ha::zg_t::sst_t> const & sst,
+                      tchecker::tck_reach::zg_history_aware::stats_t & stats);
+
+  /*!
+   \brief Type of pointer to a specialization of add_successors<CAPS>()
+   */
+  using add_successors_t = void (exploration_t::*)(tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t const &,
+                                                   std::vector<typename tchecker::zg_ha::zg_t::sst_t> const &,
+                                                   tchecker::tck_reach::zg_history_aware::stats_t &);
+
+  using node_sptr_t = tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t;
+
+  /*!
+   \brief Covering order
+   \param n : a node
+   \param s : a state
+   \param h : shared reset history of s
+   \return true if n has the same locations, integer variables valuation and reset history as (s, h), and the zone
+   of s is included in the zone of n (in its aM-abstraction in covering mode when clock bounds are available), false
+   otherwise
+   */
+  bool covers(node_sptr_t const & n, tchecker::zg::state_t const & s, tchecker::graph::reset_history_sptr_t const & h) const;
+
+  /*!
+   \brief Covering check
+   \param s : a state
+   \param h : shared reset history of s
+   \param covering_node : a node
+   \return true if some node in the graph covers (s, h), false otherwise
+   \post covering_node is a node that covers (s, h) if true is returned
+   \see exploration_t()
+   */
+  bool is_covered(tchecker::zg::state_t const & s, tchecker::graph::reset_history_sptr_t const & h,
+                  node_sptr_t & covering_node) const;
+
+  /*!
+   \brief Covering index key
+   \param s : a state
+   \param h : shared reset history of s
+   \return key of (s, h) in the covering index
+   */
+  static std::size_t covering_key(tchecker::zg::state_t const & s, tchecker::graph::reset_history_sptr_t const & h);
+
+  /*!
+   \brief Cached reset history of a vedge
+   \note the updated variables (clock IDs, then positions of tracked integer variables, see intvar_history_slots) are
+   stored in the order of the transition containers
+   */
+  struct edge_reset_history_t {
+    std::vector<std::size_t> updated;              /*!< Updated variables */
+    tchecker::graph::reset_history_sptr_t history; /*!< Shared reset history */
+    std::uint64_t word{0};                         /*!< History as a word (only with HISTORY_SINGLE_WORD) */
+  };
+
+  /*!
+   \brief Reset history of the variables updated by a transition
+   \tparam CAPS : capabilities of reset histories (combination of history_capability_t flags)
+   \param t : a transition
+   \return cached shared reset history with exactly the clocks reset and the integer variables set by t: the reset
+   history of the target state of t if t is not an epsilon transition (for an epsilon transition, it is joined with
+   the reset history of the source state)
+   \note this history only depends on the vedge of t and on its resets and integer assignments. It is
+   computed and shared once, then found in a cache indexed by vedge
+   \note the returned reference is invalidated by the next call
+   */
+  template <unsigned CAPS> edge_reset_history_t const & edge_reset_history(tchecker::zg_ha::transition_t const & t);
+
+  /*!
+   \brief Shared reset history from a word
+   \param w : a word
+   \pre histories fit in a 64-bit word (HISTORY_SINGLE_WORD)
+   \return shared reset history with the variables in w, built and shared at the first call for w
+   */
+  tchecker::graph::reset_history_sptr_t word_reset_history(std::uint64_t w);
+
+  /*!
+   \brief Hash functor on pointers to vedges, which hashes the vedges
+   */
+  struct vedge_hash_t {
+    inline std::size_t operator()(tchecker::const_vedge_sptr_t const & v) const { return tchecker::hash_value(*v); }
+  };
+
+  /*!
+   \brief Equality functor on pointers to vedges, which compares the vedges
+   */
+  struct vedge_equal_to_t {
+    inline bool operator()(tchecker::const_vedge_sptr_t const & v1, tchecker::const_vedge_sptr_t const & v2) const
+    {
+      return *v1 == *v2;
+    }
+  };
+
+  /*!
+   \brief Sequential exploration
+   \post see resume()
+   */
+  void resume_sequential(std::queue<node_sptr_t> & final_nodes_container, bool & early_termination,
+                         long long int iteration_num, tchecker::tck_reach::zg_history_aware::stats_t & stats);
+
+  /*!
+   \brief Batched exploration with parallel successor computation
+   \post see resume()
+   */
+  void resume_parallel(std::queue<node_sptr_t> & final_nodes_container, bool & early_termination,
+                       long long int iteration_num, tchecker::tck_reach::zg_history_aware::stats_t & stats);
+
+  /*!
+   \brief Check and record an accepting node
+   \param node : a node
+   \param final_nodes_container : container of final nodes
+   \param stats : statistics
+   \return true if node is accepting, false otherwise
+   \post if node is accepting, it has been flagged final and pushed to final_nodes_container, and it has been added
+   to the antichain of accepting nodes: it is dominated if it is covered by a maximal accepting node, otherwise the
+   maximal accepting nodes that it covers are dominated (see covers)
+   */
+  bool check_accepting(node_sptr_t const & node, std::queue<node_sptr_t> & final_nodes_container,
+                       tchecker::tck_reach::zg_history_aware::stats_t & stats);
+
+  /*!
+   \brief Next waiting node
+   \param node : a node
+   \return false if there is no waiting node, true otherwise
+   \post node has been removed from the backlog or from the waiting list and stored into node when true is returned
+   */
+  bool next_waiting(node_sptr_t & node);
+
+  /*!
+   \brief Check budget
+   \param stats : statistics of the current call to resume()
+   \return true if the budget is exceeded, false otherwise
+   \post if the budget is exceeded, the exceeded limit and the number of waiting nodes have been recorded in stats
+   */
+  bool budget_exceeded(tchecker::tck_reach::zg_history_aware::stats_t & stats) const;
+
+  std::shared_ptr<tchecker::ta_ha::system_t const> _system;                            /*!< System */
+  std::shared_ptr<tchecker::tck_reach::zg_history_aware::environment_summary_t const> _env; /*!< Environment */
+  std::shared_ptr<tchecker::zg_ha::zg_t> _zg;                                          /*!< Zone graph */
+  std::shared_ptr<tchecker::tck_reach::zg_history_aware::graph_t> _graph;              /*!< Graph */
+  std::unique_ptr<tchecker::waiting::waiting_t<node_sptr_t>> _waiting;                 /*!< Waiting list */
+  boost::dynamic_bitset<> _labels;                                                     /*!< Accepting labels */
+  std::vector<std::vector<tchecker::intvar_id_t>> _intvars_set_by_env;                /*!< Map : event -> intvars set by env */
+  int _num_clocks;                                                                     /*!< Number of clocks */
+  int _num_int_vars;                                                                   /*!< Tracked integer variables */
+  std::vector<std::size_t> _intvar_slots; /*!< Map : integer variable -> position in histories (see intvar_history_slots) */
+  tchecker::graph::reset_history_table_t _reset_histories;                             /*!< Shared reset histories */
+  std::unordered_map<tchecker::const_vedge_sptr_t, std::vector<edge_reset_history_t>, vedge_hash_t, vedge_equal_to_t>
+      _edge_reset_histories; /*!< Reset histories after non-epsilon transitions, by vedge */
+  std::unordered_map<std::uint64_t, tchecker::graph::reset_history_sptr_t>
+      _word_reset_histories;        /*!< Shared reset histories by word (only with HISTORY_SINGLE_WORD) */
+  unsigned _history_capabilities;   /*!< Capabilities of reset histories (history_capability_t flags) */
+  add_successors_t _add_successors; /*!< Specialization of add_successors<CAPS>() for _history_capabilities */
+  std::vector<node_sptr_t> _final_nodes; /*!< Accepting nodes, in discovery order */
+  std::unordered_map<std::size_t, std::vector<node_sptr_t>> _maximal_final_nodes; /*!< Antichain of accepting nodes by key */
+  std::vector<node_sptr_t> _dominated_final_nodes; /*!< Accepting nodes covered by a maximal accepting node */
+  node_sptr_t _pending;                   /*!< Final node left unexpanded by an early termination (if any) */
+  std::deque<node_sptr_t> _backlog;       /*!< Nodes of an interrupted batch, waiting before _waiting */
+  std::vector<typename tchecker::zg_ha::zg_t::sst_t> _sst; /*!< Successors buffer, reused by expansions */
+  std::size_t _threads;                   /*!< Number of exploration threads */
+  std::vector<std::shared_ptr<tchecker::zg_ha::zg_t>> _workers; /*!< Zone graphs of exploration threads */
+  bool _covering;                                               /*!< Covering mode */
+  std::shared_ptr<tchecker::clockbounds::global_m_map_t const> _m; /*!< Clock bounds for covering (nullptr: inclusion) */
+  std::unordered_map<std::size_t, std::vector<node_sptr_t>> _covering_index; /*!< Covering candidates by key */
+  tchecker::algorithms::budget_t _budget;                                    /*!< Budget of the exploration */
+  std::uint64_t _visited_states;                                             /*!< States visited by previous calls */
+};
+
 /*!
  \brief Run reachability algorithm on the zone graph of a system
  \param sysdecl : system declaration
@@ -250,8 +754,10 @@ public:
  \param search_order : search order
  \param block_size : number of elements allocated in one block
  \param table_size : size of hash tables
+ \param extrapolation : zone extrapolation
+ \param budget : budget of visited states, running time and memory
  \pre labels must appear as node attributes in sysdecl
- search_order must be either "dfs" or "bfs"
+ search_order must be either "dfs", "bfs", "dist", "random" or "reset" (see exploration_t)
  \return statistics on the run and the reachability graph
  */
 std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_history_aware::graph_t>>
@@ -259,7 +765,9 @@ run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl,
     std::shared_ptr<tchecker::parsing::system_declaration_t> const & envdecl,
     std::queue<tchecker::tck_reach::zg_history_aware::graph_t::node_sptr_t> & final_nodes_container, bool & early_termination,
     std::string const & labels = "", std::string const & search_order = "bfs", std::size_t block_size = 10000,
-    std::size_t table_size = 65536, long long int iteration_num = -1);
+    std::size_t table_size = 65536, long long int iteration_num = -1,
+    enum tchecker::zg_ha::extrapolation_type_t extrapolation = tchecker::zg_ha::EXTRA_M_GLOBAL,
+    tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{});
 
 /*!
  \class node_lexical_less_t
@@ -5,15 +5,22 @@
 *
  */
 
+#include <algorithm>
+#include <numeric>
 #include <ranges>
+#include <unordered_map>
 
 #include <boost/dynamic_bitset.hpp>
 
 #include "counter_example.hh"
+#include "tchecker/algorithms/reach/bitstate.hh"
 #include "tchecker/algorithms/search_order.hh"
+#include "tchecker/clockbounds/solver.hh"
+#include "tchecker/dbm/dbm.hh"
 #include "tchecker/system/static_analysis.hh"
 #include "tchecker/ta/system.hh"
 #include "tchecker/utils/log.hh"
+#include "tchecker/utils/parallel.hh"
 #include "zg-reach-compos.hh"
 
 namespace tchecker {
@@ -34,34 +41,73 @@ node_t::node_t(tchecker::zg::const_state_sptr_t const & s)
 {
 }
 
-/* super_node_t */
+/* inner_nodes_t */
 
-super_node_t::super_node_t(state_sptr_t & nodes, bool initial, bool final)
-    : tchecker::graph::node_flags_t(initial, final), _inner_nodes(nodes)
+inner_nodes_t::inner_nodes_t(tchecker::tck_reach::zg_reach_compos::state_sptr_t && nodes) : _nodes(std::move(nodes)), _hash(0)
 {
+  std::vector<std::size_t> hashes;
+  hashes.reserve(_nodes.size());
+  for (tchecker::tck_reach::zg_reach_compos::node_t const & n : _nodes)
+    hashes.push_back(tchecker::zg::shared_hash_value(n.state()));
+
+  // singletons are already normalized
+  if (_nodes.size() > 1) {
+    std::vector<std::size_t> order(_nodes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j) {
+      if (hashes[i] != hashes[j])
+        return hashes[i] < hashes[j];
+      return tchecker::zg::lexical_cmp(_nodes[i].state(), _nodes[j].state()) < 0;
+    });
+    tchecker::tck_reach::zg_reach_compos::state_sptr_t sorted;
+    std::vector<std::size_t> sorted_hashes;
+    sorted.reserve(_nodes.size());
+    sorted_hashes.reserve(_nodes.size());
+    for (std::size_t i : order) {
+      sorted.push_back(_nodes[i]);
+      sorted_hashes.push_back(hashes[i]);
+    }
+    _nodes.swap(sorted);
+    hashes.swap(sorted_hashes);
+  }
+
+  for (std::size_t h : hashes)
+    boost::hash_combine(_hash, h);
 }
 
-state_sptr_t const & super_node_t::inner_nodes() const
+bool inner_nodes_t::operator==(tchecker::tck_reach::zg_reach_compos::inner_nodes_t const & other) const
 {
-  return _inner_nodes;
+  if (_hash != other._hash || _nodes.size() != other._nodes.size())
+    return false;
+  for (std::size_t i = 0; i < _nodes.size(); ++i)
+    if (!tchecker::zg::shared_equal_to(_nodes[i].state(), other._nodes[i].state()))
+      return false;
+  return true;
 }
 
-/* node_hash_t */
+/* inner_nodes_pool_t */
 
-std::size_t node_hash_t::operator()(tchecker::tck_reach::zg_reach_compos::super_node_t const & n) const
+tchecker::tck_reach::zg_reach_compos::inner_nodes_sptr_t
+inner_nodes_pool_t::intern(tchecker::tck_reach::zg_reach_compos::state_sptr_t && nodes)
 {
-  auto it = n.inner_nodes().begin();
-  auto end = n.inner_nodes().end();
-
-  size_t h = tchecker::zg::shared_hash_value((*it).state());
-  ++it;
+  tchecker::tck_reach::zg_reach_compos::inner_nodes_sptr_t p{
+      std::make_shared<tchecker::tck_reach::zg_reach_compos::inner_nodes_t const>(std::move(nodes))};
+  return *_pool.insert(p).first;
+}
 
-  for (; it != end; ++it)
-    boost::hash_combine(h, tchecker::zg::shared_hash_value((*it).state()));
+/* super_node_t */
 
+super_node_t::super_node_t(tchecker::tck_reach::zg_reach_compos::inner_nodes_sptr_t const & inner_nodes, bool initial,
+                           bool final)
+    : tchecker::graph::node_flags_t(initial, final), _inner_nodes(inner_nodes)
+{
+}
 
+/* node_hash_t */
 
-  return h;
+std::size_t node_hash_t::operator()(tchecker::tck_reach::zg_reach_compos::super_node_t const & n) const
+{
+  return n.hash();
 }
 
 /* node_equal_to_t */
@@ -69,22 +115,7 @@ std::size_t node_hash_t::operator()(tchecker::tck_reach::zg_reach_compos::super_
 bool node_equal_to_t::operator()(tchecker::tck_reach::zg_reach_compos::super_node_t const & n1,
                                  tchecker::tck_reach::zg_reach_compos::super_node_t const & n2) const
 {
-  auto it1 = n1.inner_nodes().begin();
-  auto it2 = n2.inner_nodes().begin();
-  auto end1 = n1.inner_nodes().end();
-  auto end2 = n2.inner_nodes().end();
-  bool is_eql;
-
-  for (; true; ++it1, ++it2) {
-    if (it1 == end1 || it2 == end2) {
-      if (it1 == end1 && it2 == end2)
-        return true;
-      return false;
-    }
-    is_eql = tchecker::zg::shared_equal_to((*it1).state(), (*it2).state());
-    if (!is_eql)
-      return false;
-  }
+  return n1.inner_nodes_ptr() == n2.inner_nodes_ptr();
 }
 
 /* edge_t */
@@ -101,6 +132,8 @@ graph_t::graph_t(std::shared_ptr<tchecker::zg_compos::zg_t> const & zg, std::siz
           tchecker::tck_reach::zg_reach_compos::node_equal_to_t()),
       _zg(zg)
 {
+  // an edge is added for each successor of an inner node, hence parallel edges with the same tuple of edges
+  unique_edges(true);
 }
 
 graph_t::~graph_t()
@@ -108,6 +141,7 @@ graph_t::~graph_t()
   tchecker::graph::reachability::graph_t<tchecker::tck_reach::zg_reach_compos::super_node_t, tchecker::tck_reach::zg_reach_compos::edge_t,
                                          tchecker::tck_reach::zg_reach_compos::node_hash_t,
                                          tchecker::tck_reach::zg_reach_compos::node_equal_to_t>::clear();
+  _inner_nodes.clear();
 }
 
 void graph_t::attributes(tchecker::tck_reach::zg_reach_compos::super_node_t const & n, std::map<std::string, std::string> & m) const
@@ -211,8 +245,11 @@ public:
   }
 };
 
-std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach_compos::graph_t const & g, std::string const & name)
+std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach_compos::graph_t const & g, std::string const & name,
+                          bool lexical)
 {
+  if (!lexical)
+    return tchecker::graph::dot_output_stream(os, g, name);
   return tchecker::graph::reachability::dot_output<tchecker::tck_reach::zg_reach_compos::graph_t,
                                                    tchecker::tck_reach::zg_reach_compos::node_lexical_less_t,
                                                    tchecker::tck_reach::zg_reach_compos::edge_lexical_less_t>(os, g, name);
@@ -223,6 +260,30 @@ namespace cex {
 
 tchecker::tck_reach::zg_reach_compos::cex::symbolic_cex_t * symbolic_counter_example(tchecker::tck_reach::zg_reach_compos::graph_t const & g)
 {
+  using graph_t = tchecker::tck_reach::zg_reach_compos::graph_t;
+
+  // the run is computed in a zone graph over the same system with standard semantics and no extrapolation
+  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(g.zg().system_ptr(), g.zg().sharing_type(),
+                                                               tchecker::zg::STANDARD_SEMANTICS,
+                                                               tchecker::zg::NO_EXTRAPOLATION, 128, 128)};
+
+  // compute sequence of edges from initial to final super node in g
+  tchecker::algorithms::finite_path_extraction_algorithm_t<graph_t> algorithm;
+
+  auto && [found, root, seq] = algorithm.run(g, &tchecker::tck_reach::initial_node<graph_t>,
+                                             &tchecker::tck_reach::final_node<graph_t>, &tchecker::tck_reach::true_edge<graph_t>);
+
+  if (!found || root->inner_nodes().empty())
+    return new tchecker::zg::path::symbolic::finite_path_t{zg};
+
+  std::vector<tchecker::const_vedge_sptr_t> vedge_seq;
+  for (graph_t::edge_sptr_t const & e : seq)
+    vedge_seq.push_back(e->vedge_ptr());
+
+  // the run starts from the tuple of locations of the initial super node
+  tchecker::vloc_t const & initial_vloc = root->inner_nodes().front().state().vloc();
+
+  return tchecker::zg::path::symbolic::compute_finite_path(zg, initial_vloc, vedge_seq, true);
 }
 
 std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach_compos::cex::symbolic_cex_t const & cex,
@@ -233,6 +294,10 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach_compo
 
 tchecker::tck_reach::zg_reach_compos::cex::concrete_cex_t * concrete_counter_example(tchecker::tck_reach::zg_reach_compos::graph_t const & g)
 {
+  std::unique_ptr<tchecker::zg::path::symbolic::finite_path_t> symbolic_cex{
+      tchecker::tck_reach::zg_reach_compos::cex::symbolic_counter_example(g)};
+
+  return tchecker::zg::path::concrete::compute_finite_path(*symbolic_cex);
 }
 
 std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach_compos::cex::concrete_cex_t const & cex,
@@ -263,8 +328,295 @@ bool accepting(tchecker::tck_reach::zg_reach_compos::graph_t::node_sptr_t const
   return false;
 }
 
+/*!
+\brief Batched exploration with parallel successor computation
+\param zg : zone graph
+\param graph : reachability graph
+\param labels : accepting labels
+\param waiting : waiting list (a queue)
+\param workers : zone graphs of the exploration threads
+\param budget : budget of visited states, running time and memory
+\param stats : statistics
+\post the nodes in waiting have been explored in batches: the whole waiting list is a batch, the successors of
+all the inner nodes in the batch are computed in parallel, each thread on its own zone graph (from which states
+are copied into zg), then they are inserted into graph in waiting order. Hence graph and stats are the same as
+with a sequential breadth-first exploration. The budget is checked before each batch
+*/
+static void run_parallel(tchecker::zg_compos::zg_t & zg, tchecker::tck_reach::zg_reach_compos::graph_t & graph,
+                         boost::dynamic_bitset<> const & labels,
+                         tchecker::waiting::waiting_t<tchecker::tck_reach::zg_reach_compos::graph_t::node_sptr_t> & waiting,
+                         std::vector<std::shared_ptr<tchecker::zg_compos::zg_t>> const & workers,
+                         tchecker::algorithms::budget_t const & budget, tchecker::algorithms::reach::stats_t & stats)
+{
+  using node_sptr_t = typename tchecker::tck_reach::zg_reach_compos::graph_t::node_sptr_t;
+
+  std::vector<node_sptr_t> batch;
+  std::vector<std::tuple<std::size_t, tchecker::tck_reach::zg_reach_compos::node_t const *>> jobs; // (batch index, inner node)
+  std::vector<std::vector<typename tchecker::zg_compos::zg_t::sst_t>> successors;
+
+  bool reachable = false;
+  while (!reachable && !waiting.empty()) {
+    if (tchecker::algorithms::budget_exceeded(budget, stats.visited_states(), waiting.size(), stats))
+      break;
+
+    batch.clear();
+    while (!waiting.empty()) {
+      batch.push_back(waiting.first());
+      waiting.remove_first();
+    }
+
+    // the exploration stops at the first accepting node, in waiting order
+    std::size_t expanded = batch.size();
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      ++stats.visited_states();
+      if (accepting(batch[i], zg, labels)) {
+        batch[i]->final(true);
+        stats.reachable() = true;
+        reachable = true;
+        expanded = i;
+        break;
+      }
+    }
+
+    jobs.clear();
+    for (std::size_t i = 0; i < expanded; ++i)
+      for (tchecker::tck_reach::zg_reach_compos::node_t const & inner_node : batch[i]->inner_nodes())
+        jobs.emplace_back(i, &inner_node);
+
+    // each thread copies its source states into its own zone graph, and only touches objects allocated by it
+    successors.resize(jobs.size());
+    tchecker::parallel_for(jobs.size(), workers.size(), [&](std::size_t t, std::size_t j) {
+      tchecker::zg_compos::zg_t & worker = *workers[t];
+      tchecker::zg::const_state_sptr_t src{
+          worker.clone(static_cast<tchecker::zg::shared_state_t const &>(std::get<1>(jobs[j])->state()))};
+      worker.next(src, successors[j]);
+    });
+
+    for (std::size_t j = 0; j < jobs.size(); ++j) {
+      node_sptr_t const & super_node = batch[std::get<0>(jobs[j])];
+      for (auto && [status, s, t] : successors[j]) {
+        auto && [is_new_node, next_node] = graph.add_node(graph.intern(state_sptr_t{zg.clone(*s)}), false, false);
+        if (is_new_node)
+          waiting.insert(next_node);
+        graph.add_edge(super_node, next_node, *zg.clone(*t));
+
+        ++stats.visited_transitions();
+      }
+      successors[j].clear();
+    }
+  }
+}
+
+/*!
+\class visited_zones_t
+\brief Zones of the states visited by one direction of a bidirectional search, grouped by discrete state
+\note discrete states are compared by value, hence states from distinct zone graphs over the same system can
+be compared
+*/
+class visited_zones_t {
+public:
+  /*!
+   \brief Intersection predicate
+   \param s : a state
+   \return true if some visited state has the same tuple of locations and valuation of bounded integer variables as
+   s, and a zone that intersects the zone of s, false otherwise
+  */
+  bool intersects(tchecker::zg::state_t const & s)
+  {
+    auto it = _states.find(key(s));
+    if (it == _states.end())
+      return false;
+    tchecker::clock_id_t const dim = static_cast<tchecker::clock_id_t>(s.zone().dim());
+    _dbm.resize(static_cast<std::size_t>(dim) * dim);
+    for (tchecker::zg::const_state_sptr_t const & v : it->second)
+      if (same_discrete_state(*v, s) &&
+          tchecker::dbm::intersection(_dbm.data(), v->zone().dbm(), s.zone().dbm(), dim) == tchecker::dbm::NON_EMPTY)
+        return true;
+    return false;
+  }
+
+  /*!
+   \brief Subsumption predicate
+   \param s : a state
+   \return true if some visited state has the same tuple of locations and valuation of bounded integer variables as
+   s, and a zone that contains the zone of s, false otherwise
+  */
+  bool subsumes(tchecker::zg::state_t const & s) const
+  {
+    auto it = _states.find(key(s));
+    if (it == _states.end())
+      return false;
+    for (tchecker::zg::const_state_sptr_t const & v : it->second)
+      if (same_discrete_state(*v, s) && s.zone() <= v->zone())
+        return true;
+    return false;
+  }
+
+  /*!
+   \brief Insertion
+   \param s : a state
+   \post s has been added to the visited states
+  */
+  void insert(tchecker::zg::const_state_sptr_t const & s) { _states[key(*s)].push_back(s); }
+
+  /*!
+   \brief Clear
+   \post all visited states have been released
+  */
+  void clear() { _states.clear(); }
+
+private:
+  /*!
+   \brief Key of a discrete state
+   \param s : a state
+   \return hash value of the tuple of locations and valuation of bounded integer variables of s
+  */
+  static std::size_t key(tchecker::zg::state_t const & s)
+  {
+    return tchecker::ta::hash_value(static_cast<tchecker::ta::state_t const &>(s));
+  }
+
+  /*!
+   \brief Equality of discrete states
+   \param s1 : a state
+   \param s2 : a state
+   \return true if s1 and s2 have the same tuple of locations and valuation of bounded integer variables
+  */
+  static bool same_discrete_state(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2)
+  {
+    return static_cast<tchecker::ta::state_t const &>(s1) == static_cast<tchecker::ta::state_t const &>(s2);
+  }
+
+  std::unordered_map<std::size_t, std::vector<tchecker::zg::const_state_sptr_t>> _states; /*!< Key -> visited states */
+  std::vector<tchecker::dbm::db_t> _dbm;                                                 /*!< Intersection buffer */
+};
+
+/*!
+\brief Bidirectional exploration
+\param zg : zone graph (forward exploration)
+\param bwd : zone graph over the same system without extrapolation (backward exploration)
+\param graph : reachability graph
+\param labels : accepting labels
+\param budget : budget of visited states, running time and memory
+\param stats : statistics
+\pre graph is empty
+\post the forward exploration from the initial states of zg, and the backward exploration from the final states
+of bwd w.r.t. labels, have been run in alternation, one breadth-first level at a time, until an accepting node is
+found, or a forward state intersects a backward state with the same discrete part, or one of the explorations is
+complete, or the budget is exceeded (checked before each forward state). graph contains the forward exploration,
+stats.reachable() is true in the first two cases
+\note backward zones are exact as bwd does not extrapolate, hence a forward zone that intersects a backward zone
+contains a valuation (or, after extrapolation, simulates a valuation) that reaches labels. The backward zones are
+only compared for inclusion, and the exploration terminates since the forward exploration terminates
+*/
+static void run_bidirectional(tchecker::zg_compos::zg_t & zg, tchecker::zg_compos::zg_t & bwd,
+                              tchecker::tck_reach::zg_reach_compos::graph_t & graph,
+                              boost::dynamic_bitset<> const & labels, tchecker::algorithms::budget_t const & budget,
+                              tchecker::algorithms::reach::stats_t & stats)
+{
+  using node_sptr_t = typename tchecker::tck_reach::zg_reach_compos::graph_t::node_sptr_t;
+
+  visited_zones_t forward_zones, backward_zones;
+  std::vector<node_sptr_t> forward, next_forward;
+  std::vector<tchecker::zg::const_state_sptr_t> backward, next_backward;
+  std::vector<typename tchecker::zg_compos::zg_t::sst_t> sst;
+  bool reachable = false;
+
+  zg.initial(sst);
+  for (auto && [status, s, t] : sst) {
+    auto && [is_new_node, initial_node] = graph.add_node(graph.intern(state_sptr_t{s}), false, false);
+    initial_node->initial(true);
+    if (is_new_node) {
+      forward_zones.insert(tchecker::zg::const_state_sptr_t{s});
+      forward.push_back(initial_node);
+    }
+  }
+  sst.clear();
+
+  if (!labels.none()) {
+    bwd.final(labels, sst);
+    for (auto && [status, s, t] : sst)
+      if (!backward_zones.subsumes(*s)) {
+        reachable = reachable || forward_zones.intersects(*s);
+        backward.emplace_back(s);
+        backward_zones.insert(backward.back());
+      }
+    sst.clear();
+  }
+
+  while (!reachable && !forward.empty() && (labels.none() || !backward.empty())) {
+    // forward level
+    for (std::size_t i = 0; i < forward.size(); ++i) {
+      node_sptr_t const & super_node = forward[i];
+
+      if (tchecker::algorithms::budget_exceeded(budget, stats.visited_states(),
+                                                forward.size() - i + next_forward.size() + backward.size(), stats)) {
+        stats.reachable() = false;
+        return;
+      }
+
+      ++stats.visited_states();
+
+      if (accepting(super_node, zg, labels)) {
+        super_node->final(true);
+        reachable = true;
+        break;
+      }
+
+      for (tchecker::tck_reach::zg_reach_compos::node_t const & inner_node : super_node->inner_nodes()) {
+        zg.next(inner_node.state_ptr(), sst);
+        for (auto && [status, s, t] : sst) {
+          auto && [is_new_node, next_node] = graph.add_node(graph.intern(state_sptr_t{s}), false, false);
+          if (is_new_node) {
+            reachable = reachable || backward_zones.intersects(*s);
+            forward_zones.insert(tchecker::zg::const_state_sptr_t{s});
+            next_forward.push_back(next_node);
+          }
+          graph.add_edge(super_node, next_node, *t);
+
+          ++stats.visited_transitions();
+        }
+        sst.clear();
+      }
+
+      if (reachable)
+        break;
+    }
+    forward.swap(next_forward);
+    next_forward.clear();
+
+    if (reachable)
+      break;
+
+    // backward level
+    for (tchecker::zg::const_state_sptr_t const & s : backward) {
+      ++stats.visited_states();
+
+      bwd.prev(s, sst);
+      for (auto && [status, p, t] : sst) {
+        ++stats.visited_transitions();
+        if (backward_zones.subsumes(*p))
+          continue;
+        reachable = reachable || forward_zones.intersects(*p);
+        next_backward.emplace_back(p);
+        backward_zones.insert(next_backward.back());
+      }
+      sst.clear();
+
+      if (reachable)
+        break;
+    }
+    backward.swap(next_backward);
+    next_backward.clear();
+  }
+
+  stats.reachable() = reachable;
+}
+
 tchecker::algorithms::reach::stats_t run(tchecker::zg_compos::zg_t & zg, tchecker::tck_reach::zg_reach_compos::graph_t & graph, boost::dynamic_bitset<> const & labels,
-                                         enum tchecker::waiting::policy_t policy)
+                                         enum tchecker::waiting::policy_t policy,
+                                         std::vector<std::shared_ptr<tchecker::zg_compos::zg_t>> const & workers,
+                                         tchecker::algorithms::budget_t const & budget)
 {
   using node_sptr_t = typename tchecker::tck_reach::zg_reach_compos::graph_t::node_sptr_t;
 
@@ -279,14 +631,20 @@ tchecker::algorithms::reach::stats_t run(tchecker::zg_compos::zg_t & zg, tchecke
   zg.initial(sst);
 
   for (auto && [status, s, t] : sst) {
-    auto && [is_new_node, initial_node] = graph.add_node(state_sptr_t{s}, false, false);
+    auto && [is_new_node, initial_node] = graph.add_node(graph.intern(state_sptr_t{s}), false, false);
     initial_node->initial(true);
     if (is_new_node)
       waiting->insert(initial_node);
   }
 
-  // iterate over next nodes
-  while (!waiting->empty()) {
+  if (!workers.empty())
+    run_parallel(zg, graph, labels, *waiting, workers, budget, stats);
+
+  // iterate over next nodes (sequential exploration)
+  while (workers.empty() && !waiting->empty()) {
+    if (tchecker::algorithms::budget_exceeded(budget, stats.visited_states(), waiting->size(), stats))
+      break;
+
     node_sptr_t super_node = waiting->first();
     waiting->remove_first();
 
@@ -303,7 +661,7 @@ tchecker::algorithms::reach::stats_t run(tchecker::zg_compos::zg_t & zg, tchecke
       zg.next(inner_node.state_ptr(), sst);
 
       for (auto && [status, s, t] : sst) {
-        auto && [is_new_node, next_node] = graph.add_node(state_sptr_t{s}, false, false);
+        auto && [is_new_node, next_node] = graph.add_node(graph.intern(state_sptr_t{s}), false, false);
         if (is_new_node)
           waiting->insert(next_node);
         graph.add_edge(super_node, next_node, *t);
@@ -323,10 +681,62 @@ tchecker::algorithms::reach::stats_t run(tchecker::zg_compos::zg_t & zg, tchecke
 
 /* run */
 
+/*!
+ \brief Clock bounds of a merged system
+ \param bounds : clock bounds of the original system
+ \param original_system : original system
+ \param system : merged system
+ \return bounds if the flattened clocks of system are the flattened clocks of original_system, or if a clock of system
+ is not a clock of original_system. Otherwise, the bounds of the clocks of original_system, indexed by the
+ identifiers of the clocks with the same names in system (the merged system may not declare all the clocks of the
+ original system, see tchecker::tck_reach::activeClocks)
+ */
+static std::shared_ptr<tchecker::clockbounds::clockbounds_t const>
+merged_bounds(std::shared_ptr<tchecker::clockbounds::clockbounds_t const> const & bounds,
+              tchecker::ta::system_t const & original_system, tchecker::ta::system_t const & system)
+{
+  auto const & original_clocks = original_system.clock_variables().flattened();
+  auto const & clocks = system.clock_variables().flattened();
+  tchecker::clock_id_t const clocks_count = system.clocks_count(tchecker::VK_FLATTENED);
+  if (clocks_count == 0)
+    return bounds;
+
+  bool same = (clocks_count == original_system.clocks_count(tchecker::VK_FLATTENED));
+  std::vector<tchecker::clock_id_t> original_ids(clocks_count);
+  for (tchecker::clock_id_t id = 0; id < clocks_count; ++id) {
+    if (!original_clocks.is_variable(clocks.name(id)))
+      return bounds;
+    original_ids[id] = original_clocks.id(clocks.name(id));
+    same = same && (original_ids[id] == id);
+  }
+  if (same)
+    return bounds;
+
+  tchecker::loc_id_t const loc_nb = bounds->local_m_map()->loc_number();
+  std::shared_ptr<tchecker::clockbounds::clockbounds_t> merged{new tchecker::clockbounds::clockbounds_t{loc_nb, clocks_count}};
+  for (tchecker::clock_id_t id = 0; id < clocks_count; ++id) {
+    tchecker::clock_id_t const original_id = original_ids[id];
+    merged->global_lu_map()->L()[id] = bounds->global_lu_map()->L()[original_id];
+    merged->global_lu_map()->U()[id] = bounds->global_lu_map()->U()[original_id];
+    merged->global_m_map()->M()[id] = bounds->global_m_map()->M()[original_id];
+    for (tchecker::loc_id_t loc = 0; loc < loc_nb; ++loc) {
+      merged->local_lu_map()->L(loc)[id] = bounds->local_lu_map()->L(loc)[original_id];
+      merged->local_lu_map()->U(loc)[id] = bounds->local_lu_map()->U(loc)[original_id];
+      merged->local_m_map()->M(loc)[id] = bounds->local_m_map()->M(loc)[original_id];
+    }
+  }
+  return merged;
+}
+
 std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach_compos::graph_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & orgdecl,
     std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
-    std::string const & search_order, std::size_t block_size, std::size_t table_size)
+    std::string const & search_order, std::size_t block_size, std::size_t table_size, std::size_t threads,
+    std::size_t bitstate_size, tchecker::collection_trigger_t const & collection,
+    std::shared_ptr<tchecker::zg::zone_registry_t> const & zones, bool por,
+    enum tchecker::zg_compos::extrapolation_type_t extrapolation,
+    std::shared_ptr<tchecker::clockbounds::cache_t> const & clock_bounds, bool bidirectional,
+    tchecker::algorithms::budget_t const & budget)
 {
   std::shared_ptr<tchecker::ta::system_t const> original_system{new tchecker::ta::system_t{*orgdecl}};
   std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
@@ -334,17 +744,74 @@ run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & orgdecl,
   if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
     std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
 
-  std::shared_ptr<tchecker::zg_compos::zg_t> zg{tchecker::zg_compos::factory(original_system, system, tchecker::ts::SHARING, tchecker::zg::ELAPSED_SEMANTICS,
-                                                               tchecker::zg_compos::EXTRA_M_GLOBAL, block_size, table_size)};
+  // visited states are not stored by bitstate exploration, hence sharing would only keep dead components
+  enum tchecker::ts::sharing_type_t sharing = (bitstate_size == 0 ? tchecker::ts::SHARING : tchecker::ts::NO_SHARING);
+
+  std::shared_ptr<tchecker::clockbounds::clockbounds_t const> bounds;
+  if (extrapolation != tchecker::zg_compos::NO_EXTRAPOLATION)
+    bounds = (clock_bounds != nullptr ? clock_bounds->clockbounds(orgdecl, *original_system)
+                                      : std::shared_ptr<tchecker::clockbounds::clockbounds_t const>{
+                                            tchecker::clockbounds::compute_clockbounds(*original_system)});
+  if (bounds != nullptr)
+    bounds = merged_bounds(bounds, *original_system, *system);
+
+  // the zone graphs extrapolate w.r.t. the clock bounds of the original system
+  auto make_zg = [&](enum tchecker::ts::sharing_type_t sharing_type) {
+    if (bounds == nullptr)
+      return tchecker::zg_compos::factory(original_system, system, sharing_type, tchecker::zg::ELAPSED_SEMANTICS,
+                                          extrapolation, block_size, table_size);
+    return tchecker::zg_compos::factory(system, sharing_type, tchecker::zg::ELAPSED_SEMANTICS, extrapolation, *bounds,
+                                        block_size, table_size);
+  };
+
+  std::shared_ptr<tchecker::zg_compos::zg_t> zg{make_zg(sharing)};
+  zg->collection_trigger(collection);
+  if (zones.get() != nullptr && sharing == tchecker::ts::SHARING)
+    zg->share_zones(*zones);
 
   std::shared_ptr<tchecker::tck_reach::zg_reach_compos::graph_t> graph{
       new tchecker::tck_reach::zg_reach_compos::graph_t{zg, block_size, table_size}};
 
   boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
 
+  std::shared_ptr<tchecker::ta::por_t const> reduction{
+      por ? std::make_shared<tchecker::ta::por_t const>(*system, accepting_labels) : nullptr};
+  zg->partial_order_reduction(reduction);
+
+  // guided search orders apply to the history-aware exploration, super nodes are checked in breadth-first order
   enum tchecker::waiting::policy_t policy = tchecker::algorithms::waiting_policy(search_order);
+  if (policy == tchecker::waiting::PRIORITY_QUEUE)
+    policy = tchecker::waiting::QUEUE;
+
+  if (bitstate_size != 0) {
+    tchecker::algorithms::reach::bitstate_algorithm_t<tchecker::zg_compos::zg_t> algorithm{bitstate_size};
+    tchecker::algorithms::reach::stats_t stats = algorithm.run(*zg, accepting_labels, policy, budget);
+    return std::make_tuple(stats, graph);
+  }
+
+  // the backward zone graph does not extrapolate: its zones are exact sets of valuations that reach the labels
+  if (bidirectional) {
+    std::shared_ptr<tchecker::zg_compos::zg_t> bwd{tchecker::zg_compos::factory(
+        original_system, system, tchecker::ts::SHARING, tchecker::zg::ELAPSED_SEMANTICS,
+        tchecker::zg_compos::NO_EXTRAPOLATION, block_size, table_size)};
+    tchecker::algorithms::reach::stats_t stats;
+    stats.set_start_time();
+    run_bidirectional(*zg, *bwd, *graph, accepting_labels, budget, stats);
+    stats.set_end_time();
+    return std::make_tuple(stats, graph);
+  }
+
+  // batches preserve the exploration order of a queue only, depth-first search is sequential. Each thread has
+  // its own zone graph without sharing over the shared systems (each thread has its own virtual machine)
+  std::vector<std::shared_ptr<tchecker::zg_compos::zg_t>> workers;
+  if (threads > 1 && policy == tchecker::waiting::QUEUE) {
+    for (std::size_t t = 0; t < threads; ++t)
+      workers.emplace_back(make_zg(tchecker::ts::NO_SHARING));
+    for (std::shared_ptr<tchecker::zg_compos::zg_t> const & worker : workers)
+      worker->partial_order_reduction(reduction);
+  }
 
-  tchecker::algorithms::reach::stats_t stats = run(*zg, *graph, accepting_labels, policy);
+  tchecker::algorithms::reach::stats_t stats = run(*zg, *graph, accepting_labels, policy, workers, budget);
 
   return std::make_tuple(stats, graph);
 }
@@ -12,21 +12,25 @@
 #include <ostream>
 #include <string>
 #include <tuple>
+#include <unordered_set>
 #include <vector>
 
 #include "tchecker/algorithms/reach/algorithm.hh"
 #include "tchecker/algorithms/reach/stats.hh"
+#include "tchecker/clockbounds/cache.hh"
 #include "tchecker/graph/edge.hh"
 #include "tchecker/graph/node.hh"
 #include "tchecker/graph/reachability_graph.hh"
 #include "tchecker/parsing/declaration.hh"
 #include "tchecker/syncprod/vedge.hh"
+#include "tchecker/utils/cache.hh"
 #include "tchecker/utils/shared_objects.hh"
 #include "tchecker/waiting/waiting.hh"
 #include "tchecker/zg/path.hh"
 #include "tchecker/zg/state.hh"
 #include "tchecker/zg/transition.hh"
 #include "tchecker/zg/zg_compos.hh"
+#include "tchecker/zg/zone_registry.hh"
 
 namespace tchecker {
 
@@ -61,29 +65,136 @@ public:
 using state_sptr_t = std::vector<tchecker::tck_reach::zg_reach_compos::node_t>;
 
 /*!
-\class node_t
-\brief Node of the reachability graph of a zone graph
+\class inner_nodes_t
+\brief Normalized inner nodes of a super node, with their hash value
+*/
+class inner_nodes_t {
+public:
+  /*!
+   \brief Constructor
+   \param nodes : a vector of node_t objects
+   \post this keeps the nodes sorted by hash value of their states (see tchecker::zg::shared_hash_value), then in
+   lexical order of their states, and the hash value of the sorted nodes. Hence vectors with the same states in
+   different orders yield equal objects
+   */
+  inner_nodes_t(tchecker::tck_reach::zg_reach_compos::state_sptr_t && nodes);
+
+  /*!
+   \brief Accessor
+   \return sorted inner nodes
+   */
+  inline tchecker::tck_reach::zg_reach_compos::state_sptr_t const & nodes() const { return _nodes; }
+
+  /*!
+   \brief Accessor
+   \return hash value of the inner nodes
+   */
+  inline std::size_t hash() const { return _hash; }
+
+  /*!
+   \brief Equality predicate
+   \param other : inner nodes
+   \return true if this and other have the same hash value and the same states (w.r.t. tchecker::zg::shared_equal_to)
+   in the same order, false otherwise
+   */
+  bool operator==(tchecker::tck_reach::zg_reach_compos::inner_nodes_t const & other) const;
+
+private:
+  tchecker::tck_reach::zg_reach_compos::state_sptr_t _nodes; /*!< Sorted inner nodes */
+  std::size_t _hash;                                          /*!< Hash value of _nodes */
+};
+
+/*!
+\brief Type of shared pointer to inner nodes
+*/
+using inner_nodes_sptr_t = std::shared_ptr<tchecker::tck_reach::zg_reach_compos::inner_nodes_t const>;
+
+/*!
+\class inner_nodes_pool_t
+\brief Pool of inner nodes: equal inner nodes are shared
+*/
+class inner_nodes_pool_t {
+public:
+  /*!
+   \brief Interning
+   \param nodes : a vector of node_t objects
+   \return the inner nodes in this pool that are equal to the normalization of nodes, which have been added to this
+   pool if there were none
+   */
+  tchecker::tck_reach::zg_reach_compos::inner_nodes_sptr_t intern(tchecker::tck_reach::zg_reach_compos::state_sptr_t && nodes);
+
+  /*!
+   \brief Clear
+   \post this pool is empty (the inner nodes are released when they are not referenced anymore)
+   */
+  inline void clear() { _pool.clear(); }
+
+  /*!
+   \brief Accessor
+   \return number of inner nodes in this pool
+   */
+  inline std::size_t size() const { return _pool.size(); }
+
+private:
+  /*!
+   \brief Hash functor of the pool
+   */
+  struct hash_t {
+    std::size_t operator()(tchecker::tck_reach::zg_reach_compos::inner_nodes_sptr_t const & p) const { return p->hash(); }
+  };
+
+  /*!
+   \brief Equality functor of the pool
+   */
+  struct equal_to_t {
+    bool operator()(tchecker::tck_reach::zg_reach_compos::inner_nodes_sptr_t const & p1,
+                    tchecker::tck_reach::zg_reach_compos::inner_nodes_sptr_t const & p2) const
+    {
+      return *p1 == *p2;
+    }
+  };
+
+  std::unordered_set<tchecker::tck_reach::zg_reach_compos::inner_nodes_sptr_t, hash_t, equal_to_t> _pool; /*!< Pool */
+};
+
+/*!
+\class super_node_t
+\brief Node of the reachability graph of a zone graph, with a set of inner zone graph states
 */
 class super_node_t : public tchecker::waiting::element_t,
                      public tchecker::graph::node_flags_t {
 public:
   /*!
    \brief Constructor
-   \param nodes : a vector of node_t objects
+   \param inner_nodes : interned inner nodes
    \param initial : initial node flag
    \param final : final node flag
-   \post this node keeps a vector of node_t objects
+   \pre inner_nodes has been interned in the pool of the graph of this node (see
+   tchecker::tck_reach::zg_reach_compos::graph_t::intern)
+   \post this node shares inner_nodes
    */
-  super_node_t(tchecker::tck_reach::zg_reach_compos::state_sptr_t & nodes, bool initial, bool final);
+  super_node_t(tchecker::tck_reach::zg_reach_compos::inner_nodes_sptr_t const & inner_nodes, bool initial, bool final);
 
   /*!
    \brief Accessor to vector of nodes
-   \return vector of inner nodes
+   \return vector of inner nodes (normalized, see tchecker::tck_reach::zg_reach_compos::inner_nodes_t)
+   */
+  inline state_sptr_t const & inner_nodes() const { return _inner_nodes->nodes(); }
+
+  /*!
+   \brief Accessor
+   \return interned inner nodes
    */
-  state_sptr_t const & inner_nodes() const;
+  inline tchecker::tck_reach::zg_reach_compos::inner_nodes_sptr_t const & inner_nodes_ptr() const { return _inner_nodes; }
+
+  /*!
+   \brief Accessor
+   \return hash value of the inner nodes
+   */
+  inline std::size_t hash() const { return _inner_nodes->hash(); }
 
 private:
-  state_sptr_t _inner_nodes; /*!< Vector of node_t objects */
+  tchecker::tck_reach::zg_reach_compos::inner_nodes_sptr_t _inner_nodes; /*!< Interned inner nodes */
 };
 
 /*!
@@ -95,7 +206,7 @@ public:
   /*!
   \brief Hash function
   \param n : a node
-  \return hash value for n
+  \return hash value for n, computed when its inner nodes have been interned
   */
   std::size_t operator()(tchecker::tck_reach::zg_reach_compos::super_node_t const & n) const;
 };
@@ -110,7 +221,8 @@ public:
   \brief Equality predicate
   \param n1 : a node
   \param n2 : a node
-  \return true if n1 and n2 are equal (i.e. have same zone graph state), false otherwise
+  \return true if n1 and n2 are equal (i.e. have the same set of zone graph states), false otherwise
+  \pre the inner nodes of n1 and n2 have been interned in the same pool, hence they are compared in constant time
   */
   bool operator()(tchecker::tck_reach::zg_reach_compos::super_node_t const & n1, tchecker::tck_reach::zg_reach_compos::super_node_t const & n2) const;
 };
@@ -143,6 +255,7 @@ public:
    \param block_size : number of objects allocated in a block
    \param table_size : size of hash table
    \note this keeps a pointer on zg
+   \note edges are unique (see tchecker::graph::reachability::graph_t::unique_edges)
   */
   graph_t(std::shared_ptr<tchecker::zg_compos::zg_t> const & zg, std::size_t block_size, std::size_t table_size);
 
@@ -163,6 +276,18 @@ public:
   */
   inline tchecker::zg_compos::zg_t const & zg() const { return *_zg; }
 
+  /*!
+   \brief Interning of inner nodes
+   \param nodes : a vector of node_t objects
+   \return the inner nodes of the nodes of this graph equal to nodes (as a set of states), to build a node of this
+   graph (see tchecker::tck_reach::zg_reach_compos::inner_nodes_pool_t::intern)
+   */
+  inline tchecker::tck_reach::zg_reach_compos::inner_nodes_sptr_t
+  intern(tchecker::tck_reach::zg_reach_compos::state_sptr_t && nodes)
+  {
+    return _inner_nodes.intern(std::move(nodes));
+  }
+
   using tchecker::graph::reachability::graph_t<tchecker::tck_reach::zg_reach_compos::super_node_t, tchecker::tck_reach::zg_reach_compos::edge_t,
                                                tchecker::tck_reach::zg_reach_compos::node_hash_t,
                                                tchecker::tck_reach::zg_reach_compos::node_equal_to_t>::attributes;
@@ -185,7 +310,8 @@ protected:
   virtual void attributes(tchecker::tck_reach::zg_reach_compos::edge_t const & e, std::map<std::string, std::string> & m) const;
 
 private:
-  std::shared_ptr<tchecker::zg_compos::zg_t> _zg; /*!< Zone graph */
+  std::shared_ptr<tchecker::zg_compos::zg_t> _zg;                  /*!< Zone graph */
+  tchecker::tck_reach::zg_reach_compos::inner_nodes_pool_t _inner_nodes; /*!< Inner nodes of the nodes */
 };
 
 /*!
@@ -193,9 +319,12 @@ private:
 \param os : output stream
 \param g : graph
 \param name : graph name
+\param lexical : if true, nodes and edges are output in lexical order, otherwise they are streamed
+in the order of the graph (see tchecker::graph::dot_output_stream)
 \post graph g with name has been output to os
 */
-std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach_compos::graph_t const & g, std::string const & name);
+std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach_compos::graph_t const & g, std::string const & name,
+                          bool lexical = false);
 
 namespace cex {
 
@@ -209,6 +338,8 @@ using symbolic_cex_t = tchecker::zg::path::symbolic::finite_path_t;
 \param g : reachability graph on a zone graph
 \return a finite path from an initial node to a final node in g if any, nullptr otherwise
 \note the returned pointer shall be deleted
+\note the path is a run of the system of g (the merged system of a compositional check), computed from the
+edges of g without exploring the system again
 */
 tchecker::tck_reach::zg_reach_compos::cex::symbolic_cex_t * symbolic_counter_example(tchecker::tck_reach::zg_reach_compos::graph_t const & g);
 
@@ -267,13 +398,41 @@ public:
 \param search_order : search order
 \param block_size : number of elements allocated in one block
 \param table_size : size of hash tables
+\param threads : number of threads computing successors (only with "bfs" search order)
+\param bitstate_size : size in bytes of the bitstate table of visited states (0 means exact exploration)
+\param collection : trigger of incremental garbage collection in the zone graph
+\param zones : registry of zones shared with other zone graphs (nullptr: zones are not shared)
+\param por : partial-order reduction flag
+\param extrapolation : zone extrapolation
+\param clock_bounds : cache of clock bounds shared with other runs (nullptr: clock bounds are not shared)
+\param bidirectional : bidirectional search flag
+\param budget : budget of visited states, running time and memory
 \pre labels must appear as node attributes in sysdecl
-search_order must be either "dfs" or "bfs"
+search_order must be either "dfs", "bfs", "dist", "random" or "reset". Guided search orders ("dist", "random" and
+"reset") are checked as "bfs"
 \return statistics on the run and the reachability graph
+\note with several threads, the graph and statistics are the same as with a single thread
+\note if bitstate_size is not 0, the exploration is sequential and probabilistic, and the returned graph is
+empty, see tchecker::algorithms::reach::bitstate_algorithm_t
+\note if por is true, the returned graph is reduced w.r.t. tchecker::ta::por_t, and it has a node with labels iff
+the full graph has one
+\note clock bounds only depend on orgdecl: they are computed once for the zone graphs of all threads, and
+once for all the runs that share clock_bounds
+\note if bidirectional is true, the exploration is sequential and alternates breadth-first levels of a forward
+exploration from the initial states and of a backward exploration (without extrapolation) from the states with
+labels, and stops as soon as a forward zone intersects a backward zone of the same discrete state. The returned
+graph only contains the forward exploration, search_order and threads are ignored
+\note exploration stops when budget is exceeded, which is recorded in the returned statistics
 */
 std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach_compos::graph_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & orgdecl, std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
-    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536);
+    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536,
+    std::size_t threads = 1, std::size_t bitstate_size = 0,
+    tchecker::collection_trigger_t const & collection = tchecker::collection_trigger_t{},
+    std::shared_ptr<tchecker::zg::zone_registry_t> const & zones = nullptr, bool por = false,
+    enum tchecker::zg_compos::extrapolation_type_t extrapolation = tchecker::zg_compos::EXTRA_M_GLOBAL,
+    std::shared_ptr<tchecker::clockbounds::cache_t> const & clock_bounds = nullptr, bool bidirectional = false,
+    tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{});
 
 } // end of namespace zg_reach
 
@@ -2,15 +2,35 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 #include <ranges>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <boost/dynamic_bitset.hpp>
 
 #include "counter_example.hh"
+#include "tchecker/algorithms/reach/bitstate.hh"
+#include "tchecker/algorithms/reach/federation.hh"
+#include "tchecker/algorithms/reach/mdd.hh"
+#include "tchecker/algorithms/reach/partitioned.hh"
+#include "tchecker/algorithms/reach/stored_zones.hh"
+#include "tchecker/algorithms/reach/swarm.hh"
 #include "tchecker/algorithms/search_order.hh"
+#include "tchecker/clockbounds/solver.hh"
+#include "tchecker/graph/binary.hh"
 #include "tchecker/system/static_analysis.hh"
 #include "tchecker/ta/system.hh"
 #include "tchecker/utils/log.hh"
+#include "tchecker/utils/string.hh"
+#include "tchecker/zg/cold_state.hh"
+#include "tchecker/zg/compact_zone.hh"
+#include "tchecker/zg/delta_zone.hh"
+#include "tchecker/zg/packed_zone.hh"
+#include "tchecker/zg/reduced_zone.hh"
 #include "zg-reach.hh"
 
 namespace tchecker {
@@ -38,6 +58,11 @@ std::size_t node_hash_t::operator()(tchecker::tck_reach::zg_reach::node_t const
   return tchecker::zg::shared_hash_value(n.state());
 }
 
+std::size_t node_hash_t::discrete(tchecker::tck_reach::zg_reach::node_t const & n) const
+{
+  return tchecker::ta::shared_hash_value(n.state());
+}
+
 /* node_equal_to_t */
 
 bool node_equal_to_t::operator()(tchecker::tck_reach::zg_reach::node_t const & n1,
@@ -69,6 +94,16 @@ graph_t::~graph_t()
                                          tchecker::tck_reach::zg_reach::node_equal_to_t>::clear();
 }
 
+void graph_t::add_edge(node_sptr_t const & n1, node_sptr_t const & n2, tchecker::zg::transition_t const & t)
+{
+  tchecker::zg::profile_t * profile = _zg->profile().get();
+  if (profile != nullptr && (n2->initial() || !incoming_edges(n2).empty()))
+    profile->duplicate(n2->state().vloc(), t.vedge());
+  tchecker::graph::reachability::graph_t<tchecker::tck_reach::zg_reach::node_t, tchecker::tck_reach::zg_reach::edge_t,
+                                         tchecker::tck_reach::zg_reach::node_hash_t,
+                                         tchecker::tck_reach::zg_reach::node_equal_to_t>::add_edge(n1, n2, t);
+}
+
 void graph_t::attributes(tchecker::tck_reach::zg_reach::node_t const & n, std::map<std::string, std::string> & m) const
 {
   _zg->attributes(n.state_ptr(), m);
@@ -125,8 +160,11 @@ public:
   }
 };
 
-std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach::graph_t const & g, std::string const & name)
+std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach::graph_t const & g, std::string const & name,
+                          bool lexical)
 {
+  if (!lexical)
+    return tchecker::graph::dot_output_stream(os, g, name);
   return tchecker::graph::reachability::dot_output<tchecker::tck_reach::zg_reach::graph_t,
                                                    tchecker::tck_reach::zg_reach::node_lexical_less_t,
                                                    tchecker::tck_reach::zg_reach::edge_lexical_less_t>(os, g, name);
@@ -137,7 +175,7 @@ namespace cex {
 
 tchecker::tck_reach::zg_reach::cex::symbolic_cex_t * symbolic_counter_example(tchecker::tck_reach::zg_reach::graph_t const & g)
 {
-  return tchecker::tck_reach::symbolic_counter_example_zg<tchecker::tck_reach::zg_reach::graph_t>(g);
+  return tchecker::tck_reach::symbolic_counter_example_zg<tchecker::tck_reach::zg_reach::graph_t>(g, true);
 }
 
 std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach::cex::symbolic_cex_t const & cex,
@@ -148,7 +186,7 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach::cex:
 
 tchecker::tck_reach::zg_reach::cex::concrete_cex_t * concrete_counter_example(tchecker::tck_reach::zg_reach::graph_t const & g)
 {
-  return tchecker::tck_reach::concrete_counter_example_zg<tchecker::tck_reach::zg_reach::graph_t>(g);
+  return tchecker::tck_reach::concrete_counter_example_zg<tchecker::tck_reach::zg_reach::graph_t>(g, true);
 }
 
 std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach::cex::concrete_cex_t const & cex,
@@ -159,33 +197,662 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach::cex:
 
 } // namespace cex
 
+/* checkpoints */
+
+void write_checkpoint(std::string const & filename, tchecker::tck_reach::zg_reach::graph_t const & g,
+                      std::vector<tchecker::tck_reach::zg_reach::graph_t::node_sptr_t> const & frontier,
+                      tchecker::algorithms::reach::stats_t const & stats)
+{
+  std::unordered_map<void const *, std::size_t> waiting_rank;
+  for (std::size_t i = 0; i < frontier.size(); ++i)
+    waiting_rank.emplace(static_cast<void const *>(&*frontier[i]), i);
+
+  tchecker::graph::binary_graph_writer_t writer{g.zg().system().name()};
+  std::unordered_map<void const *, std::uint64_t> nodes_id;
+  std::map<std::string, std::string> attr;
+  for (tchecker::tck_reach::zg_reach::graph_t::node_sptr_t const & n : g.nodes()) {
+    attr.clear();
+    g.attributes(n, attr);
+    auto it = waiting_rank.find(static_cast<void const *>(&*n));
+    if (it != waiting_rank.end())
+      attr["waiting"] = std::to_string(it->second);
+    if (nodes_id.empty()) {
+      attr["checkpoint_visited_states"] = std::to_string(stats.visited_states());
+      attr["checkpoint_visited_transitions"] = std::to_string(stats.visited_transitions());
+    }
+    nodes_id.emplace(static_cast<void const *>(&*n), writer.add_node(attr));
+  }
+
+  for (tchecker::tck_reach::zg_reach::graph_t::node_sptr_t const & n : g.nodes()) {
+    std::uint64_t const src = nodes_id.at(static_cast<void const *>(&*n));
+    for (tchecker::tck_reach::zg_reach::graph_t::edge_sptr_t const & e : g.outgoing_edges(n)) {
+      attr.clear();
+      g.attributes(e, attr);
+      writer.add_edge(src, nodes_id.at(static_cast<void const *>(&*g.edge_tgt(e))), attr);
+    }
+  }
+
+  // a preempted run leaves the previous checkpoint intact
+  std::string const tmp = filename + ".tmp";
+  {
+    std::ofstream ofs{tmp, std::ios::binary};
+    if (!ofs.good())
+      throw std::runtime_error("cannot write checkpoint " + tmp);
+    writer.write(ofs);
+    if (!ofs.good())
+      throw std::runtime_error("cannot write checkpoint " + tmp);
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp, filename, ec);
+  if (ec)
+    throw std::runtime_error("cannot write checkpoint " + filename + ": " + ec.message());
+}
+
+void read_checkpoint(std::string const & filename, tchecker::zg::zg_t & zg,
+                     tchecker::tck_reach::zg_reach::graph_t & g,
+                     std::vector<tchecker::tck_reach::zg_reach::graph_t::node_sptr_t> & frontier,
+                     tchecker::algorithms::reach::stats_t & stats)
+{
+  auto invalid = [&](std::string const & reason) { return std::runtime_error(filename + ": " + reason); };
+
+  tchecker::graph::binary_graph_t checkpoint{filename};
+  if (checkpoint.name() != zg.system().name())
+    throw invalid("checkpoint of another system");
+
+  std::vector<tchecker::tck_reach::zg_reach::graph_t::node_sptr_t> nodes;
+  std::vector<tchecker::zg::zg_t::sst_t> sst;
+  std::map<std::string, std::string> attr;
+  std::map<std::size_t, tchecker::tck_reach::zg_reach::graph_t::node_sptr_t> waiting;
+  for (std::uint64_t n = 0; n < checkpoint.nodes_count(); ++n) {
+    attr.clear();
+    checkpoint.attributes(n, attr);
+    zg.build(attr, sst);
+    if (sst.size() != 1)
+      throw invalid("node " + std::to_string(n) + " is not a state of the zone graph");
+    auto && [is_new_node, node] = g.add_node(std::get<1>(sst.front()));
+    sst.clear();
+    if (!is_new_node)
+      throw invalid("node " + std::to_string(n) + " is a duplicate");
+    node->initial(attr.find("initial") != attr.end());
+    node->final(attr.find("final") != attr.end());
+    nodes.push_back(node);
+
+    auto it = attr.find("waiting");
+    if (it != attr.end())
+      waiting.emplace(std::stoull(it->second), node);
+    if (n == 0) {
+      stats.visited_states() = std::stoull(attr.at("checkpoint_visited_states"));
+      stats.visited_transitions() = std::stoull(attr.at("checkpoint_visited_transitions"));
+    }
+  }
+
+  for (auto && [rank, node] : waiting)
+    frontier.push_back(node);
+
+  // tuples of edges are not recovered from their names, which may be ambiguous, hence transitions are recomputed
+  for (std::uint64_t n = 0; n < checkpoint.nodes_count(); ++n) {
+    if (checkpoint.outgoing_edges_begin(n) == checkpoint.outgoing_edges_end(n))
+      continue;
+    zg.next(nodes[n]->state_ptr(), sst);
+    for (auto && [status, s, t] : sst) {
+      auto && [is_new_node, next_node] = g.add_node(s);
+      if (is_new_node)
+        throw invalid("successor of node " + std::to_string(n) + " is not in the checkpoint");
+      g.add_edge(nodes[n], next_node, *t);
+    }
+    sst.clear();
+  }
+}
+
+/* state stores */
+
+std::string system_hash(tchecker::parsing::system_declaration_t const & sysdecl)
+{
+  std::stringstream ss;
+  ss << sysdecl;
+  return tchecker::stable_hash(ss.str());
+}
+
+void write_store(std::string const & filename, tchecker::tck_reach::zg_reach::graph_t const & g, std::string const & hash)
+{
+  std::string const tmp = filename + ".tmp";
+  {
+    std::ofstream ofs{tmp, std::ios::binary};
+    if (!ofs.good())
+      throw std::runtime_error("cannot write state store " + tmp);
+    tchecker::graph::binary_output(ofs, g, hash);
+    if (!ofs.good())
+      throw std::runtime_error("cannot write state store " + tmp);
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp, filename, ec);
+  if (ec)
+    throw std::runtime_error("cannot write state store " + filename + ": " + ec.message());
+}
+
+bool is_store(std::string const & filename, std::string const & hash)
+{
+  std::error_code ec;
+  if (!std::filesystem::is_regular_file(filename, ec))
+    return false;
+  try {
+    tchecker::graph::binary_graph_t store{filename};
+    return store.name() == hash;
+  }
+  catch (std::runtime_error const &) {
+    return false;
+  }
+}
+
+std::tuple<tchecker::algorithms::reach::stats_t, std::uint64_t>
+query_store(std::string const & filename, tchecker::parsing::system_declaration_t const & sysdecl,
+            std::string const & labels)
+{
+  tchecker::algorithms::reach::stats_t stats;
+  stats.set_start_time();
+
+  tchecker::syncprod::system_t const system{sysdecl};
+  boost::dynamic_bitset<> const accepting_labels = system.labels(labels);
+
+  tchecker::graph::binary_graph_t store{filename};
+
+  // label index: distinct sets of labels of the stored nodes
+  std::unordered_set<std::string> labels_index;
+  std::map<std::string, std::string> attr;
+  for (std::uint64_t n = 0; n < store.nodes_count(); ++n) {
+    attr.clear();
+    store.attributes(n, attr);
+    labels_index.insert(attr["labels"]);
+  }
+
+  if (!accepting_labels.none()) {
+    for (std::string const & node_labels : labels_index) {
+      if (accepting_labels.is_subset_of(system.labels(node_labels))) {
+        stats.reachable() = true;
+        break;
+      }
+    }
+  }
+
+  stats.set_end_time();
+  return std::make_tuple(stats, store.nodes_count());
+}
+
 /* run */
 
+/*!
+ \brief Zone graph factory
+ \param system : a system of timed processes
+ \param sharing_type : type of sharing of states and transitions components
+ \param block_size : number of objects allocated in a block
+ \param table_size : size of hash tables
+ \param reduction : partial-order reduction (nullptr: no reduction)
+ \param groups : groups of symmetric processes (nullptr: no symmetry reduction)
+ \param active : active clocks (nullptr: no active-clock reduction)
+ \return a zone graph of system with elapsed semantics and local LU+ extrapolation, and the given reductions
+ \note edges only keep the tuple of edges of transitions, and counter-examples are computed on another zone graph
+ */
+static std::shared_ptr<tchecker::zg::zg_t>
+make_zg(std::shared_ptr<tchecker::ta::system_t const> const & system, enum tchecker::ts::sharing_type_t sharing_type,
+        std::size_t block_size, std::size_t table_size, std::shared_ptr<tchecker::ta::por_t const> const & reduction,
+        std::shared_ptr<tchecker::ta::symmetry_t const> const & groups,
+        std::shared_ptr<tchecker::clockbounds::active_clocks_t const> const & active)
+{
+  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, sharing_type, tchecker::zg::ELAPSED_SEMANTICS,
+                                                               tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size, table_size)};
+  zg->transition_constraints(false);
+  if (reduction.get() != nullptr)
+    zg->partial_order_reduction(reduction);
+  if (groups.get() != nullptr)
+    zg->symmetry_reduction(groups);
+  if (active.get() != nullptr)
+    zg->active_clocks_reduction(active);
+  return zg;
+}
+
+/*!
+ \brief Reductions of a run
+ \param system : a system of timed processes
+ \param accepting_labels : searched labels
+ \param por : partial-order reduction flag
+ \param symmetry : symmetry reduction flag
+ \param active_clocks : active-clock reduction flag
+ \return partial-order reduction, symmetry groups and active clocks of system, each one nullptr if its flag is false
+ \post a warning has been output for each reduction that has no effect on system
+ */
+static std::tuple<std::shared_ptr<tchecker::ta::por_t const>, std::shared_ptr<tchecker::ta::symmetry_t const>,
+                  std::shared_ptr<tchecker::clockbounds::active_clocks_t const>>
+reductions(tchecker::ta::system_t const & system, boost::dynamic_bitset<> const & accepting_labels, bool por,
+           bool symmetry, bool active_clocks)
+{
+  std::shared_ptr<tchecker::ta::por_t const> reduction{
+      por ? std::make_shared<tchecker::ta::por_t const>(system, accepting_labels) : nullptr};
+
+  std::shared_ptr<tchecker::ta::symmetry_t const> groups;
+  if (symmetry) {
+    groups = std::make_shared<tchecker::ta::symmetry_t const>(system);
+    if (groups->groups_count() == 0)
+      std::cerr << tchecker::log_warning << "no symmetric processes" << std::endl;
+  }
+
+  std::shared_ptr<tchecker::clockbounds::active_clocks_t const> active;
+  if (active_clocks) {
+    active = std::make_shared<tchecker::clockbounds::active_clocks_t const>(system);
+    if (!active->has_inactive_clocks())
+      std::cerr << tchecker::log_warning << "no inactive clocks" << std::endl;
+  }
+
+  return std::make_tuple(reduction, groups, active);
+}
+
 std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
-    std::string const & search_order, std::size_t block_size, std::size_t table_size)
+    std::string const & search_order, std::size_t block_size, std::size_t table_size,
+    tchecker::algorithms::budget_t const & budget, std::size_t bitstate_size, bool por, bool symmetry,
+    bool active_clocks, std::size_t threads, bool profile, std::string const & checkpoint_file,
+    std::chrono::milliseconds checkpoint_period, std::string const & resume_file,
+    enum tchecker::algorithms::reach::edges_t edges, bool on_the_fly)
 {
   std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
   if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
     std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
 
-  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, tchecker::ts::SHARING, tchecker::zg::ELAPSED_SEMANTICS,
-                                                               tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size, table_size)};
+  // visited states are not stored by bitstate exploration, hence sharing would only keep dead components
+  enum tchecker::ts::sharing_type_t sharing = (bitstate_size == 0 ? tchecker::ts::SHARING : tchecker::ts::NO_SHARING);
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  auto && [reduction, groups, active] = reductions(*system, accepting_labels, por, symmetry, active_clocks);
+
+  std::shared_ptr<tchecker::zg::zg_t> zg{make_zg(system, sharing, block_size, table_size, reduction, groups, active)};
+  if (profile)
+    zg->profile(std::make_shared<tchecker::zg::profile_t>(system));
 
   std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t> graph{
       new tchecker::tck_reach::zg_reach::graph_t{zg, block_size, table_size}};
 
-  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+  enum tchecker::waiting::policy_t policy = tchecker::algorithms::waiting_policy(search_order);
 
-  tchecker::tck_reach::zg_reach::algorithm_t algorithm;
+  bool const parallel = (threads > 1 && policy == tchecker::waiting::QUEUE);
+  if ((!checkpoint_file.empty() || !resume_file.empty()) && (bitstate_size != 0 || parallel))
+    throw std::invalid_argument("Checkpoints are not supported by bitstate and parallel explorations");
+  if (on_the_fly && (bitstate_size != 0 || parallel))
+    throw std::invalid_argument("On-the-fly detection is not supported by bitstate and parallel explorations");
+
+  if (bitstate_size != 0) {
+    tchecker::algorithms::reach::bitstate_algorithm_t<tchecker::zg::zg_t> algorithm{bitstate_size};
+    tchecker::algorithms::reach::stats_t stats = algorithm.run(*zg, accepting_labels, policy, budget);
+    zg->memory_usage(stats.memory_usage());
+    stats.memory_usage()["BITSTATE"] = algorithm.visited().memsize();
+    return std::make_tuple(stats, graph);
+  }
 
-  enum tchecker::waiting::policy_t policy = tchecker::algorithms::waiting_policy(search_order);
+  tchecker::tck_reach::zg_reach::algorithm_t algorithm{budget};
+  tchecker::algorithms::reach::stats_t stats;
+
+  // the profile counts successors that are visited again when their edges are added
+  algorithm.edges(profile ? tchecker::algorithms::reach::EDGES_ALL : edges);
+  algorithm.on_the_fly(on_the_fly);
 
-  tchecker::algorithms::reach::stats_t stats = algorithm.run(*zg, *graph, accepting_labels, policy);
+  if (!checkpoint_file.empty())
+    algorithm.checkpoint(
+        [&](tchecker::tck_reach::zg_reach::graph_t const & g,
+            std::vector<tchecker::tck_reach::zg_reach::graph_t::node_sptr_t> const & frontier,
+            tchecker::algorithms::reach::stats_t const & s) { write_checkpoint(checkpoint_file, g, frontier, s); },
+        checkpoint_period);
+
+  auto const priority = tchecker::algorithms::priority<tchecker::tck_reach::zg_reach::graph_t::node_sptr_t>(
+      search_order, system->as_syncprod_system(), accepting_labels);
+
+  if (!resume_file.empty()) {
+    std::vector<tchecker::tck_reach::zg_reach::graph_t::node_sptr_t> frontier;
+    tchecker::algorithms::reach::stats_t previous;
+    read_checkpoint(resume_file, *zg, *graph, frontier, previous);
+    stats = algorithm.resume(*zg, *graph, accepting_labels, policy, frontier, previous, priority);
+  }
+  else if (parallel) {
+    // each thread has its own zone graph without sharing (and its own virtual machine)
+    std::vector<std::shared_ptr<tchecker::zg::zg_t>> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+      workers.push_back(make_zg(system, tchecker::ts::NO_SHARING, block_size, table_size, reduction, groups, active));
+      workers.back()->profile(zg->profile());
+    }
+    stats = algorithm.run_bfs(*zg, *graph, accepting_labels, workers);
+  }
+  else
+    stats = algorithm.run(*zg, *graph, accepting_labels, policy, priority);
+  zg->memory_usage(stats.memory_usage());
+  graph->memory_usage(stats.memory_usage());
+  graph->occupancy(stats.occupancy());
 
   return std::make_tuple(stats, graph);
 }
 
+/* run_bitstate_cex */
+
+std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach::cex::symbolic_cex_t>>
+run_bitstate_cex(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+                 std::string const & search_order, std::size_t block_size, std::size_t table_size,
+                 tchecker::algorithms::budget_t const & budget, std::size_t bitstate_size, bool por,
+                 bool active_clocks)
+{
+  if (bitstate_size == 0)
+    throw std::invalid_argument("Size of bitstate table should be positive");
+
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+  if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
+    std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  auto && [reduction, groups, active] = reductions(*system, accepting_labels, por, false, active_clocks);
+
+  std::shared_ptr<tchecker::zg::zg_t> zg{
+      make_zg(system, tchecker::ts::NO_SHARING, block_size, table_size, reduction, groups, active)};
+
+  tchecker::algorithms::reach::bitstate_algorithm_t<tchecker::zg::zg_t> algorithm{bitstate_size, 3, true};
+  tchecker::algorithms::reach::stats_t stats =
+      algorithm.run(*zg, accepting_labels, tchecker::algorithms::waiting_policy(search_order), budget);
+  zg->memory_usage(stats.memory_usage());
+  stats.memory_usage()["BITSTATE"] = algorithm.visited().memsize();
+
+  // the run is replayed in a zone graph with standard semantics and no extrapolation
+  std::shared_ptr<tchecker::zg::zg_t> cex_zg{tchecker::zg::factory(system, tchecker::ts::NO_SHARING,
+                                                                   tchecker::zg::STANDARD_SEMANTICS,
+                                                                   tchecker::zg::NO_EXTRAPOLATION, 128, 128)};
+  auto && [found, initial_state, seq] = algorithm.trace();
+  std::shared_ptr<tchecker::tck_reach::zg_reach::cex::symbolic_cex_t> cex{
+      found ? tchecker::zg::path::symbolic::compute_finite_path(cex_zg, initial_state->vloc(), seq, true)
+            : new tchecker::tck_reach::zg_reach::cex::symbolic_cex_t{cex_zg}};
+
+  return std::make_tuple(stats, cex);
+}
+
+/* run_bmc */
+
+std::tuple<tchecker::algorithms::reach::bmc_stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach::cex::symbolic_cex_t>>
+run_bmc(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+        std::size_t depth, std::size_t cache_size, std::size_t block_size, std::size_t table_size,
+        tchecker::algorithms::budget_t const & budget, bool por, bool active_clocks)
+{
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+  if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
+    std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  auto && [reduction, groups, active] = reductions(*system, accepting_labels, por, false, active_clocks);
+
+  std::shared_ptr<tchecker::zg::zg_t> zg{
+      make_zg(system, tchecker::ts::NO_SHARING, block_size, table_size, reduction, groups, active)};
+
+  tchecker::algorithms::reach::bmc_algorithm_t<tchecker::zg::zg_t> algorithm{cache_size};
+  tchecker::algorithms::reach::bmc_stats_t stats = algorithm.run(*zg, accepting_labels, depth, budget);
+  zg->memory_usage(stats.memory_usage());
+
+  // the run is replayed in a zone graph with standard semantics and no extrapolation
+  std::shared_ptr<tchecker::zg::zg_t> cex_zg{tchecker::zg::factory(system, tchecker::ts::NO_SHARING,
+                                                                   tchecker::zg::STANDARD_SEMANTICS,
+                                                                   tchecker::zg::NO_EXTRAPOLATION, 128, 128)};
+  auto && [found, initial_state, seq] = algorithm.trace();
+  std::shared_ptr<tchecker::tck_reach::zg_reach::cex::symbolic_cex_t> cex{
+      found ? tchecker::zg::path::symbolic::compute_finite_path(cex_zg, initial_state->vloc(), seq, true)
+            : new tchecker::tck_reach::zg_reach::cex::symbolic_cex_t{cex_zg}};
+
+  return std::make_tuple(stats, cex);
+}
+
+/* run_intval_mdd */
+
+tchecker::algorithms::reach::stats_t
+run_intval_mdd(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+               std::string const & search_order, std::size_t block_size, std::size_t table_size,
+               tchecker::algorithms::budget_t const & budget, bool por, bool symmetry, bool active_clocks)
+{
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+  if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
+    std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  auto && [reduction, groups, active] = reductions(*system, accepting_labels, por, symmetry, active_clocks);
+
+  // states are not shared: the states of a group only differ by their valuations, which are stored in the diagrams
+  std::shared_ptr<tchecker::zg::zg_t> zg{
+      make_zg(system, tchecker::ts::NO_SHARING, block_size, table_size, reduction, groups, active)};
+
+  tchecker::algorithms::reach::mdd_algorithm_t<tchecker::zg::zg_t> algorithm{system->integer_variables().flattened()};
+  tchecker::algorithms::reach::stats_t stats =
+      algorithm.run(*zg, accepting_labels, tchecker::algorithms::waiting_policy(search_order), budget);
+  zg->memory_usage(stats.memory_usage());
+
+  return stats;
+}
+
+/* run_federation */
+
+tchecker::algorithms::reach::stats_t
+run_federation(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+               std::string const & search_order, std::size_t block_size, std::size_t table_size,
+               tchecker::algorithms::budget_t const & budget, bool por, bool symmetry, bool active_clocks)
+{
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+  if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
+    std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  auto && [reduction, groups, active] = reductions(*system, accepting_labels, por, symmetry, active_clocks);
+
+  // states are not shared: the zones of explored states are restricted to their new parts
+  std::shared_ptr<tchecker::zg::zg_t> zg{
+      make_zg(system, tchecker::ts::NO_SHARING, block_size, table_size, reduction, groups, active)};
+
+  tchecker::algorithms::reach::federation_algorithm_t<tchecker::zg::zg_t> algorithm;
+  tchecker::algorithms::reach::stats_t stats =
+      algorithm.run(*zg, accepting_labels, tchecker::algorithms::waiting_policy(search_order), budget);
+  zg->memory_usage(stats.memory_usage());
+
+  return stats;
+}
+
+/* run_stored_zones */
+
+/*!
+ \brief Run reachability algorithm with stored zones
+ \tparam STORAGE : storage format of the zones
+ \param zg : a zone graph
+ \param accepting_labels : searched labels
+ \param search_order : search order
+ \param budget : budget of visited states, running time and memory
+ \param packing : layout of packed valuations of bounded integer variables (nullptr: valuations are not packed)
+ \param storage : storage format of the zones
+ \return statistics on the run of tchecker::algorithms::reach::stored_zones_algorithm_t over zg
+ \throw std::invalid_argument : if packing is not nullptr and STORAGE stores the valuations
+ */
+template <class STORAGE>
+static tchecker::algorithms::reach::stats_t
+run_stored_zones_algorithm(tchecker::zg::zg_t & zg, boost::dynamic_bitset<> const & accepting_labels,
+                           std::string const & search_order, tchecker::algorithms::budget_t const & budget,
+                           std::shared_ptr<tchecker::intval_packing_t const> const & packing,
+                           STORAGE const & storage = STORAGE{})
+{
+  if (packing.get() != nullptr) {
+    if constexpr (tchecker::algorithms::reach::stores_intval_v<STORAGE>)
+      throw std::invalid_argument("The storage format of zones already stores the valuations of integer variables");
+    else
+      return run_stored_zones_algorithm(zg, accepting_labels, search_order, budget, nullptr,
+                                        tchecker::algorithms::reach::packed_intval_storage_t<STORAGE>{storage, packing});
+  }
+
+  tchecker::algorithms::reach::stored_zones_algorithm_t<tchecker::zg::zg_t, STORAGE> algorithm{storage};
+  tchecker::algorithms::reach::stats_t stats =
+      algorithm.run(zg, accepting_labels, tchecker::algorithms::waiting_policy(search_order), budget);
+  zg.memory_usage(stats.memory_usage());
+  return stats;
+}
+
+tchecker::algorithms::reach::stats_t
+run_stored_zones(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+                 enum tchecker::tck_reach::zg_reach::zone_storage_t storage, std::string const & search_order,
+                 std::size_t block_size, std::size_t table_size, tchecker::algorithms::budget_t const & budget, bool por,
+                 bool symmetry, bool active_clocks, bool packed_intvals)
+{
+  if (storage == tchecker::tck_reach::zg_reach::ZONE_STORAGE_FULL)
+    throw std::invalid_argument("Full DBMs are stored in the nodes of reachability graphs");
+
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+  if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
+    std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  // compact zones are stored over the active clocks, hence inactive clocks have to be freed
+  auto && [reduction, groups, active] =
+      reductions(*system, accepting_labels, por, symmetry,
+                 active_clocks || storage == tchecker::tck_reach::zg_reach::ZONE_STORAGE_COMPACT);
+
+  // states are not shared: stored nodes keep their own tuples of locations and valuations, and are compared by value
+  std::shared_ptr<tchecker::zg::zg_t> zg{
+      make_zg(system, tchecker::ts::NO_SHARING, block_size, table_size, reduction, groups, active)};
+
+  std::shared_ptr<tchecker::intval_packing_t const> packing;
+  if (packed_intvals)
+    packing = std::make_shared<tchecker::intval_packing_t const>(system->integer_variables().flattened());
+
+  switch (storage) {
+  case tchecker::tck_reach::zg_reach::ZONE_STORAGE_REDUCED:
+    return run_stored_zones_algorithm<tchecker::zg::reduced_zone_storage_t>(*zg, accepting_labels, search_order, budget,
+                                                                           packing);
+  case tchecker::tck_reach::zg_reach::ZONE_STORAGE_DELTA:
+    return run_stored_zones_algorithm<tchecker::zg::delta_zone_storage_t>(*zg, accepting_labels, search_order, budget,
+                                                                         packing);
+  case tchecker::tck_reach::zg_reach::ZONE_STORAGE_PACKED: {
+    std::unique_ptr<tchecker::clockbounds::clockbounds_t> clock_bounds{tchecker::clockbounds::compute_clockbounds(*system)};
+    if (clock_bounds.get() == nullptr)
+      throw std::runtime_error("Unable to compute clock bounds of the system");
+    tchecker::zg::packed_zone_storage_t const packed{tchecker::zg::bound_width(*clock_bounds->global_m_map())};
+    return run_stored_zones_algorithm(*zg, accepting_labels, search_order, budget, packing, packed);
+  }
+  case tchecker::tck_reach::zg_reach::ZONE_STORAGE_COLD:
+    return run_stored_zones_algorithm<tchecker::zg::cold_state_storage_t>(*zg, accepting_labels, search_order, budget,
+                                                                         packing);
+  case tchecker::tck_reach::zg_reach::ZONE_STORAGE_COMPACT:
+    return run_stored_zones_algorithm(*zg, accepting_labels, search_order, budget, packing,
+                                      tchecker::zg::compact_zone_storage_t{active});
+  default:
+    throw std::invalid_argument("Unknown storage format of zones");
+  }
+}
+
+/* run_lazy */
+
+tchecker::algorithms::reach::lazy_stats_t
+run_lazy(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+         std::string const & search_order, std::size_t block_size, std::size_t table_size,
+         tchecker::algorithms::budget_t const & budget)
+{
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+  if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
+    std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  // zones are exact, and transitions keep their constraints, from which the clock bounds are discovered
+  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, tchecker::ts::NO_SHARING,
+                                                               tchecker::zg::ELAPSED_SEMANTICS,
+                                                               tchecker::zg::NO_EXTRAPOLATION, block_size, table_size)};
+
+  tchecker::algorithms::reach::lazy_algorithm_t<tchecker::zg::zg_t> algorithm;
+  tchecker::algorithms::reach::lazy_stats_t stats =
+      algorithm.run(*zg, accepting_labels, tchecker::algorithms::waiting_policy(search_order), budget);
+  zg->memory_usage(stats.memory_usage());
+
+  return stats;
+}
+
+/* run_partitioned */
+
+std::tuple<tchecker::algorithms::reach::stats_t, std::vector<std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t>>>
+run_partitioned(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+                std::size_t partitions, std::size_t block_size, std::size_t table_size, bool por, bool symmetry,
+                bool active_clocks)
+{
+  if (partitions == 0)
+    throw std::invalid_argument("Number of partitions should be positive");
+
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+  if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
+    std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  auto && [reduction, groups, active] = reductions(*system, accepting_labels, por, symmetry, active_clocks);
+
+  // each partition has its own zone graph (and virtual machine) and graph shard, which share nothing with the others
+  std::vector<std::shared_ptr<tchecker::zg::zg_t>> zgs;
+  std::vector<std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t>> graphs;
+  for (std::size_t p = 0; p < partitions; ++p) {
+    zgs.push_back(make_zg(system, tchecker::ts::SHARING, block_size, table_size, reduction, groups, active));
+    graphs.push_back(std::make_shared<tchecker::tck_reach::zg_reach::graph_t>(zgs.back(), block_size, table_size));
+  }
+
+  tchecker::algorithms::reach::partitioned_algorithm_t<tchecker::zg::zg_t, tchecker::tck_reach::zg_reach::graph_t>
+      algorithm;
+  tchecker::algorithms::reach::stats_t stats = algorithm.run(zgs, graphs, accepting_labels);
+  // memory usage is summed over partitions
+  std::map<std::string, std::size_t> m;
+  for (std::size_t p = 0; p < partitions; ++p) {
+    zgs[p]->memory_usage(m);
+    graphs[p]->memory_usage(m);
+    for (auto && [key, size] : m)
+      stats.memory_usage()[key] += size;
+    m.clear();
+  }
+
+  return std::make_tuple(stats, graphs);
+}
+
+/* run_swarm */
+
+tchecker::algorithms::reach::stats_t
+run_swarm(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+          std::size_t swarm, std::size_t bitstate_size, std::size_t block_size, std::size_t table_size,
+          tchecker::algorithms::budget_t const & budget, bool por, bool symmetry, bool active_clocks)
+{
+  if (swarm == 0)
+    throw std::invalid_argument("Number of searches of the swarm should be positive");
+  if (bitstate_size == 0)
+    throw std::invalid_argument("Size of bitstate table should be positive");
+
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+  if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
+    std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  auto && [reduction, groups, active] = reductions(*system, accepting_labels, por, symmetry, active_clocks);
+
+  // each search has its own zone graph (and virtual machine), visited states are not stored
+  std::vector<std::shared_ptr<tchecker::zg::zg_t>> zgs;
+  for (std::size_t i = 0; i < swarm; ++i)
+    zgs.push_back(make_zg(system, tchecker::ts::NO_SHARING, block_size, table_size, reduction, groups, active));
+
+  tchecker::algorithms::reach::swarm_algorithm_t<tchecker::zg::zg_t> algorithm{bitstate_size};
+  tchecker::algorithms::reach::stats_t stats = algorithm.run(zgs, accepting_labels, budget);
+  // memory usage is summed over searches
+  std::map<std::string, std::size_t> m;
+  for (std::size_t i = 0; i < swarm; ++i) {
+    zgs[i]->memory_usage(m);
+    for (auto && [key, size] : m)
+      stats.memory_usage()[key] += size;
+    m.clear();
+  }
+  stats.memory_usage()["BITSTATE"] = swarm * bitstate_size;
+
+  return stats;
+}
+
 } // namespace zg_reach
 
 } // end of namespace tck_reach
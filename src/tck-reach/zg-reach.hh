@@ -5,12 +5,17 @@
 #ifndef TCHECKER_ZG_REACH_ALGORITHM_HH
 #define TCHECKER_ZG_REACH_ALGORITHM_HH
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <ostream>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include "tchecker/algorithms/reach/algorithm.hh"
+#include "tchecker/algorithms/reach/bmc.hh"
+#include "tchecker/algorithms/reach/lazy.hh"
 #include "tchecker/algorithms/reach/stats.hh"
 #include "tchecker/graph/edge.hh"
 #include "tchecker/graph/node.hh"
@@ -69,6 +74,14 @@ public:
   \return hash value for n
   */
   std::size_t operator()(tchecker::tck_reach::zg_reach::node_t const & n) const;
+
+  /*!
+  \brief Hash function on discrete parts
+  \param n : a node
+  \return hash value for the tuple of locations and the valuation of bounded integer variables in n
+  \note the nodes of the reachability graph are stored by discrete parts (see tchecker::graph::find::two_level_graph_t)
+  */
+  std::size_t discrete(tchecker::tck_reach::zg_reach::node_t const & n) const;
 };
 
 /*!
@@ -134,6 +147,18 @@ public:
   */
   inline tchecker::zg::zg_t const & zg() const { return *_zg; }
 
+  /*!
+   \brief Add an edge
+   \param n1 : source node
+   \param n2 : target node
+   \param t : a zone graph transition
+   \pre n1 and n2 are nodes of this graph
+   \post an edge from n1 to n2 along t has been added to this graph. If the zone graph has a profile (see
+   tchecker::zg::zg_t::profile) and n2 was visited before (n2 is initial or has an incoming edge), this successor has
+   been recorded as a duplicate in the profile
+  */
+  void add_edge(node_sptr_t const & n1, node_sptr_t const & n2, tchecker::zg::transition_t const & t);
+
   using tchecker::graph::reachability::graph_t<tchecker::tck_reach::zg_reach::node_t, tchecker::tck_reach::zg_reach::edge_t,
                                                tchecker::tck_reach::zg_reach::node_hash_t,
                                                tchecker::tck_reach::zg_reach::node_equal_to_t>::attributes;
@@ -164,9 +189,12 @@ private:
  \param os : output stream
  \param g : graph
  \param name : graph name
+ \param lexical : if true, nodes and edges are output in lexical order, otherwise they are streamed
+ in the order of the graph (see tchecker::graph::dot_output_stream)
  \post graph g with name has been output to os
 */
-std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach::graph_t const & g, std::string const & name);
+std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach::graph_t const & g, std::string const & name,
+                          bool lexical = false);
 
 namespace cex {
 
@@ -179,6 +207,9 @@ using symbolic_cex_t = tchecker::zg::path::symbolic::finite_path_t;
  \brief Compute a symbolic counter-example from a reachability graph of a zone graph
  \param g : reachability graph on a zone graph
  \return a finite path from an initial node to a final node in g if any, nullptr otherwise
+ \note the path is extracted along the edges to the nodes from their parents when g only stores those edges
+ (see tchecker::algorithms::reach::EDGES_PARENT), in time linear in its length. It is a shortest path when g has been
+ built by a breadth-first search
  \note the returned pointer shall be deleted
 */
 tchecker::tck_reach::zg_reach::cex::symbolic_cex_t * symbolic_counter_example(tchecker::tck_reach::zg_reach::graph_t const & g);
@@ -204,6 +235,9 @@ using concrete_cex_t = tchecker::zg::path::concrete::finite_path_t;
  \param g : reachability graph on a zone graph
  \return a finite path from an initial node to a final node in g with concrete clock valuations if any,
  nullptr otherwise
+ \note the path is extracted along the edges to the nodes from their parents when g only stores those edges
+ (see tchecker::algorithms::reach::EDGES_PARENT), in time linear in its length. It is a shortest path when g has been
+ built by a breadth-first search
  \note the returned pointer shall be deleted
 */
 tchecker::tck_reach::zg_reach::cex::concrete_cex_t * concrete_counter_example(tchecker::tck_reach::zg_reach::graph_t const & g);
@@ -231,6 +265,89 @@ public:
   using tchecker::algorithms::reach::algorithm_t<tchecker::zg::zg_t, tchecker::tck_reach::zg_reach::graph_t>::algorithm_t;
 };
 
+/*!
+ \brief Write a checkpoint of a reachability graph
+ \param filename : checkpoint file
+ \param g : a graph
+ \param frontier : waiting nodes of g, in the order in which they would be explored
+ \param stats : statistics of the run that builds g
+ \post g has been written to filename in binary format (see tchecker::graph::binary_graph_writer_t), with the
+ attributes of its nodes and edges. Each node in frontier has attribute "waiting" with its position in frontier, and
+ the first node has attributes "checkpoint_visited_states" and "checkpoint_visited_transitions" from stats. The
+ checkpoint is first written to filename.tmp, then renamed to filename, hence filename is always a complete checkpoint
+ \throw std::runtime_error : if filename cannot be written
+ */
+void write_checkpoint(std::string const & filename, tchecker::tck_reach::zg_reach::graph_t const & g,
+                      std::vector<tchecker::tck_reach::zg_reach::graph_t::node_sptr_t> const & frontier,
+                      tchecker::algorithms::reach::stats_t const & stats);
+
+/*!
+ \brief Restore a reachability graph from a checkpoint
+ \param filename : checkpoint file
+ \param zg : zone graph of g
+ \param g : a graph
+ \param frontier : waiting nodes
+ \param stats : statistics
+ \pre filename has been written by tchecker::tck_reach::zg_reach::write_checkpoint from a graph over a zone graph
+ configured as zg, and g is empty
+ \post the nodes of filename have been added to g, from the states built by zg from their attributes.
+ The edges of g have been recomputed as the transitions from the nodes that have outgoing edges in filename. The
+ waiting nodes of the checkpoint have been added to frontier in their order, and the numbers of visited states and
+ transitions of the checkpoint have been set in stats
+ \throw std::runtime_error : if filename is not a checkpoint of the system of zg, or if its nodes are not states
+ of zg
+ */
+void read_checkpoint(std::string const & filename, tchecker::zg::zg_t & zg,
+                     tchecker::tck_reach::zg_reach::graph_t & g,
+                     std::vector<tchecker::tck_reach::zg_reach::graph_t::node_sptr_t> & frontier,
+                     tchecker::algorithms::reach::stats_t & stats);
+
+/*!
+ \brief Hash of a system declaration
+ \param sysdecl : system declaration
+ \return FNV-1a hash of the declarations in sysdecl, as 16 hexadecimal digits
+ \note the hash is stable between runs (see tchecker::stable_hash), as it is kept in state stores
+ */
+std::string system_hash(tchecker::parsing::system_declaration_t const & sysdecl);
+
+/*!
+ \brief Write a state store of a reachability graph
+ \param filename : state store file
+ \param g : a graph of a fully explored zone graph
+ \param hash : hash of the system of g (see tchecker::tck_reach::zg_reach::system_hash)
+ \post g has been written to filename in binary format (see tchecker::graph::binary_output), with name hash. The
+ store is first written to filename.tmp, then renamed to filename, hence filename is always a complete store
+ \throw std::runtime_error : if filename cannot be written
+ */
+void write_store(std::string const & filename, tchecker::tck_reach::zg_reach::graph_t const & g, std::string const & hash);
+
+/*!
+ \brief Check if a file is a state store of a system
+ \param filename : file name
+ \param hash : hash of a system (see tchecker::tck_reach::zg_reach::system_hash)
+ \return true if filename is a graph in binary format with name hash, false otherwise (in particular if filename
+ does not exist or is not a binary graph)
+ */
+bool is_store(std::string const & filename, std::string const & hash);
+
+/*!
+ \brief Answer a reachability query from a state store
+ \param filename : state store file
+ \param sysdecl : system declaration
+ \param labels : comma-separated string of labels
+ \pre filename is a state store of sysdecl (see tchecker::tck_reach::zg_reach::is_store)
+ \return statistics of the query, and the number of nodes in filename. A state with labels is reachable if labels is not
+ empty and some node in filename has all the labels (the zones of stored nodes are not empty). No state nor transition
+ is visited
+ \throw std::invalid_argument : if labels contains a label that is not declared in sysdecl
+ \throw std::runtime_error : if filename cannot be read
+ \note the distinct sets of labels of the nodes are indexed first, then the query is checked against each set,
+ which is read from the strings of filename (identical strings are stored once)
+ */
+std::tuple<tchecker::algorithms::reach::stats_t, std::uint64_t>
+query_store(std::string const & filename, tchecker::parsing::system_declaration_t const & sysdecl,
+            std::string const & labels);
+
 /*!
  \brief Run reachability algorithm on the zone graph of a system
  \param sysdecl : system declaration
@@ -238,13 +355,257 @@ public:
  \param search_order : search order
  \param block_size : number of elements allocated in one block
  \param table_size : size of hash tables
+ \param budget : budget of visited states, running time and memory
+ \param bitstate_size : size in bytes of the bitstate table of visited states (0 means exact exploration)
+ \param por : partial-order reduction flag
+ \param symmetry : symmetry reduction flag
+ \param active_clocks : active-clock reduction flag
+ \param threads : number of threads computing successors (only with "bfs" search order)
+ \param profile : model profiling flag
+ \param checkpoint_file : checkpoint file (empty means no checkpoint)
+ \param checkpoint_period : time between checkpoints
+ \param resume_file : checkpoint file the run resumes from (empty means a run from the initial states)
+ \param edges : edges stored in the returned graph
+ \param on_the_fly : detection of accepting nodes on the fly
  \pre labels must appear as node attributes in sysdecl
- search_order must be either "dfs" or "bfs"
+ search_order must be either "dfs", "bfs", "dist" or "random" (see tchecker::algorithms::priority), and must be
+ "dfs" or "bfs" if bitstate_size is not 0
  \return statistics on the run and the reachability graph
+ \note exploration stops when budget is exceeded, see tchecker::algorithms::reach::algorithm_t
+ \note if bitstate_size is not 0, visited states are only stored as hash values, the returned graph is empty
+ and the run is probabilistic, see tchecker::algorithms::reach::bitstate_algorithm_t
+ \note if por is true, the successors of a state along the edges of a reducible process only are explored when
+ they exist (see tchecker::ta::por_t): the returned graph is a reduced graph, which has a node with labels iff the
+ full graph has one
+ \note if symmetry is true, the returned graph has a single node for all the permutations of a node by the groups of
+ symmetric processes (see tchecker::ta::symmetry_t), and its edges are not transitions of the zone graph
+ \note if active_clocks is true, the clocks that are inactive in a node are free in its zone (see
+ tchecker::clockbounds::active_clocks_t)
+ \note with several threads and "bfs" search order, the exploration is a level-synchronous parallel breadth-first
+ search (see tchecker::algorithms::reach::algorithm_t::run_bfs): the graph and statistics are the same as with a
+ single thread
+ \note if profile is true, the zone graph of the returned graph has a profile of the edges and locations of the system
+ (see tchecker::zg::zg_t::profile), shared by the threads
+ \note if checkpoint_file is not empty, the graph, the waiting nodes and the statistics of the run are written to
+ checkpoint_file every checkpoint_period (see tchecker::tck_reach::zg_reach::write_checkpoint). If resume_file is not
+ empty, the run restores the graph of resume_file and continues from its waiting nodes. The run that resumes should
+ have the same system, search order and reductions as the run that took the checkpoint
+ \note the returned graph only has the edges in edges (see tchecker::algorithms::reach::algorithm_t::edges), except
+ if profile is true: all edges are then stored, as the profile counts the successors that are visited again
+ \note if on_the_fly is true, the exploration stops as soon as an accepting node is discovered, and the successors
+ of a node are computed lazily (see tchecker::algorithms::reach::algorithm_t::on_the_fly)
+ \throw std::invalid_argument : if checkpoint_file or resume_file is not empty, or on_the_fly is true, and
+ bitstate_size is not 0 or threads > 1 with "bfs" search order
+ \throw std::runtime_error : if resume_file is not a checkpoint of system sysdecl
  */
 std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
-    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536);
+    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536,
+    tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{}, std::size_t bitstate_size = 0,
+    bool por = false,
+    bool symmetry = false, bool active_clocks = false, std::size_t threads = 1, bool profile = false,
+    std::string const & checkpoint_file = "",
+    std::chrono::milliseconds checkpoint_period = std::chrono::milliseconds{0}, std::string const & resume_file = "",
+    enum tchecker::algorithms::reach::edges_t edges = tchecker::algorithms::reach::EDGES_ALL, bool on_the_fly = false);
+
+/*!
+ \brief Run bitstate reachability algorithm on the zone graph of a system, and compute a counter example
+ \param sysdecl : system declaration
+ \param labels : comma-separated string of labels
+ \param search_order : search order, either "dfs" or "bfs"
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param budget : budget of visited states, running time and memory
+ \param bitstate_size : size in bytes of the bitstate table of visited states
+ \param por : partial-order reduction flag
+ \param active_clocks : active-clock reduction flag
+ \pre labels must appear as node attributes in sysdecl
+ \return statistics on the run, and a symbolic counter example (empty if no state with labels has been found)
+ \throw std::invalid_argument : if bitstate_size is 0
+ \note the exploration runs in trace mode (see tchecker::algorithms::reach::bitstate_algorithm_t): it only stores
+ the visited states as hash values, and the parent and the tuple of edges of each explored state. The zones of
+ the counter example are recomputed along the run found, in a zone graph with standard semantics and no
+ extrapolation
+ */
+std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach::cex::symbolic_cex_t>>
+run_bitstate_cex(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+                 std::string const & search_order, std::size_t block_size, std::size_t table_size,
+                 tchecker::algorithms::budget_t const & budget, std::size_t bitstate_size, bool por = false,
+                 bool active_clocks = false);
+
+/*!
+ \brief Run bounded reachability algorithm on the zone graph of a system, and compute a counter example
+ \param sysdecl : system declaration
+ \param labels : comma-separated string of labels
+ \param depth : maximal number of transitions of the runs
+ \param cache_size : number of entries of the cache of visited states (0: no cache)
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param budget : budget of visited states, running time and memory
+ \param por : partial-order reduction flag
+ \param active_clocks : active-clock reduction flag
+ \pre labels must appear as node attributes in sysdecl
+ \return statistics on the run, and a symbolic counter example (empty if no state with labels has been found)
+ \note the zone graph is explored by depth-first searches with increasing depth bounds, that only keep the current
+ run in memory (see tchecker::algorithms::reach::bmc_algorithm_t). The zones of the counter example are recomputed
+ along the run found, in a zone graph with standard semantics and no extrapolation
+ */
+std::tuple<tchecker::algorithms::reach::bmc_stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach::cex::symbolic_cex_t>>
+run_bmc(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+        std::size_t depth, std::size_t cache_size = 0, std::size_t block_size = 10000, std::size_t table_size = 65536,
+        tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{}, bool por = false,
+        bool active_clocks = false);
+
+/*!
+ \brief Run reachability algorithm on the zone graph of a system, with visited valuations of bounded integer variables
+ stored as decision diagrams
+ \param sysdecl : system declaration
+ \param labels : comma-separated string of labels
+ \param search_order : search order, either "dfs" or "bfs"
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param budget : budget of visited states, running time and memory
+ \param por : partial-order reduction flag
+ \param symmetry : symmetry reduction flag
+ \param active_clocks : active-clock reduction flag
+ \pre labels must appear as node attributes in sysdecl
+ \return statistics on the run: the visited states with the same tuple of locations and zone are grouped, and the
+ valuations of each group are stored in a decision diagram (see tchecker::algorithms::reach::mdd_algorithm_t)
+ \note no graph is computed
+ */
+tchecker::algorithms::reach::stats_t
+run_intval_mdd(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
+               std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536,
+               tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{}, bool por = false,
+               bool symmetry = false, bool active_clocks = false);
+
+/*!
+ \brief Run reachability algorithm on the zone graph of a system, with visited zones stored as federations
+ \param sysdecl : system declaration
+ \param labels : comma-separated string of labels
+ \param search_order : search order, either "dfs" or "bfs"
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param budget : budget of visited states, running time and memory
+ \param por : partial-order reduction flag
+ \param symmetry : symmetry reduction flag
+ \param active_clocks : active-clock reduction flag
+ \pre labels must appear as node attributes in sysdecl
+ \return statistics on the run: the visited zones with the same tuple of locations and valuation of bounded integer
+ variables are stored as a union of zones (see tchecker::algorithms::reach::federation_algorithm_t)
+ \note no graph is computed
+ */
+tchecker::algorithms::reach::stats_t
+run_federation(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
+               std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536,
+               tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{}, bool por = false,
+               bool symmetry = false, bool active_clocks = false);
+
+/*!
+ \brief Storage formats of the zones of the nodes at rest (see tchecker::tck_reach::zg_reach::run_stored_zones)
+ */
+enum zone_storage_t {
+  ZONE_STORAGE_FULL,    /*!< Full DBMs, in the nodes of reachability graphs */
+  ZONE_STORAGE_REDUCED, /*!< Minimal constraint sets (see tchecker::zg::reduced_zone_t) */
+  ZONE_STORAGE_DELTA,   /*!< Differences with reference zones, or full DBMs (see tchecker::zg::delta_zone_storage_t) */
+  ZONE_STORAGE_PACKED,  /*!< DBMs with bounds of the width of the clock bounds (see tchecker::zg::packed_zone_t) */
+  ZONE_STORAGE_COLD,    /*!< Compressed zones and valuations of integer variables (see tchecker::zg::cold_state_t) */
+  ZONE_STORAGE_COMPACT, /*!< DBMs over the active clocks, with active-clock reduction (see tchecker::zg::compact_zone_t) */
+};
+
+/*!
+ \brief Run reachability algorithm on the zone graph of a system, with the zones of the nodes at rest stored in a
+ compressed format
+ \param sysdecl : system declaration
+ \param labels : comma-separated string of labels
+ \param storage : storage format of the zones
+ \param search_order : search order, either "dfs" or "bfs"
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param budget : budget of visited states, running time and memory
+ \param por : partial-order reduction flag
+ \param symmetry : symmetry reduction flag
+ \param active_clocks : active-clock reduction flag
+ \param packed_intvals : flag for bit-packed valuations of bounded integer variables in the nodes
+ \pre labels must appear as node attributes in sysdecl
+ \return statistics on the run: the visited and waiting nodes keep their zones in format storage, and the zones are
+ restored when the nodes are explored or compared to new states (see
+ tchecker::algorithms::reach::stored_zones_algorithm_t). The same states are visited as with full DBMs
+ \throw std::invalid_argument : if storage is ZONE_STORAGE_FULL, or if packed_intvals is set and storage is
+ ZONE_STORAGE_COLD (which stores the valuations)
+ \note no graph is computed
+ */
+tchecker::algorithms::reach::stats_t
+run_stored_zones(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+                 enum tchecker::tck_reach::zg_reach::zone_storage_t storage, std::string const & search_order = "bfs",
+                 std::size_t block_size = 10000, std::size_t table_size = 65536,
+                 tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{}, bool por = false,
+                 bool symmetry = false, bool active_clocks = false, bool packed_intvals = false);
+
+/*!
+ \brief Run reachability algorithm with lazy abstraction on the zone graph of a system
+ \param sysdecl : system declaration
+ \param labels : comma-separated string of labels
+ \param search_order : search order, either "dfs" or "bfs"
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param budget : budget of visited states, running time and memory
+ \pre labels must appear as node attributes in sysdecl
+ \return statistics on the run: zones are exact, and the clock bounds of the aLU coverings are discovered along
+ the exploration (see tchecker::algorithms::reach::lazy_algorithm_t)
+ \throw std::invalid_argument : if the system has diagonal clock constraints
+ \note no graph is computed
+ */
+tchecker::algorithms::reach::lazy_stats_t
+run_lazy(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
+         std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536,
+         tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{});
+
+/*!
+ \brief Run partitioned reachability algorithm on the zone graph of a system
+ \param sysdecl : system declaration
+ \param labels : comma-separated string of labels
+ \param partitions : number of partitions
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param por : partial-order reduction flag
+ \param symmetry : symmetry reduction flag
+ \param active_clocks : active-clock reduction flag
+ \pre labels must appear as node attributes in sysdecl
+ \return statistics on the run and the graph shards of the partitions: each state is owned by one partition (see
+ tchecker::algorithms::reach::partitioned_algorithm_t), which explores it on its own zone graph
+ \throw std::invalid_argument : if partitions is 0
+ \note the graph shards have no edges, hence no certificate can be computed from them
+ */
+std::tuple<tchecker::algorithms::reach::stats_t, std::vector<std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t>>>
+run_partitioned(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
+                std::size_t partitions = 1, std::size_t block_size = 10000, std::size_t table_size = 65536,
+                bool por = false, bool symmetry = false, bool active_clocks = false);
+
+/*!
+ \brief Run swarm reachability algorithm on the zone graph of a system
+ \param sysdecl : system declaration
+ \param labels : comma-separated string of labels
+ \param swarm : number of searches
+ \param bitstate_size : size in bytes of the bitstate table of each search
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param budget : budget of visited states, running time and memory of each search
+ \param por : partial-order reduction flag
+ \param symmetry : symmetry reduction flag
+ \param active_clocks : active-clock reduction flag
+ \pre labels must appear as node attributes in sysdecl
+ \return statistics on the run: swarm depth-first searches with diversified orders of successors have been run in
+ parallel, each one on its own zone graph (see tchecker::algorithms::reach::swarm_algorithm_t)
+ \throw std::invalid_argument : if swarm or bitstate_size is 0
+ \note the run is probabilistic, and no graph is computed
+ */
+tchecker::algorithms::reach::stats_t
+run_swarm(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
+          std::size_t swarm = 1, std::size_t bitstate_size = 1 << 24, std::size_t block_size = 10000,
+          std::size_t table_size = 65536,
+          tchecker::algorithms::budget_t const & budget = tchecker::algorithms::budget_t{}, bool por = false,
+          bool symmetry = false, bool active_clocks = false);
 
 } // end of namespace zg_reach
 
@@ -0,0 +1,155 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <algorithm>
+
+#include "concrete.hh"
+
+namespace tchecker {
+
+namespace tck_simulate {
+
+#define CV_ID(id) (id == tchecker::REFCLOCK_ID ? 0 : id + 1) // converts from system IDs to clockval IDs
+
+/* concrete_simulator_t */
+
+concrete_simulator_t::concrete_simulator_t(std::shared_ptr<tchecker::ta::system_t const> const & system,
+                                           std::size_t block_size)
+    : _system(system), _ta(system, tchecker::ts::NO_SHARING, block_size, block_size), _state(nullptr),
+      _transition(nullptr), _delay(0)
+{
+  unsigned short const size = static_cast<unsigned short>(_system->clocks_count(tchecker::VK_FLATTENED) + 1);
+  _clockval = tchecker::clockval_allocate_and_construct(size, 0);
+  _scratch = tchecker::clockval_allocate_and_construct(size, 0);
+}
+
+concrete_simulator_t::~concrete_simulator_t()
+{
+  tchecker::clockval_destruct_and_deallocate(_clockval);
+  tchecker::clockval_destruct_and_deallocate(_scratch);
+}
+
+bool concrete_simulator_t::initial(std::mt19937_64 & generator)
+{
+  tchecker::initial(*_clockval);
+  _delay = 0;
+
+  _sst.clear();
+  _ta.initial(_sst);
+  _sst.erase(std::remove_if(_sst.begin(), _sst.end(),
+                            [&](auto const & sst) {
+                              return !tchecker::satisfies(*_clockval, std::get<2>(sst)->tgt_invariant_container());
+                            }),
+             _sst.end());
+  if (_sst.empty())
+    return false;
+
+  auto const & [status, s, t] = _sst[std::uniform_int_distribution<std::size_t>{0, _sst.size() - 1}(generator)];
+  _state = s;
+  _transition = t;
+  _sst.clear();
+  return true;
+}
+
+bool concrete_simulator_t::next(std::mt19937_64 & generator)
+{
+  _sst.clear();
+  _ta.next(tchecker::ta::const_state_sptr_t{_state}, _sst);
+
+  tchecker::clock_constraint_container_t const & invariant = _transition->tgt_invariant_container();
+
+  _delays.assign(1, 0);
+  if (tchecker::ta::delay_allowed(*_system, _state->vloc())) {
+    add_bounds(invariant);
+    for (auto const & [status, s, t] : _sst)
+      add_bounds(t->guard_container());
+    std::sort(_delays.begin(), _delays.end());
+    _delays.erase(std::unique(_delays.begin(), _delays.end()), _delays.end());
+    _delays.erase(_delays.begin(), std::lower_bound(_delays.begin(), _delays.end(), tchecker::clock_rational_value_t{0}));
+    std::size_t const bounds = _delays.size();
+    for (std::size_t k = 0; k + 1 < bounds; ++k)
+      _delays.push_back((_delays[k] + _delays[k + 1]) / 2);
+    _delays.push_back(_delays[bounds - 1] + 1);
+  }
+
+  _enabled.clear();
+  for (tchecker::clock_rational_value_t const & d : _delays) {
+    delayed(d);
+    if (!tchecker::satisfies(*_scratch, invariant))
+      continue;
+    for (std::size_t k = 0; k < _sst.size(); ++k) {
+      tchecker::ta::transition_t const & t = *std::get<2>(_sst[k]);
+      if (!tchecker::satisfies(*_scratch, t.guard_container()))
+        continue;
+      if (!t.tgt_invariant_container().empty()) {
+        tchecker::tck_simulate::reset(*_scratch, t.reset_container());
+        bool const sat = tchecker::satisfies(*_scratch, t.tgt_invariant_container());
+        delayed(d);
+        if (!sat)
+          continue;
+      }
+      _enabled.emplace_back(k, d);
+    }
+  }
+  if (_enabled.empty()) {
+    _sst.clear();
+    return false;
+  }
+
+  auto const & [k, d] = _enabled[std::uniform_int_distribution<std::size_t>{0, _enabled.size() - 1}(generator)];
+  auto const & [status, s, t] = _sst[k];
+  delayed(d);
+  tchecker::tck_simulate::reset(*_scratch, t->reset_container());
+  std::swap(_clockval, _scratch);
+  _state = s;
+  _transition = t;
+  _delay = d;
+  _sst.clear();
+  return true;
+}
+
+boost::dynamic_bitset<> concrete_simulator_t::labels() const { return tchecker::ta::labels(*_system, *_state); }
+
+void concrete_simulator_t::state_attributes(std::map<std::string, std::string> & m) const
+{
+  tchecker::ta::attributes(*_system, *_state, m);
+  tchecker::clock_index_t const & clock_index = _system->clock_variables().flattened().index();
+  m["clockval"] =
+      tchecker::to_string(*_clockval, [&](tchecker::clock_id_t id) { return (id == 0 ? "$0" : clock_index.value(id - 1)); });
+}
+
+void concrete_simulator_t::transition_attributes(std::map<std::string, std::string> & m) const
+{
+  tchecker::ta::attributes(*_system, *_transition, m);
+  m["delay"] = tchecker::to_string(_delay);
+}
+
+void concrete_simulator_t::delayed(tchecker::clock_rational_value_t const & d)
+{
+  (*_scratch)[0] = 0;
+  for (tchecker::clock_id_t x = 1; x < _clockval->size(); ++x)
+    (*_scratch)[x] = (*_clockval)[x] + d;
+}
+
+void concrete_simulator_t::add_bounds(tchecker::clock_constraint_container_t const & constraints)
+{
+  for (tchecker::clock_constraint_t const & c : constraints) {
+    if (c.id1() != tchecker::REFCLOCK_ID && c.id2() == tchecker::REFCLOCK_ID) // x # c
+      _delays.push_back(c.value() - (*_clockval)[CV_ID(c.id1())]);
+    else if (c.id1() == tchecker::REFCLOCK_ID && c.id2() != tchecker::REFCLOCK_ID) // -y # c
+      _delays.push_back(-c.value() - (*_clockval)[CV_ID(c.id2())]);
+  }
+}
+
+/* reset */
+
+void reset(tchecker::clockval_t & clockval, tchecker::clock_reset_container_t const & resets)
+{
+  for (tchecker::clock_reset_t const & r : resets)
+    clockval[CV_ID(r.left_id())] = clockval[CV_ID(r.right_id())] + r.value();
+}
+
+} // namespace tck_simulate
+
+} // namespace tchecker
@@ -0,0 +1,166 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#ifndef TCHECKER_TCK_SIMULATE_CONCRETE_HH
+#define TCHECKER_TCK_SIMULATE_CONCRETE_HH
+
+/*!
+ \file concrete.hh
+ \brief Simulation of timed automata over concrete clock valuations
+*/
+
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/ta/ta.hh"
+#include "tchecker/variables/clocks.hh"
+
+namespace tchecker {
+
+namespace tck_simulate {
+
+/*!
+ \class concrete_simulator_t
+ \brief Random simulation of a system of timed processes over concrete states (vloc, intval, clockval)
+ \note Discrete steps are computed by the transition system of the timed automaton (tchecker::ta::ta_t), hence no
+ zone is computed. Guards and invariants are checked directly on clock valuations.
+ \note Delays are rational. A step chooses a delay among: 0, the bounds of the guards of the successors and of
+ the invariant of the current state, the middles between consecutive bounds, and one time unit after the last
+ bound. Every edge that can be fired after some delay is fired after one of these delays, including edges with
+ equality guards. The (delay, edge) pair is drawn uniformly among the enabled ones
+ */
+class concrete_simulator_t {
+public:
+  /*!
+   \brief Constructor
+   \param system : a system of timed processes
+   \param block_size : number of states and transitions allocated in one block
+   */
+  concrete_simulator_t(std::shared_ptr<tchecker::ta::system_t const> const & system, std::size_t block_size = 1000);
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  concrete_simulator_t(tchecker::tck_simulate::concrete_simulator_t const &) = delete;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::tck_simulate::concrete_simulator_t & operator=(tchecker::tck_simulate::concrete_simulator_t const &) = delete;
+
+  /*!
+   \brief Destructor
+   */
+  ~concrete_simulator_t();
+
+  /*!
+   \brief Start a simulation
+   \param generator : random generator
+   \return true if the system has an initial state, false otherwise
+   \post if true is returned, the current state is an initial state chosen at random, with all clocks equal to 0
+   */
+  bool initial(std::mt19937_64 & generator);
+
+  /*!
+   \brief Simulation step
+   \param generator : random generator
+   \pre initial() returned true
+   \return true if some edge can be fired from the current state after some delay, false otherwise
+   \post if true is returned, the current state has been updated with a delay and an edge chosen at random
+   */
+  bool next(std::mt19937_64 & generator);
+
+  /*!
+   \brief Accessor
+   \return current state (locations and integer valuation)
+   */
+  inline tchecker::ta::state_t const & state() const { return *_state; }
+
+  /*!
+   \brief Accessor
+   \return current clock valuation (index 0 is the reference clock, index x+1 is the value of clock x)
+   */
+  inline tchecker::clockval_t const & clockval() const { return *_clockval; }
+
+  /*!
+   \brief Accessor
+   \return last transition (empty for an initial state)
+   */
+  inline tchecker::ta::transition_t const & transition() const { return *_transition; }
+
+  /*!
+   \brief Accessor
+   \return delay of the last step (0 for an initial state)
+   */
+  inline tchecker::clock_rational_value_t delay() const { return _delay; }
+
+  /*!
+   \brief Accessor
+   \return labels of the current state
+   */
+  boost::dynamic_bitset<> labels() const;
+
+  /*!
+   \brief Accessor to state attributes as strings
+   \param m : a map of string pairs (key, value)
+   \post attributes of the current state (vloc, intval and clockval) have been added to map m
+   */
+  void state_attributes(std::map<std::string, std::string> & m) const;
+
+  /*!
+   \brief Accessor to transition attributes as strings
+   \param m : a map of string pairs (key, value)
+   \post attributes of the last transition (vedge and delay) have been added to map m
+   */
+  void transition_attributes(std::map<std::string, std::string> & m) const;
+
+private:
+  /*!
+   \brief Compute the clock valuation after a delay
+   \param d : delay
+   \post _scratch is the current clock valuation after delay d
+   */
+  void delayed(tchecker::clock_rational_value_t const & d);
+
+  /*!
+   \brief Add the bounds of clock constraints to the candidate delays
+   \param constraints : clock constraints
+   \post the delays at which a constraint on a single clock changes its truth value have been added to _delays
+   */
+  void add_bounds(tchecker::clock_constraint_container_t const & constraints);
+
+  std::shared_ptr<tchecker::ta::system_t const> _system; /*!< System */
+  tchecker::ta::ta_t _ta;                                 /*!< Transition system of the timed automaton */
+  tchecker::ta::state_sptr_t _state;                      /*!< Current state */
+  tchecker::ta::transition_sptr_t _transition;            /*!< Last transition */
+  tchecker::clockval_t * _clockval;                       /*!< Current clock valuation */
+  tchecker::clockval_t * _scratch;                        /*!< Clock valuation of candidate steps */
+  tchecker::clock_rational_value_t _delay;                /*!< Delay of the last step */
+  std::vector<tchecker::ta::ta_t::sst_t> _sst;            /*!< Successors */
+  std::vector<tchecker::clock_rational_value_t> _delays;  /*!< Candidate delays */
+  std::vector<std::tuple<std::size_t, tchecker::clock_rational_value_t>> _enabled; /*!< Enabled (successor, delay) */
+};
+
+/*!
+ \brief Apply clock resets to a clock valuation
+ \param clockval : clock valuation
+ \param resets : clock resets
+ \pre resets are expressed over the clocks in clockval
+ \post the resets have been applied in order to clockval
+ */
+void reset(tchecker::clockval_t & clockval, tchecker::clock_reset_container_t const & resets);
+
+} // namespace tck_simulate
+
+} // namespace tchecker
+
+#endif // TCHECKER_TCK_SIMULATE_CONCRETE_HH
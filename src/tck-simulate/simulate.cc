@@ -2,14 +2,21 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <ctime>
 #include <limits>
+#include <stdexcept>
 #include <vector>
 
+#include "concrete.hh"
 #include "display.hh"
 #include "simulate.hh"
+#include "tchecker/graph/output.hh"
 #include "tchecker/ta/system.hh"
+#include "tchecker/ta/ta.hh"
+#include "tchecker/utils/parallel.hh"
 #include "tchecker/zg/zg.hh"
 
 namespace tchecker {
@@ -232,6 +239,149 @@ void onestep_simulation(tchecker::parsing::system_declaration_t const & sysdecl,
   }
 }
 
+// Batch simulation
+
+batch_stats_t::batch_stats_t(std::vector<std::string> const & labels)
+    : labels(labels), walks(0), steps(0), deadlocks(0), hits(labels.size(), 0),
+      first_hit(labels.size(), std::numeric_limits<std::uint64_t>::max()), seconds(0)
+{
+}
+
+void batch_stats_t::merge(tchecker::tck_simulate::batch_stats_t const & stats)
+{
+  assert(hits.size() == stats.hits.size());
+  walks += stats.walks;
+  steps += stats.steps;
+  deadlocks += stats.deadlocks;
+  for (std::size_t l = 0; l < hits.size(); ++l) {
+    hits[l] += stats.hits[l];
+    first_hit[l] = std::min(first_hit[l], stats.first_hit[l]);
+  }
+}
+
+void batch_stats_t::attributes(std::map<std::string, std::string> & m) const
+{
+  m["WALKS"] = std::to_string(walks);
+  m["STEPS"] = std::to_string(steps);
+  m["DEADLOCKS"] = std::to_string(deadlocks);
+  m["RUNNING_TIME_SECONDS"] = std::to_string(seconds);
+  if (seconds > 0)
+    m["STEPS_PER_SECOND"] = std::to_string(static_cast<std::uint64_t>(steps / seconds));
+  for (std::size_t l = 0; l < hits.size(); ++l) {
+    m["HITS_" + labels[l]] = std::to_string(hits[l]);
+    if (hits[l] > 0)
+      m["FIRST_HIT_" + labels[l]] = std::to_string(first_hit[l]);
+  }
+}
+
+/*!
+ \brief Run a random walk
+ \param simulator : concrete simulator
+ \param nsteps : maximal number of steps
+ \param generator : random generator
+ \param hit : labels hit by the walk
+ \param stats : statistics of walks
+ \post a walk of at most nsteps steps from a random initial state has been added to stats
+ */
+static void random_walk(tchecker::tck_simulate::concrete_simulator_t & simulator, std::size_t nsteps,
+                        std::mt19937_64 & generator, boost::dynamic_bitset<> & hit,
+                        tchecker::tck_simulate::batch_stats_t & stats)
+{
+  auto record_labels = [&](std::uint64_t i) {
+    boost::dynamic_bitset<> const labels = simulator.labels();
+    for (std::size_t l = labels.find_first(); l != boost::dynamic_bitset<>::npos; l = labels.find_next(l)) {
+      if (hit[l])
+        continue;
+      hit[l] = true;
+      ++stats.hits[l];
+      stats.first_hit[l] = std::min(stats.first_hit[l], i);
+    }
+  };
+
+  ++stats.walks;
+  hit.reset();
+  if (!simulator.initial(generator)) {
+    ++stats.deadlocks;
+    return;
+  }
+  record_labels(0);
+
+  for (std::size_t i = 1; i <= nsteps; ++i) {
+    if (!simulator.next(generator)) {
+      ++stats.deadlocks;
+      return;
+    }
+    ++stats.steps;
+    record_labels(i);
+  }
+}
+
+tchecker::tck_simulate::batch_stats_t batch_simulation(tchecker::parsing::system_declaration_t const & sysdecl,
+                                                       std::size_t nsteps, std::size_t walks, std::size_t threads,
+                                                       std::mt19937_64::result_type seed)
+{
+  if (walks == 0)
+    throw std::invalid_argument("Number of walks should be positive");
+  if (threads == 0)
+    throw std::invalid_argument("Number of threads should be positive");
+
+  auto start = std::chrono::steady_clock::now();
+
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{sysdecl}};
+  std::vector<std::string> labels;
+  for (tchecker::label_id_t l = 0; l < system->labels_count(); ++l)
+    labels.push_back(system->label_name(l));
+
+  threads = std::min(threads, walks);
+  std::vector<tchecker::tck_simulate::batch_stats_t> stats(threads, tchecker::tck_simulate::batch_stats_t{labels});
+  std::vector<std::unique_ptr<tchecker::tck_simulate::concrete_simulator_t>> simulators(threads);
+  std::vector<boost::dynamic_bitset<>> hits(threads, boost::dynamic_bitset<>(labels.size()));
+
+  tchecker::parallel_for(walks, threads, [&](std::size_t thread, std::size_t i) {
+    if (simulators[thread] == nullptr)
+      simulators[thread] = std::make_unique<tchecker::tck_simulate::concrete_simulator_t>(system);
+    std::mt19937_64 generator{seed + i};
+    tchecker::tck_simulate::random_walk(*simulators[thread], nsteps, generator, hits[thread], stats[thread]);
+  });
+
+  tchecker::tck_simulate::batch_stats_t batch{labels};
+  for (tchecker::tck_simulate::batch_stats_t const & s : stats)
+    batch.merge(s);
+  batch.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return batch;
+}
+
+std::size_t concrete_randomized_simulation(tchecker::parsing::system_declaration_t const & sysdecl, std::size_t nsteps,
+                                           std::mt19937_64::result_type seed, std::ostream & os)
+{
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{sysdecl}};
+  tchecker::tck_simulate::concrete_simulator_t simulator{system};
+  std::mt19937_64 generator{seed};
+  std::map<std::string, std::string> attr;
+
+  tchecker::graph::dot_output_header(os, sysdecl.name());
+  if (!simulator.initial(generator)) {
+    tchecker::graph::dot_output_footer(os);
+    return 0;
+  }
+  simulator.state_attributes(attr);
+  attr["initial"] = "true";
+  tchecker::graph::dot_output_node(os, "0", attr);
+
+  std::size_t i = 0;
+  while (i < nsteps && simulator.next(generator)) {
+    ++i;
+    attr.clear();
+    simulator.state_attributes(attr);
+    tchecker::graph::dot_output_node(os, std::to_string(i), attr);
+    attr.clear();
+    simulator.transition_attributes(attr);
+    tchecker::graph::dot_output_edge(os, std::to_string(i - 1), std::to_string(i), attr);
+  }
+  tchecker::graph::dot_output_footer(os);
+  return i + 1;
+}
+
 } // namespace tck_simulate
 
 } // namespace tchecker
\ No newline at end of file
@@ -10,9 +10,13 @@
  \brief Simulation of timed automata
 */
 
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <ostream>
+#include <random>
 #include <string>
+#include <vector>
 
 #include "display.hh"
 #include "graph.hh"
@@ -61,6 +65,74 @@ void onestep_simulation(tchecker::parsing::system_declaration_t const & sysdecl,
                         enum tchecker::tck_simulate::display_type_t display_type,
                         std::map<std::string, std::string> const & starting_state_attributes);
 
+/*!
+ \class batch_stats_t
+ \brief Statistics of a batch of random walks
+ */
+class batch_stats_t {
+public:
+  /*!
+   \brief Constructor
+   \param labels : names of labels
+   \post all counters are 0
+   */
+  explicit batch_stats_t(std::vector<std::string> const & labels = {});
+
+  /*!
+   \brief Add the statistics of another batch
+   \param stats : statistics
+   \pre stats and this have the same number of labels
+   \post the counters of stats have been added to this, and the first hits are the earliest of both
+   */
+  void merge(tchecker::tck_simulate::batch_stats_t const & stats);
+
+  /*!
+   \brief Accessor to statistics
+   \param m : a map (key, value) from strings to strings
+   \post the statistics of the batch have been added to m, including for each label the number of walks that
+   hit it (HITS_label) and the earliest step where it was hit (FIRST_HIT_label), if any
+   */
+  void attributes(std::map<std::string, std::string> & m) const;
+
+  std::vector<std::string> labels;      /*!< Label -> name */
+  std::uint64_t walks;                  /*!< Number of walks */
+  std::uint64_t steps;                  /*!< Number of steps of all walks */
+  std::uint64_t deadlocks;              /*!< Number of walks that stopped with no enabled transition */
+  std::vector<std::uint64_t> hits;      /*!< Label -> number of walks that hit the label */
+  std::vector<std::uint64_t> first_hit; /*!< Label -> earliest step that hit the label */
+  double seconds;                       /*!< Running time in seconds */
+};
+
+/*!
+ \brief Batch of randomized simulations of timed automata
+ \param sysdecl : system declaration
+ \param nsteps : maximal number of steps of each walk
+ \param walks : number of walks
+ \param threads : number of threads
+ \param seed : seed of the walks, walk i uses seed + i
+ \return statistics of the labels hit by walks from the initial states of the system of timed processes sysdecl
+ \note walks follow concrete clock valuations (see tchecker::tck_simulate::concrete_simulator_t). No zone is
+ computed, and no state is stored or displayed
+ \throw std::invalid_argument : if walks or threads is 0
+ */
+tchecker::tck_simulate::batch_stats_t batch_simulation(tchecker::parsing::system_declaration_t const & sysdecl,
+                                                       std::size_t nsteps, std::size_t walks, std::size_t threads,
+                                                       std::mt19937_64::result_type seed);
+
+/*!
+ \brief Randomized simulation of timed automata over concrete clock valuations
+ \param sysdecl : system declaration
+ \param nsteps : number of simulation steps
+ \param seed : seed of the simulation
+ \param os : output stream
+ \return number of states in the simulated trace
+ \post the trace of at most nsteps randomized steps from an initial state of sysdecl has been output to os in
+ graphviz DOT language, as it is computed. States have concrete clock valuations, and transitions have delays
+ (see tchecker::tck_simulate::concrete_simulator_t)
+ */
+std::size_t concrete_randomized_simulation(tchecker::parsing::system_declaration_t const & sysdecl, std::size_t nsteps,
+                                           std::mt19937_64::result_type seed, std::ostream & os);
+
 } // namespace tck_simulate
 
 } // namespace tchecker
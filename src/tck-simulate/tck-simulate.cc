@@ -3,6 +3,7 @@
  */
 
 #include "tchecker/config.hh"
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <getopt.h>
@@ -10,10 +11,12 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <thread>
 #if USE_BOOST_JSON
 #include <boost/json.hpp>
 #endif
 #include "simulate.hh"
+#include "tchecker/algorithms/stats.hh"
 
 /*!
  \file tck-simulate.cc
@@ -26,6 +29,11 @@ static struct option long_options[] = {{"interactive", no_argument, 0, 'i'},
                                        {"output", required_argument, 0, 'o'},
                                        {"trace", no_argument, 0, 't'},
                                        {"help", no_argument, 0, 'h'},
+                                       {"stats-format", required_argument, 0, 0},
+                                       {"concrete", no_argument, 0, 0},
+                                       {"walks", required_argument, 0, 0},
+                                       {"seed", required_argument, 0, 0},
+                                       {"jobs", required_argument, 0, 0},
 #if USE_BOOST_JSON
                                        {"state", required_argument, 0, 's'},
                                        {"json", no_argument, 0, 0},
@@ -52,6 +60,13 @@ void usage(char * progname)
   std::cerr << "               zone: conjunction of clock-constraints (following TChecker expression syntax)" << std::endl;
 #endif
   std::cerr << "   -t          output simulation trace, incompatible with -1" << std::endl;
+  std::cerr << "   --stats-format f  output statistics of the simulation as text or json" << std::endl;
+  std::cerr << "   --concrete  randomized simulation (with -r N) on concrete clock valuations instead of zones," << std::endl;
+  std::cerr << "               the trace is output as it is computed (incompatible with -s)" << std::endl;
+  std::cerr << "   --walks M   batch of M randomized simulations of N steps (with -r N) on concrete clock valuations," << std::endl;
+  std::cerr << "               only outputs statistics of the labels hit by the walks (incompatible with -s and -t)" << std::endl;
+  std::cerr << "   --seed s    seed of concrete simulations, walk i uses seed s+i (default: 0)" << std::endl;
+  std::cerr << "   --jobs n    number of threads for the walks (default: number of cores)" << std::endl;
   std::cerr << "   -h          help" << std::endl;
   std::cerr << "reads from standard input if file is not provided" << std::endl;
 }
@@ -72,6 +87,12 @@ static std::size_t nsteps = 0;
 static std::string output_filename = "";
 static std::string starting_state_json = "";
 static bool output_trace = false;
+static bool output_stats = false;
+static enum tchecker::algorithms::stats_format_t stats_format = tchecker::algorithms::STATS_FORMAT_TEXT;
+static bool concrete = false;                                           /*!< Concrete randomized simulation */
+static std::size_t walks = 0;                                           /*!< Number of walks of batch simulation */
+static std::mt19937_64::result_type seed = 0;                           /*!< Seed of batch simulation */
+static std::size_t jobs = std::max(1u, std::thread::hardware_concurrency()); /*!< Threads of batch simulation */
 
 /*!
 \brief Parse command line arguments
@@ -128,11 +149,34 @@ int parse_command_line(int argc, char * argv[])
       }
     }
     else {
+      if (strcmp(long_options[long_option_index].name, "stats-format") == 0) {
+        output_stats = true;
+        if (strcmp(optarg, "text") == 0)
+          stats_format = tchecker::algorithms::STATS_FORMAT_TEXT;
+        else if (strcmp(optarg, "json") == 0)
+          stats_format = tchecker::algorithms::STATS_FORMAT_JSON;
+        else
+          throw std::invalid_argument("Unknown format of statistics: " + std::string{optarg});
+      }
+      else if (strcmp(long_options[long_option_index].name, "concrete") == 0)
+        concrete = true;
+      else if (strcmp(long_options[long_option_index].name, "walks") == 0) {
+        walks = std::strtoull(optarg, nullptr, 10);
+        if (walks == 0)
+          throw std::invalid_argument("Number of walks should be positive");
+      }
+      else if (strcmp(long_options[long_option_index].name, "seed") == 0)
+        seed = std::strtoull(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "jobs") == 0) {
+        jobs = std::strtoull(optarg, nullptr, 10);
+        if (jobs == 0)
+          throw std::invalid_argument("Number of jobs should be positive");
+      }
 #if USE_BOOST_JSON
-      if (strcmp(long_options[long_option_index].name, "json") == 0)
+      else if (strcmp(long_options[long_option_index].name, "json") == 0)
         display_type = tchecker::tck_simulate::JSON_DISPLAY;
-      else
 #endif
+      else
         throw std::runtime_error("This also should never be executed");
     }
   }
@@ -224,6 +268,21 @@ int main(int argc, char * argv[])
       return EXIT_FAILURE;
     }
 
+    if (concrete && (simulation_type != RANDOMIZED_SIMULATION || starting_state_json != "")) {
+      std::cerr << "Concrete simulation requires randomized simulation (-r), and is incompatible with -s" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if (walks != 0 && simulation_type != RANDOMIZED_SIMULATION) {
+      std::cerr << "Batch simulation requires randomized simulation (-r)" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if (walks != 0 && (output_trace || starting_state_json != "")) {
+      std::cerr << "Batch simulation is incompatible with -s and -t" << std::endl;
+      return EXIT_FAILURE;
+    }
+
     std::string input_file = (optindex == argc ? "" : argv[optindex]);
     if (input_file == "" || input_file == "-")
       std::cerr << "Reading model from standard input" << std::endl;
@@ -234,11 +293,38 @@ int main(int argc, char * argv[])
     if (output_filename != "")
       os = new std::ofstream(output_filename, std::ios::out);
 
+    if (walks != 0) {
+      tchecker::tck_simulate::batch_stats_t batch = tchecker::tck_simulate::batch_simulation(*sysdecl, nsteps, walks, jobs, seed);
+      std::map<std::string, std::string> m;
+      batch.attributes(m);
+      tchecker::algorithms::output_attributes(*os, m, stats_format);
+      if (os != &std::cout)
+        delete os;
+      return EXIT_SUCCESS;
+    }
+
     std::map<std::string, std::string> starting_state_attributes;
 #if USE_BOOST_JSON
     if (starting_state_json != "")
       starting_state_attributes = parse_state_json(starting_state_json);
 #endif
+    tchecker::algorithms::stats_t stats;
+    stats.set_start_time();
+
+    if (concrete && walks == 0) {
+      std::size_t const states = tchecker::tck_simulate::concrete_randomized_simulation(*sysdecl, nsteps, seed, *os);
+      stats.set_end_time();
+      if (output_stats) {
+        std::map<std::string, std::string> m;
+        stats.attributes(m);
+        m["SIMULATION_NODES"] = std::to_string(states);
+        tchecker::algorithms::output_attributes(std::cout, m, stats_format);
+      }
+      if (os != &std::cout)
+        delete os;
+      return EXIT_SUCCESS;
+    }
+
     std::shared_ptr<tchecker::tck_simulate::graph_t> g{nullptr};
     if (simulation_type == INTERACTIVE_SIMULATION)
       g = tchecker::tck_simulate::interactive_simulation(*sysdecl, display_type, starting_state_attributes);
@@ -249,9 +335,19 @@ int main(int argc, char * argv[])
     else
       throw std::runtime_error("Select one of interactive, one-step or randomized simulation");
 
+    stats.set_end_time();
+
     if (output_trace)
       tchecker::tck_simulate::dot_output(*os, *g, sysdecl->name());
 
+    if (output_stats) {
+      std::map<std::string, std::string> m;
+      stats.attributes(m);
+      if (g != nullptr)
+        m["SIMULATION_NODES"] = std::to_string(g->nodes_count());
+      tchecker::algorithms::output_attributes(std::cout, m, stats_format);
+    }
+
     if (os != &std::cout)
       delete os;
   }
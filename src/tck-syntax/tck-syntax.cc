@@ -2,15 +2,27 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <getopt.h>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <poll.h>
+#include <sstream>
 #include <string>
+#include <sys/wait.h>
+#include <thread>
 #include <tuple>
+#include <unistd.h>
 #include <unordered_set>
+#include <vector>
 
 #if BOOST_VERSION <= 106600
 #include <boost/functional/hash.hpp>
@@ -25,6 +37,7 @@
 #include "tchecker/system/system.hh"
 #include "tchecker/ta/system.hh"
 #include "tchecker/utils/log.hh"
+#include "tchecker/utils/string.hh"
 
 /*!
  \file tck-syntax.cc
@@ -40,6 +53,8 @@ static struct option long_options[] = {{"asynchronous-events", no_argument, 0, 0
                                        {"transform", no_argument, 0, 't'},
                                        {"json", no_argument, 0, 'j'},
                                        {"help", no_argument, 0, 'h'},
+                                       {"jobs", required_argument, 0, 0},
+                                       {"cache", required_argument, 0, 0},
                                        {0, 0, 0, 0}};
 
 static char * const options = (char *)"cd:hn:o:ptj";
@@ -47,6 +62,7 @@ static char * const options = (char *)"cd:hn:o:ptj";
 void usage(char * progname)
 {
   std::cerr << "Usage: " << progname << " [options] [file]" << std::endl;
+  std::cerr << "       " << progname << " -c [--jobs n] [--cache dir] file|directory..." << std::endl;
   std::cerr << "   --asynchronous-events  reports all asynchronous events in the model" << std::endl;
   std::cerr << "   -c                     syntax check (timed automaton)" << std::endl;
   std::cerr << "   -p                     synchronized product" << std::endl;
@@ -56,7 +72,11 @@ void usage(char * progname)
   std::cerr << "   -d delim               delimiter string (default: _)" << std::endl;
   std::cerr << "   -n name                name of synchronized process (default: P)" << std::endl;
   std::cerr << "   -h                     help" << std::endl;
+  std::cerr << "   --jobs n               number of files checked concurrently with -c (default: number of cores)" << std::endl;
+  std::cerr << "   --cache dir            with -c, results are stored in dir, and files which name and content have" << std::endl;
+  std::cerr << "                          not changed are not checked again" << std::endl;
   std::cerr << "reads from standard input if file is not provided" << std::endl;
+  std::cerr << "with -c, several files can be checked, and directories are searched for .tck and .json files" << std::endl;
 }
 
 static bool report_asynchronous_events = false;
@@ -68,6 +88,8 @@ static bool help = false;
 static std::string delimiter = "_";
 static std::string process_name = "P";
 static std::string output_file = "";
+static std::size_t jobs = std::max(1u, std::thread::hardware_concurrency());
+static std::string cache_dir = "";
 
 int parse_command_line(int argc, char * argv[])
 {
@@ -118,6 +140,16 @@ int parse_command_line(int argc, char * argv[])
     else {
       if (strcmp(long_options[long_option_index].name, "asynchronous-events") == 0)
         report_asynchronous_events = true;
+      else if (strcmp(long_options[long_option_index].name, "jobs") == 0) {
+        jobs = std::strtoull(optarg, nullptr, 10);
+        if (jobs == 0)
+          throw std::invalid_argument("Number of jobs should be positive");
+      }
+      else if (strcmp(long_options[long_option_index].name, "cache") == 0) {
+        if (strcmp(optarg, "") == 0)
+          throw std::invalid_argument("Invalid empty cache directory name");
+        cache_dir = optarg;
+      }
       else
         throw std::runtime_error("This also should never be executed");
     }
@@ -210,6 +242,220 @@ void do_syntax_check_ta(tchecker::parsing::system_declaration_t const & sysdecl)
     std::cout << "Syntax OK" << std::endl;
 }
 
+/*!
+ \brief Input files
+ \param argc : number of command line arguments
+ \param argv : array of command line arguments
+ \param optindex : index of the first input in argv
+ \return the files in argv from optindex, where directories have been replaced by the .tck and .json files that
+ they contain (recursively, in lexical order)
+ \throw std::runtime_error : if a directory cannot be read
+ */
+std::vector<std::string> input_files(int argc, char * argv[], int optindex)
+{
+  std::vector<std::string> files;
+  for (int i = optindex; i < argc; ++i) {
+    std::error_code ec;
+    if (!std::filesystem::is_directory(argv[i], ec)) {
+      files.push_back(argv[i]);
+      continue;
+    }
+    std::vector<std::string> contents;
+    try {
+      for (auto const & entry : std::filesystem::recursive_directory_iterator{argv[i]}) {
+        std::string const extension = entry.path().extension().string();
+        if (entry.is_regular_file() && (extension == ".tck" || extension == ".json"))
+          contents.push_back(entry.path().string());
+      }
+    }
+    catch (std::filesystem::filesystem_error const & e) {
+      throw std::runtime_error("cannot read directory " + std::string{argv[i]} + ": " + e.code().message());
+    }
+    std::sort(contents.begin(), contents.end());
+    files.insert(files.end(), contents.begin(), contents.end());
+  }
+  return files;
+}
+
+/*!
+ \brief Result of the syntax check of a file
+ */
+struct check_result_t {
+  bool ok;            /*!< Whether the file is syntactically correct */
+  std::string output; /*!< Messages */
+};
+
+/*!
+ \brief Key of a file in the cache of results
+ \param filename : file name
+ \param key : key
+ \return true if filename can be read, false otherwise
+ \post if true is returned, key is a hash of the name and the content of filename, as 16 hexadecimal digits
+ \note the hash is stable between runs (see tchecker::stable_hash) as keys are kept between runs. Names are hashed
+ since they appear in messages
+ */
+static bool cache_key(std::string const & filename, std::string & key)
+{
+  std::ifstream ifs{filename, std::ios::in | std::ios::binary};
+  if (!ifs)
+    return false;
+  std::string const content = filename + '\0' + std::string{std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+  key = tchecker::stable_hash(content);
+  return true;
+}
+
+/*!
+ \brief Check a file in a child process
+ \param filename : file name
+ \param fd : file descriptor
+ \return identifier of the child process, -1 if it could not be started
+ \post a child process checks the syntax of filename, outputs messages to fd and exits with status EXIT_SUCCESS
+ if filename is syntactically correct, EXIT_FAILURE otherwise
+ \note files are checked in distinct processes as the parsers and the counters of errors are global
+ */
+static pid_t fork_check(std::string const & filename, int & fd)
+{
+  int pipefd[2];
+  if (::pipe(pipefd) == -1)
+    return -1;
+  std::cout.flush();
+  std::cerr.flush();
+  pid_t const pid = ::fork();
+  if (pid == 0) {
+    ::close(pipefd[0]);
+    ::dup2(pipefd[1], STDOUT_FILENO);
+    ::dup2(pipefd[1], STDERR_FILENO);
+    ::close(pipefd[1]);
+    int status = EXIT_FAILURE;
+    try {
+      tchecker::log_reset_count();
+      std::shared_ptr<tchecker::parsing::system_declaration_t> sysdecl{load_system(filename)};
+      if (sysdecl != nullptr && tchecker::tck_syntax::syntax_check_ta(std::cerr, *sysdecl)) {
+        std::cout << "Syntax OK" << std::endl;
+        status = EXIT_SUCCESS;
+      }
+    }
+    catch (std::exception const & e) {
+      std::cerr << tchecker::log_error << e.what() << std::endl;
+    }
+    std::cout.flush();
+    std::cerr.flush();
+    ::_exit(status);
+  }
+  ::close(pipefd[1]);
+  if (pid == -1) {
+    ::close(pipefd[0]);
+    return -1;
+  }
+  fd = pipefd[0];
+  return pid;
+}
+
+/*!
+ \brief Check timed automaton syntax of several files
+ \param files : file names
+ \param jobs : maximal number of files checked concurrently
+ \param cache_dir : directory of cached results (none if empty)
+ \return true if all files are syntactically correct, false otherwise
+ \post the messages of each file have been output to std::cout, in the order of files. The results of files
+ that have not been found in cache_dir have been stored in cache_dir
+ */
+bool do_syntax_check_files(std::vector<std::string> const & files, std::size_t jobs, std::string const & cache_dir)
+{
+  std::vector<check_result_t> results(files.size());
+  std::vector<std::string> keys(files.size());
+  std::vector<bool> done(files.size(), false);
+
+  if (!cache_dir.empty()) {
+    std::error_code ec;
+    std::filesystem::create_directories(cache_dir, ec);
+    for (std::size_t i = 0; i < files.size(); ++i) {
+      if (!cache_key(files[i], keys[i]))
+        continue;
+      std::ifstream ifs{cache_dir + "/" + keys[i], std::ios::in | std::ios::binary};
+      std::string status;
+      if (!ifs || !std::getline(ifs, status) || (status != "OK" && status != "FAILED"))
+        continue;
+      results[i].ok = (status == "OK");
+      results[i].output.assign(std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{});
+      done[i] = true;
+    }
+  }
+
+  struct job_t {
+    std::size_t index; /*!< Index of the file */
+    pid_t pid;         /*!< Child process */
+    int fd;            /*!< Output of the child process */
+  };
+  std::vector<job_t> running;
+  std::size_t next = 0;
+  std::size_t printed = 0;
+
+  auto print_ready = [&]() {
+    for (; printed < files.size() && done[printed]; ++printed)
+      std::cout << files[printed] << ":" << std::endl << results[printed].output << std::flush;
+  };
+
+  while (true) {
+    while (next < files.size() && done[next])
+      ++next;
+    while (running.size() < jobs && next < files.size()) {
+      int fd = -1;
+      pid_t const pid = fork_check(files[next], fd);
+      if (pid == -1)
+        throw std::runtime_error("cannot check " + files[next] + ": " + std::strerror(errno));
+      running.push_back(job_t{next, pid, fd});
+      for (++next; next < files.size() && done[next]; ++next)
+        ;
+    }
+    print_ready();
+    if (running.empty())
+      break;
+
+    std::vector<struct pollfd> fds;
+    for (job_t const & job : running)
+      fds.push_back(pollfd{job.fd, POLLIN, 0});
+    if (::poll(fds.data(), fds.size(), -1) == -1) {
+      if (errno == EINTR)
+        continue;
+      throw std::runtime_error(std::string{"cannot wait for checks: "} + std::strerror(errno));
+    }
+
+    for (std::size_t k = fds.size(); k-- > 0;) {
+      if (fds[k].revents == 0)
+        continue;
+      job_t const job = running[k];
+      char buf[4096];
+      ssize_t const n = ::read(job.fd, buf, sizeof(buf));
+      if (n > 0) {
+        results[job.index].output.append(buf, static_cast<std::size_t>(n));
+        continue;
+      }
+      if (n == -1 && errno == EINTR)
+        continue;
+      ::close(job.fd);
+      int status = 0;
+      ::waitpid(job.pid, &status, 0);
+      results[job.index].ok = (WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS);
+      done[job.index] = true;
+      running.erase(running.begin() + k);
+
+      if (!cache_dir.empty() && !keys[job.index].empty()) {
+        std::string const path = cache_dir + "/" + keys[job.index];
+        std::string const tmp = path + "." + std::to_string(::getpid());
+        {
+          std::ofstream ofs{tmp, std::ios::out | std::ios::binary | std::ios::trunc};
+          ofs << (results[job.index].ok ? "OK" : "FAILED") << "\n" << results[job.index].output;
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmp, path, ec);
+      }
+    }
+  }
+
+  return std::all_of(results.begin(), results.end(), [](check_result_t const & r) { return r.ok; });
+}
+
 /*!
  \brief Flatten a system of processes into a single process
  \param sysdecl : system declaration
@@ -270,8 +516,12 @@ int main(int argc, char * argv[])
   try {
     int optindex = parse_command_line(argc, argv);
 
-    if (argc - optindex > 1) {
-      std::cerr << "Too many input files" << std::endl;
+    std::error_code ec;
+    bool const several_inputs = (argc - optindex > 1 ||
+                                 (argc - optindex == 1 && std::filesystem::is_directory(argv[optindex], ec)));
+    bool const check_only = check_syntax && !report_asynchronous_events && !synchronized_product && !transform && !json;
+    if (several_inputs && !check_only) {
+      std::cerr << "Several input files, or a directory, can only be checked with -c" << std::endl;
       usage(argv[0]);
       return EXIT_FAILURE;
     }
@@ -287,6 +537,9 @@ int main(int argc, char * argv[])
       return EXIT_SUCCESS;
     }
 
+    if (check_only && optindex < argc && (several_inputs || cache_dir != ""))
+      return (do_syntax_check_files(input_files(argc, argv, optindex), jobs, cache_dir) ? EXIT_SUCCESS : EXIT_FAILURE);
+
     std::string input_file = (optindex == argc ? "" : argv[optindex]);
 
     std::ostream * os = nullptr;
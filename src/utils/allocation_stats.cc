@@ -0,0 +1,150 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "tchecker/utils/allocation_stats.hh"
+
+#if defined(TCHECKER_ALLOCATION_STATS)
+
+static std::atomic<std::uint64_t> allocations{0};     /*!< Number of allocations */
+static std::atomic<std::uint64_t> deallocations{0};   /*!< Number of deallocations */
+static std::atomic<std::uint64_t> allocated_bytes{0}; /*!< Number of allocated bytes */
+
+/*!
+ \brief Counted allocation
+ \param size : size in bytes
+ \param alignment : alignment (0 for default alignment)
+ \return pointer to size bytes aligned on alignment, nullptr if allocation failed
+ */
+static void * counted_allocate(std::size_t size, std::size_t alignment = 0) noexcept
+{
+  if (size == 0)
+    size = 1;
+  void * p = nullptr;
+  if (alignment <= alignof(std::max_align_t))
+    p = std::malloc(size);
+  else
+    p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+  if (p != nullptr) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  }
+  return p;
+}
+
+/*!
+ \brief Counted deallocation
+ \param p : pointer returned by counted_allocate, or nullptr
+ \post p has been freed
+ */
+static void counted_free(void * p) noexcept
+{
+  if (p == nullptr)
+    return;
+  deallocations.fetch_add(1, std::memory_order_relaxed);
+  std::free(p);
+}
+
+/*!
+ \brief Throwing counted allocation
+ \param size : size in bytes
+ \param alignment : alignment (0 for default alignment)
+ \return pointer to size bytes aligned on alignment
+ \throw std::bad_alloc : if allocation failed and there is no new handler
+ */
+static void * counted_new(std::size_t size, std::size_t alignment = 0)
+{
+  for (;;) {
+    void * p = counted_allocate(size, alignment);
+    if (p != nullptr)
+      return p;
+    std::new_handler handler = std::get_new_handler();
+    if (handler == nullptr)
+      throw std::bad_alloc();
+    handler();
+  }
+}
+
+void * operator new(std::size_t size) { return counted_new(size); }
+
+void * operator new[](std::size_t size) { return counted_new(size); }
+
+void * operator new(std::size_t size, std::nothrow_t const &) noexcept { return counted_allocate(size); }
+
+void * operator new[](std::size_t size, std::nothrow_t const &) noexcept { return counted_allocate(size); }
+
+void * operator new(std::size_t size, std::align_val_t alignment)
+{
+  return counted_new(size, static_cast<std::size_t>(alignment));
+}
+
+void * operator new[](std::size_t size, std::align_val_t alignment)
+{
+  return counted_new(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void * p) noexcept { counted_free(p); }
+
+void operator delete[](void * p) noexcept { counted_free(p); }
+
+void operator delete(void * p, std::size_t) noexcept { counted_free(p); }
+
+void operator delete[](void * p, std::size_t) noexcept { counted_free(p); }
+
+void operator delete(void * p, std::nothrow_t const &) noexcept { counted_free(p); }
+
+void operator delete[](void * p, std::nothrow_t const &) noexcept { counted_free(p); }
+
+void operator delete(void * p, std::align_val_t) noexcept { counted_free(p); }
+
+void operator delete[](void * p, std::align_val_t) noexcept { counted_free(p); }
+
+void operator delete(void * p, std::size_t, std::align_val_t) noexcept { counted_free(p); }
+
+void operator delete[](void * p, std::size_t, std::align_val_t) noexcept { counted_free(p); }
+
+#endif // TCHECKER_ALLOCATION_STATS
+
+namespace tchecker {
+
+namespace allocation_stats {
+
+tchecker::allocation_stats::counters_t operator-(tchecker::allocation_stats::counters_t const & c1,
+                                                 tchecker::allocation_stats::counters_t const & c2)
+{
+  tchecker::allocation_stats::counters_t c;
+  c.allocations = c1.allocations - c2.allocations;
+  c.deallocations = c1.deallocations - c2.deallocations;
+  c.allocated_bytes = c1.allocated_bytes - c2.allocated_bytes;
+  return c;
+}
+
+#if defined(TCHECKER_ALLOCATION_STATS)
+
+bool enabled() { return true; }
+
+tchecker::allocation_stats::counters_t counters()
+{
+  tchecker::allocation_stats::counters_t c;
+  c.allocations = allocations.load(std::memory_order_relaxed);
+  c.deallocations = deallocations.load(std::memory_order_relaxed);
+  c.allocated_bytes = allocated_bytes.load(std::memory_order_relaxed);
+  return c;
+}
+
+#else
+
+bool enabled() { return false; }
+
+tchecker::allocation_stats::counters_t counters() { return tchecker::allocation_stats::counters_t{}; }
+
+#endif // TCHECKER_ALLOCATION_STATS
+
+} // end of namespace allocation_stats
+
+} // end of namespace tchecker
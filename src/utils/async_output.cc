@@ -0,0 +1,145 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "tchecker/utils/async_output.hh"
+
+namespace tchecker {
+
+/* async_streambuf_t */
+
+async_streambuf_t::async_streambuf_t(std::ostream & os, std::size_t chunk_size, std::size_t pending_chunks)
+    : _os(os), _chunk_size(chunk_size), _pending_chunks(pending_chunks), _closing(false), _closed(false), _failed(false)
+{
+  if (_chunk_size == 0)
+    throw std::invalid_argument("Chunks of asynchronous output should not be empty");
+  if (_pending_chunks == 0)
+    throw std::invalid_argument("Asynchronous output should queue at least one chunk");
+  _chunk.resize(_chunk_size);
+  setp(_chunk.data(), _chunk.data() + _chunk.size());
+  _writer = std::thread{&tchecker::async_streambuf_t::write_chunks, this};
+}
+
+async_streambuf_t::~async_streambuf_t()
+{
+  try {
+    close();
+  }
+  catch (...) {
+  }
+}
+
+void async_streambuf_t::close()
+{
+  if (_closed)
+    return;
+
+  hand_over();
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _closing = true;
+  }
+  _cv_not_empty.notify_one();
+  _writer.join();
+
+  _closed = true;
+  setp(nullptr, nullptr);
+
+  _os.flush();
+  if (_failed || !_os)
+    throw std::runtime_error("Asynchronous output: write error");
+}
+
+tchecker::async_streambuf_t::int_type async_streambuf_t::overflow(int_type c)
+{
+  if (_closed)
+    return traits_type::eof();
+  hand_over();
+  if (!traits_type::eq_int_type(c, traits_type::eof())) {
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+  return traits_type::not_eof(c);
+}
+
+std::streamsize async_streambuf_t::xsputn(char const * s, std::streamsize n)
+{
+  if (_closed)
+    return 0;
+  std::streamsize written = 0;
+  while (written < n) {
+    if (pptr() == epptr())
+      hand_over();
+    std::streamsize const size = std::min<std::streamsize>(n - written, epptr() - pptr());
+    std::memcpy(pptr(), s + written, static_cast<std::size_t>(size));
+    pbump(static_cast<int>(size));
+    written += size;
+  }
+  return written;
+}
+
+int async_streambuf_t::sync() { return 0; }
+
+void async_streambuf_t::hand_over()
+{
+  std::size_t const size = static_cast<std::size_t>(pptr() - pbase());
+  if (size != 0) {
+    _chunk.resize(size);
+    {
+      std::unique_lock<std::mutex> lock{_mutex};
+      _cv_not_full.wait(lock, [&]() { return _queue.size() < _pending_chunks || _failed; });
+      if (!_failed)
+        _queue.push_back(std::move(_chunk));
+    }
+    _cv_not_empty.notify_one();
+    _chunk = std::vector<char>(_chunk_size);
+  }
+  setp(_chunk.data(), _chunk.data() + _chunk.size());
+}
+
+void async_streambuf_t::write_chunks()
+{
+  while (true) {
+    std::vector<char> chunk;
+    {
+      std::unique_lock<std::mutex> lock{_mutex};
+      _cv_not_empty.wait(lock, [&]() { return !_queue.empty() || _closing; });
+      if (_queue.empty())
+        return;
+      chunk = std::move(_queue.front());
+      _queue.pop_front();
+    }
+    _cv_not_full.notify_one();
+
+    _os.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    if (!_os) {
+      {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _failed = true;
+        _queue.clear();
+      }
+      _cv_not_full.notify_all();
+      return;
+    }
+  }
+}
+
+/* async_ostream_t */
+
+async_ostream_t::async_ostream_t(std::ostream & os, std::size_t chunk_size, std::size_t pending_chunks)
+    : std::ostream(nullptr), _buf(os, chunk_size, pending_chunks)
+{
+  rdbuf(&_buf);
+}
+
+void async_ostream_t::close()
+{
+  flush();
+  _buf.close();
+}
+
+} // end of namespace tchecker
@@ -0,0 +1,77 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include "tchecker/utils/bitstate.hh"
+
+namespace tchecker {
+
+bitstate_table_t::bitstate_table_t(std::size_t size, unsigned int hashes) : _mask(0), _hashes(hashes), _set_bits(0)
+{
+  if (size == 0)
+    throw std::invalid_argument("bitstate table size should be positive");
+  if (hashes == 0)
+    throw std::invalid_argument("bitstate table should have at least one hash function");
+
+  std::size_t words = 1;
+  while (words <= size / (2 * sizeof(std::uint64_t)))
+    words <<= 1;
+  _table.assign(words, 0);
+  _mask = words * 64 - 1;
+}
+
+bool bitstate_table_t::insert(std::size_t h)
+{
+  std::uint64_t const h1 = mix(h);
+  std::uint64_t const h2 = mix(h1) | 1; // odd stride: the bits of h are distinct when _hashes <= bits()
+  bool is_new = false;
+  for (unsigned int i = 0; i < _hashes; ++i) {
+    std::size_t const b = (h1 + i * h2) & _mask;
+    std::uint64_t const m = std::uint64_t{1} << (b & 63);
+    std::uint64_t & word = _table[b >> 6];
+    if ((word & m) == 0) {
+      word |= m;
+      ++_set_bits;
+      is_new = true;
+    }
+  }
+  return is_new;
+}
+
+bool bitstate_table_t::contains(std::size_t h) const
+{
+  std::uint64_t const h1 = mix(h);
+  std::uint64_t const h2 = mix(h1) | 1;
+  for (unsigned int i = 0; i < _hashes; ++i) {
+    std::size_t const b = (h1 + i * h2) & _mask;
+    if ((_table[b >> 6] & (std::uint64_t{1} << (b & 63))) == 0)
+      return false;
+  }
+  return true;
+}
+
+void bitstate_table_t::clear()
+{
+  _table.assign(_table.size(), 0);
+  _set_bits = 0;
+}
+
+double bitstate_table_t::collision_probability() const
+{
+  return std::pow(static_cast<double>(_set_bits) / static_cast<double>(bits()), static_cast<double>(_hashes));
+}
+
+std::size_t bitstate_table_t::memsize() const { return sizeof(*this) + _table.size() * sizeof(std::uint64_t); }
+
+std::uint64_t bitstate_table_t::mix(std::uint64_t h)
+{
+  h += 0x9e3779b97f4a7c15ULL;
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+  return h ^ (h >> 31);
+}
+
+} // end of namespace tchecker
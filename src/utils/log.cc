@@ -2,6 +2,8 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <atomic>
+
 #include "tchecker/utils/log.hh"
 
 namespace tchecker {
@@ -13,13 +15,20 @@ struct log_warning_t const log_warning;
 
 /* Counters */
 
-static unsigned int _log_error_count;   /*!< Error counter */
-static unsigned int _log_warning_count; /*!< Warning counter */
+// Messages can be output by several threads (e.g. parallel compilation of a system)
+static std::atomic<unsigned int> _log_error_count{0};   /*!< Error counter */
+static std::atomic<unsigned int> _log_warning_count{0}; /*!< Warning counter */
 
 unsigned int log_error_count() { return tchecker::_log_error_count; }
 
 unsigned int log_warning_count() { return tchecker::_log_warning_count; }
 
+void log_reset_count()
+{
+  tchecker::_log_error_count = 0;
+  tchecker::_log_warning_count = 0;
+}
+
 /* Output operators */
 
 void log_output_count(std::ostream & os)
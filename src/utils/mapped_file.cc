@@ -0,0 +1,37 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tchecker/utils/mapped_file.hh"
+
+namespace tchecker {
+
+mapped_file_t::mapped_file_t(std::string const & filename) : _data(nullptr), _size(0)
+{
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd == -1)
+    throw std::runtime_error("cannot open " + filename + ": " + strerror(errno));
+  struct stat st;
+  if (::fstat(fd, &st) == -1 || st.st_size == 0) {
+    ::close(fd);
+    throw std::runtime_error("cannot map " + filename + " in memory");
+  }
+  _size = static_cast<std::size_t>(st.st_size);
+  void * data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED)
+    throw std::runtime_error("cannot map " + filename + " in memory: " + strerror(errno));
+  _data = static_cast<char const *>(data);
+}
+
+mapped_file_t::~mapped_file_t() { ::munmap(const_cast<char *>(_data), _size); }
+
+} // end of namespace tchecker
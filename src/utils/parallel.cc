@@ -0,0 +1,51 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <atomic>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "tchecker/utils/parallel.hh"
+
+namespace tchecker {
+
+static std::atomic<bool> thread_pinning_policy{false}; /*!< Pinning policy */
+
+void set_thread_pinning(bool pinning) { thread_pinning_policy.store(pinning, std::memory_order_relaxed); }
+
+bool thread_pinning() { return thread_pinning_policy.load(std::memory_order_relaxed); }
+
+#if defined(__linux__)
+
+bool pin_this_thread(std::size_t t)
+{
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+    return false;
+
+  std::vector<int> cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    if (CPU_ISSET(cpu, &allowed))
+      cpus.push_back(cpu);
+  if (cpus.empty())
+    return false;
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpus[t % cpus.size()], &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+#else
+
+bool pin_this_thread(std::size_t /*t*/) { return false; }
+
+#endif
+
+} // end of namespace tchecker
@@ -0,0 +1,15 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include "tchecker/utils/probes.hh"
+
+#if defined(TCHECKER_PROBES) && !defined(TCHECKER_PROBES_SDT)
+
+extern "C" __attribute__((noinline, used)) void tchecker_probe(char const * name, std::uintptr_t a1, std::uintptr_t a2)
+{
+  // keeps calls from being optimized away
+  asm volatile("" : : "r"(name), "r"(a1), "r"(a2) : "memory");
+}
+
+#endif
@@ -0,0 +1,17 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <atomic>
+
+#include "tchecker/utils/sizing.hh"
+
+namespace tchecker {
+
+static std::atomic<bool> adaptive_sizes_policy{false}; /*!< Sizing policy */
+
+void set_adaptive_sizes(bool adaptive) { adaptive_sizes_policy.store(adaptive, std::memory_order_relaxed); }
+
+bool adaptive_sizes() { return adaptive_sizes_policy.load(std::memory_order_relaxed); }
+
+} // end of namespace tchecker
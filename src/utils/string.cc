@@ -2,6 +2,9 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
 #include <sstream>
 
 #include "tchecker/utils/string.hh"
@@ -18,4 +21,44 @@ std::vector<std::string> split(std::string const & s, char d)
   return v;
 }
 
+void output_json_string(std::ostream & os, std::string const & s)
+{
+  static char const * const hex = "0123456789abcdef";
+  os << '"';
+  for (char c : s) {
+    switch (c) {
+    case '"':
+      os << "\\\"";
+      break;
+    case '\\':
+      os << "\\\\";
+      break;
+    case '\n':
+      os << "\\n";
+      break;
+    case '\t':
+      os << "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+        os << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+      else
+        os << c;
+    }
+  }
+  os << '"';
+}
+
+std::string stable_hash(std::string const & s)
+{
+  std::uint64_t h = 14695981039346656037ULL;
+  for (unsigned char c : s) {
+    h ^= c;
+    h *= 1099511628211ULL;
+  }
+  char buf[17];
+  std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(h));
+  return buf;
+}
+
 } // namespace tchecker
@@ -0,0 +1,178 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#if BOOST_VERSION <= 106600
+#include <boost/functional/hash.hpp>
+#else
+#include <boost/container_hash/hash.hpp>
+#endif
+
+#include "tchecker/variables/intval_mdd.hh"
+
+namespace tchecker {
+
+/* intval_mdd_t */
+
+intval_mdd_t::intval_mdd_t(tchecker::flat_integer_variables_t const & intvars)
+{
+  _ranges.reserve(intvars.size());
+  for (tchecker::intvar_id_t id = 0; id < intvars.size(); ++id) {
+    tchecker::intvar_info_t const & info = intvars.info(id);
+    _ranges.emplace_back(info.min(), info.max());
+  }
+  _nodes.push_back(node_t{size(), {}, 0}); // EMPTY
+  _nodes.push_back(node_t{size(), {}, 1}); // TERMINAL
+}
+
+tchecker::intval_mdd_t::node_id_t intval_mdd_t::insert(node_id_t root, tchecker::intval_t const & intval)
+{
+  for (tchecker::intvar_id_t id = 0; id < size(); ++id)
+    if (intval[id] < _ranges[id].first || intval[id] > _ranges[id].second)
+      throw std::out_of_range("Value out of the range of a bounded integer variable");
+  return insert(root, 0, intval);
+}
+
+bool intval_mdd_t::contains(node_id_t root, tchecker::intval_t const & intval) const
+{
+  node_id_t node = root;
+  for (tchecker::intvar_id_t level = 0; level < size() && node != EMPTY; ++level) {
+    std::vector<edge_t> const & edges = _nodes[node]._edges;
+    auto it = std::lower_bound(edges.begin(), edges.end(), edge_t{intval[level], EMPTY},
+                               [](edge_t const & e1, edge_t const & e2) { return e1.first < e2.first; });
+    node = ((it != edges.end() && it->first == intval[level]) ? it->second : EMPTY);
+  }
+  return node == TERMINAL;
+}
+
+std::uint64_t intval_mdd_t::count(node_id_t root) const
+{
+  // nodes are visited bottom-up from their levels, each one once
+  std::unordered_map<node_id_t, std::uint64_t> counts{{EMPTY, 0}, {TERMINAL, 1}};
+  std::vector<node_id_t> stack{root};
+  while (!stack.empty()) {
+    node_id_t const node = stack.back();
+    if (counts.find(node) != counts.end()) {
+      stack.pop_back();
+      continue;
+    }
+    bool ready = true;
+    for (edge_t const & e : _nodes[node]._edges)
+      if (counts.find(e.second) == counts.end()) {
+        stack.push_back(e.second);
+        ready = false;
+      }
+    if (!ready)
+      continue;
+    std::uint64_t c = 0;
+    for (edge_t const & e : _nodes[node]._edges)
+      c += counts[e.second];
+    counts[node] = c;
+    stack.pop_back();
+  }
+  return counts[root];
+}
+
+void intval_mdd_t::collect(std::vector<node_id_t> const & roots)
+{
+  std::vector<bool> marked(_nodes.size(), false);
+  marked[EMPTY] = marked[TERMINAL] = true;
+  std::vector<node_id_t> stack{roots};
+  while (!stack.empty()) {
+    node_id_t const node = stack.back();
+    stack.pop_back();
+    if (marked[node])
+      continue;
+    marked[node] = true;
+    for (edge_t const & e : _nodes[node]._edges)
+      stack.push_back(e.second);
+  }
+
+  std::vector<bool> free(_nodes.size(), false);
+  for (node_id_t node : _free)
+    free[node] = true;
+
+  for (node_id_t node = 0; node < _nodes.size(); ++node)
+    if (!marked[node] && !free[node]) {
+      auto && [begin, end] = _unique.equal_range(_nodes[node]._hash);
+      for (auto it = begin; it != end; ++it)
+        if (it->second == node) {
+          _unique.erase(it);
+          break;
+        }
+      _nodes[node]._edges.clear();
+      _nodes[node]._edges.shrink_to_fit();
+      _free.push_back(node);
+    }
+}
+
+std::size_t intval_mdd_t::memsize() const
+{
+  std::size_t size = _ranges.capacity() * sizeof(_ranges[0]) + _nodes.capacity() * sizeof(node_t) +
+                     _free.capacity() * sizeof(node_id_t) + _unique.size() * (sizeof(std::size_t) + sizeof(node_id_t)) +
+                     _unique.bucket_count() * sizeof(void *);
+  for (node_t const & n : _nodes)
+    size += n._edges.capacity() * sizeof(edge_t);
+  return size;
+}
+
+tchecker::intval_mdd_t::node_id_t intval_mdd_t::insert(node_id_t node, tchecker::intvar_id_t level,
+                                                       tchecker::intval_t const & intval)
+{
+  if (level == size())
+    return TERMINAL;
+
+  tchecker::integer_t const value = intval[level];
+  std::vector<edge_t> const & edges = _nodes[node]._edges;
+  auto it = std::lower_bound(edges.begin(), edges.end(), edge_t{value, EMPTY},
+                             [](edge_t const & e1, edge_t const & e2) { return e1.first < e2.first; });
+  bool const found = (it != edges.end() && it->first == value);
+  node_id_t const child = (found ? it->second : EMPTY);
+  std::size_t const position = static_cast<std::size_t>(it - edges.begin());
+
+  node_id_t const new_child = insert(child, level + 1, intval);
+  if (new_child == child)
+    return node;
+
+  // _nodes may have grown in the recursive call, hence edges are accessed again
+  std::vector<edge_t> new_edges{_nodes[node]._edges};
+  if (found)
+    new_edges[position].second = new_child;
+  else
+    new_edges.insert(new_edges.begin() + position, edge_t{value, new_child});
+  return make_node(level, std::move(new_edges));
+}
+
+tchecker::intval_mdd_t::node_id_t intval_mdd_t::make_node(tchecker::intvar_id_t level, std::vector<edge_t> && edges)
+{
+  std::size_t hash = level;
+  for (edge_t const & e : edges) {
+    boost::hash_combine(hash, e.first);
+    boost::hash_combine(hash, e.second);
+  }
+
+  auto && [begin, end] = _unique.equal_range(hash);
+  for (auto it = begin; it != end; ++it) {
+    node_t const & n = _nodes[it->second];
+    if (n._level == level && n._edges == edges)
+      return it->second;
+  }
+
+  node_id_t id;
+  if (_free.empty()) {
+    id = static_cast<node_id_t>(_nodes.size());
+    _nodes.push_back(node_t{level, std::move(edges), hash});
+  }
+  else {
+    id = _free.back();
+    _free.pop_back();
+    _nodes[id] = node_t{level, std::move(edges), hash};
+  }
+  _unique.emplace(hash, id);
+  return id;
+}
+
+} // end of namespace tchecker
@@ -136,11 +136,18 @@ void from_string(tchecker::intval_t & intval, tchecker::flat_integer_variables_t
     throw std::invalid_argument("some variables are not assigned in " + str);
 }
 
+std::size_t intval_t::compute_hash() const
+{
+  std::size_t h = static_cast<std::size_t>(size()) * 0x9e3779b97f4a7c15ULL;
+  for (tchecker::intval_base_t::capacity_t i = 0; i < size(); ++i)
+    h ^= variable_hash(i, (*this)[i]);
+  return h;
+}
+
 int lexical_cmp(tchecker::intval_t const & intval1, tchecker::intval_t const & intval2)
 {
-  return tchecker::lexical_cmp(
-      intval1.begin(), intval1.end(), intval2.begin(), intval2.end(),
-      [](tchecker::integer_t i1, tchecker::integer_t i2) -> int { return (i1 < i2 ? -1 : (i1 == i2 ? 0 : 1)); });
+  return tchecker::lexical_cmp(static_cast<tchecker::integer_array_t const &>(intval1),
+                               static_cast<tchecker::integer_array_t const &>(intval2));
 }
 
 } // end of namespace tchecker
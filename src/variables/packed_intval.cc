@@ -0,0 +1,133 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <stdexcept>
+
+#if BOOST_VERSION <= 106600
+#include <boost/functional/hash.hpp>
+#else
+#include <boost/container_hash/hash.hpp>
+#endif
+
+#include "tchecker/variables/packed_intval.hh"
+
+namespace tchecker {
+
+/* intval_packing_t */
+
+/*!
+ \brief Number of bits needed to store a range of values
+ \param range : max - min for some bounded integer variable
+ \return ceil(log2(range + 1))
+ */
+static unsigned char bit_width(std::uint64_t range)
+{
+  unsigned char width = 0;
+  while (range != 0) {
+    ++width;
+    range >>= 1;
+  }
+  return width;
+}
+
+intval_packing_t::intval_packing_t(tchecker::flat_integer_variables_t const & intvars) : _words(0)
+{
+  constexpr unsigned word_bits = 8 * sizeof(tchecker::packed_word_t);
+  unsigned free_bits = 0; // free bits in the current word
+
+  _fields.reserve(intvars.size());
+  for (tchecker::intvar_id_t id = 0; id < intvars.size(); ++id) {
+    tchecker::intvar_info_t const & info = intvars.info(id);
+    std::uint64_t const range = static_cast<std::uint64_t>(static_cast<std::int64_t>(info.max())) -
+                                static_cast<std::uint64_t>(static_cast<std::int64_t>(info.min()));
+    unsigned char const width = bit_width(range);
+
+    if (width > free_bits) {
+      ++_words;
+      free_bits = word_bits;
+    }
+    free_bits -= width;
+
+    field_t f;
+    f._min = info.min();
+    f._max = info.max();
+    f._mask = (width == word_bits ? ~tchecker::packed_word_t{0} : (tchecker::packed_word_t{1} << width) - 1);
+    f._word = (_words == 0 ? 0 : _words - 1);
+    f._shift = static_cast<unsigned char>(width == 0 ? 0 : free_bits);
+    f._width = width;
+    _fields.push_back(f);
+  }
+}
+
+void intval_packing_t::set(tchecker::packed_word_t * words, tchecker::intvar_id_t id, tchecker::integer_t value) const
+{
+  assert(id < size());
+  field_t const & f = _fields[id];
+  if ((value < f._min) || (value > f._max))
+    throw std::out_of_range("value out of range of variable");
+  if (f._width == 0)
+    return;
+  tchecker::packed_word_t const offset = static_cast<tchecker::packed_word_t>(static_cast<std::int64_t>(value)) -
+                                         static_cast<tchecker::packed_word_t>(static_cast<std::int64_t>(f._min));
+  words[f._word] = (words[f._word] & ~(f._mask << f._shift)) | (offset << f._shift);
+}
+
+void intval_packing_t::pack(tchecker::intval_t const & intval, tchecker::packed_word_t * words) const
+{
+  assert(intval.size() == size());
+  for (unsigned short w = 0; w < _words; ++w)
+    words[w] = 0;
+  for (tchecker::intvar_id_t id = 0; id < size(); ++id)
+    set(words, id, intval[id]);
+}
+
+void intval_packing_t::unpack(tchecker::packed_word_t const * words, tchecker::intval_t & intval) const
+{
+  assert(intval.size() == size());
+  for (tchecker::intvar_id_t id = 0; id < size(); ++id)
+    intval.assign(id, get(words, id));
+}
+
+/* packed_intval_t */
+
+tchecker::packed_intval_t * packed_intval_allocate_and_construct(unsigned short words)
+{
+  char * ptr = new char[tchecker::allocation_size_t<tchecker::packed_intval_t>::alloc_size(words)];
+  tchecker::packed_intval_t::construct(ptr, words);
+  return reinterpret_cast<tchecker::packed_intval_t *>(ptr);
+}
+
+void packed_intval_destruct_and_deallocate(tchecker::packed_intval_t * v)
+{
+  tchecker::packed_intval_t::destruct(v);
+  delete[] reinterpret_cast<char *>(v);
+}
+
+bool operator==(tchecker::packed_intval_t const & v1, tchecker::packed_intval_t const & v2)
+{
+  if (v1.words() != v2.words())
+    return false;
+  for (unsigned short w = 0; w < v1.words(); ++w)
+    if (v1[w] != v2[w])
+      return false;
+  return true;
+}
+
+std::size_t hash_value(tchecker::packed_intval_t const & v)
+{
+  std::size_t h = boost::hash_range(v.begin(), v.end());
+  boost::hash_combine(h, v.words());
+  return h;
+}
+
+int lexical_cmp(tchecker::packed_intval_t const & v1, tchecker::packed_intval_t const & v2)
+{
+  unsigned short const words = (v1.words() < v2.words() ? v1.words() : v2.words());
+  for (unsigned short w = 0; w < words; ++w)
+    if (v1[w] != v2[w])
+      return (v1[w] < v2[w] ? -1 : 1);
+  return (v1.words() < v2.words() ? -1 : (v1.words() == v2.words() ? 0 : 1));
+}
+
+} // end of namespace tchecker
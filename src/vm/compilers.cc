@@ -207,7 +207,9 @@ public:
   // Bytecode compilers
 
   /*
-   VM_PUSH ID(expr.name())
+   VM_VALUEAT_ID ID(expr.name())   for bounded integer variables
+
+   VM_PUSH ID(expr.name())         otherwise
    VM_VALUEAT
    */
   virtual void visit(tchecker::typed_var_expression_t const & expr)
@@ -217,6 +219,13 @@ public:
         (expr.type() != tchecker::EXPR_TYPE_INTARRAY) && (expr.type() != tchecker::EXPR_TYPE_LOCALINTARRAY))
       invalid_expression(expr, "a variable");
 
+    // Superinstruction for the most frequent variable read
+    if (expr.type() == tchecker::EXPR_TYPE_INTVAR) {
+      _bytecode_back_inserter = tchecker::VM_VALUEAT_ID;
+      _bytecode_back_inserter = expr.id();
+      return;
+    }
+
     // Write bytecode (similar to lvalue, except last instruction)
     tchecker::details::lvalue_expression_compiler_t<BYTECODE_BACK_INSERTER> lvalue_expression_compiler(_bytecode_back_inserter);
 
@@ -1042,4 +1051,35 @@ tchecker::bytecode_t * compile(tchecker::typed_statement_t const & stmt)
   }
 }
 
+bool intval_independent(tchecker::bytecode_t const * bytecode)
+{
+  while (true) {
+    switch (*bytecode) {
+    case tchecker::VM_RET:
+      return true;
+    case tchecker::VM_VALUEAT:
+    case tchecker::VM_VALUEAT_ID:
+    case tchecker::VM_ASSIGN:
+    case tchecker::VM_PUSH_FRAME:
+    case tchecker::VM_POP_FRAME:
+    case tchecker::VM_VALUEAT_FRAME:
+    case tchecker::VM_ASSIGN_FRAME:
+    case tchecker::VM_INIT_FRAME:
+      return false;
+    case tchecker::VM_FAILNOTIN:
+      bytecode += 3;
+      break;
+    case tchecker::VM_JMP:
+    case tchecker::VM_JMPZ:
+    case tchecker::VM_PUSH:
+    case tchecker::VM_CLKCONSTR:
+      bytecode += 2;
+      break;
+    default:
+      bytecode += 1;
+      break;
+    }
+  }
+}
+
 } // end of namespace tchecker
@@ -0,0 +1,448 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <algorithm>
+#include <mutex>
+
+#include "tchecker/vm/native.hh"
+
+namespace tchecker {
+
+namespace native {
+
+/* Registry */
+
+/*!
+ \brief Registry of natively compiled bytecode
+ \note function-local statics are initialized on first use, hence registration from a shared library loaded at
+ any time is safe
+ */
+class registry_t {
+public:
+  /*!
+   \brief Accessor
+   \return the registry
+   */
+  static registry_t & instance()
+  {
+    static registry_t registry;
+    return registry;
+  }
+
+  /*!
+   \brief Register a native function
+   \param bytecode : bytecode
+   \param function : native function equivalent to bytecode
+   \post function has been registered for bytecode (replacing any previous function)
+   */
+  void add(std::vector<tchecker::bytecode_t> && bytecode, tchecker::native_function_t function)
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _functions[std::move(bytecode)] = function;
+  }
+
+  /*!
+   \brief Lookup
+   \param bytecode : bytecode
+   \param size : size of bytecode
+   \return the native function registered for bytecode if any, nullptr otherwise
+   */
+  tchecker::native_function_t find(tchecker::bytecode_t const * bytecode, std::size_t size)
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto it = _functions.find(std::vector<tchecker::bytecode_t>(bytecode, bytecode + size));
+    return (it == _functions.end() ? nullptr : it->second);
+  }
+
+  /*!
+   \brief Accessor
+   \return true if no function has been registered, false otherwise
+   */
+  bool empty()
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _functions.empty();
+  }
+
+private:
+  std::mutex _mutex;                                                              /*!< Lock */
+  std::map<std::vector<tchecker::bytecode_t>, tchecker::native_function_t> _functions; /*!< Map bytecode -> function */
+};
+
+void register_function(tchecker::bytecode_t const * bytecode, std::size_t size, tchecker::native_function_t function)
+{
+  registry_t::instance().add(std::vector<tchecker::bytecode_t>(bytecode, bytecode + size), function);
+}
+
+tchecker::native_function_t find_function(tchecker::bytecode_t const * bytecode)
+{
+  registry_t & registry = registry_t::instance();
+  if (registry.empty())
+    return nullptr;
+  return registry.find(bytecode, tchecker::native::bytecode_size(bytecode));
+}
+
+/* Control-flow and stack analysis */
+
+/*!
+ \brief Number of parameters of an instruction
+ \param instruction : an instruction
+ \return number of parameters of instruction
+ \throw std::invalid_argument : if instruction is unknown
+ */
+static std::size_t parameters(tchecker::bytecode_t instruction)
+{
+  switch (instruction) {
+  case tchecker::VM_FAILNOTIN:
+    return 2;
+  case tchecker::VM_JMP:
+  case tchecker::VM_JMPZ:
+  case tchecker::VM_PUSH:
+  case tchecker::VM_VALUEAT_ID:
+  case tchecker::VM_CLKCONSTR:
+    return 1;
+  default:
+    if ((instruction < 0) || (instruction > tchecker::VM_NOP))
+      throw std::invalid_argument("unknown bytecode instruction");
+    return 0;
+  }
+}
+
+/*!
+ \brief Stack effect of an instruction
+ \param instruction : an instruction
+ \return pair (number of popped values, number of pushed values) of instruction
+ */
+static std::pair<std::size_t, std::size_t> stack_effect(tchecker::bytecode_t instruction)
+{
+  switch (instruction) {
+  case tchecker::VM_RET:
+  case tchecker::VM_JMPZ:
+    return {1, 0};
+  case tchecker::VM_RETZ:
+  case tchecker::VM_FAILNOTIN:
+  case tchecker::VM_VALUEAT:
+  case tchecker::VM_NEG:
+  case tchecker::VM_LNOT:
+  case tchecker::VM_VALUEAT_FRAME:
+    return {1, 1};
+  case tchecker::VM_PUSH:
+  case tchecker::VM_VALUEAT_ID:
+    return {0, 1};
+  case tchecker::VM_ASSIGN:
+  case tchecker::VM_ASSIGN_FRAME:
+  case tchecker::VM_INIT_FRAME:
+    return {2, 0};
+  case tchecker::VM_LAND:
+  case tchecker::VM_MINUS:
+  case tchecker::VM_DIV:
+  case tchecker::VM_EQ:
+  case tchecker::VM_GE:
+  case tchecker::VM_GT:
+  case tchecker::VM_LT:
+  case tchecker::VM_LE:
+  case tchecker::VM_MUL:
+  case tchecker::VM_MOD:
+  case tchecker::VM_NE:
+  case tchecker::VM_SUM:
+    return {2, 1};
+  case tchecker::VM_CLKCONSTR:
+  case tchecker::VM_CLKRESET:
+    return {3, 0};
+  default: // VM_JMP, VM_PUSH_FRAME, VM_POP_FRAME, VM_NOP
+    return {0, 0};
+  }
+}
+
+/*!
+ \brief Result of the analysis of a bytecode
+ */
+struct analysis_t {
+  std::vector<long> depth;     /*!< Map : position -> stack depth before instruction (-1 if unreachable) */
+  std::vector<bool> target;    /*!< Map : position -> jump target */
+  std::size_t size = 0;        /*!< Size of reachable bytecode */
+  std::size_t max_depth = 0;   /*!< Maximal stack depth */
+  bool frames = false;         /*!< Uses frames of local variables */
+};
+
+/*!
+ \brief Analysis of a bytecode
+ \param bytecode : bytecode
+ \return the stack depth before each reachable instruction, the jump targets, the size of the reachable part of
+ bytecode and its maximal stack depth
+ \throw std::invalid_argument : if bytecode contains an unknown instruction, jumps before its first instruction, pops
+ from an empty stack, or if the stack depth at some instruction depends on the path to the instruction
+ */
+static analysis_t analyse(tchecker::bytecode_t const * bytecode)
+{
+  analysis_t a;
+  std::vector<std::size_t> todo{0};
+
+  auto reach = [&](std::size_t pos, long depth) {
+    if (pos >= a.depth.size()) {
+      a.depth.resize(pos + 1, -1);
+      a.target.resize(pos + 1, false);
+    }
+    if (a.depth[pos] == -1) {
+      a.depth[pos] = depth;
+      todo.push_back(pos);
+    }
+    else if (a.depth[pos] != depth)
+      throw std::invalid_argument("bytecode with inconsistent stack depth");
+  };
+
+  a.depth.push_back(0);
+  a.target.push_back(false);
+  while (!todo.empty()) {
+    std::size_t const pos = todo.back();
+    todo.pop_back();
+
+    tchecker::bytecode_t const instruction = bytecode[pos];
+    std::size_t const next = pos + 1 + parameters(instruction);
+    auto const [popped, pushed] = stack_effect(instruction);
+    if (a.depth[pos] < static_cast<long>(popped))
+      throw std::invalid_argument("bytecode pops from an empty stack");
+    long const depth = a.depth[pos] - static_cast<long>(popped) + static_cast<long>(pushed);
+    a.max_depth = std::max(a.max_depth, static_cast<std::size_t>(std::max(depth, a.depth[pos])));
+    a.size = std::max(a.size, next);
+
+    switch (instruction) {
+    case tchecker::VM_RET:
+      break;
+    case tchecker::VM_JMP:
+    case tchecker::VM_JMPZ: {
+      long const target = static_cast<long>(next) + static_cast<long>(bytecode[pos + 1]);
+      if (target < 0)
+        throw std::invalid_argument("bytecode jumps before its first instruction");
+      reach(static_cast<std::size_t>(target), depth);
+      a.target[static_cast<std::size_t>(target)] = true;
+      if (instruction == tchecker::VM_JMPZ)
+        reach(next, depth);
+      break;
+    }
+    case tchecker::VM_PUSH_FRAME:
+    case tchecker::VM_POP_FRAME:
+    case tchecker::VM_VALUEAT_FRAME:
+    case tchecker::VM_ASSIGN_FRAME:
+    case tchecker::VM_INIT_FRAME:
+      a.frames = true;
+      reach(next, depth);
+      break;
+    default:
+      reach(next, depth);
+      break;
+    }
+  }
+  return a;
+}
+
+std::size_t bytecode_size(tchecker::bytecode_t const * bytecode) { return tchecker::native::analyse(bytecode).size; }
+
+/* Code generation */
+
+/*!
+ \brief Output a bytecode value as a C++ literal
+ \param os : output stream
+ \param v : value
+ \post v has been output to os as a C++ expression of type tchecker::bytecode_t
+ */
+static void output_literal(std::ostream & os, tchecker::bytecode_t v)
+{
+  if (v == std::numeric_limits<tchecker::bytecode_t>::min())
+    os << "std::numeric_limits<tchecker::bytecode_t>::min()";
+  else
+    os << "static_cast<tchecker::bytecode_t>(" << v << "LL)";
+}
+
+/*!
+ \brief C++ operator of a binary instruction
+ \param instruction : an instruction
+ \return the C++ operator corresponding to instruction, nullptr if instruction is not a binary operator
+ */
+static char const * binary_operator(tchecker::bytecode_t instruction)
+{
+  switch (instruction) {
+  case tchecker::VM_LAND:
+    return "&&";
+  case tchecker::VM_MINUS:
+    return "-";
+  case tchecker::VM_DIV:
+    return "/";
+  case tchecker::VM_EQ:
+    return "==";
+  case tchecker::VM_GE:
+    return ">=";
+  case tchecker::VM_GT:
+    return ">";
+  case tchecker::VM_LT:
+    return "<";
+  case tchecker::VM_LE:
+    return "<=";
+  case tchecker::VM_MUL:
+    return "*";
+  case tchecker::VM_MOD:
+    return "%";
+  case tchecker::VM_NE:
+    return "!=";
+  case tchecker::VM_SUM:
+    return "+";
+  default:
+    return nullptr;
+  }
+}
+
+/*!
+ \brief Output the C++ function of a bytecode
+ \param os : output stream
+ \param bytecode : bytecode
+ \param a : analysis of bytecode
+ \param name : function name
+ \post a static C++ function called name, and equivalent to bytecode, has been output to os
+ */
+static void emit_function(std::ostream & os, tchecker::bytecode_t const * bytecode, analysis_t const & a,
+                          std::string const & name)
+{
+  auto s = [](long i) { return "s" + std::to_string(i); };
+  std::string const integer = "tchecker::native::value<tchecker::integer_t>";
+
+  os << "static tchecker::integer_t " << name << "(tchecker::intval_t & intval, "
+     << "tchecker::clock_constraint_container_t & clkconstr, tchecker::clock_reset_container_t & clkreset)" << std::endl;
+  os << "{" << std::endl;
+  os << "  (void)intval;" << std::endl << "  (void)clkconstr;" << std::endl << "  (void)clkreset;" << std::endl;
+  for (std::size_t i = 0; i < a.max_depth; ++i)
+    os << "  tchecker::bytecode_t " << s(i) << " = 0;" << std::endl << "  (void)" << s(i) << ";" << std::endl;
+  if (a.frames)
+    os << "  tchecker::native::frames_t frames;" << std::endl;
+
+  for (std::size_t pos = 0; pos < a.size; ++pos) {
+    if (pos >= a.depth.size() || a.depth[pos] == -1)
+      continue;
+    long const d = a.depth[pos];
+    tchecker::bytecode_t const instruction = bytecode[pos];
+    std::size_t const next = pos + 1 + tchecker::native::parameters(instruction);
+
+    if (a.target[pos])
+      os << "L" << pos << ":;" << std::endl;
+    os << "  ";
+
+    char const * op = tchecker::native::binary_operator(instruction);
+    if (op != nullptr) {
+      os << s(d - 2) << " = static_cast<tchecker::integer_t>(" << integer << "(" << s(d - 2) << ") " << op << " " << integer
+         << "(" << s(d - 1) << "));" << std::endl;
+      continue;
+    }
+
+    switch (instruction) {
+    case tchecker::VM_RET:
+      os << "return " << integer << "(" << s(d - 1) << ");";
+      break;
+    case tchecker::VM_RETZ:
+      os << "if (" << integer << "(" << s(d - 1) << ") == 0) return 0;";
+      break;
+    case tchecker::VM_FAILNOTIN:
+      os << "tchecker::native::fail_not_in(" << s(d - 1) << ", ";
+      output_literal(os, bytecode[pos + 1]);
+      os << ", ";
+      output_literal(os, bytecode[pos + 2]);
+      os << ");";
+      break;
+    case tchecker::VM_JMP:
+      os << "goto L" << next + bytecode[pos + 1] << ";";
+      break;
+    case tchecker::VM_JMPZ:
+      os << "if (" << integer << "(" << s(d - 1) << ") == 0) goto L" << next + bytecode[pos + 1] << ";";
+      break;
+    case tchecker::VM_PUSH:
+      os << s(d) << " = ";
+      output_literal(os, bytecode[pos + 1]);
+      os << ";";
+      break;
+    case tchecker::VM_VALUEAT:
+      os << s(d - 1) << " = std::as_const(intval)[tchecker::native::value<tchecker::intval_base_t::capacity_t>(" << s(d - 1)
+         << ")];";
+      break;
+    case tchecker::VM_VALUEAT_ID:
+      os << s(d) << " = std::as_const(intval)[" << bytecode[pos + 1] << "];";
+      break;
+    case tchecker::VM_ASSIGN:
+      os << "intval.assign(tchecker::native::value<tchecker::intval_base_t::capacity_t>(" << s(d - 2) << "), " << integer
+         << "(" << s(d - 1) << "));";
+      break;
+    case tchecker::VM_NEG:
+      os << s(d - 1) << " = static_cast<tchecker::integer_t>(-" << integer << "(" << s(d - 1) << "));";
+      break;
+    case tchecker::VM_LNOT:
+      os << s(d - 1) << " = static_cast<tchecker::integer_t>(!" << integer << "(" << s(d - 1) << "));";
+      break;
+    case tchecker::VM_CLKCONSTR:
+      os << "clkconstr.emplace_back(tchecker::native::value<tchecker::clock_id_t>(" << s(d - 3)
+         << "), tchecker::native::value<tchecker::clock_id_t>(" << s(d - 2) << "), "
+         << (bytecode[pos + 1] == 0 ? "tchecker::LT" : "tchecker::LE") << ", " << integer << "(" << s(d - 1) << "));";
+      break;
+    case tchecker::VM_CLKRESET:
+      os << "clkreset.emplace_back(tchecker::native::value<tchecker::clock_id_t>(" << s(d - 3)
+         << "), tchecker::native::value<tchecker::clock_id_t>(" << s(d - 2) << "), " << integer << "(" << s(d - 1)
+         << "));";
+      break;
+    case tchecker::VM_PUSH_FRAME:
+      os << "frames.emplace_back();";
+      break;
+    case tchecker::VM_POP_FRAME:
+      os << "frames.pop_back();";
+      break;
+    case tchecker::VM_VALUEAT_FRAME:
+      os << s(d - 1) << " = tchecker::native::slot_of(frames, " << s(d - 1) << ");";
+      break;
+    case tchecker::VM_ASSIGN_FRAME:
+      os << "tchecker::native::slot_of(frames, tchecker::native::value<tchecker::intvar_id_t>(" << s(d - 2) << ")) = " << integer
+         << "(" << s(d - 1) << ");";
+      break;
+    case tchecker::VM_INIT_FRAME:
+      os << "frames.back()[tchecker::native::value<tchecker::intval_base_t::capacity_t>(" << s(d - 2)
+         << ")] = static_cast<tchecker::integer_t>(tchecker::native::value<tchecker::intvar_id_t>(" << s(d - 1) << "));";
+      break;
+    default: // VM_NOP
+      os << ";";
+      break;
+    }
+    os << std::endl;
+  }
+  os << "}" << std::endl << std::endl;
+}
+
+void emit_cpp(std::ostream & os, std::vector<tchecker::bytecode_t const *> const & bytecodes, std::string const & name)
+{
+  std::vector<analysis_t> analyses;
+  analyses.reserve(bytecodes.size());
+  for (tchecker::bytecode_t const * bytecode : bytecodes)
+    analyses.push_back(tchecker::native::analyse(bytecode));
+
+  os << "// Native code for model " << name << ", generated by tck-reach --emit-cpp" << std::endl;
+  os << "// Build as a shared library, and load it with tck-reach --native" << std::endl << std::endl;
+  os << "#include <limits>" << std::endl << "#include <utility>" << std::endl << std::endl;
+  os << "#include \"tchecker/vm/native.hh\"" << std::endl << std::endl;
+  os << "namespace {" << std::endl << std::endl;
+
+  for (std::size_t i = 0; i < bytecodes.size(); ++i) {
+    os << "static tchecker::bytecode_t const bytecode_" << i << "[] = {";
+    for (std::size_t pos = 0; pos < analyses[i].size; ++pos) {
+      os << (pos == 0 ? "" : ", ");
+      output_literal(os, bytecodes[i][pos]);
+    }
+    os << "};" << std::endl;
+    tchecker::native::emit_function(os, bytecodes[i], analyses[i], "function_" + std::to_string(i));
+  }
+
+  os << "struct registration_t {" << std::endl << "  registration_t()" << std::endl << "  {" << std::endl;
+  for (std::size_t i = 0; i < bytecodes.size(); ++i)
+    os << "    tchecker::native::register_function(bytecode_" << i << ", " << analyses[i].size << ", function_" << i << ");"
+       << std::endl;
+  os << "  }" << std::endl << "};" << std::endl << std::endl;
+  os << "static registration_t const registration;" << std::endl << std::endl;
+  os << "} // end of anonymous namespace" << std::endl;
+}
+
+} // end of namespace native
+
+} // end of namespace tchecker
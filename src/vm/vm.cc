@@ -58,6 +58,11 @@ size_t output_instruction(std::ostream & os, tchecker::bytecode_t const * byteco
     os << "VALUEAT";
     break;
 
+  case VM_VALUEAT_ID:
+    os << "VALUEAT_ID " << bytecode[1];
+    res++;
+    break;
+
   case VM_ASSIGN:
     os << "ASSIGN";
     break;
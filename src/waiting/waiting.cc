@@ -12,6 +12,14 @@ namespace waiting {
 
 element_t::element_t() : _status(tchecker::waiting::NOT_WAITING) {}
 
+element_t::element_t(tchecker::waiting::element_t const & e) : _status(e._status.load()) {}
+
+tchecker::waiting::element_t & element_t::operator=(tchecker::waiting::element_t const & e)
+{
+  _status = e._status.load();
+  return *this;
+}
+
 } // end of namespace waiting
 
 } // end of namespace tchecker
\ No newline at end of file
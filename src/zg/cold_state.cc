@@ -0,0 +1,144 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <stdexcept>
+
+#if BOOST_VERSION <= 106600
+#include <boost/functional/hash.hpp>
+#else
+#include <boost/container_hash/hash.hpp>
+#endif
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/zg/cold_state.hh"
+
+namespace tchecker {
+
+namespace zg {
+
+/*!
+ \brief Encode an unsigned integer
+ \param bytes : a byte buffer
+ \param u : an unsigned integer
+ \post u has been appended to bytes as a variable-length integer (7 bits per byte, least significant first, the high
+ bit of a byte is set when more bytes follow)
+ */
+static void put_unsigned(std::vector<std::uint8_t> & bytes, std::uint64_t u)
+{
+  while (u >= 0x80) {
+    bytes.push_back(static_cast<std::uint8_t>(u | 0x80));
+    u >>= 7;
+  }
+  bytes.push_back(static_cast<std::uint8_t>(u));
+}
+
+/*!
+ \brief Encode a signed integer
+ \param bytes : a byte buffer
+ \param i : an integer
+ \post i has been appended to bytes as the variable-length integer of its zig-zag encoding (small absolute values
+ have small encodings)
+ */
+static void put_signed(std::vector<std::uint8_t> & bytes, std::int64_t i)
+{
+  put_unsigned(bytes, (static_cast<std::uint64_t>(i) << 1) ^ static_cast<std::uint64_t>(i >> 63));
+}
+
+/*!
+ \brief Decode an unsigned integer
+ \param p : pointer to a byte buffer
+ \return the variable-length integer at p
+ \post p points past the decoded integer
+ */
+static std::uint64_t get_unsigned(std::uint8_t const *& p)
+{
+  std::uint64_t u = 0;
+  for (unsigned shift = 0;; shift += 7) {
+    std::uint8_t const byte = *p++;
+    u |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+      return u;
+  }
+}
+
+/*!
+ \brief Decode a signed integer
+ \param p : pointer to a byte buffer
+ \return the zig-zag encoded variable-length integer at p
+ \post p points past the decoded integer
+ */
+static std::int64_t get_signed(std::uint8_t const *& p)
+{
+  std::uint64_t const u = get_unsigned(p);
+  return static_cast<std::int64_t>(u >> 1) ^ -static_cast<std::int64_t>(u & 1);
+}
+
+cold_state_t::cold_state_t(tchecker::zg::zone_t const & zone, tchecker::intval_t const & intval)
+    : _dim(static_cast<tchecker::clock_id_t>(zone.dim())), _intvars(intval.size()), _intval_offset(0)
+{
+  // the bounds of a minimal constraint set are finite
+  std::vector<tchecker::dbm::reduced_bound_t> bounds;
+  tchecker::dbm::reduce(zone.dbm(), _dim, bounds);
+  put_unsigned(_bytes, bounds.size());
+  for (tchecker::dbm::reduced_bound_t const & b : bounds) {
+    put_unsigned(_bytes, static_cast<std::uint64_t>(b.i) * _dim + b.j);
+    put_signed(_bytes, 2 * static_cast<std::int64_t>(tchecker::dbm::value(b.db)) + tchecker::dbm::comparator(b.db));
+  }
+
+  _intval_offset = static_cast<std::uint32_t>(_bytes.size());
+  for (tchecker::intvar_id_t id = 0; id < _intvars; ++id)
+    put_signed(_bytes, intval[id]);
+
+  _bytes.shrink_to_fit();
+}
+
+void cold_state_t::to_zone(tchecker::zg::zone_t & zone) const
+{
+  if (zone.dim() != _dim)
+    throw std::invalid_argument("Zone dimension mismatch");
+
+  std::uint8_t const * p = _bytes.data();
+  std::size_t const size = get_unsigned(p);
+  std::vector<tchecker::dbm::reduced_bound_t> bounds(size);
+  for (tchecker::dbm::reduced_bound_t & b : bounds) {
+    std::uint64_t const index = get_unsigned(p);
+    std::int64_t const encoded = get_signed(p);
+    b.i = static_cast<tchecker::clock_id_t>(index / _dim);
+    b.j = static_cast<tchecker::clock_id_t>(index % _dim);
+    b.db = tchecker::dbm::db(((encoded & 1) ? tchecker::LE : tchecker::LT),
+                             static_cast<tchecker::integer_t>((encoded - (encoded & 1)) / 2));
+  }
+  tchecker::dbm::expand(zone.dbm(), _dim, bounds.data(), bounds.size());
+}
+
+void cold_state_t::to_intval(tchecker::intval_t & intval) const
+{
+  if (intval.size() != _intvars)
+    throw std::invalid_argument("Valuation size mismatch");
+
+  std::uint8_t const * p = _bytes.data() + _intval_offset;
+  for (tchecker::intvar_id_t id = 0; id < _intvars; ++id)
+    intval[id] = static_cast<tchecker::integer_t>(get_signed(p));
+}
+
+std::size_t cold_state_t::memory_footprint() const { return sizeof(*this) + _bytes.capacity(); }
+
+bool cold_state_t::operator==(tchecker::zg::cold_state_t const & s) const
+{
+  return (_dim == s._dim) && (_intvars == s._intvars) && (_bytes == s._bytes);
+}
+
+bool cold_state_t::operator!=(tchecker::zg::cold_state_t const & s) const { return !(*this == s); }
+
+std::size_t cold_state_t::hash() const
+{
+  std::size_t seed = _dim;
+  boost::hash_combine(seed, _intvars);
+  boost::hash_range(seed, _bytes.begin(), _bytes.end());
+  return seed;
+}
+
+} // end of namespace zg
+
+} // end of namespace tchecker
@@ -0,0 +1,79 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <stdexcept>
+
+#if BOOST_VERSION <= 106600
+#include <boost/functional/hash.hpp>
+#else
+#include <boost/container_hash/hash.hpp>
+#endif
+
+#include "tchecker/zg/compact_zone.hh"
+
+namespace tchecker {
+
+namespace zg {
+
+compact_zone_t::compact_zone_t(tchecker::zg::zone_t const & zone, std::vector<tchecker::clock_id_t> const & clocks)
+    : _dim(static_cast<tchecker::clock_id_t>(zone.dim())), _clocks(1, 0)
+{
+  _clocks.reserve(clocks.size() + 1);
+  for (tchecker::clock_id_t x : clocks)
+    _clocks.push_back(x + 1); // translation of clock id from system to dbm
+  tchecker::clock_id_t const cdim = static_cast<tchecker::clock_id_t>(_clocks.size());
+  _dbm.resize(static_cast<std::size_t>(cdim) * cdim);
+  tchecker::dbm::compact(_dbm.data(), zone.dbm(), _dim, _clocks.data(), cdim);
+}
+
+void compact_zone_t::to_zone(tchecker::zg::zone_t & zone) const
+{
+  if (zone.dim() != _dim)
+    throw std::invalid_argument("Zone dimension mismatch");
+  tchecker::dbm::uncompact(zone.dbm(), _dim, _dbm.data(), _clocks.data(),
+                           static_cast<tchecker::clock_id_t>(_clocks.size()));
+}
+
+std::size_t compact_zone_t::memory_footprint() const
+{
+  return sizeof(*this) + _clocks.capacity() * sizeof(tchecker::clock_id_t) + _dbm.capacity() * sizeof(tchecker::dbm::db_t);
+}
+
+bool compact_zone_t::operator==(tchecker::zg::compact_zone_t const & zone) const
+{
+  return (_dim == zone._dim) && (_clocks == zone._clocks) && (_dbm == zone._dbm);
+}
+
+bool compact_zone_t::operator!=(tchecker::zg::compact_zone_t const & zone) const { return !(*this == zone); }
+
+std::size_t compact_zone_t::hash() const
+{
+  std::size_t seed = _dim;
+  for (tchecker::clock_id_t x : _clocks)
+    boost::hash_combine(seed, x);
+  boost::hash_combine(seed, tchecker::dbm::hash(_dbm.data(), static_cast<tchecker::clock_id_t>(_clocks.size())));
+  return seed;
+}
+
+/* compact_zone_storage_t */
+
+compact_zone_storage_t::compact_zone_storage_t(
+    std::shared_ptr<tchecker::clockbounds::active_clocks_t const> const & active)
+    : _active(active)
+{
+  if (_active.get() == nullptr)
+    throw std::invalid_argument("Compact zones need the active clocks of the system");
+}
+
+tchecker::zg::compact_zone_t compact_zone_storage_t::store(tchecker::ta::state_t const & s,
+                                                           tchecker::zg::zone_sptr_t const & zone)
+{
+  _clocks.clear();
+  _active->active_clocks(s.vloc(), _clocks);
+  return tchecker::zg::compact_zone_t{*zone, _clocks};
+}
+
+} // end of namespace zg
+
+} // end of namespace tchecker
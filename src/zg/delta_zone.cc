@@ -0,0 +1,163 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+#if BOOST_VERSION <= 106600
+#include <boost/functional/hash.hpp>
+#else
+#include <boost/container_hash/hash.hpp>
+#endif
+
+#include "tchecker/zg/delta_zone.hh"
+
+namespace tchecker {
+
+namespace zg {
+
+delta_zone_t::delta_zone_t(tchecker::zg::zone_t const & zone, tchecker::zg::zone_sptr_t const & reference)
+    : _dim(static_cast<tchecker::clock_id_t>(zone.dim())), _reference(reference)
+{
+  assert(_reference.ptr() != nullptr);
+  if (_reference->dim() != _dim)
+    throw std::invalid_argument("Zone dimension mismatch");
+
+  tchecker::dbm::db_t const * dbm = zone.dbm();
+  tchecker::dbm::db_t const * ref = _reference->dbm();
+  std::uint32_t const size = static_cast<std::uint32_t>(_dim) * _dim;
+  for (std::uint32_t k = 0; k < size; ++k)
+    if (dbm[k] != ref[k]) {
+      _indices.push_back(k);
+      _bounds.push_back(dbm[k]);
+    }
+  _indices.shrink_to_fit();
+  _bounds.shrink_to_fit();
+}
+
+void delta_zone_t::to_zone(tchecker::zg::zone_t & zone) const
+{
+  if (zone.dim() != _dim)
+    throw std::invalid_argument("Zone dimension mismatch");
+  tchecker::dbm::db_t * dbm = zone.dbm();
+  std::memcpy(dbm, _reference->dbm(), static_cast<std::size_t>(_dim) * _dim * sizeof(tchecker::dbm::db_t));
+  for (std::size_t k = 0; k < _indices.size(); ++k)
+    dbm[_indices[k]] = _bounds[k];
+}
+
+std::size_t delta_zone_t::memory_footprint() const
+{
+  return sizeof(*this) + _indices.capacity() * sizeof(std::uint32_t) + _bounds.capacity() * sizeof(tchecker::dbm::db_t);
+}
+
+bool delta_zone_t::operator==(tchecker::zg::delta_zone_t const & zone) const
+{
+  return (_dim == zone._dim) && (_reference == zone._reference) && (_indices == zone._indices) && (_bounds == zone._bounds);
+}
+
+bool delta_zone_t::operator!=(tchecker::zg::delta_zone_t const & zone) const { return !(*this == zone); }
+
+std::size_t delta_zone_t::hash() const
+{
+  std::size_t seed = _dim;
+  boost::hash_combine(seed, _reference.ptr());
+  boost::hash_range(seed, _indices.begin(), _indices.end());
+  for (tchecker::dbm::db_t const & db : _bounds)
+    boost::hash_combine(seed, tchecker::dbm::hash(db));
+  return seed;
+}
+
+/* delta_zone_storage_t */
+
+/*!
+ \brief Number of differing bounds
+ \param dbm1 : a DBM
+ \param dbm2 : a DBM
+ \param dim : dimension of dbm1 and dbm2
+ \return number of indices where dbm1 and dbm2 have distinct bounds
+ */
+static std::size_t delta_size(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim)
+{
+  std::size_t const size = static_cast<std::size_t>(dim) * dim;
+  std::size_t count = 0;
+  for (std::size_t k = 0; k < size; ++k)
+    if (dbm1[k] != dbm2[k])
+      ++count;
+  return count;
+}
+
+tchecker::zg::delta_zone_t delta_zone_storage_t::store(tchecker::ta::state_t const & s,
+                                                       tchecker::zg::zone_sptr_t const & zone)
+{
+  tchecker::clock_id_t const dim = static_cast<tchecker::clock_id_t>(zone->dim());
+  if (_zone_pool == nullptr) {
+    _vloc_pool = std::make_shared<tchecker::pool_t<tchecker::shared_vloc_t>>(
+        ALLOC_NB, tchecker::allocation_size_t<tchecker::shared_vloc_t>::alloc_size(s.vloc().capacity()));
+    _zone_pool = std::make_shared<tchecker::pool_t<tchecker::zg::shared_zone_t>>(
+        ALLOC_NB, tchecker::allocation_size_t<tchecker::zg::shared_zone_t>::alloc_size(dim));
+  }
+
+  std::vector<group_t> & bucket = _groups[tchecker::syncprod::hash_value(s)];
+  group_t * group = nullptr;
+  for (group_t & g : bucket)
+    if (*g.vloc == s.vloc()) {
+      group = &g;
+      break;
+    }
+  if (group == nullptr) {
+    bucket.push_back(group_t{_vloc_pool->construct(s.vloc()), {}});
+    group = &bucket.back();
+  }
+
+  tchecker::zg::zone_sptr_t const * closest = nullptr;
+  std::size_t closest_size = 0;
+  for (tchecker::zg::zone_sptr_t const & reference : group->references) {
+    std::size_t const size = tchecker::zg::delta_size(zone->dbm(), reference->dbm(), dim);
+    if (closest == nullptr || size < closest_size) {
+      closest = &reference;
+      closest_size = size;
+    }
+  }
+
+  // a differing bound takes an index and a bound, the full DBM takes dim*dim bounds
+  std::size_t const full_memsize = static_cast<std::size_t>(dim) * dim * sizeof(tchecker::dbm::db_t);
+  if (closest != nullptr && closest_size * (sizeof(std::uint32_t) + sizeof(tchecker::dbm::db_t)) < full_memsize)
+    return tchecker::zg::delta_zone_t{*zone, *closest};
+
+  tchecker::zg::zone_sptr_t const reference = _zone_pool->construct(*zone);
+  if (group->references.size() < MAX_REFERENCES)
+    group->references.push_back(reference);
+  return tchecker::zg::delta_zone_t{*zone, reference};
+}
+
+std::size_t delta_zone_storage_t::references() const
+{
+  std::size_t count = 0;
+  for (auto const & [h, bucket] : _groups)
+    for (group_t const & g : bucket)
+      count += g.references.size();
+  return count;
+}
+
+std::size_t delta_zone_storage_t::memsize() const
+{
+  std::size_t memsize = _groups.bucket_count() * sizeof(void *);
+  for (auto const & [h, bucket] : _groups) {
+    // node of the map, with its key and vector
+    memsize += sizeof(std::pair<std::size_t const, std::vector<group_t>>) + sizeof(void *);
+    memsize += bucket.capacity() * sizeof(group_t);
+    for (group_t const & g : bucket)
+      memsize += g.references.capacity() * sizeof(tchecker::zg::zone_sptr_t);
+  }
+  if (_vloc_pool != nullptr)
+    memsize += _vloc_pool->memsize();
+  if (_zone_pool != nullptr)
+    memsize += _zone_pool->memsize();
+  return memsize;
+}
+
+} // end of namespace zg
+
+} // end of namespace tchecker
@@ -0,0 +1,175 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#if BOOST_VERSION <= 106600
+#include <boost/functional/hash.hpp>
+#else
+#include <boost/container_hash/hash.hpp>
+#endif
+
+#include "tchecker/zg/packed_zone.hh"
+
+namespace tchecker {
+
+namespace zg {
+
+/*!
+ \brief Check if the encoded bounds of values up to a magnitude fit in a type
+ \tparam BOUND : type of stored bounds
+ \param magnitude : largest absolute value
+ \return true if the encodings of the values in [-magnitude, magnitude] fit in BOUND, with the largest value of BOUND
+ left for infinity, false otherwise
+ */
+template <class BOUND> static bool fits(tchecker::integer_t magnitude)
+{
+  return 2 * magnitude + 1 < static_cast<tchecker::integer_t>(std::numeric_limits<BOUND>::max());
+}
+
+enum tchecker::zg::bound_width_t bound_width(tchecker::integer_t max_bound, std::size_t dim)
+{
+  if (max_bound < 0)
+    max_bound = 0;
+  // the magnitude cannot overflow for bounds and dimensions of DBMs, which are far below 2^31
+  tchecker::integer_t const magnitude = static_cast<tchecker::integer_t>(dim) * (max_bound + 1);
+  if (tchecker::zg::fits<std::int16_t>(magnitude))
+    return tchecker::zg::BOUND_WIDTH_16;
+  if (tchecker::zg::fits<std::int32_t>(magnitude))
+    return tchecker::zg::BOUND_WIDTH_32;
+  return tchecker::zg::BOUND_WIDTH_64;
+}
+
+enum tchecker::zg::bound_width_t bound_width(tchecker::clockbounds::global_m_map_t const & m)
+{
+  tchecker::integer_t max_bound = tchecker::clockbounds::NO_BOUND;
+  for (tchecker::clock_id_t id = 0; id < m.clock_number(); ++id)
+    max_bound = std::max(max_bound, m.M()[id]);
+  return tchecker::zg::bound_width(max_bound, static_cast<std::size_t>(m.clock_number()) + 1);
+}
+
+/*!
+ \brief Pack a DBM
+ \tparam BOUND : type of stored bounds
+ \param packed : packed DBM
+ \param dbm : a DBM
+ \param size : number of bounds in dbm
+ \post packed is dbm with bounds encoded as 2*value+comparator of type BOUND, and infinity encoded as the largest
+ value of BOUND
+ \throw std::invalid_argument : if a finite bound of dbm does not fit in BOUND
+ */
+template <class BOUND> static void pack(std::vector<BOUND> & packed, tchecker::dbm::db_t const * dbm, std::size_t size)
+{
+  tchecker::integer_t const infinity = std::numeric_limits<BOUND>::max();
+  packed.resize(size);
+  for (std::size_t k = 0; k < size; ++k) {
+    if (dbm[k] == tchecker::dbm::LT_INFINITY) {
+      packed[k] = static_cast<BOUND>(infinity);
+      continue;
+    }
+    tchecker::integer_t const value = tchecker::dbm::value(dbm[k]);
+    if (value < std::numeric_limits<BOUND>::min() / 2 || value > (infinity - 2) / 2)
+      throw std::invalid_argument("Zone bound does not fit in packed zone");
+    packed[k] = static_cast<BOUND>(2 * value + tchecker::dbm::comparator(dbm[k]));
+  }
+}
+
+/*!
+ \brief Unpack a DBM
+ \tparam BOUND : type of stored bounds
+ \param dbm : a DBM
+ \param packed : packed DBM
+ \post dbm is packed with widened bounds
+ */
+template <class BOUND> static void unpack(tchecker::dbm::db_t * dbm, std::vector<BOUND> const & packed)
+{
+  BOUND const infinity = std::numeric_limits<BOUND>::max();
+  for (std::size_t k = 0; k < packed.size(); ++k) {
+    if (packed[k] == infinity) {
+      dbm[k] = tchecker::dbm::LT_INFINITY;
+      continue;
+    }
+    tchecker::integer_t const encoded = packed[k];
+    enum tchecker::ineq_cmp_t const cmp = ((encoded & 1) ? tchecker::LE : tchecker::LT);
+    dbm[k] = tchecker::dbm::db(cmp, (encoded - (encoded & 1)) / 2);
+  }
+}
+
+packed_zone_t::packed_zone_t(tchecker::zg::zone_t const & zone, enum tchecker::zg::bound_width_t width)
+    : _dim(static_cast<tchecker::clock_id_t>(zone.dim())), _width(width)
+{
+  std::size_t const size = static_cast<std::size_t>(_dim) * _dim;
+  switch (_width) {
+  case tchecker::zg::BOUND_WIDTH_16:
+    tchecker::zg::pack(_dbm16, zone.dbm(), size);
+    break;
+  case tchecker::zg::BOUND_WIDTH_32:
+    tchecker::zg::pack(_dbm32, zone.dbm(), size);
+    break;
+  default:
+    _dbm64.assign(zone.dbm(), zone.dbm() + size);
+    break;
+  }
+}
+
+void packed_zone_t::to_zone(tchecker::zg::zone_t & zone) const
+{
+  if (zone.dim() != _dim)
+    throw std::invalid_argument("Zone dimension mismatch");
+  switch (_width) {
+  case tchecker::zg::BOUND_WIDTH_16:
+    tchecker::zg::unpack(zone.dbm(), _dbm16);
+    break;
+  case tchecker::zg::BOUND_WIDTH_32:
+    tchecker::zg::unpack(zone.dbm(), _dbm32);
+    break;
+  default:
+    std::copy(_dbm64.begin(), _dbm64.end(), zone.dbm());
+    break;
+  }
+}
+
+std::size_t packed_zone_t::memory_footprint() const
+{
+  return sizeof(*this) + _dbm16.capacity() * sizeof(std::int16_t) + _dbm32.capacity() * sizeof(std::int32_t) +
+         _dbm64.capacity() * sizeof(tchecker::dbm::db_t);
+}
+
+bool packed_zone_t::operator==(tchecker::zg::packed_zone_t const & zone) const
+{
+  return (_dim == zone._dim) && (_width == zone._width) && (_dbm16 == zone._dbm16) && (_dbm32 == zone._dbm32) &&
+         (_dbm64 == zone._dbm64);
+}
+
+bool packed_zone_t::operator!=(tchecker::zg::packed_zone_t const & zone) const { return !(*this == zone); }
+
+std::size_t packed_zone_t::hash() const
+{
+  std::size_t seed = _dim;
+  boost::hash_combine(seed, static_cast<int>(_width));
+  boost::hash_range(seed, _dbm16.begin(), _dbm16.end());
+  boost::hash_range(seed, _dbm32.begin(), _dbm32.end());
+  if (!_dbm64.empty())
+    boost::hash_combine(seed, tchecker::dbm::hash(_dbm64.data(), _dim));
+  return seed;
+}
+
+/* packed_zone_storage_t */
+
+tchecker::zg::packed_zone_t packed_zone_storage_t::store(tchecker::ta::state_t const & s,
+                                                         tchecker::zg::zone_sptr_t const & zone) const
+{
+  try {
+    return tchecker::zg::packed_zone_t{*zone, _width};
+  }
+  catch (std::invalid_argument const &) {
+    return tchecker::zg::packed_zone_t{*zone, tchecker::zg::BOUND_WIDTH_64};
+  }
+}
+
+} // end of namespace zg
+
+} // end of namespace tchecker
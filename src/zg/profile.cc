@@ -0,0 +1,133 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+#include "tchecker/zg/profile.hh"
+
+namespace tchecker {
+
+namespace zg {
+
+/*!
+ \brief Statuses of successors rejected by bounded integer variables (or by the locations of the source state)
+ */
+static tchecker::state_status_t const intvars_statuses =
+    tchecker::STATE_INCOMPATIBLE_EDGE | tchecker::STATE_INTVARS_GUARD_VIOLATED | tchecker::STATE_INTVARS_SRC_INVARIANT_VIOLATED |
+    tchecker::STATE_INTVARS_TGT_INVARIANT_VIOLATED | tchecker::STATE_INTVARS_STATEMENT_FAILED;
+
+profile_t::profile_t(std::shared_ptr<tchecker::ta::system_t const> const & system)
+    : _system(system), _edges(system->edges_count()), _locations(system->locations_count())
+{
+}
+
+void profile_t::expanded(tchecker::vloc_t const & vloc)
+{
+  for (tchecker::loc_id_t id : vloc)
+    _locations[id].expanded.fetch_add(1, std::memory_order_relaxed);
+}
+
+void profile_t::next(tchecker::vloc_t const & vloc, tchecker::syncprod::outgoing_edges_value_t const & edges,
+                     tchecker::state_status_t status)
+{
+  for (tchecker::system::edge_const_shared_ptr_t const & e : edges) {
+    edge_counters_t & counters = _edges[e->id()];
+    counters.computed.fetch_add(1, std::memory_order_relaxed);
+    if (status == tchecker::STATE_OK)
+      counters.successors.fetch_add(1, std::memory_order_relaxed);
+    else if (status & intvars_statuses)
+      counters.intvars.fetch_add(1, std::memory_order_relaxed);
+    else if (status == tchecker::STATE_CLOCKS_GUARD_VIOLATED)
+      counters.clocks_guard.fetch_add(1, std::memory_order_relaxed);
+    else
+      counters.empty_zone.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  for (tchecker::loc_id_t id : vloc) {
+    if (status == tchecker::STATE_OK)
+      _locations[id].successors.fetch_add(1, std::memory_order_relaxed);
+    else if ((status & intvars_statuses) == 0)
+      _locations[id].empty_zone.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void profile_t::duplicate(tchecker::vloc_t const & vloc, tchecker::vedge_t const & vedge)
+{
+  for (tchecker::loc_id_t id : vloc)
+    _locations[id].duplicates.fetch_add(1, std::memory_order_relaxed);
+  for (tchecker::edge_id_t id : vedge)
+    _edges[id].duplicates.fetch_add(1, std::memory_order_relaxed);
+}
+
+tchecker::zg::profile_t::edge_counters_t const & profile_t::edge(tchecker::edge_id_t id) const
+{
+  assert(id < _edges.size());
+  return _edges[id];
+}
+
+tchecker::zg::profile_t::location_counters_t const & profile_t::location(tchecker::loc_id_t id) const
+{
+  assert(id < _locations.size());
+  return _locations[id];
+}
+
+/*!
+ \brief Ranking of identifiers
+ \param size : number of identifiers
+ \param key : function from identifiers to counts
+ \param top : maximal number of identifiers (0: no limit)
+ \return the identifiers in [0, size) with a positive count, by decreasing count then increasing identifier, at most
+ top of them if top is not 0
+ */
+template <class KEY> static std::vector<std::size_t> ranking(std::size_t size, KEY && key, std::size_t top)
+{
+  std::vector<std::size_t> ids(size);
+  std::iota(ids.begin(), ids.end(), 0);
+  ids.erase(std::remove_if(ids.begin(), ids.end(), [&](std::size_t id) { return key(id) == 0; }), ids.end());
+  std::stable_sort(ids.begin(), ids.end(), [&](std::size_t id1, std::size_t id2) { return key(id1) > key(id2); });
+  if (top != 0 && ids.size() > top)
+    ids.resize(top);
+  return ids;
+}
+
+std::ostream & profile_t::report(std::ostream & os, std::size_t top) const
+{
+  tchecker::system::system_t const & system = _system->as_system_system();
+
+  os << "# edges by computed successors" << std::endl;
+  os << "# rank computed successors intvars_disabled clocks_guard_violated empty_zone duplicates edge" << std::endl;
+  std::vector<std::size_t> edges =
+      ranking(_edges.size(), [&](std::size_t id) { return _edges[id].computed.load(std::memory_order_relaxed); }, top);
+  for (std::size_t rank = 0; rank < edges.size(); ++rank) {
+    edge_counters_t const & c = _edges[edges[rank]];
+    tchecker::system::edge_const_shared_ptr_t const & e = system.edge(static_cast<tchecker::edge_id_t>(edges[rank]));
+    os << rank + 1 << " " << c.computed.load(std::memory_order_relaxed) << " "
+       << c.successors.load(std::memory_order_relaxed) << " " << c.intvars.load(std::memory_order_relaxed) << " "
+       << c.clocks_guard.load(std::memory_order_relaxed) << " " << c.empty_zone.load(std::memory_order_relaxed) << " "
+       << c.duplicates.load(std::memory_order_relaxed) << " " << system.process_name(e->pid()) << ": "
+       << system.location(e->src())->name() << " -> " << system.location(e->tgt())->name() << " ("
+       << system.event_name(e->event_id()) << ")" << std::endl;
+  }
+
+  os << "# locations by expanded states" << std::endl;
+  os << "# rank expanded successors empty_zone duplicates location" << std::endl;
+  std::vector<std::size_t> locations = ranking(
+      _locations.size(), [&](std::size_t id) { return _locations[id].expanded.load(std::memory_order_relaxed); }, top);
+  for (std::size_t rank = 0; rank < locations.size(); ++rank) {
+    location_counters_t const & c = _locations[locations[rank]];
+    tchecker::system::loc_const_shared_ptr_t const & l = system.location(static_cast<tchecker::loc_id_t>(locations[rank]));
+    os << rank + 1 << " " << c.expanded.load(std::memory_order_relaxed) << " "
+       << c.successors.load(std::memory_order_relaxed) << " " << c.empty_zone.load(std::memory_order_relaxed) << " "
+       << c.duplicates.load(std::memory_order_relaxed) << " " << system.process_name(l->pid()) << ": " << l->name()
+       << std::endl;
+  }
+
+  return os;
+}
+
+} // end of namespace zg
+
+} // end of namespace tchecker
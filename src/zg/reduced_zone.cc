@@ -0,0 +1,62 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <stdexcept>
+
+#if BOOST_VERSION <= 106600
+#include <boost/functional/hash.hpp>
+#else
+#include <boost/container_hash/hash.hpp>
+#endif
+
+#include "tchecker/zg/reduced_zone.hh"
+
+namespace tchecker {
+
+namespace zg {
+
+reduced_zone_t::reduced_zone_t(tchecker::zg::zone_t const & zone) : _dim(static_cast<tchecker::clock_id_t>(zone.dim()))
+{
+  tchecker::dbm::reduce(zone.dbm(), _dim, _bounds);
+  _bounds.shrink_to_fit();
+}
+
+void reduced_zone_t::to_zone(tchecker::zg::zone_t & zone) const
+{
+  if (zone.dim() != _dim)
+    throw std::invalid_argument("Zone dimension mismatch");
+  tchecker::dbm::expand(zone.dbm(), _dim, _bounds.data(), _bounds.size());
+}
+
+std::size_t reduced_zone_t::memory_footprint() const
+{
+  return sizeof(*this) + _bounds.capacity() * sizeof(tchecker::dbm::reduced_bound_t);
+}
+
+bool reduced_zone_t::is_empty() const
+{
+  return (_bounds.size() == 1) && (_bounds[0].i == 0) && (_bounds[0].j == 0) && (_bounds[0].db < tchecker::dbm::LE_ZERO);
+}
+
+bool reduced_zone_t::operator==(tchecker::zg::reduced_zone_t const & zone) const
+{
+  return (_dim == zone._dim) && (_bounds == zone._bounds);
+}
+
+bool reduced_zone_t::operator!=(tchecker::zg::reduced_zone_t const & zone) const { return !(*this == zone); }
+
+std::size_t reduced_zone_t::hash() const
+{
+  std::size_t seed = _dim;
+  for (tchecker::dbm::reduced_bound_t const & b : _bounds) {
+    boost::hash_combine(seed, b.i);
+    boost::hash_combine(seed, b.j);
+    boost::hash_combine(seed, tchecker::dbm::hash(b.db));
+  }
+  return seed;
+}
+
+} // end of namespace zg
+
+} // end of namespace tchecker
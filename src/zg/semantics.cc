@@ -45,10 +45,44 @@ tchecker::state_status_t standard_semantics_t::next(tchecker::dbm::db_t * dbm, t
   if (src_delay_allowed) {
     tchecker::dbm::open_up(dbm, dim);
 
-    if (tchecker::dbm::constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
-      return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED; // should never occur
+    // src_invariant cannot be violated after delay, hence both containers are applied at once
+    if (tchecker::dbm::constrain(dbm, dim, src_invariant, guard) == tchecker::dbm::EMPTY)
+      return tchecker::STATE_CLOCKS_GUARD_VIOLATED;
   }
+  else if (tchecker::dbm::constrain(dbm, dim, guard) == tchecker::dbm::EMPTY)
+    return tchecker::STATE_CLOCKS_GUARD_VIOLATED;
+
+  tchecker::dbm::reset(dbm, dim, clkreset);
+
+  if (tchecker::dbm::constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
+    return tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED;
+
+  return tchecker::STATE_OK;
+}
+
+tchecker::state_status_t standard_semantics_t::prepare_next(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                                            bool src_delay_allowed,
+                                                            tchecker::clock_constraint_container_t const & src_invariant)
+{
+  if (tchecker::dbm::constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
+    return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED;
 
+  if (src_delay_allowed) {
+    tchecker::dbm::open_up(dbm, dim);
+
+    // cannot be empty: dbm before delay satisfies src_invariant
+    tchecker::dbm::constrain(dbm, dim, src_invariant);
+  }
+
+  return tchecker::STATE_OK;
+}
+
+tchecker::state_status_t standard_semantics_t::next_prepared(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                                             tchecker::clock_constraint_container_t const & guard,
+                                                             tchecker::clock_reset_container_t const & clkreset,
+                                                             bool tgt_delay_allowed,
+                                                             tchecker::clock_constraint_container_t const & tgt_invariant)
+{
   if (tchecker::dbm::constrain(dbm, dim, guard) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_GUARD_VIOLATED;
 
@@ -96,13 +130,30 @@ tchecker::state_status_t standard_semantics_t::prev(tchecker::dbm::db_t * dbm, t
 
 /* elapsed_semantics_t */
 
+/*!
+ \brief Check if the valuations of an invariant are closed under time predecessors
+ \param invariant : a clock invariant
+ \return true if every constraint in invariant is an upper bound x # c on a clock x, false otherwise
+ \note for such an invariant I and any zone Z, the open_up of Z intersected with I is the open_up of (Z intersected
+ with I) intersected with I, and it is empty iff Z intersected with I is empty. Hence the intersection with I before
+ open_up can be skipped, which saves a closure of the DBM on each successor
+ */
+static bool upper_bounds_only(tchecker::clock_constraint_container_t const & invariant)
+{
+  for (tchecker::clock_constraint_t const & c : invariant)
+    if (c.id1() == tchecker::REFCLOCK_ID || c.id2() != tchecker::REFCLOCK_ID)
+      return false;
+  return true;
+}
+
 tchecker::state_status_t elapsed_semantics_t::initial(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, bool delay_allowed,
                                                       tchecker::clock_constraint_container_t const & invariant)
 {
   tchecker::dbm::zero(dbm, dim);
 
-  if (tchecker::dbm::constrain(dbm, dim, invariant) == tchecker::dbm::EMPTY)
-    return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED;
+  if (!delay_allowed || !tchecker::zg::upper_bounds_only(invariant))
+    if (tchecker::dbm::constrain(dbm, dim, invariant) == tchecker::dbm::EMPTY)
+      return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED;
 
   if (delay_allowed) {
     tchecker::dbm::open_up(dbm, dim);
@@ -139,8 +190,44 @@ tchecker::state_status_t elapsed_semantics_t::next(tchecker::dbm::db_t * dbm, tc
 
   tchecker::dbm::reset(dbm, dim, clkreset);
 
-  if (tchecker::dbm::constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
-    return tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED;
+  if (!tgt_delay_allowed || !tchecker::zg::upper_bounds_only(tgt_invariant))
+    if (tchecker::dbm::constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
+      return tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED;
+
+  if (tgt_delay_allowed) {
+    tchecker::dbm::open_up(dbm, dim);
+
+    if (tchecker::dbm::constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
+      return tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED;
+  }
+
+  return tchecker::STATE_OK;
+}
+
+tchecker::state_status_t elapsed_semantics_t::prepare_next(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                                           bool src_delay_allowed,
+                                                           tchecker::clock_constraint_container_t const & src_invariant)
+{
+  if (tchecker::dbm::constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
+    return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED;
+
+  return tchecker::STATE_OK;
+}
+
+tchecker::state_status_t elapsed_semantics_t::next_prepared(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                                            tchecker::clock_constraint_container_t const & guard,
+                                                            tchecker::clock_reset_container_t const & clkreset,
+                                                            bool tgt_delay_allowed,
+                                                            tchecker::clock_constraint_container_t const & tgt_invariant)
+{
+  if (tchecker::dbm::constrain(dbm, dim, guard) == tchecker::dbm::EMPTY)
+    return tchecker::STATE_CLOCKS_GUARD_VIOLATED;
+
+  tchecker::dbm::reset(dbm, dim, clkreset);
+
+  if (!tgt_delay_allowed || !tchecker::zg::upper_bounds_only(tgt_invariant))
+    if (tchecker::dbm::constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
+      return tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED;
 
   if (tgt_delay_allowed) {
     tchecker::dbm::open_up(dbm, dim);
@@ -0,0 +1,77 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <functional>
+
+#if BOOST_VERSION <= 106600
+#include <boost/functional/hash.hpp>
+#else
+#include <boost/container_hash/hash.hpp>
+#endif
+
+#include "tchecker/zg/split_cache.hh"
+
+namespace tchecker {
+
+namespace zg {
+
+split_cache_t::split_cache_t(std::size_t capacity) : _capacity(capacity), _hits(0), _misses(0) {}
+
+std::vector<tchecker::zg::split_cache_t::zone_sptr_t> const *
+split_cache_t::find(const_zone_sptr_t const & zone, tchecker::clock_constraint_container_t const & constraints)
+{
+  if (_capacity == 0)
+    return nullptr;
+
+  auto && [begin, end] = _index.equal_range(hash(zone, constraints));
+  for (auto it = begin; it != end; ++it) {
+    entry_t const & e = *it->second;
+    if (e._zone.ptr() == zone.ptr() && e._constraints == constraints) {
+      _entries.splice(_entries.begin(), _entries, it->second);
+      ++_hits;
+      return &_entries.front()._pieces;
+    }
+  }
+  ++_misses;
+  return nullptr;
+}
+
+void split_cache_t::insert(const_zone_sptr_t const & zone, tchecker::clock_constraint_container_t const & constraints,
+                           std::vector<zone_sptr_t> && pieces)
+{
+  if (_capacity == 0)
+    return;
+
+  if (_entries.size() == _capacity) {
+    auto && [begin, end] = _index.equal_range(_entries.back()._hash);
+    for (auto it = begin; it != end; ++it)
+      if (it->second == std::prev(_entries.end())) {
+        _index.erase(it);
+        break;
+      }
+    _entries.pop_back();
+  }
+
+  std::size_t const h = hash(zone, constraints);
+  _entries.push_front(entry_t{h, zone, constraints, std::move(pieces)});
+  _index.emplace(h, _entries.begin());
+}
+
+void split_cache_t::clear()
+{
+  _index.clear();
+  _entries.clear();
+}
+
+std::size_t split_cache_t::hash(const_zone_sptr_t const & zone, tchecker::clock_constraint_container_t const & constraints)
+{
+  std::size_t h = std::hash<tchecker::zg::shared_zone_t const *>{}(zone.ptr());
+  for (tchecker::clock_constraint_t const & c : constraints)
+    boost::hash_combine(h, tchecker::hash_value(c));
+  return h;
+}
+
+} // end of namespace zg
+
+} // end of namespace tchecker
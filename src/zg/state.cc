@@ -42,7 +42,8 @@ bool shared_equal_to(tchecker::zg::state_t const & s1, tchecker::zg::state_t con
   return tchecker::ta::shared_equal_to(s1, s2) && (s1.zone_ptr() == s2.zone_ptr());
 }
 
-bool shared_equal_to_incl_vector(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2, const boost::dynamic_bitset<> & v1, const boost::dynamic_bitset<> & v2)
+bool shared_equal_to_incl_vector(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2,
+                                 boost::dynamic_bitset<> const & v1, boost::dynamic_bitset<> const & v2)
 {
   return tchecker::ta::shared_equal_to(s1, s2) && (s1.zone_ptr() == s2.zone_ptr()) && (v1 == v2);
 }
@@ -69,6 +70,17 @@ bool shared_is_alu_le(tchecker::zg::state_t const & s1, tchecker::zg::state_t co
   return tchecker::ta::shared_equal_to(s1, s2) && (s1.zone_ptr() == s2.zone_ptr() || s1.zone().is_alu_le(s2.zone(), l, u));
 }
 
+bool is_am_le(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2, tchecker::clockbounds::map_t const & m)
+{
+  return tchecker::ta::operator==(s1, s2) && s1.zone().is_am_le(s2.zone(), m);
+}
+
+bool shared_is_am_le(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2,
+                     tchecker::clockbounds::map_t const & m)
+{
+  return tchecker::ta::shared_equal_to(s1, s2) && (s1.zone_ptr() == s2.zone_ptr() || s1.zone().is_am_le(s2.zone(), m));
+}
+
 std::size_t hash_value(tchecker::zg::state_t const & s)
 {
   std::size_t h = tchecker::ta::hash_value(s);
@@ -84,7 +96,7 @@ std::size_t shared_hash_value(tchecker::zg::state_t const & s)
   return h;
 }
 
-std::size_t shared_hash_value_incl_vector(tchecker::zg::state_t const & s, boost::dynamic_bitset<> v)
+std::size_t shared_hash_value_incl_vector(tchecker::zg::state_t const & s, boost::dynamic_bitset<> const & v)
 {
   std::size_t h = tchecker::ta::shared_hash_value(s);
   boost::hash_combine(h, s.zone_ptr());
@@ -2,9 +2,12 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <algorithm>
 #include <queue>
 
 #include "tchecker/dbm/db.hh"
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/utils/probes.hh"
 #include "tchecker/variables/clocks.hh"
 #include "tchecker/zg/zg.hh"
 
@@ -212,8 +215,10 @@ zg_t::zg_t(std::shared_ptr<tchecker::ta::system_t const> const & system, enum tc
       _state_allocator(block_size, block_size, _system->processes_count(), block_size,
                        _system->intvars_count(tchecker::VK_FLATTENED), block_size,
                        _system->clocks_count(tchecker::VK_FLATTENED) + 1, table_size),
-      _transition_allocator(block_size, block_size, _system->processes_count(), table_size)
+      _transition_allocator(block_size, block_size, _system->processes_count(), table_size), _transition_constraints(true)
 {
+  if (_sharing_type == tchecker::ts::NO_SHARING)
+    _state_allocator.allocate_records(block_size);
 }
 
 initial_range_t zg_t::initial_edges() { return tchecker::zg::initial_edges(*_system); }
@@ -223,9 +228,16 @@ void zg_t::initial(tchecker::zg::initial_value_t const & init_edge, std::vector<
   tchecker::zg::state_sptr_t s = _state_allocator.construct();
   tchecker::zg::transition_sptr_t t = _transition_allocator.construct();
 
-  tchecker::state_status_t status = tchecker::zg::initial(*_system, s->vloc_ptr(), s->intval_ptr(), s->zone_ptr(), t->vedge_ptr(), t->src_invariant_container(),
+  tchecker::state_status_t status = tchecker::zg::initial(*_system, s->vloc_ptr(), s->intval_ptr(), s->zone_ptr(), t->vedge_ptr(),
+                                                          constraints_container(t->src_invariant_container(), _src_invariant_buffer),
                                                           *_semantics, *_extrapolation, init_edge);
 
+  if (status == tchecker::STATE_OK && _active_clocks != nullptr)
+    _active_clocks->free_inactive_clocks(s->zone_ptr()->dbm(), s->zone().dim(), s->vloc());
+
+  if (status == tchecker::STATE_OK && _symmetry != nullptr)
+    canonicalize(*s);
+
   if (status & mask) {
     if (_sharing_type == tchecker::ts::SHARING) {
       share(s);
@@ -235,21 +247,61 @@ void zg_t::initial(tchecker::zg::initial_value_t const & init_edge, std::vector<
   }
 }
 
-void zg_t::initial(std::vector<sst_t> & v, tchecker::state_status_t mask) { tchecker::ts::initial(*this, v, mask); }
+void zg_t::initial(std::vector<sst_t> & v, tchecker::state_status_t mask)
+{
+  tchecker::zg::initial_range_t const init_edges = initial_edges();
+  std::size_t count = 0;
+  for (auto it = init_edges.begin(); it != init_edges.end(); ++it)
+    ++count;
+  v.reserve(v.size() + count);
+  for (tchecker::zg::initial_value_t && init_edge : init_edges)
+    initial(init_edge, v, mask);
+}
 
 tchecker::zg::outgoing_edges_range_t zg_t::outgoing_edges(tchecker::zg::const_state_sptr_t const & s)
 {
   return tchecker::zg::outgoing_edges(*_system, s->vloc_ptr());
 }
 
+/*!
+ \brief Statuses returned by tchecker::ta::next when the guard of some edge does not hold
+ */
+static tchecker::state_status_t const guard_violation_statuses =
+    tchecker::STATE_INCOMPATIBLE_EDGE | tchecker::STATE_INTVARS_GUARD_VIOLATED | tchecker::STATE_INTVARS_SRC_INVARIANT_VIOLATED;
+
 void zg_t::next(tchecker::zg::const_state_sptr_t const & s, tchecker::zg::outgoing_edges_value_t const & out_edge,
                 std::vector<sst_t> & v, tchecker::state_status_t mask)
 {
-  tchecker::zg::state_sptr_t nexts = _state_allocator.clone(*s);
+  // a successor along an edge with a violated guard would be rejected by mask
+  if (((mask & guard_violation_statuses) == 0) && !_guard_cache.holds(*_system, s->intval_ptr(), out_edge)) {
+    if (_profile != nullptr)
+      _profile->next(s->vloc(), out_edge, tchecker::STATE_INTVARS_GUARD_VIOLATED);
+    return;
+  }
+
+  // the valuation of s is left unchanged along edges without integer statements, hence it is shared instead of copied
+  // (unless symmetry reduction permutes it)
+  tchecker::zg::state_sptr_t nexts = ((_symmetry == nullptr) && tchecker::ta::static_statements(*_system, out_edge)
+                                          ? _state_allocator.clone_sharing_intval(*s)
+                                          : _state_allocator.clone(*s));
   tchecker::zg::transition_sptr_t nextt = _transition_allocator.construct();
 
-  tchecker::state_status_t status = tchecker::zg::next(*_system, nexts->vloc_ptr(), nexts->intval_ptr(), nexts->zone_ptr(), nextt->vedge_ptr(), nextt->src_invariant_container(),
-                     nextt->guard_container(), nextt->reset_container(), nextt->tgt_invariant_container(), *_semantics, *_extrapolation, out_edge);
+  tchecker::state_status_t status = tchecker::zg::next(*_system, nexts->vloc_ptr(), nexts->intval_ptr(), nexts->zone_ptr(), nextt->vedge_ptr(),
+                     constraints_container(nextt->src_invariant_container(), _src_invariant_buffer),
+                     constraints_container(nextt->guard_container(), _guard_buffer),
+                     constraints_container(nextt->reset_container(), _reset_buffer),
+                     constraints_container(nextt->tgt_invariant_container(), _tgt_invariant_buffer), *_semantics, *_extrapolation, out_edge);
+
+  if (status == tchecker::STATE_OK && _active_clocks != nullptr)
+    _active_clocks->free_inactive_clocks(nexts->zone_ptr()->dbm(), nexts->zone().dim(), nexts->vloc());
+
+  if (status == tchecker::STATE_OK && _symmetry != nullptr)
+    canonicalize(*nexts);
+
+  TCHECKER_PROBE1(zg_next_edge, status);
+
+  if (_profile != nullptr)
+    _profile->next(s->vloc(), out_edge, status);
 
   if (status & mask) {
     if (_sharing_type == tchecker::ts::SHARING) {
@@ -258,11 +310,113 @@ void zg_t::next(tchecker::zg::const_state_sptr_t const & s, tchecker::zg::outgoi
     }
     v.push_back(std::make_tuple(status, nexts, nextt));
   }
+  else {
+    // release rejected state and transition at once: their chunks are reused by the next call
+    _state_allocator.destruct(nexts);
+    _transition_allocator.destruct(nextt);
+  }
 }
 
 void zg_t::next(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v, tchecker::state_status_t mask)
 {
-  tchecker::ts::next(*this, s, v, mask);
+#if defined(TCHECKER_PROBES)
+  std::size_t const first = v.size();
+  next_all(s, v, mask);
+  TCHECKER_PROBE1(zg_next, v.size() - first);
+#else
+  next_all(s, v, mask);
+#endif
+}
+
+void zg_t::next_all(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v, tchecker::state_status_t mask)
+{
+  tchecker::clock_id_t const dim = s->zone().dim();
+  bool const src_delay_allowed = tchecker::ta::delay_allowed(*_system, s->vloc());
+  bool prepared = false;
+  tchecker::state_status_t prepared_status = tchecker::STATE_OK;
+
+  // successors along edges with a violated guard would be rejected by mask: they are pruned before allocation
+  bool const prune = ((mask & guard_violation_statuses) == 0);
+  tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t const> const intval = s->intval_ptr();
+
+  // partial-order reduction: the successors along the edges of the reducible process are computed first (pass 0),
+  // and the other successors only if there is no successor with status tchecker::STATE_OK (pass 1)
+  tchecker::process_id_t const reduced =
+      (_por == nullptr ? tchecker::ta::por_t::NO_REDUCIBLE_PROCESS : _por->reducible_process(s->vloc()));
+  std::size_t const first = v.size();
+
+  if (_profile != nullptr)
+    _profile->expanded(s->vloc());
+
+  for (int pass = (reduced == tchecker::ta::por_t::NO_REDUCIBLE_PROCESS ? 1 : 0); pass < 2; ++pass) {
+    tchecker::zg::outgoing_edges_range_t out_edges = outgoing_edges(s);
+    for (tchecker::zg::outgoing_edges_value_t && out_edge : out_edges) {
+      if ((reduced != tchecker::ta::por_t::NO_REDUCIBLE_PROCESS) &&
+          ((pass == 0) != tchecker::ta::involves(out_edge, reduced)))
+        continue;
+      if (prune && !_guard_cache.holds(*_system, intval, out_edge)) {
+        if (_profile != nullptr)
+          _profile->next(s->vloc(), out_edge, tchecker::STATE_INTVARS_GUARD_VIOLATED);
+        continue;
+      }
+
+      tchecker::zg::state_sptr_t nexts = ((_symmetry == nullptr) && tchecker::ta::static_statements(*_system, out_edge)
+                                              ? _state_allocator.clone_sharing_intval(*s)
+                                              : _state_allocator.clone(*s));
+      tchecker::zg::transition_sptr_t nextt = _transition_allocator.construct();
+      tchecker::clock_constraint_container_t & src_invariant =
+          constraints_container(nextt->src_invariant_container(), _src_invariant_buffer);
+      tchecker::clock_constraint_container_t & guard = constraints_container(nextt->guard_container(), _guard_buffer);
+      tchecker::clock_reset_container_t & reset = constraints_container(nextt->reset_container(), _reset_buffer);
+      tchecker::clock_constraint_container_t & tgt_invariant =
+          constraints_container(nextt->tgt_invariant_container(), _tgt_invariant_buffer);
+
+      tchecker::state_status_t status = tchecker::ta::next(*_system, nexts->vloc_ptr(), nexts->intval_ptr(), nextt->vedge_ptr(),
+                                                           src_invariant, guard, reset, tgt_invariant, out_edge);
+
+      // the source invariant only depends on s, hence the source zone is prepared along the first enabled edge
+      if (status == tchecker::STATE_OK && !prepared) {
+        _prepared_zone.assign(s->zone().dbm(), s->zone().dbm() + dim * dim);
+        prepared_status = _semantics->prepare_next(_prepared_zone.data(), dim, src_delay_allowed, src_invariant);
+        prepared = true;
+      }
+
+      if (status == tchecker::STATE_OK)
+        status = prepared_status;
+
+      if (status == tchecker::STATE_OK) {
+        tchecker::dbm::db_t * dbm = nexts->zone_ptr()->dbm();
+        bool tgt_delay_allowed = tchecker::ta::delay_allowed(*_system, nexts->vloc());
+        tchecker::dbm::copy(dbm, _prepared_zone.data(), dim);
+        status = _semantics->next_prepared(dbm, dim, guard, reset, tgt_delay_allowed, tgt_invariant);
+        if (status == tchecker::STATE_OK && _active_clocks != nullptr)
+          _active_clocks->free_inactive_clocks(dbm, dim, nexts->vloc());
+        if (status == tchecker::STATE_OK)
+          _extrapolation->extrapolate(dbm, dim, nexts->vloc());
+        if (status == tchecker::STATE_OK && _symmetry != nullptr)
+          canonicalize(*nexts);
+      }
+
+      if (_profile != nullptr)
+        _profile->next(s->vloc(), out_edge, status);
+
+      if (status & mask) {
+        if (_sharing_type == tchecker::ts::SHARING) {
+          share(nexts);
+          share(nextt);
+        }
+        v.push_back(std::make_tuple(status, nexts, nextt));
+      }
+      else {
+        _state_allocator.destruct(nexts);
+        _transition_allocator.destruct(nextt);
+      }
+    }
+
+    if (pass == 0 &&
+        std::any_of(v.begin() + first, v.end(), [](sst_t const & sst) { return std::get<0>(sst) == tchecker::STATE_OK; }))
+      return;
+  }
 }
 
 // Backward
@@ -274,8 +428,9 @@ void zg_t::final(final_value_t const & final_edge, std::vector<sst_t> & v, tchec
   tchecker::zg::state_sptr_t s = _state_allocator.construct();
   tchecker::zg::transition_sptr_t t = _transition_allocator.construct();
 
-  tchecker::state_status_t status = tchecker::zg::final(*_system, s->vloc_ptr(), s->intval_ptr(), s->zone_ptr(), t->vedge_ptr(), t->src_invariant_container(),
-                      *_semantics, *_extrapolation, final_edge);
+  tchecker::state_status_t status = tchecker::zg::final(*_system, s->vloc_ptr(), s->intval_ptr(), s->zone_ptr(), t->vedge_ptr(),
+                      constraints_container(t->src_invariant_container(), _src_invariant_buffer), *_semantics, *_extrapolation,
+                      final_edge);
 
   if (status & mask) {
     if (_sharing_type == tchecker::ts::SHARING) {
@@ -302,8 +457,12 @@ void zg_t::prev(tchecker::zg::const_state_sptr_t const & s, incoming_edges_value
   tchecker::zg::state_sptr_t prevs = _state_allocator.clone(*s);
   tchecker::zg::transition_sptr_t prevt = _transition_allocator.construct();
 
-  tchecker::state_status_t status = tchecker::zg::prev(*_system, prevs->vloc_ptr(), prevs->intval_ptr(), prevs->zone_ptr(), prevt->vedge_ptr(), prevt->src_invariant_container(),
-                                                       prevt->guard_container(), prevt->reset_container(), prevt->tgt_invariant_container(), *_semantics, *_extrapolation, in_edge);
+  tchecker::state_status_t status = tchecker::zg::prev(*_system, prevs->vloc_ptr(), prevs->intval_ptr(), prevs->zone_ptr(), prevt->vedge_ptr(),
+                                                       constraints_container(prevt->src_invariant_container(), _src_invariant_buffer),
+                                                       constraints_container(prevt->guard_container(), _guard_buffer),
+                                                       constraints_container(prevt->reset_container(), _reset_buffer),
+                                                       constraints_container(prevt->tgt_invariant_container(), _tgt_invariant_buffer),
+                                                       *_semantics, *_extrapolation, in_edge);
 
   if (status & mask) {
     if (_sharing_type == tchecker::ts::SHARING) {
@@ -312,6 +471,11 @@ void zg_t::prev(tchecker::zg::const_state_sptr_t const & s, incoming_edges_value
     }
     v.push_back(std::make_tuple(status, prevs, prevt));
   }
+  else {
+    // release rejected state and transition at once: their chunks are reused by the next call
+    _state_allocator.destruct(prevs);
+    _transition_allocator.destruct(prevt);
+  }
 }
 
 void zg_t::prev(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v, tchecker::state_status_t mask)
@@ -397,6 +561,55 @@ void zg_t::share(tchecker::zg::state_sptr_t & s) { _state_allocator.share(s); }
 
 void zg_t::share(tchecker::zg::transition_sptr_t & t) { _transition_allocator.share(t); }
 
+tchecker::zg::state_sptr_t zg_t::clone(tchecker::zg::shared_state_t const & s)
+{
+  tchecker::zg::state_sptr_t clone = _state_allocator.clone(s);
+  if (_sharing_type == tchecker::ts::SHARING)
+    share(clone);
+  return clone;
+}
+
+tchecker::zg::state_sptr_t zg_t::clone(tchecker::zg::shared_state_t const & s, std::size_t hash)
+{
+  tchecker::zg::state_sptr_t clone = _state_allocator.clone(s);
+  if (_sharing_type == tchecker::ts::SHARING)
+    _state_allocator.share(clone, hash);
+  return clone;
+}
+
+void zg_t::prefetch(std::size_t hash)
+{
+  if (_sharing_type == tchecker::ts::SHARING)
+    _state_allocator.prefetch(hash);
+}
+
+tchecker::zg::transition_sptr_t zg_t::clone(tchecker::zg::shared_transition_t const & t)
+{
+  tchecker::zg::transition_sptr_t clone = _transition_allocator.clone(t);
+  if (_sharing_type == tchecker::ts::SHARING)
+    share(clone);
+  return clone;
+}
+
+// Memory
+
+void zg_t::memory_usage(std::map<std::string, std::size_t> & m) const
+{
+  std::size_t const vlocs = _state_allocator.vloc_memsize();
+  std::size_t const intvals = _state_allocator.intval_memsize();
+  std::size_t const zones = _state_allocator.zone_memsize();
+  std::size_t const records = _state_allocator.record_memsize();
+  m["STATES"] = _state_allocator.memsize() - vlocs - intvals - zones - records;
+  m["VLOCS"] = vlocs;
+  m["INTVALS"] = intvals;
+  m["ZONES"] = zones;
+  m["RECORDS"] = records;
+
+  std::size_t const vedges = _transition_allocator.vedge_memsize();
+  m["TRANSITIONS"] = _transition_allocator.memsize() - vedges;
+  m["VEDGES"] = vedges;
+}
+
 // Private
 
 tchecker::zg::state_sptr_t zg_t::clone_and_constrain(tchecker::zg::const_state_sptr_t const & s,
@@ -409,6 +622,67 @@ tchecker::zg::state_sptr_t zg_t::clone_and_constrain(tchecker::zg::const_state_s
   return clone_s;
 }
 
+void zg_t::canonicalize(tchecker::zg::state_t & s)
+{
+  if (!_symmetry->canonicalize(*s.vloc_ptr(), *s.intval_ptr(), _symmetry_clocks))
+    return;
+
+  // clock x of the system is clock x + 1 in zones
+  tchecker::clock_id_t const dim = s.zone().dim();
+  _symmetry_clocks.resize(dim);
+  for (tchecker::clock_id_t x = dim - 1; x > 0; --x)
+    _symmetry_clocks[x] = _symmetry_clocks[x - 1] + 1;
+  _symmetry_clocks[0] = 0;
+
+  tchecker::dbm::db_t * dbm = s.zone_ptr()->dbm();
+  _symmetry_zone.assign(dbm, dbm + dim * dim);
+  tchecker::dbm::permute(dbm, _symmetry_zone.data(), dim, _symmetry_clocks.data());
+}
+
+/* successors_t */
+
+successors_t::successors_t(tchecker::zg::zg_t & zg, tchecker::zg::const_state_sptr_t const & s,
+                           tchecker::state_status_t mask)
+    : _zg(zg), _s(s), _mask(mask),
+      _reduced(zg.partial_order_reduction() == nullptr ? tchecker::ta::por_t::NO_REDUCIBLE_PROCESS
+                                                       : zg.partial_order_reduction()->reducible_process(s->vloc())),
+      _pass(_reduced == tchecker::ta::por_t::NO_REDUCIBLE_PROCESS ? 1 : 0), _ok(false), _edges(zg.outgoing_edges(s)),
+      _it(_edges.begin()), _pos(0)
+{
+  if (_zg.profile() != nullptr)
+    _zg.profile()->expanded(_s->vloc());
+}
+
+bool successors_t::next(tchecker::zg::zg_t::sst_t & sst)
+{
+  while (_pos == _buffer.size()) {
+    _buffer.clear();
+    _pos = 0;
+
+    // partial-order reduction: the other edges are only considered if the edges of the reducible process yield no
+    // successor with status tchecker::STATE_OK
+    if (_it == _edges.end()) {
+      if (_pass == 1 || _ok)
+        return false;
+      _pass = 1;
+      _edges = _zg.outgoing_edges(_s);
+      _it = _edges.begin();
+      continue;
+    }
+
+    if ((_reduced == tchecker::ta::por_t::NO_REDUCIBLE_PROCESS) ||
+        ((_pass == 0) == tchecker::ta::involves(*_it, _reduced)))
+      _zg.next(_s, *_it, _buffer, _mask);
+    ++_it;
+
+    for (tchecker::zg::zg_t::sst_t const & b : _buffer)
+      if (std::get<0>(b) == tchecker::STATE_OK)
+        _ok = true;
+  }
+  sst = std::move(_buffer[_pos++]);
+  return true;
+}
+
 /* tools */
 
 tchecker::zg::state_sptr_t initial(tchecker::zg::zg_t & zg, tchecker::vloc_t const & vloc, tchecker::state_status_t mask)
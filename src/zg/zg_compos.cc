@@ -2,9 +2,11 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <algorithm>
 #include <queue>
 
 #include "tchecker/dbm/db.hh"
+#include "tchecker/dbm/dbm.hh"
 #include "tchecker/variables/clocks.hh"
 #include "tchecker/zg/zg_compos.hh"
 
@@ -207,12 +209,14 @@ tchecker::state_status_t initialize(tchecker::ta::system_t const & system,
 
 zg_t::zg_t(std::shared_ptr<tchecker::ta::system_t const> const & system, enum tchecker::ts::sharing_type_t sharing_type,
            std::shared_ptr<tchecker::zg::semantics_t> const & semantics,
-           std::shared_ptr<tchecker::zg_compos::extrapolation_t> const & extrapolation, std::size_t block_size, std::size_t table_size)
+           std::shared_ptr<tchecker::zg_compos::extrapolation_t> const & extrapolation, std::size_t block_size, std::size_t table_size,
+           std::size_t edges_cache_size, std::size_t split_cache_size)
     : _system(system), _sharing_type(sharing_type), _semantics(semantics), _extrapolation(extrapolation),
       _state_allocator(block_size, block_size, _system->processes_count(), block_size,
                        _system->intvars_count(tchecker::VK_FLATTENED), block_size,
                        _system->clocks_count(tchecker::VK_FLATTENED) + 1, table_size),
-      _transition_allocator(block_size, block_size, _system->processes_count(), table_size)
+      _transition_allocator(block_size, block_size, _system->processes_count(), table_size), _edges_cache(edges_cache_size),
+      _split_cache(split_cache_size)
 {
 }
 
@@ -258,11 +262,84 @@ void zg_t::next(tchecker::zg::const_state_sptr_t const & s, tchecker::zg_compos:
     }
     v.push_back(std::make_tuple(status, nexts, nextt));
   }
+  else {
+    // release rejected state and transition at once: their chunks are reused by the next call
+    _state_allocator.destruct(nexts);
+    _transition_allocator.destruct(nextt);
+  }
 }
 
 void zg_t::next(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v, tchecker::state_status_t mask)
 {
-  tchecker::ts::next(*this, s, v, mask);
+  next_all(s, v, mask);
+}
+
+void zg_t::next_all(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v, tchecker::state_status_t mask)
+{
+  tchecker::clock_id_t const dim = s->zone().dim();
+  bool const src_delay_allowed = tchecker::ta::delay_allowed(*_system, s->vloc());
+  bool prepared = false;
+  tchecker::state_status_t prepared_status = tchecker::STATE_OK;
+
+  // partial-order reduction: the successors along the edges of the reducible process are computed first (pass 0),
+  // and the other successors only if there is no successor with status tchecker::STATE_OK (pass 1)
+  tchecker::process_id_t const reduced =
+      (_por == nullptr ? tchecker::ta::por_t::NO_REDUCIBLE_PROCESS : _por->reducible_process(s->vloc()));
+  std::size_t const first = v.size();
+
+  // outgoing tuples of edges only depend on the tuple of locations of s
+  std::shared_ptr<tchecker::syncprod::edges_list_t const> out_edges =
+      _edges_cache.outgoing_edges(_system->as_syncprod_system(), s->vloc_ptr());
+
+  for (int pass = (reduced == tchecker::ta::por_t::NO_REDUCIBLE_PROCESS ? 1 : 0); pass < 2; ++pass) {
+    for (tchecker::zg_compos::outgoing_edges_value_t const & out_edge : *out_edges) {
+      if ((reduced != tchecker::ta::por_t::NO_REDUCIBLE_PROCESS) &&
+          ((pass == 0) != tchecker::ta::involves(out_edge, reduced)))
+        continue;
+      tchecker::zg::state_sptr_t nexts = _state_allocator.clone(*s);
+      tchecker::zg::transition_sptr_t nextt = _transition_allocator.construct();
+
+      tchecker::state_status_t status =
+          tchecker::ta::next(*_system, nexts->vloc_ptr(), nexts->intval_ptr(), nextt->vedge_ptr(), nextt->src_invariant_container(),
+                       nextt->guard_container(), nextt->reset_container(), nextt->tgt_invariant_container(), out_edge);
+
+      // the source invariant only depends on s, hence the source zone is prepared along the first enabled edge
+      if (status == tchecker::STATE_OK && !prepared) {
+        _prepared_zone.assign(s->zone().dbm(), s->zone().dbm() + dim * dim);
+        prepared_status = _semantics->prepare_next(_prepared_zone.data(), dim, src_delay_allowed, nextt->src_invariant_container());
+        prepared = true;
+      }
+
+      if (status == tchecker::STATE_OK)
+        status = prepared_status;
+
+      if (status == tchecker::STATE_OK) {
+        tchecker::dbm::db_t * dbm = nexts->zone_ptr()->dbm();
+        bool tgt_delay_allowed = tchecker::ta::delay_allowed(*_system, nexts->vloc());
+        tchecker::dbm::copy(dbm, _prepared_zone.data(), dim);
+        status = _semantics->next_prepared(dbm, dim, nextt->guard_container(), nextt->reset_container(), tgt_delay_allowed,
+                                           nextt->tgt_invariant_container());
+        if (status == tchecker::STATE_OK)
+          _extrapolation->extrapolate(dbm, dim, nexts->vloc());
+      }
+
+      if (status & mask) {
+        if (_sharing_type == tchecker::ts::SHARING) {
+          share(nexts);
+          share(nextt);
+        }
+        v.push_back(std::make_tuple(status, nexts, nextt));
+      }
+      else {
+        _state_allocator.destruct(nexts);
+        _transition_allocator.destruct(nextt);
+      }
+    }
+
+    if (pass == 0 &&
+        std::any_of(v.begin() + first, v.end(), [](sst_t const & sst) { return std::get<0>(sst) == tchecker::STATE_OK; }))
+      return;
+  }
 }
 
 // Backward
@@ -312,11 +389,24 @@ void zg_t::prev(tchecker::zg::const_state_sptr_t const & s, incoming_edges_value
     }
     v.push_back(std::make_tuple(status, prevs, prevt));
   }
+  else {
+    // release rejected state and transition at once: their chunks are reused by the next call
+    _state_allocator.destruct(prevs);
+    _transition_allocator.destruct(prevt);
+  }
 }
 
 void zg_t::prev(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v, tchecker::state_status_t mask)
 {
-  tchecker::ts::prev(*this, s, v, mask);
+  // same as tchecker::ts::prev, with incoming tuples of edges from the cache
+  std::shared_ptr<tchecker::syncprod::edges_list_t const> in_edges =
+      _edges_cache.incoming_edges(_system->as_syncprod_system(), s->vloc_ptr());
+  tchecker::ta::edges_valuations_iterator_t<tchecker::range_t<tchecker::syncprod::edges_list_t::const_iterator_t>,
+                                            tchecker::flat_integer_variables_valuations_range_t>
+      it(tchecker::make_range(in_edges->begin(), in_edges->end()),
+         tchecker::flat_integer_variables_valuations_range(_system->integer_variables().flattened()));
+  for (; it != tchecker::past_the_end_iterator; ++it)
+    prev(s, *it, v, mask);
 }
 
 // Builder
@@ -349,10 +439,29 @@ void zg_t::split(tchecker::zg::const_state_sptr_t const & s, tchecker::clock_con
 void zg_t::split(tchecker::zg::const_state_sptr_t const & s, tchecker::clock_constraint_container_t const & constraints,
                  std::vector<tchecker::zg::state_sptr_t> & v)
 {
+  bool const cached = (_sharing_type == tchecker::ts::SHARING);
+
+  if (cached) {
+    std::vector<tchecker::zg::split_cache_t::zone_sptr_t> const * pieces = _split_cache.find(s->zone_ptr(), constraints);
+    if (pieces != nullptr) {
+      for (tchecker::zg::split_cache_t::zone_sptr_t const & zone : *pieces) {
+        tchecker::zg::state_sptr_t split_s = _state_allocator.clone(*s);
+        split_s->zone_ptr() = zone;
+        share(split_s);
+        v.push_back(split_s);
+      }
+      return;
+    }
+  }
+
   std::vector<tchecker::zg::state_sptr_t> done;
   std::queue<tchecker::zg::state_sptr_t> todo;
 
-  todo.push(_state_allocator.clone(*s));
+  // the clone is shared (hence not modified by the caller) as its zone is cached when no constraint splits it
+  tchecker::zg::state_sptr_t clone_s = _state_allocator.clone(*s);
+  if (cached)
+    share(clone_s);
+  todo.push(clone_s);
   for (tchecker::clock_constraint_t const & c : constraints) {
     while (!todo.empty()) {
       split(tchecker::zg::const_state_sptr_t{todo.front()}, c, done);
@@ -363,8 +472,14 @@ void zg_t::split(tchecker::zg::const_state_sptr_t const & s, tchecker::clock_con
     done.clear();
   }
 
-  for (; !todo.empty(); todo.pop())
+  std::vector<tchecker::zg::split_cache_t::zone_sptr_t> pieces;
+  for (; !todo.empty(); todo.pop()) {
+    if (cached)
+      pieces.push_back(todo.front()->zone_ptr());
     v.push_back(todo.front());
+  }
+  if (cached)
+    _split_cache.insert(s->zone_ptr(), constraints, std::move(pieces));
 }
 
 // Inspector
@@ -397,6 +512,39 @@ void zg_t::share(tchecker::zg::state_sptr_t & s) { _state_allocator.share(s); }
 
 void zg_t::share(tchecker::zg::transition_sptr_t & t) { _transition_allocator.share(t); }
 
+tchecker::zg::state_sptr_t zg_t::clone(tchecker::zg::shared_state_t const & s)
+{
+  tchecker::zg::state_sptr_t clone = _state_allocator.clone(s);
+  if (_sharing_type == tchecker::ts::SHARING)
+    share(clone);
+  return clone;
+}
+
+tchecker::zg::transition_sptr_t zg_t::clone(tchecker::zg::shared_transition_t const & t)
+{
+  tchecker::zg::transition_sptr_t clone = _transition_allocator.clone(t);
+  if (_sharing_type == tchecker::ts::SHARING)
+    share(clone);
+  return clone;
+}
+
+void zg_t::collect()
+{
+  _split_cache.clear();
+  _state_allocator.collect();
+  _transition_allocator.collect();
+}
+
+void zg_t::collection_trigger(tchecker::collection_trigger_t const & trigger)
+{
+  _state_allocator.collection_trigger(trigger);
+}
+
+void zg_t::share_zones(tchecker::zg::zone_registry_t & registry)
+{
+  _state_allocator.share_zones(registry.store(_system->clocks_count(tchecker::VK_FLATTENED) + 1));
+}
+
 // Private
 
 tchecker::zg::state_sptr_t zg_t::clone_and_constrain(tchecker::zg::const_state_sptr_t const & s,
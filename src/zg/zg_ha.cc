@@ -5,6 +5,7 @@
 #include <queue>
 
 #include "tchecker/dbm/db.hh"
+#include "tchecker/dbm/dbm.hh"
 #include "tchecker/variables/clocks.hh"
 #include "tchecker/zg/zg_ha.hh"
 
@@ -72,9 +73,9 @@ tchecker::state_status_t next(tchecker::ta_ha::system_t const & system,
                               tchecker::intrusive_shared_ptr_t<tchecker::shared_vedge_t> const & vedge,
                               tchecker::clock_constraint_container_t & src_invariant,
                               tchecker::clock_constraint_container_t & guard,
-                              std::vector<unsigned> & intvar_guard,
+                              tchecker::intvar_guard_container_t & intvar_guard,
                               tchecker::clock_reset_container_t & reset,
-                              std::vector<std::pair<tchecker::variable_id_t, tchecker::variable_id_t>> & intvar_set,
+                              tchecker::intvar_set_container_t & intvar_set,
                               tchecker::clock_constraint_container_t & tgt_invariant, tchecker::zg::semantics_t & semantics,
                               tchecker::zg_ha::extrapolation_t & extrapolation, tchecker::zg_ha::outgoing_edges_value_t const & edges)
 {
@@ -104,9 +105,9 @@ tchecker::state_status_t prev(tchecker::ta_ha::system_t const & system,
                               tchecker::intrusive_shared_ptr_t<tchecker::zg::shared_zone_t> const & zone,
                               tchecker::intrusive_shared_ptr_t<tchecker::shared_vedge_t> const & vedge,
                               tchecker::clock_constraint_container_t & src_invariant,
-                              tchecker::clock_constraint_container_t & guard, std::vector<unsigned> & intvar_guard,
+                              tchecker::clock_constraint_container_t & guard, tchecker::intvar_guard_container_t & intvar_guard,
                               tchecker::clock_reset_container_t & reset,
-                              std::vector<std::pair<tchecker::variable_id_t, tchecker::variable_id_t>> & intvar_set,
+                              tchecker::intvar_set_container_t & intvar_set,
                               tchecker::clock_constraint_container_t & tgt_invariant, tchecker::zg::semantics_t & semantics,
                               tchecker::zg_ha::extrapolation_t & extrapolation, tchecker::zg_ha::incoming_edges_value_t const & edges)
 {
@@ -262,11 +263,66 @@ void zg_t::next(tchecker::zg::const_state_sptr_t const & s, tchecker::zg_ha::out
     }
     v.push_back(std::make_tuple(status, nexts, nextt));
   }
+  else {
+    // release rejected state and transition at once: their chunks are reused by the next call
+    _state_allocator.destruct(nexts);
+    _transition_allocator.destruct(nextt);
+  }
 }
 
 void zg_t::next(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v, tchecker::state_status_t mask)
 {
-  tchecker::ts::next(*this, s, v, mask);
+  next_all(s, v, mask);
+}
+
+void zg_t::next_all(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v, tchecker::state_status_t mask)
+{
+  tchecker::clock_id_t const dim = s->zone().dim();
+  bool const src_delay_allowed = tchecker::ta_ha::delay_allowed(*_system, s->vloc());
+  bool prepared = false;
+  tchecker::state_status_t prepared_status = tchecker::STATE_OK;
+
+  tchecker::zg_ha::outgoing_edges_range_t out_edges = outgoing_edges(s);
+  for (tchecker::zg_ha::outgoing_edges_value_t && out_edge : out_edges) {
+    tchecker::zg::state_sptr_t nexts = _state_allocator.clone(*s);
+    tchecker::zg_ha::transition_sptr_t nextt = _transition_allocator.construct();
+
+    tchecker::state_status_t status =
+        tchecker::ta_ha::next(*_system, nexts->vloc_ptr(), nexts->intval_ptr(), nextt->vedge_ptr(), nextt->src_invariant_container(),
+                     nextt->guard_container(), nextt->intvar_guard_container(), nextt->reset_container(), nextt->intvar_set_container(), nextt->tgt_invariant_container(), out_edge);
+
+    // the source invariant only depends on s, hence the source zone is prepared along the first enabled edge
+    if (status == tchecker::STATE_OK && !prepared) {
+      _prepared_zone.assign(s->zone().dbm(), s->zone().dbm() + dim * dim);
+      prepared_status = _semantics->prepare_next(_prepared_zone.data(), dim, src_delay_allowed, nextt->src_invariant_container());
+      prepared = true;
+    }
+
+    if (status == tchecker::STATE_OK)
+      status = prepared_status;
+
+    if (status == tchecker::STATE_OK) {
+      tchecker::dbm::db_t * dbm = nexts->zone_ptr()->dbm();
+      bool tgt_delay_allowed = tchecker::ta_ha::delay_allowed(*_system, nexts->vloc());
+      tchecker::dbm::copy(dbm, _prepared_zone.data(), dim);
+      status = _semantics->next_prepared(dbm, dim, nextt->guard_container(), nextt->reset_container(), tgt_delay_allowed,
+                                         nextt->tgt_invariant_container());
+      if (status == tchecker::STATE_OK)
+        _extrapolation->extrapolate(dbm, dim, nexts->vloc());
+    }
+
+    if (status & mask) {
+      if (_sharing_type == tchecker::ts::SHARING) {
+        share(nexts);
+        share(nextt);
+      }
+      v.push_back(std::make_tuple(status, nexts, nextt));
+    }
+    else {
+      _state_allocator.destruct(nexts);
+      _transition_allocator.destruct(nextt);
+    }
+  }
 }
 
 // Backward
@@ -316,6 +372,11 @@ void zg_t::prev(tchecker::zg::const_state_sptr_t const & s, incoming_edges_value
     }
     v.push_back(std::make_tuple(status, prevs, prevt));
   }
+  else {
+    // release rejected state and transition at once: their chunks are reused by the next call
+    _state_allocator.destruct(prevs);
+    _transition_allocator.destruct(prevt);
+  }
 }
 
 void zg_t::prev(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v, tchecker::state_status_t mask)
@@ -401,6 +462,38 @@ void zg_t::share(tchecker::zg::state_sptr_t & s) { _state_allocator.share(s); }
 
 void zg_t::share(tchecker::zg_ha::transition_sptr_t & t) { _transition_allocator.share(t); }
 
+tchecker::zg::state_sptr_t zg_t::clone(tchecker::zg::shared_state_t const & s)
+{
+  tchecker::zg::state_sptr_t clone = _state_allocator.clone(s);
+  if (_sharing_type == tchecker::ts::SHARING)
+    share(clone);
+  return clone;
+}
+
+tchecker::zg_ha::transition_sptr_t zg_t::clone(tchecker::zg_ha::shared_transition_t const & t)
+{
+  tchecker::zg_ha::transition_sptr_t clone = _transition_allocator.clone(t);
+  if (_sharing_type == tchecker::ts::SHARING)
+    share(clone);
+  return clone;
+}
+
+void zg_t::collect()
+{
+  _state_allocator.collect();
+  _transition_allocator.collect();
+}
+
+void zg_t::collection_trigger(tchecker::collection_trigger_t const & trigger)
+{
+  _state_allocator.collection_trigger(trigger);
+}
+
+void zg_t::share_zones(tchecker::zg::zone_registry_t & registry)
+{
+  _state_allocator.share_zones(registry.store(_system->clocks_count(tchecker::VK_FLATTENED) + 1));
+}
+
 // Private
 
 tchecker::zg::state_sptr_t zg_t::clone_and_constrain(tchecker::zg::const_state_sptr_t const & s,
@@ -0,0 +1,101 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+#include "tchecker/zg/zone_stats.hh"
+
+namespace tchecker {
+
+namespace zg {
+
+zone_stats_t::zone_stats_t(std::size_t period) : _period(period), _states(0), _sampled(0)
+{
+  if (_period == 0)
+    throw std::invalid_argument("Sampling period of zone statistics should be positive");
+}
+
+void zone_stats_t::add(tchecker::zg::state_t const & s)
+{
+  ++_zones[tchecker::ta::hash_value(s)];
+  if (_states++ % _period != 0)
+    return;
+  ++_sampled;
+
+  tchecker::zg::zone_t const & zone = s.zone();
+  tchecker::clock_id_t const dim = static_cast<tchecker::clock_id_t>(zone.dim());
+  tchecker::dbm::db_t const * dbm = zone.dbm();
+
+  _bounds.clear();
+  tchecker::dbm::reduce(dbm, dim, _bounds);
+  ++_constraints[_bounds.size()];
+
+  std::size_t unbounded = 0;
+  tchecker::integer_t max_constant = 0;
+  for (tchecker::clock_id_t i = 0; i < dim; ++i)
+    for (tchecker::clock_id_t j = 0; j < dim; ++j) {
+      tchecker::dbm::db_t const db = dbm[i * dim + j];
+      if (i == j)
+        continue;
+      if (db == tchecker::dbm::LT_INFINITY)
+        ++unbounded;
+      else
+        max_constant = std::max(max_constant, std::abs(tchecker::dbm::value(db)));
+    }
+  std::size_t const entries = static_cast<std::size_t>(dim) * (dim - 1);
+  ++_unbounded[(entries == 0 ? 0 : (10 * unbounded) / entries)];
+
+  std::size_t bits = 0;
+  for (tchecker::integer_t c = max_constant; c != 0; c >>= 1)
+    ++bits;
+  ++_constant_bits[bits];
+}
+
+std::ostream & zone_stats_t::report(std::ostream & os) const
+{
+  os << "# sampled zones: " << _sampled << " of " << _states << " states" << std::endl;
+
+  os << "# bounds in the minimal constraint set" << std::endl;
+  os << "# bounds zones" << std::endl;
+  for (auto && [bounds, zones] : _constraints)
+    os << bounds << " " << zones << std::endl;
+
+  // deciles are output as ranges of percents, 10 is for zones where all the non-diagonal entries are unbounded
+  os << "# unbounded non-diagonal entries" << std::endl;
+  os << "# percent zones" << std::endl;
+  for (auto && [decile, zones] : _unbounded)
+    if (decile == 10)
+      os << "100 " << zones << std::endl;
+    else
+      os << 10 * decile << "-" << 10 * decile + 9 << " " << zones << std::endl;
+
+  os << "# largest absolute constant" << std::endl;
+  os << "# bits zones" << std::endl;
+  for (auto && [bits, zones] : _constant_bits)
+    os << bits << " " << zones << std::endl;
+
+  // discrete parts are grouped by ranges [2^k, 2^(k+1)) of numbers of zones
+  std::map<std::size_t, std::uint64_t> discrete;
+  for (auto && [hash, zones] : _zones) {
+    std::size_t k = 0;
+    while ((zones >> (k + 1)) != 0)
+      ++k;
+    ++discrete[k];
+  }
+  os << "# zones per discrete part" << std::endl;
+  os << "# zones discrete_parts" << std::endl;
+  for (auto && [k, parts] : discrete)
+    if (k == 0)
+      os << "1 " << parts << std::endl;
+    else
+      os << (std::uint64_t{1} << k) << "-" << (std::uint64_t{1} << (k + 1)) - 1 << " " << parts << std::endl;
+
+  return os;
+}
+
+} // end of namespace zg
+
+} // end of namespace tchecker
@@ -0,0 +1,56 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <cassert>
+#include <cstring>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/zg/zone_summary.hh"
+
+namespace tchecker {
+
+namespace zg {
+
+/*!
+ \brief Rank of a finite difference bound
+ \param db : a difference bound
+ \pre db is not infinity
+ \return 2*c+1 if db is (<=,c), and 2*c if db is (<,c)
+ */
+static inline std::int64_t db_rank(tchecker::dbm::db_t const & db)
+{
+  return 2 * static_cast<std::int64_t>(tchecker::dbm::value(db)) + (tchecker::dbm::comparator(db) == tchecker::LE ? 1 : 0);
+}
+
+alu_summary_t::alu_summary_t(tchecker::zg::zone_t const & zone, tchecker::clockbounds::map_t const & u)
+{
+  // empty zones have an empty summary, see tchecker::zg::zone_t::is_alu_le
+  if (zone.is_empty())
+    return;
+  _dim = static_cast<tchecker::clock_id_t>(zone.dim());
+  assert(u.capacity() + 1 == _dim);
+  _rows.resize(2 * _dim);
+  tchecker::dbm::alu_lower_row(zone.dbm(), _dim, u.ptr(), _rows.data());
+  std::memcpy(_rows.data() + _dim, zone.dbm(), _dim * sizeof(tchecker::dbm::db_t));
+  // lower bounds are finite, and their ranks are increasing w.r.t. difference bound ordering, so pointwise
+  // comparison of rows implies comparison of sums of ranks
+  _lower_rank = 0;
+  _upper_rank = 0;
+  for (tchecker::clock_id_t x = 0; x < _dim; ++x) {
+    _lower_rank += db_rank(_rows[x]);
+    _upper_rank += db_rank(_rows[_dim + x]);
+  }
+}
+
+bool alu_summary_t::may_be_alu_le(tchecker::zg::alu_summary_t const & summary) const
+{
+  if (_dim == 0 || summary._dim == 0)
+    return true;
+  assert(_dim == summary._dim);
+  return tchecker::dbm::is_lower_row_le(_rows.data(), summary._rows.data() + summary._dim, _dim);
+}
+
+} // end of namespace zg
+
+} // end of namespace tchecker
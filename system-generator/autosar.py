@@ -0,0 +1,164 @@
+"""
+Part of the TCompos project. See files AUTHORS and LICENSE for copyright details.
+
+Generator of AUTOSAR-like models: a schedule releases N periodic tasks, each task executes a chain of R
+runnables, and the last runnable of each task writes a buffer that is read by the first runnable of the next
+task. The observer prop1 reaches location error when task1 is released again before it has finished.
+
+The model is an input of system.py, which splits it into the property (schedule, task1, its runnables, buffer1
+and prop1) and the environment (the other processes).
+"""
+
+import argparse
+
+parser = argparse.ArgumentParser(description="Generate an AUTOSAR-like model.")
+parser.add_argument("--tasks", type=int, default=3, help="Number of tasks")
+parser.add_argument("--runnables", type=int, default=2, help="Number of runnables per task")
+parser.add_argument("--period", type=int, default=10, help="Period of task1 (task i has period i * period)")
+parser.add_argument("--wcet", type=int, default=2, help="Worst-case execution time of runnables")
+parser.add_argument("--bcet", type=int, default=1, help="Best-case execution time of runnables")
+parser.add_argument(
+    "--unsafe",
+    action="store_true",
+    help="Tasks may finish at the end of their period, hence error is reachable",
+)
+parser.add_argument("--output", default="AUTOSAR", help="Output file")
+
+
+def runnable_id(task, j, runnables):
+    """Identifier of the j-th runnable (from 1) of task (from 1)"""
+    return (task - 1) * runnables + j
+
+
+def prop_automata(tasks, runnables):
+    """Processes of the property, in the order expected by system.py --prop_automata"""
+    processes = ["schedule", "task1"]
+    if tasks > 1:
+        processes.append("buffer1")
+    processes += ["runnable{}".format(runnable_id(1, j, runnables)) for j in range(1, runnables + 1)]
+    processes.append("prop1")
+    return processes
+
+
+def env_automata(tasks, runnables):
+    """Processes of the environment, in the order expected by system.py --env_automata"""
+    processes = ["buffer{}".format(i) for i in range(2, tasks)]
+    processes += ["task{}".format(i) for i in range(2, tasks + 1)]
+    processes += [
+        "runnable{}".format(runnable_id(i, j, runnables)) for i in range(2, tasks + 1) for j in range(1, runnables + 1)
+    ]
+    return processes
+
+
+def generate(tasks, runnables, period, wcet, bcet, unsafe):
+    """Lines of the model"""
+    if tasks < 1 or runnables < 1:
+        raise Exception("There should be at least one task and one runnable per task")
+    if bcet > wcet:
+        raise Exception("Best-case execution time should not exceed worst-case execution time")
+
+    lines = ["system:autosar_{}_{}".format(tasks, runnables), ""]
+
+    # clocks: periods of tasks (schedule), executions of tasks and of runnables
+    lines += ["clock:1:t{}".format(i) for i in range(1, tasks + 1)]
+    lines += ["clock:1:c{}".format(i) for i in range(1, tasks + 1)]
+    lines += ["clock:1:r{}".format(k) for k in range(1, tasks * runnables + 1)]
+    lines.append("")
+
+    # overwritten values of buffers
+    lines += ["int:1:0:1:0:lost{}".format(i) for i in range(1, tasks)]
+    lines.append("")
+
+    events = []
+    for i in range(1, tasks + 1):
+        events += ["release{}".format(i), "finish{}".format(i)]
+    for k in range(1, tasks * runnables + 1):
+        events += ["run{}".format(k), "done{}".format(k)]
+    for i in range(1, tasks):
+        events += ["write{}".format(i), "read{}".format(i)]
+    lines += ["event:{}".format(e) for e in events]
+    lines.append("")
+
+    # schedule: releases task i every i * period time units
+    invariant = " && ".join("t{}<={}".format(i, i * period) for i in range(1, tasks + 1))
+    lines.append("process:schedule")
+    lines.append("location:schedule:s{{initial: : invariant: {}}}".format(invariant))
+    for i in range(1, tasks + 1):
+        lines.append("edge:schedule:s:s:release{0}{{provided: t{0}>={1} : do: t{0}=0}}".format(i, i * period))
+    lines.append("")
+
+    # tasks: run their runnables in sequence, a release while running is dropped. A task has to finish before the
+    # end of its period when unsafe is not set
+    for i in range(1, tasks + 1):
+        deadline = i * period if unsafe else i * period - 1
+        lines.append("process:task{}".format(i))
+        lines.append("location:task{}:idle{{initial:}}".format(i))
+        busy = ["ready{}".format(j) for j in range(1, runnables + 1)] + ["wait{}".format(j) for j in range(1, runnables + 1)]
+        busy.append("end")
+        for loc in busy:
+            lines.append("location:task{}:{}{{invariant: c{}<={}}}".format(i, loc, i, deadline))
+        lines.append("edge:task{0}:idle:ready1:release{0}{{do: c{0}=0}}".format(i))
+        for j in range(1, runnables + 1):
+            k = runnable_id(i, j, runnables)
+            done_tgt = "ready{}".format(j + 1) if j < runnables else "end"
+            lines.append("edge:task{}:ready{}:wait{}:run{}{{}}".format(i, j, j, k))
+            lines.append("edge:task{}:wait{}:{}:done{}{{}}".format(i, j, done_tgt, k))
+        lines.append("edge:task{0}:end:idle:finish{0}{{}}".format(i))
+        for loc in busy:
+            lines.append("edge:task{0}:{1}:{1}:release{0}{{}}".format(i, loc))
+        lines.append("")
+
+    # runnables: execute between bcet and wcet time units
+    for k in range(1, tasks * runnables + 1):
+        lines.append("process:runnable{}".format(k))
+        lines.append("location:runnable{}:idle{{initial:}}".format(k))
+        lines.append("location:runnable{0}:exec{{invariant: r{0}<={1}}}".format(k, wcet))
+        lines.append("edge:runnable{0}:idle:exec:run{0}{{do: r{0}=0}}".format(k))
+        lines.append("edge:runnable{0}:exec:idle:done{0}{{provided: r{0}>={1}}}".format(k, bcet))
+        lines.append("")
+
+    # buffers: implicit communication, reads never block and writes overwrite unread values
+    for i in range(1, tasks):
+        lines.append("process:buffer{}".format(i))
+        lines.append("location:buffer{}:empty{{initial:}}".format(i))
+        lines.append("location:buffer{}:full{{}}".format(i))
+        lines.append("edge:buffer{0}:empty:full:write{0}{{}}".format(i))
+        lines.append("edge:buffer{0}:empty:empty:read{0}{{}}".format(i))
+        lines.append("edge:buffer{0}:full:empty:read{0}{{}}".format(i))
+        lines.append("edge:buffer{0}:full:full:write{0}{{do: lost{0}=1}}".format(i))
+        lines.append("")
+
+    # observer of task1
+    lines.append("process:prop1")
+    lines.append("location:prop1:idle{initial:}")
+    lines.append("location:prop1:busy{}")
+    lines.append("location:prop1:error{labels: error}")
+    lines.append("edge:prop1:idle:busy:release1{}")
+    lines.append("edge:prop1:busy:idle:finish1{}")
+    lines.append("edge:prop1:busy:error:release1{}")
+    lines.append("")
+
+    lines.append("sync:schedule@release1:task1@release1:prop1@release1")
+    for i in range(2, tasks + 1):
+        lines.append("sync:schedule@release{0}:task{0}@release{0}".format(i))
+    lines.append("sync:task1@finish1:prop1@finish1")
+    for i in range(1, tasks + 1):
+        for j in range(1, runnables + 1):
+            k = runnable_id(i, j, runnables)
+            run = "sync:task{0}@run{1}:runnable{1}@run{1}".format(i, k)
+            if j == 1 and i > 1:
+                run += ":buffer{0}@read{0}".format(i - 1)
+            done = "sync:task{0}@done{1}:runnable{1}@done{1}".format(i, k)
+            if j == runnables and i < tasks:
+                done += ":buffer{0}@write{0}".format(i)
+            lines += [run, done]
+    return lines
+
+
+if __name__ == "__main__":
+    args = parser.parse_args()
+    with open(args.output, "w") as f:
+        for line in generate(args.tasks, args.runnables, args.period, args.wcet, args.bcet, args.unsafe):
+            f.write(line + "\n")
+    print("Prop automata: ", " ".join(prop_automata(args.tasks, args.runnables)))
+    print("Env automata: ", " ".join(env_automata(args.tasks, args.runnables)))
@@ -0,0 +1,133 @@
+"""
+Part of the TCompos project. See files AUTHORS and LICENSE for copyright details.
+
+Scaling benchmark of the compositional algorithm (tck-reach -a compos) against the monolithic reachability
+algorithm (tck-reach -a reach) on AUTOSAR-like models generated by autosar.py and split by system.py.
+
+Each algorithm runs on each model under the same budget (--timeout, --max-memory). The statistics output by
+tck-reach (running time, memory, visited states, per-phase breakdown of compos) are recorded, one row per run,
+in bench.csv and bench.json in the output directory.
+"""
+
+import argparse
+import csv
+import json
+import os
+import subprocess
+import sys
+import time
+
+import autosar
+
+parser = argparse.ArgumentParser(description="Benchmark compos against reach on generated models.")
+parser.add_argument("--tck_reach", default="tck-reach", help="tck-reach executable")
+parser.add_argument("--tasks", default="2,3,4", help="Comma-separated list of numbers of tasks")
+parser.add_argument("--runnables", default="2", help="Comma-separated list of numbers of runnables per task")
+parser.add_argument("--algorithms", default="reach,compos", help="Comma-separated list of algorithms")
+parser.add_argument("--timeout", type=int, default=60, help="Timeout of each run in seconds")
+parser.add_argument("--max_memory", default="4G", help="Memory limit of each run")
+parser.add_argument("--unsafe", action="store_true", help="Generate models where error is reachable")
+parser.add_argument("--extra_args", default="", help="Extra arguments of tck-reach (space-separated)")
+parser.add_argument("--output_dir", default="bench-compos", help="Directory of models and results")
+
+GENERATOR_DIR = os.path.dirname(os.path.abspath(__file__))
+
+
+def split_model(model, tasks, runnables, output_dir):
+    """Split model with system.py, return the paths of the system, the property and the environment"""
+    subprocess.run(
+        [sys.executable, os.path.join(GENERATOR_DIR, "system.py"), "--input", model, "--output_dir", output_dir]
+        + ["--prop_automata"] + autosar.prop_automata(tasks, runnables)
+        + ["--env_automata"] + autosar.env_automata(tasks, runnables),
+        check=True,
+        stdout=subprocess.DEVNULL,
+    )
+    name = os.path.join(output_dir, "autosar_{}_{}".format(tasks, runnables))
+    return name + "_orig", name + "_prop", name + "_env"
+
+
+def command(algorithm, orig, prop, env, args):
+    """Command line of tck-reach for algorithm"""
+    cmd = [args.tck_reach, "-a", algorithm, "-l", "error", "--stats-format", "json"]
+    cmd += ["--timeout", str(args.timeout), "--max-memory", args.max_memory]
+    if algorithm == "compos":
+        cmd += ["-P", prop, "-E", env]
+    cmd += args.extra_args.split()
+    cmd.append(orig)
+    return cmd
+
+
+def run(cmd, timeout):
+    """Run cmd, return its status, wall-clock time and statistics"""
+    start = time.perf_counter()
+    try:
+        # tck-reach stops on its own budget, the margin only guards against runs that ignore it
+        p = subprocess.run(cmd, capture_output=True, text=True, timeout=2 * timeout + 10)
+    except subprocess.TimeoutExpired:
+        return "killed", time.perf_counter() - start, {}
+    wall_time = time.perf_counter() - start
+
+    stats = {}
+    for line in p.stdout.splitlines():
+        if line.startswith("{"):
+            try:
+                stats.update(json.loads(line))
+            except json.JSONDecodeError:
+                pass
+    if p.returncode != 0:
+        return "error", wall_time, stats
+    if stats.get("BUDGET_EXCEEDED", False) or stats.get("REACHABLE") == "unknown":
+        return "budget", wall_time, stats
+    return "ok", wall_time, stats
+
+
+def main():
+    args = parser.parse_args()
+    os.makedirs(args.output_dir, exist_ok=True)
+
+    tasks_list = [int(n) for n in args.tasks.split(",")]
+    if min(tasks_list) < 2:
+        raise Exception("There should be at least two tasks: the environment contains the tasks other than task1")
+
+    rows = []
+    for tasks in tasks_list:
+        for runnables in [int(n) for n in args.runnables.split(",")]:
+            model = os.path.join(args.output_dir, "AUTOSAR-{}-{}".format(tasks, runnables))
+            with open(model, "w") as f:
+                for line in autosar.generate(tasks, runnables, 10, 2, 1, args.unsafe):
+                    f.write(line + "\n")
+            orig, prop, env = split_model(model, tasks, runnables, args.output_dir)
+
+            for algorithm in args.algorithms.split(","):
+                status, wall_time, stats = run(command(algorithm, orig, prop, env, args), args.timeout)
+                row = {
+                    "TASKS": tasks,
+                    "RUNNABLES": runnables,
+                    "ALGORITHM": algorithm,
+                    "STATUS": status,
+                    "WALL_TIME_SECONDS": round(wall_time, 3),
+                }
+                row.update(stats)
+                rows.append(row)
+                print(
+                    "tasks={} runnables={} {}: {} in {:.3f}s".format(tasks, runnables, algorithm, status, wall_time),
+                    flush=True,
+                )
+
+    with open(os.path.join(args.output_dir, "bench.json"), "w") as f:
+        json.dump(rows, f, indent=2)
+
+    # the columns are the union of the statistics of all runs: compos outputs per-phase statistics that reach does not
+    columns = []
+    for row in rows:
+        for key in row:
+            if key not in columns:
+                columns.append(key)
+    with open(os.path.join(args.output_dir, "bench.csv"), "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=columns)
+        writer.writeheader()
+        writer.writerows(rows)
+
+
+if __name__ == "__main__":
+    main()
@@ -2,6 +2,7 @@
 Part of the TCompos project. See files AUTHORS and LICENSE for copyright details.
 """
 
+import os
 import re
 import argparse
 
@@ -28,6 +29,16 @@ parser.add_argument(
     ],
     help="List of env automata",
 )
+parser.add_argument(
+    "--input",
+    default="../../examples/AUTOSAR-1",
+    help="Model to split",
+)
+parser.add_argument(
+    "--output_dir",
+    default=".",
+    help="Directory of the output files",
+)
 args = parser.parse_args()
 
 
@@ -38,7 +49,7 @@ print("Prop automata: ", prop_automata)
 print("Env automata: ", env_automata)
 
 # Get the input automata code (this can be from a file or string)
-f = open("../../examples/AUTOSAR-1", "r")
+f = open(args.input, "r")
 
 system_desc = {
     "system": None,
@@ -257,7 +268,7 @@ if len(prop_clock_set.intersection(env_clock_set)) != 0:
     )
 
 # write main
-orig = open(system_desc["system"].lower() + "_orig", "w")
+orig = open(os.path.join(args.output_dir, system_desc["system"].lower() + "_orig"), "w")
 orig.write("system:{}".format(system_desc["system"] + "\n"))
 orig.write("\n")
 
@@ -287,7 +298,7 @@ for sync in system_desc["syncs"]:
 orig.close()
 
 # write prop
-prop = open(system_desc["system"].lower() + "_prop", "w")
+prop = open(os.path.join(args.output_dir, system_desc["system"].lower() + "_prop"), "w")
 prop.write("system:{}".format(system_desc["system"] + "\n"))
 prop.write("\n")
 
@@ -319,14 +330,15 @@ for sync in prop_syncs:
 prop.close()
 
 # write env
-env = open(system_desc["system"].lower() + "_env", "w")
+env = open(os.path.join(args.output_dir, system_desc["system"].lower() + "_env"), "w")
 env.write("system:{}".format(system_desc["system"] + "\n"))
 env.write("\n")
 
 for clk in env_clock_set:
     clock = next((c for c in system_desc["clocks"] if c["name"] == clk), None)
     if clock:
-        prop.write(clock["exp"] + "\n")
+        env.write(clock["exp"] + "\n")
+env.write("\n")
 
 for int_var in system_desc["int_vars"]:
     env.write(int_var + "\n")
@@ -267,7 +267,7 @@ function(tck_add_nr_memcheck_test testfile testnamevar slist)
         tck_add_test_envvar(testenv TEST "${CMAKE_CURRENT_SOURCE_DIR}/${testfile}")
     elseif (ext STREQUAL ".tck")
         tck_add_test_envvar(testenv TEST "${TCK_REACH}")
-        tck_add_test_envvar(testenv TEST_ARGS "-a reach -C graph -o /dev/stdout ${CMAKE_CURRENT_SOURCE_DIR}/${testfile}")
+        tck_add_test_envvar(testenv TEST_ARGS "-a reach -C graph --lexical-graph -o /dev/stdout ${CMAKE_CURRENT_SOURCE_DIR}/${testfile}")
     else ()
         message(FATAL_ERROR "Don't know what kind of test is ${testfile}.")
     endif ()
@@ -0,0 +1,50 @@
+#!/usr/bin/env bash
+
+# This script checks that the compositional algorithm and reach agree on the
+# reachability of labels in a TChecker file. It is invoked as:
+#   compos-verdict.sh labels file [options of compos]
+# where labels is a comma-separated list of labels. The system is decomposed
+# with --auto-split. Nothing is output if both verdicts are the same.
+#
+
+if ! test -n "${TCK_REACH}";
+then
+    echo 1>&2 "missing variable TCK_REACH"
+    exit 1
+fi
+
+if test $# -lt 2;
+then
+    echo 1>&2 "usage: $0 labels file [options of compos]"
+    exit 1
+fi
+
+LABELS="$1"
+INPUTFILE="$2"
+shift 2
+
+if ! test -f "${INPUTFILE}";
+then
+    echo 1>&2 "missing input file '${INPUTFILE}'"
+    exit 1
+fi
+
+TMPERRFILE="tmperrfile.$$.err"
+
+verdict() {
+    eval ${TCK_REACH} "$@" -l \"${LABELS}\" \"${INPUTFILE}\" 2>> "${TMPERRFILE}" |
+        sed -n -e 's/^REACHABLE *//p'
+}
+
+EXPECTED=$(verdict -a reach)
+VERDICT=$(verdict -a compos --auto-split "$@")
+
+if test -z "${EXPECTED}" || test "${VERDICT}" != "${EXPECTED}";
+then
+    echo 1>&2 "compos $* answers '${VERDICT}' instead of '${EXPECTED}' for labels ${LABELS} in ${INPUTFILE}"
+    cat 1>&2 "${TMPERRFILE}"
+    rm -f "${TMPERRFILE}"
+    exit 1
+fi
+
+rm -f "${TMPERRFILE}"
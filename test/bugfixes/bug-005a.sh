@@ -8,7 +8,7 @@ fi
 
 if test -n "${TCK_REACH_SH}";
 then
-    exec ${TCK_REACH_SH} -a reach -C graph -o /dev/stdout ${TCK_EXAMPLES_DIR}/ad94.txt
+    exec ${TCK_REACH_SH} -a reach -C graph --lexical-graph -o /dev/stdout ${TCK_EXAMPLES_DIR}/ad94.txt
 else
     echo 1>&2 "missing environment variable TCK_REACH"
     exit 1
@@ -0,0 +1,36 @@
+#!/usr/bin/env bash
+
+# This script is a wrapper that extracts labels from TChecker files and
+# invokes tck-reach on them like tck-reach.sh, but keeps the statistics
+# unfiltered (running time, memory) and outputs no certificate, so that they
+# can be compared to performance baselines (see test-driver.sh).
+#
+
+if ! test -n "${TCK_REACH}";
+then
+    echo 1>&2 "missing variable TCK_REACH"
+    exit 1
+fi
+
+COMMAND="${TCK_REACH}"
+while test $# != 1;
+do
+    COMMAND="${COMMAND} \"$1\""
+    shift
+done
+
+INPUTFILE="$1"
+if test -f "${INPUTFILE}";
+then
+    LABELS=$(grep -e "^# *labels *= *\([a-zA-Z0-9_:]*\) *\$" ${INPUTFILE} | sed -e 's/^# *labels *= *//g' | tr : ,)
+    if test -n "${LABELS}";
+    then
+        COMMAND="${COMMAND} -l \"${LABELS}\""
+    fi
+    COMMAND="${COMMAND} \"${INPUTFILE}\""
+else
+    echo 1>&2 "missing input file '${INPUTFILE}'"
+    exit 1
+fi
+
+eval ${COMMAND}
@@ -35,6 +35,89 @@ then
   fi
 fi
 
+# Performance mode: the statistics in the output are compared to the
+# baseline in ${PERF_BASELINE_FILE}. Each line of the baseline is a statistic,
+# its baseline value and a relative tolerance. The test fails when a running
+# time or a memory usage (RUNNING_TIME_*, MEMORY_*) exceeds its baseline by
+# more than the tolerance, and when any other statistic (e.g. VISITED_STATES)
+# differs from its baseline by more than the tolerance. A statistic KEY@class
+# is only checked when ${PERF_HARDWARE_CLASS} is class. With
+# PERF_SAVE_BASELINE=yes, the baseline is updated with the output instead.
+if test -n "${PERF_BASELINE_FILE}";
+then
+    if test ${retcode} -ne 0;
+    then
+        echo 1>&2 "Test failed with code ${retcode}."
+        test -f "${ERROR_FILE}" && head -n ${DIFF_HEAD_SIZE} "${ERROR_FILE}" 1>&2
+        exit 1
+    fi
+
+    if test "${PERF_SAVE_BASELINE}" = "yes";
+    then
+        if ! test -f "${PERF_BASELINE_FILE}";
+        then
+            {
+                echo "# statistic baseline tolerance"
+                echo "VISITED_STATES 0 0"
+                echo "VISITED_TRANSITIONS 0 0"
+                echo "MEMORY_PEAK_RSS_BYTES 0 0.25"
+            } > "${PERF_BASELINE_FILE}"
+        fi
+        if test -n "${PERF_HARDWARE_CLASS}" &&
+           ! grep -q -e "^RUNNING_TIME_SECONDS@${PERF_HARDWARE_CLASS} " "${PERF_BASELINE_FILE}";
+        then
+            echo "RUNNING_TIME_SECONDS@${PERF_HARDWARE_CLASS} 0 0.5" >> "${PERF_BASELINE_FILE}"
+        fi
+        awk -v class="${PERF_HARDWARE_CLASS}" '
+            FNR == NR { if (NF == 2) measured[$1] = $2; next }
+            /^#/ || NF < 3 { print; next }
+            {
+                n = split($1, key, "@")
+                if ((n == 1 || key[2] == class) && (key[1] in measured))
+                    $2 = measured[key[1]]
+                print
+            }' "${OUTPUT_FILE}" "${PERF_BASELINE_FILE}" > "${PERF_BASELINE_FILE}.tmp" &&
+        mv "${PERF_BASELINE_FILE}.tmp" "${PERF_BASELINE_FILE}"
+        echo "Saved baseline ${PERF_BASELINE_FILE}"
+        exit 0
+    fi
+
+    if ! test -f "${PERF_BASELINE_FILE}";
+    then
+        echo "No baseline ${PERF_BASELINE_FILE}: record one with PERF_SAVE_BASELINE=yes (target save-perf-baselines)"
+        exit 77
+    fi
+
+    awk -v class="${PERF_HARDWARE_CLASS}" '
+        FNR == NR { if (NF == 2) measured[$1] = $2; next }
+        /^#/ || NF < 3 { next }
+        {
+            n = split($1, key, "@")
+            if (n > 1 && key[2] != class)
+                next
+            if (!(key[1] in measured)) {
+                printf "%s: missing from the output\n", $1
+                failed = 1
+                next
+            }
+            value = measured[key[1]] + 0
+            baseline = $2 + 0
+            tolerance = $3 + 0
+            if (value > baseline * (1 + tolerance)) {
+                printf "%s: %s exceeds baseline %s by more than %s\n", $1, value, baseline, tolerance
+                failed = 1
+            }
+            else if (key[1] !~ /^(RUNNING_TIME|MEMORY)/ && value < baseline * (1 - tolerance)) {
+                printf "%s: %s is below baseline %s by more than %s, update the baseline\n", $1, value, baseline, tolerance
+                failed = 1
+            }
+        }
+        END { exit failed }' "${OUTPUT_FILE}" "${PERF_BASELINE_FILE}" 1>&2 || exit 1
+
+    test -s "${ERROR_FILE}" || rm "${ERROR_FILE}"
+    exit 0
+fi
+
 if test ${retcode} -eq 0;
 then
     if ! test -f "${EXPECTED_OUTPUT_FILE}";
@@ -0,0 +1,41 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <stdexcept>
+
+#include "tchecker/utils/bitstate.hh"
+
+TEST_CASE("Bitstate table", "[bitstate]")
+{
+  SECTION("Size is a power of 2")
+  {
+    tchecker::bitstate_table_t t{1000};
+    REQUIRE(t.bits() == 4096);
+    REQUIRE(t.set_bits() == 0);
+    REQUIRE(t.collision_probability() == 0.0);
+    REQUIRE_THROWS_AS(tchecker::bitstate_table_t(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(tchecker::bitstate_table_t(1000, 0), std::invalid_argument);
+  }
+
+  SECTION("Inserted values are members")
+  {
+    tchecker::bitstate_table_t t{1 << 16};
+    std::size_t new_values = 0;
+    for (std::size_t h = 0; h < 1000; ++h)
+      if (t.insert(h))
+        ++new_values;
+    REQUIRE(new_values == 1000); // a collision is very unlikely with 2^19 bits
+    for (std::size_t h = 0; h < 1000; ++h) {
+      REQUIRE(t.contains(h));
+      REQUIRE_FALSE(t.insert(h));
+    }
+    REQUIRE(t.set_bits() <= 3 * 1000);
+    REQUIRE(t.collision_probability() > 0.0);
+    REQUIRE(t.collision_probability() < 1e-6);
+
+    t.clear();
+    REQUIRE(t.set_bits() == 0);
+    REQUIRE_FALSE(t.contains(0));
+  }
+}
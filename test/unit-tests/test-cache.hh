@@ -2,9 +2,14 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <atomic>
+#include <chrono>
 #include <functional>
+#include <thread>
+#include <vector>
 
 #include "tchecker/utils/cache.hh"
+#include "tchecker/utils/pool.hh"
 #include "tchecker/utils/shared_objects.hh"
 
 // Object for testing
@@ -37,6 +42,26 @@ using A_cache_t = tchecker::cache_t<A_sptr_t, A_hash_t, A_equal_t>;
 
 using A_periodic_collectable_cache_t = tchecker::periodic_collectable_cache_t<A_sptr_t, A_hash_t, A_equal_t>;
 
+// Objects with an atomic reference counter, shared between threads
+using atomic_shared_A_t = tchecker::make_shared_t<A_t, std::atomic<std::size_t>>;
+
+using atomic_A_sptr_t = tchecker::intrusive_shared_ptr_t<atomic_shared_A_t>;
+
+class atomic_A_hash_t {
+public:
+  std::size_t operator()(atomic_A_sptr_t const & a) const noexcept { return static_cast<std::size_t>(a->x()); }
+};
+
+class atomic_A_equal_t {
+public:
+  bool operator()(atomic_A_sptr_t const & a1, atomic_A_sptr_t const & a2) const
+  {
+    return (a1->x() == a2->x() && a1->y() == a2->y());
+  }
+};
+
+using atomic_A_concurrent_cache_t = tchecker::concurrent_cache_t<atomic_A_sptr_t, atomic_A_hash_t, atomic_A_equal_t>;
+
 namespace tchecker {
 template <> class allocation_size_t<A_t> {
 public:
@@ -327,6 +352,24 @@ TEST_CASE("Periodic collectable cache with nothing to collect", "[cache]")
     REQUIRE(ncollect == 2);
   }
 
+  SECTION("Collection regardless of period")
+  {
+    cache.find_else_add(p1);
+    cache.find_else_add(p2);
+    cache.find_else_add(p3);
+    cache.find_else_add(p4);
+
+    std::size_t ncollect = cache.collect();
+    REQUIRE(ncollect == 0);
+
+    // p1 and p3 are collected at once, even though collection period has not been reached
+    p1 = nullptr;
+    p3 = nullptr;
+    ncollect = cache.collect_now();
+    REQUIRE(ncollect == 2);
+    REQUIRE(cache.size() == 2);
+  }
+
   cache.clear();
   p1 = nullptr;
   p2 = nullptr;
@@ -337,3 +380,74 @@ TEST_CASE("Periodic collectable cache with nothing to collect", "[cache]")
   shared_A_t::destruct_and_deallocate(a2);
   shared_A_t::destruct_and_deallocate(a1);
 }
+
+TEST_CASE("Collection trigger", "[cache]")
+{
+  SECTION("Disabled trigger")
+  {
+    tchecker::collection_trigger_t trigger;
+    REQUIRE_FALSE(trigger.enabled());
+    for (std::size_t i = 0; i < 1000; ++i)
+      REQUIRE_FALSE(trigger.tick());
+  }
+
+  SECTION("Trigger driven by allocations")
+  {
+    tchecker::collection_trigger_t trigger{3};
+    REQUIRE(trigger.enabled());
+    REQUIRE_FALSE(trigger.tick());
+    REQUIRE_FALSE(trigger.tick());
+    REQUIRE(trigger.tick());
+    REQUIRE_FALSE(trigger.tick());
+    REQUIRE_FALSE(trigger.tick());
+    REQUIRE(trigger.tick());
+  }
+
+  SECTION("Trigger driven by time")
+  {
+    tchecker::collection_trigger_t trigger{0, std::chrono::milliseconds{1}};
+    REQUIRE(trigger.enabled());
+    std::this_thread::sleep_for(std::chrono::milliseconds{2});
+    bool fired = false;
+    for (std::size_t i = 0; i < 256 && !fired; ++i)
+      fired = trigger.tick();
+    REQUIRE(fired);
+  }
+}
+
+TEST_CASE("Concurrent cache shared between threads", "[cache]")
+{
+  std::size_t const THREADS = 4;
+  int const N = 256;
+  tchecker::sharded_pool_t<atomic_shared_A_t> pool(64, tchecker::allocation_size_t<atomic_shared_A_t>::alloc_size(),
+                                                   THREADS);
+  atomic_A_concurrent_cache_t cache(16);
+  std::vector<std::vector<atomic_A_sptr_t>> shared(THREADS);
+
+  // every thread shares the same objects, the unshared copies are released at once
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < THREADS; ++t)
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < N; ++i) {
+        atomic_A_sptr_t a = pool.construct(i, 0);
+        shared[t].push_back(cache.find_else_add(a));
+        if (shared[t].back() != a)
+          pool.destruct(a);
+      }
+    });
+  for (std::thread & thread : threads)
+    thread.join();
+
+  REQUIRE(cache.size() == N);
+  for (std::size_t t = 1; t < THREADS; ++t)
+    for (int i = 0; i < N; ++i)
+      REQUIRE(shared[t][i] == shared[0][i]);
+
+  // objects that are only referenced by the cache are collected
+  for (std::size_t t = 1; t < THREADS; ++t)
+    shared[t].clear();
+  REQUIRE(cache.collect() == 0);
+  shared[0].clear();
+  REQUIRE(cache.collect() == N);
+  REQUIRE(cache.size() == 0);
+}
@@ -0,0 +1,59 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/zg/cold_state.hh"
+#include "tchecker/zg/zone.hh"
+
+TEST_CASE("Cold states", "[cold_state]")
+{
+  tchecker::clock_id_t const dim = 4;
+  tchecker::zg::zone_t * zone = tchecker::zg::zone_allocate_and_construct(dim, dim);
+  tchecker::zg::zone_t * decoded_zone = tchecker::zg::zone_allocate_and_construct(dim, dim);
+  tchecker::intval_t * intval = tchecker::intval_allocate_and_construct(3, 3, 0);
+  tchecker::intval_t * decoded_intval = tchecker::intval_allocate_and_construct(3, 3, 0);
+
+  tchecker::dbm::universal_positive(zone->dbm(), dim);
+  tchecker::dbm::constrain(zone->dbm(), dim, 1, 0, tchecker::LE, 5);
+  tchecker::dbm::constrain(zone->dbm(), dim, 0, 2, tchecker::LT, -3);
+  tchecker::dbm::constrain(zone->dbm(), dim, 3, 1, tchecker::LE, 1);
+  (*intval)[0] = -7;
+  (*intval)[1] = 1000;
+
+  SECTION("Decompression")
+  {
+    tchecker::zg::cold_state_t cold{*zone, *intval};
+    cold.to_zone(*decoded_zone);
+    cold.to_intval(*decoded_intval);
+    REQUIRE(*decoded_zone == *zone);
+    REQUIRE((*decoded_intval)[0] == -7);
+    REQUIRE((*decoded_intval)[1] == 1000);
+    REQUIRE((*decoded_intval)[2] == 0);
+  }
+
+  SECTION("Empty zone")
+  {
+    tchecker::dbm::empty(zone->dbm(), dim);
+    tchecker::zg::cold_state_t cold{*zone, *intval};
+    cold.to_zone(*decoded_zone);
+    REQUIRE(decoded_zone->is_empty());
+  }
+
+  SECTION("Equality")
+  {
+    tchecker::zg::cold_state_t cold1{*zone, *intval};
+    tchecker::zg::cold_state_t cold2{*zone, *intval};
+    REQUIRE(cold1 == cold2);
+    REQUIRE(cold1.hash() == cold2.hash());
+    (*intval)[2] = 1;
+    tchecker::zg::cold_state_t cold3{*zone, *intval};
+    REQUIRE(cold1 != cold3);
+  }
+
+  tchecker::intval_destruct_and_deallocate(decoded_intval);
+  tchecker::intval_destruct_and_deallocate(intval);
+  tchecker::zg::zone_destruct_and_deallocate(decoded_zone);
+  tchecker::zg::zone_destruct_and_deallocate(zone);
+}
@@ -2,7 +2,10 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <vector>
+
 #include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/federation.hh"
 
 #define DBM(i, j)  dbm[(i)*dim + (j)]
 #define DBM1(i, j) dbm1[(i)*dim + (j)]
@@ -1968,6 +1971,48 @@ TEST_CASE("Zone inclusion w.r.t. abstraction aLU from LICS12", "[dbm]")
   }
 }
 
+TEST_CASE("Lower-bound row rejection of aLU inclusion", "[dbm]")
+{
+  tchecker::clock_id_t const dim = 3;
+  tchecker::clock_id_t const x = 1;
+
+  tchecker::integer_t u[dim - 1] = {4, 4};
+  tchecker::integer_t l[dim - 1] = {4, 4};
+
+  tchecker::dbm::db_t dbm[dim * dim];
+  tchecker::dbm::universal_positive(dbm, dim);
+
+  // 2 <= x
+  tchecker::dbm::db_t dbm2[dim * dim];
+  tchecker::dbm::universal_positive(dbm2, dim);
+  DBM2(0, x) = tchecker::dbm::db(tchecker::LE, -2);
+  tchecker::dbm::tighten(dbm2, dim);
+
+  tchecker::dbm::db_t row[dim], row2[dim];
+  tchecker::dbm::alu_lower_row(dbm, dim, u, row);
+  tchecker::dbm::alu_lower_row(dbm2, dim, u, row2);
+
+  SECTION("rejects non-included zones")
+  {
+    REQUIRE_FALSE(tchecker::dbm::is_alu_le(dbm, dbm2, dim, l, u));
+    REQUIRE_FALSE(tchecker::dbm::is_lower_row_le(row, dbm2, dim));
+  }
+
+  SECTION("does not reject included zones")
+  {
+    REQUIRE(tchecker::dbm::is_alu_le(dbm2, dbm, dim, l, u));
+    REQUIRE(tchecker::dbm::is_lower_row_le(row2, dbm, dim));
+    REQUIRE(tchecker::dbm::is_lower_row_le(row2, dbm2, dim));
+  }
+
+  SECTION("ignores clocks beyond their upper bound")
+  {
+    tchecker::integer_t u_inf[dim - 1] = {-tchecker::dbm::INF_VALUE, -tchecker::dbm::INF_VALUE};
+    tchecker::dbm::alu_lower_row(dbm, dim, u_inf, row);
+    REQUIRE(tchecker::dbm::is_lower_row_le(row, dbm2, dim));
+  }
+}
+
 TEST_CASE("scale_up, structural tests", "[dbm]")
 {
   tchecker::clock_id_t const dim = 3;
@@ -2683,3 +2728,264 @@ TEST_CASE("Clock position", "[dbm]")
     REQUIRE(tchecker::dbm::clock_position(dbm, dim, x4, x4) == tchecker::dbm::CLK_SYNCHRONIZED);
   }
 }
+
+TEST_CASE("reduce and expand", "[dbm]")
+{
+  tchecker::clock_id_t const dim = 4;
+  tchecker::clock_id_t const x1 = 1, x2 = 2, x3 = 3;
+  tchecker::dbm::db_t dbm[dim * dim];
+  tchecker::dbm::db_t expanded[dim * dim];
+  std::vector<tchecker::dbm::reduced_bound_t> bounds;
+
+  SECTION("universal positive zone")
+  {
+    tchecker::dbm::universal_positive(dbm, dim);
+    tchecker::dbm::reduce(dbm, dim, bounds);
+    REQUIRE(bounds.size() == dim - 1);
+    tchecker::dbm::expand(expanded, dim, bounds.data(), bounds.size());
+    REQUIRE(tchecker::dbm::is_equal(dbm, expanded, dim));
+  }
+
+  SECTION("zone with equal clocks")
+  {
+    // x1 = x2 = x3 and 1 <= x1 < 3
+    tchecker::dbm::universal_positive(dbm, dim);
+    tchecker::dbm::constrain(dbm, dim, x1, x2, tchecker::LE, 0);
+    tchecker::dbm::constrain(dbm, dim, x2, x1, tchecker::LE, 0);
+    tchecker::dbm::constrain(dbm, dim, x2, x3, tchecker::LE, 0);
+    tchecker::dbm::constrain(dbm, dim, x3, x2, tchecker::LE, 0);
+    tchecker::dbm::constrain(dbm, dim, 0, x1, tchecker::LE, -1);
+    tchecker::dbm::constrain(dbm, dim, x1, 0, tchecker::LT, 3);
+
+    tchecker::dbm::reduce(dbm, dim, bounds);
+    // cycle x1 -> x2 -> x3 -> x1, and bounds between 0 and x1
+    REQUIRE(bounds.size() == 5);
+    tchecker::dbm::expand(expanded, dim, bounds.data(), bounds.size());
+    REQUIRE(tchecker::dbm::is_equal(dbm, expanded, dim));
+  }
+
+  SECTION("empty zone")
+  {
+    tchecker::dbm::empty(dbm, dim);
+    tchecker::dbm::reduce(dbm, dim, bounds);
+    REQUIRE(bounds.size() == 1);
+    tchecker::dbm::expand(expanded, dim, bounds.data(), bounds.size());
+    REQUIRE(tchecker::dbm::is_empty_0(expanded, dim));
+  }
+}
+
+TEST_CASE("permute", "[dbm]")
+{
+  tchecker::clock_id_t const dim = 3;
+  tchecker::clock_id_t const x1 = 1;
+  tchecker::clock_id_t const x2 = 2;
+
+  tchecker::dbm::db_t dbm[dim * dim];
+  tchecker::dbm::db_t permuted[dim * dim];
+  tchecker::dbm::db_t expected[dim * dim];
+
+  // 1 <= x1 <= 2 and x2 < 5
+  tchecker::dbm::universal_positive(dbm, dim);
+  tchecker::dbm::constrain(dbm, dim, 0, x1, tchecker::LE, -1);
+  tchecker::dbm::constrain(dbm, dim, x1, 0, tchecker::LE, 2);
+  tchecker::dbm::constrain(dbm, dim, x2, 0, tchecker::LT, 5);
+
+  SECTION("identity")
+  {
+    tchecker::clock_id_t const perm[dim] = {0, 1, 2};
+    tchecker::dbm::permute(permuted, dbm, dim, perm);
+    REQUIRE(tchecker::dbm::is_equal(permuted, dbm, dim));
+  }
+
+  SECTION("swap x1 and x2")
+  {
+    tchecker::clock_id_t const perm[dim] = {0, 2, 1};
+    tchecker::dbm::permute(permuted, dbm, dim, perm);
+
+    // 1 <= x2 <= 2 and x1 < 5
+    tchecker::dbm::universal_positive(expected, dim);
+    tchecker::dbm::constrain(expected, dim, 0, x2, tchecker::LE, -1);
+    tchecker::dbm::constrain(expected, dim, x2, 0, tchecker::LE, 2);
+    tchecker::dbm::constrain(expected, dim, x1, 0, tchecker::LT, 5);
+
+    REQUIRE(tchecker::dbm::is_tight(permuted, dim));
+    REQUIRE(tchecker::dbm::is_equal(permuted, expected, dim));
+  }
+}
+
+TEST_CASE("compact and uncompact", "[dbm]")
+{
+  tchecker::clock_id_t const dim = 4;
+  tchecker::clock_id_t const x1 = 1, x2 = 2, x3 = 3;
+  tchecker::clock_id_t const clocks[2] = {0, x2};
+  tchecker::clock_id_t const cdim = 2;
+
+  tchecker::dbm::db_t dbm[dim * dim];
+  tchecker::dbm::db_t cdbm[cdim * cdim];
+  tchecker::dbm::db_t uncompacted[dim * dim];
+
+  // x1 = x2 + 1, x2 < 3 and x3 <= x2, then x1 and x3 are freed
+  tchecker::dbm::universal_positive(dbm, dim);
+  tchecker::dbm::constrain(dbm, dim, x1, x2, tchecker::LE, 1);
+  tchecker::dbm::constrain(dbm, dim, x2, x1, tchecker::LE, -1);
+  tchecker::dbm::constrain(dbm, dim, x2, 0, tchecker::LT, 3);
+  tchecker::dbm::constrain(dbm, dim, x3, x2, tchecker::LE, 0);
+  tchecker::dbm::free_clock(dbm, dim, x1);
+  tchecker::dbm::free_clock(dbm, dim, x3);
+
+  tchecker::dbm::compact(cdbm, dbm, dim, clocks, cdim);
+  REQUIRE(cdbm[0 * cdim + 1] == tchecker::dbm::LE_ZERO);
+  REQUIRE(cdbm[1 * cdim + 0] == tchecker::dbm::db(tchecker::LT, 3));
+
+  tchecker::dbm::uncompact(uncompacted, dim, cdbm, clocks, cdim);
+  REQUIRE(tchecker::dbm::is_tight(uncompacted, dim));
+  REQUIRE(tchecker::dbm::is_equal(dbm, uncompacted, dim));
+}
+
+TEST_CASE("convex union", "[dbm]")
+{
+  tchecker::clock_id_t const dim = 3;
+  tchecker::clock_id_t const x1 = 1, x2 = 2;
+
+  tchecker::dbm::db_t dbm1[dim * dim];
+  tchecker::dbm::db_t dbm2[dim * dim];
+  tchecker::dbm::db_t hull[dim * dim];
+
+  // 0 <= x1 <= 2 and x1 == x2
+  tchecker::dbm::zero(dbm1, dim);
+  tchecker::dbm::open_up(dbm1, dim);
+  tchecker::dbm::constrain(dbm1, dim, x1, 0, tchecker::LE, 2);
+
+  SECTION("adjacent zones")
+  {
+    // 2 <= x1 <= 5 and x1 == x2
+    tchecker::dbm::zero(dbm2, dim);
+    tchecker::dbm::open_up(dbm2, dim);
+    tchecker::dbm::constrain(dbm2, dim, 0, x1, tchecker::LE, -2);
+    tchecker::dbm::constrain(dbm2, dim, x1, 0, tchecker::LE, 5);
+
+    REQUIRE(tchecker::dbm::is_union_convex(dbm1, dbm2, dim));
+    REQUIRE(tchecker::dbm::is_union_convex(dbm2, dbm1, dim));
+
+    tchecker::dbm::convex_hull(hull, dbm1, dbm2, dim);
+    REQUIRE(tchecker::dbm::is_tight(hull, dim));
+    REQUIRE(hull[x1 * dim + 0] == tchecker::dbm::db(tchecker::LE, 5));
+    REQUIRE(hull[0 * dim + x1] == tchecker::dbm::LE_ZERO);
+  }
+
+  SECTION("zones separated by a gap")
+  {
+    // 3 < x1 <= 5 and x1 == x2
+    tchecker::dbm::zero(dbm2, dim);
+    tchecker::dbm::open_up(dbm2, dim);
+    tchecker::dbm::constrain(dbm2, dim, 0, x1, tchecker::LT, -3);
+    tchecker::dbm::constrain(dbm2, dim, x1, 0, tchecker::LE, 5);
+
+    REQUIRE_FALSE(tchecker::dbm::is_union_convex(dbm1, dbm2, dim));
+    REQUIRE_FALSE(tchecker::dbm::is_union_convex(dbm2, dbm1, dim));
+  }
+
+  SECTION("zones with distinct diagonals")
+  {
+    // 0 <= x1 <= 2 and x2 == x1 + 1
+    tchecker::dbm::universal_positive(dbm2, dim);
+    tchecker::dbm::constrain(dbm2, dim, x1, 0, tchecker::LE, 2);
+    tchecker::dbm::constrain(dbm2, dim, x2, x1, tchecker::LE, 1);
+    tchecker::dbm::constrain(dbm2, dim, x1, x2, tchecker::LE, -1);
+
+    REQUIRE_FALSE(tchecker::dbm::is_union_convex(dbm1, dbm2, dim));
+  }
+
+  SECTION("included zones")
+  {
+    tchecker::dbm::universal_positive(dbm2, dim);
+    REQUIRE(tchecker::dbm::is_union_convex(dbm1, dbm2, dim));
+    REQUIRE(tchecker::dbm::is_union_convex(dbm2, dbm1, dim));
+  }
+}
+
+TEST_CASE("difference of zones and federations", "[dbm]")
+{
+  tchecker::clock_id_t const dim = 3;
+  tchecker::clock_id_t const x1 = 1, x2 = 2;
+
+  tchecker::dbm::db_t dbm1[dim * dim];
+  tchecker::dbm::db_t dbm2[dim * dim];
+  tchecker::dbm::db_t dbm3[dim * dim];
+
+  // 0 <= x1 <= 5 and 0 <= x2 <= 5
+  tchecker::dbm::universal_positive(dbm1, dim);
+  tchecker::dbm::constrain(dbm1, dim, x1, 0, tchecker::LE, 5);
+  tchecker::dbm::constrain(dbm1, dim, x2, 0, tchecker::LE, 5);
+
+  // 0 <= x1 <= 2 and 0 <= x2 <= 5
+  tchecker::dbm::universal_positive(dbm2, dim);
+  tchecker::dbm::constrain(dbm2, dim, x1, 0, tchecker::LE, 2);
+  tchecker::dbm::constrain(dbm2, dim, x2, 0, tchecker::LE, 5);
+
+  // 2 < x1 <= 5 and 0 <= x2 <= 5
+  tchecker::dbm::universal_positive(dbm3, dim);
+  tchecker::dbm::constrain(dbm3, dim, 0, x1, tchecker::LT, -2);
+  tchecker::dbm::constrain(dbm3, dim, x1, 0, tchecker::LE, 5);
+  tchecker::dbm::constrain(dbm3, dim, x2, 0, tchecker::LE, 5);
+
+  SECTION("difference")
+  {
+    std::vector<tchecker::dbm::db_t> pieces;
+    REQUIRE(tchecker::dbm::subtract(dbm2, dbm1, dim, pieces) == 0);
+    REQUIRE(pieces.empty());
+
+    REQUIRE(tchecker::dbm::subtract(dbm1, dbm2, dim, pieces) == 1);
+    REQUIRE(tchecker::dbm::is_equal(pieces.data(), dbm3, dim));
+  }
+
+  SECTION("federation")
+  {
+    tchecker::dbm::federation_t federation{dim};
+    REQUIRE(federation.empty());
+    REQUIRE_FALSE(federation.contains(dbm2));
+
+    // distinct diagonals: the union of dbm2 and x1 == x2 is not convex
+    tchecker::dbm::db_t diagonal[dim * dim];
+    tchecker::dbm::zero(diagonal, dim);
+    tchecker::dbm::open_up(diagonal, dim);
+    tchecker::dbm::constrain(diagonal, dim, x1, 0, tchecker::LE, 5);
+
+    REQUIRE(federation.add(dbm2));
+    REQUIRE(federation.add(diagonal));
+    REQUIRE(federation.size() == 2);
+    REQUIRE_FALSE(federation.contains(dbm1));
+
+    std::vector<tchecker::dbm::db_t> pieces;
+    REQUIRE(federation.subtract(dbm1, pieces) > 0);
+
+    // dbm3 and dbm2 are adjacent: they are merged into dbm1, which includes the diagonal
+    REQUIRE(federation.add(dbm3));
+    REQUIRE(federation.size() == 1);
+    REQUIRE(tchecker::dbm::is_equal(federation.dbm(0), dbm1, dim));
+    REQUIRE(federation.contains(diagonal));
+    REQUIRE_FALSE(federation.add(dbm2));
+  }
+
+  SECTION("inclusion in a union that no DBM includes")
+  {
+    // x1 <= 2 or x1 >= 2 (not merged: the DBMs also bound x2 differently)
+    tchecker::dbm::db_t low[dim * dim];
+    tchecker::dbm::db_t high[dim * dim];
+    tchecker::dbm::universal_positive(low, dim);
+    tchecker::dbm::constrain(low, dim, x1, 0, tchecker::LE, 2);
+    tchecker::dbm::constrain(low, dim, x2, 0, tchecker::LE, 6);
+    tchecker::dbm::universal_positive(high, dim);
+    tchecker::dbm::constrain(high, dim, 0, x1, tchecker::LE, -2);
+    tchecker::dbm::constrain(high, dim, x1, 0, tchecker::LE, 5);
+    tchecker::dbm::constrain(high, dim, x2, 0, tchecker::LE, 5);
+
+    tchecker::dbm::federation_t federation{dim};
+    REQUIRE(federation.add(low));
+    REQUIRE(federation.add(high));
+    REQUIRE(federation.size() == 2);
+    REQUIRE_FALSE(tchecker::dbm::is_le(dbm1, low, dim));
+    REQUIRE_FALSE(tchecker::dbm::is_le(dbm1, high, dim));
+    REQUIRE(federation.contains(dbm1));
+  }
+}
@@ -0,0 +1,127 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/parsing/declaration_filter.hh"
+
+#include "utils.hh"
+
+namespace {
+
+/*!
+ \class process_filter_t
+ \brief Copy of the declarations of all the processes but one, with renamed event a
+ */
+class process_filter_t : public tchecker::parsing::declaration_filter_t {
+public:
+  process_filter_t(tchecker::parsing::system_declaration_t & copy, std::string const & removed)
+      : tchecker::parsing::declaration_filter_t(copy), _removed(removed), _renamed("_a")
+  {
+  }
+
+protected:
+  using tchecker::parsing::declaration_filter_t::keep;
+
+  virtual bool keep(tchecker::parsing::process_declaration_t const & d) { return d.name() != _removed; }
+
+  virtual bool keep(tchecker::parsing::location_declaration_t const & d) { return d.process().name() != _removed; }
+
+  virtual bool keep(tchecker::parsing::edge_declaration_t const & d, tchecker::edge_id_t id)
+  {
+    return d.process().name() != _removed;
+  }
+
+  virtual bool keep(tchecker::parsing::sync_constraint_t const & c) { return c.process().name() != _removed; }
+
+  virtual std::string const & event_name(std::string const & name) const { return (name == "a" ? _renamed : name); }
+
+private:
+  std::string const _removed; /*!< Removed process */
+  std::string const _renamed; /*!< New name of event a */
+};
+
+} // end of anonymous namespace
+
+TEST_CASE("filtered copies rebuild declarations on the copy", "[declaration_filter]")
+{
+  std::string model = "system:filter \n\
+  event:a \n\
+  event:b \n\
+  clock:1:x \n\
+  int:1:0:1:0:i \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial:} \n\
+  edge:P:l0:l0:a{do: x=0} \n\
+  \n\
+  process:Q \n\
+  location:Q:l0{initial:} \n\
+  edge:Q:l0:l0:a \n\
+  edge:Q:l0:l0:b \n\
+  \n\
+  process:R \n\
+  location:R:l0{initial:} \n\
+  edge:R:l0:l0:a \n\
+  \n\
+  sync:P@a:Q@a \n\
+  sync:P@a:Q@a:R@a \n\
+  sync:Q@b\n";
+
+  tchecker::parsing::system_declaration_t const * sysdecl = tchecker::test::parse(model);
+  REQUIRE(sysdecl != nullptr);
+
+  SECTION("everything is kept by default")
+  {
+    tchecker::parsing::system_declaration_t copy{"filter", tchecker::parsing::attributes_t{}, ""};
+    tchecker::parsing::declaration_filter_t filter{copy};
+    sysdecl->visit(filter);
+
+    std::stringstream expected, output;
+    expected << *sysdecl;
+    output << copy;
+    REQUIRE(output.str() == expected.str());
+  }
+
+  SECTION("synchronizations keep at least two of their constraints")
+  {
+    tchecker::parsing::system_declaration_t copy{"filter", tchecker::parsing::attributes_t{}, ""};
+    process_filter_t filter{copy, "Q"};
+    sysdecl->visit(filter);
+
+    REQUIRE(copy.get_process_declaration("Q") == nullptr);
+    REQUIRE(copy.get_location_declaration("Q", "l0") == nullptr);
+    REQUIRE(copy.get_event_declaration("_a") != nullptr);
+    REQUIRE(copy.get_event_declaration("a") == nullptr);
+
+    std::size_t edges = 0, syncs = 0;
+    for (tchecker::parsing::inner_declaration_t const * d : copy.declarations()) {
+      if (auto const * e = dynamic_cast<tchecker::parsing::edge_declaration_t const *>(d)) {
+        ++edges;
+        REQUIRE(&e->process() == copy.get_process_declaration(e->process().name()));
+        REQUIRE(&e->event() == copy.get_event_declaration("_a"));
+      }
+      else if (auto const * s = dynamic_cast<tchecker::parsing::sync_declaration_t const *>(d)) {
+        ++syncs;
+        REQUIRE(std::distance(s->sync_constraints().begin(), s->sync_constraints().end()) == 2);
+      }
+    }
+    REQUIRE(edges == 2);
+    REQUIRE(syncs == 1); // P@a:R@a
+  }
+
+  SECTION("kept declarations must not clash with the copy")
+  {
+    tchecker::parsing::system_declaration_t copy{"filter", tchecker::parsing::attributes_t{}, ""};
+    tchecker::parsing::declaration_filter_t filter{copy};
+    sysdecl->visit(filter);
+    tchecker::parsing::declaration_filter_t again{copy};
+    REQUIRE_THROWS_AS(sysdecl->visit(again), std::runtime_error);
+  }
+
+  delete sysdecl;
+}
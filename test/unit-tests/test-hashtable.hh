@@ -2,11 +2,19 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
+#include "tchecker/graph/find_graph.hh"
 #include "tchecker/utils/hashtable.hh"
+#include "tchecker/utils/pool.hh"
 #include "tchecker/utils/shared_objects.hh"
+#include "tchecker/utils/sizing.hh"
 
 // Object for testing collision table
 class cto_t : public tchecker::collision_table_object_t {
@@ -38,6 +46,10 @@ using shared_cto_t = tchecker::make_shared_t<cto_t>;
 
 using cto_sptr_t = tchecker::intrusive_shared_ptr_t<shared_cto_t>;
 
+using atomic_shared_cto_t = tchecker::make_shared_t<cto_t, std::atomic<std::size_t>>;
+
+using atomic_cto_sptr_t = tchecker::intrusive_shared_ptr_t<atomic_shared_cto_t>;
+
 class cto_sptr_hash_t {
 public:
   std::size_t operator()(cto_sptr_t const & p) const { return hash(*p); }
@@ -609,6 +621,71 @@ public:
   bool operator()(hto_sptr_t const & p1, hto_sptr_t const & p2) const { return (*p1 == *p2); }
 };
 
+class hto_sptr_discrete_hash_t : public hto_sptr_hash_t {
+public:
+  std::size_t discrete(hto_sptr_t const & p) const { return static_cast<std::size_t>(p->x() / 100); }
+};
+
+TEST_CASE("Two-level graph", "[hashtable]")
+{
+  hto_sptr_discrete_hash_t hash;
+  hto_sptr_equal_t equal;
+  tchecker::graph::find::two_level_graph_t<hto_sptr_t, hto_sptr_discrete_hash_t, hto_sptr_equal_t> g(16, hash, equal);
+
+  // objects 0..19 have the same discrete part, hence their bucket gets indexed, object 100 is alone in its bucket
+  std::vector<hto_sptr_t> v;
+  for (int x = 0; x < 20; ++x)
+    v.emplace_back(shared_hto_t::allocate_and_construct(x));
+  v.emplace_back(shared_hto_t::allocate_and_construct(100));
+  hto_sptr_t o1b{shared_hto_t::allocate_and_construct(1)};
+
+  for (hto_sptr_t const & o : v)
+    REQUIRE(g.add_node(o));
+  REQUIRE(g.size() == v.size());
+  REQUIRE(g.longest_probe() == 20);
+
+  SECTION("Equal nodes are found")
+  {
+    REQUIRE_FALSE(g.add_node(o1b));
+    auto && [found, p] = g.find(o1b);
+    REQUIRE(found);
+    REQUIRE(p == v[1]);
+    REQUIRE(g.size() == v.size());
+  }
+
+  SECTION("Iteration on nodes")
+  {
+    std::size_t count = 0;
+    for (hto_sptr_t const & o : g) {
+      REQUIRE(std::find(v.begin(), v.end(), o) != v.end());
+      ++count;
+    }
+    REQUIRE(count == v.size());
+  }
+
+  SECTION("Removed nodes are not found")
+  {
+    g.remove_node(v[1]);
+    g.remove_node(v[20]);
+    REQUIRE(g.size() == v.size() - 2);
+    REQUIRE_FALSE(std::get<0>(g.find(o1b)));
+    REQUIRE_FALSE(std::get<0>(g.find(v[20])));
+    REQUIRE(std::get<0>(g.find(v[2])));
+    REQUIRE_THROWS_AS(g.remove_node(v[20]), std::invalid_argument);
+  }
+
+  g.clear();
+  std::vector<shared_hto_t *> pointers;
+  for (hto_sptr_t & o : v) {
+    pointers.push_back(o.ptr());
+    o = nullptr;
+  }
+  pointers.push_back(o1b.ptr());
+  o1b = nullptr;
+  for (shared_hto_t * p : pointers)
+    shared_hto_t::destruct_and_deallocate(p);
+}
+
 TEST_CASE("Empty hashtable", "[hashtable]")
 {
   tchecker::hashtable_t<hto_sptr_t, hto_sptr_hash_t, hto_sptr_equal_t> t(1024, hto_sptr_hash_t{}, hto_sptr_equal_t{});
@@ -699,3 +776,245 @@ TEST_CASE("Non-empty hashtable", "[hashtable]")
   shared_hto_t::destruct_and_deallocate(p1b);
   shared_hto_t::destruct_and_deallocate(p2);
 }
+
+TEST_CASE("Batched insertion in hashtable", "[hashtable]")
+{
+  hto_sptr_hash_t hash;
+  hto_sptr_equal_t equal;
+  tchecker::hashtable_t<hto_sptr_t, hto_sptr_hash_t, hto_sptr_equal_t> t(16, hash, equal);
+
+  // a batch of 40 objects with 20 distinct values, larger than the table, some of them already in the table
+  std::vector<hto_sptr_t> inserted, batch;
+  std::vector<std::size_t> hashes;
+  for (int x = 0; x < 5; ++x) {
+    inserted.emplace_back(shared_hto_t::allocate_and_construct(x));
+    t.add(inserted.back());
+  }
+  for (int x = 0; x < 40; ++x) {
+    batch.emplace_back(shared_hto_t::allocate_and_construct(x % 20));
+    hashes.push_back(hash(batch.back()));
+  }
+  std::vector<hto_sptr_t> objects = batch;
+
+  t.find_else_add(objects, hashes);
+
+  REQUIRE(t.size() == 20);
+  for (std::size_t i = 0; i < objects.size(); ++i) {
+    REQUIRE(objects[i]->x() == static_cast<int>(i % 20));
+    if (i < 5)
+      REQUIRE(objects[i] == inserted[i]);
+    else if (i < 20)
+      REQUIRE(objects[i] == batch[i]);
+    else
+      REQUIRE(objects[i] == objects[i - 20]);
+  }
+
+  std::vector<std::size_t> wrong_hashes(3, 0);
+  REQUIRE_THROWS_AS(t.find_else_add(objects, wrong_hashes), std::invalid_argument);
+
+  t.clear();
+  objects.clear();
+  std::vector<shared_hto_t *> pointers;
+  for (hto_sptr_t & o : inserted) {
+    pointers.push_back(o.ptr());
+    o = nullptr;
+  }
+  for (hto_sptr_t & o : batch) {
+    pointers.push_back(o.ptr());
+    o = nullptr;
+  }
+  for (shared_hto_t * p : pointers)
+    shared_hto_t::destruct_and_deallocate(p);
+}
+
+TEST_CASE("Hashtable growth and removal", "[hashtable]")
+{
+  hto_sptr_hash_t hash;
+  hto_sptr_equal_t equal;
+  tchecker::hashtable_t<hto_sptr_t, hto_sptr_hash_t, hto_sptr_equal_t> t(16, hash, equal);
+
+  std::size_t const N = 1000;
+  std::vector<hto_sptr_t> o;
+  for (std::size_t i = 0; i < N; ++i)
+    o.push_back(hto_sptr_t{shared_hto_t::allocate_and_construct(static_cast<int>(i))});
+
+  for (std::size_t i = 0; i < N; ++i)
+    REQUIRE(t.add(o[i]));
+  REQUIRE(t.size() == N);
+  REQUIRE(t.capacity() >= N);
+
+  SECTION("All objects are found after growing")
+  {
+    for (std::size_t i = 0; i < N; ++i) {
+      auto && [found, p] = t.find(o[i]);
+      REQUIRE(found);
+      REQUIRE(p == o[i]);
+    }
+  }
+
+  SECTION("Removing while iterating visits every object once")
+  {
+    std::vector<int> visited(N, 0);
+    auto it = t.begin();
+    while (it != t.end()) {
+      ++visited[(*it)->x()];
+      if ((*it)->x() % 2 == 0)
+        it = t.remove(it);
+      else
+        ++it;
+    }
+    REQUIRE(t.size() == N / 2);
+    for (std::size_t i = 0; i < N; ++i) {
+      REQUIRE(visited[i] == 1);
+      REQUIRE(std::get<0>(t.find(o[i])) == (i % 2 == 1));
+    }
+  }
+
+  t.clear();
+  for (std::size_t i = 0; i < N; ++i) {
+    shared_hto_t * p = o[i].ptr();
+    o[i] = nullptr;
+    shared_hto_t::destruct_and_deallocate(p);
+  }
+}
+
+TEST_CASE("Concurrent hashtable", "[hashtable]")
+{
+  hto_sptr_hash_t hash;
+  hto_sptr_equal_t equal;
+  tchecker::concurrent_hashtable_t<hto_sptr_t, hto_sptr_hash_t, hto_sptr_equal_t> t(64, hash, equal, 4);
+
+  hto_sptr_t o1{shared_hto_t::allocate_and_construct(1)};
+  hto_sptr_t o1b{shared_hto_t::allocate_and_construct(1)};
+  hto_sptr_t o2{shared_hto_t::allocate_and_construct(14)};
+
+  REQUIRE(t.find_else_add(o1) == o1);
+  REQUIRE(t.find_else_add(o1b) == o1);
+  REQUIRE(t.add(o2));
+  REQUIRE(t.size() == 2);
+  t.remove(o1b);
+  REQUIRE_FALSE(std::get<0>(t.find(o1)));
+  REQUIRE(t.size() == 1);
+
+  t.clear();
+  shared_hto_t *p1 = o1.ptr(), *p1b = o1b.ptr(), *p2 = o2.ptr();
+  o1 = nullptr;
+  o1b = nullptr;
+  o2 = nullptr;
+  shared_hto_t::destruct_and_deallocate(p1);
+  shared_hto_t::destruct_and_deallocate(p1b);
+  shared_hto_t::destruct_and_deallocate(p2);
+}
+
+TEST_CASE("Collision table with adaptive size", "[hashtable]")
+{
+  tchecker::set_adaptive_sizes(true);
+  cto_sptr_hash_t hash;
+  tchecker::collision_table_t<cto_sptr_t, cto_sptr_hash_t> t(4, hash);
+  tchecker::set_adaptive_sizes(false);
+
+  std::size_t const N = 64;
+  cto_sptr_t o[N];
+  for (std::size_t i = 0; i < N; ++i) {
+    o[i] = shared_cto_t::allocate_and_construct(static_cast<int>(i % 32), static_cast<int>(i));
+    t.add(o[i]);
+  }
+
+  REQUIRE(t.size() == N);
+  REQUIRE(t.table_size() > 4);
+  REQUIRE(t.load_factor() <= 2.0);
+  REQUIRE(t.longest_collision_list() == 2);
+
+  for (std::size_t i = 0; i < N; ++i) {
+    std::size_t count = 0;
+    for (cto_sptr_t const & p : t.collision_range(o[i])) {
+      REQUIRE(hash(p) == hash(o[i]));
+      ++count;
+    }
+    REQUIRE(count == 2);
+  }
+
+  for (std::size_t i = 0; i < N; i += 2)
+    t.remove(o[i]);
+  REQUIRE(t.size() == N / 2);
+
+  t.clear();
+  for (std::size_t i = 0; i < N; ++i) {
+    shared_cto_t * p = o[i].ptr();
+    o[i] = nullptr;
+    shared_cto_t::destruct_and_deallocate(p);
+  }
+}
+
+TEST_CASE("Pool with adaptive block size", "[pool]")
+{
+  tchecker::set_adaptive_sizes(true);
+  tchecker::pool_t<shared_cto_t> pool(2, tchecker::allocation_size_t<shared_cto_t>::alloc_size());
+  tchecker::set_adaptive_sizes(false);
+
+  std::vector<cto_sptr_t> v;
+  for (int i = 0; i < 30; ++i)
+    v.push_back(pool.construct(i, i));
+
+  // blocks of 2, 4, 8 and 16 chunks
+  REQUIRE(pool.adaptive());
+  REQUIRE(pool.blocks_count() == 4);
+  REQUIRE(pool.chunks_count() == 30);
+  REQUIRE(pool.alloc_nb() == 32);
+  for (int i = 0; i < 30; ++i)
+    REQUIRE(v[i]->x() == i);
+
+  v.clear();
+  REQUIRE(pool.collect() == 30);
+}
+
+TEST_CASE("Sharded pool shared between threads", "[pool]")
+{
+  std::size_t const THREADS = 4;
+  int const N = 1000;
+  tchecker::sharded_pool_t<atomic_shared_cto_t> pool(16, tchecker::allocation_size_t<atomic_shared_cto_t>::alloc_size(),
+                                                     THREADS);
+  std::vector<std::vector<atomic_cto_sptr_t>> objects(THREADS);
+  std::atomic<std::size_t> arrived{0}, destructed{0};
+  std::size_t memsize = 0;
+
+  // threads wait for each other between phases
+  auto barrier = [&](std::size_t phase) {
+    arrived.fetch_add(1);
+    while (arrived.load() < phase * THREADS)
+      std::this_thread::yield();
+  };
+
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < THREADS; ++t)
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < N; ++i)
+        objects[t].push_back(pool.construct(static_cast<int>(t), i));
+      barrier(1);
+      // the objects of the next thread are released to the shard of that thread
+      for (atomic_cto_sptr_t & p : objects[(t + 1) % THREADS])
+        if (pool.destruct(p))
+          destructed.fetch_add(1);
+      barrier(2);
+      if (t == 0)
+        memsize = pool.memsize();
+      barrier(3);
+      // the released chunks are reused by their shard
+      for (int i = 0; i < N; ++i)
+        objects[(t + 1) % THREADS][i] = pool.construct(static_cast<int>(t), i);
+    });
+  for (std::thread & thread : threads)
+    thread.join();
+
+  REQUIRE(destructed.load() == THREADS * N);
+  REQUIRE(pool.memsize() == memsize);
+  for (std::size_t t = 0; t < THREADS; ++t)
+    for (int i = 0; i < N; ++i) {
+      REQUIRE(objects[(t + 1) % THREADS][i]->x() == static_cast<int>(t));
+      REQUIRE(objects[(t + 1) % THREADS][i]->y() == i);
+    }
+
+  for (auto & v : objects)
+    v.clear();
+  REQUIRE(pool.collect() == THREADS * N);
+}
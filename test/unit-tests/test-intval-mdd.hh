@@ -0,0 +1,91 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <stdexcept>
+#include <vector>
+
+#include "tchecker/variables/intval_mdd.hh"
+#include "tchecker/variables/intvars.hh"
+
+TEST_CASE("Decision diagrams of valuations of bounded integer variables", "[intval_mdd]")
+{
+  tchecker::integer_variables_t intvars;
+  intvars.declare("counter", 3, -2, 5, 0);
+  intvars.declare("flag", 1, 0, 1, 0);
+  tchecker::flat_integer_variables_t flat_intvars{intvars};
+  unsigned short const size = static_cast<unsigned short>(flat_intvars.size());
+
+  tchecker::intval_mdd_t mdd{flat_intvars};
+  tchecker::intval_t * intval = tchecker::intval_allocate_and_construct(size, size, 0);
+
+  SECTION("Insertion and membership")
+  {
+    tchecker::intval_mdd_t::node_id_t root = tchecker::intval_mdd_t::EMPTY;
+    REQUIRE(mdd.count(root) == 0);
+    REQUIRE_FALSE(mdd.contains(root, *intval));
+
+    root = mdd.insert(root, *intval);
+    REQUIRE(mdd.contains(root, *intval));
+    REQUIRE(mdd.count(root) == 1);
+    REQUIRE(mdd.insert(root, *intval) == root);
+
+    (*intval)[1] = -2;
+    REQUIRE_FALSE(mdd.contains(root, *intval));
+    root = mdd.insert(root, *intval);
+    REQUIRE(mdd.contains(root, *intval));
+    REQUIRE(mdd.count(root) == 2);
+
+    (*intval)[3] = 2;
+    REQUIRE_THROWS_AS(mdd.insert(root, *intval), std::out_of_range);
+  }
+
+  SECTION("Equal sets have the same root, and suffixes are shared")
+  {
+    tchecker::intval_mdd_t::node_id_t root1 = tchecker::intval_mdd_t::EMPTY;
+    tchecker::intval_mdd_t::node_id_t root2 = tchecker::intval_mdd_t::EMPTY;
+    // all values of the first counter, with the same suffix, inserted in opposite orders
+    for (tchecker::integer_t v = -2; v <= 5; ++v) {
+      (*intval)[0] = v;
+      root1 = mdd.insert(root1, *intval);
+      (*intval)[0] = 3 - v;
+      root2 = mdd.insert(root2, *intval);
+    }
+    REQUIRE(root1 == root2);
+    REQUIRE(mdd.count(root1) == 8);
+
+    mdd.collect(std::vector<tchecker::intval_mdd_t::node_id_t>{root1});
+    REQUIRE(mdd.nodes() == 2 + 4); // terminals, and one node per variable
+    REQUIRE(mdd.count(root1) == 8);
+  }
+
+  SECTION("Collection keeps the sets of the roots")
+  {
+    tchecker::intval_mdd_t::node_id_t kept = tchecker::intval_mdd_t::EMPTY;
+    tchecker::intval_mdd_t::node_id_t dropped = tchecker::intval_mdd_t::EMPTY;
+    for (tchecker::integer_t v = 0; v <= 5; ++v) {
+      (*intval)[1] = v;
+      (*intval)[2] = 0;
+      kept = mdd.insert(kept, *intval);
+      (*intval)[2] = 1;
+      dropped = mdd.insert(dropped, *intval);
+    }
+    mdd.collect(std::vector<tchecker::intval_mdd_t::node_id_t>{kept});
+    std::size_t const nodes = mdd.nodes();
+
+    (*intval)[2] = 0;
+    for (tchecker::integer_t v = 0; v <= 5; ++v) {
+      (*intval)[1] = v;
+      REQUIRE(mdd.contains(kept, *intval));
+    }
+    REQUIRE(mdd.count(kept) == 6);
+
+    // reclaimed nodes are reused by later insertions
+    (*intval)[3] = 1;
+    kept = mdd.insert(kept, *intval);
+    REQUIRE(mdd.count(kept) == 7);
+    REQUIRE(mdd.nodes() > nodes);
+  }
+
+  tchecker::intval_destruct_and_deallocate(intval);
+}
@@ -0,0 +1,102 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <stdexcept>
+
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/variables/packed_intval.hh"
+
+TEST_CASE("Packed valuations of bounded integer variables", "[packed_intval]")
+{
+  tchecker::integer_variables_t intvars;
+  intvars.declare("flags", 40, 0, 1, 0);   // 40 variables on 1 bit
+  intvars.declare("counter", 1, -5, 10, 3); // 4 bits
+  intvars.declare("constant", 1, 7, 7, 7);  // 0 bits
+  intvars.declare("big", 3, 0, 1000, 0);    // 3 variables on 10 bits
+  tchecker::flat_integer_variables_t flat_intvars{intvars};
+
+  tchecker::intval_packing_t packing{flat_intvars};
+  unsigned short const size = static_cast<unsigned short>(flat_intvars.size());
+
+  SECTION("Layout")
+  {
+    REQUIRE(packing.size() == size);
+    REQUIRE(packing.width(0) == 1);
+    REQUIRE(packing.width(40) == 4);
+    REQUIRE(packing.width(41) == 0);
+    REQUIRE(packing.width(42) == 10);
+    REQUIRE(packing.words() == 2); // 40 + 4 + 10 + 10 bits, then 10 bits in a second word
+  }
+
+  SECTION("Pack and unpack")
+  {
+    tchecker::intval_t * intval = tchecker::intval_allocate_and_construct(size, size, 0);
+    for (tchecker::intvar_id_t id = 0; id < 40; ++id)
+      (*intval)[id] = id % 3 == 0 ? 1 : 0;
+    (*intval)[40] = -5;
+    (*intval)[41] = 7;
+    (*intval)[42] = 1000;
+    (*intval)[43] = 513;
+    (*intval)[44] = 0;
+
+    tchecker::packed_intval_t * packed = tchecker::packed_intval_allocate_and_construct(packing.words());
+    packing.pack(*intval, packed->data());
+    REQUIRE(packing.get(packed->data(), 40) == -5);
+    REQUIRE(packing.get(packed->data(), 43) == 513);
+
+    tchecker::intval_t * unpacked = tchecker::intval_allocate_and_construct(size, size, 0);
+    packing.unpack(packed->data(), *unpacked);
+    for (tchecker::intvar_id_t id = 0; id < size; ++id)
+      REQUIRE((*unpacked)[id] == (*intval)[id]);
+
+    packing.set(packed->data(), 40, 10);
+    REQUIRE(packing.get(packed->data(), 40) == 10);
+    REQUIRE(packing.get(packed->data(), 39) == (*intval)[39]);
+    REQUIRE(packing.get(packed->data(), 42) == 1000);
+    REQUIRE_THROWS_AS(packing.set(packed->data(), 40, 11), std::out_of_range);
+    REQUIRE_THROWS_AS(packing.set(packed->data(), 41, 6), std::out_of_range);
+
+    tchecker::intval_destruct_and_deallocate(unpacked);
+    tchecker::packed_intval_destruct_and_deallocate(packed);
+    tchecker::intval_destruct_and_deallocate(intval);
+  }
+
+  SECTION("Equality, hash and ordering on words")
+  {
+    tchecker::intval_t * intval1 = tchecker::intval_allocate_and_construct(size, size, 0);
+    tchecker::intval_t * intval2 = tchecker::intval_allocate_and_construct(size, size, 0);
+    (*intval1)[41] = 7;
+    (*intval2)[41] = 7;
+    (*intval1)[40] = 2;
+    (*intval2)[40] = 2;
+    (*intval2)[44] = 1;
+
+    tchecker::packed_intval_t * packed1 = tchecker::packed_intval_allocate_and_construct(packing.words());
+    tchecker::packed_intval_t * packed2 = tchecker::packed_intval_allocate_and_construct(packing.words());
+    packing.pack(*intval1, packed1->data());
+    packing.pack(*intval2, packed2->data());
+
+    REQUIRE(*packed1 != *packed2);
+    REQUIRE(tchecker::lexical_cmp(*intval1, *intval2) < 0);
+    REQUIRE(tchecker::lexical_cmp(*packed1, *packed2) < 0);
+    REQUIRE(tchecker::lexical_cmp(*packed2, *packed1) > 0);
+
+    (*intval2)[44] = 0;
+    (*intval2)[0] = 1;
+    packing.pack(*intval2, packed2->data());
+    REQUIRE(tchecker::lexical_cmp(*packed1, *packed2) < 0);
+    REQUIRE(tchecker::lexical_cmp(*intval1, *intval2) < 0);
+
+    (*intval2)[0] = 0;
+    packing.pack(*intval2, packed2->data());
+    REQUIRE(*packed1 == *packed2);
+    REQUIRE(tchecker::hash_value(*packed1) == tchecker::hash_value(*packed2));
+    REQUIRE(tchecker::lexical_cmp(*packed1, *packed2) == 0);
+
+    tchecker::packed_intval_destruct_and_deallocate(packed2);
+    tchecker::packed_intval_destruct_and_deallocate(packed1);
+    tchecker::intval_destruct_and_deallocate(intval2);
+    tchecker::intval_destruct_and_deallocate(intval1);
+  }
+}
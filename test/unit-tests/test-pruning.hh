@@ -0,0 +1,79 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <memory>
+#include <string>
+
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/pruning.hh"
+#include "tchecker/ta/system.hh"
+
+#include "utils.hh"
+
+TEST_CASE("edges with unsatisfiable guards are dead", "[pruning]")
+{
+  std::string model = "system:pruning \n\
+  event:a \n\
+  event:b \n\
+  event:c \n\
+  int:1:0:3:0:id \n\
+  int:1:0:1:0:turn \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial:} \n\
+  location:P:l1 \n\
+  location:P:l2 \n\
+  edge:P:l0:l1:a{provided: id==2 && turn==1} \n\
+  edge:P:l0:l1:b{do: turn=1} \n\
+  edge:P:l1:l2:c{provided: turn==1} \n\
+  \n\
+  process:Q \n\
+  location:Q:l0{initial:} \n\
+  edge:Q:l0:l0:c{provided: id>5} \n\
+  \n\
+  sync:P@c:Q@c\n";
+
+  tchecker::parsing::system_declaration_t const * sysdecl = tchecker::test::parse(model);
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::live_edges_t const live = tchecker::ta::live_edges(tchecker::ta::system_t{*sysdecl});
+  REQUIRE_FALSE(live.edges[0]);
+  REQUIRE(live.edges[1]);
+  REQUIRE_FALSE(live.edges[2]); // synchronized with a dead edge
+  REQUIRE_FALSE(live.edges[3]);
+  REQUIRE_FALSE(live.syncs[0]);
+
+  std::shared_ptr<tchecker::parsing::system_declaration_t> const pruned = tchecker::ta::prune_dead_edges(*sysdecl);
+  tchecker::ta::system_t const system{*pruned};
+  REQUIRE(system.edges_count() == 1);
+  REQUIRE(system.synchronizations_count() == 0);
+  REQUIRE(system.locations_count() == 4);
+
+  delete sysdecl;
+}
+
+TEST_CASE("edges enabled by counters are live", "[pruning]")
+{
+  std::string model = "system:counter \n\
+  event:a \n\
+  event:b \n\
+  int:1:0:10:0:i \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial:} \n\
+  location:P:l1 \n\
+  edge:P:l0:l0:a{provided: i<7 : do: i=i+1} \n\
+  edge:P:l0:l1:b{provided: i==7} \n\
+  edge:P:l1:l0:b{provided: i>7}\n";
+
+  tchecker::parsing::system_declaration_t const * sysdecl = tchecker::test::parse(model);
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::live_edges_t const live = tchecker::ta::live_edges(tchecker::ta::system_t{*sysdecl});
+  REQUIRE(live.edges[0]);
+  REQUIRE(live.edges[1]);
+  REQUIRE_FALSE(live.edges[2]);
+
+  delete sysdecl;
+}
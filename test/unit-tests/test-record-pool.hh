@@ -0,0 +1,106 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/zg/allocators.hh"
+#include "tchecker/zg/zone_registry.hh"
+
+TEST_CASE("Records of state components", "[record_pool]")
+{
+  std::size_t const alloc_nb = 4, vloc_capacity = 2, intval_capacity = 3, zone_dimension = 3;
+  tchecker::zg::state_pool_allocator_t allocator{alloc_nb, alloc_nb, vloc_capacity, alloc_nb, intval_capacity,
+                                                 alloc_nb, zone_dimension, 16};
+  allocator.allocate_records(alloc_nb);
+
+  SECTION("Components are allocated in one record")
+  {
+    tchecker::zg::state_sptr_t s = allocator.construct();
+    char const * vloc = reinterpret_cast<char const *>(s->vloc_ptr().ptr());
+    char const * intval = reinterpret_cast<char const *>(s->intval_ptr().ptr());
+    char const * zone = reinterpret_cast<char const *>(s->zone_ptr().ptr());
+    REQUIRE(vloc < intval);
+    REQUIRE(intval < zone);
+    REQUIRE(static_cast<std::size_t>(zone - vloc) <
+            tchecker::allocation_size_t<tchecker::shared_vloc_t>::alloc_size(vloc_capacity) +
+                tchecker::allocation_size_t<tchecker::shared_intval_t>::alloc_size(intval_capacity) + 2 * sizeof(void *));
+    REQUIRE(allocator.record_memsize() > 0);
+    REQUIRE(allocator.vloc_memsize() == 0);
+    REQUIRE(allocator.intval_memsize() == 0);
+    REQUIRE(allocator.zone_memsize() == 0);
+    allocator.destruct(s);
+  }
+
+  SECTION("Clones copy the components")
+  {
+    tchecker::zg::state_sptr_t s = allocator.construct();
+    (*s->vloc_ptr())[0] = 1;
+    (*s->vloc_ptr())[1] = 0;
+    (*s->intval_ptr())[0] = 5;
+    (*s->intval_ptr())[1] = -2;
+    (*s->intval_ptr())[2] = 0;
+    tchecker::dbm::universal_positive(s->zone_ptr()->dbm(), zone_dimension);
+    tchecker::dbm::constrain(s->zone_ptr()->dbm(), zone_dimension, 1, 0, tchecker::LE, 3);
+
+    tchecker::zg::state_sptr_t c = allocator.clone(*s);
+    tchecker::zg::state_sptr_t ci = allocator.clone_sharing_intval(*s);
+    REQUIRE(c->vloc_ptr().ptr() != s->vloc_ptr().ptr());
+    REQUIRE(ci->intval_ptr().ptr() != s->intval_ptr().ptr());
+    REQUIRE(*c == *s);
+    REQUIRE(*ci == *s);
+
+    allocator.destruct(ci);
+    allocator.destruct(c);
+    allocator.destruct(s);
+  }
+
+  SECTION("Records are reused")
+  {
+    std::vector<tchecker::zg::state_sptr_t> v;
+    for (std::size_t i = 0; i < alloc_nb; ++i)
+      v.push_back(allocator.construct());
+    std::size_t const memsize = allocator.record_memsize();
+
+    REQUIRE(allocator.destruct(v.back()));
+    v.back() = allocator.construct();
+    REQUIRE(allocator.record_memsize() == memsize);
+
+    // records of states that are not referenced anymore are collected
+    v.front() = nullptr;
+    allocator.collect();
+    v.front() = allocator.construct();
+    REQUIRE(allocator.record_memsize() == memsize);
+
+    for (tchecker::zg::state_sptr_t & s : v)
+      allocator.destruct(s);
+  }
+
+  SECTION("Shared components")
+  {
+    tchecker::zg::state_sptr_t s1 = allocator.construct();
+    tchecker::dbm::universal_positive(s1->zone_ptr()->dbm(), zone_dimension);
+    tchecker::zg::state_sptr_t s2 = allocator.clone(*s1);
+    allocator.share(s1);
+    allocator.share(s2);
+    REQUIRE(s1->vloc_ptr().ptr() == s2->vloc_ptr().ptr());
+    REQUIRE(s1->intval_ptr().ptr() == s2->intval_ptr().ptr());
+    REQUIRE(s1->zone_ptr().ptr() == s2->zone_ptr().ptr());
+    allocator.destruct(s2);
+    allocator.destruct(s1);
+    allocator.collect();
+  }
+
+  SECTION("Records cannot be combined with shared zones, nor allocated after states")
+  {
+    tchecker::zg::zone_registry_t registry{alloc_nb, 16};
+    REQUIRE_THROWS_AS(allocator.share_zones(registry.store(zone_dimension)), std::runtime_error);
+
+    tchecker::zg::state_sptr_t s = allocator.construct();
+    REQUIRE_THROWS_AS(allocator.allocate_records(alloc_nb), std::runtime_error);
+    allocator.destruct(s);
+  }
+}
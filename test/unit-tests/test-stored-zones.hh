@@ -0,0 +1,463 @@
+/*
+ * See files AUTHORS and LICENSE for copyright details.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/reach/stored_zones.hh"
+#include "tchecker/clockbounds/active_clocks.hh"
+#include "tchecker/clockbounds/solver.hh"
+#include "tchecker/dbm/db.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/variables/packed_intval.hh"
+#include "tchecker/waiting/factory.hh"
+#include "tchecker/zg/cold_state.hh"
+#include "tchecker/zg/compact_zone.hh"
+#include "tchecker/zg/delta_zone.hh"
+#include "tchecker/zg/packed_zone.hh"
+#include "tchecker/zg/reduced_zone.hh"
+#include "tchecker/zg/zg.hh"
+#include "tchecker/zg/zone.hh"
+
+#include "testutils/utils.hh"
+
+namespace {
+
+/*!
+ \class full_zone_storage_t
+ \brief Storage of zones as copies of their DBMs, as a reference for the compressed formats
+ */
+class full_zone_storage_t {
+public:
+  struct stored_zone_t {
+    std::vector<tchecker::dbm::db_t> dbm;
+
+    std::size_t memory_footprint() const { return sizeof(*this) + dbm.capacity() * sizeof(tchecker::dbm::db_t); }
+  };
+
+  stored_zone_t store(tchecker::ta::state_t const & s, tchecker::zg::zone_sptr_t const & zone) const
+  {
+    return stored_zone_t{std::vector<tchecker::dbm::db_t>(zone->dbm(), zone->dbm() + zone->dim() * zone->dim())};
+  }
+
+  void restore(stored_zone_t const & stored, tchecker::zg::zone_t & zone) const
+  {
+    std::copy(stored.dbm.begin(), stored.dbm.end(), zone.dbm());
+  }
+};
+
+/*!
+ \brief Run of the reachability algorithm with stored zones
+ \param zg : a zone graph
+ \param labels : accepting labels
+ \param policy : waiting policy
+ \param storage : storage format of the zones
+ \return statistics on the run, and number of stored nodes
+ */
+template <class STORAGE>
+std::tuple<tchecker::algorithms::reach::stats_t, std::size_t>
+run_stored_zones(tchecker::zg::zg_t & zg, boost::dynamic_bitset<> const & labels, enum tchecker::waiting::policy_t policy,
+                 STORAGE const & storage = STORAGE{})
+{
+  tchecker::algorithms::reach::stored_zones_algorithm_t<tchecker::zg::zg_t, STORAGE> algorithm{storage};
+  tchecker::algorithms::reach::stats_t stats = algorithm.run(zg, labels, policy);
+  return std::make_tuple(stats, algorithm.nodes());
+}
+
+/*!
+ \brief Check that two runs visit the same states
+ \param full : statistics and number of nodes of a run with full DBMs
+ \param stored : statistics and number of nodes of a run with stored zones
+ */
+void require_same_run(std::tuple<tchecker::algorithms::reach::stats_t, std::size_t> const & full,
+                      std::tuple<tchecker::algorithms::reach::stats_t, std::size_t> const & stored)
+{
+  REQUIRE(std::get<0>(stored).reachable() == std::get<0>(full).reachable());
+  REQUIRE(std::get<0>(stored).visited_states() == std::get<0>(full).visited_states());
+  REQUIRE(std::get<0>(stored).visited_transitions() == std::get<0>(full).visited_transitions());
+  REQUIRE(std::get<1>(stored) == std::get<1>(full));
+}
+
+} // end of anonymous namespace
+
+TEST_CASE("Reachability with stored zones", "[stored_zones]")
+{
+  std::string model = "system:stored_zones \n\
+  event:a \n\
+  event:b \n\
+  clock:1:x \n\
+  clock:1:y \n\
+  int:1:0:3:0:i \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial: : invariant: x<=3} \n\
+  location:P:l1{labels: done} \n\
+  edge:P:l0:l0:a{provided: x>=1 && i<3 : do: x=0; i=i+1} \n\
+  edge:P:l0:l1:b{provided: y>=2 && i==3} \n\
+  edge:P:l1:l0:a{do: y=0; i=0} \n\
+  \n\
+  process:Q \n\
+  clock:1:z \n\
+  location:Q:m0{initial:} \n\
+  location:Q:m1{invariant: z<=2} \n\
+  edge:Q:m0:m1:a{do: z=0} \n\
+  edge:Q:m1:m0:b{provided: z>=1} \n\
+  \n\
+  sync:P@b:Q@b\n";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl.get() != nullptr);
+
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, tchecker::ts::NO_SHARING,
+                                                               tchecker::zg::ELAPSED_SEMANTICS,
+                                                               tchecker::zg::EXTRA_LU_PLUS_LOCAL, 128, 128)};
+  REQUIRE(zg.get() != nullptr);
+
+  boost::dynamic_bitset<> const no_labels = system->as_syncprod_system().labels("");
+  boost::dynamic_bitset<> const done = system->as_syncprod_system().labels("done");
+
+  SECTION("Round trip of reduced zones")
+  {
+    std::vector<tchecker::zg::zg_t::sst_t> sst, next_sst;
+    zg->initial(sst);
+    REQUIRE(sst.size() == 1);
+    tchecker::zg::state_sptr_t restored = zg->clone(*std::get<1>(sst.front()));
+
+    tchecker::zg::reduced_zone_storage_t const storage;
+    for (int depth = 0; depth < 6 && !sst.empty(); ++depth) {
+      for (auto && [status, s, t] : sst) {
+        tchecker::zg::reduced_zone_t const stored = storage.store(*s, s->zone_ptr());
+        storage.restore(stored, *restored->zone_ptr());
+        REQUIRE(restored->zone() == s->zone());
+        REQUIRE(stored == storage.store(*restored, restored->zone_ptr()));
+        zg->next(tchecker::zg::const_state_sptr_t{s}, next_sst);
+      }
+      sst.swap(next_sst);
+      next_sst.clear();
+    }
+  }
+
+  SECTION("Reduced zones visit the same states as full DBMs")
+  {
+    for (enum tchecker::waiting::policy_t policy : {tchecker::waiting::QUEUE, tchecker::waiting::STACK}) {
+      auto full = run_stored_zones<full_zone_storage_t>(*zg, no_labels, policy);
+      REQUIRE_FALSE(std::get<0>(full).reachable());
+      REQUIRE(std::get<1>(full) == std::get<0>(full).visited_states());
+      require_same_run(full, run_stored_zones<tchecker::zg::reduced_zone_storage_t>(*zg, no_labels, policy));
+    }
+  }
+
+  SECTION("Reduced zones find the same accepting states as full DBMs")
+  {
+    auto full = run_stored_zones<full_zone_storage_t>(*zg, done, tchecker::waiting::QUEUE);
+    REQUIRE(std::get<0>(full).reachable());
+    require_same_run(full, run_stored_zones<tchecker::zg::reduced_zone_storage_t>(*zg, done, tchecker::waiting::QUEUE));
+  }
+
+  SECTION("Round trip of delta zones")
+  {
+    std::vector<tchecker::zg::zg_t::sst_t> sst, next_sst;
+    zg->initial(sst);
+    REQUIRE(sst.size() == 1);
+    tchecker::zg::state_sptr_t restored = zg->clone(*std::get<1>(sst.front()));
+
+    tchecker::zg::delta_zone_storage_t storage;
+    for (int depth = 0; depth < 6 && !sst.empty(); ++depth) {
+      for (auto && [status, s, t] : sst) {
+        std::size_t const references = storage.references();
+        tchecker::zg::delta_zone_t const stored = storage.store(*s, s->zone_ptr());
+        storage.restore(stored, *restored->zone_ptr());
+        REQUIRE(restored->zone() == s->zone());
+        if (stored.delta_size() == 0) {
+          // a copy of the zone, or an equal reference zone, is the reference
+          REQUIRE(*stored.reference() == s->zone());
+          REQUIRE(storage.references() <= references + 1);
+        }
+        else {
+          REQUIRE(stored.delta_size() > 0);
+          REQUIRE(storage.references() == references);
+        }
+        zg->next(tchecker::zg::const_state_sptr_t{s}, next_sst);
+      }
+      sst.swap(next_sst);
+      next_sst.clear();
+    }
+    REQUIRE(storage.references() > 0);
+  }
+
+  SECTION("Full-DBM fallback of delta zones")
+  {
+    std::vector<tchecker::zg::zg_t::sst_t> sst;
+    zg->initial(sst);
+    REQUIRE(sst.size() == 1);
+    tchecker::zg::state_sptr_t const & s = std::get<1>(sst.front());
+
+    tchecker::zg::delta_zone_storage_t storage;
+
+    // the first zone of a tuple of locations is stored as a full DBM, and becomes a reference
+    tchecker::zg::delta_zone_t const first = storage.store(*s, s->zone_ptr());
+    REQUIRE(*first.reference() == s->zone());
+    REQUIRE(first.reference().ptr() != s->zone_ptr().ptr());
+    REQUIRE(first.delta_size() == 0);
+    REQUIRE(storage.references() == 1);
+    std::size_t const memsize = storage.memsize();
+    REQUIRE(memsize > 0);
+
+    // a zone that differs from the reference in one bound is stored as a delta
+    tchecker::zg::state_sptr_t close = zg->clone(*s);
+    tchecker::dbm::db_t * dbm = close->zone_ptr()->dbm();
+    tchecker::clock_id_t const dim = close->zone().dim();
+    dbm[1 * dim + 0] = tchecker::dbm::db(tchecker::LE, 1); // x <= 1
+    tchecker::zg::delta_zone_t const delta = storage.store(*close, close->zone_ptr());
+    REQUIRE(delta.reference().ptr() == first.reference().ptr());
+    REQUIRE(delta.delta_size() == 1);
+    REQUIRE(storage.references() == 1);
+
+    tchecker::zg::state_sptr_t restored = zg->clone(*s);
+    storage.restore(delta, *restored->zone_ptr());
+    REQUIRE(restored->zone() == close->zone());
+    REQUIRE(delta != first);
+
+    // a zone that differs from the reference in all its non-diagonal bounds is stored as a full DBM
+    tchecker::zg::state_sptr_t far = zg->clone(*s);
+    dbm = far->zone_ptr()->dbm();
+    for (tchecker::clock_id_t i = 0; i < dim; ++i)
+      for (tchecker::clock_id_t j = 0; j < dim; ++j)
+        if (i != j)
+          dbm[i * dim + j] = tchecker::dbm::db(tchecker::LE, 10 + i * dim + j);
+    tchecker::zg::delta_zone_t const fallback = storage.store(*far, far->zone_ptr());
+    REQUIRE(*fallback.reference() == far->zone());
+    REQUIRE(fallback.delta_size() == 0);
+    REQUIRE(storage.references() == 2);
+
+    storage.restore(fallback, *restored->zone_ptr());
+    REQUIRE(restored->zone() == far->zone());
+  }
+
+  SECTION("Delta zones visit the same states as full DBMs")
+  {
+    for (enum tchecker::waiting::policy_t policy : {tchecker::waiting::QUEUE, tchecker::waiting::STACK}) {
+      auto full = run_stored_zones<full_zone_storage_t>(*zg, no_labels, policy);
+      require_same_run(full, run_stored_zones<tchecker::zg::delta_zone_storage_t>(*zg, no_labels, policy));
+    }
+    auto full = run_stored_zones<full_zone_storage_t>(*zg, done, tchecker::waiting::QUEUE);
+    require_same_run(full, run_stored_zones<tchecker::zg::delta_zone_storage_t>(*zg, done, tchecker::waiting::QUEUE));
+  }
+
+  SECTION("Width of packed zones")
+  {
+    std::unique_ptr<tchecker::clockbounds::clockbounds_t> clock_bounds{tchecker::clockbounds::compute_clockbounds(*system)};
+    REQUIRE(clock_bounds.get() != nullptr);
+    REQUIRE(tchecker::zg::bound_width(*clock_bounds->global_m_map()) == tchecker::zg::BOUND_WIDTH_16);
+    REQUIRE(tchecker::zg::bound_width(3, 4) == tchecker::zg::BOUND_WIDTH_16);
+    REQUIRE(tchecker::zg::bound_width(10000, 4) == tchecker::zg::BOUND_WIDTH_32);
+  }
+
+  SECTION("Round trip of packed zones")
+  {
+    std::vector<tchecker::zg::zg_t::sst_t> sst, next_sst;
+    zg->initial(sst);
+    REQUIRE(sst.size() == 1);
+    tchecker::zg::state_sptr_t restored = zg->clone(*std::get<1>(sst.front()));
+
+    tchecker::zg::packed_zone_storage_t const storage{tchecker::zg::BOUND_WIDTH_16};
+    for (int depth = 0; depth < 6 && !sst.empty(); ++depth) {
+      for (auto && [status, s, t] : sst) {
+        tchecker::zg::packed_zone_t const stored = storage.store(*s, s->zone_ptr());
+        REQUIRE(stored.width() == tchecker::zg::BOUND_WIDTH_16);
+        storage.restore(stored, *restored->zone_ptr());
+        REQUIRE(restored->zone() == s->zone());
+        REQUIRE(stored == storage.store(*restored, restored->zone_ptr()));
+        zg->next(tchecker::zg::const_state_sptr_t{s}, next_sst);
+      }
+      sst.swap(next_sst);
+      next_sst.clear();
+    }
+  }
+
+  SECTION("Overflow fallback of packed zones")
+  {
+    std::vector<tchecker::zg::zg_t::sst_t> sst;
+    zg->initial(sst);
+    REQUIRE(sst.size() == 1);
+    tchecker::zg::state_sptr_t large = zg->clone(*std::get<1>(sst.front()));
+    tchecker::clock_id_t const dim = large->zone().dim();
+    large->zone_ptr()->dbm()[1 * dim + 0] = tchecker::dbm::db(tchecker::LE, 100000); // x <= 100000
+
+    REQUIRE_THROWS_AS((tchecker::zg::packed_zone_t{large->zone(), tchecker::zg::BOUND_WIDTH_16}), std::invalid_argument);
+
+    tchecker::zg::state_sptr_t restored = zg->clone(*large);
+
+    // bounds that do not fit in 16 bits are stored with bounds of type tchecker::dbm::db_t
+    tchecker::zg::packed_zone_storage_t const storage16{tchecker::zg::BOUND_WIDTH_16};
+    tchecker::zg::packed_zone_t const stored64 = storage16.store(*large, large->zone_ptr());
+    REQUIRE(stored64.width() == tchecker::zg::BOUND_WIDTH_64);
+    storage16.restore(stored64, *restored->zone_ptr());
+    REQUIRE(restored->zone() == large->zone());
+
+    // they fit in 32 bits
+    tchecker::zg::packed_zone_storage_t const storage32{tchecker::zg::BOUND_WIDTH_32};
+    tchecker::zg::packed_zone_t const stored32 = storage32.store(*large, large->zone_ptr());
+    REQUIRE(stored32.width() == tchecker::zg::BOUND_WIDTH_32);
+    storage32.restore(stored32, *restored->zone_ptr());
+    REQUIRE(restored->zone() == large->zone());
+  }
+
+  SECTION("Packed zones visit the same states as full DBMs")
+  {
+    tchecker::zg::packed_zone_storage_t const storage{tchecker::zg::BOUND_WIDTH_16};
+    for (enum tchecker::waiting::policy_t policy : {tchecker::waiting::QUEUE, tchecker::waiting::STACK}) {
+      auto full = run_stored_zones<full_zone_storage_t>(*zg, no_labels, policy);
+      require_same_run(full, run_stored_zones(*zg, no_labels, policy, storage));
+    }
+    auto full = run_stored_zones<full_zone_storage_t>(*zg, done, tchecker::waiting::QUEUE);
+    require_same_run(full, run_stored_zones(*zg, done, tchecker::waiting::QUEUE, storage));
+  }
+
+  SECTION("Round trip of cold states")
+  {
+    REQUIRE(tchecker::algorithms::reach::stores_intval_v<tchecker::zg::cold_state_storage_t>);
+    REQUIRE_FALSE(tchecker::algorithms::reach::stores_intval_v<tchecker::zg::reduced_zone_storage_t>);
+    REQUIRE(tchecker::algorithms::reach::stores_expanded_only_v<tchecker::zg::cold_state_storage_t>);
+    REQUIRE_FALSE(tchecker::algorithms::reach::stores_expanded_only_v<tchecker::zg::reduced_zone_storage_t>);
+
+    std::vector<tchecker::zg::zg_t::sst_t> sst, next_sst;
+    zg->initial(sst);
+    REQUIRE(sst.size() == 1);
+    tchecker::zg::state_sptr_t restored = zg->clone(*std::get<1>(sst.front()));
+
+    tchecker::zg::cold_state_storage_t const storage;
+    for (int depth = 0; depth < 6 && !sst.empty(); ++depth) {
+      for (auto && [status, s, t] : sst) {
+        tchecker::zg::cold_state_t const stored = storage.store(*s, s->zone_ptr());
+        storage.restore(stored, *restored->zone_ptr());
+        storage.restore_intval(stored, *restored->intval_ptr());
+        REQUIRE(restored->zone() == s->zone());
+        REQUIRE(restored->intval() == s->intval());
+        REQUIRE(stored == storage.store(*restored, restored->zone_ptr()));
+        zg->next(tchecker::zg::const_state_sptr_t{s}, next_sst);
+      }
+      sst.swap(next_sst);
+      next_sst.clear();
+    }
+  }
+
+  SECTION("Cold states visit the same states as full DBMs")
+  {
+    for (enum tchecker::waiting::policy_t policy : {tchecker::waiting::QUEUE, tchecker::waiting::STACK}) {
+      auto full = run_stored_zones<full_zone_storage_t>(*zg, no_labels, policy);
+      require_same_run(full, run_stored_zones<tchecker::zg::cold_state_storage_t>(*zg, no_labels, policy));
+    }
+    auto full = run_stored_zones<full_zone_storage_t>(*zg, done, tchecker::waiting::QUEUE);
+    require_same_run(full, run_stored_zones<tchecker::zg::cold_state_storage_t>(*zg, done, tchecker::waiting::QUEUE));
+  }
+
+  SECTION("Round trip of compact zones")
+  {
+    // z is reset before being read from m0, hence inactive in m0
+    auto active = std::make_shared<tchecker::clockbounds::active_clocks_t const>(*system);
+    REQUIRE(active->has_inactive_clocks());
+    zg->active_clocks_reduction(active);
+
+    std::vector<tchecker::zg::zg_t::sst_t> sst, next_sst;
+    zg->initial(sst);
+    REQUIRE(sst.size() == 1);
+    tchecker::zg::state_sptr_t restored = zg->clone(*std::get<1>(sst.front()));
+
+    tchecker::zg::compact_zone_storage_t storage{active};
+    bool compacted = false;
+    for (int depth = 0; depth < 6 && !sst.empty(); ++depth) {
+      for (auto && [status, s, t] : sst) {
+        tchecker::zg::compact_zone_t const stored = storage.store(*s, s->zone_ptr());
+        if (stored.compact_dim() < stored.dim())
+          compacted = true;
+        storage.restore(stored, *restored->zone_ptr());
+        REQUIRE(restored->zone() == s->zone());
+        REQUIRE(stored == storage.store(*restored, restored->zone_ptr()));
+        zg->next(tchecker::zg::const_state_sptr_t{s}, next_sst);
+      }
+      sst.swap(next_sst);
+      next_sst.clear();
+    }
+    REQUIRE(compacted);
+  }
+
+  SECTION("Compact zones visit the same states as full DBMs")
+  {
+    auto active = std::make_shared<tchecker::clockbounds::active_clocks_t const>(*system);
+    zg->active_clocks_reduction(active);
+
+    for (enum tchecker::waiting::policy_t policy : {tchecker::waiting::QUEUE, tchecker::waiting::STACK}) {
+      auto full = run_stored_zones<full_zone_storage_t>(*zg, no_labels, policy);
+      require_same_run(full, run_stored_zones(*zg, no_labels, policy, tchecker::zg::compact_zone_storage_t{active}));
+    }
+    auto full = run_stored_zones<full_zone_storage_t>(*zg, done, tchecker::waiting::QUEUE);
+    require_same_run(full, run_stored_zones(*zg, done, tchecker::waiting::QUEUE, tchecker::zg::compact_zone_storage_t{active}));
+  }
+
+  SECTION("Compact zones need active clocks")
+  {
+    REQUIRE_THROWS_AS(tchecker::zg::compact_zone_storage_t{nullptr}, std::invalid_argument);
+  }
+
+  SECTION("Round trip of packed valuations")
+  {
+    using storage_t = tchecker::algorithms::reach::packed_intval_storage_t<tchecker::zg::reduced_zone_storage_t>;
+    REQUIRE(tchecker::algorithms::reach::stores_intval_v<storage_t>);
+
+    auto packing = std::make_shared<tchecker::intval_packing_t const>(system->integer_variables().flattened());
+    REQUIRE(packing->words() == 1);
+
+    std::vector<tchecker::zg::zg_t::sst_t> sst, next_sst;
+    zg->initial(sst);
+    REQUIRE(sst.size() == 1);
+    tchecker::zg::state_sptr_t restored = zg->clone(*std::get<1>(sst.front()));
+
+    storage_t storage{tchecker::zg::reduced_zone_storage_t{}, packing};
+    for (int depth = 0; depth < 8 && !sst.empty(); ++depth) {
+      for (auto && [status, s, t] : sst) {
+        storage_t::stored_zone_t const stored = storage.store(*s, s->zone_ptr());
+        REQUIRE(stored.intval.size() == 1);
+        storage.restore(stored, *restored->zone_ptr());
+        storage.restore_intval(stored, *restored->intval_ptr());
+        REQUIRE(restored->zone() == s->zone());
+        REQUIRE(restored->intval() == s->intval());
+        zg->next(tchecker::zg::const_state_sptr_t{s}, next_sst);
+      }
+      sst.swap(next_sst);
+      next_sst.clear();
+    }
+
+    REQUIRE_THROWS_AS((storage_t{tchecker::zg::reduced_zone_storage_t{}, nullptr}), std::invalid_argument);
+  }
+
+  SECTION("Packed valuations visit the same states as full DBMs")
+  {
+    using storage_t = tchecker::algorithms::reach::packed_intval_storage_t<tchecker::zg::reduced_zone_storage_t>;
+    auto packing = std::make_shared<tchecker::intval_packing_t const>(system->integer_variables().flattened());
+    storage_t const storage{tchecker::zg::reduced_zone_storage_t{}, packing};
+
+    for (enum tchecker::waiting::policy_t policy : {tchecker::waiting::QUEUE, tchecker::waiting::STACK}) {
+      auto full = run_stored_zones<full_zone_storage_t>(*zg, no_labels, policy);
+      require_same_run(full, run_stored_zones(*zg, no_labels, policy, storage));
+    }
+    auto full = run_stored_zones<full_zone_storage_t>(*zg, done, tchecker::waiting::QUEUE);
+    require_same_run(full, run_stored_zones(*zg, done, tchecker::waiting::QUEUE, storage));
+  }
+
+  SECTION("Unsupported waiting policy")
+  {
+    REQUIRE_THROWS_AS(
+        run_stored_zones<tchecker::zg::reduced_zone_storage_t>(*zg, no_labels, tchecker::waiting::PRIORITY_QUEUE),
+        std::invalid_argument);
+  }
+}
@@ -4,6 +4,8 @@
 
 #include <vector>
 
+#include "tchecker/waiting/concurrent.hh"
+#include "tchecker/waiting/priority_queue.hh"
 #include "tchecker/waiting/queue.hh"
 #include "tchecker/waiting/stack.hh"
 #include "tchecker/waiting/waiting.hh"
@@ -633,4 +635,156 @@ TEST_CASE("fast remove waiting stack", "[waiting]")
     non_empty_stack.remove_first();
     REQUIRE(non_empty_stack.empty());
   }
-}
\ No newline at end of file
+}
+TEST_CASE("waiting priority queue", "[waiting]")
+{
+  // smallest value modulo 10 first
+  tchecker::waiting::priority_queue_t<int> queue{[](int const & x) { return x % 10; }};
+  queue.insert(13);
+  queue.insert(21);
+  queue.insert(3);
+  queue.insert(7);
+
+  SECTION("priority order, fifo on equal priorities")
+  {
+    REQUIRE(queue.first() == 21);
+    queue.remove_first();
+    REQUIRE(queue.first() == 13);
+    queue.remove_first();
+    REQUIRE(queue.first() == 3);
+    queue.remove_first();
+    REQUIRE(queue.first() == 7);
+    queue.remove_first();
+    REQUIRE(queue.empty());
+  }
+
+  SECTION("remove")
+  {
+    queue.remove(13);
+    REQUIRE(queue.first() == 21);
+    queue.remove_first();
+    REQUIRE(queue.first() == 3);
+    queue.remove_first();
+    REQUIRE(queue.first() == 7);
+    queue.remove_first();
+    REQUIRE(queue.empty());
+  }
+
+  SECTION("clear")
+  {
+    queue.clear();
+    REQUIRE(queue.empty());
+  }
+
+  SECTION("no priority function")
+  {
+    REQUIRE_THROWS_AS(tchecker::waiting::priority_queue_t<int>{nullptr}, std::invalid_argument);
+  }
+}
+
+TEST_CASE("work-stealing deque", "[waiting]")
+{
+  tchecker::waiting::chase_lev_deque_t<int> deque{2};
+  for (int i = 0; i < 5; ++i)
+    deque.push(i);
+  REQUIRE(deque.size() == 5);
+
+  int x = -1;
+  REQUIRE(deque.pop(x));
+  REQUIRE(x == 4);
+  REQUIRE(deque.steal(x));
+  REQUIRE(x == 0);
+  REQUIRE(deque.pop(x));
+  REQUIRE(x == 3);
+  REQUIRE(deque.steal(x));
+  REQUIRE(x == 1);
+  REQUIRE(deque.pop(x));
+  REQUIRE(x == 2);
+  REQUIRE(deque.empty());
+  REQUIRE_FALSE(deque.pop(x));
+  REQUIRE_FALSE(deque.steal(x));
+}
+
+TEST_CASE("mpmc queue", "[waiting]")
+{
+  tchecker::waiting::mpmc_queue_t<int> queue{3};
+  REQUIRE(queue.capacity() == 4);
+  for (int i = 0; i < 4; ++i)
+    REQUIRE(queue.try_push(i));
+  REQUIRE_FALSE(queue.try_push(4));
+
+  int x = -1;
+  REQUIRE(queue.try_pop(x));
+  REQUIRE(x == 0);
+  REQUIRE(queue.try_push(4));
+  for (int i = 1; i < 5; ++i) {
+    REQUIRE(queue.try_pop(x));
+    REQUIRE(x == i);
+  }
+  REQUIRE_FALSE(queue.try_pop(x));
+}
+
+TEST_CASE("concurrent waiting containers with fast remove", "[waiting]")
+{
+  int_element_t e1{1}, e2{2}, e3{3};
+
+  SECTION("work-stealing")
+  {
+    tchecker::waiting::work_stealing_waiting_t<int_element_t *> waiting{2};
+    waiting.insert(0, &e1);
+    waiting.insert(0, &e2);
+    waiting.insert(1, &e3);
+    waiting.remove(&e2);
+
+    int_element_t * e = nullptr;
+    REQUIRE(waiting.take(0, e));
+    REQUIRE(e == &e1);
+    REQUIRE(waiting.take(0, e)); // stolen from worker 1
+    REQUIRE(e == &e3);
+    REQUIRE_FALSE(waiting.take(0, e));
+    REQUIRE_FALSE(waiting.take(1, e));
+  }
+
+  SECTION("work-stealing seeded evenly")
+  {
+    tchecker::waiting::work_stealing_waiting_t<int_element_t *> waiting{2};
+    waiting.seed({&e1, &e2, &e3});
+
+    int_element_t * e = nullptr;
+    REQUIRE(waiting.take(1, e));
+    REQUIRE(e == &e2);
+    REQUIRE(waiting.take(0, e));
+    REQUIRE(e == &e3);
+    REQUIRE(waiting.take(0, e));
+    REQUIRE(e == &e1);
+    REQUIRE_FALSE(waiting.take(1, e));
+  }
+
+  SECTION("queue")
+  {
+    tchecker::waiting::concurrent_queue_waiting_t<int_element_t *> waiting{8};
+    waiting.insert(&e1);
+    waiting.insert(&e2);
+    waiting.insert(&e3);
+    waiting.remove(&e1);
+
+    int_element_t * e = nullptr;
+    REQUIRE(waiting.take(e));
+    REQUIRE(e == &e2);
+    REQUIRE(waiting.take(e));
+    REQUIRE(e == &e3);
+    REQUIRE_FALSE(waiting.take(e));
+  }
+
+  SECTION("an element inserted twice is taken once")
+  {
+    tchecker::waiting::concurrent_queue_waiting_t<int_element_t *> waiting{8};
+    waiting.insert(&e1);
+    waiting.insert(&e1);
+
+    int_element_t * e = nullptr;
+    REQUIRE(waiting.take(e));
+    REQUIRE(e == &e1);
+    REQUIRE_FALSE(waiting.take(e));
+  }
+}
@@ -2,6 +2,7 @@
  * See files AUTHORS and LICENSE for copyright details.
  */
 
+#include <cstring>
 #include <memory>
 
 #include "tchecker/basictypes.hh"
@@ -1012,6 +1013,33 @@ TEST_CASE("elapsed semantics: next zone", "[zg semantics]")
         semantics->next(dbm, dim, src_delay_allowed, src_invariant, guard, clkreset, tgt_delay_allowed, tgt_invariant);
     REQUIRE(status == tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED);
   }
+
+  SECTION("next zone: satisfied guard, reset y:=0, upper bounds in tgt invariant, delays allowed")
+  {
+    // guard: 2<=x
+    guard.push_back(tchecker::clock_constraint_t{tchecker::REFCLOCK_ID, x, tchecker::LE, -2});
+
+    // reset
+    clkreset.push_back(tchecker::clock_reset_t{y, tchecker::REFCLOCK_ID, 0});
+
+    // tgt invariant: x<=4 && y<2
+    tgt_invariant.push_back(tchecker::clock_constraint_t{x, tchecker::REFCLOCK_ID, tchecker::LE, 4});
+    tgt_invariant.push_back(tchecker::clock_constraint_t{y, tchecker::REFCLOCK_ID, tchecker::LT, 2});
+
+    // expected dbm: tgt invariant applied before and after delay
+    std::memcpy(dbm2, dbm, dim * dim * sizeof(*dbm));
+    REQUIRE(tchecker::dbm::constrain(dbm2, dim, guard) == tchecker::dbm::NON_EMPTY);
+    tchecker::dbm::reset(dbm2, dim, clkreset);
+    REQUIRE(tchecker::dbm::constrain(dbm2, dim, tgt_invariant) == tchecker::dbm::NON_EMPTY);
+    tchecker::dbm::open_up(dbm2, dim);
+    REQUIRE(tchecker::dbm::constrain(dbm2, dim, tgt_invariant) == tchecker::dbm::NON_EMPTY);
+
+    tchecker::state_status_t status =
+        semantics->next(dbm, dim, src_delay_allowed, src_invariant, guard, clkreset, tgt_delay_allowed, tgt_invariant);
+    REQUIRE(status == tchecker::STATE_OK);
+
+    REQUIRE(tchecker::dbm::is_equal(dbm, dbm2, dim));
+  }
 }
 
 TEST_CASE("elapsed semantics: previous zone", "[zg semantics]")
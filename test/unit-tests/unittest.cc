@@ -5,21 +5,29 @@
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_test_macros.hpp>
 
+#include "test-bitstate.hh"
 #include "test-cache.hh"
 #include "test-clocks.hh"
+#include "test-cold-state.hh"
 #include "test-db.hh"
 #include "test-dbm.hh"
+#include "test-declaration-filter.hh"
 #include "test-delay_allowed.hh"
 #include "test-extract_variables.hh"
 #include "test-finite-path.hh"
 #include "test-from_string.hh"
 #include "test-guard_weak_sync.hh"
 #include "test-hashtable.hh"
+#include "test-intval-mdd.hh"
 #include "test-labels.hh"
 #include "test-ordering.hh"
+#include "test-packed-intval.hh"
+#include "test-pruning.hh"
+#include "test-record-pool.hh"
 #include "test-refdbm.hh"
 #include "test-reference_clock_variables.hh"
 #include "test-refzg-semantics.hh"
+#include "test-stored-zones.hh"
 #include "test-variables-access.hh"
 #include "test-waiting.hh"
 #include "test-zg-semantics.hh"